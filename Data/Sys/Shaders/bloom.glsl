@@ -0,0 +1,84 @@
+// A bloom that blurs the bright parts of the image at half resolution, in separate passes.
+// Each [Pass] names the function that is its main(), the textures it reads (the image that is
+// post-processed is the ColorBuffer), and the output that later passes can read. The inputs after
+// the first one are sampled with SampleInput1() onwards.
+
+/*
+[configuration]
+
+[OptionRangeFloat]
+GUIName = Threshold
+OptionName = THRESHOLD
+MinValue = 0
+MaxValue = 1
+StepAmount = 0.01
+DefaultValue = 0.7
+
+[OptionRangeFloat]
+GUIName = Intensity
+OptionName = INTENSITY
+MinValue = 0
+MaxValue = 4
+StepAmount = 0.05
+DefaultValue = 1
+
+[Pass]
+EntryPoint = BrightPass
+Inputs = ColorBuffer
+Output = bright
+OutputScale = 0.5
+
+[Pass]
+EntryPoint = BlurHorizontal
+Inputs = bright
+Output = blur_h
+OutputScale = 0.5
+
+[Pass]
+EntryPoint = BlurVertical
+Inputs = blur_h
+Output = blur
+OutputScale = 0.5
+
+[Pass]
+EntryPoint = Combine
+Inputs = ColorBuffer, blur
+
+[/configuration]
+*/
+
+void BrightPass()
+{
+	float4 color = Sample();
+	float brightness = max(color.r, max(color.g, color.b));
+	float amount = max(brightness - GetOption(THRESHOLD), 0.0) / max(brightness, 0.0001);
+	SetOutput(float4(color.rgb * amount, 1.0));
+}
+
+float4 Blur(float2 direction)
+{
+	float2 step = direction * GetInvResolution();
+	float4 sum = Sample() * 0.227027;
+	sum += SampleLocation(GetCoordinates() + step * 1.384615) * 0.316216;
+	sum += SampleLocation(GetCoordinates() - step * 1.384615) * 0.316216;
+	sum += SampleLocation(GetCoordinates() + step * 3.230769) * 0.070270;
+	sum += SampleLocation(GetCoordinates() - step * 3.230769) * 0.070270;
+	return sum;
+}
+
+void BlurHorizontal()
+{
+	SetOutput(Blur(float2(1.0, 0.0)));
+}
+
+void BlurVertical()
+{
+	SetOutput(Blur(float2(0.0, 1.0)));
+}
+
+void Combine()
+{
+	float4 color = Sample();
+	float4 bloom = SampleInput1(GetCoordinates());
+	SetOutput(float4(color.rgb + bloom.rgb * GetOption(INTENSITY), color.a));
+}
@@ -6,23 +6,68 @@
 #include <algorithm>
 #include <cmath>
 #include <cstddef>
+#include <limits>
 
+#ifdef _M_ARM_64
+#include <arm_neon.h>
+#endif
+
+#include "Common/Intrinsics.h"
 #include "Common/Logging/Log.h"
 #include "Core/Config/MainSettings.h"
 
 namespace AudioCommon
 {
-AudioStretcher::AudioStretcher(unsigned int sample_rate) : m_sample_rate(sample_rate)
+namespace
+{
+// The same sequence, overlap and seek lengths that SoundTouch used by default
+constexpr u32 SEQUENCE_MS = 40;
+constexpr u32 OVERLAP_MS = 8;
+constexpr u32 SEEK_MS = 15;
+
+float DotProduct(const float* a, const float* b, size_t count)
+{
+  size_t i = 0;
+  float result = 0.0f;
+
+#if defined(_M_X86_64)
+  __m128 sum = _mm_setzero_ps();
+  for (; i + 4 <= count; i += 4)
+    sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+  sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+  sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+  result = _mm_cvtss_f32(sum);
+#elif defined(_M_ARM_64)
+  float32x4_t sum = vdupq_n_f32(0.0f);
+  for (; i + 4 <= count; i += 4)
+    sum = vfmaq_f32(sum, vld1q_f32(a + i), vld1q_f32(b + i));
+  result = vaddvq_f32(sum);
+#endif
+
+  for (; i < count; ++i)
+    result += a[i] * b[i];
+  return result;
+}
+
+short ToShort(float sample)
+{
+  return static_cast<short>(std::clamp(sample, -32768.0f, 32767.0f));
+}
+}  // namespace
+
+AudioStretcher::AudioStretcher(unsigned int sample_rate)
+    : m_sample_rate(sample_rate), m_sequence_length(sample_rate * SEQUENCE_MS / 1000),
+      m_overlap_length(sample_rate * OVERLAP_MS / 1000), m_seek_length(sample_rate * SEEK_MS / 1000)
 {
-  m_sound_touch.setChannels(2);
-  m_sound_touch.setSampleRate(sample_rate);
-  m_sound_touch.setPitch(1.0);
-  m_sound_touch.setTempo(1.0);
+  m_overlap.resize(m_overlap_length * 2);
 }
 
 void AudioStretcher::Clear()
 {
-  m_sound_touch.clear();
+  m_input.clear();
+  m_input_position = 0.0;
+  m_have_overlap = false;
+  m_output.clear();
 }
 
 void AudioStretcher::ProcessSamples(const short* in, unsigned int num_in, unsigned int num_out)
@@ -34,7 +79,7 @@ void AudioStretcher::ProcessSamples(const short* in, unsigned int num_in, unsign
 
   const double max_latency = Config::Get(Config::MAIN_AUDIO_STRETCH_LATENCY);
   const double max_backlog = m_sample_rate * max_latency / 1000.0 / m_stretch_ratio;
-  const double backlog_fullness = m_sound_touch.numSamples() / max_backlog;
+  const double backlog_fullness = m_output.size() / 2 / max_backlog;
   if (backlog_fullness > 5.0)
   {
     // Too many samples in backlog: Don't push anymore on
@@ -56,17 +101,95 @@ void AudioStretcher::ProcessSamples(const short* in, unsigned int num_in, unsign
   // Place a lower limit of 10% speed.  When a game boots up, there will be
   // many silence samples.  These do not need to be timestretched.
   m_stretch_ratio = std::max(m_stretch_ratio, 0.1);
-  m_sound_touch.setTempo(m_stretch_ratio);
 
   DEBUG_LOG_FMT(AUDIO, "Audio stretching: samples:{}/{} ratio:{} backlog:{} gain: {}", num_in,
                 num_out, m_stretch_ratio, backlog_fullness, lpf_gain);
 
-  m_sound_touch.putSamples(in, num_in);
+  m_input.insert(m_input.end(), in, in + num_in * 2);
+  Stretch();
+}
+
+u32 AudioStretcher::FindBestOffset(const float* input) const
+{
+  // The candidate that correlates best with the overlap, normalized by the candidate's energy
+  const size_t count = m_overlap_length * 2;
+  double energy = DotProduct(input, input, count);
+  double best_score = -std::numeric_limits<double>::infinity();
+  u32 best_offset = 0;
+
+  for (u32 offset = 0; offset < m_seek_length; ++offset)
+  {
+    const float* candidate = input + offset * 2;
+    const double score =
+        DotProduct(m_overlap.data(), candidate, count) / std::sqrt(std::max(energy, 1.0));
+    if (score > best_score)
+    {
+      best_score = score;
+      best_offset = offset;
+    }
+
+    // Slide the energy over to the next candidate
+    energy += candidate[count] * candidate[count] + candidate[count + 1] * candidate[count + 1] -
+              candidate[0] * candidate[0] - candidate[1] * candidate[1];
+  }
+
+  return best_offset;
+}
+
+void AudioStretcher::Stretch()
+{
+  const bool fast_forward = m_stretch_ratio > FAST_FORWARD_TEMPO;
+  // Every sequence outputs everything but the overlap, which the next sequence fades in over
+  const u32 step = m_sequence_length - m_overlap_length;
+  const size_t available = m_input.size() / 2;
+
+  while (true)
+  {
+    const size_t base = static_cast<size_t>(m_input_position);
+    if (base + m_seek_length + m_sequence_length > available)
+      break;
+
+    const u32 offset = m_have_overlap && !fast_forward ? FindBestOffset(&m_input[base * 2]) : 0;
+    const float* sequence = &m_input[(base + offset) * 2];
+
+    const size_t output_start = m_output.size();
+    m_output.resize(output_start + step * 2);
+    short* out = &m_output[output_start];
+
+    u32 i = 0;
+    if (m_have_overlap)
+    {
+      for (; i < m_overlap_length; ++i)
+      {
+        const float fade = static_cast<float>(i) / m_overlap_length;
+        out[i * 2] = ToShort(m_overlap[i * 2] + (sequence[i * 2] - m_overlap[i * 2]) * fade);
+        out[i * 2 + 1] =
+            ToShort(m_overlap[i * 2 + 1] + (sequence[i * 2 + 1] - m_overlap[i * 2 + 1]) * fade);
+      }
+    }
+    for (; i < step; ++i)
+    {
+      out[i * 2] = ToShort(sequence[i * 2]);
+      out[i * 2 + 1] = ToShort(sequence[i * 2 + 1]);
+    }
+
+    std::copy(sequence + step * 2, sequence + m_sequence_length * 2, m_overlap.begin());
+    m_have_overlap = true;
+    m_input_position += step * m_stretch_ratio;
+  }
+
+  // Drop the input that no sequence can start in anymore. When fast-forwarding, the position can
+  // be past the end of the input, and the input that is skipped over is dropped as it arrives.
+  const size_t consumed = std::min(static_cast<size_t>(m_input_position), available);
+  m_input.erase(m_input.begin(), m_input.begin() + consumed * 2);
+  m_input_position -= consumed;
 }
 
 void AudioStretcher::GetStretchedSamples(short* out, unsigned int num_out)
 {
-  const size_t samples_received = m_sound_touch.receiveSamples(out, num_out);
+  const size_t samples_received = std::min<size_t>(num_out, m_output.size() / 2);
+  std::copy_n(m_output.begin(), samples_received * 2, out);
+  m_output.erase(m_output.begin(), m_output.begin() + samples_received * 2);
 
   if (samples_received != 0)
   {
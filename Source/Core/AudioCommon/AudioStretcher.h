@@ -4,11 +4,15 @@
 #pragma once
 
 #include <array>
+#include <vector>
 
-#include <SoundTouch.h>
+#include "Common/CommonTypes.h"
 
 namespace AudioCommon
 {
+// Changes the tempo of stereo audio without changing its pitch, using WSOLA: the input is cut into
+// overlapping sequences, and every sequence is moved by up to the seek window to where it best
+// matches the end of the previous one before they are crossfaded.
 class AudioStretcher
 {
 public:
@@ -17,10 +21,33 @@ public:
   void GetStretchedSamples(short* out, unsigned int num_out);
   void Clear();
 
+  // Above this tempo, sequences are taken from where they are instead of searching for the best
+  // match, which drops audio cheaply while fast-forwarding
+  static constexpr double FAST_FORWARD_TEMPO = 2.0;
+
 private:
+  void Stretch();
+  u32 FindBestOffset(const float* input) const;
+
   unsigned int m_sample_rate;
+  // In stereo samples
+  u32 m_sequence_length;
+  u32 m_overlap_length;
+  u32 m_seek_length;
+
+  // Interleaved stereo samples that haven't been stretched yet. m_input_position is where the
+  // next sequence starts without seeking.
+  std::vector<float> m_input;
+  double m_input_position = 0.0;
+
+  // The end of the previous sequence, which the next sequence is crossfaded with
+  std::vector<float> m_overlap;
+  bool m_have_overlap = false;
+
+  // Stretched interleaved stereo samples
+  std::vector<short> m_output;
+
   std::array<short, 2> m_last_stretched_sample = {};
-  soundtouch::SoundTouch m_sound_touch;
   double m_stretch_ratio = 1.0;
 };
 
@@ -12,4 +12,12 @@ enum class DPL2Quality
   High = 2,
   Highest = 3
 };
+
+enum class DPL2Mode
+{
+  // Steers the channels by frequency band, with FreeSurround
+  FreeSurround = 0,
+  // A passive matrix, which is much cheaper and has no latency, but separates the channels less
+  Matrix = 1
+};
 }  // namespace AudioCommon
@@ -7,15 +7,25 @@
 #include <cmath>
 #include <cstring>
 
+#ifdef _M_ARM_64
+#include <arm_neon.h>
+#endif
+
 #include "AudioCommon/Enums.h"
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
+#include "Common/Counters.h"
+#include "Common/Intrinsics.h"
 #include "Common/Logging/Log.h"
 #include "Common/Swap.h"
+#include "Common/TraceEvents.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "VideoCommon/PerformanceMetrics.h"
 
+static Common::Counter s_audio_underruns("dolphin_audio_underruns_total",
+                                         "Audio callbacks that ran out of samples to play");
+
 static u32 DPL2QualityToFrameBlockSize(AudioCommon::DPL2Quality quality)
 {
   switch (quality)
@@ -57,13 +67,64 @@ void Mixer::DoState(PointerWrap& p)
     mixer.DoState(p);
 }
 
+// Scales the (right, left) sample pairs of block by the volumes and adds them to the samples
+void Mixer::MixBlock(short* samples, const s16* block, u32 num_samples, s32 lvolume,
+                     s32 rvolume)
+{
+  u32 i = 0;
+
+#if defined(_M_X86_64)
+  // madd of a sample and a zero with a volume and a zero multiplies them into a 32-bit lane
+  const __m128i volume = _mm_setr_epi32(rvolume, lvolume, rvolume, lvolume);
+  const __m128i min = _mm_set1_epi16(-32767);
+  for (; i + 4 <= num_samples; i += 4)
+  {
+    const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + i * 2));
+    const __m128i out = _mm_loadu_si128(reinterpret_cast<const __m128i*>(samples + i * 2));
+
+    const __m128i lo = _mm_srai_epi32(
+        _mm_madd_epi16(_mm_unpacklo_epi16(in, _mm_setzero_si128()), volume), 8);
+    const __m128i hi = _mm_srai_epi32(
+        _mm_madd_epi16(_mm_unpackhi_epi16(in, _mm_setzero_si128()), volume), 8);
+    const __m128i out_lo = _mm_srai_epi32(_mm_unpacklo_epi16(out, out), 16);
+    const __m128i out_hi = _mm_srai_epi32(_mm_unpackhi_epi16(out, out), 16);
+
+    const __m128i result = _mm_packs_epi32(_mm_add_epi32(lo, out_lo), _mm_add_epi32(hi, out_hi));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(samples + i * 2), _mm_max_epi16(result, min));
+  }
+#elif defined(_M_ARM_64)
+  const s32 volumes[4] = {rvolume, lvolume, rvolume, lvolume};
+  const int32x4_t volume = vld1q_s32(volumes);
+  const int16x8_t min = vdupq_n_s16(-32767);
+  for (; i + 4 <= num_samples; i += 4)
+  {
+    const int16x8_t in = vld1q_s16(block + i * 2);
+    const int16x8_t out = vld1q_s16(samples + i * 2);
+
+    const int32x4_t lo = vaddw_s16(
+        vshrq_n_s32(vmulq_s32(vmovl_s16(vget_low_s16(in)), volume), 8), vget_low_s16(out));
+    const int32x4_t hi = vaddw_s16(
+        vshrq_n_s32(vmulq_s32(vmovl_s16(vget_high_s16(in)), volume), 8), vget_high_s16(out));
+
+    const int16x8_t result = vcombine_s16(vqmovn_s32(lo), vqmovn_s32(hi));
+    vst1q_s16(samples + i * 2, vmaxq_s16(result, min));
+  }
+#endif
+
+  for (; i < num_samples; ++i)
+  {
+    const int sampleR = ((block[i * 2] * rvolume) >> 8) + samples[i * 2];
+    samples[i * 2] = std::clamp(sampleR, -32767, 32767);
+    const int sampleL = ((block[i * 2 + 1] * lvolume) >> 8) + samples[i * 2 + 1];
+    samples[i * 2 + 1] = std::clamp(sampleL, -32767, 32767);
+  }
+}
+
 // Executed from sound stream thread
 unsigned int Mixer::MixerFifo::Mix(short* samples, unsigned int numSamples,
                                    bool consider_framelimit, float emulationspeed,
                                    int timing_variance)
 {
-  unsigned int currentSample = 0;
-
   // Cache access in non-volatile variable
   // This is the only function changing the read value, so it's safe to
   // cache it locally although it's written here.
@@ -107,32 +168,46 @@ unsigned int Mixer::MixerFifo::Mix(short* samples, unsigned int numSamples,
     return m_little_endian ? m_buffer[index] : Common::swap16(m_buffer[index]);
   };
 
+  // Interpolating needs the next sample, so output samples can be produced while at least two
+  // input samples are left
+  const u32 available = ((indexW - indexR) & INDEX_MASK) / 2;
+  u32 actual_sample_count = 0;
+  if (available >= 2)
+  {
+    const u64 last_position = (static_cast<u64>(available - 1) << 16) - 1 - m_frac;
+    actual_sample_count =
+        ratio == 0 ? numSamples :
+                     static_cast<u32>(std::min<u64>(numSamples, last_position / ratio + 1));
+  }
+
+  // Resample a block at a time, then apply the volume and mix the whole block in
   // TODO: consider a higher-quality resampling algorithm.
-  for (; currentSample < numSamples * 2 && ((indexW - indexR) & INDEX_MASK) > 2; currentSample += 2)
+  std::array<s16, MIX_BLOCK_SIZE * 2> block;
+  u64 position = m_frac;
+  for (u32 block_start = 0; block_start < actual_sample_count; block_start += MIX_BLOCK_SIZE)
   {
-    u32 indexR2 = indexR + 2;  // next sample
-
-    s16 l1 = read_buffer(indexR & INDEX_MASK);   // current
-    s16 l2 = read_buffer(indexR2 & INDEX_MASK);  // next
-    int sampleL = ((l1 << 16) + (l2 - l1) * (u16)m_frac) >> 16;
-    sampleL = (sampleL * lvolume) >> 8;
-    sampleL += samples[currentSample + 1];
-    samples[currentSample + 1] = std::clamp(sampleL, -32767, 32767);
-
-    s16 r1 = read_buffer((indexR + 1) & INDEX_MASK);   // current
-    s16 r2 = read_buffer((indexR2 + 1) & INDEX_MASK);  // next
-    int sampleR = ((r1 << 16) + (r2 - r1) * (u16)m_frac) >> 16;
-    sampleR = (sampleR * rvolume) >> 8;
-    sampleR += samples[currentSample];
-    samples[currentSample] = std::clamp(sampleR, -32767, 32767);
-
-    m_frac += ratio;
-    indexR += 2 * (u16)(m_frac >> 16);
-    m_frac &= 0xffff;
+    const u32 block_size = std::min(MIX_BLOCK_SIZE, actual_sample_count - block_start);
+    for (u32 i = 0; i < block_size; ++i, position += ratio)
+    {
+      const u32 index = indexR + 2 * static_cast<u32>(position >> 16);  // current
+      const u32 index2 = index + 2;                                      // next
+      const int frac = static_cast<int>(position & 0xffff);
+
+      const s16 l1 = read_buffer(index & INDEX_MASK);
+      const s16 l2 = read_buffer(index2 & INDEX_MASK);
+      block[i * 2 + 1] = static_cast<s16>(((l1 << 16) + (l2 - l1) * frac) >> 16);
+
+      const s16 r1 = read_buffer((index + 1) & INDEX_MASK);
+      const s16 r2 = read_buffer((index2 + 1) & INDEX_MASK);
+      block[i * 2] = static_cast<s16>(((r1 << 16) + (r2 - r1) * frac) >> 16);
+    }
+
+    MixBlock(samples + block_start * 2, block.data(), block_size, lvolume, rvolume);
   }
+  indexR += 2 * static_cast<u32>(position >> 16);
+  m_frac = static_cast<u32>(position & 0xffff);
 
-  // Actual number of samples written to the buffer without padding.
-  unsigned int actual_sample_count = currentSample / 2;
+  unsigned int currentSample = actual_sample_count * 2;
 
   // Padding
   short s[2];
@@ -160,12 +235,15 @@ unsigned int Mixer::Mix(short* samples, unsigned int num_samples)
   if (!samples)
     return 0;
 
+  TRACE_SCOPE("Mix audio");
+
   memset(samples, 0, num_samples * 2 * sizeof(short));
 
   // TODO: Determine how emulation speed will be used in audio
   // const float emulation_speed = g_perf_metrics.GetSpeed();
   const float emulation_speed = m_config_emulation_speed;
-  const int timing_variance = m_config_timing_variance;
+  const int timing_variance =
+      m_config_low_latency ? UpdateLowLatencyTarget(num_samples) : m_config_timing_variance;
   if (m_config_audio_stretch)
   {
     unsigned int available_samples =
@@ -202,18 +280,58 @@ unsigned int Mixer::Mix(short* samples, unsigned int num_samples)
   }
   else
   {
-    m_dma_mixer.Mix(samples, num_samples, true, emulation_speed, timing_variance);
+    const unsigned int dma_samples =
+        m_dma_mixer.Mix(samples, num_samples, true, emulation_speed, timing_variance);
     m_streaming_mixer.Mix(samples, num_samples, true, emulation_speed, timing_variance);
     m_wiimote_speaker_mixer.Mix(samples, num_samples, true, emulation_speed, timing_variance);
     m_skylander_portal_mixer.Mix(samples, num_samples, true, emulation_speed, timing_variance);
     for (auto& mixer : m_gba_mixers)
       mixer.Mix(samples, num_samples, true, emulation_speed, timing_variance);
     m_is_stretching = false;
+
+    // A FIFO that is completely empty just has nothing to play
+    if (dma_samples != 0 && dma_samples < num_samples)
+    {
+      g_perf_metrics.CountAudioUnderrun();
+      s_audio_underruns.Add();
+      if (m_config_low_latency)
+        m_underrun_margin_ms += 1000.0 * num_samples / m_sampleRate;
+    }
   }
 
+  const double dma_sample_rate = static_cast<double>(FIXED_SAMPLE_RATE_DIVIDEND) /
+                                 m_dma_mixer.GetInputSampleRateDivisor();
+  g_perf_metrics.SetAudioBufferLevels(1000.0 * m_dma_mixer.AvailableSamples() / dma_sample_rate,
+                                      timing_variance);
+
   return num_samples;
 }
 
+int Mixer::UpdateLowLatencyTarget(unsigned int num_samples)
+{
+  const auto now = std::chrono::steady_clock::now();
+  const double period_ms = 1000.0 * num_samples / m_sampleRate;
+
+  const double interval_s = std::chrono::duration<double>(now - m_last_mix_time).count();
+  if (interval_s < LOW_LATENCY_MAX_INTERVAL_S)
+  {
+    // Increases of the jitter are followed right away
+    const double jitter_ms = std::abs(1000.0 * interval_s - period_ms);
+    m_callback_jitter_ms =
+        std::max(jitter_ms, m_callback_jitter_ms * std::exp(-interval_s / JITTER_DECAY_TIME_S));
+    m_underrun_margin_ms *= std::exp(-interval_s / UNDERRUN_MARGIN_DECAY_TIME_S);
+  }
+  m_last_mix_time = now;
+
+  const double target_ms = period_ms + 2.0 * m_callback_jitter_ms + LOW_LATENCY_BURST_MARGIN_MS +
+                           m_underrun_margin_ms;
+
+  // Never use more than the regular mode
+  const int max_target_ms = std::max(m_config_timing_variance, LOW_LATENCY_MIN_TARGET_MS);
+  return std::clamp(static_cast<int>(std::ceil(target_ms)), LOW_LATENCY_MIN_TARGET_MS,
+                    max_target_ms);
+}
+
 unsigned int Mixer::MixSurround(float* samples, unsigned int num_samples)
 {
   if (!num_samples)
@@ -237,6 +355,7 @@ unsigned int Mixer::MixSurround(float* samples, unsigned int num_samples)
     return 0;
   }
 
+  m_surround_decoder.SetMode(m_config_dpl2_mode);
   m_surround_decoder.PutFrames(m_scratch_buffer.data(), needed_frames);
   m_surround_decoder.ReceiveFrames(samples, num_samples);
 
@@ -458,6 +577,8 @@ void Mixer::RefreshConfig()
   m_config_emulation_speed = Config::Get(Config::MAIN_EMULATION_SPEED);
   m_config_timing_variance = Config::Get(Config::MAIN_TIMING_VARIANCE);
   m_config_audio_stretch = Config::Get(Config::MAIN_AUDIO_STRETCH);
+  m_config_low_latency = Config::Get(Config::MAIN_AUDIO_LOW_LATENCY);
+  m_config_dpl2_mode = Config::Get(Config::MAIN_DPL2_MODE);
 }
 
 void Mixer::MixerFifo::DoState(PointerWrap& p)
@@ -5,6 +5,7 @@
 
 #include <array>
 #include <atomic>
+#include <chrono>
 
 #include "AudioCommon/AudioStretcher.h"
 #include "AudioCommon/SurroundDecoder.h"
@@ -59,6 +60,17 @@ private:
   static constexpr int MAX_FREQ_SHIFT = 200;  // Per 32000 Hz
   static constexpr float CONTROL_FACTOR = 0.2f;
   static constexpr u32 CONTROL_AVG = 32;  // In freq_shift per FIFO size offset
+  // Number of samples that the FIFOs resample at once before mixing them in
+  static constexpr u32 MIX_BLOCK_SIZE = 256;
+  // Adaptive low latency: the FIFOs are kept filled by one backend callback, twice the callback
+  // jitter and a margin for the bursts the emulated hardware pushes samples in, plus a margin
+  // that grows with underruns. Jitter decays over seconds, the underrun margin more slowly.
+  static constexpr double LOW_LATENCY_BURST_MARGIN_MS = 5.0;
+  static constexpr int LOW_LATENCY_MIN_TARGET_MS = 5;
+  static constexpr double JITTER_DECAY_TIME_S = 2.0;
+  static constexpr double UNDERRUN_MARGIN_DECAY_TIME_S = 10.0;
+  // Longer gaps between callbacks are the backend starting or pausing, not jitter
+  static constexpr double LOW_LATENCY_MAX_INTERVAL_S = 0.25;
 
   const unsigned int SURROUND_CHANNELS = 6;
 
@@ -94,7 +106,11 @@ private:
     u32 m_frac = 0;
   };
 
+  static void MixBlock(short* samples, const s16* block, u32 num_samples, s32 lvolume,
+                       s32 rvolume);
+
   void RefreshConfig();
+  int UpdateLowLatencyTarget(unsigned int num_samples);
 
   MixerFifo m_dma_mixer{this, FIXED_SAMPLE_RATE_DIVIDEND / 32000, false};
   MixerFifo m_streaming_mixer{this, FIXED_SAMPLE_RATE_DIVIDEND / 48000, false};
@@ -120,6 +136,13 @@ private:
   float m_config_emulation_speed;
   int m_config_timing_variance;
   bool m_config_audio_stretch;
+  bool m_config_low_latency;
+  AudioCommon::DPL2Mode m_config_dpl2_mode;
+
+  // Only accessed from the audio thread
+  std::chrono::steady_clock::time_point m_last_mix_time{};
+  double m_callback_jitter_ms = 0.0;
+  double m_underrun_margin_ms = 0.0;
 
   Config::ConfigChangedCallbackID m_config_changed_callback_id;
 };
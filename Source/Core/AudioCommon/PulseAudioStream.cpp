@@ -10,11 +10,18 @@
 #include "Common/Logging/Log.h"
 #include "Common/Thread.h"
 #include "Core/Config/MainSettings.h"
+#include "VideoCommon/PerformanceMetrics.h"
 
 namespace
 {
-const size_t BUFFER_SAMPLES = 512;  // ~10 ms - needs to be at least 240 for surround
+const size_t BUFFER_SAMPLES = 512;              // ~10 ms - needs to be at least 240 for surround
+const size_t LOW_LATENCY_BUFFER_SAMPLES = 256;  // ~5 ms, for MAIN_AUDIO_LOW_LATENCY
+
+size_t GetBufferSamples()
+{
+  return Config::Get(Config::MAIN_AUDIO_LOW_LATENCY) ? LOW_LATENCY_BUFFER_SAMPLES : BUFFER_SAMPLES;
 }
+}  // namespace
 
 PulseAudio::PulseAudio() = default;
 
@@ -117,7 +124,7 @@ bool PulseAudio::PulseInit()
   m_pa_ba.minreq = -1;     // don't read every byte, try to group them _a bit_
   m_pa_ba.prebuf = -1;     // start as early as possible
   m_pa_ba.tlength =
-      BUFFER_SAMPLES * m_channels *
+      GetBufferSamples() * m_channels *
       m_bytespersample;  // designed latency, only change this flag for low latency output
   pa_stream_flags flags = pa_stream_flags(PA_STREAM_INTERPOLATE_TIMING | PA_STREAM_ADJUST_LATENCY |
                                           PA_STREAM_AUTO_TIMING_UPDATE);
@@ -155,10 +162,12 @@ void PulseAudio::StateCallback(pa_context* c)
     break;
   }
 }
-// on underflow, increase pulseaudio latency in ~10ms steps
+// on underflow, increase pulseaudio latency in steps of the initial latency
 void PulseAudio::UnderflowCallback(pa_stream* s)
 {
-  m_pa_ba.tlength += BUFFER_SAMPLES * m_channels * m_bytespersample;
+  g_perf_metrics.CountAudioUnderrun();
+
+  m_pa_ba.tlength += GetBufferSamples() * m_channels * m_bytespersample;
   pa_operation* op = pa_stream_set_buffer_attr(s, &m_pa_ba, nullptr, nullptr);
   pa_operation_unref(op);
 
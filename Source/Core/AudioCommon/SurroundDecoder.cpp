@@ -4,18 +4,69 @@
 #include "AudioCommon/SurroundDecoder.h"
 
 #include <FreeSurround/FreeSurroundDecoder.h>
+#include <algorithm>
+#include <cmath>
 #include <limits>
+#include <numbers>
+
+#ifdef _M_ARM_64
+#include <arm_neon.h>
+#endif
+
+#include "Common/Intrinsics.h"
 
 namespace AudioCommon
 {
 constexpr size_t STEREO_CHANNELS = 2;
 constexpr size_t SURROUND_CHANNELS = 6;
 
+constexpr float SAMPLE_SCALE = 1.0f / std::numeric_limits<short>::max();
+
+// The passive matrix, in the backend channel order FL | FR | FC | LFE | BL | BR, with one column
+// for the left and one for the right input. Pro Logic II encodes the rear channels into both
+// front channels with opposite signs, which the rear rows undo as far as a matrix can.
+constexpr std::array<float, SURROUND_CHANNELS> MATRIX_LEFT = {
+    1.0f, 0.0f, 0.7071f, 0.0f, -0.8718f, -0.4899f};
+constexpr std::array<float, SURROUND_CHANNELS> MATRIX_RIGHT = {
+    0.0f, 1.0f, 0.7071f, 0.0f, 0.4899f, 0.8718f};
+// The LFE channel is the low-passed sum of both inputs
+constexpr float LFE_CUTOFF = 80.0f;
+
+static void ConvertToFloat(const short* in, float* out, size_t count)
+{
+  size_t i = 0;
+
+#if defined(_M_X86_64)
+  const __m128 scale = _mm_set1_ps(SAMPLE_SCALE);
+  for (; i + 8 <= count; i += 8)
+  {
+    const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+    const __m128i low = _mm_srai_epi32(_mm_unpacklo_epi16(samples, samples), 16);
+    const __m128i high = _mm_srai_epi32(_mm_unpackhi_epi16(samples, samples), 16);
+    _mm_storeu_ps(out + i, _mm_mul_ps(_mm_cvtepi32_ps(low), scale));
+    _mm_storeu_ps(out + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(high), scale));
+  }
+#elif defined(_M_ARM_64)
+  for (; i + 8 <= count; i += 8)
+  {
+    const int16x8_t samples = vld1q_s16(in + i);
+    vst1q_f32(out + i, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(samples))), SAMPLE_SCALE));
+    vst1q_f32(out + i + 4, vmulq_n_f32(vcvtq_f32_s32(vmovl_high_s16(samples)), SAMPLE_SCALE));
+  }
+#endif
+
+  for (; i < count; ++i)
+    out[i] = in[i] * SAMPLE_SCALE;
+}
+
 SurroundDecoder::SurroundDecoder(u32 sample_rate, u32 frame_block_size)
-    : m_sample_rate(sample_rate), m_frame_block_size(frame_block_size)
+    : m_sample_rate(sample_rate), m_frame_block_size(frame_block_size),
+      m_lfe_coefficient(1.0f - std::exp(-2.0f * std::numbers::pi_v<float> * LFE_CUTOFF /
+                                        static_cast<float>(sample_rate)))
 {
   m_fsdecoder = std::make_unique<DPL2FSDecoder>();
   m_fsdecoder->Init(cs_5point1, m_frame_block_size, m_sample_rate);
+  m_decoded.reserve(m_frame_block_size * 2 * SURROUND_CHANNELS);
 }
 
 SurroundDecoder::~SurroundDecoder() = default;
@@ -23,16 +74,30 @@ SurroundDecoder::~SurroundDecoder() = default;
 void SurroundDecoder::Clear()
 {
   m_fsdecoder->flush();
-  m_decoded_fifo.clear();
+  m_lfe = 0.0f;
+  m_decoded.clear();
+  m_decoded_position = 0;
+}
+
+void SurroundDecoder::SetMode(DPL2Mode mode)
+{
+  if (mode == m_mode)
+    return;
+
+  // Don't let the state of the previous mode leak into the output, the decoded frames are kept
+  m_mode = mode;
+  m_fsdecoder->flush();
+  m_lfe = 0.0f;
 }
 
 // Currently only 6 channels are supported.
 size_t SurroundDecoder::QueryFramesNeededForSurroundOutput(const size_t output_frames) const
 {
-  if (m_decoded_fifo.size() < output_frames * SURROUND_CHANNELS)
+  const size_t decoded_frames = (m_decoded.size() - m_decoded_position) / SURROUND_CHANNELS;
+  if (decoded_frames < output_frames)
   {
     // Output stereo frames needed to have at least the desired number of surround frames
-    size_t frames_needed = output_frames - m_decoded_fifo.size() / SURROUND_CHANNELS;
+    size_t frames_needed = output_frames - decoded_frames;
     return frames_needed + m_frame_block_size - frames_needed % m_frame_block_size;
   }
 
@@ -42,51 +107,150 @@ size_t SurroundDecoder::QueryFramesNeededForSurroundOutput(const size_t output_f
 // Receive and decode samples
 void SurroundDecoder::PutFrames(const short* in, const size_t num_frames_in)
 {
+  // Drop the frames that were already received
+  m_decoded.erase(m_decoded.begin(), m_decoded.begin() + m_decoded_position);
+  m_decoded_position = 0;
+
   // Maybe check if it is really power-of-2?
   s64 remaining_frames = static_cast<s64>(num_frames_in);
   size_t frame_index = 0;
 
   while (remaining_frames > 0)
   {
-    // Convert to float
-    for (size_t i = 0, end = m_frame_block_size * STEREO_CHANNELS; i < end; ++i)
-    {
-      m_float_conversion_buffer[i] = in[i + frame_index * STEREO_CHANNELS] /
-                                     static_cast<float>(std::numeric_limits<short>::max());
-    }
+    const size_t decoded_size = m_decoded.size();
+    m_decoded.resize(decoded_size + m_frame_block_size * SURROUND_CHANNELS);
+
+    const short* block = in + frame_index * STEREO_CHANNELS;
+    float* out = m_decoded.data() + decoded_size;
+    if (m_mode == DPL2Mode::Matrix)
+      DecodeMatrix(block, out);
+    else
+      DecodeFreeSurround(block, out);
 
-    // Decode
-    const float* dpl2_fs = m_fsdecoder->decode(m_float_conversion_buffer.data());
+    remaining_frames = remaining_frames - static_cast<int>(m_frame_block_size);
+    frame_index = frame_index + m_frame_block_size;
+  }
+}
 
-    // Add to ring buffer and fix channel mapping
-    // Maybe modify FreeSurround to output the correct mapping?
-    // FreeSurround:
-    // FL | FC | FR | BL | BR | LFE
-    // Most backends:
-    // FL | FR | FC | LFE | BL | BR
-    for (size_t i = 0; i < m_frame_block_size; ++i)
+void SurroundDecoder::DecodeFreeSurround(const short* in, float* out)
+{
+  ConvertToFloat(in, m_float_conversion_buffer.data(), m_frame_block_size * STEREO_CHANNELS);
+
+  // Decode
+  const float* dpl2_fs = m_fsdecoder->decode(m_float_conversion_buffer.data());
+
+  // Fix channel mapping
+  // Maybe modify FreeSurround to output the correct mapping?
+  // FreeSurround:
+  // FL | FC | FR | BL | BR | LFE
+  // Most backends:
+  // FL | FR | FC | LFE | BL | BR
+  for (size_t i = 0; i < m_frame_block_size; ++i)
+  {
+    const float* frame = dpl2_fs + i * SURROUND_CHANNELS;
+    out[0] = frame[0];  // LEFTFRONT
+    out[1] = frame[2];  // RIGHTFRONT
+    out[2] = frame[1];  // CENTREFRONT
+    out[3] = frame[5];  // sub/lfe
+    out[4] = frame[3];  // LEFTREAR
+    out[5] = frame[4];  // RIGHTREAR
+    out += SURROUND_CHANNELS;
+  }
+}
+
+void SurroundDecoder::DecodeMatrix(const short* in, float* out)
+{
+  size_t i = 0;
+
+  // Two frames are twelve output samples, which are three vectors
+#if defined(_M_X86_64)
+  const auto load = [](size_t first, size_t second, size_t third, size_t fourth,
+                       const std::array<float, SURROUND_CHANNELS>& column) {
+    return _mm_setr_ps(column[first], column[second], column[third], column[fourth]);
+  };
+  const __m128 left_0 = load(0, 1, 2, 3, MATRIX_LEFT);
+  const __m128 left_1 = load(4, 5, 0, 1, MATRIX_LEFT);
+  const __m128 left_2 = load(2, 3, 4, 5, MATRIX_LEFT);
+  const __m128 right_0 = load(0, 1, 2, 3, MATRIX_RIGHT);
+  const __m128 right_1 = load(4, 5, 0, 1, MATRIX_RIGHT);
+  const __m128 right_2 = load(2, 3, 4, 5, MATRIX_RIGHT);
+  const __m128 scale = _mm_set1_ps(SAMPLE_SCALE);
+
+  for (; i + 2 <= m_frame_block_size; i += 2)
+  {
+    // L0 R0 L1 R1
+    const __m128i samples = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(in + i * 2));
+    const __m128 input = _mm_mul_ps(
+        _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(samples, samples), 16)), scale);
+
+    float* frames = out + i * SURROUND_CHANNELS;
+    _mm_storeu_ps(frames,
+                  _mm_add_ps(_mm_mul_ps(_mm_shuffle_ps(input, input, 0x00), left_0),
+                             _mm_mul_ps(_mm_shuffle_ps(input, input, 0x55), right_0)));
+    _mm_storeu_ps(frames + 4,
+                  _mm_add_ps(_mm_mul_ps(_mm_shuffle_ps(input, input, 0xa0), left_1),
+                             _mm_mul_ps(_mm_shuffle_ps(input, input, 0xf5), right_1)));
+    _mm_storeu_ps(frames + 8,
+                  _mm_add_ps(_mm_mul_ps(_mm_shuffle_ps(input, input, 0xaa), left_2),
+                             _mm_mul_ps(_mm_shuffle_ps(input, input, 0xff), right_2)));
+  }
+#elif defined(_M_ARM_64)
+  const auto load = [](size_t first, size_t second, size_t third, size_t fourth,
+                       const std::array<float, SURROUND_CHANNELS>& column) {
+    const float values[4] = {column[first], column[second], column[third], column[fourth]};
+    return vld1q_f32(values);
+  };
+  const float32x4_t left_0 = load(0, 1, 2, 3, MATRIX_LEFT);
+  const float32x4_t left_1 = load(4, 5, 0, 1, MATRIX_LEFT);
+  const float32x4_t left_2 = load(2, 3, 4, 5, MATRIX_LEFT);
+  const float32x4_t right_0 = load(0, 1, 2, 3, MATRIX_RIGHT);
+  const float32x4_t right_1 = load(4, 5, 0, 1, MATRIX_RIGHT);
+  const float32x4_t right_2 = load(2, 3, 4, 5, MATRIX_RIGHT);
+
+  for (; i + 2 <= m_frame_block_size; i += 2)
+  {
+    // L0 R0 L1 R1
+    const float32x4_t input =
+        vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vld1_s16(in + i * 2))), SAMPLE_SCALE);
+    const float32x4_t l0_l1 = vcombine_f32(vdup_laneq_f32(input, 0), vdup_laneq_f32(input, 2));
+    const float32x4_t r0_r1 = vcombine_f32(vdup_laneq_f32(input, 1), vdup_laneq_f32(input, 3));
+
+    float* frames = out + i * SURROUND_CHANNELS;
+    vst1q_f32(frames, vfmaq_laneq_f32(vmulq_laneq_f32(left_0, input, 0), right_0, input, 1));
+    vst1q_f32(frames + 4, vfmaq_f32(vmulq_f32(left_1, l0_l1), right_1, r0_r1));
+    vst1q_f32(frames + 8, vfmaq_laneq_f32(vmulq_laneq_f32(left_2, input, 2), right_2, input, 3));
+  }
+#endif
+
+  for (; i < m_frame_block_size; ++i)
+  {
+    const float left = in[i * 2] * SAMPLE_SCALE;
+    const float right = in[i * 2 + 1] * SAMPLE_SCALE;
+    for (size_t channel = 0; channel < SURROUND_CHANNELS; ++channel)
     {
-      m_decoded_fifo.push(dpl2_fs[i * SURROUND_CHANNELS + 0]);  // LEFTFRONT
-      m_decoded_fifo.push(dpl2_fs[i * SURROUND_CHANNELS + 2]);  // RIGHTFRONT
-      m_decoded_fifo.push(dpl2_fs[i * SURROUND_CHANNELS + 1]);  // CENTREFRONT
-      m_decoded_fifo.push(dpl2_fs[i * SURROUND_CHANNELS + 5]);  // sub/lfe
-      m_decoded_fifo.push(dpl2_fs[i * SURROUND_CHANNELS + 3]);  // LEFTREAR
-      m_decoded_fifo.push(dpl2_fs[i * SURROUND_CHANNELS + 4]);  // RIGHTREAR
+      out[i * SURROUND_CHANNELS + channel] =
+          left * MATRIX_LEFT[channel] + right * MATRIX_RIGHT[channel];
     }
+  }
 
-    remaining_frames = remaining_frames - static_cast<int>(m_frame_block_size);
-    frame_index = frame_index + m_frame_block_size;
+  // The filter depends on its previous output, so it can't be vectorized over the frames
+  for (i = 0; i < m_frame_block_size; ++i)
+  {
+    const float mono = (in[i * 2] + in[i * 2 + 1]) * (SAMPLE_SCALE * 0.5f);
+    m_lfe += m_lfe_coefficient * (mono - m_lfe);
+    out[i * SURROUND_CHANNELS + 3] = m_lfe;
   }
 }
 
 void SurroundDecoder::ReceiveFrames(float* out, const size_t num_frames_out)
 {
   // Copy to output array with desired num_frames_out
-  for (size_t i = 0, num_samples_output = num_frames_out * SURROUND_CHANNELS;
-       i < num_samples_output; ++i)
-  {
-    out[i] = m_decoded_fifo.pop_front();
-  }
+  const size_t num_samples_output = num_frames_out * SURROUND_CHANNELS;
+  const size_t num_samples_copied =
+      std::min(num_samples_output, m_decoded.size() - m_decoded_position);
+  std::copy_n(m_decoded.begin() + m_decoded_position, num_samples_copied, out);
+  std::fill(out + num_samples_copied, out + num_samples_output, 0.0f);
+  m_decoded_position += num_samples_copied;
 }
 
 }  // namespace AudioCommon
@@ -5,9 +5,10 @@
 
 #include <array>
 #include <memory>
+#include <vector>
 
+#include "AudioCommon/Enums.h"
 #include "Common/CommonTypes.h"
-#include "Common/FixedSizeQueue.h"
 
 class DPL2FSDecoder;
 
@@ -23,13 +24,27 @@ public:
   void ReceiveFrames(float* out, const size_t num_frames_out);
   void Clear();
 
+  // Takes effect for the frames that are put in next
+  void SetMode(DPL2Mode mode);
+
 private:
+  void DecodeFreeSurround(const short* in, float* out);
+  void DecodeMatrix(const short* in, float* out);
+
   u32 m_sample_rate;
   u32 m_frame_block_size;
+  DPL2Mode m_mode = DPL2Mode::FreeSurround;
 
   std::unique_ptr<DPL2FSDecoder> m_fsdecoder;
   std::array<float, 32768> m_float_conversion_buffer;
-  Common::FixedSizeQueue<float, 32768> m_decoded_fifo;
+
+  // State of the low-pass filter that the matrix decoder derives the LFE channel with
+  float m_lfe_coefficient;
+  float m_lfe = 0.0f;
+
+  // Decoded frames in the backend channel order, from m_decoded_position on
+  std::vector<float> m_decoded;
+  size_t m_decoded_position = 0;
 };
 
 }  // namespace AudioCommon
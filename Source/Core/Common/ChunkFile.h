@@ -46,14 +46,27 @@ public:
     Verify,
   };
 
+  // An array that DoArrayInPlace referenced instead of copying it into the buffer. The serialized
+  // data is the buffer with the array inserted at offset.
+  struct ExternalRegion
+  {
+    size_t offset;
+    const u8* data;
+    u32 size;
+  };
+
 private:
   u8** m_ptr_current;
+  u8* m_ptr_start;
   u8* m_ptr_end;
   Mode m_mode;
+  std::vector<ExternalRegion>* m_external_regions;
 
 public:
-  PointerWrap(u8** ptr, size_t size, Mode mode)
-      : m_ptr_current(ptr), m_ptr_end(*ptr + size), m_mode(mode)
+  PointerWrap(u8** ptr, size_t size, Mode mode,
+              std::vector<ExternalRegion>* external_regions = nullptr)
+      : m_ptr_current(ptr), m_ptr_start(*ptr), m_ptr_end(*ptr + size), m_mode(mode),
+        m_external_regions(external_regions)
   {
   }
 
@@ -214,6 +227,24 @@ public:
     DoArray(arr, static_cast<u32>(N));
   }
 
+  // Like DoArray, but if the PointerWrap has a list of external regions, writing only records
+  // where the array belongs instead of copying it, and measuring doesn't count it. The array must
+  // stay unchanged until the caller is done with the serialized data.
+  void DoArrayInPlace(u8* data, u32 size)
+  {
+    if (!m_external_regions || !(IsWriteMode() || IsMeasureMode()))
+    {
+      DoArray(data, size);
+      return;
+    }
+
+    if (IsWriteMode())
+    {
+      const size_t offset = static_cast<size_t>(*m_ptr_current - m_ptr_start);
+      m_external_regions->push_back({offset, data, size});
+    }
+  }
+
   // The caller is required to inspect the mode of this PointerWrap
   // and deal with the pointer returned from this function themself.
   [[nodiscard]] u8* DoExternal(u32& count)
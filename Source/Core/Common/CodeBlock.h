@@ -57,6 +57,8 @@ public:
     T::SetCodePtr(region, region + size);
   }
 
+  void AdviseHugePages() { Common::AdviseHugePages(region, total_region_size); }
+
   // Always clear code space with breakpoints, so that if someone accidentally executes
   // uninitialized, it just breaks into the debugger.
   void ClearCodeSpace()
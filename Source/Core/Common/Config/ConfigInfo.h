@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <mutex>
 #include <shared_mutex>
 #include <string>
@@ -39,12 +40,95 @@ struct CachedValue
   u64 config_version;
 };
 
+namespace detail
+{
+template <typename T>
+constexpr bool IsAtomicallyCacheable()
+{
+  if constexpr (std::is_trivially_copyable_v<T>)
+    return std::atomic<T>::is_always_lock_free;
+  else
+    return false;
+}
+
+template <typename T, bool = IsAtomicallyCacheable<T>()>
+class CachedValueStorage
+{
+public:
+  CachedValueStorage() = default;
+  constexpr explicit CachedValueStorage(const T& value) : m_value{value, 0} {}
+
+  CachedValue<T> Load() const
+  {
+    std::shared_lock lock(m_mutex);
+    return m_value;
+  }
+
+  void Store(const CachedValue<T>& value)
+  {
+    std::unique_lock lock(m_mutex);
+    m_value = value;
+  }
+
+  void StoreIfNewer(const CachedValue<T>& value)
+  {
+    std::unique_lock lock(m_mutex);
+    if (m_value.config_version < value.config_version)
+      m_value = value;
+  }
+
+private:
+  CachedValue<T> m_value;
+  mutable std::shared_mutex m_mutex;
+};
+
+// Most settings are bools, numbers and enums, and some of them are read on every frame or every
+// event. Those are read without taking a lock. The value is published before its version, so a
+// reader that sees a version gets a value that is at least as recent as it.
+template <typename T>
+class CachedValueStorage<T, true>
+{
+public:
+  CachedValueStorage() = default;
+  constexpr explicit CachedValueStorage(const T& value) : m_value{value}, m_config_version{0} {}
+
+  CachedValue<T> Load() const
+  {
+    const u64 config_version = m_config_version.load(std::memory_order_acquire);
+    return CachedValue<T>{m_value.load(std::memory_order_relaxed), config_version};
+  }
+
+  void Store(const CachedValue<T>& value)
+  {
+    std::lock_guard lock(m_mutex);
+    m_value.store(value.value, std::memory_order_relaxed);
+    m_config_version.store(value.config_version, std::memory_order_release);
+  }
+
+  void StoreIfNewer(const CachedValue<T>& value)
+  {
+    std::lock_guard lock(m_mutex);
+    if (m_config_version.load(std::memory_order_relaxed) < value.config_version)
+    {
+      m_value.store(value.value, std::memory_order_relaxed);
+      m_config_version.store(value.config_version, std::memory_order_release);
+    }
+  }
+
+private:
+  std::atomic<T> m_value;
+  std::atomic<u64> m_config_version{0};
+  // Only taken by writers
+  std::mutex m_mutex;
+};
+}  // namespace detail
+
 template <typename T>
 class Info
 {
 public:
   constexpr Info(const Location& location, const T& default_value)
-      : m_location{location}, m_default_value{default_value}, m_cached_value{default_value, 0}
+      : m_location{location}, m_default_value{default_value}, m_cached_value{default_value}
   {
   }
 
@@ -66,7 +150,7 @@ public:
   {
     m_location = other.GetLocation();
     m_default_value = other.GetDefaultValue();
-    m_cached_value = other.GetCachedValue();
+    m_cached_value.Store(other.GetCachedValue());
     return *this;
   }
 
@@ -75,7 +159,7 @@ public:
   {
     m_location = std::move(other.m_location);
     m_default_value = std::move(other.m_default_value);
-    m_cached_value = std::move(other.m_cached_value);
+    m_cached_value.Store(other.GetCachedValue());
     return *this;
   }
 
@@ -87,38 +171,31 @@ public:
   {
     m_location = other.GetLocation();
     m_default_value = static_cast<T>(other.GetDefaultValue());
-    m_cached_value = other.template GetCachedValueCasted<T>();
+    m_cached_value.Store(other.template GetCachedValueCasted<T>());
     return *this;
   }
 
   constexpr const Location& GetLocation() const { return m_location; }
   constexpr const T& GetDefaultValue() const { return m_default_value; }
 
-  CachedValue<T> GetCachedValue() const
-  {
-    std::shared_lock lock(m_cached_value_mutex);
-    return m_cached_value;
-  }
+  CachedValue<T> GetCachedValue() const { return m_cached_value.Load(); }
 
   template <typename U>
   CachedValue<U> GetCachedValueCasted() const
   {
-    std::shared_lock lock(m_cached_value_mutex);
-    return CachedValue<U>{static_cast<U>(m_cached_value.value), m_cached_value.config_version};
+    const CachedValue<T> cached_value = m_cached_value.Load();
+    return CachedValue<U>{static_cast<U>(cached_value.value), cached_value.config_version};
   }
 
   void SetCachedValue(const CachedValue<T>& cached_value) const
   {
-    std::unique_lock lock(m_cached_value_mutex);
-    if (m_cached_value.config_version < cached_value.config_version)
-      m_cached_value = cached_value;
+    m_cached_value.StoreIfNewer(cached_value);
   }
 
 private:
   Location m_location;
   T m_default_value;
 
-  mutable CachedValue<T> m_cached_value;
-  mutable std::shared_mutex m_cached_value_mutex;
+  mutable detail::CachedValueStorage<T> m_cached_value;
 };
 }  // namespace Config
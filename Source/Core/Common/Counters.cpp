@@ -0,0 +1,149 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Common/Counters.h"
+
+#include <algorithm>
+#include <iterator>
+#include <mutex>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
+#include "Common/Thread.h"
+
+namespace Common
+{
+namespace
+{
+struct Registry
+{
+  std::mutex mutex;
+  std::vector<const Counter*> counters;
+};
+
+// Counters are constructed during static initialization, so the registry has to be created on
+// first use
+Registry& GetRegistry()
+{
+  static Registry registry;
+  return registry;
+}
+
+std::vector<const Counter*> GetSortedCounters(std::unique_lock<std::mutex>* lock)
+{
+  Registry& registry = GetRegistry();
+  *lock = std::unique_lock(registry.mutex);
+  std::vector<const Counter*> counters = registry.counters;
+  std::sort(counters.begin(), counters.end(),
+            [](const Counter* a, const Counter* b) { return a->GetName() < b->GetName(); });
+  return counters;
+}
+}  // namespace
+
+Counter::Counter(std::string_view name, std::string_view help, Type type)
+    : m_name(name), m_help(help), m_type(type)
+{
+  Registry& registry = GetRegistry();
+  std::lock_guard lk(registry.mutex);
+  registry.counters.push_back(this);
+}
+
+Counter::~Counter()
+{
+  Registry& registry = GetRegistry();
+  std::lock_guard lk(registry.mutex);
+  std::erase(registry.counters, this);
+}
+
+std::string FormatCountersAsPrometheus()
+{
+  std::unique_lock<std::mutex> lock;
+  std::string text;
+  for (const Counter* counter : GetSortedCounters(&lock))
+  {
+    fmt::format_to(std::back_inserter(text), "# HELP {0} {1}\n# TYPE {0} {2}\n{0} {3}\n",
+                   counter->GetName(), counter->GetHelp(),
+                   counter->GetType() == Counter::Type::Gauge ? "gauge" : "counter",
+                   counter->Get());
+  }
+  return text;
+}
+
+std::string FormatCountersAsJSON()
+{
+  std::unique_lock<std::mutex> lock;
+  std::string json = "{";
+  bool first = true;
+  for (const Counter* counter : GetSortedCounters(&lock))
+  {
+    fmt::format_to(std::back_inserter(json), "{}\"{}\":{}", first ? "" : ",", counter->GetName(),
+                   counter->Get());
+    first = false;
+  }
+  json += "}\n";
+  return json;
+}
+
+bool WriteCounters(const std::string& path)
+{
+  const std::string text =
+      path.ends_with(".json") ? FormatCountersAsJSON() : FormatCountersAsPrometheus();
+  const std::string temp_path = path + ".tmp";
+  if (!File::WriteStringToFile(temp_path, text) || !File::Rename(temp_path, path))
+  {
+    File::Delete(temp_path, File::IfAbsentBehavior::NoConsoleWarning);
+    return false;
+  }
+  return true;
+}
+
+CounterWriter::~CounterWriter()
+{
+  Stop();
+}
+
+void CounterWriter::Start(const std::string& path, std::chrono::milliseconds interval)
+{
+  interval = std::max(interval, std::chrono::milliseconds(100));
+  if (m_thread.joinable() && path == m_path && interval == m_interval)
+    return;
+
+  Stop();
+  if (path.empty())
+    return;
+
+  m_path = path;
+  m_interval = interval;
+  m_thread = std::thread(&CounterWriter::ThreadFunc, this);
+}
+
+void CounterWriter::Stop()
+{
+  if (!m_thread.joinable())
+    return;
+
+  m_stop_event.Set();
+  m_thread.join();
+}
+
+void CounterWriter::ThreadFunc()
+{
+  SetCurrentThreadName("Counter writer");
+
+  bool failed = false;
+  do
+  {
+    // Only logged once, rather than at every interval
+    const bool success = WriteCounters(m_path);
+    if (!success && !failed)
+      ERROR_LOG_FMT(COMMON, "Failed to write the counters to {}", m_path);
+    failed = !success;
+  } while (!m_stop_event.WaitFor(m_interval));
+
+  // The last values are written as well, so that nothing that happened before a shutdown is lost
+  WriteCounters(m_path);
+}
+}  // namespace Common
@@ -0,0 +1,86 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include "Common/CommonTypes.h"
+#include "Common/Event.h"
+
+namespace Common
+{
+// A value that is cheap enough to update on hot paths, for monitoring long running instances.
+// Counters are defined at namespace scope and add themselves to a registry, from which all of them
+// are written out together.
+class Counter final
+{
+public:
+  enum class Type
+  {
+    // Only goes up
+    Counter,
+    // Goes up and down
+    Gauge,
+  };
+
+  // name has to follow the naming rules of Prometheus metrics
+  Counter(std::string_view name, std::string_view help, Type type = Type::Counter);
+  ~Counter();
+
+  Counter(const Counter&) = delete;
+  Counter& operator=(const Counter&) = delete;
+
+  void Add(u64 value = 1) { m_value.fetch_add(value, std::memory_order_relaxed); }
+  void Set(u64 value) { m_value.store(value, std::memory_order_relaxed); }
+  u64 Get() const { return m_value.load(std::memory_order_relaxed); }
+
+  const std::string& GetName() const { return m_name; }
+  const std::string& GetHelp() const { return m_help; }
+  Type GetType() const { return m_type; }
+
+private:
+  std::string m_name;
+  std::string m_help;
+  Type m_type;
+  std::atomic<u64> m_value = 0;
+};
+
+// All counters in the Prometheus text format, sorted by name
+std::string FormatCountersAsPrometheus();
+// All counters as a JSON object of their names and values
+std::string FormatCountersAsJSON();
+
+// Writes the counters to path, as JSON if it ends with .json and in the Prometheus text format
+// otherwise. The file is replaced at once, so that the node exporter textfile collector and other
+// readers never see a partially written file.
+bool WriteCounters(const std::string& path);
+
+// Writes the counters to a file periodically on a thread of its own
+class CounterWriter final
+{
+public:
+  CounterWriter() = default;
+  ~CounterWriter();
+
+  CounterWriter(const CounterWriter&) = delete;
+  CounterWriter& operator=(const CounterWriter&) = delete;
+
+  // Restarts the writer if it was writing to another path or at another interval. An empty path
+  // stops it.
+  void Start(const std::string& path, std::chrono::milliseconds interval);
+  void Stop();
+
+private:
+  void ThreadFunc();
+
+  std::string m_path;
+  std::chrono::milliseconds m_interval{};
+  std::thread m_thread;
+  Event m_stop_event;
+};
+}  // namespace Common
@@ -6,9 +6,11 @@
 #include <algorithm>
 #include <cmath>
 #include <cstdlib>
+#include <cstring>
 #include <mutex>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 #include <fmt/format.h>
@@ -355,6 +357,95 @@ static u64 GetSize(const File::FSTEntry& entry)
   return size;
 }
 
+// Compares the contents of a host file against a file in the SD image, both read from the start
+static bool ContentsMatch(File::IOFile& host_file, FIL* image_file, u64 size,
+                          std::vector<u8>& tmp_buffer)
+{
+  const size_t half = tmp_buffer.size() / 2;
+  u8* const host_data = tmp_buffer.data();
+  u8* const image_data = tmp_buffer.data() + half;
+
+  while (size > 0)
+  {
+    const u32 chunk_size = static_cast<u32>(std::min(size, static_cast<u64>(half)));
+    u32 read_size;
+    if (!host_file.ReadBytes(host_data, chunk_size) ||
+        f_read(image_file, image_data, chunk_size, &read_size) != FR_OK ||
+        read_size != chunk_size || std::memcmp(host_data, image_data, chunk_size) != 0)
+    {
+      return false;
+    }
+
+    size -= chunk_size;
+  }
+
+  return true;
+}
+
+// Lists the directory in the SD image that is the current directory, as name and is_directory
+static bool ReadImageDirectory(std::vector<std::pair<std::string, bool>>* children)
+{
+  DIR directory{};
+  if (f_opendir(&directory, ".") != FR_OK)
+    return false;
+
+  FILINFO entry{};
+  while (f_readdir(&directory, &entry) == FR_OK && entry.fname[0] != '\0')
+  {
+    // Entries without a name are likely corrupted, see Unpack()
+    if (entry.fname[0] == '?' && entry.fname[1] == '\0' && entry.altname[0] == '\0')
+      continue;
+    children->emplace_back(entry.fname, (entry.fattrib & AM_DIR) != 0);
+  }
+
+  return f_closedir(&directory) == FR_OK;
+}
+
+static bool DeleteFromImage(const std::string& name, bool is_directory)
+{
+  if (is_directory)
+  {
+    if (f_chdir(name.c_str()) != FR_OK)
+      return false;
+
+    std::vector<std::pair<std::string, bool>> children;
+    if (!ReadImageDirectory(&children))
+      return false;
+    for (const auto& [child_name, child_is_directory] : children)
+    {
+      if (!DeleteFromImage(child_name, child_is_directory))
+        return false;
+    }
+
+    if (f_chdir("..") != FR_OK)
+      return false;
+  }
+
+  const auto unlink_error_code = f_unlink(name.c_str());
+  if (unlink_error_code != FR_OK)
+  {
+    ERROR_LOG_FMT(COMMON, "Failed to delete {} from SD image: {}", name,
+                  FatFsErrorToString(unlink_error_code));
+    return false;
+  }
+
+  return true;
+}
+
+static bool ImageFileMatches(const File::FSTEntry& entry, std::vector<u8>& tmp_buffer)
+{
+  FIL image_file{};
+  if (f_open(&image_file, entry.virtualName.c_str(), FA_READ) != FR_OK)
+    return false;
+  Common::ScopeGuard close_guard{[&] { f_close(&image_file); }};
+
+  if (f_size(&image_file) != entry.size)
+    return false;
+
+  File::IOFile host_file(entry.physicalName, "rb");
+  return host_file && ContentsMatch(host_file, &image_file, entry.size, tmp_buffer);
+}
+
 static bool Pack(const std::function<bool()>& cancelled, const File::FSTEntry& entry, bool is_root,
                  std::vector<u8>& tmp_buffer)
 {
@@ -483,6 +574,98 @@ static bool Pack(const std::function<bool()>& cancelled, const File::FSTEntry& e
   return true;
 }
 
+// Brings the current directory of the SD image up to date with the given folder. Only the files
+// that were added or changed are written, and the entries that are gone are deleted.
+static bool Update(const std::function<bool()>& cancelled, const File::FSTEntry& entry,
+                   std::vector<u8>& tmp_buffer)
+{
+  std::vector<std::pair<std::string, bool>> image_children;
+  if (!ReadImageDirectory(&image_children))
+  {
+    ERROR_LOG_FMT(COMMON, "Failed to read directory {} in SD image", entry.physicalName);
+    return false;
+  }
+
+  // Compared case-sensitively, so that renames which only change the case are carried over
+  for (const auto& [name, is_directory] : image_children)
+  {
+    const bool still_exists = std::any_of(
+        entry.children.begin(), entry.children.end(), [&](const File::FSTEntry& child) {
+          return child.virtualName == name && child.isDirectory == is_directory;
+        });
+    if (!still_exists && !DeleteFromImage(name, is_directory))
+      return false;
+  }
+
+  for (const File::FSTEntry& child : entry.children)
+  {
+    if (cancelled())
+      return false;
+
+    FILINFO info{};
+    const bool exists = f_stat(child.virtualName.c_str(), &info) == FR_OK;
+    if (!exists || (!child.isDirectory && !ImageFileMatches(child, tmp_buffer)))
+    {
+      if (!Pack(cancelled, child, false, tmp_buffer))
+        return false;
+      continue;
+    }
+
+    if (!child.isDirectory)
+      continue;
+
+    const auto chdir_error_code = f_chdir(child.virtualName.c_str());
+    if (chdir_error_code != FR_OK)
+    {
+      ERROR_LOG_FMT(COMMON, "Failed to enter directory {} in SD image: {}", child.physicalName,
+                    FatFsErrorToString(chdir_error_code));
+      return false;
+    }
+
+    if (!Update(cancelled, child, tmp_buffer))
+      return false;
+
+    const auto chdir_up_error_code = f_chdir("..");
+    if (chdir_up_error_code != FR_OK)
+    {
+      ERROR_LOG_FMT(COMMON, "Failed to leave directory {} in SD image: {}", child.physicalName,
+                    FatFsErrorToString(chdir_up_error_code));
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Updates the existing SD image in place. Fails if there is no usable image, in which case the
+// caller builds a new one.
+static bool UpdateSDImage(const std::function<bool()>& cancelled, const File::FSTEntry& root,
+                          const std::string& image_path, u64 size, bool size_is_configured,
+                          File::IOFile& image)
+{
+  if (!image.Open(image_path, "r+b"))
+    return false;
+  Common::ScopeGuard close_guard{[&] { image.Close(); }};
+
+  // An image that is too small for the folder would run out of space halfway through
+  const u64 image_size = image.GetSize();
+  if (size_is_configured ? image_size != size : image_size < GetSize(root))
+    return false;
+
+  FATFS fs{};
+  if (f_mount(&fs, "", 1) != FR_OK)
+    return false;
+  Common::ScopeGuard unmount_guard{[] { f_unmount(""); }};
+
+  std::vector<u8> tmp_buffer(MAX_CLUSTER_SIZE);
+  if (!Update(cancelled, root, tmp_buffer))
+    return false;
+
+  unmount_guard.Exit();  // unmount before closing the image
+  close_guard.Dismiss();
+  return image.Close();
+}
+
 static void SortFST(File::FSTEntry* root)
 {
   std::sort(root->children.begin(), root->children.end(),
@@ -516,7 +699,8 @@ bool SyncSDFolderToSDImage(const std::function<bool()>& cancelled, bool determin
     return false;
 
   u64 size = Config::Get(Config::MAIN_WII_SD_CARD_FILESIZE);
-  if (size == 0)
+  const bool size_is_configured = size != 0;
+  if (!size_is_configured)
   {
     size = GetSize(root);
     // Allocate a reasonable amount of free space
@@ -533,6 +717,17 @@ bool SyncSDFolderToSDImage(const std::function<bool()>& cancelled, bool determin
   callbacks.m_image = &image;
   callbacks.m_deterministic = deterministic;
 
+  // A deterministic image has to be laid out the same way every time, so it is always rebuilt
+  if (!deterministic &&
+      UpdateSDImage(cancelled, root, image_path, size, size_is_configured, image))
+  {
+    INFO_LOG_FMT(COMMON, "Successfully updated SD image at {} from folder {}", image_path,
+                 source_dir);
+    return true;
+  }
+  if (cancelled())
+    return false;
+
   const std::string temp_image_path = File::GetTempFilenameForAtomicWrite(image_path);
   if (!image.Open(temp_image_path, "w+b"))
   {
@@ -623,12 +818,33 @@ static bool Unpack(const std::function<bool()>& cancelled, const std::string pat
       return false;
     }
 
-    File::IOFile dst(path, "wb");
+    if (File::IsDirectory(path) && !File::DeleteDirRecursively(path))
+    {
+      ERROR_LOG_FMT(COMMON, "Failed to delete directory {}", path);
+      return false;
+    }
+
+    // Leave the files that haven't changed alone
+    if (File::GetSize(path) == f_size(&src))
+    {
+      File::IOFile host_file(path, "rb");
+      if (host_file && ContentsMatch(host_file, &src, f_size(&src), tmp_buffer))
+        return f_close(&src) == FR_OK;
+      f_lseek(&src, 0);
+    }
+
+    // Write to a temporary file first, so that a failed sync leaves the old file behind
+    const std::string temp_path = File::GetTempFilenameForAtomicWrite(path);
+    File::IOFile dst(temp_path, "wb");
     if (!dst)
     {
-      ERROR_LOG_FMT(COMMON, "Failed to open file {}", path);
+      ERROR_LOG_FMT(COMMON, "Failed to open file {}", temp_path);
       return false;
     }
+    Common::ScopeGuard temp_delete_guard{[&] {
+      dst.Close();
+      File::Delete(temp_path);
+    }};
 
     u32 size = f_size(&src);
     while (size > 0)
@@ -664,10 +880,17 @@ static bool Unpack(const std::function<bool()>& cancelled, const std::string pat
 
     if (!dst.Close())
     {
-      ERROR_LOG_FMT(COMMON, "Failed to close file {}", path);
+      ERROR_LOG_FMT(COMMON, "Failed to close file {}", temp_path);
       return false;
     }
 
+    if (!File::Rename(temp_path, path))
+    {
+      ERROR_LOG_FMT(COMMON, "Failed to rename {} to {}", temp_path, path);
+      return false;
+    }
+    temp_delete_guard.Dismiss();
+
     const auto close_error_code = f_close(&src);
     if (close_error_code != FR_OK)
     {
@@ -679,6 +902,12 @@ static bool Unpack(const std::function<bool()>& cancelled, const std::string pat
     return true;
   }
 
+  if (File::Exists(path) && !File::IsDirectory(path) && !File::Delete(path))
+  {
+    ERROR_LOG_FMT(COMMON, "Failed to delete file {}", path);
+    return false;
+  }
+
   if (!File::CreateDir(path))
   {
     ERROR_LOG_FMT(COMMON, "Failed to create directory {}", path);
@@ -693,6 +922,33 @@ static bool Unpack(const std::function<bool()>& cancelled, const std::string pat
     return false;
   }
 
+  // Delete what is gone from the SD image. This is case-sensitive, like Update().
+  std::vector<std::pair<std::string, bool>> image_children;
+  if (!ReadImageDirectory(&image_children))
+  {
+    ERROR_LOG_FMT(COMMON, "Failed to read directory {} in SD image", path);
+    return false;
+  }
+  for (const File::FSTEntry& host_child : File::ScanDirectoryTree(path, false).children)
+  {
+    const bool still_exists = std::any_of(
+        image_children.begin(), image_children.end(), [&](const auto& image_child) {
+          return image_child.first == host_child.virtualName &&
+                 image_child.second == host_child.isDirectory;
+        });
+    if (still_exists)
+      continue;
+
+    const bool deleted = host_child.isDirectory ?
+                             File::DeleteDirRecursively(host_child.physicalName) :
+                             File::Delete(host_child.physicalName);
+    if (!deleted)
+    {
+      ERROR_LOG_FMT(COMMON, "Failed to delete {}", host_child.physicalName);
+      return false;
+    }
+  }
+
   DIR directory{};
   const auto opendir_error_code = f_opendir(&directory, ".");
   if (opendir_error_code != FR_OK)
@@ -803,39 +1059,20 @@ bool SyncSDImageToSDFolder(const std::function<bool()>& cancelled)
   }
   Common::ScopeGuard unmount_guard{[] { f_unmount(""); }};
 
-  // Unpack() and GetTempFilenameForAtomicWrite() don't want the trailing separator.
+  // Unpack() doesn't want the trailing separator.
   const std::string target_dir_without_slash = target_dir.substr(0, target_dir.length() - 1);
 
-  // Most systems don't offer atomic directory renaming, so it's simpler to directly work on the
-  // actual one and rollback if needed.
-  const bool target_dir_exists = File::IsDirectory(target_dir);
-  const std::string backup_target_dir_without_slash =
-      File::GetTempFilenameForAtomicWrite(target_dir_without_slash);
-
-  if (target_dir_exists)
-  {
-    if (!File::Rename(target_dir_without_slash, backup_target_dir_without_slash))
-    {
-      ERROR_LOG_FMT(COMMON, "Failed to move old SD folder to {}", backup_target_dir_without_slash);
-      return false;
-    }
-  }
-
+  // The folder is updated in place, so only the files that have changed are written. Every file
+  // is written atomically, so a failed sync leaves each file either in its old or its new state.
   std::vector<u8> tmp_buffer(MAX_CLUSTER_SIZE);
   if (!Unpack(cancelled, target_dir_without_slash, true, "", tmp_buffer))
   {
     ERROR_LOG_FMT(COMMON, "Failed to unpack SD image {} to {}", image_path, target_dir);
-    File::DeleteDirRecursively(target_dir_without_slash);
-    if (target_dir_exists)
-      File::Rename(backup_target_dir_without_slash, target_dir_without_slash);
     return false;
   }
 
   unmount_guard.Exit();  // unmount before closing the image
 
-  if (target_dir_exists)
-    File::DeleteDirRecursively(backup_target_dir_without_slash);
-
   // even if this fails the conversion has already succeeded, so we still return true
   if (!image.Close())
     ERROR_LOG_FMT(COMMON, "Failed to close SD image {}", image_path);
@@ -979,6 +979,9 @@ PFNDOLCLIPCONTROLPROC dolClipControl;
 // ARB_copy_image
 PFNDOLCOPYIMAGESUBDATAPROC dolCopyImageSubData;
 
+// KHR_parallel_shader_compile
+PFNDOLMAXSHADERCOMPILERTHREADSPROC dolMaxShaderCompilerThreads;
+
 // ARB_shader_storage_buffer_object
 PFNDOLSHADERSTORAGEBLOCKBINDINGPROC dolShaderStorageBlockBinding;
 
@@ -2101,6 +2104,11 @@ const GLFunc gl_function_array[] = {
     // ARB_copy_image
     GLFUNC_REQUIRES(glCopyImageSubData, "GL_ARB_copy_image !VERSION_4_3 |VERSION_GLES_3_2"),
 
+    // KHR_parallel_shader_compile
+    GLFUNC_SUFFIX(glMaxShaderCompilerThreads, KHR, "GL_KHR_parallel_shader_compile"),
+    GLFUNC_SUFFIX(glMaxShaderCompilerThreads, ARB,
+                  "GL_ARB_parallel_shader_compile !GL_KHR_parallel_shader_compile"),
+
     // NV_copy_image
     GLFUNC_SUFFIX(glCopyImageSubData, NV, "GL_NV_copy_image !GL_ARB_copy_image !VERSION_GLES_3_2"),
 
@@ -7,6 +7,7 @@
 #include <bit>
 #include <cstring>
 
+#include <xxhash.h>
 #include <zlib.h>
 
 #include "Common/BitUtils.h"
@@ -451,6 +452,11 @@ u64 GetHash64(const u8* src, u32 len, u32 samples)
   return s_texture_hash_func(src, len, samples);
 }
 
+u64 HashData(const void* data, size_t len, u64 seed)
+{
+  return XXH64(data, len, seed);
+}
+
 u32 StartCRC32()
 {
   return crc32_z(0L, Z_NULL, 0);
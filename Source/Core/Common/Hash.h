@@ -14,9 +14,14 @@ u32 HashAdler32(const u8* data, size_t len);
 // JUNK. DO NOT USE FOR NEW THINGS
 u32 HashEctor(const u8* data, size_t len);
 
-// Specialized hash function used for the texture cache
+// Specialized hash function used for the texture cache. It's picked at runtime for the host, can
+// hash just a sample of the data, and gives different results on different hosts.
 u64 GetHash64(const u8* src, u32 len, u32 samples);
 
+// Hash for cache keys and anything else that isn't sampled. It's XXH64, so the results are the same
+// on every host and can be stored on disk.
+u64 HashData(const void* data, size_t len, u64 seed = 0);
+
 u32 StartCRC32();
 u32 UpdateCRC32(u32 crc, const u8* data, size_t len);
 u32 ComputeCRC32(const u8* data, size_t len);
@@ -3,6 +3,7 @@
 
 #include "Common/HttpRequest.h"
 
+#include <array>
 #include <chrono>
 #include <cstddef>
 #include <mutex>
@@ -15,6 +16,50 @@
 
 namespace Common
 {
+namespace
+{
+// Lets all requests reuse each other's connections, DNS lookups and TLS sessions, so that
+// short-lived HttpRequest objects don't pay for a new handshake when talking to the same server.
+class SharedCache final
+{
+public:
+  SharedCache()
+  {
+    m_share = curl_share_init();
+    if (!m_share)
+      return;
+
+    curl_share_setopt(m_share, CURLSHOPT_LOCKFUNC, Lock);
+    curl_share_setopt(m_share, CURLSHOPT_UNLOCKFUNC, Unlock);
+    curl_share_setopt(m_share, CURLSHOPT_USERDATA, this);
+    curl_share_setopt(m_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+    curl_share_setopt(m_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+    curl_share_setopt(m_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
+  }
+
+  // Easy handles can live in static objects, so the cache is never cleaned up
+  static CURLSH* Get()
+  {
+    static SharedCache* const s_cache = new SharedCache();
+    return s_cache->m_share;
+  }
+
+private:
+  static void Lock(CURL*, curl_lock_data data, curl_lock_access, void* userdata)
+  {
+    static_cast<SharedCache*>(userdata)->m_mutexes[data].lock();
+  }
+
+  static void Unlock(CURL*, curl_lock_data data, void* userdata)
+  {
+    static_cast<SharedCache*>(userdata)->m_mutexes[data].unlock();
+  }
+
+  CURLSH* m_share = nullptr;
+  std::array<std::mutex, CURL_LOCK_DATA_LAST> m_mutexes;
+};
+}  // namespace
+
 class HttpRequest::Impl final
 {
 public:
@@ -125,6 +170,12 @@ HttpRequest::Impl::Impl(std::chrono::milliseconds timeout_ms, ProgressCallback c
   if (!m_curl)
     return;
 
+  if (CURLSH* share = SharedCache::Get())
+    curl_easy_setopt(m_curl.get(), CURLOPT_SHARE, share);
+  // Keep idle pooled connections from being dropped by NATs and proxies
+  curl_easy_setopt(m_curl.get(), CURLOPT_TCP_KEEPALIVE, 1L);
+  curl_easy_setopt(m_curl.get(), CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS);
+
   curl_easy_setopt(m_curl.get(), CURLOPT_NOPROGRESS, m_callback == nullptr);
 
   if (m_callback)
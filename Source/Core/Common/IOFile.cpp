@@ -3,12 +3,15 @@
 
 #include "Common/IOFile.h"
 
+#include <algorithm>
+#include <cerrno>
 #include <cstddef>
 #include <cstdio>
 #include <string>
 
 #ifdef _WIN32
 #include <io.h>
+#include <windows.h>
 
 #include "Common/CommonFuncs.h"
 #include "Common/StringUtil.h"
@@ -17,8 +20,6 @@
 #endif
 
 #ifdef ANDROID
-#include <algorithm>
-
 #include "jni/AndroidCommon/AndroidCommon.h"
 #endif
 
@@ -157,6 +158,40 @@ u64 IOFile::Tell() const
     return UINT64_MAX;
 }
 
+bool IOFile::ReadAt(void* data, size_t length, u64 offset) const
+{
+  if (!IsOpen())
+    return false;
+
+  u8* out = static_cast<u8*>(data);
+  while (length > 0)
+  {
+#ifdef _WIN32
+    // ReadFile with an offset is a positional read even though the handle isn't overlapped
+    const HANDLE handle = reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(m_file)));
+    OVERLAPPED overlapped{};
+    overlapped.Offset = static_cast<DWORD>(offset);
+    overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+    const DWORD to_read = static_cast<DWORD>(std::min<size_t>(length, 0x40000000));
+    DWORD bytes_read = 0;
+    if (!ReadFile(handle, out, to_read, &bytes_read, &overlapped) || bytes_read == 0)
+      return false;
+#else
+    const ssize_t bytes_read = pread(fileno(m_file), out, length, static_cast<off_t>(offset));
+    if (bytes_read < 0 && errno == EINTR)
+      continue;
+    if (bytes_read <= 0)
+      return false;
+#endif
+
+    out += bytes_read;
+    offset += bytes_read;
+    length -= bytes_read;
+  }
+
+  return true;
+}
+
 bool IOFile::Flush()
 {
   if (!IsOpen() || 0 != std::fflush(m_file))
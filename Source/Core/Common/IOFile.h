@@ -99,6 +99,11 @@ public:
 
   bool WriteString(std::string_view str) { return WriteBytes(str.data(), str.size()); }
 
+  // Reads length bytes at the given offset without going through the stdio buffer. Several
+  // threads may call this at once on the same file. The error state is left untouched, and on
+  // Windows the position of the underlying handle moves, so Seek before mixing this with ReadBytes.
+  bool ReadAt(void* data, size_t length, u64 offset) const;
+
   bool IsOpen() const { return nullptr != m_file; }
   // m_good is set to false when a read, write or other function fails
   bool IsGood() const { return m_good; }
@@ -5,9 +5,13 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <filesystem>
 #include <fstream>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <system_error>
 #include <string_view>
 #include <utility>
 #include <vector>
@@ -17,6 +21,19 @@
 
 namespace Common
 {
+namespace
+{
+struct CachedIniFile
+{
+  std::filesystem::file_time_type last_write_time;
+  u64 size;
+  std::shared_ptr<const IniFile> ini;
+};
+
+std::mutex s_cache_mutex;
+std::map<std::string, CachedIniFile> s_cache;
+}  // namespace
+
 void IniFile::ParseLine(std::string_view line, std::string* keyOut, std::string* valueOut)
 {
   if (line.empty() || line.front() == '#')
@@ -124,28 +141,44 @@ bool IniFile::Section::GetLines(std::vector<std::string>* lines, const bool remo
 
 IniFile::IniFile() = default;
 
-IniFile::~IniFile() = default;
+IniFile::IniFile(const IniFile& other) : sections{other.sections}
+{
+  RebuildSectionIndex();
+}
 
-const IniFile::Section* IniFile::GetSection(std::string_view section_name) const
+IniFile::IniFile(IniFile&& other) = default;
+
+IniFile& IniFile::operator=(const IniFile& other)
 {
-  for (const Section& sect : sections)
+  if (this != &other)
   {
-    if (CaseInsensitiveStringCompare::IsEqual(sect.name, section_name))
-      return &sect;
+    sections = other.sections;
+    RebuildSectionIndex();
   }
-
-  return nullptr;
+  return *this;
 }
 
-IniFile::Section* IniFile::GetSection(std::string_view section_name)
+IniFile& IniFile::operator=(IniFile&& other) = default;
+
+IniFile::~IniFile() = default;
+
+void IniFile::RebuildSectionIndex()
 {
+  m_section_index.clear();
   for (Section& sect : sections)
-  {
-    if (CaseInsensitiveStringCompare::IsEqual(sect.name, section_name))
-      return &sect;
-  }
+    m_section_index.emplace(sect.name, &sect);
+}
+
+const IniFile::Section* IniFile::GetSection(std::string_view section_name) const
+{
+  const auto it = m_section_index.find(section_name);
+  return it != m_section_index.end() ? it->second : nullptr;
+}
 
-  return nullptr;
+IniFile::Section* IniFile::GetSection(std::string_view section_name)
+{
+  const auto it = m_section_index.find(section_name);
+  return it != m_section_index.end() ? it->second : nullptr;
 }
 
 IniFile::Section* IniFile::GetOrCreateSection(std::string_view section_name)
@@ -155,16 +188,20 @@ IniFile::Section* IniFile::GetOrCreateSection(std::string_view section_name)
   {
     sections.emplace_back(std::string(section_name));
     section = &sections.back();
+    m_section_index.emplace(section->name, section);
   }
   return section;
 }
 
 bool IniFile::DeleteSection(std::string_view section_name)
 {
-  Section* s = GetSection(section_name);
-  if (!s)
+  const auto index_it = m_section_index.find(section_name);
+  if (index_it == m_section_index.end())
     return false;
 
+  const Section* s = index_it->second;
+  m_section_index.erase(index_it);
+
   for (auto iter = sections.begin(); iter != sections.end(); ++iter)
   {
     if (&(*iter) == s)
@@ -238,41 +275,34 @@ void IniFile::SortSections()
 bool IniFile::Load(const std::string& filename, bool keep_current_data)
 {
   if (!keep_current_data)
+  {
     sections.clear();
+    m_section_index.clear();
+  }
   // first section consists of the comments before the first real section
 
-  // Open file
-  std::ifstream in;
-  File::OpenFStream(in, filename, std::ios::in);
-
-  if (in.fail())
+  // Read the whole file at once and split it up in place, rather than going through a stream
+  // line by line
+  std::string contents;
+  if (!File::ReadFileToString(filename, contents))
     return false;
 
-  Section* current_section = nullptr;
-  bool first_line = true;
-  while (!in.eof())
-  {
-    std::string line_str;
-    if (!std::getline(in, line_str))
-    {
-      if (in.eof())
-        return true;
-      else
-        return false;
-    }
+  std::string_view remaining = contents;
 
-    std::string_view line = line_str;
+  // Skips the UTF-8 BOM at the start of files. Notepad likes to add this.
+  if (remaining.substr(0, 3) == "\xEF\xBB\xBF")
+    remaining.remove_prefix(3);
 
-    // Skips the UTF-8 BOM at the start of files. Notepad likes to add this.
-    if (first_line && line.substr(0, 3) == "\xEF\xBB\xBF")
-      line.remove_prefix(3);
-    first_line = false;
+  Section* current_section = nullptr;
+  while (!remaining.empty())
+  {
+    const size_t eol = remaining.find('\n');
+    std::string_view line = remaining.substr(0, eol);
+    remaining.remove_prefix(eol != std::string_view::npos ? eol + 1 : remaining.size());
 
-#ifndef _WIN32
     // Check for CRLF eol and convert it to LF
     if (!line.empty() && line.back() == '\r')
       line.remove_suffix(1);
-#endif
 
     if (!line.empty())
     {
@@ -311,10 +341,58 @@ bool IniFile::Load(const std::string& filename, bool keep_current_data)
     }
   }
 
-  in.close();
   return true;
 }
 
+bool IniFile::LoadCached(const std::string& filename, bool keep_current_data)
+{
+  std::error_code error;
+  const auto last_write_time = std::filesystem::last_write_time(StringToPath(filename), error);
+  if (error)
+    return Load(filename, keep_current_data);
+  const u64 size = File::GetSize(filename);
+
+  std::shared_ptr<const IniFile> parsed;
+  {
+    std::lock_guard lk(s_cache_mutex);
+    const auto it = s_cache.find(filename);
+    if (it != s_cache.end() && it->second.last_write_time == last_write_time &&
+        it->second.size == size)
+    {
+      parsed = it->second.ini;
+    }
+  }
+
+  if (!parsed)
+  {
+    auto ini = std::make_shared<IniFile>();
+    if (!ini->Load(filename))
+      return Load(filename, keep_current_data);
+
+    std::lock_guard lk(s_cache_mutex);
+    s_cache.insert_or_assign(filename, CachedIniFile{last_write_time, size, ini});
+    parsed = std::move(ini);
+  }
+
+  if (keep_current_data)
+    Merge(*parsed);
+  else
+    *this = *parsed;
+  return true;
+}
+
+void IniFile::Merge(const IniFile& other)
+{
+  for (const Section& other_section : other.sections)
+  {
+    Section* section = GetOrCreateSection(other_section.name);
+    for (const std::string& key : other_section.keys_order)
+      section->Set(key, other_section.values.find(key)->second);
+    section->m_lines.insert(section->m_lines.end(), other_section.m_lines.begin(),
+                            other_section.m_lines.end());
+  }
+}
+
 bool IniFile::Save(const std::string& filename)
 {
   std::ofstream out;
@@ -348,6 +426,11 @@ bool IniFile::Save(const std::string& filename)
 
   out.close();
 
+  {
+    std::lock_guard lk(s_cache_mutex);
+    s_cache.erase(filename);
+  }
+
   return File::RenameSync(temp, filename);
 }
 
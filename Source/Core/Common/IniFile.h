@@ -102,6 +102,10 @@ public:
   };
 
   IniFile();
+  IniFile(const IniFile& other);
+  IniFile(IniFile&& other);
+  IniFile& operator=(const IniFile& other);
+  IniFile& operator=(IniFile&& other);
   ~IniFile();
 
   /**
@@ -116,6 +120,13 @@ public:
    */
   bool Load(const std::string& filename, bool keep_current_data = false);
 
+  /**
+   * Same as Load, but reuses the parsed contents of the file if it was already loaded this way and
+   * hasn't been modified since (as determined by its modification time and size). Meant for files
+   * that are read far more often than they are written, like the GameSettings INIs.
+   */
+  bool LoadCached(const std::string& filename, bool keep_current_data = false);
+
   bool Save(const std::string& filename);
 
   bool Exists(std::string_view section_name) const;
@@ -164,7 +175,14 @@ public:
   const std::list<Section>& GetSections() const { return sections; }
 
 private:
+  void RebuildSectionIndex();
+  // Applies the sections of other on top of this file, the same way Load with keep_current_data
+  // would if it loaded the file other was loaded from.
+  void Merge(const IniFile& other);
+
   std::list<Section> sections;
+  // Sections by name, pointing into sections (whose nodes never move)
+  std::map<std::string_view, Section*, CaseInsensitiveStringCompare> m_section_index;
 
   static const std::string& NULL_STRING;
 };
@@ -21,6 +21,12 @@
 #include <unistd.h>
 #endif
 
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <time.h>
+#endif
+
 #if defined USE_OPROFILE && USE_OPROFILE
 #include <opagent.h>
 #endif
@@ -40,16 +46,144 @@ namespace Common::JitRegister
 {
 static bool s_is_enabled = false;
 
-void Init(const std::string& perf_dir)
+#ifdef __linux__
+// The jitdump format of Linux perf, described in tools/perf/Documentation/jitdump-specification.txt
+// of the kernel source. Unlike the perf map, it has the code of the blocks, so that perf annotate
+// can show their instructions, and timestamps, so that blocks that replace others at the same
+// address are told apart.
+namespace JitDump
+{
+constexpr u32 MAGIC = 0x4A695444;
+constexpr u32 VERSION = 1;
+constexpr u32 JIT_CODE_LOAD = 0;
+constexpr u32 JIT_CODE_CLOSE = 3;
+
+#if defined(_M_X86_64)
+constexpr u32 ELF_MACHINE = 62;  // EM_X86_64
+#elif defined(_M_ARM_64)
+constexpr u32 ELF_MACHINE = 183;  // EM_AARCH64
+#else
+constexpr u32 ELF_MACHINE = 0;
+#endif
+
+struct Header
+{
+  u32 magic;
+  u32 version;
+  u32 total_size;
+  u32 elf_mach;
+  u32 pad1;
+  u32 pid;
+  u64 timestamp;
+  u64 flags;
+};
+
+struct RecordHeader
+{
+  u32 id;
+  u32 total_size;
+  u64 timestamp;
+};
+
+struct CodeLoad
+{
+  RecordHeader header;
+  u32 pid;
+  u32 tid;
+  u64 vma;
+  u64 code_addr;
+  u64 code_size;
+  u64 code_index;
+};
+}  // namespace JitDump
+
+static File::IOFile s_jitdump_file;
+// perf record finds the dump through this mapping of it
+static void* s_jitdump_mapping = nullptr;
+static u64 s_jitdump_code_index = 0;
+
+// perf has to be run with -k mono for its timestamps to match these
+static u64 GetJitDumpTimestamp()
+{
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<u64>(ts.tv_sec) * 1000000000 + static_cast<u64>(ts.tv_nsec);
+}
+
+static void OpenJitDump(const std::string& dir)
+{
+  if (s_jitdump_file.IsOpen())
+    return;
+
+  const std::string filename = fmt::format("{}/jit-{}.dump", dir, getpid());
+  if (!s_jitdump_file.Open(filename, "w+b"))
+    return;
+
+  JitDump::Header header{};
+  header.magic = JitDump::MAGIC;
+  header.version = JitDump::VERSION;
+  header.total_size = sizeof(JitDump::Header);
+  header.elf_mach = JitDump::ELF_MACHINE;
+  header.pid = static_cast<u32>(getpid());
+  header.timestamp = GetJitDumpTimestamp();
+  if (!s_jitdump_file.WriteArray(&header, 1) || !s_jitdump_file.Flush())
+  {
+    s_jitdump_file.Close();
+    return;
+  }
+
+  void* mapping = mmap(nullptr, sysconf(_SC_PAGESIZE), PROT_READ | PROT_EXEC, MAP_PRIVATE,
+                       fileno(s_jitdump_file.GetHandle()), 0);
+  s_jitdump_mapping = mapping == MAP_FAILED ? nullptr : mapping;
+  s_is_enabled = true;
+}
+
+static void CloseJitDump()
+{
+  if (!s_jitdump_file.IsOpen())
+    return;
+
+  const JitDump::RecordHeader record{JitDump::JIT_CODE_CLOSE, sizeof(JitDump::RecordHeader),
+                                     GetJitDumpTimestamp()};
+  s_jitdump_file.WriteArray(&record, 1);
+
+  if (s_jitdump_mapping)
+    munmap(s_jitdump_mapping, sysconf(_SC_PAGESIZE));
+  s_jitdump_mapping = nullptr;
+  s_jitdump_file.Close();
+}
+
+static void WriteJitDumpCodeLoad(const void* base_address, u32 code_size,
+                                 const std::string& symbol_name)
+{
+  const u64 address = reinterpret_cast<u64>(base_address);
+  const u32 total_size =
+      static_cast<u32>(sizeof(JitDump::CodeLoad) + symbol_name.size() + 1 + code_size);
+  JitDump::CodeLoad record{};
+  record.header = {JitDump::JIT_CODE_LOAD, total_size, GetJitDumpTimestamp()};
+  record.pid = static_cast<u32>(getpid());
+  record.tid = static_cast<u32>(syscall(SYS_gettid));
+  record.vma = address;
+  record.code_addr = address;
+  record.code_size = code_size;
+  record.code_index = s_jitdump_code_index++;
+
+  s_jitdump_file.WriteArray(&record, 1);
+  s_jitdump_file.WriteBytes(symbol_name.c_str(), symbol_name.size() + 1);
+  s_jitdump_file.WriteBytes(base_address, code_size);
+}
+#endif
+
+void Init(const std::string& perf_dir, bool write_jitdump)
 {
 #if defined USE_OPROFILE && USE_OPROFILE
   s_agent = op_open_agent();
   s_is_enabled = true;
 #endif
 
+  const std::string dir = perf_dir.empty() ? "/tmp" : perf_dir;
   if (!perf_dir.empty() || getenv("PERF_BUILDID_DIR"))
   {
-    const std::string dir = perf_dir.empty() ? "/tmp" : perf_dir;
     const std::string filename = fmt::format("{}/perf-{}.map", dir, getpid());
     s_perf_map_file.Open(filename, "w");
     // Disable buffering in order to avoid missing some mappings
@@ -57,6 +191,11 @@ void Init(const std::string& perf_dir)
     std::setvbuf(s_perf_map_file.GetHandle(), nullptr, _IONBF, 0);
     s_is_enabled = true;
   }
+
+#ifdef __linux__
+  if (write_jitdump)
+    OpenJitDump(dir);
+#endif
 }
 
 void Shutdown()
@@ -73,6 +212,10 @@ void Shutdown()
   if (s_perf_map_file.IsOpen())
     s_perf_map_file.Close();
 
+#ifdef __linux__
+  CloseJitDump();
+#endif
+
   s_is_enabled = false;
 }
 
@@ -84,7 +227,7 @@ bool IsEnabled()
 void Register(const void* base_address, u32 code_size, const std::string& symbol_name)
 {
 #if !(defined USE_OPROFILE && USE_OPROFILE) && !defined(USE_VTUNE)
-  if (!s_perf_map_file.IsOpen())
+  if (!s_is_enabled)
     return;
 #endif
 
@@ -101,6 +244,12 @@ void Register(const void* base_address, u32 code_size, const std::string& symbol
   iJIT_NotifyEvent(iJVM_EVENT_TYPE_METHOD_LOAD_FINISHED, (void*)&jmethod);
 #endif
 
+#ifdef __linux__
+  // Linux perf /tmp/jit-$pid.dump:
+  if (s_jitdump_file.IsOpen())
+    WriteJitDumpCodeLoad(base_address, code_size, symbol_name);
+#endif
+
   // Linux perf /tmp/perf-$pid.map:
   if (!s_perf_map_file.IsOpen())
     return;
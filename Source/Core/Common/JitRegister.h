@@ -11,7 +11,8 @@
 
 namespace Common::JitRegister
 {
-void Init(const std::string& perf_dir);
+// Writes a perf map to perf_dir, and if write_jitdump is set a jitdump for Linux perf as well
+void Init(const std::string& perf_dir, bool write_jitdump);
 void Shutdown();
 void Register(const void* base_address, u32 code_size, const std::string& symbol_name);
 bool IsEnabled();
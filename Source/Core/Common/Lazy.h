@@ -4,6 +4,8 @@
 #pragma once
 
 #include <functional>
+#include <memory>
+#include <mutex>
 #include <utility>
 #include <variant>
 
@@ -45,4 +47,56 @@ private:
 
   mutable std::variant<T, std::function<T()>> m_value;
 };
+
+// Like Lazy, but the value may be accessed from several threads at once. Copies share the value,
+// and the function is called at most once for all of them. Modify gives this object a value of
+// its own to write to, so writing never affects copies that other threads may be reading.
+template <typename T>
+class SharedLazy
+{
+public:
+  SharedLazy() : m_state(std::make_shared<State>()) {}
+  explicit SharedLazy(std::function<T()> function) : m_state(std::make_shared<State>())
+  {
+    m_state->function = std::move(function);
+  }
+
+  const T& operator*() const { return ComputeValue(); }
+  const T* operator->() const { return &ComputeValue(); }
+
+  T& Modify()
+  {
+    ComputeValue();
+    if (m_state.use_count() != 1)
+    {
+      auto state = std::make_shared<State>();
+      state->value = m_state->value;
+      m_state = std::move(state);
+    }
+    return m_state->value;
+  }
+
+private:
+  struct State
+  {
+    std::once_flag once;
+    std::function<T()> function;
+    T value{};
+  };
+
+  const T& ComputeValue() const
+  {
+    State& state = *m_state;
+    std::call_once(state.once, [&state] {
+      if (state.function)
+      {
+        state.value = state.function();
+        state.function = nullptr;
+      }
+    });
+    return state.value;
+  }
+
+  std::shared_ptr<State> m_state;
+};
 }  // namespace Common
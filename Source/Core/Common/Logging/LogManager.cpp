@@ -21,6 +21,7 @@
 #include "Common/Logging/ConsoleListener.h"
 #include "Common/Logging/Log.h"
 #include "Common/StringUtil.h"
+#include "Common/Thread.h"
 
 namespace Common::Log
 {
@@ -170,10 +171,18 @@ LogManager::LogManager()
   }
 
   m_path_cutoff_point = DeterminePathCutOffPoint();
+
+  m_writer_running.Set();
+  m_writer_thread = std::thread(&LogManager::WriterThread, this);
 }
 
 LogManager::~LogManager()
 {
+  m_writer_running.Clear();
+  m_writer_event.Set();
+  m_writer_thread.join();
+  WritePending();
+
   // The log window listener pointer is owned by the GUI code.
   delete m_listeners[LogListener::CONSOLE_LISTENER];
   delete m_listeners[LogListener::FILE_LISTENER];
@@ -207,29 +216,114 @@ void LogManager::Log(LogLevel level, LogType type, const char* file, int line, c
   LogWithFullPath(level, type, file + m_path_cutoff_point, line, message);
 }
 
-std::string LogManager::GetTimestamp()
+std::string LogManager::GetTimestamp(std::chrono::system_clock::time_point time)
 {
   // NOTE: the Qt LogWidget hardcodes the expected length of the timestamp portion of the log line,
   // so ensure they stay in sync
 
   // We want milliseconds *and not hours*, so can't directly use STL formatters
-  const auto now = std::chrono::system_clock::now();
-  const auto now_s = std::chrono::floor<std::chrono::seconds>(now);
-  const auto now_ms = std::chrono::floor<std::chrono::milliseconds>(now);
-  return fmt::format("{:%M:%S}:{:03}", now_s, (now_ms - now_s).count());
+  const auto time_s = std::chrono::floor<std::chrono::seconds>(time);
+  const auto time_ms = std::chrono::floor<std::chrono::milliseconds>(time);
+  return fmt::format("{:%M:%S}:{:03}", time_s, (time_ms - time_s).count());
 }
 
 void LogManager::LogWithFullPath(LogLevel level, LogType type, const char* file, int line,
                                  const char* message)
 {
-  const std::string msg =
-      fmt::format("{} {}:{} {}[{}]: {}\n", GetTimestamp(), file, line,
-                  LOG_LEVEL_TO_CHAR[static_cast<int>(level)], GetShortName(type), message);
+  if (!TakeRateLimit(type))
+    return;
 
+  // Only the message is copied here, the line is put together on the writer thread
+  m_pending.Push(
+      PendingMessage{std::chrono::system_clock::now(), level, type, file, line, message});
+
+  // Errors are often followed by a panic alert, an assert or a crash, so they are written before
+  // returning, together with everything that was logged before them
+  if (level == LogLevel::LERROR)
+    WritePending();
+  else
+    WakeWriter();
+}
+
+bool LogManager::TakeRateLimit(LogType type)
+{
+  RateLimit& limit = m_rate_limits[type];
+  const s64 second = std::chrono::duration_cast<std::chrono::seconds>(
+                         std::chrono::steady_clock::now().time_since_epoch())
+                         .count();
+
+  // Whichever thread sees the new second first starts counting again
+  s64 last_second = limit.second.load(std::memory_order_relaxed);
+  if (last_second != second &&
+      limit.second.compare_exchange_strong(last_second, second, std::memory_order_relaxed))
+  {
+    limit.count.store(0, std::memory_order_relaxed);
+  }
+
+  if (limit.count.fetch_add(1, std::memory_order_relaxed) < MAX_MESSAGES_PER_SECOND)
+    return true;
+
+  limit.dropped.fetch_add(1, std::memory_order_relaxed);
+  return false;
+}
+
+void LogManager::WakeWriter()
+{
+  // Only the first message after the writer woke up has to signal it
+  if (m_writer_woken.TestAndSet())
+    m_writer_event.Set();
+}
+
+void LogManager::WriterThread()
+{
+  Common::SetCurrentThreadName("Log writer");
+
+  while (m_writer_running.IsSet())
+  {
+    m_writer_event.Wait();
+    m_writer_woken.Clear();
+    WritePending();
+  }
+}
+
+void LogManager::Flush()
+{
+  WritePending();
+}
+
+void LogManager::WritePending()
+{
+  std::lock_guard lk(m_listener_mutex);
+
+  m_pending.PopAll([this](PendingMessage&& pending) {
+    const std::string msg = fmt::format(
+        "{} {}:{} {}[{}]: {}\n", GetTimestamp(pending.time), pending.file, pending.line,
+        LOG_LEVEL_TO_CHAR[static_cast<int>(pending.level)], GetShortName(pending.type),
+        pending.message);
+    Dispatch(pending.level, msg.c_str());
+  });
+
+  for (size_t i = 0; i < m_rate_limits.size(); ++i)
+  {
+    const u32 dropped = m_rate_limits.data()[i].dropped.exchange(0, std::memory_order_relaxed);
+    if (dropped == 0)
+      continue;
+
+    const std::string msg = fmt::format(
+        "{} {}[{}]: Dropped {} messages, more than {} were logged in a second\n",
+        GetTimestamp(std::chrono::system_clock::now()),
+        LOG_LEVEL_TO_CHAR[static_cast<int>(LogLevel::LWARNING)],
+        GetShortName(static_cast<LogType>(i)), dropped, MAX_MESSAGES_PER_SECOND);
+    Dispatch(LogLevel::LWARNING, msg.c_str());
+  }
+}
+
+void LogManager::Dispatch(LogLevel level, const char* msg)
+{
   for (const auto listener_id : m_listener_ids)
   {
     if (m_listeners[listener_id])
-      m_listeners[listener_id]->Log(level, msg.c_str());
+      m_listeners[listener_id]->Log(level, msg);
   }
 }
 
@@ -275,6 +369,7 @@ const char* LogManager::GetFullName(LogType type) const
 
 void LogManager::RegisterListener(LogListener::LISTENER id, LogListener* listener)
 {
+  std::lock_guard lk(m_listener_mutex);
   m_listeners[id] = listener;
 }
 
@@ -4,13 +4,21 @@
 #pragma once
 
 #include <array>
+#include <atomic>
+#include <chrono>
 #include <cstdarg>
 #include <map>
+#include <mutex>
 #include <string>
+#include <thread>
 
 #include "Common/BitSet.h"
+#include "Common/CommonTypes.h"
 #include "Common/EnumMap.h"
+#include "Common/Event.h"
+#include "Common/Flag.h"
 #include "Common/Logging/Log.h"
+#include "Common/MPSCQueue.h"
 
 namespace Common::Log
 {
@@ -38,9 +46,14 @@ public:
   static void Init();
   static void Shutdown();
 
+  // Messages are handed to the listeners on a writer thread, so logging doesn't wait for the
+  // listeners, except for errors, which are written before this returns. file has to stay valid
+  // until then, which string literals like __FILE__ do.
   void Log(LogLevel level, LogType type, const char* file, int line, const char* message);
   void LogWithFullPath(LogLevel level, LogType type, const char* file, int line,
                        const char* message);
+  // Waits until the listeners got every message that was logged so far
+  void Flush();
 
   LogLevel GetLogLevel() const;
   void SetLogLevel(LogLevel level);
@@ -53,6 +66,8 @@ public:
   const char* GetShortName(LogType type) const;
   const char* GetFullName(LogType type) const;
 
+  // The listener may be called from any thread. Once this returns, the previous listener isn't
+  // called anymore.
   void RegisterListener(LogListener::LISTENER id, LogListener* listener);
   void EnableListener(LogListener::LISTENER id, bool enable);
   bool IsListenerEnabled(LogListener::LISTENER id) const;
@@ -67,6 +82,27 @@ private:
     bool m_enable = false;
   };
 
+  // More messages of one type than this in a second are dropped, so that a log that was enabled
+  // for diagnosis can't queue up faster than the listeners keep up with
+  static constexpr u32 MAX_MESSAGES_PER_SECOND = 10000;
+
+  struct RateLimit
+  {
+    std::atomic<s64> second{0};
+    std::atomic<u32> count{0};
+    std::atomic<u32> dropped{0};
+  };
+
+  struct PendingMessage
+  {
+    std::chrono::system_clock::time_point time;
+    LogLevel level;
+    LogType type;
+    const char* file;
+    int line;
+    std::string message;
+  };
+
   LogManager();
   ~LogManager();
 
@@ -75,12 +111,27 @@ private:
   LogManager(LogManager&&) = delete;
   LogManager& operator=(LogManager&&) = delete;
 
-  static std::string GetTimestamp();
+  static std::string GetTimestamp(std::chrono::system_clock::time_point time);
+
+  bool TakeRateLimit(LogType type);
+  void WakeWriter();
+  void WriterThread();
+  void WritePending();
+  void Dispatch(LogLevel level, const char* msg);
 
   LogLevel m_level;
   EnumMap<LogContainer, LAST_LOG_TYPE> m_log{};
   std::array<LogListener*, LogListener::NUMBER_OF_LISTENERS> m_listeners{};
   BitSet32 m_listener_ids;
   size_t m_path_cutoff_point = 0;
+
+  EnumMap<RateLimit, LAST_LOG_TYPE> m_rate_limits;
+  Common::MPSCQueue<PendingMessage> m_pending;
+  Common::Flag m_writer_woken;
+  Common::Event m_writer_event;
+  Common::Flag m_writer_running;
+  std::thread m_writer_thread;
+  // Held while the pending messages are taken and given to the listeners
+  std::mutex m_listener_mutex;
 };
 }  // namespace Common::Log
@@ -0,0 +1,78 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+// a simple lockless thread-safe,
+// multiple producer, single consumer queue.
+// Producers never block. The consumer takes all pending elements at once.
+
+#include <atomic>
+#include <utility>
+
+namespace Common
+{
+template <typename T>
+class MPSCQueue
+{
+public:
+  MPSCQueue() = default;
+  ~MPSCQueue() { Clear(); }
+
+  MPSCQueue(const MPSCQueue&) = delete;
+  MPSCQueue& operator=(const MPSCQueue&) = delete;
+
+  template <typename Arg>
+  void Push(Arg&& t)
+  {
+    Node* node = new Node{T(std::forward<Arg>(t)), m_head.load(std::memory_order_relaxed)};
+    while (!m_head.compare_exchange_weak(node->next, node, std::memory_order_release,
+                                         std::memory_order_relaxed))
+    {
+    }
+  }
+
+  bool Empty() const { return m_head.load(std::memory_order_acquire) == nullptr; }
+
+  // Calls func with every element pushed so far, in push order.
+  // Only the consumer thread may call this.
+  template <typename Func>
+  void PopAll(Func&& func)
+  {
+    Node* node = m_head.exchange(nullptr, std::memory_order_acquire);
+
+    // The list is newest first, reverse it to get FIFO order
+    Node* reversed = nullptr;
+    while (node)
+    {
+      Node* next = node->next;
+      node->next = reversed;
+      reversed = node;
+      node = next;
+    }
+
+    while (reversed)
+    {
+      Node* next = reversed->next;
+      func(std::move(reversed->value));
+      delete reversed;
+      reversed = next;
+    }
+  }
+
+  // Only the consumer thread may call this.
+  void Clear()
+  {
+    PopAll([](T&&) {});
+  }
+
+private:
+  struct Node
+  {
+    T value;
+    Node* next;
+  };
+
+  std::atomic<Node*> m_head{nullptr};
+};
+}  // namespace Common
@@ -0,0 +1,155 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Common/MappedFile.h"
+
+#include <algorithm>
+#include <utility>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "Common/CommonFuncs.h"
+#include "Common/Logging/Log.h"
+#include "Common/StringUtil.h"
+
+namespace File
+{
+MappedFile::MappedFile() = default;
+
+MappedFile::MappedFile(const std::string& filename)
+{
+  Open(filename);
+}
+
+MappedFile::~MappedFile()
+{
+  Close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : m_data(std::exchange(other.m_data, nullptr)), m_size(std::exchange(other.m_size, 0))
+#ifdef _WIN32
+      ,
+      m_mapping_handle(std::exchange(other.m_mapping_handle, nullptr))
+#endif
+{
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+  if (this != &other)
+  {
+    Close();
+    m_data = std::exchange(other.m_data, nullptr);
+    m_size = std::exchange(other.m_size, 0);
+#ifdef _WIN32
+    m_mapping_handle = std::exchange(other.m_mapping_handle, nullptr);
+#endif
+  }
+  return *this;
+}
+
+bool MappedFile::Open(const std::string& filename)
+{
+  Close();
+
+#ifdef _WIN32
+  const HANDLE file = CreateFileW(UTF8ToWString(filename).c_str(), GENERIC_READ, FILE_SHARE_READ,
+                                  nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+    return false;
+
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+  {
+    CloseHandle(file);
+    return false;
+  }
+
+  const HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  // The mapping keeps its own reference to the file
+  CloseHandle(file);
+  if (!mapping)
+    return false;
+
+  void* const view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  if (!view)
+  {
+    CloseHandle(mapping);
+    return false;
+  }
+
+  m_mapping_handle = mapping;
+  m_data = static_cast<const u8*>(view);
+  m_size = static_cast<size_t>(size.QuadPart);
+#else
+  const int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0)
+    return false;
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size == 0)
+  {
+    close(fd);
+    return false;
+  }
+
+  void* const view = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+  // The mapping stays valid after the descriptor is closed
+  close(fd);
+  if (view == MAP_FAILED)
+  {
+    ERROR_LOG_FMT(COMMON, "Failed to map {}: {}", filename, Common::LastStrerrorString());
+    return false;
+  }
+
+  m_data = static_cast<const u8*>(view);
+  m_size = static_cast<size_t>(st.st_size);
+#endif
+
+  return true;
+}
+
+void MappedFile::Prefetch(size_t offset, size_t size) const
+{
+  if (!m_data || offset >= m_size)
+    return;
+
+  size = std::min(size, m_size - offset);
+
+#ifdef _WIN32
+  WIN32_MEMORY_RANGE_ENTRY range{const_cast<u8*>(m_data + offset), size};
+  PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#else
+  // madvise needs a page-aligned start, the mapping itself always is
+  static const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  const size_t aligned_offset = offset - offset % page_size;
+  madvise(const_cast<u8*>(m_data + aligned_offset), size + (offset - aligned_offset),
+          MADV_WILLNEED);
+#endif
+}
+
+void MappedFile::Close()
+{
+  if (!m_data)
+    return;
+
+#ifdef _WIN32
+  UnmapViewOfFile(m_data);
+  CloseHandle(m_mapping_handle);
+  m_mapping_handle = nullptr;
+#else
+  munmap(const_cast<u8*>(m_data), m_size);
+#endif
+
+  m_data = nullptr;
+  m_size = 0;
+}
+}  // namespace File
@@ -0,0 +1,46 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <string>
+
+#include "Common/CommonTypes.h"
+
+namespace File
+{
+// A read-only view of a whole file mapped into memory
+class MappedFile
+{
+public:
+  MappedFile();
+  explicit MappedFile(const std::string& filename);
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  MappedFile(MappedFile&& other) noexcept;
+  MappedFile& operator=(MappedFile&& other) noexcept;
+
+  bool Open(const std::string& filename);
+  void Close();
+
+  bool IsOpen() const { return m_data != nullptr; }
+  const u8* GetData() const { return m_data; }
+  size_t GetSize() const { return m_size; }
+  std::span<const u8> GetSpan() const { return {m_data, m_size}; }
+
+  // Asks the OS to start reading the given range into the page cache without waiting for it
+  void Prefetch(size_t offset, size_t size) const;
+
+private:
+  const u8* m_data = nullptr;
+  size_t m_size = 0;
+#ifdef _WIN32
+  void* m_mapping_handle = nullptr;
+#endif
+};
+}  // namespace File
@@ -29,6 +29,13 @@ public:
   MemArena& operator=(const MemArena&) = delete;
   MemArena& operator=(MemArena&&) = delete;
 
+  ///
+  /// Ask for the memory segment and the views of it to be backed by huge pages, where the host
+  /// supports it. This has to be called before GrabSHMSegment(). Huge pages are only used where the
+  /// offsets within the segment, and the addresses of the views, are multiples of HUGE_PAGE_SIZE.
+  ///
+  void SetUseHugePages(bool use_huge_pages) { m_use_huge_pages = use_huge_pages; }
+
   ///
   /// Allocate the singular memory segment handled by this MemArena. This will be the actual
   /// 'physical' available memory for this arena. After allocation, it can be interacted with using
@@ -102,7 +109,15 @@ public:
   ///
   void UnmapFromMemoryRegion(void* view, size_t size);
 
+  ///
+  /// Get the granularity that MapInMemoryRegion() can map at. The offset, size and base address
+  /// passed to it must all be multiples of this.
+  ///
+  static size_t GetMappingGranularity();
+
 private:
+  bool m_use_huge_pages = false;
+
 #ifdef _WIN32
   WindowsMemoryRegion* EnsureSplitRegionForMapping(void* address, size_t size);
   bool JoinRegionsAfterUnmap(void* address, size_t size);
@@ -5,6 +5,7 @@
 
 #include <cerrno>
 #include <cstddef>
+#include <cstdint>
 #include <cstdlib>
 #include <cstring>
 #include <set>
@@ -16,10 +17,12 @@
 #include <sys/mman.h>
 #include <unistd.h>
 
+#include "Common/Align.h"
 #include "Common/Assert.h"
 #include "Common/CommonFuncs.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
+#include "Common/MemoryUtil.h"
 #include "Common/MsgHandler.h"
 #include "Common/StringUtil.h"
 
@@ -28,16 +31,35 @@ namespace Common
 MemArena::MemArena() = default;
 MemArena::~MemArena() = default;
 
+static int CreateHugePageSegment(const std::string& name)
+{
+#ifdef __linux__
+  // tmpfs in /dev/shm is usually mounted without huge pages, but the memfd mount uses them for
+  // madvised ranges when /sys/kernel/mm/transparent_hugepage/shmem_enabled allows it
+  const int fd = memfd_create(name.c_str(), MFD_CLOEXEC);
+  if (fd == -1)
+    WARN_LOG_FMT(MEMMAP, "memfd_create failed, not using huge pages: {}", strerror(errno));
+  return fd;
+#else
+  return -1;
+#endif
+}
+
 void MemArena::GrabSHMSegment(size_t size, std::string_view base_name)
 {
   const std::string file_name = fmt::format("/{}.{}", base_name, getpid());
-  m_shm_fd = shm_open(file_name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+  m_shm_fd = m_use_huge_pages ? CreateHugePageSegment(file_name.substr(1)) : -1;
   if (m_shm_fd == -1)
   {
-    ERROR_LOG_FMT(MEMMAP, "shm_open failed: {}", strerror(errno));
-    return;
+    m_use_huge_pages = false;
+    m_shm_fd = shm_open(file_name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (m_shm_fd == -1)
+    {
+      ERROR_LOG_FMT(MEMMAP, "shm_open failed: {}", strerror(errno));
+      return;
+    }
+    shm_unlink(file_name.c_str());
   }
-  shm_unlink(file_name.c_str());
   if (ftruncate(m_shm_fd, size) < 0)
     ERROR_LOG_FMT(MEMMAP, "Failed to allocate low memory space");
 }
@@ -57,6 +79,8 @@ void* MemArena::CreateView(s64 offset, size_t size)
   }
   else
   {
+    if (m_use_huge_pages)
+      AdviseHugePages(retval, size);
     return retval;
   }
 }
@@ -68,13 +92,25 @@ void MemArena::ReleaseView(void* view, size_t size)
 
 u8* MemArena::ReserveMemoryRegion(size_t memory_size)
 {
+  // Huge pages only back views at addresses that are aligned to them, so reserve a bit more to be
+  // able to align the region
+  const size_t alignment = m_use_huge_pages ? HUGE_PAGE_SIZE : 0;
   const int flags = MAP_ANON | MAP_PRIVATE;
-  void* base = mmap(nullptr, memory_size, PROT_NONE, flags, -1, 0);
+  void* base = mmap(nullptr, memory_size + alignment, PROT_NONE, flags, -1, 0);
   if (base == MAP_FAILED)
   {
     PanicAlertFmt("Failed to map enough memory space: {}", LastStrerrorString());
     return nullptr;
   }
+  if (alignment != 0)
+  {
+    const uintptr_t start = reinterpret_cast<uintptr_t>(base);
+    const uintptr_t aligned_start = Common::AlignUp(start, alignment);
+    if (aligned_start != start)
+      munmap(base, aligned_start - start);
+    munmap(reinterpret_cast<void*>(aligned_start + memory_size), start + alignment - aligned_start);
+    base = reinterpret_cast<void*>(aligned_start);
+  }
   m_reserved_region = base;
   m_reserved_region_size = memory_size;
   return static_cast<u8*>(base);
@@ -99,6 +135,8 @@ void* MemArena::MapInMemoryRegion(s64 offset, size_t size, void* base)
   }
   else
   {
+    if (m_use_huge_pages)
+      AdviseHugePages(retval, size);
     return retval;
   }
 }
@@ -110,6 +148,12 @@ void MemArena::UnmapFromMemoryRegion(void* view, size_t size)
     NOTICE_LOG_FMT(MEMMAP, "mmap failed");
 }
 
+size_t MemArena::GetMappingGranularity()
+{
+  static const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  return page_size;
+}
+
 LazyMemoryRegion::LazyMemoryRegion() = default;
 
 LazyMemoryRegion::~LazyMemoryRegion()
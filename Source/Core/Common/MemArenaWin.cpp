@@ -434,6 +434,17 @@ void MemArena::UnmapFromMemoryRegion(void* view, size_t size)
   UnmapViewOfFile(view);
 }
 
+size_t MemArena::GetMappingGranularity()
+{
+  // Views of a file mapping can only start at multiples of the allocation granularity
+  static const size_t granularity = [] {
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return static_cast<size_t>(info.dwAllocationGranularity);
+  }();
+  return granularity;
+}
+
 LazyMemoryRegion::LazyMemoryRegion() = default;
 
 LazyMemoryRegion::~LazyMemoryRegion()
@@ -4,9 +4,11 @@
 #include "Common/MemoryUtil.h"
 
 #include <cstddef>
+#include <cstdint>
 #include <cstdlib>
 #include <string>
 
+#include "Common/Align.h"
 #include "Common/CommonFuncs.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
@@ -257,6 +259,19 @@ bool UnWriteProtectMemory(void* ptr, size_t size, bool allowExecute)
   return true;
 }
 
+void AdviseHugePages(void* ptr, size_t size)
+{
+#ifdef MADV_HUGEPAGE
+  const uintptr_t start = Common::AlignUp(reinterpret_cast<uintptr_t>(ptr), HUGE_PAGE_SIZE);
+  const uintptr_t end = Common::AlignDown(reinterpret_cast<uintptr_t>(ptr) + size, HUGE_PAGE_SIZE);
+  if (start >= end)
+    return;
+
+  if (madvise(reinterpret_cast<void*>(start), end - start, MADV_HUGEPAGE) != 0)
+    WARN_LOG_FMT(COMMON, "Failed to ask for huge pages: {}", LastStrerrorString());
+#endif
+}
+
 size_t MemPhysical()
 {
 #ifdef _WIN32
@@ -33,6 +33,12 @@ void FreeAlignedMemory(void* ptr);
 bool ReadProtectMemory(void* ptr, size_t size);
 bool WriteProtectMemory(void* ptr, size_t size, bool executable = false);
 bool UnWriteProtectMemory(void* ptr, size_t size, bool allowExecute = false);
+
+// The size of the huge pages that AdviseHugePages() asks for, on hosts with 4 KiB pages
+constexpr size_t HUGE_PAGE_SIZE = 0x200000;
+// Asks for the parts of the range that are aligned to huge pages to be backed by them, which means
+// fewer TLB misses. This only does something on Linux with transparent huge pages.
+void AdviseHugePages(void* ptr, size_t size);
 size_t MemPhysical();
 
 }  // namespace Common
@@ -35,6 +35,9 @@ public:
   auto begin() const { return m_array.begin(); }
   auto end() const { return m_array.begin() + m_size; }
 
+  T* data() { return m_array.data(); }
+  const T* data() const { return m_array.data(); }
+
   size_t size() const { return m_size; }
   bool empty() const { return m_size == 0; }
 
@@ -52,15 +52,28 @@ void SymbolDB::Clear(const char* prefix)
   // TODO: honor prefix
   m_functions.clear();
   m_checksum_to_function.clear();
+  m_address_index.clear();
+  m_address_index_valid = false;
+}
+
+SymbolDB::XFuncMap& SymbolDB::AccessSymbols()
+{
+  InvalidateAddressIndex();
+  return m_functions;
 }
 
 void SymbolDB::Index()
 {
+  m_address_index.clear();
+  m_address_index.reserve(m_functions.size());
+
   int i = 0;
   for (auto& func : m_functions)
   {
     func.second.index = i++;
+    m_address_index.push_back({func.first, func.second.size, &func.second});
   }
+  m_address_index_valid = true;
 }
 
 Symbol* SymbolDB::GetSymbolFromName(std::string_view name)
@@ -109,5 +122,6 @@ std::vector<Symbol*> SymbolDB::GetSymbolsFromHash(u32 hash)
 void SymbolDB::AddCompleteSymbol(const Symbol& symbol)
 {
   m_functions.emplace(symbol.address, symbol);
+  InvalidateAddressIndex();
 }
 }  // namespace Common
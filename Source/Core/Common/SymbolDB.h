@@ -85,14 +85,29 @@ public:
   std::vector<Symbol*> GetSymbolsFromHash(u32 hash);
 
   const XFuncMap& Symbols() const { return m_functions; }
-  XFuncMap& AccessSymbols() { return m_functions; }
+  // Callers that change the address or size of symbols have to call Index afterwards
+  XFuncMap& AccessSymbols();
   bool IsEmpty() const;
   void Clear(const char* prefix = "");
   void List();
+  // Numbers the symbols and builds the address index. Call it after adding a batch of symbols.
   void Index();
 
 protected:
+  // A flat copy of the ranges of m_functions in address order, which is much faster to search
+  // than the map. It is only valid from the last call to Index until the symbols change.
+  struct IndexedRange
+  {
+    u32 address;
+    u32 size;
+    Symbol* symbol;
+  };
+
+  void InvalidateAddressIndex() { m_address_index_valid = false; }
+
   XFuncMap m_functions;
   XFuncPtrMap m_checksum_to_function;
+  std::vector<IndexedRange> m_address_index;
+  bool m_address_index_valid = false;
 };
 }  // namespace Common
@@ -0,0 +1,196 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Common/TraceEvents.h"
+
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+
+namespace Common::Trace
+{
+std::atomic<bool> g_is_recording = false;
+
+namespace
+{
+// Keeps a trace of a long recording from taking up all memory
+constexpr size_t MAX_ZONES_PER_THREAD = 1 << 20;
+
+struct Zone
+{
+  u32 name_index;
+  u64 start_us;
+  u64 end_us;
+};
+
+// The zones of one thread. Only the thread itself adds to them, so the mutex is only contended
+// while the trace is written.
+struct ThreadZones
+{
+  std::mutex mutex;
+  u32 id = 0;
+  std::string thread_name;
+  std::vector<Zone> zones;
+  u64 dropped_zones = 0;
+
+  // Zone names are copied, as the names of things like CoreTiming events don't outlive the
+  // emulation
+  std::vector<std::string> names;
+  std::unordered_map<const char*, u32> name_indices;
+
+  void Clear()
+  {
+    zones.clear();
+    dropped_zones = 0;
+    names.clear();
+    name_indices.clear();
+  }
+};
+
+std::mutex s_threads_mutex;
+std::vector<std::shared_ptr<ThreadZones>> s_threads;
+u32 s_next_thread_id = 1;
+
+thread_local std::shared_ptr<ThreadZones> t_zones;
+
+ThreadZones& GetThreadZones()
+{
+  if (!t_zones)
+  {
+    t_zones = std::make_shared<ThreadZones>();
+    std::lock_guard lk(s_threads_mutex);
+    t_zones->id = s_next_thread_id++;
+    s_threads.push_back(t_zones);
+  }
+  return *t_zones;
+}
+
+void AppendEscaped(std::string* out, std::string_view str)
+{
+  for (const char c : str)
+  {
+    if (c == '"' || c == '\\')
+      out->push_back('\\');
+    if (static_cast<unsigned char>(c) < 0x20)
+      fmt::format_to(std::back_inserter(*out), "\\u{:04x}", static_cast<int>(c));
+    else
+      out->push_back(c);
+  }
+}
+}  // namespace
+
+void StartRecording()
+{
+  {
+    std::lock_guard lk(s_threads_mutex);
+    // Threads that exited are only kept around until their zones are written
+    std::erase_if(s_threads, [](const auto& thread) { return thread.use_count() == 1; });
+    for (const auto& thread : s_threads)
+    {
+      std::lock_guard thread_lk(thread->mutex);
+      thread->Clear();
+    }
+  }
+
+  g_is_recording.store(true, std::memory_order_relaxed);
+}
+
+void StopRecording()
+{
+  g_is_recording.store(false, std::memory_order_relaxed);
+}
+
+bool WriteRecording(const std::string& path)
+{
+  File::IOFile file(path, "wb");
+  if (!file)
+  {
+    ERROR_LOG_FMT(COMMON, "Failed to open {} to write the trace", path);
+    return false;
+  }
+
+  // Written in pieces, as a trace can have millions of zones
+  std::string buffer = R"({"displayTimeUnit":"ms","traceEvents":[)";
+  bool first = true;
+  bool success = true;
+  const auto flush = [&] {
+    success = success && file.WriteString(buffer);
+    buffer.clear();
+  };
+
+  std::lock_guard lk(s_threads_mutex);
+  for (const auto& thread : s_threads)
+  {
+    std::lock_guard thread_lk(thread->mutex);
+    if (thread->zones.empty())
+      continue;
+
+    if (!first)
+      buffer += ',';
+    first = false;
+    fmt::format_to(std::back_inserter(buffer),
+                   R"({{"ph":"M","name":"thread_name","pid":1,"tid":{},"args":{{"name":")",
+                   thread->id);
+    AppendEscaped(&buffer, thread->thread_name.empty() ? fmt::format("Thread {}", thread->id) :
+                                                         thread->thread_name);
+    buffer += "\"}}";
+
+    for (const Zone& zone : thread->zones)
+    {
+      buffer += R"(,{"ph":"X","name":")";
+      AppendEscaped(&buffer, thread->names[zone.name_index]);
+      fmt::format_to(std::back_inserter(buffer), R"(","pid":1,"tid":{},"ts":{},"dur":{}}})",
+                     thread->id, zone.start_us, zone.end_us - zone.start_us);
+      if (buffer.size() >= 0x10000)
+        flush();
+    }
+
+    if (thread->dropped_zones != 0)
+    {
+      WARN_LOG_FMT(COMMON, "The trace is missing {} zones of thread {}", thread->dropped_zones,
+                   thread->thread_name);
+    }
+  }
+
+  buffer += "]}";
+  flush();
+  return success;
+}
+
+void SetThreadName(const char* name)
+{
+  ThreadZones& zones = GetThreadZones();
+  std::lock_guard lk(zones.mutex);
+  zones.thread_name = name;
+}
+
+void AddZone(const char* name, u64 start_us, u64 end_us)
+{
+  ThreadZones& zones = GetThreadZones();
+  std::lock_guard lk(zones.mutex);
+  if (zones.zones.size() >= MAX_ZONES_PER_THREAD)
+  {
+    ++zones.dropped_zones;
+    return;
+  }
+
+  // A name that was freed can be followed by a different one at the same address
+  auto [it, inserted] = zones.name_indices.try_emplace(name, static_cast<u32>(zones.names.size()));
+  if (!inserted && zones.names[it->second] != name)
+  {
+    it->second = static_cast<u32>(zones.names.size());
+    inserted = true;
+  }
+  if (inserted)
+    zones.names.emplace_back(name);
+  zones.zones.push_back({it->second, start_us, end_us});
+}
+}  // namespace Common::Trace
@@ -0,0 +1,64 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Records how long scopes on every thread take, for finding out which thread stalls when the
+// emulation stutters. The trace is written in the trace event format of Chrome, which Perfetto
+// (https://ui.perfetto.dev) and chrome://tracing can open. While no trace is recorded, a zone only
+// costs a relaxed atomic load.
+
+#pragma once
+
+#include <atomic>
+#include <string>
+
+#include "Common/CommonTypes.h"
+#include "Common/Timer.h"
+
+namespace Common::Trace
+{
+extern std::atomic<bool> g_is_recording;
+
+inline bool IsRecording()
+{
+  return g_is_recording.load(std::memory_order_relaxed);
+}
+
+// Drops the zones of the previous recording
+void StartRecording();
+void StopRecording();
+// Writes the zones of the last recording to path. Returns false if the file couldn't be written.
+bool WriteRecording(const std::string& path);
+
+// Called by Common::SetCurrentThreadName, so that the threads have names in the trace
+void SetThreadName(const char* name);
+
+void AddZone(const char* name, u64 start_us, u64 end_us);
+
+class ScopedZone final
+{
+public:
+  explicit ScopedZone(const char* name)
+  {
+    if (IsRecording())
+    {
+      m_name = name;
+      m_start_us = Timer::NowUs();
+    }
+  }
+  ~ScopedZone()
+  {
+    if (m_name)
+      AddZone(m_name, m_start_us, Timer::NowUs());
+  }
+
+  ScopedZone(const ScopedZone&) = delete;
+  ScopedZone& operator=(const ScopedZone&) = delete;
+
+private:
+  const char* m_name = nullptr;
+  u64 m_start_us = 0;
+};
+}  // namespace Common::Trace
+
+// Only one per scope
+#define TRACE_SCOPE(name) Common::Trace::ScopedZone trace_scope_zone(name)
@@ -0,0 +1,96 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Common/WorkerPool.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "Common/Thread.h"
+
+namespace Common
+{
+WorkerPool::WorkerPool(std::string name, size_t max_workers)
+    : m_name(std::move(name)), m_max_workers(max_workers)
+{
+}
+
+size_t WorkerPool::GetJobCount()
+{
+  if (!m_started)
+  {
+    m_started = true;
+    m_exit = false;
+
+    // Leave a core each to the CPU and GPU threads
+    const size_t hardware_threads = std::thread::hardware_concurrency();
+    const size_t workers =
+        hardware_threads > 2 ? std::min(hardware_threads - 2, m_max_workers) : 0;
+    for (size_t i = 0; i < workers; ++i)
+      m_workers.emplace_back(&WorkerPool::WorkerThread, this, i + 1, m_generation);
+  }
+
+  return m_workers.size() + 1;
+}
+
+void WorkerPool::Shutdown()
+{
+  {
+    std::lock_guard lk(m_mutex);
+    m_exit = true;
+  }
+  m_work_cv.notify_all();
+  for (std::thread& worker : m_workers)
+    worker.join();
+
+  m_workers.clear();
+  m_started = false;
+}
+
+void WorkerPool::WorkerThread(size_t index, u64 generation)
+{
+  Common::SetCurrentThreadName(m_name.c_str());
+
+  while (true)
+  {
+    {
+      std::unique_lock lk(m_mutex);
+      m_work_cv.wait(lk, [&] { return m_exit || m_generation != generation; });
+      if (m_exit)
+        return;
+      generation = m_generation;
+    }
+
+    (*m_job)(index);
+
+    {
+      std::lock_guard lk(m_mutex);
+      --m_pending_jobs;
+    }
+    m_done_cv.notify_one();
+  }
+}
+
+void WorkerPool::Run(const std::function<void(size_t)>& job)
+{
+  if (m_workers.empty())
+  {
+    job(0);
+    return;
+  }
+
+  {
+    std::lock_guard lk(m_mutex);
+    m_job = &job;
+    m_pending_jobs = m_workers.size();
+    ++m_generation;
+  }
+  m_work_cv.notify_all();
+
+  job(0);
+
+  std::unique_lock lk(m_mutex);
+  m_done_cv.wait(lk, [&] { return m_pending_jobs == 0; });
+  m_job = nullptr;
+}
+}  // namespace Common
@@ -0,0 +1,55 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+// Persistent threads that run the parts of a job at the same time as the calling thread, for jobs
+// that come often enough that starting threads for each of them would cost more than it saves.
+
+namespace Common
+{
+class WorkerPool
+{
+public:
+  WorkerPool(std::string name, size_t max_workers);
+  WorkerPool(const WorkerPool&) = delete;
+  WorkerPool& operator=(const WorkerPool&) = delete;
+  ~WorkerPool() { Shutdown(); }
+
+  // How many parts Run runs at the same time, including the one on the calling thread. Starts the
+  // workers the first time. 1 if the host doesn't have enough cores to spare.
+  size_t GetJobCount();
+
+  // Calls job(i) for every i below GetJobCount(), job(0) on the calling thread, and returns once
+  // all of them are done.
+  void Run(const std::function<void(size_t)>& job);
+
+  // Stops the workers. GetJobCount starts them again.
+  void Shutdown();
+
+private:
+  void WorkerThread(size_t index, u64 generation);
+
+  std::string m_name;
+  size_t m_max_workers;
+  std::vector<std::thread> m_workers;
+  const std::function<void(size_t)>* m_job = nullptr;
+  std::mutex m_mutex;
+  std::condition_variable m_work_cv;
+  std::condition_variable m_done_cv;
+  u64 m_generation = 0;
+  size_t m_pending_jobs = 0;
+  bool m_exit = false;
+  bool m_started = false;
+};
+}  // namespace Common
@@ -204,6 +204,12 @@ void CPUInfo::Detect()
         bBMI2 = true;
       if ((info.ebx >> 29) & 1)
         bSHA1 = bSHA2 = true;
+      // AVX-512 additionally needs XSAVE to be usable for the opmask and upper ZMM registers
+      if (bAVX && ((info.ebx >> 16) & 1) &&
+          (xgetbv(XCR_XFEATURE_ENABLED_MASK) & 0b11100000) == 0b11100000)
+      {
+        bAVX512F = true;
+      }
     }
   }
 
@@ -258,6 +264,8 @@ std::string CPUInfo::Summarize()
     sum.push_back("HTT");
   if (bAVX)
     sum.push_back("AVX");
+  if (bAVX512F)
+    sum.push_back("AVX512F");
   if (bBMI1)
     sum.push_back("BMI1");
   if (bBMI2)
@@ -5,6 +5,9 @@
 
 #include "Core/AchievementManager.h"
 
+#include <algorithm>
+#include <cstring>
+
 #include <fmt/format.h>
 
 #include <rcheevos/include/rc_api_info.h>
@@ -12,9 +15,11 @@
 
 #include "Common/HttpRequest.h"
 #include "Common/Logging/Log.h"
+#include "Common/Swap.h"
 #include "Common/WorkQueueThread.h"
 #include "Core/Config/AchievementSettings.h"
 #include "Core/Core.h"
+#include "Core/HW/Memmap.h"
 #include "Core/PowerPC/MMU.h"
 #include "Core/System.h"
 #include "DiscIO/Volume.h"
@@ -97,62 +102,28 @@ void AchievementManager::LoadGameByFilenameAsync(const std::string& iso_path,
     return;
   }
   m_system = &Core::System::GetInstance();
-  struct FilereaderState
-  {
-    int64_t position = 0;
-    std::unique_ptr<DiscIO::Volume> volume;
-  };
-  rc_hash_filereader volume_reader{
-      .open = [](const char* path_utf8) -> void* {
-        auto state = std::make_unique<FilereaderState>();
-        state->volume = DiscIO::CreateVolume(path_utf8);
-        if (!state->volume)
-          return nullptr;
-        return state.release();
-      },
-      .seek =
-          [](void* file_handle, int64_t offset, int origin) {
-            switch (origin)
-            {
-            case SEEK_SET:
-              reinterpret_cast<FilereaderState*>(file_handle)->position = offset;
-              break;
-            case SEEK_CUR:
-              reinterpret_cast<FilereaderState*>(file_handle)->position += offset;
-              break;
-            case SEEK_END:
-              // Unused
-              break;
-            }
-          },
-      .tell =
-          [](void* file_handle) {
-            return reinterpret_cast<FilereaderState*>(file_handle)->position;
-          },
-      .read =
-          [](void* file_handle, void* buffer, size_t requested_bytes) {
-            FilereaderState* filereader_state = reinterpret_cast<FilereaderState*>(file_handle);
-            bool success = (filereader_state->volume->Read(
-                filereader_state->position, requested_bytes, reinterpret_cast<u8*>(buffer),
-                DiscIO::PARTITION_NONE));
-            if (success)
-            {
-              filereader_state->position += requested_bytes;
-              return requested_bytes;
-            }
-            else
-            {
-              return static_cast<size_t>(0);
-            }
-          },
-      .close = [](void* file_handle) { delete reinterpret_cast<FilereaderState*>(file_handle); }};
-  rc_hash_init_custom_filereader(&volume_reader);
-  if (!rc_hash_generate_from_file(m_game_hash.data(), RC_CONSOLE_GAMECUBE, iso_path.c_str()))
+
+  std::string game_hash;
   {
-    ERROR_LOG_FMT(ACHIEVEMENTS, "Unable to generate achievement hash from game file.");
-    return;
+    std::lock_guard lg{m_known_game_hashes_lock};
+    const auto it = m_known_game_hashes.find(iso_path);
+    if (it != m_known_game_hashes.end())
+      game_hash = it->second;
   }
-  m_queue.EmplaceItem([this, callback] {
+
+  m_queue.EmplaceItem([this, callback, iso_path, game_hash = std::move(game_hash)]() mutable {
+    // Hashing reads parts of the disc, which is slow for compressed images, so it's done here
+    // rather than holding up the boot
+    if (game_hash.empty())
+      game_hash = HashGame(iso_path);
+    if (game_hash.empty() || game_hash.size() >= m_game_hash.size())
+    {
+      ERROR_LOG_FMT(ACHIEVEMENTS, "Unable to generate achievement hash from game file.");
+      return;
+    }
+    m_game_hash = {};
+    std::copy(game_hash.begin(), game_hash.end(), m_game_hash.begin());
+
     const auto resolve_hash_response = ResolveHash(this->m_game_hash);
     if (resolve_hash_response != ResponseType::SUCCESS || m_game_id == 0)
     {
@@ -228,6 +199,71 @@ bool AchievementManager::IsGameLoaded() const
   return m_is_game_loaded;
 }
 
+std::string AchievementManager::HashGame(const std::string& path)
+{
+  struct FilereaderState
+  {
+    int64_t position = 0;
+    std::unique_ptr<DiscIO::Volume> volume;
+  };
+  rc_hash_filereader volume_reader{
+      .open = [](const char* path_utf8) -> void* {
+        auto state = std::make_unique<FilereaderState>();
+        state->volume = DiscIO::CreateVolume(path_utf8);
+        if (!state->volume)
+          return nullptr;
+        return state.release();
+      },
+      .seek =
+          [](void* file_handle, int64_t offset, int origin) {
+            switch (origin)
+            {
+            case SEEK_SET:
+              reinterpret_cast<FilereaderState*>(file_handle)->position = offset;
+              break;
+            case SEEK_CUR:
+              reinterpret_cast<FilereaderState*>(file_handle)->position += offset;
+              break;
+            case SEEK_END:
+              // Unused
+              break;
+            }
+          },
+      .tell =
+          [](void* file_handle) {
+            return reinterpret_cast<FilereaderState*>(file_handle)->position;
+          },
+      .read =
+          [](void* file_handle, void* buffer, size_t requested_bytes) {
+            FilereaderState* filereader_state = reinterpret_cast<FilereaderState*>(file_handle);
+            bool success = (filereader_state->volume->Read(
+                filereader_state->position, requested_bytes, reinterpret_cast<u8*>(buffer),
+                DiscIO::PARTITION_NONE));
+            if (success)
+            {
+              filereader_state->position += requested_bytes;
+              return requested_bytes;
+            }
+            else
+            {
+              return static_cast<size_t>(0);
+            }
+          },
+      .close = [](void* file_handle) { delete reinterpret_cast<FilereaderState*>(file_handle); }};
+  rc_hash_init_custom_filereader(&volume_reader);
+
+  std::array<char, HASH_LENGTH> game_hash{};
+  if (!rc_hash_generate_from_file(game_hash.data(), RC_CONSOLE_GAMECUBE, path.c_str()))
+    return {};
+  return game_hash.data();
+}
+
+void AchievementManager::AddKnownGameHash(const std::string& path, std::string hash)
+{
+  std::lock_guard lg{m_known_game_hashes_lock};
+  m_known_game_hashes.insert_or_assign(path, std::move(hash));
+}
+
 void AchievementManager::LoadUnlockData(const ResponseCallback& callback)
 {
   m_queue.EmplaceItem([this, callback] {
@@ -284,6 +320,7 @@ void AchievementManager::ActivateDeactivateLeaderboards()
       rc_runtime_deactivate_lboard(&m_runtime, m_game_data.leaderboards[ix].id);
     }
   }
+  m_memory_ranges_dirty = true;
   INFO_LOG_FMT(ACHIEVEMENTS, "Leaderboards (de)activated.");
 }
 
@@ -295,6 +332,7 @@ void AchievementManager::ActivateDeactivateRichPresence()
           m_game_data.rich_presence_script :
           "",
       nullptr, 0);
+  m_memory_ranges_dirty = true;
   INFO_LOG_FMT(ACHIEVEMENTS, "Rich presence (de)activated.");
 }
 
@@ -553,6 +591,9 @@ void AchievementManager::DoFrame()
   if (!m_is_game_loaded)
     return;
   Core::RunAsCPUThread([&] {
+    if (m_memory_ranges_dirty.exchange(false))
+      UpdateMemoryRanges();
+    TakeMemorySnapshot();
     rc_runtime_do_frame(
         &m_runtime,
         [](const rc_runtime_event_t* runtime_event) {
@@ -562,6 +603,8 @@ void AchievementManager::DoFrame()
           return static_cast<AchievementManager*>(ud)->MemoryPeeker(address, num_bytes, ud);
         },
         this, nullptr);
+    // The emulated RAM changes once the CPU runs again
+    m_memory_snapshot_valid = false;
   });
   if (!m_system)
     return;
@@ -576,8 +619,117 @@ void AchievementManager::DoFrame()
   }
 }
 
+void AchievementManager::UpdateMemoryRanges()
+{
+  std::vector<std::pair<u32, u32>> memrefs;
+  for (const rc_memref_t* memref = m_runtime.memrefs; memref; memref = memref->next)
+  {
+    // The address of an indirect memref is an offset from a pointer that is only known later
+    if (memref->value.is_indirect)
+      continue;
+    // Every size that rcheevos peeks is at most 4 bytes. The snapshot only covers RAM, which
+    // doesn't reach the end of the address space.
+    if (memref->address <= 0xFFFFFFFFu - MEMORY_RANGE_MAX_GAP - 4)
+      memrefs.emplace_back(memref->address, 4);
+  }
+  std::sort(memrefs.begin(), memrefs.end());
+
+  m_memory_ranges.clear();
+  u32 snapshot_size = 0;
+  for (const auto& [address, size] : memrefs)
+  {
+    MemoryRange* last = m_memory_ranges.empty() ? nullptr : &m_memory_ranges.back();
+    if (last && address <= last->address + last->size + MEMORY_RANGE_MAX_GAP)
+    {
+      const u32 end = std::max(last->address + last->size, address + size);
+      snapshot_size += end - (last->address + last->size);
+      last->size = end - last->address;
+    }
+    else
+    {
+      m_memory_ranges.push_back({address, size, snapshot_size});
+      snapshot_size += size;
+    }
+  }
+  m_memory_snapshot.resize(snapshot_size);
+
+  INFO_LOG_FMT(ACHIEVEMENTS, "{} memrefs are read from {} ranges of {} bytes in total",
+               memrefs.size(), m_memory_ranges.size(), snapshot_size);
+}
+
+void AchievementManager::TakeMemorySnapshot()
+{
+  m_memory_snapshot_valid = false;
+  if (!m_system)
+    return;
+
+  auto& memory = m_system->GetMemory();
+  for (MemoryRange& range : m_memory_ranges)
+  {
+    // The same addresses that a physical MMU read finds in RAM. Ranges that aren't entirely in
+    // RAM are marked as empty, so that their reads go through the MMU.
+    const u32 ram_address = range.address & 0x3FFFFFFF;
+    const u8* source = nullptr;
+    if (u64{ram_address} + range.size <= memory.GetRamSizeReal())
+    {
+      source = memory.GetRAM() + ram_address;
+    }
+    else if (memory.GetEXRAM() && (ram_address >> 28) == 0x1 &&
+             u64{ram_address & 0x0FFFFFFF} + range.size <= memory.GetExRamSizeReal())
+    {
+      source = memory.GetEXRAM() + (ram_address & 0x0FFFFFFF);
+    }
+
+    if (source)
+      std::memcpy(m_memory_snapshot.data() + range.snapshot_offset, source, range.size);
+    else
+      range.size = 0;
+  }
+  m_memory_snapshot_valid = true;
+}
+
+std::optional<u32> AchievementManager::ReadFromMemorySnapshot(u32 address, u32 num_bytes) const
+{
+  if (!m_memory_snapshot_valid)
+    return std::nullopt;
+
+  // The last range that starts at or before the address
+  auto it = std::upper_bound(
+      m_memory_ranges.begin(), m_memory_ranges.end(), address,
+      [](u32 value, const MemoryRange& range) { return value < range.address; });
+  if (it == m_memory_ranges.begin())
+    return std::nullopt;
+  --it;
+  if (u64{address} + num_bytes > u64{it->address} + it->size)
+    return std::nullopt;
+
+  const u8* data = m_memory_snapshot.data() + it->snapshot_offset + (address - it->address);
+  switch (num_bytes)
+  {
+  case 1:
+    return *data;
+  case 2:
+  {
+    u16 value;
+    std::memcpy(&value, data, sizeof(value));
+    return Common::swap16(value);
+  }
+  case 4:
+  {
+    u32 value;
+    std::memcpy(&value, data, sizeof(value));
+    return Common::swap32(value);
+  }
+  default:
+    return std::nullopt;
+  }
+}
+
 u32 AchievementManager::MemoryPeeker(u32 address, u32 num_bytes, void* ud)
 {
+  if (const std::optional<u32> value = ReadFromMemorySnapshot(address, num_bytes))
+    return *value;
+
   if (!m_system)
     return 0u;
   Core::CPUThreadGuard threadguard(*m_system);
@@ -1100,6 +1252,7 @@ void AchievementManager::ActivateDeactivateAchievement(AchievementId id, bool en
   }
   if (active && !activate)
     rc_runtime_deactivate_achievement(&m_runtime, id);
+  m_memory_ranges_dirty = true;
 }
 
 void AchievementManager::GenerateRichPresence()
@@ -5,17 +5,21 @@
 
 #ifdef USE_RETRO_ACHIEVEMENTS
 #include <array>
+#include <atomic>
 #include <ctime>
 #include <functional>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <thread>
 #include <unordered_map>
+#include <vector>
 
 #include <rcheevos/include/rc_api_runtime.h>
 #include <rcheevos/include/rc_api_user.h>
 #include <rcheevos/include/rc_runtime.h>
 
+#include "Common/CommonTypes.h"
 #include "Common/Event.h"
 #include "Common/WorkQueueThread.h"
 
@@ -106,6 +110,11 @@ public:
   void LoginAsync(const std::string& password, const ResponseCallback& callback);
   bool IsLoggedIn() const;
   void LoadGameByFilenameAsync(const std::string& iso_path, const ResponseCallback& callback);
+  // Hashes a game file the way RetroAchievements identifies it, which means reading parts of it.
+  // Returns an empty string if the file can't be hashed. May be called from any thread.
+  static std::string HashGame(const std::string& path);
+  // Remembers the hash of a game file, so that loading it doesn't have to hash it again
+  void AddKnownGameHash(const std::string& path, std::string hash);
   bool IsGameLoaded() const;
 
   void LoadUnlockData(const ResponseCallback& callback);
@@ -140,6 +149,16 @@ private:
   AchievementManager() = default;
 
   static constexpr int HASH_LENGTH = 33;
+  // Memrefs closer than this are copied as one range
+  static constexpr u32 MEMORY_RANGE_MAX_GAP = 256;
+
+  // A range of RAM that memrefs read from, and where it is in the snapshot
+  struct MemoryRange
+  {
+    u32 address;
+    u32 size;
+    u32 snapshot_offset;
+  };
 
   ResponseType VerifyCredentials(const std::string& password);
   ResponseType ResolveHash(std::array<char, HASH_LENGTH> game_hash);
@@ -151,6 +170,10 @@ private:
   void ActivateDeactivateAchievement(AchievementId id, bool enabled, bool unofficial, bool encore);
   void GenerateRichPresence();
 
+  void UpdateMemoryRanges();
+  void TakeMemorySnapshot();
+  std::optional<u32> ReadFromMemorySnapshot(u32 address, u32 num_bytes) const;
+
   ResponseType AwardAchievement(AchievementId achievement_id);
   ResponseType SubmitLeaderboard(AchievementId leaderboard_id, int value);
   ResponseType PingRichPresence(const RichPresence& rich_presence);
@@ -182,6 +205,18 @@ private:
   RichPresence m_rich_presence;
   time_t m_last_ping_time = 0;
 
+  // The memrefs of the runtime are read from a copy of the RAM they reference, which is taken at
+  // the start of every frame, rather than one MMU read at a time. Memrefs that are read through a
+  // pointer, or that aren't in RAM, are still read through the MMU.
+  std::vector<MemoryRange> m_memory_ranges;
+  std::vector<u8> m_memory_snapshot;
+  std::atomic<bool> m_memory_ranges_dirty = true;
+  bool m_memory_snapshot_valid = false;
+
+  // Hashes of game files that were hashed ahead of time, such as by the game list
+  std::unordered_map<std::string, std::string> m_known_game_hashes;
+  std::mutex m_known_game_hashes_lock;
+
   std::unordered_map<AchievementId, UnlockStatus> m_unlock_map;
   std::unordered_map<AchievementId, LeaderboardStatus> m_leaderboard_map;
 
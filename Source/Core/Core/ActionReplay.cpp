@@ -21,9 +21,11 @@
 #include "Core/ActionReplay.h"
 
 #include <algorithm>
+#include <array>
 #include <atomic>
 #include <iterator>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <utility>
 #include <variant>
@@ -81,9 +83,59 @@ enum
   SUB_MASTER_CODE = 0x03,
 };
 
+// A code decoded ahead of time, so that running it doesn't have to interpret every line again.
+// Conditional codes know where to continue if they fail, and the two lines of zero codes that use
+// the following line are one op.
+struct CompiledOp
+{
+  enum class Type : u8
+  {
+    Write8,
+    Write16,
+    Write32,
+    WritePointer8,
+    WritePointer16,
+    WritePointer32,
+    Add8,
+    Add16,
+    Add32,
+    AddFloat,
+    FillAndSlide,
+    MemoryCopy,
+    MemoryCopyWithPointers,
+    Compare,
+    End,
+  };
+
+  Type type;
+  // FillAndSlide and Compare: DATATYPE_*
+  u8 size = 0;
+  // Compare: CONDTIONAL_*
+  u8 condition = 0;
+  // FillAndSlide: the first address written. MemoryCopy: the destination.
+  u32 address = 0;
+  // FillAndSlide: the first value written. MemoryCopy: the number of bytes.
+  u32 value = 0;
+  // FillAndSlide: the increments and count. MemoryCopy: the source. Compare: the index of the op
+  // to continue at if the comparison fails.
+  u32 arg = 0;
+};
+using CompiledCode = std::vector<CompiledOp>;
+
+static std::optional<CompiledCode> CompileCode(const std::vector<AREntry>& ops);
+
+struct ActiveCode
+{
+  explicit ActiveCode(ARCode code_) : code(std::move(code_)), compiled(CompileCode(code.ops)) {}
+
+  ARCode code;
+  // Unset if the code uses something that only the interpreter handles, such as the errors
+  std::optional<CompiledCode> compiled;
+};
+
 // General lock. Protects codes list and internal log.
 static std::mutex s_lock;
-static std::vector<ARCode> s_active_codes;
+static std::vector<ActiveCode> s_active_codes;
 static std::vector<ARCode> s_synced_codes;
 static std::vector<std::string> s_internal_log;
 static std::atomic<bool> s_use_internal_log{false};
@@ -120,8 +172,11 @@ void ApplyCodes(std::span<const ARCode> codes)
   std::lock_guard guard(s_lock);
   s_disable_logging = false;
   s_active_codes.clear();
-  std::copy_if(codes.begin(), codes.end(), std::back_inserter(s_active_codes),
-               [](const ARCode& code) { return code.enabled; });
+  for (const ARCode& code : codes)
+  {
+    if (code.enabled)
+      s_active_codes.emplace_back(code);
+  }
   s_active_codes.shrink_to_fit();
 }
 
@@ -129,7 +184,8 @@ void SetSyncedCodesAsActive()
 {
   s_active_codes.clear();
   s_active_codes.reserve(s_synced_codes.size());
-  s_active_codes = s_synced_codes;
+  for (const ARCode& code : s_synced_codes)
+    s_active_codes.emplace_back(code);
 }
 
 void UpdateSyncedCodes(std::span<const ARCode> codes)
@@ -148,12 +204,19 @@ std::vector<ARCode> ApplyAndReturnCodes(std::span<const ARCode> codes)
     std::lock_guard guard(s_lock);
     s_disable_logging = false;
     s_active_codes.clear();
-    std::copy_if(codes.begin(), codes.end(), std::back_inserter(s_active_codes),
-                 [](const ARCode& code) { return code.enabled; });
+    for (const ARCode& code : codes)
+    {
+      if (code.enabled)
+        s_active_codes.emplace_back(code);
+    }
   }
   s_active_codes.shrink_to_fit();
 
-  return s_active_codes;
+  std::vector<ARCode> active_codes;
+  active_codes.reserve(s_active_codes.size());
+  for (const ActiveCode& active_code : s_active_codes)
+    active_codes.push_back(active_code.code);
+  return active_codes;
 }
 
 void AddCode(ARCode code)
@@ -988,6 +1051,265 @@ static bool RunCodeLocked(const Core::CPUThreadGuard& guard, const ARCode& arcod
   return true;
 }
 
+static std::optional<CompiledCode> CompileCode(const std::vector<AREntry>& ops)
+{
+  // Lines that are the data of the zero code before them, which don't run on their own
+  std::vector<bool> is_data_line(ops.size());
+  for (size_t i = 0; i + 1 < ops.size(); ++i)
+  {
+    if (ops[i].cmd_addr == 0 && (ops[i].value >> 29) == ZCODE_04)
+      is_data_line[++i] = true;
+  }
+
+  CompiledCode compiled;
+  // The op that each line starts at
+  std::vector<u32> op_index(ops.size() + 1);
+  // The compares that continue at a line that isn't compiled yet, and that line
+  std::vector<std::pair<size_t, size_t>> compare_targets;
+
+  for (size_t i = 0; i < ops.size(); ++i)
+  {
+    op_index[i] = static_cast<u32>(compiled.size());
+    if (is_data_line[i])
+      continue;
+
+    const ARAddr addr(ops[i].cmd_addr);
+    const u32 data = ops[i].value;
+
+    if (addr >= 0x00002000 && addr < 0x00003000)
+      return std::nullopt;
+
+    if (addr == 0)
+    {
+      switch (data >> 29)
+      {
+      case ZCODE_END:
+        compiled.push_back({CompiledOp::Type::End});
+        break;
+
+      case ZCODE_NORM:
+        break;
+
+      case ZCODE_04:
+      {
+        // Without a following line, this does nothing
+        if (i + 1 == ops.size())
+          break;
+
+        const ARAddr next_addr(ops[i + 1].cmd_addr);
+        const u32 next_data = ops[i + 1].value;
+        if (0x3 == ((data >> 25) & 0x03))
+        {
+          if ((next_data & 0xFF0000) != 0)
+            return std::nullopt;
+          const auto type = (next_data >> 24) != 0 ? CompiledOp::Type::MemoryCopyWithPointers :
+                                                     CompiledOp::Type::MemoryCopy;
+          const u8 num_bytes = static_cast<u8>(next_data & 0x7FFF);
+          compiled.push_back({type, 0, 0, data & ~0x06000000, num_bytes, next_addr.GCAddress()});
+        }
+        else
+        {
+          const u8 size = ARAddr(data).size;
+          if (size == DATATYPE_32BIT_FLOAT)
+            return std::nullopt;
+          compiled.push_back({CompiledOp::Type::FillAndSlide, size, 0, ARAddr(data).GCAddress(),
+                              next_addr.address, next_data});
+        }
+        break;
+      }
+
+      default:
+        return std::nullopt;
+      }
+      continue;
+    }
+
+    const u32 address = addr.GCAddress();
+    if (addr.type == 0x00)
+    {
+      static constexpr std::array<std::array<CompiledOp::Type, 4>, 3> types{{
+          {CompiledOp::Type::Write8, CompiledOp::Type::Write16, CompiledOp::Type::Write32,
+           CompiledOp::Type::Write32},
+          {CompiledOp::Type::WritePointer8, CompiledOp::Type::WritePointer16,
+           CompiledOp::Type::WritePointer32, CompiledOp::Type::WritePointer32},
+          {CompiledOp::Type::Add8, CompiledOp::Type::Add16, CompiledOp::Type::Add32,
+           CompiledOp::Type::AddFloat},
+      }};
+      // Master codes aren't supported
+      if (addr.subtype >= types.size())
+        return std::nullopt;
+      compiled.push_back({types[addr.subtype][addr.size], 0, 0, address, data});
+      continue;
+    }
+
+    if (addr.type > CONDTIONAL_AND)
+      return std::nullopt;
+
+    size_t target;
+    switch (addr.subtype)
+    {
+    case CONDTIONAL_ONE_LINE:
+    case CONDTIONAL_TWO_LINES:
+      target = std::min(i + 2 + addr.subtype, ops.size());
+      break;
+    case CONDTIONAL_ALL_LINES_UNTIL:
+    {
+      const auto end_if = std::find(ops.begin() + i + 1, ops.end(), AREntry(0, 0x40000000));
+      target = end_if == ops.end() ? ops.size() : end_if - ops.begin() + 1;
+      break;
+    }
+    case CONDTIONAL_ALL_LINES:
+    default:
+      target = ops.size();
+      break;
+    }
+    // Continuing at the data line of a zero code would run it on its own
+    if (target < ops.size() && is_data_line[target])
+      return std::nullopt;
+
+    compare_targets.emplace_back(compiled.size(), target);
+    compiled.push_back({CompiledOp::Type::Compare, static_cast<u8>(addr.size),
+                        static_cast<u8>(addr.type), address, data});
+  }
+
+  op_index[ops.size()] = static_cast<u32>(compiled.size());
+  for (const auto& [compare, target] : compare_targets)
+    compiled[compare].arg = op_index[target];
+
+  return compiled;
+}
+
+// Does the same as RunCodeLocked, without logging
+static void RunCompiledCode(const Core::CPUThreadGuard& guard, const CompiledCode& compiled)
+{
+  using PowerPC::MMU;
+
+  size_t i = 0;
+  while (i < compiled.size())
+  {
+    const CompiledOp& op = compiled[i++];
+    const u32 address = op.address;
+    const u32 data = op.value;
+
+    switch (op.type)
+    {
+    case CompiledOp::Type::Write8:
+      for (u32 j = 0; j <= (data >> 8); ++j)
+        MMU::HostWrite_U8(guard, data & 0xFF, address + j);
+      break;
+
+    case CompiledOp::Type::Write16:
+      for (u32 j = 0; j <= (data >> 16); ++j)
+        MMU::HostWrite_U16(guard, data & 0xFFFF, address + j * 2);
+      break;
+
+    case CompiledOp::Type::Write32:
+      MMU::HostWrite_U32(guard, data, address);
+      break;
+
+    case CompiledOp::Type::WritePointer8:
+      MMU::HostWrite_U8(guard, data & 0xFF, MMU::HostRead_U32(guard, address) + (data >> 8));
+      break;
+
+    case CompiledOp::Type::WritePointer16:
+      MMU::HostWrite_U16(guard, data & 0xFFFF,
+                         MMU::HostRead_U32(guard, address) + ((data >> 16) << 1));
+      break;
+
+    case CompiledOp::Type::WritePointer32:
+      MMU::HostWrite_U32(guard, data, MMU::HostRead_U32(guard, address));
+      break;
+
+    case CompiledOp::Type::Add8:
+      MMU::HostWrite_U8(guard, MMU::HostRead_U8(guard, address) + data, address);
+      break;
+
+    case CompiledOp::Type::Add16:
+      MMU::HostWrite_U16(guard, MMU::HostRead_U16(guard, address) + data, address);
+      break;
+
+    case CompiledOp::Type::Add32:
+      MMU::HostWrite_U32(guard, MMU::HostRead_U32(guard, address) + data, address);
+      break;
+
+    case CompiledOp::Type::AddFloat:
+    {
+      const float value = Common::BitCast<float>(MMU::HostRead_U32(guard, address));
+      MMU::HostWrite_U32(guard, Common::BitCast<u32>(value + static_cast<float>(data)), address);
+      break;
+    }
+
+    case CompiledOp::Type::FillAndSlide:
+    {
+      const s16 addr_incr = static_cast<s16>(op.arg & 0xFFFF);
+      const s8 val_incr = static_cast<s8>(op.arg >> 24);
+      const u8 write_num = static_cast<u8>((op.arg & 0xFF0000) >> 16);
+      u32 val = data;
+      u32 curr_addr = address;
+      for (int j = 0; j < write_num; ++j)
+      {
+        switch (op.size)
+        {
+        case DATATYPE_8BIT:
+          MMU::HostWrite_U8(guard, val & 0xFF, curr_addr);
+          curr_addr += addr_incr;
+          break;
+        case DATATYPE_16BIT:
+          MMU::HostWrite_U16(guard, val & 0xFFFF, curr_addr);
+          curr_addr += addr_incr * 2;
+          break;
+        default:
+          MMU::HostWrite_U32(guard, val, curr_addr);
+          curr_addr += addr_incr * 4;
+          break;
+        }
+        val += val_incr;
+      }
+      break;
+    }
+
+    case CompiledOp::Type::MemoryCopy:
+    case CompiledOp::Type::MemoryCopyWithPointers:
+    {
+      u32 dest = address;
+      u32 src = op.arg;
+      if (op.type == CompiledOp::Type::MemoryCopyWithPointers)
+      {
+        dest = MMU::HostRead_U32(guard, dest);
+        src = MMU::HostRead_U32(guard, src);
+      }
+      for (u32 j = 0; j < data; ++j)
+        MMU::HostWrite_U8(guard, MMU::HostRead_U8(guard, src + j), dest + j);
+      break;
+    }
+
+    case CompiledOp::Type::Compare:
+    {
+      u32 value;
+      switch (op.size)
+      {
+      case DATATYPE_8BIT:
+        value = MMU::HostRead_U8(guard, address);
+        break;
+      case DATATYPE_16BIT:
+        value = MMU::HostRead_U16(guard, address);
+        break;
+      default:
+        value = MMU::HostRead_U32(guard, address);
+        break;
+      }
+      const u32 mask = op.size == DATATYPE_8BIT ? 0xFF : op.size == DATATYPE_16BIT ? 0xFFFF : ~0u;
+      if (!CompareValues(value, data & mask, op.condition))
+        i = op.arg;
+      break;
+    }
+
+    case CompiledOp::Type::End:
+      return;
+    }
+  }
+}
+
 void RunAllActive(const Core::CPUThreadGuard& cpu_guard)
 {
   if (!Config::Get(Config::MAIN_ENABLE_CHEATS))
@@ -998,8 +1320,15 @@ void RunAllActive(const Core::CPUThreadGuard& cpu_guard)
   // be contested.
   std::lock_guard guard(s_lock);
   s_active_codes.erase(std::remove_if(s_active_codes.begin(), s_active_codes.end(),
-                                      [&cpu_guard](const ARCode& code) {
-                                        bool success = RunCodeLocked(cpu_guard, code);
+                                      [&cpu_guard](const ActiveCode& active_code) {
+                                        // The first run after the codes changed is logged, and
+                                        // finds the codes that fail
+                                        if (s_disable_logging && active_code.compiled)
+                                        {
+                                          RunCompiledCode(cpu_guard, *active_code.compiled);
+                                          return false;
+                                        }
+                                        bool success = RunCodeLocked(cpu_guard, active_code.code);
                                         LogInfo("\n");
                                         return !success;
                                       }),
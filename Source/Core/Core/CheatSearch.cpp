@@ -3,10 +3,17 @@
 
 #include "Core/CheatSearch.h"
 
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
 #include <functional>
+#include <future>
+#include <iterator>
 #include <memory>
 #include <optional>
 #include <string>
+#include <thread>
 #include <type_traits>
 #include <variant>
 #include <vector>
@@ -15,6 +22,7 @@
 #include "Common/Assert.h"
 #include "Common/BitUtils.h"
 #include "Common/StringUtil.h"
+#include "Common/Swap.h"
 
 #include "Core/Core.h"
 #include "Core/HW/Memmap.h"
@@ -99,224 +107,447 @@ std::vector<u8> Cheats::GetValueAsByteVector(const Cheats::SearchValue& value)
   }
 }
 
-namespace
+template <typename T>
+Cheats::SearchResults<T>::SearchResults(u32 step) : m_step(step)
 {
+}
+
 template <typename T>
-static std::optional<PowerPC::ReadResult<T>>
-TryReadValueFromEmulatedMemory(const Core::CPUThreadGuard& guard, u32 addr,
-                               PowerPC::RequestedAddressSpace space);
+size_t Cheats::SearchResults<T>::Page::GetCount() const
+{
+  size_t count = 0;
+  for (const u64 word : words)
+    count += std::popcount(word);
+  return count;
+}
 
-template <>
-std::optional<PowerPC::ReadResult<u8>>
-TryReadValueFromEmulatedMemory(const Core::CPUThreadGuard& guard, u32 addr,
-                               PowerPC::RequestedAddressSpace space)
+template <typename T>
+void Cheats::SearchResults<T>::Page::SetBitmap(const std::array<u64, WORD_COUNT>& bitmap)
 {
-  return PowerPC::MMU::HostTryReadU8(guard, addr, space);
+  word_mask = 0;
+  words.clear();
+  for (u32 i = 0; i < WORD_COUNT; ++i)
+  {
+    if (bitmap[i] == 0)
+      continue;
+    word_mask |= u64{1} << i;
+    words.push_back(bitmap[i]);
+  }
+  words.shrink_to_fit();
 }
 
-template <>
-std::optional<PowerPC::ReadResult<u16>>
-TryReadValueFromEmulatedMemory(const Core::CPUThreadGuard& guard, u32 addr,
-                               PowerPC::RequestedAddressSpace space)
+template <typename T>
+void Cheats::SearchResults<T>::AddPages(std::vector<Page> pages)
 {
-  return PowerPC::MMU::HostTryReadU16(guard, addr, space);
+  for (Page& page : pages)
+  {
+    const size_t count = page.GetCount();
+    if (count == 0)
+      continue;
+    m_first_indices.push_back(m_count);
+    m_count += count;
+    m_pages.push_back(std::move(page));
+  }
 }
 
-template <>
-std::optional<PowerPC::ReadResult<u32>>
-TryReadValueFromEmulatedMemory(const Core::CPUThreadGuard& guard, u32 addr,
-                               PowerPC::RequestedAddressSpace space)
+template <typename T>
+size_t Cheats::SearchResults<T>::GetPageIndex(size_t index) const
 {
-  return PowerPC::MMU::HostTryReadU32(guard, addr, space);
+  const auto it = std::upper_bound(m_first_indices.begin(), m_first_indices.end(), index);
+  return static_cast<size_t>(it - m_first_indices.begin()) - 1;
 }
 
-template <>
-std::optional<PowerPC::ReadResult<u64>>
-TryReadValueFromEmulatedMemory(const Core::CPUThreadGuard& guard, u32 addr,
-                               PowerPC::RequestedAddressSpace space)
+template <typename T>
+size_t Cheats::SearchResults<T>::GetPageEnd(size_t page_index) const
 {
-  return PowerPC::MMU::HostTryReadU64(guard, addr, space);
+  return page_index + 1 < m_first_indices.size() ? m_first_indices[page_index + 1] : m_count;
 }
 
-template <>
-std::optional<PowerPC::ReadResult<s8>>
-TryReadValueFromEmulatedMemory(const Core::CPUThreadGuard& guard, u32 addr,
-                               PowerPC::RequestedAddressSpace space)
+template <typename T>
+size_t Cheats::SearchResults<T>::GetValidValueCount() const
 {
-  auto tmp = PowerPC::MMU::HostTryReadU8(guard, addr, space);
-  if (!tmp)
-    return std::nullopt;
-  return PowerPC::ReadResult<s8>(tmp->translated, Common::BitCast<s8>(tmp->value));
+  size_t count = 0;
+  for (size_t i = 0; i < m_pages.size(); ++i)
+  {
+    if (m_pages[i].value_state != SearchResultValueState::AddressNotAccessible)
+      count += GetPageEnd(i) - m_first_indices[i];
+  }
+  return count;
 }
 
-template <>
-std::optional<PowerPC::ReadResult<s16>>
-TryReadValueFromEmulatedMemory(const Core::CPUThreadGuard& guard, u32 addr,
-                               PowerPC::RequestedAddressSpace space)
+template <typename T>
+Cheats::SearchResult<T> Cheats::SearchResults<T>::Get(size_t index) const
 {
-  auto tmp = PowerPC::MMU::HostTryReadU16(guard, addr, space);
-  if (!tmp)
-    return std::nullopt;
-  return PowerPC::ReadResult<s16>(tmp->translated, Common::BitCast<s16>(tmp->value));
+  const size_t page_index = GetPageIndex(index);
+  const Page& page = m_pages[page_index];
+  const size_t index_in_page = index - m_first_indices[page_index];
+
+  // Find the word with the result, and then the bit within it
+  size_t remaining = index_in_page;
+  size_t word_entry = 0;
+  u64 mask = page.word_mask;
+  while (remaining >= static_cast<size_t>(std::popcount(page.words[word_entry])))
+  {
+    remaining -= std::popcount(page.words[word_entry]);
+    mask &= mask - 1;
+    ++word_entry;
+  }
+  u64 bits = page.words[word_entry];
+  for (; remaining != 0; --remaining)
+    bits &= bits - 1;
+  const u32 slot = std::countr_zero(mask) * 64 + std::countr_zero(bits);
+
+  SearchResult<T> result;
+  result.m_value = page.values.empty() ? T(0) : page.values[index_in_page];
+  result.m_value_state = page.value_state;
+  result.m_address = page.address + slot * m_step;
+  return result;
 }
 
-template <>
-std::optional<PowerPC::ReadResult<s32>>
-TryReadValueFromEmulatedMemory(const Core::CPUThreadGuard& guard, u32 addr,
-                               PowerPC::RequestedAddressSpace space)
+template <typename T>
+Cheats::SearchResults<T> Cheats::SearchResults<T>::GetSubset(std::vector<size_t> indices) const
 {
-  auto tmp = PowerPC::MMU::HostTryReadU32(guard, addr, space);
-  if (!tmp)
-    return std::nullopt;
-  return PowerPC::ReadResult<s32>(tmp->translated, Common::BitCast<s32>(tmp->value));
+  std::sort(indices.begin(), indices.end());
+  indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+
+  std::vector<Page> pages;
+  auto it = indices.begin();
+  while (it != indices.end() && *it < m_count)
+  {
+    const size_t page_index = GetPageIndex(*it);
+    const Page& page = m_pages[page_index];
+    size_t index = m_first_indices[page_index];
+
+    Page& new_page = pages.emplace_back();
+    new_page.address = page.address;
+    new_page.value_state = page.value_state;
+
+    std::array<u64, Page::WORD_COUNT> bitmap{};
+    size_t word_entry = 0;
+    for (u64 mask = page.word_mask; mask != 0; mask &= mask - 1)
+    {
+      const u32 word = std::countr_zero(mask);
+      for (u64 bits = page.words[word_entry++]; bits != 0; bits &= bits - 1, ++index)
+      {
+        if (it == indices.end() || *it != index)
+          continue;
+
+        bitmap[word] |= bits & ~(bits - 1);
+        if (!page.values.empty())
+          new_page.values.push_back(page.values[index - m_first_indices[page_index]]);
+        ++it;
+      }
+    }
+    new_page.SetBitmap(bitmap);
+  }
+
+  SearchResults subset(m_step);
+  subset.AddPages(std::move(pages));
+  return subset;
 }
 
-template <>
-std::optional<PowerPC::ReadResult<s64>>
-TryReadValueFromEmulatedMemory(const Core::CPUThreadGuard& guard, u32 addr,
-                               PowerPC::RequestedAddressSpace space)
+namespace
 {
-  auto tmp = PowerPC::MMU::HostTryReadU64(guard, addr, space);
-  if (!tmp)
-    return std::nullopt;
-  return PowerPC::ReadResult<s64>(tmp->translated, Common::BitCast<s64>(tmp->value));
+using Cheats::SearchResultValueState;
+
+// The start of the next page is copied along with every page, for the values that cross into it
+constexpr u32 PAGE_SIZE = 4096;
+constexpr u32 SNAPSHOT_SIZE = PAGE_SIZE + sizeof(u64) - 1;
+static_assert(PAGE_SIZE == PowerPC::HW_PAGE_SIZE);
+
+// Searching fewer pages than this on a thread isn't worth starting it
+constexpr size_t MIN_PAGES_PER_THREAD = 64;
+
+template <typename T>
+T ReadBigEndian(const u8* data)
+{
+  T value;
+  std::memcpy(&value, data, sizeof(T));
+  return Common::FromBigEndian(value);
 }
 
-template <>
-std::optional<PowerPC::ReadResult<float>>
-TryReadValueFromEmulatedMemory(const Core::CPUThreadGuard& guard, u32 addr,
-                               PowerPC::RequestedAddressSpace space)
+// Bytes of the next page that isn't RAM are left as 0, as HostTryRead returns for them as well
+bool SnapshotPage(const Core::CPUThreadGuard& guard, u32 page_address,
+                  PowerPC::RequestedAddressSpace address_space, u8* snapshot)
 {
-  return PowerPC::MMU::HostTryReadF32(guard, addr, space);
+  if (!PowerPC::MMU::HostTryCopyFromPage(guard, page_address, snapshot, PAGE_SIZE, address_space))
+    return false;
+
+  const u32 next_page_address = page_address + PAGE_SIZE;
+  if (next_page_address == 0 ||
+      !PowerPC::MMU::HostTryCopyFromPage(guard, next_page_address, snapshot + PAGE_SIZE,
+                                         SNAPSHOT_SIZE - PAGE_SIZE, address_space))
+  {
+    std::memset(snapshot + PAGE_SIZE, 0, SNAPSHOT_SIZE - PAGE_SIZE);
+  }
+  return true;
 }
 
-template <>
-std::optional<PowerPC::ReadResult<double>>
-TryReadValueFromEmulatedMemory(const Core::CPUThreadGuard& guard, u32 addr,
-                               PowerPC::RequestedAddressSpace space)
+SearchResultValueState GetValueState(const Core::System& system,
+                                     PowerPC::RequestedAddressSpace address_space)
 {
-  return PowerPC::MMU::HostTryReadF64(guard, addr, space);
+  const bool translated = address_space == PowerPC::RequestedAddressSpace::Virtual ||
+                          (address_space == PowerPC::RequestedAddressSpace::Effective &&
+                           system.GetPPCState().msr.DR);
+  return translated ? SearchResultValueState::ValueFromVirtualMemory :
+                      SearchResultValueState::ValueFromPhysicalMemory;
 }
-}  // namespace
 
-template <typename T>
-Common::Result<Cheats::SearchErrorCode, std::vector<Cheats::SearchResult<T>>>
-Cheats::NewSearch(const Core::CPUThreadGuard& guard,
-                  const std::vector<Cheats::MemoryRange>& memory_ranges,
-                  PowerPC::RequestedAddressSpace address_space, bool aligned,
-                  const std::function<bool(const T& value)>& validator)
+Cheats::SearchErrorCode CheckCanSearch(const Core::System& system,
+                                       PowerPC::RequestedAddressSpace address_space)
 {
-  const u32 data_size = sizeof(T);
-  std::vector<Cheats::SearchResult<T>> results;
-  Cheats::SearchErrorCode error_code = Cheats::SearchErrorCode::Success;
-  Core::RunAsCPUThread([&] {
-    const Core::State core_state = Core::GetState();
-    if (core_state != Core::State::Running && core_state != Core::State::Paused)
+  const Core::State core_state = Core::GetState();
+  if (core_state != Core::State::Running && core_state != Core::State::Paused)
+    return Cheats::SearchErrorCode::NoEmulationActive;
+
+  if (address_space == PowerPC::RequestedAddressSpace::Virtual && !system.GetPPCState().msr.DR)
+    return Cheats::SearchErrorCode::VirtualAddressesCurrentlyNotAccessible;
+
+  return Cheats::SearchErrorCode::Success;
+}
+
+// Calls scan_page for every page index below page_count, on as many threads as are worth it, and
+// returns the pages with results in order.
+template <typename T, typename ScanPage>
+std::vector<typename Cheats::SearchResults<T>::Page> ScanPages(size_t page_count,
+                                                               const ScanPage& scan_page)
+{
+  using Page = typename Cheats::SearchResults<T>::Page;
+
+  const auto scan_pages = [&scan_page](size_t begin, size_t end) {
+    std::vector<Page> pages;
+    for (size_t i = begin; i < end; ++i)
     {
-      error_code = Cheats::SearchErrorCode::NoEmulationActive;
-      return;
+      Page page = scan_page(i);
+      if (page.word_mask != 0)
+        pages.push_back(std::move(page));
     }
+    return pages;
+  };
+
+  const size_t thread_count =
+      std::clamp<size_t>(page_count / MIN_PAGES_PER_THREAD, 1,
+                         std::max<size_t>(std::thread::hardware_concurrency(), 1));
+  if (thread_count == 1)
+    return scan_pages(0, page_count);
+
+  const size_t pages_per_thread = (page_count + thread_count - 1) / thread_count;
+  std::vector<std::future<std::vector<Page>>> futures;
+  for (size_t begin = 0; begin < page_count; begin += pages_per_thread)
+  {
+    futures.push_back(std::async(std::launch::async, scan_pages, begin,
+                                 std::min(begin + pages_per_thread, page_count)));
+  }
+
+  std::vector<Page> pages;
+  for (auto& future : futures)
+  {
+    std::vector<Page> thread_pages = future.get();
+    std::move(thread_pages.begin(), thread_pages.end(), std::back_inserter(pages));
+  }
+  return pages;
+}
+
+// The bits of a bitmap word for the slots in [first_slot, end_slot)
+u64 GetSlotMask(u32 word, u32 first_slot, u32 end_slot)
+{
+  const u32 word_start = word * 64;
+  u64 mask = ~u64{0};
+  if (first_slot > word_start)
+    mask &= ~u64{0} << (first_slot - word_start);
+  if (end_slot < word_start + 64)
+    mask &= ~(~u64{0} << (end_slot - word_start));
+  return mask;
+}
+
+// Do a new search across the given memory region in the given address space, only keeping values
+// for which the given validator returns true. The memory is copied page by page, and compared on
+// multiple threads.
+template <typename T, typename Validator>
+Common::Result<Cheats::SearchErrorCode, Cheats::SearchResults<T>>
+NewSearch(const Core::CPUThreadGuard& guard, const std::vector<Cheats::MemoryRange>& memory_ranges,
+          PowerPC::RequestedAddressSpace address_space, bool aligned, const Validator& validator)
+{
+  using Page = typename Cheats::SearchResults<T>::Page;
 
+  struct PageToScan
+  {
+    u32 address;
+    u32 first_slot;
+    u32 end_slot;
+  };
+
+  const u32 data_size = sizeof(T);
+  const u32 step = aligned ? data_size : 1;
+  std::vector<PageToScan> pages_to_scan;
+  std::vector<u8> snapshots;
+  SearchResultValueState value_state{};
+  Cheats::SearchErrorCode error_code = Cheats::SearchErrorCode::Success;
+  Core::RunAsCPUThread([&] {
     auto& system = Core::System::GetInstance();
-    auto& ppc_state = system.GetPPCState();
-    if (address_space == PowerPC::RequestedAddressSpace::Virtual && !ppc_state.msr.DR)
-    {
-      error_code = Cheats::SearchErrorCode::VirtualAddressesCurrentlyNotAccessible;
+    error_code = CheckCanSearch(system, address_space);
+    if (error_code != Cheats::SearchErrorCode::Success)
       return;
-    }
+    value_state = GetValueState(system, address_space);
 
     for (const Cheats::MemoryRange& range : memory_ranges)
     {
       if (range.m_length < data_size)
         continue;
 
-      const u32 increment_per_loop = aligned ? data_size : 1;
       const u32 start_address = aligned ? Common::AlignUp(range.m_start, data_size) : range.m_start;
       const u64 aligned_length = range.m_length - (start_address - range.m_start);
 
       if (aligned_length < data_size)
         continue;
 
-      const u64 length = aligned_length - (data_size - 1);
-      for (u64 i = 0; i < length; i += increment_per_loop)
+      // The values that start at or after end would reach past the range
+      const u64 end = std::min<u64>(u64{start_address} + aligned_length - (data_size - 1),
+                                    u64{1} << 32);
+      for (u64 page = start_address & ~u64{PAGE_SIZE - 1}; page < end; page += PAGE_SIZE)
       {
-        const u32 addr = start_address + i;
-        const auto current_value = TryReadValueFromEmulatedMemory<T>(guard, addr, address_space);
-        if (!current_value)
-          continue;
+        const u64 first = std::max<u64>(page, start_address);
+        const u64 last = std::min<u64>(page + PAGE_SIZE, end);
 
-        if (validator(current_value->value))
+        const size_t snapshot_offset = snapshots.size();
+        snapshots.resize(snapshot_offset + SNAPSHOT_SIZE);
+        if (!SnapshotPage(guard, static_cast<u32>(page), address_space,
+                          snapshots.data() + snapshot_offset))
         {
-          auto& r = results.emplace_back();
-          r.m_value = current_value->value;
-          r.m_value_state = current_value->translated ?
-                                Cheats::SearchResultValueState::ValueFromVirtualMemory :
-                                Cheats::SearchResultValueState::ValueFromPhysicalMemory;
-          r.m_address = addr;
+          snapshots.resize(snapshot_offset);
+          continue;
         }
+
+        pages_to_scan.push_back({static_cast<u32>(page), static_cast<u32>((first - page) / step),
+                                 static_cast<u32>((last - page + step - 1) / step)});
       }
     }
   });
-  if (error_code == Cheats::SearchErrorCode::Success)
-    return results;
-  return error_code;
+  if (error_code != Cheats::SearchErrorCode::Success)
+    return error_code;
+
+  // Emulation can go on while the copies are compared
+  std::vector<Page> pages = ScanPages<T>(pages_to_scan.size(), [&](size_t i) {
+    const PageToScan& page_to_scan = pages_to_scan[i];
+    const u8* snapshot = snapshots.data() + i * SNAPSHOT_SIZE;
+
+    std::array<u64, Page::WORD_COUNT> bitmap{};
+    const u32 end_word = (page_to_scan.end_slot + 63) / 64;
+    for (u32 word = page_to_scan.first_slot / 64; word < end_word; ++word)
+    {
+      // A whole word of values is converted and compared at once, which lets the compiler
+      // vectorize both loops.
+      std::array<T, 64> values;
+      for (u32 bit = 0; bit < 64; ++bit)
+        values[bit] = ReadBigEndian<T>(snapshot + (word * 64 + bit) * step);
+
+      u64 bits = 0;
+      for (u32 bit = 0; bit < 64; ++bit)
+        bits |= u64{validator(values[bit])} << bit;
+
+      bitmap[word] = bits & GetSlotMask(word, page_to_scan.first_slot, page_to_scan.end_slot);
+    }
+
+    Page page;
+    page.address = page_to_scan.address;
+    page.value_state = value_state;
+    page.SetBitmap(bitmap);
+    for (u32 word = 0; word < Page::WORD_COUNT; ++word)
+    {
+      for (u64 bits = bitmap[word]; bits != 0; bits &= bits - 1)
+      {
+        const u32 slot = word * 64 + std::countr_zero(bits);
+        page.values.push_back(ReadBigEndian<T>(snapshot + slot * step));
+      }
+    }
+    page.values.shrink_to_fit();
+    return page;
+  });
+
+  Cheats::SearchResults<T> results(step);
+  results.AddPages(std::move(pages));
+  return results;
 }
 
-template <typename T>
-Common::Result<Cheats::SearchErrorCode, std::vector<Cheats::SearchResult<T>>>
-Cheats::NextSearch(const Core::CPUThreadGuard& guard,
-                   const std::vector<Cheats::SearchResult<T>>& previous_results,
-                   PowerPC::RequestedAddressSpace address_space,
-                   const std::function<bool(const T& new_value, const T& old_value)>& validator)
+// Refresh the values for the given results in the given address space, only keeping values for
+// which the given validator returns true.
+template <typename T, typename Validator>
+Common::Result<Cheats::SearchErrorCode, Cheats::SearchResults<T>>
+NextSearch(const Core::CPUThreadGuard& guard, const Cheats::SearchResults<T>& previous_results,
+           PowerPC::RequestedAddressSpace address_space, const Validator& validator)
 {
-  std::vector<Cheats::SearchResult<T>> results;
+  using Page = typename Cheats::SearchResults<T>::Page;
+
+  const std::vector<Page>& previous_pages = previous_results.GetPages();
+  const u32 step = previous_results.GetStep();
+  std::vector<u8> snapshots(previous_pages.size() * SNAPSHOT_SIZE);
+  std::vector<u8> accessible(previous_pages.size());
+  SearchResultValueState value_state{};
   Cheats::SearchErrorCode error_code = Cheats::SearchErrorCode::Success;
   Core::RunAsCPUThread([&] {
-    const Core::State core_state = Core::GetState();
-    if (core_state != Core::State::Running && core_state != Core::State::Paused)
-    {
-      error_code = Cheats::SearchErrorCode::NoEmulationActive;
+    auto& system = Core::System::GetInstance();
+    error_code = CheckCanSearch(system, address_space);
+    if (error_code != Cheats::SearchErrorCode::Success)
       return;
-    }
+    value_state = GetValueState(system, address_space);
 
-    auto& system = Core::System::GetInstance();
-    auto& ppc_state = system.GetPPCState();
-    if (address_space == PowerPC::RequestedAddressSpace::Virtual && !ppc_state.msr.DR)
+    for (size_t i = 0; i < previous_pages.size(); ++i)
     {
-      error_code = Cheats::SearchErrorCode::VirtualAddressesCurrentlyNotAccessible;
-      return;
+      accessible[i] = SnapshotPage(guard, previous_pages[i].address, address_space,
+                                   snapshots.data() + i * SNAPSHOT_SIZE);
     }
+  });
+  if (error_code != Cheats::SearchErrorCode::Success)
+    return error_code;
 
-    for (const auto& previous_result : previous_results)
-    {
-      const u32 addr = previous_result.m_address;
-      const auto current_value = TryReadValueFromEmulatedMemory<T>(guard, addr, address_space);
-      if (!current_value)
-      {
-        auto& r = results.emplace_back();
-        r.m_address = addr;
-        r.m_value_state = Cheats::SearchResultValueState::AddressNotAccessible;
-        continue;
-      }
+  std::vector<Page> pages = ScanPages<T>(previous_pages.size(), [&](size_t i) {
+    const Page& previous_page = previous_pages[i];
 
-      // if the previous state was invalid we always update the value to avoid getting stuck in an
-      // invalid state
-      if (!previous_result.IsValueValid() ||
-          validator(current_value->value, previous_result.m_value))
+    Page page;
+    page.address = previous_page.address;
+    if (!accessible[i])
+    {
+      page.value_state = SearchResultValueState::AddressNotAccessible;
+      page.word_mask = previous_page.word_mask;
+      page.words = previous_page.words;
+      return page;
+    }
+    page.value_state = value_state;
+
+    // if the previous state was invalid we always update the value to avoid getting stuck in an
+    // invalid state
+    const bool keep_all =
+        previous_page.value_state == SearchResultValueState::AddressNotAccessible;
+
+    const u8* snapshot = snapshots.data() + i * SNAPSHOT_SIZE;
+    std::array<u64, Page::WORD_COUNT> bitmap{};
+    size_t word_entry = 0;
+    size_t value_index = 0;
+    for (u64 mask = previous_page.word_mask; mask != 0; mask &= mask - 1)
+    {
+      const u32 word = std::countr_zero(mask);
+      for (u64 bits = previous_page.words[word_entry++]; bits != 0; bits &= bits - 1)
       {
-        auto& r = results.emplace_back();
-        r.m_value = current_value->value;
-        r.m_value_state = current_value->translated ?
-                              Cheats::SearchResultValueState::ValueFromVirtualMemory :
-                              Cheats::SearchResultValueState::ValueFromPhysicalMemory;
-        r.m_address = addr;
+        const u32 slot = word * 64 + std::countr_zero(bits);
+        const T value = ReadBigEndian<T>(snapshot + slot * step);
+        if (keep_all || validator(value, previous_page.values[value_index]))
+        {
+          bitmap[word] |= bits & ~(bits - 1);
+          page.values.push_back(value);
+        }
+        ++value_index;
       }
     }
+    page.SetBitmap(bitmap);
+    page.values.shrink_to_fit();
+    return page;
   });
-  if (error_code == Cheats::SearchErrorCode::Success)
-    return results;
-  return error_code;
+
+  Cheats::SearchResults<T> results(step);
+  results.AddPages(std::move(pages));
+  return results;
 }
+}  // namespace
 
 Cheats::CheatSearchSessionBase::~CheatSearchSessionBase() = default;
 
@@ -324,7 +555,8 @@ template <typename T>
 Cheats::CheatSearchSession<T>::CheatSearchSession(std::vector<MemoryRange> memory_ranges,
                                                   PowerPC::RequestedAddressSpace address_space,
                                                   bool aligned)
-    : m_memory_ranges(std::move(memory_ranges)), m_address_space(address_space), m_aligned(aligned)
+    : m_search_results(aligned ? static_cast<u32>(sizeof(T)) : 1),
+      m_memory_ranges(std::move(memory_ranges)), m_address_space(address_space), m_aligned(aligned)
 {
 }
 
@@ -390,98 +622,79 @@ template <typename T>
 void Cheats::CheatSearchSession<T>::ResetResults()
 {
   m_first_search_done = false;
-  m_search_results.clear();
+  m_search_results = SearchResults<T>(m_search_results.GetStep());
 }
 
-template <typename T>
-static std::function<bool(const T& new_value)>
-MakeCompareFunctionForSpecificValue(Cheats::CompareType op, const T& old_value)
+// Calls search with the comparison for the given CompareType. The comparison is passed as its own
+// type rather than as a std::function, so that it can be inlined into the loops of the search.
+template <typename T, typename Search>
+static Common::Result<Cheats::SearchErrorCode, Cheats::SearchResults<T>>
+SearchWithCompareType(Cheats::CompareType op, const Search& search)
 {
   switch (op)
   {
   case Cheats::CompareType::Equal:
-    return [&](const T& new_value) { return new_value == old_value; };
+    return search(std::equal_to<T>());
   case Cheats::CompareType::NotEqual:
-    return [&](const T& new_value) { return new_value != old_value; };
+    return search(std::not_equal_to<T>());
   case Cheats::CompareType::Less:
-    return [&](const T& new_value) { return new_value < old_value; };
+    return search(std::less<T>());
   case Cheats::CompareType::LessOrEqual:
-    return [&](const T& new_value) { return new_value <= old_value; };
+    return search(std::less_equal<T>());
   case Cheats::CompareType::Greater:
-    return [&](const T& new_value) { return new_value > old_value; };
+    return search(std::greater<T>());
   case Cheats::CompareType::GreaterOrEqual:
-    return [&](const T& new_value) { return new_value >= old_value; };
+    return search(std::greater_equal<T>());
   default:
     DEBUG_ASSERT(false);
-    return nullptr;
-  }
-}
-
-template <typename T>
-static std::function<bool(const T& old_value, const T& new_value)>
-MakeCompareFunctionForLastValue(Cheats::CompareType op)
-{
-  switch (op)
-  {
-  case Cheats::CompareType::Equal:
-    return [](const T& new_value, const T& old_value) { return new_value == old_value; };
-  case Cheats::CompareType::NotEqual:
-    return [](const T& new_value, const T& old_value) { return new_value != old_value; };
-  case Cheats::CompareType::Less:
-    return [](const T& new_value, const T& old_value) { return new_value < old_value; };
-  case Cheats::CompareType::LessOrEqual:
-    return [](const T& new_value, const T& old_value) { return new_value <= old_value; };
-  case Cheats::CompareType::Greater:
-    return [](const T& new_value, const T& old_value) { return new_value > old_value; };
-  case Cheats::CompareType::GreaterOrEqual:
-    return [](const T& new_value, const T& old_value) { return new_value >= old_value; };
-  default:
-    DEBUG_ASSERT(false);
-    return nullptr;
+    return Cheats::SearchErrorCode::InvalidParameters;
   }
 }
 
 template <typename T>
 Cheats::SearchErrorCode Cheats::CheatSearchSession<T>::RunSearch(const Core::CPUThreadGuard& guard)
 {
-  Common::Result<SearchErrorCode, std::vector<SearchResult<T>>> result =
+  Common::Result<SearchErrorCode, SearchResults<T>> result =
       Cheats::SearchErrorCode::InvalidParameters;
   if (m_filter_type == FilterType::CompareAgainstSpecificValue)
   {
     if (!m_value)
       return Cheats::SearchErrorCode::InvalidParameters;
 
-    auto func = MakeCompareFunctionForSpecificValue<T>(m_compare_type, *m_value);
-    if (m_first_search_done)
-    {
-      result = Cheats::NextSearch<T>(
-          guard, m_search_results, m_address_space,
-          [&func](const T& new_value, const T& old_value) { return func(new_value); });
-    }
-    else
-    {
-      result = Cheats::NewSearch<T>(guard, m_memory_ranges, m_address_space, m_aligned, func);
-    }
+    const T value = *m_value;
+    result = SearchWithCompareType<T>(m_compare_type, [&](auto compare) {
+      if (m_first_search_done)
+      {
+        return NextSearch<T>(guard, m_search_results, m_address_space,
+                             [compare, value](const T& new_value, const T& old_value) {
+                               return compare(new_value, value);
+                             });
+      }
+      return NewSearch<T>(
+          guard, m_memory_ranges, m_address_space, m_aligned,
+          [compare, value](const T& new_value) { return compare(new_value, value); });
+    });
   }
   else if (m_filter_type == FilterType::CompareAgainstLastValue)
   {
     if (!m_first_search_done)
       return Cheats::SearchErrorCode::InvalidParameters;
 
-    result = Cheats::NextSearch<T>(guard, m_search_results, m_address_space,
-                                   MakeCompareFunctionForLastValue<T>(m_compare_type));
+    result = SearchWithCompareType<T>(m_compare_type, [&](auto compare) {
+      return NextSearch<T>(guard, m_search_results, m_address_space, compare);
+    });
   }
   else if (m_filter_type == FilterType::DoNotFilter)
   {
     if (m_first_search_done)
     {
-      result = Cheats::NextSearch<T>(guard, m_search_results, m_address_space,
-                                     [](const T& v1, const T& v2) { return true; });
+      result = NextSearch<T>(guard, m_search_results, m_address_space,
+                             [](const T& v1, const T& v2) { return true; });
     }
     else
     {
-      result = Cheats::NewSearch<T>(guard, m_memory_ranges, m_address_space, m_aligned,
-                                    [](const T& v) { return true; });
+      result = NewSearch<T>(guard, m_memory_ranges, m_address_space, m_aligned,
+                            [](const T& v) { return true; });
     }
   }
 
@@ -540,64 +753,58 @@ bool Cheats::CheatSearchSession<T>::IsFloatingType() const
 template <typename T>
 size_t Cheats::CheatSearchSession<T>::GetResultCount() const
 {
-  return m_search_results.size();
+  return m_search_results.GetCount();
 }
 
 template <typename T>
 size_t Cheats::CheatSearchSession<T>::GetValidValueCount() const
 {
-  const auto& results = m_search_results;
-  size_t count = 0;
-  for (const auto& r : results)
-  {
-    if (r.IsValueValid())
-      ++count;
-  }
-  return count;
+  return m_search_results.GetValidValueCount();
 }
 
 template <typename T>
 u32 Cheats::CheatSearchSession<T>::GetResultAddress(size_t index) const
 {
-  return m_search_results[index].m_address;
+  return m_search_results.Get(index).m_address;
 }
 
 template <typename T>
 T Cheats::CheatSearchSession<T>::GetResultValue(size_t index) const
 {
-  return m_search_results[index].m_value;
+  return m_search_results.Get(index).m_value;
 }
 
 template <typename T>
 Cheats::SearchValue Cheats::CheatSearchSession<T>::GetResultValueAsSearchValue(size_t index) const
 {
-  return Cheats::SearchValue{m_search_results[index].m_value};
+  return Cheats::SearchValue{GetResultValue(index)};
 }
 
 template <typename T>
 std::string Cheats::CheatSearchSession<T>::GetResultValueAsString(size_t index, bool hex) const
 {
-  if (GetResultValueState(index) == Cheats::SearchResultValueState::AddressNotAccessible)
+  const SearchResult<T> result = m_search_results.Get(index);
+  if (result.m_value_state == Cheats::SearchResultValueState::AddressNotAccessible)
     return "(inaccessible)";
 
   if (hex)
   {
     if constexpr (std::is_same_v<T, float>)
-      return fmt::format("0x{0:08x}", Common::BitCast<u32>(m_search_results[index].m_value));
+      return fmt::format("0x{0:08x}", Common::BitCast<u32>(result.m_value));
     else if constexpr (std::is_same_v<T, double>)
-      return fmt::format("0x{0:016x}", Common::BitCast<u64>(m_search_results[index].m_value));
+      return fmt::format("0x{0:016x}", Common::BitCast<u64>(result.m_value));
     else
-      return fmt::format("0x{0:0{1}x}", m_search_results[index].m_value, sizeof(T) * 2);
+      return fmt::format("0x{0:0{1}x}", result.m_value, sizeof(T) * 2);
   }
 
-  return fmt::format("{}", m_search_results[index].m_value);
+  return fmt::format("{}", result.m_value);
 }
 
 template <typename T>
 Cheats::SearchResultValueState
 Cheats::CheatSearchSession<T>::GetResultValueState(size_t index) const
 {
-  return m_search_results[index].m_value_state;
+  return m_search_results.Get(index).m_value_state;
 }
 
 template <typename T>
@@ -616,15 +823,9 @@ template <typename T>
 std::unique_ptr<Cheats::CheatSearchSessionBase>
 Cheats::CheatSearchSession<T>::ClonePartial(const std::vector<size_t>& result_indices) const
 {
-  const auto& results = m_search_results;
-  std::vector<SearchResult<T>> partial_results;
-  partial_results.reserve(result_indices.size());
-  for (size_t idx : result_indices)
-    partial_results.push_back(results[idx]);
-
   auto c =
       std::make_unique<Cheats::CheatSearchSession<T>>(m_memory_ranges, m_address_space, m_aligned);
-  c->m_search_results = std::move(partial_results);
+  c->m_search_results = m_search_results.GetSubset(result_indices);
   c->m_compare_type = this->m_compare_type;
   c->m_filter_type = this->m_filter_type;
   c->m_value = this->m_value;
@@ -632,6 +833,17 @@ Cheats::CheatSearchSession<T>::ClonePartial(const std::vector<size_t>& result_in
   return c;
 }
 
+template class Cheats::SearchResults<u8>;
+template class Cheats::SearchResults<u16>;
+template class Cheats::SearchResults<u32>;
+template class Cheats::SearchResults<u64>;
+template class Cheats::SearchResults<s8>;
+template class Cheats::SearchResults<s16>;
+template class Cheats::SearchResults<s32>;
+template class Cheats::SearchResults<s64>;
+template class Cheats::SearchResults<float>;
+template class Cheats::SearchResults<double>;
+
 template class Cheats::CheatSearchSession<u8>;
 template class Cheats::CheatSearchSession<u16>;
 template class Cheats::CheatSearchSession<u32>;
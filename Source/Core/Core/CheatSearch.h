@@ -3,7 +3,7 @@
 
 #pragma once
 
-#include <functional>
+#include <array>
 #include <memory>
 #include <optional>
 #include <string>
@@ -78,6 +78,56 @@ struct SearchResult
   }
 };
 
+// The results of a search, ordered by address. For every page of memory that has results, a
+// bitmap says which of the searched addresses in the page are results, and only the values of
+// those are stored.
+template <typename T>
+class SearchResults
+{
+public:
+  // step is the distance between the searched addresses
+  explicit SearchResults(u32 step = 1);
+
+  size_t GetCount() const { return m_count; }
+  size_t GetValidValueCount() const;
+  SearchResult<T> Get(size_t index) const;
+
+  // Returns the results with the given indices, in the order of their addresses
+  SearchResults GetSubset(std::vector<size_t> indices) const;
+
+  struct Page
+  {
+    static constexpr u32 SIZE = 4096;
+    static constexpr u32 WORD_COUNT = 64;
+
+    u32 address = 0;
+    SearchResultValueState value_state = SearchResultValueState::AddressNotAccessible;
+    // Bit n is set if words has an entry for word n of the page's bitmap, which is only the case
+    // for words with results. Bit m of word n is result (n * 64 + m) * step bytes into the page.
+    u64 word_mask = 0;
+    std::vector<u64> words;
+    // The values of the results, or nothing if the page wasn't accessible
+    std::vector<T> values;
+
+    size_t GetCount() const;
+    void SetBitmap(const std::array<u64, WORD_COUNT>& bitmap);
+  };
+
+  u32 GetStep() const { return m_step; }
+  const std::vector<Page>& GetPages() const { return m_pages; }
+  void AddPages(std::vector<Page> pages);
+
+private:
+  size_t GetPageIndex(size_t index) const;
+  size_t GetPageEnd(size_t page_index) const;
+
+  u32 m_step;
+  std::vector<Page> m_pages;
+  // The index of the first result of every page
+  std::vector<size_t> m_first_indices;
+  size_t m_count = 0;
+};
+
 struct MemoryRange
 {
   u32 m_start;
@@ -109,22 +159,6 @@ DataType GetDataType(const SearchValue& value);
 // patches or action replay codes.
 std::vector<u8> GetValueAsByteVector(const SearchValue& value);
 
-// Do a new search across the given memory region in the given address space, only keeping values
-// for which the given validator returns true.
-template <typename T>
-Common::Result<SearchErrorCode, std::vector<SearchResult<T>>>
-NewSearch(const Core::CPUThreadGuard& guard, const std::vector<MemoryRange>& memory_ranges,
-          PowerPC::RequestedAddressSpace address_space, bool aligned,
-          const std::function<bool(const T& value)>& validator);
-
-// Refresh the values for the given results in the given address space, only keeping values for
-// which the given validator returns true.
-template <typename T>
-Common::Result<SearchErrorCode, std::vector<SearchResult<T>>>
-NextSearch(const Core::CPUThreadGuard& guard, const std::vector<SearchResult<T>>& previous_results,
-           PowerPC::RequestedAddressSpace address_space,
-           const std::function<bool(const T& new_value, const T& old_value)>& validator);
-
 class CheatSearchSessionBase
 {
 public:
@@ -214,7 +248,7 @@ public:
   ClonePartial(const std::vector<size_t>& result_indices) const override;
 
 private:
-  std::vector<SearchResult<T>> m_search_results;
+  SearchResults<T> m_search_results;
   std::vector<MemoryRange> m_memory_ranges;
   PowerPC::RequestedAddressSpace m_address_space;
   CompareType m_compare_type = CompareType::Equal;
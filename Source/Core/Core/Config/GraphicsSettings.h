@@ -22,6 +22,7 @@ namespace Config
 // Graphics.Hardware
 
 extern const Info<bool> GFX_VSYNC;
+extern const Info<bool> GFX_FRAME_PACING;
 extern const Info<int> GFX_ADAPTER;
 
 // Graphics.Settings
@@ -35,6 +36,7 @@ extern const Info<float> GFX_WIDESCREEN_HEURISTIC_STANDARD_RATIO;
 extern const Info<float> GFX_WIDESCREEN_HEURISTIC_WIDESCREEN_RATIO;
 extern const Info<bool> GFX_CROP;
 extern const Info<int> GFX_SAFE_TEXTURE_CACHE_COLOR_SAMPLES;
+extern const Info<int> GFX_TEXTURE_CACHE_MEMORY_BUDGET;
 extern const Info<bool> GFX_SHOW_FPS;
 extern const Info<bool> GFX_SHOW_FTIMES;
 extern const Info<bool> GFX_SHOW_VPS;
@@ -42,6 +44,9 @@ extern const Info<bool> GFX_SHOW_VTIMES;
 extern const Info<bool> GFX_SHOW_GRAPHS;
 extern const Info<bool> GFX_SHOW_SPEED;
 extern const Info<bool> GFX_SHOW_SPEED_COLORS;
+extern const Info<bool> GFX_SHOW_DISC_CACHE_STATS;
+extern const Info<bool> GFX_SHOW_SHADER_COMPILER_STATS;
+extern const Info<bool> GFX_SHOW_AUDIO_STATS;
 extern const Info<int> GFX_PERF_SAMP_WINDOW;
 extern const Info<bool> GFX_SHOW_NETPLAY_PING;
 extern const Info<bool> GFX_SHOW_NETPLAY_MESSAGES;
@@ -55,6 +60,7 @@ extern const Info<bool> GFX_DUMP_BASE_TEXTURES;
 extern const Info<int> GFX_TEXTURE_PNG_COMPRESSION_LEVEL;
 extern const Info<bool> GFX_HIRES_TEXTURES;
 extern const Info<bool> GFX_CACHE_HIRES_TEXTURES;
+extern const Info<int> GFX_HIRES_TEXTURE_MEMORY_BUDGET;
 extern const Info<bool> GFX_DUMP_EFB_TARGET;
 extern const Info<bool> GFX_DUMP_XFB_TARGET;
 extern const Info<bool> GFX_DUMP_FRAMES_AS_IMAGES;
@@ -82,6 +88,7 @@ extern const Info<bool> GFX_BORDERLESS_FULLSCREEN;
 extern const Info<bool> GFX_ENABLE_VALIDATION_LAYER;
 extern const Info<bool> GFX_BACKEND_MULTITHREADING;
 extern const Info<int> GFX_COMMAND_BUFFER_EXECUTE_INTERVAL;
+extern const Info<int> GFX_COMMAND_RECORDING_THREADS;
 extern const Info<bool> GFX_SHADER_CACHE;
 extern const Info<bool> GFX_WAIT_FOR_SHADERS_BEFORE_STARTING;
 extern const Info<ShaderCompilationMode> GFX_SHADER_COMPILATION_MODE;
@@ -151,8 +158,10 @@ static constexpr int GFX_STEREO_CONVERGENCE_MAXIMUM = 200;
 
 extern const Info<bool> GFX_HACK_EFB_ACCESS_ENABLE;
 extern const Info<bool> GFX_HACK_EFB_DEFER_INVALIDATION;
+extern const Info<bool> GFX_HACK_EFB_PREDICTIVE_READBACK;
 extern const Info<int> GFX_HACK_EFB_ACCESS_TILE_SIZE;
 extern const Info<bool> GFX_HACK_BBOX_ENABLE;
+extern const Info<bool> GFX_HACK_BBOX_CPU_ESTIMATE;
 extern const Info<bool> GFX_HACK_FORCE_PROGRESSIVE;
 extern const Info<bool> GFX_HACK_SKIP_EFB_COPY_TO_RAM;
 extern const Info<bool> GFX_HACK_SKIP_XFB_COPY_TO_RAM;
@@ -162,6 +171,7 @@ extern const Info<bool> GFX_HACK_IMMEDIATE_XFB;
 extern const Info<bool> GFX_HACK_SKIP_DUPLICATE_XFBS;
 extern const Info<bool> GFX_HACK_EARLY_XFB_OUTPUT;
 extern const Info<bool> GFX_HACK_COPY_EFB_SCALED;
+extern const Info<bool> GFX_HACK_EFB_COPY_SCALE_BY_USE;
 extern const Info<bool> GFX_HACK_EFB_EMULATE_FORMAT_CHANGES;
 extern const Info<bool> GFX_HACK_VERTEX_ROUNDING;
 extern const Info<bool> GFX_HACK_VI_SKIP;
@@ -174,6 +184,8 @@ extern const Info<bool> GFX_HACK_NO_MIPMAPPING;
 // Graphics.GameSpecific
 
 extern const Info<bool> GFX_PERF_QUERIES_ENABLE;
+// Don't wait for the GPU when the game reads the counters, the results may be a few draws behind
+extern const Info<bool> GFX_PERF_QUERIES_ASYNC;
 
 // Android custom GPU drivers
 
@@ -37,7 +37,14 @@ const Info<bool> MAIN_SKIP_IPL{{System::Main, "Core", "SkipIPL"}, true};
 const Info<PowerPC::CPUCore> MAIN_CPU_CORE{{System::Main, "Core", "CPUCore"},
                                            PowerPC::DefaultCPUCore()};
 const Info<bool> MAIN_JIT_FOLLOW_BRANCH{{System::Main, "Core", "JITFollowBranch"}, true};
+const Info<bool> MAIN_JIT_TIER_UP{{System::Main, "Core", "JITTierUp"}, false};
+const Info<bool> MAIN_JIT_HOT_BLOCK_CACHE{{System::Main, "Core", "JITHotBlockCache"}, false};
+const Info<bool> MAIN_JIT_DEFER_COMPILATION{{System::Main, "Core", "JITDeferCompilation"},
+                                             false};
+const Info<bool> MAIN_JIT_KEEP_LOOP_REGISTERS{{System::Main, "Core", "JITKeepLoopRegisters"},
+                                               false};
 const Info<bool> MAIN_FASTMEM{{System::Main, "Core", "Fastmem"}, true};
+const Info<bool> MAIN_HUGE_PAGES{{System::Main, "Core", "HugePages"}, false};
 const Info<bool> MAIN_ACCURATE_CPU_CACHE{{System::Main, "Core", "AccurateCPUCache"}, false};
 const Info<bool> MAIN_DSP_HLE{{System::Main, "Core", "DSPHLE"}, true};
 const Info<int> MAIN_MAX_FALLBACK{{System::Main, "Core", "MaxFallback"}, 100};
@@ -52,9 +59,12 @@ const Info<bool> MAIN_OVERRIDE_REGION_SETTINGS{{System::Main, "Core", "OverrideR
 const Info<bool> MAIN_DPL2_DECODER{{System::Main, "Core", "DPL2Decoder"}, false};
 const Info<AudioCommon::DPL2Quality> MAIN_DPL2_QUALITY{{System::Main, "Core", "DPL2Quality"},
                                                        AudioCommon::GetDefaultDPL2Quality()};
+const Info<AudioCommon::DPL2Mode> MAIN_DPL2_MODE{{System::Main, "Core", "DPL2Mode"},
+                                                 AudioCommon::DPL2Mode::FreeSurround};
 const Info<int> MAIN_AUDIO_LATENCY{{System::Main, "Core", "AudioLatency"}, 20};
 const Info<bool> MAIN_AUDIO_STRETCH{{System::Main, "Core", "AudioStretch"}, false};
 const Info<int> MAIN_AUDIO_STRETCH_LATENCY{{System::Main, "Core", "AudioStretchMaxLatency"}, 80};
+const Info<bool> MAIN_AUDIO_LOW_LATENCY{{System::Main, "Core", "AudioLowLatency"}, false};
 const Info<std::string> MAIN_MEMCARD_A_PATH{{System::Main, "Core", "MemcardAPath"}, ""};
 const Info<std::string> MAIN_MEMCARD_B_PATH{{System::Main, "Core", "MemcardBPath"}, ""};
 const Info<std::string>& GetInfoForMemcardPath(ExpansionInterface::Slot slot)
@@ -191,6 +201,13 @@ const Info<int> MAIN_SYNC_GPU_MAX_DISTANCE{{System::Main, "Core", "SyncGpuMaxDis
 const Info<int> MAIN_SYNC_GPU_MIN_DISTANCE{{System::Main, "Core", "SyncGpuMinDistance"}, -200000};
 const Info<float> MAIN_SYNC_GPU_OVERCLOCK{{System::Main, "Core", "SyncGpuOverclock"}, 1.0f};
 const Info<bool> MAIN_FAST_DISC_SPEED{{System::Main, "Core", "FastDiscSpeed"}, false};
+const Info<int> MAIN_DISC_READ_AHEAD_SIZE{{System::Main, "Core", "DiscReadAheadSize"}, 32};
+const Info<int> MAIN_WIA_RVZ_GROUP_CACHE_SIZE{{System::Main, "Core", "WIARVZGroupCacheSize"},
+                                              64};
+const Info<bool> MAIN_RECORD_DISC_ACCESS{{System::Main, "Core", "RecordDiscAccess"}, false};
+const Info<bool> MAIN_MAP_PLAIN_DISC_IMAGES{{System::Main, "Core", "MapPlainDiscImages"}, false};
+const Info<std::string> MAIN_SHARED_DISC_CACHE_PATH{{System::Main, "Core", "SharedDiscCachePath"},
+                                                    ""};
 const Info<bool> MAIN_LOW_DCBZ_HACK{{System::Main, "Core", "LowDCBZHack"}, false};
 const Info<bool> MAIN_FLOAT_EXCEPTIONS{{System::Main, "Core", "FloatExceptions"}, false};
 const Info<bool> MAIN_DIVIDE_BY_ZERO_EXCEPTIONS{{System::Main, "Core", "DivByZeroExceptions"},
@@ -229,6 +246,9 @@ GPUDeterminismMode GetGPUDeterminismMode()
 }
 
 const Info<std::string> MAIN_PERF_MAP_DIR{{System::Main, "Core", "PerfMapDir"}, ""};
+const Info<bool> MAIN_PERF_JITDUMP{{System::Main, "Core", "PerfJitDump"}, false};
+const Info<std::string> MAIN_METRICS_PATH{{System::Main, "Core", "MetricsPath"}, ""};
+const Info<u32> MAIN_METRICS_INTERVAL{{System::Main, "Core", "MetricsInterval"}, 10};
 const Info<bool> MAIN_CUSTOM_RTC_ENABLE{{System::Main, "Core", "EnableCustomRTC"}, false};
 // Measured in seconds since the unix epoch (1.1.1970).  Default is 1.1.2000; there are 7 leap years
 // between those dates.
@@ -239,6 +259,10 @@ const Info<DiscIO::Region> MAIN_FALLBACK_REGION{{System::Main, "Core", "Fallback
 const Info<bool> MAIN_AUTO_DISC_CHANGE{{System::Main, "Core", "AutoDiscChange"}, false};
 const Info<bool> MAIN_ALLOW_SD_WRITES{{System::Main, "Core", "WiiSDCardAllowWrites"}, true};
 const Info<bool> MAIN_ENABLE_SAVESTATES{{System::Main, "Core", "EnableSaveStates"}, false};
+const Info<bool> MAIN_REWIND_ENABLE{{System::Main, "Core", "RewindEnable"}, false};
+const Info<u32> MAIN_REWIND_INTERVAL{{System::Main, "Core", "RewindInterval"}, 500};
+const Info<u32> MAIN_REWIND_MEMORY_LIMIT{{System::Main, "Core", "RewindMemoryLimit"}, 1024};
+const Info<int> MAIN_SAVESTATE_ZSTD_LEVEL{{System::Main, "Core", "SavestateZstdLevel"}, 0};
 const Info<bool> MAIN_REAL_WII_REMOTE_REPEAT_REPORTS{
     {System::Main, "Core", "RealWiiRemoteRepeatReports"}, true};
 const Info<bool> MAIN_WII_WIILINK_ENABLE{{System::Main, "Core", "EnableWiiLink"}, false};
@@ -264,6 +288,9 @@ const Info<bool> MAIN_DISABLE_SCREENSAVER{{System::Main, "Display", "DisableScre
 // Main.DSP
 
 const Info<bool> MAIN_DSP_THREAD{{System::Main, "DSP", "DSPThread"}, false};
+// In DSP cycles. The default is about two DSP updates, which is how far the DSP thread could fall
+// behind before this was configurable.
+const Info<int> MAIN_DSP_THREAD_SKEW{{System::Main, "DSP", "DSPThreadSkew"}, 4200};
 const Info<bool> MAIN_DSP_CAPTURE_LOG{{System::Main, "DSP", "CaptureLog"}, false};
 const Info<bool> MAIN_DSP_JIT{{System::Main, "DSP", "EnableJIT"}, true};
 const Info<bool> MAIN_DUMP_AUDIO{{System::Main, "DSP", "DumpAudio"}, false};
@@ -360,8 +387,15 @@ const std::array<Info<std::string>, 4> MAIN_GBA_ROM_PATHS{
 const Info<std::string> MAIN_GBA_SAVES_PATH{{System::Main, "GBA", "SavesPath"}, ""};
 const Info<bool> MAIN_GBA_SAVES_IN_ROM_PATH{{System::Main, "GBA", "SavesInRomPath"}, false};
 const Info<bool> MAIN_GBA_THREADS{{System::Main, "GBA", "Threads"}, true};
+const Info<bool> MAIN_GBA_PIN_THREADS{{System::Main, "GBA", "PinThreads"}, false};
 #endif
 
+// Main.Subtitles
+
+const Info<std::string> MAIN_SUBTITLES_LANGUAGE{{System::Main, "Subtitles", "Language"}, ""};
+const Info<bool> MAIN_SUBTITLES_SYNC_TO_STREAM{{System::Main, "Subtitles", "SyncToStream"},
+                                               false};
+
 // Main.Network
 
 const Info<bool> MAIN_NETWORK_SSL_DUMP_READ{{System::Main, "Network", "SSLDumpRead"}, false};
@@ -474,6 +508,8 @@ const Info<bool> MAIN_MOVIE_DUMP_FRAMES_SILENT{{System::Main, "Movie", "DumpFram
 const Info<bool> MAIN_MOVIE_SHOW_INPUT_DISPLAY{{System::Main, "Movie", "ShowInputDisplay"}, false};
 const Info<bool> MAIN_MOVIE_SHOW_RTC{{System::Main, "Movie", "ShowRTC"}, false};
 const Info<bool> MAIN_MOVIE_SHOW_RERECORD{{System::Main, "Movie", "ShowRerecord"}, false};
+// Off by default, as other programs that read DTM files don't know about the hashes
+const Info<u32> MAIN_MOVIE_STATE_HASH_INTERVAL{{System::Main, "Movie", "StateHashInterval"}, 0};
 
 // Main.Input
 
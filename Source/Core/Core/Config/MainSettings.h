@@ -29,6 +29,7 @@ enum class CPUCore;
 
 namespace AudioCommon
 {
+enum class DPL2Mode;
 enum class DPL2Quality;
 }
 
@@ -55,7 +56,12 @@ namespace Config
 extern const Info<bool> MAIN_SKIP_IPL;
 extern const Info<PowerPC::CPUCore> MAIN_CPU_CORE;
 extern const Info<bool> MAIN_JIT_FOLLOW_BRANCH;
+extern const Info<bool> MAIN_JIT_TIER_UP;
+extern const Info<bool> MAIN_JIT_HOT_BLOCK_CACHE;
+extern const Info<bool> MAIN_JIT_DEFER_COMPILATION;
+extern const Info<bool> MAIN_JIT_KEEP_LOOP_REGISTERS;
 extern const Info<bool> MAIN_FASTMEM;
+extern const Info<bool> MAIN_HUGE_PAGES;
 extern const Info<bool> MAIN_ACCURATE_CPU_CACHE;
 // Should really be in the DSP section, but we're kind of stuck with bad decisions made in the past.
 extern const Info<bool> MAIN_DSP_HLE;
@@ -69,9 +75,13 @@ extern const Info<int> MAIN_GC_LANGUAGE;
 extern const Info<bool> MAIN_OVERRIDE_REGION_SETTINGS;
 extern const Info<bool> MAIN_DPL2_DECODER;
 extern const Info<AudioCommon::DPL2Quality> MAIN_DPL2_QUALITY;
+extern const Info<AudioCommon::DPL2Mode> MAIN_DPL2_MODE;
 extern const Info<int> MAIN_AUDIO_LATENCY;
 extern const Info<bool> MAIN_AUDIO_STRETCH;
 extern const Info<int> MAIN_AUDIO_STRETCH_LATENCY;
+// Sizes the mixer's buffers by how regularly the backend asks for samples instead of by
+// MAIN_TIMING_VARIANCE, and makes the Cubeb and PulseAudio backends use small buffers
+extern const Info<bool> MAIN_AUDIO_LOW_LATENCY;
 extern const Info<std::string> MAIN_MEMCARD_A_PATH;
 extern const Info<std::string> MAIN_MEMCARD_B_PATH;
 const Info<std::string>& GetInfoForMemcardPath(ExpansionInterface::Slot slot);
@@ -112,6 +122,16 @@ extern const Info<int> MAIN_SYNC_GPU_MAX_DISTANCE;
 extern const Info<int> MAIN_SYNC_GPU_MIN_DISTANCE;
 extern const Info<float> MAIN_SYNC_GPU_OVERCLOCK;
 extern const Info<bool> MAIN_FAST_DISC_SPEED;
+// In MiB, 0 disables reading ahead of sequential disc reads
+extern const Info<int> MAIN_DISC_READ_AHEAD_SIZE;
+// In MiB, how much decompressed data each WIA/RVZ reader keeps
+extern const Info<int> MAIN_WIA_RVZ_GROUP_CACHE_SIZE;
+extern const Info<bool> MAIN_RECORD_DISC_ACCESS;
+// Serve reads of uncompressed disc images from a memory mapping
+extern const Info<bool> MAIN_MAP_PLAIN_DISC_IMAGES;
+// Directory that instances on one host share decompressed copies of compressed disc images in.
+// Empty disables it.
+extern const Info<std::string> MAIN_SHARED_DISC_CACHE_PATH;
 extern const Info<bool> MAIN_LOW_DCBZ_HACK;
 extern const Info<bool> MAIN_FLOAT_EXCEPTIONS;
 extern const Info<bool> MAIN_DIVIDE_BY_ZERO_EXCEPTIONS;
@@ -141,11 +161,23 @@ extern const Info<std::string> MAIN_GPU_DETERMINISM_MODE;
 GPUDeterminismMode GetGPUDeterminismMode();
 
 extern const Info<std::string> MAIN_PERF_MAP_DIR;
+extern const Info<bool> MAIN_PERF_JITDUMP;
+// The file that the counters of Common/Counters.h are written to every MAIN_METRICS_INTERVAL
+// seconds. Ends in .json for JSON, otherwise it is in the Prometheus text format.
+extern const Info<std::string> MAIN_METRICS_PATH;
+extern const Info<u32> MAIN_METRICS_INTERVAL;
 extern const Info<bool> MAIN_CUSTOM_RTC_ENABLE;
 extern const Info<u32> MAIN_CUSTOM_RTC_VALUE;
 extern const Info<bool> MAIN_AUTO_DISC_CHANGE;
 extern const Info<bool> MAIN_ALLOW_SD_WRITES;
 extern const Info<bool> MAIN_ENABLE_SAVESTATES;
+extern const Info<bool> MAIN_REWIND_ENABLE;
+// In milliseconds of emulated time
+extern const Info<u32> MAIN_REWIND_INTERVAL;
+// In MiB
+extern const Info<u32> MAIN_REWIND_MEMORY_LIMIT;
+// 0 compresses savestates with LZ4, anything else with zstd at that level
+extern const Info<int> MAIN_SAVESTATE_ZSTD_LEVEL;
 extern const Info<DiscIO::Region> MAIN_FALLBACK_REGION;
 extern const Info<bool> MAIN_REAL_WII_REMOTE_REPEAT_REPORTS;
 extern const Info<s32> MAIN_OVERRIDE_BOOT_IOS;
@@ -155,6 +187,7 @@ extern const Info<bool> MAIN_WII_WIILINK_ENABLE;
 // Main.DSP
 
 extern const Info<bool> MAIN_DSP_THREAD;
+extern const Info<int> MAIN_DSP_THREAD_SKEW;
 extern const Info<bool> MAIN_DSP_CAPTURE_LOG;
 extern const Info<bool> MAIN_DSP_JIT;
 extern const Info<bool> MAIN_DUMP_AUDIO;
@@ -209,8 +242,18 @@ extern const std::array<Info<std::string>, 4> MAIN_GBA_ROM_PATHS;
 extern const Info<std::string> MAIN_GBA_SAVES_PATH;
 extern const Info<bool> MAIN_GBA_SAVES_IN_ROM_PATH;
 extern const Info<bool> MAIN_GBA_THREADS;
+extern const Info<bool> MAIN_GBA_PIN_THREADS;
 #endif
 
+// Main.Subtitles
+
+// Language of the shards to use for games whose subtitles have a manifest, empty for the
+// manifest's default
+extern const Info<std::string> MAIN_SUBTITLES_LANGUAGE;
+// Times the cues of streamed audio files by the position being played instead of the reads,
+// for DTK audio and for AX voices playing from data that was read from the disc
+extern const Info<bool> MAIN_SUBTITLES_SYNC_TO_STREAM;
+
 // Main.Network
 
 extern const Info<bool> MAIN_NETWORK_SSL_DUMP_READ;
@@ -311,6 +354,7 @@ extern const Info<bool> MAIN_MOVIE_DUMP_FRAMES_SILENT;
 extern const Info<bool> MAIN_MOVIE_SHOW_INPUT_DISPLAY;
 extern const Info<bool> MAIN_MOVIE_SHOW_RTC;
 extern const Info<bool> MAIN_MOVIE_SHOW_RERECORD;
+extern const Info<u32> MAIN_MOVIE_STATE_HASH_INTERVAL;
 
 // Main.Input
 
@@ -179,12 +179,12 @@ public:
     if (layer->GetLayer() == Config::LayerType::GlobalGame)
     {
       for (const std::string& filename : GetGameIniFilenames(m_id, m_revision))
-        ini.Load(File::GetSysDirectory() + GAMESETTINGS_DIR DIR_SEP + filename, true);
+        ini.LoadCached(File::GetSysDirectory() + GAMESETTINGS_DIR DIR_SEP + filename, true);
     }
     else
     {
       for (const std::string& filename : GetGameIniFilenames(m_id, m_revision))
-        ini.Load(File::GetUserPath(D_GAMESETTINGS_IDX) + filename, true);
+        ini.LoadCached(File::GetUserPath(D_GAMESETTINGS_IDX) + filename, true);
     }
 
     const auto& system_sections = ini.GetSections();
@@ -70,6 +70,8 @@ public:
     layer->Set(Config::GFX_SAFE_TEXTURE_CACHE_COLOR_SAMPLES,
                m_settings.safe_texture_cache_color_samples);
     layer->Set(Config::GFX_PERF_QUERIES_ENABLE, m_settings.perf_queries_enable);
+    // How far behind the results are depends on the speed of each host's GPU
+    layer->Set(Config::GFX_PERF_QUERIES_ASYNC, false);
     layer->Set(Config::MAIN_FLOAT_EXCEPTIONS, m_settings.float_exceptions);
     layer->Set(Config::MAIN_DIVIDE_BY_ZERO_EXCEPTIONS, m_settings.divide_by_zero_exceptions);
     layer->Set(Config::MAIN_FPRF, m_settings.fprf);
@@ -5,6 +5,7 @@
 
 #include <algorithm>
 #include <climits>
+#include <future>
 #include <memory>
 #include <optional>
 #include <sstream>
@@ -28,6 +29,7 @@
 #include "Common/MsgHandler.h"
 #include "Common/NandPaths.h"
 #include "Common/StringUtil.h"
+#include "Common/Timer.h"
 #include "Common/Version.h"
 
 #include "Core/Boot/Boot.h"
@@ -205,13 +207,23 @@ void SConfig::OnNewTitleLoad(const Core::CPUThreadGuard& guard)
     g_symbolDB.Clear();
     Host_NotifyMapLoaded();
   }
+
+  // Texture packs only read files of their own, so they are indexed on another thread while the
+  // steps that touch emulated state run here. Subtitles load in the background on their own and
+  // are not waited for.
+  Common::Timer timer;
+  timer.Start();
+  auto hires_textures = std::async(std::launch::async, &HiresTexture::Update);
+  Subtitles::Reload();
+
   CBoot::LoadMapFromFilename(guard);
   auto& system = Core::System::GetInstance();
   HLE::Reload(system);
   PatchEngine::Reload();
-  HiresTexture::Update();
   WC24PatchEngine::Reload();
-  Subtitles::Reload();
+
+  hires_textures.wait();
+  INFO_LOG_FMT(BOOT, "Title load steps took {} ms", timer.ElapsedMs());
 }
 
 void SConfig::LoadDefaults()
@@ -418,7 +430,7 @@ Common::IniFile SConfig::LoadDefaultGameIni(const std::string& id, std::optional
 {
   Common::IniFile game_ini;
   for (const std::string& filename : ConfigLoaders::GetGameIniFilenames(id, revision))
-    game_ini.Load(File::GetSysDirectory() + GAMESETTINGS_DIR DIR_SEP + filename, true);
+    game_ini.LoadCached(File::GetSysDirectory() + GAMESETTINGS_DIR DIR_SEP + filename, true);
   return game_ini;
 }
 
@@ -426,7 +438,7 @@ Common::IniFile SConfig::LoadLocalGameIni(const std::string& id, std::optional<u
 {
   Common::IniFile game_ini;
   for (const std::string& filename : ConfigLoaders::GetGameIniFilenames(id, revision))
-    game_ini.Load(File::GetUserPath(D_GAMESETTINGS_IDX) + filename, true);
+    game_ini.LoadCached(File::GetUserPath(D_GAMESETTINGS_IDX) + filename, true);
   return game_ini;
 }
 
@@ -434,9 +446,9 @@ Common::IniFile SConfig::LoadGameIni(const std::string& id, std::optional<u16> r
 {
   Common::IniFile game_ini;
   for (const std::string& filename : ConfigLoaders::GetGameIniFilenames(id, revision))
-    game_ini.Load(File::GetSysDirectory() + GAMESETTINGS_DIR DIR_SEP + filename, true);
+    game_ini.LoadCached(File::GetSysDirectory() + GAMESETTINGS_DIR DIR_SEP + filename, true);
   for (const std::string& filename : ConfigLoaders::GetGameIniFilenames(id, revision))
-    game_ini.Load(File::GetUserPath(D_GAMESETTINGS_IDX) + filename, true);
+    game_ini.LoadCached(File::GetUserPath(D_GAMESETTINGS_IDX) + filename, true);
   return game_ini;
 }
 
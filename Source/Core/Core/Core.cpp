@@ -71,6 +71,7 @@
 #include "Core/PowerPC/JitInterface.h"
 #include "Core/PowerPC/PowerPC.h"
 #include "Core/State.h"
+#include "Core/StateRewind.h"
 #include "Core/System.h"
 #include "Core/WiiRoot.h"
 
@@ -116,6 +117,10 @@ static std::atomic<double> s_last_actual_emulation_speed{1.0};
 static bool s_frame_step = false;
 static std::atomic<bool> s_stop_frame_step;
 
+// Measures how long each stage of the boot and the time to the first frame take
+static Common::Timer s_boot_timer;
+static std::atomic<bool> s_first_frame_pending{false};
+
 #ifdef USE_MEMORYWATCHER
 static std::unique_ptr<MemoryWatcher> s_memory_watcher;
 #endif
@@ -255,6 +260,9 @@ bool Init(std::unique_ptr<BootParameters> boot, const WindowSystemInfo& wsi)
   // Drain any left over jobs
   HostDispatchJobs();
 
+  s_boot_timer.Start();
+  s_first_frame_pending = true;
+
   INFO_LOG_FMT(BOOT, "Starting core = {} mode", SConfig::GetInstance().bWii ? "Wii" : "GameCube");
   INFO_LOG_FMT(BOOT, "CPU Thread separate = {}",
                Core::System::GetInstance().IsDualCoreMode() ? "Yes" : "No");
@@ -489,6 +497,12 @@ static void FifoPlayerThread(const std::optional<std::string>& savestate_path,
 // Initialize and create emulation thread
 // Call browser: Init():s_emu_thread().
 // See the BootManager.cpp file description for a complete call schedule.
+static void LogBootStage(std::string_view stage)
+{
+  INFO_LOG_FMT(BOOT, "Boot stage done: {} ({} ms since boot started)", stage,
+               s_boot_timer.ElapsedMs());
+}
+
 static void EmuThread(std::unique_ptr<BootParameters> boot, WindowSystemInfo wsi)
 {
   Core::System& system = Core::System::GetInstance();
@@ -571,6 +585,7 @@ static void EmuThread(std::unique_ptr<BootParameters> boot, WindowSystemInfo wsi
 
   HW::Init(system,
            NetPlay::IsNetPlayRunning() ? &(boot_session_data.GetNetplaySettings()->sram) : nullptr);
+  LogBootStage("hardware");
 
   Common::ScopeGuard hw_guard{[&system] {
     // We must set up this flag before executing HW::Shutdown()
@@ -597,6 +612,7 @@ static void EmuThread(std::unique_ptr<BootParameters> boot, WindowSystemInfo wsi
     PanicAlertFmt("Failed to initialize video backend!");
     return;
   }
+  LogBootStage("video backend");
   Common::ScopeGuard video_guard{[] {
     // Clear on screen messages that haven't expired
     OSD::ClearMessages();
@@ -615,6 +631,7 @@ static void EmuThread(std::unique_ptr<BootParameters> boot, WindowSystemInfo wsi
     PanicAlertFmt("Failed to initialize DSP emulation!");
     return;
   }
+  LogBootStage("DSP");
 
   AudioCommon::PostInitSoundStream(system);
 
@@ -645,6 +662,7 @@ static void EmuThread(std::unique_ptr<BootParameters> boot, WindowSystemInfo wsi
     if (!CBoot::BootUp(system, guard, std::move(boot)))
       return;
   }
+  LogBootStage("executable loaded");
 
   // Initialise Wii filesystem contents.
   // This is done here after Boot and not in BootManager to ensure that we operate
@@ -911,6 +929,12 @@ void Callback_FramePresented(double actual_emulation_speed)
 {
   g_perf_metrics.CountFrame();
 
+  if (s_first_frame_pending.load(std::memory_order_relaxed) && s_first_frame_pending.exchange(false))
+  {
+    NOTICE_LOG_FMT(BOOT, "First frame presented {} ms after boot started",
+                   s_boot_timer.ElapsedMs());
+  }
+
   s_last_actual_emulation_speed = actual_emulation_speed;
   s_stop_frame_step.store(true);
 }
@@ -938,6 +962,8 @@ void Callback_NewField(Core::System& system)
 #ifdef USE_RETRO_ACHIEVEMENTS
   AchievementManager::GetInstance()->DoFrame();
 #endif  // USE_RETRO_ACHIEVEMENTS
+
+  ::State::Rewind::OnNewField();
 }
 
 void UpdateTitle()
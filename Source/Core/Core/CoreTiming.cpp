@@ -4,7 +4,6 @@
 #include "Core/CoreTiming.h"
 
 #include <algorithm>
-#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -14,7 +13,8 @@
 #include "Common/Assert.h"
 #include "Common/ChunkFile.h"
 #include "Common/Logging/Log.h"
-#include "Common/SPSCQueue.h"
+#include "Common/MPSCQueue.h"
+#include "Common/TraceEvents.h"
 
 #include "Core/CPUThreadConfigCallback.h"
 #include "Core/Config/MainSettings.h"
@@ -23,6 +23,7 @@
 #include "Core/System.h"
 
 #include "VideoCommon/Fifo.h"
+#include "VideoCommon/FramePacer.h"
 #include "VideoCommon/PerformanceMetrics.h"
 #include "VideoCommon/VideoBackendBase.h"
 #include "VideoCommon/VideoConfig.h"
@@ -115,7 +116,6 @@ void CoreTimingManager::Init()
 
 void CoreTimingManager::Shutdown()
 {
-  std::lock_guard lk(m_ts_write_lock);
   MoveEvents();
   ClearPendingEvents();
   UnregisterAllEvents();
@@ -140,7 +140,6 @@ void CoreTimingManager::RefreshConfig()
 
 void CoreTimingManager::DoState(PointerWrap& p)
 {
-  std::lock_guard lk(m_ts_write_lock);
   p.Do(m_globals.slice_length);
   p.Do(m_globals.global_timer);
   p.Do(m_idled_cycles);
@@ -263,7 +262,6 @@ void CoreTimingManager::ScheduleEvent(s64 cycles_into_future, EventType* event_t
                     *event_type->name);
     }
 
-    std::lock_guard lk(m_ts_write_lock);
     m_ts_queue.Push(Event{m_globals.global_timer + cycles_into_future, 0, userdata, event_type});
   }
 }
@@ -302,12 +300,11 @@ void CoreTimingManager::ForceExceptionCheck(s64 cycles)
 
 void CoreTimingManager::MoveEvents()
 {
-  for (Event ev; m_ts_queue.Pop(ev);)
-  {
+  m_ts_queue.PopAll([this](Event&& ev) {
     ev.fifo_order = m_event_fifo_id++;
     m_event_queue.emplace_back(std::move(ev));
     std::push_heap(m_event_queue.begin(), m_event_queue.end(), std::greater<Event>());
-  }
+  });
 }
 
 void CoreTimingManager::Advance()
@@ -334,6 +331,8 @@ void CoreTimingManager::Advance()
     m_event_queue.pop_back();
 
     Throttle(evt.time);
+
+    Common::Trace::ScopedZone zone(evt.type->name->c_str());
     evt.type->callback(m_system, evt.userdata, m_globals.global_timer - evt.time);
   }
 
@@ -393,10 +392,19 @@ void CoreTimingManager::Throttle(const s64 target_cycle)
   // It doesn't matter what amount of lag we skip VI at, as long as it's constant.
   m_throttle_disable_vi_int = 0.0 < speed && m_throttle_deadline < vi_deadline;
 
+  // The frame pacer runs the CPU later than the deadline, so that frames are done just before the
+  // display refreshes. This changes when the CPU runs, but not how fast, so the deadline itself
+  // isn't moved.
+  const TimePoint sleep_deadline =
+      0.0 < speed ? m_throttle_deadline + g_frame_pacer.GetDelay() : m_throttle_deadline;
+
   // Only sleep if we are behind the deadline
-  if (time < m_throttle_deadline)
+  if (time < sleep_deadline)
   {
-    std::this_thread::sleep_until(m_throttle_deadline);
+    {
+      TRACE_SCOPE("Throttle");
+      std::this_thread::sleep_until(sleep_deadline);
+    }
 
     // Count amount of time sleeping for analytics
     const TimePoint time_after_sleep = Clock::now();
@@ -16,13 +16,12 @@
 // inside callback:
 //   ScheduleEvent(periodInCycles - cyclesLate, callback, "whatever")
 
-#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
 #include "Common/CommonTypes.h"
-#include "Common/SPSCQueue.h"
+#include "Common/MPSCQueue.h"
 #include "Core/CPUThreadConfigCallback.h"
 
 class PointerWrap;
@@ -169,8 +168,8 @@ private:
   // by the standard adaptor class.
   std::vector<Event> m_event_queue;
   u64 m_event_fifo_id = 0;
-  std::mutex m_ts_write_lock;
-  Common::SPSCQueue<Event, false> m_ts_queue;
+  // Events scheduled from other threads, moved into m_event_queue by the CPU thread
+  Common::MPSCQueue<Event> m_ts_queue;
 
   float m_last_oc_factor = 0.0f;
 
@@ -60,6 +60,60 @@ constexpr u16 idle_skip_sigs[NUM_IDLE_SIGS][MAX_IDLE_SIG_SIZE + 1] = {
      0, 0},
 };
 
+// Longest loop, in instruction words, that FindIdleLoops considers.
+constexpr u16 MAX_IDLE_LOOP_SIZE = 8;
+
+namespace
+{
+// Whether reading from a hardware register has side effects. Reading the low half of a mailbox
+// clears it, and reading accelerator data advances the accelerator.
+bool HasReadSideEffects(u16 address)
+{
+  switch (address)
+  {
+  case 0xFFD3:  // ACDAT2
+  case 0xFFDD:  // ACDAT
+  case 0xFFFD:  // DMBL
+  case 0xFFFF:  // CMBL
+    return true;
+  default:
+    return false;
+  }
+}
+
+// Whether executing an instruction of a loop again gives the same result as long as memory
+// doesn't change. That is, the instruction only reads memory and either sets the flags or
+// overwrites a register.
+bool IsIdempotent(const SDSP& dsp, u16 addr, UDSPInstruction inst)
+{
+  // LR $D, @M: the stack registers can't be loaded, as that pushes them
+  if ((inst & 0xffe0) == 0x00c0)
+  {
+    const u16 reg = inst & 0x1f;
+    return (reg < DSP_REG_ST0 || reg > DSP_REG_ST3) &&
+           !HasReadSideEffects(dsp.ReadIMEM(static_cast<u16>(addr + 1)));
+  }
+
+  // LRS $(D+24), @M, which reads from ($cr << 8) | M. $cr is almost always 0xFF.
+  if ((inst & 0xf800) == 0x2000)
+    return !HasReadSideEffects(0xFF00 | (inst & 0xff));
+
+  // NOP, and ANDF, ANDCF, CMPI and CMPIS which only set the flags
+  if ((inst & 0xfffc) == 0x0000 || (inst & 0xfeff) == 0x02a0 || (inst & 0xfeff) == 0x02c0 ||
+      (inst & 0xfeff) == 0x0280 || (inst & 0xfe00) == 0x0600)
+  {
+    return true;
+  }
+
+  // CMP, TSTPROD, TSTAXH, TST and CMPAXH only set the flags too, but must not have an extended
+  // opcode other than NOP
+  if ((inst & 0xfc) != 0)
+    return false;
+  return (inst & 0xff00) == 0x8200 || (inst & 0xff00) == 0x8500 || (inst & 0xfe00) == 0x8600 ||
+         (inst & 0xf700) == 0xb100 || (inst & 0xe700) == 0xc100;
+}
+}  // namespace
+
 Analyzer::Analyzer() = default;
 Analyzer::~Analyzer() = default;
 
@@ -83,6 +137,7 @@ void Analyzer::AnalyzeRange(const SDSP& dsp, u16 start_addr, u16 end_addr)
 
   // Next, we'll scan for potential idle skips.
   FindIdleSkips(dsp, start_addr, end_addr);
+  FindIdleLoops(dsp, start_addr, end_addr);
 
   INFO_LOG_FMT(DSPLLE, "Finished analysis.");
 }
@@ -170,4 +225,52 @@ void Analyzer::FindIdleSkips(const SDSP& dsp, u16 start_addr, u16 end_addr)
     }
   }
 }
+
+void Analyzer::FindIdleLoops(const SDSP& dsp, u16 start_addr, u16 end_addr)
+{
+  // Wait loops that aren't covered by the signatures: short loops that only read memory and test
+  // what they read, until an interrupt or another processor changes it. Exits out of the loop are
+  // allowed, the loop is marked at its start.
+  for (u16 addr = start_addr; addr < end_addr; addr++)
+  {
+    const UDSPInstruction inst = dsp.ReadIMEM(addr);
+
+    // Jcc, with the destination before the jump
+    if (!IsStartOfInstruction(addr) || (inst & 0xfff0) != 0x0290)
+      continue;
+
+    const u16 loop_start = dsp.ReadIMEM(static_cast<u16>(addr + 1));
+    if (loop_start > addr || addr - loop_start > MAX_IDLE_LOOP_SIZE ||
+        !IsStartOfInstruction(loop_start))
+    {
+      continue;
+    }
+
+    bool idle = true;
+    for (u16 loop_addr = loop_start; loop_addr < addr && idle;)
+    {
+      const UDSPInstruction loop_inst = dsp.ReadIMEM(loop_addr);
+      const DSPOPCTemplate* opcode = GetOpTemplate(loop_inst);
+      if (!opcode || IsLoopStart(loop_addr) || IsLoopEnd(loop_addr))
+        idle = false;
+      // Conditional jumps out of the loop
+      else if ((loop_inst & 0xfff0) == 0x0290 && loop_inst != 0x029f)
+      {
+        const u16 dest = dsp.ReadIMEM(static_cast<u16>(loop_addr + 1));
+        idle = dest < loop_start || dest > addr;
+      }
+      else
+        idle = IsIdempotent(dsp, loop_addr, loop_inst);
+
+      if (opcode)
+        loop_addr += opcode->size;
+    }
+
+    if (idle && !IsIdleSkip(loop_start))
+    {
+      INFO_LOG_FMT(DSPLLE, "Idle loop found at {:04x}", loop_start);
+      m_code_flags[loop_start] |= CODE_IDLE_SKIP;
+    }
+  }
+}
 }  // namespace DSP
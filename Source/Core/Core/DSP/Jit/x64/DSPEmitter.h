@@ -213,6 +213,7 @@ private:
 
   void WriteBranchExit();
   void WriteBlockLink(u16 dest);
+  void WriteBlockLinkJump(Block dest, u16 dest_size);
 
   void ReJitConditional(UDSPInstruction opc, void (DSPEmitter::*conditional_fn)(UDSPInstruction));
   void r_jcc(UDSPInstruction opc);
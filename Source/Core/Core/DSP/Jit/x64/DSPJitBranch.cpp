@@ -116,22 +116,23 @@ void DSPEmitter::WriteBranchExit()
 
 void DSPEmitter::WriteBlockLink(u16 dest)
 {
+  if (dest == m_start_address)
+  {
+    // Loop back into the block being compiled, unless it's an idle loop: those return to the
+    // dispatcher to give up the rest of the time slice.
+    if (m_dsp_core.DSPState().GetAnalyzer().IsIdleSkip(m_start_address))
+      return;
+
+    WriteBlockLinkJump(m_block_link_entry, m_block_size[m_start_address]);
+    return;
+  }
+
   // Jump directly to the called block if it has already been compiled.
   if (!(dest >= m_start_address && dest <= m_compile_pc))
   {
     if (m_block_links[dest] != nullptr)
     {
-      m_gpr.FlushRegs();
-      // Check if we have enough cycles to execute the next block
-      MOV(64, R(RAX), ImmPtr(&m_cycles_left));
-      MOV(16, R(ECX), MatR(RAX));
-      CMP(16, R(ECX), Imm16(m_block_size[m_start_address] + m_block_size[dest]));
-      FixupBranch notEnoughCycles = J_CC(CC_BE);
-
-      SUB(16, R(ECX), Imm16(m_block_size[m_start_address]));
-      MOV(16, MatR(RAX), R(ECX));
-      JMP(m_block_links[dest], Jump::Near);
-      SetJumpTarget(notEnoughCycles);
+      WriteBlockLinkJump(m_block_links[dest], m_block_size[dest]);
     }
     else
     {
@@ -142,14 +143,27 @@ void DSPEmitter::WriteBlockLink(u16 dest)
   }
 }
 
+void DSPEmitter::WriteBlockLinkJump(Block dest, u16 dest_size)
+{
+  m_gpr.FlushRegs();
+  // Check if we have enough cycles to execute the next block
+  MOV(64, R(RAX), ImmPtr(&m_cycles_left));
+  MOV(16, R(ECX), MatR(RAX));
+  CMP(16, R(ECX), Imm16(m_block_size[m_start_address] + dest_size));
+  FixupBranch notEnoughCycles = J_CC(CC_BE);
+
+  SUB(16, R(ECX), Imm16(m_block_size[m_start_address]));
+  MOV(16, MatR(RAX), R(ECX));
+  JMP(dest, Jump::Near);
+  SetJumpTarget(notEnoughCycles);
+}
+
 void DSPEmitter::r_jcc(const UDSPInstruction opc)
 {
   const u16 dest = m_dsp_core.DSPState().ReadIMEM(m_compile_pc + 1);
-  const DSPOPCTemplate* opcode = GetOpTemplate(opc);
 
-  // If the block is unconditional, attempt to link block
-  if (opcode->uncond_branch)
-    WriteBlockLink(dest);
+  // Only reached if the condition is met, so conditional jumps can be linked as well
+  WriteBlockLink(dest);
   MOV(16, M_SDSP_pc(), Imm16(dest));
   WriteBranchExit();
 }
@@ -192,11 +206,9 @@ void DSPEmitter::r_call(const UDSPInstruction opc)
   MOV(16, R(DX), Imm16(m_compile_pc + 2));
   dsp_reg_store_stack(StackRegister::Call);
   const u16 dest = m_dsp_core.DSPState().ReadIMEM(m_compile_pc + 1);
-  const DSPOPCTemplate* opcode = GetOpTemplate(opc);
 
-  // If the block is unconditional, attempt to link block
-  if (opcode->uncond_branch)
-    WriteBlockLink(dest);
+  // Only reached if the condition is met, so conditional calls can be linked as well
+  WriteBlockLink(dest);
   MOV(16, M_SDSP_pc(), Imm16(dest));
   WriteBranchExit();
 }
@@ -27,6 +27,9 @@ public:
   virtual u16 DSP_ReadControlRegister() = 0;
   virtual u16 DSP_WriteControlRegister(u16 value) = 0;
   virtual void DSP_Update(int cycles) = 0;
+  // Waits until the DSP has run all the cycles it was given, for when the CPU accesses state the
+  // DSP may still be using
+  virtual void DSP_Sync() = 0;
   virtual void DSP_StopSoundStream() = 0;
   virtual u32 DSP_UpdateRate() = 0;
 
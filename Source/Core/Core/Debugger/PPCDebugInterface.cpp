@@ -6,6 +6,7 @@
 #include <algorithm>
 #include <array>
 #include <cstddef>
+#include <optional>
 #include <regex>
 #include <string>
 #include <vector>
@@ -13,6 +14,7 @@
 #include <fmt/format.h>
 
 #include "Common/Align.h"
+#include "Common/Counters.h"
 #include "Common/GekkoDisassembler.h"
 #include "Common/StringUtil.h"
 
@@ -26,6 +28,10 @@
 #include "Core/PowerPC/PowerPC.h"
 #include "Core/System.h"
 
+static Common::Counter s_skipped_memory_patch_writes(
+    "dolphin_memory_patch_writes_skipped_total",
+    "Memory patch bytes that were not rewritten because memory already held the patched value");
+
 void ApplyMemoryPatch(const Core::CPUThreadGuard& guard, Common::Debug::MemoryPatch& patch,
                       bool store_existing_value)
 {
@@ -37,28 +43,35 @@ void ApplyMemoryPatch(const Core::CPUThreadGuard& guard, Common::Debug::MemoryPa
   if (!PowerPC::MMU::HostIsRAMAddress(guard, address))
     return;
 
+  // Patches that are applied every frame usually find their bytes unchanged. Only the cache lines
+  // that were actually written to are invalidated, each of them once.
+  constexpr u32 CACHE_LINE_SIZE = 32;
   auto& power_pc = guard.GetSystem().GetPowerPC();
+  std::optional<u32> dirty_line;
+  u64 skipped_writes = 0;
   for (u32 offset = 0; offset < size; ++offset)
   {
-    if (store_existing_value)
+    const u32 current_address = address + offset;
+    const u8 value = PowerPC::MMU::HostRead_U8(guard, current_address);
+    if (value == patch.value[offset])
     {
-      const u8 value = PowerPC::MMU::HostRead_U8(guard, address + offset);
-      PowerPC::MMU::HostWrite_U8(guard, patch.value[offset], address + offset);
-      patch.value[offset] = value;
+      ++skipped_writes;
+      continue;
     }
-    else
+
+    PowerPC::MMU::HostWrite_U8(guard, patch.value[offset], current_address);
+    if (store_existing_value)
+      patch.value[offset] = value;
+
+    const u32 line = Common::AlignDown(current_address, CACHE_LINE_SIZE);
+    if (dirty_line != line)
     {
-      PowerPC::MMU::HostWrite_U8(guard, patch.value[offset], address + offset);
+      power_pc.ScheduleInvalidateCacheThreadSafe(line);
+      dirty_line = line;
     }
-
-    if (((address + offset) % 4) == 3)
-      power_pc.ScheduleInvalidateCacheThreadSafe(Common::AlignDown(address + offset, 4));
-  }
-  if (((address + size) % 4) != 0)
-  {
-    power_pc.ScheduleInvalidateCacheThreadSafe(
-        Common::AlignDown(address + static_cast<u32>(size), 4));
   }
+  if (skipped_writes != 0)
+    s_skipped_memory_patch_writes.Add(skipped_writes);
 }
 
 void PPCPatches::ApplyExistingPatch(const Core::CPUThreadGuard& guard, std::size_t index)
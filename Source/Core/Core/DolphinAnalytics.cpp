@@ -131,7 +131,8 @@ void DolphinAnalytics::ReportGameStart()
   Send(builder);
 
   // Reset per-game state.
-  m_reported_quirks.fill(false);
+  for (std::atomic<bool>& reported : m_reported_quirks)
+    reported.store(false);
   InitializePerformanceSampling();
 }
 
@@ -174,9 +175,8 @@ void DolphinAnalytics::ReportGameQuirk(GameQuirk quirk)
   u32 quirk_idx = static_cast<u32>(quirk);
 
   // Only report once per run.
-  if (m_reported_quirks[quirk_idx])
+  if (m_reported_quirks[quirk_idx].exchange(true))
     return;
-  m_reported_quirks[quirk_idx] = true;
 
   Common::AnalyticsReportBuilder builder(m_per_game_builder);
   builder.AddData("type", "quirk");
@@ -9,6 +9,9 @@
 #include <string>
 #include <vector>
 
+#include <zstd.h>
+
+#include "Common/Assert.h"
 #include "Common/IOFile.h"
 #include "Common/MsgHandler.h"
 #include "Core/Config/MainSettings.h"
@@ -16,11 +19,15 @@
 #include "Core/System.h"
 
 constexpr u32 FILE_ID = 0x0d01f1f0;
-constexpr u32 VERSION_NUMBER = 5;
+constexpr u32 VERSION_NUMBER = 6;
 constexpr u32 MIN_LOADER_VERSION = 1;
 // This value is only used if the DFF file was created with overridden RAM sizes.
 // If the MIN_LOADER_VERSION ever exceeds this, it's alright to remove it.
 constexpr u32 MIN_LOADER_VERSION_FOR_RAM_OVERRIDE = 5;
+constexpr u32 MIN_LOADER_VERSION_FOR_COMPRESSED_FRAMES = 6;
+
+// Frames are compressed while the game is running, so this favors speed over size
+constexpr int COMPRESSION_LEVEL = 3;
 
 #pragma pack(push, 1)
 
@@ -58,7 +65,11 @@ struct FileFrameInfo
   u32 fifoEnd;
   u64 memoryUpdatesOffset;
   u32 numMemoryUpdates;
-  u8 reserved[32];
+  // Only used by files with FLAG_COMPRESSED_FRAMES, where fifoDataOffset points to the compressed
+  // frame and memoryUpdatesOffset is unused
+  u32 compressedSize;
+  u32 uncompressedSize;
+  u8 reserved[24];
 };
 static_assert(sizeof(FileFrameInfo) == 64, "FileFrameInfo should be 64 bytes");
 
@@ -77,7 +88,10 @@ static_assert(sizeof(FileMemoryUpdate) == 24, "FileMemoryUpdate should be 24 byt
 
 FifoDataFile::FifoDataFile() = default;
 
-FifoDataFile::~FifoDataFile() = default;
+FifoDataFile::~FifoDataFile()
+{
+  StopStreaming();
+}
 
 bool FifoDataFile::ShouldGenerateFakeVIUpdates() const
 {
@@ -101,7 +115,209 @@ bool FifoDataFile::GetIsWii() const
 
 void FifoDataFile::AddFrame(const FifoFrameInfo& frameInfo)
 {
-  m_Frames.push_back(frameInfo);
+  if (m_streaming)
+    m_stream_thread.Push(frameInfo);
+  else
+    m_Frames.push_back(frameInfo);
+
+  m_frame_count++;
+}
+
+std::shared_ptr<const FifoFrameInfo> FifoDataFile::GetFrame(u32 frame) const
+{
+  if (!GetFlag(FLAG_COMPRESSED_FRAMES))
+    return std::shared_ptr<const FifoFrameInfo>(std::shared_ptr<void>(), &m_Frames[frame]);
+
+  ASSERT_MSG(CORE, !m_streaming, "Frames can't be read while they are being streamed");
+
+  std::lock_guard lk(m_compressed_frames_mutex);
+  if (!m_last_frame || m_last_frame_number != frame)
+  {
+    m_last_frame = std::make_shared<const FifoFrameInfo>(ReadCompressedFrame(frame));
+    m_last_frame_number = frame;
+  }
+  return m_last_frame;
+}
+
+u64 FifoDataFile::GetFifoDataSize() const
+{
+  std::lock_guard lk(m_compressed_frames_mutex);
+
+  u64 size = 0;
+  for (const FifoFrameInfo& frame : m_Frames)
+    size += frame.fifoData.size();
+  for (const CompressedFrame& frame : m_compressed_frames)
+    size += frame.fifo_data_size;
+  return size;
+}
+
+u64 FifoDataFile::GetMemoryUpdatesSize() const
+{
+  std::lock_guard lk(m_compressed_frames_mutex);
+
+  u64 size = 0;
+  for (const FifoFrameInfo& frame : m_Frames)
+  {
+    for (const MemoryUpdate& update : frame.memoryUpdates)
+      size += update.data.size();
+  }
+  for (const CompressedFrame& frame : m_compressed_frames)
+  {
+    size += frame.uncompressed_size - frame.fifo_data_size -
+            frame.num_memory_updates * sizeof(FileMemoryUpdate);
+  }
+  return size;
+}
+
+bool FifoDataFile::StartStreaming(const std::string& filename)
+{
+  auto file = std::make_unique<File::IOFile>(filename, "w+b");
+  if (!file->IsOpen())
+    return false;
+
+  // Add space for header
+  PadFile(sizeof(FileHeader), *file);
+
+  m_file = std::move(file);
+  m_Frames.clear();
+  m_compressed_frames.clear();
+  m_frame_count = 0;
+  m_last_frame.reset();
+  SetFlag(FLAG_COMPRESSED_FRAMES, true);
+
+  m_streaming = true;
+  m_stream_failed = false;
+  m_stream_thread.Reset("FIFO Log Writer",
+                        [this](FifoFrameInfo frame) { WriteCompressedFrame(frame); });
+  return true;
+}
+
+bool FifoDataFile::StopStreaming()
+{
+  if (!m_streaming)
+    return true;
+
+  // Waits for the frames that are still queued to be written
+  m_stream_thread.Shutdown();
+  m_streaming = false;
+
+  File::IOFile& file = *m_file;
+  file.Seek(0, File::SeekOrigin::End);
+  const u64 frameListOffset = file.Tell();
+  for (const CompressedFrame& srcFrame : m_compressed_frames)
+  {
+    FileFrameInfo dstFrame{};
+    dstFrame.fifoDataOffset = srcFrame.offset;
+    dstFrame.fifoDataSize = srcFrame.fifo_data_size;
+    dstFrame.fifoStart = srcFrame.fifo_start;
+    dstFrame.fifoEnd = srcFrame.fifo_end;
+    dstFrame.numMemoryUpdates = srcFrame.num_memory_updates;
+    dstFrame.compressedSize = srcFrame.compressed_size;
+    dstFrame.uncompressedSize = srcFrame.uncompressed_size;
+    file.WriteBytes(&dstFrame, sizeof(FileFrameInfo));
+  }
+
+  // Frames that failed to be compressed are missing from the list
+  m_frame_count = static_cast<u32>(m_compressed_frames.size());
+  WriteMemoryAndHeader(frameListOffset, m_Flags, file);
+
+  return file.Flush() && !m_stream_failed;
+}
+
+void FifoDataFile::WriteCompressedFrame(const FifoFrameInfo& frame)
+{
+  // The memory update list follows the FIFO data, with data offsets relative to the frame start
+  std::vector<u8> data = frame.fifoData;
+  const size_t updateListOffset = data.size();
+  data.resize(updateListOffset + frame.memoryUpdates.size() * sizeof(FileMemoryUpdate));
+
+  for (size_t i = 0; i < frame.memoryUpdates.size(); ++i)
+  {
+    const MemoryUpdate& srcUpdate = frame.memoryUpdates[i];
+
+    FileMemoryUpdate dstUpdate{};
+    dstUpdate.address = srcUpdate.address;
+    dstUpdate.dataOffset = data.size();
+    dstUpdate.dataSize = static_cast<u32>(srcUpdate.data.size());
+    dstUpdate.fifoPosition = srcUpdate.fifoPosition;
+    dstUpdate.type = static_cast<u8>(srcUpdate.type);
+    std::memcpy(&data[updateListOffset + i * sizeof(FileMemoryUpdate)], &dstUpdate,
+                sizeof(FileMemoryUpdate));
+
+    data.insert(data.end(), srcUpdate.data.begin(), srcUpdate.data.end());
+  }
+
+  std::vector<u8> compressed(ZSTD_compressBound(data.size()));
+  const size_t compressed_size = ZSTD_compress(compressed.data(), compressed.size(), data.data(),
+                                               data.size(), COMPRESSION_LEVEL);
+  if (ZSTD_isError(compressed_size))
+  {
+    m_stream_failed = true;
+    return;
+  }
+
+  CompressedFrame dstFrame;
+  dstFrame.offset = m_file->Tell();
+  dstFrame.compressed_size = static_cast<u32>(compressed_size);
+  dstFrame.uncompressed_size = static_cast<u32>(data.size());
+  dstFrame.fifo_data_size = static_cast<u32>(frame.fifoData.size());
+  dstFrame.fifo_start = frame.fifoStart;
+  dstFrame.fifo_end = frame.fifoEnd;
+  dstFrame.num_memory_updates = static_cast<u32>(frame.memoryUpdates.size());
+
+  if (!m_file->WriteBytes(compressed.data(), compressed_size))
+    m_stream_failed = true;
+
+  std::lock_guard lk(m_compressed_frames_mutex);
+  m_compressed_frames.push_back(dstFrame);
+}
+
+FifoFrameInfo FifoDataFile::ReadCompressedFrame(u32 frame) const
+{
+  const CompressedFrame& srcFrame = m_compressed_frames[frame];
+
+  FifoFrameInfo dstFrame;
+  dstFrame.fifoStart = srcFrame.fifo_start;
+  dstFrame.fifoEnd = srcFrame.fifo_end;
+
+  std::vector<u8> compressed(srcFrame.compressed_size);
+  std::vector<u8> data(srcFrame.uncompressed_size);
+  const u64 updateListEnd =
+      u64(srcFrame.fifo_data_size) + u64(srcFrame.num_memory_updates) * sizeof(FileMemoryUpdate);
+  if (!m_file->Seek(srcFrame.offset, File::SeekOrigin::Begin) ||
+      !m_file->ReadBytes(compressed.data(), compressed.size()) ||
+      ZSTD_decompress(data.data(), data.size(), compressed.data(), compressed.size()) !=
+          data.size() ||
+      updateListEnd > data.size())
+  {
+    PanicAlertFmtT("Failed to read frame {0} of the DFF file.", frame);
+    return dstFrame;
+  }
+
+  dstFrame.fifoData.assign(data.begin(), data.begin() + srcFrame.fifo_data_size);
+  dstFrame.memoryUpdates.resize(srcFrame.num_memory_updates);
+  for (u32 i = 0; i < srcFrame.num_memory_updates; ++i)
+  {
+    FileMemoryUpdate srcUpdate;
+    std::memcpy(&srcUpdate, &data[srcFrame.fifo_data_size + i * sizeof(FileMemoryUpdate)],
+                sizeof(FileMemoryUpdate));
+    if (srcUpdate.dataOffset > data.size() ||
+        srcUpdate.dataSize > data.size() - srcUpdate.dataOffset)
+    {
+      PanicAlertFmtT("Failed to read frame {0} of the DFF file.", frame);
+      dstFrame.memoryUpdates.clear();
+      return dstFrame;
+    }
+
+    MemoryUpdate& dstUpdate = dstFrame.memoryUpdates[i];
+    dstUpdate.address = srcUpdate.address;
+    dstUpdate.fifoPosition = srcUpdate.fifoPosition;
+    dstUpdate.type = static_cast<MemoryUpdate::Type>(srcUpdate.type);
+    dstUpdate.data.assign(data.begin() + srcUpdate.dataOffset,
+                          data.begin() + srcUpdate.dataOffset + srcUpdate.dataSize);
+  }
+
+  return dstFrame;
 }
 
 bool FifoDataFile::Save(const std::string& filename)
@@ -115,8 +331,45 @@ bool FifoDataFile::Save(const std::string& filename)
 
   // Add space for frame list
   u64 frameListOffset = file.Tell();
-  PadFile(m_Frames.size() * sizeof(FileFrameInfo), file);
+  PadFile(m_frame_count * sizeof(FileFrameInfo), file);
+
+  // Frames are always saved uncompressed
+  WriteMemoryAndHeader(frameListOffset, m_Flags & ~FLAG_COMPRESSED_FRAMES, file);
+
+  // Write frames list
+  for (u32 i = 0; i < m_frame_count; ++i)
+  {
+    const std::shared_ptr<const FifoFrameInfo> srcFrame = GetFrame(i);
+
+    // Write FIFO data
+    file.Seek(0, File::SeekOrigin::End);
+    u64 dataOffset = file.Tell();
+    file.WriteBytes(srcFrame->fifoData.data(), srcFrame->fifoData.size());
+
+    u64 memoryUpdatesOffset = WriteMemoryUpdates(srcFrame->memoryUpdates, file);
+
+    FileFrameInfo dstFrame;
+    dstFrame.fifoDataSize = static_cast<u32>(srcFrame->fifoData.size());
+    dstFrame.fifoDataOffset = dataOffset;
+    dstFrame.fifoStart = srcFrame->fifoStart;
+    dstFrame.fifoEnd = srcFrame->fifoEnd;
+    dstFrame.memoryUpdatesOffset = memoryUpdatesOffset;
+    dstFrame.numMemoryUpdates = static_cast<u32>(srcFrame->memoryUpdates.size());
+
+    // Write frame info
+    u64 frameOffset = frameListOffset + (i * sizeof(FileFrameInfo));
+    file.Seek(frameOffset, File::SeekOrigin::Begin);
+    file.WriteBytes(&dstFrame, sizeof(FileFrameInfo));
+  }
+
+  if (!file.Close())
+    return false;
+
+  return true;
+}
 
+void FifoDataFile::WriteMemoryAndHeader(u64 frameListOffset, u32 flags, File::IOFile& file)
+{
   u64 bpMemOffset = file.Tell();
   file.WriteArray(m_BPMem);
 
@@ -136,8 +389,11 @@ bool FifoDataFile::Save(const std::string& filename)
   FileHeader header;
   header.fileId = FILE_ID;
   header.file_version = VERSION_NUMBER;
-  // Maintain backwards compatability so long as the RAM sizes aren't overridden.
-  if (Config::Get(Config::MAIN_RAM_OVERRIDE_ENABLE))
+  // Maintain backwards compatability so long as the RAM sizes aren't overridden and the frames
+  // aren't compressed.
+  if (flags & FLAG_COMPRESSED_FRAMES)
+    header.min_loader_version = MIN_LOADER_VERSION_FOR_COMPRESSED_FRAMES;
+  else if (Config::Get(Config::MAIN_RAM_OVERRIDE_ENABLE))
     header.min_loader_version = MIN_LOADER_VERSION_FOR_RAM_OVERRIDE;
   else
     header.min_loader_version = MIN_LOADER_VERSION;
@@ -158,9 +414,9 @@ bool FifoDataFile::Save(const std::string& filename)
   header.texMemSize = TEX_MEM_SIZE;
 
   header.frameListOffset = frameListOffset;
-  header.frameCount = (u32)m_Frames.size();
+  header.frameCount = m_frame_count;
 
-  header.flags = m_Flags;
+  header.flags = flags;
 
   auto& system = Core::System::GetInstance();
   auto& memory = system.GetMemory();
@@ -169,37 +425,6 @@ bool FifoDataFile::Save(const std::string& filename)
 
   file.Seek(0, File::SeekOrigin::Begin);
   file.WriteBytes(&header, sizeof(FileHeader));
-
-  // Write frames list
-  for (unsigned int i = 0; i < m_Frames.size(); ++i)
-  {
-    const FifoFrameInfo& srcFrame = m_Frames[i];
-
-    // Write FIFO data
-    file.Seek(0, File::SeekOrigin::End);
-    u64 dataOffset = file.Tell();
-    file.WriteBytes(srcFrame.fifoData.data(), srcFrame.fifoData.size());
-
-    u64 memoryUpdatesOffset = WriteMemoryUpdates(srcFrame.memoryUpdates, file);
-
-    FileFrameInfo dstFrame;
-    dstFrame.fifoDataSize = static_cast<u32>(srcFrame.fifoData.size());
-    dstFrame.fifoDataOffset = dataOffset;
-    dstFrame.fifoStart = srcFrame.fifoStart;
-    dstFrame.fifoEnd = srcFrame.fifoEnd;
-    dstFrame.memoryUpdatesOffset = memoryUpdatesOffset;
-    dstFrame.numMemoryUpdates = static_cast<u32>(srcFrame.memoryUpdates.size());
-
-    // Write frame info
-    u64 frameOffset = frameListOffset + (i * sizeof(FileFrameInfo));
-    file.Seek(frameOffset, File::SeekOrigin::Begin);
-    file.WriteBytes(&dstFrame, sizeof(FileFrameInfo));
-  }
-
-  if (!file.Close())
-    return false;
-
-  return true;
 }
 
 std::unique_ptr<FifoDataFile> FifoDataFile::Load(const std::string& filename, bool flagsOnly)
@@ -316,6 +541,31 @@ std::unique_ptr<FifoDataFile> FifoDataFile::Load(const std::string& filename, bo
   dataFile->m_ram_size_real = header.mem1_size;
   dataFile->m_exram_size_real = header.mem2_size;
 
+  if (dataFile->GetFlag(FLAG_COMPRESSED_FRAMES))
+  {
+    // Compressed frames are only read when they are needed
+    file.Seek(header.frameListOffset, File::SeekOrigin::Begin);
+    dataFile->m_compressed_frames.resize(header.frameCount);
+    for (CompressedFrame& dstFrame : dataFile->m_compressed_frames)
+    {
+      FileFrameInfo srcFrame;
+      if (!file.ReadBytes(&srcFrame, sizeof(FileFrameInfo)))
+        return panic_failed_to_read();
+
+      dstFrame.offset = srcFrame.fifoDataOffset;
+      dstFrame.compressed_size = srcFrame.compressedSize;
+      dstFrame.uncompressed_size = srcFrame.uncompressedSize;
+      dstFrame.fifo_data_size = srcFrame.fifoDataSize;
+      dstFrame.fifo_start = srcFrame.fifoStart;
+      dstFrame.fifo_end = srcFrame.fifoEnd;
+      dstFrame.num_memory_updates = srcFrame.numMemoryUpdates;
+    }
+
+    dataFile->m_frame_count = header.frameCount;
+    dataFile->m_file = std::make_unique<File::IOFile>(std::move(file));
+    return dataFile;
+  }
+
   // Read frames
   for (u32 i = 0; i < header.frameCount; ++i)
   {
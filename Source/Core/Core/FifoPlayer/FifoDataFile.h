@@ -5,10 +5,12 @@
 
 #include <array>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/WorkQueueThread.h"
 #include "VideoCommon/XFMemory.h"
 
 namespace File
@@ -72,9 +74,21 @@ public:
   u32 GetRamSizeReal() { return m_ram_size_real; }
   u32 GetExRamSizeReal() { return m_exram_size_real; }
 
+  // Makes the frames added from now on get compressed and written to the given file on a worker
+  // thread instead of being kept in memory. StopStreaming finishes the file with the current
+  // memory state, after which the frames are read back from the file like those of a loaded
+  // compressed file.
+  bool StartStreaming(const std::string& filename);
+  bool StopStreaming();
+  bool IsStreaming() const { return m_streaming; }
+
   void AddFrame(const FifoFrameInfo& frameInfo);
-  const FifoFrameInfo& GetFrame(u32 frame) const { return m_Frames[frame]; }
-  u32 GetFrameCount() const { return static_cast<u32>(m_Frames.size()); }
+  // The frames of compressed files are decompressed when they are requested, only the frame that
+  // was requested last is kept in memory
+  std::shared_ptr<const FifoFrameInfo> GetFrame(u32 frame) const;
+  u32 GetFrameCount() const { return m_frame_count; }
+  u64 GetFifoDataSize() const;
+  u64 GetMemoryUpdatesSize() const;
   bool Save(const std::string& filename);
 
   static std::unique_ptr<FifoDataFile> Load(const std::string& filename, bool flagsOnly);
@@ -82,7 +96,21 @@ public:
 private:
   enum
   {
-    FLAG_IS_WII = 1
+    FLAG_IS_WII = 1,
+    FLAG_COMPRESSED_FRAMES = 2,
+  };
+
+  // A frame of a compressed file, stored as a single zstd frame holding the FIFO data followed by
+  // the memory updates
+  struct CompressedFrame
+  {
+    u64 offset;
+    u32 compressed_size;
+    u32 uncompressed_size;
+    u32 fifo_data_size;
+    u32 fifo_start;
+    u32 fifo_end;
+    u32 num_memory_updates;
   };
 
   void PadFile(size_t numBytes, File::IOFile& file);
@@ -90,6 +118,10 @@ private:
   void SetFlag(u32 flag, bool set);
   bool GetFlag(u32 flag) const;
 
+  void WriteMemoryAndHeader(u64 frameListOffset, u32 flags, File::IOFile& file);
+  void WriteCompressedFrame(const FifoFrameInfo& frame);
+  FifoFrameInfo ReadCompressedFrame(u32 frame) const;
+
   u64 WriteMemoryUpdates(const std::vector<MemoryUpdate>& memUpdates, File::IOFile& file);
   static void ReadMemoryUpdates(u64 fileOffset, u32 numUpdates,
                                 std::vector<MemoryUpdate>& memUpdates, File::IOFile& file);
@@ -105,5 +137,17 @@ private:
   u32 m_Flags = 0;
   u32 m_Version = 0;
 
+  u32 m_frame_count = 0;
   std::vector<FifoFrameInfo> m_Frames;
+
+  // The file compressed frames are read from or streamed to
+  std::unique_ptr<File::IOFile> m_file;
+  std::vector<CompressedFrame> m_compressed_frames;
+  mutable std::mutex m_compressed_frames_mutex;
+  mutable std::shared_ptr<const FifoFrameInfo> m_last_frame;
+  mutable u32 m_last_frame_number = 0;
+
+  bool m_streaming = false;
+  bool m_stream_failed = false;
+  Common::WorkQueueThread<FifoFrameInfo> m_stream_thread;
 };
@@ -82,7 +82,8 @@ void FifoPlaybackAnalyzer::AnalyzeFrames(FifoDataFile* file,
 
   for (u32 frame_no = 0; frame_no < file->GetFrameCount(); frame_no++)
   {
-    const FifoFrameInfo& frame = file->GetFrame(frame_no);
+    const std::shared_ptr<const FifoFrameInfo> frame_ptr = file->GetFrame(frame_no);
+    const FifoFrameInfo& frame = *frame_ptr;
     AnalyzedFrameInfo& analyzed = frame_info[frame_no];
 
     u32 offset = 0;
@@ -299,7 +300,7 @@ CPU::State FifoPlayer::AdvanceFrame()
   if (m_EarlyMemoryUpdates && m_CurrentFrame == m_FrameRangeStart)
     WriteAllMemoryUpdates();
 
-  WriteFrame(m_File->GetFrame(m_CurrentFrame), m_FrameInfo[m_CurrentFrame]);
+  WriteFrame(*m_File->GetFrame(m_CurrentFrame), m_FrameInfo[m_CurrentFrame]);
 
   ++m_CurrentFrame;
   return CPU::State::Running;
@@ -490,8 +491,8 @@ void FifoPlayer::WriteAllMemoryUpdates()
 
   for (u32 frameNum = 0; frameNum < m_File->GetFrameCount(); ++frameNum)
   {
-    const FifoFrameInfo& frame = m_File->GetFrame(frameNum);
-    for (auto& update : frame.memoryUpdates)
+    const std::shared_ptr<const FifoFrameInfo> frame = m_File->GetFrame(frameNum);
+    for (auto& update : frame->memoryUpdates)
     {
       WriteMemory(update);
     }
@@ -557,7 +558,8 @@ void FifoPlayer::SetupFifo()
   WriteCP(CommandProcessor::CTRL_REGISTER, 0);   // disable read, BP, interrupts
   WriteCP(CommandProcessor::CLEAR_REGISTER, 7);  // clear overflow, underflow, metrics
 
-  const FifoFrameInfo& frame = m_File->GetFrame(m_CurrentFrame);
+  const std::shared_ptr<const FifoFrameInfo> frame_ptr = m_File->GetFrame(m_CurrentFrame);
+  const FifoFrameInfo& frame = *frame_ptr;
 
   // Set fifo bounds
   WriteCP(CommandProcessor::FIFO_BASE_LO, frame.fifoStart);
@@ -217,11 +217,17 @@ static FifoRecorder instance;
 
 FifoRecorder::FifoRecorder() = default;
 
-void FifoRecorder::StartRecording(s32 numFrames, CallbackFunc finishedCb)
+bool FifoRecorder::StartRecording(s32 numFrames, CallbackFunc finishedCb,
+                                  const std::string& stream_path)
 {
   std::lock_guard lk(m_mutex);
 
   m_File = std::make_unique<FifoDataFile>();
+  if (!stream_path.empty() && !m_File->StartStreaming(stream_path))
+  {
+    m_File.reset();
+    return false;
+  }
 
   // TODO: This, ideally, would be deallocated when done recording.
   //       However, care needs to be taken since global state
@@ -273,6 +279,8 @@ void FifoRecorder::StartRecording(s32 numFrames, CallbackFunc finishedCb)
                  fifo.CPEnd.load(std::memory_order_relaxed));
       },
       "FifoRecorder::EndFrame");
+
+  return true;
 }
 
 void FifoRecorder::RecordInitialVideoMemory()
@@ -298,7 +306,7 @@ void FifoRecorder::StopRecording()
 
 bool FifoRecorder::IsRecordingDone() const
 {
-  return m_WasRecording && m_File != nullptr;
+  return m_WasRecording && m_File != nullptr && !m_File->IsStreaming();
 }
 
 FifoDataFile* FifoRecorder::GetRecordedFile() const
@@ -338,6 +346,9 @@ void FifoRecorder::WriteGPCommand(const u8* data, u32 size)
       // The file will be responsible for freeing the memory allocated for each frame's fifoData
       m_File->AddFrame(m_CurrentFrame);
 
+      if (m_RequestedRecordingEnd && m_File->IsStreaming() && !m_File->StopStreaming())
+        PanicAlertFmtT("Failed to write FIFO log.");
+
       if (m_FinishedCb && m_RequestedRecordingEnd)
         m_FinishedCb();
     }
@@ -6,6 +6,7 @@
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <string>
 #include <vector>
 
 #include "Common/Assert.h"
@@ -19,7 +20,9 @@ public:
 
   FifoRecorder();
 
-  void StartRecording(s32 numFrames, CallbackFunc finishedCb);
+  // If stream_path is not empty, frames are written to that file while they are recorded rather
+  // than being kept in memory
+  bool StartRecording(s32 numFrames, CallbackFunc finishedCb, const std::string& stream_path = {});
   void StopRecording();
 
   bool IsRecordingDone() const;
@@ -4,6 +4,7 @@
 #include "Core/HW/AddressSpace.h"
 
 #include <algorithm>
+#include <cstring>
 
 #include "Common/BitUtils.h"
 #include "Core/ConfigManager.h"
@@ -59,6 +60,16 @@ float Accessors::ReadF32(const Core::CPUThreadGuard& guard, u32 address) const
   return Common::BitCast<float>(ReadU32(guard, address));
 }
 
+void Accessors::ReadBytes(const Core::CPUThreadGuard& guard, u32 address, u8* dest, u8* valid,
+                          u32 size) const
+{
+  for (u32 i = 0; i < size; ++i)
+  {
+    valid[i] = IsValidAddress(guard, address + i);
+    dest[i] = valid[i] ? ReadU8(guard, address + i) : 0;
+  }
+}
+
 Accessors::iterator Accessors::begin() const
 {
   return nullptr;
@@ -122,6 +133,25 @@ struct EffectiveAddressSpaceAccessors : Accessors
   {
     return PowerPC::MMU::HostRead_F32(guard, address);
   };
+  void ReadBytes(const Core::CPUThreadGuard& guard, u32 address, u8* dest, u8* valid,
+                 u32 size) const override
+  {
+    // A page is translated once rather than for every byte in it
+    while (size != 0)
+    {
+      const u32 count =
+          std::min<u32>(size, PowerPC::HW_PAGE_SIZE - (address & PowerPC::HW_PAGE_MASK));
+      const bool is_ram = PowerPC::MMU::HostTryCopyFromPage(guard, address, dest, count);
+      if (!is_ram)
+        std::fill_n(dest, count, u8(0));
+      std::fill_n(valid, count, u8(is_ram));
+
+      address += count;
+      dest += count;
+      valid += count;
+      size -= count;
+    }
+  }
 
   bool Matches(const Core::CPUThreadGuard& guard, u32 haystack_start, const u8* needle_start,
                std::size_t needle_size) const
@@ -366,6 +396,18 @@ struct SmallBlockAccessors : Accessors
     (*alloc_base)[address] = value;
   }
 
+  void ReadBytes(const Core::CPUThreadGuard& guard, u32 address, u8* dest, u8* valid,
+                 u32 length) const override
+  {
+    if (IsValidAddress(guard, address) && u64{address} + length <= size)
+    {
+      std::memcpy(dest, *alloc_base + address, length);
+      std::fill_n(valid, length, u8(1));
+      return;
+    }
+    Accessors::ReadBytes(guard, address, dest, valid, length);
+  }
+
   iterator begin() const override { return *alloc_base; }
 
   iterator end() const override
@@ -40,6 +40,10 @@ struct Accessors
   virtual u64 ReadU64(const Core::CPUThreadGuard& guard, u32 address) const;
   virtual void WriteU64(const Core::CPUThreadGuard& guard, u32 address, u64 value);
   virtual float ReadF32(const Core::CPUThreadGuard& guard, u32 address) const;
+  // Copies size bytes starting at address to dest, and sets the same entries of valid to whether
+  // IsValidAddress is true for them. Invalid bytes are set to 0.
+  virtual void ReadBytes(const Core::CPUThreadGuard& guard, u32 address, u8* dest, u8* valid,
+                         u32 size) const;
 
   virtual iterator begin() const;
   virtual iterator end() const;
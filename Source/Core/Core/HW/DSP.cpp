@@ -34,6 +34,7 @@
 #include "Core/ConfigManager.h"
 #include "Core/CoreTiming.h"
 #include "Core/DSPEmulator.h"
+#include "Core/HW/DVD/DVDThread.h"
 #include "Core/HW/HSP/HSP.h"
 #include "Core/HW/MMIO.h"
 #include "Core/HW/Memmap.h"
@@ -80,7 +81,7 @@ constexpr int DSP_MAIL_SLICE = 72;
 void DSPManager::DoState(PointerWrap& p)
 {
   if (!m_aram.wii_mode)
-    p.DoArray(m_aram.ptr, m_aram.size);
+    m_aram_delta.DoState(p, m_aram.ptr, m_aram.size);
   p.Do(m_dsp_control);
   p.Do(m_audio_dma);
   p.Do(m_aram_dma);
@@ -157,6 +158,7 @@ void DSPManager::Shutdown()
     Common::FreeMemoryPages(m_aram.ptr, m_aram.size);
     m_aram.ptr = nullptr;
   }
+  m_aram_delta.Clear();
 
   m_dsp_emulator->Shutdown();
   m_dsp_emulator.reset();
@@ -459,6 +461,9 @@ void DSPManager::Do_ARAM_DMA()
   auto& core_timing = m_system.GetCoreTiming();
   auto& memory = m_system.GetMemory();
 
+  // A DSP running on its own thread may still be reading the ARAM that gets overwritten
+  m_dsp_emulator->DSP_Sync();
+
   m_dsp_control.DMAState = 1;
 
   // ARAM DMA transfer rate has been measured on real hw
@@ -528,6 +533,10 @@ void DSPManager::Do_ARAM_DMA()
 
     if (m_aram_dma.ARAddr < m_aram.size)
     {
+      auto& dvd_thread = m_system.GetDVDThread();
+      if (dvd_thread.IsTrackingStreams())
+        dvd_thread.OnCopyToARAM(m_aram_dma.MMAddr, m_aram_dma.ARAddr, m_aram_dma.Cnt.count);
+
       while (m_aram_dma.Cnt.count)
       {
         if ((m_aram_info.Hex & 0xf) == 3)
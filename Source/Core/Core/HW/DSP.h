@@ -6,6 +6,7 @@
 #include <memory>
 
 #include "Common/CommonTypes.h"
+#include "Core/StateDelta.h"
 
 class PointerWrap;
 class DSPEmulator;
@@ -169,6 +170,8 @@ private:
   };
 
   ARAMInfo m_aram;
+  // Base of ARAM for incremental savestates
+  State::DeltaArray m_aram_delta;
   AudioDMA m_audio_dma;
   ARAM_DMA m_aram_dma;
   UDSPControl m_dsp_control;
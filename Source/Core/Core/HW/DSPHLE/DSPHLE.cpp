@@ -36,6 +36,10 @@ bool DSPHLE::Initialize(bool wii, bool dsp_thread)
   return true;
 }
 
+void DSPHLE::DSP_Sync()
+{
+}
+
 void DSPHLE::DSP_StopSoundStream()
 {
 }
@@ -35,6 +35,7 @@ public:
   u16 DSP_ReadControlRegister() override;
   u16 DSP_WriteControlRegister(u16 value) override;
   void DSP_Update(int cycles) override;
+  void DSP_Sync() override;
   void DSP_StopSoundStream() override;
   u32 DSP_UpdateRate() override;
 
@@ -404,16 +404,13 @@ void AXUCode::ProcessPBList(u32 pb_addr)
   // 32KHz to 48KHz, but AX always process at 32KHz.
   constexpr u32 spms = 32;
 
-  AXPB pb;
-
-  while (pb_addr)
-  {
-    AXBuffers buffers = {{m_samples_main_left, m_samples_main_right, m_samples_main_surround,
-                          m_samples_auxA_left, m_samples_auxA_right, m_samples_auxA_surround,
-                          m_samples_auxB_left, m_samples_auxB_right, m_samples_auxB_surround}};
-
-    ReadPB(pb_addr, pb, m_crc);
+  const AXBuffers buffers = {{m_samples_main_left, m_samples_main_right, m_samples_main_surround,
+                              m_samples_auxA_left, m_samples_auxA_right, m_samples_auxA_surround,
+                              m_samples_auxB_left, m_samples_auxB_right, m_samples_auxB_surround}};
+  AXBufferSizes sizes;
+  sizes.fill(spms * 5);
 
+  const auto process = [this](AXPB& pb, AXBuffers voice_buffers) {
     u32 updates_addr = HILO_TO_32(pb.updates.data);
     u16* updates = (u16*)HLEMemory_Get_Pointer(updates_addr);
 
@@ -421,17 +418,25 @@ void AXUCode::ProcessPBList(u32 pb_addr)
     {
       ApplyUpdatesForMs(curr_ms, pb, pb.updates.num_updates, updates);
 
-      ProcessVoice(pb, buffers, spms, ConvertMixerControl(pb.mixer_control),
+      ProcessVoice(pb, voice_buffers, spms, ConvertMixerControl(pb.mixer_control),
                    m_coeffs_checksum ? m_coeffs.data() : nullptr);
 
       // Forward the buffers
-      for (auto& ptr : buffers.ptrs)
+      for (auto& ptr : voice_buffers.ptrs)
         ptr += spms;
     }
+  };
 
-    WritePB(pb_addr, pb, m_crc);
-    pb_addr = HILO_TO_32(pb.next_pb);
-  }
+  // The updates can change where the next PB is
+  const auto get_next_pb = [this](const AXPB& pb) {
+    AXPB updated_pb = pb;
+    u16* updates = (u16*)HLEMemory_Get_Pointer(HILO_TO_32(pb.updates.data));
+    for (int curr_ms = 0; curr_ms < 5; ++curr_ms)
+      ApplyUpdatesForMs(curr_ms, updated_pb, updated_pb.updates.num_updates, updates);
+    return HILO_TO_32(updated_pb.next_pb);
+  };
+
+  ProcessPBs(pb_addr, m_crc, buffers, sizes, m_voice_workers, process, get_next_pb);
 }
 
 void AXUCode::MixAUXSamples(int aux_id, u32 write_addr, u32 read_addr)
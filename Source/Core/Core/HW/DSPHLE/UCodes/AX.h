@@ -17,6 +17,7 @@
 #include "Common/BitUtils.h"
 #include "Common/CommonTypes.h"
 #include "Common/Swap.h"
+#include "Common/WorkerPool.h"
 #include "Core/HW/DSPHLE/UCodes/UCodes.h"
 #include "Core/HW/Memmap.h"
 #include "Core/System.h"
@@ -100,6 +101,10 @@ protected:
 
   u16 m_compressor_pos = 0;
 
+  // The threads that the voices of large PB lists are processed on
+  static constexpr size_t MAX_VOICE_WORKERS = 3;
+  Common::WorkerPool m_voice_workers{"AX voice worker", MAX_VOICE_WORKERS};
+
   bool LoadResamplingCoefficients(bool require_same_checksum, u32 desired_checksum);
 
   // Copy a command list from memory to our temp buffer
@@ -12,13 +12,24 @@
 #endif
 
 #include <algorithm>
+#include <array>
 #include <functional>
 #include <memory>
+#include <type_traits>
+#include <vector>
+
+#ifdef _M_ARM_64
+#include <arm_neon.h>
+#endif
 
 #include "Common/CommonTypes.h"
+#include "Common/Intrinsics.h"
+#include "Common/MathUtil.h"
+#include "Common/WorkerPool.h"
 #include "Core/DSP/DSPAccelerator.h"
 #include "Core/DolphinAnalytics.h"
 #include "Core/HW/DSP.h"
+#include "Core/HW/DVD/DVDThread.h"
 #include "Core/HW/DSPHLE/UCodes/AX.h"
 #include "Core/HW/DSPHLE/UCodes/AXStructs.h"
 #include "Core/HW/Memmap.h"
@@ -87,6 +98,11 @@ union AXBuffers
 #endif
 };
 
+constexpr size_t AX_BUFFER_COUNT = std::extent_v<decltype(AXBuffers::ptrs)>;
+
+// How many samples of each buffer the voices of a PB list are mixed into
+using AXBufferSizes = std::array<u32, AX_BUFFER_COUNT>;
+
 // Determines if this version of the UCode has a PBLowPassFilter in its AXPB layout.
 bool HasLpf(u32 crc)
 {
@@ -152,8 +168,8 @@ void WritePB(u32 addr, const PB_TYPE& pb, u32 crc)
   }
 }
 
-// Simulated accelerator state.
-static PB_TYPE* acc_pb;
+// Simulated accelerator state. Every thread that processes voices has its own.
+thread_local PB_TYPE* acc_pb;
 
 class HLEAccelerator final : public Accelerator
 {
@@ -197,7 +213,7 @@ protected:
   }
 };
 
-static std::unique_ptr<Accelerator> s_accelerator = std::make_unique<HLEAccelerator>();
+thread_local std::unique_ptr<Accelerator> s_accelerator = std::make_unique<HLEAccelerator>();
 
 // Sets up the simulated accelerator.
 void AcceleratorSetup(PB_TYPE* pb)
@@ -352,6 +368,179 @@ u32 ResampleAudio(std::function<s16(u32)> input_callback, s16* output, u32 count
   return curr_pos;
 }
 
+// Block resampling reads up to this many input samples at once. Faster voices are resampled by
+// ResampleAudio instead.
+constexpr u32 MAX_BLOCK_INPUT_SAMPLES = MAX_SAMPLES_PER_FRAME * 4;
+
+// Returns how many input samples ResampleAudio reads to output <count> samples.
+u64 GetResampleInputCount(u32 count, u32 curr_pos, u32 ratio, int srctype)
+{
+  if (srctype == SRCTYPE_LINEAR || srctype == SRCTYPE_POLYPHASE)
+    return (curr_pos + u64(ratio) * count) >> 16;
+  return count;
+}
+
+s16 PolyphaseSample(const s16* window, const s16* c)
+{
+  const s64 samp = (s64(window[0]) * c[0] + s64(window[1]) * c[1] + s64(window[2]) * c[2] +
+                    s64(window[3]) * c[3]) >> 15;
+  return MathUtil::SaturatingCast<s16>(samp);
+}
+
+// Interpolates every output sample from the four input samples starting at positions[i], using
+// the coefficients for fracs[i].
+void PolyphaseInterpolate(s16* output, const s16* input, const u32* positions, const u16* fracs,
+                          u32 count, const s16* coeffs)
+{
+  const auto get_row = [&](u32 i) { return &coeffs[(fracs[i] >> 9) << 2]; };
+  u32 i = 0;
+
+#if defined(_M_X86_64)
+  const __m128i min_coeff = _mm_set1_epi16(-32768);
+  for (; i + 4 <= count; i += 4)
+  {
+    const auto load_pair = [](const s16* first, const s16* second) {
+      return _mm_unpacklo_epi64(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(first)),
+                                _mm_loadl_epi64(reinterpret_cast<const __m128i*>(second)));
+    };
+    const __m128i c01 = load_pair(get_row(i), get_row(i + 1));
+    const __m128i c23 = load_pair(get_row(i + 2), get_row(i + 3));
+
+    // pmaddwd only wraps around when all four factors of a pair are -32768
+    const __m128i has_min_coeff =
+        _mm_or_si128(_mm_cmpeq_epi16(c01, min_coeff), _mm_cmpeq_epi16(c23, min_coeff));
+    if (_mm_movemask_epi8(has_min_coeff) != 0)
+    {
+      for (u32 j = i; j < i + 4; ++j)
+        output[j] = PolyphaseSample(&input[positions[j]], get_row(j));
+      continue;
+    }
+
+    const __m128i x01 = load_pair(&input[positions[i]], &input[positions[i + 1]]);
+    const __m128i x23 = load_pair(&input[positions[i + 2]], &input[positions[i + 3]]);
+    const __m128 pairs01 = _mm_castsi128_ps(_mm_madd_epi16(x01, c01));
+    const __m128 pairs23 = _mm_castsi128_ps(_mm_madd_epi16(x23, c23));
+    const __m128i a = _mm_castps_si128(_mm_shuffle_ps(pairs01, pairs23, _MM_SHUFFLE(2, 0, 2, 0)));
+    const __m128i b = _mm_castps_si128(_mm_shuffle_ps(pairs01, pairs23, _MM_SHUFFLE(3, 1, 3, 1)));
+    const __m128i sum = _mm_add_epi32(a, b);
+
+    // The sum takes 33 bits when both pairs are large and have the same sign, in which case the
+    // sample saturates towards that sign
+    const __m128i overflow =
+        _mm_srai_epi32(_mm_andnot_si128(_mm_xor_si128(a, b), _mm_xor_si128(a, sum)), 31);
+    const __m128i saturated = _mm_xor_si128(_mm_srai_epi32(a, 31), _mm_set1_epi32(0x7FFF));
+    const __m128i samples = _mm_or_si128(_mm_and_si128(overflow, saturated),
+                                         _mm_andnot_si128(overflow, _mm_srai_epi32(sum, 15)));
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(&output[i]), _mm_packs_epi32(samples, samples));
+  }
+#elif defined(_M_ARM_64)
+  for (; i < count; ++i)
+  {
+    const int32x4_t products = vmull_s16(vld1_s16(&input[positions[i]]), vld1_s16(get_row(i)));
+    const s64 samp = vaddvq_s64(vpaddlq_s32(products)) >> 15;
+    output[i] = MathUtil::SaturatingCast<s16>(samp);
+  }
+#endif
+
+  for (; i < count; ++i)
+    output[i] = PolyphaseSample(&input[positions[i]], get_row(i));
+}
+
+// Interpolates every output sample between the input samples at positions[i] and positions[i] + 1.
+void LinearInterpolate(s16* output, const s16* input, const u32* positions, const u16* fracs,
+                       u32 count)
+{
+  u32 i = 0;
+
+#if defined(_M_X86_64)
+  // The sample is the upper half of (s0 << 16) + s1 * frac - s0 * frac. It lies between s0 and
+  // s1, so it can be computed modulo 2^16 from the halves of the products.
+  const __m128i sign_bit = _mm_set1_epi16(-32768);
+  for (; i + 8 <= count; i += 8)
+  {
+    const u32* p = &positions[i];
+    const __m128i s0 = _mm_setr_epi16(input[p[0]], input[p[1]], input[p[2]], input[p[3]],
+                                      input[p[4]], input[p[5]], input[p[6]], input[p[7]]);
+    const __m128i s1 =
+        _mm_setr_epi16(input[p[0] + 1], input[p[1] + 1], input[p[2] + 1], input[p[3] + 1],
+                       input[p[4] + 1], input[p[5] + 1], input[p[6] + 1], input[p[7] + 1]);
+    const __m128i frac = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&fracs[i]));
+
+    // Signed by unsigned products, the upper halves are corrected for negative samples
+    const __m128i low0 = _mm_mullo_epi16(s0, frac);
+    const __m128i low1 = _mm_mullo_epi16(s1, frac);
+    const __m128i high0 =
+        _mm_sub_epi16(_mm_mulhi_epu16(s0, frac), _mm_and_si128(_mm_srai_epi16(s0, 15), frac));
+    const __m128i high1 =
+        _mm_sub_epi16(_mm_mulhi_epu16(s1, frac), _mm_and_si128(_mm_srai_epi16(s1, 15), frac));
+
+    // All ones where subtracting the lower halves borrows from the upper half
+    const __m128i borrow =
+        _mm_cmplt_epi16(_mm_xor_si128(low1, sign_bit), _mm_xor_si128(low0, sign_bit));
+    const __m128i samples = _mm_add_epi16(_mm_add_epi16(s0, _mm_sub_epi16(high1, high0)), borrow);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&output[i]), samples);
+  }
+#elif defined(_M_ARM_64)
+  for (; i + 4 <= count; i += 4)
+  {
+    const u32* p = &positions[i];
+    const s16 first[4] = {input[p[0]], input[p[1]], input[p[2]], input[p[3]]};
+    const s16 second[4] = {input[p[0] + 1], input[p[1] + 1], input[p[2] + 1], input[p[3] + 1]};
+    const int32x4_t s0 = vmovl_s16(vld1_s16(first));
+    const int32x4_t s1 = vmovl_s16(vld1_s16(second));
+    const int32x4_t frac = vreinterpretq_s32_u32(vmovl_u16(vld1_u16(&fracs[i])));
+
+    // Fits in 32 bits, 0x10000 - frac is only 0x10000 when frac is 0
+    int32x4_t sum = vmulq_s32(s0, vsubq_s32(vdupq_n_s32(0x10000), frac));
+    sum = vmlaq_s32(sum, s1, frac);
+    vst1_s16(&output[i], vmovn_s32(vshrq_n_s32(sum, 16)));
+  }
+#endif
+
+  for (; i < count; ++i)
+  {
+    const s32 s0 = input[positions[i]];
+    const s32 s1 = input[positions[i] + 1];
+    output[i] = static_cast<s16>((s0 * (0x10000 - fracs[i]) + s1 * fracs[i]) >> 16);
+  }
+}
+
+// Produces the same output as ResampleAudio, but takes all of its input at once and resamples it
+// with SIMD. <input> starts with the four last_samples, followed by the
+// GetResampleInputCount(...) samples that ResampleAudio would read. <count> can be at most
+// MAX_SAMPLES_PER_FRAME.
+u32 ResampleBlock(const s16* input, s16* output, u32 count, s16* last_samples, u32 curr_pos,
+                  u32 ratio, int srctype, const s16* coeffs)
+{
+  if (srctype != SRCTYPE_LINEAR && srctype != SRCTYPE_POLYPHASE)
+  {
+    std::copy_n(input + 4, count, output);
+    std::copy_n(output + count - 4, 4, last_samples);
+    return curr_pos;
+  }
+
+  // Where the four input samples that each output sample is interpolated from start
+  std::array<u32, MAX_SAMPLES_PER_FRAME> positions;
+  std::array<u16, MAX_SAMPLES_PER_FRAME> fracs;
+  u32 position = 0;
+  for (u32 i = 0; i < count; ++i)
+  {
+    curr_pos += ratio;
+    position += curr_pos >> 16;
+    curr_pos &= 0xFFFF;
+    positions[i] = position;
+    fracs[i] = static_cast<u16>(curr_pos);
+  }
+
+  if (coeffs && srctype == SRCTYPE_POLYPHASE)
+    PolyphaseInterpolate(output, input, positions.data(), fracs.data(), count, coeffs);
+  else
+    LinearInterpolate(output, input, positions.data(), fracs.data(), count);
+
+  std::copy_n(input + position, 4, last_samples);
+  return curr_pos;
+}
+
 // Read <count> input samples from ARAM, decoding and converting rate
 // if required.
 void GetInputSamples(PB_TYPE& pb, s16* samples, u16 count, const s16* coeffs)
@@ -360,9 +549,26 @@ void GetInputSamples(PB_TYPE& pb, s16* samples, u16 count, const s16* coeffs)
 
   if (coeffs)
     coeffs += pb.coef_select * 0x200;
-  u32 curr_pos =
-      ResampleAudio([](u32) { return AcceleratorGetSample(); }, samples, count, pb.src.last_samples,
-                    pb.src.cur_addr_frac, HILO_TO_32(pb.src.ratio), pb.src_type, coeffs);
+
+  const u32 ratio = HILO_TO_32(pb.src.ratio);
+  const u64 input_count = GetResampleInputCount(count, pb.src.cur_addr_frac, ratio, pb.src_type);
+  u32 curr_pos;
+  if (input_count <= MAX_BLOCK_INPUT_SAMPLES)
+  {
+    // Decode the whole block first, then resample it
+    std::array<s16, 4 + MAX_BLOCK_INPUT_SAMPLES> input;
+    std::copy_n(pb.src.last_samples, 4, input.begin());
+    for (u32 i = 0; i < input_count; ++i)
+      input[4 + i] = AcceleratorGetSample();
+
+    curr_pos = ResampleBlock(input.data(), samples, count, pb.src.last_samples,
+                             pb.src.cur_addr_frac, ratio, pb.src_type, coeffs);
+  }
+  else
+  {
+    curr_pos = ResampleAudio([](u32) { return AcceleratorGetSample(); }, samples, count,
+                             pb.src.last_samples, pb.src.cur_addr_frac, ratio, pb.src_type, coeffs);
+  }
   pb.src.cur_addr_frac = (curr_pos & 0xFFFF);
 
   // Update current position, YN1, YN2 and pred scale in the PB.
@@ -529,9 +735,11 @@ void ProcessVoice(PB_TYPE& pb, const AXBuffers& buffers, u16 count, AXMixControl
 
     // We use ratio 0x55555 == (5 * 65536 + 21845) / 65536 == 5.3333 which
     // is the nearest we can get to 96/18
-    u32 curr_pos = ResampleAudio([&samples](u32 i) { return samples[i]; }, wm_samples, wm_count,
-                                 pb.remote_src.last_samples, pb.remote_src.cur_addr_frac, 0x55555,
-                                 SRCTYPE_POLYPHASE, coeffs);
+    std::array<s16, 4 + MAX_SAMPLES_PER_FRAME> wm_input;
+    std::copy_n(pb.remote_src.last_samples, 4, wm_input.begin());
+    std::copy_n(samples, count, wm_input.begin() + 4);
+    u32 curr_pos = ResampleBlock(wm_input.data(), wm_samples, wm_count, pb.remote_src.last_samples,
+                                 pb.remote_src.cur_addr_frac, 0x55555, SRCTYPE_POLYPHASE, coeffs);
     pb.remote_src.cur_addr_frac = curr_pos & 0xFFFF;
 
 // Mix to main[0-3] and aux[0-3]
@@ -568,6 +776,113 @@ void ProcessVoice(PB_TYPE& pb, const AXBuffers& buffers, u16 count, AXMixControl
 #endif
 }
 
+// Accelerator addresses count nibbles for ADPCM and samples for PCM16
+u32 GetVoiceByteAddress(const PB_TYPE& pb)
+{
+  const u32 address = HILO_TO_32(pb.audio_addr.cur_addr);
+  switch (pb.audio_addr.sample_format)
+  {
+  case AUDIOFORMAT_ADPCM:
+    return address / 2;
+  case AUDIOFORMAT_PCM16:
+    return address * 2;
+  default:
+    return address;
+  }
+}
+
+// Lists with fewer voices than this take less time to process than waking up the workers
+constexpr size_t MIN_PARALLEL_VOICES = 16;
+
+#ifdef AX_GC
+constexpr u32 MAX_BUFFER_SAMPLES = 32 * 5;
+#else
+constexpr u32 MAX_BUFFER_SAMPLES = 32 * 3;
+#endif
+
+// Processes the voices of a PB list. <process> mixes a voice into the given buffers, and
+// <get_next_pb> returns the address of the PB that follows one once all its updates are applied,
+// so that the whole list can be read up front.
+//
+// Voices only depend on their own PB, so large lists are split into contiguous ranges that are
+// processed by the workers. Every range but the first one is mixed into zeroed buffers that are
+// added to the real buffers afterwards. Integer additions give the same result in any order, so
+// the output is exactly the same as processing the voices one after another, which keeps movies
+// and netplay deterministic.
+template <typename ProcessFunction, typename NextPBFunction>
+void ProcessPBs(u32 pb_addr, u32 crc, const AXBuffers& buffers, const AXBufferSizes& sizes,
+                Common::WorkerPool& workers, ProcessFunction process, NextPBFunction get_next_pb)
+{
+  struct Voice
+  {
+    u32 addr;
+    PB_TYPE pb;
+  };
+
+  // Only used on the CPU thread, kept around to avoid allocating every frame
+  static std::vector<Voice> voices;
+  static std::vector<std::array<int, AX_BUFFER_COUNT * MAX_BUFFER_SAMPLES>> job_samples;
+
+  voices.clear();
+  while (pb_addr)
+  {
+    Voice& voice = voices.emplace_back();
+    voice.addr = pb_addr;
+    ReadPB(pb_addr, voice.pb, crc);
+    pb_addr = get_next_pb(voice.pb);
+  }
+
+  const size_t job_count = voices.size() >= MIN_PARALLEL_VOICES ? workers.GetJobCount() : 1;
+  if (job_count == 1)
+  {
+    for (Voice& voice : voices)
+      process(voice.pb, buffers);
+  }
+  else
+  {
+    job_samples.resize(job_count - 1);
+    const size_t voices_per_job = voices.size() / job_count;
+
+    workers.Run([&](size_t job) {
+      AXBuffers job_buffers = buffers;
+      if (job != 0)
+      {
+        auto& samples = job_samples[job - 1];
+        samples.fill(0);
+        for (size_t i = 0; i < AX_BUFFER_COUNT; ++i)
+          job_buffers.ptrs[i] = &samples[i * MAX_BUFFER_SAMPLES];
+      }
+
+      const size_t first = job * voices_per_job;
+      const size_t last = job == job_count - 1 ? voices.size() : first + voices_per_job;
+      for (size_t i = first; i < last; ++i)
+        process(voices[i].pb, job_buffers);
+    });
+
+    for (const auto& samples : job_samples)
+    {
+      for (size_t i = 0; i < AX_BUFFER_COUNT; ++i)
+      {
+        for (u32 j = 0; j < sizes[i]; ++j)
+          buffers.ptrs[i][j] += samples[i * MAX_BUFFER_SAMPLES + j];
+      }
+    }
+  }
+
+  for (const Voice& voice : voices)
+    WritePB(voice.addr, voice.pb, crc);
+
+  auto& dvd_thread = Core::System::GetInstance().GetDVDThread();
+  if (dvd_thread.IsTrackingStreams())
+  {
+    for (const Voice& voice : voices)
+    {
+      if (voice.pb.running)
+        dvd_thread.NotifyVoicePlayback(voice.addr, GetVoiceByteAddress(voice.pb));
+    }
+  }
+}
+
 }  // namespace
 }  // inline namespace AXGC/AXWii
 }  // namespace DSP::HLE
@@ -413,21 +413,23 @@ void AXWiiUCode::ProcessPBList(u32 pb_addr)
   // Samples per millisecond. In theory DSP sampling rate can be changed from
   // 32KHz to 48KHz, but AX always process at 32KHz.
   constexpr u32 spms = 32;
-
-  AXPBWii pb;
-
-  while (pb_addr)
-  {
-    AXBuffers buffers = {{m_samples_main_left, m_samples_main_right, m_samples_main_surround,
-                          m_samples_auxA_left, m_samples_auxA_right, m_samples_auxA_surround,
-                          m_samples_auxB_left, m_samples_auxB_right, m_samples_auxB_surround,
-                          m_samples_auxC_left, m_samples_auxC_right, m_samples_auxC_surround,
-                          m_samples_wm0,       m_samples_aux0,       m_samples_wm1,
-                          m_samples_aux1,      m_samples_wm2,        m_samples_aux2,
-                          m_samples_wm3,       m_samples_aux3}};
-
-    ReadPB(pb_addr, pb, m_crc);
-
+  // Wiimote samples per millisecond
+  constexpr u32 wm_spms = 6;
+  // The first buffers are at the DSP sampling rate, the rest are Wiimote buffers
+  constexpr size_t wm_first_buffer = 12;
+
+  const AXBuffers buffers = {{m_samples_main_left, m_samples_main_right, m_samples_main_surround,
+                              m_samples_auxA_left, m_samples_auxA_right, m_samples_auxA_surround,
+                              m_samples_auxB_left, m_samples_auxB_right, m_samples_auxB_surround,
+                              m_samples_auxC_left, m_samples_auxC_right, m_samples_auxC_surround,
+                              m_samples_wm0,       m_samples_aux0,       m_samples_wm1,
+                              m_samples_aux1,      m_samples_wm2,        m_samples_aux2,
+                              m_samples_wm3,       m_samples_aux3}};
+  AXBufferSizes sizes;
+  std::fill(sizes.begin(), sizes.begin() + wm_first_buffer, spms * 3);
+  std::fill(sizes.begin() + wm_first_buffer, sizes.end(), wm_spms * 3);
+
+  const auto process = [this](AXPBWii& pb, AXBuffers voice_buffers) {
     u16 num_updates[3];
     u16 updates[1024];
     u32 updates_addr;
@@ -436,24 +438,38 @@ void AXWiiUCode::ProcessPBList(u32 pb_addr)
       for (int curr_ms = 0; curr_ms < 3; ++curr_ms)
       {
         ApplyUpdatesForMs(curr_ms, pb, num_updates, updates);
-        ProcessVoice(pb, buffers, spms, ConvertMixerControl(HILO_TO_32(pb.mixer_control)),
+        ProcessVoice(pb, voice_buffers, spms, ConvertMixerControl(HILO_TO_32(pb.mixer_control)),
                      m_coeffs_checksum ? m_coeffs.data() : nullptr);
 
         // Forward the buffers
-        for (auto& ptr : buffers.ptrs)
-          ptr += spms;
+        for (size_t i = 0; i < AX_BUFFER_COUNT; ++i)
+          voice_buffers.ptrs[i] += i < wm_first_buffer ? spms : wm_spms;
       }
       ReinjectUpdatesFields(pb, num_updates, updates_addr);
     }
     else
     {
-      ProcessVoice(pb, buffers, 96, ConvertMixerControl(HILO_TO_32(pb.mixer_control)),
+      ProcessVoice(pb, voice_buffers, 96, ConvertMixerControl(HILO_TO_32(pb.mixer_control)),
                    m_coeffs_checksum ? m_coeffs.data() : nullptr);
     }
+  };
 
-    WritePB(pb_addr, pb, m_crc);
-    pb_addr = HILO_TO_32(pb.next_pb);
-  }
+  // The updates can change where the next PB is
+  const auto get_next_pb = [this](const AXPBWii& pb) {
+    AXPBWii updated_pb = pb;
+    u16 num_updates[3];
+    u16 updates[1024];
+    u32 updates_addr;
+    if (ExtractUpdatesFields(updated_pb, num_updates, updates, &updates_addr))
+    {
+      for (int curr_ms = 0; curr_ms < 3; ++curr_ms)
+        ApplyUpdatesForMs(curr_ms, updated_pb, num_updates, updates);
+      ReinjectUpdatesFields(updated_pb, num_updates, updates_addr);
+    }
+    return HILO_TO_32(updated_pb.next_pb);
+  };
+
+  ProcessPBs(pb_addr, m_crc, buffers, sizes, m_voice_workers, process, get_next_pb);
 }
 
 void AXWiiUCode::MixAUXSamples(int aux_id, u32 write_addr, u32 read_addr, u16 volume)
@@ -3,6 +3,7 @@
 
 #include "Core/HW/DSPLLE/DSPLLE.h"
 
+#include <algorithm>
 #include <mutex>
 #include <string>
 #include <thread>
@@ -74,7 +75,8 @@ void DSPLLE::DSPThread(DSPLLE* dsp_lle)
         {
           dsp_lle->m_dsp_core.GetInterpreter().RunCyclesThread(cycles);
         }
-        dsp_lle->m_cycle_count.store(0);
+        dsp_lle->m_cycle_count.fetch_sub(cycles);
+        dsp_lle->m_ppc_event.Set();
         continue;
       }
     }
@@ -150,6 +152,7 @@ bool DSPLLE::Initialize(bool wii, bool dsp_thread)
 
   m_wii = wii;
   m_is_dsp_on_thread = dsp_thread;
+  m_max_skew = static_cast<u32>(std::max(Config::Get(Config::MAIN_DSP_THREAD_SKEW), 0));
 
   m_dsp_core.Reset();
 
@@ -183,6 +186,8 @@ void DSPLLE::Shutdown()
 
 u16 DSPLLE::DSP_WriteControlRegister(u16 value)
 {
+  // Resets, halts and interrupts must happen at the point the CPU expects them to
+  DSP_Sync();
   m_dsp_core.GetInterpreter().WriteControlRegister(value);
 
   if ((value & CR_EXTERNAL_INT) != 0)
@@ -212,7 +217,14 @@ u16 DSPLLE::DSP_ReadControlRegister()
 
 u16 DSPLLE::DSP_ReadMailBoxHigh(bool cpu_mailbox)
 {
-  return m_dsp_core.ReadMailboxHigh(cpu_mailbox ? Mailbox::CPU : Mailbox::DSP);
+  const Mailbox mailbox = cpu_mailbox ? Mailbox::CPU : Mailbox::DSP;
+
+  // If the DSP hasn't sent any mail yet, it might only be because it's behind. Catch up, so that
+  // the CPU doesn't poll for longer than it would on hardware.
+  if (!cpu_mailbox && (m_dsp_core.PeekMailbox(mailbox) & 0x80000000) == 0)
+    DSP_Sync();
+
+  return m_dsp_core.ReadMailboxHigh(mailbox);
 }
 
 u16 DSPLLE::DSP_ReadMailBoxLow(bool cpu_mailbox)
@@ -243,6 +255,10 @@ void DSPLLE::DSP_WriteMailBoxLow(bool cpu_mailbox, u16 value)
   if (cpu_mailbox)
   {
     m_dsp_core.WriteMailboxLow(Mailbox::CPU, value);
+
+    // The mail is complete, wake the DSP thread if it's waiting for work
+    if (m_is_dsp_on_thread)
+      m_dsp_event.Set();
   }
   else
   {
@@ -276,10 +292,26 @@ void DSPLLE::DSP_Update(int cycles)
   }
   else
   {
-    // Wait for DSP thread to complete its cycle. Note: this logic should be thought through.
-    m_ppc_event.Wait();
+    // The DSP thread runs behind the CPU. Only wait for it once it's further behind than allowed.
     m_cycle_count.fetch_add(dsp_cycles);
     m_dsp_event.Set();
+    WaitForDSPThread(m_max_skew);
+  }
+}
+
+void DSPLLE::DSP_Sync()
+{
+  if (m_is_dsp_on_thread)
+    WaitForDSPThread(0);
+}
+
+void DSPLLE::WaitForDSPThread(u32 max_pending_cycles)
+{
+  // The DSP thread signals m_ppc_event every time it has run the cycles it had
+  while (m_cycle_count.load() > max_pending_cycles && m_is_running.IsSet())
+  {
+    m_dsp_event.Set();
+    m_ppc_event.Wait();
   }
 }
 
@@ -298,12 +330,9 @@ void DSPLLE::PauseAndLock(bool do_lock)
   {
     m_dsp_thread_mutex.unlock();
 
+    // Signal the DSP thread so it can perform any outstanding work now (if any)
     if (m_is_dsp_on_thread)
-    {
-      // Signal the DSP thread so it can perform any outstanding work now (if any)
-      m_ppc_event.Wait();
       m_dsp_event.Set();
-    }
   }
 }
 }  // namespace DSP::LLE
@@ -35,18 +35,22 @@ public:
   u16 DSP_ReadControlRegister() override;
   u16 DSP_WriteControlRegister(u16 value) override;
   void DSP_Update(int cycles) override;
+  void DSP_Sync() override;
   void DSP_StopSoundStream() override;
   u32 DSP_UpdateRate() override;
 
 private:
   static void DSPThread(DSPLLE* dsp_lle);
+  void WaitForDSPThread(u32 max_pending_cycles);
 
   DSPCore m_dsp_core;
   std::thread m_dsp_thread;
   std::mutex m_dsp_thread_mutex;
   bool m_is_dsp_on_thread = false;
   Common::Flag m_is_running;
+  // The cycles that the DSP thread has yet to run, and how many of them the CPU may get ahead by
   std::atomic<u32> m_cycle_count{};
+  u32 m_max_skew = 0;
 
   Common::Event m_dsp_event;
   Common::Event m_ppc_event;
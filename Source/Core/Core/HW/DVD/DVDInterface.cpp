@@ -41,6 +41,7 @@
 #include "DiscIO/Blob.h"
 #include "DiscIO/DiscUtils.h"
 #include "DiscIO/Enums.h"
+#include "DiscIO/SharedDiscCache.h"
 #include "DiscIO/VolumeDisc.h"
 #include "DiscIO/VolumeWii.h"
 
@@ -215,6 +216,19 @@ void DVDInterface::DTKStreamingCallback(DIInterruptType interrupt_type,
     sound_stream->GetMixer()->PushStreamingSamples(temp_pcm.data(),
                                                    pending_blocks * StreamADPCM::SAMPLES_PER_BLOCK);
 
+    // The samples that were just mixed end at the current position, unless the track ended
+    auto& dvd_thread = m_system.GetDVDThread();
+    const u64 played_bytes = u64(pending_blocks) * StreamADPCM::ONE_BLOCK_SIZE;
+    if (!audio_data.empty() && pending_blocks != 0 &&
+        m_audio_position >= m_current_start + played_bytes && dvd_thread.IsTrackingStreams())
+    {
+      const u32 bytes_per_second = static_cast<u32>(
+          StreamADPCM::ONE_BLOCK_SIZE * (Mixer::FIXED_SAMPLE_RATE_DIVIDEND / sample_rate_divisor) /
+          StreamADPCM::SAMPLES_PER_BLOCK);
+      dvd_thread.NotifyStreamPlayback(DiscIO::PARTITION_NONE, m_audio_position - played_bytes,
+                                      bytes_per_second);
+    }
+
     if (m_stream && ai.IsPlaying())
     {
       read_offset = m_audio_position;
@@ -424,7 +438,8 @@ void DVDInterface::EjectDiscCallback(Core::System& system, u64 userdata, s64 cyc
 void DVDInterface::InsertDiscCallback(Core::System& system, u64 userdata, s64 cyclesLate)
 {
   auto& di = system.GetDVDInterface();
-  std::unique_ptr<DiscIO::VolumeDisc> new_disc = DiscIO::CreateDisc(di.m_disc_path_to_insert);
+  std::unique_ptr<DiscIO::VolumeDisc> new_disc =
+      DiscIO::CreateDisc(DiscIO::CreateBlobReaderForEmulation(di.m_disc_path_to_insert));
 
   if (new_disc)
     di.SetDisc(std::move(new_disc), {});
@@ -3,6 +3,7 @@
 
 #include "Core/HW/DVD/DVDThread.h"
 
+#include <algorithm>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -13,6 +14,7 @@
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
+#include "Common/Counters.h"
 #include "Common/Event.h"
 #include "Common/Flag.h"
 #include "Common/Logging/Log.h"
@@ -20,7 +22,9 @@
 #include "Common/SPSCQueue.h"
 #include "Common/Thread.h"
 #include "Common/Timer.h"
+#include "Common/TraceEvents.h"
 
+#include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
@@ -32,13 +36,25 @@
 #include "Core/System.h"
 
 #include "DiscIO/Enums.h"
+#include "DiscIO/FileReadQueue.h"
 #include "DiscIO/Volume.h"
-
-#include "Subtitles/Subtitles.h"
+#include "DiscIO/WIABlob.h"
 
 namespace DVD
 {
-DVDThread::DVDThread(Core::System& system) : m_system(system)
+// A game usually has a few reads in flight at most, and buffers above this size are rare enough
+// that keeping them around would mostly waste memory
+constexpr u32 MAX_FREE_BUFFERS = 8;
+constexpr size_t MAX_FREE_BUFFER_SIZE = 0x400000;
+
+static Common::Counter s_disc_reads("dolphin_dvd_reads_total", "Reads done by the DVD thread");
+static Common::Counter s_disc_read_bytes("dolphin_dvd_read_bytes_total",
+                                         "Bytes read by the DVD thread");
+
+DVDThread::DVDThread(Core::System& system)
+    : m_disc_access_observers{&m_read_ahead, &m_access_recorder, &m_file_logger,
+                              &m_subtitle_observer},
+      m_system(system)
 {
 }
 
@@ -52,11 +68,14 @@ void DVDThread::Start()
   m_result_queue_expanded.Reset();
   m_request_queue.Clear();
   m_result_queue.Clear();
+  m_free_buffers.Clear();
 
   // This is reset on every launch for determinism, but it doesn't matter
   // much, because this will never get exposed to the emulated game.
   m_next_id = 0;
 
+  Subtitles::StartWorker();
+  m_read_ahead.Start();
   StartDVDThread();
 }
 
@@ -70,6 +89,10 @@ void DVDThread::StartDVDThread()
 void DVDThread::Stop()
 {
   StopDVDThread();
+  Subtitles::StopWorker();
+  m_read_ahead.Stop();
+  m_access_recorder.SetDisc(nullptr, false);
+  m_stream_tracker.Clear();
   m_disc.reset();
 }
 
@@ -104,6 +127,10 @@ void DVDThread::DoState(PointerWrap& p)
   p.Do(m_result_map);
   p.Do(m_next_id);
 
+  // RAM and ARAM are replaced by the state's, the disc positions of their contents are unknown
+  if (p.IsReadMode())
+    m_stream_tracker.Clear();
+
   // m_disc isn't savestated (because it points to files on the
   // local system). Instead, we check that the status of the disc
   // is the same as when the savestate was made. This won't catch
@@ -133,7 +160,17 @@ void DVDThread::DoState(PointerWrap& p)
 void DVDThread::SetDisc(std::unique_ptr<DiscIO::Volume> disc)
 {
   WaitUntilIdle();
+  // The subtitle worker may still be resolving accesses against the old disc
+  Subtitles::WaitUntilIdle();
   m_disc = std::move(disc);
+  m_stream_tracker.Clear();
+  DiscIO::SetWIARVZGroupCacheSize(
+      u64(std::max(Config::Get(Config::MAIN_WIA_RVZ_GROUP_CACHE_SIZE), 0)) << 20);
+  DiscIO::ResetWIARVZGroupCacheStats();
+  DiscIO::ResetFileReadStats();
+  m_read_ahead.SetDisc(m_disc.get(),
+                       u64(std::max(Config::Get(Config::MAIN_DISC_READ_AHEAD_SIZE), 0)) << 20);
+  m_access_recorder.SetDisc(m_disc.get(), Config::Get(Config::MAIN_RECORD_DISC_ACCESS));
 }
 
 bool DVDThread::HasDisc() const
@@ -254,6 +291,56 @@ void DVDThread::StartReadInternal(bool copy_to_ram, u32 output_address, u64 dvd_
   core_timing.ScheduleEvent(ticks_until_completion, m_finish_read, id);
 }
 
+void DVDThread::AddDiscAccessObserver(DiscAccessObserver* observer)
+{
+  WaitUntilIdle();
+  m_disc_access_observers.push_back(observer);
+}
+
+void DVDThread::RemoveDiscAccessObserver(DiscAccessObserver* observer)
+{
+  WaitUntilIdle();
+  std::erase(m_disc_access_observers, observer);
+}
+
+DiscReadAhead::Stats DVDThread::GetReadAheadStats() const
+{
+  return m_read_ahead.GetStats();
+}
+
+bool DVDThread::IsTrackingStreams() const
+{
+  return m_disc && Subtitles::IsSyncedToStream();
+}
+
+void DVDThread::OnCopyToARAM(u32 ram_address, u32 aram_address, u32 length)
+{
+  m_stream_tracker.OnCopyToARAM(ram_address, aram_address, length);
+}
+
+void DVDThread::NotifyStreamPlayback(const DiscIO::Partition& partition, u64 dvd_offset,
+                                     u32 bytes_per_second)
+{
+  if (!m_disc)
+    return;
+
+  Subtitles::OnStreamPlayback(*m_disc, partition, dvd_offset, bytes_per_second,
+                              m_system.GetCoreTiming().GetTicks());
+}
+
+void DVDThread::NotifyVoicePlayback(u32 pb_address, u32 address)
+{
+  // The Wii has no ARAM, its voices play from RAM that the disc is read to directly
+  const std::optional<DiscStreamTracker::Position> position =
+      m_stream_tracker.UpdateVoice(pb_address, address, !SConfig::GetInstance().bWii);
+  if (!position)
+    return;
+
+  // The rate of a voice doesn't tell the rate of its file, which may have headers or interleave
+  // channels, so only the position is reported
+  NotifyStreamPlayback(position->partition, position->dvd_offset, 0);
+}
+
 void DVDThread::GlobalFinishRead(Core::System& system, u64 id, s64 cycles_late)
 {
   system.GetDVDThread().FinishRead(id, cycles_late);
@@ -321,6 +408,12 @@ void DVDThread::FinishRead(u64 id, s64 cycles_late)
     {
       auto& memory = m_system.GetMemory();
       memory.CopyToEmu(request.output_address, buffer.data(), request.length);
+
+      if (IsTrackingStreams())
+      {
+        m_stream_tracker.OnReadToRAM(request.partition, request.dvd_offset, request.length,
+                                     request.output_address);
+      }
     }
 
     interrupt = DVD::DIInterruptType::TCINT;
@@ -328,6 +421,29 @@ void DVDThread::FinishRead(u64 id, s64 cycles_late)
 
   // Notify the emulated software that the command has been executed
   dvd_interface.FinishExecutingCommand(request.reply_type, interrupt, cycles_late, buffer);
+
+  ReturnBuffer(std::move(result.second));
+}
+
+std::vector<u8> DVDThread::TakeBuffer(u32 length)
+{
+  std::vector<u8> buffer;
+  m_free_buffers.Pop(buffer);
+
+  // Resizing within the capacity doesn't allocate
+  buffer.resize(length);
+  return buffer;
+}
+
+void DVDThread::ReturnBuffer(std::vector<u8> buffer)
+{
+  if (buffer.capacity() == 0 || buffer.capacity() > MAX_FREE_BUFFER_SIZE ||
+      m_free_buffers.Size() >= MAX_FREE_BUFFERS)
+  {
+    return;
+  }
+
+  m_free_buffers.Push(std::move(buffer));
 }
 
 void DVDThread::DVDThreadMain()
@@ -344,14 +460,22 @@ void DVDThread::DVDThreadMain()
     ReadRequest request;
     while (m_request_queue.Pop(request))
     {
-      m_file_logger.Log(*m_disc, request.partition, request.dvd_offset);
-      Subtitles::OnFileAccess(*m_disc, request.partition, request.dvd_offset);
-
-      std::vector<u8> buffer(request.length);
-      if (!m_disc->Read(request.dvd_offset, request.length, buffer.data(), request.partition))
+      TRACE_SCOPE("Read disc");
+      NotifyDiscAccessObservers(m_disc_access_observers, *m_disc, request.partition,
+                                request.dvd_offset, request.length, request.time_started_ticks,
+                                request.reply_type == ReplyType::DTK);
+
+      std::vector<u8> buffer = TakeBuffer(request.length);
+      if (!m_read_ahead.Read(request.dvd_offset, request.length, buffer.data(),
+                             request.partition) &&
+          !m_disc->Read(request.dvd_offset, request.length, buffer.data(), request.partition))
+      {
         buffer.resize(0);
+      }
 
       request.realtime_done_us = Common::Timer::NowUs();
+      s_disc_reads.Add();
+      s_disc_read_bytes.Add(buffer.size());
 
       m_result_queue.Push(ReadResult(std::move(request), std::move(buffer)));
       m_result_queue_expanded.Set();
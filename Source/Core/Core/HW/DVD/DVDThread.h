@@ -16,10 +16,16 @@
 #include "Common/SPSCQueue.h"
 
 #include "Core/HW/DVD/DVDInterface.h"
+#include "Core/HW/DVD/DiscAccessObserver.h"
+#include "Core/HW/DVD/DiscAccessRecorder.h"
+#include "Core/HW/DVD/DiscReadAhead.h"
+#include "Core/HW/DVD/DiscStreamTracker.h"
 #include "Core/HW/DVD/FileMonitor.h"
 
 #include "DiscIO/Volume.h"
 
+#include "Subtitles/Subtitles.h"
+
 class PointerWrap;
 namespace Core
 {
@@ -86,6 +92,22 @@ public:
                               const DiscIO::Partition& partition, DVD::ReplyType reply_type,
                               s64 ticks_until_completion);
 
+  // Observers are called on the DVD thread and must outlive their registration.
+  void AddDiscAccessObserver(DiscAccessObserver* observer);
+  void RemoveDiscAccessObserver(DiscAccessObserver* observer);
+
+  DiscReadAhead::Stats GetReadAheadStats() const;
+
+  // Audio that is played from the disc, or from RAM or ARAM it was copied to, is reported to the
+  // subtitles, so that their cues can follow playback instead of the reads. Only called on the
+  // CPU thread, and only worth calling while IsTrackingStreams returns true.
+  bool IsTrackingStreams() const;
+  void OnCopyToARAM(u32 ram_address, u32 aram_address, u32 length);
+  void NotifyStreamPlayback(const DiscIO::Partition& partition, u64 dvd_offset,
+                            u32 bytes_per_second);
+  // address is the byte address the voice with the PB at pb_address is playing from
+  void NotifyVoicePlayback(u32 pb_address, u32 address);
+
 private:
   void StartDVDThread();
   void StopDVDThread();
@@ -100,6 +122,11 @@ private:
 
   void DVDThreadMain();
 
+  // Called on the DVD thread
+  std::vector<u8> TakeBuffer(u32 length);
+  // Called on the CPU thread once a result has been handed to DVDInterface
+  void ReturnBuffer(std::vector<u8> buffer);
+
   struct ReadRequest
   {
     bool copy_to_ram = false;
@@ -118,7 +145,7 @@ private:
     // it's fine to re-use IDs of requests that have existed in the past.
     u64 id = 0;
 
-    // Only used for logging
+    // Used for logging and for DiscAccessObservers
     u64 time_started_ticks = 0;
     u64 realtime_started_us = 0;
     u64 realtime_done_us = 0;
@@ -139,9 +166,18 @@ private:
   Common::SPSCQueue<ReadResult, false> m_result_queue;
   std::map<u64, ReadResult> m_result_map;
 
+  // Buffers of finished reads, handed back from the CPU thread so that the DVD thread doesn't
+  // allocate and fault in a new buffer for every read
+  Common::SPSCQueue<std::vector<u8>> m_free_buffers;
+
   std::unique_ptr<DiscIO::Volume> m_disc;
 
+  DiscReadAhead m_read_ahead;
+  DiscAccessRecorder m_access_recorder;
   FileMonitor::FileLogger m_file_logger;
+  Subtitles::SubtitleObserver m_subtitle_observer;
+  DiscStreamTracker m_stream_tracker;
+  std::vector<DiscAccessObserver*> m_disc_access_observers;
 
   Core::System& m_system;
 };
@@ -0,0 +1,56 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/HW/DVD/DiscAccessObserver.h"
+
+#include <optional>
+
+#include "DiscIO/Filesystem.h"
+#include "DiscIO/Volume.h"
+
+namespace DVD
+{
+void NotifyDiscAccessObservers(std::span<DiscAccessObserver* const> observers,
+                               const DiscIO::Volume& volume, const DiscIO::Partition& partition,
+                               u64 dvd_offset, u32 length, u64 ticks, bool audio_stream)
+{
+  bool any_enabled = false;
+  bool needs_file_info = false;
+  for (const DiscAccessObserver* observer : observers)
+  {
+    if (observer->IsEnabled())
+    {
+      any_enabled = true;
+      needs_file_info |= observer->NeedsFileInfo();
+    }
+  }
+
+  if (!any_enabled)
+    return;
+
+  // Resolve the file once for all observers
+  std::optional<DiscIO::FileLocation> file;
+  if (needs_file_info)
+  {
+    if (const DiscIO::FileSystem* file_system = volume.GetFileSystem(partition))
+      file = file_system->FindFileLocation(dvd_offset);
+  }
+
+  const u64 file_offset = file ? file->offset : 0;
+  const DiscAccess access{volume,
+                          partition,
+                          dvd_offset,
+                          length,
+                          ticks,
+                          audio_stream,
+                          file ? &*file : nullptr,
+                          file_offset,
+                          file ? dvd_offset - file_offset : 0};
+
+  for (DiscAccessObserver* observer : observers)
+  {
+    if (observer->IsEnabled())
+      observer->OnDiscAccess(access);
+  }
+}
+}  // namespace DVD
@@ -0,0 +1,58 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <span>
+
+#include "Common/CommonTypes.h"
+
+namespace DiscIO
+{
+struct FileLocation;
+struct Partition;
+class Volume;
+}  // namespace DiscIO
+
+namespace DVD
+{
+// A disc read as seen by DiscAccessObservers. Everything is non-owning and only valid for the
+// duration of the OnDiscAccess call.
+struct DiscAccess
+{
+  const DiscIO::Volume& volume;
+  const DiscIO::Partition& partition;
+  u64 dvd_offset;
+  u32 length;
+  // CoreTiming ticks at which the emulated software issued the read
+  u64 ticks;
+  // Set for the reads the drive issues by itself to stream DTK audio
+  bool audio_stream;
+
+  // Only resolved if an enabled observer returned true from NeedsFileInfo.
+  // Null if that was not the case or if no file contains dvd_offset.
+  const DiscIO::FileLocation* file;
+  // Absolute offset of the file and dvd_offset relative to it. Zero if file is null.
+  u64 file_offset;
+  u64 relative_offset;
+};
+
+// Observers are notified by the DVD thread before each read. The FST lookup is done at most once
+// per read and shared between all observers that need it.
+class DiscAccessObserver
+{
+public:
+  virtual ~DiscAccessObserver() = default;
+
+  // Checked before each read; disabled observers cost nothing beyond this call.
+  virtual bool IsEnabled() const = 0;
+  virtual bool NeedsFileInfo() const { return false; }
+  virtual void OnDiscAccess(const DiscAccess& access) = 0;
+};
+
+// Notifies every enabled observer of a read. This is what the DVD thread calls before each read.
+void NotifyDiscAccessObservers(std::span<DiscAccessObserver* const> observers,
+                               const DiscIO::Volume& volume, const DiscIO::Partition& partition,
+                               u64 dvd_offset, u32 length, u64 ticks,
+                               bool audio_stream = false);
+}  // namespace DVD
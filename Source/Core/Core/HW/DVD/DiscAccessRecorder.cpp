@@ -0,0 +1,103 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/HW/DVD/DiscAccessRecorder.h"
+
+#include <algorithm>
+#include <ctime>
+#include <string>
+
+#include <fmt/chrono.h>
+#include <fmt/format.h>
+
+#include "Common/CommonPaths.h"
+#include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
+#include "Core/HW/SystemTimers.h"
+#include "DiscIO/Filesystem.h"
+#include "DiscIO/Volume.h"
+
+namespace DVD
+{
+// Records are written in batches so that the DVD thread rarely touches the file
+constexpr size_t RECORDS_PER_WRITE = 4096;
+
+DiscAccessRecorder::DiscAccessRecorder() = default;
+
+DiscAccessRecorder::~DiscAccessRecorder()
+{
+  SetDisc(nullptr, false);
+}
+
+void DiscAccessRecorder::SetDisc(const DiscIO::Volume* disc, bool enabled)
+{
+  if (m_file.IsOpen())
+  {
+    Flush();
+    m_file.Close();
+  }
+
+  if (!disc || !enabled)
+    return;
+
+  const DiscIO::Partition partition = disc->GetGamePartition();
+  const std::string game_id = disc->GetGameID(partition);
+
+  m_header = {};
+  m_header.magic = DiscIO::DISC_ACCESS_TRACE_MAGIC;
+  m_header.version = DiscIO::DISC_ACCESS_FORMAT_VERSION;
+  std::copy_n(game_id.begin(), std::min(game_id.size(), sizeof(m_header.game_id)),
+              m_header.game_id);
+  m_header.revision = disc->GetRevision(partition).value_or(0);
+  m_header.disc_number = disc->GetDiscNumber(partition).value_or(0);
+  m_header.ticks_per_second = SystemTimers::GetTicksPerSecond();
+
+  const std::string dir = File::GetUserPath(D_DUMP_IDX) + DUMP_DISC_ACCESS_DIR DIR_SEP;
+  const std::string path = fmt::format("{}{}_{:%Y-%m-%d_%H-%M-%S}.dtrc", dir, game_id,
+                                       fmt::localtime(std::time(nullptr)));
+  if (!File::CreateFullPath(dir) || !m_file.Open(path, "wb") || !m_file.WriteArray(&m_header, 1))
+  {
+    ERROR_LOG_FMT(DVDINTERFACE, "Failed to create disc access trace {}", path);
+    m_file.Close();
+    return;
+  }
+
+  m_pending_records.reserve(RECORDS_PER_WRITE);
+  NOTICE_LOG_FMT(DVDINTERFACE, "Recording disc accesses to {}", path);
+}
+
+bool DiscAccessRecorder::IsEnabled() const
+{
+  return m_file.IsOpen();
+}
+
+void DiscAccessRecorder::OnDiscAccess(const DiscAccess& access)
+{
+  m_pending_records.push_back({access.ticks, access.partition.offset, access.dvd_offset,
+                               access.length,
+                               access.file ? access.file->index : DiscIO::DISC_ACCESS_NO_FILE});
+
+  if (m_pending_records.size() >= RECORDS_PER_WRITE)
+    Flush();
+}
+
+void DiscAccessRecorder::Flush()
+{
+  if (m_pending_records.empty())
+    return;
+
+  m_header.entry_count += static_cast<u32>(m_pending_records.size());
+
+  // Keep the header's count current, so that a trace is usable even if Dolphin doesn't exit
+  // cleanly
+  if (!m_file.WriteArray(m_pending_records.data(), m_pending_records.size()) ||
+      !m_file.Seek(0, File::SeekOrigin::Begin) || !m_file.WriteArray(&m_header, 1) ||
+      !m_file.Seek(0, File::SeekOrigin::End))
+  {
+    ERROR_LOG_FMT(DVDINTERFACE, "Failed to write disc access trace, stopping the recording");
+    m_file.Close();
+  }
+
+  m_pending_records.clear();
+}
+}  // namespace DVD
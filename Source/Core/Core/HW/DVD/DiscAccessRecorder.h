@@ -0,0 +1,43 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/IOFile.h"
+#include "Core/HW/DVD/DiscAccessObserver.h"
+#include "DiscIO/DiscAccessProfile.h"
+
+namespace DiscIO
+{
+class Volume;
+}
+
+namespace DVD
+{
+// Writes a DiscIO::DiscAccessTrace of every DVD read to the dump directory, for building disc
+// access profiles offline.
+class DiscAccessRecorder final : public DiscAccessObserver
+{
+public:
+  DiscAccessRecorder();
+  ~DiscAccessRecorder();
+
+  // Must not be called while the DVD thread is reading. Finishes the current trace and starts a
+  // new one for the disc if recording is enabled.
+  void SetDisc(const DiscIO::Volume* disc, bool enabled);
+
+  bool IsEnabled() const override;
+  bool NeedsFileInfo() const override { return true; }
+  void OnDiscAccess(const DiscAccess& access) override;
+
+private:
+  void Flush();
+
+  File::IOFile m_file;
+  DiscIO::DiscAccessHeader m_header{};
+  std::vector<DiscIO::DiscAccessRecord> m_pending_records;
+};
+}  // namespace DVD
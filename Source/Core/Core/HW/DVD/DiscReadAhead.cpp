@@ -0,0 +1,191 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/HW/DVD/DiscReadAhead.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "Common/Align.h"
+#include "Common/Logging/Log.h"
+#include "DiscIO/Blob.h"
+#include "DiscIO/Filesystem.h"
+
+namespace DVD
+{
+DiscReadAhead::DiscReadAhead() = default;
+
+DiscReadAhead::~DiscReadAhead()
+{
+  Stop();
+}
+
+void DiscReadAhead::Start()
+{
+  m_worker.Reset("DVD read-ahead", [this](ChunkKey key) { Prefetch(std::move(key)); });
+  m_worker_running = true;
+}
+
+void DiscReadAhead::Stop()
+{
+  m_worker.Shutdown(true);
+  m_worker_running = false;
+  LogStats();
+  Clear();
+  m_volume.reset();
+  m_max_chunks = 0;
+}
+
+void DiscReadAhead::SetDisc(const DiscIO::Volume* disc, u64 cache_size)
+{
+  // WaitForCompletion never returns for a cancelled worker that isn't running
+  if (m_worker_running)
+  {
+    m_worker.Cancel();
+    m_worker.WaitForCompletion();
+  }
+
+  LogStats();
+  Clear();
+  m_volume.reset();
+  m_max_chunks = cache_size / CHUNK_SIZE;
+
+  if (!disc || m_max_chunks == 0)
+    return;
+
+  // Not every blob reader can be copied, in which case there is no read-ahead
+  if (std::unique_ptr<DiscIO::BlobReader> reader = disc->GetBlobReader().CopyReader())
+    m_volume = DiscIO::CreateVolume(std::move(reader));
+}
+
+bool DiscReadAhead::IsEnabled() const
+{
+  return m_volume != nullptr;
+}
+
+void DiscReadAhead::OnDiscAccess(const DiscAccess& access)
+{
+  const DiscIO::FileLocation* file = access.file;
+  if (!file)
+  {
+    m_stream_is_sequential = false;
+    return;
+  }
+
+  // A read that continues exactly where the previous read of the same file ended
+  const bool sequential = access.partition == m_stream_partition &&
+                          access.file_offset == m_stream_file_offset &&
+                          access.dvd_offset == m_stream_end;
+
+  m_stream_partition = access.partition;
+  m_stream_file_offset = access.file_offset;
+  m_stream_end = access.dvd_offset + access.length;
+
+  // Wait for the second sequential read so that one-off reads don't trigger prefetching
+  const bool was_sequential = m_stream_is_sequential;
+  m_stream_is_sequential = sequential;
+  if (!sequential || !was_sequential)
+    return;
+
+  const u64 file_end = access.file_offset + file->size;
+  const u64 prefetch_end = std::min(file_end, m_stream_end + READ_AHEAD_CHUNKS * CHUNK_SIZE);
+
+  std::lock_guard lk(m_cache_mutex);
+  for (u64 offset = Common::AlignDown(m_stream_end, CHUNK_SIZE); offset < prefetch_end;
+       offset += CHUNK_SIZE)
+  {
+    ChunkKey key{access.partition, offset};
+    if (m_chunks.contains(key) || !m_pending_chunks.insert(key).second)
+      continue;
+
+    m_worker.Push(std::move(key));
+  }
+}
+
+bool DiscReadAhead::Read(u64 offset, u32 length, u8* out_ptr, const DiscIO::Partition& partition)
+{
+  if (!m_volume || length == 0)
+    return false;
+
+  std::lock_guard lk(m_cache_mutex);
+
+  const u64 end = offset + length;
+  for (u64 chunk = Common::AlignDown(offset, CHUNK_SIZE); chunk < end; chunk += CHUNK_SIZE)
+  {
+    if (!m_chunks.contains({partition, chunk}))
+    {
+      ++m_misses;
+      return false;
+    }
+  }
+
+  for (u64 chunk = Common::AlignDown(offset, CHUNK_SIZE); chunk < end; chunk += CHUNK_SIZE)
+  {
+    const std::vector<u8>& data = m_chunks.find({partition, chunk})->second;
+    const u64 copy_start = std::max(offset, chunk);
+    const u64 copy_end = std::min(end, chunk + CHUNK_SIZE);
+    std::memcpy(out_ptr + (copy_start - offset), data.data() + (copy_start - chunk),
+                copy_end - copy_start);
+  }
+
+  ++m_hits;
+  return true;
+}
+
+void DiscReadAhead::Prefetch(ChunkKey key)
+{
+  // Allocated and read outside of the lock so the DVD thread is never blocked by decompression
+  std::vector<u8> data;
+  bool success = false;
+  if (!m_worker.IsCancelling())
+  {
+    data.resize(CHUNK_SIZE);
+    success = m_volume->Read(key.second, CHUNK_SIZE, data.data(), key.first);
+  }
+
+  std::lock_guard lk(m_cache_mutex);
+  m_pending_chunks.erase(key);
+
+  // Reads fail near the end of the disc, in which case those reads are left to the DVD thread
+  if (!success)
+    return;
+
+  m_prefetched_bytes += CHUNK_SIZE;
+  m_chunks.emplace(key, std::move(data));
+  m_chunk_order.push_back(std::move(key));
+  while (m_chunk_order.size() > m_max_chunks)
+  {
+    m_chunks.erase(m_chunk_order.front());
+    m_chunk_order.pop_front();
+  }
+}
+
+void DiscReadAhead::Clear()
+{
+  std::lock_guard lk(m_cache_mutex);
+  m_chunks.clear();
+  m_chunk_order.clear();
+  m_pending_chunks.clear();
+  m_stream_is_sequential = false;
+
+  m_hits = 0;
+  m_misses = 0;
+  m_prefetched_bytes = 0;
+}
+
+DiscReadAhead::Stats DiscReadAhead::GetStats() const
+{
+  return {m_hits, m_misses, m_prefetched_bytes};
+}
+
+void DiscReadAhead::LogStats() const
+{
+  const Stats stats = GetStats();
+  const u64 reads = stats.hits + stats.misses;
+  if (reads == 0)
+    return;
+
+  INFO_LOG_FMT(DVDINTERFACE, "Read-ahead: {} of {} reads hit ({:.1f}%), {} KiB prefetched",
+               stats.hits, reads, stats.hits * 100.0 / reads, stats.prefetched_bytes / 1024);
+}
+}  // namespace DVD
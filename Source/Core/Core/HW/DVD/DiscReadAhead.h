@@ -0,0 +1,95 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/WorkQueueThread.h"
+#include "Core/HW/DVD/DiscAccessObserver.h"
+#include "DiscIO/Volume.h"
+
+namespace DVD
+{
+// Detects games streaming a file sequentially and reads the next chunks of that file on a
+// background thread, so that decompressing them is off the DVD thread's critical path.
+// The DVD thread tries Read before reading from the disc itself.
+class DiscReadAhead final : public DiscAccessObserver
+{
+public:
+  struct Stats
+  {
+    u64 hits = 0;
+    u64 misses = 0;
+    u64 prefetched_bytes = 0;
+  };
+
+  // Chunks are aligned to this in partition offsets. RVZ defaults to 128 KiB chunks, so this
+  // makes each prefetch decompress about one chunk of the most common kind of image.
+  static constexpr u64 CHUNK_SIZE = 0x20000;
+  // How far ahead of the current read a detected stream is prefetched
+  static constexpr u32 READ_AHEAD_CHUNKS = 8;
+
+  DiscReadAhead();
+  ~DiscReadAhead();
+
+  DiscReadAhead(const DiscReadAhead&) = delete;
+  DiscReadAhead& operator=(const DiscReadAhead&) = delete;
+
+  void Start();
+  void Stop();
+
+  // Must not be called while the DVD thread is reading. A size of 0 disables read-ahead.
+  void SetDisc(const DiscIO::Volume* disc, u64 cache_size);
+
+  // Called on the DVD thread. Returns false without touching out_ptr unless the whole range is
+  // cached.
+  bool Read(u64 offset, u32 length, u8* out_ptr, const DiscIO::Partition& partition);
+
+  Stats GetStats() const;
+
+  bool IsEnabled() const override;
+  bool NeedsFileInfo() const override { return true; }
+  void OnDiscAccess(const DiscAccess& access) override;
+
+private:
+  using ChunkKey = std::pair<DiscIO::Partition, u64>;
+
+  void Prefetch(ChunkKey key);
+  void Clear();
+  void LogStats() const;
+
+  Common::WorkQueueThread<ChunkKey> m_worker;
+  bool m_worker_running = false;
+
+  // Only accessed by the worker while it's running. The worker reads from its own blob reader
+  // so that it never shares decompression state with the DVD thread.
+  std::unique_ptr<DiscIO::Volume> m_volume;
+  size_t m_max_chunks = 0;
+
+  mutable std::mutex m_cache_mutex;
+  std::map<ChunkKey, std::vector<u8>> m_chunks;
+  // Insertion order of m_chunks, oldest first. Streamed data is rarely read twice, so
+  // the oldest chunk is the one to evict.
+  std::deque<ChunkKey> m_chunk_order;
+  std::set<ChunkKey> m_pending_chunks;
+
+  // Stream detection, only accessed on the DVD thread
+  DiscIO::Partition m_stream_partition;
+  u64 m_stream_file_offset = 0;
+  u64 m_stream_end = 0;
+  bool m_stream_is_sequential = false;
+
+  std::atomic<u64> m_hits = 0;
+  std::atomic<u64> m_misses = 0;
+  std::atomic<u64> m_prefetched_bytes = 0;
+};
+}  // namespace DVD
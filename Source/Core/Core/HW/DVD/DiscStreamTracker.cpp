@@ -0,0 +1,118 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/HW/DVD/DiscStreamTracker.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace DVD
+{
+void DiscStreamTracker::Clear()
+{
+  m_ram.clear();
+  m_aram.clear();
+  m_voice_offsets.clear();
+}
+
+void DiscStreamTracker::OnReadToRAM(const DiscIO::Partition& partition, u64 dvd_offset,
+                                    u32 length, u32 ram_address)
+{
+  if (length == 0)
+    return;
+
+  Erase(m_ram, ram_address, ram_address + length);
+  m_ram.emplace(ram_address, Extent{ram_address + length, partition, dvd_offset});
+}
+
+void DiscStreamTracker::OnCopyToARAM(u32 ram_address, u32 aram_address, u32 length)
+{
+  if (length == 0)
+    return;
+
+  Erase(m_aram, aram_address, aram_address + length);
+
+  // Copy the disc positions of the parts of the source that came from the disc
+  const u32 ram_end = ram_address + length;
+  auto it = m_ram.upper_bound(ram_address);
+  if (it != m_ram.begin())
+    --it;
+  for (; it != m_ram.end() && it->first < ram_end; ++it)
+  {
+    const u32 start = std::max(it->first, ram_address);
+    const u32 end = std::min(it->second.end, ram_end);
+    if (start >= end)
+      continue;
+
+    m_aram.emplace(aram_address + (start - ram_address),
+                   Extent{aram_address + (end - ram_address), it->second.partition,
+                          it->second.dvd_offset + (start - it->first)});
+  }
+}
+
+std::optional<DiscStreamTracker::Position> DiscStreamTracker::UpdateVoice(u32 voice, u32 address,
+                                                                         bool in_aram)
+{
+  const std::optional<Position> position = Find(in_aram ? m_aram : m_ram, address);
+  if (!position)
+    return std::nullopt;
+
+  auto [it, inserted] = m_voice_offsets.try_emplace(voice, position->dvd_offset);
+  if (!inserted)
+  {
+    // Loops and new sounds on the same voice go back, which is always reported
+    if (position->dvd_offset >= it->second &&
+        position->dvd_offset < it->second + VOICE_GRANULARITY)
+    {
+      return std::nullopt;
+    }
+    it->second = position->dvd_offset;
+  }
+  return position;
+}
+
+void DiscStreamTracker::Erase(ExtentMap& extents, u32 start, u32 end)
+{
+  auto it = extents.lower_bound(start);
+
+  // The extent before start may reach into the erased range or even past it
+  if (it != extents.begin())
+  {
+    Extent& previous = std::prev(it)->second;
+    const u32 previous_start = std::prev(it)->first;
+    if (previous.end > start)
+    {
+      if (previous.end > end)
+      {
+        extents.emplace(end, Extent{previous.end, previous.partition,
+                                    previous.dvd_offset + (end - previous_start)});
+      }
+      previous.end = start;
+    }
+  }
+
+  while (it != extents.end() && it->first < end)
+  {
+    if (it->second.end > end)
+    {
+      extents.emplace(end, Extent{it->second.end, it->second.partition,
+                                  it->second.dvd_offset + (end - it->first)});
+    }
+    it = extents.erase(it);
+  }
+}
+
+std::optional<DiscStreamTracker::Position> DiscStreamTracker::Find(const ExtentMap& extents,
+                                                                  u32 address)
+{
+  auto it = extents.upper_bound(address);
+  if (it == extents.begin())
+    return std::nullopt;
+
+  --it;
+  if (address >= it->second.end)
+    return std::nullopt;
+
+  return Position{it->second.partition, it->second.dvd_offset + (address - it->first)};
+}
+}  // namespace DVD
@@ -0,0 +1,59 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <map>
+#include <optional>
+
+#include "Common/CommonTypes.h"
+#include "DiscIO/Volume.h"
+
+namespace DVD
+{
+// Remembers which disc data was copied to RAM and from there to ARAM, so that the address an
+// audio voice is playing from can be traced back to the disc. Memory that is written by anything
+// else afterwards keeps its old disc position, which is fine for buffers that only ever hold
+// streamed data. Only used on the CPU thread.
+class DiscStreamTracker
+{
+public:
+  struct Position
+  {
+    DiscIO::Partition partition;
+    u64 dvd_offset;
+  };
+
+  // Voices have to move at least this far before their position is reported again
+  static constexpr u64 VOICE_GRANULARITY = 0x100;
+
+  void Clear();
+
+  void OnReadToRAM(const DiscIO::Partition& partition, u64 dvd_offset, u32 length,
+                   u32 ram_address);
+  void OnCopyToARAM(u32 ram_address, u32 aram_address, u32 length);
+
+  // Returns where on the disc the voice is playing from, if that changed by at least
+  // VOICE_GRANULARITY since the last call for the same voice. address is a byte address in
+  // ARAM, or in RAM for voices that play from RAM.
+  std::optional<Position> UpdateVoice(u32 voice, u32 address, bool in_aram);
+
+private:
+  struct Extent
+  {
+    u32 end;
+    DiscIO::Partition partition;
+    u64 dvd_offset;
+  };
+  // Non-overlapping extents by start address
+  using ExtentMap = std::map<u32, Extent>;
+
+  static void Erase(ExtentMap& extents, u32 start, u32 end);
+  static std::optional<Position> Find(const ExtentMap& extents, u32 address);
+
+  ExtentMap m_ram;
+  ExtentMap m_aram;
+  // Last reported disc offset by PB address
+  std::map<u32, u64> m_voice_offsets;
+};
+}  // namespace DVD
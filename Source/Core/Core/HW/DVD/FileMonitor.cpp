@@ -6,6 +6,7 @@
 #include <algorithm>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <unordered_set>
 
 #include <fmt/format.h>
@@ -21,10 +22,14 @@
 namespace FileMonitor
 {
 // Filtered files
-static bool IsSoundOrVideoFile(const std::string& filename)
+static bool IsSoundOrVideoFile(std::string_view path)
 {
-  std::string extension;
-  SplitPath(filename, nullptr, nullptr, &extension);
+  const size_t name_start = path.find_last_of('/') + 1;
+  const size_t extension_start = path.find_last_of('.');
+  if (extension_start == std::string_view::npos || extension_start < name_start)
+    return false;
+
+  std::string extension(path.substr(extension_start));
   Common::ToLower(&extension);
 
   static const std::unordered_set<std::string> extensions = {
@@ -52,37 +57,35 @@ FileLogger::FileLogger() = default;
 
 FileLogger::~FileLogger() = default;
 
-void FileLogger::Log(const DiscIO::Volume& volume, const DiscIO::Partition& partition, u64 offset)
+bool FileLogger::IsEnabled() const
 {
   // Do nothing if the log isn't selected
-  if (!Common::Log::LogManager::GetInstance()->IsEnabled(Common::Log::LogType::FILEMON,
-                                                         Common::Log::LogLevel::LWARNING))
-  {
-    return;
-  }
-
-  const DiscIO::FileSystem* file_system = volume.GetFileSystem(partition);
-
-  // Do nothing if there is no valid file system
-  if (!file_system)
-    return;
-
-  const std::unique_ptr<DiscIO::FileInfo> file_info = file_system->FindFileInfo(offset);
+  return Common::Log::LogManager::GetInstance()->IsEnabled(Common::Log::LogType::FILEMON,
+                                                           Common::Log::LogLevel::LWARNING);
+}
 
+void FileLogger::OnDiscAccess(const DVD::DiscAccess& access)
+{
   // Do nothing if no file was found at that offset
-  if (!file_info)
+  if (!access.file)
     return;
 
-  const u64 file_offset = file_info->GetOffset();
-  const u64 relativeOffset = offset - file_info->GetOffset();
+  const DiscIO::Partition& partition = access.partition;
+  const u64 offset = access.dvd_offset;
+  const u64 file_offset = access.file_offset;
+  const u64 relativeOffset = access.relative_offset;
 
   // TODO add last_log time to keep logging streamed asset offsets without spamming logs? Or another LogType so user can enable nonstop logging?
   // Do nothing if we found the same file again
   if (m_previous_partition == partition && m_previous_file_offset == file_offset)
     return;
 
-  const std::string size_string = Common::ThousandSeparate(file_info->GetSize() / 1000, 7);
-  const std::string path = file_info->GetPath();
+  const DiscIO::FileSystem* file_system = access.volume.GetFileSystem(partition);
+  if (!file_system)
+    return;
+
+  const std::string size_string = Common::ThousandSeparate(access.file->size / 1000, 7);
+  const std::string_view path = file_system->GetPath(access.file->index);
   const std::string log_string = fmt::format("{} kB {} offset {} fileOffset {} relativeOffset {}", size_string, path, offset, file_offset, relativeOffset);
 
   if (IsSoundOrVideoFile(path))
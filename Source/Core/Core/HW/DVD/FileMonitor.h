@@ -4,17 +4,20 @@
 #pragma once
 
 #include "Common/CommonTypes.h"
+#include "Core/HW/DVD/DiscAccessObserver.h"
 #include "DiscIO/Volume.h"
 
 namespace FileMonitor
 {
-class FileLogger
+class FileLogger final : public DVD::DiscAccessObserver
 {
 public:
   FileLogger();
-  ~FileLogger();
+  ~FileLogger() override;
 
-  void Log(const DiscIO::Volume& volume, const DiscIO::Partition& partition, u64 offset);
+  bool IsEnabled() const override;
+  bool NeedsFileInfo() const override { return true; }
+  void OnDiscAccess(const DVD::DiscAccess& access) override;
 
 private:
   DiscIO::Partition m_previous_partition;
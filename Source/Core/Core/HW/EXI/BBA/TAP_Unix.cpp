@@ -16,6 +16,7 @@
 #include "Core/HW/EXI/EXI_Device.h"
 
 #ifdef __linux__
+#include <cerrno>
 #include <fcntl.h>
 #include <linux/if_tun.h>
 #include <net/if.h>
@@ -39,7 +40,8 @@ bool CEXIETHERNET::TAPNetworkInterface::Activate()
   // Assumes that there is a TAP device named "Dolphin" preconfigured for
   // bridge/NAT/whatever the user wants it configured.
 
-  if ((fd = open("/dev/net/tun", O_RDWR)) < 0)
+  // Non-blocking, so that the read thread can drain all queued frames after each wakeup
+  if ((fd = open("/dev/net/tun", O_RDWR | O_NONBLOCK)) < 0)
   {
     ERROR_LOG_FMT(SP1, "Couldn't open /dev/net/tun, unable to init BBA");
     return false;
@@ -142,17 +144,25 @@ void CEXIETHERNET::TAPNetworkInterface::ReadThreadHandler(TAPNetworkInterface* s
     if (select(self->fd + 1, &rfds, nullptr, nullptr, &timeout) <= 0)
       continue;
 
-    int readBytes = read(self->fd, self->m_eth_ref->mRecvBuffer.get(), BBA_RECV_SIZE);
-    if (readBytes < 0)
+    // Each read returns one frame, keep going until the queue is empty so that bursts of small
+    // packets only cost one select
+    while (!self->readThreadShutdown.IsSet())
     {
-      ERROR_LOG_FMT(SP1, "Failed to read from BBA, err={}", readBytes);
-    }
-    else if (self->readEnabled.IsSet())
-    {
-      DEBUG_LOG_FMT(SP1, "Read data: {}",
-                    ArrayToString(self->m_eth_ref->mRecvBuffer.get(), readBytes, 0x10));
-      self->m_eth_ref->mRecvBufferLength = readBytes;
-      self->m_eth_ref->RecvHandlePacket();
+      int readBytes = read(self->fd, self->m_eth_ref->mRecvBuffer.get(), BBA_RECV_SIZE);
+      if (readBytes < 0)
+      {
+        if (errno != EAGAIN && errno != EWOULDBLOCK)
+          ERROR_LOG_FMT(SP1, "Failed to read from BBA, err={}", errno);
+        break;
+      }
+
+      if (self->readEnabled.IsSet())
+      {
+        DEBUG_LOG_FMT(SP1, "Read data: {}",
+                      ArrayToString(self->m_eth_ref->mRecvBuffer.get(), readBytes, 0x10));
+        self->m_eth_ref->mRecvBufferLength = readBytes;
+        self->m_eth_ref->RecvHandlePacket();
+      }
     }
   }
 }
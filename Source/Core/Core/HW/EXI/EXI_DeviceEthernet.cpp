@@ -4,6 +4,7 @@
 #include "Core/HW/EXI/EXI_DeviceEthernet.h"
 
 #include <algorithm>
+#include <cstring>
 #include <memory>
 #include <optional>
 #include <string>
@@ -11,6 +12,7 @@
 #include "Common/BitUtils.h"
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
+#include "Common/Counters.h"
 #include "Common/Logging/Log.h"
 #include "Common/Network.h"
 #include "Common/StringUtil.h"
@@ -23,6 +25,16 @@
 
 namespace ExpansionInterface
 {
+static Common::Counter s_frames_sent("dolphin_bba_frames_sent_total",
+                                     "Ethernet frames sent by the broadband adapter");
+static Common::Counter s_bytes_sent("dolphin_bba_sent_bytes_total",
+                                    "Bytes of Ethernet frames sent by the broadband adapter");
+static Common::Counter s_frames_received("dolphin_bba_frames_received_total",
+                                         "Ethernet frames received by the broadband adapter");
+static Common::Counter s_bytes_received(
+    "dolphin_bba_received_bytes_total",
+    "Bytes of Ethernet frames received by the broadband adapter");
+
 // XXX: The BBA stores multi-byte elements as little endian.
 // Multiple parts of this implementation depend on Dolphin
 // being compiled for a little endian host.
@@ -448,7 +460,11 @@ void CEXIETHERNET::SendFromDirectFIFO()
   const u8* frame = tx_fifo.get();
   const u16 size = Common::BitCastPtr<u16>(&mBbaMem[BBA_TXFIFOCNT]);
   if (m_network_interface->SendFrame(frame, size))
+  {
+    s_frames_sent.Add();
+    s_bytes_sent.Add(size);
     m_system.GetPowerPC().GetDebugInterface().NetworkLogger()->LogBBA(frame, size);
+  }
 }
 
 void CEXIETHERNET::SendFromPacketBuffer()
@@ -554,6 +570,9 @@ bool CEXIETHERNET::RecvHandlePacket()
   if (!RecvMACFilter())
     goto wait_for_next;
 
+  s_frames_received.Add();
+  s_bytes_received.Add(mRecvBufferLength);
+
 #ifdef BBA_TRACK_PAGE_PTRS
   INFO_LOG_FMT(SP1, "RecvHandlePacket {:x}\n{}", mRecvBufferLength,
                ArrayToString(mRecvBuffer.get(), mRecvBufferLength, 16));
@@ -568,10 +587,13 @@ bool CEXIETHERNET::RecvHandlePacket()
   descriptor = (Descriptor*)write_ptr;
   current_rwp = page_ptr(BBA_RWP);
   DEBUG_LOG_FMT(SP1, "Frame recv: {:x}", mRecvBufferLength);
-  for (u32 i = 0; i < mRecvBufferLength; i++)
+  // Copy up to the end of each page at once
+  for (u32 i = 0; i < mRecvBufferLength;)
   {
-    write_ptr[off] = mRecvBuffer[i];
-    off++;
+    const u32 chunk = std::min(mRecvBufferLength - i, 0x100 - off);
+    std::memcpy(write_ptr + off, &mRecvBuffer[i], chunk);
+    i += chunk;
+    off += chunk;
     if (off == 0x100)
     {
       off = 0;
@@ -3,6 +3,9 @@
 
 #include "Core/HW/GBACore.h"
 
+#include <algorithm>
+#include <utility>
+
 #define PYCPARSE  // Remove static functions from the header
 #include <mgba/core/interface.h>
 #undef PYCPARSE
@@ -479,9 +482,21 @@ void Core::SendJoybusCommand(u64 gc_ticks, int transfer_time, u8* buffer, u16 ke
   if (m_thread)
   {
     std::lock_guard<std::mutex> lock(m_queue_mutex);
+    if (command.sync_only && command.transfer_time == 0 && !m_command_queue.empty() &&
+        m_command_queue.back().sync_only && m_command_queue.back().transfer_time == 0 &&
+        m_command_queue.back().keys == command.keys && !::Core::WantsDeterminism())
+    {
+      // The thread is behind, so let it catch up to the latest sync point in one batch instead
+      // of stopping at every sync point in between. Where it stops depends on the host's speed,
+      // so this is only done when determinism isn't needed.
+      m_command_queue.back().ticks = command.ticks;
+      return;
+    }
+
     m_command_queue.push(command);
-    m_idle = false;
-    m_command_cv.notify_one();
+    // The thread only waits on the condition variable once it ran out of commands
+    if (std::exchange(m_idle, false))
+      m_command_cv.notify_one();
   }
   else
   {
@@ -514,6 +529,13 @@ void Core::Flush()
 void Core::ThreadLoop()
 {
   Common::SetCurrentThreadName(fmt::format("GBA{}", m_device_number + 1).c_str());
+  if (Config::Get(Config::MAIN_GBA_PIN_THREADS))
+  {
+    // Give each GBA a core of its own, counting down from the last core since the first ones are
+    // the most likely to be busy with the emulated CPU and GPU
+    const u32 core_count = std::min(std::max(std::thread::hardware_concurrency(), 1u), 32u);
+    Common::SetCurrentThreadAffinity(1u << (core_count - 1 - m_device_number % core_count));
+  }
   std::unique_lock<std::mutex> queue_lock(m_queue_mutex);
   while (true)
   {
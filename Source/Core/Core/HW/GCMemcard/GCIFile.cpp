@@ -62,6 +62,8 @@ bool GCIFile::LoadSaveBlocks()
       m_save_data.clear();
       return false;
     }
+
+    m_dirty_blocks.assign(num_blocks, false);
   }
   return true;
 }
@@ -85,6 +87,13 @@ int GCIFile::UsesBlock(u16 block_num)
   return -1;
 }
 
+void GCIFile::MarkBlockDirty(int block_index)
+{
+  if (!m_dirty_blocks.empty())
+    m_dirty_blocks[block_index] = true;
+  m_dirty = true;
+}
+
 void GCIFile::DoState(PointerWrap& p)
 {
   p.Do(m_gci_header);
@@ -92,5 +101,9 @@ void GCIFile::DoState(PointerWrap& p)
   p.Do(m_filename);
   p.Do(m_save_data);
   p.Do(m_used_blocks);
+
+  // The loaded save data may differ from the file on disk in any block
+  if (p.IsReadMode())
+    m_dirty_blocks.clear();
 }
 }  // namespace Memcard
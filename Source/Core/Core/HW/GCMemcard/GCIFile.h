@@ -21,11 +21,15 @@ public:
   bool HasCopyProtection() const;
   void DoState(PointerWrap& p);
   int UsesBlock(u16 blocknum);
+  void MarkBlockDirty(int block_index);
 
   DEntry m_gci_header;
   std::vector<GCMBlock> m_save_data;
   std::vector<u16> m_used_blocks;
   bool m_dirty = false;
+  // Which blocks of m_save_data differ from the file on disk. Empty if that isn't known, in which
+  // case the whole file has to be rewritten.
+  std::vector<bool> m_dirty_blocks;
   std::string m_filename;
 };
 }  // namespace Memcard
@@ -90,9 +90,24 @@ bool GCMemcardDirectory::LoadGCI(Memcard::GCIFile gci)
     return false;
   }
 
-  if (!gci.LoadSaveBlocks())
+  // Only the saves of the running game are read right away. The data of the others is read on
+  // first access, which most of them never see, so that large GCI folders don't slow down boot.
+  const bool load_now = m_game_id == Common::swap32(gci.m_gci_header.m_gamecode.data()) ||
+                        gci.HasCopyProtection();
+  if (load_now)
   {
-    ERROR_LOG_FMT(EXPANSIONINTERFACE, "Failed to load data of {}", gci.m_filename);
+    if (!gci.LoadSaveBlocks())
+    {
+      ERROR_LOG_FMT(EXPANSIONINTERFACE, "Failed to load data of {}", gci.m_filename);
+      return false;
+    }
+  }
+  else if (File::GetSize(gci.m_filename) != num_blocks * Memcard::BLOCK_SIZE + Memcard::DENTRY_SIZE)
+  {
+    ERROR_LOG_FMT(EXPANSIONINTERFACE,
+                  "{}\nwas not loaded because it is an invalid GCI.\n File size does not match "
+                  "the size recorded in the header",
+                  gci.m_filename);
     return false;
   }
 
@@ -507,6 +522,7 @@ inline void GCMemcardDirectory::SyncSaves()
           INFO_LOG_FMT(EXPANSIONINTERFACE, "Save moved from {:#x} to {:#x}", old_start, new_start);
           m_saves[i].m_used_blocks.clear();
           m_saves[i].m_save_data.clear();
+          m_saves[i].m_dirty_blocks.clear();
         }
         if (m_saves[i].m_used_blocks.empty())
         {
@@ -521,6 +537,7 @@ inline void GCMemcardDirectory::SyncSaves()
       m_saves[i].m_gci_header.m_gamecode = Memcard::DEntry::UNINITIALIZED_GAMECODE;
       m_saves[i].m_save_data.clear();
       m_saves[i].m_used_blocks.clear();
+      m_saves[i].m_dirty_blocks.clear();
       m_saves[i].m_dirty = true;
     }
   }
@@ -551,7 +568,7 @@ inline s32 GCMemcardDirectory::SaveAreaRW(u32 block, bool writing)
 
         if (writing)
         {
-          m_saves[i].m_dirty = true;
+          m_saves[i].MarkBlockDirty(idx);
         }
 
         m_last_block = block;
@@ -620,10 +637,23 @@ bool GCMemcardDirectory::SetUsedBlocks(int save_index)
 
 void GCMemcardDirectory::FlushToFile()
 {
+  // Everything that has to be written is copied while holding the lock, and written out after
+  // releasing it, so that the emulated game isn't held up by the file system.
+  struct PendingWrite
+  {
+    std::string filename;
+    Memcard::DEntry header;
+    // Indices of the blocks to write within the save. Empty if the whole file is rewritten.
+    std::vector<u16> block_indices;
+    std::vector<Memcard::GCMBlock> blocks;
+  };
+  std::vector<PendingWrite> pending_writes;
+  std::vector<std::string> pending_deletions;
+
   std::unique_lock l(m_write_mutex);
-  Memcard::DEntry invalid;
   for (Memcard::GCIFile& save : m_saves)
   {
+    bool write_pending = false;
     if (save.m_dirty)
     {
       if (save.m_gci_header.m_gamecode != Memcard::DEntry::UNINITIALIZED_GAMECODE)
@@ -656,44 +686,40 @@ void GCMemcardDirectory::FlushToFile()
                            default_save_name);
           }
           save.m_filename = default_save_name;
+          save.m_dirty_blocks.clear();
         }
-        File::IOFile gci(save.m_filename, "wb");
-        if (gci)
-        {
-          gci.WriteBytes(&save.m_gci_header, Memcard::DENTRY_SIZE);
-          for (const Memcard::GCMBlock& block : save.m_save_data)
-            gci.WriteBytes(block.m_block.data(), Memcard::BLOCK_SIZE);
 
-          if (gci.IsGood())
-          {
-            Core::DisplayMessage("Wrote save contents to GCI Folder", 4000);
-          }
-          else
+        PendingWrite& write = pending_writes.emplace_back();
+        write.filename = save.m_filename;
+        write.header = save.m_gci_header;
+        if (save.m_dirty_blocks.size() == save.m_save_data.size())
+        {
+          // Only the header and the blocks that were written to have changed since the file was
+          // last read or written
+          for (u16 i = 0; i < save.m_save_data.size(); ++i)
           {
-            Core::DisplayMessage(
-                fmt::format("Failed to write save contents to {}", save.m_filename), 10000);
-            ERROR_LOG_FMT(EXPANSIONINTERFACE, "Failed to save data to {}", save.m_filename);
+            if (save.m_dirty_blocks[i])
+            {
+              write.block_indices.push_back(i);
+              write.blocks.push_back(save.m_save_data[i]);
+            }
           }
         }
         else
         {
-          Core::DisplayMessage(
-              fmt::format("Failed to open file at {} for writing", save.m_filename), 10000);
-          ERROR_LOG_FMT(EXPANSIONINTERFACE, "Failed to open file at {} for writing",
-                        save.m_filename);
+          write.blocks = save.m_save_data;
         }
+        save.m_dirty_blocks.assign(save.m_save_data.size(), false);
+        write_pending = true;
       }
       else if (save.m_filename.length() != 0)
       {
         save.m_dirty = false;
-        std::string& old_name = save.m_filename;
-        std::string deleted_name = old_name + ".deleted";
-        if (File::Exists(deleted_name))
-          File::Delete(deleted_name);
-        File::Rename(old_name, deleted_name);
+        pending_deletions.push_back(std::move(save.m_filename));
         save.m_filename.clear();
         save.m_save_data.clear();
         save.m_used_blocks.clear();
+        save.m_dirty_blocks.clear();
       }
     }
 
@@ -702,11 +728,15 @@ void GCMemcardDirectory::FlushToFile()
     // simultaneously
     // this ensures that the save data for all of the current games gci files are stored in the
     // savestate
+    // Saves that are about to be written are kept until the next flush, so that they aren't read
+    // back from a file that is still being written.
     const u32 gamecode = Common::swap32(save.m_gci_header.m_gamecode.data());
-    if (gamecode != m_game_id && gamecode != 0xFFFFFFFF && !save.m_save_data.empty())
+    if (gamecode != m_game_id && gamecode != 0xFFFFFFFF && !save.m_save_data.empty() &&
+        !write_pending)
     {
       INFO_LOG_FMT(EXPANSIONINTERFACE, "Flushing savedata to disk for {}", save.m_filename);
       save.m_save_data.clear();
+      save.m_dirty_blocks.clear();
     }
   }
 #if _WRITE_MC_HEADER
@@ -715,6 +745,74 @@ void GCMemcardDirectory::FlushToFile()
   File::IOFile hdrfile(m_save_directory + MC_HDR, "wb");
   hdrfile.WriteBytes(mc, BLOCK_SIZE * MC_FST_BLOCKS);
 #endif
+  l.unlock();
+
+  for (const std::string& old_name : pending_deletions)
+  {
+    std::string deleted_name = old_name + ".deleted";
+    if (File::Exists(deleted_name))
+      File::Delete(deleted_name);
+    File::Rename(old_name, deleted_name);
+  }
+
+  std::vector<std::string> failed_writes;
+  for (const PendingWrite& write : pending_writes)
+  {
+    const bool whole_file = write.block_indices.empty() && !write.blocks.empty();
+    File::IOFile gci(write.filename, whole_file ? "wb" : "r+b");
+    if (gci)
+    {
+      gci.WriteBytes(&write.header, Memcard::DENTRY_SIZE);
+      if (whole_file)
+      {
+        for (const Memcard::GCMBlock& block : write.blocks)
+          gci.WriteBytes(block.m_block.data(), Memcard::BLOCK_SIZE);
+      }
+      else
+      {
+        for (size_t i = 0; i < write.block_indices.size(); ++i)
+        {
+          gci.Seek(Memcard::DENTRY_SIZE + u64(write.block_indices[i]) * Memcard::BLOCK_SIZE,
+                   File::SeekOrigin::Begin);
+          gci.WriteBytes(write.blocks[i].m_block.data(), Memcard::BLOCK_SIZE);
+        }
+      }
+
+      if (gci.IsGood())
+      {
+        Core::DisplayMessage("Wrote save contents to GCI Folder", 4000);
+      }
+      else
+      {
+        Core::DisplayMessage(fmt::format("Failed to write save contents to {}", write.filename),
+                             10000);
+        ERROR_LOG_FMT(EXPANSIONINTERFACE, "Failed to save data to {}", write.filename);
+        failed_writes.push_back(write.filename);
+      }
+    }
+    else
+    {
+      Core::DisplayMessage(fmt::format("Failed to open file at {} for writing", write.filename),
+                           10000);
+      ERROR_LOG_FMT(EXPANSIONINTERFACE, "Failed to open file at {} for writing", write.filename);
+      failed_writes.push_back(write.filename);
+    }
+  }
+
+  // The files that couldn't be written no longer match what we know about them, so make sure that
+  // they are rewritten in full the next time
+  if (!failed_writes.empty())
+  {
+    l.lock();
+    for (Memcard::GCIFile& save : m_saves)
+    {
+      if (std::find(failed_writes.begin(), failed_writes.end(), save.m_filename) !=
+          failed_writes.end())
+      {
+        save.m_dirty_blocks.clear();
+      }
+    }
+  }
 }
 
 void GCMemcardDirectory::DoState(PointerWrap& p)
@@ -3,6 +3,7 @@
 
 #include "Core/HW/GPFifo.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstring>
 
@@ -89,27 +90,35 @@ void GPFifoManager::UpdateGatherPipe()
   auto& processor_interface = system.GetProcessorInterface();
 
   size_t pipe_count = GetGatherPipeCount();
-  size_t processed;
-  u8* cur_mem = memory.GetPointer(processor_interface.m_fifo_cpu_write_pointer);
-  for (processed = 0; pipe_count >= GATHER_PIPE_SIZE; processed += GATHER_PIPE_SIZE)
+  size_t processed = 0;
+  while (pipe_count >= GATHER_PIPE_SIZE)
   {
+    // The bursts up to the end of the FIFO are contiguous in memory, so they are copied and handed
+    // to the command processor at once. The first burst goes on its own, since the command
+    // processor moves the CPU write pointer to its own if the gather pipe is linked to its FIFO.
+    const u32 write_pointer = processor_interface.m_fifo_cpu_write_pointer;
+    const u32 end = processor_interface.m_fifo_cpu_end;
+    u32 bursts = 1;
+    if (processed != 0)
+    {
+      bursts = static_cast<u32>(pipe_count / GATHER_PIPE_SIZE);
+      if (write_pointer <= end && (end - write_pointer) % GATHER_PIPE_SIZE == 0)
+        bursts = std::min(bursts, (end - write_pointer) / GATHER_PIPE_SIZE + 1);
+    }
+    const u32 size = bursts * GATHER_PIPE_SIZE;
+
     // copy the GatherPipe
-    memcpy(cur_mem, m_gather_pipe + processed, GATHER_PIPE_SIZE);
-    pipe_count -= GATHER_PIPE_SIZE;
+    memcpy(memory.GetPointer(write_pointer), m_gather_pipe + processed, size);
+    processed += size;
+    pipe_count -= size;
 
-    // increase the CPUWritePointer
-    if (processor_interface.m_fifo_cpu_write_pointer == processor_interface.m_fifo_cpu_end)
-    {
+    // increase the CPUWritePointer, wrapping around after a burst at the end
+    if (write_pointer + size - GATHER_PIPE_SIZE == end)
       processor_interface.m_fifo_cpu_write_pointer = processor_interface.m_fifo_cpu_base;
-      cur_mem = memory.GetPointer(processor_interface.m_fifo_cpu_write_pointer);
-    }
     else
-    {
-      cur_mem += GATHER_PIPE_SIZE;
-      processor_interface.m_fifo_cpu_write_pointer += GATHER_PIPE_SIZE;
-    }
+      processor_interface.m_fifo_cpu_write_pointer = write_pointer + size;
 
-    system.GetCommandProcessor().GatherPipeBursted(system);
+    system.GetCommandProcessor().GatherPipeBursted(system, bursts);
   }
 
   // move back the spill bytes
@@ -21,6 +21,13 @@ constexpr u32 GATHER_PIPE_PHYSICAL_ADDRESS = 0x0C008000;
 constexpr u32 GATHER_PIPE_SIZE = 32;
 constexpr u32 GATHER_PIPE_EXTRA_SIZE = GATHER_PIPE_SIZE * 16;
 
+// The JITs check the gather pipe once this many bytes have been written to it in a block, rather
+// than after every burst, so that the bursts are handed to the FIFO together. There has to be room
+// left for what was in the pipe before the block and for the largest single write.
+constexpr u32 GATHER_PIPE_JIT_CHECK_SIZE = GATHER_PIPE_SIZE * 8;
+static_assert(GATHER_PIPE_JIT_CHECK_SIZE + GATHER_PIPE_SIZE + sizeof(u64) <=
+              GATHER_PIPE_EXTRA_SIZE);
+
 class GPFifoManager final
 {
 public:
@@ -292,15 +292,12 @@ void ReadHandler<T>::Visit(ReadHandlingMethodVisitor<T>& visitor)
 }
 
 template <typename T>
-T ReadHandler<T>::Read(Core::System& system, u32 addr)
+T ReadHandler<T>::ReadUninitialized(Core::System& system, u32 addr)
 {
-  // Check if the handler has already been initialized. For real
-  // handlers, this will always be the case, so this branch should be
-  // easily predictable.
-  if (!m_Method)
-    InitializeInvalid();
-
-  return m_ReadFunc(system, addr);
+  // Real handlers are always initialized, so only the invalid handlers of
+  // unused addresses end up here.
+  InitializeInvalid();
+  return Read(system, addr);
 }
 
 template <typename T>
@@ -308,31 +305,34 @@ void ReadHandler<T>::ResetMethod(ReadHandlingMethod<T>* method)
 {
   m_Method.reset(method);
 
-  struct FuncCreatorVisitor : public ReadHandlingMethodVisitor<T>
+  struct FlattenVisitor : public ReadHandlingMethodVisitor<T>
   {
-    virtual ~FuncCreatorVisitor() = default;
+    explicit FlattenVisitor(ReadHandler<T>* handler_) : handler(handler_) {}
+    virtual ~FlattenVisitor() = default;
 
-    std::function<T(Core::System&, u32)> ret;
+    ReadHandler<T>* handler;
 
     void VisitConstant(T value) override
     {
-      ret = [value](Core::System&, u32) { return value; };
+      handler->m_kind = Kind::Constant;
+      handler->m_constant = value;
     }
 
     void VisitDirect(const T* addr, u32 mask) override
     {
-      ret = [addr, mask](Core::System&, u32) { return *addr & mask; };
+      handler->m_kind = Kind::Direct;
+      handler->m_direct = {addr, mask};
     }
 
     void VisitComplex(const std::function<T(Core::System&, u32)>* lambda) override
     {
-      ret = *lambda;
+      handler->m_kind = Kind::Complex;
+      handler->m_complex = lambda;
     }
   };
 
-  FuncCreatorVisitor v;
+  FlattenVisitor v(this);
   Visit(v);
-  m_ReadFunc = v.ret;
 }
 
 template <typename T>
@@ -367,15 +367,12 @@ void WriteHandler<T>::Visit(WriteHandlingMethodVisitor<T>& visitor)
 }
 
 template <typename T>
-void WriteHandler<T>::Write(Core::System& system, u32 addr, T val)
+void WriteHandler<T>::WriteUninitialized(Core::System& system, u32 addr, T val)
 {
-  // Check if the handler has already been initialized. For real
-  // handlers, this will always be the case, so this branch should be
-  // easily predictable.
-  if (!m_Method)
-    InitializeInvalid();
-
-  m_WriteFunc(system, addr, val);
+  // Real handlers are always initialized, so only the invalid handlers of
+  // unused addresses end up here.
+  InitializeInvalid();
+  Write(system, addr, val);
 }
 
 template <typename T>
@@ -383,31 +380,30 @@ void WriteHandler<T>::ResetMethod(WriteHandlingMethod<T>* method)
 {
   m_Method.reset(method);
 
-  struct FuncCreatorVisitor : public WriteHandlingMethodVisitor<T>
+  struct FlattenVisitor : public WriteHandlingMethodVisitor<T>
   {
-    virtual ~FuncCreatorVisitor() = default;
+    explicit FlattenVisitor(WriteHandler<T>* handler_) : handler(handler_) {}
+    virtual ~FlattenVisitor() = default;
 
-    std::function<void(Core::System&, u32, T)> ret;
+    WriteHandler<T>* handler;
 
-    void VisitNop() override
-    {
-      ret = [](Core::System&, u32, T) {};
-    }
+    void VisitNop() override { handler->m_kind = Kind::Nop; }
 
     void VisitDirect(T* ptr, u32 mask) override
     {
-      ret = [ptr, mask](Core::System&, u32, T val) { *ptr = val & mask; };
+      handler->m_kind = Kind::Direct;
+      handler->m_direct = {ptr, mask};
     }
 
     void VisitComplex(const std::function<void(Core::System&, u32, T)>* lambda) override
     {
-      ret = *lambda;
+      handler->m_kind = Kind::Complex;
+      handler->m_complex = lambda;
     }
   };
 
-  FuncCreatorVisitor v;
+  FlattenVisitor v(this);
   Visit(v);
-  m_WriteFunc = v.ret;
 }
 
 template <typename T>
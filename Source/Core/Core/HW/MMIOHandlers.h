@@ -130,18 +130,54 @@ public:
   // Entry point for read handling method visitors.
   void Visit(ReadHandlingMethodVisitor<T>& visitor);
 
-  T Read(Core::System& system, u32 addr);
+  T Read(Core::System& system, u32 addr)
+  {
+    switch (m_kind)
+    {
+    case Kind::Constant:
+      return m_constant;
+    case Kind::Direct:
+      return static_cast<T>(*m_direct.addr & m_direct.mask);
+    case Kind::Complex:
+      return (*m_complex)(system, addr);
+    default:
+      return ReadUninitialized(system, addr);
+    }
+  }
 
   // Internal method called when changing the internal method object. Its
   // main role is to make sure the read function is updated at the same time.
   void ResetMethod(ReadHandlingMethod<T>* method);
 
 private:
+  // The handling method, flattened when it is set so that reads don't need to
+  // go through the method object or a std::function for the common cases.
+  enum class Kind : u8
+  {
+    Uninitialized,
+    Constant,
+    Direct,
+    Complex,
+  };
+
   // Initialize this handler to an invalid handler. Done lazily to avoid
   // useless initialization of thousands of unused handler objects.
   void InitializeInvalid();
+  T ReadUninitialized(Core::System& system, u32 addr);
+
   std::unique_ptr<ReadHandlingMethod<T>> m_Method;
-  std::function<T(Core::System&, u32)> m_ReadFunc;
+  Kind m_kind = Kind::Uninitialized;
+  union
+  {
+    T m_constant;
+    struct
+    {
+      const T* addr;
+      u32 mask;
+    } m_direct;
+    // Owned by m_Method
+    const std::function<T(Core::System&, u32)>* m_complex;
+  };
 };
 template <typename T>
 class WriteHandler
@@ -157,7 +193,23 @@ public:
   // Entry point for write handling method visitors.
   void Visit(WriteHandlingMethodVisitor<T>& visitor);
 
-  void Write(Core::System& system, u32 addr, T val);
+  void Write(Core::System& system, u32 addr, T val)
+  {
+    switch (m_kind)
+    {
+    case Kind::Nop:
+      break;
+    case Kind::Direct:
+      *m_direct.addr = static_cast<T>(val & m_direct.mask);
+      break;
+    case Kind::Complex:
+      (*m_complex)(system, addr, val);
+      break;
+    default:
+      WriteUninitialized(system, addr, val);
+      break;
+    }
+  }
 
   // Internal method called when changing the internal method object. Its
   // main role is to make sure the write function is updated at the same
@@ -165,11 +217,32 @@ public:
   void ResetMethod(WriteHandlingMethod<T>* method);
 
 private:
+  // See ReadHandler::Kind.
+  enum class Kind : u8
+  {
+    Uninitialized,
+    Nop,
+    Direct,
+    Complex,
+  };
+
   // Initialize this handler to an invalid handler. Done lazily to avoid
   // useless initialization of thousands of unused handler objects.
   void InitializeInvalid();
+  void WriteUninitialized(Core::System& system, u32 addr, T val);
+
   std::unique_ptr<WriteHandlingMethod<T>> m_Method;
-  std::function<void(Core::System&, u32, T)> m_WriteFunc;
+  Kind m_kind = Kind::Uninitialized;
+  union
+  {
+    struct
+    {
+      T* addr;
+      u32 mask;
+    } m_direct;
+    // Owned by m_Method
+    const std::function<void(Core::System&, u32, T)>* m_complex;
+  };
 };
 
 // Boilerplate boilerplate boilerplate.
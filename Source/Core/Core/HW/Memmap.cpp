@@ -14,10 +14,12 @@
 #include <memory>
 #include <tuple>
 
+#include "Common/Align.h"
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Common/MemArena.h"
+#include "Common/MemoryUtil.h"
 #include "Common/MsgHandler.h"
 #include "Common/Swap.h"
 #include "Core/Config/MainSettings.h"
@@ -109,6 +111,11 @@ void MemoryManager::Init()
   // If MMU is turned off in GameCube mode, turn on fake VMEM hack.
   const bool fake_vmem = !wii && !mmu;
 
+  // Huge pages can only back the regions that start at a multiple of their size in the segment.
+  // What is skipped to align them is never touched, so it doesn't take any memory.
+  const bool huge_pages = Config::Get(Config::MAIN_HUGE_PAGES);
+  const u32 region_alignment = huge_pages ? static_cast<u32>(Common::HUGE_PAGE_SIZE) : 1;
+
   u32 mem_size = 0;
   for (PhysicalMemoryRegion& region : m_physical_regions)
   {
@@ -117,10 +124,11 @@ void MemoryManager::Init()
     if (!fake_vmem && (region.flags & PhysicalMemoryRegion::FAKE_VMEM))
       continue;
 
-    region.shm_position = mem_size;
+    region.shm_position = Common::AlignUp(mem_size, region_alignment);
     region.active = true;
-    mem_size += region.size;
+    mem_size = region.shm_position + region.size;
   }
+  m_arena.SetUseHugePages(huge_pages);
   m_arena.GrabSHMSegment(mem_size, "dolphin-emu");
 
   m_physical_page_mappings.fill(nullptr);
@@ -235,6 +243,8 @@ bool MemoryManager::InitFastmemArena()
 
 void MemoryManager::UpdateLogicalMemory(const PowerPC::BatTable& dbat_table)
 {
+  UnmapAllPageTableEntries();
+
   for (auto& entry : m_logical_mapped_entries)
   {
     m_arena.UnmapFromMemoryRegion(entry.mapped_pointer, entry.mapped_size);
@@ -290,6 +300,55 @@ void MemoryManager::UpdateLogicalMemory(const PowerPC::BatTable& dbat_table)
   }
 }
 
+bool MemoryManager::MapPageTableEntry(u32 logical_address, u32 translated_address)
+{
+  if (!m_is_fastmem_arena_initialized ||
+      Common::MemArena::GetMappingGranularity() > PowerPC::HW_PAGE_SIZE)
+  {
+    return false;
+  }
+
+  for (const auto& physical_region : m_physical_regions)
+  {
+    if (!physical_region.active)
+      continue;
+
+    const u32 mapping_address = physical_region.physical_address;
+    if (translated_address < mapping_address ||
+        translated_address - mapping_address >= physical_region.size)
+    {
+      continue;
+    }
+
+    const u32 position = physical_region.shm_position + translated_address - mapping_address;
+    u8* base = m_logical_base + logical_address;
+    void* mapped_pointer = m_arena.MapInMemoryRegion(position, PowerPC::HW_PAGE_SIZE, base);
+    if (!mapped_pointer)
+      return false;
+
+    const u32 tlb_index = (logical_address >> PowerPC::HW_PAGE_INDEX_SHIFT) &
+                          PowerPC::HW_PAGE_INDEX_MASK;
+    m_page_table_mapped_entries[tlb_index].push_back(
+        {mapped_pointer, static_cast<u32>(PowerPC::HW_PAGE_SIZE)});
+    return true;
+  }
+
+  return false;
+}
+
+void MemoryManager::UnmapPageTableEntries(u32 tlb_index)
+{
+  for (auto& entry : m_page_table_mapped_entries[tlb_index])
+    m_arena.UnmapFromMemoryRegion(entry.mapped_pointer, entry.mapped_size);
+  m_page_table_mapped_entries[tlb_index].clear();
+}
+
+void MemoryManager::UnmapAllPageTableEntries()
+{
+  for (u32 i = 0; i < m_page_table_mapped_entries.size(); ++i)
+    UnmapPageTableEntries(i);
+}
+
 void MemoryManager::DoState(PointerWrap& p)
 {
   const u32 current_ram_size = GetRamSize();
@@ -328,14 +387,14 @@ void MemoryManager::DoState(PointerWrap& p)
     return;
   }
 
-  p.DoArray(m_ram, current_ram_size);
+  m_ram_delta.DoState(p, m_ram, current_ram_size);
   p.DoArray(m_l1_cache, current_l1_cache_size);
   p.DoMarker("Memory RAM");
   if (current_have_fake_vmem)
-    p.DoArray(m_fake_vmem, current_fake_vmem_size);
+    m_fake_vmem_delta.DoState(p, m_fake_vmem, current_fake_vmem_size);
   p.DoMarker("Memory FakeVMEM");
   if (current_have_exram)
-    p.DoArray(m_exram, current_exram_size);
+    m_exram_delta.DoState(p, m_exram, current_exram_size);
   p.DoMarker("Memory EXRAM");
 }
 
@@ -343,6 +402,10 @@ void MemoryManager::Shutdown()
 {
   ShutdownFastmemArena();
 
+  m_ram_delta.Clear();
+  m_exram_delta.Clear();
+  m_fake_vmem_delta.Clear();
+
   m_is_initialized = false;
   for (const PhysicalMemoryRegion& region : m_physical_regions)
   {
@@ -371,6 +434,8 @@ void MemoryManager::ShutdownFastmemArena()
     m_arena.UnmapFromMemoryRegion(base, region.size);
   }
 
+  UnmapAllPageTableEntries();
+
   for (auto& entry : m_logical_mapped_entries)
   {
     m_arena.UnmapFromMemoryRegion(entry.mapped_pointer, entry.mapped_size);
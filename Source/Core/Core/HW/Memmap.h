@@ -13,6 +13,7 @@
 #include "Common/MemArena.h"
 #include "Common/Swap.h"
 #include "Core/PowerPC/MMU.h"
+#include "Core/StateDelta.h"
 
 // Global declarations
 class PointerWrap;
@@ -100,6 +101,13 @@ public:
 
   void UpdateLogicalMemory(const PowerPC::BatTable& dbat_table);
 
+  // Maps a page of the logical fastmem view that is translated through the page table. Fails if
+  // the translated address isn't RAM or the host can't map memory at page granularity.
+  bool MapPageTableEntry(u32 logical_address, u32 translated_address);
+  // Unmaps the pages mapped by MapPageTableEntry that share the given TLB index
+  void UnmapPageTableEntries(u32 tlb_index);
+  void UnmapAllPageTableEntries();
+
   void Clear();
 
   // Routines to access physically addressed memory, designed for use by
@@ -167,6 +175,11 @@ private:
   u8* m_l1_cache = nullptr;
   u8* m_fake_vmem = nullptr;
 
+  // Bases of the arrays for incremental savestates
+  State::DeltaArray m_ram_delta;
+  State::DeltaArray m_exram_delta;
+  State::DeltaArray m_fake_vmem_delta;
+
   // m_ram_size is the amount allocated by the emulator, whereas m_ram_size_real
   // is what will be reported in lowmem, and thus used by emulated software.
   // Note: Writing to lowmem is done by IPL. If using retail IPL, it will
@@ -223,7 +236,8 @@ private:
   //
   // The 4GB starting at m_logical_base represents access from the CPU
   // with address translation turned on.  This mapping is computed based
-  // on the BAT registers.
+  // on the BAT registers. Pages that are translated through the page table
+  // are mapped individually when a fastmem access to them first faults.
   //
   // Each of these 4GB regions is surrounded by 2GB of empty space so overflows
   // in address computation in the JIT don't access unrelated memory.
@@ -239,6 +253,10 @@ private:
   std::array<PhysicalMemoryRegion, 4> m_physical_regions{};
 
   std::vector<LogicalMemoryView> m_logical_mapped_entries;
+  // Pages mapped through the page table, grouped by the TLB index of their logical address so
+  // that tlbie only has to unmap the pages it can affect
+  std::array<std::vector<LogicalMemoryView>, PowerPC::HW_PAGE_INDEX_MASK + 1>
+      m_page_table_mapped_entries;
 
   std::array<void*, PowerPC::BAT_PAGE_COUNT> m_physical_page_mappings{};
   std::array<void*, PowerPC::BAT_PAGE_COUNT> m_logical_page_mappings{};
@@ -12,10 +12,13 @@
 #include <array>
 #include <cstdio>
 #include <cstring>
+#include <deque>
+#include <future>
 #include <mbedtls/md5.h>
 #include <memory>
 #include <optional>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -486,7 +489,17 @@ StoragePointer MakeDataBinStorage(IOS::HLE::IOSC* iosc, const std::string& path,
   return StoragePointer{new DataBinStorage{iosc, path, mode}};
 }
 
-CopyResult Copy(Storage* source, Storage* dest)
+namespace
+{
+struct SaveContents
+{
+  Header header;
+  BkHeader bk_header;
+  std::vector<Storage::SaveFile> files;
+};
+}  // namespace
+
+static CopyResult ReadSave(Storage* source, SaveContents* contents)
 {
   // first make sure we can read all the data from the source
   const auto header = source->ReadHeader();
@@ -503,13 +516,21 @@ CopyResult Copy(Storage* source, Storage* dest)
     return CopyResult::CorruptedSource;
   }
 
-  const auto files = source->ReadFiles();
+  auto files = source->ReadFiles();
   if (!files)
   {
     ERROR_LOG_FMT(CORE, "WiiSave::Copy: Failed to read files");
     return CopyResult::CorruptedSource;
   }
 
+  contents->header = *header;
+  contents->bk_header = *bk_header;
+  contents->files = std::move(*files);
+  return CopyResult::Success;
+}
+
+static CopyResult WriteSave(Storage* dest, const SaveContents& contents)
+{
   // once we have confirmed we can read the source, erase corresponding save in the destination
   if (dest->SaveExists())
   {
@@ -521,19 +542,19 @@ CopyResult Copy(Storage* source, Storage* dest)
   }
 
   // and then write it to the destination
-  if (!dest->WriteHeader(*header))
+  if (!dest->WriteHeader(contents.header))
   {
     ERROR_LOG_FMT(CORE, "WiiSave::Copy: Failed to write header");
     return CopyResult::Error;
   }
 
-  if (!dest->WriteBkHeader(*bk_header))
+  if (!dest->WriteBkHeader(contents.bk_header))
   {
     ERROR_LOG_FMT(CORE, "WiiSave::Copy: Failed to write bk header");
     return CopyResult::Error;
   }
 
-  if (!dest->WriteFiles(*files))
+  if (!dest->WriteFiles(contents.files))
   {
     ERROR_LOG_FMT(CORE, "WiiSave::Copy: Failed to write files");
     return CopyResult::Error;
@@ -542,6 +563,15 @@ CopyResult Copy(Storage* source, Storage* dest)
   return CopyResult::Success;
 }
 
+CopyResult Copy(Storage* source, Storage* dest)
+{
+  SaveContents contents;
+  const CopyResult result = ReadSave(source, &contents);
+  if (result != CopyResult::Success)
+    return result;
+  return WriteSave(dest, contents);
+}
+
 CopyResult Import(const std::string& data_bin_path, std::function<bool()> can_overwrite)
 {
   IOS::HLE::Kernel ios;
@@ -566,30 +596,81 @@ CopyResult Import(const std::string& data_bin_path, std::function<bool()> can_ov
   return Copy(data_bin.get(), nand.get());
 }
 
-static CopyResult Export(u64 tid, std::string_view export_path, IOS::HLE::Kernel* ios)
+static std::string GetExportPath(u64 tid, std::string_view export_path)
 {
-  const std::string path = fmt::format("{}/private/wii/title/{}{}{}{}/data.bin", export_path,
-                                       static_cast<char>(tid >> 24), static_cast<char>(tid >> 16),
-                                       static_cast<char>(tid >> 8), static_cast<char>(tid));
-  return Copy(MakeNandStorage(ios->GetFS().get(), tid).get(),
-              MakeDataBinStorage(&ios->GetIOSC(), path, "w+b").get());
+  return fmt::format("{}/private/wii/title/{}{}{}{}/data.bin", export_path,
+                     static_cast<char>(tid >> 24), static_cast<char>(tid >> 16),
+                     static_cast<char>(tid >> 8), static_cast<char>(tid));
 }
 
 CopyResult Export(u64 tid, std::string_view export_path)
 {
   IOS::HLE::Kernel ios;
-  return Export(tid, export_path, &ios);
+  return Copy(MakeNandStorage(ios.GetFS().get(), tid).get(),
+              MakeDataBinStorage(&ios.GetIOSC(), GetExportPath(tid, export_path), "w+b").get());
 }
 
-size_t ExportAll(std::string_view export_path)
+size_t ExportAll(std::string_view export_path,
+                 const std::function<bool(size_t exported, size_t total)>& update_progress)
 {
   IOS::HLE::Kernel ios;
+  const std::vector<u64> titles = ios.GetESCore().GetInstalledTitles();
+
+  // The NAND is only accessed from this thread. Encrypting, signing and writing each data.bin
+  // happens on other threads, with at most this many saves held in memory at a time.
+  const size_t max_pending = std::max(std::thread::hardware_concurrency(), 1u);
+  std::deque<std::future<CopyResult>> pending;
+  size_t finished_count = 0;
   size_t exported_save_count = 0;
-  for (const u64 title : ios.GetESCore().GetInstalledTitles())
-  {
-    if (Export(title, export_path, &ios) == CopyResult::Success)
+  const auto finish_oldest = [&] {
+    if (pending.front().get() == CopyResult::Success)
       ++exported_save_count;
+    pending.pop_front();
+    ++finished_count;
+  };
+
+  for (const u64 title : titles)
+  {
+    if (update_progress && !update_progress(finished_count, titles.size()))
+      break;
+
+    auto contents = std::make_shared<SaveContents>();
+    if (ReadSave(MakeNandStorage(ios.GetFS().get(), title).get(), contents.get()) !=
+        CopyResult::Success)
+    {
+      ++finished_count;
+      continue;
+    }
+
+    // Read the file data now, the NAND can't be used from the writer threads
+    bool read_all_files = true;
+    for (const Storage::SaveFile& file : contents->files)
+    {
+      if (file.type == Storage::SaveFile::Type::File && !*file.data)
+        read_all_files = false;
+    }
+    if (!read_all_files)
+    {
+      ERROR_LOG_FMT(CORE, "WiiSave::ExportAll: Failed to read files of title {:016x}", title);
+      ++finished_count;
+      continue;
+    }
+
+    if (pending.size() == max_pending)
+      finish_oldest();
+
+    pending.push_back(std::async(std::launch::async, [&ios, contents, title, export_path] {
+      return WriteSave(
+          MakeDataBinStorage(&ios.GetIOSC(), GetExportPath(title, export_path), "w+b").get(),
+          *contents);
+    }));
   }
+
+  while (!pending.empty())
+    finish_oldest();
+  if (update_progress)
+    update_progress(finished_count, titles.size());
+
   return exported_save_count;
 }
 }  // namespace WiiSave
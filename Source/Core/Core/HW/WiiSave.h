@@ -48,5 +48,8 @@ CopyResult Import(const std::string& data_bin_path, std::function<bool()> can_ov
 /// Export a save to a .bin file.
 CopyResult Export(u64 tid, std::string_view export_path);
 /// Export all saves that are in the NAND. Returns the number of exported saves.
-size_t ExportAll(std::string_view export_path);
+/// update_progress is called with the number of titles that were handled so far and the number
+/// of installed titles. Returning false from it stops the export after the saves in flight.
+size_t ExportAll(std::string_view export_path,
+                 const std::function<bool(size_t exported, size_t total)>& update_progress = {});
 }  // namespace WiiSave
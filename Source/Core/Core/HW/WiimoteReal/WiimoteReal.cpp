@@ -4,6 +4,7 @@
 #include "Core/HW/WiimoteReal/WiimoteReal.h"
 
 #include <algorithm>
+#include <chrono>
 #include <cstdlib>
 #include <mutex>
 #include <queue>
@@ -311,10 +312,26 @@ void Wiimote::Read()
 
   // Drop the report if not connected.
   if (!m_is_linked)
+  {
+    m_have_last_report = false;
     return;
+  }
 
   if (result > 0)
   {
+    const auto now = std::chrono::steady_clock::now();
+    if (m_have_last_report)
+    {
+      const auto& limits = ReportLatencyHistogram::BUCKET_LIMITS_MS;
+      const auto latency =
+          std::chrono::duration_cast<std::chrono::milliseconds>(now - m_last_report_time).count();
+      const auto bucket = std::find_if(limits.begin(), limits.end(),
+                                       [&](u32 limit) { return latency < s64(limit); });
+      m_latency_counts[bucket - limits.begin()].fetch_add(1, std::memory_order_relaxed);
+    }
+    m_last_report_time = now;
+    m_have_last_report = true;
+
     if (m_balance_board_dump_port > 0 && m_index == WIIMOTE_BALANCE_BOARD)
     {
       static sf::UdpSocket Socket;
@@ -734,28 +751,36 @@ void WiimoteScanner::ThreadFunc()
       std::vector<Wiimote*> found_wiimotes;
       Wiimote* found_board = nullptr;
       backend->FindWiimotes(found_wiimotes, found_board);
-      {
-        std::unique_lock wm_lk(g_wiimotes_mutex);
 
-        for (auto* wiimote : found_wiimotes)
+      // Connecting takes a while, so it happens without holding g_wiimotes_mutex. That keeps the
+      // connected remotes and their slots usable while new ones are set up.
+      for (auto* wiimote : found_wiimotes)
+      {
         {
-          {
-            std::lock_guard lk(s_known_ids_mutex);
-            s_known_ids.insert(wiimote->GetId());
-          }
-
-          AddWiimoteToPool(std::unique_ptr<Wiimote>(wiimote));
-          g_controller_interface.PlatformPopulateDevices([] { ProcessWiimotePool(); });
+          std::lock_guard lk(s_known_ids_mutex);
+          s_known_ids.insert(wiimote->GetId());
         }
 
-        if (found_board)
+        AddWiimoteToPool(std::unique_ptr<Wiimote>(wiimote));
+        g_controller_interface.PlatformPopulateDevices([] { ProcessWiimotePool(); });
+      }
+
+      if (found_board)
+      {
         {
-          {
-            std::lock_guard lk(s_known_ids_mutex);
-            s_known_ids.insert(found_board->GetId());
-          }
+          std::lock_guard lk(s_known_ids_mutex);
+          s_known_ids.insert(found_board->GetId());
+        }
 
-          TryToConnectBalanceBoard(std::unique_ptr<Wiimote>(found_board));
+        std::unique_ptr<Wiimote> board(found_board);
+        if (board->Connect(WIIMOTE_BALANCE_BOARD))
+        {
+          std::lock_guard wm_lk(g_wiimotes_mutex);
+          TryToConnectBalanceBoard(std::move(board));
+        }
+        else
+        {
+          ERROR_LOG_FMT(WIIMOTE, "Failed to connect real balance board.");
         }
       }
     }
@@ -854,6 +879,22 @@ int Wiimote::GetIndex() const
   return m_index;
 }
 
+ReportLatencyHistogram Wiimote::GetReportLatencyHistogram() const
+{
+  ReportLatencyHistogram histogram;
+  for (size_t i = 0; i < histogram.counts.size(); ++i)
+    histogram.counts[i] = m_latency_counts[i].load(std::memory_order_relaxed);
+  return histogram;
+}
+
+std::optional<ReportLatencyHistogram> GetReportLatencyHistogram(unsigned int index)
+{
+  std::lock_guard lk(g_wiimotes_mutex);
+  if (!g_wiimotes[index] || !g_wiimotes[index]->IsConnected())
+    return std::nullopt;
+  return g_wiimotes[index]->GetReportLatencyHistogram();
+}
+
 // config dialog calls this when some settings change
 void Initialize(::Wiimote::InitializeMode init_mode)
 {
@@ -3,8 +3,11 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
+#include <chrono>
 #include <memory>
+#include <optional>
 #include <mutex>
 #include <string>
 #include <thread>
@@ -32,6 +35,16 @@ constexpr int REPORT_HID_HEADER_SIZE = 1;
 
 constexpr u32 WIIMOTE_DEFAULT_TIMEOUT = 1000;
 
+// How long the I/O thread of a Wii Remote waited between two input reports. Remotes report every
+// 5 ms in continuous mode, so the higher buckets show stalls of the connection.
+struct ReportLatencyHistogram
+{
+  // Upper bounds of the buckets in milliseconds, the last bucket has no upper bound
+  static constexpr std::array<u32, 5> BUCKET_LIMITS_MS = {6, 12, 25, 50, 100};
+
+  std::array<u64, BUCKET_LIMITS_MS.size() + 1> counts{};
+};
+
 // The 4 most significant bits of the first byte of an outgoing command must be
 // 0x50 if sending on the command channel and 0xA0 if sending on the interrupt
 // channel. On Mac and Linux we use interrupt channel; on Windows, command.
@@ -93,6 +106,8 @@ public:
 
   int GetIndex() const;
 
+  ReportLatencyHistogram GetReportLatencyHistogram() const;
+
 protected:
   Wiimote();
 
@@ -155,6 +170,12 @@ private:
   Common::SPSCQueue<Report> m_read_reports;
   Common::SPSCQueue<Report> m_write_reports;
 
+  // Written by the I/O thread only
+  std::chrono::steady_clock::time_point m_last_report_time;
+  bool m_have_last_report = false;
+  std::array<std::atomic<u64>, ReportLatencyHistogram::BUCKET_LIMITS_MS.size() + 1>
+      m_latency_counts{};
+
   bool m_speaker_enabled_in_dolphin_config = false;
   int m_balance_board_dump_port = 0;
 
@@ -211,6 +232,9 @@ extern std::unique_ptr<Wiimote> g_wiimotes[MAX_BBMOTES];
 
 void AddWiimoteToPool(std::unique_ptr<Wiimote>);
 
+// Returns nothing if no real Wii Remote is connected to the slot.
+std::optional<ReportLatencyHistogram> GetReportLatencyHistogram(unsigned int index);
+
 bool IsValidDeviceName(const std::string& name);
 bool IsBalanceBoardName(const std::string& name);
 bool IsNewWiimote(const std::string& identifier);
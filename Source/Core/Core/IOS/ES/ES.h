@@ -191,6 +191,9 @@ private:
   // Finish stale imports and clear the import directory.
   void FinishStaleImport(u64 title_id);
   void FinishAllStaleImports();
+  // Decrypt the content that is being imported and check it against its hash.
+  ReturnCode DecryptAndHashContent(const Context& context, const ES::Content& info,
+                                   std::vector<u8>* decrypted_data) const;
 
   std::string GetContentPath(u64 title_id, const ES::Content& content, Ticks ticks = {}) const;
 
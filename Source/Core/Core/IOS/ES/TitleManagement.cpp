@@ -4,7 +4,12 @@
 #include "Core/IOS/ES/ES.h"
 
 #include <algorithm>
+#include <array>
 #include <cstddef>
+#include <future>
+#include <optional>
+#include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -374,16 +379,70 @@ IPCReply ESDevice::ImportContentData(Context& context, const IOCtlVRequest& requ
       m_core.ImportContentData(context, content_fd, data_start, request.in_vectors[1].size));
 }
 
-static bool CheckIfContentHashMatches(const std::vector<u8>& content, const ES::Content& info)
-{
-  return Common::SHA1::CalculateDigest(content.data(), info.size) == info.sha1;
-}
+// Contents are decrypted on several threads, in ranges of at least this many bytes. Hashing the
+// ranges that are decrypted already overlaps with decrypting the ones after them.
+constexpr size_t MIN_DECRYPTION_RANGE_SIZE = 0x100000;
 
 static std::string GetImportContentPath(u64 title_id, u32 content_id)
 {
   return fmt::format("{}/content/{:08x}.app", Common::GetImportTitlePath(title_id), content_id);
 }
 
+ReturnCode ESCore::DecryptAndHashContent(const Context& context, const ES::Content& info,
+                                         std::vector<u8>* decrypted_data) const
+{
+  const std::vector<u8>& encrypted_data = context.title_import_export.content.buffer;
+  if (encrypted_data.size() < info.size)
+    return ES_HASH_MISMATCH;
+
+  // AES-CBC can be decrypted from any block, with the previous block of ciphertext as the IV
+  constexpr size_t AES_BLOCK_SIZE = 16;
+  const size_t block_count = encrypted_data.size() / AES_BLOCK_SIZE;
+  const size_t min_range_blocks = MIN_DECRYPTION_RANGE_SIZE / AES_BLOCK_SIZE;
+  const size_t range_count = std::clamp<size_t>(block_count / min_range_blocks, 1,
+                                                std::max(std::thread::hardware_concurrency(), 1u));
+  const size_t range_blocks = Common::AlignUp(block_count, range_count) / range_count;
+
+  decrypted_data->resize(encrypted_data.size());
+  const auto decrypt_range = [&](size_t range) {
+    const size_t start = std::min(range * range_blocks, block_count) * AES_BLOCK_SIZE;
+    const size_t end = std::min((range + 1) * range_blocks, block_count) * AES_BLOCK_SIZE;
+    std::array<u8, AES_BLOCK_SIZE> iv = context.title_import_export.content.iv;
+    if (start != 0)
+      std::copy_n(&encrypted_data[start - AES_BLOCK_SIZE], AES_BLOCK_SIZE, iv.begin());
+    return m_ios.GetIOSC().Decrypt(context.title_import_export.key_handle, iv.data(),
+                                   encrypted_data.data() + start, end - start,
+                                   decrypted_data->data() + start, PID_ES);
+  };
+
+  std::vector<std::future<ReturnCode>> futures(range_count);
+  for (size_t range = 1; range < range_count; ++range)
+    futures[range] = std::async(std::launch::async, decrypt_range, range);
+
+  ReturnCode ret = decrypt_range(0);
+  const auto sha1 = Common::SHA1::CreateContext();
+  for (size_t range = 0; range < range_count; ++range)
+  {
+    if (range != 0)
+    {
+      const ReturnCode range_ret = futures[range].get();
+      if (ret == IPC_SUCCESS)
+        ret = range_ret;
+    }
+    if (ret != IPC_SUCCESS)
+      continue;
+
+    // Only the first info.size bytes are part of the content, the rest is padding
+    const size_t start = std::min<size_t>(range * range_blocks * AES_BLOCK_SIZE, info.size);
+    const size_t end = std::min<size_t>((range + 1) * range_blocks * AES_BLOCK_SIZE, info.size);
+    sha1->Update(decrypted_data->data() + start, end - start);
+  }
+
+  if (ret != IPC_SUCCESS)
+    return ret;
+  return sha1->Finish() == info.sha1 ? IPC_SUCCESS : ES_HASH_MISMATCH;
+}
+
 ReturnCode ESCore::ImportContentEnd(Context& context, u32 content_fd)
 {
   INFO_LOG_FMT(IOS_ES, "ImportContentEnd: content fd {:08x}", content_fd);
@@ -391,25 +450,43 @@ ReturnCode ESCore::ImportContentEnd(Context& context, u32 content_fd)
   if (!context.title_import_export.valid || !context.title_import_export.content.valid)
     return ES_EINVAL;
 
-  std::vector<u8> decrypted_data(context.title_import_export.content.buffer.size());
-  const ReturnCode decrypt_ret = m_ios.GetIOSC().Decrypt(
-      context.title_import_export.key_handle, context.title_import_export.content.iv.data(),
-      context.title_import_export.content.buffer.data(),
-      context.title_import_export.content.buffer.size(), decrypted_data.data(), PID_ES);
-  if (decrypt_ret != IPC_SUCCESS)
-    return decrypt_ret;
-
   ES::Content content_info;
   context.title_import_export.tmd.FindContentById(context.title_import_export.content.id,
                                                   &content_info);
-  if (!CheckIfContentHashMatches(decrypted_data, content_info))
+
+  const auto fs = m_ios.GetFS();
+  if (content_info.IsShared())
+  {
+    // Shared contents are stored by their hash, so a content that is already stored (because the
+    // title is installed again, or another title uses it too) doesn't need to be written again.
+    const ES::SharedContentMap shared_content{m_ios.GetFSCore()};
+    const std::optional<std::string> stored_path =
+        shared_content.GetFilenameFromSHA1(content_info.sha1);
+    const auto is_stored = [&] {
+      if (!stored_path)
+        return false;
+      const auto metadata = fs->GetMetadata(PID_KERNEL, PID_KERNEL, *stored_path);
+      return metadata && metadata->is_file && metadata->size == content_info.size;
+    };
+    if (is_stored())
+    {
+      INFO_LOG_FMT(IOS_ES, "ImportContentEnd: Shared content {:08x} is stored already at {}",
+                   content_info.id, *stored_path);
+      context.title_import_export.content = {};
+      return IPC_SUCCESS;
+    }
+  }
+
+  std::vector<u8> decrypted_data;
+  const ReturnCode decrypt_ret = DecryptAndHashContent(context, content_info, &decrypted_data);
+  if (decrypt_ret == ES_HASH_MISMATCH)
   {
     ERROR_LOG_FMT(IOS_ES, "ImportContentEnd: Hash for content {:08x} doesn't match",
                   content_info.id);
-    return ES_HASH_MISMATCH;
   }
+  if (decrypt_ret != IPC_SUCCESS)
+    return decrypt_ret;
 
-  const auto fs = m_ios.GetFS();
   std::string content_path;
   if (content_info.IsShared())
   {
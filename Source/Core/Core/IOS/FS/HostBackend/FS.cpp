@@ -28,6 +28,8 @@
 namespace IOS::HLE::FS
 {
 constexpr u32 BUFFER_CHUNK_SIZE = 65536;
+// How many changes the FST journal holds before the whole FST gets written
+constexpr size_t MAX_FST_JOURNAL_RECORDS = 256;
 
 HostFileSystem::HostFilename HostFileSystem::BuildFilename(const std::string& wii_path) const
 {
@@ -90,6 +92,22 @@ auto GetNamePredicate(const std::string& name)
   return [&name](const auto& entry) { return entry.name == name; };
 }
 
+// Paths are at most 64 characters, so a byte is enough for the size
+void AppendJournalString(std::vector<u8>* record, const std::string& str)
+{
+  record->push_back(static_cast<u8>(str.size()));
+  record->insert(record->end(), str.begin(), str.end());
+}
+
+bool ReadJournalString(File::IOFile& file, std::string* str)
+{
+  u8 size;
+  if (!file.ReadArray(&size, 1))
+    return false;
+  str->resize(size);
+  return file.ReadBytes(str->data(), size);
+}
+
 // Convert the host directory entries into ones that can be exposed to the emulated system.
 static u64 FixupDirectoryEntries(File::FSTEntry* dir, bool is_root)
 {
@@ -152,15 +170,24 @@ HostFileSystem::HostFileSystem(const std::string& root_path,
   File::CreateFullPath(m_root_path + '/');
   ResetFst();
   LoadFst();
+  ReplayFstJournal();
 }
 
-HostFileSystem::~HostFileSystem() = default;
+HostFileSystem::~HostFileSystem()
+{
+  FlushFst();
+}
 
 std::string HostFileSystem::GetFstFilePath() const
 {
   return fmt::format("{}/fst.bin", m_root_path);
 }
 
+std::string HostFileSystem::GetFstJournalPath() const
+{
+  return fmt::format("{}/fst.journal", m_root_path);
+}
+
 void HostFileSystem::ResetFst()
 {
   m_root_entry = {};
@@ -232,7 +259,179 @@ void HostFileSystem::SaveFst()
     }
   }
   if (!File::Rename(temp_path, dest_path))
+  {
     PanicAlertFmt("IOS_FS: Failed to rename temporary FST file");
+    return;
+  }
+
+  if (m_fst_journal.IsOpen() || m_fst_journal_records != 0)
+  {
+    m_fst_journal.Close();
+    File::Delete(GetFstJournalPath());
+    m_fst_journal_records = 0;
+  }
+}
+
+void HostFileSystem::FlushFst()
+{
+  if (m_fst_journal_records != 0)
+    SaveFst();
+}
+
+void HostFileSystem::JournalFstChange(JournalOp op, const std::string& path, const Metadata& data,
+                                      const std::string& new_path)
+{
+  // Only the FST of the NAND is saved. Changes that involve redirects are rare, so just write the
+  // FST like before instead of having to tell the two FSTs apart when replaying.
+  if (BuildFilename(path).is_redirect ||
+      (op == JournalOp::Rename && BuildFilename(new_path).is_redirect))
+  {
+    SaveFst();
+    return;
+  }
+
+  std::vector<u8> record;
+  record.push_back(static_cast<u8>(op));
+  AppendJournalString(&record, path);
+  if (op == JournalOp::Rename)
+    AppendJournalString(&record, new_path);
+  if (op == JournalOp::Create || op == JournalOp::SetMetadata)
+  {
+    SerializedFstEntry serialized;
+    GetMetadataFields(serialized) = GetMetadataFields(data);
+    const u8* bytes = reinterpret_cast<const u8*>(&serialized);
+    record.insert(record.end(), bytes, bytes + sizeof(serialized));
+  }
+
+  if (!m_fst_journal.IsOpen())
+    m_fst_journal.Open(GetFstJournalPath(), "ab");
+
+  // Flushing hands the record to the host OS, so that it survives Dolphin crashing. Unlike
+  // writing the FST, this doesn't create, rename or sync any files.
+  if (!m_fst_journal.WriteBytes(record.data(), record.size()) || !m_fst_journal.Flush())
+  {
+    ERROR_LOG_FMT(IOS_FS, "Failed to write to the FST journal");
+    SaveFst();
+    return;
+  }
+
+  if (++m_fst_journal_records >= MAX_FST_JOURNAL_RECORDS)
+    SaveFst();
+}
+
+void HostFileSystem::ReplayFstJournal()
+{
+  const std::string journal_path = GetFstJournalPath();
+  File::IOFile file{journal_path, "rb"};
+  if (!file)
+    return;
+
+  // Like GetFstEntryForPath, but only looks at the FST, as the host files already are in the state
+  // after all the changes.
+  const auto find_entry = [this](const std::string& path, bool create) -> FstEntry* {
+    FstEntry* entry = &m_root_entry;
+    if (path == "/")
+      return entry;
+    for (const std::string& component : SplitString(path.substr(1), '/'))
+    {
+      const auto next =
+          std::find_if(entry->children.begin(), entry->children.end(), GetNamePredicate(component));
+      if (next != entry->children.end())
+      {
+        entry = &*next;
+      }
+      else
+      {
+        if (!create)
+          return nullptr;
+        entry = &entry->children.emplace_back();
+        entry->name = component;
+        entry->data.modes = {Mode::ReadWrite, Mode::ReadWrite, Mode::ReadWrite};
+      }
+    }
+    return entry;
+  };
+
+  // Replaying a change again has no effect, so it doesn't matter whether Dolphin crashed before or
+  // after writing the FST. A record that was cut off by a crash ends the journal.
+  size_t records = 0;
+  while (true)
+  {
+    u8 op;
+    std::string path;
+    std::string new_path;
+    SerializedFstEntry serialized;
+    if (!file.ReadArray(&op, 1) || !ReadJournalString(file, &path) || !IsValidNonRootPath(path))
+      break;
+    if (op == static_cast<u8>(JournalOp::Rename) &&
+        (!ReadJournalString(file, &new_path) || !IsValidNonRootPath(new_path)))
+    {
+      break;
+    }
+    if ((op == static_cast<u8>(JournalOp::Create) ||
+         op == static_cast<u8>(JournalOp::SetMetadata)) &&
+        !file.ReadArray(&serialized, 1))
+    {
+      break;
+    }
+
+    const auto split_path = SplitPathAndBasename(path);
+    if (op == static_cast<u8>(JournalOp::Create))
+    {
+      FstEntry* entry = find_entry(path, true);
+      *entry = {};
+      entry->name = split_path.file_name;
+      GetMetadataFields(entry->data) = GetMetadataFields(serialized);
+    }
+    else if (op == static_cast<u8>(JournalOp::SetMetadata))
+    {
+      GetMetadataFields(find_entry(path, true)->data) = GetMetadataFields(serialized);
+    }
+    else if (op == static_cast<u8>(JournalOp::Delete))
+    {
+      FstEntry* parent = find_entry(split_path.parent, false);
+      if (parent)
+      {
+        const auto it = std::find_if(parent->children.begin(), parent->children.end(),
+                                     GetNamePredicate(split_path.file_name));
+        if (it != parent->children.end())
+          parent->children.erase(it);
+      }
+    }
+    else if (op == static_cast<u8>(JournalOp::Rename))
+    {
+      FstEntry* new_entry = find_entry(new_path, true);
+      new_entry->name = SplitPathAndBasename(new_path).file_name;
+
+      // Look up the old parent afterwards, creating the new entry may move the entries
+      FstEntry* old_parent = find_entry(split_path.parent, false);
+      if (old_parent)
+      {
+        const auto it = std::find_if(old_parent->children.begin(), old_parent->children.end(),
+                                     GetNamePredicate(split_path.file_name));
+        if (it != old_parent->children.end())
+        {
+          new_entry->data = it->data;
+          new_entry->children = it->children;
+          old_parent->children.erase(it);
+        }
+      }
+    }
+    else
+    {
+      break;
+    }
+
+    ++records;
+  }
+  file.Close();
+
+  INFO_LOG_FMT(IOS_FS, "Replayed {} changes from the FST journal", records);
+  m_fst_journal_records = records;
+  if (records != 0)
+    SaveFst();
+  else
+    File::Delete(journal_path);
 }
 
 HostFileSystem::FstEntry* HostFileSystem::GetFstEntryForPath(const std::string& path)
@@ -372,6 +571,9 @@ void HostFileSystem::DoStateWriteOrMeasure(PointerWrap& p, std::string start_dir
 
 void HostFileSystem::DoState(PointerWrap& p)
 {
+  // Save states are where the FST gets written
+  FlushFst();
+
   // Temporarily close the file, to prevent any issues with the savestating of files/folders.
   for (Handle& handle : m_handles)
     handle.host_file.reset();
@@ -496,7 +698,7 @@ ResultCode HostFileSystem::CreateFileOrDirectory(Uid uid, Gid gid, const std::st
   child->data.uid = uid;
   child->data.gid = gid;
   child->data.attribute = attr;
-  SaveFst();
+  JournalFstChange(JournalOp::Create, path, child->data);
   return ResultCode::Success;
 }
 
@@ -555,7 +757,7 @@ ResultCode HostFileSystem::Delete(Uid uid, Gid gid, const std::string& path)
                                GetNamePredicate(split_path.file_name));
   if (it != parent->children.end())
     parent->children.erase(it);
-  SaveFst();
+  JournalFstChange(JournalOp::Delete, path);
 
   return ResultCode::Success;
 }
@@ -651,7 +853,7 @@ ResultCode HostFileSystem::Rename(Uid uid, Gid gid, const std::string& old_path,
     old_parent->children.erase(it);
   }
 
-  SaveFst();
+  JournalFstChange(JournalOp::Rename, old_path, {}, new_path);
 
   return ResultCode::Success;
 }
@@ -765,7 +967,7 @@ ResultCode HostFileSystem::SetMetadata(Uid caller_uid, const std::string& path,
     entry->data.uid = uid;
     entry->data.attribute = attr;
     entry->data.modes = modes;
-    SaveFst();
+    JournalFstChange(JournalOp::SetMetadata, path, entry->data);
   }
 
   return ResultCode::Success;
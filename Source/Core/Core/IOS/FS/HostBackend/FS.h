@@ -101,10 +101,29 @@ private:
   bool IsFileOpened(const std::string& path) const;
   bool IsDirectoryInUse(const std::string& path) const;
 
+  /// Changes to the FST that are recorded in the journal.
+  enum class JournalOp : u8
+  {
+    Create,
+    SetMetadata,
+    Delete,
+    Rename,
+  };
+
   std::string GetFstFilePath() const;
+  std::string GetFstJournalPath() const;
   void ResetFst();
   void LoadFst();
+  /// Writes the whole FST, which makes the journal obsolete.
   void SaveFst();
+  /// Writes the FST if there are changes that are only in the journal.
+  void FlushFst();
+  /// Appends a change to the journal instead of writing the whole FST for it. The FST is only
+  /// written at save states, at shutdown and when the journal gets long; if Dolphin crashes before
+  /// that, the journal is replayed on top of the FST the next time it's loaded.
+  void JournalFstChange(JournalOp op, const std::string& path, const Metadata& data = {},
+                        const std::string& new_path = {});
+  void ReplayFstJournal();
   /// Get the FST entry for a file (or directory).
   /// Automatically creates fallback entries for parents if they do not exist.
   /// Returns nullptr if the path is invalid or the file does not exist.
@@ -120,6 +139,8 @@ private:
   /// filesystem root manually.
   FstEntry m_root_entry{};
   std::string m_root_path;
+  File::IOFile m_fst_journal;
+  size_t m_fst_journal_records = 0;
   std::map<std::string, std::weak_ptr<File::IOFile>> m_open_files;
   std::array<Handle, 16> m_handles{};
 
@@ -961,6 +961,9 @@ void Init()
   DIDevice::s_finish_executing_di_command =
       core_timing.RegisterEvent("FinishDICommand", DIDevice::FinishDICommandCallback);
 
+  SDIOSlot0Device::s_finish_read =
+      core_timing.RegisterEvent("FinishSDRead", SDIOSlot0Device::FinishReadCallback);
+
   // Start with IOS80 to simulate part of the Wii boot process.
   s_ios = std::make_unique<EmulationKernel>(system, Titles::SYSTEM_MENU_IOS);
   // On a Wii, boot2 launches the system menu IOS, which then launches the system menu
@@ -5,7 +5,9 @@
 
 #include <array>
 #include <cstring>
+#include <map>
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include <mbedtls/md.h>
@@ -86,8 +88,52 @@ int SSLRecv(void* ctx, unsigned char* buf, size_t len)
 
   return ret;
 }
+
+class CachedSession
+{
+public:
+  CachedSession() { mbedtls_ssl_session_init(&m_session); }
+  ~CachedSession() { mbedtls_ssl_session_free(&m_session); }
+  CachedSession(const CachedSession&) = delete;
+  CachedSession& operator=(const CachedSession&) = delete;
+
+  mbedtls_ssl_session* Get() { return &m_session; }
+
+private:
+  mbedtls_ssl_session m_session;
+};
+
+constexpr size_t MAX_CACHED_SESSIONS = 32;
+
+// Keyed by the host name and the verification mode, so that a session whose certificate wasn't
+// verified is never resumed by a connection that requires verification
+using SessionKey = std::pair<std::string, int>;
+std::map<SessionKey, std::unique_ptr<CachedSession>> s_session_cache;
+
+SessionKey GetSessionKey(const WII_SSL& ssl)
+{
+  return {ssl.hostname, ssl.config.authmode};
+}
+
+void WaitForHandshake(WII_SSL* ssl)
+{
+  if (ssl->handshake.valid())
+    ssl->handshake.wait();
+  ssl->handshake = {};
+}
 }  // namespace
 
+void NetSSLDevice::CacheSession(const WII_SSL& ssl)
+{
+  auto session = std::make_unique<CachedSession>();
+  if (mbedtls_ssl_get_session(&ssl.ctx, session->Get()) != 0)
+    return;
+
+  if (s_session_cache.size() >= MAX_CACHED_SESSIONS)
+    s_session_cache.erase(s_session_cache.begin());
+  s_session_cache.insert_or_assign(GetSessionKey(ssl), std::move(session));
+}
+
 NetSSLDevice::NetSSLDevice(EmulationKernel& ios, const std::string& device_name)
     : EmulationDevice(ios, device_name)
 {
@@ -104,6 +150,7 @@ NetSSLDevice::~NetSSLDevice()
   {
     if (ssl.active)
     {
+      WaitForHandshake(&ssl);
       mbedtls_ssl_close_notify(&ssl.ctx);
 
       mbedtls_x509_crt_free(&ssl.cacert);
@@ -278,6 +325,7 @@ std::optional<IPCReply> NetSSLDevice::IOCtlV(const IOCtlVRequest& request)
       else
         mbedtls_ssl_conf_authmode(&ssl->config, MBEDTLS_SSL_VERIFY_NONE);
       mbedtls_ssl_conf_renegotiation(&ssl->config, MBEDTLS_SSL_RENEGOTIATION_ENABLED);
+      mbedtls_ssl_conf_session_tickets(&ssl->config, MBEDTLS_SSL_SESSION_TICKETS_ENABLED);
 
       ssl->hostname = hostname;
       ssl->active = true;
@@ -306,6 +354,7 @@ std::optional<IPCReply> NetSSLDevice::IOCtlV(const IOCtlVRequest& request)
     {
       WII_SSL* ssl = &_SSL[sslID];
 
+      WaitForHandshake(ssl);
       mbedtls_ssl_close_notify(&ssl->ctx);
 
       mbedtls_x509_crt_free(&ssl->cacert);
@@ -500,6 +549,13 @@ std::optional<IPCReply> NetSSLDevice::IOCtlV(const IOCtlVRequest& request)
       ssl->hostfd = GetEmulationKernel().GetSocketManager()->GetHostSocket(ssl->sockfd);
       INFO_LOG_FMT(IOS_SSL, "IOCTLV_NET_SSL_CONNECT socket = {}", ssl->sockfd);
       mbedtls_ssl_set_bio(&ssl->ctx, ssl, SSLSendWithoutSNI, SSLRecv, nullptr);
+
+      const auto cached_session = s_session_cache.find(GetSessionKey(*ssl));
+      if (cached_session != s_session_cache.end() &&
+          mbedtls_ssl_set_session(&ssl->ctx, cached_session->second->Get()) == 0)
+      {
+        INFO_LOG_FMT(IOS_SSL, "IOCTLV_NET_SSL_CONNECT resuming session with {}", ssl->hostname);
+      }
       WriteReturnValue(SSL_OK, BufferIn);
     }
     else
@@ -13,6 +13,7 @@
 #include <mbedtls/platform.h>
 #include <mbedtls/ssl.h>
 #include <mbedtls/x509_crt.h>
+#include <future>
 #include <string>
 
 // clang-format on
@@ -77,6 +78,9 @@ struct WII_SSL
   int hostfd = -1;
   std::string hostname;
   bool active = false;
+  // The handshake step that is running on another thread, if any. Nothing else may use ctx
+  // until it is done.
+  std::future<int> handshake;
 };
 
 class NetSSLDevice : public EmulationDevice
@@ -91,6 +95,10 @@ public:
 
   int GetSSLFreeID() const;
 
+  // Remembers the session of a finished handshake, so that the next connection to the same
+  // server can resume it instead of doing a full handshake.
+  static void CacheSession(const WII_SSL& ssl);
+
   static WII_SSL _SSL[NET_SSL_MAXINSTANCES];
 
 private:
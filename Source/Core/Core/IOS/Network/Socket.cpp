@@ -5,6 +5,8 @@
 #include "Core/IOS/Network/Socket.h"
 
 #include <algorithm>
+#include <chrono>
+#include <future>
 #include <numeric>
 
 #include <mbedtls/error.h>
@@ -409,8 +411,24 @@ void WiiSocket::Update(bool read, bool write, bool except)
               break;
             }
 
-            mbedtls_ssl_context* ctx = &NetSSLDevice::_SSL[sslID].ctx;
-            const int ret = mbedtls_ssl_handshake(ctx);
+            // The steps of a handshake can take a lot of CPU time, so they run on another
+            // thread. Until the running step is done, the guest is asked to try again.
+            WII_SSL* ssl = &NetSSLDevice::_SSL[sslID];
+            mbedtls_ssl_context* ctx = &ssl->ctx;
+            if (!ssl->handshake.valid())
+            {
+              ssl->handshake =
+                  std::async(std::launch::async, [ctx] { return mbedtls_ssl_handshake(ctx); });
+            }
+            if (ssl->handshake.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+            {
+              WriteReturnValue(SSL_ERR_RAGAIN, BufferIn);
+              if (!nonBlock)
+                ReturnValue = SSL_ERR_RAGAIN;
+              break;
+            }
+
+            const int ret = ssl->handshake.get();
             if (ret != 0)
             {
               char error_buffer[256] = "";
@@ -421,6 +439,7 @@ void WiiSocket::Update(bool read, bool write, bool except)
             {
             case 0:
               WriteReturnValue(SSL_OK, BufferIn);
+              NetSSLDevice::CacheSession(*ssl);
               break;
             case MBEDTLS_ERR_SSL_WANT_READ:
               WriteReturnValue(SSL_ERR_RAGAIN, BufferIn);
@@ -487,6 +506,13 @@ void WiiSocket::Update(bool read, bool write, bool except)
           case IOCTLV_NET_SSL_WRITE:
           {
             WII_SSL* ssl = &NetSSLDevice::_SSL[sslID];
+            if (ssl->handshake.valid())
+            {
+              WriteReturnValue(SSL_ERR_RAGAIN, BufferIn);
+              if (!nonBlock)
+                ReturnValue = SSL_ERR_RAGAIN;
+              break;
+            }
             const int ret =
                 mbedtls_ssl_write(&ssl->ctx, memory.GetPointer(BufferOut2), BufferOutSize2);
 
@@ -521,6 +547,13 @@ void WiiSocket::Update(bool read, bool write, bool except)
           case IOCTLV_NET_SSL_READ:
           {
             WII_SSL* ssl = &NetSSLDevice::_SSL[sslID];
+            if (ssl->handshake.valid())
+            {
+              WriteReturnValue(SSL_ERR_RAGAIN, BufferIn);
+              if (!nonBlock)
+                ReturnValue = SSL_ERR_RAGAIN;
+              break;
+            }
             const int ret =
                 mbedtls_ssl_read(&ssl->ctx, memory.GetPointer(BufferIn2), BufferInSize2);
 
@@ -970,58 +1003,53 @@ s32 WiiSockMan::DeleteSocket(s32 wii_fd)
   {
     ReturnValue = socket_entry->second.CloseFd();
     WiiSockets.erase(socket_entry);
+    m_active_sockets.erase(wii_fd);
   }
   return ReturnValue;
 }
 
 void WiiSockMan::Update()
 {
-  s32 nfds = 0;
-  fd_set read_fds, write_fds, except_fds;
-  struct timeval t = {0, 0};
-  FD_ZERO(&read_fds);
-  FD_ZERO(&write_fds);
-  FD_ZERO(&except_fds);
+  m_active_poll_fds.clear();
+  m_active_socket_list.clear();
 
-  auto socket_iter = WiiSockets.begin();
-  auto end_socks = WiiSockets.end();
-
-  while (socket_iter != end_socks)
+  for (auto iter = m_active_sockets.begin(); iter != m_active_sockets.end();)
   {
-    const WiiSocket& sock = socket_iter->second;
-    if (sock.IsValid())
+    const auto socket_entry = WiiSockets.find(*iter);
+    if (socket_entry == WiiSockets.end() || socket_entry->second.pending_sockops.empty())
     {
-      FD_SET(sock.fd, &read_fds);
-      FD_SET(sock.fd, &write_fds);
-      FD_SET(sock.fd, &except_fds);
-      nfds = std::max(nfds, sock.fd + 1);
-      ++socket_iter;
+      iter = m_active_sockets.erase(iter);
+      continue;
     }
-    else
+
+    WiiSocket& sock = socket_entry->second;
+    if (!sock.IsValid())
     {
       // Good time to clean up invalid sockets.
-      socket_iter = WiiSockets.erase(socket_iter);
+      WiiSockets.erase(socket_entry);
+      iter = m_active_sockets.erase(iter);
+      continue;
     }
-  }
 
-  const s32 ret = select(nfds, &read_fds, &write_fds, &except_fds, &t);
-
-  if (ret >= 0)
-  {
-    for (auto& pair : WiiSockets)
-    {
-      WiiSocket& sock = pair.second;
-      sock.Update(FD_ISSET(sock.fd, &read_fds) != 0, FD_ISSET(sock.fd, &write_fds) != 0,
-                  FD_ISSET(sock.fd, &except_fds) != 0);
-    }
+    m_active_poll_fds.push_back({sock.fd, POLLRDNORM | POLLWRNORM, 0});
+    m_active_socket_list.push_back(&sock);
+    ++iter;
   }
-  else
+
+  if (!m_active_poll_fds.empty())
   {
-    for (auto& elem : WiiSockets)
+    const s32 ret =
+        poll(m_active_poll_fds.data(), static_cast<u32>(m_active_poll_fds.size()), 0);
+
+    for (size_t i = 0; i < m_active_socket_list.size(); ++i)
     {
-      elem.second.Update(false, false, false);
+      const int revents = ret >= 0 ? m_active_poll_fds[i].revents : 0;
+      m_active_socket_list[i]->Update((revents & (POLLRDNORM | POLLHUP)) != 0,
+                                      (revents & POLLWRNORM) != 0,
+                                      (revents & (POLLERR | POLLNVAL)) != 0);
     }
   }
+
   UpdatePollCommands();
 }
 
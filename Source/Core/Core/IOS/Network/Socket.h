@@ -49,6 +49,7 @@ typedef struct pollfd pollfd_t;
 #include <string>
 #include <string_view>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 
 #include "Common/CommonTypes.h"
@@ -282,7 +283,11 @@ public:
   s32 DeleteSocket(s32 wii_fd);
   s32 GetLastNetError() const { return errno_last; }
   void SetLastNetError(s32 error) { errno_last = error; }
-  void Clean() { WiiSockets.clear(); }
+  void Clean()
+  {
+    WiiSockets.clear();
+    m_active_sockets.clear();
+  }
   template <typename T>
   void DoSock(s32 sock, const Request& request, T type)
   {
@@ -296,6 +301,7 @@ public:
     else
     {
       socket_entry->second.DoSock(request, type);
+      m_active_sockets.insert(sock);
     }
   }
 
@@ -305,6 +311,12 @@ private:
   void UpdatePollCommands();
 
   std::unordered_map<s32, WiiSocket> WiiSockets;
+  // The Wii fds of the sockets that have pending operations, which are the only ones that Update
+  // has to look at
+  std::unordered_set<s32> m_active_sockets;
+  // Reused by every Update, so that they don't have to be allocated every time
+  std::vector<pollfd_t> m_active_poll_fds;
+  std::vector<WiiSocket*> m_active_socket_list;
   s32 errno_last = 0;
   std::vector<PollCommand> pending_polls;
   std::chrono::time_point<std::chrono::high_resolution_clock> last_time =
@@ -19,13 +19,17 @@
 #include "Core/Config/MainSettings.h"
 #include "Core/Config/SessionSettings.h"
 #include "Core/Core.h"
+#include "Core/CoreTiming.h"
 #include "Core/HW/Memmap.h"
+#include "Core/HW/SystemTimers.h"
 #include "Core/IOS/IOS.h"
 #include "Core/IOS/VersionInfo.h"
 #include "Core/System.h"
 
 namespace IOS::HLE
 {
+CoreTiming::EventType* SDIOSlot0Device::s_finish_read;
+
 SDIOSlot0Device::SDIOSlot0Device(EmulationKernel& ios, const std::string& device_name)
     : EmulationDevice(ios, device_name),
       m_sdhc_supported(HasFeature(ios.GetVersion(), Feature::SDv2))
@@ -36,11 +40,14 @@ SDIOSlot0Device::SDIOSlot0Device(EmulationKernel& ios, const std::string& device
   m_config_callback_id =
       CPUThreadConfigCallback::AddConfigChangedCallback([this] { RefreshConfig(); });
   m_sd_card_inserted = Config::Get(Config::MAIN_WII_SD_CARD);
+
+  m_read_thread.Reset("SD Card Reader", [](std::function<void()> read) { read(); });
 }
 
 SDIOSlot0Device::~SDIOSlot0Device()
 {
   CPUThreadConfigCallback::RemoveConfigChangedCallback(m_config_callback_id);
+  m_read_thread.Shutdown();
 }
 
 void SDIOSlot0Device::RefreshConfig()
@@ -55,6 +62,9 @@ void SDIOSlot0Device::RefreshConfig()
 
 void SDIOSlot0Device::DoState(PointerWrap& p)
 {
+  // The read data is part of the state until it was copied to emulated memory
+  m_read_thread.WaitForCompletion();
+
   Device::DoState(p);
   if (p.IsReadMode())
   {
@@ -66,6 +76,23 @@ void SDIOSlot0Device::DoState(PointerWrap& p)
   p.Do(m_registers);
   p.Do(m_protocol);
   p.Do(m_sdhc_supported);
+
+  bool has_pending_read = m_pending_read.has_value();
+  p.Do(has_pending_read);
+  if (!has_pending_read)
+  {
+    m_pending_read.reset();
+    return;
+  }
+
+  if (p.IsReadMode())
+    m_pending_read.emplace();
+  p.Do(m_pending_read->request_address);
+  p.Do(m_pending_read->is_ioctlv);
+  p.Do(m_pending_read->address);
+  p.Do(m_pending_read->offset);
+  p.Do(m_pending_read->data);
+  p.Do(m_pending_read->success);
 }
 
 void SDIOSlot0Device::EventNotify()
@@ -88,6 +115,8 @@ void SDIOSlot0Device::EventNotify()
 
 void SDIOSlot0Device::OpenInternal()
 {
+  m_read_thread.WaitForCompletion();
+
   const std::string filename = File::GetUserPath(F_WIISDCARDIMAGE_IDX);
   m_card.Open(filename, "r+b");
   if (!m_card)
@@ -118,6 +147,7 @@ std::optional<IPCReply> SDIOSlot0Device::Open(const OpenRequest& request)
 
 std::optional<IPCReply> SDIOSlot0Device::Close(u32 fd)
 {
+  m_read_thread.WaitForCompletion();
   m_card.Close();
   m_block_length = 0;
   m_bus_width = 0;
@@ -203,6 +233,10 @@ s32 SDIOSlot0Device::ExecuteCommand(const Request& request, u32 buffer_in, u32 b
 
   // Note: req.addr is the virtual address of _rwBuffer
 
+  // Keep the commands in order with a read that hasn't been replied to yet
+  if (m_pending_read)
+    FinishRead();
+
   s32 ret = RET_OK;
 
   switch (req.command)
@@ -281,22 +315,9 @@ s32 SDIOSlot0Device::ExecuteCommand(const Request& request, u32 buffer_in, u32 b
 
     if (m_card)
     {
-      const u32 size = req.bsize * req.blocks;
-      const u64 address = GetAddressFromRequest(req.arg);
-
-      if (!m_card.Seek(address, File::SeekOrigin::Begin))
-        ERROR_LOG_FMT(IOS_SD, "Seek failed");
-
-      if (m_card.ReadBytes(memory.GetPointer(req.addr), size))
-      {
-        DEBUG_LOG_FMT(IOS_SD, "Outbuffer size {} got {}", rw_buffer_size, size);
-      }
-      else
-      {
-        ERROR_LOG_FMT(IOS_SD, "Read Failed - error: {}, eof: {}", std::ferror(m_card.GetHandle()),
-                      std::feof(m_card.GetHandle()));
-        ret = RET_FAIL;
-      }
+      DEBUG_LOG_FMT(IOS_SD, "Outbuffer size {} got {}", rw_buffer_size, req.bsize * req.blocks);
+      StartRead(request, req.addr, GetAddressFromRequest(req.arg), req.bsize * req.blocks);
+      ret = RET_ASYNC_READ;
     }
   }
     memory.Write_U32(0x900, buffer_out);
@@ -459,11 +480,16 @@ std::optional<IPCReply> SDIOSlot0Device::SendCommand(const IOCtlRequest& request
     return std::nullopt;
   }
 
+  if (return_value == RET_ASYNC_READ)
+    return std::nullopt;
+
   return IPCReply(IPC_SUCCESS);
 }
 
 IPCReply SDIOSlot0Device::GetStatus(const IOCtlRequest& request)
 {
+  m_read_thread.WaitForCompletion();
+
   // Since IOS does the SD initialization itself, we just say we're always initialized.
   if (m_card)
   {
@@ -513,7 +539,7 @@ IPCReply SDIOSlot0Device::GetOCRegister(const IOCtlRequest& request)
   return IPCReply(IPC_SUCCESS);
 }
 
-IPCReply SDIOSlot0Device::SendCommand(const IOCtlVRequest& request)
+std::optional<IPCReply> SDIOSlot0Device::SendCommand(const IOCtlVRequest& request)
 {
   auto& system = GetSystem();
   auto& memory = system.GetMemory();
@@ -526,9 +552,65 @@ IPCReply SDIOSlot0Device::SendCommand(const IOCtlVRequest& request)
                      request.in_vectors[1].address, request.in_vectors[1].size,
                      request.io_vectors[0].address, request.io_vectors[0].size);
 
+  if (return_value == RET_ASYNC_READ)
+    return std::nullopt;
+
   return IPCReply(return_value);
 }
 
+void SDIOSlot0Device::StartRead(const Request& request, u32 address, u64 offset, u32 size)
+{
+  PendingRead& read = m_pending_read.emplace();
+  read.request_address = request.address;
+  read.is_ioctlv = request.command == IPC_CMD_IOCTLV;
+  read.address = address;
+  read.offset = offset;
+  read.data.resize(size);
+
+  m_read_thread.Push([this, &read] {
+    if (!m_card.Seek(read.offset, File::SeekOrigin::Begin))
+      ERROR_LOG_FMT(IOS_SD, "Seek failed");
+
+    read.success = m_card.ReadBytes(read.data.data(), read.data.size());
+    if (!read.success)
+    {
+      ERROR_LOG_FMT(IOS_SD, "Read Failed - error: {}, eof: {}", std::ferror(m_card.GetHandle()),
+                    std::feof(m_card.GetHandle()));
+    }
+  });
+
+  const u64 ticks = IPC_OVERHEAD_TICKS + u64{size} * SystemTimers::GetTicksPerSecond() /
+                                             READ_BYTES_PER_SECOND;
+  GetSystem().GetCoreTiming().ScheduleEvent(ticks, s_finish_read, request.address);
+}
+
+void SDIOSlot0Device::FinishRead()
+{
+  m_read_thread.WaitForCompletion();
+  const PendingRead read = std::move(*m_pending_read);
+  m_pending_read.reset();
+
+  auto& system = GetSystem();
+  if (read.success)
+    system.GetMemory().CopyToEmu(read.address, read.data.data(), read.data.size());
+
+  // IOCtlV commands report failures in their reply, IOCtl ones always succeed
+  const s32 return_value = !read.is_ioctlv ? IPC_SUCCESS : read.success ? RET_OK : RET_FAIL;
+  GetEmulationKernel().EnqueueIPCReply(Request(system, read.request_address), return_value);
+}
+
+void SDIOSlot0Device::FinishReadCallback(Core::System& system, u64 userdata, s64 cycles_late)
+{
+  auto ios = GetIOS();
+  if (!ios)
+    return;
+
+  auto device = std::static_pointer_cast<SDIOSlot0Device>(ios->GetDeviceByName("/dev/sdio/slot0"));
+  // The read may already have been finished early, because another command came in
+  if (device && device->m_pending_read && device->m_pending_read->request_address == userdata)
+    device->FinishRead();
+}
+
 u32 SDIOSlot0Device::GetOCRegister() const
 {
   u32 ocr = 0x00ff8000;
@@ -6,15 +6,27 @@
 #pragma once
 
 #include <array>
+#include <functional>
+#include <optional>
 #include <string>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/IOFile.h"
+#include "Common/WorkQueueThread.h"
 #include "Core/CPUThreadConfigCallback.h"
 #include "Core/IOS/Device.h"
 #include "Core/IOS/IOS.h"
 
 class PointerWrap;
+namespace Core
+{
+class System;
+}
+namespace CoreTiming
+{
+struct EventType;
+}
 
 namespace IOS::HLE
 {
@@ -33,6 +45,8 @@ public:
   std::optional<IPCReply> IOCtlV(const IOCtlVRequest& request) override;
 
 private:
+  friend void ::IOS::HLE::Init();
+
   // SD Host Controller Registers
   enum
   {
@@ -64,6 +78,7 @@ private:
     RET_OK,
     RET_FAIL,
     RET_EVENT_REGISTER,  // internal state only - not actually returned
+    RET_ASYNC_READ,      // internal state only - replied to once the read is finished
   };
 
   // Status
@@ -124,6 +139,21 @@ private:
     Request request;
   };
 
+  // A block read that the read thread does from the card image. The data is only copied to
+  // emulated memory when the reply is due, so the timing stays deterministic.
+  struct PendingRead
+  {
+    u32 request_address = 0;
+    bool is_ioctlv = false;
+    u32 address = 0;
+    u64 offset = 0;
+    std::vector<u8> data;
+    bool success = false;
+  };
+
+  // The rate at which reads are transferred, which is about what a 4-bit bus at 50 MHz delivers
+  static constexpr u64 READ_BYTES_PER_SECOND = 25'000'000;
+
   void RefreshConfig();
 
   void EventNotify();
@@ -136,7 +166,13 @@ private:
   IPCReply GetStatus(const IOCtlRequest& request);
   IPCReply GetOCRegister(const IOCtlRequest& request);
 
-  IPCReply SendCommand(const IOCtlVRequest& request);
+  std::optional<IPCReply> SendCommand(const IOCtlVRequest& request);
+
+  void StartRead(const Request& request, u32 address, u64 offset, u32 size);
+  void FinishRead();
+  static void FinishReadCallback(Core::System& system, u64 userdata, s64 cycles_late);
+
+  static CoreTiming::EventType* s_finish_read;
 
   s32 ExecuteCommand(const Request& request, u32 buffer_in, u32 buffer_in_size, u32 rw_buffer,
                      u32 rw_buffer_size, u32 buffer_out, u32 buffer_out_size);
@@ -167,6 +203,11 @@ private:
 
   File::IOFile m_card;
 
+  std::optional<PendingRead> m_pending_read;
+  // Only accesses m_card while a read is running. Everything else that uses m_card has to wait
+  // for the read thread first.
+  Common::WorkQueueThread<std::function<void()>> m_read_thread;
+
   CPUThreadConfigCallback::ConfigChangedCallbackID m_config_callback_id;
   bool m_sd_card_inserted = false;
 };
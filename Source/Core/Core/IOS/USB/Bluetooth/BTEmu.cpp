@@ -400,17 +400,18 @@ void BluetoothEmuDevice::Update()
 
 void BluetoothEmuDevice::ACLPool::Store(const u8* data, const u16 size, const u16 conn_handle)
 {
-  if (m_queue.size() >= 100)
+  if (m_count >= MAX_QUEUED_PACKETS)
   {
     // Many simultaneous exchanges of ACL packets tend to cause the queue to fill up.
-    ERROR_LOG_FMT(IOS_WIIMOTE, "ACL queue size reached 100 - current packet will be dropped!");
+    ERROR_LOG_FMT(IOS_WIIMOTE, "ACL queue size reached {} - current packet will be dropped!",
+                  MAX_QUEUED_PACKETS);
     return;
   }
 
   DEBUG_ASSERT_MSG(IOS_WIIMOTE, size < ACL_PKT_SIZE, "ACL packet too large for pool");
 
-  m_queue.push_back(Packet());
-  auto& packet = m_queue.back();
+  auto& packet = m_packets[(m_first + m_count) % MAX_QUEUED_PACKETS];
+  ++m_count;
 
   std::copy(data, data + size, packet.data);
   packet.size = size;
@@ -419,7 +420,7 @@ void BluetoothEmuDevice::ACLPool::Store(const u8* data, const u16 size, const u1
 
 void BluetoothEmuDevice::ACLPool::WriteToEndpoint(const USB::V0BulkMessage& endpoint)
 {
-  auto& packet = m_queue.front();
+  const auto& packet = m_packets[m_first];
 
   const u8* const data = packet.data;
   const u16 size = packet.size;
@@ -438,11 +439,27 @@ void BluetoothEmuDevice::ACLPool::WriteToEndpoint(const USB::V0BulkMessage& endp
   // Write the packet to the buffer
   std::copy(data, data + size, (u8*)header + sizeof(hci_acldata_hdr_t));
 
-  m_queue.pop_front();
+  m_first = (m_first + 1) % MAX_QUEUED_PACKETS;
+  --m_count;
 
   m_ios.EnqueueIPCReply(endpoint.ios_request, sizeof(hci_acldata_hdr_t) + size);
 }
 
+void BluetoothEmuDevice::ACLPool::DoState(PointerWrap& p)
+{
+  // Stored the same way as the std::deque that used to hold the packets
+  u32 count = static_cast<u32>(m_count);
+  p.Do(count);
+  if (p.IsReadMode())
+  {
+    m_first = 0;
+    m_count = std::min<size_t>(count, MAX_QUEUED_PACKETS);
+  }
+
+  for (u32 i = 0; i < count; ++i)
+    p.Do(m_packets[(m_first + i) % MAX_QUEUED_PACKETS]);
+}
+
 bool BluetoothEmuDevice::SendEventInquiryComplete(u8 num_responses)
 {
   SQueuedEvent event(sizeof(SHCIEventInquiryComplete), 0);
@@ -789,6 +806,14 @@ bool BluetoothEmuDevice::SendEventRoleChange(bdaddr_t bd, bool master)
 
 bool BluetoothEmuDevice::SendEventNumberOfCompletedPackets()
 {
+  // This runs on every update, so don't build the event when there is nothing to report
+  if (std::all_of(std::begin(m_packet_count), std::end(m_packet_count),
+                  [](u32 count) { return count == 0; }))
+  {
+    DEBUG_LOG_FMT(IOS_WIIMOTE, "SendEventNumberOfCompletedPackets: no packets; no event");
+    return true;
+  }
+
   SQueuedEvent event((u32)(sizeof(hci_event_hdr_t) + sizeof(hci_num_compl_pkts_ep) +
                            (sizeof(hci_num_compl_pkts_info) * m_wiimotes.size())),
                      0);
@@ -803,8 +828,6 @@ bool BluetoothEmuDevice::SendEventNumberOfCompletedPackets()
   event_hdr->length = sizeof(hci_num_compl_pkts_ep);
   hci_event->num_con_handles = 0;
 
-  u32 acc = 0;
-
   for (unsigned int i = 0; i < m_wiimotes.size(); i++)
   {
     event_hdr->length += sizeof(hci_num_compl_pkts_info);
@@ -815,19 +838,11 @@ bool BluetoothEmuDevice::SendEventNumberOfCompletedPackets()
     DEBUG_LOG_FMT(IOS_WIIMOTE, "  Connection_Handle: {:#06x}", info->con_handle);
     DEBUG_LOG_FMT(IOS_WIIMOTE, "  Number_Of_Completed_Packets: {}", info->compl_pkts);
 
-    acc += info->compl_pkts;
     m_packet_count[i] = 0;
     info++;
   }
 
-  if (acc)
-  {
-    AddEventToQueue(event);
-  }
-  else
-  {
-    DEBUG_LOG_FMT(IOS_WIIMOTE, "SendEventNumberOfCompletedPackets: no packets; no event");
-  }
+  AddEventToQueue(event);
 
   return true;
 }
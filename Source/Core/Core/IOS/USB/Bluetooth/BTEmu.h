@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <array>
 #include <cstddef>
 #include <deque>
 #include <memory>
@@ -71,19 +72,23 @@ private:
   std::unique_ptr<USB::V0BulkMessage> m_acl_endpoint;
   std::deque<SQueuedEvent> m_event_queue;
 
+  // Queues the ACL packets that arrive while the guest has no ACL buffer waiting. The packets
+  // live in a fixed ring buffer, so queueing a report never allocates.
   class ACLPool
   {
   public:
-    explicit ACLPool(EmulationKernel& ios) : m_ios(ios), m_queue() {}
+    explicit ACLPool(EmulationKernel& ios) : m_ios(ios) {}
     void Store(const u8* data, const u16 size, const u16 conn_handle);
 
     void WriteToEndpoint(const USB::V0BulkMessage& endpoint);
 
-    bool IsEmpty() const { return m_queue.empty(); }
+    bool IsEmpty() const { return m_count == 0; }
     // For SaveStates
-    void DoState(PointerWrap& p) { p.Do(m_queue); }
+    void DoState(PointerWrap& p);
 
   private:
+    static constexpr size_t MAX_QUEUED_PACKETS = 100;
+
     struct Packet
     {
       u8 data[ACL_PKT_SIZE];
@@ -92,7 +97,9 @@ private:
     };
 
     EmulationKernel& m_ios;
-    std::deque<Packet> m_queue;
+    std::array<Packet, MAX_QUEUED_PACKETS> m_packets;
+    size_t m_first = 0;
+    size_t m_count = 0;
   } m_acl_pool{GetEmulationKernel()};
 
   u32 m_packet_count[MAX_BBMOTES] = {};
@@ -3,12 +3,17 @@
 
 #include "Core/MemoryWatcher.h"
 
+#include <algorithm>
 #include <cstring>
 #include <fstream>
 #include <iostream>
+#include <iterator>
+#include <map>
 #include <sstream>
 #include <unistd.h>
 
+#include <fmt/format.h>
+
 #include "Common/FileUtil.h"
 #include "Core/HW/SystemTimers.h"
 #include "Core/PowerPC/MMU.h"
@@ -43,19 +48,25 @@ bool MemoryWatcher::LoadAddresses(const std::string& path)
   while (std::getline(locations, line))
     ParseLine(line);
 
-  return !m_values.empty();
+  std::sort(m_watches.begin(), m_watches.end(),
+            [](const Watch& a, const Watch& b) { return a.line < b.line; });
+  m_needs_update.resize(m_watches.size());
+  return !m_watches.empty();
 }
 
 void MemoryWatcher::ParseLine(const std::string& line)
 {
-  m_values[line] = 0;
-  m_addresses[line] = std::vector<u32>();
+  const auto it = std::find_if(m_watches.begin(), m_watches.end(),
+                               [&line](const Watch& watch) { return watch.line == line; });
+  Watch& watch = it != m_watches.end() ? *it : m_watches.emplace_back();
+  watch.line = line;
+  watch.offsets.clear();
 
   std::istringstream offsets(line);
   offsets >> std::hex;
   u32 offset;
   while (offsets >> offset)
-    m_addresses[line].push_back(offset);
+    watch.offsets.push_back(offset);
 }
 
 bool MemoryWatcher::OpenSocket(const std::string& path)
@@ -67,11 +78,13 @@ bool MemoryWatcher::OpenSocket(const std::string& path)
   return m_fd >= 0;
 }
 
-u32 MemoryWatcher::ChasePointer(const Core::CPUThreadGuard& guard, const std::string& line)
+u32 MemoryWatcher::ChasePointer(const Core::CPUThreadGuard& guard, const Watch& watch,
+                                std::vector<u32>* read_addresses) const
 {
   u32 value = 0;
-  for (u32 offset : m_addresses[line])
+  for (u32 offset : watch.offsets)
   {
+    read_addresses->push_back(value + offset);
     value = PowerPC::MMU::HostRead_U32(guard, value + offset);
     if (!PowerPC::MMU::HostIsRAMAddress(guard, value))
       break;
@@ -79,26 +92,105 @@ u32 MemoryWatcher::ChasePointer(const Core::CPUThreadGuard& guard, const std::st
   return value;
 }
 
-std::string MemoryWatcher::ComposeMessages(const Core::CPUThreadGuard& guard)
+void MemoryWatcher::BuildWatchedRanges(const Core::CPUThreadGuard& guard)
+{
+  // Page address -> range within it
+  std::map<u32, WatchedRange> ranges;
+  const auto add_to_range = [&ranges](u64 begin, u64 end, size_t watch) {
+    const u32 page_address = static_cast<u32>(begin & ~u64{PowerPC::HW_PAGE_MASK});
+    auto [it, inserted] =
+        ranges.try_emplace(page_address, WatchedRange{static_cast<u32>(begin), 0, false, {}, {}});
+    WatchedRange& range = it->second;
+    const u64 range_end = std::max<u64>(u64{range.address} + range.size, end);
+    range.address = std::min(range.address, static_cast<u32>(begin));
+    range.size = static_cast<u32>(range_end - range.address);
+    if (range.watches.empty() || range.watches.back() != watch)
+      range.watches.push_back(watch);
+  };
+
+  for (size_t i = 0; i < m_watches.size(); ++i)
+  {
+    for (const u32 address : m_watches[i].read_addresses)
+    {
+      // A read can cross into the next page
+      const u64 end = u64{address} + sizeof(u32);
+      const u64 page_end = (address & ~u64{PowerPC::HW_PAGE_MASK}) + PowerPC::HW_PAGE_SIZE;
+      add_to_range(address, std::min(end, page_end), i);
+      if (end > page_end && page_end <= 0xFFFFFFFF)
+        add_to_range(page_end, end, i);
+    }
+  }
+
+  m_ranges.clear();
+  for (auto& [page_address, range] : ranges)
+  {
+    range.data.resize(range.size);
+    range.is_ram = PowerPC::MMU::HostTryCopyFromPage(guard, range.address, range.data.data(),
+                                                     range.size);
+    m_ranges.push_back(std::move(range));
+  }
+  m_ranges_built = true;
+}
+
+bool MemoryWatcher::UpdateWatchedRange(const Core::CPUThreadGuard& guard, WatchedRange* range)
+{
+  m_range_buffer.resize(range->size);
+  const bool is_ram = PowerPC::MMU::HostTryCopyFromPage(guard, range->address,
+                                                        m_range_buffer.data(), range->size);
+  const bool changed = !is_ram || !range->is_ram ||
+                       std::memcmp(m_range_buffer.data(), range->data.data(), range->size) != 0;
+  if (changed && is_ram)
+    std::swap(m_range_buffer, range->data);
+  range->is_ram = is_ram;
+  return changed;
+}
+
+void MemoryWatcher::ComposeMessages(const Core::CPUThreadGuard& guard)
 {
-  std::ostringstream message_stream;
-  message_stream << std::hex;
+  m_message.clear();
+
+  if (m_ranges_built)
+  {
+    std::fill(m_needs_update.begin(), m_needs_update.end(), false);
+    for (WatchedRange& range : m_ranges)
+    {
+      if (!UpdateWatchedRange(guard, &range))
+        continue;
+      for (const size_t watch : range.watches)
+        m_needs_update[watch] = true;
+    }
+  }
+  else
+  {
+    std::fill(m_needs_update.begin(), m_needs_update.end(), true);
+  }
 
-  for (auto& entry : m_values)
+  bool read_addresses_changed = false;
+  std::vector<u32> read_addresses;
+  for (size_t i = 0; i < m_watches.size(); ++i)
   {
-    std::string address = entry.first;
-    u32& current_value = entry.second;
+    if (!m_needs_update[i])
+      continue;
+
+    Watch& watch = m_watches[i];
+    read_addresses.clear();
+    const u32 new_value = ChasePointer(guard, watch, &read_addresses);
+    if (read_addresses != watch.read_addresses)
+    {
+      std::swap(read_addresses, watch.read_addresses);
+      read_addresses_changed = true;
+    }
 
-    u32 new_value = ChasePointer(guard, address);
-    if (new_value != current_value)
+    if (new_value != watch.value)
     {
       // Update the value
-      current_value = new_value;
-      message_stream << address << '\n' << new_value << '\n';
+      watch.value = new_value;
+      fmt::format_to(std::back_inserter(m_message), "{}\n{:x}\n", watch.line, new_value);
     }
   }
 
-  return message_stream.str();
+  if (read_addresses_changed || !m_ranges_built)
+    BuildWatchedRanges(guard);
 }
 
 void MemoryWatcher::Step(const Core::CPUThreadGuard& guard)
@@ -106,7 +198,8 @@ void MemoryWatcher::Step(const Core::CPUThreadGuard& guard)
   if (!m_running)
     return;
 
-  std::string message = ComposeMessages(guard);
-  sendto(m_fd, message.c_str(), message.size() + 1, 0, reinterpret_cast<sockaddr*>(&m_addr),
+  // All changes of a frame are sent together
+  ComposeMessages(guard);
+  sendto(m_fd, m_message.c_str(), m_message.size() + 1, 0, reinterpret_cast<sockaddr*>(&m_addr),
          sizeof(m_addr));
 }
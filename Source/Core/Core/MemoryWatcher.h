@@ -5,7 +5,6 @@
 
 #include "Common/CommonTypes.h"
 
-#include <map>
 #include <string>
 #include <sys/socket.h>
 #include <sys/un.h>
@@ -24,6 +23,9 @@ class CPUThreadGuard;
 // "ABCD EF" will watch the address at (*0xABCD) + 0xEF.
 // The output to the socket is two lines. The first is the address from the
 // input file, and the second is the new value in hex.
+//
+// Only the watches whose memory was written to since the last frame follow their pointers again.
+// For that, the parts of the pages that watches read from are compared with copies of them.
 class MemoryWatcher final
 {
 public:
@@ -32,20 +34,51 @@ public:
   void Step(const Core::CPUThreadGuard& guard);
 
 private:
+  struct Watch
+  {
+    // Address as stored in the file
+    std::string line;
+    // Offsets to follow
+    std::vector<u32> offsets;
+    u32 value = 0;
+    // The addresses that were read the last time the pointers were followed
+    std::vector<u32> read_addresses;
+  };
+
+  // The part of a page that watches read from, and its contents at the last step
+  struct WatchedRange
+  {
+    u32 address;
+    u32 size;
+    // Ranges that aren't RAM are read again at every step
+    bool is_ram;
+    std::vector<u8> data;
+    // Indices into m_watches
+    std::vector<size_t> watches;
+  };
+
   bool LoadAddresses(const std::string& path);
   bool OpenSocket(const std::string& path);
 
   void ParseLine(const std::string& line);
-  u32 ChasePointer(const Core::CPUThreadGuard& guard, const std::string& line);
-  std::string ComposeMessages(const Core::CPUThreadGuard& guard);
+  u32 ChasePointer(const Core::CPUThreadGuard& guard, const Watch& watch,
+                   std::vector<u32>* read_addresses) const;
+  void BuildWatchedRanges(const Core::CPUThreadGuard& guard);
+  bool UpdateWatchedRange(const Core::CPUThreadGuard& guard, WatchedRange* range);
+  void ComposeMessages(const Core::CPUThreadGuard& guard);
 
   bool m_running = false;
 
   int m_fd;
   sockaddr_un m_addr{};
 
-  // Address as stored in the file -> list of offsets to follow
-  std::map<std::string, std::vector<u32>> m_addresses;
-  // Address as stored in the file -> current value
-  std::map<std::string, u32> m_values;
+  // Sorted by address as stored in the file
+  std::vector<Watch> m_watches;
+  std::vector<WatchedRange> m_ranges;
+  bool m_ranges_built = false;
+
+  // Kept around between steps to not allocate them every frame
+  std::vector<u8> m_needs_update;
+  std::vector<u8> m_range_buffer;
+  std::string m_message;
 };
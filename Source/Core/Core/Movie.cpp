@@ -12,6 +12,7 @@
 #include <mbedtls/config.h>
 #include <mbedtls/md.h>
 #include <mutex>
+#include <span>
 #include <sstream>
 #include <thread>
 #include <utility>
@@ -27,6 +28,7 @@
 #include "Common/FileUtil.h"
 #include "Common/Hash.h"
 #include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 #include "Common/NandPaths.h"
 #include "Common/StringUtil.h"
@@ -47,6 +49,7 @@
 #include "Core/HW/EXI/EXI.h"
 #include "Core/HW/EXI/EXI_DeviceIPL.h"
 #include "Core/HW/EXI/EXI_DeviceMemoryCard.h"
+#include "Core/HW/Memmap.h"
 #include "Core/HW/ProcessorInterface.h"
 #include "Core/HW/SI/SI.h"
 #include "Core/HW/SI/SI_Device.h"
@@ -61,7 +64,9 @@
 
 #include "Core/IOS/USB/Bluetooth/BTEmu.h"
 #include "Core/IOS/USB/Bluetooth/WiimoteDevice.h"
+#include "Core/MovieInputLog.h"
 #include "Core/NetPlayProto.h"
+#include "Core/PowerPC/PowerPC.h"
 #include "Core/State.h"
 #include "Core/System.h"
 #include "Core/WiiUtils.h"
@@ -96,7 +101,7 @@ static std::array<ControllerType, 4> s_controllers{};
 static std::array<bool, 4> s_wiimotes{};
 static ControllerState s_padState;
 static DTMHeader tmpHeader;
-static std::vector<u8> s_temp_input;
+static InputLog s_temp_input;
 static u64 s_currentByte = 0;
 static u64 s_currentFrame = 0, s_totalFrames = 0;  // VI
 static u64 s_currentLagCount = 0;
@@ -125,10 +130,21 @@ static std::string s_InputDisplay[8];
 
 static std::string s_current_file_name;
 
+static u32 s_state_hash_interval = 0;
+static std::vector<u64> s_state_hashes;
+static u64 s_checked_state_hashes = 0;
+static std::optional<u64> s_first_divergent_frame;
+static std::function<void()> s_verification_end_callback;
+
 static void GetSettings();
+// Version 2 files store the input data in compressed blocks, see InputLog
+constexpr u8 DTM_VERSION_1 = 0x1A;
+constexpr u8 DTM_VERSION_2 = 0x1B;
+
 static bool IsMovieHeader(const std::array<u8, 4>& magic)
 {
-  return magic[0] == 'D' && magic[1] == 'T' && magic[2] == 'M' && magic[3] == 0x1A;
+  return magic[0] == 'D' && magic[1] == 'T' && magic[2] == 'M' &&
+         (magic[3] == DTM_VERSION_1 || magic[3] == DTM_VERSION_2);
 }
 
 static std::array<u8, 20> ConvertGitRevisionToBytes(const std::string& revision)
@@ -220,12 +236,61 @@ std::string GetRerecords()
   return "Rerecords: N/A";
 }
 
+// RAM, the CPU registers and the time, which diverge within a few frames of a desync and don't
+// depend on host timing the way the full savestate does
+static u64 GetStateHash()
+{
+  auto& system = Core::System::GetInstance();
+  auto& memory = system.GetMemory();
+  auto& ppc_state = system.GetPPCState();
+
+  u64 hash = Common::GetHash64(memory.GetRAM(), memory.GetRamSize(), 0);
+  if (memory.GetEXRAM())
+    hash ^= Common::GetHash64(memory.GetEXRAM(), memory.GetExRamSize(), 0) * 31;
+  hash ^= Common::GetHash64(reinterpret_cast<const u8*>(ppc_state.gpr), sizeof(ppc_state.gpr), 0) *
+          37;
+  hash ^= (u64{ppc_state.pc} << 32 | ppc_state.msr.Hex) * 41;
+  hash ^= system.GetCoreTiming().GetTicks() * 43;
+  return hash;
+}
+
+static void UpdateStateHash()
+{
+  const size_t index = static_cast<size_t>(s_currentFrame / s_state_hash_interval - 1);
+
+  if (IsRecordingInput())
+  {
+    // After a rerecord, the hashes of the frames that are recorded again are replaced
+    s_state_hashes.resize(index);
+    s_state_hashes.push_back(GetStateHash());
+    return;
+  }
+
+  if (!IsPlayingInput() || index >= s_state_hashes.size() || s_first_divergent_frame)
+    return;
+
+  ++s_checked_state_hashes;
+  if (GetStateHash() == s_state_hashes[index])
+    return;
+
+  // The desync happened somewhere since the previous hash
+  s_first_divergent_frame = s_currentFrame;
+  ERROR_LOG_FMT(CORE, "Movie state hash mismatch at frame {} (last match at frame {})",
+                s_currentFrame, s_currentFrame - s_state_hash_interval);
+  Core::DisplayMessage(fmt::format("Movie desynced at frame {}", s_currentFrame), 4000);
+  if (s_verification_end_callback)
+    s_verification_end_callback();
+}
+
 void FrameUpdate()
 {
   s_currentFrame++;
   if (!s_bPolled)
     s_currentLagCount++;
 
+  if (s_state_hash_interval != 0 && s_currentFrame % s_state_hash_interval == 0)
+    UpdateStateHash();
+
   if (IsRecordingInput())
   {
     s_totalFrames = s_currentFrame;
@@ -600,7 +665,9 @@ bool BeginRecordingInput(const ControllerTypeArray& controllers,
 
     s_playMode = PlayMode::Recording;
     s_author = Config::Get(Config::MAIN_MOVIE_MOVIE_AUTHOR);
-    s_temp_input.clear();
+    s_temp_input.Clear();
+    s_state_hash_interval = Config::Get(Config::MAIN_MOVIE_STATE_HASH_INTERVAL);
+    s_state_hashes.clear();
 
     s_currentByte = 0;
 
@@ -890,8 +957,8 @@ void RecordInput(const GCPadStatus* PadStatus, int controllerID)
 
   CheckPadStatus(PadStatus, controllerID);
 
-  s_temp_input.resize(s_currentByte + sizeof(ControllerState));
-  memcpy(&s_temp_input[s_currentByte], &s_padState, sizeof(ControllerState));
+  s_temp_input.Truncate(s_currentByte);
+  s_temp_input.Append(&s_padState, sizeof(ControllerState));
   s_currentByte += sizeof(ControllerState);
 }
 
@@ -911,10 +978,10 @@ void RecordWiimote(int wiimote, const u8* data, u8 size)
     return;
 
   InputUpdate();
-  s_temp_input.resize(s_currentByte + size + 1);
-  s_temp_input[s_currentByte++] = size;
-  memcpy(&s_temp_input[s_currentByte], data, size);
-  s_currentByte += size;
+  s_temp_input.Truncate(s_currentByte);
+  s_temp_input.Append(&size, 1);
+  s_temp_input.Append(data, size);
+  s_currentByte += size + 1;
 }
 
 // NOTE: EmuThread / Host Thread
@@ -954,6 +1021,25 @@ void ReadHeader()
   s_MD5 = tmpHeader.md5;
   s_DSPiromHash = tmpHeader.DSPiromHash;
   s_DSPcoefHash = tmpHeader.DSPcoefHash;
+  s_state_hash_interval = tmpHeader.stateHashInterval;
+}
+
+// Reads the input data and the state hashes after the header of either version. Files that were
+// saved before the state hashes existed have a count of 0.
+static bool ReadInput(File::IOFile& file, InputLog* input, std::vector<u64>* state_hashes)
+{
+  if (tmpHeader.filetype[3] == DTM_VERSION_2)
+    return input->LoadBlocks(file, tmpHeader.stateHashCount, state_hashes);
+
+  const u64 hashes_size = u64{tmpHeader.stateHashCount} * sizeof(u64);
+  const u64 file_size = file.GetSize();
+  if (file_size < sizeof(DTMHeader) + hashes_size)
+    return false;
+
+  const u64 input_size = file_size - sizeof(DTMHeader) - hashes_size;
+  state_hashes->resize(tmpHeader.stateHashCount);
+  return input->LoadRaw(file, input_size) &&
+         file.ReadArray(state_hashes->data(), state_hashes->size());
 }
 
 // NOTE: Host Thread
@@ -988,8 +1074,14 @@ bool PlayInput(const std::string& movie_path, std::optional<std::string>* savest
 
   Core::UpdateWantDeterminism();
 
-  s_temp_input.resize(recording_file.GetSize() - 256);
-  recording_file.ReadBytes(s_temp_input.data(), s_temp_input.size());
+  s_checked_state_hashes = 0;
+  s_first_divergent_frame.reset();
+  if (!ReadInput(recording_file, &s_temp_input, &s_state_hashes))
+  {
+    PanicAlertFmtT("Failed to read the input data of {0}", movie_path);
+    s_temp_input.Clear();
+    s_state_hashes.clear();
+  }
   s_currentByte = 0;
   recording_file.Close();
 
@@ -1060,7 +1152,17 @@ void LoadInput(const std::string& movie_path)
   if (SConfig::GetInstance().bWii)
     ChangeWiiPads(true);
 
-  u64 totalSavedBytes = t_record.GetSize() - 256;
+  InputLog saved_input;
+  std::vector<u64> saved_state_hashes;
+  if (!ReadInput(t_record, &saved_input, &saved_state_hashes))
+  {
+    PanicAlertFmtT("Savestate movie {0} is corrupted, movie recording stopping...", movie_path);
+    EndPlayInput(false);
+    return;
+  }
+  t_record.Close();
+
+  const u64 totalSavedBytes = saved_input.GetSize();
 
   bool afterEnd = false;
   // This can only happen if the user manually deletes data from the dtm.
@@ -1073,37 +1175,40 @@ void LoadInput(const std::string& movie_path)
     afterEnd = true;
   }
 
-  if (!s_bReadOnly || s_temp_input.empty())
+  if (!s_bReadOnly || s_temp_input.IsEmpty())
   {
     s_totalFrames = tmpHeader.frameCount;
     s_totalLagCount = tmpHeader.lagCount;
     s_totalInputCount = tmpHeader.inputCount;
     s_totalTickCount = s_tickCountAtLastInput = tmpHeader.tickCount;
 
-    s_temp_input.resize(static_cast<size_t>(totalSavedBytes));
-    t_record.ReadBytes(s_temp_input.data(), s_temp_input.size());
+    s_temp_input = std::move(saved_input);
+    s_state_hashes = std::move(saved_state_hashes);
   }
   else if (s_currentByte > 0)
   {
     if (s_currentByte > totalSavedBytes)
     {
     }
-    else if (s_currentByte > s_temp_input.size())
+    else if (s_currentByte > s_temp_input.GetSize())
     {
       afterEnd = true;
       PanicAlertFmtT(
           "Warning: You loaded a save that's after the end of the current movie. (byte {0} "
           "> {1}) (input {2} > {3}). You should load another save before continuing, or load "
           "this state with read-only mode off.",
-          s_currentByte + 256, s_temp_input.size() + 256, s_currentInputCount, s_totalInputCount);
+          s_currentByte + 256, s_temp_input.GetSize() + 256, s_currentInputCount,
+          s_totalInputCount);
     }
-    else if (s_currentByte > 0 && !s_temp_input.empty())
+    else if (s_currentByte > 0 && !s_temp_input.IsEmpty())
     {
       // verify identical from movie start to the save's current frame
       std::vector<u8> movInput(s_currentByte);
-      t_record.ReadArray(movInput.data(), movInput.size());
+      saved_input.Read(0, movInput.data(), movInput.size());
+      std::vector<u8> curInput(s_currentByte);
+      s_temp_input.Read(0, curInput.data(), curInput.size());
 
-      const auto result = std::mismatch(movInput.begin(), movInput.end(), s_temp_input.begin());
+      const auto result = std::mismatch(movInput.begin(), movInput.end(), curInput.begin());
 
       if (result.first != movInput.end())
       {
@@ -1122,13 +1227,16 @@ void LoadInput(const std::string& movie_path)
                          "read-only mode off. Otherwise you'll probably get a desync.",
                          byte_offset, byte_offset);
 
-          std::copy(movInput.begin(), movInput.end(), s_temp_input.begin());
+          std::vector<u8> input = s_temp_input.ReadAll();
+          std::copy(movInput.begin(), movInput.end(), input.begin());
+          s_temp_input.Clear();
+          s_temp_input.Append(input.data(), input.size());
         }
         else
         {
           const ptrdiff_t frame = mismatch_index / sizeof(ControllerState);
           ControllerState curPadState;
-          memcpy(&curPadState, &s_temp_input[frame * sizeof(ControllerState)],
+          memcpy(&curPadState, &curInput[frame * sizeof(ControllerState)],
                  sizeof(ControllerState));
           ControllerState movPadState;
           memcpy(&movPadState, &movInput[frame * sizeof(ControllerState)], sizeof(ControllerState));
@@ -1162,7 +1270,6 @@ void LoadInput(const std::string& movie_path)
       }
     }
   }
-  t_record.Close();
 
   s_bSaveConfig = tmpHeader.bSaveConfig;
 
@@ -1196,7 +1303,7 @@ void LoadInput(const std::string& movie_path)
 // NOTE: CPU Thread
 static void CheckInputEnd()
 {
-  if (s_currentByte >= s_temp_input.size() ||
+  if (s_currentByte >= s_temp_input.GetSize() ||
       (Core::System::GetInstance().GetCoreTiming().GetTicks() > s_totalTickCount &&
        !IsRecordingInputFromSaveState()))
   {
@@ -1209,18 +1316,17 @@ void PlayController(GCPadStatus* PadStatus, int controllerID)
 {
   // Correct playback is entirely dependent on the emulator polling the controllers
   // in the same order done during recording
-  if (!IsPlayingInput() || !IsUsingPad(controllerID) || s_temp_input.empty())
+  if (!IsPlayingInput() || !IsUsingPad(controllerID) || s_temp_input.IsEmpty())
     return;
 
-  if (s_currentByte + sizeof(ControllerState) > s_temp_input.size())
+  if (!s_temp_input.Read(s_currentByte, &s_padState, sizeof(ControllerState)))
   {
     PanicAlertFmtT("Premature movie end in PlayController. {0} + {1} > {2}", s_currentByte,
-                   sizeof(ControllerState), s_temp_input.size());
+                   sizeof(ControllerState), s_temp_input.GetSize());
     EndPlayInput(!s_bReadOnly);
     return;
   }
 
-  memcpy(&s_padState, &s_temp_input[s_currentByte], sizeof(ControllerState));
   s_currentByte += sizeof(ControllerState);
 
   PadStatus->isConnected = s_padState.is_connected;
@@ -1299,19 +1405,19 @@ void PlayController(GCPadStatus* PadStatus, int controllerID)
 bool PlayWiimote(int wiimote, WiimoteCommon::DataReportBuilder& rpt, int ext,
                  const EncryptionKey& key)
 {
-  if (!IsPlayingInput() || !IsUsingWiimote(wiimote) || s_temp_input.empty())
+  if (!IsPlayingInput() || !IsUsingWiimote(wiimote) || s_temp_input.IsEmpty())
     return false;
 
-  if (s_currentByte > s_temp_input.size())
+  u8 sizeInMovie;
+  if (!s_temp_input.Read(s_currentByte, &sizeInMovie, 1))
   {
     PanicAlertFmtT("Premature movie end in PlayWiimote. {0} > {1}", s_currentByte,
-                   s_temp_input.size());
+                   s_temp_input.GetSize());
     EndPlayInput(!s_bReadOnly);
     return false;
   }
 
   const u8 size = rpt.GetDataSize();
-  const u8 sizeInMovie = s_temp_input[s_currentByte];
 
   if (size != sizeInMovie)
   {
@@ -1328,15 +1434,14 @@ bool PlayWiimote(int wiimote, WiimoteCommon::DataReportBuilder& rpt, int ext,
 
   s_currentByte++;
 
-  if (s_currentByte + size > s_temp_input.size())
+  if (!s_temp_input.Read(s_currentByte, rpt.GetDataPtr(), size))
   {
     PanicAlertFmtT("Premature movie end in PlayWiimote. {0} + {1} > {2}", s_currentByte, size,
-                   s_temp_input.size());
+                   s_temp_input.GetSize());
     EndPlayInput(!s_bReadOnly);
     return false;
   }
 
-  memcpy(rpt.GetDataPtr(), &s_temp_input[s_currentByte], size);
   s_currentByte += size;
 
   s_currentInputCount++;
@@ -1355,6 +1460,8 @@ void EndPlayInput(bool cont)
 
     s_playMode = PlayMode::Recording;
     Core::DisplayMessage("Reached movie end. Resuming recording.", 2000);
+    if (s_verification_end_callback)
+      s_verification_end_callback();
   }
   else if (s_playMode != PlayMode::None)
   {
@@ -1377,13 +1484,26 @@ void EndPlayInput(bool cont)
     // tmpInput = nullptr;
 
     Core::QueueHostJob([=] { Core::UpdateWantDeterminism(); });
+    if (s_verification_end_callback)
+      s_verification_end_callback();
   }
 }
 
+StateHashVerification GetStateHashVerification()
+{
+  return {s_checked_state_hashes, s_state_hashes.size(), s_first_divergent_frame};
+}
+
+void SetVerificationEndCallback(std::function<void()> callback)
+{
+  s_verification_end_callback = std::move(callback);
+}
+
 // NOTE: Save State + Host Thread
 void SaveRecording(const std::string& filename)
 {
-  File::IOFile save_record(filename, "wb");
+  // Saving the same file again only writes the input data that was added since
+  File::IOFile save_record(filename, s_temp_input.CanSaveIncrementally(filename) ? "r+b" : "wb");
   // Create the real header now and write it
   DTMHeader header;
   memset(&header, 0, sizeof(DTMHeader));
@@ -1391,7 +1511,7 @@ void SaveRecording(const std::string& filename)
   header.filetype[0] = 'D';
   header.filetype[1] = 'T';
   header.filetype[2] = 'M';
-  header.filetype[3] = 0x1A;
+  header.filetype[3] = DTM_VERSION_2;
   strncpy(header.gameID.data(), SConfig::GetInstance().GetGameID().c_str(), 6);
   header.bWii = SConfig::GetInstance().bWii;
   header.controllers = 0;
@@ -1427,13 +1547,22 @@ void SaveRecording(const std::string& filename)
   header.DSPcoefHash = s_DSPcoefHash;
   header.tickCount = s_totalTickCount;
 
+  // Hashes past the end of the recording are of frames that were undone by a rerecord
+  const size_t state_hash_count =
+      s_state_hash_interval != 0 ?
+          std::min<size_t>(s_state_hashes.size(), s_totalFrames / s_state_hash_interval) :
+          0;
+  header.stateHashInterval = s_state_hash_interval;
+  header.stateHashCount = static_cast<u32>(state_hash_count);
+
   // TODO
   header.uniqueID = 0;
   // header.audioEmulator;
 
-  save_record.WriteArray(&header, 1);
-
-  bool success = save_record.WriteBytes(s_temp_input.data(), s_temp_input.size());
+  bool success = save_record.WriteArray(&header, 1) &&
+                 s_temp_input.Save(save_record, filename,
+                                   std::span(s_state_hashes.data(), state_hash_count));
+  save_record.Close();
 
   if (success && s_bRecordingFromSaveState)
   {
@@ -1576,6 +1705,6 @@ static void GetMD5()
 void Shutdown()
 {
   s_currentInputCount = s_totalInputCount = s_totalFrames = s_tickCountAtLastInput = 0;
-  s_temp_input.clear();
+  s_temp_input.Clear();
 }
 }  // namespace Movie
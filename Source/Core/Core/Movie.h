@@ -5,6 +5,7 @@
 
 #include <array>
 #include <cstring>
+#include <functional>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -75,7 +76,7 @@ struct DTMHeader
     return {gameID.data(), strnlen(gameID.data(), gameID.size())};
   }
 
-  std::array<u8, 4> filetype;  // Unique Identifier (always "DTM"0x1A)
+  std::array<u8, 4> filetype;  // Unique Identifier ("DTM"0x1A, or "DTM"0x1B for version 2)
 
   std::array<char, 6> gameID;  // The Game ID
   bool bWii;                   // Wii game
@@ -129,7 +130,9 @@ struct DTMHeader
   u32 DSPiromHash;
   u32 DSPcoefHash;
   u64 tickCount;                 // Number of ticks in the recording
-  std::array<u8, 11> reserved2;  // Make heading 256 bytes, just because we can
+  u32 stateHashInterval;         // Frames between the state hashes after the input data, or 0
+  u32 stateHashCount;            // Number of u64 state hashes after the input data
+  std::array<u8, 3> reserved2;   // Make heading 256 bytes, just because we can
 };
 static_assert(sizeof(DTMHeader) == 256, "DTMHeader should be 256 bytes");
 
@@ -195,6 +198,18 @@ void CheckPadStatus(const GCPadStatus* PadStatus, int controllerID);
 void CheckWiimoteStatus(int wiimote, const WiimoteCommon::DataReportBuilder& rpt, int ext,
                         const WiimoteEmu::EncryptionKey& key);
 
+// Recordings made with MAIN_MOVIE_STATE_HASH_INTERVAL set embed a hash of the emulated state every
+// that many frames, which playback compares against to find where a movie desyncs.
+struct StateHashVerification
+{
+  u64 checked_hashes = 0;
+  u64 total_hashes = 0;
+  std::optional<u64> first_divergent_frame;
+};
+StateHashVerification GetStateHashVerification();
+// Called on the CPU thread when playback ends, or at the first state hash that doesn't match
+void SetVerificationEndCallback(std::function<void()> callback);
+
 std::string GetInputDisplay();
 std::string GetRTCDisplay();
 std::string GetRerecords();
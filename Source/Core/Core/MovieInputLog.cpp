@@ -0,0 +1,343 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/MovieInputLog.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <zstd.h>
+
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+#include "Common/Random.h"
+
+namespace Movie
+{
+constexpr int COMPRESSION_LEVEL = 3;
+
+void InputLog::Clear()
+{
+  m_blocks.clear();
+  m_tail.clear();
+  m_size = 0;
+  m_cached_block.reset();
+  m_saved_files.clear();
+}
+
+void InputLog::Truncate(u64 size)
+{
+  if (size >= m_size)
+    return;
+
+  const size_t block_index = static_cast<size_t>(size / BLOCK_SIZE);
+  if (block_index < m_blocks.size())
+  {
+    // The block that gets cut becomes the uncompressed tail again
+    DecompressBlock(block_index, &m_tail);
+    m_blocks.resize(block_index);
+    ForgetSavedBlocksFrom(block_index);
+    if (m_cached_block && *m_cached_block >= block_index)
+      m_cached_block.reset();
+  }
+
+  m_tail.resize(static_cast<size_t>(size - u64{block_index} * BLOCK_SIZE));
+  m_size = size;
+}
+
+void InputLog::Append(const void* data, size_t size)
+{
+  const u8* src = static_cast<const u8*>(data);
+  while (size != 0)
+  {
+    const size_t count = std::min(size, BLOCK_SIZE - m_tail.size());
+    m_tail.insert(m_tail.end(), src, src + count);
+    src += count;
+    size -= count;
+    m_size += count;
+
+    if (m_tail.size() == BLOCK_SIZE)
+      CompressTail();
+  }
+}
+
+bool InputLog::Read(u64 offset, void* data, size_t size)
+{
+  if (offset > m_size || size > m_size - offset)
+    return false;
+
+  u8* dest = static_cast<u8*>(data);
+  while (size != 0)
+  {
+    const size_t block_index = static_cast<size_t>(offset / BLOCK_SIZE);
+    const size_t offset_in_block = static_cast<size_t>(offset % BLOCK_SIZE);
+
+    const std::vector<u8>* block = &m_tail;
+    if (block_index < m_blocks.size())
+    {
+      if (m_cached_block != block_index)
+      {
+        m_cached_block.reset();
+        if (!DecompressBlock(block_index, &m_cache))
+          return false;
+        m_cached_block = block_index;
+      }
+      block = &m_cache;
+    }
+
+    const size_t count = std::min(size, block->size() - offset_in_block);
+    std::memcpy(dest, block->data() + offset_in_block, count);
+    dest += count;
+    offset += count;
+    size -= count;
+  }
+
+  return true;
+}
+
+std::vector<u8> InputLog::ReadAll()
+{
+  std::vector<u8> data(static_cast<size_t>(m_size));
+  if (!Read(0, data.data(), data.size()))
+    data.clear();
+  return data;
+}
+
+std::optional<std::vector<u8>> InputLog::Compress(std::span<const u8> data)
+{
+  std::vector<u8> compressed(ZSTD_compressBound(data.size()));
+  const size_t compressed_size =
+      ZSTD_compress(compressed.data(), compressed.size(), data.data(), data.size(),
+                    COMPRESSION_LEVEL);
+  if (ZSTD_isError(compressed_size))
+  {
+    ERROR_LOG_FMT(CORE, "Failed to compress movie input: {}", ZSTD_getErrorName(compressed_size));
+    return std::nullopt;
+  }
+  compressed.resize(compressed_size);
+  compressed.shrink_to_fit();
+  return compressed;
+}
+
+void InputLog::CompressTail()
+{
+  Block block;
+  block.raw_size = static_cast<u32>(m_tail.size());
+  if (std::optional<std::vector<u8>> compressed = Compress(m_tail))
+  {
+    block.data = std::move(*compressed);
+  }
+  else
+  {
+    // Only happens when out of memory. Keep the block uncompressed so that no input is lost.
+    block.data = m_tail;
+    block.compressed = false;
+  }
+
+  m_blocks.push_back(std::move(block));
+  m_tail.clear();
+}
+
+bool InputLog::DecompressBlock(size_t index, std::vector<u8>* out) const
+{
+  const Block& block = m_blocks[index];
+  if (!block.compressed)
+  {
+    *out = block.data;
+    return true;
+  }
+
+  out->resize(block.raw_size);
+  const size_t size =
+      ZSTD_decompress(out->data(), out->size(), block.data.data(), block.data.size());
+  if (ZSTD_isError(size) || size != block.raw_size)
+  {
+    ERROR_LOG_FMT(CORE, "Failed to decompress block {} of the movie input", index);
+    out->clear();
+    return false;
+  }
+  return true;
+}
+
+void InputLog::ForgetSavedBlocksFrom(size_t index)
+{
+  for (auto& [path, saved_file] : m_saved_files)
+  {
+    if (saved_file.index.size() > index)
+      saved_file.index.resize(index);
+  }
+}
+
+bool InputLog::LoadRaw(File::IOFile& file, u64 size)
+{
+  Clear();
+
+  std::vector<u8> buffer(BLOCK_SIZE);
+  while (size != 0)
+  {
+    const size_t count = static_cast<size_t>(std::min<u64>(size, BLOCK_SIZE));
+    if (!file.ReadBytes(buffer.data(), count))
+      return false;
+    Append(buffer.data(), count);
+    size -= count;
+  }
+  return true;
+}
+
+bool InputLog::LoadBlocks(File::IOFile& file, u32 state_hash_count,
+                          std::vector<u64>* state_hashes)
+{
+  Clear();
+
+  const u64 body_start = file.Tell();
+  const u64 file_size = file.GetSize();
+
+  Footer footer;
+  if (file_size < body_start + sizeof(Footer) ||
+      !file.Seek(file_size - sizeof(Footer), File::SeekOrigin::Begin) ||
+      !file.ReadArray(&footer, 1) || footer.magic != FOOTER_MAGIC)
+  {
+    return false;
+  }
+
+  const u64 index_size = u64{footer.block_count} * sizeof(IndexEntry);
+  const u64 hashes_size = u64{state_hash_count} * sizeof(u64);
+  if (footer.index_offset + index_size + sizeof(Footer) != file_size ||
+      footer.index_offset < body_start + hashes_size)
+  {
+    return false;
+  }
+  const u64 hashes_offset = footer.index_offset - hashes_size;
+
+  std::vector<IndexEntry> index(footer.block_count);
+  state_hashes->resize(state_hash_count);
+  if (!file.Seek(footer.index_offset, File::SeekOrigin::Begin) ||
+      !file.ReadArray(index.data(), index.size()) ||
+      !file.Seek(hashes_offset, File::SeekOrigin::Begin) ||
+      !file.ReadArray(state_hashes->data(), state_hashes->size()))
+  {
+    state_hashes->clear();
+    return false;
+  }
+
+  for (size_t i = 0; i < index.size(); ++i)
+  {
+    const IndexEntry& entry = index[i];
+    const bool is_last = i + 1 == index.size();
+    if (entry.raw_size == 0 || entry.raw_size > BLOCK_SIZE ||
+        (!is_last && entry.raw_size != BLOCK_SIZE) || entry.file_offset < body_start ||
+        entry.file_offset + entry.compressed_size > hashes_offset)
+    {
+      Clear();
+      return false;
+    }
+
+    Block block;
+    block.raw_size = entry.raw_size;
+    block.data.resize(entry.compressed_size);
+    if (!file.Seek(entry.file_offset, File::SeekOrigin::Begin) ||
+        !file.ReadBytes(block.data.data(), block.data.size()))
+    {
+      Clear();
+      return false;
+    }
+    m_blocks.push_back(std::move(block));
+    m_size += entry.raw_size;
+  }
+
+  // Only full blocks stay compressed
+  if (!m_blocks.empty() && m_blocks.back().raw_size != BLOCK_SIZE)
+  {
+    if (!DecompressBlock(m_blocks.size() - 1, &m_tail))
+    {
+      Clear();
+      return false;
+    }
+    m_blocks.pop_back();
+  }
+
+  return true;
+}
+
+bool InputLog::CanSaveIncrementally(const std::string& path) const
+{
+  const auto it = m_saved_files.find(path);
+  if (it == m_saved_files.end() || it->second.index.empty())
+    return false;
+
+  // The file must still be the one that was saved, not another one that took its place
+  File::IOFile file(path, "rb");
+  const u64 file_size = file.GetSize();
+  Footer footer;
+  if (file_size < sizeof(Footer) ||
+      !file.Seek(file_size - sizeof(Footer), File::SeekOrigin::Begin) ||
+      !file.ReadArray(&footer, 1) || footer.magic != FOOTER_MAGIC ||
+      footer.save_id != it->second.save_id)
+  {
+    return false;
+  }
+
+  const IndexEntry& last = it->second.index.back();
+  return footer.index_offset >= last.file_offset + last.compressed_size;
+}
+
+bool InputLog::Save(File::IOFile& file, const std::string& path,
+                    std::span<const u64> state_hashes)
+{
+  const bool incremental = CanSaveIncrementally(path);
+  SavedFile& saved_file = m_saved_files[path];
+  std::vector<IndexEntry>& index = saved_file.index;
+  if (!incremental)
+    index.clear();
+  saved_file.save_id = Common::Random::GenerateValue<u64>();
+
+  bool success = true;
+  if (!index.empty())
+  {
+    const IndexEntry& last = index.back();
+    success = file.Seek(last.file_offset + last.compressed_size, File::SeekOrigin::Begin);
+  }
+
+  const auto write_block = [&file](std::span<const u8> data, u32 raw_size,
+                                   std::vector<IndexEntry>* written) {
+    written->push_back({file.Tell(), raw_size, static_cast<u32>(data.size())});
+    return file.WriteBytes(data.data(), data.size());
+  };
+
+  for (size_t i = index.size(); success && i < m_blocks.size(); ++i)
+  {
+    const Block& block = m_blocks[i];
+    if (block.compressed)
+    {
+      success = write_block(block.data, block.raw_size, &index);
+    }
+    else
+    {
+      const std::optional<std::vector<u8>> compressed = Compress(block.data);
+      success = compressed && write_block(*compressed, block.raw_size, &index);
+    }
+  }
+
+  // The tail is written as a partial block, which the next save overwrites
+  std::vector<IndexEntry> full_index = index;
+  if (success && !m_tail.empty())
+  {
+    const std::optional<std::vector<u8>> compressed = Compress(m_tail);
+    success = compressed && write_block(*compressed, static_cast<u32>(m_tail.size()), &full_index);
+  }
+
+  if (success)
+  {
+    success = file.WriteArray(state_hashes.data(), state_hashes.size());
+    const Footer footer{file.Tell(), saved_file.save_id, static_cast<u32>(full_index.size()),
+                        FOOTER_MAGIC};
+    success = success && file.WriteArray(full_index.data(), full_index.size()) &&
+              file.WriteArray(&footer, 1) && file.Flush() && file.Resize(file.Tell());
+  }
+
+  if (!success)
+    m_saved_files.erase(path);
+  return success;
+}
+}  // namespace Movie
@@ -0,0 +1,110 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <map>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+namespace File
+{
+class IOFile;
+}
+
+namespace Movie
+{
+// The input data of a movie. Full blocks are kept zstd compressed, so only the block that is being
+// recorded and the one that was read last take up their full size in memory.
+//
+// Version 1 DTM files store the input data uncompressed after the header. Version 2 files store
+// the compressed blocks instead, followed by the state hashes, an index of the blocks and a footer:
+//
+//   DTMHeader | blocks | state hashes | index | Footer
+//
+// As the index is at the end, saving the same file again only writes the blocks that changed. The
+// footer holds a random ID of the save that wrote it, so that a file that was replaced since isn't
+// taken for the one that was saved.
+class InputLog
+{
+public:
+  static constexpr size_t BLOCK_SIZE = 64 * 1024;
+  static constexpr std::array<u8, 4> FOOTER_MAGIC = {'D', 'T', 'M', 'I'};
+
+#pragma pack(push, 1)
+  struct IndexEntry
+  {
+    u64 file_offset;
+    u32 raw_size;
+    u32 compressed_size;
+  };
+  static_assert(sizeof(IndexEntry) == 16);
+
+  struct Footer
+  {
+    u64 index_offset;
+    u64 save_id;
+    u32 block_count;
+    std::array<u8, 4> magic;
+  };
+  static_assert(sizeof(Footer) == 24);
+#pragma pack(pop)
+
+  u64 GetSize() const { return m_size; }
+  bool IsEmpty() const { return m_size == 0; }
+
+  void Clear();
+  // Drops everything from the given size on
+  void Truncate(u64 size);
+  void Append(const void* data, size_t size);
+  // Returns false if the range isn't within the log
+  bool Read(u64 offset, void* data, size_t size);
+  std::vector<u8> ReadAll();
+
+  // Reads size bytes of version 1 input data from the current position
+  bool LoadRaw(File::IOFile& file, u64 size);
+  // Reads the body of a version 2 file, along with state_hash_count state hashes
+  bool LoadBlocks(File::IOFile& file, u32 state_hash_count, std::vector<u64>* state_hashes);
+  // Writes the body of a version 2 file after the header at the start of the file. If the file at
+  // path was saved before, the blocks that are already in it are kept.
+  bool Save(File::IOFile& file, const std::string& path, std::span<const u64> state_hashes);
+  // Whether Save only needs to update the end of the file at path
+  bool CanSaveIncrementally(const std::string& path) const;
+
+private:
+  struct Block
+  {
+    std::vector<u8> data;
+    u32 raw_size = 0;
+    bool compressed = true;
+  };
+
+  static std::optional<std::vector<u8>> Compress(std::span<const u8> data);
+  void CompressTail();
+  bool DecompressBlock(size_t index, std::vector<u8>* out) const;
+  void ForgetSavedBlocksFrom(size_t index);
+
+  std::vector<Block> m_blocks;
+  // The uncompressed data after the compressed blocks
+  std::vector<u8> m_tail;
+  u64 m_size = 0;
+
+  std::optional<size_t> m_cached_block;
+  std::vector<u8> m_cache;
+
+  struct SavedFile
+  {
+    // The blocks in the file that are still the same as in m_blocks
+    std::vector<IndexEntry> index;
+    u64 save_id = 0;
+  };
+
+  // Recording saves the movie next to every savestate, so there are usually a few of them
+  std::map<std::string, SavedFile> m_saved_files;
+};
+}  // namespace Movie
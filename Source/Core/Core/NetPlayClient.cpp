@@ -40,6 +40,7 @@
 #include "Core/Config/SessionSettings.h"
 #include "Core/Config/WiimoteSettings.h"
 #include "Core/ConfigManager.h"
+#include "Core/Core.h"
 #include "Core/GeckoCode.h"
 #include "Core/HW/EXI/EXI.h"
 #include "Core/HW/EXI/EXI_DeviceIPL.h"
@@ -345,6 +346,9 @@ void NetPlayClient::OnData(sf::Packet& packet)
 
   INFO_LOG_FMT(NETPLAY, "Got server message: {:x}", static_cast<u8>(mid));
 
+  if (mid == MessageID::PadData || mid == MessageID::PadHostData || mid == MessageID::WiimoteData)
+    m_input_bytes_received += packet.getDataSize();
+
   switch (mid)
   {
   case MessageID::PlayerJoin:
@@ -674,22 +678,32 @@ void NetPlayClient::OnGBAConfig(sf::Packet& packet)
   m_dialog->Update();
 }
 
+bool NetPlayClient::ReadPadStateFromPacket(sf::Packet& packet, ControllerStateDelta& delta,
+                                           PadIndex* map, GCPadStatus* pad)
+{
+  packet >> *map;
+
+  // Trusting server for good map value (>=0 && <4)
+  ControllerStateDelta::State state;
+  if (!delta.Decode(*map, packet, &state))
+  {
+    ERROR_LOG_FMT(NETPLAY, "Received invalid pad data for pad {}", *map);
+    return false;
+  }
+
+  *pad = ControllerStateDelta::ToPadStatus(state, m_gba_config.at(*map).enabled);
+  return true;
+}
+
 void NetPlayClient::OnPadData(sf::Packet& packet)
 {
   while (!packet.endOfPacket())
   {
     PadIndex map;
-    packet >> map;
-
     GCPadStatus pad;
-    packet >> pad.button;
-    if (!m_gba_config.at(map).enabled)
-    {
-      packet >> pad.analogA >> pad.analogB >> pad.stickX >> pad.stickY >> pad.substickX >>
-          pad.substickY >> pad.triggerLeft >> pad.triggerRight >> pad.isConnected;
-    }
+    if (!ReadPadStateFromPacket(packet, m_pad_data_received, &map, &pad))
+      return;
 
-    // Trusting server for good map value (>=0 && <4)
     // add to pad buffer
     m_pad_buffer.at(map).Push(pad);
     m_gc_pad_event.Set();
@@ -701,17 +715,10 @@ void NetPlayClient::OnPadHostData(sf::Packet& packet)
   while (!packet.endOfPacket())
   {
     PadIndex map;
-    packet >> map;
-
     GCPadStatus pad;
-    packet >> pad.button;
-    if (!m_gba_config.at(map).enabled)
-    {
-      packet >> pad.analogA >> pad.analogB >> pad.stickX >> pad.stickY >> pad.substickX >>
-          pad.substickY >> pad.triggerLeft >> pad.triggerRight >> pad.isConnected;
-    }
+    if (!ReadPadStateFromPacket(packet, m_pad_host_data_received, &map, &pad))
+      return;
 
-    // Trusting server for good map value (>=0 && <4)
     // write to last status
     m_last_pad_status[map] = pad;
 
@@ -730,20 +737,17 @@ void NetPlayClient::OnWiimoteData(sf::Packet& packet)
     PadIndex map;
     packet >> map;
 
+    // Trusting server for good map value (>=0 && <4)
+    ControllerStateDelta::State state;
+    const bool valid = m_wiimote_data_received.Decode(map, packet, &state);
+    ASSERT(valid);
+    if (!valid)
+      return;
+
     WiimoteEmu::SerializedWiimoteState pad;
-    packet >> pad.length;
-    ASSERT(pad.length <= pad.data.size());
-    if (pad.length <= pad.data.size())
-    {
-      for (size_t i = 0; i < pad.length; ++i)
-        packet >> pad.data[i];
-    }
-    else
-    {
-      pad.length = 0;
-    }
+    pad.length = state.length;
+    std::copy_n(state.data.begin(), state.length, pad.data.begin());
 
-    // Trusting server for good map value (>=0 && <4)
     // add to pad buffer
     m_wiimote_buffer.at(map).Push(pad);
     m_wii_pad_event.Set();
@@ -926,6 +930,7 @@ void NetPlayClient::OnStartGame(sf::Packet& packet)
     packet >> m_net_settings.sync_codes;
 
     packet >> m_net_settings.golf_mode;
+    packet >> m_net_settings.rollback;
     packet >> m_net_settings.use_fma;
     packet >> m_net_settings.hide_remote_gbas;
 
@@ -1013,8 +1018,25 @@ void NetPlayClient::OnSyncSaveData(sf::Packet& packet)
   {
   case SyncSaveDataID::Notify:
     OnSyncSaveDataNotify(packet);
+    return;
+
+  case SyncSaveDataID::Cached:
+    OnSyncSaveDataCached(packet);
+    return;
+
+  default:
     break;
+  }
+
+  // Keep the save around, so that the host doesn't need to send it again if it doesn't change
+  sf::Packet copy;
+  copy.append(packet.getData(), packet.getDataSize());
+  m_save_data_cache.emplace(
+      Common::SHA1::CalculateDigest(static_cast<const u8*>(packet.getData()), packet.getDataSize()),
+      std::move(copy));
 
+  switch (sub_id)
+  {
   case SyncSaveDataID::RawData:
     OnSyncSaveDataRaw(packet);
     break;
@@ -1044,12 +1066,39 @@ void NetPlayClient::OnSyncSaveDataNotify(sf::Packet& packet)
 
   INFO_LOG_FMT(NETPLAY, "Initializing wait for {} savegame chunks.", m_sync_save_data_count);
 
+  // Only the saves of the last synchronization can be reused
+  m_previous_save_data_cache = std::move(m_save_data_cache);
+  m_save_data_cache.clear();
+
   if (m_sync_save_data_count == 0)
     SyncSaveDataResponse(true);
   else
     m_dialog->AppendChat(Common::GetStringT("Synchronizing save data..."));
 }
 
+void NetPlayClient::OnSyncSaveDataCached(sf::Packet& packet)
+{
+  Common::SHA1::Digest digest;
+  for (u8& byte : digest)
+    packet >> byte;
+
+  auto it = m_previous_save_data_cache.find(digest);
+  if (!packet || it == m_previous_save_data_cache.end())
+  {
+    PanicAlertFmtT("Failed to find the save data that the host asked to reuse.");
+    SyncSaveDataResponse(false);
+    return;
+  }
+
+  INFO_LOG_FMT(NETPLAY, "Reusing the save data of the last synchronization.");
+
+  sf::Packet cached = std::move(it->second);
+  m_previous_save_data_cache.erase(it);
+  MessageID mid;
+  cached >> mid;
+  OnSyncSaveData(cached);
+}
+
 void NetPlayClient::OnSyncSaveDataRaw(sf::Packet& packet)
 {
   bool is_slot_a;
@@ -1693,15 +1742,11 @@ void NetPlayClient::SendChatMessage(const std::string& msg)
 
 // called from ---CPU--- thread
 void NetPlayClient::AddPadStateToPacket(const int in_game_pad, const GCPadStatus& pad,
-                                        sf::Packet& packet)
+                                        ControllerStateDelta& delta, sf::Packet& packet)
 {
   packet << static_cast<PadIndex>(in_game_pad);
-  packet << pad.button;
-  if (!m_gba_config[in_game_pad].enabled)
-  {
-    packet << pad.analogA << pad.analogB << pad.stickX << pad.stickY << pad.substickX
-           << pad.substickY << pad.triggerLeft << pad.triggerRight << pad.isConnected;
-  }
+  delta.Encode(in_game_pad,
+               ControllerStateDelta::FromPadStatus(pad, m_gba_config[in_game_pad].enabled), packet);
 }
 
 // called from ---CPU--- thread
@@ -1709,10 +1754,19 @@ void NetPlayClient::AddWiimoteStateToPacket(int in_game_pad,
                                             const WiimoteEmu::SerializedWiimoteState& state,
                                             sf::Packet& packet)
 {
+  ControllerStateDelta::State delta_state;
+  delta_state.length = state.length;
+  std::copy_n(state.data.begin(), state.length, delta_state.data.begin());
+
   packet << static_cast<PadIndex>(in_game_pad);
-  packet << state.length;
-  for (size_t i = 0; i < state.length; ++i)
-    packet << state.data[i];
+  m_wiimote_data_sent.Encode(in_game_pad, delta_state, packet);
+}
+
+// called from ---CPU--- thread
+void NetPlayClient::SendInputAsync(sf::Packet&& packet)
+{
+  m_input_bytes_sent += packet.getDataSize();
+  SendAsync(std::move(packet));
 }
 
 // called from ---GUI--- thread
@@ -1747,6 +1801,8 @@ bool NetPlayClient::StartGame(const std::string& path)
   }
 
   m_timebase_frame = 0;
+  m_rollback = m_net_settings.rollback ? std::make_unique<RollbackSession>(m_selected_game) :
+                                         nullptr;
   m_current_golfer = 1;
   m_wait_on_input = false;
 
@@ -2048,7 +2104,7 @@ bool NetPlayClient::GetNetPads(const int pad_nb, const bool batching, GCPadStatu
     }
 
     if (send_packet)
-      SendAsync(std::move(packet));
+      SendInputAsync(std::move(packet));
 
     if (m_host_input_authority)
       SendPadHostPoll(-1);
@@ -2062,7 +2118,7 @@ bool NetPlayClient::GetNetPads(const int pad_nb, const bool batching, GCPadStatu
       sf::Packet packet;
       packet << MessageID::PadData;
       if (PollLocalPad(local_pad, packet))
-        SendAsync(std::move(packet));
+        SendInputAsync(std::move(packet));
     }
 
     if (m_host_input_authority)
@@ -2096,6 +2152,25 @@ bool NetPlayClient::GetNetPads(const int pad_nb, const bool batching, GCPadStatu
     }
   }
 
+  if (m_rollback)
+  {
+    // The remote inputs that didn't arrive yet are predicted, and only waited for when too many
+    // of them are. Movies can't be recorded, as a rollback would have to undo the recording.
+    ReceiveRollbackPads(pad_nb);
+    std::optional<GCPadStatus> status;
+    while (!(status = m_rollback->PollPad(pad_nb)))
+    {
+      if (!m_is_running.IsSet())
+        return false;
+
+      m_gc_pad_event.Wait();
+      ReceiveRollbackPads(pad_nb);
+    }
+
+    *pad_status = *status;
+    return true;
+  }
+
   // Now, we either use the data pushed earlier, or wait for the
   // other clients to send it to us
   while (m_pad_buffer[pad_nb].Size() == 0)
@@ -2128,6 +2203,19 @@ u64 NetPlayClient::GetInitialRTCValue() const
   return m_initial_rtc;
 }
 
+NetPlayClient::InputTraffic NetPlayClient::GetInputTraffic() const
+{
+  return {m_input_bytes_sent.load(), m_input_bytes_received.load()};
+}
+
+// m_rollback is only replaced on the GUI thread, and GetStats doesn't need the CPU thread
+std::optional<RollbackStats> NetPlayClient::GetRollbackStats() const
+{
+  if (!m_rollback)
+    return std::nullopt;
+  return m_rollback->GetStats();
+}
+
 // called from ---CPU--- thread
 bool NetPlayClient::WiimoteUpdate(const std::span<WiimoteDataBatchEntry>& entries)
 {
@@ -2143,7 +2231,7 @@ bool NetPlayClient::WiimoteUpdate(const std::span<WiimoteDataBatchEntry>& entrie
       sf::Packet packet;
       packet << MessageID::WiimoteData;
       if (AddLocalWiimoteToBuffer(local_wiimote, *entry.state, packet))
-        SendAsync(std::move(packet));
+        SendInputAsync(std::move(packet));
     }
 
     // Now, we either use the data pushed earlier, or wait for the
@@ -2192,7 +2280,7 @@ bool NetPlayClient::PollLocalPad(const int local_pad, sf::Packet& packet)
     if (m_local_player->pid != m_current_golfer)
     {
       // add to packet
-      AddPadStateToPacket(ingame_pad, pad_status, packet);
+      AddPadStateToPacket(ingame_pad, pad_status, m_pad_data_sent, packet);
       data_added = true;
     }
     else
@@ -2202,6 +2290,18 @@ bool NetPlayClient::PollLocalPad(const int local_pad, sf::Packet& packet)
       m_first_pad_status_received[ingame_pad] = true;
     }
   }
+  else if (m_rollback)
+  {
+    // Local inputs aren't delayed. After a rollback, the inputs that were sent before are polled
+    // again instead of new ones.
+    ReceiveRollbackPads(ingame_pad);
+    if (m_rollback->NeedsInput(ingame_pad))
+    {
+      m_rollback->ReceivePad(ingame_pad, pad_status);
+      AddPadStateToPacket(ingame_pad, pad_status, m_pad_data_sent, packet);
+      data_added = true;
+    }
+  }
   else
   {
     // adjust the buffer either up or down
@@ -2212,7 +2312,7 @@ bool NetPlayClient::PollLocalPad(const int local_pad, sf::Packet& packet)
       m_pad_buffer[ingame_pad].Push(pad_status);
 
       // add to packet
-      AddPadStateToPacket(ingame_pad, pad_status, packet);
+      AddPadStateToPacket(ingame_pad, pad_status, m_pad_data_sent, packet);
       data_added = true;
     }
   }
@@ -2220,6 +2320,13 @@ bool NetPlayClient::PollLocalPad(const int local_pad, sf::Packet& packet)
   return data_added;
 }
 
+void NetPlayClient::ReceiveRollbackPads(const int pad_nb)
+{
+  GCPadStatus status;
+  while (m_pad_buffer[pad_nb].Pop(status))
+    m_rollback->ReceivePad(pad_nb, status);
+}
+
 bool NetPlayClient::AddLocalWiimoteToBuffer(const int local_wiimote,
                                             const WiimoteEmu::SerializedWiimoteState& state,
                                             sf::Packet& packet)
@@ -2285,7 +2392,7 @@ void NetPlayClient::SendPadHostPoll(const PadIndex pad_num)
 
       const GCPadStatus& pad_status = m_last_pad_status[i];
       m_pad_buffer[i].Push(pad_status);
-      AddPadStateToPacket(static_cast<int>(i), pad_status, packet);
+      AddPadStateToPacket(static_cast<int>(i), pad_status, m_pad_host_data_sent, packet);
     }
   }
   else if (m_pad_map[pad_num] != 0)
@@ -2302,11 +2409,11 @@ void NetPlayClient::SendPadHostPoll(const PadIndex pad_num)
     {
       const GCPadStatus& pad_status = m_last_pad_status[pad_num];
       m_pad_buffer[pad_num].Push(pad_status);
-      AddPadStateToPacket(pad_num, pad_status, packet);
+      AddPadStateToPacket(pad_num, pad_status, m_pad_host_data_sent, packet);
     }
   }
 
-  SendAsync(std::move(packet));
+  SendInputAsync(std::move(packet));
 }
 
 void NetPlayClient::InvokeStop()
@@ -2516,6 +2623,12 @@ void NetPlayClient::SendTimeBase()
 {
   std::lock_guard lk(crit_netplay_client);
 
+  if (netplay_client->m_rollback)
+  {
+    netplay_client->UpdateRollback();
+    return;
+  }
+
   if (netplay_client->m_timebase_frame % 60 == 0)
   {
     const sf::Uint64 timebase = SystemTimers::GetFakeTimeBase();
@@ -2531,6 +2644,36 @@ void NetPlayClient::SendTimeBase()
   netplay_client->m_timebase_frame++;
 }
 
+// called from ---CPU--- thread
+void NetPlayClient::UpdateRollback()
+{
+  if (m_rollback->OnFrame(SystemTimers::GetFakeTimeBase()))
+  {
+    // States can't be saved or loaded from within a CoreTiming event
+    Core::QueueHostJob([] {
+      Core::RunOnCPUThread(
+          [] {
+            std::lock_guard lk(crit_netplay_client);
+            if (netplay_client && netplay_client->m_rollback && Core::IsRunningAndStarted())
+              netplay_client->m_rollback->RunJob();
+          },
+          true);
+    });
+  }
+
+  // The server compares these between the clients the same way as the timebases without rollback,
+  // but only once the inputs that led to them are known, so that predictions don't desync them
+  for (const auto& [frame, checksum] : m_rollback->TakeConfirmedChecksums())
+  {
+    sf::Packet packet;
+    packet << MessageID::TimeBase;
+    packet << sf::Uint64{checksum};
+    packet << frame;
+
+    SendAsync(std::move(packet));
+  }
+}
+
 bool NetPlayClient::DoAllPlayersHaveGame()
 {
   std::lock_guard lkp(m_crit.players);
@@ -5,10 +5,12 @@
 
 #include <SFML/Network/Packet.hpp>
 #include <array>
+#include <atomic>
 #include <chrono>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <span>
 #include <string>
 #include <thread>
@@ -17,10 +19,13 @@
 #include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/Crypto/SHA1.h"
 #include "Common/Event.h"
 #include "Common/SPSCQueue.h"
 #include "Common/TraversalClient.h"
+#include "Core/NetPlayCommon.h"
 #include "Core/NetPlayProto.h"
+#include "Core/NetPlayRollback.h"
 #include "Core/SyncIdentifier.h"
 #include "InputCommon/GCPadStatus.h"
 
@@ -145,6 +150,16 @@ public:
 
   u64 GetInitialRTCValue() const;
 
+  // How many bytes of pad and Wii Remote data were sent and received so far
+  struct InputTraffic
+  {
+    u64 bytes_sent = 0;
+    u64 bytes_received = 0;
+  };
+  InputTraffic GetInputTraffic() const;
+  // Only has a value if the game runs in rollback mode
+  std::optional<RollbackStats> GetRollbackStats() const;
+
   void OnTraversalStateChanged() override;
   void OnConnectReady(ENetAddress addr) override;
   void OnConnectFailed(Common::TraversalConnectFailedReason reason) override;
@@ -202,6 +217,19 @@ protected:
   std::array<GCPadStatus, 4> m_last_pad_status{};
   std::array<bool, 4> m_first_pad_status_received{};
 
+  // Pad states are sent as deltas against the previous state of the same pad. These are only used
+  // on the CPU thread.
+  ControllerStateDelta m_pad_data_sent;
+  ControllerStateDelta m_pad_host_data_sent;
+  ControllerStateDelta m_wiimote_data_sent;
+  // These are only used on the NetPlay thread.
+  ControllerStateDelta m_pad_data_received;
+  ControllerStateDelta m_pad_host_data_received;
+  ControllerStateDelta m_wiimote_data_received;
+
+  std::atomic<u64> m_input_bytes_sent = 0;
+  std::atomic<u64> m_input_bytes_received = 0;
+
   std::chrono::time_point<std::chrono::steady_clock> m_buffer_under_target_last;
 
   NetPlayUI* m_dialog = nullptr;
@@ -255,13 +283,19 @@ private:
   void SyncCodeResponse(bool success);
 
   bool PollLocalPad(int local_pad, sf::Packet& packet);
+  void ReceiveRollbackPads(int pad_nb);
+  void UpdateRollback();
   void SendPadHostPoll(PadIndex pad_num);
 
   bool AddLocalWiimoteToBuffer(int local_wiimote, const WiimoteEmu::SerializedWiimoteState& state,
                                sf::Packet& packet);
 
   void UpdateDevices();
-  void AddPadStateToPacket(int in_game_pad, const GCPadStatus& np, sf::Packet& packet);
+  void AddPadStateToPacket(int in_game_pad, const GCPadStatus& np, ControllerStateDelta& delta,
+                           sf::Packet& packet);
+  bool ReadPadStateFromPacket(sf::Packet& packet, ControllerStateDelta& delta, PadIndex* map,
+                              GCPadStatus* pad);
+  void SendInputAsync(sf::Packet&& packet);
   void AddWiimoteStateToPacket(int in_game_pad, const WiimoteEmu::SerializedWiimoteState& np,
                                sf::Packet& packet);
   void Send(const sf::Packet& packet, u8 channel_id = DEFAULT_CHANNEL);
@@ -300,6 +334,7 @@ private:
   void OnDesyncDetected(sf::Packet& packet);
   void OnSyncSaveData(sf::Packet& packet);
   void OnSyncSaveDataNotify(sf::Packet& packet);
+  void OnSyncSaveDataCached(sf::Packet& packet);
   void OnSyncSaveDataRaw(sf::Packet& packet);
   void OnSyncSaveDataGCI(sf::Packet& packet);
   void OnSyncSaveDataWii(sf::Packet& packet);
@@ -334,6 +369,9 @@ private:
   Common::Event m_wait_on_input_event;
   u8 m_sync_save_data_count = 0;
   u8 m_sync_save_data_success_count = 0;
+  // Copies of the save data packets of the current and the last save synchronization
+  std::map<Common::SHA1::Digest, sf::Packet> m_save_data_cache;
+  std::map<Common::SHA1::Digest, sf::Packet> m_previous_save_data_cache;
   u16 m_sync_gecko_codes_count = 0;
   u16 m_sync_gecko_codes_success_count = 0;
   bool m_sync_gecko_codes_complete = false;
@@ -344,6 +382,8 @@ private:
 
   u64 m_initial_rtc = 0;
   u32 m_timebase_frame = 0;
+  // Created on the GUI thread when a game starts in rollback mode, and then used on the CPU thread
+  std::unique_ptr<RollbackSession> m_rollback;
 
   std::unique_ptr<IOS::HLE::FS::FileSystem> m_wii_sync_fs;
   std::vector<u64> m_wii_sync_titles;
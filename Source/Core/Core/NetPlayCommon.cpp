@@ -4,19 +4,75 @@
 #include "Core/NetPlayCommon.h"
 
 #include <algorithm>
+#include <memory>
 
 #include <fmt/format.h>
-#include <lzo/lzo1x.h>
+#include <zstd.h>
 
 #include "Common/FileUtil.h"
 #include "Common/IOFile.h"
 #include "Common/MsgHandler.h"
 #include "Common/SFMLHelper.h"
+#include "InputCommon/GCPadStatus.h"
 
 namespace NetPlay
 {
-constexpr u32 LZO_IN_LEN = 1024 * 64;
-constexpr u32 LZO_OUT_LEN = LZO_IN_LEN + (LZO_IN_LEN / 16) + 64 + 3;
+// Data is compressed in chunks of this size, so that the receiver knows how large every
+// decompressed chunk can get
+constexpr u32 COMPRESSION_CHUNK_SIZE = 1024 * 128;
+constexpr int COMPRESSION_LEVEL = 3;
+
+static bool CompressChunkIntoPacket(ZSTD_CCtx* context, const u8* data, size_t size,
+                                    std::vector<u8>& out_buffer, sf::Packet& packet)
+{
+  const size_t out_len = ZSTD_compressCCtx(context, out_buffer.data(), out_buffer.size(), data,
+                                           size, COMPRESSION_LEVEL);
+  if (ZSTD_isError(out_len))
+  {
+    PanicAlertFmtT("Internal Zstandard Error - compression failed");
+    return false;
+  }
+
+  packet << static_cast<u32>(out_len);
+  packet.append(out_buffer.data(), out_len);
+  return true;
+}
+
+static bool DecompressChunkFromPacket(ZSTD_DCtx* context, sf::Packet& packet,
+                                      std::vector<u8>& in_buffer, std::vector<u8>& out_buffer,
+                                      size_t* out_len)
+{
+  u32 cur_len = 0;
+  packet >> cur_len;
+  if (!cur_len)
+  {
+    // We reached the end of the data stream
+    *out_len = 0;
+    return true;
+  }
+
+  if (cur_len > in_buffer.size())
+  {
+    PanicAlertFmtT("Internal Zstandard Error - decompression failed");
+    return false;
+  }
+
+  for (size_t j = 0; j < cur_len; j++)
+  {
+    packet >> in_buffer[j];
+  }
+
+  const size_t new_len =
+      ZSTD_decompressDCtx(context, out_buffer.data(), out_buffer.size(), in_buffer.data(), cur_len);
+  if (!packet || ZSTD_isError(new_len) || new_len == 0)
+  {
+    PanicAlertFmtT("Internal Zstandard Error - decompression failed");
+    return false;
+  }
+
+  *out_len = new_len;
+  return true;
+}
 
 bool CompressFileIntoPacket(const std::string& file_path, sf::Packet& packet)
 {
@@ -33,52 +89,21 @@ bool CompressFileIntoPacket(const std::string& file_path, sf::Packet& packet)
   if (size == 0)
     return true;
 
-  std::vector<u8> in_buffer(LZO_IN_LEN);
-  std::vector<u8> out_buffer(LZO_OUT_LEN);
-  std::vector<u8> wrkmem(LZO1X_1_MEM_COMPRESS);
+  std::vector<u8> in_buffer(COMPRESSION_CHUNK_SIZE);
+  std::vector<u8> out_buffer(ZSTD_compressBound(COMPRESSION_CHUNK_SIZE));
+  std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> context(ZSTD_createCCtx(), ZSTD_freeCCtx);
 
-  lzo_uint i = 0;
-  while (true)
+  for (u64 i = 0; i < size; i += COMPRESSION_CHUNK_SIZE)
   {
-    lzo_uint32 cur_len = 0;  // number of bytes to read
-    lzo_uint out_len = 0;    // number of bytes to write
-
-    if ((i + LZO_IN_LEN) >= size)
-    {
-      cur_len = static_cast<lzo_uint32>(size - i);
-    }
-    else
-    {
-      cur_len = LZO_IN_LEN;
-    }
-
-    if (cur_len <= 0)
-      break;  // EOF
-
+    const size_t cur_len = static_cast<size_t>(std::min<u64>(size - i, COMPRESSION_CHUNK_SIZE));
     if (!file.ReadBytes(in_buffer.data(), cur_len))
     {
       PanicAlertFmtT("Error reading file: {0}", file_path.c_str());
       return false;
     }
 
-    if (lzo1x_1_compress(in_buffer.data(), cur_len, out_buffer.data(), &out_len, wrkmem.data()) !=
-        LZO_E_OK)
-    {
-      PanicAlertFmtT("Internal LZO Error - compression failed");
+    if (!CompressChunkIntoPacket(context.get(), in_buffer.data(), cur_len, out_buffer, packet))
       return false;
-    }
-
-    // The size of the data to write is 'out_len'
-    packet << static_cast<u32>(out_len);
-    for (size_t j = 0; j < out_len; j++)
-    {
-      packet << out_buffer[j];
-    }
-
-    if (cur_len != LZO_IN_LEN)
-      break;
-
-    i += cur_len;
   }
 
   // Mark end of data
@@ -124,45 +149,14 @@ bool CompressBufferIntoPacket(const std::vector<u8>& in_buffer, sf::Packet& pack
   if (size == 0)
     return true;
 
-  std::vector<u8> out_buffer(LZO_OUT_LEN);
-  std::vector<u8> wrkmem(LZO1X_1_MEM_COMPRESS);
+  std::vector<u8> out_buffer(ZSTD_compressBound(COMPRESSION_CHUNK_SIZE));
+  std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> context(ZSTD_createCCtx(), ZSTD_freeCCtx);
 
-  lzo_uint i = 0;
-  while (true)
+  for (size_t i = 0; i < in_buffer.size(); i += COMPRESSION_CHUNK_SIZE)
   {
-    lzo_uint32 cur_len = 0;  // number of bytes to read
-    lzo_uint out_len = 0;    // number of bytes to write
-
-    if ((i + LZO_IN_LEN) >= size)
-    {
-      cur_len = static_cast<lzo_uint32>(size - i);
-    }
-    else
-    {
-      cur_len = LZO_IN_LEN;
-    }
-
-    if (cur_len <= 0)
-      break;  // end of buffer
-
-    if (lzo1x_1_compress(&in_buffer[i], cur_len, out_buffer.data(), &out_len, wrkmem.data()) !=
-        LZO_E_OK)
-    {
-      PanicAlertFmtT("Internal LZO Error - compression failed");
+    const size_t cur_len = std::min<size_t>(in_buffer.size() - i, COMPRESSION_CHUNK_SIZE);
+    if (!CompressChunkIntoPacket(context.get(), &in_buffer[i], cur_len, out_buffer, packet))
       return false;
-    }
-
-    // The size of the data to write is 'out_len'
-    packet << static_cast<u32>(out_len);
-    for (size_t j = 0; j < out_len; j++)
-    {
-      packet << out_buffer[j];
-    }
-
-    if (cur_len != LZO_IN_LEN)
-      break;
-
-    i += cur_len;
   }
 
   // Mark end of data
@@ -185,29 +179,17 @@ bool DecompressPacketIntoFile(sf::Packet& packet, const std::string& file_path)
     return false;
   }
 
-  std::vector<u8> in_buffer(LZO_OUT_LEN);
-  std::vector<u8> out_buffer(LZO_IN_LEN);
+  std::vector<u8> in_buffer(ZSTD_compressBound(COMPRESSION_CHUNK_SIZE));
+  std::vector<u8> out_buffer(COMPRESSION_CHUNK_SIZE);
+  std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> context(ZSTD_createDCtx(), ZSTD_freeDCtx);
 
   while (true)
   {
-    u32 cur_len = 0;       // number of bytes to read
-    lzo_uint new_len = 0;  // number of bytes to write
-
-    packet >> cur_len;
-    if (!cur_len)
-      break;  // We reached the end of the data stream
-
-    for (size_t j = 0; j < cur_len; j++)
-    {
-      packet >> in_buffer[j];
-    }
-
-    if (lzo1x_decompress(in_buffer.data(), cur_len, out_buffer.data(), &new_len, nullptr) !=
-        LZO_E_OK)
-    {
-      PanicAlertFmtT("Internal LZO Error - decompression failed");
+    size_t new_len = 0;
+    if (!DecompressChunkFromPacket(context.get(), packet, in_buffer, out_buffer, &new_len))
       return false;
-    }
+    if (new_len == 0)
+      break;
 
     if (!file.WriteBytes(out_buffer.data(), new_len))
     {
@@ -264,37 +246,125 @@ std::optional<std::vector<u8>> DecompressPacketIntoBuffer(sf::Packet& packet)
 {
   u64 size = Common::PacketReadU64(packet);
 
-  std::vector<u8> out_buffer(size);
+  std::vector<u8> out_buffer;
+  out_buffer.reserve(size);
 
   if (size == 0)
     return out_buffer;
 
-  std::vector<u8> in_buffer(LZO_OUT_LEN);
+  std::vector<u8> in_buffer(ZSTD_compressBound(COMPRESSION_CHUNK_SIZE));
+  std::vector<u8> chunk_buffer(COMPRESSION_CHUNK_SIZE);
+  std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> context(ZSTD_createDCtx(), ZSTD_freeDCtx);
 
-  lzo_uint i = 0;
   while (true)
   {
-    u32 cur_len = 0;       // number of bytes to read
-    lzo_uint new_len = 0;  // number of bytes to write
-
-    packet >> cur_len;
-    if (!cur_len)
-      break;  // We reached the end of the data stream
+    size_t new_len = 0;
+    if (!DecompressChunkFromPacket(context.get(), packet, in_buffer, chunk_buffer, &new_len))
+      return {};
+    if (new_len == 0)
+      break;
 
-    for (size_t j = 0; j < cur_len; j++)
+    if (new_len > size - out_buffer.size())
     {
-      packet >> in_buffer[j];
+      PanicAlertFmtT("Internal Zstandard Error - decompression failed");
+      return {};
     }
+    out_buffer.insert(out_buffer.end(), chunk_buffer.begin(), chunk_buffer.begin() + new_len);
+  }
+
+  out_buffer.resize(size);
+  return out_buffer;
+}
+
+void ControllerStateDelta::Encode(size_t controller, const State& state, sf::Packet& packet)
+{
+  State& previous = m_previous.at(controller);
+
+  // A bit for every byte that changed, followed by the changed bytes
+  std::array<u8, (MAX_STATE_SIZE + 7) / 8> changed{};
+  for (size_t i = 0; i < state.length; ++i)
+  {
+    if (state.data[i] != previous.data[i])
+      changed[i / 8] |= 1 << (i % 8);
+  }
+
+  packet << state.length;
+  for (size_t i = 0; i < (state.length + 7u) / 8; ++i)
+    packet << changed[i];
+  for (size_t i = 0; i < state.length; ++i)
+  {
+    if (changed[i / 8] & (1 << (i % 8)))
+      packet << state.data[i];
+  }
+
+  // Bytes past the length are kept as they were, the same as in Decode
+  previous.length = state.length;
+  std::copy_n(state.data.begin(), state.length, previous.data.begin());
+}
+
+bool ControllerStateDelta::Decode(size_t controller, sf::Packet& packet, State* state)
+{
+  if (controller >= m_previous.size())
+    return false;
+  State& previous = m_previous[controller];
 
-    if (lzo1x_decompress(in_buffer.data(), cur_len, &out_buffer[i], &new_len, nullptr) != LZO_E_OK)
+  u8 length;
+  packet >> length;
+  if (!packet || length > MAX_STATE_SIZE)
+    return false;
+
+  std::array<u8, (MAX_STATE_SIZE + 7) / 8> changed{};
+  for (size_t i = 0; i < (length + 7u) / 8; ++i)
+    packet >> changed[i];
+
+  previous.length = length;
+  for (size_t i = 0; i < length; ++i)
+  {
+    if (changed[i / 8] & (1 << (i % 8)))
+      packet >> previous.data[i];
+  }
+
+  if (!packet)
+    return false;
+
+  *state = previous;
+  return true;
+}
+
+ControllerStateDelta::State ControllerStateDelta::FromPadStatus(const GCPadStatus& pad, bool gba)
+{
+  State state;
+  state.data[0] = static_cast<u8>(pad.button >> 8);
+  state.data[1] = static_cast<u8>(pad.button);
+  state.length = 2;
+  if (!gba)
+  {
+    for (const u8 value : {pad.analogA, pad.analogB, pad.stickX, pad.stickY, pad.substickX,
+                           pad.substickY, pad.triggerLeft, pad.triggerRight,
+                           static_cast<u8>(pad.isConnected)})
     {
-      PanicAlertFmtT("Internal LZO Error - decompression failed");
-      return {};
+      state.data[state.length++] = value;
     }
-
-    i += new_len;
   }
+  return state;
+}
 
-  return out_buffer;
+GCPadStatus ControllerStateDelta::ToPadStatus(const State& state, bool gba)
+{
+  GCPadStatus pad;
+  pad.button = static_cast<u16>((state.data[0] << 8) | state.data[1]);
+  if (!gba)
+  {
+    pad.analogA = state.data[2];
+    pad.analogB = state.data[3];
+    pad.stickX = state.data[4];
+    pad.stickY = state.data[5];
+    pad.substickX = state.data[6];
+    pad.substickY = state.data[7];
+    pad.triggerLeft = state.data[8];
+    pad.triggerRight = state.data[9];
+    pad.isConnected = state.data[10] != 0;
+  }
+  return pad;
 }
 }  // namespace NetPlay
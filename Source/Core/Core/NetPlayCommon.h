@@ -13,6 +13,8 @@
 
 #include "Common/CommonTypes.h"
 
+struct GCPadStatus;
+
 namespace NetPlay
 {
 using namespace std::chrono_literals;
@@ -26,4 +28,32 @@ bool CompressBufferIntoPacket(const std::vector<u8>& in_buffer, sf::Packet& pack
 bool DecompressPacketIntoFile(sf::Packet& packet, const std::string& file_path);
 bool DecompressPacketIntoFolder(sf::Packet& packet, const std::string& folder_path);
 std::optional<std::vector<u8>> DecompressPacketIntoBuffer(sf::Packet& packet);
+
+// Sends the states of controllers as the bytes that changed since the previous state of the same
+// controller. Every direction of a connection keeps one of these per kind of message on both ends,
+// so the receiving end has to decode every state that the sending end encoded.
+class ControllerStateDelta
+{
+public:
+  // The size of a serialized Wii Remote state, which is the largest state
+  static constexpr size_t MAX_STATE_SIZE = 24;
+  static constexpr size_t MAX_CONTROLLERS = 4;
+
+  struct State
+  {
+    u8 length = 0;
+    std::array<u8, MAX_STATE_SIZE> data{};
+  };
+
+  void Encode(size_t controller, const State& state, sf::Packet& packet);
+  // Returns false if the packet doesn't hold a valid state.
+  bool Decode(size_t controller, sf::Packet& packet, State* state);
+
+  // GameCube pads that are GBAs only send their buttons
+  static State FromPadStatus(const GCPadStatus& pad, bool gba);
+  static GCPadStatus ToPadStatus(const State& state, bool gba);
+
+private:
+  std::array<State, MAX_CONTROLLERS> m_previous{};
+};
 }  // namespace NetPlay
@@ -103,6 +103,7 @@ struct NetSettings
   bool sync_codes = false;
   std::string save_data_region;
   bool golf_mode = false;
+  bool rollback = false;
   bool use_fma = false;
   bool hide_remote_gbas = false;
 
@@ -204,7 +205,8 @@ enum class SyncSaveDataID : u8
   RawData = 3,
   GCIData = 4,
   WiiData = 5,
-  GBAData = 6
+  GBAData = 6,
+  Cached = 7
 };
 
 enum class SyncCodeID : u8
@@ -0,0 +1,455 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/NetPlayRollback.h"
+
+#include <algorithm>
+#include <iterator>
+#include <tuple>
+#include <unordered_set>
+
+#include "Common/Hash.h"
+#include "Common/Logging/Log.h"
+#include "Core/Core.h"
+#include "Core/CoreTiming.h"
+#include "Core/HW/Memmap.h"
+#include "Core/State.h"
+#include "Core/StateDelta.h"
+#include "Core/System.h"
+#include "VideoCommon/Present.h"
+
+namespace NetPlay
+{
+static bool IsSamePadStatus(const GCPadStatus& a, const GCPadStatus& b)
+{
+  return std::tie(a.button, a.stickX, a.stickY, a.substickX, a.substickY, a.triggerLeft,
+                  a.triggerRight, a.analogA, a.analogB, a.isConnected) ==
+         std::tie(b.button, b.stickX, b.stickY, b.substickX, b.substickY, b.triggerLeft,
+                  b.triggerRight, b.analogA, b.analogB, b.isConnected);
+}
+
+void RollbackInputHistory::Clear()
+{
+  m_pads = {};
+}
+
+bool RollbackInputHistory::Receive(size_t pad, const GCPadStatus& status)
+{
+  Pad& p = m_pads.at(pad);
+  const u64 index = p.GetReceivedEnd();
+
+  bool predicted_correctly = true;
+  if (!p.predicted.empty())
+  {
+    predicted_correctly = IsSamePadStatus(p.predicted.front(), status);
+    p.predicted.pop_front();
+    if (!predicted_correctly && !p.mispredicted)
+      p.mispredicted = index;
+  }
+
+  p.received.push_back(status);
+  p.last_received = status;
+  return predicted_correctly;
+}
+
+std::optional<GCPadStatus> RollbackInputHistory::Poll(size_t pad)
+{
+  Pad& p = m_pads.at(pad);
+
+  if (p.position < p.GetReceivedEnd())
+    return p.received[p.position++ - p.first_received];
+
+  if (p.predicted.size() >= MAX_PREDICTED_INPUTS)
+    return std::nullopt;
+
+  p.predicted.push_back(p.last_received);
+  ++p.position;
+  return p.last_received;
+}
+
+bool RollbackInputHistory::IsPolledUpToReceived(size_t pad) const
+{
+  const Pad& p = m_pads.at(pad);
+  return p.position >= p.GetReceivedEnd();
+}
+
+RollbackInputHistory::Positions RollbackInputHistory::GetPositions() const
+{
+  Positions positions;
+  for (size_t i = 0; i < MAX_PADS; ++i)
+    positions[i] = m_pads[i].position;
+  return positions;
+}
+
+bool RollbackInputHistory::IsReceived(const Positions& positions) const
+{
+  for (size_t i = 0; i < MAX_PADS; ++i)
+  {
+    if (positions[i] > m_pads[i].GetReceivedEnd())
+      return false;
+  }
+  return true;
+}
+
+bool RollbackInputHistory::IsMispredicted() const
+{
+  return std::any_of(m_pads.begin(), m_pads.end(),
+                     [](const Pad& p) { return p.mispredicted.has_value(); });
+}
+
+bool RollbackInputHistory::CanRollBackTo(const Positions& positions) const
+{
+  for (size_t i = 0; i < MAX_PADS; ++i)
+  {
+    const Pad& p = m_pads[i];
+    if (p.mispredicted && positions[i] > *p.mispredicted)
+      return false;
+    // The received inputs before the position have to be there to be polled again
+    if (positions[i] < p.first_received)
+      return false;
+  }
+  return true;
+}
+
+void RollbackInputHistory::RollBack(const Positions& positions)
+{
+  for (size_t i = 0; i < MAX_PADS; ++i)
+  {
+    Pad& p = m_pads[i];
+    p.position = positions[i];
+    p.mispredicted.reset();
+
+    // The predictions that were polled before the position are part of the emulated state again
+    const u64 received_end = p.GetReceivedEnd();
+    const size_t still_predicted =
+        p.position > received_end ? static_cast<size_t>(p.position - received_end) : 0;
+    p.predicted.resize(std::min(p.predicted.size(), still_predicted));
+  }
+}
+
+void RollbackInputHistory::Forget(const Positions& positions)
+{
+  for (size_t i = 0; i < MAX_PADS; ++i)
+  {
+    Pad& p = m_pads[i];
+    while (!p.received.empty() && p.first_received < positions[i])
+    {
+      p.received.pop_front();
+      ++p.first_received;
+    }
+  }
+}
+
+RollbackDeterminismChecker::RollbackDeterminismChecker(const SyncIdentifier& game)
+    : m_seed(GetSeed(game))
+{
+}
+
+u64 RollbackDeterminismChecker::GetSeed(const SyncIdentifier& game)
+{
+  // FNV-1a over everything that makes the game sync differently
+  u64 seed = 0xcbf29ce484222325;
+  const auto add = [&seed](u64 value, size_t size) {
+    for (size_t i = 0; i < size; ++i)
+      seed = (seed ^ ((value >> (i * 8)) & 0xff)) * 0x100000001b3;
+  };
+
+  add(game.dol_elf_size, sizeof(game.dol_elf_size));
+  for (char c : game.game_id)
+    add(static_cast<u8>(c), 1);
+  add(game.revision, sizeof(game.revision));
+  add(game.disc_number, sizeof(game.disc_number));
+  add(game.is_datel, 1);
+  for (u8 byte : game.sync_hash)
+    add(byte, 1);
+  return seed;
+}
+
+void RollbackDeterminismChecker::Record(u32 frame, u64 timebase, u64 memory_hash,
+                                        const RollbackInputHistory::Positions& positions)
+{
+  u64 value = m_seed;
+  for (const u64 part : {timebase, memory_hash})
+    value = (value ^ part) * 0x100000001b3;
+
+  m_pending.push_back(Checksum{frame, value, positions});
+}
+
+void RollbackDeterminismChecker::RollBack(u32 frame)
+{
+  while (!m_pending.empty() && m_pending.back().frame >= frame)
+    m_pending.pop_back();
+}
+
+std::vector<std::pair<u32, u64>>
+RollbackDeterminismChecker::TakeConfirmed(const RollbackInputHistory& history)
+{
+  std::vector<std::pair<u32, u64>> confirmed;
+  while (!m_pending.empty() && history.IsReceived(m_pending.front().positions) &&
+         history.CanRollBackTo(m_pending.front().positions))
+  {
+    const Checksum& checksum = m_pending.front();
+    if (!m_last_confirmed_frame || checksum.frame > *m_last_confirmed_frame)
+    {
+      confirmed.emplace_back(checksum.frame, checksum.value);
+      m_last_confirmed_frame = checksum.frame;
+    }
+    m_pending.pop_front();
+  }
+  return confirmed;
+}
+
+RollbackSession::RollbackSession(const SyncIdentifier& game) : m_checker(game)
+{
+}
+
+RollbackSession::~RollbackSession()
+{
+  // Don't leave the emulation running unthrottled and hidden
+  if (m_resimulating)
+    FinishResimulation();
+}
+
+void RollbackSession::ReceivePad(size_t pad, const GCPadStatus& status)
+{
+  if (!m_history.Receive(pad, status))
+    ++m_counters.mispredicted_inputs;
+}
+
+std::optional<GCPadStatus> RollbackSession::PollPad(size_t pad)
+{
+  // Without a state to roll back to, nothing can be predicted
+  const bool received = !m_history.IsPolledUpToReceived(pad);
+  if (!received && m_captures.empty())
+    return std::nullopt;
+
+  const std::optional<GCPadStatus> status = m_history.Poll(pad);
+  if (status && !received)
+    ++m_counters.predicted_inputs;
+  return status;
+}
+
+bool RollbackSession::NeedsInput(size_t pad) const
+{
+  return m_history.IsPolledUpToReceived(pad);
+}
+
+bool RollbackSession::OnFrame(u64 timebase)
+{
+  auto& system = Core::System::GetInstance();
+
+  if (m_resimulating && system.GetCoreTiming().GetTicks() >= m_resimulate_until_ticks)
+    FinishResimulation();
+
+  if (m_frame % RollbackDeterminismChecker::CHECKSUM_INTERVAL == 0)
+  {
+    // The GPU thread writes to memory at different times on every client in dual core mode
+    u64 memory_hash = 0;
+    if (!system.IsDualCoreMode())
+    {
+      auto& memory = system.GetMemory();
+      memory_hash = Common::GetHash64(memory.GetRAM(), memory.GetRamSize(), 0);
+    }
+    m_checker.Record(m_frame, timebase, memory_hash, m_history.GetPositions());
+  }
+  ++m_frame;
+
+  UpdateStats();
+
+  if (m_job_queued)
+    return false;
+  m_job_queued = true;
+  return true;
+}
+
+void RollbackSession::RunJob()
+{
+  m_job_queued = false;
+
+  if (m_history.IsMispredicted())
+    RollBack();
+  else
+    CaptureState();
+
+  UpdateStats();
+}
+
+std::vector<std::pair<u32, u64>> RollbackSession::TakeConfirmedChecksums()
+{
+  return m_checker.TakeConfirmed(m_history);
+}
+
+RollbackStats RollbackSession::GetStats() const
+{
+  std::lock_guard lk(m_stats_mutex);
+  return m_stats;
+}
+
+void RollbackSession::CaptureState()
+{
+  const auto start = std::chrono::steady_clock::now();
+
+  Capture capture;
+  capture.serial = m_next_serial++;
+  capture.ticks = Core::System::GetInstance().GetCoreTiming().GetTicks();
+  capture.frame = m_frame;
+  capture.positions = m_history.GetPositions();
+
+  const bool keyframe = m_base_serial == 0 || m_force_keyframe;
+  capture.keyframe_serial = keyframe ? capture.serial : m_base_serial;
+  if (!State::SaveToBuffer(capture.buffer,
+                           keyframe ? State::StateType::Keyframe : State::StateType::Delta,
+                           State::DeltaBase::Rollback))
+  {
+    ERROR_LOG_FMT(NETPLAY, "Failed to capture a state for rollback");
+    return;
+  }
+
+  if (keyframe)
+  {
+    m_base_serial = capture.serial;
+    m_base_size = capture.buffer.size();
+  }
+  // Deltas grow as more pages differ from the keyframe, start a new one once they stop being much
+  // smaller than it
+  m_force_keyframe = !keyframe && capture.buffer.size() > m_base_size / 2;
+
+  m_captures.push_back(std::move(capture));
+  DropUnneededCaptures();
+
+  m_counters.last_capture_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                                   std::chrono::steady_clock::now() - start)
+                                   .count();
+}
+
+void RollbackSession::DropUnneededCaptures()
+{
+  // Nothing is mispredicted at this point, so inputs that were received won't cause a rollback
+  // anymore. The newest capture that only depends on received inputs is the oldest one that can be
+  // rolled back to.
+  const auto oldest_needed =
+      std::find_if(m_captures.rbegin(), m_captures.rend(), [this](const Capture& capture) {
+        return m_history.IsReceived(capture.positions);
+      });
+  if (oldest_needed == m_captures.rend())
+    return;
+
+  const auto first_kept = std::prev(oldest_needed.base());
+  std::unordered_set<u64> needed_keyframes;
+  for (auto it = first_kept; it != m_captures.end(); ++it)
+    needed_keyframes.insert(it->keyframe_serial);
+
+  m_history.Forget(first_kept->positions);
+
+  // Older deltas can't be rolled back to anymore, but their keyframes may still be needed to load
+  // the deltas that are kept
+  const auto end =
+      std::remove_if(m_captures.begin(), first_kept, [&needed_keyframes](const Capture& capture) {
+        return !capture.IsKeyframe() || !needed_keyframes.contains(capture.serial);
+      });
+  m_captures.erase(end, first_kept);
+}
+
+bool RollbackSession::LoadCapture(const Capture& capture)
+{
+  const State::CaptureLoad load =
+      State::GetCaptureLoad(capture.serial, capture.keyframe_serial, m_base_serial);
+  if (load.load_keyframe)
+  {
+    const auto keyframe = std::find_if(m_captures.begin(), m_captures.end(), [&](const Capture& c) {
+      return c.serial == capture.keyframe_serial;
+    });
+    // LoadFromRollbackBuffer takes a non-const buffer, but only reads from it
+    if (keyframe == m_captures.end() ||
+        !State::LoadFromRollbackBuffer(const_cast<std::vector<u8>&>(keyframe->buffer),
+                                       State::StateType::Keyframe))
+    {
+      return false;
+    }
+    m_base_serial = keyframe->serial;
+    m_base_size = keyframe->buffer.size();
+  }
+
+  return !load.load_delta ||
+         State::LoadFromRollbackBuffer(const_cast<std::vector<u8>&>(capture.buffer),
+                                       State::StateType::Delta);
+}
+
+void RollbackSession::RollBack()
+{
+  const auto start = std::chrono::steady_clock::now();
+  const u64 ticks = Core::System::GetInstance().GetCoreTiming().GetTicks();
+
+  ++m_counters.rollbacks;
+
+  // The newest capture from before every mispredicted input
+  const auto target =
+      std::find_if(m_captures.rbegin(), m_captures.rend(), [this](const Capture& capture) {
+        return m_history.CanRollBackTo(capture.positions);
+      });
+  if (target == m_captures.rend() || !LoadCapture(*target))
+  {
+    ERROR_LOG_FMT(NETPLAY, "Failed to roll back to a state from before a mispredicted input");
+    ++m_counters.failed_rollbacks;
+    m_history.RollBack(m_history.GetPositions());
+    m_captures.clear();
+    m_base_serial = 0;
+    return;
+  }
+
+  const u32 frame = target->frame;
+  INFO_LOG_FMT(NETPLAY, "Rolling back from frame {} to frame {}", m_frame, frame);
+
+  m_counters.resimulated_frames += m_frame - frame;
+  if (!m_resimulating)
+  {
+    m_resimulating = true;
+    m_resimulation_start = start;
+    m_resimulation_start_frame = m_frame;
+    m_counters.last_resimulated_frames = 0;
+  }
+  m_counters.last_resimulated_frames += m_frame - frame;
+  m_resimulate_until_ticks = std::max(m_resimulate_until_ticks, ticks);
+
+  m_history.RollBack(target->positions);
+  m_checker.RollBack(frame);
+  m_frame = frame;
+
+  // The newer captures are of the mispredicted inputs. Their keyframes can go too, as the base
+  // is the keyframe of the target now.
+  m_captures.erase(target.base(), m_captures.end());
+
+  // Catch up as fast as possible without presenting the frames that were already shown
+  Core::SetIsThrottlerTempDisabled(true);
+  if (g_presenter)
+    g_presenter->SetSkipPresenting(true);
+}
+
+void RollbackSession::FinishResimulation()
+{
+  m_resimulating = false;
+  Core::SetIsThrottlerTempDisabled(false);
+  if (g_presenter)
+    g_presenter->SetSkipPresenting(false);
+
+  const u64 resimulation_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                                  std::chrono::steady_clock::now() - m_resimulation_start)
+                                  .count();
+  m_counters.last_resimulation_us = resimulation_us;
+  m_counters.resimulation_us += resimulation_us;
+
+  DEBUG_LOG_FMT(NETPLAY, "Caught up with frame {} after {} us", m_resimulation_start_frame,
+                resimulation_us);
+}
+
+void RollbackSession::UpdateStats()
+{
+  m_counters.state_count = m_captures.size();
+  m_counters.state_memory_usage = 0;
+  for (const Capture& capture : m_captures)
+    m_counters.state_memory_usage += capture.buffer.size();
+
+  std::lock_guard lk(m_stats_mutex);
+  m_stats = m_counters;
+}
+}  // namespace NetPlay
@@ -0,0 +1,198 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Rollback support for NetPlay. Instead of waiting for the inputs of remote players, their inputs
+// are predicted to repeat the last one that arrived. When an input turns out to be mispredicted,
+// the emulation is rolled back to an in-memory state from before it and run again with the
+// inputs that arrived, without presenting the frames until it has caught up.
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Core/SyncIdentifier.h"
+#include "InputCommon/GCPadStatus.h"
+
+namespace NetPlay
+{
+struct RollbackStats
+{
+  u64 predicted_inputs = 0;
+  u64 mispredicted_inputs = 0;
+  u64 rollbacks = 0;
+  // Rollbacks without a state from before the mispredicted input, which desync the emulation
+  u64 failed_rollbacks = 0;
+  u64 resimulated_frames = 0;
+  // Wall time spent loading states and running the emulation again
+  u64 resimulation_us = 0;
+  u64 last_resimulation_us = 0;
+  u32 last_resimulated_frames = 0;
+  // The states that are kept around to roll back to, and their size
+  size_t state_count = 0;
+  size_t state_memory_usage = 0;
+  u64 last_capture_us = 0;
+};
+
+// The inputs of every in-game pad in the order that they are polled in, which is the same on all
+// clients. A position is the number of polls of every pad so far.
+class RollbackInputHistory
+{
+public:
+  static constexpr size_t MAX_PADS = 4;
+  // After this many, the remote player is waited for, the same as without rollback
+  static constexpr size_t MAX_PREDICTED_INPUTS = 8;
+
+  using Positions = std::array<u64, MAX_PADS>;
+
+  void Clear();
+
+  // Adds the next input of a pad that was received. Returns false if it was predicted differently.
+  bool Receive(size_t pad, const GCPadStatus& status);
+  // Returns the input for the next poll of a pad, predicted if it wasn't received yet. Returns
+  // nothing if too many inputs of the pad are predicted already.
+  std::optional<GCPadStatus> Poll(size_t pad);
+  // Whether the next poll of a pad is past the inputs that were received
+  bool IsPolledUpToReceived(size_t pad) const;
+
+  Positions GetPositions() const;
+  // Whether all inputs before the positions were received
+  bool IsReceived(const Positions& positions) const;
+  bool IsMispredicted() const;
+  // Whether all inputs before the positions were predicted correctly
+  bool CanRollBackTo(const Positions& positions) const;
+  // Makes the positions the current ones, and forgets about the mispredictions
+  void RollBack(const Positions& positions);
+  // The received inputs before the positions won't be polled again
+  void Forget(const Positions& positions);
+
+private:
+  struct Pad
+  {
+    // The received inputs, the first one being the input of poll first_received
+    std::deque<GCPadStatus> received;
+    u64 first_received = 0;
+    // The inputs that were polled past the received ones
+    std::deque<GCPadStatus> predicted;
+    u64 position = 0;
+    std::optional<u64> mispredicted;
+    GCPadStatus last_received;
+
+    u64 GetReceivedEnd() const { return first_received + received.size(); }
+  };
+
+  std::array<Pad, MAX_PADS> m_pads;
+};
+
+// Collects checksums of the emulated state every few frames, and hands them out once the inputs
+// that led to them were received. The checksums are seeded with the SyncIdentifier of the game,
+// so that they only match between clients that run the same game.
+class RollbackDeterminismChecker
+{
+public:
+  static constexpr u32 CHECKSUM_INTERVAL = 60;
+
+  explicit RollbackDeterminismChecker(const SyncIdentifier& game);
+
+  static u64 GetSeed(const SyncIdentifier& game);
+
+  // memory_hash is 0 if the memory can't be compared between clients
+  void Record(u32 frame, u64 timebase, u64 memory_hash,
+              const RollbackInputHistory::Positions& positions);
+  // The frames from this one on are emulated again
+  void RollBack(u32 frame);
+  std::vector<std::pair<u32, u64>> TakeConfirmed(const RollbackInputHistory& history);
+
+private:
+  struct Checksum
+  {
+    u32 frame;
+    u64 value;
+    RollbackInputHistory::Positions positions;
+  };
+
+  u64 m_seed;
+  std::deque<Checksum> m_pending;
+  // Frames are only handed out once, even if they are emulated again
+  std::optional<u32> m_last_confirmed_frame;
+};
+
+// Keeps the states to roll back to and does the rollbacks. Everything but GetStats is called on
+// the CPU thread.
+class RollbackSession
+{
+public:
+  explicit RollbackSession(const SyncIdentifier& game);
+  ~RollbackSession();
+
+  RollbackSession(const RollbackSession&) = delete;
+  RollbackSession& operator=(const RollbackSession&) = delete;
+
+  void ReceivePad(size_t pad, const GCPadStatus& status);
+  std::optional<GCPadStatus> PollPad(size_t pad);
+  // Whether the next poll of a local pad needs a new input, rather than one that was polled before
+  // a rollback
+  bool NeedsInput(size_t pad) const;
+
+  // Called for every frame from within a CoreTiming event. Returns whether RunJob should be called
+  // at the next point where the CPU thread can be paused.
+  bool OnFrame(u64 timebase);
+  // Captures a state, or rolls back if an input was mispredicted
+  void RunJob();
+
+  u32 GetFrame() const { return m_frame; }
+  bool IsResimulating() const { return m_resimulating; }
+  std::vector<std::pair<u32, u64>> TakeConfirmedChecksums();
+
+  RollbackStats GetStats() const;
+
+private:
+  struct Capture
+  {
+    std::vector<u8> buffer;
+    u64 serial = 0;
+    // The capture this one is a delta of, or its own serial for keyframes
+    u64 keyframe_serial = 0;
+    u64 ticks = 0;
+    u32 frame = 0;
+    RollbackInputHistory::Positions positions{};
+
+    bool IsKeyframe() const { return serial == keyframe_serial; }
+  };
+
+  void CaptureState();
+  void RollBack();
+  bool LoadCapture(const Capture& capture);
+  void FinishResimulation();
+  void DropUnneededCaptures();
+  void UpdateStats();
+
+  RollbackInputHistory m_history;
+  RollbackDeterminismChecker m_checker;
+  u32 m_frame = 0;
+  bool m_job_queued = false;
+
+  std::deque<Capture> m_captures;
+  u64 m_next_serial = 1;
+  // The keyframe whose memory the DeltaArrays hold as the rollback base
+  u64 m_base_serial = 0;
+  size_t m_base_size = 0;
+  bool m_force_keyframe = false;
+
+  bool m_resimulating = false;
+  u64 m_resimulate_until_ticks = 0;
+  std::chrono::steady_clock::time_point m_resimulation_start;
+  u32 m_resimulation_start_frame = 0;
+
+  // Only accessed on the CPU thread, and copied to m_stats for every frame
+  RollbackStats m_counters;
+  mutable std::mutex m_stats_mutex;
+  RollbackStats m_stats;
+};
+}  // namespace NetPlay
@@ -7,9 +7,11 @@
 #include <chrono>
 #include <cstddef>
 #include <cstdio>
+#include <future>
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <set>
 #include <string>
 #include <thread>
 #include <type_traits>
@@ -20,6 +22,7 @@
 #include <fmt/format.h>
 
 #include "Common/CommonPaths.h"
+#include "Common/Crypto/SHA1.h"
 #include "Common/ENet.h"
 #include "Common/FileUtil.h"
 #include "Common/HttpRequest.h"
@@ -792,13 +795,9 @@ unsigned int NetPlayServer::OnData(sf::Packet& packet, Client& player)
 
   case MessageID::PadData:
   {
-    // if this is pad data from the last game still being received, ignore it
-    if (player.current_game != m_current_game)
-      break;
-
-    sf::Packet spac;
-    spac << (m_host_input_authority ? MessageID::PadHostData : MessageID::PadData);
-
+    // The states are decoded even if they are from the last game, as every state has to be seen
+    // to decode the ones that follow
+    ControllerStates states;
     while (!packet.endOfPacket())
     {
       PadIndex map;
@@ -811,28 +810,32 @@ unsigned int NetPlayServer::OnData(sf::Packet& packet, Client& player)
         return 1;
       }
 
-      GCPadStatus pad;
-      packet >> pad.button;
-      spac << map << pad.button;
-      if (!m_gba_config.at(map).enabled)
-      {
-        packet >> pad.analogA >> pad.analogB >> pad.stickX >> pad.stickY >> pad.substickX >>
-            pad.substickY >> pad.triggerLeft >> pad.triggerRight >> pad.isConnected;
-
-        spac << pad.analogA << pad.analogB << pad.stickX << pad.stickY << pad.substickX
-             << pad.substickY << pad.triggerLeft << pad.triggerRight << pad.isConnected;
-      }
+      ControllerStateDelta::State state;
+      if (!player.pad_data_received.Decode(map, packet, &state))
+        return 1;
+      states.emplace_back(map, state);
     }
 
+    // if this is pad data from the last game still being received, ignore it
+    if (player.current_game != m_current_game)
+      break;
+
     if (m_host_input_authority)
     {
       // Prevent crash before game stop if the golfer disconnects
       if (m_current_golfer != 0 && m_players.find(m_current_golfer) != m_players.end())
-        Send(m_players.at(m_current_golfer).socket, spac);
+      {
+        SendControllerStates(m_players.at(m_current_golfer), MessageID::PadHostData, states,
+                             &Client::pad_host_data_sent);
+      }
     }
     else
     {
-      SendToClients(spac, player.pid);
+      for (auto& p : m_players)
+      {
+        if (p.second.pid && p.second.pid != player.pid)
+          SendControllerStates(p.second, MessageID::PadData, states, &Client::pad_data_sent);
+      }
     }
   }
   break;
@@ -843,40 +846,29 @@ unsigned int NetPlayServer::OnData(sf::Packet& packet, Client& player)
     if (m_current_golfer != 0 && player.pid != m_current_golfer)
       return 1;
 
-    sf::Packet spac;
-    spac << MessageID::PadData;
-
+    ControllerStates states;
     while (!packet.endOfPacket())
     {
       PadIndex map;
       packet >> map;
 
-      GCPadStatus pad;
-      packet >> pad.button;
-      spac << map << pad.button;
-      if (!m_gba_config.at(map).enabled)
-      {
-        packet >> pad.analogA >> pad.analogB >> pad.stickX >> pad.stickY >> pad.substickX >>
-            pad.substickY >> pad.triggerLeft >> pad.triggerRight >> pad.isConnected;
-
-        spac << pad.analogA << pad.analogB << pad.stickX << pad.stickY << pad.substickX
-             << pad.substickY << pad.triggerLeft << pad.triggerRight << pad.isConnected;
-      }
+      ControllerStateDelta::State state;
+      if (!player.pad_host_data_received.Decode(map, packet, &state))
+        return 1;
+      states.emplace_back(map, state);
     }
 
-    SendToClients(spac, player.pid);
+    for (auto& p : m_players)
+    {
+      if (p.second.pid && p.second.pid != player.pid)
+        SendControllerStates(p.second, MessageID::PadData, states, &Client::pad_data_sent);
+    }
   }
   break;
 
   case MessageID::WiimoteData:
   {
-    // if this is Wiimote data from the last game still being received, ignore it
-    if (player.current_game != m_current_game)
-      break;
-
-    sf::Packet spac;
-    spac << MessageID::WiimoteData;
-
+    ControllerStates states;
     while (!packet.endOfPacket())
     {
       PadIndex map;
@@ -889,20 +881,21 @@ unsigned int NetPlayServer::OnData(sf::Packet& packet, Client& player)
         return 1;
       }
 
-      WiimoteEmu::SerializedWiimoteState pad;
-      packet >> pad.length;
-      if (pad.length > pad.data.size())
+      ControllerStateDelta::State state;
+      if (!player.wiimote_data_received.Decode(map, packet, &state))
         return 1;
-      for (size_t i = 0; i < pad.length; ++i)
-        packet >> pad.data[i];
-
-      spac << map;
-      spac << pad.length;
-      for (size_t i = 0; i < pad.length; ++i)
-        spac << pad.data[i];
+      states.emplace_back(map, state);
     }
 
-    SendToClients(spac, player.pid);
+    // if this is Wiimote data from the last game still being received, ignore it
+    if (player.current_game != m_current_game)
+      break;
+
+    for (auto& p : m_players)
+    {
+      if (p.second.pid && p.second.pid != player.pid)
+        SendControllerStates(p.second, MessageID::WiimoteData, states, &Client::wiimote_data_sent);
+    }
   }
   break;
 
@@ -1440,6 +1433,7 @@ bool NetPlayServer::SetupNetSettings()
   settings.strict_settings_sync = Config::Get(Config::NETPLAY_STRICT_SETTINGS_SYNC);
   settings.sync_codes = Config::Get(Config::NETPLAY_SYNC_CODES);
   settings.golf_mode = Config::Get(Config::NETPLAY_NETWORK_MODE) == "golf";
+  settings.rollback = Config::Get(Config::NETPLAY_NETWORK_MODE) == "rollback";
   settings.use_fma = DoAllPlayersHaveHardwareFMA();
   settings.hide_remote_gbas = Config::Get(Config::NETPLAY_HIDE_REMOTE_GBAS);
 
@@ -1647,6 +1641,7 @@ bool NetPlayServer::StartGame()
   spac << m_settings.sync_codes;
 
   spac << m_settings.golf_mode;
+  spac << m_settings.rollback;
   spac << m_settings.use_fma;
   spac << m_settings.hide_remote_gbas;
 
@@ -1788,6 +1783,18 @@ bool NetPlayServer::SyncSaveData(const SaveSyncInfo& sync_info)
 
   m_save_data_synced_players = 0;
 
+  {
+    std::lock_guard lkp(m_crit.players);
+    const bool forget_save_data = m_forget_sent_save_data.exchange(false);
+    for (auto& [pid, client] : m_players)
+    {
+      // Clients only keep the saves of the last synchronization around
+      client.previous_save_data = forget_save_data ? std::set<Common::SHA1::Digest>{} :
+                                                     std::move(client.save_data);
+      client.save_data.clear();
+    }
+  }
+
   {
     sf::Packet pac;
     pac << MessageID::SyncSaveData;
@@ -1805,6 +1812,10 @@ bool NetPlayServer::SyncSaveData(const SaveSyncInfo& sync_info)
   const auto gamecube_region = Config::ToGameCubeRegion(game_region);
   const std::string region = Config::GetDirectoryForRegion(gamecube_region);
 
+  // Every save is read and compressed on its own thread. The futures are waited for in order, so
+  // the saves are still sent in the same order.
+  std::vector<std::pair<std::string, std::future<std::optional<sf::Packet>>>> saves;
+
   for (ExpansionInterface::Slot slot : ExpansionInterface::MEMCARD_SLOTS)
   {
     const bool is_slot_a = slot == ExpansionInterface::Slot::A;
@@ -1818,205 +1829,281 @@ bool NetPlayServer::SyncSaveData(const SaveSyncInfo& sync_info)
               Memcard::MBIT_SIZE_MEMORY_CARD_2043;
       const std::string path = Config::GetMemcardPath(slot, game_region, card_size_mbits);
 
-      sf::Packet pac;
-      pac << MessageID::SyncSaveData;
-      pac << SyncSaveDataID::RawData;
-      pac << is_slot_a << region << size_override;
-
-      if (File::Exists(path))
-      {
-        INFO_LOG_FMT(NETPLAY, "Sending data of raw memcard {} in slot {}.", path,
-                     is_slot_a ? 'A' : 'B');
-        if (!CompressFileIntoPacket(path, pac))
-          return false;
-      }
-      else
-      {
-        // No file, so we'll say the size is 0
-        INFO_LOG_FMT(NETPLAY, "Sending empty marker for raw memcard {} in slot {}.", path,
-                     is_slot_a ? 'A' : 'B');
-        pac << sf::Uint64{0};
-      }
-
-      SendChunkedToClients(std::move(pac), 1,
-                           fmt::format("Memory Card {} Synchronization", is_slot_a ? 'A' : 'B'));
+      saves.emplace_back(
+          fmt::format("Memory Card {} Synchronization", is_slot_a ? 'A' : 'B'),
+          std::async(std::launch::async, [=]() -> std::optional<sf::Packet> {
+            sf::Packet pac;
+            pac << MessageID::SyncSaveData;
+            pac << SyncSaveDataID::RawData;
+            pac << is_slot_a << region << size_override;
+
+            if (File::Exists(path))
+            {
+              INFO_LOG_FMT(NETPLAY, "Sending data of raw memcard {} in slot {}.", path,
+                           is_slot_a ? 'A' : 'B');
+              if (!CompressFileIntoPacket(path, pac))
+                return std::nullopt;
+            }
+            else
+            {
+              // No file, so we'll say the size is 0
+              INFO_LOG_FMT(NETPLAY, "Sending empty marker for raw memcard {} in slot {}.", path,
+                           is_slot_a ? 'A' : 'B');
+              pac << sf::Uint64{0};
+            }
+
+            return pac;
+          }));
     }
     else if (Config::Get(Config::GetInfoForEXIDevice(slot)) ==
              ExpansionInterface::EXIDeviceType::MemoryCardFolder)
     {
       const std::string path = Config::GetGCIFolderPath(slot, gamecube_region);
+      const std::string game_id = sync_info.game->GetGameID();
+
+      saves.emplace_back(
+          fmt::format("GCI Folder {} Synchronization", is_slot_a ? 'A' : 'B'),
+          std::async(std::launch::async, [=]() -> std::optional<sf::Packet> {
+            sf::Packet pac;
+            pac << MessageID::SyncSaveData;
+            pac << SyncSaveDataID::GCIData;
+            pac << is_slot_a;
+
+            if (File::IsDirectory(path))
+            {
+              std::vector<std::string> files =
+                  GCMemcardDirectory::GetFileNamesForGameID(path + DIR_SEP, game_id);
+
+              INFO_LOG_FMT(NETPLAY, "Sending data of GCI memcard {} in slot {} ({} files).", path,
+                           is_slot_a ? 'A' : 'B', files.size());
+
+              pac << static_cast<u8>(files.size());
+
+              for (const std::string& file : files)
+              {
+                const std::string filename = file.substr(file.find_last_of('/') + 1);
+                INFO_LOG_FMT(NETPLAY, "Sending GCI {}.", filename);
+                pac << filename;
+                if (!CompressFileIntoPacket(file, pac))
+                  return std::nullopt;
+              }
+            }
+            else
+            {
+              INFO_LOG_FMT(NETPLAY, "Sending empty marker for GCI memcard {} in slot {}.", path,
+                           is_slot_a ? 'A' : 'B');
+
+              pac << static_cast<u8>(0);
+            }
+
+            return pac;
+          }));
+    }
+  }
 
-      sf::Packet pac;
-      pac << MessageID::SyncSaveData;
-      pac << SyncSaveDataID::GCIData;
-      pac << is_slot_a;
+  if (sync_info.has_wii_save)
+  {
+    saves.emplace_back(
+        "Wii Save Synchronization",
+        std::async(std::launch::async, [&sync_info]() -> std::optional<sf::Packet> {
+          return GetWiiSaveDataPacket(sync_info);
+        }));
+  }
 
-      if (File::IsDirectory(path))
-      {
-        std::vector<std::string> files =
-            GCMemcardDirectory::GetFileNamesForGameID(path + DIR_SEP, sync_info.game->GetGameID());
+  for (size_t i = 0; i < m_gba_config.size(); ++i)
+  {
+    if (m_gba_config[i].enabled && m_gba_config[i].has_rom)
+    {
+      std::string path;
+#ifdef HAS_LIBMGBA
+      path = HW::GBA::Core::GetSavePath(Config::Get(Config::MAIN_GBA_ROM_PATHS[i]),
+                                        static_cast<int>(i));
+#endif
 
-        INFO_LOG_FMT(NETPLAY, "Sending data of GCI memcard {} in slot {} ({} files).", path,
-                     is_slot_a ? 'A' : 'B', files.size());
+      saves.emplace_back(
+          fmt::format("GBA{} Save File Synchronization", i + 1),
+          std::async(std::launch::async, [=]() -> std::optional<sf::Packet> {
+            sf::Packet pac;
+            pac << MessageID::SyncSaveData;
+            pac << SyncSaveDataID::GBAData;
+            pac << static_cast<u8>(i);
+
+            if (File::Exists(path))
+            {
+              INFO_LOG_FMT(NETPLAY, "Sending data of GBA save at {} for slot {}.", path, i);
+              if (!CompressFileIntoPacket(path, pac))
+                return std::nullopt;
+            }
+            else
+            {
+              // No file, so we'll say the size is 0
+              INFO_LOG_FMT(NETPLAY, "Sending empty marker for GBA save at {} for slot {}.", path,
+                           i);
+              pac << sf::Uint64{0};
+            }
+
+            return pac;
+          }));
+    }
+  }
 
-        pac << static_cast<u8>(files.size());
+  for (auto& [title, save] : saves)
+  {
+    std::optional<sf::Packet> pac = save.get();
+    if (!pac)
+      return false;
 
-        for (const std::string& file : files)
-        {
-          const std::string filename = file.substr(file.find_last_of('/') + 1);
-          INFO_LOG_FMT(NETPLAY, "Sending GCI {}.", filename);
-          pac << filename;
-          if (!CompressFileIntoPacket(file, pac))
-            return false;
-        }
-      }
-      else
-      {
-        INFO_LOG_FMT(NETPLAY, "Sending empty marker for GCI memcard {} in slot {}.", path,
-                     is_slot_a ? 'A' : 'B');
+    SendSaveDataToClients(std::move(*pac), title);
+  }
 
-        pac << static_cast<u8>(0);
-      }
+  return true;
+}
 
-      SendChunkedToClients(std::move(pac), 1,
-                           fmt::format("GCI Folder {} Synchronization", is_slot_a ? 'A' : 'B'));
-    }
-  }
+// Called from a save data compression thread
+std::optional<sf::Packet> NetPlayServer::GetWiiSaveDataPacket(const SaveSyncInfo& sync_info)
+{
+  sf::Packet pac;
+  pac << MessageID::SyncSaveData;
+  pac << SyncSaveDataID::WiiData;
 
-  if (sync_info.has_wii_save)
+  // Shove the Mii data into the start the packet
+  if (sync_info.mii_data)
   {
-    sf::Packet pac;
-    pac << MessageID::SyncSaveData;
-    pac << SyncSaveDataID::WiiData;
+    INFO_LOG_FMT(NETPLAY, "Sending Mii data.");
+    pac << true;
+    if (!CompressBufferIntoPacket(*sync_info.mii_data, pac))
+      return std::nullopt;
+  }
+  else
+  {
+    INFO_LOG_FMT(NETPLAY, "Not sending Mii data.");
+    pac << false;  // no mii data
+  }
 
-    // Shove the Mii data into the start the packet
-    if (sync_info.mii_data)
-    {
-      INFO_LOG_FMT(NETPLAY, "Sending Mii data.");
-      pac << true;
-      if (!CompressBufferIntoPacket(*sync_info.mii_data, pac))
-        return false;
-    }
-    else
-    {
-      INFO_LOG_FMT(NETPLAY, "Not sending Mii data.");
-      pac << false;  // no mii data
-    }
+  // Carry on with the save files
+  INFO_LOG_FMT(NETPLAY, "Sending {} Wii saves.", sync_info.wii_saves.size());
+  pac << static_cast<u32>(sync_info.wii_saves.size());
 
-    // Carry on with the save files
-    INFO_LOG_FMT(NETPLAY, "Sending {} Wii saves.", sync_info.wii_saves.size());
-    pac << static_cast<u32>(sync_info.wii_saves.size());
+  for (const auto& [title_id, storage] : sync_info.wii_saves)
+  {
+    pac << sf::Uint64{title_id};
 
-    for (const auto& [title_id, storage] : sync_info.wii_saves)
+    if (storage->SaveExists())
     {
-      pac << sf::Uint64{title_id};
+      const std::optional<WiiSave::Header> header = storage->ReadHeader();
+      const std::optional<WiiSave::BkHeader> bk_header = storage->ReadBkHeader();
+      const std::optional<std::vector<WiiSave::Storage::SaveFile>> files = storage->ReadFiles();
+      if (!header || !bk_header || !files)
+      {
+        INFO_LOG_FMT(NETPLAY, "Wii save of title {:016x} is corrupted.", title_id);
+        return std::nullopt;
+      }
 
-      if (storage->SaveExists())
+      INFO_LOG_FMT(NETPLAY, "Sending Wii save of title {:016x}.", title_id);
+      pac << true;  // save exists
+
+      // Header
+      pac << sf::Uint64{header->tid};
+      pac << header->banner_size << header->permissions << header->unk1;
+      for (u8 byte : header->md5)
+        pac << byte;
+      pac << header->unk2;
+      for (size_t i = 0; i < header->banner_size; i++)
+        pac << header->banner[i];
+
+      // BkHeader
+      pac << bk_header->size << bk_header->magic << bk_header->ngid << bk_header->number_of_files
+          << bk_header->size_of_files << bk_header->unk1 << bk_header->unk2
+          << bk_header->total_size;
+      for (u8 byte : bk_header->unk3)
+        pac << byte;
+      pac << sf::Uint64{bk_header->tid};
+      for (u8 byte : bk_header->mac_address)
+        pac << byte;
+
+      // Files
+      for (const WiiSave::Storage::SaveFile& file : *files)
       {
-        const std::optional<WiiSave::Header> header = storage->ReadHeader();
-        const std::optional<WiiSave::BkHeader> bk_header = storage->ReadBkHeader();
-        const std::optional<std::vector<WiiSave::Storage::SaveFile>> files = storage->ReadFiles();
-        if (!header || !bk_header || !files)
-        {
-          INFO_LOG_FMT(NETPLAY, "Wii save of title {:016x} is corrupted.", title_id);
-          return false;
-        }
+        INFO_LOG_FMT(NETPLAY, "Sending Wii save data of type {} at {}",
+                     static_cast<u8>(file.type), file.path);
 
-        INFO_LOG_FMT(NETPLAY, "Sending Wii save of title {:016x}.", title_id);
-        pac << true;  // save exists
+        pac << file.mode << file.attributes << file.type << file.path;
 
-        // Header
-        pac << sf::Uint64{header->tid};
-        pac << header->banner_size << header->permissions << header->unk1;
-        for (u8 byte : header->md5)
-          pac << byte;
-        pac << header->unk2;
-        for (size_t i = 0; i < header->banner_size; i++)
-          pac << header->banner[i];
-
-        // BkHeader
-        pac << bk_header->size << bk_header->magic << bk_header->ngid << bk_header->number_of_files
-            << bk_header->size_of_files << bk_header->unk1 << bk_header->unk2
-            << bk_header->total_size;
-        for (u8 byte : bk_header->unk3)
-          pac << byte;
-        pac << sf::Uint64{bk_header->tid};
-        for (u8 byte : bk_header->mac_address)
-          pac << byte;
-
-        // Files
-        for (const WiiSave::Storage::SaveFile& file : *files)
+        if (file.type == WiiSave::Storage::SaveFile::Type::File)
         {
-          INFO_LOG_FMT(NETPLAY, "Sending Wii save data of type {} at {}",
-                       static_cast<u8>(file.type), file.path);
-
-          pac << file.mode << file.attributes << file.type << file.path;
-
-          if (file.type == WiiSave::Storage::SaveFile::Type::File)
-          {
-            const std::optional<std::vector<u8>>& data = *file.data;
-            if (!data || !CompressBufferIntoPacket(*data, pac))
-              return false;
-          }
+          const std::optional<std::vector<u8>>& data = *file.data;
+          if (!data || !CompressBufferIntoPacket(*data, pac))
+            return std::nullopt;
         }
       }
-      else
-      {
-        INFO_LOG_FMT(NETPLAY, "No data for Wii save of title {:016x}.", title_id);
-        pac << false;  // save does not exist
-      }
-    }
-
-    if (sync_info.redirected_save)
-    {
-      INFO_LOG_FMT(NETPLAY, "Sending redirected save at {}.",
-                   sync_info.redirected_save->m_target_path);
-      pac << true;
-      if (!CompressFolderIntoPacket(sync_info.redirected_save->m_target_path, pac))
-        return false;
     }
     else
     {
-      INFO_LOG_FMT(NETPLAY, "Not sending redirected save.");
-      pac << false;  // no redirected save
+      INFO_LOG_FMT(NETPLAY, "No data for Wii save of title {:016x}.", title_id);
+      pac << false;  // save does not exist
     }
+  }
 
-    SendChunkedToClients(std::move(pac), 1, "Wii Save Synchronization");
+  if (sync_info.redirected_save)
+  {
+    INFO_LOG_FMT(NETPLAY, "Sending redirected save at {}.",
+                 sync_info.redirected_save->m_target_path);
+    pac << true;
+    if (!CompressFolderIntoPacket(sync_info.redirected_save->m_target_path, pac))
+      return std::nullopt;
+  }
+  else
+  {
+    INFO_LOG_FMT(NETPLAY, "Not sending redirected save.");
+    pac << false;  // no redirected save
   }
 
-  for (size_t i = 0; i < m_gba_config.size(); ++i)
+  return pac;
+}
+
+void NetPlayServer::SendSaveDataToClients(sf::Packet&& packet, const std::string& title)
+{
+  const Common::SHA1::Digest digest = Common::SHA1::CalculateDigest(
+      static_cast<const u8*>(packet.getData()), packet.getDataSize());
+
+  // Clients that got the same save in the last synchronization are told to use their copy of it
+  std::vector<PlayerId> missing_players;
+  size_t client_count = 0;
   {
-    if (m_gba_config[i].enabled && m_gba_config[i].has_rom)
+    std::lock_guard lkp(m_crit.players);
+    for (auto& [pid, client] : m_players)
     {
-      sf::Packet pac;
-      pac << MessageID::SyncSaveData;
-      pac << SyncSaveDataID::GBAData;
-      pac << static_cast<u8>(i);
+      if (client.IsHost())
+        continue;
 
-      std::string path;
-#ifdef HAS_LIBMGBA
-      path = HW::GBA::Core::GetSavePath(Config::Get(Config::MAIN_GBA_ROM_PATHS[i]),
-                                        static_cast<int>(i));
-#endif
-      if (File::Exists(path))
+      ++client_count;
+      if (client.previous_save_data.contains(digest))
       {
-        INFO_LOG_FMT(NETPLAY, "Sending data of GBA save at {} for slot {}.", path, i);
-        if (!CompressFileIntoPacket(path, pac))
-          return false;
+        INFO_LOG_FMT(NETPLAY, "Player {} already has the data of {}.", pid, title);
+
+        sf::Packet pac;
+        pac << MessageID::SyncSaveData;
+        pac << SyncSaveDataID::Cached;
+        for (u8 byte : digest)
+          pac << byte;
+        SendAsync(std::move(pac), pid, CHUNKED_DATA_CHANNEL);
       }
       else
       {
-        // No file, so we'll say the size is 0
-        INFO_LOG_FMT(NETPLAY, "Sending empty marker for GBA save at {} for slot {}.", path, i);
-        pac << sf::Uint64{0};
+        missing_players.push_back(pid);
       }
-
-      SendChunkedToClients(std::move(pac), 1,
-                           fmt::format("GBA{} Save File Synchronization", i + 1));
+      client.save_data.insert(digest);
     }
   }
 
-  return true;
+  if (missing_players.size() == client_count)
+  {
+    SendChunkedToClients(std::move(packet), 1, title);
+    return;
+  }
+
+  for (PlayerId pid : missing_players)
+    SendChunked(sf::Packet(packet), pid, title);
 }
 
 bool NetPlayServer::SyncCodes()
@@ -2196,6 +2283,21 @@ void NetPlayServer::Send(ENetPeer* socket, const sf::Packet& packet, const u8 ch
   Common::ENet::SendPacket(socket, packet, channel_id);
 }
 
+void NetPlayServer::SendControllerStates(Client& target, MessageID message_id,
+                                         const ControllerStates& states,
+                                         ControllerStateDelta Client::*delta)
+{
+  sf::Packet spac;
+  spac << message_id;
+  for (const auto& [map, state] : states)
+  {
+    spac << map;
+    (target.*delta).Encode(map, state, spac);
+  }
+
+  Send(target.socket, spac);
+}
+
 void NetPlayServer::KickPlayer(PlayerId player)
 {
   for (auto& current_player : m_players)
@@ -2482,6 +2584,8 @@ void NetPlayServer::ChunkedDataSend(sf::Packet&& packet, const PlayerId pid,
 
 void NetPlayServer::ChunkedDataAbort()
 {
+  // The clients might not have received all of the saves that were queued
+  m_forget_sent_save_data = true;
   m_abort_chunked_data = true;
   m_chunked_data_event.Set();
   m_chunked_data_complete_event.Set();
@@ -5,22 +5,26 @@
 
 #include <SFML/Network/Packet.hpp>
 
+#include <atomic>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <optional>
 #include <queue>
+#include <set>
 #include <sstream>
 #include <thread>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
 
+#include "Common/Crypto/SHA1.h"
 #include "Common/Event.h"
 #include "Common/QoSSession.h"
 #include "Common/SPSCQueue.h"
 #include "Common/Timer.h"
 #include "Common/TraversalClient.h"
+#include "Core/NetPlayCommon.h"
 #include "Core/NetPlayProto.h"
 #include "Core/SyncIdentifier.h"
 #include "InputCommon/GCPadStatus.h"
@@ -93,6 +97,19 @@ private:
     u32 ping = 0;
     u32 current_game = 0;
 
+    // The previous controller states that were received from and sent to this client
+    ControllerStateDelta pad_data_received;
+    ControllerStateDelta pad_host_data_received;
+    ControllerStateDelta wiimote_data_received;
+    ControllerStateDelta pad_data_sent;
+    ControllerStateDelta pad_host_data_sent;
+    ControllerStateDelta wiimote_data_sent;
+
+    // Digests of the save data packets that were sent to this client in the current and the last
+    // save synchronization
+    std::set<Common::SHA1::Digest> save_data;
+    std::set<Common::SHA1::Digest> previous_save_data;
+
     Common::QoSSession qos_session;
 
     bool operator==(const Client& other) const { return this == &other; }
@@ -124,6 +141,8 @@ private:
   bool SetupNetSettings();
   std::optional<SaveSyncInfo> CollectSaveSyncInfo();
   bool SyncSaveData(const SaveSyncInfo& sync_info);
+  static std::optional<sf::Packet> GetWiiSaveDataPacket(const SaveSyncInfo& sync_info);
+  void SendSaveDataToClients(sf::Packet&& packet, const std::string& title);
   bool SyncCodes();
   void CheckSyncAndStartGame();
 
@@ -137,6 +156,10 @@ private:
   void SendToClients(const sf::Packet& packet, PlayerId skip_pid = 0,
                      u8 channel_id = DEFAULT_CHANNEL);
   void Send(ENetPeer* socket, const sf::Packet& packet, u8 channel_id = DEFAULT_CHANNEL);
+  // Encodes the states against the previous states that were sent to the target
+  using ControllerStates = std::vector<std::pair<PadIndex, ControllerStateDelta::State>>;
+  void SendControllerStates(Client& target, MessageID message_id, const ControllerStates& states,
+                            ControllerStateDelta Client::*delta);
   ConnectionError OnConnect(ENetPeer* socket, sf::Packet& received_packet);
   unsigned int OnDisconnect(const Client& player);
   unsigned int OnData(sf::Packet& packet, Client& player);
@@ -208,6 +231,7 @@ private:
   u32 m_next_chunked_data_id = 0;
   std::unordered_map<u32, unsigned int> m_chunked_data_complete_count;
   bool m_abort_chunked_data = false;
+  std::atomic<bool> m_forget_sent_save_data = false;
 
   ENetHost* m_server = nullptr;
   Common::TraversalClient* m_traversal_client = nullptr;
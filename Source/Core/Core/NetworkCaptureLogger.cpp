@@ -7,6 +7,7 @@
 #include <cerrno>
 #include <cstring>
 #include <iterator>
+#include <mutex>
 
 #include <fmt/chrono.h>
 #include <fmt/format.h>
@@ -91,6 +92,7 @@ PCAPSSLCaptureLogger::~PCAPSSLCaptureLogger() = default;
 
 void PCAPSSLCaptureLogger::OnNewSocket(s32 socket)
 {
+  std::lock_guard lock(m_mutex);
   m_read_sequence_number[socket] = 0;
   m_write_sequence_number[socket] = 0;
 }
@@ -123,6 +125,7 @@ void PCAPSSLCaptureLogger::LogBBA(const void* data, std::size_t length)
 {
   if (!Config::Get(Config::MAIN_NETWORK_DUMP_BBA))
     return;
+  std::lock_guard lock(m_mutex);
   m_file->AddPacket(static_cast<const u8*>(data), length);
 }
 
@@ -162,6 +165,7 @@ void PCAPSSLCaptureLogger::Log(LogType log_type, const void* data, std::size_t l
 void PCAPSSLCaptureLogger::LogIPv4(LogType log_type, const u8* data, u16 length, s32 socket,
                                    const sockaddr_in& from, const sockaddr_in& to)
 {
+  std::lock_guard lock(m_mutex);
   int socket_type;
   socklen_t option_length = sizeof(int);
 
@@ -20,6 +20,7 @@
 #include <fmt/format.h>
 
 #include "Common/Assert.h"
+#include "Common/Counters.h"
 #include "Common/Debug/MemoryPatches.h"
 #include "Common/IniFile.h"
 #include "Common/StringUtil.h"
@@ -49,6 +50,10 @@ static std::vector<std::size_t> s_on_frame_memory;
 static std::mutex s_on_frame_memory_mutex;
 static std::map<u32, int> s_speed_hacks;
 
+static Common::Counter s_skipped_patch_writes(
+    "dolphin_patch_writes_skipped_total",
+    "Frame patch writes that were skipped because memory already held the patched value");
+
 const char* PatchTypeAsString(PatchType type)
 {
   return s_patch_type_strings.at(static_cast<int>(type));
@@ -232,6 +237,9 @@ void LoadPatches()
 
 static void ApplyPatches(const Core::CPUThreadGuard& guard, const std::vector<Patch>& patches)
 {
+  // Most patches have already been applied on earlier frames, so they are only written if the
+  // memory doesn't hold the patched value anymore
+  u64 skipped_writes = 0;
   for (const Patch& patch : patches)
   {
     if (patch.enabled)
@@ -244,23 +252,32 @@ static void ApplyPatches(const Core::CPUThreadGuard& guard, const std::vector<Pa
         switch (entry.type)
         {
         case PatchType::Patch8Bit:
-          if (!entry.conditional ||
-              PowerPC::MMU::HostRead_U8(guard, addr) == static_cast<u8>(comparand))
-          {
+        {
+          const u8 current = PowerPC::MMU::HostRead_U8(guard, addr);
+          if (current == static_cast<u8>(value))
+            ++skipped_writes;
+          else if (!entry.conditional || current == static_cast<u8>(comparand))
             PowerPC::MMU::HostWrite_U8(guard, static_cast<u8>(value), addr);
-          }
           break;
+        }
         case PatchType::Patch16Bit:
-          if (!entry.conditional ||
-              PowerPC::MMU::HostRead_U16(guard, addr) == static_cast<u16>(comparand))
-          {
+        {
+          const u16 current = PowerPC::MMU::HostRead_U16(guard, addr);
+          if (current == static_cast<u16>(value))
+            ++skipped_writes;
+          else if (!entry.conditional || current == static_cast<u16>(comparand))
             PowerPC::MMU::HostWrite_U16(guard, static_cast<u16>(value), addr);
-          }
           break;
+        }
         case PatchType::Patch32Bit:
-          if (!entry.conditional || PowerPC::MMU::HostRead_U32(guard, addr) == comparand)
+        {
+          const u32 current = PowerPC::MMU::HostRead_U32(guard, addr);
+          if (current == value)
+            ++skipped_writes;
+          else if (!entry.conditional || current == comparand)
             PowerPC::MMU::HostWrite_U32(guard, value, addr);
           break;
+        }
         default:
           // unknown patchtype
           break;
@@ -268,6 +285,8 @@ static void ApplyPatches(const Core::CPUThreadGuard& guard, const std::vector<Pa
       }
     }
   }
+  if (skipped_writes != 0)
+    s_skipped_patch_writes.Add(skipped_writes);
 }
 
 static void ApplyMemoryPatches(const Core::CPUThreadGuard& guard,
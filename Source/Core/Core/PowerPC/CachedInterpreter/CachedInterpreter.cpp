@@ -3,6 +3,10 @@
 
 #include "Core/PowerPC/CachedInterpreter/CachedInterpreter.h"
 
+#include <bit>
+#include <limits>
+
+#include "Common/Assert.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Core/ConfigManager.h"
@@ -51,7 +55,7 @@ struct CachedInterpreter::Instruction
   {
   }
 
-  enum class Type
+  enum class Type : u8
   {
     Abort,
     Common,
@@ -59,8 +63,28 @@ struct CachedInterpreter::Instruction
     Interpreter,
     CachedInterpreter,
     ConditionalCachedInterpreter,
+
+    // Common instructions with their operands decoded ahead of time, which are run by the
+    // dispatcher itself instead of through a call.
+    LoadImmediate,  // gpr[d] = data
+    AddImmediate,   // gpr[d] = gpr[a] + data
+    OrImmediate,    // gpr[d] = gpr[a] | data
+    RotateAndMask,  // gpr[d] = rotl(gpr[a], shift) & data
+
+    // EndBlock followed by the updates of the performance monitor counters, data is the downcount
+    EndBlock,
   };
 
+  Instruction(Type t, u32 d, u8 rd, u8 ra, u8 shift = 0)
+      : operands{rd, ra, shift}, data(d), type(t)
+  {
+  }
+
+  Instruction(Type t, u32 downcount, u16 num_load_stores, u16 num_fp_inst)
+      : block_end{num_load_stores, num_fp_inst}, data(downcount), type(t)
+  {
+  }
+
   union
   {
     const CommonCallback common_callback = nullptr;
@@ -68,6 +92,17 @@ struct CachedInterpreter::Instruction
     const InterpreterCallback interpreter_callback;
     const CachedInterpreterCallback cached_interpreter_callback;
     const ConditionalCachedInterpreterCallback conditional_cached_interpreter_callback;
+    struct
+    {
+      u8 d;
+      u8 a;
+      u8 shift;
+    } operands;
+    struct
+    {
+      u16 num_load_stores;
+      u16 num_fp_inst;
+    } block_end;
   };
 
   u32 data = 0;
@@ -116,6 +151,7 @@ void CachedInterpreter::ExecuteOneBlock()
 
   const Instruction* code = reinterpret_cast<const Instruction*>(normal_entry);
   auto& interpreter = m_system.GetInterpreter();
+  auto& gpr = m_ppc_state.gpr;
 
   for (; code->type != Instruction::Type::Abort; ++code)
   {
@@ -143,6 +179,29 @@ void CachedInterpreter::ExecuteOneBlock()
         return;
       break;
 
+    case Instruction::Type::LoadImmediate:
+      gpr[code->operands.d] = code->data;
+      break;
+
+    case Instruction::Type::AddImmediate:
+      gpr[code->operands.d] = gpr[code->operands.a] + code->data;
+      break;
+
+    case Instruction::Type::OrImmediate:
+      gpr[code->operands.d] = gpr[code->operands.a] | code->data;
+      break;
+
+    case Instruction::Type::RotateAndMask:
+      gpr[code->operands.d] = std::rotl(gpr[code->operands.a], code->operands.shift) & code->data;
+      break;
+
+    case Instruction::Type::EndBlock:
+      m_ppc_state.pc = m_ppc_state.npc;
+      m_ppc_state.downcount -= code->data;
+      PowerPC::UpdatePerformanceMonitor(code->data, code->block_end.num_load_stores,
+                                        code->block_end.num_fp_inst, m_ppc_state);
+      break;
+
     default:
       ERROR_LOG_FMT(POWERPC, "Unknown CachedInterpreter Instruction: {}",
                     static_cast<int>(code->type));
@@ -185,18 +244,6 @@ void CachedInterpreter::EndBlock(CachedInterpreter& cached_interpreter, UGeckoIn
   PowerPC::UpdatePerformanceMonitor(data.hex, 0, 0, ppc_state);
 }
 
-void CachedInterpreter::UpdateNumLoadStoreInstructions(CachedInterpreter& cached_interpreter,
-                                                       UGeckoInstruction data)
-{
-  PowerPC::UpdatePerformanceMonitor(0, data.hex, 0, cached_interpreter.m_ppc_state);
-}
-
-void CachedInterpreter::UpdateNumFloatingPointInstructions(CachedInterpreter& cached_interpreter,
-                                                           UGeckoInstruction data)
-{
-  PowerPC::UpdatePerformanceMonitor(0, 0, data.hex, cached_interpreter.m_ppc_state);
-}
-
 void CachedInterpreter::WritePC(CachedInterpreter& cached_interpreter, UGeckoInstruction data)
 {
   auto& ppc_state = cached_interpreter.m_ppc_state;
@@ -267,6 +314,83 @@ bool CachedInterpreter::CheckIdle(CachedInterpreter& cached_interpreter, u32 idl
   return false;
 }
 
+bool CachedInterpreter::EmitSpecializedInstruction(UGeckoInstruction inst)
+{
+  using Type = Instruction::Type;
+
+  switch (inst.OPCD)
+  {
+  case 14:  // addi
+  case 15:  // addis
+  {
+    const u32 imm = inst.OPCD == 15 ? u32(inst.SIMM_16 << 16) : u32(inst.SIMM_16);
+    if (inst.RA == 0)
+      m_code.emplace_back(Type::LoadImmediate, imm, u8(inst.RD), u8(0));
+    else
+      m_code.emplace_back(Type::AddImmediate, imm, u8(inst.RD), u8(inst.RA));
+    return true;
+  }
+
+  case 24:  // ori
+  case 25:  // oris
+  {
+    const u32 imm = inst.OPCD == 25 ? u32{inst.UIMM} << 16 : u32{inst.UIMM};
+    m_code.emplace_back(Type::OrImmediate, imm, u8(inst.RA), u8(inst.RS));
+    return true;
+  }
+
+  case 21:  // rlwinmx
+    if (inst.Rc)
+      return false;
+    m_code.emplace_back(Type::RotateAndMask, MakeRotationMask(inst.MB, inst.ME), u8(inst.RA),
+                        u8(inst.RS), u8(inst.SH));
+    return true;
+
+  default:
+    return false;
+  }
+}
+
+bool CachedInterpreter::EmitLoadImmediatePair(const PPCAnalyst::CodeOp& op,
+                                              const PPCAnalyst::CodeOp& next)
+{
+  // lis rX, high followed by addi rX, rX, low or ori rX, rX, low, which is how 32-bit constants
+  // and addresses are loaded
+  const UGeckoInstruction lis = op.inst;
+  if (lis.OPCD != 15 || lis.RA != 0)
+    return false;
+
+  const UGeckoInstruction low = next.inst;
+  const u32 reg = lis.RD;
+  u32 value = u32(lis.SIMM_16 << 16);
+  if (low.OPCD == 14 && low.RD == reg && low.RA == reg)
+    value += u32(low.SIMM_16);
+  else if (low.OPCD == 24 && low.RA == reg && low.RS == reg)
+    value |= low.UIMM;
+  else
+    return false;
+
+  // The second instruction has to be one that wouldn't get any checks of its own
+  if (next.skip || HLE::GetHookByFunctionAddress(next.address) != 0 ||
+      (m_enable_debugging &&
+       m_system.GetPowerPC().GetBreakPoints().IsAddressBreakPoint(next.address)))
+  {
+    return false;
+  }
+
+  m_code.emplace_back(Instruction::Type::LoadImmediate, value, u8(reg), u8(0));
+  return true;
+}
+
+void CachedInterpreter::EmitEndBlock()
+{
+  DEBUG_ASSERT(js.numLoadStoreInst <= std::numeric_limits<u16>::max() &&
+               js.numFloatingPointInst <= std::numeric_limits<u16>::max());
+  m_code.emplace_back(Instruction::Type::EndBlock, js.downcountAmount,
+                      static_cast<u16>(js.numLoadStoreInst),
+                      static_cast<u16>(js.numFloatingPointInst));
+}
+
 bool CachedInterpreter::HandleFunctionHooking(u32 address)
 {
   return HLE::ReplaceFunctionIfPossible(address, [&](u32 hook_index, HLE::HookType type) {
@@ -350,7 +474,22 @@ void CachedInterpreter::Jit(u32 address)
         js.firstFPInstructionFound = true;
       }
 
-      m_code.emplace_back(Interpreter::GetInterpreterOp(op.inst), op.inst);
+      if (!breakpoint && !check_fpu && !endblock && !memcheck && !check_program_exception &&
+          !idle_loop && i + 1 < code_block.m_num_instructions &&
+          EmitLoadImmediatePair(op, m_code_buffer[i + 1]))
+      {
+        // The second instruction is part of this one
+        const PPCAnalyst::CodeOp& next = m_code_buffer[++i];
+        js.downcountAmount += next.opinfo->num_cycles;
+        if (next.opinfo->flags & FL_LOADSTORE)
+          ++js.numLoadStoreInst;
+        if (next.opinfo->flags & FL_USE_FPU)
+          ++js.numFloatingPointInst;
+        continue;
+      }
+
+      if (!EmitSpecializedInstruction(op.inst))
+        m_code.emplace_back(Interpreter::GetInterpreterOp(op.inst), op.inst);
       if (memcheck)
         m_code.emplace_back(CheckDSI, js.downcountAmount);
       if (check_program_exception)
@@ -358,19 +497,13 @@ void CachedInterpreter::Jit(u32 address)
       if (idle_loop)
         m_code.emplace_back(CheckIdle, js.blockStart);
       if (endblock)
-      {
-        m_code.emplace_back(EndBlock, js.downcountAmount);
-        m_code.emplace_back(UpdateNumLoadStoreInstructions, js.numLoadStoreInst);
-        m_code.emplace_back(UpdateNumFloatingPointInstructions, js.numFloatingPointInst);
-      }
+        EmitEndBlock();
     }
   }
   if (code_block.m_broken)
   {
     m_code.emplace_back(WriteBrokenBlockNPC, nextPC);
-    m_code.emplace_back(EndBlock, js.downcountAmount);
-    m_code.emplace_back(UpdateNumLoadStoreInstructions, js.numLoadStoreInst);
-    m_code.emplace_back(UpdateNumFloatingPointInstructions, js.numFloatingPointInst);
+    EmitEndBlock();
   }
   m_code.emplace_back();
 
@@ -42,12 +42,11 @@ private:
   void ExecuteOneBlock();
 
   bool HandleFunctionHooking(u32 address);
+  bool EmitSpecializedInstruction(UGeckoInstruction inst);
+  bool EmitLoadImmediatePair(const PPCAnalyst::CodeOp& op, const PPCAnalyst::CodeOp& next);
+  void EmitEndBlock();
 
   static void EndBlock(CachedInterpreter& cached_interpreter, UGeckoInstruction data);
-  static void UpdateNumLoadStoreInstructions(CachedInterpreter& cached_interpreter,
-                                             UGeckoInstruction data);
-  static void UpdateNumFloatingPointInstructions(CachedInterpreter& cached_interpreter,
-                                                 UGeckoInstruction data);
   static void WritePC(CachedInterpreter& cached_interpreter, UGeckoInstruction data);
   static void WriteBrokenBlockNPC(CachedInterpreter& cached_interpreter, UGeckoInstruction data);
   static bool CheckFPU(CachedInterpreter& cached_interpreter, u32 data);
@@ -6,7 +6,17 @@
 #include "Core/PowerPC/GDBStub.h"
 
 #include <fmt/format.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <mutex>
 #include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
 #include <signal.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -30,12 +40,14 @@ typedef SSIZE_T ssize_t;
 #include "Common/Logging/Log.h"
 #include "Common/SocketContext.h"
 #include "Common/StringUtil.h"
+#include "Common/Thread.h"
 #include "Core/Core.h"
 #include "Core/HW/CPU.h"
 #include "Core/HW/Memmap.h"
 #include "Core/Host.h"
 #include "Core/PowerPC/BreakPoints.h"
 #include "Core/PowerPC/Gekko.h"
+#include "Core/PowerPC/MMU.h"
 #include "Core/PowerPC/PPCCache.h"
 #include "Core/PowerPC/PowerPC.h"
 #include "Core/System.h"
@@ -44,12 +56,14 @@ namespace GDBStub
 {
 static std::optional<Common::SocketContext> s_socket_context;
 
-#define GDB_BFR_MAX 10000
+#define GDB_BFR_MAX 0x10000
 
 #define GDB_STUB_START '$'
 #define GDB_STUB_END '#'
 #define GDB_STUB_ACK '+'
 #define GDB_STUB_NAK '-'
+#define GDB_STUB_ESCAPE '}'
+#define GDB_STUB_BREAK 0x03
 
 // We are treating software breakpoints and hardware breakpoints the same way
 enum class BreakpointType
@@ -79,6 +93,15 @@ static u32 s_cmd_len;
 
 static CoreTiming::EventType* s_update_event;
 
+// Packets are received and acknowledged on a thread of their own, so the CPU thread doesn't have
+// to poll the socket. It only pauses the emulation to handle the packets that have arrived.
+static std::thread s_receive_thread;
+static std::mutex s_packets_mutex;
+static std::deque<std::vector<u8>> s_packets;
+static Common::Event s_packet_event;
+static std::atomic<bool> s_connection_lost = false;
+static std::mutex s_send_mutex;
+
 static const char* CommandBufferAsString()
 {
   return reinterpret_cast<const char*>(s_cmd_bfr);
@@ -133,28 +156,11 @@ static void UpdateCallback(Core::System& system, u64 userdata, s64 cycles_late)
     Core::System::GetInstance().GetCoreTiming().ScheduleEvent(GDB_UPDATE_CYCLES, s_update_event);
 }
 
-static u8 ReadByte()
-{
-  u8 c = '+';
-
-  const ssize_t res = recv(s_sock, (char*)&c, 1, MSG_WAITALL);
-  if (res != 1)
-  {
-    ERROR_LOG_FMT(GDB_STUB, "recv failed : {}", res);
-    Deinit();
-  }
-
-  return c;
-}
-
-static u8 CalculateChecksum()
+static u8 CalculateChecksum(const u8* data, size_t size)
 {
-  u32 len = s_cmd_len;
-  u8* ptr = s_cmd_bfr;
   u8 c = 0;
-
-  while (len-- > 0)
-    c += *ptr++;
+  while (size-- > 0)
+    c += *data++;
 
   return c;
 }
@@ -181,139 +187,179 @@ static void RemoveBreakpoint(BreakpointType type, u32 addr, u32 len)
   }
 }
 
-static void Nack()
+static bool SendBytes(const u8* data, size_t size)
 {
-  const char nak = GDB_STUB_NAK;
-  const ssize_t res = send(s_sock, &nak, 1, 0);
+  std::lock_guard lk(s_send_mutex);
+  while (size > 0)
+  {
+    const int n = send(s_sock, reinterpret_cast<const char*>(data), static_cast<int>(size), 0);
+    if (n < 0)
+      return false;
+    size -= n;
+    data += n;
+  }
+  return true;
+}
 
-  if (res != 1)
+static void Nack()
+{
+  const u8 nak = GDB_STUB_NAK;
+  if (!SendBytes(&nak, 1))
     ERROR_LOG_FMT(GDB_STUB, "send failed");
 }
 
 static void Ack()
 {
-  const char ack = GDB_STUB_ACK;
-  const ssize_t res = send(s_sock, &ack, 1, 0);
-
-  if (res != 1)
+  const u8 ack = GDB_STUB_ACK;
+  if (!SendBytes(&ack, 1))
     ERROR_LOG_FMT(GDB_STUB, "send failed");
 }
 
-static void ReadCommand()
+static void QueuePacket(std::vector<u8> packet)
 {
-  s_cmd_len = 0;
-  memset(s_cmd_bfr, 0, sizeof s_cmd_bfr);
-
-  u8 c = ReadByte();
-  if (c == '+')
-  {
-    // ignore ack
-    return;
-  }
-  else if (c == 0x03)
   {
-    auto& system = Core::System::GetInstance();
-    system.GetCPU().Break();
-    SendSignal(Signal::Sigtrap);
-    s_has_control = true;
-    INFO_LOG_FMT(GDB_STUB, "gdb: CPU::Break due to break command");
-    return;
-  }
-  else if (c != GDB_STUB_START)
-  {
-    WARN_LOG_FMT(GDB_STUB, "gdb: read invalid byte {:02x}", c);
-    return;
+    std::lock_guard lk(s_packets_mutex);
+    s_packets.push_back(std::move(packet));
   }
+  s_packet_event.Set();
+}
 
-  while ((c = ReadByte()) != GDB_STUB_END)
+static void ReceivePackets(int sock)
+{
+  Common::SetCurrentThreadName("GDB Stub");
+
+  enum class ReceiveState
+  {
+    Idle,
+    Data,
+    ChecksumHigh,
+    ChecksumLow,
+  };
+
+  ReceiveState state = ReceiveState::Idle;
+  std::vector<u8> packet;
+  u8 chk_read = 0;
+  std::array<u8, 4096> buffer;
+  while (true)
   {
-    s_cmd_bfr[s_cmd_len++] = c;
-    if (s_cmd_len == sizeof s_cmd_bfr)
+    const ssize_t res = recv(sock, reinterpret_cast<char*>(buffer.data()),
+                             static_cast<int>(buffer.size()), 0);
+    if (res <= 0)
     {
-      ERROR_LOG_FMT(GDB_STUB, "gdb: cmd_bfr overflow");
-      Nack();
+      if (res < 0)
+        ERROR_LOG_FMT(GDB_STUB, "recv failed : {}", res);
+      s_connection_lost = true;
+      s_packet_event.Set();
       return;
     }
-  }
-
-  u8 chk_read = Hex2char(ReadByte()) << 4;
-  chk_read |= Hex2char(ReadByte());
 
-  const u8 chk_calc = CalculateChecksum();
-
-  if (chk_calc != chk_read)
-  {
-    ERROR_LOG_FMT(GDB_STUB,
-                  "gdb: invalid checksum: calculated {:02x} and read {:02x} for ${}# (length: {})",
-                  chk_calc, chk_read, CommandBufferAsString(), s_cmd_len);
-    s_cmd_len = 0;
-
-    Nack();
-    return;
+    for (ssize_t i = 0; i < res; ++i)
+    {
+      const u8 c = buffer[i];
+      switch (state)
+      {
+      case ReceiveState::Idle:
+        if (c == GDB_STUB_START)
+        {
+          packet.clear();
+          state = ReceiveState::Data;
+        }
+        else if (c == GDB_STUB_BREAK)
+        {
+          QueuePacket({GDB_STUB_BREAK});
+        }
+        else if (c != GDB_STUB_ACK)
+        {
+          WARN_LOG_FMT(GDB_STUB, "gdb: read invalid byte {:02x}", c);
+        }
+        break;
+
+      case ReceiveState::Data:
+        if (c == GDB_STUB_END)
+        {
+          state = ReceiveState::ChecksumHigh;
+        }
+        else if (packet.size() == GDB_BFR_MAX - 1)
+        {
+          ERROR_LOG_FMT(GDB_STUB, "gdb: cmd_bfr overflow");
+          Nack();
+          state = ReceiveState::Idle;
+        }
+        else
+        {
+          packet.push_back(c);
+        }
+        break;
+
+      case ReceiveState::ChecksumHigh:
+        chk_read = Hex2char(c) << 4;
+        state = ReceiveState::ChecksumLow;
+        break;
+
+      case ReceiveState::ChecksumLow:
+      {
+        chk_read |= Hex2char(c);
+        state = ReceiveState::Idle;
+
+        const u8 chk_calc = CalculateChecksum(packet.data(), packet.size());
+        if (chk_calc != chk_read)
+        {
+          ERROR_LOG_FMT(GDB_STUB,
+                        "gdb: invalid checksum: calculated {:02x} and read {:02x} (length: {})",
+                        chk_calc, chk_read, packet.size());
+          Nack();
+          break;
+        }
+
+        Ack();
+        if (!packet.empty())
+          QueuePacket(std::move(packet));
+        packet = {};
+        break;
+      }
+      }
+    }
   }
-
-  DEBUG_LOG_FMT(GDB_STUB, "gdb: read command {} with a length of {}: {}",
-                static_cast<char>(s_cmd_bfr[0]), s_cmd_len, CommandBufferAsString());
-  Ack();
 }
 
-static bool IsDataAvailable()
+// Moves the next packet that was received into s_cmd_bfr. Returns false if there is none.
+static bool PopPacket()
 {
-  struct timeval t;
-  fd_set _fds, *fds = &_fds;
-
-  FD_ZERO(fds);
-  FD_SET(s_sock, fds);
-
-  t.tv_sec = 0;
-  t.tv_usec = 20;
-
-  if (select(s_sock + 1, fds, nullptr, nullptr, &t) < 0)
-  {
-    ERROR_LOG_FMT(GDB_STUB, "select failed");
+  std::lock_guard lk(s_packets_mutex);
+  if (s_packets.empty())
     return false;
-  }
 
-  if (FD_ISSET(s_sock, fds))
-    return true;
-  return false;
+  const std::vector<u8>& packet = s_packets.front();
+  memset(s_cmd_bfr, 0, sizeof s_cmd_bfr);
+  memcpy(s_cmd_bfr, packet.data(), packet.size());
+  s_cmd_len = static_cast<u32>(packet.size());
+  s_packets.pop_front();
+
+  DEBUG_LOG_FMT(GDB_STUB, "gdb: read command {} with a length of {}: {}",
+                static_cast<char>(s_cmd_bfr[0]), s_cmd_len, CommandBufferAsString());
+  return true;
 }
 
-static void SendReply(const char* reply)
+static void SendReply(std::string_view reply)
 {
   if (!IsActive())
     return;
 
-  memset(s_cmd_bfr, 0, sizeof s_cmd_bfr);
-
-  s_cmd_len = (u32)strlen(reply);
-  if (s_cmd_len + 4 > sizeof s_cmd_bfr)
-    ERROR_LOG_FMT(GDB_STUB, "cmd_bfr overflow in gdb_reply");
-
-  memcpy(s_cmd_bfr + 1, reply, s_cmd_len);
-
-  s_cmd_len++;
-  const u8 chk = CalculateChecksum();
-  s_cmd_len--;
-  s_cmd_bfr[0] = GDB_STUB_START;
-  s_cmd_bfr[s_cmd_len + 1] = GDB_STUB_END;
-  s_cmd_bfr[s_cmd_len + 2] = Nibble2hex(chk >> 4);
-  s_cmd_bfr[s_cmd_len + 3] = Nibble2hex(chk);
+  std::vector<u8> packet;
+  packet.reserve(reply.size() + 4);
+  packet.push_back(GDB_STUB_START);
+  packet.insert(packet.end(), reply.begin(), reply.end());
+  const u8 chk = CalculateChecksum(packet.data() + 1, reply.size());
+  packet.push_back(GDB_STUB_END);
+  packet.push_back(Nibble2hex(chk >> 4));
+  packet.push_back(Nibble2hex(chk));
 
-  DEBUG_LOG_FMT(GDB_STUB, "gdb: reply (len: {}): {}", s_cmd_len, CommandBufferAsString());
+  DEBUG_LOG_FMT(GDB_STUB, "gdb: reply (len: {}): {}", reply.size(), reply);
 
-  const char* ptr = (const char*)s_cmd_bfr;
-  u32 left = s_cmd_len + 4;
-  while (left > 0)
+  if (!SendBytes(packet.data(), packet.size()))
   {
-    const int n = send(s_sock, ptr, left, 0);
-    if (n < 0)
-    {
-      ERROR_LOG_FMT(GDB_STUB, "gdb: send failed");
-      return Deinit();
-    }
-    left -= n;
-    ptr += n;
+    ERROR_LOG_FMT(GDB_STUB, "gdb: send failed");
+    return Deinit();
   }
 }
 
@@ -325,6 +371,62 @@ static void WriteHostInfo()
           .c_str());
 }
 
+static std::string GetTargetDescription()
+{
+  return "<?xml version=\"1.0\"?><!DOCTYPE target SYSTEM \"gdb-target.dtd\">"
+         "<target version=\"1.0\"><architecture>powerpc:750</architecture></target>";
+}
+
+// The cached views of MEM1 and MEM2, so that clients know which ranges can be read
+static std::string GetMemoryMap()
+{
+  auto& system = Core::System::GetInstance();
+  auto& memory = system.GetMemory();
+
+  std::string map = "<?xml version=\"1.0\"?><!DOCTYPE memory-map PUBLIC "
+                    "\"+//IDN gnu.org//DTD GDB Memory Map V1.0//EN\" "
+                    "\"http://sourceware.org/gdb/gdb-memory-map.dtd\"><memory-map>";
+  map += fmt::format("<memory type=\"ram\" start=\"{:#x}\" length=\"{:#x}\"/>",
+                     Memory::MEM1_BASE_ADDR, memory.GetRamSizeReal());
+  if (memory.GetEXRAM())
+  {
+    map += fmt::format("<memory type=\"ram\" start=\"{:#x}\" length=\"{:#x}\"/>",
+                       Memory::MEM2_BASE_ADDR, memory.GetExRamSizeReal());
+  }
+  map += "</memory-map>";
+  return map;
+}
+
+// qXfer:object:read:annex:offset,length
+static void HandleTransfer()
+{
+  const std::string_view command(CommandBufferAsString(), s_cmd_len);
+
+  std::string object;
+  if (command.starts_with("qXfer:features:read:target.xml:"))
+    object = GetTargetDescription();
+  else if (command.starts_with("qXfer:memory-map:read::"))
+    object = GetMemoryMap();
+  else
+    return SendReply("");
+
+  u32 i = static_cast<u32>(command.rfind(':')) + 1;
+  u32 offset = 0;
+  while (i < s_cmd_len && s_cmd_bfr[i] != ',')
+    offset = (offset << 4) | Hex2char(s_cmd_bfr[i++]);
+  i++;
+  u32 len = 0;
+  while (i < s_cmd_len)
+    len = (len << 4) | Hex2char(s_cmd_bfr[i++]);
+
+  // The objects don't contain any characters that would need escaping
+  if (offset >= object.size())
+    return SendReply("l");
+  const std::string_view chunk = std::string_view(object).substr(offset, len);
+  const char prefix = offset + chunk.size() < object.size() ? 'm' : 'l';
+  SendReply(std::string(1, prefix).append(chunk));
+}
+
 static void HandleQuery()
 {
   DEBUG_LOG_FMT(GDB_STUB, "gdb: query '{}'", CommandBufferAsString());
@@ -342,7 +444,13 @@ static void HandleQuery()
   else if (!strncmp((const char*)(s_cmd_bfr), "qHostInfo", strlen("qHostInfo")))
     return WriteHostInfo();
   else if (!strncmp((const char*)(s_cmd_bfr), "qSupported", strlen("qSupported")))
-    return SendReply("swbreak+;hwbreak+");
+  {
+    return SendReply(fmt::format(
+        "swbreak+;hwbreak+;PacketSize={:x};qXfer:features:read+;qXfer:memory-map:read+",
+        GDB_BFR_MAX - 1));
+  }
+  else if (!strncmp((const char*)(s_cmd_bfr), "qXfer:", strlen("qXfer:")))
+    return HandleTransfer();
 
   SendReply("");
 }
@@ -399,22 +507,19 @@ static u64 re64hex(u8* p)
   return res;
 }
 
-static void ReadRegister()
-{
-  auto& system = Core::System::GetInstance();
-  auto& ppc_state = system.GetPPCState();
-
-  static u8 reply[64];
-  u32 id;
+// Registers are numbered the same way as GDB does for the PowerPC 750. The
+// registers up to fpscr are those of the 'g' and 'G' packets.
+constexpr u32 NUM_G_REGISTERS = 71;
 
-  memset(reply, 0, sizeof reply);
-  id = Hex2char(s_cmd_bfr[1]);
-  if (s_cmd_bfr[2] != '\0')
-  {
-    id <<= 4;
-    id |= Hex2char(s_cmd_bfr[2]);
-  }
+static u32 GetRegisterHexSize(u32 id)
+{
+  return (id >= 32 && id < 64) || id == 105 ? 16 : 8;
+}
 
+// Writes the value of the register as hex to reply, and returns the number of characters written,
+// or 0 if there is no such register
+static u32 ReadRegisterHex(const PowerPC::PowerPCState& ppc_state, u32 id, u8* reply)
+{
   if (id < 32)
   {
     wbe32hex(reply, ppc_state.gpr[id]);
@@ -422,6 +527,7 @@ static void ReadRegister()
   else if (id >= 32 && id < 64)
   {
     wbe64hex(reply, ppc_state.ps[id - 32].PS0AsU64());
+    return 16;
   }
   else if (id >= 71 && id < 87)
   {
@@ -464,7 +570,7 @@ static void ReadRegister()
       break;
     case 105:
       wbe64hex(reply, ppc_state.spr[SPR_ASR]);
-      break;
+      return 16;
     case 106:
       wbe32hex(reply, ppc_state.spr[SPR_DAR]);
       break;
@@ -574,68 +680,17 @@ static void ReadRegister()
       wbe32hex(reply, ppc_state.spr[SPR_THRM3]);
       break;
     default:
-      return SendReply("E01");
-      break;
+      return 0;
     }
   }
 
-  SendReply((char*)reply);
-}
 
-static void ReadRegisters()
-{
-  auto& system = Core::System::GetInstance();
-  auto& ppc_state = system.GetPPCState();
-
-  static u8 bfr[GDB_BFR_MAX - 4];
-  u8* bufptr = bfr;
-  u32 i;
-
-  memset(bfr, 0, sizeof bfr);
-
-  for (i = 0; i < 32; i++)
-  {
-    wbe32hex(bufptr + i * 8, ppc_state.gpr[i]);
-  }
-  bufptr += 32 * 8;
-
-  SendReply((char*)bfr);
+  return 8;
 }
 
-static void WriteRegisters()
-{
-  auto& system = Core::System::GetInstance();
-  auto& ppc_state = system.GetPPCState();
-
-  u32 i;
-  u8* bufptr = s_cmd_bfr;
-
-  for (i = 0; i < 32; i++)
-  {
-    ppc_state.gpr[i] = re32hex(bufptr + i * 8);
-  }
-  bufptr += 32 * 8;
-
-  SendReply("OK");
-}
-
-static void WriteRegister()
+// Returns false if there is no such register
+static bool WriteRegisterHex(PowerPC::PowerPCState& ppc_state, u32 id, u8* bufptr)
 {
-  auto& system = Core::System::GetInstance();
-  auto& ppc_state = system.GetPPCState();
-
-  u32 id;
-
-  u8* bufptr = s_cmd_bfr + 3;
-
-  id = Hex2char(s_cmd_bfr[1]);
-  if (s_cmd_bfr[2] != '=')
-  {
-    ++bufptr;
-    id <<= 4;
-    id |= Hex2char(s_cmd_bfr[2]);
-  }
-
   if (id < 32)
   {
     ppc_state.gpr[id] = re32hex(bufptr);
@@ -795,68 +850,243 @@ static void WriteRegister()
       ppc_state.spr[SPR_THRM3] = re32hex(bufptr);
       break;
     default:
-      return SendReply("E01");
-      break;
+      return false;
     }
   }
 
+
+  return true;
+}
+
+static void ReadRegister()
+{
+  auto& system = Core::System::GetInstance();
+  auto& ppc_state = system.GetPPCState();
+
+  static u8 reply[64];
+  u32 id;
+
+  memset(reply, 0, sizeof reply);
+  id = Hex2char(s_cmd_bfr[1]);
+  if (s_cmd_bfr[2] != '\0')
+  {
+    id <<= 4;
+    id |= Hex2char(s_cmd_bfr[2]);
+  }
+
+  if (ReadRegisterHex(ppc_state, id, reply) == 0)
+    return SendReply("E01");
+
+  SendReply((char*)reply);
+}
+
+static void ReadRegisters()
+{
+  auto& system = Core::System::GetInstance();
+  auto& ppc_state = system.GetPPCState();
+
+  static u8 bfr[GDB_BFR_MAX - 4];
+  u8* bufptr = bfr;
+
+  memset(bfr, 0, sizeof bfr);
+
+  for (u32 id = 0; id < NUM_G_REGISTERS; id++)
+    bufptr += ReadRegisterHex(ppc_state, id, bufptr);
+
+  SendReply((char*)bfr);
+}
+
+static void WriteRegisters()
+{
+  auto& system = Core::System::GetInstance();
+  auto& ppc_state = system.GetPPCState();
+
+  u8* bufptr = s_cmd_bfr + 1;
+  u8* const end = s_cmd_bfr + s_cmd_len;
+
+  // Clients may send fewer registers than 'g' replies with
+  for (u32 id = 0; id < NUM_G_REGISTERS && bufptr + GetRegisterHexSize(id) <= end; id++)
+  {
+    WriteRegisterHex(ppc_state, id, bufptr);
+    bufptr += GetRegisterHexSize(id);
+  }
+
   SendReply("OK");
 }
 
-static void ReadMemory(const Core::CPUThreadGuard& guard)
+static void WriteRegister()
 {
-  static u8 reply[GDB_BFR_MAX - 4];
-  u32 addr, len;
-  u32 i;
+  auto& system = Core::System::GetInstance();
+  auto& ppc_state = system.GetPPCState();
 
-  i = 1;
-  addr = 0;
-  while (s_cmd_bfr[i] != ',')
-    addr = (addr << 4) | Hex2char(s_cmd_bfr[i++]);
+  u32 id;
+
+  u8* bufptr = s_cmd_bfr + 3;
+
+  id = Hex2char(s_cmd_bfr[1]);
+  if (s_cmd_bfr[2] != '=')
+  {
+    ++bufptr;
+    id <<= 4;
+    id |= Hex2char(s_cmd_bfr[2]);
+  }
+
+  if (!WriteRegisterHex(ppc_state, id, bufptr))
+    return SendReply("E01");
+
+  SendReply("OK");
+}
+
+// Parses the "addr,length" of a memory packet, and returns the position after it. For the packets
+// that write memory, the data starts after a ':' there.
+static u32 ParseMemoryRange(u32* addr, u32* len)
+{
+  u32 i = 1;
+  *addr = 0;
+  while (i < s_cmd_len && s_cmd_bfr[i] != ',')
+    *addr = (*addr << 4) | Hex2char(s_cmd_bfr[i++]);
   i++;
 
-  len = 0;
-  while (i < s_cmd_len)
-    len = (len << 4) | Hex2char(s_cmd_bfr[i++]);
-  INFO_LOG_FMT(GDB_STUB, "gdb: read memory: {:08x} bytes from {:08x}", len, addr);
+  *len = 0;
+  while (i < s_cmd_len && s_cmd_bfr[i] != ':')
+    *len = (*len << 4) | Hex2char(s_cmd_bfr[i++]);
+  return i;
+}
+
+// Copies guest memory a page at a time, up to the first page that isn't RAM. Returns the number of
+// bytes that were copied.
+static u32 CopyFromGuest(const Core::CPUThreadGuard& guard, u32 addr, u8* dst, u32 len)
+{
+  u32 copied = 0;
+  while (copied < len)
+  {
+    const u32 address = addr + copied;
+    const u32 size = std::min<u32>(len - copied, PowerPC::HW_PAGE_SIZE -
+                                                     (address & PowerPC::HW_PAGE_MASK));
+    if (!PowerPC::MMU::HostTryCopyFromPage(guard, address, dst + copied, size))
+      break;
+    copied += size;
+  }
+  return copied;
+}
 
-  if (len * 2 > sizeof reply)
-    SendReply("E01");
+// Writes guest memory a page at a time. Returns false if any of the pages isn't RAM, in which case
+// nothing is written.
+static bool CopyToGuest(const Core::CPUThreadGuard& guard, u32 addr, const u8* src, u32 len)
+{
+  for (u32 offset = 0; offset < len;)
+  {
+    const u32 address = addr + offset;
+    if (!PowerPC::MMU::HostIsRAMAddress(guard, address))
+      return false;
+    offset += PowerPC::HW_PAGE_SIZE - (address & PowerPC::HW_PAGE_MASK);
+  }
+
+  auto& memory = guard.GetSystem().GetMemory();
+  u32 written = 0;
+  while (written < len)
+  {
+    const u32 address = addr + written;
+    const u32 size = std::min<u32>(len - written, PowerPC::HW_PAGE_SIZE -
+                                                      (address & PowerPC::HW_PAGE_MASK));
+    memcpy(memory.GetPointer(address), src + written, size);
+    written += size;
+  }
+  return true;
+}
+
+// Reads always fit into a reply, even if every byte of binary data has to be escaped
+constexpr u32 MAX_MEMORY_READ = (GDB_BFR_MAX - 5) / 2;
+
+static void ReadMemory(const Core::CPUThreadGuard& guard)
+{
+  static u8 data[MAX_MEMORY_READ];
+  static u8 reply[GDB_BFR_MAX - 4];
+  u32 addr, len;
+  ParseMemoryRange(&addr, &len);
+  INFO_LOG_FMT(GDB_STUB, "gdb: read memory: {:08x} bytes from {:08x}", len, addr);
 
-  if (!PowerPC::MMU::HostIsRAMAddress(guard, addr))
+  // Replies to reads may be shorter than what was asked for
+  len = std::min(len, MAX_MEMORY_READ);
+  len = CopyFromGuest(guard, addr, data, len);
+  if (len == 0)
     return SendReply("E00");
 
-  auto& system = Core::System::GetInstance();
-  auto& memory = system.GetMemory();
-  u8* data = memory.GetPointer(addr);
   Mem2hex(reply, data, len);
   reply[len * 2] = '\0';
   SendReply((char*)reply);
 }
 
-static void WriteMemory(const Core::CPUThreadGuard& guard)
+static void ReadMemoryBinary(const Core::CPUThreadGuard& guard)
 {
+  static u8 data[MAX_MEMORY_READ];
   u32 addr, len;
-  u32 i;
+  ParseMemoryRange(&addr, &len);
+  DEBUG_LOG_FMT(GDB_STUB, "gdb: read binary memory: {:08x} bytes from {:08x}", len, addr);
 
-  i = 1;
-  addr = 0;
-  while (s_cmd_bfr[i] != ',')
-    addr = (addr << 4) | Hex2char(s_cmd_bfr[i++]);
-  i++;
+  // A read of 0 bytes checks whether the packet is supported
+  if (len == 0)
+    return SendReply("b");
 
-  len = 0;
-  while (s_cmd_bfr[i] != ':')
-    len = (len << 4) | Hex2char(s_cmd_bfr[i++]);
+  len = std::min(len, MAX_MEMORY_READ);
+  len = CopyFromGuest(guard, addr, data, len);
+  if (len == 0)
+    return SendReply("E00");
+
+  std::string reply = "b";
+  reply.reserve(len + 1);
+  for (u32 i = 0; i < len; ++i)
+  {
+    const u8 c = data[i];
+    if (c == GDB_STUB_START || c == GDB_STUB_END || c == GDB_STUB_ESCAPE || c == '*')
+    {
+      reply.push_back(GDB_STUB_ESCAPE);
+      reply.push_back(static_cast<char>(c ^ 0x20));
+    }
+    else
+    {
+      reply.push_back(static_cast<char>(c));
+    }
+  }
+  SendReply(reply);
+}
+
+static void WriteMemory(const Core::CPUThreadGuard& guard)
+{
+  static u8 data[GDB_BFR_MAX / 2];
+  u32 addr, len;
+  const u32 i = ParseMemoryRange(&addr, &len);
   INFO_LOG_FMT(GDB_STUB, "gdb: write memory: {:08x} bytes to {:08x}", len, addr);
 
-  if (!PowerPC::MMU::HostIsRAMAddress(guard, addr))
+  if (i + 1 + u64{len} * 2 > s_cmd_len)
+    return SendReply("E01");
+
+  Hex2mem(data, s_cmd_bfr + i + 1, len);
+  if (!CopyToGuest(guard, addr, data, len))
     return SendReply("E00");
+  SendReply("OK");
+}
 
-  auto& system = Core::System::GetInstance();
-  auto& memory = system.GetMemory();
-  u8* dst = memory.GetPointer(addr);
-  Hex2mem(dst, s_cmd_bfr + i + 1, len);
+static void WriteMemoryBinary(const Core::CPUThreadGuard& guard)
+{
+  static u8 data[GDB_BFR_MAX];
+  u32 addr, len;
+  u32 i = ParseMemoryRange(&addr, &len) + 1;
+  DEBUG_LOG_FMT(GDB_STUB, "gdb: write binary memory: {:08x} bytes to {:08x}", len, addr);
+
+  u32 count = 0;
+  while (i < s_cmd_len && count < len)
+  {
+    u8 c = s_cmd_bfr[i++];
+    if (c == GDB_STUB_ESCAPE && i < s_cmd_len)
+      c = s_cmd_bfr[i++] ^ 0x20;
+    data[count++] = c;
+  }
+  if (count != len)
+    return SendReply("E01");
+
+  if (len != 0 && !CopyToGuest(guard, addr, data, len))
+    return SendReply("E00");
   SendReply("OK");
 }
 
@@ -956,20 +1186,31 @@ void ProcessCommands(bool loop_until_continue)
       return;
     }
 
-    if (!IsDataAvailable())
+    if (s_connection_lost)
     {
-      if (loop_until_continue)
-        continue;
-      else
-        return;
+      Deinit();
+      INFO_LOG_FMT(GDB_STUB, "gdb: connection lost");
+      return;
     }
-    ReadCommand();
-    // No more commands
-    if (s_cmd_len == 0)
+
+    if (!PopPacket())
+    {
+      if (!loop_until_continue)
+        return;
+
+      // Wake up every now and then to notice power downs
+      s_packet_event.WaitFor(std::chrono::milliseconds(10));
       continue;
+    }
 
     switch (s_cmd_bfr[0])
     {
+    case GDB_STUB_BREAK:
+      cpu.Break();
+      SendSignal(Signal::Sigtrap);
+      s_has_control = true;
+      INFO_LOG_FMT(GDB_STUB, "gdb: CPU::Break due to break command");
+      break;
     case 'q':
       HandleQuery();
       break;
@@ -999,19 +1240,27 @@ void ProcessCommands(bool loop_until_continue)
       WriteRegister();
       break;
     case 'm':
+    case 'x':
     {
       ASSERT(Core::IsCPUThread());
       Core::CPUThreadGuard guard(system);
 
-      ReadMemory(guard);
+      if (s_cmd_bfr[0] == 'm')
+        ReadMemory(guard);
+      else
+        ReadMemoryBinary(guard);
       break;
     }
     case 'M':
+    case 'X':
     {
       ASSERT(Core::IsCPUThread());
       Core::CPUThreadGuard guard(system);
 
-      WriteMemory(guard);
+      if (s_cmd_bfr[0] == 'M')
+        WriteMemory(guard);
+      else
+        WriteMemoryBinary(guard);
       auto& ppc_state = system.GetPPCState();
       ppc_state.iCache.Reset();
       Host_UpdateDisasmDialog();
@@ -1100,6 +1349,12 @@ static void InitGeneric(int domain, const sockaddr* server_addr, socklen_t serve
   INFO_LOG_FMT(GDB_STUB, "Client connected.");
   s_just_connected = true;
 
+  s_connection_lost = false;
+  if (s_sock >= 0)
+    s_receive_thread = std::thread(ReceivePackets, s_sock);
+  else
+    s_connection_lost = true;
+
 #ifdef _WIN32
   closesocket(s_tmpsock);
 #else
@@ -1123,10 +1378,18 @@ void Deinit()
   }
   if (s_sock != -1)
   {
+    // Wakes up the receive thread
     shutdown(s_sock, SHUT_RDWR);
+    if (s_receive_thread.joinable())
+      s_receive_thread.join();
     s_sock = -1;
   }
 
+  {
+    std::lock_guard lk(s_packets_mutex);
+    s_packets.clear();
+  }
+
   s_socket_context.reset();
   s_has_control = false;
 }
@@ -33,6 +33,9 @@ public:
   void Shutdown() override;
   void SingleStep() override;
   int SingleStepInner();
+  // Executes instructions up to and including the next one that ends a block, and returns the
+  // number of cycles they took
+  int SingleStepBlock();
 
   void Run() override;
   void ClearCache() override;
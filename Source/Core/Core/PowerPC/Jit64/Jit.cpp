@@ -3,7 +3,10 @@
 
 #include "Core/PowerPC/Jit64/Jit.h"
 
+#include <algorithm>
+#include <array>
 #include <map>
+#include <numeric>
 #include <sstream>
 #include <string>
 
@@ -152,6 +155,13 @@ bool Jit64::HandleFault(uintptr_t access_address, SContext* ctx)
                    "PC {:#018x}, access address {:#018x}, memory base {:#018x}, MSR.DR {}",
                    ctx->CTX_PC, access_address, memory_base, ppc_state.msr.DR);
     }
+    else if (ppc_state.msr.DR &&
+             m_mmu.MapPageTableAddressForFastmem(static_cast<u32>(access_address - memory_base)))
+    {
+      // The page is translated through the page table and has just been mapped, so the access
+      // can be retried without backpatching it
+      return true;
+    }
 
     return BackPatch(ctx);
   }
@@ -268,6 +278,8 @@ void Jit64::Init()
   const size_t farcode_size = jo.memcheck ? FARCODE_SIZE_MMU : FARCODE_SIZE;
   const size_t constpool_size = m_const_pool.CONST_POOL_SIZE;
   AllocCodeSpace(CODE_SIZE + routines_size + trampolines_size + farcode_size + constpool_size);
+  if (m_huge_pages_enabled)
+    AdviseHugePages();
   AddChildCodeSpace(&asm_routines, routines_size);
   AddChildCodeSpace(&trampolines, trampolines_size);
   AddChildCodeSpace(&m_far_code, farcode_size);
@@ -319,6 +331,7 @@ void Jit64::ResetFreeMemoryRanges()
 
 void Jit64::Shutdown()
 {
+  m_hot_block_cache.Save();
   FreeCodeSpace();
 
   auto& memory = m_system.GetMemory();
@@ -425,7 +438,7 @@ void Jit64::ImHere(Jit64& jit)
   been_here[ppc_state.pc] = 1;
 }
 
-bool Jit64::Cleanup()
+bool Jit64::Cleanup(BitSet32 registers_in_use)
 {
   bool did_something = false;
 
@@ -435,9 +448,9 @@ bool Jit64::Cleanup()
     SUB(64, R(RSCRATCH), PPCSTATE(gather_pipe_base_ptr));
     CMP(64, R(RSCRATCH), Imm32(GPFifo::GATHER_PIPE_SIZE));
     FixupBranch exit = J_CC(CC_L);
-    ABI_PushRegistersAndAdjustStack({}, 0);
+    ABI_PushRegistersAndAdjustStack(registers_in_use, 0);
     ABI_CallFunctionP(GPFifo::UpdateGatherPipe, &m_system.GetGPFifo());
-    ABI_PopRegistersAndAdjustStack({}, 0);
+    ABI_PopRegistersAndAdjustStack(registers_in_use, 0);
     SetJumpTarget(exit);
     did_something = true;
   }
@@ -445,16 +458,16 @@ bool Jit64::Cleanup()
   // SPEED HACK: MMCR0/MMCR1 should be checked at run-time, not at compile time.
   if (MMCR0(m_ppc_state).Hex || MMCR1(m_ppc_state).Hex)
   {
-    ABI_PushRegistersAndAdjustStack({}, 0);
+    ABI_PushRegistersAndAdjustStack(registers_in_use, 0);
     ABI_CallFunctionCCCP(PowerPC::UpdatePerformanceMonitor, js.downcountAmount, js.numLoadStoreInst,
                          js.numFloatingPointInst, &m_ppc_state);
-    ABI_PopRegistersAndAdjustStack({}, 0);
+    ABI_PopRegistersAndAdjustStack(registers_in_use, 0);
     did_something = true;
   }
 
   if (jo.profile_blocks)
   {
-    ABI_PushRegistersAndAdjustStack({}, 0);
+    ABI_PushRegistersAndAdjustStack(registers_in_use, 0);
     // get end tic
     MOV(64, R(ABI_PARAM1), ImmPtr(&js.curBlock->profile_data.ticStop));
     ABI_CallFunction(QueryPerformanceCounter);
@@ -466,7 +479,7 @@ bool Jit64::Cleanup()
     ADD(64, MDisp(RSCRATCH2, offsetof(JitBlock::ProfileData, downcountCounter)),
         Imm32(js.downcountAmount));
     MOV(64, MDisp(RSCRATCH2, offsetof(JitBlock::ProfileData, ticCounter)), R(RSCRATCH));
-    ABI_PopRegistersAndAdjustStack({}, 0);
+    ABI_PopRegistersAndAdjustStack(registers_in_use, 0);
     did_something = true;
   }
 
@@ -755,7 +768,7 @@ void Jit64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
   // Analyze the block, collect all instructions it is made of (including inlining,
   // if that is enabled), reorder instructions for optimal performance, and join joinable
   // instructions.
-  const u32 nextPC = analyzer.Analyze(em_address, &code_block, &m_code_buffer, block_size);
+  const u32 nextPC = AnalyzeBlock(em_address, block_size);
 
   if (code_block.m_memory_exception)
   {
@@ -869,6 +882,25 @@ bool Jit64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
     ADD(64, MDisp(ABI_PARAM1, offset), Imm8(1));
     ABI_CallFunction(QueryPerformanceCounter);
   }
+
+  // Count the runs of the block, and have it recompiled once it turns out to be hot.
+  if (ShouldCountRunsForTierUp(js.blockStart))
+  {
+    SwitchToFarCode();
+    const u8* target = GetCodePtr();
+    MOV(32, PPCSTATE(pc), Imm32(js.blockStart));
+    ABI_PushRegistersAndAdjustStack({}, 0);
+    ABI_CallFunctionPC(JitInterface::CompileExceptionCheckFromJIT, &m_system.GetJitInterface(),
+                       static_cast<u32>(JitInterface::ExceptionType::HotBlock));
+    ABI_PopRegistersAndAdjustStack({}, 0);
+    JMP(asm_routines.dispatcher_no_check, Jump::Near);
+    SwitchToNearCode();
+
+    MOV(64, R(RSCRATCH), ImmPtr(&b->profile_data.runCount));
+    ADD(64, MatR(RSCRATCH), Imm8(1));
+    CMP(64, MatR(RSCRATCH), Imm32(static_cast<u32>(TIER_UP_RUN_COUNT)));
+    J_CC(CC_E, target);
+  }
 #if defined(_DEBUG) || defined(DEBUGFAST) || defined(NAN_CHECK)
   // should help logged stack-traces become more accurate
   MOV(32, PPCSTATE(pc), Imm32(js.blockStart));
@@ -923,6 +955,13 @@ bool Jit64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
     IntializeSpeculativeConstants();
   }
 
+  m_loop_head = nullptr;
+  if (m_enable_loop_registers && !m_enable_debugging && !jo.profile_blocks &&
+      !bJITRegisterCacheOff && code_block.m_loop_back_edge)
+  {
+    StartLoop(*code_block.m_loop_back_edge);
+  }
+
   // Translate instructions
   for (u32 i = 0; i < code_block.m_num_instructions; i++)
   {
@@ -955,7 +994,7 @@ bool Jit64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
 
       // Gather pipe writes using an immediate address are explicitly tracked.
       if (jo.optimizeGatherPipe &&
-          (js.fifoBytesSinceCheck >= GPFifo::GATHER_PIPE_SIZE || js.mustCheckFifo))
+          (js.fifoBytesSinceCheck >= GPFifo::GATHER_PIPE_JIT_CHECK_SIZE || js.mustCheckFifo))
       {
         js.fifoBytesSinceCheck = 0;
         js.mustCheckFifo = false;
@@ -1124,8 +1163,16 @@ bool Jit64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
         gpr.Discard(op.gprDiscardable);
         fpr.Discard(op.fprDiscardable);
       }
-      gpr.Flush(~op.gprInUse & (op.regsIn | op.regsOut));
-      fpr.Flush(~op.fprInUse & (op.fregsIn | op.GetFregsOut()));
+      BitSet32 gprs_in_use = op.gprInUse;
+      BitSet32 fprs_in_use = op.fprInUse;
+      if (m_loop_head && i <= m_loop_back_edge)
+      {
+        // The next iteration uses them again
+        gprs_in_use |= m_gpr_loop_state.bound;
+        fprs_in_use |= m_fpr_loop_state.bound;
+      }
+      gpr.Flush(~gprs_in_use & (op.regsIn | op.regsOut));
+      fpr.Flush(~fprs_in_use & (op.fregsIn | op.GetFregsOut()));
 
       if (opinfo->flags & FL_LOADSTORE)
         ++js.numLoadStoreInst;
@@ -1234,6 +1281,74 @@ void Jit64::IntializeSpeculativeConstants()
   }
 }
 
+void Jit64::StartLoop(u32 back_edge)
+{
+  std::array<u32, 32> gpr_uses{};
+  std::array<u32, 32> fpr_uses{};
+  BitSet32 gprs_written;
+  BitSet32 fprs_written;
+  for (u32 i = 0; i <= back_edge; i++)
+  {
+    const PPCAnalyst::CodeOp& op = m_code_buffer[i];
+    for (int reg : op.regsIn | op.regsOut)
+      ++gpr_uses[reg];
+    for (int reg : op.fregsIn | op.GetFregsOut())
+      ++fpr_uses[reg];
+    gprs_written |= op.regsOut;
+    fprs_written |= op.GetFregsOut();
+  }
+
+  // The registers the loop uses most, leaving the rest of the host registers to the instructions
+  const auto most_used = [](const std::array<u32, 32>& uses, size_t max_count) {
+    std::array<int, 32> regs;
+    std::iota(regs.begin(), regs.end(), 0);
+    std::stable_sort(regs.begin(), regs.end(), [&](int a, int b) { return uses[a] > uses[b]; });
+
+    BitSet32 result;
+    for (size_t i = 0; i < max_count && uses[regs[i]] != 0; i++)
+      result[regs[i]] = true;
+    return result;
+  };
+
+  m_gpr_loop_state = gpr.StartLoop(most_used(gpr_uses, MAX_LOOP_GPRS), gprs_written);
+  m_fpr_loop_state = fpr.StartLoop(most_used(fpr_uses, MAX_LOOP_FPRS), fprs_written);
+  m_loop_back_edge = back_edge;
+  m_loop_head = GetCodePtr();
+}
+
+bool Jit64::IsLoopBackEdge(u32 instruction_number) const
+{
+  return m_loop_head && instruction_number == m_loop_back_edge;
+}
+
+void Jit64::WriteLoopBackEdge()
+{
+  ASSERT(js.carryFlag == CarryFlag::InPPCState);
+
+  gpr.ReconcileLoop(m_gpr_loop_state);
+  fpr.ReconcileLoop(m_fpr_loop_state);
+
+  // The loop registers stay in host registers across the calls
+  Cleanup(CallerSavedRegistersInUse());
+  SUB(32, PPCSTATE(downcount), Imm32(js.downcountAmount));
+  FixupBranch do_timing = J_CC(CC_LE, Jump::Near);
+
+  SwitchToFarCode();
+  SetJumpTarget(do_timing);
+  {
+    RCForkGuard gpr_guard = gpr.Fork();
+    RCForkGuard fpr_guard = fpr.Fork();
+    gpr.Flush();
+    fpr.Flush();
+
+    MOV(32, PPCSTATE(pc), Imm32(js.blockStart));
+    JMP(asm_routines.do_timing, Jump::Near);
+  }
+  SwitchToNearCode();
+
+  JMP(m_loop_head, Jump::Near);
+}
+
 bool Jit64::HandleFunctionHooking(u32 address)
 {
   return HLE::ReplaceFunctionIfPossible(address, [&](u32 hook_index, HLE::HookType type) {
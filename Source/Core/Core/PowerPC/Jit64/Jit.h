@@ -74,6 +74,12 @@ public:
 
   void IntializeSpeculativeConstants();
 
+  // Keeps the guest registers a loop uses most in host registers from the start of the block up to
+  // the loop's back-edge, which jumps back to the loop head without flushing them
+  void StartLoop(u32 back_edge);
+  bool IsLoopBackEdge(u32 instruction_number) const;
+  void WriteLoopBackEdge();
+
   JitBlockCache* GetBlockCache() override { return &blocks; }
   void Trace();
 
@@ -98,7 +104,8 @@ public:
   void WriteExternalExceptionExit();
   void WriteRfiExitDestInRSCRATCH();
   void WriteIdleExit(u32 destination);
-  bool Cleanup();
+  // registers_in_use are the caller saved host registers that have to survive the calls
+  bool Cleanup(BitSet32 registers_in_use = {});
 
   void GenerateConstantOverflow(bool overflow);
   void GenerateConstantOverflow(s64 val);
@@ -275,6 +282,14 @@ private:
   HyoutaUtilities::RangeSizeSet<u8*> m_free_ranges_near;
   HyoutaUtilities::RangeSizeSet<u8*> m_free_ranges_far;
 
+  static constexpr size_t MAX_LOOP_GPRS = 7;
+  static constexpr size_t MAX_LOOP_FPRS = 10;
+  // Null if the block isn't compiled as a loop
+  const u8* m_loop_head = nullptr;
+  u32 m_loop_back_edge = 0;
+  RegCache::LoopState m_gpr_loop_state;
+  RegCache::LoopState m_fpr_loop_state;
+
   const bool m_im_here_debug = false;
   const bool m_im_here_log = false;
   std::map<u32, int> m_been_here;
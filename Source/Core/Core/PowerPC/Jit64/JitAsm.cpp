@@ -217,7 +217,11 @@ void Jit64AsmRoutineManager::Generate()
   ABI_CallFunction(JitTrampoline);
   ABI_PopRegistersAndAdjustStack({}, 0);
 
-  JMP(dispatcher_no_check, Jump::Near);
+  // With deferred compilation, the block may have been interpreted instead, which can change the
+  // memory base and use up the downcount
+  MOV(64, R(RMEM), PPCSTATE(mem_ptr));
+  CMP(32, PPCSTATE(downcount), Imm8(0));
+  JMP(dispatcher, Jump::Near);
 
   SetJumpTarget(bail);
   do_timing = GetCodePtr();
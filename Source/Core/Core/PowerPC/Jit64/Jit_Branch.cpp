@@ -88,6 +88,12 @@ void Jit64::bx(UGeckoInstruction inst)
     return;
   }
 
+  if (IsLoopBackEdge(js.instructionNumber))
+  {
+    WriteLoopBackEdge();
+    return;
+  }
+
   gpr.Flush();
   fpr.Flush();
 
@@ -154,16 +160,20 @@ void Jit64::bcx(UGeckoInstruction inst)
   {
     RCForkGuard gpr_guard = gpr.Fork();
     RCForkGuard fpr_guard = fpr.Fork();
-    gpr.Flush();
-    fpr.Flush();
 
-    if (js.op->branchIsIdleLoop)
+    if (IsLoopBackEdge(js.instructionNumber))
     {
-      WriteIdleExit(js.op->branchTo);
+      WriteLoopBackEdge();
     }
     else
     {
-      WriteExit(js.op->branchTo, inst.LK, js.compilerPC + 4);
+      gpr.Flush();
+      fpr.Flush();
+
+      if (js.op->branchIsIdleLoop)
+        WriteIdleExit(js.op->branchTo);
+      else
+        WriteExit(js.op->branchTo, inst.LK, js.compilerPC + 4);
     }
   }
 
@@ -389,6 +389,15 @@ void Jit64::DoMergedBranch()
   const UGeckoInstruction& next = js.op[1].inst;
   const u32 nextPC = js.op[1].address;
 
+  if (IsLoopBackEdge(js.instructionNumber + 1))
+  {
+    WriteLoopBackEdge();
+    return;
+  }
+
+  gpr.Flush();
+  fpr.Flush();
+
   if (js.op[1].branchIsIdleLoop)
   {
     if (next.LK)
@@ -468,9 +477,6 @@ void Jit64::DoMergedBranchCondition()
     RCForkGuard gpr_guard = gpr.Fork();
     RCForkGuard fpr_guard = fpr.Fork();
 
-    gpr.Flush();
-    fpr.Flush();
-
     DoMergedBranch();
   }
 
@@ -507,8 +513,6 @@ void Jit64::DoMergedBranchImmediate(s64 val)
 
   if (branch)
   {
-    gpr.Flush();
-    fpr.Flush();
     DoMergedBranch();
   }
   else if (!analyzer.HasOption(PPCAnalyst::PPCAnalyzer::OPTION_CONDITIONAL_CONTINUE))
@@ -56,30 +56,7 @@ void Jit64::psq_stXX(UGeckoInstruction inst)
   if (gqrIsConstant)
   {
     const u32 gqrValue = js.constantGqr[i] & 0xffff;
-    int type = gqrValue & 0x7;
-
-    // Paired stores (other than w/type zero) don't yield any real change in
-    // performance right now, but if we can improve fastmem support this might change
-    if (gqrValue == 0)
-    {
-      if (w)
-        GenQuantizedStore(true, static_cast<EQuantizeType>(type), (gqrValue & 0x3F00) >> 8);
-      else
-        GenQuantizedStore(false, static_cast<EQuantizeType>(type), (gqrValue & 0x3F00) >> 8);
-    }
-    else
-    {
-      // Stash PC in case asm_routine causes exception
-      MOV(32, PPCSTATE(pc), Imm32(js.compilerPC));
-      // We know what GQR is here, so we can load RSCRATCH2 and call into the store method directly
-      // with just the scale bits.
-      MOV(32, R(RSCRATCH2), Imm32(gqrValue & 0x3F00));
-
-      if (w)
-        CALL(asm_routines.single_store_quantized[type]);
-      else
-        CALL(asm_routines.paired_store_quantized[type]);
-    }
+    GenQuantizedStore(w == 1, static_cast<EQuantizeType>(gqrValue & 0x7), (gqrValue & 0x3F00) >> 8);
   }
   else
   {
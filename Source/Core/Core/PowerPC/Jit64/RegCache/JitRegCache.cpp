@@ -487,6 +487,66 @@ void RegCache::PreloadRegisters(BitSet32 to_preload)
   }
 }
 
+RegCache::LoopState RegCache::StartLoop(BitSet32 pregs, BitSet32 dirty_pregs)
+{
+  ASSERT(IsAllUnlocked());
+
+  // Speculative immediates that aren't flushed here would be assumed on every iteration
+  Flush(~pregs);
+
+  LoopState state;
+  for (preg_t preg : pregs)
+  {
+    BindToRegister(preg, true, dirty_pregs[preg]);
+
+    const X64Reg xr = RX(preg);
+    state.bound[preg] = true;
+    state.dirty[preg] = m_xregs[xr].IsDirty();
+    state.xregs[preg] = xr;
+  }
+
+  return state;
+}
+
+void RegCache::ReconcileLoop(const LoopState& state)
+{
+  ASSERT(IsAllUnlocked());
+
+  // First free the host registers of the loop state, so that nothing below has to move registers
+  // that are in each other's way
+  BitSet32 to_flush = ~state.bound;
+  for (preg_t preg : state.bound)
+  {
+    ASSERT_MSG(DYNA_REC, !m_regs[preg].IsDiscarded(), "Loop register {} is discarded", preg);
+
+    if (m_regs[preg].IsBound() ? RX(preg) != state.xregs[preg] :
+                                 m_regs[preg].IsAway() && !state.dirty[preg])
+    {
+      to_flush[preg] = true;
+    }
+  }
+  Flush(to_flush);
+
+  for (preg_t preg : state.bound)
+  {
+    const X64Reg xr = state.xregs[preg];
+    if (m_regs[preg].IsBound())
+    {
+      // Registers that are clean at the head of the loop have to match the register file
+      if (m_xregs[xr].IsDirty() && !state.dirty[preg])
+        StoreRegister(preg, GetDefaultLocation(preg));
+      m_xregs[xr].SetBoundTo(preg, state.dirty[preg]);
+      continue;
+    }
+
+    ASSERT_MSG(DYNA_REC, m_xregs[xr].IsFree(), "Xreg {} of loop register {} is in use",
+               Common::ToUnderlying(xr), preg);
+    m_xregs[xr].SetBoundTo(preg, state.dirty[preg]);
+    LoadRegister(preg, xr);
+    m_regs[preg].SetBoundTo(xr);
+  }
+}
+
 BitSet32 RegCache::RegistersInUse() const
 {
   BitSet32 result;
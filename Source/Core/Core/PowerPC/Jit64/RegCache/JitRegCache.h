@@ -128,6 +128,14 @@ public:
     MaintainState,
   };
 
+  // Where guest registers are kept at the head of a loop, which the loop's back-edge restores
+  struct LoopState
+  {
+    BitSet32 bound;
+    BitSet32 dirty;
+    std::array<Gen::X64Reg, 32> xregs{};
+  };
+
   explicit RegCache(Jit64& jit);
   virtual ~RegCache() = default;
 
@@ -176,6 +184,12 @@ public:
   bool IsAllUnlocked() const;
 
   void PreloadRegisters(BitSet32 pregs);
+
+  // Flushes every register except pregs and binds pregs, marking the ones in dirty_pregs as dirty.
+  // Returns the resulting state, which ReconcileLoop moves the registers back into at the end of
+  // the loop body.
+  LoopState StartLoop(BitSet32 pregs, BitSet32 dirty_pregs);
+  void ReconcileLoop(const LoopState& state);
   BitSet32 RegistersInUse() const;
 
 protected:
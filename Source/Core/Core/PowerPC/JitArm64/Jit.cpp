@@ -51,6 +51,8 @@ void JitArm64::Init()
 
   const size_t child_code_size = jo.memcheck ? FARCODE_SIZE_MMU : FARCODE_SIZE;
   AllocCodeSpace(CODE_SIZE + child_code_size);
+  if (m_huge_pages_enabled)
+    AdviseHugePages();
   AddChildCodeSpace(&m_far_code, child_code_size);
 
   jo.optimizeGatherPipe = true;
@@ -131,6 +133,13 @@ bool JitArm64::HandleFault(uintptr_t access_address, SContext* ctx)
                       fmt::ptr(m_ppc_state.mem_ptr), fmt::ptr(memory.GetPhysicalBase()),
                       fmt::ptr(memory.GetLogicalBase()));
       }
+      else if (m_ppc_state.msr.DR &&
+               m_mmu.MapPageTableAddressForFastmem(static_cast<u32>(access_address - memory_base)))
+      {
+        // The page is translated through the page table and has just been mapped, so the access
+        // can be retried without backpatching it
+        success = true;
+      }
       else
       {
         success = HandleFastmemFault(ctx);
@@ -173,6 +182,7 @@ void JitArm64::ResetFreeMemoryRanges()
 
 void JitArm64::Shutdown()
 {
+  m_hot_block_cache.Save();
   auto& memory = m_system.GetMemory();
   memory.ShutdownFastmemArena();
   FreeCodeSpace();
@@ -877,7 +887,7 @@ void JitArm64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
   // Analyze the block, collect all instructions it is made of (including inlining,
   // if that is enabled), reorder instructions for optimal performance, and join joinable
   // instructions.
-  const u32 nextPC = analyzer.Analyze(em_address, &code_block, &m_code_buffer, block_size);
+  const u32 nextPC = AnalyzeBlock(em_address, block_size);
 
   if (code_block.m_memory_exception)
   {
@@ -966,6 +976,7 @@ bool JitArm64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
   js.isLastInstruction = false;
   js.firstFPInstructionFound = false;
   js.assumeNoPairedQuantize = false;
+  js.constantGqrValid = BitSet8();
   js.blockStart = em_address;
   js.fifoBytesSinceCheck = 0;
   js.mustCheckFifo = false;
@@ -985,14 +996,48 @@ bool JitArm64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
     BeginTimeProfile(b);
   }
 
+  // Count the runs of the block, and have it recompiled once it turns out to be hot.
+  if (ShouldCountRunsForTierUp(js.blockStart))
+  {
+    MOVP2R(ARM64Reg::X0, &b->profile_data);
+    LDR(IndexType::Unsigned, ARM64Reg::X1, ARM64Reg::X0, offsetof(JitBlock::ProfileData, runCount));
+    ADD(ARM64Reg::X1, ARM64Reg::X1, 1);
+    STR(IndexType::Unsigned, ARM64Reg::X1, ARM64Reg::X0, offsetof(JitBlock::ProfileData, runCount));
+    CMPI2R(ARM64Reg::X1, TIER_UP_RUN_COUNT, ARM64Reg::X2);
+    FixupBranch not_hot = B(CC_NEQ);
+    FixupBranch hot = B();
+    SwitchToFarCode();
+    SetJumpTarget(hot);
+    MOVI2R(DISPATCHER_PC, js.blockStart);
+    STR(IndexType::Unsigned, DISPATCHER_PC, PPC_REG, PPCSTATE_OFF(pc));
+    MOVP2R(ARM64Reg::X0, &m_system.GetJitInterface());
+    MOVI2R(ARM64Reg::W1, static_cast<u32>(JitInterface::ExceptionType::HotBlock));
+    MOVP2R(ARM64Reg::X2, &JitInterface::CompileExceptionCheckFromJIT);
+    BLR(ARM64Reg::X2);
+    B(dispatcher_no_check);
+    SwitchToNearCode();
+    SetJumpTarget(not_hot);
+  }
+
   if (code_block.m_gqr_used.Count() == 1 &&
       js.pairedQuantizeAddresses.find(js.blockStart) == js.pairedQuantizeAddresses.end())
   {
     int gqr = *code_block.m_gqr_used.begin();
-    if (!code_block.m_gqr_modified[gqr] && !GQR(m_ppc_state, gqr))
+    if (!code_block.m_gqr_modified[gqr])
     {
+      // Assume that the GQR keeps the value it has now, and check that at the start of the block
+      const u32 gqr_value = GQR(m_ppc_state, gqr);
       LDR(IndexType::Unsigned, ARM64Reg::W0, PPC_REG, PPCSTATE_OFF_SPR(SPR_GQR0 + gqr));
-      FixupBranch no_fail = CBZ(ARM64Reg::W0);
+      FixupBranch no_fail;
+      if (gqr_value == 0)
+      {
+        no_fail = CBZ(ARM64Reg::W0);
+      }
+      else
+      {
+        CMPI2R(ARM64Reg::W0, gqr_value, ARM64Reg::W1);
+        no_fail = B(CC_EQ);
+      }
       FixupBranch fail = B();
       SwitchToFarCode();
       SetJumpTarget(fail);
@@ -1005,7 +1050,16 @@ bool JitArm64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
       B(dispatcher_no_check);
       SwitchToNearCode();
       SetJumpTarget(no_fail);
-      js.assumeNoPairedQuantize = true;
+
+      if (gqr_value == 0)
+      {
+        js.assumeNoPairedQuantize = true;
+      }
+      else
+      {
+        js.constantGqr[gqr] = gqr_value;
+        js.constantGqrValid[gqr] = true;
+      }
     }
   }
 
@@ -1052,7 +1106,7 @@ bool JitArm64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
           js.fifoWriteAddresses.find(prev_address) != js.fifoWriteAddresses.end();
 
       if (jo.optimizeGatherPipe &&
-          (js.fifoBytesSinceCheck >= GPFifo::GATHER_PIPE_SIZE || js.mustCheckFifo))
+          (js.fifoBytesSinceCheck >= GPFifo::GATHER_PIPE_JIT_CHECK_SIZE || js.mustCheckFifo))
       {
         js.fifoBytesSinceCheck = 0;
         js.mustCheckFifo = false;
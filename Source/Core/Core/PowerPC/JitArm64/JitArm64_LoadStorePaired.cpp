@@ -147,9 +147,6 @@ void JitArm64::psq_stXX(UGeckoInstruction inst)
   INSTRUCTION_START
   JITDISABLE(bJITLoadStorePairedOff);
 
-  // If we have a fastmem arena, the asm routines assume address translation is on.
-  FALLBACK_IF(!js.assumeNoPairedQuantize && jo.fastmem_arena && !m_ppc_state.msr.DR);
-
   // X30 is LR
   // X0 contains the scale
   // X1 is the address
@@ -161,6 +158,19 @@ void JitArm64::psq_stXX(UGeckoInstruction inst)
   const int i = indexed ? inst.Ix : inst.I;
   const int w = indexed ? inst.Wx : inst.W;
 
+  // With a GQR that is known at compile time, the store is quantized inline instead of in the asm
+  // routine for the type
+  const u32 gqr_value = js.constantGqr[i] & 0xffff;
+  const EQuantizeType type = static_cast<EQuantizeType>(gqr_value & 0x7);
+  const bool quantize_inline =
+      !js.assumeNoPairedQuantize && js.constantGqrValid[i] &&
+      (type == QUANTIZE_FLOAT || type == QUANTIZE_U8 || type == QUANTIZE_U16 ||
+       type == QUANTIZE_S8 || type == QUANTIZE_S16);
+
+  // If we have a fastmem arena, the asm routines assume address translation is on.
+  FALLBACK_IF(!js.assumeNoPairedQuantize && !quantize_inline && jo.fastmem_arena &&
+              !m_ppc_state.msr.DR);
+
   fpr.Lock(ARM64Reg::Q0);
   if (!js.assumeNoPairedQuantize)
     fpr.Lock(ARM64Reg::Q1);
@@ -251,6 +261,66 @@ void JitArm64::psq_stXX(UGeckoInstruction inst)
     EmitBackpatchRoutine(flags, MemAccessMode::Auto, VS, EncodeRegTo64(addr_reg), gprs_in_use,
                          fprs_in_use);
   }
+  else if (quantize_inline)
+  {
+    // The same as the asm routine for the type, with the scale as a constant
+    const u32 scale = (gqr_value & 0x3F00) >> 8;
+    if (type != QUANTIZE_FLOAT && scale != 0)
+    {
+      const s32 load_offset = MOVPage2R(ARM64Reg::X2, &m_quantizeTableS[scale * 2]);
+      m_float_emit.LDR(32, IndexType::Unsigned, ARM64Reg::D1, ARM64Reg::X2, load_offset);
+      if (w)
+        m_float_emit.FMUL(32, ARM64Reg::D0, ARM64Reg::D0, ARM64Reg::D1);
+      else
+        m_float_emit.FMUL(32, ARM64Reg::D0, ARM64Reg::D0, ARM64Reg::D1, 0);
+    }
+
+    u32 flags = BackPatchInfo::FLAG_STORE | BackPatchInfo::FLAG_FLOAT;
+    switch (type)
+    {
+    case QUANTIZE_U8:
+      m_float_emit.FCVTZU(32, ARM64Reg::D0, ARM64Reg::D0);
+      m_float_emit.UQXTN(16, ARM64Reg::D0, ARM64Reg::D0);
+      m_float_emit.UQXTN(8, ARM64Reg::D0, ARM64Reg::D0);
+      flags |= BackPatchInfo::FLAG_SIZE_8;
+      break;
+    case QUANTIZE_S8:
+      m_float_emit.FCVTZS(32, ARM64Reg::D0, ARM64Reg::D0);
+      m_float_emit.SQXTN(16, ARM64Reg::D0, ARM64Reg::D0);
+      m_float_emit.SQXTN(8, ARM64Reg::D0, ARM64Reg::D0);
+      flags |= BackPatchInfo::FLAG_SIZE_8;
+      break;
+    case QUANTIZE_U16:
+      m_float_emit.FCVTZU(32, ARM64Reg::D0, ARM64Reg::D0);
+      m_float_emit.UQXTN(16, ARM64Reg::D0, ARM64Reg::D0);
+      flags |= BackPatchInfo::FLAG_SIZE_16;
+      break;
+    case QUANTIZE_S16:
+      m_float_emit.FCVTZS(32, ARM64Reg::D0, ARM64Reg::D0);
+      m_float_emit.SQXTN(16, ARM64Reg::D0, ARM64Reg::D0);
+      flags |= BackPatchInfo::FLAG_SIZE_16;
+      break;
+    default:
+      flags |= BackPatchInfo::FLAG_SIZE_32;
+      break;
+    }
+    if (!w)
+      flags |= BackPatchInfo::FLAG_PAIR;
+
+    BitSet32 gprs_in_use = gpr.GetCallerSavedUsed();
+    BitSet32 fprs_in_use = fpr.GetCallerSavedUsed();
+
+    // Wipe the registers we are using as temporaries
+    gprs_in_use[DecodeReg(ARM64Reg::W0)] = false;
+    if (!update || early_update)
+      gprs_in_use[DecodeReg(ARM64Reg::W1)] = false;
+    gprs_in_use[DecodeReg(ARM64Reg::W2)] = false;
+    fprs_in_use[DecodeReg(ARM64Reg::Q0)] = false;
+    fprs_in_use[DecodeReg(ARM64Reg::Q1)] = false;
+
+    EmitBackpatchRoutine(flags, MemAccessMode::Auto, ARM64Reg::D0, EncodeRegTo64(addr_reg),
+                         gprs_in_use, fprs_in_use);
+  }
   else
   {
     LDR(IndexType::Unsigned, scale_reg, PPC_REG, PPCSTATE_OFF_SPR(SPR_GQR0 + i));
@@ -174,7 +174,13 @@ void JitArm64::GenerateAsm()
   MOVP2R(ARM64Reg::X8, reinterpret_cast<void*>(&JitTrampoline));
   BLR(ARM64Reg::X8);
   LDR(IndexType::Unsigned, DISPATCHER_PC, PPC_REG, PPCSTATE_OFF(pc));
-  B(dispatcher_no_check);
+
+  // With deferred compilation, the block may have been interpreted instead, which can change the
+  // memory base and use up the downcount
+  EmitUpdateMembase();
+  LDR(IndexType::Unsigned, ARM64Reg::W0, PPC_REG, PPCSTATE_OFF(downcount));
+  CMP(ARM64Reg::W0, 0);
+  B(dispatcher);
 
   SetJumpTarget(bail);
   do_timing = GetCodePtr();
@@ -0,0 +1,139 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/PowerPC/JitCommon/HotBlockCache.h"
+
+#include <cstring>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Common/CommonPaths.h"
+#include "Common/Crypto/SHA1.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+
+namespace
+{
+struct Header
+{
+  u32 magic;
+  u32 version;
+  u32 entry_count;
+  u32 padding;
+};
+static_assert(sizeof(Header) == 0x10, "Wrong size for hot block cache header");
+}  // namespace
+
+HotBlockCache::~HotBlockCache()
+{
+  Save();
+}
+
+void HotBlockCache::SetGame(const std::string& game_id, u16 revision)
+{
+  if (game_id == m_game_id && revision == m_revision)
+    return;
+
+  Save();
+
+  m_game_id = game_id;
+  m_revision = revision;
+  m_entries.clear();
+  m_dirty = false;
+  m_path.clear();
+
+  if (!m_game_id.empty())
+  {
+    m_path = fmt::format("{}JIT" DIR_SEP "{}_{}.hbc", File::GetUserPath(D_CACHE_IDX), m_game_id,
+                         m_revision);
+    Load();
+  }
+}
+
+void HotBlockCache::Load()
+{
+  File::IOFile file(m_path, "rb");
+  if (!file)
+    return;
+
+  Header header;
+  if (!file.ReadArray(&header, 1) || header.magic != MAGIC || header.version != VERSION ||
+      file.GetSize() < sizeof(Header) + u64(header.entry_count) * sizeof(Entry))
+  {
+    WARN_LOG_FMT(DYNA_REC, "Ignoring invalid hot block cache {}", m_path);
+    return;
+  }
+
+  std::vector<Entry> entries(header.entry_count);
+  if (!file.ReadArray(entries.data(), entries.size()))
+  {
+    WARN_LOG_FMT(DYNA_REC, "Failed to read hot block cache {}", m_path);
+    return;
+  }
+
+  for (const Entry& entry : entries)
+    m_entries.emplace(GetKey(entry.address, entry.msr_bits), entry);
+
+  INFO_LOG_FMT(DYNA_REC, "Loaded {} hot blocks from {}", m_entries.size(), m_path);
+}
+
+void HotBlockCache::Save()
+{
+  if (!m_dirty || m_path.empty())
+    return;
+
+  m_dirty = false;
+
+  std::vector<Entry> entries;
+  entries.reserve(m_entries.size());
+  for (const auto& [key, entry] : m_entries)
+    entries.push_back(entry);
+
+  const Header header{MAGIC, VERSION, static_cast<u32>(entries.size()), 0};
+
+  File::CreateFullPath(m_path);
+  File::IOFile file(m_path, "wb");
+  if (!file || !file.WriteArray(&header, 1) || !file.WriteArray(entries.data(), entries.size()))
+    ERROR_LOG_FMT(DYNA_REC, "Failed to write hot block cache {}", m_path);
+}
+
+const HotBlockCache::Entry* HotBlockCache::Find(u32 address, u32 msr_bits) const
+{
+  const auto it = m_entries.find(GetKey(address, msr_bits));
+  return it != m_entries.end() ? &it->second : nullptr;
+}
+
+void HotBlockCache::Insert(const Entry& entry)
+{
+  if (m_path.empty())
+    return;
+
+  m_entries.insert_or_assign(GetKey(entry.address, entry.msr_bits), entry);
+  m_dirty = true;
+}
+
+void HotBlockCache::Erase(u32 address, u32 msr_bits)
+{
+  if (m_entries.erase(GetKey(address, msr_bits)) != 0)
+    m_dirty = true;
+}
+
+u64 HotBlockCache::HashCode(const PPCAnalyst::CodeBuffer& buffer, u32 instruction_count)
+{
+  // Branch following makes blocks non-contiguous, so the address of each instruction is hashed
+  // along with the instruction
+  std::vector<u32> code;
+  code.reserve(instruction_count * 2);
+  for (u32 i = 0; i < instruction_count; ++i)
+  {
+    code.push_back(buffer[i].address);
+    code.push_back(buffer[i].inst.hex);
+  }
+
+  const Common::SHA1::Digest digest = Common::SHA1::CalculateDigest(code);
+  u64 hash;
+  std::memcpy(&hash, digest.data(), sizeof(hash));
+  return hash;
+}
@@ -0,0 +1,64 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+
+#include "Common/CommonTypes.h"
+#include "Core/PowerPC/PPCAnalyst.h"
+
+// Remembers which blocks of a game turned hot in earlier sessions, so that the JIT can compile
+// them as hot blocks right away instead of compiling them once normally and again once they
+// have run often enough. An entry is only used if analyzing the code at its address gives the
+// same instructions as when the entry was stored.
+//
+// The cache of each game is stored in User/Cache/JIT/<game ID>_<revision>.hbc, in host byte order.
+class HotBlockCache
+{
+public:
+  static constexpr u32 MAGIC = 0x31434248;  // "HBC1"
+  static constexpr u32 VERSION = 1;
+
+#pragma pack(push, 1)
+  struct Entry
+  {
+    u32 address;
+    u32 msr_bits;
+    u32 instruction_count;
+    u32 padding;
+    // Hash of the addresses and instructions of the analyzed block
+    u64 code_hash;
+  };
+  static_assert(sizeof(Entry) == 0x18, "Wrong size for hot block cache entry");
+#pragma pack(pop)
+
+  HotBlockCache() = default;
+  ~HotBlockCache();
+
+  HotBlockCache(const HotBlockCache&) = delete;
+  HotBlockCache& operator=(const HotBlockCache&) = delete;
+
+  // Saves the entries of the current game if they changed, then loads the entries of the given
+  // game. Does nothing if the game is the current game.
+  void SetGame(const std::string& game_id, u16 revision);
+  void Save();
+
+  const Entry* Find(u32 address, u32 msr_bits) const;
+  void Insert(const Entry& entry);
+  void Erase(u32 address, u32 msr_bits);
+
+  static u64 HashCode(const PPCAnalyst::CodeBuffer& buffer, u32 instruction_count);
+
+private:
+  static u64 GetKey(u32 address, u32 msr_bits) { return (u64(msr_bits) << 32) | address; }
+
+  void Load();
+
+  std::string m_game_id;
+  u16 m_revision = 0;
+  std::string m_path;
+  std::unordered_map<u64, Entry> m_entries;
+  bool m_dirty = false;
+};
@@ -11,6 +11,7 @@
 #include "Common/CommonTypes.h"
 #include "Common/MemoryUtil.h"
 #include "Common/Thread.h"
+#include "Common/Timer.h"
 
 #include "Core/CPUThreadConfigCallback.h"
 #include "Core/Config/MainSettings.h"
@@ -19,6 +20,10 @@
 #include "Core/CoreTiming.h"
 #include "Core/HW/CPU.h"
 #include "Core/MemTools.h"
+#include "Core/Movie.h"
+#include "Core/NetPlayProto.h"
+#include "Core/PowerPC/Interpreter/Interpreter.h"
+#include "Core/PowerPC/JitInterface.h"
 #include "Core/PowerPC/PPCAnalyst.h"
 #include "Core/PowerPC/PowerPC.h"
 #include "Core/System.h"
@@ -57,7 +62,7 @@
 // After resetting the stack to the top, we call _resetstkoflw() to restore
 // the guard page at the 256kb mark.
 
-const std::array<std::pair<bool JitBase::*, const Config::Info<bool>*>, 22> JitBase::JIT_SETTINGS{{
+const std::array<std::pair<bool JitBase::*, const Config::Info<bool>*>, 27> JitBase::JIT_SETTINGS{{
     {&JitBase::bJITOff, &Config::MAIN_DEBUG_JIT_OFF},
     {&JitBase::bJITLoadStoreOff, &Config::MAIN_DEBUG_JIT_LOAD_STORE_OFF},
     {&JitBase::bJITLoadStorelXzOff, &Config::MAIN_DEBUG_JIT_LOAD_STORE_LXZ_OFF},
@@ -73,12 +78,17 @@ const std::array<std::pair<bool JitBase::*, const Config::Info<bool>*>, 22> JitB
     {&JitBase::bJITRegisterCacheOff, &Config::MAIN_DEBUG_JIT_REGISTER_CACHE_OFF},
     {&JitBase::m_enable_debugging, &Config::MAIN_ENABLE_DEBUGGING},
     {&JitBase::m_enable_branch_following, &Config::MAIN_JIT_FOLLOW_BRANCH},
+    {&JitBase::m_enable_tier_up, &Config::MAIN_JIT_TIER_UP},
+    {&JitBase::m_enable_hot_block_cache, &Config::MAIN_JIT_HOT_BLOCK_CACHE},
+    {&JitBase::m_enable_deferred_compilation, &Config::MAIN_JIT_DEFER_COMPILATION},
+    {&JitBase::m_enable_loop_registers, &Config::MAIN_JIT_KEEP_LOOP_REGISTERS},
     {&JitBase::m_enable_float_exceptions, &Config::MAIN_FLOAT_EXCEPTIONS},
     {&JitBase::m_enable_div_by_zero_exceptions, &Config::MAIN_DIVIDE_BY_ZERO_EXCEPTIONS},
     {&JitBase::m_low_dcbz_hack, &Config::MAIN_LOW_DCBZ_HACK},
     {&JitBase::m_fprf, &Config::MAIN_FPRF},
     {&JitBase::m_accurate_nans, &Config::MAIN_ACCURATE_NANS},
     {&JitBase::m_fastmem_enabled, &Config::MAIN_FASTMEM},
+    {&JitBase::m_huge_pages_enabled, &Config::MAIN_HUGE_PAGES},
     {&JitBase::m_accurate_cpu_cache_enabled, &Config::MAIN_ACCURATE_CPU_CACHE},
 }};
 
@@ -89,7 +99,21 @@ const u8* JitBase::Dispatch(JitBase& jit)
 
 void JitTrampoline(JitBase& jit, u32 em_address)
 {
+  if (!jit.jo.defer_compilation)
+  {
+    jit.Jit(em_address);
+    return;
+  }
+
+  if (!jit.HasCompileBudget())
+  {
+    jit.InterpretBlock();
+    return;
+  }
+
+  const u64 start_us = Common::Timer::NowUs();
   jit.Jit(em_address);
+  jit.ChargeCompileTime(Common::Timer::NowUs() - start_us);
 }
 
 JitBase::JitBase(Core::System& system)
@@ -144,6 +168,87 @@ void JitBase::RefreshConfig(InitFastmemArena init_fastmem_arena)
   jo.memcheck = m_system.IsMMUMode() || m_system.IsPauseOnPanicMode() || any_watchpoints;
   jo.fp_exceptions = m_enable_float_exceptions;
   jo.div_by_zero_exceptions = m_enable_div_by_zero_exceptions;
+  // Recompiling blocks would get in the way of stepping through them
+  jo.tier_up = m_enable_tier_up && !m_enable_debugging;
+  // Whether a block gets interpreted depends on the host's speed, which would make the timing of
+  // the emulated CPU differ between the participants of a movie or netplay session
+  jo.defer_compilation = m_enable_deferred_compilation && !m_enable_debugging &&
+                         !Movie::IsMovieActive() && !NetPlay::IsNetPlayRunning();
+}
+
+bool JitBase::ShouldCountRunsForTierUp(u32 address) const
+{
+  // Block profiling counts runs itself and wants blocks to stay as they are
+  return jo.tier_up && !jo.profile_blocks && !js.hotBlockAddresses.contains(address);
+}
+
+u32 JitBase::AnalyzeBlock(u32 em_address, std::size_t block_size)
+{
+  const bool use_hot_block_cache = jo.tier_up && m_enable_hot_block_cache;
+  if (use_hot_block_cache)
+  {
+    const SConfig& config = SConfig::GetInstance();
+    m_hot_block_cache.SetGame(config.GetGameID(), config.GetRevision());
+  }
+
+  const u32 msr_bits = m_ppc_state.msr.Hex & JitBaseBlockCache::JIT_CACHE_MSR_MASK;
+  const bool hot = js.hotBlockAddresses.contains(em_address);
+  const HotBlockCache::Entry* cached =
+      use_hot_block_cache && !hot ? m_hot_block_cache.Find(em_address, msr_bits) : nullptr;
+
+  analyzer.SetBranchFollowingThreshold(hot || cached ?
+                                           PPCAnalyst::HOT_BLOCK_BRANCH_FOLLOWING_THRESHOLD :
+                                           PPCAnalyst::BRANCH_FOLLOWING_THRESHOLD);
+  const u32 next_pc = analyzer.Analyze(em_address, &code_block, &m_code_buffer, block_size);
+  if (code_block.m_memory_exception || (!hot && !cached))
+    return next_pc;
+
+  const u64 code_hash = HotBlockCache::HashCode(m_code_buffer, code_block.m_num_instructions);
+  if (hot)
+  {
+    if (use_hot_block_cache)
+      m_hot_block_cache.Insert({em_address, msr_bits, code_block.m_num_instructions, 0, code_hash});
+    return next_pc;
+  }
+
+  if (cached->instruction_count == code_block.m_num_instructions &&
+      cached->code_hash == code_hash)
+  {
+    js.hotBlockAddresses.insert(em_address);
+    return next_pc;
+  }
+
+  // The game has different code at this address than when the block was cached
+  m_hot_block_cache.Erase(em_address, msr_bits);
+  analyzer.SetBranchFollowingThreshold(PPCAnalyst::BRANCH_FOLLOWING_THRESHOLD);
+  return analyzer.Analyze(em_address, &code_block, &m_code_buffer, block_size);
+}
+
+bool JitBase::HasCompileBudget()
+{
+  const u64 now_us = Common::Timer::NowUs();
+  const u64 elapsed_us = now_us - m_compile_budget_updated_us;
+  m_compile_budget_updated_us = now_us;
+
+  // Clamped first, since the first call sees all the time since the epoch of the clock
+  const u64 refill_us = std::min<u64>(elapsed_us / COMPILE_TIME_SHARE, MAX_COMPILE_BUDGET_US);
+  m_compile_budget_us =
+      std::min(m_compile_budget_us + static_cast<s64>(refill_us), MAX_COMPILE_BUDGET_US);
+  return m_compile_budget_us > 0;
+}
+
+void JitBase::ChargeCompileTime(u64 compile_time_us)
+{
+  m_compile_budget_us -= static_cast<s64>(compile_time_us);
+}
+
+void JitBase::InterpretBlock()
+{
+  m_ppc_state.downcount -= m_system.GetInterpreter().SingleStepBlock();
+
+  // Unlike the JIT, the interpreter doesn't update the memory base when rfi or mtmsr change the
+  // address translation mode
+  m_system.GetJitInterface().UpdateMembase();
 }
 
 void JitBase::InitBLROptimization()
@@ -18,6 +18,7 @@
 #include "Core/MachineContext.h"
 #include "Core/PowerPC/CPUCoreBase.h"
 #include "Core/PowerPC/JitCommon/JitAsmCommon.h"
+#include "Core/PowerPC/JitCommon/HotBlockCache.h"
 #include "Core/PowerPC/JitCommon/JitCache.h"
 #include "Core/PowerPC/PPCAnalyst.h"
 
@@ -85,6 +86,8 @@ protected:
     bool fp_exceptions;
     bool div_by_zero_exceptions;
     bool profile_blocks;
+    bool tier_up;
+    bool defer_compilation;
   };
   struct JitState
   {
@@ -127,6 +130,8 @@ protected:
     std::unordered_set<u32> fifoWriteAddresses;
     std::unordered_set<u32> pairedQuantizeAddresses;
     std::unordered_set<u32> noSpeculativeConstantsAddresses;
+    // Start addresses of blocks that reached TIER_UP_RUN_COUNT and were recompiled
+    std::unordered_set<u32> hotBlockAddresses;
   };
 
   PPCAnalyst::CodeBlock code_block;
@@ -149,19 +154,24 @@ protected:
   bool bJITRegisterCacheOff = false;
   bool m_enable_debugging = false;
   bool m_enable_branch_following = false;
+  bool m_enable_tier_up = false;
+  bool m_enable_hot_block_cache = false;
+  bool m_enable_deferred_compilation = false;
+  bool m_enable_loop_registers = false;
   bool m_enable_float_exceptions = false;
   bool m_enable_div_by_zero_exceptions = false;
   bool m_low_dcbz_hack = false;
   bool m_fprf = false;
   bool m_accurate_nans = false;
   bool m_fastmem_enabled = false;
+  bool m_huge_pages_enabled = false;
   bool m_accurate_cpu_cache_enabled = false;
 
   bool m_enable_blr_optimization = false;
   bool m_cleanup_after_stackfault = false;
   u8* m_stack_guard = nullptr;
 
-  static const std::array<std::pair<bool JitBase::*, const Config::Info<bool>*>, 22> JIT_SETTINGS;
+  static const std::array<std::pair<bool JitBase::*, const Config::Info<bool>*>, 27> JIT_SETTINGS;
 
   enum class InitFastmemArena
   {
@@ -172,6 +182,28 @@ protected:
   bool DoesConfigNeedRefresh();
   void RefreshConfig(InitFastmemArena init_fastmem_arena);
 
+  // With tier-up enabled, blocks count how often they run. A block that reaches TIER_UP_RUN_COUNT
+  // enters the hot block set and is invalidated, and its next compile covers a larger region.
+  static constexpr u64 TIER_UP_RUN_COUNT = 5000;
+  bool ShouldCountRunsForTierUp(u32 address) const;
+
+  // Analyzes the block at em_address into code_block and m_code_buffer. Hot blocks are analyzed
+  // for a larger region, and so are blocks the hot block cache knows as hot, if the code still
+  // matches the cache.
+  u32 AnalyzeBlock(u32 em_address, std::size_t block_size);
+  HotBlockCache m_hot_block_cache;
+
+  // With deferred compilation, compiling blocks may take up 1 / COMPILE_TIME_SHARE of the time on
+  // the CPU thread, in bursts of up to MAX_COMPILE_BUDGET_US. A block the dispatcher doesn't find
+  // while the budget is used up is interpreted instead, and compiled on a later dispatch.
+  static constexpr u64 COMPILE_TIME_SHARE = 4;
+  static constexpr s64 MAX_COMPILE_BUDGET_US = 4000;
+  bool HasCompileBudget();
+  void ChargeCompileTime(u64 compile_time_us);
+  void InterpretBlock();
+  s64 m_compile_budget_us = MAX_COMPILE_BUDGET_US;
+  u64 m_compile_budget_updated_us = 0;
+
   void InitBLROptimization();
   void ProtectStack();
   void UnprotectStack();
@@ -210,6 +242,8 @@ public:
   Core::System& m_system;
   PowerPC::PowerPCState& m_ppc_state;
   PowerPC::MMU& m_mmu;
+
+  friend void JitTrampoline(JitBase& jit, u32 em_address);
 };
 
 void JitTrampoline(JitBase& jit, u32 em_address);
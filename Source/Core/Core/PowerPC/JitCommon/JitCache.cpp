@@ -8,10 +8,13 @@
 #include <cstring>
 #include <functional>
 #include <map>
+#include <memory>
 #include <set>
 #include <utility>
+#include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/Counters.h"
 #include "Common/JitRegister.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/Core.h"
@@ -26,13 +29,17 @@
 
 using namespace Gen;
 
+static Common::Counter s_compiled_blocks("dolphin_jit_blocks_compiled_total",
+                                         "Blocks compiled by the JIT");
+
 bool JitBlock::OverlapsPhysicalRange(u32 address, u32 length) const
 {
-  return physical_addresses.lower_bound(address) !=
-         physical_addresses.lower_bound(address + length);
+  const auto it = std::lower_bound(physical_addresses.begin(), physical_addresses.end(), address);
+  return it != physical_addresses.end() && *it < u64(address) + length;
 }
 
-JitBaseBlockCache::JitBaseBlockCache(JitBase& jit) : m_jit{jit}
+JitBaseBlockCache::JitBaseBlockCache(JitBase& jit)
+    : m_jit{jit}, m_block_lookup_table(BLOCK_LOOKUP_TABLE_MIN_SIZE)
 {
 }
 
@@ -40,7 +47,8 @@ JitBaseBlockCache::~JitBaseBlockCache() = default;
 
 void JitBaseBlockCache::Init()
 {
-  Common::JitRegister::Init(Config::Get(Config::MAIN_PERF_MAP_DIR));
+  Common::JitRegister::Init(Config::Get(Config::MAIN_PERF_MAP_DIR),
+                            Config::Get(Config::MAIN_PERF_JITDUMP));
 
 #ifdef _ARCH_64
   m_entry_points_ptr = reinterpret_cast<u8**>(m_entry_points_arena.Create(FAST_BLOCK_MAP_SIZE));
@@ -68,13 +76,18 @@ void JitBaseBlockCache::Clear()
   m_jit.js.fifoWriteAddresses.clear();
   m_jit.js.pairedQuantizeAddresses.clear();
   m_jit.js.noSpeculativeConstantsAddresses.clear();
+  m_jit.js.hotBlockAddresses.clear();
   for (auto& e : block_map)
   {
     DestroyBlock(e.second);
   }
   block_map.clear();
   links_to.clear();
-  block_range_map.clear();
+
+  m_block_lookup_table.assign(BLOCK_LOOKUP_TABLE_MIN_SIZE, {});
+  m_block_lookup_count = 0;
+  for (std::unique_ptr<PageListLeaf>& leaf : m_page_lists)
+    leaf.reset();
 
   valid_block.ClearAll();
 
@@ -119,6 +132,8 @@ JitBlock* JitBaseBlockCache::AllocateBlock(u32 em_address)
 void JitBaseBlockCache::FinalizeBlock(JitBlock& block, bool block_link,
                                       const std::set<u32>& physical_addresses)
 {
+  s_compiled_blocks.Add();
+
   size_t index = FastLookupIndexForAddress(block.effectiveAddress, block.msrBits);
   if (m_entry_points_ptr)
     m_entry_points_ptr[index] = block.normalEntry;
@@ -126,14 +141,21 @@ void JitBaseBlockCache::FinalizeBlock(JitBlock& block, bool block_link,
     m_fast_block_map_fallback[index] = &block;
   block.fast_block_map_index = index;
 
-  block.physical_addresses = physical_addresses;
+  block.physical_addresses.assign(physical_addresses.begin(), physical_addresses.end());
 
-  u32 range_mask = ~(BLOCK_RANGE_MAP_ELEMENTS - 1);
+  // The addresses are sorted, so the addresses in each page are next to each other
+  block.page_list_nodes.clear();
   for (u32 addr : physical_addresses)
   {
     valid_block.Set(addr / 32);
-    block_range_map[addr & range_mask].insert(&block);
+    const u32 page = addr & ~(INVALIDATION_PAGE_SIZE - 1);
+    if (block.page_list_nodes.empty() || block.page_list_nodes.back().page != page)
+      block.page_list_nodes.push_back({&block, nullptr, nullptr, page});
   }
+  for (JitBlock::PageListNode& node : block.page_list_nodes)
+    LinkIntoPageList(node);
+
+  InsertIntoLookupTable(block);
 
   if (block_link)
   {
@@ -172,15 +194,20 @@ JitBlock* JitBaseBlockCache::GetBlockFromStartAddress(u32 addr, u32 msr)
     translated_addr = translated.address;
   }
 
-  auto iter = block_map.equal_range(translated_addr);
-  for (; iter.first != iter.second; iter.first++)
+  const u32 msr_bits = msr & JIT_CACHE_MSR_MASK;
+  const size_t mask = m_block_lookup_table.size() - 1;
+  for (size_t i = LookupTableHomeIndex(addr, msr_bits);; i = (i + 1) & mask)
   {
-    JitBlock& b = iter.first->second;
-    if (b.effectiveAddress == addr && b.msrBits == (msr & JIT_CACHE_MSR_MASK))
-      return &b;
-  }
+    const BlockLookupEntry& entry = m_block_lookup_table[i];
+    if (!entry.block)
+      return nullptr;
 
-  return nullptr;
+    if (entry.effective_address == addr && entry.msr_bits == msr_bits &&
+        entry.block->physicalAddress == translated_addr)
+    {
+      return entry.block;
+    }
+  }
 }
 
 const u8* JitBaseBlockCache::Dispatch()
@@ -299,6 +326,7 @@ void JitBaseBlockCache::InvalidateICacheInternal(u32 physical_address, u32 addre
         m_jit.js.fifoWriteAddresses.erase(i);
         m_jit.js.pairedQuantizeAddresses.erase(i);
         m_jit.js.noSpeculativeConstantsAddresses.erase(i);
+        m_jit.js.hotBlockAddresses.erase(i);
       }
     }
   }
@@ -306,50 +334,50 @@ void JitBaseBlockCache::InvalidateICacheInternal(u32 physical_address, u32 addre
 
 void JitBaseBlockCache::ErasePhysicalRange(u32 address, u32 length)
 {
-  // Iterate over all macro blocks which overlap the given range.
-  u32 range_mask = ~(BLOCK_RANGE_MAP_ELEMENTS - 1);
-  auto start = block_range_map.lower_bound(address & range_mask);
-  auto end = block_range_map.lower_bound(address + length);
-  while (start != end)
+  // Iterate over all pages which overlap the given range.
+  const u64 end = std::min<u64>(u64(address) + length, 1ull << 32);
+  u64 page = address & ~(INVALIDATION_PAGE_SIZE - 1);
+  while (page < end)
   {
-    // Iterate over all blocks in the macro block.
-    auto iter = start->second.begin();
-    while (iter != start->second.end())
+    JitBlock::PageListNode** head = GetPageListHead(static_cast<u32>(page), false);
+    if (!head)
     {
-      JitBlock* block = *iter;
-      if (block->OverlapsPhysicalRange(address, length))
-      {
-        // If the block overlaps, also remove all other occupied slots in the other macro blocks.
-        // This will leak empty macro blocks, but they may be reused or cleared later on.
-        for (u32 addr : block->physical_addresses)
-          if ((addr & range_mask) != start->first)
-            block_range_map[addr & range_mask].erase(block);
-
-        // And remove the block.
-        DestroyBlock(*block);
-        auto block_map_iter = block_map.equal_range(block->physicalAddress);
-        while (block_map_iter.first != block_map_iter.second)
-        {
-          if (&block_map_iter.first->second == block)
-          {
-            block_map.erase(block_map_iter.first);
-            break;
-          }
-          block_map_iter.first++;
-        }
-        iter = start->second.erase(iter);
-      }
-      else
-      {
-        iter++;
-      }
+      // No page in this leaf ever had code in it.
+      page = (page | ((1u << PAGE_LIST_LEAF_SHIFT) - 1)) + 1;
+      continue;
     }
 
-    // If the macro block is empty, drop it.
-    if (start->second.empty())
-      start = block_range_map.erase(start);
-    else
-      start++;
+    // Iterate over all blocks in the page. A block has only one node per page, so removing it
+    // leaves the next node in the list.
+    JitBlock::PageListNode* node = *head;
+    while (node)
+    {
+      JitBlock::PageListNode* next = node->next;
+      if (node->block->OverlapsPhysicalRange(address, length))
+        EraseBlock(*node->block);
+      node = next;
+    }
+
+    page += INVALIDATION_PAGE_SIZE;
+  }
+}
+
+void JitBaseBlockCache::EraseBlock(JitBlock& block)
+{
+  for (JitBlock::PageListNode& node : block.page_list_nodes)
+    UnlinkFromPageList(node);
+  EraseFromLookupTable(block);
+
+  DestroyBlock(block);
+  auto block_map_iter = block_map.equal_range(block.physicalAddress);
+  while (block_map_iter.first != block_map_iter.second)
+  {
+    if (&block_map_iter.first->second == &block)
+    {
+      block_map.erase(block_map_iter.first);
+      break;
+    }
+    block_map_iter.first++;
   }
 }
 
@@ -505,3 +533,99 @@ size_t JitBaseBlockCache::FastLookupIndexForAddress(u32 address, u32 msr)
     return (address >> 2) & FAST_BLOCK_MAP_FALLBACK_MASK;
   }
 }
+
+size_t JitBaseBlockCache::LookupTableHomeIndex(u32 address, u32 msr) const
+{
+  // Fibonacci hashing. Addresses of blocks are close together, so the key has to be mixed well.
+  const u64 key = (u64(msr) << 32) | address;
+  return static_cast<size_t>((key * 0x9E3779B97F4A7C15) >> 32) & (m_block_lookup_table.size() - 1);
+}
+
+void JitBaseBlockCache::InsertIntoLookupTable(JitBlock& block)
+{
+  // Keep the table at most half full so that probe sequences stay short.
+  if ((m_block_lookup_count + 1) * 2 > m_block_lookup_table.size())
+    ResizeLookupTable(m_block_lookup_table.size() * 2);
+
+  const size_t mask = m_block_lookup_table.size() - 1;
+  size_t i = LookupTableHomeIndex(block.effectiveAddress, block.msrBits);
+  while (m_block_lookup_table[i].block)
+    i = (i + 1) & mask;
+
+  m_block_lookup_table[i] = {block.effectiveAddress, block.msrBits, &block};
+  ++m_block_lookup_count;
+}
+
+void JitBaseBlockCache::EraseFromLookupTable(const JitBlock& block)
+{
+  const size_t mask = m_block_lookup_table.size() - 1;
+  size_t i = LookupTableHomeIndex(block.effectiveAddress, block.msrBits);
+  while (m_block_lookup_table[i].block != &block)
+  {
+    if (!m_block_lookup_table[i].block)
+      return;
+    i = (i + 1) & mask;
+  }
+
+  // Move the following entries of the probe sequence back into the gap, unless that would put
+  // them before their home index. This way no tombstones are needed.
+  for (size_t j = (i + 1) & mask; m_block_lookup_table[j].block; j = (j + 1) & mask)
+  {
+    const BlockLookupEntry& entry = m_block_lookup_table[j];
+    const size_t home = LookupTableHomeIndex(entry.effective_address, entry.msr_bits);
+    if (((j - home) & mask) >= ((j - i) & mask))
+    {
+      m_block_lookup_table[i] = entry;
+      i = j;
+    }
+  }
+
+  m_block_lookup_table[i] = {};
+  --m_block_lookup_count;
+}
+
+void JitBaseBlockCache::ResizeLookupTable(size_t size)
+{
+  const std::vector<BlockLookupEntry> old_table =
+      std::exchange(m_block_lookup_table, std::vector<BlockLookupEntry>(size));
+  m_block_lookup_count = 0;
+  for (const BlockLookupEntry& entry : old_table)
+  {
+    if (entry.block)
+      InsertIntoLookupTable(*entry.block);
+  }
+}
+
+JitBlock::PageListNode** JitBaseBlockCache::GetPageListHead(u32 page, bool create)
+{
+  std::unique_ptr<PageListLeaf>& leaf = m_page_lists[page >> PAGE_LIST_LEAF_SHIFT];
+  if (!leaf)
+  {
+    if (!create)
+      return nullptr;
+    leaf = std::make_unique<PageListLeaf>();
+  }
+
+  return &(*leaf)[(page & ((1u << PAGE_LIST_LEAF_SHIFT) - 1)) / INVALIDATION_PAGE_SIZE];
+}
+
+void JitBaseBlockCache::LinkIntoPageList(JitBlock::PageListNode& node)
+{
+  JitBlock::PageListNode** head = GetPageListHead(node.page, true);
+  node.prev = nullptr;
+  node.next = *head;
+  if (node.next)
+    node.next->prev = &node;
+  *head = &node;
+}
+
+void JitBaseBlockCache::UnlinkFromPageList(JitBlock::PageListNode& node)
+{
+  if (node.prev)
+    node.prev->next = node.next;
+  else
+    *GetPageListHead(node.page, false) = node.next;
+
+  if (node.next)
+    node.next->prev = node.prev;
+}
@@ -79,8 +79,20 @@ struct JitBlock : public JitBlockData
   };
   std::vector<LinkData> linkData;
 
-  // This set stores all physical addresses of all occupied instructions.
-  std::set<u32> physical_addresses;
+  // The physical addresses of all occupied instructions, sorted.
+  std::vector<u32> physical_addresses;
+
+  // Intrusive list node for each invalidation page the instructions of this block occupy.
+  // The nodes are linked into the per-page lists of JitBaseBlockCache, so that invalidating
+  // a page doesn't need any lookups. The vector isn't resized while the nodes are linked.
+  struct PageListNode
+  {
+    JitBlock* block;
+    PageListNode* prev;
+    PageListNode* next;
+    u32 page;
+  };
+  std::vector<PageListNode> page_list_nodes;
 
   // Block profiling data, structure is inlined in Jit.cpp
   struct ProfileData
@@ -184,25 +196,52 @@ private:
   void LinkBlock(JitBlock& block);
   void UnlinkBlock(const JitBlock& block);
   void InvalidateICacheInternal(u32 physical_address, u32 address, u32 length, bool forced);
+  void EraseBlock(JitBlock& block);
 
   JitBlock* MoveBlockIntoFastCache(u32 em_address, u32 msr);
 
   // Fast but risky block lookup based on fast_block_map.
   size_t FastLookupIndexForAddress(u32 address, u32 msr);
 
+  // The block lookup table is an open-addressed hash table with linear probing, keyed by
+  // effective address and MSR bits. Blocks for the same key but different physical addresses
+  // are all stored, so the key is only where probing starts.
+  size_t LookupTableHomeIndex(u32 address, u32 msr) const;
+  void InsertIntoLookupTable(JitBlock& block);
+  void EraseFromLookupTable(const JitBlock& block);
+  void ResizeLookupTable(size_t size);
+
+  JitBlock::PageListNode** GetPageListHead(u32 page, bool create);
+  void LinkIntoPageList(JitBlock::PageListNode& node);
+  void UnlinkFromPageList(JitBlock::PageListNode& node);
+
   // links_to hold all exit points of all valid blocks in a reverse way.
   // It is used to query all blocks which links to an address.
   std::unordered_map<u32, std::unordered_set<JitBlock*>> links_to;  // destination_PC -> number
 
-  // Map indexed by the physical address of the entry point.
-  // This is used to query the block based on the current PC in a slow way.
+  // Owns all blocks, indexed by the physical address of the entry point.
   std::multimap<u32, JitBlock> block_map;  // start_addr -> block
 
-  // Range of overlapping code indexed by a masked physical address.
-  // This is used for invalidation of memory regions. The range is grouped
-  // in macro blocks of each 0x100 bytes.
-  static constexpr u32 BLOCK_RANGE_MAP_ELEMENTS = 0x100;
-  std::map<u32, std::unordered_set<JitBlock*>> block_range_map;
+  // This is used to query the block based on the current PC when fast_block_map misses.
+  struct BlockLookupEntry
+  {
+    u32 effective_address;
+    u32 msr_bits;
+    JitBlock* block;  // nullptr for empty entries
+  };
+  static constexpr size_t BLOCK_LOOKUP_TABLE_MIN_SIZE = 0x1000;
+  std::vector<BlockLookupEntry> m_block_lookup_table;
+  size_t m_block_lookup_count = 0;
+
+  // Lists of the blocks occupying each page of physical memory, used for invalidation of memory
+  // regions. The list heads are kept in a two-level table, so only the parts of the address
+  // space that have code in them get allocated.
+  static constexpr u32 INVALIDATION_PAGE_SIZE = 0x100;
+  static constexpr u32 PAGE_LIST_LEAF_SHIFT = 20;
+  static constexpr u32 PAGES_PER_LEAF = (1u << PAGE_LIST_LEAF_SHIFT) / INVALIDATION_PAGE_SIZE;
+  using PageListLeaf = std::array<JitBlock::PageListNode*, PAGES_PER_LEAF>;
+  std::array<std::unique_ptr<PageListLeaf>, (1ull << 32) / (1u << PAGE_LIST_LEAF_SHIFT)>
+      m_page_lists;
 
   // This bitsets shows which cachelines overlap with any blocks.
   // It is used to provide a fast way to query if no icache invalidation is needed.
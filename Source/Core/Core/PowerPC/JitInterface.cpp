@@ -128,6 +128,13 @@ void JitInterface::WriteProfileResults(const std::string& filename) const
     PanicAlertFmt("Failed to open {}", filename);
     return;
   }
+
+  if (filename.ends_with(".json"))
+  {
+    f.WriteString(Profiler::GetSpeedscopeJSON(prof_stats, g_symbolDB));
+    return;
+  }
+
   f.WriteString("origAddr\tblkName\trunCount\tcost\ttimeCost\tpercent\ttimePercent\tOvAllinBlkTime("
                 "ms)\tblkCodeSize\n");
   for (auto& stat : prof_stats.block_stats)
@@ -301,6 +308,9 @@ void JitInterface::CompileExceptionCheck(ExceptionType type)
   case ExceptionType::SpeculativeConstants:
     exception_addresses = &m_jit->js.noSpeculativeConstantsAddresses;
     break;
+  case ExceptionType::HotBlock:
+    exception_addresses = &m_jit->js.hotBlockAddresses;
+    break;
   }
 
   auto& ppc_state = m_system.GetPPCState();
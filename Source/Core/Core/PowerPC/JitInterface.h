@@ -63,6 +63,7 @@ public:
 
   void UpdateMembase();
   void SetProfilingState(ProfilingState state);
+  // Writes a speedscope profile if filename ends with .json, and a table of the blocks otherwise
   void WriteProfileResults(const std::string& filename) const;
   void GetProfileResults(Profiler::ProfileStats* prof_stats) const;
   std::variant<GetHostCodeError, GetHostCodeResult> GetHostCode(u32 address) const;
@@ -90,7 +91,8 @@ public:
   {
     FIFOWrite,
     PairedQuantize,
-    SpeculativeConstants
+    SpeculativeConstants,
+    HotBlock
   };
   void CompileExceptionCheck(ExceptionType type);
   static void CompileExceptionCheckFromJIT(JitInterface& jit_interface, ExceptionType type);
@@ -908,9 +908,8 @@ std::optional<ReadResult<std::string>> MMU::HostTryReadString(const Core::CPUThr
 
 bool MMU::IsOptimizableRAMAddress(const u32 address) const
 {
-  if (m_power_pc.GetMemChecks().HasAny())
-    return false;
-
+  // BAT pages that overlap memchecks don't have BAT_PHYSICAL_BIT set, so memchecks don't need to
+  // be checked for here
   if (!m_ppc_state.msr.DR)
     return false;
 
@@ -975,6 +974,76 @@ bool MMU::HostIsRAMAddress(const Core::CPUThreadGuard& guard, u32 address,
   return false;
 }
 
+bool MMU::HostTryCopyFromPage(const Core::CPUThreadGuard& guard, u32 address, void* dest, u32 size,
+                              RequestedAddressSpace space)
+{
+  ASSERT(size != 0 && (address & ~HW_PAGE_MASK) == ((address + size - 1) & ~HW_PAGE_MASK));
+
+  auto& mmu = guard.GetSystem().GetMMU();
+  bool translate = false;
+  switch (space)
+  {
+  case RequestedAddressSpace::Effective:
+    translate = mmu.m_ppc_state.msr.DR;
+    break;
+  case RequestedAddressSpace::Physical:
+    break;
+  case RequestedAddressSpace::Virtual:
+    if (!mmu.m_ppc_state.msr.DR)
+      return false;
+    translate = true;
+    break;
+  }
+
+  bool wi = false;
+  if (translate)
+  {
+    const auto translated_addr = mmu.TranslateAddress<XCheckTLBFlag::NoException>(address);
+    if (!translated_addr.Success())
+      return false;
+    address = translated_addr.address;
+    wi = translated_addr.wi;
+  }
+
+  // The same cases as in ReadFromHardware, but for a whole range at once
+  auto& memory = mmu.m_memory;
+  const u32 segment = address >> 28;
+  if (memory.GetRAM() && segment == 0x0 && (address & 0x0FFFFFFF) < memory.GetRamSizeReal())
+  {
+    address &= memory.GetRamMask();
+    if (!mmu.m_ppc_state.m_enable_dcache || wi)
+      std::memcpy(dest, &memory.GetRAM()[address], size);
+    else
+      mmu.m_ppc_state.dCache.Read(address, dest, size, true);
+    return true;
+  }
+
+  if (memory.GetEXRAM() && segment == 0x1 && (address & 0x0FFFFFFF) < memory.GetExRamSizeReal())
+  {
+    address &= 0x0FFFFFFF;
+    if (!mmu.m_ppc_state.m_enable_dcache || wi)
+      std::memcpy(dest, &memory.GetEXRAM()[address], size);
+    else
+      mmu.m_ppc_state.dCache.Read(address + 0x10000000, dest, size, true);
+    return true;
+  }
+
+  if (memory.GetFakeVMEM() && ((address & 0xFE000000) == 0x7E000000))
+  {
+    std::memcpy(dest, &memory.GetFakeVMEM()[address & memory.GetFakeVMemMask()], size);
+    return true;
+  }
+
+  if (memory.GetL1Cache() && segment == 0xE &&
+      (address < (0xE0000000 + memory.GetL1CacheSize())))
+  {
+    std::memcpy(dest, &memory.GetL1Cache()[address & 0x0FFFFFFF], size);
+    return true;
+  }
+
+  return false;
+}
+
 bool MMU::HostIsInstructionRAMAddress(const Core::CPUThreadGuard& guard, u32 address,
                                       RequestedAddressSpace space)
 {
@@ -1314,6 +1383,10 @@ void MMU::SDRUpdated()
 
   m_ppc_state.pagetable_base = htaborg << 16;
   m_ppc_state.pagetable_hashmask = ((htabmask << 10) | 0x3ff);
+
+#ifndef _ARCH_32
+  m_memory.UnmapAllPageTableEntries();
+#endif
 }
 
 enum class TLBLookupResult
@@ -1400,6 +1473,10 @@ void MMU::InvalidateTLBEntry(u32 address)
 
   m_ppc_state.tlb[0][entry_index].Invalidate();
   m_ppc_state.tlb[1][entry_index].Invalidate();
+
+#ifndef _ARCH_32
+  m_memory.UnmapPageTableEntries(entry_index);
+#endif
 }
 
 // Page Address Translation
@@ -1431,16 +1508,56 @@ MMU::TranslateAddressResult MMU::TranslatePageAddress(const EffectiveAddress add
     return TranslateAddressResult{TranslateAddressResultEnum::PAGE_FAULT, 0};
   }
 
-  const u32 offset = address.offset;          // 12 bit
+  const std::optional<u32> pte_address = LookupPageTable<flag>(address, sr.VSID);
+  if (!pte_address)
+    return TranslateAddressResult{TranslateAddressResultEnum::PAGE_FAULT, 0};
+
+  UPTE_Hi pte2(ReadFromHardware<flag, u32, true>(*pte_address + 4));
+
+  // set the access bits
+  switch (flag)
+  {
+  case XCheckTLBFlag::NoException:
+  case XCheckTLBFlag::OpcodeNoException:
+    break;
+  case XCheckTLBFlag::Read:
+    pte2.R = 1;
+    break;
+  case XCheckTLBFlag::Write:
+    pte2.R = 1;
+    pte2.C = 1;
+    break;
+  case XCheckTLBFlag::Opcode:
+    pte2.R = 1;
+    break;
+  }
+
+  if (!IsNoExceptionFlag(flag))
+  {
+    m_memory.Write_U32(pte2.Hex, *pte_address + 4);
+  }
+
+  // We already updated the TLB entry if this was caused by a C bit.
+  if (res != TLBLookupResult::UpdateC)
+    UpdateTLBEntry(m_ppc_state, flag, pte2, address.Hex);
+
+  *wi = (pte2.WIMG & 0b1100) != 0;
+
+  return TranslateAddressResult{TranslateAddressResultEnum::PAGE_TABLE_TRANSLATED,
+                                (pte2.RPN << 12) | address.offset};
+}
+
+template <const XCheckTLBFlag flag>
+std::optional<u32> MMU::LookupPageTable(const EffectiveAddress address, u32 vsid)
+{
   const u32 page_index = address.page_index;  // 16 bit
-  const u32 VSID = sr.VSID;                   // 24 bit
   const u32 api = address.API;                //  6 bit (part of page_index)
 
   // hash function no 1 "xor" .360
-  u32 hash = (VSID ^ page_index);
+  u32 hash = (vsid ^ page_index);
 
   UPTE_Lo pte1;
-  pte1.VSID = VSID;
+  pte1.VSID = vsid;
   pte1.API = api;
   pte1.V = 1;
 
@@ -1460,44 +1577,60 @@ MMU::TranslateAddressResult MMU::TranslatePageAddress(const EffectiveAddress add
       const u32 pteg = ReadFromHardware<flag, u32, true>(pteg_addr);
 
       if (pte1.Hex == pteg)
-      {
-        UPTE_Hi pte2(ReadFromHardware<flag, u32, true>(pteg_addr + 4));
+        return pteg_addr;
+    }
+  }
+  return std::nullopt;
+}
 
-        // set the access bits
-        switch (flag)
-        {
-        case XCheckTLBFlag::NoException:
-        case XCheckTLBFlag::OpcodeNoException:
-          break;
-        case XCheckTLBFlag::Read:
-          pte2.R = 1;
-          break;
-        case XCheckTLBFlag::Write:
-          pte2.R = 1;
-          pte2.C = 1;
-          break;
-        case XCheckTLBFlag::Opcode:
-          pte2.R = 1;
-          break;
-        }
+bool MMU::MapPageTableAddressForFastmem(u32 address)
+{
+#ifdef _ARCH_32
+  return false;
+#else
+  const u32 page_address = address & ~HW_PAGE_MASK;
+  if (m_power_pc.GetMemChecks().OverlapsMemcheck(page_address, HW_PAGE_SIZE))
+    return false;
 
-        if (!IsNoExceptionFlag(flag))
-        {
-          m_memory.Write_U32(pte2.Hex, pteg_addr + 4);
-        }
+  // BATs take priority over the page table
+  const u32 bat_result = m_dbat_table[address >> BAT_INDEX_SHIFT];
+  if (bat_result & BAT_MAPPED_BIT)
+  {
+    // A memcheck elsewhere in the BAT page keeps all of it out of fastmem when the BATs are
+    // updated. Map the pages without memchecks as they get accessed, so that only the pages with
+    // memchecks take the slow path.
+    if ((bat_result & BAT_MEMCHECK_BIT) == 0)
+      return false;
+    const u32 translated_address =
+        (bat_result & BAT_RESULT_MASK) | (page_address & (BAT_PAGE_SIZE - 1));
+    return m_memory.MapPageTableEntry(page_address, translated_address);
+  }
 
-        // We already updated the TLB entry if this was caused by a C bit.
-        if (res != TLBLookupResult::UpdateC)
-          UpdateTLBEntry(m_ppc_state, flag, pte2, address.Hex);
+  const EffectiveAddress effective_address{address};
+  const auto sr = UReg_SR{m_ppc_state.sr[effective_address.SR]};
+  if (sr.T != 0)
+    return false;
 
-        *wi = (pte2.WIMG & 0b1100) != 0;
+  const std::optional<u32> pte_address =
+      LookupPageTable<XCheckTLBFlag::NoException>(effective_address, sr.VSID);
+  if (!pte_address)
+    return false;
 
-        return TranslateAddressResult{TranslateAddressResultEnum::PAGE_TABLE_TRANSLATED,
-                                      (pte2.RPN << 12) | offset};
-      }
-    }
+  UPTE_Hi pte2(m_memory.Read_U32(*pte_address + 4));
+  if (!m_memory.MapPageTableEntry(page_address, pte2.RPN << HW_PAGE_INDEX_SHIFT))
+    return false;
+
+  // Accesses through fastmem can't set the referenced and changed bits, so set both now as if
+  // the page had been written to. At worst, this makes the game write back a page it didn't change.
+  if (pte2.R == 0 || pte2.C == 0)
+  {
+    pte2.R = 1;
+    pte2.C = 1;
+    m_memory.Write_U32(pte2.Hex, *pte_address + 4);
   }
-  return TranslateAddressResult{TranslateAddressResultEnum::PAGE_FAULT, 0};
+
+  return true;
+#endif
 }
 
 void MMU::UpdateBATs(BatTable& bat_table, u32 base_spr)
@@ -1551,6 +1684,7 @@ void MMU::UpdateBATs(BatTable& bat_table, u32 base_spr)
         // BAT_MAPPED_BIT is whether the translation is valid
         // BAT_PHYSICAL_BIT is whether we can use the fastmem arena
         // BAT_WI_BIT is whether either W or I (of WIMG) is set
+        // BAT_MEMCHECK_BIT is whether we could use the fastmem arena if it wasn't for memchecks
         u32 valid_bit = BAT_MAPPED_BIT;
 
         const bool wi = (batl.WIMG & 0b1100) != 0;
@@ -1582,8 +1716,11 @@ void MMU::UpdateBATs(BatTable& bat_table, u32 base_spr)
         }
 
         // Fastmem doesn't support memchecks, so disable it for all overlapping virtual pages.
-        if (m_power_pc.GetMemChecks().OverlapsMemcheck(virtual_address, BAT_PAGE_SIZE))
-          valid_bit &= ~BAT_PHYSICAL_BIT;
+        if ((valid_bit & BAT_PHYSICAL_BIT) != 0 &&
+            m_power_pc.GetMemChecks().OverlapsMemcheck(virtual_address, BAT_PAGE_SIZE))
+        {
+          valid_bit = (valid_bit & ~BAT_PHYSICAL_BIT) | BAT_MEMCHECK_BIT;
+        }
 
         // (BEPI | j) == (BEPI & ~BL) | (j & BL).
         bat_table[virtual_address >> BAT_INDEX_SHIFT] = physical_address | valid_bit;
@@ -1603,7 +1740,7 @@ void MMU::UpdateFakeMMUBat(BatTable& bat_table, u32 start_addr)
     u32 flags = BAT_MAPPED_BIT | BAT_PHYSICAL_BIT;
 
     if (m_power_pc.GetMemChecks().OverlapsMemcheck(e_address << BAT_INDEX_SHIFT, BAT_PAGE_SIZE))
-      flags &= ~BAT_PHYSICAL_BIT;
+      flags = (flags & ~BAT_PHYSICAL_BIT) | BAT_MEMCHECK_BIT;
 
     bat_table[e_address] = p_address | flags;
   }
@@ -64,7 +64,8 @@ constexpr u32 BAT_PAGE_COUNT = 1 << (32 - BAT_INDEX_SHIFT);
 constexpr u32 BAT_MAPPED_BIT = 0x1;
 constexpr u32 BAT_PHYSICAL_BIT = 0x2;
 constexpr u32 BAT_WI_BIT = 0x4;
-constexpr u32 BAT_RESULT_MASK = UINT32_C(~0x7);
+constexpr u32 BAT_MEMCHECK_BIT = 0x8;
+constexpr u32 BAT_RESULT_MASK = UINT32_C(~0xf);
 using BatTable = std::array<u32, BAT_PAGE_COUNT>;  // 128 KB
 
 constexpr size_t HW_PAGE_SIZE = 4096;
@@ -202,6 +203,12 @@ public:
   static bool HostIsRAMAddress(const Core::CPUThreadGuard& guard, u32 address,
                                RequestedAddressSpace space = RequestedAddressSpace::Effective);
 
+  // Copies size bytes of RAM starting at the given address, which must not cross a page boundary,
+  // to dest. Returns false without copying anything if HostIsRAMAddress would return false.
+  static bool HostTryCopyFromPage(const Core::CPUThreadGuard& guard, u32 address, void* dest,
+                                  u32 size,
+                                  RequestedAddressSpace space = RequestedAddressSpace::Effective);
+
   // Same as HostIsRAMAddress, but uses IBAT instead of DBAT.
   static bool
   HostIsInstructionRAMAddress(const Core::CPUThreadGuard& guard, u32 address,
@@ -242,6 +249,12 @@ public:
   void DBATUpdated();
   void IBATUpdated();
 
+  // Called when a fastmem access with MSR.DR set faults. If the address is translated through the
+  // page table to RAM, maps the page into the logical fastmem view so that the access can be
+  // retried. The mapping is removed again when the TLB entry of the page is invalidated. The same
+  // is done for pages of BAT pages that are only kept out of fastmem by memchecks on other pages.
+  bool MapPageTableAddressForFastmem(u32 address);
+
   // Result changes based on the BAT registers and MSR.DR.  Returns whether
   // it's safe to optimize a read or write to this address to an unguarded
   // memory access.  Does not consider page tables.
@@ -296,6 +309,9 @@ private:
 
   template <const XCheckTLBFlag flag>
   TranslateAddressResult TranslatePageAddress(const EffectiveAddress address, bool* wi);
+  // Returns the address of the page table entry for the given address in the given segment, if any
+  template <const XCheckTLBFlag flag>
+  std::optional<u32> LookupPageTable(const EffectiveAddress address, u32 vsid);
 
   void GenerateDSIException(u32 effective_address, bool write);
   void GenerateISIException(u32 effective_address);
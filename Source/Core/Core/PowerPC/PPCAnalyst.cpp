@@ -4,9 +4,11 @@
 #include "Core/PowerPC/PPCAnalyst.h"
 
 #include <algorithm>
+#include <future>
 #include <map>
 #include <queue>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include <fmt/format.h>
@@ -40,9 +42,6 @@
 
 namespace PPCAnalyst
 {
-// 0 does not perform block merging
-constexpr u32 BRANCH_FOLLOWING_THRESHOLD = 2;
-
 constexpr u32 INVALID_BRANCH_TARGET = 0xFFFFFFFF;
 
 static u32 EvaluateBranchTarget(UGeckoInstruction instr, u32 pc)
@@ -186,11 +185,12 @@ bool ReanalyzeFunction(const Core::CPUThreadGuard& guard, u32 start_addr, Common
 
 // Second pass analysis, done after the first pass is done for all functions
 // so we have more information to work with
-static void AnalyzeFunction2(Common::Symbol* func)
+// Only reads the symbols, so that it can run on several threads at once
+static u32 AnalyzeFunction2(const Common::Symbol& func)
 {
-  u32 flags = func->flags;
+  u32 flags = func.flags;
 
-  bool nonleafcall = std::any_of(func->calls.begin(), func->calls.end(), [](const auto& call) {
+  bool nonleafcall = std::any_of(func.calls.begin(), func.calls.end(), [](const auto& call) {
     const Common::Symbol* called_func = g_symbolDB.GetSymbolFromAddr(call.function);
     return called_func && (called_func->flags & Common::FFLAG_LEAF) == 0;
   });
@@ -198,7 +198,44 @@ static void AnalyzeFunction2(Common::Symbol* func)
   if (nonleafcall && !(flags & Common::FFLAG_EVIL) && !(flags & Common::FFLAG_RFI))
     flags |= Common::FFLAG_ONLYCALLSNICELEAFS;
 
-  func->flags = flags;
+  return flags;
+}
+
+// Returns the result of AnalyzeFunction2 for every symbol, in the order of the symbol map
+static std::vector<u32> AnalyzeFunctions2(const PPCSymbolDB& func_db)
+{
+  constexpr size_t MIN_FUNCTIONS_PER_THREAD = 1024;
+
+  std::vector<const Common::Symbol*> functions;
+  functions.reserve(func_db.Symbols().size());
+  for (const auto& func : func_db.Symbols())
+    functions.push_back(&func.second);
+
+  std::vector<u32> flags(functions.size());
+  const auto analyze = [&functions, &flags](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i)
+      flags[i] = AnalyzeFunction2(*functions[i]);
+  };
+
+  const size_t thread_count =
+      std::clamp<size_t>(functions.size() / MIN_FUNCTIONS_PER_THREAD, 1,
+                         std::max<size_t>(std::thread::hardware_concurrency(), 1));
+  if (thread_count == 1)
+  {
+    analyze(0, functions.size());
+    return flags;
+  }
+
+  const size_t functions_per_thread = (functions.size() + thread_count - 1) / thread_count;
+  std::vector<std::future<void>> futures;
+  for (size_t begin = 0; begin < functions.size(); begin += functions_per_thread)
+  {
+    futures.push_back(std::async(std::launch::async, analyze, begin,
+                                 std::min(begin + functions_per_thread, functions.size())));
+  }
+  for (auto& future : futures)
+    future.get();
+  return flags;
 }
 
 bool PPCAnalyzer::CanSwapAdjacentOps(const CodeOp& a, const CodeOp& b) const
@@ -385,18 +422,24 @@ void FindFunctions(const Core::CPUThreadGuard& guard, u32 startAddr, u32 endAddr
   func_db->FillInCallers();
   func_db->Index();
 
+  // Step 3: Finding the functions reads guest memory, so it stays on this thread, but analyzing
+  // them again only needs the symbols
+  const std::vector<u32> flags = AnalyzeFunctions2(*func_db);
+
   int numLeafs = 0, numNice = 0, numUnNice = 0;
   int numTimer = 0, numRFI = 0, numStraightLeaf = 0;
   int leafSize = 0, niceSize = 0, unniceSize = 0;
+  size_t flags_index = 0;
   for (auto& func : func_db->AccessSymbols())
   {
+    const u32 func_flags = flags[flags_index++];
     if (func.second.address == 4)
     {
       WARN_LOG_FMT(SYMBOLS, "Weird function");
       continue;
     }
-    AnalyzeFunction2(&(func.second));
     Common::Symbol& f = func.second;
+    f.flags = func_flags;
     if (f.name.substr(0, 3) == "zzz")
     {
       if (f.flags & Common::FFLAG_LEAF)
@@ -448,6 +491,8 @@ void FindFunctions(const Core::CPUThreadGuard& guard, u32 startAddr, u32 endAddr
                numLeafs, numNice, numUnNice, numTimer, numRFI, numStraightLeaf);
   INFO_LOG_FMT(SYMBOLS, "Average size: {} (leaf), {} (nice), {}(unnice)", leafSize, niceSize,
                unniceSize);
+
+  func_db->Index();
 }
 
 static bool isCmp(const CodeOp& a)
@@ -704,28 +749,60 @@ void PPCAnalyzer::SetInstructionStats(CodeBlock* block, CodeOp* code,
   }
 }
 
+// Instructions that don't change any state a busy wait loop could depend on
+static bool IsBusyWaitLoopNoOp(UGeckoInstruction inst)
+{
+  if (inst.OPCD == 19 && inst.SUBOP10 == 150)  // isync
+    return true;
+  return inst.OPCD == 31 && (inst.SUBOP10 == 598 || inst.SUBOP10 == 854);  // sync, eieio
+}
+
 bool PPCAnalyzer::IsBusyWaitLoop(CodeBlock* block, CodeOp* code, size_t instructions) const
 {
   // Very basic algorithm to detect busy wait loops:
-  //   * It loops to itself and does not contain any other branches.
-  //   * It does not write to memory.
+  //   * It loops to itself and does not use CTR.
+  //   * It does not write to memory. Reading memory, which includes polling MMIO registers, is
+  //     fine.
   //   * It only reads from registers it wrote to earlier in the loop, or it
-  //     does not write to these registers.
+  //     does not write to these registers. This applies to GPRs, CR fields and CA.
   //
-  // Would benefit a lot from basic inlining support - a lot of the most
-  // used busy loops are DSP register interactions, which are bl/cmp/bne
-  // (with the bl target a pure function that follows the above rules). We
-  // don't detect these at the moment.
+  // Calls to pure functions, such as the DSP register reads most busy loops use, are only
+  // detected when branch following inlined them into the block.
   std::bitset<32> write_disallowed_regs;
   std::bitset<32> written_regs;
+  BitSet8 write_disallowed_cr;
+  BitSet8 written_cr;
+  bool write_disallowed_ca = false;
+  bool written_ca = false;
   for (size_t i = 0; i <= instructions; ++i)
   {
+    const UGeckoInstruction inst = code[i].inst;
+    BitSet8 cr_in;
+    BitSet8 cr_out;
+
     if (code[i].opinfo->type == OpType::Branch)
     {
       if (code[i].branchUsesCtr)
         return false;
-      if (code[i].branchTo == block->m_address && i == instructions)
-        return true;
+      if (inst.OPCD != 18 && (inst.BO & BO_DONT_CHECK_CONDITION) == 0)
+        cr_in[inst.BI >> 2] = true;
+    }
+    else if (code[i].opinfo->type == OpType::CR)
+    {
+      // Logical operations on CR bits, which keep the other bits of the output field
+      cr_in[inst.CRBA >> 2] = true;
+      cr_in[inst.CRBB >> 2] = true;
+      cr_in[inst.CRBD >> 2] = true;
+      cr_out[inst.CRBD >> 2] = true;
+    }
+    else if (inst.OPCD == 19 && inst.SUBOP10 == 0)  // mcrf
+    {
+      cr_in = code[i].wantsCR;
+      cr_out = code[i].outputCR;
+    }
+    else if (IsBusyWaitLoopNoOp(inst))
+    {
+      continue;
     }
     else if (code[i].opinfo->type != OpType::Integer && code[i].opinfo->type != OpType::Load)
     {
@@ -736,6 +813,9 @@ bool PPCAnalyzer::IsBusyWaitLoop(CodeBlock* block, CodeOp* code, size_t instruct
     }
     else
     {
+      cr_in = code[i].wantsCR;
+      cr_out = code[i].outputCR;
+
       for (int reg : code[i].regsIn)
       {
         if (reg == -1)
@@ -752,6 +832,26 @@ bool PPCAnalyzer::IsBusyWaitLoop(CodeBlock* block, CodeOp* code, size_t instruct
           return false;
         written_regs[reg] = true;
       }
+
+      if (code[i].wantsCA && !written_ca)
+        write_disallowed_ca = true;
+      if (code[i].outputCA)
+      {
+        if (write_disallowed_ca)
+          return false;
+        written_ca = true;
+      }
+    }
+
+    write_disallowed_cr |= cr_in & ~written_cr;
+    if (cr_out & write_disallowed_cr)
+      return false;
+    written_cr |= cr_out;
+
+    if (code[i].opinfo->type == OpType::Branch && code[i].branchTo == block->m_address &&
+        i == instructions)
+    {
+      return true;
     }
   }
   return false;
@@ -767,6 +867,24 @@ static bool CanCauseGatherPipeInterruptCheck(const CodeOp& op)
          op.opinfo->type == OpType::StorePS;
 }
 
+// Whether op is a branch to the start of the block that leaves the block, without linking and
+// without being an idle loop
+static bool IsLoopBackEdge(const CodeOp& op, u32 block_address, bool is_last_instruction)
+{
+  if (op.skip || op.branchTo != block_address || op.inst.LK || op.branchIsIdleLoop)
+    return false;
+
+  // Unconditional branches in the middle of a block were followed
+  if (op.inst.OPCD == 18)  // bx
+    return is_last_instruction;
+  if (op.inst.OPCD == 16)  // bcx
+  {
+    return is_last_instruction || (op.inst.BO & BO_DONT_DECREMENT_FLAG) == 0 ||
+           (op.inst.BO & BO_DONT_CHECK_CONDITION) == 0;
+  }
+  return false;
+}
+
 u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer,
                          std::size_t block_size) const
 {
@@ -785,6 +903,7 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer,
   block->m_memory_exception = false;
   block->m_num_instructions = 0;
   block->m_gqr_used = BitSet8(0);
+  block->m_loop_back_edge.reset();
   block->m_physical_addresses.clear();
 
   CodeOp* const code = buffer->data();
@@ -857,7 +976,7 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer,
       {
         code[i].branchTo = code[caller].address + 4;
         if ((inst.BO & BO_DONT_DECREMENT_FLAG) && (inst.BO & BO_DONT_CHECK_CONDITION) &&
-            numFollows < BRANCH_FOLLOWING_THRESHOLD)
+            numFollows < m_branch_following_threshold)
         {
           // bclrx with unconditional branch = return
           // Follow it if we can propagate the LR value of the last CALL instruction.
@@ -917,7 +1036,7 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer,
     code[i].branchIsIdleLoop =
         code[i].branchTo == block->m_address && IsBusyWaitLoop(block, code, i);
 
-    if (follow && numFollows < BRANCH_FOLLOWING_THRESHOLD)
+    if (follow && numFollows < m_branch_following_threshold)
     {
       // Follow the unconditional branch.
       numFollows++;
@@ -1015,6 +1134,9 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer,
     gprBlockInputs |= op.regsIn & ~gprDefined;
     gprDefined |= op.regsOut;
 
+    if (IsLoopBackEdge(op, block->m_address, i == block->m_num_instructions - 1))
+      block->m_loop_back_edge = i;
+
     op.fprIsSingle = fprIsSingle;
     op.fprIsDuplicated = fprIsDuplicated;
     op.fprIsStoreSafeBeforeInst = fprIsStoreSafe;
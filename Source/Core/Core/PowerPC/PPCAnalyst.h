@@ -5,6 +5,7 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <optional>
 #include <set>
 #include <vector>
 
@@ -26,6 +27,12 @@ class CPUThreadGuard;
 
 namespace PPCAnalyst
 {
+// The number of unconditional branches followed into one block. 0 does not perform block merging.
+constexpr u32 BRANCH_FOLLOWING_THRESHOLD = 2;
+// Used when recompiling blocks that run often. Following more branches inlines more of the
+// functions they call, at the cost of duplicating more code.
+constexpr u32 HOT_BLOCK_BRANCH_FOLLOWING_THRESHOLD = 8;
+
 struct CodeOp  // 16B
 {
   UGeckoInstruction inst;
@@ -125,6 +132,10 @@ struct CodeBlock
   // Which GPRs this block reads from before defining, if any.
   BitSet32 m_gpr_inputs;
 
+  // Index of the last instruction that branches back to the start of the block, if any. The
+  // instructions up to it form a loop.
+  std::optional<u32> m_loop_back_edge;
+
   // Which memory locations are occupied by this block.
   std::set<u32> m_physical_addresses;
 };
@@ -176,6 +187,7 @@ public:
   bool HasOption(AnalystOption option) const { return !!(m_options & option); }
   void SetDebuggingEnabled(bool enabled) { m_is_debugging_enabled = enabled; }
   void SetBranchFollowingEnabled(bool enabled) { m_enable_branch_following = enabled; }
+  void SetBranchFollowingThreshold(u32 threshold) { m_branch_following_threshold = threshold; }
   void SetFloatExceptionsEnabled(bool enabled) { m_enable_float_exceptions = enabled; }
   void SetDivByZeroExceptionsEnabled(bool enabled) { m_enable_div_by_zero_exceptions = enabled; }
   u32 Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, std::size_t block_size) const;
@@ -200,6 +212,7 @@ private:
 
   bool m_is_debugging_enabled = false;
   bool m_enable_branch_following = false;
+  u32 m_branch_following_threshold = BRANCH_FOLLOWING_THRESHOLD;
   bool m_enable_float_exceptions = false;
   bool m_enable_div_by_zero_exceptions = false;
 };
@@ -49,12 +49,15 @@ Common::Symbol* PPCSymbolDB::AddFunction(const Core::CPUThreadGuard& guard, u32
   Common::Symbol* ptr = &insert.first->second;
   ptr->type = Common::Symbol::Type::Function;
   m_checksum_to_function[ptr->hash].insert(ptr);
+  InvalidateAddressIndex();
   return ptr;
 }
 
 void PPCSymbolDB::AddKnownSymbol(const Core::CPUThreadGuard& guard, u32 startAddr, u32 size,
                                  const std::string& name, Common::Symbol::Type type)
 {
+  InvalidateAddressIndex();
+
   auto iter = m_functions.find(startAddr);
   if (iter != m_functions.end())
   {
@@ -93,6 +96,21 @@ void PPCSymbolDB::AddKnownSymbol(const Core::CPUThreadGuard& guard, u32 startAdd
 
 Common::Symbol* PPCSymbolDB::GetSymbolFromAddr(u32 addr)
 {
+  if (m_address_index_valid)
+  {
+    // The last range that starts at or before the address
+    auto range = std::upper_bound(
+        m_address_index.begin(), m_address_index.end(), addr,
+        [](u32 address, const IndexedRange& indexed) { return address < indexed.address; });
+    if (range == m_address_index.begin())
+      return nullptr;
+    --range;
+
+    if (range->address == addr || addr < range->address + range->size)
+      return range->symbol;
+    return nullptr;
+  }
+
   auto it = m_functions.lower_bound(addr);
 
   if (it != m_functions.end())
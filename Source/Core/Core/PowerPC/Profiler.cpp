@@ -0,0 +1,125 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/PowerPC/Profiler.h"
+
+#include <algorithm>
+#include <map>
+#include <utility>
+
+#include <fmt/format.h>
+#include <picojson.h>
+
+#include "Common/SymbolDB.h"
+#include "Core/PowerPC/PPCSymbolDB.h"
+
+namespace Profiler
+{
+std::vector<FunctionStat> GetFunctionStats(const ProfileStats& stats, PPCSymbolDB& symbol_db)
+{
+  std::map<u32, FunctionStat> functions;
+  for (const BlockStat& block : stats.block_stats)
+  {
+    const Common::Symbol* symbol = symbol_db.GetSymbolFromAddr(block.addr);
+    if (!symbol)
+      continue;
+
+    auto [it, inserted] = functions.try_emplace(symbol->address);
+    FunctionStat& function = it->second;
+    if (inserted)
+    {
+      function.addr = symbol->address;
+      function.name = symbol->name;
+    }
+    function.cost += block.cost;
+    function.tick_counter += block.tick_counter;
+    function.run_count += block.run_count;
+    ++function.block_count;
+  }
+
+  std::vector<FunctionStat> result;
+  result.reserve(functions.size());
+  for (auto& [address, function] : functions)
+    result.push_back(std::move(function));
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+std::string GetSpeedscopeJSON(const ProfileStats& stats, PPCSymbolDB& symbol_db)
+{
+  picojson::array frames;
+  std::map<u32, size_t> function_frames;
+  const auto add_frame = [&frames](std::string name, u32 address) {
+    picojson::object frame;
+    frame["name"] = picojson::value(std::move(name));
+    frame["file"] = picojson::value(fmt::format("{:08x}", address));
+    frames.emplace_back(std::move(frame));
+    return frames.size() - 1;
+  };
+
+  // A sample is a stack of the function and the block, so that the blocks of a function show up
+  // as its children
+  picojson::array samples;
+  picojson::array cycle_weights;
+  picojson::array time_weights;
+  double total_cycles = 0;
+  double total_time = 0;
+  const double ns_per_tick =
+      stats.countsPerSec != 0 ? 1e9 / static_cast<double>(stats.countsPerSec) : 0;
+
+  for (const BlockStat& block : stats.block_stats)
+  {
+    picojson::array stack;
+    if (const Common::Symbol* symbol = symbol_db.GetSymbolFromAddr(block.addr))
+    {
+      auto it = function_frames.find(symbol->address);
+      if (it == function_frames.end())
+      {
+        const size_t function_frame = add_frame(symbol->name, symbol->address);
+        it = function_frames.emplace(symbol->address, function_frame).first;
+      }
+      stack.emplace_back(static_cast<double>(it->second));
+    }
+    const size_t block_frame = add_frame(fmt::format("block {:08x}", block.addr), block.addr);
+    stack.emplace_back(static_cast<double>(block_frame));
+    samples.emplace_back(std::move(stack));
+
+    const double cycles = static_cast<double>(block.cost);
+    const double time = static_cast<double>(block.tick_counter) * ns_per_tick;
+    cycle_weights.emplace_back(cycles);
+    time_weights.emplace_back(time);
+    total_cycles += cycles;
+    total_time += time;
+  }
+
+  const auto make_profile = [&samples](std::string name, std::string unit, picojson::array weights,
+                                       double total) {
+    picojson::object profile;
+    profile["type"] = picojson::value("sampled");
+    profile["name"] = picojson::value(std::move(name));
+    profile["unit"] = picojson::value(std::move(unit));
+    profile["startValue"] = picojson::value(0.0);
+    profile["endValue"] = picojson::value(total);
+    profile["samples"] = picojson::value(samples);
+    profile["weights"] = picojson::value(std::move(weights));
+    return picojson::value(std::move(profile));
+  };
+
+  picojson::array profiles;
+  profiles.push_back(
+      make_profile("Emulated cycles", "none", std::move(cycle_weights), total_cycles));
+  profiles.push_back(make_profile("Host time", "nanoseconds", std::move(time_weights), total_time));
+
+  picojson::object shared;
+  shared["frames"] = picojson::value(std::move(frames));
+
+  picojson::object root;
+  root["$schema"] = picojson::value("https://www.speedscope.app/file-format-schema.json");
+  root["exporter"] = picojson::value("Dolphin");
+  root["name"] = picojson::value("JIT block profile");
+  root["activeProfileIndex"] = picojson::value(0.0);
+  root["shared"] = picojson::value(std::move(shared));
+  root["profiles"] = picojson::value(std::move(profiles));
+  return picojson::value(std::move(root)).serialize();
+}
+}  // namespace Profiler
@@ -9,6 +9,8 @@
 
 #include "Common/CommonTypes.h"
 
+class PPCSymbolDB;
+
 namespace Profiler
 {
 struct BlockStat
@@ -33,4 +35,25 @@ struct ProfileStats
   u64 countsPerSec = 0;
 };
 
+// The blocks that start in a function of the symbol database, added up
+struct FunctionStat
+{
+  u32 addr;
+  std::string name;
+  u64 cost = 0;
+  u64 tick_counter = 0;
+  u64 run_count = 0;
+  u32 block_count = 0;
+
+  bool operator<(const FunctionStat& other) const { return cost > other.cost; }
+};
+
+// Sorted by cost like the block stats. Blocks outside of all functions aren't included.
+std::vector<FunctionStat> GetFunctionStats(const ProfileStats& stats, PPCSymbolDB& symbol_db);
+
+// Writes the profile in the JSON format of speedscope (https://www.speedscope.app), which other
+// profilers can import as well. Every block is a sample in the function it starts in, weighted by
+// its emulated cycles in one profile and by its host time in another.
+std::string GetSpeedscopeJSON(const ProfileStats& stats, PPCSymbolDB& symbol_db);
+
 }  // namespace Profiler
@@ -3,13 +3,19 @@
 
 #include "Core/PowerPC/SignatureDB/MEGASignatureDB.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdlib>
 #include <fstream>
+#include <future>
 #include <limits>
+#include <span>
 #include <sstream>
 #include <string>
+#include <thread>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "Common/FileUtil.h"
 #include "Common/Logging/Log.h"
@@ -101,21 +107,85 @@ bool GetRefs(MEGASignature* sig, std::istringstream* iss)
   return true;
 }
 
-bool Compare(const Core::CPUThreadGuard& guard, u32 address, u32 size, const MEGASignature& sig)
+bool Compare(std::span<const u32> code, const MEGASignature& sig)
 {
-  if (size != sig.code.size() * sizeof(u32))
-    return false;
-
   for (size_t i = 0; i < sig.code.size(); ++i)
   {
-    if (sig.code[i] != 0 && PowerPC::MMU::HostRead_U32(
-                                guard, static_cast<u32>(address + i * sizeof(u32))) != sig.code[i])
-    {
+    if (sig.code[i] != 0 && code[i] != sig.code[i])
       return false;
-    }
   }
   return true;
 }
+
+// Signatures are bucketed by their instruction count and first instruction, which is 0 for those
+// that start with a wildcard. A function only has to be compared against two buckets.
+u64 GetBucketKey(size_t instruction_count, u32 first_instruction)
+{
+  return (u64{static_cast<u32>(instruction_count)} << 32) | first_instruction;
+}
+
+using Buckets = std::unordered_map<u64, std::vector<const MEGASignature*>>;
+
+// The code of a function that has signatures of the same size
+struct Candidate
+{
+  Common::Symbol* symbol;
+  std::vector<u32> code;
+  const std::vector<const MEGASignature*>* exact_bucket;
+  const std::vector<const MEGASignature*>* wildcard_bucket;
+};
+
+const MEGASignature* FindFirstMatch(const std::vector<const MEGASignature*>* bucket,
+                                    std::span<const u32> code)
+{
+  if (!bucket)
+    return nullptr;
+  const auto it = std::find_if(bucket->begin(), bucket->end(),
+                               [code](const MEGASignature* sig) { return Compare(code, *sig); });
+  return it != bucket->end() ? *it : nullptr;
+}
+
+// Returns the first signature in database order that matches the candidate
+const MEGASignature* FindMatch(const Candidate& candidate)
+{
+  const MEGASignature* exact = FindFirstMatch(candidate.exact_bucket, candidate.code);
+  const MEGASignature* wildcard = FindFirstMatch(candidate.wildcard_bucket, candidate.code);
+  if (!exact || !wildcard)
+    return exact ? exact : wildcard;
+  // The buckets point into the same vector
+  return std::min(exact, wildcard);
+}
+
+constexpr size_t MIN_CANDIDATES_PER_THREAD = 256;
+
+std::vector<const MEGASignature*> FindMatches(const std::vector<Candidate>& candidates)
+{
+  std::vector<const MEGASignature*> matches(candidates.size());
+  const auto find_matches = [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i)
+      matches[i] = FindMatch(candidates[i]);
+  };
+
+  const size_t thread_count =
+      std::clamp<size_t>(candidates.size() / MIN_CANDIDATES_PER_THREAD, 1,
+                         std::max<size_t>(std::thread::hardware_concurrency(), 1));
+  if (thread_count == 1)
+  {
+    find_matches(0, candidates.size());
+    return matches;
+  }
+
+  const size_t candidates_per_thread = (candidates.size() + thread_count - 1) / thread_count;
+  std::vector<std::future<void>> futures;
+  for (size_t begin = 0; begin < candidates.size(); begin += candidates_per_thread)
+  {
+    futures.push_back(std::async(std::launch::async, find_matches, begin,
+                                 std::min(begin + candidates_per_thread, candidates.size())));
+  }
+  for (auto& future : futures)
+    future.get();
+  return matches;
+}
 }  // Anonymous namespace
 
 MEGASignatureDB::MEGASignatureDB() = default;
@@ -160,20 +230,55 @@ bool MEGASignatureDB::Save(const std::string& file_path) const
 
 void MEGASignatureDB::Apply(const Core::CPUThreadGuard& guard, PPCSymbolDB* symbol_db) const
 {
+  Buckets buckets;
+  for (const MEGASignature& sig : m_signatures)
+  {
+    if (!sig.code.empty())
+      buckets[GetBucketKey(sig.code.size(), sig.code[0])].push_back(&sig);
+  }
+  const auto find_bucket = [&buckets](size_t instruction_count, u32 first_instruction) {
+    const auto it = buckets.find(GetBucketKey(instruction_count, first_instruction));
+    return it != buckets.end() ? &it->second : nullptr;
+  };
+
+  // Guest memory is only read on this thread. The comparisons run on other threads afterwards.
+  std::vector<Candidate> candidates;
   for (auto& it : symbol_db->AccessSymbols())
   {
-    auto& symbol = it.second;
-    for (const auto& sig : m_signatures)
+    Common::Symbol& symbol = it.second;
+    if (symbol.size == 0 || symbol.size % sizeof(u32) != 0)
+      continue;
+
+    const size_t instruction_count = symbol.size / sizeof(u32);
+    const u32 first_instruction = PowerPC::MMU::HostRead_U32(guard, symbol.address);
+    const auto* wildcard_bucket = find_bucket(instruction_count, 0);
+    const auto* exact_bucket =
+        first_instruction != 0 ? find_bucket(instruction_count, first_instruction) : nullptr;
+    if (!exact_bucket && !wildcard_bucket)
+      continue;
+
+    Candidate& candidate =
+        candidates.emplace_back(Candidate{&symbol, {}, exact_bucket, wildcard_bucket});
+    candidate.code.resize(instruction_count);
+    candidate.code[0] = first_instruction;
+    for (size_t i = 1; i < instruction_count; ++i)
     {
-      if (Compare(guard, symbol.address, symbol.size, sig))
-      {
-        symbol.name = sig.name;
-        INFO_LOG_FMT(SYMBOLS, "Found {} at {:08x} (size: {:08x})!", sig.name, symbol.address,
-                     symbol.size);
-        break;
-      }
+      candidate.code[i] =
+          PowerPC::MMU::HostRead_U32(guard, static_cast<u32>(symbol.address + i * sizeof(u32)));
     }
   }
+
+  const std::vector<const MEGASignature*> matches = FindMatches(candidates);
+  for (size_t i = 0; i < candidates.size(); ++i)
+  {
+    if (!matches[i])
+      continue;
+
+    Common::Symbol& symbol = *candidates[i].symbol;
+    symbol.name = matches[i]->name;
+    INFO_LOG_FMT(SYMBOLS, "Found {} at {:08x} (size: {:08x})!", symbol.name, symbol.address,
+                 symbol.size);
+  }
   symbol_db->Index();
 }
 
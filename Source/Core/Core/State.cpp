@@ -3,12 +3,15 @@
 
 #include "Core/State.h"
 
+#include <algorithm>
 #include <atomic>
 #include <condition_variable>
+#include <cstring>
 #include <filesystem>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <span>
 #include <string>
 #include <thread>
 #include <utility>
@@ -18,18 +21,22 @@
 
 #include <lz4.h>
 #include <lzo/lzo1x.h>
+#include <zstd.h>
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 #include "Common/Event.h"
 #include "Common/FileUtil.h"
 #include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
+#include "Common/Random.h"
 #include "Common/Thread.h"
 #include "Common/Timer.h"
 #include "Common/Version.h"
 #include "Common/WorkQueueThread.h"
 
+#include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
@@ -41,6 +48,7 @@
 #include "Core/Movie.h"
 #include "Core/NetPlayClient.h"
 #include "Core/PowerPC/PowerPC.h"
+#include "Core/StateRewind.h"
 #include "Core/System.h"
 
 #include "VideoCommon/FrameDumpFFMpeg.h"
@@ -71,11 +79,27 @@ static std::mutex s_load_or_save_in_progress_mutex;
 
 struct CompressAndDumpState_args
 {
+  // When compressing, the regions that were referenced in place belong into buffer_vector at
+  // their offsets. The chunks that hold any of them are compressed before the state is queued,
+  // the others are left empty for the save thread.
   std::vector<u8> buffer_vector;
+  std::vector<PointerWrap::ExternalRegion> external_regions;
+  std::vector<std::vector<u8>> compressed_chunks;
+  size_t uncompressed_size = 0;
   std::string filename;
+  StateType state_type = StateType::Full;
+  u64 keyframe_id = 0;
+  std::string keyframe_filename;
+  CompressionType compression_type = CompressionType::Uncompressed;
+  int zstd_level = 0;
   std::shared_ptr<Common::Event> state_write_done_event;
 };
 
+// The keyframe that delta states are based on, the last keyframe state that was saved or loaded.
+// Only accessed from the CPU thread.
+static u64 s_keyframe_id = 0;
+static std::string s_keyframe_filename;
+
 // Protects against simultaneous reads and writes to the final savestate location from multiple
 // threads.
 static std::mutex s_save_thread_mutex;
@@ -92,13 +116,12 @@ static size_t s_state_writes_in_queue;
 static std::condition_variable s_state_write_queue_is_empty;
 
 // Don't forget to increase this after doing changes on the savestate system
-constexpr u32 STATE_VERSION = 163;  // Last changed in PR 12217
+constexpr u32 STATE_VERSION = 165;  // Last changed for the free look view constants
 
 // Increase this if the StateExtendedHeader definition changes
-constexpr u32 EXTENDED_HEADER_VERSION = 1;  // Last changed in PR 12217
-
-// Change this if we ever need to store more data in the extended header
-constexpr u32 COMPRESSED_DATA_OFFSET = 0;
+constexpr u32 EXTENDED_HEADER_VERSION = 2;
+// States from before incremental savestates only have the base header
+constexpr u32 EXTENDED_HEADER_VERSION_WITHOUT_INCREMENTAL = 1;
 
 constexpr u32 COOKIE_BASE = 0xBAADBABE;
 
@@ -195,27 +218,46 @@ static void DoState(PointerWrap& p)
   p.DoMarker("Gecko");
 }
 
-void LoadFromBuffer(std::vector<u8>& buffer)
+static bool LoadFromBufferOnCPUThread(std::vector<u8>& buffer, StateType type, DeltaBase base)
 {
-  if (NetPlay::IsNetPlayRunning())
-  {
-    OSD::AddMessage("Loading savestates is disabled in Netplay to prevent desyncs");
-    return;
-  }
-
+  bool success = false;
   Core::RunOnCPUThread(
       [&] {
+        SetStateType(type, base);
         u8* ptr = buffer.data();
         PointerWrap p(&ptr, buffer.size(), PointerWrap::Mode::Read);
         DoState(p);
+        SetStateType(StateType::Full);
+        success = p.IsReadMode();
       },
       true);
+  return success;
+}
+
+bool LoadFromBuffer(std::vector<u8>& buffer, StateType type, DeltaBase base)
+{
+  if (NetPlay::IsNetPlayRunning())
+  {
+    WARN_LOG_FMT(CORE, "Not loading a savestate while NetPlay is running");
+    OSD::AddMessage("Loading savestates is disabled in Netplay to prevent desyncs");
+    return false;
+  }
+
+  return LoadFromBufferOnCPUThread(buffer, type, base);
+}
+
+bool LoadFromRollbackBuffer(std::vector<u8>& buffer, StateType type)
+{
+  return LoadFromBufferOnCPUThread(buffer, type, DeltaBase::Rollback);
 }
 
-void SaveToBuffer(std::vector<u8>& buffer)
+bool SaveToBuffer(std::vector<u8>& buffer, StateType type, DeltaBase base)
 {
+  bool success = false;
   Core::RunOnCPUThread(
       [&] {
+        SetStateType(type, base);
+
         u8* ptr = nullptr;
         PointerWrap p_measure(&ptr, 0, PointerWrap::Mode::Measure);
 
@@ -226,8 +268,12 @@ void SaveToBuffer(std::vector<u8>& buffer)
         ptr = buffer.data();
         PointerWrap p(&ptr, buffer_size, PointerWrap::Mode::Write);
         DoState(p);
+
+        SetStateType(StateType::Full);
+        success = p.IsWriteMode();
       },
       true);
+  return success;
 }
 
 // return state number not in map
@@ -306,51 +352,177 @@ static std::map<double, int> GetSavedStates()
   return m;
 }
 
-static void CompressBufferToFile(const u8* raw_buffer, u64 size, File::IOFile& f)
+// Savestates are compressed in chunks of this size, so that the chunks can be compressed and
+// decompressed on all cores at once
+constexpr u32 COMPRESSION_CHUNK_SIZE = 4 * 1024 * 1024;
+
+// Calls func for every chunk index, on as many threads as there are cores
+template <typename Func>
+static void ForEachChunkInParallel(size_t chunk_count, const Func& func)
 {
-  u64 total_bytes_compressed = 0;
+  const size_t thread_count =
+      std::min<size_t>(chunk_count, std::max(1u, std::thread::hardware_concurrency()));
+
+  std::atomic<size_t> next_chunk = 0;
+  const auto work = [&] {
+    for (size_t i = next_chunk++; i < chunk_count; i = next_chunk++)
+      func(i);
+  };
+
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < thread_count; ++i)
+    threads.emplace_back(work);
+  work();
+  for (std::thread& thread : threads)
+    thread.join();
+}
 
-  while (true)
+// Splits the serialized state into the parts of the PointerWrap buffer and the regions that were
+// referenced in place, in the order they make up the state
+static std::vector<std::span<const u8>>
+GetStateSegments(const std::vector<u8>& buffer,
+                 const std::vector<PointerWrap::ExternalRegion>& external_regions)
+{
+  std::vector<std::span<const u8>> segments;
+  size_t buffer_offset = 0;
+  for (const PointerWrap::ExternalRegion& region : external_regions)
+  {
+    segments.emplace_back(buffer.data() + buffer_offset, region.offset - buffer_offset);
+    segments.emplace_back(region.data, region.size);
+    buffer_offset = region.offset;
+  }
+  segments.emplace_back(buffer.data() + buffer_offset, buffer.size() - buffer_offset);
+  return segments;
+}
+
+// Returns the data at offset, copied into scratch if it spans several segments
+static const u8* GetStateData(std::span<const std::span<const u8>> segments, u64 offset,
+                              size_t size, std::vector<u8>& scratch)
+{
+  size_t i = 0;
+  while (offset >= segments[i].size())
+    offset -= segments[i++].size();
+
+  if (offset + size <= segments[i].size())
+    return segments[i].data() + offset;
+
+  scratch.resize(size);
+  for (size_t copied = 0; copied < size; offset = 0)
+  {
+    const size_t length = std::min<u64>(size - copied, segments[i].size() - offset);
+    std::memcpy(scratch.data() + copied, segments[i++].data() + offset, length);
+    copied += length;
+  }
+  return scratch.data();
+}
+
+// Whether the chunk at index i holds any part of the regions that were referenced in place
+static bool ChunkHasExternalRegion(const std::vector<PointerWrap::ExternalRegion>& external_regions,
+                                   size_t i)
+{
+  const u64 chunk_start = u64{i} * COMPRESSION_CHUNK_SIZE;
+  const u64 chunk_end = chunk_start + COMPRESSION_CHUNK_SIZE;
+  u64 inserted_size = 0;
+  for (const PointerWrap::ExternalRegion& region : external_regions)
   {
-    u64 bytes_left_to_compress = size - total_bytes_compressed;
+    const u64 region_start = region.offset + inserted_size;
+    inserted_size += region.size;
+    if (region_start < chunk_end && region_start + region.size > chunk_start)
+      return true;
+  }
+  return false;
+}
+
+// Compresses the chunks for which should_compress(i) returns true, in parallel
+template <typename Func>
+static bool CompressChunks(std::span<const std::span<const u8>> segments, u64 size,
+                           CompressionType compression_type, int zstd_level,
+                           std::vector<std::vector<u8>>& compressed_chunks,
+                           const Func& should_compress)
+{
+  const size_t chunk_count = (size + COMPRESSION_CHUNK_SIZE - 1) / COMPRESSION_CHUNK_SIZE;
+  compressed_chunks.resize(chunk_count);
+  std::atomic<bool> failed = false;
+
+  ForEachChunkInParallel(chunk_count, [&](size_t i) {
+    if (!should_compress(i))
+      return;
 
-    int bytes_to_compress =
-        static_cast<int>(std::min(static_cast<u64>(LZ4_MAX_INPUT_SIZE), bytes_left_to_compress));
-    int compressed_buffer_size = LZ4_compressBound(bytes_to_compress);
-    auto compressed_buffer = std::make_unique<char[]>(compressed_buffer_size);
-    s32 compressed_len =
-        LZ4_compress_default(reinterpret_cast<const char*>(raw_buffer) + total_bytes_compressed,
-                             compressed_buffer.get(), bytes_to_compress, compressed_buffer_size);
+    const size_t chunk_size =
+        std::min<u64>(COMPRESSION_CHUNK_SIZE, size - i * COMPRESSION_CHUNK_SIZE);
+    std::vector<u8> scratch;
+    const u8* chunk = GetStateData(segments, i * COMPRESSION_CHUNK_SIZE, chunk_size, scratch);
+    std::vector<u8>& compressed = compressed_chunks[i];
 
-    if (compressed_len == 0)
+    if (compression_type == CompressionType::ZstdChunks)
     {
-      PanicAlertFmtT("Internal LZ4 Error - compression failed");
-      break;
+      compressed.resize(ZSTD_compressBound(chunk_size));
+      const size_t compressed_len =
+          ZSTD_compress(compressed.data(), compressed.size(), chunk, chunk_size, zstd_level);
+      if (ZSTD_isError(compressed_len))
+        failed = true;
+      else
+        compressed.resize(compressed_len);
+    }
+    else
+    {
+      compressed.resize(LZ4_compressBound(static_cast<int>(chunk_size)));
+      const int compressed_len = LZ4_compress_default(
+          reinterpret_cast<const char*>(chunk), reinterpret_cast<char*>(compressed.data()),
+          static_cast<int>(chunk_size), static_cast<int>(compressed.size()));
+      if (compressed_len == 0)
+        failed = true;
+      else
+        compressed.resize(compressed_len);
     }
+  });
+
+  if (failed)
+  {
+    PanicAlertFmtT("Internal compression error - compression failed");
+    return false;
+  }
+
+  return true;
+}
+
+static void WriteCompressedChunksToFile(const std::vector<std::vector<u8>>& compressed_chunks,
+                                        File::IOFile& f)
+{
 
+  f.WriteArray(&COMPRESSION_CHUNK_SIZE, 1);
+  for (const std::vector<u8>& compressed : compressed_chunks)
+  {
     // The size of the data to write is 'compressed_len'
+    const s32 compressed_len = static_cast<s32>(compressed.size());
     f.WriteArray(&compressed_len, 1);
-    f.WriteBytes(compressed_buffer.get(), compressed_len);
-
-    total_bytes_compressed += bytes_to_compress;
-    if (total_bytes_compressed == size)
-      break;
+    f.WriteBytes(compressed.data(), compressed.size());
   }
 }
 
-static void CreateExtendedHeader(StateExtendedHeader& extended_header, size_t uncompressed_size)
+static void CreateExtendedHeader(StateExtendedHeader& extended_header, size_t uncompressed_size,
+                                 const CompressAndDumpState_args& save_args)
 {
+  StateExtendedIncrementalHeader& incremental_header = extended_header.incremental_header;
+  incremental_header.state_type = static_cast<u32>(save_args.state_type);
+  incremental_header.keyframe_id = save_args.keyframe_id;
+  if (save_args.state_type == StateType::Delta)
+    extended_header.keyframe_filename = save_args.keyframe_filename;
+  incremental_header.keyframe_filename_length =
+      static_cast<u32>(extended_header.keyframe_filename.length());
+
   StateExtendedBaseHeader& base_header = extended_header.base_header;
   base_header.header_version = EXTENDED_HEADER_VERSION;
-  base_header.compression_type =
-      s_use_compression ? CompressionType::LZ4 : CompressionType::Uncompressed;
-  base_header.payload_offset = COMPRESSED_DATA_OFFSET;
+  base_header.compression_type = save_args.compression_type;
+  base_header.payload_offset = static_cast<u32>(sizeof(StateExtendedIncrementalHeader) +
+                                                extended_header.keyframe_filename.length());
   base_header.uncompressed_size = uncompressed_size;
 
   // If more fields are added to StateExtendedHeader, set them here.
 }
 
-static void WriteHeadersToFile(size_t uncompressed_size, File::IOFile& f)
+static void WriteHeadersToFile(size_t uncompressed_size, const CompressAndDumpState_args& save_args,
+                               File::IOFile& f)
 {
   StateHeader header{};
   SConfig::GetInstance().GetGameID().copy(header.legacy_header.game_id,
@@ -362,22 +534,36 @@ static void WriteHeadersToFile(size_t uncompressed_size, File::IOFile& f)
   header.version_header.version_string_length = static_cast<u32>(header.version_string.length());
 
   StateExtendedHeader extended_header{};
-  CreateExtendedHeader(extended_header, uncompressed_size);
+  CreateExtendedHeader(extended_header, uncompressed_size, save_args);
 
   f.WriteArray(&header.legacy_header, 1);
   f.WriteArray(&header.version_header, 1);
   f.WriteString(header.version_string);
 
   f.WriteArray(&extended_header.base_header, 1);
-  // If StateExtendedHeader is amended to include more than the base, add WriteBytes() calls here.
+  f.WriteArray(&extended_header.incremental_header, 1);
+  f.WriteString(extended_header.keyframe_filename);
+  // If StateExtendedHeader is amended to include more fields, add WriteBytes() calls here.
 }
 
 static void CompressAndDumpState(CompressAndDumpState_args& save_args)
 {
-  const u8* const buffer_data = save_args.buffer_vector.data();
-  const size_t buffer_size = save_args.buffer_vector.size();
   const std::string& filename = save_args.filename;
 
+  if (save_args.compression_type != CompressionType::Uncompressed)
+  {
+    // The chunks that hold emulated memory were compressed while emulation was paused, so only
+    // the state buffer is read here
+    std::vector<std::vector<u8>>& compressed_chunks = save_args.compressed_chunks;
+    if (!CompressChunks(GetStateSegments(save_args.buffer_vector, save_args.external_regions),
+                        save_args.uncompressed_size, save_args.compression_type,
+                        save_args.zstd_level, compressed_chunks,
+                        [&](size_t i) { return compressed_chunks[i].empty(); }))
+    {
+      return;
+    }
+  }
+
   // Find free temporary filename.
   // TODO: The file exists check and the actual opening of the file should be atomic, we don't have
   // functions for that.
@@ -396,12 +582,12 @@ static void CompressAndDumpState(CompressAndDumpState_args& save_args)
     return;
   }
 
-  WriteHeadersToFile(buffer_size, f);
+  WriteHeadersToFile(save_args.uncompressed_size, save_args, f);
 
-  if (s_use_compression)
-    CompressBufferToFile(buffer_data, buffer_size, f);
+  if (save_args.compression_type != CompressionType::Uncompressed)
+    WriteCompressedChunksToFile(save_args.compressed_chunks, f);
   else
-    f.WriteBytes(buffer_data, buffer_size);
+    f.WriteBytes(save_args.buffer_vector.data(), save_args.buffer_vector.size());
 
   const std::string last_state_filename = File::GetUserPath(D_STATESAVES_IDX) + "lastState.sav";
   const std::string last_state_dtmname = last_state_filename + ".dtm";
@@ -446,7 +632,7 @@ static void CompressAndDumpState(CompressAndDumpState_args& save_args)
   Host_UpdateMainFrame();
 }
 
-void SaveAs(const std::string& filename, bool wait)
+void SaveAs(const std::string& filename, bool wait, StateType type)
 {
   std::unique_lock lk(s_load_or_save_in_progress_mutex, std::try_to_lock);
   if (!lk)
@@ -454,14 +640,31 @@ void SaveAs(const std::string& filename, bool wait)
 
   Core::RunOnCPUThread(
       [&] {
+        if (type == StateType::Delta && s_keyframe_id == 0)
+        {
+          Core::DisplayMessage("Unable to save a delta state without a keyframe", 4000);
+          return;
+        }
+
         {
           std::lock_guard lk_(s_state_writes_in_queue_mutex);
           ++s_state_writes_in_queue;
         }
 
+        // Saving a keyframe makes the memory contents the new base of delta states
+        const u64 keyframe_id =
+            type == StateType::Keyframe ? Common::Random::GenerateValue<u64>() | 1 : s_keyframe_id;
+        SetStateType(type);
+
+        // When compressing, the emulated memory is compressed in place instead of being copied
+        // into the buffer
+        std::vector<PointerWrap::ExternalRegion> external_regions;
+        std::vector<PointerWrap::ExternalRegion>* const external_regions_ptr =
+            s_use_compression ? &external_regions : nullptr;
+
         // Measure the size of the buffer.
         u8* ptr = nullptr;
-        PointerWrap p_measure(&ptr, 0, PointerWrap::Mode::Measure);
+        PointerWrap p_measure(&ptr, 0, PointerWrap::Mode::Measure, external_regions_ptr);
         DoState(p_measure);
         const size_t buffer_size = reinterpret_cast<size_t>(ptr);
 
@@ -469,18 +672,52 @@ void SaveAs(const std::string& filename, bool wait)
         std::vector<u8> current_buffer;
         current_buffer.resize(buffer_size);
         ptr = current_buffer.data();
-        PointerWrap p(&ptr, buffer_size, PointerWrap::Mode::Write);
+        PointerWrap p(&ptr, buffer_size, PointerWrap::Mode::Write, external_regions_ptr);
         DoState(p);
 
-        if (p.IsWriteMode())
+        SetStateType(StateType::Full);
+
+        CompressAndDumpState_args save_args;
+        save_args.uncompressed_size = buffer_size;
+        bool success = p.IsWriteMode();
+        if (success && s_use_compression)
+        {
+          for (const PointerWrap::ExternalRegion& region : external_regions)
+            save_args.uncompressed_size += region.size;
+
+          save_args.zstd_level = Config::Get(Config::MAIN_SAVESTATE_ZSTD_LEVEL);
+          save_args.compression_type = save_args.zstd_level > 0 ? CompressionType::ZstdChunks :
+                                                                  CompressionType::LZ4Chunks;
+
+          // Emulation only stays paused until this returns, so the chunks that hold emulated
+          // memory are compressed here. The rest of the state is left to the save thread.
+          success = CompressChunks(
+              GetStateSegments(current_buffer, external_regions), save_args.uncompressed_size,
+              save_args.compression_type, save_args.zstd_level, save_args.compressed_chunks,
+              [&](size_t i) { return ChunkHasExternalRegion(external_regions, i); });
+        }
+
+        if (success)
         {
           Core::DisplayMessage("Saving State...", 1000);
 
+          if (type == StateType::Keyframe)
+          {
+            s_keyframe_id = keyframe_id;
+            s_keyframe_filename = filename;
+          }
+
           std::shared_ptr<Common::Event> sync_event;
 
-          CompressAndDumpState_args save_args;
           save_args.buffer_vector = std::move(current_buffer);
+          save_args.external_regions = std::move(external_regions);
           save_args.filename = filename;
+          if (type != StateType::Full)
+          {
+            save_args.state_type = type;
+            save_args.keyframe_id = keyframe_id;
+            save_args.keyframe_filename = s_keyframe_filename;
+          }
           if (wait)
           {
             sync_event = std::make_shared<Common::Event>();
@@ -691,6 +928,80 @@ static bool DecompressLZ4(std::vector<u8>& raw_buffer, u64 size, File::IOFile& f
   }
 }
 
+static bool DecompressChunks(std::vector<u8>& raw_buffer, u64 size,
+                             CompressionType compression_type, File::IOFile& f)
+{
+  raw_buffer.resize(size);
+
+  u32 chunk_size;
+  if (!f.ReadArray(&chunk_size, 1) || chunk_size == 0)
+  {
+    PanicAlertFmt("Could not read state chunk size");
+    return false;
+  }
+
+  // Read all chunks first, so that the threads only have to decompress
+  const size_t chunk_count = (size + chunk_size - 1) / chunk_size;
+  std::vector<std::vector<u8>> compressed_chunks(chunk_count);
+  for (std::vector<u8>& compressed : compressed_chunks)
+  {
+    s32 compressed_data_len;
+    if (!f.ReadArray(&compressed_data_len, 1))
+    {
+      PanicAlertFmt("Could not read state data length");
+      return false;
+    }
+
+    if (compressed_data_len <= 0)
+    {
+      PanicAlertFmt("Internal compression error - Tried decompressing {0} bytes",
+                    compressed_data_len);
+      return false;
+    }
+
+    compressed.resize(compressed_data_len);
+    if (!f.ReadBytes(compressed.data(), compressed.size()))
+    {
+      PanicAlertFmt("Could not read state data");
+      return false;
+    }
+  }
+
+  std::atomic<bool> failed = false;
+  ForEachChunkInParallel(chunk_count, [&](size_t i) {
+    u8* chunk = raw_buffer.data() + i * chunk_size;
+    const size_t decompressed_size = std::min<u64>(chunk_size, size - i * chunk_size);
+    const std::vector<u8>& compressed = compressed_chunks[i];
+
+    size_t bytes_read;
+    if (compression_type == CompressionType::ZstdChunks)
+    {
+      bytes_read = ZSTD_decompress(chunk, decompressed_size, compressed.data(), compressed.size());
+      if (ZSTD_isError(bytes_read))
+        bytes_read = 0;
+    }
+    else
+    {
+      const int result = LZ4_decompress_safe(reinterpret_cast<const char*>(compressed.data()),
+                                             reinterpret_cast<char*>(chunk),
+                                             static_cast<int>(compressed.size()),
+                                             static_cast<int>(decompressed_size));
+      bytes_read = result < 0 ? 0 : static_cast<size_t>(result);
+    }
+
+    if (bytes_read != decompressed_size)
+      failed = true;
+  });
+
+  if (failed)
+  {
+    PanicAlertFmt("Internal compression error - decompression failed");
+    return false;
+  }
+
+  return true;
+}
+
 static bool ValidateHeaders(const StateHeader& header)
 {
   bool success = true;
@@ -738,7 +1049,8 @@ static bool ValidateHeaders(const StateHeader& header)
   return success;
 }
 
-static void LoadFileStateData(const std::string& filename, std::vector<u8>& ret_data)
+static void LoadFileStateData(const std::string& filename, std::vector<u8>& ret_data,
+                              StateExtendedHeader& ret_extended_header)
 {
   File::IOFile f;
 
@@ -762,19 +1074,37 @@ static void LoadFileStateData(const std::string& filename, std::vector<u8>& ret_
   if (!ReadStateHeaderFromFile(header, f) || !ValidateHeaders(header))
     return;
 
-  StateExtendedHeader extended_header;
+  StateExtendedHeader extended_header{};
   if (!f.ReadArray(&extended_header.base_header, 1))
   {
     PanicAlertFmt("Unable to read state header");
     return;
   }
-  // If StateExtendedHeader is amended to include more than the base, add ReadBytes() calls here.
 
-  if (extended_header.base_header.header_version != EXTENDED_HEADER_VERSION)
+  if (extended_header.base_header.header_version == EXTENDED_HEADER_VERSION)
+  {
+    if (!f.ReadArray(&extended_header.incremental_header, 1))
+    {
+      PanicAlertFmt("Unable to read state header");
+      return;
+    }
+
+    const u32 length = extended_header.incremental_header.keyframe_filename_length;
+    auto keyframe_filename_buffer = std::make_unique<char[]>(length);
+    if (!f.ReadBytes(keyframe_filename_buffer.get(), length))
+    {
+      PanicAlertFmt("Unable to read state header");
+      return;
+    }
+    extended_header.keyframe_filename = std::string(keyframe_filename_buffer.get(), length);
+  }
+  else if (extended_header.base_header.header_version !=
+           EXTENDED_HEADER_VERSION_WITHOUT_INCREMENTAL)
   {
     PanicAlertFmt("State header corrupted");
     return;
   }
+  // If StateExtendedHeader is amended to include more fields, add ReadBytes() calls here.
 
   std::vector<u8> buffer;
 
@@ -788,6 +1118,20 @@ static void LoadFileStateData(const std::string& filename, std::vector<u8>& ret_
 
     break;
   }
+  case CompressionType::LZ4Chunks:
+  case CompressionType::ZstdChunks:
+  {
+    Core::DisplayMessage("Decompressing State...", 500);
+    const auto compression_type =
+        static_cast<CompressionType>(extended_header.base_header.compression_type);
+    if (!DecompressChunks(buffer, extended_header.base_header.uncompressed_size, compression_type,
+                          f))
+    {
+      return;
+    }
+
+    break;
+  }
   case CompressionType::Uncompressed:
   {
     u64 header_len = sizeof(StateHeaderLegacy) + sizeof(StateHeaderVersion) +
@@ -818,6 +1162,41 @@ static void LoadFileStateData(const std::string& filename, std::vector<u8>& ret_
 
   // all good
   ret_data.swap(buffer);
+  ret_extended_header = std::move(extended_header);
+}
+
+// Loads the keyframe a delta state is based on. Returns false if the keyframe couldn't be read,
+// and sets loaded if the emulated state was overwritten.
+static bool LoadKeyframe(const StateExtendedHeader& delta_header, bool* loaded)
+{
+  std::vector<u8> buffer;
+  StateExtendedHeader extended_header{};
+  LoadFileStateData(delta_header.keyframe_filename, buffer, extended_header);
+  if (buffer.empty() ||
+      extended_header.incremental_header.state_type != static_cast<u32>(StateType::Keyframe) ||
+      extended_header.incremental_header.keyframe_id !=
+          delta_header.incremental_header.keyframe_id)
+  {
+    Core::DisplayMessage(
+        fmt::format("The keyframe {} of this delta state is missing or has been overwritten",
+                    delta_header.keyframe_filename),
+        OSD::Duration::NORMAL);
+    return false;
+  }
+
+  SetStateType(StateType::Keyframe);
+  u8* ptr = buffer.data();
+  PointerWrap p(&ptr, buffer.size(), PointerWrap::Mode::Read);
+  DoState(p);
+  SetStateType(StateType::Full);
+
+  *loaded = true;
+  if (!p.IsReadMode())
+    return false;
+
+  s_keyframe_id = extended_header.incremental_header.keyframe_id;
+  s_keyframe_filename = delta_header.keyframe_filename;
+  return true;
 }
 
 void LoadAs(const std::string& filename)
@@ -855,15 +1234,31 @@ void LoadAs(const std::string& filename)
         // brackets here are so buffer gets freed ASAP
         {
           std::vector<u8> buffer;
-          LoadFileStateData(filename, buffer);
+          StateExtendedHeader extended_header{};
+          LoadFileStateData(filename, buffer, extended_header);
+
+          const StateExtendedIncrementalHeader& incremental_header =
+              extended_header.incremental_header;
+          const StateType type = static_cast<StateType>(incremental_header.state_type);
+          const bool has_base = type != StateType::Delta ||
+                                incremental_header.keyframe_id == s_keyframe_id ||
+                                LoadKeyframe(extended_header, &loaded);
 
-          if (!buffer.empty())
+          if (!buffer.empty() && has_base)
           {
+            SetStateType(type);
             u8* ptr = buffer.data();
             PointerWrap p(&ptr, buffer.size(), PointerWrap::Mode::Read);
             DoState(p);
+            SetStateType(StateType::Full);
             loaded = true;
             loadedSuccessfully = p.IsReadMode();
+
+            if (loadedSuccessfully && type == StateType::Keyframe)
+            {
+              s_keyframe_id = incremental_header.keyframe_id;
+              s_keyframe_filename = filename;
+            }
           }
         }
 
@@ -902,6 +1297,8 @@ void SetOnAfterLoadCallback(AfterLoadCallbackFunc callback)
 
 void Init()
 {
+  Rewind::Init();
+
   s_save_thread.Reset("Savestate Worker", [](CompressAndDumpState_args args) {
     CompressAndDumpState(args);
 
@@ -919,6 +1316,11 @@ void Init()
 void Shutdown()
 {
   s_save_thread.Shutdown();
+  Rewind::Shutdown();
+
+  // The bases of delta states are gone with the emulated memory
+  s_keyframe_id = 0;
+  s_keyframe_filename.clear();
 
   // swapping with an empty vector, rather than clear()ing
   // this gives a better guarantee to free the allocated memory right NOW (as opposed to, actually,
@@ -12,6 +12,7 @@
 #include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Core/StateDelta.h"
 
 namespace State
 {
@@ -50,6 +51,11 @@ enum CompressionType : u16
 {
   Uncompressed = 0,
   LZ4 = 1,
+  // The payload is split into chunks of the same uncompressed size (except for the last one),
+  // so that the chunks can be compressed and decompressed in parallel. A u32 chunk size is
+  // followed by an s32 compressed size and the compressed data of every chunk.
+  LZ4Chunks = 2,
+  ZstdChunks = 3,
   // Add new compression types after this, as the compression type
   // is numerically stored in the state file.
 };
@@ -67,10 +73,24 @@ static_assert(offsetof(StateExtendedBaseHeader, payload_offset) == 4);
 static_assert(offsetof(StateExtendedBaseHeader, uncompressed_size) == 8);
 static_assert(std::is_trivially_copyable_v<StateExtendedBaseHeader>);
 
+// Added in extended header version 2
+struct StateExtendedIncrementalHeader
+{
+  u32 state_type;  // StateType
+  u32 keyframe_filename_length;
+  // The keyframe of a keyframe or delta state
+  u64 keyframe_id;
+};
+static_assert(sizeof(StateExtendedIncrementalHeader) == 16);
+static_assert(std::is_trivially_copyable_v<StateExtendedIncrementalHeader>);
+
 struct StateExtendedHeader
 {
   StateExtendedBaseHeader base_header;
-  // Feel free to add new fields here, adjusting COMPRESSED_DATA_OFFSET accordingly, as well as
+  StateExtendedIncrementalHeader incremental_header;
+  // The file a delta state is based on
+  std::string keyframe_filename;
+  // Feel free to add new fields here, adjusting the payload offset accordingly, as well as
   // CreateExtendedHeader(). Add the appropriate IOFile read/write calls within LoadFileStateData()
   // and WriteHeadersToFile()
 };
@@ -98,11 +118,19 @@ u64 GetUnixTimeOfSlot(int slot);
 void Save(int slot, bool wait = false);
 void Load(int slot);
 
-void SaveAs(const std::string& filename, bool wait = false);
+// Keyframe states are full states that later delta states can be based on. Delta states only
+// store the pages of emulated memory that changed since the last keyframe that was saved or
+// loaded, and loading one loads its keyframe first unless it's the current one.
+void SaveAs(const std::string& filename, bool wait = false, StateType type = StateType::Full);
 void LoadAs(const std::string& filename);
 
-void SaveToBuffer(std::vector<u8>& buffer);
-void LoadFromBuffer(std::vector<u8>& buffer);
+bool SaveToBuffer(std::vector<u8>& buffer, StateType type = StateType::Full,
+                  DeltaBase base = DeltaBase::Savestate);
+bool LoadFromBuffer(std::vector<u8>& buffer, StateType type = StateType::Full,
+                    DeltaBase base = DeltaBase::Savestate);
+// Only for NetPlay rollback, which loads the states it captured itself. Unlike LoadFromBuffer, this
+// works while NetPlay is running, since every client rolls back to the same states.
+bool LoadFromRollbackBuffer(std::vector<u8>& buffer, StateType type);
 
 void LoadLastSaved(int i = 1);
 void SaveFirstSaved();
@@ -0,0 +1,102 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/StateDelta.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "Common/ChunkFile.h"
+
+namespace State
+{
+static StateType s_state_type = StateType::Full;
+static DeltaBase s_delta_base = DeltaBase::Savestate;
+
+StateType GetStateType()
+{
+  return s_state_type;
+}
+
+void SetStateType(StateType type, DeltaBase base)
+{
+  s_state_type = type;
+  s_delta_base = base;
+}
+
+CaptureLoad GetCaptureLoad(u64 serial, u64 keyframe_serial, u64 base_serial)
+{
+  const bool is_keyframe = serial == keyframe_serial;
+  return {.load_keyframe = is_keyframe || keyframe_serial != base_serial,
+          .load_delta = !is_keyframe};
+}
+
+void DeltaArray::DoState(PointerWrap& p, u8* data, u32 size)
+{
+  std::vector<u8>& base = m_bases[static_cast<size_t>(s_delta_base)];
+
+  switch (s_state_type)
+  {
+  case StateType::Full:
+    p.DoArrayInPlace(data, size);
+    break;
+
+  case StateType::Keyframe:
+    p.DoArrayInPlace(data, size);
+    if (p.IsReadMode() || p.IsWriteMode())
+      base.assign(data, data + size);
+    break;
+
+  case StateType::Delta:
+  {
+    u32 base_size = static_cast<u32>(base.size());
+    p.Do(base_size);
+    if (base_size != size || base.size() != size)
+    {
+      // Loading a delta that isn't based on the current keyframe
+      p.SetVerifyMode();
+      return;
+    }
+
+    std::vector<u32> pages;
+    if (!p.IsReadMode())
+    {
+      for (u32 offset = 0; offset < size; offset += PAGE_SIZE)
+      {
+        const u32 length = std::min(PAGE_SIZE, size - offset);
+        if (std::memcmp(data + offset, base.data() + offset, length) != 0)
+          pages.push_back(offset / PAGE_SIZE);
+      }
+    }
+    p.Do(pages);
+
+    if (p.IsReadMode())
+    {
+      if (!std::all_of(pages.begin(), pages.end(),
+                       [size](u32 page) { return page < (size + PAGE_SIZE - 1) / PAGE_SIZE; }))
+      {
+        p.SetVerifyMode();
+        return;
+      }
+      std::memcpy(data, base.data(), size);
+    }
+
+    for (const u32 page : pages)
+    {
+      const u32 offset = page * PAGE_SIZE;
+      p.DoArray(data + offset, std::min(PAGE_SIZE, size - offset));
+    }
+    break;
+  }
+  }
+}
+
+void DeltaArray::Clear()
+{
+  for (std::vector<u8>& base : m_bases)
+  {
+    base.clear();
+    base.shrink_to_fit();
+  }
+}
+}  // namespace State
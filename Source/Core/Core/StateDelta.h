@@ -0,0 +1,65 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Support for incremental savestates, which only store the pages of the large memory arrays that
+// changed since the keyframe state they are based on.
+
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+class PointerWrap;
+
+namespace State
+{
+enum class StateType : u32
+{
+  // A regular savestate, which doesn't change the base of delta states
+  Full = 0,
+  // A full savestate that delta states can be based on
+  Keyframe = 1,
+  // Only stores the memory pages that differ from the last keyframe
+  Delta = 2,
+};
+
+// Savestate files, the rewind ring and NetPlay rollback each have their own keyframe
+enum class DeltaBase : u32
+{
+  Savestate = 0,
+  Rewind = 1,
+  Rollback = 2,
+  Count,
+};
+
+// The type of the state that is being saved or loaded, Full outside of saving and loading
+StateType GetStateType();
+void SetStateType(StateType type, DeltaBase base = DeltaBase::Savestate);
+
+// The rewind ring and NetPlay rollback keep captures that are keyframes or deltas of one.
+// Returning to a capture loads its keyframe unless the DeltaArrays hold that one already, and then
+// the capture itself if it's a delta. A keyframe is always loaded, since the emulation moved on.
+struct CaptureLoad
+{
+  bool load_keyframe;
+  bool load_delta;
+};
+CaptureLoad GetCaptureLoad(u64 serial, u64 keyframe_serial, u64 base_serial);
+
+// A large memory array that is serialized as a delta in delta states. It keeps a copy of its
+// contents from when the last keyframe of each DeltaBase was saved or loaded, which the pages are
+// compared against when saving a delta and copied from when loading one.
+class DeltaArray
+{
+public:
+  static constexpr u32 PAGE_SIZE = 0x1000;
+
+  void DoState(PointerWrap& p, u8* data, u32 size);
+  void Clear();
+
+private:
+  std::array<std::vector<u8>, static_cast<size_t>(DeltaBase::Count)> m_bases;
+};
+}  // namespace State
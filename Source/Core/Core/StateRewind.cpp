@@ -0,0 +1,260 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/StateRewind.h"
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Common/Config/Config.h"
+#include "Common/Logging/Log.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/Core.h"
+#include "Core/CoreTiming.h"
+#include "Core/HW/SystemTimers.h"
+#include "Core/NetPlayClient.h"
+#include "Core/State.h"
+#include "Core/StateDelta.h"
+#include "Core/System.h"
+#include "VideoCommon/OnScreenDisplay.h"
+
+namespace State::Rewind
+{
+namespace
+{
+struct Capture
+{
+  std::vector<u8> buffer;
+  u64 serial = 0;
+  // The capture this one is a delta of, or its own serial for keyframes
+  u64 keyframe_serial = 0;
+  u64 ticks = 0;
+
+  bool IsKeyframe() const { return serial == keyframe_serial; }
+};
+
+bool s_enabled = false;
+u64 s_interval_ticks = 0;
+size_t s_memory_limit = 0;
+
+// Only accessed on the CPU thread
+std::deque<Capture> s_captures;
+u64 s_next_serial = 1;
+// The keyframe whose memory the DeltaArrays hold as the rewind base, always the keyframe of the
+// newest captures
+u64 s_base_serial = 0;
+size_t s_base_size = 0;
+bool s_force_keyframe = false;
+u64 s_next_capture_ticks = 0;
+bool s_capture_queued = false;
+
+std::mutex s_stats_mutex;
+Stats s_stats;
+}  // namespace
+
+static size_t GetMemoryUsage()
+{
+  size_t usage = 0;
+  for (const Capture& capture : s_captures)
+    usage += capture.buffer.size();
+  return usage;
+}
+
+static void UpdateStats(const Capture* last_capture, u64 last_capture_us)
+{
+  std::lock_guard lk(s_stats_mutex);
+
+  s_stats.capture_count = s_captures.size();
+  s_stats.keyframe_count =
+      std::count_if(s_captures.begin(), s_captures.end(),
+                    [](const Capture& capture) { return capture.IsKeyframe(); });
+  s_stats.memory_usage = GetMemoryUsage();
+
+  if (last_capture)
+  {
+    s_stats.last_capture_us = last_capture_us;
+    s_stats.last_capture_size = last_capture->buffer.size();
+    s_stats.last_capture_was_keyframe = last_capture->IsKeyframe();
+  }
+}
+
+static void EvictOldCaptures()
+{
+  size_t usage = GetMemoryUsage();
+  while (usage > s_memory_limit)
+  {
+    // A keyframe can only be dropped together with the deltas based on it
+    const auto next_keyframe =
+        std::find_if(s_captures.begin() + 1, s_captures.end(),
+                     [](const Capture& capture) { return capture.IsKeyframe(); });
+    if (next_keyframe == s_captures.end())
+    {
+      // Start a new keyframe so that this one can be dropped next time
+      s_force_keyframe = true;
+      return;
+    }
+
+    for (auto it = s_captures.begin(); it != next_keyframe; ++it)
+      usage -= it->buffer.size();
+    s_captures.erase(s_captures.begin(), next_keyframe);
+  }
+}
+
+static void CaptureOnCPUThread()
+{
+  s_capture_queued = false;
+
+  const auto start = std::chrono::steady_clock::now();
+
+  Capture capture;
+  capture.serial = s_next_serial++;
+  capture.ticks = Core::System::GetInstance().GetCoreTiming().GetTicks();
+
+  const bool keyframe = s_base_serial == 0 || s_force_keyframe;
+  capture.keyframe_serial = keyframe ? capture.serial : s_base_serial;
+  if (!SaveToBuffer(capture.buffer, keyframe ? StateType::Keyframe : StateType::Delta,
+                    DeltaBase::Rewind))
+  {
+    ERROR_LOG_FMT(CORE, "Failed to capture a state for rewinding");
+    return;
+  }
+
+  if (keyframe)
+  {
+    s_base_serial = capture.serial;
+    s_base_size = capture.buffer.size();
+  }
+  // Deltas grow as more pages differ from the keyframe, start a new one once they stop being much
+  // smaller than it
+  s_force_keyframe = !keyframe && capture.buffer.size() > s_base_size / 2;
+  s_next_capture_ticks = capture.ticks + s_interval_ticks;
+
+  const u64 capture_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                             std::chrono::steady_clock::now() - start)
+                             .count();
+
+  s_captures.push_back(std::move(capture));
+  EvictOldCaptures();
+  UpdateStats(&s_captures.back(), capture_us);
+}
+
+static bool LoadOnCPUThread()
+{
+  const u64 ticks = Core::System::GetInstance().GetCoreTiming().GetTicks();
+
+  // Stepping back right after a capture or rewind goes to the capture before it
+  if (s_captures.size() > 1 && ticks < s_captures.back().ticks + s_interval_ticks / 2)
+  {
+    // Deltas can't be based on a keyframe that isn't in the ring anymore
+    if (s_captures.back().IsKeyframe())
+      s_force_keyframe = true;
+    s_captures.pop_back();
+  }
+
+  if (s_captures.empty())
+  {
+    OSD::AddMessage("Nothing to rewind to");
+    return false;
+  }
+
+  Capture& capture = s_captures.back();
+  const CaptureLoad load = GetCaptureLoad(capture.serial, capture.keyframe_serial, s_base_serial);
+  if (load.load_keyframe)
+  {
+    auto keyframe = std::find_if(s_captures.begin(), s_captures.end(), [&](const Capture& c) {
+      return c.serial == capture.keyframe_serial;
+    });
+    if (keyframe == s_captures.end() ||
+        !LoadFromBuffer(keyframe->buffer, StateType::Keyframe, DeltaBase::Rewind))
+    {
+      s_captures.clear();
+      s_base_serial = 0;
+      UpdateStats(nullptr, 0);
+      return false;
+    }
+    s_base_serial = keyframe->serial;
+    s_base_size = keyframe->buffer.size();
+  }
+
+  if (load.load_delta && !LoadFromBuffer(capture.buffer, StateType::Delta, DeltaBase::Rewind))
+  {
+    s_captures.clear();
+    s_base_serial = 0;
+    UpdateStats(nullptr, 0);
+    return false;
+  }
+
+  s_next_capture_ticks = capture.ticks + s_interval_ticks;
+  UpdateStats(nullptr, 0);
+
+  OSD::AddMessage(fmt::format("Rewound {:.1f} seconds",
+                              static_cast<double>(ticks - capture.ticks) /
+                                  SystemTimers::GetTicksPerSecond()));
+  return true;
+}
+
+void Init()
+{
+  s_enabled = Config::Get(Config::MAIN_REWIND_ENABLE);
+  s_interval_ticks = u64(SystemTimers::GetTicksPerSecond()) *
+                     std::max(Config::Get(Config::MAIN_REWIND_INTERVAL), 1U) / 1000;
+  s_memory_limit = size_t(Config::Get(Config::MAIN_REWIND_MEMORY_LIMIT)) * 1024 * 1024;
+
+  s_next_serial = 1;
+  s_base_serial = 0;
+  s_force_keyframe = false;
+  s_next_capture_ticks = 0;
+  s_capture_queued = false;
+}
+
+void Shutdown()
+{
+  s_captures.clear();
+  s_captures.shrink_to_fit();
+  s_enabled = false;
+  UpdateStats(nullptr, 0);
+}
+
+void OnNewField()
+{
+  if (!s_enabled || s_capture_queued)
+    return;
+
+  // Loading a savestate can move the emulated time backwards
+  const u64 ticks = Core::System::GetInstance().GetCoreTiming().GetTicks();
+  if (ticks < s_next_capture_ticks && ticks + s_interval_ticks >= s_next_capture_ticks)
+    return;
+
+  // States can't be captured from within a CoreTiming event, so capture at the next point where
+  // the CPU thread can be paused
+  s_capture_queued = true;
+  Core::QueueHostJob([] { Core::RunOnCPUThread(CaptureOnCPUThread, true); });
+}
+
+bool StepBack()
+{
+  if (!s_enabled)
+    return false;
+
+  if (NetPlay::IsNetPlayRunning())
+  {
+    OSD::AddMessage("Rewinding is disabled in Netplay to prevent desyncs");
+    return false;
+  }
+
+  bool result = false;
+  Core::RunOnCPUThread([&] { result = LoadOnCPUThread(); }, true);
+  return result;
+}
+
+Stats GetStats()
+{
+  std::lock_guard lk(s_stats_mutex);
+  return s_stats;
+}
+}  // namespace State::Rewind
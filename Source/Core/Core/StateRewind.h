@@ -0,0 +1,39 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// A ring of savestates kept in memory, captured at a fixed interval of emulated time. All but the
+// keyframes of the ring are delta states, so that rewinding takes a few milliseconds instead of
+// a load from disk.
+
+#pragma once
+
+#include <cstddef>
+
+#include "Common/CommonTypes.h"
+
+namespace State::Rewind
+{
+struct Stats
+{
+  size_t capture_count = 0;
+  size_t keyframe_count = 0;
+  // The size of all captures
+  size_t memory_usage = 0;
+  // How long the last capture took to serialize, and how large it is
+  u64 last_capture_us = 0;
+  size_t last_capture_size = 0;
+  bool last_capture_was_keyframe = false;
+};
+
+void Init();
+void Shutdown();
+
+// Called on the CPU thread for every field, captures a state once the interval has passed
+void OnNewField();
+
+// Loads the latest capture, or the one before it if the latest was loaded just now. Newer
+// captures are dropped.
+bool StepBack();
+
+Stats GetStats();
+}  // namespace State::Rewind
@@ -6,6 +6,7 @@
 #include <algorithm>
 #include <bitset>
 #include <cstddef>
+#include <future>
 #include <map>
 #include <memory>
 #include <optional>
@@ -84,9 +85,23 @@ static bool ImportWAD(IOS::HLE::Kernel& ios, const DiscIO::VolumeWAD& wad,
 
   const bool contents_imported = [&]() {
     const u64 title_id = tmd.GetTitleId();
-    for (const IOS::ES::Content& content : tmd.GetContents())
+    const std::vector<IOS::ES::Content> contents = tmd.GetContents();
+
+    // Read the next content from the WAD while the current one is being decrypted and written
+    std::future<std::vector<u8>> next_data;
+    const auto read_content = [&](size_t i) {
+      next_data = std::async(std::launch::async,
+                             [&wad, index = contents[i].index] { return wad.GetContent(index); });
+    };
+    if (!contents.empty())
+      read_content(0);
+
+    for (size_t i = 0; i < contents.size(); ++i)
     {
-      const std::vector<u8> data = wad.GetContent(content.index);
+      const IOS::ES::Content& content = contents[i];
+      const std::vector<u8> data = next_data.get();
+      if (i + 1 < contents.size())
+        read_content(i + 1);
 
       if (es.ImportContentBegin(context, title_id, content.id) < 0 ||
           es.ImportContentData(context, 0, data.data(), static_cast<u32>(data.size())) < 0 ||
@@ -251,6 +251,12 @@ std::unique_ptr<BlobReader> CreateBlobReader(const std::string& filename)
     if (auto split_blob = SplitPlainFileReader::Create(filename))
       return std::move(split_blob);
 
+    if (GetMapPlainDiscImages())
+    {
+      if (auto mapped_blob = MappedFileReader::Create(filename))
+        return std::move(mapped_blob);
+    }
+
     return PlainFileReader::Create(std::move(file));
   }
 }
@@ -25,6 +25,7 @@
 
 namespace DiscIO
 {
+struct DiscAccessProfile;
 enum class WIARVZCompressionType : u32;
 
 // Increment CACHE_REVISION (GameFileCache.cpp) if the enum below is modified
@@ -202,6 +203,7 @@ bool ConvertToPlain(BlobReader* infile, const std::string& infile_path,
 bool ConvertToWIAOrRVZ(BlobReader* infile, const std::string& infile_path,
                        const std::string& outfile_path, bool rvz,
                        WIARVZCompressionType compression_type, int compression_level,
-                       int chunk_size, CompressCB callback);
+                       int chunk_size, CompressCB callback,
+                       const DiscAccessProfile* access_profile = nullptr);
 
 }  // namespace DiscIO
@@ -64,13 +64,23 @@ bool CISOFileReader::Read(u64 offset, u64 nbytes, u8* out_ptr)
   {
     u64 const block = offset / m_block_size;
     u64 const data_offset = offset % m_block_size;
-    u64 const bytes_to_read = std::min(m_block_size - data_offset, nbytes);
+    u64 bytes_to_read = std::min(m_block_size - data_offset, nbytes);
 
     if (block < CISO_MAP_SIZE && UNUSED_BLOCK_ID != m_ciso_map[block])
     {
       // calculate the base address
       u64 const file_off = CISO_HEADER_SIZE + m_ciso_map[block] * (u64)m_block_size + data_offset;
 
+      // Used blocks are usually stored in order, so extend the read over all the following blocks
+      // that directly follow this one in the file as well, instead of seeking for each of them
+      for (u64 next = block + 1;
+           bytes_to_read < nbytes && next < CISO_MAP_SIZE && UNUSED_BLOCK_ID != m_ciso_map[next] &&
+           m_ciso_map[next] == m_ciso_map[next - 1] + 1;
+           ++next)
+      {
+        bytes_to_read = std::min(bytes_to_read + m_block_size, nbytes);
+      }
+
       if (!(m_file.Seek(file_off, File::SeekOrigin::Begin) &&
             m_file.ReadArray(out_ptr, bytes_to_read)))
       {
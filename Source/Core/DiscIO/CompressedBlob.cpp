@@ -42,6 +42,9 @@ CompressedBlobReader::CompressedBlobReader(File::IOFile file, const std::string&
   m_file.ReadArray(&m_header, 1);
 
   SetSectorSize(m_header.block_size);
+  // Read ahead by decoding several blocks at a time, as reads are usually sequential and the
+  // compressed data of consecutive blocks can then be read from the file in one go
+  SetChunkSize(std::max<int>(1, GCZ_READ_AHEAD_SIZE / std::max<u32>(m_header.block_size, 1)));
 
   // cache block pointers and hashes
   m_block_pointers.resize(m_header.num_blocks);
@@ -94,17 +97,8 @@ u64 CompressedBlobReader::GetBlockCompressedSize(u64 block_num) const
 
 bool CompressedBlobReader::GetBlock(u64 block_num, u8* out_ptr)
 {
-  bool uncompressed = false;
-  u32 comp_block_size = (u32)GetBlockCompressedSize(block_num);
-  u64 offset = m_block_pointers[block_num] + m_data_offset;
-
-  if (offset & (1ULL << 63))
-  {
-    if (comp_block_size != m_header.block_size)
-      ERROR_LOG_FMT(DISCIO, "Uncompressed block with wrong size");
-    uncompressed = true;
-    offset &= ~(1ULL << 63);
-  }
+  const u32 comp_block_size = (u32)GetBlockCompressedSize(block_num);
+  const u64 offset = (m_block_pointers[block_num] & ~GCZ_UNCOMPRESSED_FLAG) + m_data_offset;
 
   // clear unused part of zlib buffer. maybe this can be deleted when it works fully.
   memset(&m_zlib_buffer[comp_block_size], 0, m_zlib_buffer.size() - comp_block_size);
@@ -118,8 +112,53 @@ bool CompressedBlobReader::GetBlock(u64 block_num, u8* out_ptr)
     return false;
   }
 
+  return DecodeBlock(block_num, m_zlib_buffer.data(), comp_block_size, out_ptr);
+}
+
+bool CompressedBlobReader::ReadMultipleAlignedBlocks(u64 block_num, u64 num_blocks, u8* out_ptr)
+{
+  // The compressed blocks are normally stored back to back, which lets us fetch all of them with a
+  // single read. Fall back to reading them one by one if that isn't the case.
+  const u64 first_offset = m_block_pointers[block_num] & ~GCZ_UNCOMPRESSED_FLAG;
+  u64 total_size = 0;
+  for (u64 i = block_num; i < block_num + num_blocks; ++i)
+  {
+    if ((m_block_pointers[i] & ~GCZ_UNCOMPRESSED_FLAG) != first_offset + total_size)
+      return SectorReader::ReadMultipleAlignedBlocks(block_num, num_blocks, out_ptr);
+    total_size += static_cast<u32>(GetBlockCompressedSize(i));
+  }
+
+  m_chunk_buffer.resize(total_size);
+  m_file.Seek(first_offset + m_data_offset, File::SeekOrigin::Begin);
+  if (!m_file.ReadBytes(m_chunk_buffer.data(), total_size))
+  {
+    ERROR_LOG_FMT(DISCIO, "The disc image \"{}\" is truncated, some of the data is missing.",
+                  m_file_name);
+    m_file.ClearError();
+    return false;
+  }
+
+  const u8* compressed = m_chunk_buffer.data();
+  for (u64 i = block_num; i < block_num + num_blocks; ++i)
+  {
+    const u32 comp_block_size = static_cast<u32>(GetBlockCompressedSize(i));
+    if (!DecodeBlock(i, compressed, comp_block_size, out_ptr))
+      return false;
+    compressed += comp_block_size;
+    out_ptr += m_header.block_size;
+  }
+  return true;
+}
+
+bool CompressedBlobReader::DecodeBlock(u64 block_num, const u8* data, u32 comp_block_size,
+                                       u8* out_ptr)
+{
+  const bool uncompressed = (m_block_pointers[block_num] & GCZ_UNCOMPRESSED_FLAG) != 0;
+  if (uncompressed && comp_block_size != m_header.block_size)
+    ERROR_LOG_FMT(DISCIO, "Uncompressed block with wrong size");
+
   // First, check hash.
-  const u32 block_hash = Common::HashAdler32(m_zlib_buffer.data(), comp_block_size);
+  const u32 block_hash = Common::HashAdler32(data, comp_block_size);
   if (block_hash != m_hashes[block_num])
   {
     ERROR_LOG_FMT(DISCIO,
@@ -130,12 +169,12 @@ bool CompressedBlobReader::GetBlock(u64 block_num, u8* out_ptr)
 
   if (uncompressed)
   {
-    std::copy(m_zlib_buffer.begin(), m_zlib_buffer.begin() + comp_block_size, out_ptr);
+    std::copy(data, data + comp_block_size, out_ptr);
   }
   else
   {
     z_stream z = {};
-    z.next_in = m_zlib_buffer.data();
+    z.next_in = const_cast<u8*>(data);
     z.avail_in = comp_block_size;
     if (z.avail_in > m_header.block_size)
     {
@@ -23,6 +23,9 @@
 namespace DiscIO
 {
 static constexpr u32 GCZ_MAGIC = 0xB10BC001;
+static constexpr u64 GCZ_UNCOMPRESSED_FLAG = 1ULL << 63;
+// How much data is decoded when a block that isn't cached is read
+static constexpr u32 GCZ_READ_AHEAD_SIZE = 0x20000;
 
 // GCZ file structure:
 // BlobHeader
@@ -64,9 +67,14 @@ public:
   u64 GetBlockCompressedSize(u64 block_num) const;
   bool GetBlock(u64 block_num, u8* out_ptr) override;
 
+protected:
+  bool ReadMultipleAlignedBlocks(u64 block_num, u64 num_blocks, u8* out_ptr) override;
+
 private:
   CompressedBlobReader(File::IOFile file, const std::string& filename);
 
+  bool DecodeBlock(u64 block_num, const u8* data, u32 comp_block_size, u8* out_ptr);
+
   CompressedBlobHeader m_header;
   std::vector<u64> m_block_pointers;
   std::vector<u32> m_hashes;
@@ -74,6 +82,7 @@ private:
   File::IOFile m_file;
   u64 m_file_size;
   std::vector<u8> m_zlib_buffer;
+  std::vector<u8> m_chunk_buffer;
   std::string m_file_name;
 };
 
@@ -0,0 +1,115 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DiscIO/DiscAccessProfile.h"
+
+#include <algorithm>
+#include <tuple>
+
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+
+namespace DiscIO
+{
+template <typename T>
+static std::optional<T> ReadDiscAccessFile(const std::string& path, u32 magic)
+{
+  using Entry = typename decltype(T::entries)::value_type;
+
+  File::IOFile file(path, "rb");
+  T result;
+  if (!file.IsOpen() || !file.ReadArray(&result.header, 1))
+  {
+    ERROR_LOG_FMT(DISCIO, "Failed to read {}", path);
+    return std::nullopt;
+  }
+
+  if (result.header.magic != magic || result.header.version != DISC_ACCESS_FORMAT_VERSION)
+  {
+    ERROR_LOG_FMT(DISCIO, "{} is not a supported disc access file", path);
+    return std::nullopt;
+  }
+
+  const u64 expected_size =
+      sizeof(DiscAccessHeader) + u64(result.header.entry_count) * sizeof(Entry);
+  if (file.GetSize() < expected_size)
+  {
+    ERROR_LOG_FMT(DISCIO, "{} is truncated", path);
+    return std::nullopt;
+  }
+
+  result.entries.resize(result.header.entry_count);
+  if (!file.ReadArray(result.entries.data(), result.entries.size()))
+  {
+    ERROR_LOG_FMT(DISCIO, "Failed to read {}", path);
+    return std::nullopt;
+  }
+
+  return result;
+}
+
+std::optional<DiscAccessTrace> ReadDiscAccessTrace(const std::string& path)
+{
+  return ReadDiscAccessFile<DiscAccessTrace>(path, DISC_ACCESS_TRACE_MAGIC);
+}
+
+std::optional<DiscAccessProfile> ReadDiscAccessProfile(const std::string& path)
+{
+  return ReadDiscAccessFile<DiscAccessProfile>(path, DISC_ACCESS_PROFILE_MAGIC);
+}
+
+bool WriteDiscAccessProfile(const std::string& path, const DiscAccessProfile& profile)
+{
+  DiscAccessHeader header = profile.header;
+  header.magic = DISC_ACCESS_PROFILE_MAGIC;
+  header.version = DISC_ACCESS_FORMAT_VERSION;
+  header.entry_count = static_cast<u32>(profile.entries.size());
+
+  File::IOFile file(path, "wb");
+  if (!file.IsOpen() || !file.WriteArray(&header, 1) ||
+      !file.WriteArray(profile.entries.data(), profile.entries.size()))
+  {
+    ERROR_LOG_FMT(DISCIO, "Failed to write {}", path);
+    return false;
+  }
+
+  return true;
+}
+
+std::vector<HotExtent> BuildHotExtents(std::span<const DiscAccessRecord> records,
+                                       u64 merge_distance)
+{
+  std::vector<DiscAccessRecord> sorted(records.begin(), records.end());
+  std::sort(sorted.begin(), sorted.end(), [](const DiscAccessRecord& a, const DiscAccessRecord& b) {
+    return std::tie(a.partition, a.offset) < std::tie(b.partition, b.offset);
+  });
+
+  std::vector<HotExtent> extents;
+  for (const DiscAccessRecord& record : sorted)
+  {
+    if (record.length == 0)
+      continue;
+
+    const u64 end = record.offset + record.length;
+    if (!extents.empty())
+    {
+      HotExtent& last = extents.back();
+      if (last.partition == record.partition && record.offset <= last.end + merge_distance)
+      {
+        last.end = std::max(last.end, end);
+        last.first_access_ticks = std::min(last.first_access_ticks, record.ticks);
+        ++last.access_count;
+        continue;
+      }
+    }
+
+    extents.push_back({record.partition, record.offset, end, record.ticks, 1, record.file_index});
+  }
+
+  std::stable_sort(extents.begin(), extents.end(), [](const HotExtent& a, const HotExtent& b) {
+    return a.first_access_ticks < b.first_access_ticks;
+  });
+
+  return extents;
+}
+}  // namespace DiscIO
@@ -0,0 +1,90 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+namespace DiscIO
+{
+// Disc access traces (.dtrc) are written by the DVD thread while Core.RecordDiscAccess is set.
+// They hold one record per DVD read, in the order the reads were issued.
+//
+// Disc access profiles (.dprf) are built from one or more traces by "dolphin-tool profile".
+// They hold the disc extents a game touched, merged and sorted by first access.
+//
+// Both are stored in host byte order, a file with the wrong byte order is rejected by its magic.
+constexpr u32 DISC_ACCESS_TRACE_MAGIC = 0x43525444;    // "DTRC"
+constexpr u32 DISC_ACCESS_PROFILE_MAGIC = 0x46525044;  // "DPRF"
+constexpr u32 DISC_ACCESS_FORMAT_VERSION = 1;
+
+// Stored as the file index of reads that aren't inside any file
+constexpr u32 DISC_ACCESS_NO_FILE = 0xFFFFFFFF;
+
+#pragma pack(push, 1)
+struct DiscAccessHeader
+{
+  u32 magic;
+  u32 version;
+  // Not null-terminated if all six characters are used
+  char game_id[6];
+  u16 revision;
+  u8 disc_number;
+  u8 padding[7];
+  // Ticks are CoreTiming ticks of the emulated CPU
+  u32 ticks_per_second;
+  u32 entry_count;
+};
+static_assert(sizeof(DiscAccessHeader) == 0x20, "Wrong size for disc access header");
+
+struct DiscAccessRecord
+{
+  u64 ticks;
+  // Offset of the partition, or PARTITION_NONE.offset for discs without partitions
+  u64 partition;
+  u64 offset;
+  u32 length;
+  // Index of the file in the partition's FST
+  u32 file_index;
+};
+static_assert(sizeof(DiscAccessRecord) == 0x20, "Wrong size for disc access record");
+
+struct HotExtent
+{
+  u64 partition;
+  // Offsets inside the partition, end is exclusive
+  u64 start;
+  u64 end;
+  u64 first_access_ticks;
+  u32 access_count;
+  u32 file_index;
+};
+static_assert(sizeof(HotExtent) == 0x28, "Wrong size for hot extent");
+#pragma pack(pop)
+
+struct DiscAccessTrace
+{
+  DiscAccessHeader header;
+  std::vector<DiscAccessRecord> entries;
+};
+
+struct DiscAccessProfile
+{
+  DiscAccessHeader header;
+  std::vector<HotExtent> entries;
+};
+
+std::optional<DiscAccessTrace> ReadDiscAccessTrace(const std::string& path);
+std::optional<DiscAccessProfile> ReadDiscAccessProfile(const std::string& path);
+bool WriteDiscAccessProfile(const std::string& path, const DiscAccessProfile& profile);
+
+// Merges the reads of each partition into extents, joining reads that overlap or are less than
+// merge_distance bytes apart, and sorts the extents by the time they were first read.
+std::vector<HotExtent> BuildHotExtents(std::span<const DiscAccessRecord> records,
+                                       u64 merge_distance);
+}  // namespace DiscIO
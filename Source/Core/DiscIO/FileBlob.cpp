@@ -4,6 +4,8 @@
 #include "DiscIO/FileBlob.h"
 
 #include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <memory>
 #include <string>
 #include <utility>
@@ -12,6 +14,7 @@
 #include "Common/Assert.h"
 #include "Common/FileUtil.h"
 #include "Common/MsgHandler.h"
+#include "DiscIO/FileReadQueue.h"
 
 namespace DiscIO
 {
@@ -35,15 +38,59 @@ std::unique_ptr<BlobReader> PlainFileReader::CopyReader() const
 
 bool PlainFileReader::Read(u64 offset, u64 nbytes, u8* out_ptr)
 {
-  if (m_file.Seek(offset, File::SeekOrigin::Begin) && m_file.ReadBytes(out_ptr, nbytes))
-  {
-    return true;
-  }
-  else
-  {
-    m_file.ClearError();
+  const FileReadRequest request{&m_file, offset, nbytes, out_ptr};
+  return ReadFiles({&request, 1});
+}
+
+static std::atomic<bool> s_map_plain_disc_images = false;
+
+void SetMapPlainDiscImages(bool enable)
+{
+  s_map_plain_disc_images = enable;
+}
+
+bool GetMapPlainDiscImages()
+{
+  return s_map_plain_disc_images;
+}
+
+MappedFileReader::MappedFileReader(File::MappedFile file, std::string path)
+    : m_file(std::move(file)), m_path(std::move(path))
+{
+}
+
+std::unique_ptr<MappedFileReader> MappedFileReader::Create(const std::string& path)
+{
+  File::MappedFile file(path);
+  if (file.IsOpen())
+    return std::unique_ptr<MappedFileReader>(new MappedFileReader(std::move(file), path));
+
+  return nullptr;
+}
+
+std::unique_ptr<BlobReader> MappedFileReader::CopyReader() const
+{
+  // The copy has its own mapping, but both are backed by the same pages of the page cache
+  return Create(m_path);
+}
+
+bool MappedFileReader::Read(u64 offset, u64 nbytes, u8* out_ptr)
+{
+  const u64 size = m_file.GetSize();
+  if (offset > size || nbytes > size - offset)
     return false;
+
+  const u64 end = offset + nbytes;
+  if (offset == m_stream_end && end + PREFETCH_SIZE / 2 > m_prefetched_end)
+  {
+    const u64 prefetch_start = std::max(end, m_prefetched_end);
+    m_prefetched_end = end + PREFETCH_SIZE;
+    m_file.Prefetch(prefetch_start, m_prefetched_end - prefetch_start);
   }
+  m_stream_end = end;
+
+  std::memcpy(out_ptr, m_file.GetData() + offset, nbytes);
+  return true;
 }
 
 bool ConvertToPlain(BlobReader* infile, const std::string& infile_path,
@@ -0,0 +1,165 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DiscIO/FileReadQueue.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Common/Thread.h"
+
+namespace DiscIO
+{
+namespace
+{
+struct ReadBatch
+{
+  std::mutex mutex;
+  std::condition_variable done;
+  size_t remaining = 0;
+  bool failed = false;
+};
+
+struct ReadPiece
+{
+  FileReadRequest request;
+  ReadBatch* batch;
+};
+
+std::atomic<u32> s_outstanding = 0;
+std::atomic<u32> s_peak_outstanding = 0;
+std::atomic<u64> s_reads = 0;
+
+bool DoRead(const FileReadRequest& request)
+{
+  const u32 outstanding = ++s_outstanding;
+  u32 peak = s_peak_outstanding.load(std::memory_order_relaxed);
+  while (outstanding > peak && !s_peak_outstanding.compare_exchange_weak(peak, outstanding))
+  {
+  }
+
+  const bool success = request.file->ReadAt(request.out_ptr, request.size, request.offset);
+
+  --s_outstanding;
+  ++s_reads;
+  return success;
+}
+
+// The calling thread reads one piece itself, so the pool has one thread less than the depth
+class FileReadPool
+{
+public:
+  FileReadPool()
+  {
+    for (u32 i = 0; i < FILE_READ_QUEUE_DEPTH - 1; ++i)
+      m_threads.emplace_back(&FileReadPool::ThreadLoop, this);
+  }
+
+  ~FileReadPool()
+  {
+    {
+      std::lock_guard lk(m_mutex);
+      m_shutdown = true;
+    }
+    m_wakeup.notify_all();
+    for (std::thread& thread : m_threads)
+      thread.join();
+  }
+
+  FileReadPool(const FileReadPool&) = delete;
+  FileReadPool& operator=(const FileReadPool&) = delete;
+
+  void Push(std::span<const ReadPiece> pieces)
+  {
+    {
+      std::lock_guard lk(m_mutex);
+      m_pieces.insert(m_pieces.end(), pieces.begin(), pieces.end());
+    }
+    m_wakeup.notify_all();
+  }
+
+private:
+  void ThreadLoop()
+  {
+    Common::SetCurrentThreadName("File read");
+
+    std::unique_lock lk(m_mutex);
+    while (true)
+    {
+      m_wakeup.wait(lk, [this] { return m_shutdown || !m_pieces.empty(); });
+      if (m_shutdown)
+        return;
+
+      const ReadPiece piece = m_pieces.front();
+      m_pieces.pop_front();
+      lk.unlock();
+
+      const bool success = DoRead(piece.request);
+      {
+        // Notified with the lock held, since the batch is gone as soon as the reader sees 0
+        std::lock_guard batch_lk(piece.batch->mutex);
+        piece.batch->failed |= !success;
+        if (--piece.batch->remaining == 0)
+          piece.batch->done.notify_one();
+      }
+
+      lk.lock();
+    }
+  }
+
+  std::vector<std::thread> m_threads;
+  std::mutex m_mutex;
+  std::condition_variable m_wakeup;
+  std::deque<ReadPiece> m_pieces;
+  bool m_shutdown = false;
+};
+}  // namespace
+
+bool ReadFiles(std::span<const FileReadRequest> requests)
+{
+  ReadBatch batch;
+  std::vector<ReadPiece> pieces;
+  for (const FileReadRequest& request : requests)
+  {
+    const u64 piece_size = std::max(
+        FILE_READ_PIECE_SIZE, (request.size + FILE_READ_QUEUE_DEPTH - 1) / FILE_READ_QUEUE_DEPTH);
+    for (u64 i = 0; i < request.size; i += piece_size)
+    {
+      const u64 size = std::min(piece_size, request.size - i);
+      pieces.push_back({{request.file, request.offset + i, size, request.out_ptr + i}, &batch});
+    }
+  }
+
+  if (pieces.empty())
+    return true;
+
+  if (pieces.size() > 1)
+  {
+    static FileReadPool s_pool;
+    batch.remaining = pieces.size() - 1;
+    s_pool.Push(std::span(pieces).subspan(1));
+  }
+
+  const bool success = DoRead(pieces.front().request);
+
+  std::unique_lock lk(batch.mutex);
+  batch.done.wait(lk, [&batch] { return batch.remaining == 0; });
+  return success && !batch.failed;
+}
+
+FileReadStats GetFileReadStats()
+{
+  return {s_outstanding, s_peak_outstanding, s_reads};
+}
+
+void ResetFileReadStats()
+{
+  s_peak_outstanding = s_outstanding.load();
+  s_reads = 0;
+}
+}  // namespace DiscIO
@@ -0,0 +1,43 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <span>
+
+#include "Common/CommonTypes.h"
+#include "Common/IOFile.h"
+
+namespace DiscIO
+{
+// Reads from plain image files are split into pieces that are read at the same time by a small
+// pool of I/O threads, so that a large read from slow storage (like a NAS) has several requests
+// in flight instead of waiting for one blocking read after another. The reads are positional,
+// so the DVD thread and the read-ahead worker can read from the same file without seeking.
+constexpr u32 FILE_READ_QUEUE_DEPTH = 4;
+// Reads that aren't larger than this are done directly on the calling thread
+constexpr u64 FILE_READ_PIECE_SIZE = 0x40000;
+
+struct FileReadRequest
+{
+  const File::IOFile* file;
+  u64 offset;
+  u64 size;
+  u8* out_ptr;
+};
+
+struct FileReadStats
+{
+  // Number of reads currently waiting for the OS
+  u32 outstanding;
+  // Highest value of outstanding since the last ResetFileReadStats
+  u32 peak_outstanding;
+  u64 reads;
+};
+
+// Returns once all requests have been read. Returns false if any of them failed.
+bool ReadFiles(std::span<const FileReadRequest> requests);
+
+FileReadStats GetFileReadStats();
+void ResetFileReadStats();
+}  // namespace DiscIO
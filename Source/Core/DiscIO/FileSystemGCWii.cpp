@@ -6,8 +6,8 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstring>
+#include <future>
 #include <locale>
-#include <map>
 #include <memory>
 #include <optional>
 #include <string>
@@ -183,6 +183,11 @@ std::string FileInfoGCWii::GetPath() const
   }
 }
 
+u32 FileInfoGCWii::GetIndex() const
+{
+  return m_index;
+}
+
 bool FileInfoGCWii::IsValid(u64 fst_size, const FileInfoGCWii& parent_directory) const
 {
   if (GetNameOffset() >= fst_size)
@@ -287,6 +292,13 @@ FileSystemGCWii::FileSystemGCWii(const VolumeDisc* volume, const Partition& part
   }
 
   m_valid = m_root.IsValid(*fst_size, m_root);
+  if (m_valid)
+  {
+    m_indexes_ready = std::async(std::launch::async, [this] {
+                        BuildOffsetIndex();
+                        BuildPathIndex();
+                      }).share();
+  }
 }
 
 FileSystemGCWii::~FileSystemGCWii() = default;
@@ -296,79 +308,165 @@ const FileInfo& FileSystemGCWii::GetRoot() const
   return m_root;
 }
 
+// Drops empty path components and lowercases ASCII characters. We need case insensitive
+// comparison since some games have OPENING.BNR instead of opening.bnr
+static std::string NormalizePath(std::string_view path)
+{
+  std::string result;
+  result.reserve(path.size());
+
+  size_t name_start = path.find_first_not_of('/');
+  while (name_start != std::string_view::npos)
+  {
+    const size_t name_end = path.find('/', name_start);
+    const std::string_view name = path.substr(name_start, name_end - name_start);
+
+    if (!result.empty())
+      result.push_back('/');
+    for (const char c : name)
+      result.push_back(Common::ToLower(c));
+
+    name_start = path.find_first_not_of('/', name_end);
+  }
+
+  return result;
+}
+
 std::unique_ptr<FileInfo> FileSystemGCWii::FindFileInfo(std::string_view path) const
 {
   if (!IsValid())
     return nullptr;
 
-  return FindFileInfo(path, m_root);
+  m_indexes_ready.wait();
+
+  const auto it = m_path_index.find(NormalizePath(path));
+  if (it == m_path_index.end())
+    return nullptr;
+
+  if (it->second == 0)
+    return m_root.clone();
+  return std::make_unique<FileInfoGCWii>(m_root, it->second);
+}
+
+std::string_view FileSystemGCWii::GetPath(u32 index) const
+{
+  if (!IsValid())
+    return {};
+
+  m_indexes_ready.wait();
+
+  return index < m_paths.size() ? m_paths[index] : std::string_view{};
+}
+
+std::unique_ptr<FileInfo> FileSystemGCWii::FindFileInfo(u64 disc_offset) const
+{
+  const std::optional<FileLocation> location = FindFileLocation(disc_offset);
+  if (!location)
+    return nullptr;
+
+  return std::make_unique<FileInfoGCWii>(m_root, location->index);
 }
 
-std::unique_ptr<FileInfo> FileSystemGCWii::FindFileInfo(std::string_view path,
-                                                        const FileInfo& file_info) const
+std::optional<FileLocation> FileSystemGCWii::FindFileLocation(u64 disc_offset) const
 {
-  // Given a path like "directory1/directory2/fileA.bin", this function will
-  // find directory1 and then call itself to search for "directory2/fileA.bin".
+  if (!IsValid())
+    return std::nullopt;
 
-  const size_t name_start = path.find_first_not_of('/');
-  if (name_start == std::string::npos)
-    return file_info.clone();  // We're done
+  m_indexes_ready.wait();
 
-  const size_t name_end = path.find('/', name_start);
-  const std::string_view name = path.substr(name_start, name_end - name_start);
-  const std::string_view rest_of_path =
-      (name_end != std::string::npos) ? path.substr(name_end + 1) : "";
+  // Get the first file that ends after disc_offset
+  const auto it = std::upper_bound(m_offset_index.begin(), m_offset_index.end(), disc_offset,
+                                   [](u64 offset, const FileLocation& location) {
+                                     return offset < location.offset + location.size;
+                                   });
+  if (it == m_offset_index.end())
+    return std::nullopt;
 
-  for (const FileInfo& child : file_info)
+  // If the file's start isn't after disc_offset, success
+  if (it->offset <= disc_offset)
+    return *it;
+
+  return std::nullopt;
+}
+
+void FileSystemGCWii::BuildOffsetIndex()
+{
+  const u32 fst_entries = m_root.GetSize();
+  for (u32 i = 0; i < fst_entries; i++)
   {
-    // We need case insensitive comparison since some games have OPENING.BNR instead of opening.bnr
-    if (child.NameCaseInsensitiveEquals(name))
+    FileInfoGCWii file_info(m_root, i);
+    if (!file_info.IsDirectory())
     {
-      // A match is found. The rest of the path is passed on to finish the search.
-      std::unique_ptr<FileInfo> result = FindFileInfo(rest_of_path, child);
-
-      // If the search wasn't successful, the loop continues, just in case there's a second
-      // file info that matches searching_for (which probably won't happen in practice)
-      if (result)
-        return result;
+      const u32 size = file_info.GetSize();
+      if (size != 0)
+        m_offset_index.push_back({file_info.GetOffset(), size, i});
     }
   }
 
-  return nullptr;
+  const auto end_offset = [](const FileLocation& location) {
+    return location.offset + location.size;
+  };
+
+  // Of several files with the same end, the one with the lowest FST index is kept
+  std::stable_sort(m_offset_index.begin(), m_offset_index.end(),
+                   [&](const FileLocation& a, const FileLocation& b) {
+                     return end_offset(a) < end_offset(b);
+                   });
+  m_offset_index.erase(std::unique(m_offset_index.begin(), m_offset_index.end(),
+                                   [&](const FileLocation& a, const FileLocation& b) {
+                                     return end_offset(a) == end_offset(b);
+                                   }),
+                       m_offset_index.end());
+  m_offset_index.shrink_to_fit();
 }
 
-std::unique_ptr<FileInfo> FileSystemGCWii::FindFileInfo(u64 disc_offset) const
+void FileSystemGCWii::BuildPathIndex()
 {
-  if (!IsValid())
-    return nullptr;
-
-  // Build a cache (unless there already is one)
-  if (m_offset_file_info_cache.empty())
+  struct Directory
   {
-    u32 fst_entries = m_root.GetSize();
-    for (u32 i = 0; i < fst_entries; i++)
+    // FST index of the first entry that isn't in the directory
+    u32 end;
+    size_t path_start;
+    size_t path_size;
+  };
+
+  const u32 fst_entries = m_root.GetSize();
+  std::vector<std::pair<size_t, size_t>> path_ranges(fst_entries);
+  std::vector<Directory> directories{{fst_entries, 0, 0}};
+
+  // Entries come in depth-first order, so the parent of each entry is the innermost directory
+  // that hasn't ended yet
+  for (u32 i = 1; i < fst_entries; i++)
+  {
+    while (directories.back().end <= i)
+      directories.pop_back();
+    const Directory& parent = directories.back();
+
+    const FileInfoGCWii file_info(m_root, i);
+    const size_t path_start = m_path_arena.size();
+    m_path_arena.append(m_path_arena, parent.path_start, parent.path_size);
+    m_path_arena.append(file_info.GetName());
+    if (file_info.IsDirectory())
     {
-      FileInfoGCWii file_info(m_root, i);
-      if (!file_info.IsDirectory())
-      {
-        const u32 size = file_info.GetSize();
-        if (size != 0)
-          m_offset_file_info_cache.emplace(file_info.GetOffset() + size, i);
-      }
+      m_path_arena.push_back('/');
+      directories.push_back({i + 1 + file_info.GetTotalChildren(), path_start,
+                             m_path_arena.size() - path_start});
     }
-  }
 
-  // Get the first file that ends after disc_offset
-  const auto it = m_offset_file_info_cache.upper_bound(disc_offset);
-  if (it == m_offset_file_info_cache.end())
-    return nullptr;
-  std::unique_ptr<FileInfo> result(std::make_unique<FileInfoGCWii>(m_root, it->second));
+    path_ranges[i] = {path_start, m_path_arena.size() - path_start};
+  }
 
-  // If the file's start isn't after disc_offset, success
-  if (result->GetOffset() <= disc_offset)
-    return result;
+  // Views are only created once the arena has stopped growing
+  m_paths.reserve(fst_entries);
+  m_path_index.reserve(fst_entries);
+  const std::string_view arena = m_path_arena;
+  for (u32 i = 0; i < fst_entries; i++)
+  {
+    const std::string_view path = arena.substr(path_ranges[i].first, path_ranges[i].second);
+    m_paths.push_back(path);
 
-  return nullptr;
+    // The first of several entries with the same path wins, like a search of the tree would
+    m_path_index.emplace(NormalizePath(path), i);
+  }
 }
-
 }  // namespace DiscIO
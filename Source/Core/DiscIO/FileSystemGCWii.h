@@ -4,11 +4,12 @@
 #pragma once
 
 #include <cstddef>
-#include <map>
+#include <future>
 #include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <unordered_map>
 #include <vector>
 
 #include "Common/CommonTypes.h"
@@ -47,6 +48,7 @@ public:
   std::string GetName() const override;
   bool NameCaseInsensitiveEquals(std::string_view other) const override;
   std::string GetPath() const override;
+  u32 GetIndex() const override;
 
   bool IsValid(u64 fst_size, const FileInfoGCWii& parent_directory) const;
 
@@ -90,19 +92,35 @@ public:
   FileSystemGCWii(const VolumeDisc* volume, const Partition& partition);
   ~FileSystemGCWii() override;
 
+  // The offset index is built by a task that refers to this object
+  FileSystemGCWii(const FileSystemGCWii&) = delete;
+  FileSystemGCWii& operator=(const FileSystemGCWii&) = delete;
+
   bool IsValid() const override { return m_valid; }
   const FileInfo& GetRoot() const override;
   std::unique_ptr<FileInfo> FindFileInfo(std::string_view path) const override;
   std::unique_ptr<FileInfo> FindFileInfo(u64 disc_offset) const override;
+  std::optional<FileLocation> FindFileLocation(u64 disc_offset) const override;
+  std::string_view GetPath(u32 index) const override;
 
 private:
   bool m_valid;
   std::vector<u8> m_file_system_table;
   FileInfoGCWii m_root;
-  // Maps the end offset of files to FST indexes
-  mutable std::map<u64, u32> m_offset_file_info_cache;
-
-  std::unique_ptr<FileInfo> FindFileInfo(std::string_view path, const FileInfo& file_info) const;
+  // The indexes below are built on a background thread as soon as the file system has been
+  // read, so that the first lookup doesn't have to walk the whole FST.
+  // All non-empty files sorted by end offset, for FindFileLocation
+  std::vector<FileLocation> m_offset_index;
+  // The path of every entry, by FST index. The views point into m_path_arena.
+  std::string m_path_arena;
+  std::vector<std::string_view> m_paths;
+  // Maps paths normalized by NormalizePath to FST indexes, for FindFileInfo
+  std::unordered_map<std::string, u32> m_path_index;
+  // Must stay the last member, so that the task ends before anything it uses goes away
+  std::shared_future<void> m_indexes_ready;
+
+  void BuildOffsetIndex();
+  void BuildPathIndex();
 };
 
 }  // namespace DiscIO
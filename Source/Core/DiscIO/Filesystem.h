@@ -15,6 +15,17 @@
 
 namespace DiscIO
 {
+// Where a file is on the disc. Unlike FileInfo, this is a plain value, so looking one up with
+// FileSystem::FindFileLocation doesn't allocate.
+struct FileLocation
+{
+  // Inside the partition, if there is one
+  u64 offset;
+  u32 size;
+  // The position of the file's entry in the file system table
+  u32 index;
+};
+
 // file info of an FST entry
 class FileInfo
 {
@@ -99,6 +110,8 @@ public:
   // so it's slower than other functions. If you're traversing through folders
   // to get a file and its path, building the path while traversing is faster.
   virtual std::string GetPath() const = 0;
+  // The position of this entry in the file system table
+  virtual u32 GetIndex() const = 0;
 
 protected:
   // Only used for comparisons with other file info objects
@@ -122,6 +135,12 @@ public:
   virtual std::unique_ptr<FileInfo> FindFileInfo(std::string_view path) const = 0;
   // Returns nullptr if not found
   virtual std::unique_ptr<FileInfo> FindFileInfo(u64 disc_offset) const = 0;
+  // Returns std::nullopt if not found. Cheaper than FindFileInfo if only the location is needed.
+  virtual std::optional<FileLocation> FindFileLocation(u64 disc_offset) const = 0;
+  // Returns the same path as FileInfo::GetPath for the entry with the given FST index, or an
+  // empty string if there is no such entry. Doesn't allocate, the returned view stays valid for
+  // as long as the file system object.
+  virtual std::string_view GetPath(u32 index) const = 0;
 };
 
 // Calling Volume::GetFileSystem instead of manually constructing a filesystem is recommended,
@@ -51,12 +51,23 @@ size_t LaggedFibonacciGenerator::GetSeed(const u8* data, size_t size, size_t dat
 
   lfg.m_position_bytes = data_offset % (LFG_K * sizeof(u32));
 
+  // Compare the data against the generator's buffer a whole buffer at a time rather than going
+  // through GetByte, since junk data usually goes on for a long time
   const u8* end = data + size;
   size_t reconstructed_bytes = 0;
-  while (data < end && lfg.GetByte() == *data)
+  while (data < end)
   {
-    ++reconstructed_bytes;
-    ++data;
+    const size_t length = std::min(static_cast<size_t>(end - data),
+                                   LFG_K * sizeof(u32) - lfg.m_position_bytes);
+    const u8* generated = reinterpret_cast<const u8*>(lfg.m_buffer.data()) + lfg.m_position_bytes;
+    const size_t matching = std::mismatch(data, data + length, generated).first - data;
+
+    reconstructed_bytes += matching;
+    if (matching != length)
+      break;
+
+    lfg.Forward(length);
+    data += length;
   }
   return reconstructed_bytes;
 }
@@ -145,8 +156,14 @@ void LaggedFibonacciGenerator::Forward()
   for (size_t i = 0; i < LFG_J; ++i)
     m_buffer[i] ^= m_buffer[i + LFG_K - LFG_J];
 
-  for (size_t i = LFG_J; i < LFG_K; ++i)
-    m_buffer[i] ^= m_buffer[i - LFG_J];
+  // Each word only depends on the word LFG_J words before it, so process LFG_J words at a time.
+  // There are no dependencies within such a batch, which lets the compiler vectorize it.
+  for (size_t i = LFG_J; i < LFG_K; i += LFG_J)
+  {
+    const size_t batch_end = std::min(i + LFG_J, LFG_K);
+    for (size_t j = i; j < batch_end; ++j)
+      m_buffer[j] ^= m_buffer[j - LFG_J];
+  }
 }
 
 void LaggedFibonacciGenerator::Backward(size_t start_word, size_t end_word)
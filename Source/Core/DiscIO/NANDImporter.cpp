@@ -5,6 +5,7 @@
 
 #include <algorithm>
 #include <cstring>
+#include <utility>
 
 #include "Common/Crypto/AES.h"
 #include "Common/FileUtil.h"
@@ -35,7 +36,16 @@ void NANDImporter::ImportNANDBin(const std::string& path_to_bin,
     return;
 
   ExportKeys();
+
+  // The files are written by a separate thread while the next ones are decrypted
+  m_file_writer.Reset("NAND Importer Writer", [](std::pair<std::string, std::vector<u8>> file) {
+    File::IOFile host_file(file.first, "wb");
+    if (!host_file.WriteBytes(file.second.data(), file.second.size()))
+      ERROR_LOG_FMT(DISCIO, "Failed to write {}", file.first);
+  });
   ProcessEntry(0, "");
+  m_file_writer.Shutdown();
+
   ExtractCertificates();
 }
 
@@ -58,17 +68,24 @@ bool NANDImporter::ReadNANDBin(const std::string& path_to_bin,
 
   m_nand.resize(NAND_SIZE);
 
-  for (size_t i = 0; i < NAND_TOTAL_BLOCKS; i++)
+  // Read many blocks at once instead of seeking past every ECC block on its own
+  constexpr size_t BLOCKS_PER_READ = 0x400;
+  static_assert(NAND_TOTAL_BLOCKS % BLOCKS_PER_READ == 0);
+  std::vector<u8> blocks(BLOCKS_PER_READ * (NAND_BLOCK_SIZE + NAND_ECC_BLOCK_SIZE));
+
+  for (size_t i = 0; i < NAND_TOTAL_BLOCKS; i += BLOCKS_PER_READ)
   {
-    // Instead of updating on every cycle, we only update every 1000 cycles for a balance between
-    // not updating fast enough vs updating too fast
-    if (i % 1000 == 0)
-      m_update_callback();
+    // Updating once per read is a balance between not updating fast enough vs updating too fast
+    m_update_callback();
 
-    file.ReadBytes(&m_nand[i * NAND_BLOCK_SIZE], NAND_BLOCK_SIZE);
+    file.ReadBytes(blocks.data(), blocks.size());
 
     // We don't care about the ECC blocks
-    file.Seek(NAND_ECC_BLOCK_SIZE, File::SeekOrigin::Current);
+    for (size_t j = 0; j < BLOCKS_PER_READ; ++j)
+    {
+      std::memcpy(&m_nand[(i + j) * NAND_BLOCK_SIZE],
+                  &blocks[j * (NAND_BLOCK_SIZE + NAND_ECC_BLOCK_SIZE)], NAND_BLOCK_SIZE);
+    }
   }
 
   m_nand_keys.resize(NAND_KEYS_SIZE);
@@ -150,9 +167,7 @@ void NANDImporter::ProcessEntry(u16 entry_number, const std::string& parent_path
     Type type = static_cast<Type>(entry.mode & 3);
     if (type == Type::File)
     {
-      std::vector<u8> data = GetEntryData(entry);
-      File::IOFile file(m_nand_root + path, "wb");
-      file.WriteBytes(data.data(), data.size());
+      m_file_writer.EmplaceItem(m_nand_root + path, GetEntryData(entry));
     }
     else if (type == Type::Directory)
     {
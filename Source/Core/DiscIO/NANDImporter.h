@@ -7,6 +7,7 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <fmt/format.h>
@@ -14,6 +15,7 @@
 #include "Common/CommonTypes.h"
 #include "Common/Crypto/AES.h"
 #include "Common/Swap.h"
+#include "Common/WorkQueueThread.h"
 
 namespace DiscIO
 {
@@ -78,6 +80,8 @@ private:
   std::unique_ptr<Common::AES::Context> m_aes_ctx;
   std::unique_ptr<NANDSuperblock> m_superblock;
   std::function<void()> m_update_callback;
+  // Writes extracted files to the NAND root, as path and contents
+  Common::WorkQueueThread<std::pair<std::string, std::vector<u8>>> m_file_writer;
 };
 }  // namespace DiscIO
 
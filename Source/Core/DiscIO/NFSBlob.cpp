@@ -251,15 +251,14 @@ bool NFSFileReader::ReadEncryptedBlock(u64 physical_block_index)
   return true;
 }
 
-void NFSFileReader::DecryptBlock(u64 logical_block_index)
+void NFSFileReader::DecryptBlock(u64 logical_block_index, const u8* in, u8* out)
 {
   std::array<u8, 16> iv{};
   const u64 swapped_block_index = Common::swap64(logical_block_index);
   std::memcpy(iv.data() + iv.size() - sizeof(swapped_block_index), &swapped_block_index,
               sizeof(swapped_block_index));
 
-  m_aes_context->Crypt(iv.data(), m_current_block_encrypted.data(),
-                       m_current_block_decrypted.data(), BLOCK_SIZE);
+  m_aes_context->Crypt(iv.data(), in, out, BLOCK_SIZE);
 }
 
 bool NFSFileReader::ReadAndDecryptBlock(u64 logical_block_index)
@@ -276,7 +275,8 @@ bool NFSFileReader::ReadAndDecryptBlock(u64 logical_block_index)
     if (!ReadEncryptedBlock(physical_block_index))
       return false;
 
-    DecryptBlock(logical_block_index);
+    DecryptBlock(logical_block_index, m_current_block_encrypted.data(),
+                 m_current_block_decrypted.data());
   }
 
   // Small hack: Set 0x61 of the header to 1 so that VolumeWii realizes that the disc is unencrypted
@@ -286,6 +286,56 @@ bool NFSFileReader::ReadAndDecryptBlock(u64 logical_block_index)
   return true;
 }
 
+u64 NFSFileReader::ReadAndDecryptBlocks(u64 logical_block_index, u64 max_blocks, u8* out_ptr)
+{
+  constexpr u64 BLOCKS_PER_FILE = MAX_FILE_SIZE / BLOCK_SIZE;
+
+  // Find out how many of the blocks are stored back to back in the same file. The last block of
+  // each file is split across two files, so leave it to ReadEncryptedBlock.
+  u64 physical_block_index = 0;
+  u64 num_blocks = 0;
+  for (const NFSLBARange& range : m_lba_ranges)
+  {
+    if (logical_block_index >= range.start_block &&
+        logical_block_index < range.start_block + range.num_blocks)
+    {
+      physical_block_index += logical_block_index - range.start_block;
+      num_blocks = range.start_block + range.num_blocks - logical_block_index;
+      break;
+    }
+
+    physical_block_index += range.num_blocks;
+  }
+
+  const u64 file_index = physical_block_index / BLOCKS_PER_FILE;
+  const u64 block_in_file = physical_block_index % BLOCKS_PER_FILE;
+  num_blocks = std::min({num_blocks, max_blocks, BLOCKS_PER_FILE - 1 - block_in_file,
+                         u64(MAX_BATCH_BLOCKS)});
+  if (num_blocks < 2)
+    return 0;
+
+  m_batch_encrypted.resize(num_blocks * BLOCK_SIZE);
+  File::IOFile& file = m_files[file_index];
+  if (!file.Seek(sizeof(NFSHeader) + block_in_file * BLOCK_SIZE, File::SeekOrigin::Begin) ||
+      !file.ReadBytes(m_batch_encrypted.data(), m_batch_encrypted.size()))
+  {
+    file.ClearError();
+    return 0;
+  }
+
+  for (u64 i = 0; i < num_blocks; ++i)
+  {
+    DecryptBlock(logical_block_index + i, m_batch_encrypted.data() + i * BLOCK_SIZE,
+                 out_ptr + i * BLOCK_SIZE);
+  }
+
+  // Small hack: Set 0x61 of the header to 1 so that VolumeWii realizes that the disc is unencrypted
+  if (logical_block_index == 0)
+    out_ptr[0x61] = 1;
+
+  return num_blocks;
+}
+
 bool NFSFileReader::Read(u64 offset, u64 nbytes, u8* out_ptr)
 {
   while (nbytes != 0)
@@ -293,6 +343,20 @@ bool NFSFileReader::Read(u64 offset, u64 nbytes, u8* out_ptr)
     const u64 logical_block_index = offset / BLOCK_SIZE;
     const u64 offset_in_block = offset % BLOCK_SIZE;
 
+    // Decrypt runs of whole blocks straight into the output, with one file read for all of them
+    if (offset_in_block == 0 && nbytes >= 2 * BLOCK_SIZE)
+    {
+      const u64 blocks_read =
+          ReadAndDecryptBlocks(logical_block_index, nbytes / BLOCK_SIZE, out_ptr);
+      if (blocks_read != 0)
+      {
+        offset += blocks_read * BLOCK_SIZE;
+        nbytes -= blocks_read * BLOCK_SIZE;
+        out_ptr += blocks_read * BLOCK_SIZE;
+        continue;
+      }
+    }
+
     if (logical_block_index != m_current_logical_block_index)
     {
       if (!ReadAndDecryptBlock(logical_block_index))
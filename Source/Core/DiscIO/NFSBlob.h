@@ -62,6 +62,8 @@ private:
   using Key = std::array<u8, Common::AES::Context::KEY_SIZE>;
   static constexpr u32 BLOCK_SIZE = 0x8000;
   static constexpr u32 MAX_FILE_SIZE = 0xFA00000;
+  // The most blocks that are read from a file at once when a read covers several whole blocks
+  static constexpr u32 MAX_BATCH_BLOCKS = 64;
 
   static bool ReadKey(const std::string& path, const std::string& directory, Key* key_out);
   static std::vector<NFSLBARange> GetLBARanges(const NFSHeader& header);
@@ -75,12 +77,15 @@ private:
 
   u64 ToPhysicalBlockIndex(u64 logical_block_index);
   bool ReadEncryptedBlock(u64 physical_block_index);
-  void DecryptBlock(u64 logical_block_index);
+  void DecryptBlock(u64 logical_block_index, const u8* in, u8* out);
   bool ReadAndDecryptBlock(u64 logical_block_index);
+  // Returns the number of blocks read, or 0 if the caller should fall back to ReadAndDecryptBlock
+  u64 ReadAndDecryptBlocks(u64 logical_block_index, u64 max_blocks, u8* out_ptr);
 
   std::array<u8, BLOCK_SIZE> m_current_block_encrypted;
   std::array<u8, BLOCK_SIZE> m_current_block_decrypted;
   u64 m_current_logical_block_index = std::numeric_limits<u64>::max();
+  std::vector<u8> m_batch_encrypted;
 
   std::vector<NFSLBARange> m_lba_ranges;
   std::vector<File::IOFile> m_files;
@@ -45,10 +45,10 @@ FileDataLoaderHostFS::FileDataLoaderHostFS(std::string sd_root, const std::strin
   SplitPath(xml_path, &m_patch_root, nullptr, nullptr);
 
   // Then try to resolve the given patch_root as if it was a file path, and on success replace the
-  // m_patch_root with it.
+  // m_patch_root with it. This bypasses the path cache, as its results depend on m_patch_root.
   if (!patch_root.empty())
   {
-    auto r = MakeAbsoluteFromRelative(patch_root);
+    auto r = ResolveAbsoluteFromRelative(patch_root);
     if (r)
       m_patch_root = std::move(*r);
   }
@@ -56,6 +56,18 @@ FileDataLoaderHostFS::FileDataLoaderHostFS(std::string sd_root, const std::strin
 
 std::optional<std::string>
 FileDataLoaderHostFS::MakeAbsoluteFromRelative(std::string_view external_relative_path)
+{
+  const auto it = m_resolved_paths.find(external_relative_path);
+  if (it != m_resolved_paths.end())
+    return it->second;
+
+  auto result = ResolveAbsoluteFromRelative(external_relative_path);
+  m_resolved_paths.emplace(external_relative_path, result);
+  return result;
+}
+
+std::optional<std::string>
+FileDataLoaderHostFS::ResolveAbsoluteFromRelative(std::string_view external_relative_path) const
 {
 #ifdef _WIN32
   // Riivolution treats a backslash as just a standard filename character, but we can't replicate
@@ -166,10 +178,15 @@ FileDataLoaderHostFS::GetExternalFileSize(std::string_view external_relative_pat
   auto path = MakeAbsoluteFromRelative(external_relative_path);
   if (!path)
     return std::nullopt;
+
+  const auto it = m_file_sizes.find(*path);
+  if (it != m_file_sizes.end())
+    return it->second;
+
   ::File::FileInfo f(*path);
-  if (!f.IsFile())
-    return std::nullopt;
-  return f.GetSize();
+  const std::optional<u64> size = f.IsFile() ? std::optional<u64>(f.GetSize()) : std::nullopt;
+  m_file_sizes.emplace(std::move(*path), size);
+  return size;
 }
 
 std::vector<u8> FileDataLoaderHostFS::GetFileContents(std::string_view external_relative_path)
@@ -195,10 +212,30 @@ FileDataLoaderHostFS::GetFolderContents(std::string_view external_relative_path)
   if (!path)
     return {};
   ::File::FSTEntry external_files = ::File::ScanDirectoryTree(*path, false);
+
+  // The caller usually goes on to patch every file in the folder, using the paths built below
+  // (the same way ApplyFolderPatchToFST combines them). The scan already told us where each of
+  // them is and how big it is, so there's no need to ask the file system again.
+  std::string_view parent = external_relative_path;
+  if (parent.ends_with('/'))
+    parent.remove_suffix(1);
+
   std::vector<FileDataLoader::Node> nodes;
   nodes.reserve(external_files.children.size());
   for (auto& file : external_files.children)
+  {
+    // Names made up of only dots are rejected by MakeAbsoluteFromRelative, leave those to it.
+    if (!std::all_of(file.virtualName.begin(), file.virtualName.end(),
+                     [](char c) { return c == '.'; }))
+    {
+      std::string child =
+          parent.empty() ? file.virtualName : fmt::format("{}/{}", parent, file.virtualName);
+      if (!file.isDirectory)
+        m_file_sizes.emplace(file.physicalName, file.size);
+      m_resolved_paths.emplace(std::move(child), std::move(file.physicalName));
+    }
     nodes.emplace_back(FileDataLoader::Node{std::move(file.virtualName), file.isDirectory});
+  }
   return nodes;
 }
 
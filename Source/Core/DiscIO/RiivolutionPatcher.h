@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <functional>
+#include <map>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -65,9 +67,16 @@ public:
 
 private:
   std::optional<std::string> MakeAbsoluteFromRelative(std::string_view external_relative_path);
+  std::optional<std::string>
+  ResolveAbsoluteFromRelative(std::string_view external_relative_path) const;
 
   std::string m_sd_root;
   std::string m_patch_root;
+
+  // Large mods apply thousands of files, each of which is resolved and stat'ed more than once, so
+  // remember what the host file system told us for the lifetime of this loader.
+  std::map<std::string, std::optional<std::string>, std::less<>> m_resolved_paths;
+  std::map<std::string, std::optional<u64>, std::less<>> m_file_sizes;
 };
 
 enum class PatchIndex
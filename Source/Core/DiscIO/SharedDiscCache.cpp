@@ -0,0 +1,201 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DiscIO/SharedDiscCache.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Common/CommonPaths.h"
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/Hash.h"
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+#include "Common/Thread.h"
+#include "DiscIO/FileBlob.h"
+
+namespace DiscIO
+{
+namespace
+{
+// Images with the same disc header can still differ, like hacks and scrubbed dumps, so a piece of
+// the start and the end of the compressed file is hashed along with it
+constexpr u64 DISC_HEADER_SIZE = 0x440;
+constexpr u64 FINGERPRINT_SIZE = 0x10000;
+constexpr u64 COPY_BLOCK_SIZE = 0x400000;
+
+// Writes the decompressed contents of a reader to a file on a thread of its own
+class CacheWriter final
+{
+public:
+  CacheWriter(std::unique_ptr<BlobReader> reader, std::string path)
+      : m_reader(std::move(reader)), m_path(std::move(path)), m_thread([this] { Write(); })
+  {
+  }
+
+  ~CacheWriter()
+  {
+    m_stop = true;
+    m_thread.join();
+  }
+
+  CacheWriter(const CacheWriter&) = delete;
+  CacheWriter& operator=(const CacheWriter&) = delete;
+
+  bool IsDone() const { return m_done; }
+
+private:
+  void Write()
+  {
+    Common::SetCurrentThreadName("Shared disc cache writer");
+
+    // Instances that boot the same image before one of them has finished all write a copy. Each
+    // writes to a file of its own, and the last one to finish replaces the others.
+    const std::string temp_path = fmt::format("{}.{:08x}.tmp", m_path, std::random_device()());
+    bool success;
+    {
+      File::IOFile file(temp_path, "wb");
+      success = file.IsOpen();
+
+      std::vector<u8> buffer(COPY_BLOCK_SIZE);
+      const u64 size = m_reader->GetDataSize();
+      for (u64 offset = 0; success && offset < size; offset += COPY_BLOCK_SIZE)
+      {
+        const u64 block_size = std::min(COPY_BLOCK_SIZE, size - offset);
+        success = !m_stop && m_reader->Read(offset, block_size, buffer.data()) &&
+                  file.WriteBytes(buffer.data(), block_size);
+      }
+    }
+
+    if (success && File::Rename(temp_path, m_path))
+    {
+      INFO_LOG_FMT(DISCIO, "Wrote shared disc cache entry {}", m_path);
+    }
+    else
+    {
+      File::Delete(temp_path, File::IfAbsentBehavior::NoConsoleWarning);
+      if (!m_stop)
+        WARN_LOG_FMT(DISCIO, "Could not write shared disc cache entry {}", m_path);
+    }
+
+    m_done = true;
+  }
+
+  std::unique_ptr<BlobReader> m_reader;
+  std::string m_path;
+  std::atomic<bool> m_stop = false;
+  std::atomic<bool> m_done = false;
+  std::thread m_thread;
+};
+
+std::mutex s_mutex;
+std::string s_directory;
+std::unique_ptr<CacheWriter> s_writer;
+
+bool IsCompressed(BlobType type)
+{
+  switch (type)
+  {
+  case BlobType::GCZ:
+  case BlobType::CISO:
+  case BlobType::WBFS:
+  case BlobType::TGC:
+  case BlobType::WIA:
+  case BlobType::RVZ:
+  case BlobType::NFS:
+    return true;
+  default:
+    return false;
+  }
+}
+
+std::optional<std::string> GetCachePath(const std::string& directory, const std::string& path,
+                                        BlobReader& reader)
+{
+  File::IOFile file(path, "rb");
+  const u64 raw_size = file.GetSize();
+  const u64 fingerprint_size = std::min(FINGERPRINT_SIZE, raw_size);
+
+  std::vector<u8> key(DISC_HEADER_SIZE + fingerprint_size * 2);
+  if (!reader.Read(0, DISC_HEADER_SIZE, key.data()) ||
+      !file.ReadBytes(key.data() + DISC_HEADER_SIZE, fingerprint_size) ||
+      !file.Seek(raw_size - fingerprint_size, File::SeekOrigin::Begin) ||
+      !file.ReadBytes(key.data() + DISC_HEADER_SIZE + fingerprint_size, fingerprint_size))
+  {
+    return std::nullopt;
+  }
+
+  const u64 hash = Common::GetHash64(key.data(), static_cast<u32>(key.size()), 0);
+  return fmt::format("{}/{:016x}_{:x}_{:x}.iso", directory, hash, raw_size,
+                     reader.GetDataSize());
+}
+}  // namespace
+
+void SetSharedDiscCacheDirectory(std::string directory)
+{
+  std::lock_guard lock(s_mutex);
+  s_directory = std::move(directory);
+}
+
+std::string GetSharedDiscCacheDirectory()
+{
+  std::lock_guard lock(s_mutex);
+  return s_directory;
+}
+
+std::unique_ptr<BlobReader> CreateBlobReaderForEmulation(const std::string& path)
+{
+  std::unique_ptr<BlobReader> reader = CreateBlobReader(path);
+  const std::string directory = GetSharedDiscCacheDirectory();
+  if (!reader || directory.empty() || !IsCompressed(reader->GetBlobType()) ||
+      reader->GetDataSizeType() != DataSizeType::Accurate)
+  {
+    return reader;
+  }
+
+  const std::optional<std::string> cache_path = GetCachePath(directory, path, *reader);
+  if (!cache_path)
+    return reader;
+
+  if (File::IsFile(*cache_path))
+  {
+    std::unique_ptr<MappedFileReader> cached_reader = MappedFileReader::Create(*cache_path);
+    if (cached_reader && cached_reader->GetDataSize() == reader->GetDataSize())
+    {
+      INFO_LOG_FMT(DISCIO, "Reading {} from shared disc cache entry {}", path, *cache_path);
+      return cached_reader;
+    }
+  }
+
+  // Only one copy is written at a time, other images can be cached when they're booted again
+  std::lock_guard lock(s_mutex);
+  if (s_writer && !s_writer->IsDone())
+    return reader;
+
+  s_writer.reset();
+  if (!File::CreateFullPath(directory + DIR_SEP))
+    return reader;
+
+  if (std::unique_ptr<BlobReader> writer_reader = reader->CopyReader())
+    s_writer = std::make_unique<CacheWriter>(std::move(writer_reader), *cache_path);
+
+  return reader;
+}
+
+void StopSharedDiscCacheWriter()
+{
+  std::lock_guard lock(s_mutex);
+  s_writer.reset();
+}
+}  // namespace DiscIO
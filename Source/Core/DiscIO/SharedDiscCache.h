@@ -0,0 +1,27 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "DiscIO/Blob.h"
+
+namespace DiscIO
+{
+// Lets several instances on one host share the decompressed contents of compressed disc images.
+// The first instance that boots a compressed image writes it out decompressed to the shared cache
+// directory in the background. Instances that boot it once that has finished map the decompressed
+// copy read-only, so they don't decompress anything and the OS keeps one copy of the data in its
+// page cache for all of them. An empty directory, which is the default, turns this off.
+void SetSharedDiscCacheDirectory(std::string directory);
+std::string GetSharedDiscCacheDirectory();
+
+// Like CreateBlobReader, but returns the shared decompressed copy of a compressed image if there
+// is one. Meant for the disc that is emulated, not for tools that care about the container.
+std::unique_ptr<BlobReader> CreateBlobReaderForEmulation(const std::string& path);
+
+// Stops writing a decompressed copy, leaving no partial file behind
+void StopSharedDiscCacheWriter();
+}  // namespace DiscIO
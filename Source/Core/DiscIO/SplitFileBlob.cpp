@@ -3,6 +3,7 @@
 
 #include "DiscIO/SplitFileBlob.h"
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <string_view>
@@ -14,6 +15,7 @@
 #include "Common/FileUtil.h"
 #include "Common/IOFile.h"
 #include "Common/MsgHandler.h"
+#include "DiscIO/FileReadQueue.h"
 
 namespace DiscIO
 {
@@ -72,30 +74,27 @@ bool SplitPlainFileReader::Read(u64 offset, u64 nbytes, u8* out_ptr)
   if (offset >= m_size)
     return false;
 
+  // The parts of a read that cross file boundaries are read at the same time
+  std::vector<FileReadRequest> requests;
   u64 current_offset = offset;
   u64 rest = nbytes;
   u8* out = out_ptr;
-  for (auto& file : m_files)
+  for (const SingleFile& file : m_files)
   {
     if (current_offset >= file.offset && current_offset < file.offset + file.size)
     {
-      auto& f = file.file;
-      const u64 seek_offset = current_offset - file.offset;
-      const u64 current_read = std::min(file.size - seek_offset, rest);
-      if (!f.Seek(seek_offset, File::SeekOrigin::Begin) || !f.ReadBytes(out, current_read))
-      {
-        f.ClearError();
-        return false;
-      }
+      const u64 file_offset = current_offset - file.offset;
+      const u64 current_read = std::min(file.size - file_offset, rest);
+      requests.push_back({&file.file, file_offset, current_read, out});
 
       rest -= current_read;
       if (rest == 0)
-        return true;
+        break;
       current_offset += current_read;
       out += current_read;
     }
   }
 
-  return rest == 0;
+  return rest == 0 && ReadFiles(requests);
 }
 }  // namespace DiscIO
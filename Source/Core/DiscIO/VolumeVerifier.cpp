@@ -360,13 +360,19 @@ RedumpVerifier::Result RedumpVerifier::Finish(const Hashes<std::vector<u8>>& has
 constexpr u64 DEFAULT_READ_SIZE = 0x20000;  // Arbitrary value
 
 VolumeVerifier::VolumeVerifier(const Volume& volume, bool redump_verification,
-                               Hashes<bool> hashes_to_calculate)
+                               Hashes<bool> hashes_to_calculate, u32 jobs)
     : m_volume(volume), m_redump_verification(redump_verification),
       m_hashes_to_calculate(hashes_to_calculate),
       m_calculating_any_hash(hashes_to_calculate.crc32 || hashes_to_calculate.md5 ||
                              hashes_to_calculate.sha1),
+      m_jobs(std::max<u32>(jobs, 1)), m_read_size(DEFAULT_READ_SIZE),
       m_max_progress(volume.GetDataSize()), m_data_size_type(volume.GetDataSizeType())
 {
+  // Reading one block of the blob per job lets readers such as WIA/RVZ decompress them at once.
+  // Memory stays bounded to the chunk being read plus the chunk being hashed.
+  if (m_jobs > 1)
+    m_read_size = std::max(m_read_size, volume.GetBlobReader().GetBlockSize() * m_jobs);
+
   if (!m_calculating_any_hash)
     m_redump_verification = false;
 }
@@ -1094,6 +1100,63 @@ void VolumeVerifier::WaitForAsyncOperations() const
     m_group_future.wait();
 }
 
+void VolumeVerifier::VerifyGroup(const GroupToVerify& group, bool read_failed)
+{
+  const size_t blocks = group.block_index_end - group.block_index_start;
+  std::vector<u8> block_is_valid(blocks, false);
+
+  const auto check_blocks = [&](size_t first, size_t step) {
+    for (size_t i = first; i < blocks; i += step)
+    {
+      block_is_valid[i] = m_volume.CheckBlockIntegrity(
+          group.block_index_start + i, m_data.data() + i * VolumeWii::BLOCK_TOTAL_SIZE,
+          group.partition);
+    }
+  };
+
+  if (!read_failed && blocks > 0)
+  {
+    // The first check sets up the partition's lazily loaded key and H3 table, so it has to be
+    // done before any other thread checks a block of the same partition
+    check_blocks(0, blocks);
+
+    const size_t jobs = std::min<size_t>(m_jobs, blocks - 1);
+    std::vector<std::future<void>> futures;
+    for (size_t job = 1; job < jobs; ++job)
+      futures.push_back(std::async(std::launch::async, check_blocks, job + 1, jobs));
+
+    if (jobs > 0)
+      check_blocks(1, jobs);
+
+    for (std::future<void>& future : futures)
+      future.wait();
+  }
+
+  for (size_t i = 0; i < blocks; ++i)
+  {
+    const u64 block_offset = group.offset + i * VolumeWii::BLOCK_TOTAL_SIZE;
+
+    if (block_is_valid[i])
+    {
+      m_biggest_verified_offset =
+          std::max(m_biggest_verified_offset, block_offset + VolumeWii::BLOCK_TOTAL_SIZE);
+    }
+    else
+    {
+      if (m_scrubber.CanBlockBeScrubbed(block_offset))
+      {
+        WARN_LOG_FMT(DISCIO, "Integrity check failed for unused block at {:#x}", block_offset);
+        m_unused_block_errors[group.partition]++;
+      }
+      else
+      {
+        WARN_LOG_FMT(DISCIO, "Integrity check failed for block at {:#x}", block_offset);
+        m_block_errors[group.partition]++;
+      }
+    }
+  }
+}
+
 bool VolumeVerifier::ReadChunkAndWaitForAsyncOperations(u64 bytes_to_read)
 {
   std::vector<u8> data(bytes_to_read);
@@ -1128,7 +1191,7 @@ void VolumeVerifier::Process()
   IOS::ES::Content content{};
   bool content_read = false;
   bool group_read = false;
-  u64 bytes_to_read = DEFAULT_READ_SIZE;
+  u64 bytes_to_read = m_read_size;
   u64 excess_bytes = 0;
   if (m_content_index < m_content_offsets.size() &&
       m_content_offsets[m_content_index] == m_progress)
@@ -1240,36 +1303,10 @@ void VolumeVerifier::Process()
 
   if (group_read)
   {
-    m_group_future = std::async(std::launch::async, [this, read_failed,
-                                                     group_index = m_group_index] {
-      const GroupToVerify& group = m_groups[group_index];
-      u64 offset_in_group = 0;
-      for (u64 block_index = group.block_index_start; block_index < group.block_index_end;
-           ++block_index, offset_in_group += VolumeWii::BLOCK_TOTAL_SIZE)
-      {
-        const u64 block_offset = group.offset + offset_in_group;
-
-        if (!read_failed && m_volume.CheckBlockIntegrity(
-                                block_index, m_data.data() + offset_in_group, group.partition))
-        {
-          m_biggest_verified_offset =
-              std::max(m_biggest_verified_offset, block_offset + VolumeWii::BLOCK_TOTAL_SIZE);
-        }
-        else
-        {
-          if (m_scrubber.CanBlockBeScrubbed(block_offset))
-          {
-            WARN_LOG_FMT(DISCIO, "Integrity check failed for unused block at {:#x}", block_offset);
-            m_unused_block_errors[group.partition]++;
-          }
-          else
-          {
-            WARN_LOG_FMT(DISCIO, "Integrity check failed for block at {:#x}", block_offset);
-            m_block_errors[group.partition]++;
-          }
-        }
-      }
-    });
+    m_group_future =
+        std::async(std::launch::async, [this, read_failed, group_index = m_group_index] {
+          VerifyGroup(m_groups[group_index], read_failed);
+        });
 
     m_group_index++;
   }
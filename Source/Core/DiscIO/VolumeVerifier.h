@@ -124,7 +124,10 @@ public:
     RedumpVerifier::Result redump;
   };
 
-  VolumeVerifier(const Volume& volume, bool redump_verification, Hashes<bool> hashes_to_calculate);
+  // With more than one job, larger chunks are read at a time so that compressed formats can
+  // decompress several blocks at once, and the blocks of each Wii group are checked in parallel.
+  VolumeVerifier(const Volume& volume, bool redump_verification, Hashes<bool> hashes_to_calculate,
+                 u32 jobs = 1);
   ~VolumeVerifier();
 
   static Hashes<bool> GetDefaultHashesToCalculate();
@@ -157,6 +160,7 @@ private:
   void CheckSuperPaperMario();
   void SetUpHashing();
   void WaitForAsyncOperations() const;
+  void VerifyGroup(const GroupToVerify& group, bool read_failed);
   bool ReadChunkAndWaitForAsyncOperations(u64 bytes_to_read);
 
   void AddProblem(Severity severity, std::string text);
@@ -178,6 +182,9 @@ private:
   mbedtls_md5_context m_md5_context{};
   std::unique_ptr<Common::SHA1::Context> m_sha1_context;
 
+  u32 m_jobs;
+  u64 m_read_size = 0;
+
   u64 m_excess_bytes = 0;
   std::vector<u8> m_data;
   std::future<void> m_crc32_future;
@@ -8,6 +8,8 @@
 #include <cstddef>
 #include <cstring>
 #include <future>
+#include <iterator>
+#include <list>
 #include <map>
 #include <memory>
 #include <optional>
@@ -36,8 +38,7 @@
 namespace DiscIO
 {
 VolumeWii::VolumeWii(std::unique_ptr<BlobReader> reader)
-    : m_reader(std::move(reader)), m_game_partition(PARTITION_NONE),
-      m_last_decrypted_block(UINT64_MAX)
+    : m_reader(std::move(reader)), m_game_partition(PARTITION_NONE)
 {
   ASSERT(m_reader);
 
@@ -186,14 +187,11 @@ bool VolumeWii::Read(u64 offset, u64 length, u8* buffer, const Partition& partit
   }
 
   Common::AES::Context* aes_context = nullptr;
-  std::unique_ptr<u8[]> read_buffer = nullptr;
   if (m_has_encryption)
   {
     aes_context = partition_details.key->get();
     if (!aes_context)
       return false;
-
-    read_buffer = std::make_unique<u8[]>(BLOCK_TOTAL_SIZE);
   }
 
   while (length > 0)
@@ -202,34 +200,29 @@ bool VolumeWii::Read(u64 offset, u64 length, u8* buffer, const Partition& partit
     u64 block_offset_on_disc = partition_data_offset + offset / BLOCK_DATA_SIZE * BLOCK_TOTAL_SIZE;
     u64 data_offset_in_block = offset % BLOCK_DATA_SIZE;
 
-    if (m_last_decrypted_block != block_offset_on_disc)
+    const u8* block_data = GetCachedBlock(block_offset_on_disc);
+    if (!block_data)
     {
-      if (m_has_encryption)
+      // Also read the blocks after this one that the read needs and that aren't cached yet
+      const u64 last_block_offset_on_disc =
+          partition_data_offset + (offset + length - 1) / BLOCK_DATA_SIZE * BLOCK_TOTAL_SIZE;
+      size_t block_count = 1;
+      while (block_count < MAX_BLOCKS_PER_READ &&
+             block_offset_on_disc + block_count * BLOCK_TOTAL_SIZE <= last_block_offset_on_disc &&
+             !m_block_cache_index.contains(block_offset_on_disc + block_count * BLOCK_TOTAL_SIZE))
       {
-        // Read the current block
-        if (!m_reader->Read(block_offset_on_disc, BLOCK_TOTAL_SIZE, read_buffer.get()))
-          return false;
-
-        // Decrypt the block's data
-        DecryptBlockData(read_buffer.get(), m_last_decrypted_block_data, aes_context);
-      }
-      else
-      {
-        // Read the current block
-        if (!m_reader->Read(block_offset_on_disc + BLOCK_HEADER_SIZE, BLOCK_DATA_SIZE,
-                            m_last_decrypted_block_data))
-        {
-          return false;
-        }
+        ++block_count;
       }
 
-      m_last_decrypted_block = block_offset_on_disc;
+      if (!ReadBlocks(block_offset_on_disc, block_count, aes_context))
+        return false;
+
+      block_data = m_block_cache.front().data.data();
     }
 
     // Copy the decrypted data
     u64 copy_size = std::min(length, BLOCK_DATA_SIZE - data_offset_in_block);
-    memcpy(buffer, &m_last_decrypted_block_data[data_offset_in_block],
-           static_cast<size_t>(copy_size));
+    memcpy(buffer, &block_data[data_offset_in_block], static_cast<size_t>(copy_size));
 
     // Update offsets
     length -= copy_size;
@@ -240,6 +233,55 @@ bool VolumeWii::Read(u64 offset, u64 length, u8* buffer, const Partition& partit
   return true;
 }
 
+const u8* VolumeWii::GetCachedBlock(u64 block_offset_on_disc) const
+{
+  const auto it = m_block_cache_index.find(block_offset_on_disc);
+  if (it == m_block_cache_index.end())
+    return nullptr;
+
+  m_block_cache.splice(m_block_cache.begin(), m_block_cache, it->second);
+  return it->second->data.data();
+}
+
+bool VolumeWii::ReadBlocks(u64 block_offset_on_disc, size_t block_count,
+                           Common::AES::Context* aes_context) const
+{
+  m_read_buffer.resize(block_count * BLOCK_TOTAL_SIZE);
+  if (!m_reader->Read(block_offset_on_disc, m_read_buffer.size(), m_read_buffer.data()))
+    return false;
+
+  // Inserted last to first, so that the first block ends up most recently used
+  for (size_t i = block_count; i-- > 0;)
+  {
+    const u64 offset_on_disc = block_offset_on_disc + i * BLOCK_TOTAL_SIZE;
+
+    // Reuse the least recently used entry once the cache is full
+    if (m_block_cache.size() < BLOCK_CACHE_SIZE)
+    {
+      m_block_cache.emplace_front();
+    }
+    else
+    {
+      m_block_cache_index.erase(m_block_cache.back().offset_on_disc);
+      m_block_cache.splice(m_block_cache.begin(), m_block_cache, std::prev(m_block_cache.end()));
+    }
+
+    CachedBlock& block = m_block_cache.front();
+    block.offset_on_disc = offset_on_disc;
+    m_block_cache_index[offset_on_disc] = m_block_cache.begin();
+
+    // Each block has its own IV, so the blocks are decrypted one by one. Within a block, the
+    // AES-NI and ARMv8 implementations already decrypt several AES blocks at a time.
+    const u8* in = m_read_buffer.data() + i * BLOCK_TOTAL_SIZE;
+    if (aes_context)
+      DecryptBlockData(in, block.data.data(), aes_context);
+    else
+      std::memcpy(block.data.data(), in + BLOCK_HEADER_SIZE, BLOCK_DATA_SIZE);
+  }
+
+  return true;
+}
+
 bool VolumeWii::HasWiiHashes() const
 {
   return m_has_hashes;
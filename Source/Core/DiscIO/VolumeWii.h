@@ -5,10 +5,12 @@
 
 #include <array>
 #include <functional>
+#include <list>
 #include <map>
 #include <memory>
 #include <optional>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "Common/CommonTypes.h"
@@ -125,14 +127,32 @@ private:
     u32 type = 0;
   };
 
+  struct CachedBlock
+  {
+    u64 offset_on_disc;
+    std::array<u8, BLOCK_DATA_SIZE> data;
+  };
+
+  // Enough for the small files that Wii games tend to read over and over, like archive headers
+  static constexpr size_t BLOCK_CACHE_SIZE = 64;
+  // Contiguous uncached blocks are read from the blob in one call, up to this many at a time
+  static constexpr size_t MAX_BLOCKS_PER_READ = 16;
+  static_assert(MAX_BLOCKS_PER_READ <= BLOCK_CACHE_SIZE);
+
+  const u8* GetCachedBlock(u64 block_offset_on_disc) const;
+  bool ReadBlocks(u64 block_offset_on_disc, size_t block_count,
+                  Common::AES::Context* aes_context) const;
+
   std::unique_ptr<BlobReader> m_reader;
   std::map<Partition, PartitionDetails> m_partitions;
   Partition m_game_partition;
   bool m_has_hashes;
   bool m_has_encryption;
 
-  mutable u64 m_last_decrypted_block;
-  mutable u8 m_last_decrypted_block_data[BLOCK_DATA_SIZE]{};
+  // Decrypted block data, most recently used first
+  mutable std::list<CachedBlock> m_block_cache;
+  mutable std::unordered_map<u64, std::list<CachedBlock>::iterator> m_block_cache_index;
+  mutable std::vector<u8> m_read_buffer;
 };
 
 }  // namespace DiscIO
@@ -5,12 +5,15 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cstring>
+#include <future>
 #include <limits>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <thread>
 #include <type_traits>
 #include <utility>
 
@@ -40,6 +43,11 @@
 
 namespace DiscIO
 {
+static std::atomic<u64> s_group_cache_size = 0;
+static std::atomic<u64> s_group_cache_hits = 0;
+static std::atomic<u64> s_group_cache_misses = 0;
+static std::atomic<u32> s_decompression_threads = 0;
+
 static void PushBack(std::vector<u8>* vector, const u8* begin, const u8* end)
 {
   const size_t offset_in_vector = vector->size();
@@ -77,6 +85,63 @@ std::pair<int, int> GetAllowedCompressionLevels(WIARVZCompressionType compressio
   }
 }
 
+u64 GetCompressorMemoryUsage(WIARVZCompressionType compression_type, int compression_level)
+{
+  switch (compression_type)
+  {
+  case WIARVZCompressionType::Bzip2:
+    // bzip2 documents 400 KiB plus 8 times the block size, which is 100 kB per level
+    return 400 * 1024 + 800000 * u64(compression_level);
+  case WIARVZCompressionType::LZMA:
+  case WIARVZCompressionType::LZMA2:
+  {
+    lzma_options_lzma options;
+    if (lzma_lzma_preset(&options, static_cast<uint32_t>(compression_level)))
+      return 0;
+
+    const lzma_filter filters[] = {
+        {compression_type == WIARVZCompressionType::LZMA2 ? LZMA_FILTER_LZMA2 : LZMA_FILTER_LZMA1,
+         &options},
+        {LZMA_VLI_UNKNOWN, nullptr},
+    };
+    const u64 usage = lzma_raw_encoder_memusage(filters);
+    return usage == UINT64_MAX ? 0 : usage;
+  }
+  case WIARVZCompressionType::Zstd:
+    // The window grows with the level, this matches zstd's default parameters for large inputs
+    if (compression_level <= 5)
+      return 16 * 1024 * 1024;
+    if (compression_level <= 12)
+      return 64 * 1024 * 1024;
+    if (compression_level <= 19)
+      return 192 * 1024 * 1024;
+    return 1024 * 1024 * 1024;
+  default:
+    return 0;
+  }
+}
+
+void SetWIARVZGroupCacheSize(u64 size)
+{
+  s_group_cache_size = size;
+}
+
+void SetWIARVZDecompressionThreads(u32 threads)
+{
+  s_decompression_threads = threads;
+}
+
+WIARVZGroupCacheStats GetWIARVZGroupCacheStats()
+{
+  return {s_group_cache_hits, s_group_cache_misses};
+}
+
+void ResetWIARVZGroupCacheStats()
+{
+  s_group_cache_hits = 0;
+  s_group_cache_misses = 0;
+}
+
 template <bool RVZ>
 WIARVZFileReader<RVZ>::WIARVZFileReader(File::IOFile file, const std::string& path)
     : m_file(std::move(file)), m_path(path), m_encryption_cache(this)
@@ -500,6 +565,9 @@ bool WIARVZFileReader<RVZ>::ReadFromGroups(u64* offset, u64* size, u8** out_ptr,
   data_offset -= skipped_data;
   data_size += skipped_data;
 
+  DecompressGroupsInParallel(*offset, *size, chunk_size, data_offset, data_size, group_index,
+                             number_of_groups, exception_lists);
+
   const u64 start_group_index = (*offset - data_offset) / chunk_size;
   for (u64 i = start_group_index; i < number_of_groups && (*size) > 0; ++i)
   {
@@ -537,12 +605,12 @@ bool WIARVZFileReader<RVZ>::ReadFromGroups(u64* offset, u64* size, u8** out_ptr,
       const u64 group_offset_in_file = static_cast<u64>(Common::swap32(group.data_offset)) << 2;
 
       Chunk& chunk =
-          ReadCompressedData(group_offset_in_file, group_data_size, chunk_size, compression_type,
-                             exception_lists, rvz_packed_size, group_offset_in_data);
+          ReadCompressedGroup(group_offset_in_file, group_data_size, chunk_size, compression_type,
+                              exception_lists, rvz_packed_size, group_offset_in_data);
 
       if (!chunk.Read(offset_in_group, bytes_to_read, *out_ptr))
       {
-        m_cached_chunk_offset = std::numeric_limits<u64>::max();  // Invalidate the cache
+        InvalidateCachedGroup(group_offset_in_file);
         return false;
       }
 
@@ -566,15 +634,10 @@ bool WIARVZFileReader<RVZ>::ReadFromGroups(u64* offset, u64* size, u8** out_ptr,
 }
 
 template <bool RVZ>
-typename WIARVZFileReader<RVZ>::Chunk&
-WIARVZFileReader<RVZ>::ReadCompressedData(u64 offset_in_file, u64 compressed_size,
-                                          u64 decompressed_size,
-                                          WIARVZCompressionType compression_type,
-                                          u32 exception_lists, u32 rvz_packed_size, u64 data_offset)
+std::unique_ptr<Decompressor>
+WIARVZFileReader<RVZ>::CreateDecompressor(WIARVZCompressionType compression_type,
+                                          u64 decompressed_size, u32 rvz_packed_size) const
 {
-  if (offset_in_file == m_cached_chunk_offset)
-    return m_cached_chunk;
-
   std::unique_ptr<Decompressor> decompressor;
   switch (compression_type)
   {
@@ -601,15 +664,201 @@ WIARVZFileReader<RVZ>::ReadCompressedData(u64 offset_in_file, u64 compressed_siz
     break;
   }
 
+  return decompressor;
+}
+
+template <bool RVZ>
+void WIARVZFileReader<RVZ>::DecompressGroupsInParallel(u64 offset, u64 size, u64 chunk_size,
+                                                       u64 data_offset, u64 data_size,
+                                                       u32 group_index, u32 number_of_groups,
+                                                       u32 exception_lists)
+{
+  // The decompressed groups are handed over through the group cache. Only use half of it, so
+  // that the groups of this read can't evict each other before they have been copied out.
+  const u64 memory_budget = s_group_cache_size.load(std::memory_order_relaxed) / 2;
+  if (memory_budget == 0 || size == 0)
+    return;
+
+  const u64 first_group = (offset - data_offset) / chunk_size;
+  const u64 last_group = std::min<u64>((offset + size - 1 - data_offset) / chunk_size,
+                                       u64(number_of_groups) - 1);
+  if (last_group <= first_group)
+    return;
+
+  // Reading from the file stays on this thread
+  std::vector<Chunk*> chunks;
+  u64 memory_usage = 0;
+  for (u64 i = first_group; i <= last_group; ++i)
+  {
+    const u64 total_group_index = group_index + i;
+    if (total_group_index >= m_group_entries.size())
+      break;
+
+    const GroupEntry& group = m_group_entries[total_group_index];
+    const u64 group_offset_in_data = i * chunk_size;
+    const u64 decompressed_size = std::min(chunk_size, data_size - group_offset_in_data);
+    u32 group_data_size = Common::swap32(group.data_size);
+
+    WIARVZCompressionType compression_type = m_compression_type;
+    u32 rvz_packed_size = 0;
+    if constexpr (RVZ)
+    {
+      if ((group_data_size & 0x80000000) == 0)
+        compression_type = WIARVZCompressionType::None;
+
+      group_data_size &= 0x7FFFFFFF;
+
+      rvz_packed_size = Common::swap32(group.rvz_packed_size);
+    }
+
+    // Groups that aren't compressed are no faster to read on another thread
+    if (group_data_size == 0 || compression_type <= WIARVZCompressionType::Purge)
+      continue;
+
+    const u64 group_offset_in_file = static_cast<u64>(Common::swap32(group.data_offset)) << 2;
+    if (m_group_cache_index.contains(group_offset_in_file))
+      continue;
+
+    memory_usage += group_data_size + decompressed_size;
+    if (memory_usage > memory_budget)
+      break;
+
+    Chunk& chunk =
+        ReadCompressedGroup(group_offset_in_file, group_data_size, decompressed_size,
+                            compression_type, exception_lists, rvz_packed_size,
+                            group_offset_in_data);
+    if (!chunk.ReadAllInput())
+    {
+      InvalidateCachedGroup(group_offset_in_file);
+      return;
+    }
+
+    chunks.push_back(&chunk);
+  }
+
+  // A chunk that fails to decompress here fails again when ReadFromGroups reads it, which is
+  // where the error is handled
+  if (chunks.size() < 2)
+  {
+    for (Chunk* chunk : chunks)
+      chunk->ProcessInput();
+    return;
+  }
+
+  u32 max_threads = s_decompression_threads.load(std::memory_order_relaxed);
+  if (max_threads == 0)
+    max_threads = std::max(1u, std::thread::hardware_concurrency());
+
+  const size_t thread_count = std::min<size_t>(chunks.size(), max_threads);
+  const auto process_chunks = [&chunks, thread_count](size_t first_chunk) {
+    for (size_t i = first_chunk; i < chunks.size(); i += thread_count)
+      chunks[i]->ProcessInput();
+  };
+
+  std::vector<std::future<void>> futures;
+  futures.reserve(thread_count - 1);
+  for (size_t i = 1; i < thread_count; ++i)
+    futures.push_back(std::async(std::launch::async, process_chunks, i));
+
+  process_chunks(0);
+
+  for (std::future<void>& future : futures)
+    future.wait();
+}
+
+template <bool RVZ>
+typename WIARVZFileReader<RVZ>::Chunk&
+WIARVZFileReader<RVZ>::ReadCompressedData(u64 offset_in_file, u64 compressed_size,
+                                          u64 decompressed_size,
+                                          WIARVZCompressionType compression_type,
+                                          u32 exception_lists, u32 rvz_packed_size, u64 data_offset)
+{
+  if (offset_in_file == m_cached_chunk_offset)
+    return m_cached_chunk;
+
   const bool compressed_exception_lists = compression_type > WIARVZCompressionType::Purge;
 
   m_cached_chunk =
       Chunk(&m_file, offset_in_file, compressed_size, decompressed_size, exception_lists,
-            compressed_exception_lists, rvz_packed_size, data_offset, std::move(decompressor));
+            compressed_exception_lists, rvz_packed_size, data_offset,
+            CreateDecompressor(compression_type, decompressed_size, rvz_packed_size));
   m_cached_chunk_offset = offset_in_file;
   return m_cached_chunk;
 }
 
+template <bool RVZ>
+typename WIARVZFileReader<RVZ>::Chunk&
+WIARVZFileReader<RVZ>::ReadCompressedGroup(u64 offset_in_file, u64 compressed_size,
+                                           u64 decompressed_size,
+                                           WIARVZCompressionType compression_type,
+                                           u32 exception_lists, u32 rvz_packed_size,
+                                           u64 data_offset)
+{
+  const u64 cache_size = s_group_cache_size.load(std::memory_order_relaxed);
+  if (cache_size == 0)
+  {
+    if (!m_group_cache.empty())
+    {
+      m_group_cache.clear();
+      m_group_cache_index.clear();
+      m_group_cache_memory_usage = 0;
+    }
+
+    if (offset_in_file == m_cached_chunk_offset)
+      ++s_group_cache_hits;
+    else
+      ++s_group_cache_misses;
+
+    return ReadCompressedData(offset_in_file, compressed_size, decompressed_size,
+                              compression_type, exception_lists, rvz_packed_size, data_offset);
+  }
+
+  if (const auto it = m_group_cache_index.find(offset_in_file); it != m_group_cache_index.end())
+  {
+    ++s_group_cache_hits;
+    m_group_cache.splice(m_group_cache.begin(), m_group_cache, it->second);
+    return it->second->chunk;
+  }
+
+  ++s_group_cache_misses;
+
+  const bool compressed_exception_lists = compression_type > WIARVZCompressionType::Purge;
+
+  m_group_cache.push_front(
+      {offset_in_file,
+       Chunk(&m_file, offset_in_file, compressed_size, decompressed_size, exception_lists,
+             compressed_exception_lists, rvz_packed_size, data_offset,
+             CreateDecompressor(compression_type, decompressed_size, rvz_packed_size))});
+  m_group_cache_index.emplace(offset_in_file, m_group_cache.begin());
+  m_group_cache_memory_usage += m_group_cache.front().chunk.GetMemoryUsage();
+
+  // The group that was just added is always kept, even if it alone is larger than the cache
+  while (m_group_cache_memory_usage > cache_size && m_group_cache.size() > 1)
+  {
+    const CachedGroup& oldest = m_group_cache.back();
+    m_group_cache_memory_usage -= oldest.chunk.GetMemoryUsage();
+    m_group_cache_index.erase(oldest.offset_in_file);
+    m_group_cache.pop_back();
+  }
+
+  return m_group_cache.front().chunk;
+}
+
+template <bool RVZ>
+void WIARVZFileReader<RVZ>::InvalidateCachedGroup(u64 offset_in_file)
+{
+  if (offset_in_file == m_cached_chunk_offset)
+    m_cached_chunk_offset = std::numeric_limits<u64>::max();
+
+  const auto it = m_group_cache_index.find(offset_in_file);
+  if (it == m_group_cache_index.end())
+    return;
+
+  m_group_cache_memory_usage -= it->second->chunk.GetMemoryUsage();
+  m_group_cache.erase(it->second);
+  m_group_cache_index.erase(it);
+}
+
 template <bool RVZ>
 std::string WIARVZFileReader<RVZ>::VersionToString(u32 version)
 {
@@ -691,69 +940,93 @@ bool WIARVZFileReader<RVZ>::Chunk::Read(u64 offset, u64 size, u8* out_ptr)
       return false;
     }
 
-    if (!m_file->Seek(m_offset_in_file, File::SeekOrigin::Begin))
-      return false;
-    if (!m_file->ReadBytes(m_in.data.data() + m_in.bytes_written, bytes_to_read))
+    if (!ReadInput(bytes_to_read) || !ProcessInput())
       return false;
+  }
 
-    m_offset_in_file += bytes_to_read;
-    m_in.bytes_written += bytes_to_read;
+  std::memcpy(out_ptr, m_out.data.data() + offset + m_out_bytes_used_for_exceptions, size);
+  return true;
+}
 
-    if (m_exception_lists > 0 && !m_compressed_exception_lists)
-    {
-      if (!HandleExceptions(m_in.data.data(), m_in.data.size(), m_in.bytes_written,
-                            &m_in_bytes_used_for_exceptions, true))
-      {
-        return false;
-      }
+template <bool RVZ>
+bool WIARVZFileReader<RVZ>::Chunk::ReadAllInput()
+{
+  if (!m_decompressor || !m_file)
+    return false;
 
-      m_in_bytes_read = m_in_bytes_used_for_exceptions;
-    }
+  const u64 bytes_to_read = m_in.data.size() - m_in.bytes_written;
+  return bytes_to_read == 0 || ReadInput(bytes_to_read);
+}
+
+template <bool RVZ>
+bool WIARVZFileReader<RVZ>::Chunk::ReadInput(u64 bytes_to_read)
+{
+  if (!m_file->Seek(m_offset_in_file, File::SeekOrigin::Begin))
+    return false;
+  if (!m_file->ReadBytes(m_in.data.data() + m_in.bytes_written, bytes_to_read))
+    return false;
+
+  m_offset_in_file += bytes_to_read;
+  m_in.bytes_written += bytes_to_read;
+  return true;
+}
 
-    if (m_exception_lists == 0 || m_compressed_exception_lists)
+template <bool RVZ>
+bool WIARVZFileReader<RVZ>::Chunk::ProcessInput()
+{
+  if (m_exception_lists > 0 && !m_compressed_exception_lists)
+  {
+    if (!HandleExceptions(m_in.data.data(), m_in.data.size(), m_in.bytes_written,
+                          &m_in_bytes_used_for_exceptions, true))
     {
-      if (!Decompress())
-        return false;
+      return false;
     }
 
-    if (m_exception_lists > 0 && m_compressed_exception_lists)
-    {
-      if (!HandleExceptions(m_out.data.data(), m_out_bytes_allocated_for_exceptions,
-                            m_out.bytes_written, &m_out_bytes_used_for_exceptions, false))
-      {
-        return false;
-      }
+    m_in_bytes_read = m_in_bytes_used_for_exceptions;
+  }
 
-      if (m_rvz_packed_size != 0 && m_exception_lists == 0)
-      {
-        if (!Decompress())
-          return false;
-      }
+  if (m_exception_lists == 0 || m_compressed_exception_lists)
+  {
+    if (!Decompress())
+      return false;
+  }
+
+  if (m_exception_lists > 0 && m_compressed_exception_lists)
+  {
+    if (!HandleExceptions(m_out.data.data(), m_out_bytes_allocated_for_exceptions,
+                          m_out.bytes_written, &m_out_bytes_used_for_exceptions, false))
+    {
+      return false;
     }
 
-    if (m_exception_lists == 0)
+    if (m_rvz_packed_size != 0 && m_exception_lists == 0)
     {
-      const size_t expected_out_bytes = m_out.data.size() - m_out_bytes_allocated_for_exceptions +
-                                        m_out_bytes_used_for_exceptions;
+      if (!Decompress())
+        return false;
+    }
+  }
 
-      if (m_out.bytes_written > expected_out_bytes)
-        return false;  // Decompressed size is larger than expected
+  if (m_exception_lists == 0)
+  {
+    const size_t expected_out_bytes = m_out.data.size() - m_out_bytes_allocated_for_exceptions +
+                                      m_out_bytes_used_for_exceptions;
 
-      // The reason why we need the m_in.bytes_written == m_in.data.size() check as part of
-      // this conditional is because (for example) zstd can finish writing all data to m_out
-      // before becoming done if we've given it all input data except the checksum at the end.
-      if (m_out.bytes_written == expected_out_bytes && !m_decompressor->Done() &&
-          m_in.bytes_written == m_in.data.size())
-      {
-        return false;  // Decompressed size is larger than expected
-      }
+    if (m_out.bytes_written > expected_out_bytes)
+      return false;  // Decompressed size is larger than expected
 
-      if (m_decompressor->Done() && m_in_bytes_read != m_in.data.size())
-        return false;  // Compressed size is smaller than expected
+    // The reason why we need the m_in.bytes_written == m_in.data.size() check as part of
+    // this conditional is because (for example) zstd can finish writing all data to m_out
+    // before becoming done if we've given it all input data except the checksum at the end.
+    if (m_out.bytes_written == expected_out_bytes && !m_decompressor->Done() &&
+        m_in.bytes_written == m_in.data.size())
+    {
+      return false;  // Decompressed size is larger than expected
     }
+
+    if (m_decompressor->Done() && m_in_bytes_read != m_in.data.size())
+      return false;  // Compressed size is smaller than expected
   }
 
-  std::memcpy(out_ptr, m_out.data.data() + offset + m_out_bytes_used_for_exceptions, size);
   return true;
 }
 
@@ -1191,14 +1464,14 @@ static void RVZPack(const u8* in, OutputParametersEntry* out, u64 bytes_per_chun
 
     if (file_system)
     {
-      const std::unique_ptr<DiscIO::FileInfo> file_info =
-          file_system->FindFileInfo(data_offset + bytes_reconstructed);
+      const std::optional<DiscIO::FileLocation> file =
+          file_system->FindFileLocation(data_offset + bytes_reconstructed);
 
       // If we're at a file and there's more space in this block after the file,
       // continue after the file instead of skipping to the next block
-      if (file_info)
+      if (file)
       {
-        const u64 file_end_offset = file_info->GetOffset() + file_info->GetSize();
+        const u64 file_end_offset = file->offset + file->size;
         if (file_end_offset < data_offset + bytes_to_read)
         {
           position += file_end_offset - data_offset;
@@ -1709,6 +1982,148 @@ ConversionResultCode WIARVZFileReader<RVZ>::RunCallback(size_t groups_written, u
                                       ConversionResultCode::Canceled;
 }
 
+template <bool RVZ>
+std::vector<u32> WIARVZFileReader<RVZ>::GetGroupAccessOrder(
+    const DiscAccessProfile& access_profile, const VolumeDisc* volume, int chunk_size,
+    u32 total_groups, const std::vector<PartitionEntry>& partition_entries,
+    const std::vector<RawDataEntry>& raw_data_entries, const std::vector<DataEntry>& data_entries)
+{
+  struct GroupRange
+  {
+    u64 start;
+    u64 end;
+    u32 first_group;
+    u32 number_of_groups;
+  };
+
+  // The raw disc range covered by each data entry, matching how Convert reads them
+  std::vector<GroupRange> ranges;
+  for (const DataEntry& data_entry : data_entries)
+  {
+    if (data_entry.is_partition)
+    {
+      const PartitionDataEntry& entry =
+          partition_entries[data_entry.index].data_entries[data_entry.partition_data_index];
+      const u64 start = u64(Common::swap32(entry.first_sector)) * VolumeWii::BLOCK_TOTAL_SIZE;
+      const u64 size = u64(Common::swap32(entry.number_of_sectors)) * VolumeWii::BLOCK_TOTAL_SIZE;
+      ranges.push_back({start, start + size, Common::swap32(entry.group_index),
+                        Common::swap32(entry.number_of_groups)});
+    }
+    else
+    {
+      const RawDataEntry& entry = raw_data_entries[data_entry.index];
+      const u64 offset = Common::swap64(entry.data_offset);
+      ranges.push_back({Common::AlignDown(offset, VolumeWii::BLOCK_TOTAL_SIZE),
+                        offset + Common::swap64(entry.data_size), Common::swap32(entry.group_index),
+                        Common::swap32(entry.number_of_groups)});
+    }
+  }
+
+  std::vector<u32> order;
+  order.reserve(total_groups);
+  std::vector<bool> ordered(total_groups);
+
+  const auto add_group = [&](u32 group) {
+    if (group < total_groups && !ordered[group])
+    {
+      ordered[group] = true;
+      order.push_back(group);
+    }
+  };
+
+  // Extents are sorted by first access, so the groups of each extent go after those of the
+  // extents read before it
+  for (const HotExtent& extent : access_profile.entries)
+  {
+    if (extent.end <= extent.start)
+      continue;
+
+    u64 raw_start = extent.start;
+    u64 raw_end = extent.end;
+    if (extent.partition != PARTITION_NONE.offset)
+    {
+      if (!volume)
+        continue;
+
+      const Partition partition(extent.partition);
+      raw_start = volume->PartitionOffsetToRawOffset(extent.start, partition);
+      raw_end = volume->PartitionOffsetToRawOffset(extent.end - 1, partition) + 1;
+    }
+
+    for (const GroupRange& range : ranges)
+    {
+      if (range.number_of_groups == 0 || raw_end <= range.start || raw_start >= range.end)
+        continue;
+
+      const u64 start = std::max(raw_start, range.start) - range.start;
+      const u64 end = std::min(raw_end, range.end) - range.start;
+      const u32 first = static_cast<u32>(start / chunk_size);
+      const u32 last =
+          std::min(static_cast<u32>((end - 1) / chunk_size), range.number_of_groups - 1);
+      for (u32 i = first; i <= last; ++i)
+        add_group(range.first_group + i);
+    }
+  }
+
+  INFO_LOG_FMT(DISCIO, "{} of {} groups are ordered by the disc access profile", order.size(),
+               total_groups);
+
+  for (u32 group = 0; group < total_groups; ++group)
+    add_group(group);
+
+  return order;
+}
+
+template <bool RVZ>
+ConversionResultCode
+WIARVZFileReader<RVZ>::CopyGroupsInOrder(File::IOFile* from, File::IOFile* to,
+                                         const std::vector<u32>& group_order,
+                                         std::vector<GroupEntry>* group_entries, u64* bytes_written)
+{
+  // Reused groups share their data, which is copied the first time one of them comes up
+  std::map<u32, u32> new_data_offsets;
+  std::vector<u8> buffer;
+
+  for (const u32 group : group_order)
+  {
+    GroupEntry& group_entry = (*group_entries)[group];
+
+    u32 data_size = Common::swap32(group_entry.data_size);
+    if constexpr (RVZ)
+      data_size &= 0x7FFFFFFF;
+    if (data_size == 0)
+      continue;
+
+    const u32 data_offset = Common::swap32(group_entry.data_offset);
+    const auto [it, inserted] = new_data_offsets.try_emplace(data_offset, 0);
+    if (inserted)
+    {
+      if (*bytes_written >> 2 > std::numeric_limits<u32>::max())
+        return ConversionResultCode::InternalError;
+
+      it->second = static_cast<u32>(*bytes_written >> 2);
+
+      buffer.resize(data_size);
+      if (!from->Seek(u64(data_offset) << 2, File::SeekOrigin::Begin) ||
+          !from->ReadBytes(buffer.data(), buffer.size()))
+      {
+        return ConversionResultCode::ReadFailed;
+      }
+
+      if (!to->WriteBytes(buffer.data(), buffer.size()))
+        return ConversionResultCode::WriteFailed;
+      *bytes_written += buffer.size();
+
+      if (!PadTo4(to, bytes_written))
+        return ConversionResultCode::WriteFailed;
+    }
+
+    group_entry.data_offset = Common::swap32(it->second);
+  }
+
+  return ConversionResultCode::Success;
+}
+
 template <bool RVZ>
 bool WIARVZFileReader<RVZ>::WriteHeader(File::IOFile* file, const u8* data, size_t size,
                                         u64 upper_bound, u64* bytes_written, u64* offset_out)
@@ -1735,10 +2150,12 @@ template <bool RVZ>
 ConversionResultCode
 WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volume,
                                File::IOFile* outfile, WIARVZCompressionType compression_type,
-                               int compression_level, int chunk_size, CompressCB callback)
+                               int compression_level, int chunk_size, CompressCB callback,
+                               const DiscAccessProfile* access_profile, File::IOFile* spill_file)
 {
   ASSERT(infile->GetDataSizeType() == DataSizeType::Accurate);
   ASSERT(chunk_size > 0);
+  ASSERT(!access_profile || spill_file);
 
   const u64 iso_size = infile->GetDataSize();
   const u64 chunks_per_wii_group = std::max<u64>(1, VolumeWii::GROUP_TOTAL_SIZE / chunk_size);
@@ -1771,6 +2188,13 @@ WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volu
 
   group_entries.resize(total_groups);
 
+  std::vector<u32> group_order;
+  if (access_profile)
+  {
+    group_order = GetGroupAccessOrder(*access_profile, infile_volume, chunk_size, total_groups,
+                                      partition_entries, raw_data_entries, data_entries);
+  }
+
   const size_t partition_entries_size = partition_entries.size() * sizeof(PartitionEntry);
   const size_t raw_data_entries_size = raw_data_entries.size() * sizeof(RawDataEntry);
   const size_t group_entries_size = group_entries.size() * sizeof(GroupEntry);
@@ -1810,6 +2234,11 @@ WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volu
   std::map<ReuseID, GroupEntry> reusable_groups;
   std::mutex reusable_groups_mutex;
 
+  // Group data goes to the spill file in disc order if it's going to be reordered afterwards
+  File::IOFile* data_file = access_profile ? spill_file : outfile;
+  u64 spill_bytes_written = 0;
+  u64* data_bytes_written = access_profile ? &spill_bytes_written : &bytes_written;
+
   const auto set_up_compress_thread_state = [&](CompressThreadState* state) {
     SetUpCompressor(&state->compressor, compression_type, compression_level, nullptr);
     return ConversionResultCode::Success;
@@ -1831,14 +2260,14 @@ WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volu
 
   const auto output = [&](OutputParameters parameters) {
     const ConversionResultCode result =
-        Output(&parameters.entries, outfile, &reusable_groups, &reusable_groups_mutex,
-               &group_entries[parameters.group_index], &bytes_written);
+        Output(&parameters.entries, data_file, &reusable_groups, &reusable_groups_mutex,
+               &group_entries[parameters.group_index], data_bytes_written);
 
     if (result != ConversionResultCode::Success)
       return result;
 
     return RunCallback(parameters.group_index + parameters.entries.size(), parameters.bytes_read,
-                       bytes_written, total_groups, iso_size, callback);
+                       *data_bytes_written, total_groups, iso_size, callback);
   };
 
   MultithreadedCompressor<CompressThreadState, CompressParameters, OutputParameters> mt_compressor(
@@ -1939,6 +2368,14 @@ WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volu
   if (status != ConversionResultCode::Success)
     return status;
 
+  if (access_profile)
+  {
+    const ConversionResultCode copy_result =
+        CopyGroupsInOrder(spill_file, outfile, group_order, &group_entries, &bytes_written);
+    if (copy_result != ConversionResultCode::Success)
+      return copy_result;
+  }
+
   std::unique_ptr<Compressor> compressor;
   SetUpCompressor(&compressor, compression_type, compression_level, &header_2);
 
@@ -2034,7 +2471,8 @@ WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volu
 bool ConvertToWIAOrRVZ(BlobReader* infile, const std::string& infile_path,
                        const std::string& outfile_path, bool rvz,
                        WIARVZCompressionType compression_type, int compression_level,
-                       int chunk_size, CompressCB callback)
+                       int chunk_size, CompressCB callback,
+                       const DiscAccessProfile* access_profile)
 {
   File::IOFile outfile(outfile_path, "wb");
   if (!outfile)
@@ -2049,10 +2487,24 @@ bool ConvertToWIAOrRVZ(BlobReader* infile, const std::string& infile_path,
 
   std::unique_ptr<VolumeDisc> infile_volume = CreateDisc(infile_path);
 
+  const std::string spill_file_path = outfile_path + ".groups";
+  File::IOFile spill_file;
+  if (access_profile && !spill_file.Open(spill_file_path, "w+b"))
+  {
+    PanicAlertFmtT("Failed to open the temporary file \"{0}\".", spill_file_path);
+    return false;
+  }
+
   const auto convert = rvz ? RVZFileReader::Convert : WIAFileReader::Convert;
   const ConversionResultCode result =
       convert(infile, infile_volume.get(), &outfile, compression_type, compression_level,
-              chunk_size, callback);
+              chunk_size, callback, access_profile, access_profile ? &spill_file : nullptr);
+
+  if (spill_file.IsOpen())
+  {
+    spill_file.Close();
+    File::Delete(spill_file_path);
+  }
 
   if (result == ConversionResultCode::ReadFailed)
     PanicAlertFmtT("Failed to read from the input file \"{0}\".", infile_path);
@@ -4,11 +4,13 @@
 #pragma once
 
 #include <array>
+#include <list>
 #include <limits>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <type_traits>
+#include <unordered_map>
 #include <utility>
 
 #include "Common/CommonTypes.h"
@@ -16,6 +18,7 @@
 #include "Common/IOFile.h"
 #include "Common/Swap.h"
 #include "DiscIO/Blob.h"
+#include "DiscIO/DiscAccessProfile.h"
 #include "DiscIO/MultithreadedCompressor.h"
 #include "DiscIO/WIACompression.h"
 #include "DiscIO/WiiEncryptionCache.h"
@@ -36,6 +39,24 @@ enum class WIARVZCompressionType : u32
 };
 
 std::pair<int, int> GetAllowedCompressionLevels(WIARVZCompressionType compression_type, bool gui);
+// A rough upper bound of the memory one compressor uses, not counting its input and output
+u64 GetCompressorMemoryUsage(WIARVZCompressionType compression_type, int compression_level);
+
+struct WIARVZGroupCacheStats
+{
+  u64 hits = 0;
+  u64 misses = 0;
+};
+
+// Each WIA/RVZ reader keeps up to this many bytes of decompressed groups, least recently used
+// first out. With 0, only the most recently used group is kept. Takes effect on the next read.
+void SetWIARVZGroupCacheSize(u64 size);
+// How many threads a read that spans several groups may decompress on. With 0, which is the
+// default, one thread per hardware thread is used.
+void SetWIARVZDecompressionThreads(u32 threads);
+// Counted over all readers since the last reset
+WIARVZGroupCacheStats GetWIARVZGroupCacheStats();
+void ResetWIARVZGroupCacheStats();
 
 constexpr u32 WIA_MAGIC = 0x01414957;  // "WIA\x1" (byteswapped to little endian)
 constexpr u32 RVZ_MAGIC = 0x015A5652;  // "RVZ\x1" (byteswapped to little endian)
@@ -67,9 +88,13 @@ public:
   bool SupportsReadWiiDecrypted(u64 offset, u64 size, u64 partition_data_offset) const override;
   bool ReadWiiDecrypted(u64 offset, u64 size, u8* out_ptr, u64 partition_data_offset) override;
 
+  // If access_profile is set, group data is stored in the order the profile's extents were first
+  // read instead of in disc order. It is first written to spill_file and then copied to outfile.
   static ConversionResultCode Convert(BlobReader* infile, const VolumeDisc* infile_volume,
                                       File::IOFile* outfile, WIARVZCompressionType compression_type,
-                                      int compression_level, int chunk_size, CompressCB callback);
+                                      int compression_level, int chunk_size, CompressCB callback,
+                                      const DiscAccessProfile* access_profile = nullptr,
+                                      File::IOFile* spill_file = nullptr);
 
 private:
   using WiiKey = std::array<u8, 16>;
@@ -194,6 +219,11 @@ private:
 
     bool Read(u64 offset, u64 size, u8* out_ptr);
 
+    // Together, these do what Read does for the whole chunk. Only ReadAllInput touches the file,
+    // so ProcessInput can be called for different chunks on different threads.
+    bool ReadAllInput();
+    bool ProcessInput();
+
     // This can only be called once at least one byte of data has been read
     void GetHashExceptions(std::vector<HashExceptionEntry>* exception_list,
                            u64 exception_list_index, u16 additional_offset) const;
@@ -204,7 +234,10 @@ private:
       return Read(0, vector->size() * sizeof(T), reinterpret_cast<u8*>(vector->data()));
     }
 
+    size_t GetMemoryUsage() const { return m_in.data.size() + m_out.data.size(); }
+
   private:
+    bool ReadInput(u64 bytes_to_read);
     bool Decompress();
     bool HandleExceptions(const u8* data, size_t bytes_allocated, size_t bytes_written,
                           size_t* bytes_used, bool align);
@@ -240,6 +273,17 @@ private:
   Chunk& ReadCompressedData(u64 offset_in_file, u64 compressed_size, u64 decompressed_size,
                             WIARVZCompressionType compression_type, u32 exception_lists = 0,
                             u32 rvz_packed_size = 0, u64 data_offset = 0);
+  // Like ReadCompressedData, but keeps the chunk in the group cache
+  Chunk& ReadCompressedGroup(u64 offset_in_file, u64 compressed_size, u64 decompressed_size,
+                             WIARVZCompressionType compression_type, u32 exception_lists,
+                             u32 rvz_packed_size, u64 data_offset);
+  void InvalidateCachedGroup(u64 offset_in_file);
+  void DecompressGroupsInParallel(u64 offset, u64 size, u64 chunk_size, u64 data_offset,
+                                  u64 data_size, u32 group_index, u32 number_of_groups,
+                                  u32 exception_lists);
+  std::unique_ptr<Decompressor> CreateDecompressor(WIARVZCompressionType compression_type,
+                                                   u64 decompressed_size,
+                                                   u32 rvz_packed_size) const;
 
   static bool ApplyHashExceptions(const std::vector<HashExceptionEntry>& exception_list,
                                   VolumeWii::HashBlock hash_blocks[VolumeWii::BLOCKS_PER_GROUP]);
@@ -361,6 +405,16 @@ private:
                                      u64* bytes_written);
   static ConversionResultCode RunCallback(size_t groups_written, u64 bytes_read, u64 bytes_written,
                                           u32 total_groups, u64 iso_size, CompressCB callback);
+  static std::vector<u32> GetGroupAccessOrder(const DiscAccessProfile& access_profile,
+                                              const VolumeDisc* volume, int chunk_size,
+                                              u32 total_groups,
+                                              const std::vector<PartitionEntry>& partition_entries,
+                                              const std::vector<RawDataEntry>& raw_data_entries,
+                                              const std::vector<DataEntry>& data_entries);
+  static ConversionResultCode CopyGroupsInOrder(File::IOFile* from, File::IOFile* to,
+                                                const std::vector<u32>& group_order,
+                                                std::vector<GroupEntry>* group_entries,
+                                                u64* bytes_written);
 
   bool m_valid;
   WIARVZCompressionType m_compression_type;
@@ -369,6 +423,19 @@ private:
   std::string m_path;
   Chunk m_cached_chunk;
   u64 m_cached_chunk_offset = std::numeric_limits<u64>::max();
+
+  struct CachedGroup
+  {
+    u64 offset_in_file;
+    Chunk chunk;
+  };
+
+  // Most recently used first. Groups are keyed by their offset in the file, since reused groups
+  // share their data. Exception lists are parsed once when a group is decompressed, so groups
+  // served from the cache don't decompress anything to hand out their hash exceptions.
+  std::list<CachedGroup> m_group_cache;
+  std::unordered_map<u64, typename std::list<CachedGroup>::iterator> m_group_cache_index;
+  size_t m_group_cache_memory_usage = 0;
   WiiEncryptionCache m_encryption_cache;
 
   std::vector<HashExceptionEntry> m_exception_list;
@@ -4,26 +4,44 @@
 #include "DolphinNoGUI/Platform.h"
 
 #include <OptionParser.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <cstddef>
 #include <cstdio>
 #include <cstring>
+#include <limits>
+#include <optional>
+#include <picojson.h>
 #include <signal.h>
 #include <string>
+#include <variant>
 #include <vector>
 
 #ifndef _WIN32
+#include <sys/resource.h>
 #include <unistd.h>
 #else
 #include <Windows.h>
+#include <psapi.h>
 #endif
 
+#include "Common/Counters.h"
+#include "Common/FileUtil.h"
 #include "Common/ScopeGuard.h"
 #include "Common/StringUtil.h"
 #include "Core/Boot/Boot.h"
 #include "Core/BootManager.h"
+#include "Core/Config/GraphicsSettings.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/Core.h"
 #include "Core/DolphinAnalytics.h"
+#include "Core/FifoPlayer/FifoPlayer.h"
+#include "Core/HW/SystemTimers.h"
 #include "Core/Host.h"
+#include "Core/Movie.h"
+#include "Core/State.h"
 
 #include "UICommon/CommandLineParse.h"
 #ifdef USE_DISCORD_PRESENCE
@@ -33,7 +51,9 @@
 
 #include "InputCommon/GCAdapter.h"
 
+#include "VideoCommon/FrameProfiler.h"
 #include "VideoCommon/VideoBackendBase.h"
+#include "VideoCommon/VideoEvents.h"
 
 static std::unique_ptr<Platform> s_platform;
 
@@ -179,6 +199,272 @@ static std::unique_ptr<Platform> GetPlatform(const optparse::Values& options)
   return nullptr;
 }
 
+// --fifo-bench: plays a FIFO log a number of times as fast as possible while the frame profiler
+// records every presented frame
+class FifoBenchmark
+{
+public:
+  explicit FifoBenchmark(u32 loops) : m_loops(loops)
+  {
+    // Nothing should wait for the emulated or the host display
+    Config::SetCurrent(Config::MAIN_EMULATION_SPEED, 0.0f);
+    Config::SetCurrent(Config::GFX_VSYNC, false);
+    Config::SetCurrent(Config::MAIN_FIFOPLAYER_LOOP_REPLAY, true);
+
+    FifoPlayer::GetInstance().SetFileLoadedCallback([this] {
+      if (const FifoDataFile* file = FifoPlayer::GetInstance().GetFile())
+        m_frames_per_loop = file->GetFrameCount();
+    });
+    m_after_present_event = AfterPresentEvent::Register(
+        [this](const PresentInfo&) {
+          const u32 frames_per_loop = m_frames_per_loop;
+          if (frames_per_loop != 0 && ++m_presented_frames == u64(m_loops) * frames_per_loop)
+            s_platform->Stop();
+        },
+        "FifoBenchmark");
+    g_frame_profiler.SetEnabled(true);
+  }
+
+  ~FifoBenchmark()
+  {
+    g_frame_profiler.SetEnabled(false);
+    FifoPlayer::GetInstance().SetFileLoadedCallback(nullptr);
+  }
+
+  FifoBenchmark(const FifoBenchmark&) = delete;
+  FifoBenchmark& operator=(const FifoBenchmark&) = delete;
+
+  // Call once emulation has stopped
+  std::string GetReport() const
+  {
+    const u32 frames_per_loop = m_frames_per_loop;
+    std::vector<FrameProfiler::Frame> frames = g_frame_profiler.TakeFrames();
+    frames.resize(std::min<size_t>(frames.size(), size_t(m_loops) * frames_per_loop));
+
+    // The first loop includes compiling shaders and filling caches, so it's left out of the
+    // averages unless it is the only one
+    const size_t first_averaged = m_loops > 1 ? frames_per_loop : 0;
+    std::array<double, FrameProfiler::NUM_STAGES + 1> sums{};
+
+    picojson::array json_frames;
+    for (size_t i = 0; i < frames.size(); i++)
+    {
+      picojson::object json_frame;
+      json_frame["loop"] = picojson::value(double(i / frames_per_loop));
+      json_frame["frame_time_us"] = picojson::value(double(frames[i].frame_time_us));
+      for (size_t stage = 0; stage < FrameProfiler::NUM_STAGES; stage++)
+      {
+        json_frame[GetStageKey(stage)] = picojson::value(double(frames[i].stage_time_us[stage]));
+        if (i >= first_averaged)
+          sums[stage] += frames[i].stage_time_us[stage];
+      }
+      if (i >= first_averaged)
+        sums.back() += frames[i].frame_time_us;
+      json_frames.emplace_back(std::move(json_frame));
+    }
+
+    picojson::object json_average;
+    const double averaged_frames = std::max<double>(double(frames.size()) - first_averaged, 1.0);
+    json_average["frame_time_us"] = picojson::value(sums.back() / averaged_frames);
+    for (size_t stage = 0; stage < FrameProfiler::NUM_STAGES; stage++)
+      json_average[GetStageKey(stage)] = picojson::value(sums[stage] / averaged_frames);
+
+    picojson::object json_root;
+    json_root["backend"] = picojson::value(Config::Get(Config::MAIN_GFX_BACKEND));
+    json_root["loops"] = picojson::value(double(m_loops));
+    json_root["frames_per_loop"] = picojson::value(double(frames_per_loop));
+    json_root["average"] = picojson::value(std::move(json_average));
+    json_root["frames"] = picojson::value(std::move(json_frames));
+    return picojson::value(std::move(json_root)).serialize(true);
+  }
+
+  bool HasLoadedFile() const { return m_frames_per_loop != 0; }
+
+private:
+  static std::string GetStageKey(size_t stage)
+  {
+    return std::string(FrameProfiler::GetStageName(static_cast<FrameProfiler::Stage>(stage))) +
+           "_us";
+  }
+
+  const u32 m_loops;
+  std::atomic<u32> m_frames_per_loop = 0;
+  u64 m_presented_frames = 0;
+  Common::EventHook m_after_present_event;
+};
+
+// --cpu-bench: runs a game or movie on the Null video backend as fast as possible for a number of
+// emulated frames, to measure the CPU side of emulation on machines without a GPU
+class CpuBenchmark
+{
+public:
+  // Upper bounds of the frame time histogram buckets, the last bucket has no bound
+  static constexpr std::array<u64, 7> HISTOGRAM_BOUNDS_US = {1000,  2000,  4000,  8333,
+                                                             16667, 33333, 66667};
+  static constexpr int SAVESTATE_RUNS = 5;
+
+  explicit CpuBenchmark(u32 frames) : m_frames(frames)
+  {
+    Config::SetCurrent(Config::MAIN_GFX_BACKEND, "Null");
+    Config::SetCurrent(Config::MAIN_AUDIO_BACKEND, BACKEND_NULLSOUND);
+    Config::SetCurrent(Config::MAIN_DUMP_AUDIO, false);
+    Config::SetCurrent(Config::MAIN_EMULATION_SPEED, 0.0f);
+    Config::SetCurrent(Config::MAIN_MOVIE_PAUSE_MOVIE, false);
+
+    // Every VI field counts as an emulated frame, whether it shows a new XFB or not
+    m_before_present_event = BeforePresentEvent::Register(
+        [this](const PresentInfo& info) { OnField(info); }, "CpuBenchmark");
+  }
+
+  CpuBenchmark(const CpuBenchmark&) = delete;
+  CpuBenchmark& operator=(const CpuBenchmark&) = delete;
+
+  // Call once emulation has stopped
+  std::string GetReport() const
+  {
+    // Booting is left out, the measurement starts at the first field
+    const double host_seconds = std::chrono::duration<double>(m_last_field - m_first_field).count();
+    const u64 emulated_ticks = m_last_ticks - m_first_ticks;
+    const double emulated_seconds =
+        m_ticks_per_second != 0 ? double(emulated_ticks) / m_ticks_per_second : 0.0;
+    const u64 measured_frames = m_frame_times_us.size();
+
+    picojson::array json_histogram;
+    for (size_t i = 0; i <= HISTOGRAM_BOUNDS_US.size(); i++)
+    {
+      const u64 lower = i == 0 ? 0 : HISTOGRAM_BOUNDS_US[i - 1];
+      const u64 upper = i < HISTOGRAM_BOUNDS_US.size() ? HISTOGRAM_BOUNDS_US[i] :
+                                                         std::numeric_limits<u64>::max();
+      const auto count = std::count_if(m_frame_times_us.begin(), m_frame_times_us.end(),
+                                       [&](u64 time) { return time >= lower && time < upper; });
+
+      picojson::object json_bucket;
+      json_bucket["min_us"] = picojson::value(double(lower));
+      if (i < HISTOGRAM_BOUNDS_US.size())
+        json_bucket["max_us"] = picojson::value(double(upper));
+      json_bucket["frames"] = picojson::value(double(count));
+      json_histogram.emplace_back(std::move(json_bucket));
+    }
+
+    picojson::value json_counters;
+    picojson::parse(json_counters, Common::FormatCountersAsJSON());
+
+    picojson::object json_root;
+    json_root["frames"] = picojson::value(double(measured_frames));
+    json_root["host_seconds"] = picojson::value(host_seconds);
+    json_root["emulated_seconds"] = picojson::value(emulated_seconds);
+    json_root["speed"] =
+        picojson::value(host_seconds > 0.0 ? emulated_seconds / host_seconds : 0.0);
+    // The JITs count cycles rather than instructions, so this is the emulated clock rate that was
+    // reached. It is comparable between runs of the same game.
+    json_root["emulated_mhz"] =
+        picojson::value(host_seconds > 0.0 ? emulated_ticks / host_seconds / 1000000.0 : 0.0);
+    json_root["average_frame_time_us"] =
+        picojson::value(measured_frames != 0 ? host_seconds * 1000000.0 / measured_frames : 0.0);
+    json_root["frame_time_histogram"] = picojson::value(std::move(json_histogram));
+    json_root["peak_rss_bytes"] = picojson::value(double(GetPeakResidentBytes()));
+    if (m_savestate_bytes != 0)
+    {
+      picojson::object json_savestate;
+      json_savestate["size_bytes"] = picojson::value(double(m_savestate_bytes));
+      json_savestate["save_ms"] = picojson::value(m_savestate_save_ms);
+      json_savestate["load_ms"] = picojson::value(m_savestate_load_ms);
+      json_root["savestate"] = picojson::value(std::move(json_savestate));
+    }
+    json_root["counters"] = std::move(json_counters);
+    return picojson::value(std::move(json_root)).serialize(true);
+  }
+
+  bool HasRun() const { return !m_frame_times_us.empty(); }
+
+  // Call on the host thread once the frames have been emulated, before emulation is stopped.
+  // Saves and loads a savestate in memory a few times.
+  void MeasureSavestates()
+  {
+    std::vector<u8> buffer;
+    const auto save_start = std::chrono::steady_clock::now();
+    for (int i = 0; i < SAVESTATE_RUNS; i++)
+    {
+      if (!State::SaveToBuffer(buffer))
+        return;
+    }
+    const auto load_start = std::chrono::steady_clock::now();
+    for (int i = 0; i < SAVESTATE_RUNS; i++)
+    {
+      if (!State::LoadFromBuffer(buffer))
+        return;
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    m_savestate_bytes = buffer.size();
+    m_savestate_save_ms =
+        std::chrono::duration<double, std::milli>(load_start - save_start).count() / SAVESTATE_RUNS;
+    m_savestate_load_ms =
+        std::chrono::duration<double, std::milli>(end - load_start).count() / SAVESTATE_RUNS;
+  }
+
+private:
+  // Called on the GPU thread
+  void OnField(const PresentInfo& info)
+  {
+    // Fields after the last one, like the ones while savestates are measured, aren't counted
+    if (m_fields > m_frames)
+      return;
+
+    const auto now = std::chrono::steady_clock::now();
+    if (m_fields == 0)
+    {
+      m_first_field = now;
+      m_first_ticks = info.emulated_timestamp;
+      m_ticks_per_second = SystemTimers::GetTicksPerSecond();
+    }
+    else
+    {
+      const auto frame_time =
+          std::chrono::duration_cast<std::chrono::microseconds>(now - m_last_field);
+      m_frame_times_us.push_back(static_cast<u64>(frame_time.count()));
+    }
+    m_last_field = now;
+    m_last_ticks = info.emulated_timestamp;
+
+    if (++m_fields == u64(m_frames) + 1)
+      s_platform->Stop();
+  }
+
+  static u64 GetPeakResidentBytes()
+  {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters{};
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+      return 0;
+    return counters.PeakWorkingSetSize;
+#else
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+      return 0;
+#ifdef __APPLE__
+    return static_cast<u64>(usage.ru_maxrss);
+#else
+    // Linux and the BSDs report kilobytes
+    return static_cast<u64>(usage.ru_maxrss) * 1024;
+#endif
+#endif
+  }
+
+  const u32 m_frames;
+  u64 m_fields = 0;
+  std::chrono::steady_clock::time_point m_first_field;
+  std::chrono::steady_clock::time_point m_last_field;
+  u64 m_first_ticks = 0;
+  u64 m_last_ticks = 0;
+  u32 m_ticks_per_second = 0;
+  std::vector<u64> m_frame_times_us;
+  size_t m_savestate_bytes = 0;
+  double m_savestate_save_ms = 0.0;
+  double m_savestate_load_ms = 0.0;
+  Common::EventHook m_before_present_event;
+};
+
 #ifdef _WIN32
 #define main app_main
 #endif
@@ -210,6 +496,33 @@ int main(int argc, char* argv[])
             "macos"
 #endif
       });
+  parser->add_option("--fifo-bench")
+      .action("store")
+      .metavar("<loops>")
+      .type("int")
+      .help("Play the given FIFO log this many times at unlimited speed, then report the time "
+            "spent in each frame as JSON");
+  parser->add_option("--fifo-bench-output")
+      .action("store")
+      .metavar("<file>")
+      .type("string")
+      .help("Write the FIFO benchmark report to this file instead of the standard output");
+  parser->add_option("--cpu-bench")
+      .action("store")
+      .metavar("<frames>")
+      .type("int")
+      .help("Run the game or movie with the Null video backend and no audio at unlimited speed for "
+            "this many emulated frames, then report the emulation speed and the time it takes to "
+            "save and load a savestate as JSON");
+  parser->add_option("--cpu-bench-output")
+      .action("store")
+      .metavar("<file>")
+      .type("string")
+      .help("Write the CPU benchmark report to this file instead of the standard output");
+  parser->add_option("--verify-movie")
+      .action("store_true")
+      .help("Play the movie given with --movie with the Null video backend and no audio output at "
+            "unlimited speed, and report the first frame where its state hashes don't match");
 
   optparse::Values& options = CommandLineParse::ParseArguments(parser.get(), argc, argv);
   std::vector<std::string> args = parser->args();
@@ -256,11 +569,47 @@ int main(int argc, char* argv[])
     return 0;
   }
 
+  std::optional<u32> fifo_bench_loops;
+  if (options.is_set("fifo_bench"))
+  {
+    const int loops = static_cast<int>(options.get("fifo_bench"));
+    if (loops <= 0 || !boot || !std::holds_alternative<BootParameters::DFF>(boot->parameters))
+    {
+      fprintf(stderr, "--fifo-bench needs a FIFO log to play and a positive number of loops\n");
+      return 1;
+    }
+    fifo_bench_loops = static_cast<u32>(loops);
+  }
+
+  std::optional<u32> cpu_bench_frames;
+  if (options.is_set("cpu_bench"))
+  {
+    const int frames = static_cast<int>(options.get("cpu_bench"));
+    if (frames <= 0 || fifo_bench_loops)
+    {
+      fprintf(stderr, "--cpu-bench needs a positive number of frames and can't be combined with "
+                      "--fifo-bench\n");
+      return 1;
+    }
+    cpu_bench_frames = static_cast<u32>(frames);
+  }
+
+  const bool verify_movie = static_cast<bool>(options.get("verify_movie"));
+  if (verify_movie && !options.is_set("movie"))
+  {
+    fprintf(stderr, "--verify-movie needs a movie to play\n");
+    return 1;
+  }
+
   std::string user_directory;
   if (options.is_set("user"))
     user_directory = static_cast<const char*>(options.get("user"));
 
-  s_platform = GetPlatform(options);
+  // Verification and the CPU benchmark don't show anything, so they don't need a window
+  if ((verify_movie || cpu_bench_frames) && !options.is_set("platform"))
+    s_platform = Platform::CreateHeadlessPlatform();
+  else
+    s_platform = GetPlatform(options);
   if (!s_platform || !s_platform->Init())
   {
     fprintf(stderr, "No platform found, or failed to initialize.\n");
@@ -304,6 +653,40 @@ int main(int argc, char* argv[])
 
   DolphinAnalytics::Instance().ReportDolphinStart("nogui");
 
+  std::optional<FifoBenchmark> fifo_benchmark;
+  if (fifo_bench_loops)
+    fifo_benchmark.emplace(*fifo_bench_loops);
+
+  std::optional<CpuBenchmark> cpu_benchmark;
+  if (cpu_bench_frames)
+    cpu_benchmark.emplace(*cpu_bench_frames);
+
+  if (verify_movie)
+  {
+    Config::SetCurrent(Config::MAIN_GFX_BACKEND, "Null");
+    Config::SetCurrent(Config::MAIN_AUDIO_BACKEND, BACKEND_NULLSOUND);
+    Config::SetCurrent(Config::MAIN_EMULATION_SPEED, 0.0f);
+    Config::SetCurrent(Config::MAIN_MOVIE_PAUSE_MOVIE, false);
+    Movie::SetReadOnly(true);
+    Movie::SetVerificationEndCallback([] { s_platform->Stop(); });
+  }
+
+  if (options.is_set("movie"))
+  {
+    const std::string movie_path = static_cast<const char*>(options.get("movie"));
+    std::optional<std::string> movie_save_state_path;
+    if (!Movie::PlayInput(movie_path, &movie_save_state_path))
+    {
+      fprintf(stderr, "Could not play the movie %s\n", movie_path.c_str());
+      return 1;
+    }
+    if (movie_save_state_path)
+    {
+      boot->boot_session_data.SetSavestateData(std::move(movie_save_state_path),
+                                               DeleteSavestateAfterBoot::No);
+    }
+  }
+
   if (!BootManager::BootCore(std::move(boot), wsi))
   {
     fprintf(stderr, "Could not boot the specified file\n");
@@ -315,12 +698,82 @@ int main(int argc, char* argv[])
 #endif
 
   s_platform->MainLoop();
+  if (cpu_benchmark && cpu_benchmark->HasRun() && Core::IsRunning())
+    cpu_benchmark->MeasureSavestates();
   Core::Stop();
 
   Core::Shutdown();
+
+  int exit_code = 0;
+  if (verify_movie)
+  {
+    Movie::SetVerificationEndCallback(nullptr);
+    const Movie::StateHashVerification verification = Movie::GetStateHashVerification();
+    if (verification.first_divergent_frame)
+    {
+      fprintf(stdout, "Desync: state hash mismatch at frame %llu after %llu matching hashes\n",
+              static_cast<unsigned long long>(*verification.first_divergent_frame),
+              static_cast<unsigned long long>(verification.checked_hashes - 1));
+      exit_code = 1;
+    }
+    else if (verification.total_hashes == 0)
+    {
+      fprintf(stderr, "The movie contains no state hashes to verify\n");
+      exit_code = 2;
+    }
+    else
+    {
+      fprintf(stdout, "In sync: %llu of %llu state hashes matched\n",
+              static_cast<unsigned long long>(verification.checked_hashes),
+              static_cast<unsigned long long>(verification.total_hashes));
+      // Stopping before the end of the movie leaves hashes unchecked
+      if (verification.checked_hashes < verification.total_hashes)
+        exit_code = 1;
+    }
+  }
+
+  if (fifo_benchmark)
+  {
+    if (!fifo_benchmark->HasLoadedFile())
+    {
+      fprintf(stderr, "The FIFO log could not be loaded\n");
+    }
+    else if (options.is_set("fifo_bench_output"))
+    {
+      const std::string path = static_cast<const char*>(options.get("fifo_bench_output"));
+      if (!File::WriteStringToFile(path, fifo_benchmark->GetReport()))
+        fprintf(stderr, "Could not write the FIFO benchmark report to %s\n", path.c_str());
+    }
+    else
+    {
+      fprintf(stdout, "%s\n", fifo_benchmark->GetReport().c_str());
+    }
+    fifo_benchmark.reset();
+  }
+
+  if (cpu_benchmark)
+  {
+    if (!cpu_benchmark->HasRun())
+    {
+      fprintf(stderr, "No frames were emulated for the CPU benchmark\n");
+      exit_code = 1;
+    }
+    else if (options.is_set("cpu_bench_output"))
+    {
+      const std::string path = static_cast<const char*>(options.get("cpu_bench_output"));
+      if (!File::WriteStringToFile(path, cpu_benchmark->GetReport()))
+        fprintf(stderr, "Could not write the CPU benchmark report to %s\n", path.c_str());
+    }
+    else
+    {
+      fprintf(stdout, "%s\n", cpu_benchmark->GetReport().c_str());
+    }
+    cpu_benchmark.reset();
+  }
+
   s_platform.reset();
 
-  return 0;
+  return exit_code;
 }
 
 #ifdef _WIN32
@@ -57,6 +57,12 @@ void AdvancedWidget::CreateWidgets()
   m_show_graphs = new ConfigBool(tr("Show Performance Graphs"), Config::GFX_SHOW_GRAPHS);
   m_show_speed = new ConfigBool(tr("Show % Speed"), Config::GFX_SHOW_SPEED);
   m_show_speed_colors = new ConfigBool(tr("Show Speed Colors"), Config::GFX_SHOW_SPEED_COLORS);
+  m_show_disc_cache_stats =
+      new ConfigBool(tr("Show Disc Cache Statistics"), Config::GFX_SHOW_DISC_CACHE_STATS);
+  m_show_shader_compiler_stats = new ConfigBool(tr("Show Shader Compiler Statistics"),
+                                                Config::GFX_SHOW_SHADER_COMPILER_STATS);
+  m_show_audio_stats =
+      new ConfigBool(tr("Show Audio Buffer Statistics"), Config::GFX_SHOW_AUDIO_STATS);
   m_perf_samp_window = new ConfigInteger(0, 10000, Config::GFX_PERF_SAMP_WINDOW, 100);
   m_perf_samp_window->SetTitle(tr("Performance Sample Window (ms)"));
   m_log_render_time =
@@ -72,6 +78,9 @@ void AdvancedWidget::CreateWidgets()
   performance_layout->addWidget(m_perf_samp_window, 3, 1);
   performance_layout->addWidget(m_log_render_time, 4, 0);
   performance_layout->addWidget(m_show_speed_colors, 4, 1);
+  performance_layout->addWidget(m_show_disc_cache_stats, 5, 0);
+  performance_layout->addWidget(m_show_shader_compiler_stats, 5, 1);
+  performance_layout->addWidget(m_show_audio_stats, 6, 0);
 
   // Debugging
   auto* debugging_box = new QGroupBox(tr("Debugging"));
@@ -182,9 +191,18 @@ void AdvancedWidget::CreateWidgets()
       new ConfigBool(tr("Defer EFB Cache Invalidation"), Config::GFX_HACK_EFB_DEFER_INVALIDATION);
   m_manual_texture_sampling =
       new ConfigBool(tr("Manual Texture Sampling"), Config::GFX_HACK_FAST_TEXTURE_SAMPLING, true);
+  m_predictive_efb_readback =
+      new ConfigBool(tr("Predictive EFB Readback"), Config::GFX_HACK_EFB_PREDICTIVE_READBACK);
+  m_bbox_cpu_estimate =
+      new ConfigBool(tr("Estimate Bounding Box on the CPU"), Config::GFX_HACK_BBOX_CPU_ESTIMATE);
+  m_efb_copy_scale_by_use =
+      new ConfigBool(tr("Scale EFB Copies by Use"), Config::GFX_HACK_EFB_COPY_SCALE_BY_USE);
 
   experimental_layout->addWidget(m_defer_efb_access_invalidation, 0, 0);
   experimental_layout->addWidget(m_manual_texture_sampling, 0, 1);
+  experimental_layout->addWidget(m_predictive_efb_readback, 1, 0);
+  experimental_layout->addWidget(m_bbox_cpu_estimate, 1, 1);
+  experimental_layout->addWidget(m_efb_copy_scale_by_use, 2, 0);
 
   main_layout->addWidget(performance_box);
   main_layout->addWidget(debugging_box);
@@ -274,6 +292,22 @@ void AdvancedWidget::AddDescriptions()
       QT_TR_NOOP("Changes the color of the FPS counter depending on emulation speed."
                  "<br><br><dolphin_emphasis>If unsure, leave this "
                  "checked.</dolphin_emphasis>");
+  static const char TR_SHOW_DISC_CACHE_STATS_DESCRIPTION[] =
+      QT_TR_NOOP("Shows how many reads of WIA and RVZ disc images were served from already "
+                 "decompressed data, and how many reads of plain disc images are currently "
+                 "waiting for the storage device, along with the peak since the disc was "
+                 "inserted.<br><br><dolphin_emphasis>If unsure, leave this "
+                 "unchecked.</dolphin_emphasis>");
+  static const char TR_SHOW_SHADER_COMPILER_STATS_DESCRIPTION[] =
+      QT_TR_NOOP("Shows how many shaders are waiting to be compiled, how many of those are "
+                 "precompiled in the background and by how many threads at most, and how long "
+                 "shaders needed for drawing take to compile.<br><br>"
+                 "<dolphin_emphasis>If unsure, leave this unchecked.</dolphin_emphasis>");
+  static const char TR_SHOW_AUDIO_STATS_DESCRIPTION[] =
+      QT_TR_NOOP("Shows how many milliseconds of audio are buffered for the audio backend, how "
+                 "many the mixer aims for, and how often the buffer ran out while a game was "
+                 "playing audio.<br><br><dolphin_emphasis>If unsure, leave this "
+                 "unchecked.</dolphin_emphasis>");
   static const char TR_PERF_SAMP_WINDOW_DESCRIPTION[] =
       QT_TR_NOOP("The amount of time the FPS and VPS counters will sample over."
                  "<br><br>The higher the value, the more stable the FPS/VPS counter will be, "
@@ -381,6 +415,22 @@ void AdvancedWidget::AddDescriptions()
       "<br><br>May improve performance in some games which rely on CPU EFB Access at the cost "
       "of stability.<br><br><dolphin_emphasis>If unsure, leave this "
       "unchecked.</dolphin_emphasis>");
+  static const char TR_PREDICTIVE_EFB_READBACK_DESCRIPTION[] = QT_TR_NOOP(
+      "Only invalidates the parts of the EFB access cache that were drawn to, and starts reading "
+      "back the parts that were read in the last frame right after they are drawn, instead of "
+      "waiting for the GPU when they are read.<br><br>May improve performance in games which "
+      "rely on CPU EFB Access. Has no effect if EFB cache invalidation is deferred."
+      "<br><br><dolphin_emphasis>If unsure, leave this unchecked.</dolphin_emphasis>");
+  static const char TR_BBOX_CPU_ESTIMATE_DESCRIPTION[] = QT_TR_NOOP(
+      "Estimates on the CPU which parts of the screen a draw can reach, so that bounding box "
+      "values the draw can't have changed are read without waiting for the GPU.<br><br>May "
+      "improve performance in games which use Bounding Box. Has no effect if Bounding Box is "
+      "disabled.<br><br><dolphin_emphasis>If unsure, leave this unchecked.</dolphin_emphasis>");
+  static const char TR_EFB_COPY_SCALE_BY_USE_DESCRIPTION[] = QT_TR_NOOP(
+      "Makes EFB copies at a lower resolution when the previous copy to the same address was only "
+      "drawn small, such as the steps of a bloom effect.<br><br>May improve GPU performance at "
+      "high internal resolutions. Has no effect if Scaled EFB Copy is disabled."
+      "<br><br><dolphin_emphasis>If unsure, leave this unchecked.</dolphin_emphasis>");
   static const char TR_MANUAL_TEXTURE_SAMPLING_DESCRIPTION[] = QT_TR_NOOP(
       "Use a manual implementation of texture sampling instead of the graphics backend's built-in "
       "functionality.<br><br>"
@@ -413,6 +463,9 @@ void AdvancedWidget::AddDescriptions()
   m_show_speed->SetDescription(tr(TR_SHOW_SPEED_DESCRIPTION));
   m_log_render_time->SetDescription(tr(TR_LOG_RENDERTIME_DESCRIPTION));
   m_show_speed_colors->SetDescription(tr(TR_SHOW_SPEED_COLORS_DESCRIPTION));
+  m_show_disc_cache_stats->SetDescription(tr(TR_SHOW_DISC_CACHE_STATS_DESCRIPTION));
+  m_show_shader_compiler_stats->SetDescription(tr(TR_SHOW_SHADER_COMPILER_STATS_DESCRIPTION));
+  m_show_audio_stats->SetDescription(tr(TR_SHOW_AUDIO_STATS_DESCRIPTION));
 
   m_enable_wireframe->SetDescription(tr(TR_WIREFRAME_DESCRIPTION));
   m_show_statistics->SetDescription(tr(TR_SHOW_STATS_DESCRIPTION));
@@ -453,4 +506,7 @@ void AdvancedWidget::AddDescriptions()
 #endif
   m_defer_efb_access_invalidation->SetDescription(tr(TR_DEFER_EFB_ACCESS_INVALIDATION_DESCRIPTION));
   m_manual_texture_sampling->SetDescription(tr(TR_MANUAL_TEXTURE_SAMPLING_DESCRIPTION));
+  m_predictive_efb_readback->SetDescription(tr(TR_PREDICTIVE_EFB_READBACK_DESCRIPTION));
+  m_bbox_cpu_estimate->SetDescription(tr(TR_BBOX_CPU_ESTIMATE_DESCRIPTION));
+  m_efb_copy_scale_by_use->SetDescription(tr(TR_EFB_COPY_SCALE_BY_USE_DESCRIPTION));
 }
@@ -42,6 +42,9 @@ private:
   ConfigBool* m_show_graphs;
   ConfigBool* m_show_speed;
   ConfigBool* m_show_speed_colors;
+  ConfigBool* m_show_disc_cache_stats;
+  ConfigBool* m_show_shader_compiler_stats;
+  ConfigBool* m_show_audio_stats;
   ConfigInteger* m_perf_samp_window;
   ConfigBool* m_log_render_time;
 
@@ -75,4 +78,7 @@ private:
   // Experimental
   ConfigBool* m_defer_efb_access_invalidation;
   ConfigBool* m_manual_texture_sampling;
+  ConfigBool* m_predictive_efb_readback;
+  ConfigBool* m_bbox_cpu_estimate;
+  ConfigBool* m_efb_copy_scale_by_use;
 };
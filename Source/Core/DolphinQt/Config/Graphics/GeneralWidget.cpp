@@ -59,6 +59,7 @@ void GeneralWidget::CreateWidgets()
                        Config::GFX_ASPECT_RATIO);
   m_adapter_combo = new ToolTipComboBox;
   m_enable_vsync = new ConfigBool(tr("V-Sync"), Config::GFX_VSYNC);
+  m_enable_frame_pacing = new ConfigBool(tr("Frame Pacing"), Config::GFX_FRAME_PACING);
   m_enable_fullscreen = new ConfigBool(tr("Start in Fullscreen"), Config::MAIN_FULLSCREEN);
 
   m_video_box->setLayout(m_video_layout);
@@ -80,6 +81,7 @@ void GeneralWidget::CreateWidgets()
 
   m_video_layout->addWidget(m_enable_vsync, 4, 0);
   m_video_layout->addWidget(m_enable_fullscreen, 4, 1);
+  m_video_layout->addWidget(m_enable_frame_pacing, 5, 0);
 
   // Other
   auto* m_options_box = new QGroupBox(tr("Other"));
@@ -218,6 +220,12 @@ void GeneralWidget::AddDescriptions()
       "if emulation speed is below 100%.<br><br><dolphin_emphasis>If unsure, leave "
       "this "
       "unchecked.</dolphin_emphasis>");
+  static const char TR_FRAME_PACING_DESCRIPTION[] = QT_TR_NOOP(
+      "With V-Sync, runs emulation as late as possible while still finishing every frame "
+      "before the display refreshes. This reduces input latency by up to a few milliseconds "
+      "without changing the emulation speed.<br><br>Has no effect when V-Sync is disabled. "
+      "If Show Performance Graphs is enabled, a graph of the present latency is shown."
+      "<br><br><dolphin_emphasis>If unsure, leave this unchecked.</dolphin_emphasis>");
   static const char TR_SHOW_NETPLAY_PING_DESCRIPTION[] = QT_TR_NOOP(
       "Shows the player's maximum ping while playing on "
       "NetPlay.<br><br><dolphin_emphasis>If unsure, leave this unchecked.</dolphin_emphasis>");
@@ -263,6 +271,8 @@ void GeneralWidget::AddDescriptions()
 
   m_enable_vsync->SetDescription(tr(TR_VSYNC_DESCRIPTION));
 
+  m_enable_frame_pacing->SetDescription(tr(TR_FRAME_PACING_DESCRIPTION));
+
   m_enable_fullscreen->SetDescription(tr(TR_FULLSCREEN_DESCRIPTION));
 
   m_show_ping->SetDescription(tr(TR_SHOW_NETPLAY_PING_DESCRIPTION));
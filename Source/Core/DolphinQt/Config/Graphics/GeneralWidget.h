@@ -42,6 +42,7 @@ private:
   ToolTipComboBox* m_adapter_combo;
   ConfigChoice* m_aspect_combo;
   ConfigBool* m_enable_vsync;
+  ConfigBool* m_enable_frame_pacing;
   ConfigBool* m_enable_fullscreen;
 
   // Options
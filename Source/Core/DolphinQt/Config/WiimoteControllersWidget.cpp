@@ -12,6 +12,8 @@
 #include <QPushButton>
 #include <QRadioButton>
 #include <QScreen>
+#include <QStringList>
+#include <QTimer>
 #include <QVBoxLayout>
 
 #include <map>
@@ -49,6 +51,11 @@ WiimoteControllersWidget::WiimoteControllersWidget(QWidget* parent) : QWidget(pa
   connect(&Settings::Instance(), &Settings::EmulationStateChanged, this,
           [this](Core::State state) { LoadSettings(state); });
   LoadSettings(Core::GetState());
+
+  auto* latency_timer = new QTimer(this);
+  connect(latency_timer, &QTimer::timeout, this, &WiimoteControllersWidget::UpdateReportLatency);
+  latency_timer->start(1000);
+  UpdateReportLatency();
 }
 
 void WiimoteControllersWidget::UpdateBluetoothAvailableStatus()
@@ -146,6 +153,11 @@ void WiimoteControllersWidget::CreateLayout()
     m_wiimote_layout->addWidget(wm_label, wm_row, 1);
     m_wiimote_layout->addWidget(wm_box, wm_row, 2);
     m_wiimote_layout->addWidget(wm_button, wm_row, 3);
+
+    auto* latency_label = m_wiimote_latency_labels[i] = new QLabel();
+    latency_label->setToolTip(tr("How long Dolphin waited between two input reports of this real "
+                                 "Wii Remote.\nLong waits show a stalling Bluetooth connection."));
+    m_wiimote_layout->addWidget(latency_label, m_wiimote_layout->rowCount(), 2, 1, 2);
   }
 
   m_wiimote_layout->addWidget(m_wiimote_real_balance_board, m_wiimote_layout->rowCount(), 1, 1, -1);
@@ -266,6 +278,43 @@ void WiimoteControllersWidget::OnWiimoteConfigure(size_t index)
   window->show();
 }
 
+void WiimoteControllersWidget::UpdateReportLatency()
+{
+  if (!isVisible())
+    return;
+
+  using WiimoteReal::ReportLatencyHistogram;
+
+  for (size_t i = 0; i < m_wiimote_latency_labels.size(); i++)
+  {
+    const auto histogram = WiimoteReal::GetReportLatencyHistogram(static_cast<unsigned int>(i));
+    u64 total = 0;
+    if (histogram)
+    {
+      for (const u64 count : histogram->counts)
+        total += count;
+    }
+
+    m_wiimote_latency_labels[i]->setHidden(total == 0);
+    if (total == 0)
+      continue;
+
+    const auto& limits = ReportLatencyHistogram::BUCKET_LIMITS_MS;
+    QStringList buckets;
+    for (size_t bucket = 0; bucket < histogram->counts.size(); bucket++)
+    {
+      const double percent = 100.0 * histogram->counts[bucket] / total;
+      if (bucket < limits.size())
+        buckets.append(tr("< %1 ms: %2%").arg(limits[bucket]).arg(percent, 0, 'f', 1));
+      else
+        buckets.append(tr("%1+ ms: %2%").arg(limits.back()).arg(percent, 0, 'f', 1));
+    }
+
+    m_wiimote_latency_labels[i]->setText(
+        tr("Report latency: %1").arg(buckets.join(QStringLiteral(", "))));
+  }
+}
+
 void WiimoteControllersWidget::LoadSettings(Core::State state)
 {
   for (size_t i = 0; i < m_wiimote_groups.size(); i++)
@@ -35,6 +35,7 @@ private:
   void OnBluetoothPassthroughResetPressed();
   void OnWiimoteRefreshPressed();
   void OnWiimoteConfigure(size_t index);
+  void UpdateReportLatency();
 
   void CreateLayout();
   void ConnectWidgets();
@@ -46,6 +47,7 @@ private:
   std::array<QComboBox*, 4> m_wiimote_boxes;
   std::array<QPushButton*, 4> m_wiimote_buttons;
   std::array<QHBoxLayout*, 4> m_wiimote_groups;
+  std::array<QLabel*, 4> m_wiimote_latency_labels;
   std::array<QLabel*, 2> m_wiimote_pt_labels;
 
   QRadioButton* m_wiimote_emu;
@@ -47,6 +47,8 @@ struct CodeViewBranch
   u32 dst_addr = 0;
   u32 indentation = 0;
   bool is_link = false;
+
+  bool operator==(const CodeViewBranch&) const = default;
 };
 
 constexpr u32 WIDTH_PER_BRANCH_ARROW = 16;
@@ -129,6 +131,9 @@ constexpr double SCROLL_FRACTION_DEGREES = 15.;
 
 constexpr size_t VALID_BRANCH_LENGTH = 10;
 
+// Enough for many screens full of rows. The cache is cleared when it grows past this.
+constexpr size_t MAX_DISASSEMBLY_CACHE_SIZE = 0x4000;
+
 constexpr int CODE_VIEW_COLUMN_BREAKPOINT = 0;
 constexpr int CODE_VIEW_COLUMN_ADDRESS = 1;
 constexpr int CODE_VIEW_COLUMN_INSTRUCTION = 2;
@@ -189,9 +194,8 @@ CodeViewWidget::CodeViewWidget() : m_system(Core::System::GetInstance())
 
 CodeViewWidget::~CodeViewWidget() = default;
 
-static u32 GetBranchFromAddress(const Core::CPUThreadGuard& guard, u32 addr)
+static u32 GetBranchFromDisassembly(const std::string& disasm)
 {
-  std::string disasm = guard.GetSystem().GetPowerPC().GetDebugInterface().Disassemble(&guard, addr);
   size_t pos = disasm.find("->0x");
 
   if (pos == std::string::npos)
@@ -201,6 +205,12 @@ static u32 GetBranchFromAddress(const Core::CPUThreadGuard& guard, u32 addr)
   return std::stoul(hex, nullptr, 16);
 }
 
+static u32 GetBranchFromAddress(const Core::CPUThreadGuard& guard, u32 addr)
+{
+  return GetBranchFromDisassembly(
+      guard.GetSystem().GetPowerPC().GetDebugInterface().Disassemble(&guard, addr));
+}
+
 void CodeViewWidget::FontBasedSizing()
 {
   // just text width is too small with some fonts, so increase by a bit
@@ -248,6 +258,52 @@ static bool IsBranchInstructionWithLink(std::string_view ins)
          ins.ends_with("l-") || ins.ends_with("la-");
 }
 
+const CodeViewWidget::DisassembledInstruction&
+CodeViewWidget::GetDisassembledInstruction(const Core::CPUThreadGuard* guard, u32 addr)
+{
+  // The disassembly only depends on the address and the instruction, so writes to memory don't
+  // need to be tracked. Rows that aren't RAM, or where the core is running, aren't cached.
+  std::optional<u64> key;
+  if (guard && PowerPC::MMU::HostIsRAMAddress(*guard, addr))
+    key = (u64{addr} << 32) | PowerPC::MMU::HostRead_Instruction(*guard, addr);
+
+  if (key)
+  {
+    const auto it = m_disassembly_cache.find(*key);
+    if (it != m_disassembly_cache.end())
+      return it->second;
+  }
+
+  const std::string disas = m_system.GetPowerPC().GetDebugInterface().Disassemble(guard, addr);
+  const auto split = disas.find('\t');
+  const std::string ins = (split == std::string::npos ? disas : disas.substr(0, split));
+  const std::string param = (split == std::string::npos ? "" : disas.substr(split + 1));
+
+  DisassembledInstruction instruction;
+  // Adds whitespace and a minimum size to ins and param. Helps to prevent frequent resizing while
+  // scrolling.
+  instruction.ins = QStringLiteral("%1").arg(QString::fromStdString(ins), -7, QLatin1Char(' '));
+  instruction.param =
+      QStringLiteral("%1").arg(QString::fromStdString(param), -19, QLatin1Char(' '));
+  instruction.is_blr = ins == "blr";
+  instruction.is_link = IsBranchInstructionWithLink(ins);
+
+  // look for hex strings to decode branches
+  const size_t pos = param.find("0x");
+  if (pos != std::string::npos && param.size() - pos == VALID_BRANCH_LENGTH)
+    instruction.branch_addr = GetBranchFromDisassembly(disas);
+
+  if (!key)
+  {
+    m_uncached_instruction = std::move(instruction);
+    return m_uncached_instruction;
+  }
+
+  if (m_disassembly_cache.size() >= MAX_DISASSEMBLY_CACHE_SIZE)
+    m_disassembly_cache.clear();
+  return m_disassembly_cache.emplace(*key, std::move(instruction)).first->second;
+}
+
 static bool IsInstructionLoadStore(std::string_view ins)
 {
   // Could add check for context address being near PC, because we need gprs to be correct for the
@@ -318,23 +374,13 @@ void CodeViewWidget::Update(const Core::CPUThreadGuard* guard)
     auto* bp_item = new QTableWidgetItem;
     auto* addr_item = new QTableWidgetItem(QStringLiteral("%1").arg(addr, 8, 16, QLatin1Char('0')));
 
-    std::string disas = debug_interface.Disassemble(guard, addr);
-    auto split = disas.find('\t');
-
-    std::string ins = (split == std::string::npos ? disas : disas.substr(0, split));
-    std::string param = (split == std::string::npos ? "" : disas.substr(split + 1));
+    const DisassembledInstruction& instruction = GetDisassembledInstruction(guard, addr);
     std::string desc = debug_interface.GetDescription(addr);
 
-    // Adds whitespace and a minimum size to ins and param. Helps to prevent frequent resizing while
-    // scrolling.
-    const QString ins_formatted =
-        QStringLiteral("%1").arg(QString::fromStdString(ins), -7, QLatin1Char(' '));
-    const QString param_formatted =
-        QStringLiteral("%1").arg(QString::fromStdString(param), -19, QLatin1Char(' '));
     const QString desc_formatted = QStringLiteral("%1   ").arg(QString::fromStdString(desc));
 
-    auto* ins_item = new QTableWidgetItem(ins_formatted);
-    auto* param_item = new QTableWidgetItem(param_formatted);
+    auto* ins_item = new QTableWidgetItem(instruction.ins);
+    auto* param_item = new QTableWidgetItem(instruction.param);
     auto* description_item = new QTableWidgetItem(desc_formatted);
     auto* branch_item = new QTableWidgetItem();
 
@@ -354,28 +400,20 @@ void CodeViewWidget::Update(const Core::CPUThreadGuard* guard)
       }
     }
 
-    // look for hex strings to decode branches
-    std::string hex_str;
-    size_t pos = param.find("0x");
-    if (pos != std::string::npos)
+    if (guard && instruction.branch_addr && desc != "---")
     {
-      hex_str = param.substr(pos);
-    }
-
-    if (guard && hex_str.length() == VALID_BRANCH_LENGTH && desc != "---")
-    {
-      u32 branch_addr = GetBranchFromAddress(*guard, addr);
+      const u32 branch_addr = *instruction.branch_addr;
       CodeViewBranch& branch = m_branches.emplace_back();
       branch.src_addr = addr;
       branch.dst_addr = branch_addr;
-      branch.is_link = IsBranchInstructionWithLink(ins);
+      branch.is_link = instruction.is_link;
 
       description_item->setText(
           tr("--> %1").arg(QString::fromStdString(debug_interface.GetDescription(branch_addr))));
       param_item->setForeground(dark_theme ? QColor(255, 135, 255) : Qt::magenta);
     }
 
-    if (ins == "blr")
+    if (instruction.is_blr)
       ins_item->setForeground(dark_theme ? QColor(0xa0FFa0) : Qt::darkGreen);
 
     if (debug_interface.IsBreakpoint(addr))
@@ -422,6 +460,18 @@ void CodeViewWidget::CalculateBranchIndentation()
   if (rows < 1 || columns < 1)
     return;
 
+  // Refreshing without scrolling, e.g. when toggling a breakpoint, gives the same arrows
+  const u32 first_row_addr = AddressForRow(0);
+  if (m_branches == m_branch_layout_input && first_row_addr == m_branch_layout_addr &&
+      rows == m_branch_layout_rows)
+  {
+    m_branches = m_branch_layout;
+    return;
+  }
+  m_branch_layout_input = m_branches;
+  m_branch_layout_addr = first_row_addr;
+  m_branch_layout_rows = rows;
+
   // process in order of how much vertical space the drawn arrow would take up
   // so shorter arrows go further to the left
   const auto priority = [](const CodeViewBranch& b) {
@@ -513,6 +563,8 @@ void CodeViewWidget::CalculateBranchIndentation()
       add_branch_arrow(branch, 0x00000000, addr_zero_row, last_visible_addr);
     }
   }
+
+  m_branch_layout = m_branches;
 }
 
 u32 CodeViewWidget::GetAddress() const
@@ -3,8 +3,11 @@
 
 #pragma once
 
+#include <optional>
+#include <unordered_map>
 #include <vector>
 
+#include <QString>
 #include <QTableWidget>
 
 #include "Common/CommonTypes.h"
@@ -97,6 +100,18 @@ private:
   void OnReplaceInstruction();
   void OnRestoreInstruction();
 
+  // What is shown for an instruction, apart from the parts that depend on symbols
+  struct DisassembledInstruction
+  {
+    QString ins;
+    QString param;
+    std::optional<u32> branch_addr;
+    bool is_link = false;
+    bool is_blr = false;
+  };
+
+  const DisassembledInstruction& GetDisassembledInstruction(const Core::CPUThreadGuard* guard,
+                                                            u32 addr);
   void CalculateBranchIndentation();
 
   Core::System& m_system;
@@ -108,5 +123,15 @@ private:
 
   std::vector<CodeViewBranch> m_branches;
 
+  // Keyed by the address in the upper and the instruction in the lower 32 bits
+  std::unordered_map<u64, DisassembledInstruction> m_disassembly_cache;
+  DisassembledInstruction m_uncached_instruction;
+
+  // The last branches and rows that the arrows were laid out for, and the result
+  std::vector<CodeViewBranch> m_branch_layout_input;
+  std::vector<CodeViewBranch> m_branch_layout;
+  u32 m_branch_layout_addr = 0;
+  u32 m_branch_layout_rows = 0;
+
   friend class BranchDisplayDelegate;
 };
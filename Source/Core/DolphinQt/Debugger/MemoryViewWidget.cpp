@@ -14,7 +14,9 @@
 #include <QTableWidget>
 #include <QtGlobal>
 
+#include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <fmt/printf.h>
 
 #include "Common/Align.h"
@@ -39,6 +41,7 @@ constexpr int MISC_COLUMNS = 2;
 constexpr auto USER_ROLE_IS_ROW_BREAKPOINT_CELL = Qt::UserRole;
 constexpr auto USER_ROLE_CELL_ADDRESS = Qt::UserRole + 1;
 constexpr auto USER_ROLE_VALUE_TYPE = Qt::UserRole + 2;
+constexpr auto USER_ROLE_VALUE_CHANGED = Qt::UserRole + 3;
 
 // Numbers for the scrollbar. These affect how much big the draggable part of the scrollbar is, how
 // smooth it scrolls, and how much memory it traverses while dragging.
@@ -49,6 +52,14 @@ constexpr int SCROLLBAR_CENTER = SCROLLBAR_MAXIMUM / 2;
 
 const QString INVALID_MEMORY = QStringLiteral("-");
 
+template <typename T>
+static T ReadBigEndian(const u8* data)
+{
+  T value;
+  std::memcpy(&value, data, sizeof(T));
+  return Common::FromBigEndian(value);
+}
+
 class MemoryViewTable final : public QTableWidget
 {
 public:
@@ -395,6 +406,7 @@ void MemoryViewWidget::Update()
 
   const QSignalBlocker blocker(m_table);
   m_table->clearSelection();
+  m_cells_up_to_date = false;
 
   // Update addresses
   const u32 address = Common::AlignDown(m_address, m_alignment);
@@ -461,6 +473,22 @@ void MemoryViewWidget::UpdateColumns(const Core::CPUThreadGuard* guard)
 
   const QSignalBlocker blocker(m_table);
 
+  // All of the visible memory is read at once, and only the cells whose bytes differ from the last
+  // read get new text
+  MemorySnapshot snapshot;
+  if (guard)
+  {
+    snapshot.address = m_table->item(0, 1)->data(USER_ROLE_CELL_ADDRESS).toUInt();
+    const u32 size = static_cast<u32>(m_table->rowCount() * m_bytes_per_row);
+    snapshot.data.resize(size);
+    snapshot.valid.resize(size);
+    AddressSpace::GetAccessors(m_address_space)
+        ->ReadBytes(*guard, snapshot.address, snapshot.data.data(), snapshot.valid.data(), size);
+  }
+
+  const bool same_range = m_cells_up_to_date && guard && snapshot.address == m_snapshot.address &&
+                          snapshot.data.size() == m_snapshot.data.size();
+
   for (int i = 0; i < m_table->rowCount(); i++)
   {
     for (int c = 0; c < m_data_columns; c++)
@@ -468,66 +496,95 @@ void MemoryViewWidget::UpdateColumns(const Core::CPUThreadGuard* guard)
       auto* cell_item = m_table->item(i, c + MISC_COLUMNS);
       const u32 cell_address = cell_item->data(USER_ROLE_CELL_ADDRESS).toUInt();
       const Type type = static_cast<Type>(cell_item->data(USER_ROLE_VALUE_TYPE).toInt());
+      const u32 size = GetTypeSize(type);
 
-      cell_item->setText(guard ? ValueToString(*guard, cell_address, type) : INVALID_MEMORY);
+      bool changed = false;
+      if (!guard)
+      {
+        cell_item->setText(INVALID_MEMORY);
+      }
+      else
+      {
+        const u32 offset = cell_address - snapshot.address;
+        const u8* data = snapshot.data.data() + offset;
+        const u8* valid = snapshot.valid.data() + offset;
+
+        const bool up_to_date = same_range &&
+                                std::memcmp(data, m_snapshot.data.data() + offset, size) == 0 &&
+                                std::memcmp(valid, m_snapshot.valid.data() + offset, size) == 0;
+        if (!up_to_date)
+          cell_item->setText(valid[0] ? ValueToString(data, type) : INVALID_MEMORY);
+
+        // Values are compared by address, so that they stay highlighted after scrolling
+        const u32 old_offset = cell_address - m_snapshot.address;
+        if (u64{old_offset} + size <= m_snapshot.data.size() &&
+            std::all_of(valid, valid + size, [](u8 v) { return v != 0; }))
+        {
+          const u8* old_valid = m_snapshot.valid.data() + old_offset;
+          changed = std::all_of(old_valid, old_valid + size, [](u8 v) { return v != 0; }) &&
+                    std::memcmp(data, m_snapshot.data.data() + old_offset, size) != 0;
+        }
+      }
+
+      if (cell_item->data(USER_ROLE_VALUE_CHANGED).toBool() != changed)
+      {
+        cell_item->setData(USER_ROLE_VALUE_CHANGED, changed);
+        cell_item->setData(Qt::ForegroundRole, changed ? QVariant(QBrush(Qt::red)) : QVariant());
+      }
 
       // Set search address to selected / colored
       if (cell_address == m_address_highlight)
         cell_item->setSelected(true);
     }
   }
+
+  // Without a guard the snapshot is kept, so that what changed while the emulation was running
+  // gets highlighted once it is paused
+  if (guard)
+  {
+    m_snapshot = std::move(snapshot);
+    m_cells_up_to_date = true;
+  }
+  else
+  {
+    m_cells_up_to_date = false;
+  }
 }
 
-// May only be called if we have taken on the role of the CPU thread
-QString MemoryViewWidget::ValueToString(const Core::CPUThreadGuard& guard, u32 address, Type type)
+// The value of a cell from its big endian bytes
+QString MemoryViewWidget::ValueToString(const u8* data, Type type)
 {
-  const AddressSpace::Accessors* accessors = AddressSpace::GetAccessors(m_address_space);
-  if (!accessors->IsValidAddress(guard, address))
-    return INVALID_MEMORY;
-
   switch (type)
   {
   case Type::Hex8:
-  {
-    const u8 value = accessors->ReadU8(guard, address);
-    return QStringLiteral("%1").arg(value, 2, 16, QLatin1Char('0'));
-  }
+    return QStringLiteral("%1").arg(data[0], 2, 16, QLatin1Char('0'));
   case Type::ASCII:
   {
-    const char value = accessors->ReadU8(guard, address);
+    const char value = data[0];
     return Common::IsPrintableCharacter(value) ? QString{QChar::fromLatin1(value)} :
                                                  QString{QChar::fromLatin1('.')};
   }
   case Type::Hex16:
-  {
-    const u16 value = accessors->ReadU16(guard, address);
-    return QStringLiteral("%1").arg(value, 4, 16, QLatin1Char('0'));
-  }
+    return QStringLiteral("%1").arg(ReadBigEndian<u16>(data), 4, 16, QLatin1Char('0'));
   case Type::Hex32:
-  {
-    const u32 value = accessors->ReadU32(guard, address);
-    return QStringLiteral("%1").arg(value, 8, 16, QLatin1Char('0'));
-  }
+    return QStringLiteral("%1").arg(ReadBigEndian<u32>(data), 8, 16, QLatin1Char('0'));
   case Type::Hex64:
-  {
-    const u64 value = accessors->ReadU64(guard, address);
-    return QStringLiteral("%1").arg(value, 16, 16, QLatin1Char('0'));
-  }
+    return QStringLiteral("%1").arg(ReadBigEndian<u64>(data), 16, 16, QLatin1Char('0'));
   case Type::Unsigned8:
-    return QString::number(accessors->ReadU8(guard, address));
+    return QString::number(data[0]);
   case Type::Unsigned16:
-    return QString::number(accessors->ReadU16(guard, address));
+    return QString::number(ReadBigEndian<u16>(data));
   case Type::Unsigned32:
-    return QString::number(accessors->ReadU32(guard, address));
+    return QString::number(ReadBigEndian<u32>(data));
   case Type::Signed8:
-    return QString::number(Common::BitCast<s8>(accessors->ReadU8(guard, address)));
+    return QString::number(Common::BitCast<s8>(data[0]));
   case Type::Signed16:
-    return QString::number(Common::BitCast<s16>(accessors->ReadU16(guard, address)));
+    return QString::number(Common::BitCast<s16>(ReadBigEndian<u16>(data)));
   case Type::Signed32:
-    return QString::number(Common::BitCast<s32>(accessors->ReadU32(guard, address)));
+    return QString::number(Common::BitCast<s32>(ReadBigEndian<u32>(data)));
   case Type::Float32:
   {
-    QString string = QString::number(accessors->ReadF32(guard, address), 'g', 4);
+    QString string = QString::number(Common::BitCast<float>(ReadBigEndian<u32>(data)), 'g', 4);
     // Align to first digit.
     if (!string.startsWith(QLatin1Char('-')))
       string.prepend(QLatin1Char(' '));
@@ -536,8 +593,7 @@ QString MemoryViewWidget::ValueToString(const Core::CPUThreadGuard& guard, u32 a
   }
   case Type::Double:
   {
-    QString string =
-        QString::number(Common::BitCast<double>(accessors->ReadU64(guard, address)), 'g', 4);
+    QString string = QString::number(Common::BitCast<double>(ReadBigEndian<u64>(data)), 'g', 4);
     // Align to first digit.
     if (!string.startsWith(QLatin1Char('-')))
       string.prepend(QLatin1Char(' '));
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include <QWidget>
 
 #include "Common/CommonTypes.h"
@@ -84,7 +86,15 @@ private:
   void UpdateColumns(const Core::CPUThreadGuard* guard);
   void ScrollbarActionTriggered(int action);
   void ScrollbarSliderReleased();
-  QString ValueToString(const Core::CPUThreadGuard& guard, u32 address, Type type);
+  static QString ValueToString(const u8* data, Type type);
+
+  struct MemorySnapshot
+  {
+    u32 address = 0;
+    std::vector<u8> data;
+    // Whether each byte of data could be read
+    std::vector<u8> valid;
+  };
 
   Core::System& m_system;
 
@@ -103,5 +113,10 @@ private:
   int m_data_columns;
   bool m_dual_view = false;
 
+  // The memory of all rows as it was last read
+  MemorySnapshot m_snapshot;
+  // Whether the cells show m_snapshot at the addresses they have now
+  bool m_cells_up_to_date = false;
+
   friend class MemoryViewTable;
 };
@@ -32,6 +32,10 @@
 #include "DolphinQt/Resources.h"
 #include "DolphinQt/Settings.h"
 
+// One minute, and one hour at 60 frames per second
+constexpr int MAX_RECORDED_FRAMES = 3600;
+constexpr int MAX_STREAMED_FRAMES = 216000;
+
 FIFOPlayerWindow::FIFOPlayerWindow(QWidget* parent) : QWidget(parent)
 {
   setWindowTitle(tr("FIFO Player"));
@@ -133,13 +137,15 @@ void FIFOPlayerWindow::CreateWidgets()
   auto* recording_layout = new QHBoxLayout;
   m_frame_record_count = new QSpinBox;
   m_frame_record_count_label = new QLabel(tr("Frames to Record:"));
+  m_stream_to_file = new ToolTipCheckBox(tr("Stream to File"));
 
   m_frame_record_count->setMinimum(1);
-  m_frame_record_count->setMaximum(3600);
+  m_frame_record_count->setMaximum(MAX_RECORDED_FRAMES);
   m_frame_record_count->setValue(3);
 
   recording_layout->addWidget(m_frame_record_count_label);
   recording_layout->addWidget(m_frame_record_count);
+  recording_layout->addWidget(m_stream_to_file);
   recording_group->setLayout(recording_layout);
 
   m_button_box = new QDialogButtonBox(QDialogButtonBox::Close);
@@ -185,6 +191,7 @@ void FIFOPlayerWindow::ConnectWidgets()
   connect(m_stop, &QPushButton::clicked, this, &FIFOPlayerWindow::StopRecording);
   connect(m_button_box, &QDialogButtonBox::rejected, this, &FIFOPlayerWindow::hide);
   connect(m_early_memory_updates, &QCheckBox::toggled, this, &FIFOPlayerWindow::OnConfigChanged);
+  connect(m_stream_to_file, &QCheckBox::toggled, this, &FIFOPlayerWindow::UpdateControls);
   connect(m_loop, &QCheckBox::toggled, this, &FIFOPlayerWindow::OnConfigChanged);
 
   connect(m_frame_range_from, qOverload<int>(&QSpinBox::valueChanged), this,
@@ -208,9 +215,16 @@ void FIFOPlayerWindow::AddDescriptions()
       QT_TR_NOOP("If unchecked, then playback of the fifolog stops after the final frame.<br><br>"
                  "This is generally only useful when a frame-dumping option is enabled.<br><br>"
                  "<dolphin_emphasis>If unsure, leave this checked.</dolphin_emphasis>");
+  static const char TR_STREAM_TO_FILE_DESCRIPTION[] = QT_TR_NOOP(
+      "If enabled, then recorded frames are compressed and written to a file chosen before "
+      "recording starts, instead of being kept in memory until the recording is saved.<br><br>"
+      "This allows recordings that are too long to fit in memory, but needs a version of the "
+      "FIFO Player that supports compressed fifologs to play them.<br><br>"
+      "<dolphin_emphasis>If unsure, leave this unchecked.</dolphin_emphasis>");
 
   m_early_memory_updates->SetDescription(tr(TR_MEMORY_UPDATES_DESCRIPTION));
   m_loop->SetDescription(tr(TR_LOOP_DESCRIPTION));
+  m_stream_to_file->SetDescription(tr(TR_STREAM_TO_FILE_DESCRIPTION));
 }
 
 void FIFOPlayerWindow::LoadRecording()
@@ -244,10 +258,22 @@ void FIFOPlayerWindow::SaveRecording()
 
 void FIFOPlayerWindow::StartRecording()
 {
+  QString path;
+  if (m_stream_to_file->isChecked())
+  {
+    path = DolphinFileDialog::getSaveFileName(this, tr("Save FIFO log"), QString(),
+                                              tr("Dolphin FIFO Log (*.dff)"));
+    if (path.isEmpty())
+      return;
+  }
+
   // Start recording
-  FifoRecorder::GetInstance().StartRecording(m_frame_record_count->value(), [this] {
-    QueueOnObject(this, [this] { OnRecordingDone(); });
-  });
+  const bool result = FifoRecorder::GetInstance().StartRecording(
+      m_frame_record_count->value(),
+      [this] { QueueOnObject(this, [this] { OnRecordingDone(); }); }, path.toStdString());
+
+  if (!result)
+    ModalMessageBox::critical(this, tr("Error"), tr("Failed to create FIFO log."));
 
   UpdateControls();
 
@@ -304,18 +330,9 @@ void FIFOPlayerWindow::UpdateInfo()
   if (FifoRecorder::GetInstance().IsRecordingDone())
   {
     FifoDataFile* file = FifoRecorder::GetInstance().GetRecordedFile();
-    size_t fifo_bytes = 0;
-    size_t mem_bytes = 0;
-
-    for (u32 i = 0; i < file->GetFrameCount(); ++i)
-    {
-      fifo_bytes += file->GetFrame(i).fifoData.size();
-      for (const auto& mem_update : file->GetFrame(i).memoryUpdates)
-        mem_bytes += mem_update.data.size();
-    }
-
     m_info_label->setText(tr("%1 FIFO bytes\n%2 memory bytes\n%3 frames")
-                              .arg(QString::number(fifo_bytes), QString::number(mem_bytes),
+                              .arg(QString::number(file->GetFifoDataSize()),
+                                   QString::number(file->GetMemoryUpdatesSize()),
                                    QString::number(file->GetFrameCount())));
     return;
   }
@@ -396,6 +413,10 @@ void FIFOPlayerWindow::UpdateControls()
 
   m_frame_record_count_label->setEnabled(enable_frame_record_count);
   m_frame_record_count->setEnabled(enable_frame_record_count);
+  m_stream_to_file->setEnabled(enable_frame_record_count);
+  // Streamed recordings aren't limited by the amount of memory
+  m_frame_record_count->setMaximum(m_stream_to_file->isChecked() ? MAX_STREAMED_FRAMES :
+                                                                   MAX_RECORDED_FRAMES);
 
   m_load->setEnabled(!running);
   m_record->setEnabled(running && !is_playing);
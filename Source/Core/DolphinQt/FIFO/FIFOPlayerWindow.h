@@ -60,6 +60,7 @@ private:
   QLabel* m_frame_range_to_label;
   QSpinBox* m_frame_record_count;
   QLabel* m_frame_record_count_label;
+  ToolTipCheckBox* m_stream_to_file;
   QSpinBox* m_object_range_from;
   QLabel* m_object_range_from_label;
   QSpinBox* m_object_range_to;
@@ -3,9 +3,12 @@
 
 #include "DolphinQt/GameList/GameListModel.h"
 
+#include <algorithm>
+
 #include <QDir>
 #include <QFileInfo>
 #include <QPixmap>
+#include <QPixmapCache>
 #include <QRegularExpression>
 
 #include "Core/Config/MainSettings.h"
@@ -21,6 +24,10 @@
 
 const QSize GAMECUBE_BANNER_SIZE(96, 32);
 
+// Holds the banners and covers of the rows that were shown last, so scrolling back and forth
+// doesn't convert and scale them again. Large libraries only ever have a few screens' worth here.
+constexpr int PIXMAP_CACHE_LIMIT_KB = 64 * 1024;
+
 GameListModel::GameListModel(QObject* parent) : QAbstractTableModel(parent)
 {
   connect(&m_tracker, &GameTracker::GameLoaded, this, &GameListModel::AddGame);
@@ -30,8 +37,14 @@ GameListModel::GameListModel(QObject* parent) : QAbstractTableModel(parent)
   connect(&Settings::Instance(), &Settings::PathRemoved, &m_tracker, &GameTracker::RemoveDirectory);
   connect(&Settings::Instance(), &Settings::GameListRefreshRequested, &m_tracker,
           &GameTracker::RefreshAll);
-  connect(&Settings::Instance(), &Settings::TitleDBReloadRequested,
-          [this] { m_title_database = Core::TitleDatabase(); });
+  connect(&Settings::Instance(), &Settings::GameListRefreshRequested, this,
+          &GameListModel::ClearCachedStrings);
+  connect(&Settings::Instance(), &Settings::TitleDBReloadRequested, [this] {
+    m_title_database = Core::TitleDatabase();
+    ClearCachedStrings();
+  });
+
+  QPixmapCache::setCacheLimit(std::max(QPixmapCache::cacheLimit(), PIXMAP_CACHE_LIMIT_KB));
 
   for (const QString& dir : Settings::Instance().GetPaths())
     m_tracker.AddDirectory(dir);
@@ -41,6 +54,7 @@ GameListModel::GameListModel(QObject* parent) : QAbstractTableModel(parent)
   connect(&Settings::Instance(), &Settings::ThemeChanged, [this] {
     // Tell the view to repaint. The signal 'dataChanged' also seems like it would work here, but
     // unfortunately it won't cause a repaint until the view is focused.
+    QPixmapCache::clear();
     emit layoutAboutToBeChanged();
     emit layoutChanged();
   });
@@ -56,7 +70,8 @@ QVariant GameListModel::data(const QModelIndex& index, int role) const
   if (!index.isValid())
     return QVariant();
 
-  const UICommon::GameFile& game = *m_games[index.row()];
+  const Entry& entry = m_games[index.row()];
+  const UICommon::GameFile& game = *entry.game;
 
   switch (static_cast<Column>(index.column()))
   {
@@ -74,54 +89,13 @@ QVariant GameListModel::data(const QModelIndex& index, int role) const
     break;
   case Column::Banner:
     if (role == Qt::DecorationRole)
-    {
-      // GameCube banners are 96x32, but Wii banners are 192x64.
-      QPixmap banner = ToQPixmap(game.GetBannerImage());
-      if (banner.isNull())
-        banner = Resources::GetMisc(Resources::MiscID::BannerMissing).pixmap(GAMECUBE_BANNER_SIZE);
-
-      banner.setDevicePixelRatio(
-          std::max(static_cast<qreal>(banner.width()) / GAMECUBE_BANNER_SIZE.width(),
-                   static_cast<qreal>(banner.height()) / GAMECUBE_BANNER_SIZE.height()));
-
-      return banner;
-    }
+      return GetBanner(entry);
     break;
   case Column::Title:
-    if (role == Qt::DisplayRole || role == SORT_ROLE)
-    {
-      QString name = QString::fromStdString(game.GetName(m_title_database));
-
-      // Add disc numbers > 1 to title if not present.
-      const int disc_nr = game.GetDiscNumber() + 1;
-      if (disc_nr > 1)
-      {
-        if (!name.contains(QRegularExpression(QStringLiteral("disc ?%1").arg(disc_nr),
-                                              QRegularExpression::CaseInsensitiveOption)))
-        {
-          name.append(tr(" (Disc %1)").arg(disc_nr));
-        }
-      }
-
-      // For natural sorting, pad all numbers to the same length.
-      if (SORT_ROLE == role)
-      {
-        constexpr int MAX_NUMBER_LENGTH = 10;
-
-        const QRegularExpression rx(QStringLiteral("\\d+"));
-        QRegularExpressionMatch match;
-        int pos = 0;
-        while ((match = rx.match(name, pos)).hasMatch())
-        {
-          pos = match.capturedStart();
-          name.replace(pos, match.capturedLength(),
-                       match.captured().rightJustified(MAX_NUMBER_LENGTH));
-          pos += MAX_NUMBER_LENGTH;
-        }
-      }
-
-      return name;
-    }
+    if (role == Qt::DisplayRole)
+      return GetTitle(entry);
+    if (role == SORT_ROLE)
+      return GetTitleSortKey(entry);
     break;
   case Column::ID:
     if (role == Qt::DisplayRole || role == SORT_ROLE)
@@ -255,12 +229,12 @@ int GameListModel::columnCount(const QModelIndex& parent) const
 
 bool GameListModel::ShouldDisplayGameListItem(int index) const
 {
-  const UICommon::GameFile& game = *m_games[index];
+  const Entry& entry = m_games[index];
+  const UICommon::GameFile& game = *entry.game;
 
   if (!m_term.isEmpty())
   {
-    const bool matches_title = QString::fromStdString(game.GetName(m_title_database))
-                                   .contains(m_term, Qt::CaseInsensitive);
+    const bool matches_title = GetName(entry).contains(m_term, Qt::CaseInsensitive);
     const bool filename_visible = Config::Get(Config::MAIN_GAMELIST_COLUMN_FILE_NAME);
     const bool list_view_selected = Settings::Instance().GetPreferredView();
     const bool matches_filename =
@@ -327,7 +301,105 @@ bool GameListModel::ShouldDisplayGameListItem(int index) const
 
 std::shared_ptr<const UICommon::GameFile> GameListModel::GetGameFile(int index) const
 {
-  return m_games[index];
+  return m_games[index].game;
+}
+
+QString GameListModel::GetPixmapCacheKey(int index) const
+{
+  return QStringLiteral("gamelist/%1").arg(m_games[index].serial);
+}
+
+GameListModel::Entry GameListModel::MakeEntry(const std::shared_ptr<const UICommon::GameFile>& game)
+{
+  return Entry{game, m_next_serial++};
+}
+
+const QString& GameListModel::GetName(const Entry& entry) const
+{
+  if (entry.name.isNull())
+    entry.name = QString::fromStdString(entry.game->GetName(m_title_database));
+  return entry.name;
+}
+
+const QString& GameListModel::GetTitle(const Entry& entry) const
+{
+  if (!entry.title.isNull())
+    return entry.title;
+
+  entry.title = GetName(entry);
+
+  // Add disc numbers > 1 to title if not present.
+  const int disc_nr = entry.game->GetDiscNumber() + 1;
+  if (disc_nr > 1)
+  {
+    if (!entry.title.contains(QRegularExpression(QStringLiteral("disc ?%1").arg(disc_nr),
+                                                 QRegularExpression::CaseInsensitiveOption)))
+    {
+      entry.title.append(tr(" (Disc %1)").arg(disc_nr));
+    }
+  }
+
+  return entry.title;
+}
+
+const QString& GameListModel::GetTitleSortKey(const Entry& entry) const
+{
+  if (!entry.title_sort_key.isNull())
+    return entry.title_sort_key;
+
+  entry.title_sort_key = GetTitle(entry);
+
+  // For natural sorting, pad all numbers to the same length.
+  constexpr int MAX_NUMBER_LENGTH = 10;
+
+  static const QRegularExpression rx(QStringLiteral("\\d+"));
+  QString& key = entry.title_sort_key;
+  QRegularExpressionMatch match;
+  int pos = 0;
+  while ((match = rx.match(key, pos)).hasMatch())
+  {
+    pos = match.capturedStart();
+    key.replace(pos, match.capturedLength(), match.captured().rightJustified(MAX_NUMBER_LENGTH));
+    pos += MAX_NUMBER_LENGTH;
+  }
+
+  return key;
+}
+
+QPixmap GameListModel::GetBanner(const Entry& entry) const
+{
+  const QString key = QStringLiteral("gamelist/%1/banner").arg(entry.serial);
+  QPixmap banner;
+  if (QPixmapCache::find(key, &banner))
+    return banner;
+
+  // GameCube banners are 96x32, but Wii banners are 192x64.
+  banner = ToQPixmap(entry.game->GetBannerImage());
+  if (banner.isNull())
+  {
+    // Not cached, as it follows the theme
+    banner = Resources::GetMisc(Resources::MiscID::BannerMissing).pixmap(GAMECUBE_BANNER_SIZE);
+  }
+  else
+  {
+    QPixmapCache::insert(key, banner);
+  }
+
+  banner.setDevicePixelRatio(
+      std::max(static_cast<qreal>(banner.width()) / GAMECUBE_BANNER_SIZE.width(),
+               static_cast<qreal>(banner.height()) / GAMECUBE_BANNER_SIZE.height()));
+
+  return banner;
+}
+
+void GameListModel::ClearCachedStrings()
+{
+  for (const Entry& entry : m_games)
+  {
+    entry.name.clear();
+    entry.title.clear();
+    entry.title_sort_key.clear();
+  }
 }
 
 std::string GameListModel::GetNetPlayName(const UICommon::GameFile& game) const
@@ -338,7 +410,7 @@ std::string GameListModel::GetNetPlayName(const UICommon::GameFile& game) const
 void GameListModel::AddGame(const std::shared_ptr<const UICommon::GameFile>& game)
 {
   beginInsertRows(QModelIndex(), m_games.size(), m_games.size());
-  m_games.push_back(game);
+  m_games.push_back(MakeEntry(game));
   endInsertRows();
 }
 
@@ -351,7 +423,7 @@ void GameListModel::UpdateGame(const std::shared_ptr<const UICommon::GameFile>&
   }
   else
   {
-    m_games[index] = game;
+    m_games[index] = MakeEntry(game);
     emit dataChanged(createIndex(index, 0), createIndex(index, columnCount(QModelIndex()) - 1));
   }
 }
@@ -370,14 +442,14 @@ void GameListModel::RemoveGame(const std::string& path)
 std::shared_ptr<const UICommon::GameFile> GameListModel::FindGame(const std::string& path) const
 {
   const int index = FindGameIndex(path);
-  return index < 0 ? nullptr : m_games[index];
+  return index < 0 ? nullptr : m_games[index].game;
 }
 
 int GameListModel::FindGameIndex(const std::string& path) const
 {
   for (int i = 0; i < m_games.size(); i++)
   {
-    if (m_games[i]->GetFilePath() == path)
+    if (m_games[i].game->GetFilePath() == path)
       return i;
   }
   return -1;
@@ -390,8 +462,9 @@ GameListModel::FindSecondDisc(const UICommon::GameFile& game) const
 
   if (DiscIO::IsDisc(game.GetPlatform()))
   {
-    for (auto& other_game : m_games)
+    for (const Entry& entry : m_games)
     {
+      const std::shared_ptr<const UICommon::GameFile>& other_game = entry.game;
       if (game.GetGameID() == other_game->GetGameID() &&
           game.GetDiscNumber() != other_game->GetDiscNumber())
       {
@@ -8,6 +8,7 @@
 
 #include <QAbstractTableModel>
 #include <QMap>
+#include <QPixmap>
 #include <QString>
 #include <QStringList>
 #include <QVariant>
@@ -36,6 +37,9 @@ public:
   int columnCount(const QModelIndex& parent) const override;
 
   std::shared_ptr<const UICommon::GameFile> GetGameFile(int index) const;
+  // Prefix of QPixmapCache keys for pixmaps made from the game at index. It changes when the game
+  // is updated, so pixmaps of the old version are never found again.
+  QString GetPixmapCacheKey(int index) const;
   std::string GetNetPlayName(const UICommon::GameFile& game) const;
   bool ShouldDisplayGameListItem(int index) const;
   void SetSearchTerm(const QString& term);
@@ -84,6 +88,25 @@ public:
   void PurgeCache();
 
 private:
+  struct Entry
+  {
+    std::shared_ptr<const UICommon::GameFile> game;
+    quint64 serial;
+
+    // Filled in the first time they're needed. Sorting and filtering look these up many times per
+    // game, and building them is much slower than comparing them.
+    mutable QString name;
+    mutable QString title;
+    mutable QString title_sort_key;
+  };
+
+  Entry MakeEntry(const std::shared_ptr<const UICommon::GameFile>& game);
+  const QString& GetName(const Entry& entry) const;
+  const QString& GetTitle(const Entry& entry) const;
+  const QString& GetTitleSortKey(const Entry& entry) const;
+  QPixmap GetBanner(const Entry& entry) const;
+  void ClearCachedStrings();
+
   // Index in m_games, or -1 if it isn't found
   int FindGameIndex(const std::string& path) const;
 
@@ -91,7 +114,8 @@ private:
   QMap<QString, QVariant> m_game_tags;
 
   GameTracker m_tracker;
-  QList<std::shared_ptr<const UICommon::GameFile>> m_games;
+  QList<Entry> m_games;
+  quint64 m_next_serial = 0;
   Core::TitleDatabase m_title_database;
   QString m_term;
   float m_scale = 1.0;
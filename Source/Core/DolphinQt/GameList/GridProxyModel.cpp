@@ -6,6 +6,7 @@
 #include <QImage>
 #include <QPainter>
 #include <QPixmap>
+#include <QPixmapCache>
 #include <QSize>
 
 #include "DolphinQt/GameList/GameListModel.h"
@@ -22,6 +23,41 @@ GridProxyModel::GridProxyModel(QObject* parent) : QSortFilterProxyModel(parent)
   sort(static_cast<int>(GameListModel::Column::Title));
 }
 
+static QPixmap CreatePixmap(const GameListModel& model, int row, bool use_covers)
+{
+  const auto& buffer = model.GetGameFile(row)->GetCoverImage().buffer;
+
+  QSize size = use_covers ? QSize(160, 224) : LARGE_BANNER_SIZE;
+  QPixmap pixmap(size * model.GetScale() * QPixmap().devicePixelRatio());
+
+  if (buffer.empty() || !use_covers)
+  {
+    QPixmap banner =
+        model.data(model.index(row, static_cast<int>(GameListModel::Column::Banner)),
+                   Qt::DecorationRole)
+            .value<QPixmap>();
+
+    banner = banner.scaled(pixmap.size(), Qt::KeepAspectRatio, Qt::SmoothTransformation);
+
+    pixmap.fill();
+
+    QPainter painter(&pixmap);
+
+    painter.drawPixmap(0, pixmap.height() / 2 - banner.height() / 2, banner.width(),
+                       banner.height(), banner);
+
+    return pixmap;
+  }
+  else
+  {
+    pixmap = QPixmap::fromImage(QImage::fromData(
+        reinterpret_cast<const unsigned char*>(&buffer[0]), static_cast<int>(buffer.size())));
+
+    return pixmap.scaled(QSize(160, 224) * model.GetScale() * pixmap.devicePixelRatio(),
+                         Qt::KeepAspectRatio, Qt::SmoothTransformation);
+  }
+}
+
 QVariant GridProxyModel::data(const QModelIndex& i, int role) const
 {
   QModelIndex source_index = mapToSource(i);
@@ -35,38 +71,18 @@ QVariant GridProxyModel::data(const QModelIndex& i, int role) const
   {
     auto* model = static_cast<GameListModel*>(sourceModel());
 
-    const auto& buffer = model->GetGameFile(source_index.row())->GetCoverImage().buffer;
-
-    QSize size = Config::Get(Config::MAIN_USE_GAME_COVERS) ? QSize(160, 224) : LARGE_BANNER_SIZE;
-    QPixmap pixmap(size * model->GetScale() * QPixmap().devicePixelRatio());
-
-    if (buffer.empty() || !Config::Get(Config::MAIN_USE_GAME_COVERS))
-    {
-      QPixmap banner = model
-                           ->data(model->index(source_index.row(),
-                                               static_cast<int>(GameListModel::Column::Banner)),
-                                  Qt::DecorationRole)
-                           .value<QPixmap>();
-
-      banner = banner.scaled(pixmap.size(), Qt::KeepAspectRatio, Qt::SmoothTransformation);
-
-      pixmap.fill();
-
-      QPainter painter(&pixmap);
-
-      painter.drawPixmap(0, pixmap.height() / 2 - banner.height() / 2, banner.width(),
-                         banner.height(), banner);
-
-      return pixmap;
-    }
-    else
+    const bool use_covers = Config::Get(Config::MAIN_USE_GAME_COVERS);
+    const QString key = QStringLiteral("%1/grid/%2/%3")
+                            .arg(model->GetPixmapCacheKey(source_index.row()))
+                            .arg(model->GetScale())
+                            .arg(use_covers);
+    QPixmap pixmap;
+    if (!QPixmapCache::find(key, &pixmap))
     {
-      pixmap = QPixmap::fromImage(QImage::fromData(
-          reinterpret_cast<const unsigned char*>(&buffer[0]), static_cast<int>(buffer.size())));
-
-      return pixmap.scaled(QSize(160, 224) * model->GetScale() * pixmap.devicePixelRatio(),
-                           Qt::KeepAspectRatio, Qt::SmoothTransformation);
+      pixmap = CreatePixmap(*model, source_index.row(), use_covers);
+      QPixmapCache::insert(key, pixmap);
     }
+    return pixmap;
   }
   return QVariant();
 }
@@ -604,6 +604,9 @@ void HotkeyScheduler::Run()
     if (IsHotkey(HK_UNDO_LOAD_STATE))
       emit StateLoadUndo();
 
+    if (IsHotkey(HK_REWIND))
+      emit StateRewind();
+
     if (IsHotkey(HK_UNDO_SAVE_STATE))
       emit StateSaveUndo();
 
@@ -65,6 +65,7 @@
 #include "Core/NetPlayProto.h"
 #include "Core/NetPlayServer.h"
 #include "Core/State.h"
+#include "Core/StateRewind.h"
 #include "Core/System.h"
 #include "Core/WiiUtils.h"
 
@@ -615,6 +616,7 @@ void MainWindow::ConnectHotkeys()
   connect(m_hotkey_scheduler, &HotkeyScheduler::StateLoadLastSaved, this,
           &MainWindow::StateLoadLastSavedAt);
   connect(m_hotkey_scheduler, &HotkeyScheduler::StateLoadUndo, this, &MainWindow::StateLoadUndo);
+  connect(m_hotkey_scheduler, &HotkeyScheduler::StateRewind, this, &MainWindow::StateRewind);
   connect(m_hotkey_scheduler, &HotkeyScheduler::StateSaveUndo, this, &MainWindow::StateSaveUndo);
   connect(m_hotkey_scheduler, &HotkeyScheduler::StateSaveOldest, this,
           &MainWindow::StateSaveOldest);
@@ -1425,6 +1427,11 @@ void MainWindow::StateLoadUndo()
   State::UndoLoadState();
 }
 
+void MainWindow::StateRewind()
+{
+  State::Rewind::StepBack();
+}
+
 void MainWindow::StateSaveUndo()
 {
   State::UndoSaveState();
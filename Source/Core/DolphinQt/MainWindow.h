@@ -107,6 +107,7 @@ private:
   void StateSaveSlotAt(int slot);
   void StateLoadLastSavedAt(int slot);
   void StateLoadUndo();
+  void StateRewind();
   void StateSaveUndo();
   void StateSaveOldest();
   void SetStateSlot(int slot);
@@ -19,6 +19,7 @@
 #include "Common/CommonPaths.h"
 #include "Common/FileUtil.h"
 #include "Common/StringUtil.h"
+#include "Common/TraceEvents.h"
 
 #include "Core/Boot/Boot.h"
 #include "Core/CommonTitles.h"
@@ -142,6 +143,8 @@ void MenuBar::OnEmulationStateChanged(Core::State state)
   m_jit_clear_cache->setEnabled(running);
   m_jit_log_coverage->setEnabled(!running);
   m_jit_search_instruction->setEnabled(running);
+  m_jit_profile_blocks->setEnabled(running);
+  m_jit_write_profile->setEnabled(running);
 
   // Symbols
   m_symbols->setEnabled(running);
@@ -218,6 +221,10 @@ void MenuBar::AddToolsMenu()
 
   tools_menu->addAction(tr("FIFO Player"), this, &MenuBar::ShowFIFOPlayer);
 
+  m_record_trace = tools_menu->addAction(tr("Record Performance Trace"));
+  m_record_trace->setCheckable(true);
+  connect(m_record_trace, &QAction::toggled, this, &MenuBar::ToggleTraceRecording);
+
   auto* usb_device_menu = new QMenu(tr("Emulated USB Devices"), tools_menu);
   usb_device_menu->addAction(tr("&Skylanders Portal"), this, &MenuBar::ShowSkylanderPortal);
   usb_device_menu->addAction(tr("&Infinity Base"), this, &MenuBar::ShowInfinityBase);
@@ -856,6 +863,17 @@ void MenuBar::AddJITMenu()
   m_jit_search_instruction =
       m_jit->addAction(tr("Search for an Instruction"), this, &MenuBar::SearchInstruction);
 
+  m_jit_profile_blocks = m_jit->addAction(tr("Enable JIT Block Profiling"));
+  m_jit_profile_blocks->setCheckable(true);
+  connect(m_jit_profile_blocks, &QAction::toggled, [this](bool enabled) {
+    Core::System::GetInstance().GetJitInterface().SetProfilingState(
+        enabled ? JitInterface::ProfilingState::Enabled : JitInterface::ProfilingState::Disabled);
+    // Only newly compiled blocks count their runs
+    ClearCache();
+  });
+  m_jit_write_profile =
+      m_jit->addAction(tr("Write JIT Block Profile..."), this, &MenuBar::WriteJitProfile);
+
   m_jit->addSeparator();
 
   m_jit_off = m_jit->addAction(tr("JIT Off (JIT Core)"));
@@ -1103,7 +1121,25 @@ void MenuBar::ExportWiiSaves()
   if (export_dir.isEmpty())
     return;
 
-  const size_t count = WiiSave::ExportAll(export_dir.toStdString());
+  ParallelProgressDialog progress(tr("Exporting saves..."), tr("Cancel"), 0, 0, this);
+  progress.GetRaw()->setWindowTitle(tr("Save Export"));
+  progress.GetRaw()->setMinimumDuration(1000);
+  progress.GetRaw()->setWindowModality(Qt::WindowModal);
+
+  auto future = std::async(std::launch::async, [&progress, &export_dir] {
+    const size_t exported = WiiSave::ExportAll(
+        export_dir.toStdString(), [&progress](size_t handled, size_t total) {
+          progress.SetMaximum(static_cast<int>(total));
+          progress.SetValue(static_cast<int>(handled));
+          return !progress.WasCanceled();
+        });
+    progress.Reset();
+    return exported;
+  });
+  SetQWidgetWindowDecorations(progress.GetRaw());
+  progress.GetRaw()->exec();
+
+  const size_t count = future.get();
   ModalMessageBox::information(this, tr("Save Export"),
                                tr("Exported %n save(s)", "", static_cast<int>(count)));
 }
@@ -1723,6 +1759,42 @@ void MenuBar::LogInstructions()
   PPCTables::LogCompiledInstructions();
 }
 
+void MenuBar::ToggleTraceRecording(bool record)
+{
+  if (record)
+  {
+    Common::Trace::StartRecording();
+    return;
+  }
+
+  Common::Trace::StopRecording();
+
+  const QString file = DolphinFileDialog::getSaveFileName(
+      this, tr("Save performance trace"),
+      QString::fromStdString(File::GetUserPath(D_DUMP_IDX) + "trace.json"),
+      tr("Trace Event File (*.json)"));
+  if (file.isEmpty())
+    return;
+
+  if (!Common::Trace::WriteRecording(file.toStdString()))
+  {
+    ModalMessageBox::warning(this, tr("Error"),
+                             tr("Failed to save the performance trace to '%1'").arg(file));
+  }
+}
+
+void MenuBar::WriteJitProfile()
+{
+  const QString file = DolphinFileDialog::getSaveFileName(
+      this, tr("Write JIT block profile"),
+      QString::fromStdString(File::GetUserPath(D_DUMP_IDX) + "profile.json"),
+      tr("Speedscope Profile (*.json);;Text File (*.txt)"));
+  if (file.isEmpty())
+    return;
+
+  Core::System::GetInstance().GetJitInterface().WriteProfileResults(file.toStdString());
+}
+
 void MenuBar::SearchInstruction()
 {
   bool good;
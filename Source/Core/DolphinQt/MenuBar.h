@@ -183,6 +183,8 @@ private:
   void ClearCache();
   void LogInstructions();
   void SearchInstruction();
+  void WriteJitProfile();
+  void ToggleTraceRecording(bool record);
 
   void OnSelectionChanged(std::shared_ptr<const UICommon::GameFile> game_file);
   void OnRecordingStatusChanged(bool recording);
@@ -213,6 +215,7 @@ private:
   QAction* m_check_nand;
   QAction* m_extract_certificates;
   std::array<QAction*, 5> m_wii_remotes;
+  QAction* m_record_trace;
 
   // Emulation
   QAction* m_play_action;
@@ -267,6 +270,8 @@ private:
   QAction* m_jit_clear_cache;
   QAction* m_jit_log_coverage;
   QAction* m_jit_search_instruction;
+  QAction* m_jit_profile_blocks;
+  QAction* m_jit_write_profile;
   QAction* m_jit_off;
   QAction* m_jit_loadstore_off;
   QAction* m_jit_loadstore_lbzx_off;
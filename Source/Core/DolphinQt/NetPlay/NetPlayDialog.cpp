@@ -199,12 +199,20 @@ void NetPlayDialog::CreateMainLayout()
          "switched at any time.\nSuitable for turn-based games with timing-sensitive controls, "
          "such as golf."));
   m_golf_mode_action->setCheckable(true);
+  m_rollback_action = m_network_menu->addAction(tr("Rollback"));
+  m_rollback_action->setToolTip(
+      tr("Each player sends their own inputs to the game without a buffer. Inputs of other "
+         "players that didn't arrive yet are predicted, and the game is rolled back and run again "
+         "when a prediction was wrong.\nSuitable for GameCube games on stable connections with a "
+         "fast computer. Wii Remotes still use the buffer."));
+  m_rollback_action->setCheckable(true);
 
   m_network_mode_group = new QActionGroup(this);
   m_network_mode_group->setExclusive(true);
   m_network_mode_group->addAction(m_fixed_delay_action);
   m_network_mode_group->addAction(m_host_input_authority_action);
   m_network_mode_group->addAction(m_golf_mode_action);
+  m_network_mode_group->addAction(m_rollback_action);
   m_fixed_delay_action->setChecked(true);
 
   m_game_digest_menu = m_menu_bar->addMenu(tr("Checksum"));
@@ -291,6 +299,9 @@ void NetPlayDialog::CreatePlayersLayout()
   m_hostcode_label = new QLabel;
   m_hostcode_action_button = new QPushButton(tr("Copy"));
   m_players_list = new QTableWidget;
+  m_input_traffic_label = new QLabel;
+  m_input_traffic_label->setToolTip(
+      tr("How much pad and Wii Remote data this client sends and receives"));
   m_kick_button = new QPushButton(tr("Kick Player"));
   m_assign_ports_button = new QPushButton(tr("Assign Controller Ports"));
 
@@ -310,8 +321,9 @@ void NetPlayDialog::CreatePlayersLayout()
   layout->addWidget(m_hostcode_label, 0, 1);
   layout->addWidget(m_hostcode_action_button, 0, 2);
   layout->addWidget(m_players_list, 1, 0, 1, -1);
-  layout->addWidget(m_kick_button, 2, 0, 1, -1);
-  layout->addWidget(m_assign_ports_button, 3, 0, 1, -1);
+  layout->addWidget(m_input_traffic_label, 2, 0, 1, -1);
+  layout->addWidget(m_kick_button, 3, 0, 1, -1);
+  layout->addWidget(m_assign_ports_button, 4, 0, 1, -1);
 
   m_players_box->setLayout(layout);
 }
@@ -377,6 +389,7 @@ void NetPlayDialog::ConnectWidgets()
           [hia_function] { hia_function(true); });
   connect(m_golf_mode_action, &QAction::toggled, this, [hia_function] { hia_function(true); });
   connect(m_fixed_delay_action, &QAction::toggled, this, [hia_function] { hia_function(false); });
+  connect(m_rollback_action, &QAction::toggled, this, [hia_function] { hia_function(false); });
 
   connect(m_start_button, &QPushButton::clicked, this, &NetPlayDialog::OnStart);
   connect(m_quit_button, &QPushButton::clicked, this, &NetPlayDialog::reject);
@@ -426,6 +439,7 @@ void NetPlayDialog::ConnectWidgets()
   connect(m_golf_mode_action, &QAction::toggled, this, &NetPlayDialog::SaveSettings);
   connect(m_golf_mode_overlay_action, &QAction::toggled, this, &NetPlayDialog::SaveSettings);
   connect(m_fixed_delay_action, &QAction::toggled, this, &NetPlayDialog::SaveSettings);
+  connect(m_rollback_action, &QAction::toggled, this, &NetPlayDialog::SaveSettings);
   connect(m_hide_remote_gbas_action, &QAction::toggled, this, &NetPlayDialog::SaveSettings);
 }
 
@@ -690,6 +704,36 @@ void NetPlayDialog::UpdateGUI()
       m_players_list->selectRow(i);
   }
 
+  const auto now = std::chrono::steady_clock::now();
+  const std::chrono::duration<double> traffic_elapsed = now - m_last_input_traffic_time;
+  if (traffic_elapsed >= std::chrono::seconds(1))
+  {
+    const auto traffic = client->GetInputTraffic();
+    // A new client starts counting from zero again
+    if (traffic.bytes_sent < m_last_input_traffic.bytes_sent ||
+        traffic.bytes_received < m_last_input_traffic.bytes_received)
+    {
+      m_last_input_traffic = {};
+    }
+    const double kib_per_second = 1024.0 * traffic_elapsed.count();
+    QString text =
+        tr("Input data: %1 KiB/s sent, %2 KiB/s received")
+            .arg((traffic.bytes_sent - m_last_input_traffic.bytes_sent) / kib_per_second, 0, 'f',
+                 1)
+            .arg((traffic.bytes_received - m_last_input_traffic.bytes_received) / kib_per_second,
+                 0, 'f', 1);
+    if (const auto stats = client->GetRollbackStats())
+    {
+      text += QStringLiteral("\n") +
+              tr("Rollbacks: %1, last one ran %2 frames again in %3 ms").arg(stats->rollbacks)
+                  .arg(stats->last_resimulated_frames)
+                  .arg(stats->last_resimulation_us / 1000.0, 0, 'f', 1);
+    }
+    m_input_traffic_label->setText(text);
+    m_last_input_traffic = traffic;
+    m_last_input_traffic_time = now;
+  }
+
   if (m_old_player_count != m_player_count)
   {
     UpdateDiscordPresence();
@@ -864,6 +908,7 @@ void NetPlayDialog::SetOptionsEnabled(bool enabled)
     m_host_input_authority_action->setEnabled(enabled);
     m_golf_mode_action->setEnabled(enabled);
     m_fixed_delay_action->setEnabled(enabled);
+    m_rollback_action->setEnabled(enabled);
   }
 
   m_record_input_action->setEnabled(enabled);
@@ -1162,6 +1207,10 @@ void NetPlayDialog::LoadSettings()
   {
     m_golf_mode_action->setChecked(true);
   }
+  else if (network_mode == "rollback")
+  {
+    m_rollback_action->setChecked(true);
+  }
   else
   {
     WARN_LOG_FMT(NETPLAY, "Unknown network mode '{}', using 'fixeddelay'", network_mode);
@@ -1204,6 +1253,10 @@ void NetPlayDialog::SaveSettings()
   {
     network_mode = "golf";
   }
+  else if (m_rollback_action->isChecked())
+  {
+    network_mode = "rollback";
+  }
 
   Config::SetBase(Config::NETPLAY_NETWORK_MODE, network_mode);
 }
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <functional>
 #include <memory>
 #include <string>
@@ -129,6 +130,7 @@ private:
   QLabel* m_hostcode_label;
   QPushButton* m_hostcode_action_button;
   QTableWidget* m_players_list;
+  QLabel* m_input_traffic_label;
   QPushButton* m_kick_button;
   QPushButton* m_assign_ports_button;
 
@@ -156,6 +158,7 @@ private:
   QAction* m_golf_mode_action;
   QAction* m_golf_mode_overlay_action;
   QAction* m_fixed_delay_action;
+  QAction* m_rollback_action;
   QAction* m_hide_remote_gbas_action;
   QPushButton* m_quit_button;
   QSplitter* m_splitter;
@@ -176,6 +179,8 @@ private:
   int m_buffer_size = 0;
   int m_player_count = 0;
   int m_old_player_count = 0;
+  NetPlay::NetPlayClient::InputTraffic m_last_input_traffic;
+  std::chrono::steady_clock::time_point m_last_input_traffic_time;
   bool m_host_input_authority = false;
 
   StartGameCallback m_start_game_callback;
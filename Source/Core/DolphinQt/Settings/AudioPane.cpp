@@ -93,6 +93,12 @@ void AudioPane::CreateWidgets()
            "crackling. Certain backends only."));
   }
 
+  m_low_latency = new QCheckBox(tr("Adaptive Low Latency"));
+  m_low_latency->setToolTip(
+      tr("Buffers only as much audio as the audio driver needs to play without "
+         "crackling, measured while playing. Reduces audio latency, but may crackle "
+         "during stutters."));
+
   m_dolby_pro_logic->setToolTip(
       tr("Enables Dolby Pro Logic II emulation using 5.1 surround. Certain backends only."));
 
@@ -115,6 +121,11 @@ void AudioPane::CreateWidgets()
   m_dolby_quality_latency_label =
       new QLabel(GetDPL2ApproximateLatencyLabel(AudioCommon::DPL2Quality::Highest));
 
+  m_dolby_matrix = new QCheckBox(tr("Passive Matrix Decoding"));
+  m_dolby_matrix->setToolTip(
+      tr("Decodes with a fixed matrix instead of steering the channels by frequency. Uses much "
+         "less CPU time and adds no latency, but separates the channels less."));
+
   dolby_quality_layout->addWidget(m_dolby_quality_low_label);
   dolby_quality_layout->addWidget(m_dolby_quality_slider);
   dolby_quality_layout->addWidget(m_dolby_quality_highest_label);
@@ -124,6 +135,7 @@ void AudioPane::CreateWidgets()
   backend_layout->addRow(m_backend_label, m_backend_combo);
   if (m_latency_control_supported)
     backend_layout->addRow(m_latency_label, m_latency_spin);
+  backend_layout->addRow(m_low_latency);
 
 #ifdef _WIN32
   m_wasapi_device_label = new QLabel(tr("Device:"));
@@ -136,6 +148,7 @@ void AudioPane::CreateWidgets()
   backend_layout->addRow(m_dolby_quality_label);
   backend_layout->addRow(dolby_quality_layout);
   backend_layout->addRow(m_dolby_quality_latency_label);
+  backend_layout->addRow(m_dolby_matrix);
 
   auto* stretching_box = new QGroupBox(tr("Audio Stretching Settings"));
   auto* stretching_layout = new QGridLayout;
@@ -182,9 +195,11 @@ void AudioPane::ConnectWidgets()
     connect(m_latency_spin, qOverload<int>(&QSpinBox::valueChanged), this,
             &AudioPane::SaveSettings);
   }
+  connect(m_low_latency, &QCheckBox::toggled, this, &AudioPane::SaveSettings);
   connect(m_stretching_buffer_slider, &QSlider::valueChanged, this, &AudioPane::SaveSettings);
   connect(m_dolby_pro_logic, &QCheckBox::toggled, this, &AudioPane::SaveSettings);
   connect(m_dolby_quality_slider, &QSlider::valueChanged, this, &AudioPane::SaveSettings);
+  connect(m_dolby_matrix, &QCheckBox::toggled, this, &AudioPane::SaveSettings);
   connect(m_stretching_enable, &QCheckBox::toggled, this, &AudioPane::SaveSettings);
   connect(m_dsp_hle, &QRadioButton::toggled, this, &AudioPane::SaveSettings);
   connect(m_dsp_lle, &QRadioButton::toggled, this, &AudioPane::SaveSettings);
@@ -236,6 +251,7 @@ void AudioPane::LoadSettings()
   m_dolby_quality_slider->setValue(int(Config::Get(Config::MAIN_DPL2_QUALITY)));
   m_dolby_quality_latency_label->setText(
       GetDPL2ApproximateLatencyLabel(Config::Get(Config::MAIN_DPL2_QUALITY)));
+  m_dolby_matrix->setChecked(Config::Get(Config::MAIN_DPL2_MODE) == AudioCommon::DPL2Mode::Matrix);
   if (AudioCommon::SupportsDPL2Decoder(current) && !m_dsp_hle->isChecked())
   {
     EnableDolbyQualityWidgets(m_dolby_pro_logic->isChecked());
@@ -244,6 +260,7 @@ void AudioPane::LoadSettings()
   // Latency
   if (m_latency_control_supported)
     m_latency_spin->setValue(Config::Get(Config::MAIN_AUDIO_LATENCY));
+  m_low_latency->setChecked(Config::Get(Config::MAIN_AUDIO_LOW_LATENCY));
 
   // Stretch
   m_stretching_enable->setChecked(Config::Get(Config::MAIN_AUDIO_STRETCH));
@@ -304,6 +321,9 @@ void AudioPane::SaveSettings()
                   static_cast<AudioCommon::DPL2Quality>(m_dolby_quality_slider->value()));
   m_dolby_quality_latency_label->setText(
       GetDPL2ApproximateLatencyLabel(Config::Get(Config::MAIN_DPL2_QUALITY)));
+  Config::SetBaseOrCurrent(Config::MAIN_DPL2_MODE, m_dolby_matrix->isChecked() ?
+                                                       AudioCommon::DPL2Mode::Matrix :
+                                                       AudioCommon::DPL2Mode::FreeSurround);
   if (AudioCommon::SupportsDPL2Decoder(backend) && !m_dsp_hle->isChecked())
   {
     EnableDolbyQualityWidgets(m_dolby_pro_logic->isChecked());
@@ -312,6 +332,7 @@ void AudioPane::SaveSettings()
   // Latency
   if (m_latency_control_supported)
     Config::SetBaseOrCurrent(Config::MAIN_AUDIO_LATENCY, m_latency_spin->value());
+  Config::SetBaseOrCurrent(Config::MAIN_AUDIO_LOW_LATENCY, m_low_latency->isChecked());
 
   // Stretch
   Config::SetBaseOrCurrent(Config::MAIN_AUDIO_STRETCH, m_stretching_enable->isChecked());
@@ -396,6 +417,8 @@ void AudioPane::OnEmulationStateChanged(bool running)
     m_latency_label->setEnabled(!running);
     m_latency_spin->setEnabled(!running);
   }
+  // The backends pick their buffer sizes when they start
+  m_low_latency->setEnabled(!running);
 
 #ifdef _WIN32
   m_wasapi_device_combo->setEnabled(!running);
@@ -452,4 +475,5 @@ void AudioPane::EnableDolbyQualityWidgets(bool enabled) const
   m_dolby_quality_low_label->setEnabled(enabled);
   m_dolby_quality_highest_label->setEnabled(enabled);
   m_dolby_quality_latency_label->setEnabled(enabled);
+  m_dolby_matrix->setEnabled(enabled);
 }
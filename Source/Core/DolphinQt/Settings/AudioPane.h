@@ -64,8 +64,10 @@ private:
   QLabel* m_dolby_quality_low_label;
   QLabel* m_dolby_quality_highest_label;
   QLabel* m_dolby_quality_latency_label;
+  QCheckBox* m_dolby_matrix;
   QLabel* m_latency_label;
   QSpinBox* m_latency_spin;
+  QCheckBox* m_low_latency;
 #ifdef _WIN32
   QLabel* m_wasapi_device_label;
   QComboBox* m_wasapi_device_combo;
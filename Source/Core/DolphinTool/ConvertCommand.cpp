@@ -3,20 +3,35 @@
 
 #include "DolphinTool/ConvertCommand.h"
 
+#include <algorithm>
+#include <condition_variable>
 #include <cstdlib>
+#include <cstring>
+#include <filesystem>
 #include <iostream>
 #include <limits>
+#include <mutex>
 #include <optional>
+#include <set>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <vector>
 
 #include <OptionParser.h>
 #include <fmt/format.h>
 #include <fmt/ostream.h>
 
+#include "Common/CommonPaths.h"
 #include "Common/CommonTypes.h"
+#include "Common/FileSearch.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Common/StringUtil.h"
 #include "DiscIO/Blob.h"
+#include "DiscIO/DiscAccessProfile.h"
 #include "DiscIO/DiscUtils.h"
+#include "DiscIO/MultithreadedCompressor.h"
 #include "DiscIO/ScrubbedBlob.h"
 #include "DiscIO/Volume.h"
 #include "DiscIO/VolumeDisc.h"
@@ -25,6 +40,16 @@
 
 namespace DolphinTool
 {
+struct ConversionSettings
+{
+  DiscIO::BlobType format;
+  bool scrub;
+  std::optional<int> block_size;
+  std::optional<DiscIO::WIARVZCompressionType> compression;
+  std::optional<int> compression_level;
+  std::optional<DiscIO::DiscAccessProfile> profile;
+};
+
 static std::optional<DiscIO::WIARVZCompressionType>
 ParseCompressionTypeString(const std::string& compression_str)
 {
@@ -56,105 +81,107 @@ static std::optional<DiscIO::BlobType> ParseFormatString(const std::string& form
   return std::nullopt;
 }
 
-int ConvertCommand(const std::vector<std::string>& args)
+static const char* GetFormatExtension(DiscIO::BlobType format)
 {
-  optparse::OptionParser parser;
-
-  parser.usage("usage: convert [options]... [FILE]...");
-
-  parser.add_option("-u", "--user")
-      .type("string")
-      .action("store")
-      .help("User folder path, required for temporary processing files. "
-            "Will be automatically created if this option is not set.")
-      .set_default("");
-
-  parser.add_option("-i", "--input")
-      .type("string")
-      .action("store")
-      .help("Path to disc image FILE.")
-      .metavar("FILE");
-
-  parser.add_option("-o", "--output")
-      .type("string")
-      .action("store")
-      .help("Path to the destination FILE.")
-      .metavar("FILE");
-
-  parser.add_option("-f", "--format")
-      .type("string")
-      .action("store")
-      .help("Container format to use. Default is RVZ. [%choices]")
-      .choices({"iso", "gcz", "wia", "rvz"});
+  switch (format)
+  {
+  case DiscIO::BlobType::GCZ:
+    return ".gcz";
+  case DiscIO::BlobType::WIA:
+    return ".wia";
+  case DiscIO::BlobType::RVZ:
+    return ".rvz";
+  default:
+    return ".iso";
+  }
+}
 
-  parser.add_option("-s", "--scrub")
-      .action("store_true")
-      .help("Scrub junk data as part of conversion.");
+// Checks the parts of the settings that don't depend on the input image
+static bool ValidateSettings(ConversionSettings* settings)
+{
+  const DiscIO::BlobType format = settings->format;
 
-  parser.add_option("-b", "--block_size")
-      .type("int")
-      .action("store")
-      .help("Block size for GCZ/WIA/RVZ formats, as an integer. Suggested value for RVZ: 131072 "
-            "(128 KiB)");
+  if (format == DiscIO::BlobType::GCZ || format == DiscIO::BlobType::WIA ||
+      format == DiscIO::BlobType::RVZ)
+  {
+    if (!settings->block_size.has_value())
+    {
+      fmt::print(std::cerr, "Error: Block size must be set for GCZ/RVZ/WIA\n");
+      return false;
+    }
 
-  parser.add_option("-c", "--compression")
-      .type("string")
-      .action("store")
-      .help("Compression method to use when converting to WIA/RVZ. Suggested value for RVZ: zstd "
-            "[%choices]")
-      .choices({"none", "zstd", "bzip", "lzma", "lzma2"});
+    if (!DiscIO::IsDiscImageBlockSizeValid(settings->block_size.value(), format))
+    {
+      fmt::print(std::cerr, "Error: Block size is not valid for this format\n");
+      return false;
+    }
 
-  parser.add_option("-l", "--compression_level")
-      .type("int")
-      .action("store")
-      .help("Level of compression for the selected method. Ignored if 'none'. Suggested value for "
-            "zstd: 5");
+    if (settings->block_size.value() < DiscIO::PREFERRED_MIN_BLOCK_SIZE ||
+        settings->block_size.value() > DiscIO::PREFERRED_MAX_BLOCK_SIZE)
+    {
+      fmt::print(std::cerr,
+                 "Warning: Block size is not ideal for performance. Continuing anyway.\n");
+    }
+  }
 
-  const optparse::Values& options = parser.parse_args(args);
+  if (format == DiscIO::BlobType::WIA || format == DiscIO::BlobType::RVZ)
+  {
+    if (!settings->compression.has_value())
+    {
+      fmt::print(std::cerr, "Error: Compression format must be set for WIA or RVZ\n");
+      return false;
+    }
 
-  // Initialize the dolphin user directory, required for temporary processing files
-  // If this is not set, destructive file operations could occur due to path confusion
-  UICommon::SetUserDirectory(options["user"]);
-  UICommon::Init();
+    if ((format == DiscIO::BlobType::WIA &&
+         settings->compression.value() == DiscIO::WIARVZCompressionType::Zstd) ||
+        (format == DiscIO::BlobType::RVZ &&
+         settings->compression.value() == DiscIO::WIARVZCompressionType::Purge))
+    {
+      fmt::print(std::cerr, "Error: Compression type is not supported for the container format\n");
+      return false;
+    }
 
-  // Validate options
+    if (settings->compression.value() == DiscIO::WIARVZCompressionType::None)
+    {
+      settings->compression_level = 0;
+    }
+    else
+    {
+      if (!settings->compression_level.has_value())
+      {
+        fmt::print(std::cerr,
+                   "Error: Compression level must be set when compression type is not 'none'\n");
+        return false;
+      }
 
-  // --input
-  if (!options.is_set("input"))
-  {
-    fmt::print(std::cerr, "Error: No input set\n");
-    return EXIT_FAILURE;
+      const std::pair<int, int> range =
+          DiscIO::GetAllowedCompressionLevels(settings->compression.value(), false);
+      if (settings->compression_level.value() < range.first ||
+          settings->compression_level.value() > range.second)
+      {
+        fmt::print(std::cerr, "Error: Compression level not in acceptable range\n");
+        return false;
+      }
+    }
   }
-  const std::string& input_file_path = options["input"];
 
-  // --output
-  if (!options.is_set("output"))
-  {
-    fmt::print(std::cerr, "Error: No output set\n");
-    return EXIT_FAILURE;
-  }
-  const std::string& output_file_path = options["output"];
+  return true;
+}
 
-  // --format
-  const std::optional<DiscIO::BlobType> format_o = ParseFormatString(options["format"]);
-  if (!format_o.has_value())
-  {
-    fmt::print(std::cerr, "Error: No output format set\n");
-    return EXIT_FAILURE;
-  }
-  const DiscIO::BlobType format = format_o.value();
+static bool ConvertImage(const ConversionSettings& settings, const std::string& input_file_path,
+                         const std::string& output_file_path)
+{
+  const DiscIO::BlobType format = settings.format;
+  const bool scrub = settings.scrub;
 
   // Open the blob reader
   std::unique_ptr<DiscIO::BlobReader> blob_reader = DiscIO::CreateBlobReader(input_file_path);
   if (!blob_reader)
   {
     fmt::print(std::cerr, "Error: The input file could not be opened.\n");
-    return EXIT_FAILURE;
+    return false;
   }
 
-  // --scrub
-  const bool scrub = static_cast<bool>(options.get("scrub"));
-
   // Open the volume
   std::unique_ptr<DiscIO::Volume> volume = DiscIO::CreateDisc(input_file_path);
   if (!volume)
@@ -162,7 +189,7 @@ int ConvertCommand(const std::vector<std::string>& args)
     if (scrub)
     {
       fmt::print(std::cerr, "Error: Scrubbing is only supported for GC/Wii disc images.\n");
-      return EXIT_FAILURE;
+      return false;
     }
 
     fmt::print(std::cerr,
@@ -174,7 +201,7 @@ int ConvertCommand(const std::vector<std::string>& args)
     if (volume->IsDatelDisc())
     {
       fmt::print(std::cerr, "Error: Scrubbing a Datel disc is not supported.\n");
-      return EXIT_FAILURE;
+      return false;
     }
 
     blob_reader = DiscIO::ScrubbedBlob::Create(input_file_path);
@@ -182,7 +209,7 @@ int ConvertCommand(const std::vector<std::string>& args)
     if (!blob_reader)
     {
       fmt::print(std::cerr, "Error: Unable to process disc image. Try again without --scrub.\n");
-      return EXIT_FAILURE;
+      return false;
     }
   }
 
@@ -211,88 +238,26 @@ int ConvertCommand(const std::vector<std::string>& args)
                "Warning: Converting an NKit file, output will still be NKit! Continuing anyway.\n");
   }
 
-  // --block_size
-  std::optional<int> block_size_o;
-  if (options.is_set("block_size"))
-    block_size_o = static_cast<int>(options.get("block_size"));
-
-  if (format == DiscIO::BlobType::GCZ || format == DiscIO::BlobType::WIA ||
-      format == DiscIO::BlobType::RVZ)
+  if (format == DiscIO::BlobType::GCZ && volume &&
+      !DiscIO::IsGCZBlockSizeLegacyCompatible(settings.block_size.value(), volume->GetDataSize()))
   {
-    if (!block_size_o.has_value())
-    {
-      fmt::print(std::cerr, "Error: Block size must be set for GCZ/RVZ/WIA\n");
-      return EXIT_FAILURE;
-    }
-
-    if (!DiscIO::IsDiscImageBlockSizeValid(block_size_o.value(), format))
-    {
-      fmt::print(std::cerr, "Error: Block size is not valid for this format\n");
-      return EXIT_FAILURE;
-    }
-
-    if (block_size_o.value() < DiscIO::PREFERRED_MIN_BLOCK_SIZE ||
-        block_size_o.value() > DiscIO::PREFERRED_MAX_BLOCK_SIZE)
-    {
-      fmt::print(std::cerr,
-                 "Warning: Block size is not ideal for performance. Continuing anyway.\n");
-    }
-
-    if (format == DiscIO::BlobType::GCZ && volume &&
-        !DiscIO::IsGCZBlockSizeLegacyCompatible(block_size_o.value(), volume->GetDataSize()))
-    {
-      fmt::print(std::cerr,
-                 "Warning: For GCZs to be compatible with Dolphin < 5.0-11893, the file size "
-                 "must be an integer multiple of the block size and must not be an integer "
-                 "multiple of the block size multiplied by 32. Continuing anyway.\n");
-    }
+    fmt::print(std::cerr,
+               "Warning: For GCZs to be compatible with Dolphin < 5.0-11893, the file size "
+               "must be an integer multiple of the block size and must not be an integer "
+               "multiple of the block size multiplied by 32. Continuing anyway.\n");
   }
 
-  // --compress, --compress_level
-  std::optional<DiscIO::WIARVZCompressionType> compression_o =
-      ParseCompressionTypeString(options["compression"]);
-
-  std::optional<int> compression_level_o;
-  if (options.is_set("compression_level"))
-    compression_level_o = static_cast<int>(options.get("compression_level"));
-
-  if (format == DiscIO::BlobType::WIA || format == DiscIO::BlobType::RVZ)
+  if (settings.profile && volume)
   {
-    if (!compression_o.has_value())
-    {
-      fmt::print(std::cerr, "Error: Compression format must be set for WIA or RVZ\n");
-      return EXIT_FAILURE;
-    }
-
-    if ((format == DiscIO::BlobType::WIA &&
-         compression_o.value() == DiscIO::WIARVZCompressionType::Zstd) ||
-        (format == DiscIO::BlobType::RVZ &&
-         compression_o.value() == DiscIO::WIARVZCompressionType::Purge))
-    {
-      fmt::print(std::cerr, "Error: Compression type is not supported for the container format\n");
-      return EXIT_FAILURE;
-    }
-
-    if (compression_o.value() == DiscIO::WIARVZCompressionType::None)
-    {
-      compression_level_o = 0;
-    }
-    else
+    const DiscIO::DiscAccessHeader& header = settings.profile->header;
+    const std::string profile_game_id(header.game_id,
+                                      strnlen(header.game_id, sizeof(header.game_id)));
+    if (profile_game_id != volume->GetGameID())
     {
-      if (!compression_level_o.has_value())
-      {
-        fmt::print(std::cerr,
-                   "Error: Compression level must be set when compression type is not 'none'\n");
-        return EXIT_FAILURE;
-      }
-
-      const std::pair<int, int> range =
-          DiscIO::GetAllowedCompressionLevels(compression_o.value(), false);
-      if (compression_level_o.value() < range.first || compression_level_o.value() > range.second)
-      {
-        fmt::print(std::cerr, "Error: Compression level not in acceptable range\n");
-        return EXIT_FAILURE;
-      }
+      fmt::print(std::cerr,
+                 "Warning: The disc access profile was recorded with {} and not with {}. "
+                 "Continuing anyway.\n",
+                 profile_game_id, volume->GetGameID());
     }
   }
 
@@ -321,17 +286,18 @@ int ConvertCommand(const std::vector<std::string>& args)
         sub_type = 1;
     }
     success = DiscIO::ConvertToGCZ(blob_reader.get(), input_file_path, output_file_path, sub_type,
-                                   block_size_o.value(), NOOP_STATUS_CALLBACK);
+                                   settings.block_size.value(), NOOP_STATUS_CALLBACK);
     break;
   }
 
   case DiscIO::BlobType::WIA:
   case DiscIO::BlobType::RVZ:
   {
-    success = DiscIO::ConvertToWIAOrRVZ(blob_reader.get(), input_file_path, output_file_path,
-                                        format == DiscIO::BlobType::RVZ, compression_o.value(),
-                                        compression_level_o.value(), block_size_o.value(),
-                                        NOOP_STATUS_CALLBACK);
+    success = DiscIO::ConvertToWIAOrRVZ(
+        blob_reader.get(), input_file_path, output_file_path, format == DiscIO::BlobType::RVZ,
+        settings.compression.value(), settings.compression_level.value(),
+        settings.block_size.value(), NOOP_STATUS_CALLBACK,
+        settings.profile ? &settings.profile.value() : nullptr);
     break;
   }
 
@@ -345,9 +311,380 @@ int ConvertCommand(const std::vector<std::string>& args)
   if (!success)
   {
     fmt::print(std::cerr, "Error: Conversion failed\n");
+    return false;
+  }
+
+  return true;
+}
+
+// Every compression thread holds an input and an output block plus its compressor
+static u64 GetConversionMemoryUsage(const ConversionSettings& settings, unsigned int threads)
+{
+  u64 per_thread = 0;
+  switch (settings.format)
+  {
+  case DiscIO::BlobType::GCZ:
+    // zlib's deflate state
+    per_thread = 2 * u64(settings.block_size.value()) + 256 * 1024;
+    break;
+  case DiscIO::BlobType::WIA:
+  case DiscIO::BlobType::RVZ:
+    // A chunk can be made of several Wii groups, each of which may be read whole
+    per_thread = 2 * std::max<u64>(settings.block_size.value(), 0x200000) +
+                 DiscIO::GetCompressorMemoryUsage(settings.compression.value(),
+                                                  settings.compression_level.value());
+    break;
+  default:
+    break;
+  }
+
+  return per_thread * threads;
+}
+
+static std::vector<std::string> GetBatchInputs(const std::string& input)
+{
+  if (File::IsDirectory(input))
+  {
+    std::vector<std::string> paths = Common::DoFileSearch(
+        {input}, {".gcm", ".iso", ".tgc", ".wbfs", ".ciso", ".gcz", ".wia", ".rvz", ".nfs"}, true);
+    std::sort(paths.begin(), paths.end());
+    return paths;
+  }
+
+  // A list file has one path per line. Empty lines and lines starting with # are skipped.
+  std::string list;
+  if (!File::ReadFileToString(input, list))
+    return {};
+
+  std::vector<std::string> paths;
+  for (const std::string& line : SplitString(list, '\n'))
+  {
+    const std::string_view path = StripWhitespace(line);
+    if (!path.empty() && path[0] != '#')
+      paths.emplace_back(path);
+  }
+  return paths;
+}
+
+static std::string GetBatchOutputPath(const std::string& input_root, const std::string& input,
+                                      const std::string& output_directory,
+                                      DiscIO::BlobType format)
+{
+  // Images found by searching a directory keep their place relative to it, so that images with
+  // the same name in different folders don't overwrite each other
+  std::filesystem::path relative_path;
+  if (File::IsDirectory(input_root))
+    relative_path = StringToPath(input).lexically_relative(StringToPath(input_root));
+  if (relative_path.empty() || *relative_path.begin() == "..")
+    relative_path = StringToPath(input).filename();
+
+  relative_path.replace_extension(GetFormatExtension(format));
+  return PathToString(StringToPath(output_directory) / relative_path);
+}
+
+// The manifest lists the input of each finished conversion, one per line
+static std::set<std::string> ReadManifest(const std::string& path)
+{
+  std::set<std::string> finished;
+  std::string manifest;
+  if (!File::ReadFileToString(path, manifest))
+    return finished;
+
+  for (const std::string& line : SplitString(manifest, '\n'))
+  {
+    if (!line.empty())
+      finished.insert(line);
+  }
+  return finished;
+}
+
+static int BatchConvert(const ConversionSettings& settings, const std::string& input,
+                        const std::string& output_directory, const std::string& manifest_path,
+                        unsigned int jobs, u64 memory_budget)
+{
+  const std::vector<std::string> inputs = GetBatchInputs(input);
+  if (inputs.empty())
+  {
+    fmt::print(std::cerr, "Error: No disc images found in {}\n", input);
+    return EXIT_FAILURE;
+  }
+
+  if (!File::CreateFullPath(manifest_path))
+  {
+    fmt::print(std::cerr, "Error: Unable to create the directory of {}\n", manifest_path);
+    return EXIT_FAILURE;
+  }
+
+  const std::set<std::string> finished = ReadManifest(manifest_path);
+
+  struct Conversion
+  {
+    std::string input;
+    std::string output;
+  };
+  std::vector<Conversion> conversions;
+  for (const std::string& path : inputs)
+  {
+    std::string output = GetBatchOutputPath(input, path, output_directory, settings.format);
+    if (finished.contains(path) && File::Exists(output))
+      continue;
+
+    conversions.push_back({path, std::move(output)});
+  }
+
+  fmt::print(std::cerr, "{} of {} disc images left to convert\n", conversions.size(),
+             inputs.size());
+  if (conversions.empty())
+    return EXIT_SUCCESS;
+
+  // The compression threads are divided between the conversions running at once
+  jobs = std::clamp<unsigned int>(jobs, 1, static_cast<unsigned int>(conversions.size()));
+  const unsigned int hardware_threads = std::max(1u, std::thread::hardware_concurrency());
+  const unsigned int compression_threads = std::max(1u, hardware_threads / jobs);
+  DiscIO::SetCompressionThreadCount(compression_threads);
+
+  const u64 memory_per_conversion = GetConversionMemoryUsage(settings, compression_threads);
+  if (memory_per_conversion > memory_budget)
+  {
+    fmt::print(std::cerr,
+               "Warning: One conversion needs about {} MiB, which is more than the memory "
+               "budget. Converting one image at a time.\n",
+               memory_per_conversion >> 20);
+  }
+
+  File::IOFile manifest(manifest_path, "ab");
+  std::mutex mutex;
+  std::condition_variable memory_released;
+  u64 memory_in_use = 0;
+  size_t next_conversion = 0;
+  size_t failures = 0;
+
+  const auto worker = [&] {
+    std::unique_lock lk(mutex);
+    while (next_conversion < conversions.size())
+    {
+      const Conversion& conversion = conversions[next_conversion++];
+
+      // A conversion always starts if nothing else is running, even if it's over the budget
+      memory_released.wait(lk, [&] {
+        return memory_in_use == 0 || memory_in_use + memory_per_conversion <= memory_budget;
+      });
+      memory_in_use += memory_per_conversion;
+
+      fmt::print(std::cerr, "Converting {}\n", conversion.input);
+      lk.unlock();
+
+      const bool success = File::CreateFullPath(conversion.output) &&
+                           ConvertImage(settings, conversion.input, conversion.output);
+
+      lk.lock();
+      memory_in_use -= memory_per_conversion;
+      memory_released.notify_all();
+
+      if (success)
+      {
+        const std::string line = conversion.input + '\n';
+        manifest.WriteString(line);
+        manifest.Flush();
+        fmt::print(std::cerr, "Converted {} to {}\n", conversion.input, conversion.output);
+      }
+      else
+      {
+        ++failures;
+        fmt::print(std::cerr, "Failed to convert {}\n", conversion.input);
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (unsigned int i = 0; i < jobs; ++i)
+    threads.emplace_back(worker);
+  for (std::thread& thread : threads)
+    thread.join();
+
+  fmt::print(std::cerr, "Converted {} of {} disc images\n", conversions.size() - failures,
+             conversions.size());
+  return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int ConvertCommand(const std::vector<std::string>& args)
+{
+  optparse::OptionParser parser;
+
+  parser.usage("usage: convert [options]... [FILE]...");
+
+  parser.add_option("-u", "--user")
+      .type("string")
+      .action("store")
+      .help("User folder path, required for temporary processing files. "
+            "Will be automatically created if this option is not set.")
+      .set_default("");
+
+  parser.add_option("-i", "--input")
+      .type("string")
+      .action("store")
+      .help("Path to disc image FILE.")
+      .metavar("FILE");
+
+  parser.add_option("-o", "--output")
+      .type("string")
+      .action("store")
+      .help("Path to the destination FILE.")
+      .metavar("FILE");
+
+  parser.add_option("-f", "--format")
+      .type("string")
+      .action("store")
+      .help("Container format to use. Default is RVZ. [%choices]")
+      .choices({"iso", "gcz", "wia", "rvz"});
+
+  parser.add_option("-s", "--scrub")
+      .action("store_true")
+      .help("Scrub junk data as part of conversion.");
+
+  parser.add_option("-b", "--block_size")
+      .type("int")
+      .action("store")
+      .help("Block size for GCZ/WIA/RVZ formats, as an integer. Suggested value for RVZ: 131072 "
+            "(128 KiB)");
+
+  parser.add_option("-c", "--compression")
+      .type("string")
+      .action("store")
+      .help("Compression method to use when converting to WIA/RVZ. Suggested value for RVZ: zstd "
+            "[%choices]")
+      .choices({"none", "zstd", "bzip", "lzma", "lzma2"});
+
+  parser.add_option("-l", "--compression_level")
+      .type("int")
+      .action("store")
+      .help("Level of compression for the selected method. Ignored if 'none'. Suggested value for "
+            "zstd: 5");
+
+  parser.add_option("-p", "--profile")
+      .type("string")
+      .action("store")
+      .help("Path to a disc access profile FILE made with the profile command. WIA/RVZ group "
+            "data is stored in the order the game first read it.")
+      .metavar("FILE");
+
+  parser.add_option("-B", "--batch")
+      .action("store_true")
+      .help("Convert many disc images. The input is a directory, which is searched recursively, "
+            "or a file listing one image per line. The output is a directory.");
+
+  parser.add_option("-j", "--jobs")
+      .type("int")
+      .action("store")
+      .help("Batch mode: how many images to convert at once. Default is 2.")
+      .set_default(2);
+
+  parser.add_option("-m", "--memory")
+      .type("int")
+      .action("store")
+      .help("Batch mode: memory budget in MiB for all conversions together. Default is 4096.")
+      .set_default(4096);
+
+  parser.add_option("--manifest")
+      .type("string")
+      .action("store")
+      .help("Batch mode: FILE that lists finished conversions, so that an interrupted batch "
+            "can be resumed. Default is convert-manifest.txt in the output directory.")
+      .metavar("FILE");
+
+  const optparse::Values& options = parser.parse_args(args);
+
+  // Initialize the dolphin user directory, required for temporary processing files
+  // If this is not set, destructive file operations could occur due to path confusion
+  UICommon::SetUserDirectory(options["user"]);
+  UICommon::Init();
+
+  // Validate options
+
+  // --input
+  if (!options.is_set("input"))
+  {
+    fmt::print(std::cerr, "Error: No input set\n");
     return EXIT_FAILURE;
   }
+  const std::string& input_file_path = options["input"];
+
+  // --output
+  if (!options.is_set("output"))
+  {
+    fmt::print(std::cerr, "Error: No output set\n");
+    return EXIT_FAILURE;
+  }
+  const std::string& output_file_path = options["output"];
+
+  // --format
+  const std::optional<DiscIO::BlobType> format_o = ParseFormatString(options["format"]);
+  if (!format_o.has_value())
+  {
+    fmt::print(std::cerr, "Error: No output format set\n");
+    return EXIT_FAILURE;
+  }
+
+  ConversionSettings settings{};
+  settings.format = format_o.value();
+
+  // --scrub
+  settings.scrub = static_cast<bool>(options.get("scrub"));
+
+  // --block_size
+  if (options.is_set("block_size"))
+    settings.block_size = static_cast<int>(options.get("block_size"));
+
+  // --compress, --compress_level
+  settings.compression = ParseCompressionTypeString(options["compression"]);
+  if (options.is_set("compression_level"))
+    settings.compression_level = static_cast<int>(options.get("compression_level"));
+
+  if (!ValidateSettings(&settings))
+    return EXIT_FAILURE;
+
+  const bool batch = static_cast<bool>(options.get("batch"));
+
+  // --profile
+  if (options.is_set("profile"))
+  {
+    if (settings.format != DiscIO::BlobType::WIA && settings.format != DiscIO::BlobType::RVZ)
+    {
+      fmt::print(std::cerr, "Error: A disc access profile can only be used for WIA or RVZ\n");
+      return EXIT_FAILURE;
+    }
+
+    if (batch)
+    {
+      fmt::print(std::cerr, "Error: A disc access profile can't be used in batch mode\n");
+      return EXIT_FAILURE;
+    }
+
+    settings.profile = DiscIO::ReadDiscAccessProfile(options["profile"]);
+    if (!settings.profile.has_value())
+    {
+      fmt::print(std::cerr, "Error: The disc access profile could not be read\n");
+      return EXIT_FAILURE;
+    }
+  }
+
+  if (!batch)
+    return ConvertImage(settings, input_file_path, output_file_path) ? EXIT_SUCCESS : EXIT_FAILURE;
+
+  // --jobs, --memory, --manifest
+  const int jobs = static_cast<int>(options.get("jobs"));
+  const int memory = static_cast<int>(options.get("memory"));
+  if (jobs < 1 || memory < 1)
+  {
+    fmt::print(std::cerr, "Error: The number of jobs and the memory budget must be positive\n");
+    return EXIT_FAILURE;
+  }
+
+  const std::string manifest_path = options.is_set("manifest") ?
+                                        options["manifest"] :
+                                        output_file_path + DIR_SEP "convert-manifest.txt";
 
-  return EXIT_SUCCESS;
+  return BatchConvert(settings, input_file_path, output_file_path, manifest_path,
+                      static_cast<unsigned int>(jobs), u64(memory) << 20);
 }
 }  // namespace DolphinTool
@@ -0,0 +1,136 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinTool/ProfileCommand.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <OptionParser.h>
+#include <fmt/format.h>
+#include <fmt/ostream.h>
+
+#include "DiscIO/DiscAccessProfile.h"
+
+namespace DolphinTool
+{
+// Reads closer together than this are usually one load split into several DI commands
+constexpr u64 DEFAULT_MERGE_DISTANCE = 0x8000;
+
+static std::string_view GetGameID(const DiscIO::DiscAccessHeader& header)
+{
+  return std::string_view(header.game_id, strnlen(header.game_id, sizeof(header.game_id)));
+}
+
+int ProfileCommand(const std::vector<std::string>& args)
+{
+  optparse::OptionParser parser;
+
+  parser.usage("usage: profile [options]...");
+
+  parser.add_option("-i", "--input")
+      .type("string")
+      .action("append")
+      .help("Path to a disc access trace recorded with Core.RecordDiscAccess. "
+            "Can be given multiple times to merge traces of the same game.")
+      .metavar("FILE");
+
+  parser.add_option("-o", "--output")
+      .type("string")
+      .action("store")
+      .help("Optional. Path to the disc access profile to write.")
+      .metavar("FILE");
+
+  parser.add_option("-m", "--merge_distance")
+      .type("long")
+      .action("store")
+      .help(fmt::format("Optional. Reads at most this many bytes apart are merged into one "
+                        "extent. Defaults to {}.",
+                        DEFAULT_MERGE_DISTANCE))
+      .metavar("BYTES");
+
+  parser.add_option("-n", "--top")
+      .type("int")
+      .action("store")
+      .help("Optional. Number of extents to print, in order of first access. Defaults to 20.")
+      .metavar("COUNT");
+
+  const optparse::Values& options = parser.parse_args(args);
+
+  if (!options.is_set("input"))
+  {
+    fmt::print(std::cerr, "Error: No input set\n");
+    return EXIT_FAILURE;
+  }
+
+  std::optional<DiscIO::DiscAccessHeader> header;
+  std::vector<DiscIO::DiscAccessRecord> records;
+  for (const std::string& input_file_path : options.all("input"))
+  {
+    const std::optional<DiscIO::DiscAccessTrace> trace =
+        DiscIO::ReadDiscAccessTrace(input_file_path);
+    if (!trace)
+    {
+      fmt::print(std::cerr, "Error: {} is not a valid disc access trace\n", input_file_path);
+      return EXIT_FAILURE;
+    }
+
+    if (header && (GetGameID(*header) != GetGameID(trace->header) ||
+                   header->revision != trace->header.revision ||
+                   header->disc_number != trace->header.disc_number))
+    {
+      fmt::print(std::cerr, "Error: {} was recorded with a different disc\n", input_file_path);
+      return EXIT_FAILURE;
+    }
+
+    header = trace->header;
+    records.insert(records.end(), trace->entries.begin(), trace->entries.end());
+  }
+
+  u64 merge_distance = DEFAULT_MERGE_DISTANCE;
+  if (options.is_set("merge_distance"))
+  {
+    const long value = static_cast<long>(options.get("merge_distance"));
+    merge_distance = static_cast<u64>(std::max(value, 0L));
+  }
+
+  DiscIO::DiscAccessProfile profile;
+  profile.header = *header;
+  profile.entries = DiscIO::BuildHotExtents(records, merge_distance);
+
+  u64 total_size = 0;
+  for (const DiscIO::HotExtent& extent : profile.entries)
+    total_size += extent.end - extent.start;
+
+  fmt::print(std::cout, "{}: {} reads in {} extents, {} KiB\n", GetGameID(profile.header),
+             records.size(), profile.entries.size(), total_size / 1024);
+
+  size_t shown = 20;
+  if (options.is_set("top"))
+    shown = static_cast<size_t>(std::max(static_cast<int>(options.get("top")), 0));
+  shown = std::min(shown, profile.entries.size());
+  const double ticks_per_second = std::max<u32>(profile.header.ticks_per_second, 1);
+  for (size_t i = 0; i < shown; ++i)
+  {
+    const DiscIO::HotExtent& extent = profile.entries[i];
+    fmt::print(std::cout, "{:>10.3f}s  partition {:#x}  {:#011x}-{:#011x}  {:>8} KiB  {} reads\n",
+               extent.first_access_ticks / ticks_per_second, extent.partition, extent.start,
+               extent.end, (extent.end - extent.start) / 1024, extent.access_count);
+  }
+
+  const std::string output_file_path = options["output"];
+  if (!output_file_path.empty() && !DiscIO::WriteDiscAccessProfile(output_file_path, profile))
+  {
+    fmt::print(std::cerr, "Error: Failed to write {}\n", output_file_path);
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+}  // namespace DolphinTool
@@ -0,0 +1,87 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinTool/ShaderCacheCommand.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <OptionParser.h>
+#include <fmt/format.h>
+#include <fmt/ostream.h>
+
+#include "VideoCommon/SharedPipelineUIDCache.h"
+
+namespace DolphinTool
+{
+static int MergeUIDCaches(const std::vector<std::string>& args)
+{
+  optparse::OptionParser parser;
+
+  parser.usage("usage: shadercache merge [options]...");
+
+  parser.add_option("-i", "--input")
+      .type("string")
+      .action("append")
+      .help("Path to the pipeline UID cache of a game (<game ID>.uidcache in the Cache directory) "
+            "or to a shared UID cache. Can be given multiple times to merge the caches of many "
+            "machines.")
+      .metavar("FILE");
+
+  parser.add_option("-o", "--output")
+      .type("string")
+      .action("store")
+      .help("Path to the shared UID cache to write. Dolphin loads it from <game ID>" +
+            VideoCommon::SharedPipelineUIDCacheExtension + " in the Cache directory.")
+      .metavar("FILE");
+
+  const optparse::Values& options = parser.parse_args(args);
+
+  if (!options.is_set("input"))
+  {
+    fmt::print(std::cerr, "Error: No input set\n");
+    return EXIT_FAILURE;
+  }
+
+  if (!options.is_set("output"))
+  {
+    fmt::print(std::cerr, "Error: No output set\n");
+    return EXIT_FAILURE;
+  }
+
+  VideoCommon::SharedPipelineUIDCache cache;
+  for (const std::string& input_file_path : options.all("input"))
+  {
+    if (!cache.AddFile(input_file_path))
+    {
+      fmt::print(std::cerr, "Error: {} is not a valid pipeline UID cache of this version\n",
+                 input_file_path);
+      return EXIT_FAILURE;
+    }
+  }
+
+  const std::string output_file_path = options["output"];
+  if (!cache.Save(output_file_path))
+  {
+    fmt::print(std::cerr, "Error: Failed to write {}\n", output_file_path);
+    return EXIT_FAILURE;
+  }
+
+  fmt::print(std::cout, "Merged {} pipeline UIDs of {} machines into {}\n", cache.GetUIDCount(),
+             cache.GetSourceCount(), output_file_path);
+  return EXIT_SUCCESS;
+}
+
+int ShaderCacheCommand(const std::vector<std::string>& args)
+{
+  if (args.empty() || args[0] != "merge")
+  {
+    fmt::print(std::cerr, "usage: shadercache merge [options]...\n");
+    return EXIT_FAILURE;
+  }
+
+  return MergeUIDCaches(std::vector<std::string>(args.begin() + 1, args.end()));
+}
+}  // namespace DolphinTool
@@ -0,0 +1,317 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinTool/SubtitlesCommand.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <OptionParser.h>
+#include <fmt/format.h>
+#include <fmt/ostream.h>
+
+#include "Common/FileUtil.h"
+#include "DiscIO/DiscAccessProfile.h"
+#include "DiscIO/Filesystem.h"
+#include "DiscIO/Volume.h"
+#include "Subtitles/SubtitleEntry.h"
+#include "Subtitles/SubtitleFileIndex.h"
+#include "Subtitles/SubtitleLoader.h"
+#include "Subtitles/SubtitlePack.h"
+
+namespace DolphinTool
+{
+static int CompileSubtitles(const std::vector<std::string>& args)
+{
+  optparse::OptionParser parser;
+
+  parser.usage("usage: subtitles compile [options]...");
+
+  parser.add_option("-i", "--input")
+      .type("string")
+      .action("store")
+      .help("Path to the subtitle directory of a game, containing the JSON files.")
+      .metavar("DIR");
+
+  parser.add_option("-o", "--output")
+      .type("string")
+      .action("store")
+      .help("Optional. Path to the compiled pack. Defaults to DIR" +
+            Subtitles::SubtitlePackExtension + ", which is where Dolphin looks for it.")
+      .metavar("FILE");
+
+  const optparse::Values& options = parser.parse_args(args);
+
+  std::string input_dir_path = options["input"];
+  if (input_dir_path.empty())
+  {
+    fmt::print(std::cerr, "Error: No input set\n");
+    return EXIT_FAILURE;
+  }
+  while (input_dir_path.size() > 1 &&
+         (input_dir_path.back() == '/' || input_dir_path.back() == '\\'))
+  {
+    input_dir_path.pop_back();
+  }
+
+  if (!File::IsDirectory(input_dir_path))
+  {
+    fmt::print(std::cerr, "Error: {} is not a directory\n", input_dir_path);
+    return EXIT_FAILURE;
+  }
+
+  std::string output_file_path = options["output"];
+  if (output_file_path.empty())
+    output_file_path = input_dir_path + Subtitles::SubtitlePackExtension;
+
+  Subtitles::TranslationMap translations;
+  Subtitles::ReadSubtitleJsons(input_dir_path, translations);
+
+  if (translations.empty())
+  {
+    fmt::print(std::cerr, "Error: No subtitles found in {}\n", input_dir_path);
+    return EXIT_FAILURE;
+  }
+
+  // Store cues in lookup order so that loading the pack doesn't have to sort much
+  size_t cue_count = 0;
+  for (auto& [path, group] : translations)
+  {
+    group.Preprocess();
+    cue_count += group.subtitleLines.size();
+  }
+
+  if (!Subtitles::WriteSubtitlePack(output_file_path, translations))
+  {
+    fmt::print(std::cerr, "Error: Failed to write {}\n", output_file_path);
+    return EXIT_FAILURE;
+  }
+
+  fmt::print(std::cout, "Compiled {} cues for {} files into {}\n", cue_count, translations.size(),
+             output_file_path);
+  return EXIT_SUCCESS;
+}
+
+// Reads of one subtitled file during a trace
+struct SubtitledFileReads
+{
+  u32 read_count = 0;
+  u32 uncovered_read_count = 0;
+  // Ranges of offsets in the file that were read while no cue applied, end is exclusive
+  std::vector<std::pair<u64, u64>> uncovered;
+};
+
+static void PrintCue(const Subtitles::SubtitleEntryGroup& group,
+                     const Subtitles::SubtitleEntry& cue, std::string_view file_path)
+{
+  if (group.hasOffsets)
+  {
+    fmt::print(std::cout, "  {}  offset {:#x}-{:#x}  \"{}\"\n", file_path, cue.Offset,
+               cue.OffsetEnd, group.GetText(cue));
+  }
+  else if (group.hasTimestamps)
+  {
+    fmt::print(std::cout, "  {}  at {} ms  \"{}\"\n", file_path, cue.Timestamp,
+               group.GetText(cue));
+  }
+  else
+  {
+    fmt::print(std::cout, "  {}  \"{}\"\n", file_path, group.GetText(cue));
+  }
+}
+
+// Replays a disc access trace through the same lookups the emulator makes, so that translators
+// can check their offsets and timestamps without running the game with subtitle logging
+static int AnalyzeSubtitles(const std::vector<std::string>& args)
+{
+  optparse::OptionParser parser;
+
+  parser.usage("usage: subtitles analyze [options]...");
+
+  parser.add_option("-t", "--trace")
+      .type("string")
+      .action("store")
+      .help("Path to a disc access trace recorded with Core.RecordDiscAccess.")
+      .metavar("FILE");
+
+  parser.add_option("-s", "--subtitles")
+      .type("string")
+      .action("store")
+      .help("Path to a compiled subtitle pack, or to a directory containing the JSON files.")
+      .metavar("PATH");
+
+  parser.add_option("-d", "--disc")
+      .type("string")
+      .action("store")
+      .help("Path to the disc image the trace was recorded with, to locate the subtitled files.")
+      .metavar("FILE");
+
+  const optparse::Values& options = parser.parse_args(args);
+
+  const std::string trace_path = options["trace"];
+  const std::string subtitles_path = options["subtitles"];
+  const std::string disc_path = options["disc"];
+  if (trace_path.empty() || subtitles_path.empty() || disc_path.empty())
+  {
+    fmt::print(std::cerr, "Error: A trace, subtitles and a disc must be set\n");
+    return EXIT_FAILURE;
+  }
+
+  const std::optional<DiscIO::DiscAccessTrace> trace = DiscIO::ReadDiscAccessTrace(trace_path);
+  if (!trace)
+  {
+    fmt::print(std::cerr, "Error: {} is not a valid disc access trace\n", trace_path);
+    return EXIT_FAILURE;
+  }
+
+  const std::unique_ptr<DiscIO::Volume> volume = DiscIO::CreateVolume(disc_path);
+  if (!volume)
+  {
+    fmt::print(std::cerr, "Error: Unable to open disc image\n");
+    return EXIT_FAILURE;
+  }
+
+  const std::string_view trace_game_id(
+      trace->header.game_id, strnlen(trace->header.game_id, sizeof(trace->header.game_id)));
+  if (volume->GetGameID() != trace_game_id)
+  {
+    fmt::print(std::cerr, "Warning: The trace was recorded with {}, not {}\n", trace_game_id,
+               volume->GetGameID());
+  }
+
+  Subtitles::TranslationMap translations;
+  if (File::IsDirectory(subtitles_path))
+  {
+    Subtitles::ReadSubtitleJsons(subtitles_path, translations);
+  }
+  else if (!Subtitles::ReadSubtitlePack(subtitles_path, translations))
+  {
+    fmt::print(std::cerr, "Error: {} is not a valid subtitle pack\n", subtitles_path);
+    return EXIT_FAILURE;
+  }
+
+  if (translations.empty())
+  {
+    fmt::print(std::cerr, "Error: No subtitles found in {}\n", subtitles_path);
+    return EXIT_FAILURE;
+  }
+
+  std::map<const Subtitles::SubtitleEntryGroup*, std::string_view> file_paths;
+  for (auto& [path, group] : translations)
+  {
+    group.Preprocess();
+    file_paths.emplace(&group, path);
+  }
+
+  std::map<u64, Subtitles::SubtitleFileIndex> indices;
+  std::map<const Subtitles::SubtitleEntryGroup*, SubtitledFileReads> file_reads;
+  std::map<const Subtitles::SubtitleEntry*, u32> cue_reads;
+  const u64 ticks_per_second = std::max<u32>(trace->header.ticks_per_second, 1);
+
+  fmt::print(std::cout, "Cues in the order they fire:\n");
+  for (const DiscIO::DiscAccessRecord& record : trace->entries)
+  {
+    auto [index_it, inserted] = indices.try_emplace(record.partition);
+    if (inserted)
+    {
+      const DiscIO::Partition partition(record.partition);
+      if (const DiscIO::FileSystem* file_system = volume->GetFileSystem(partition))
+        index_it->second.Build(*file_system, translations);
+    }
+
+    const Subtitles::SubtitleFileIndex::Extent* extent = index_it->second.Find(record.offset);
+    if (!extent)
+      continue;
+
+    Subtitles::SubtitleEntryGroup& group = *extent->group;
+    const u64 relative_offset = record.offset - extent->start;
+    const u64 emulated_ms = record.ticks * 1000 / ticks_per_second;
+    const Subtitles::SubtitleEntry* cue =
+        group.GetSubtitle(static_cast<u32>(relative_offset), emulated_ms);
+
+    SubtitledFileReads& reads = file_reads[&group];
+    ++reads.read_count;
+    if (!cue)
+    {
+      ++reads.uncovered_read_count;
+      const u64 end = relative_offset + record.length;
+      if (!reads.uncovered.empty() && reads.uncovered.back().second >= relative_offset &&
+          reads.uncovered.back().first <= relative_offset)
+      {
+        reads.uncovered.back().second = std::max(reads.uncovered.back().second, end);
+      }
+      else
+      {
+        reads.uncovered.emplace_back(relative_offset, end);
+      }
+      continue;
+    }
+
+    if (cue_reads[cue]++ == 0)
+    {
+      // Offsets take precedence over timestamps, like in the lookup
+      std::string position = "any read";
+      if (group.hasOffsets)
+        position = fmt::format("read at {:#x}", relative_offset);
+      else if (group.hasTimestamps)
+        position = fmt::format("{} ms into the file", emulated_ms - group.startMs);
+      fmt::print(std::cout, "{:>10.3f}s  {}  {}  \"{}\"\n",
+                 static_cast<double>(record.ticks) / ticks_per_second, file_paths[&group],
+                 position, group.GetText(*cue));
+    }
+  }
+
+  fmt::print(std::cout, "\nReads of subtitled files that no cue covers:\n");
+  for (const auto& [group, reads] : file_reads)
+  {
+    if (reads.uncovered_read_count == 0)
+      continue;
+
+    fmt::print(std::cout, "  {}  {} of {} reads\n", file_paths[group], reads.uncovered_read_count,
+               reads.read_count);
+    for (const auto& [start, end] : reads.uncovered)
+      fmt::print(std::cout, "    {:#x}-{:#x}\n", start, end);
+  }
+
+  size_t cue_count = 0;
+  fmt::print(std::cout, "\nCues that never fired:\n");
+  for (const auto& [path, group] : translations)
+  {
+    cue_count += group.subtitleLines.size();
+    if (!file_reads.contains(&group))
+    {
+      fmt::print(std::cout, "  {}  file never read, {} cues\n", path, group.subtitleLines.size());
+      continue;
+    }
+
+    for (const Subtitles::SubtitleEntry& cue : group.subtitleLines)
+    {
+      if (!cue_reads.contains(&cue))
+        PrintCue(group, cue, path);
+    }
+  }
+
+  fmt::print(std::cout, "\n{} of {} cues fired, {} of {} subtitled files were read\n",
+             cue_reads.size(), cue_count, file_reads.size(), translations.size());
+  return EXIT_SUCCESS;
+}
+
+int SubtitlesCommand(const std::vector<std::string>& args)
+{
+  if (!args.empty() && args[0] == "compile")
+    return CompileSubtitles(std::vector<std::string>(args.begin() + 1, args.end()));
+  if (!args.empty() && args[0] == "analyze")
+    return AnalyzeSubtitles(std::vector<std::string>(args.begin() + 1, args.end()));
+
+  fmt::print(std::cerr, "usage: subtitles [compile|analyze] [options]...\n");
+  return EXIT_FAILURE;
+}
+}  // namespace DolphinTool
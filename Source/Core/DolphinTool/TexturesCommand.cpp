@@ -0,0 +1,209 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinTool/TexturesCommand.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <OptionParser.h>
+#include <fmt/format.h>
+#include <fmt/ostream.h>
+
+#include "Common/FileSearch.h"
+#include "Common/FileUtil.h"
+#include "Common/StringUtil.h"
+#include "VideoCommon/Assets/CustomTexturePack.h"
+#include "VideoCommon/Assets/DirectFilesystemAssetLibrary.h"
+#include "VideoCommon/Assets/TextureAsset.h"
+
+namespace DolphinTool
+{
+static constexpr std::string_view TEXTURE_PREFIX = "tex1_";
+
+// Additional mip levels are loaded along with the base level, so they aren't packed on their own
+static bool IsMipLevelFile(std::string_view filename)
+{
+  const size_t mip_index = filename.rfind("_mip");
+  if (mip_index == std::string_view::npos || mip_index + 4 == filename.size())
+    return false;
+  return std::all_of(filename.begin() + mip_index + 4, filename.end(),
+                     [](char c) { return c >= '0' && c <= '9'; });
+}
+
+// Box filters an RGBA8 level down to 1x1
+static void GenerateMipmaps(VideoCommon::CustomTextureData::ArraySlice* slice)
+{
+  while (slice->m_levels.back().width > 1 || slice->m_levels.back().height > 1)
+  {
+    const auto& src = slice->m_levels.back();
+    VideoCommon::CustomTextureData::ArraySlice::Level dst;
+    dst.format = src.format;
+    dst.width = std::max(src.width / 2, 1u);
+    dst.height = std::max(src.height / 2, 1u);
+    dst.row_length = dst.width;
+    dst.data.resize(dst.width * dst.height * 4);
+
+    for (u32 y = 0; y < dst.height; ++y)
+    {
+      const u32 y0 = std::min(y * 2, src.height - 1);
+      const u32 y1 = std::min(y * 2 + 1, src.height - 1);
+      for (u32 x = 0; x < dst.width; ++x)
+      {
+        const u32 x0 = std::min(x * 2, src.width - 1);
+        const u32 x1 = std::min(x * 2 + 1, src.width - 1);
+        for (u32 c = 0; c < 4; ++c)
+        {
+          const u32 sum = src.data[(y0 * src.row_length + x0) * 4 + c] +
+                          src.data[(y0 * src.row_length + x1) * 4 + c] +
+                          src.data[(y1 * src.row_length + x0) * 4 + c] +
+                          src.data[(y1 * src.row_length + x1) * 4 + c];
+          dst.data[(y * dst.width + x) * 4 + c] = static_cast<u8>((sum + 2) / 4);
+        }
+      }
+    }
+
+    slice->m_levels.push_back(std::move(dst));
+  }
+}
+
+static int PackTextures(const std::vector<std::string>& args)
+{
+  optparse::OptionParser parser;
+
+  parser.usage("usage: textures pack [options]...");
+
+  parser.add_option("-i", "--input")
+      .type("string")
+      .action("store")
+      .help("Path to a directory of custom textures, containing the PNG and DDS files.")
+      .metavar("DIR");
+
+  parser.add_option("-o", "--output")
+      .type("string")
+      .action("store")
+      .help("Optional. Path to the texture pack. Defaults to DIR" +
+            VideoCommon::CustomTexturePackExtension +
+            ". Dolphin loads packs from the custom texture directory of a game, loose textures "
+            "take precedence over packed ones.")
+      .metavar("FILE");
+
+  parser.add_option("-m", "--generate_mips")
+      .action("store_true")
+      .help("Optional. Generate the mipmaps of uncompressed textures that come without any.");
+
+  const optparse::Values& options = parser.parse_args(args);
+
+  std::string input_dir_path = options["input"];
+  if (input_dir_path.empty())
+  {
+    fmt::print(std::cerr, "Error: No input set\n");
+    return EXIT_FAILURE;
+  }
+  while (input_dir_path.size() > 1 &&
+         (input_dir_path.back() == '/' || input_dir_path.back() == '\\'))
+  {
+    input_dir_path.pop_back();
+  }
+
+  if (!File::IsDirectory(input_dir_path))
+  {
+    fmt::print(std::cerr, "Error: {} is not a directory\n", input_dir_path);
+    return EXIT_FAILURE;
+  }
+
+  std::string output_file_path = options["output"];
+  if (output_file_path.empty())
+    output_file_path = input_dir_path + VideoCommon::CustomTexturePackExtension;
+
+  const bool generate_mips = static_cast<bool>(options.get("generate_mips"));
+
+  // Same naming rules as HiresTexture::Update
+  std::map<std::string, std::string> texture_paths;
+  std::map<std::string, bool> arbitrary_mipmaps;
+  for (const std::string& path :
+       Common::DoFileSearch({input_dir_path}, {".png", ".dds"}, /*recursive*/ true))
+  {
+    std::string filename;
+    SplitPath(path, nullptr, &filename, nullptr);
+    if (!filename.starts_with(TEXTURE_PREFIX) || IsMipLevelFile(filename))
+      continue;
+
+    const size_t arb_index = filename.rfind("_arb");
+    const bool has_arbitrary_mipmaps = arb_index != std::string::npos;
+    if (has_arbitrary_mipmaps)
+      filename.erase(arb_index, 4);
+
+    if (!texture_paths.try_emplace(filename, path).second)
+    {
+      fmt::print(std::cerr, "Warning: Skipping {}, {} was already found\n", path, filename);
+      continue;
+    }
+    arbitrary_mipmaps[filename] = has_arbitrary_mipmaps;
+  }
+
+  if (texture_paths.empty())
+  {
+    fmt::print(std::cerr, "Error: No custom textures found in {}\n", input_dir_path);
+    return EXIT_FAILURE;
+  }
+
+  VideoCommon::DirectFilesystemAssetLibrary library;
+  std::vector<VideoCommon::CustomTexturePackInput> textures;
+  textures.reserve(texture_paths.size());
+  size_t total_size = 0;
+  for (const auto& [name, path] : texture_paths)
+  {
+    library.SetAssetIDMapData(name, {{"texture", StringToPath(path)}});
+
+    VideoCommon::TextureData data;
+    if (library.LoadGameTexture(name, &data).m_bytes_loaded == 0 ||
+        data.m_texture.m_slices.size() != 1)
+    {
+      fmt::print(std::cerr, "Warning: Skipping {}, it could not be loaded\n", path);
+      continue;
+    }
+
+    VideoCommon::CustomTexturePackInput& texture = textures.emplace_back();
+    texture.name = name;
+    texture.has_arbitrary_mipmaps = arbitrary_mipmaps[name];
+    texture.slice = std::move(data.m_texture.m_slices[0]);
+
+    if (generate_mips && texture.slice.m_levels.size() == 1 &&
+        texture.slice.m_levels[0].format == AbstractTextureFormat::RGBA8)
+    {
+      GenerateMipmaps(&texture.slice);
+    }
+
+    for (const auto& level : texture.slice.m_levels)
+      total_size += level.data.size();
+  }
+
+  const size_t texture_count = textures.size();
+  if (!VideoCommon::WriteCustomTexturePack(output_file_path, std::move(textures)))
+  {
+    fmt::print(std::cerr, "Error: Failed to write {}\n", output_file_path);
+    return EXIT_FAILURE;
+  }
+
+  fmt::print(std::cout, "Packed {} textures ({} MiB) into {}\n", texture_count,
+             total_size >> 20, output_file_path);
+  return EXIT_SUCCESS;
+}
+
+int TexturesCommand(const std::vector<std::string>& args)
+{
+  if (args.empty() || args[0] != "pack")
+  {
+    fmt::print(std::cerr, "usage: textures pack [options]...\n");
+    return EXIT_FAILURE;
+  }
+
+  return PackTextures(std::vector<std::string>(args.begin() + 1, args.end()));
+}
+}  // namespace DolphinTool
@@ -18,13 +18,19 @@
 
 #include "DolphinTool/ConvertCommand.h"
 #include "DolphinTool/HeaderCommand.h"
+#include "DolphinTool/ProfileCommand.h"
+#include "DolphinTool/ShaderCacheCommand.h"
+#include "DolphinTool/SubtitlesCommand.h"
+#include "DolphinTool/TexturesCommand.h"
 #include "DolphinTool/VerifyCommand.h"
 
 static void PrintUsage()
 {
-  fmt::print(std::cerr, "usage: dolphin-tool COMMAND -h\n"
-                        "\n"
-                        "commands supported: [convert, verify, header]\n");
+  fmt::print(std::cerr,
+             "usage: dolphin-tool COMMAND -h\n"
+             "\n"
+             "commands supported: [convert, verify, header, subtitles, textures, shadercache, "
+             "profile]\n");
 }
 
 #ifdef _WIN32
@@ -51,6 +57,14 @@ int main(int argc, char* argv[])
     return DolphinTool::VerifyCommand(args);
   else if (command_str == "header")
     return DolphinTool::HeaderCommand(args);
+  else if (command_str == "subtitles")
+    return DolphinTool::SubtitlesCommand(args);
+  else if (command_str == "textures")
+    return DolphinTool::TexturesCommand(args);
+  else if (command_str == "shadercache")
+    return DolphinTool::ShaderCacheCommand(args);
+  else if (command_str == "profile")
+    return DolphinTool::ProfileCommand(args);
   PrintUsage();
   return EXIT_FAILURE;
 }
@@ -6,6 +6,8 @@
 #include <algorithm>
 #include <array>
 #include <chrono>
+#include <mutex>
+#include <thread>
 #include <tuple>
 
 #include <SFML/Network/SocketSelector.hpp>
@@ -131,6 +133,7 @@ public:
   void UpdateInput() override;
 
   Device(std::string name, int index, std::string server_address, u16 server_port, u32 client_uid);
+  ~Device() override;
 
   std::string GetName() const final override;
   std::string GetSource() const final override;
@@ -139,17 +142,39 @@ public:
   int GetSortPriority() const override { return -5; }
 
 private:
+  struct PadState
+  {
+    Proto::MessageType::PadDataResponse pad_data{};
+    int touch_x = 0;
+    int touch_y = 0;
+  };
+
   void ResetPadData();
+  void ReceiveThreadFunc();
 
   const std::string m_name;
   const int m_index;
+
+  // What the inputs read. Only UpdateInput changes it, so the state stays the same while the
+  // emulated controllers read it.
+  Proto::MessageType::PadDataResponse m_pad_data{};
+  int m_touch_x = 0;
+  int m_touch_y = 0;
+
+  // The receive thread talks to the server, so a slow network never holds up UpdateInput. It
+  // publishes the newest state here for UpdateInput to pick up.
+  std::mutex m_received_state_mutex;
+  PadState m_received_state;
+  bool m_received_new_state = false;
+
+  std::thread m_receive_thread;
+  Common::Flag m_receive_thread_running;
+
+  // Only used by the receive thread
   sf::UdpSocket m_socket;
   SteadyClock::time_point m_next_reregister = SteadyClock::time_point::min();
-  Proto::MessageType::PadDataResponse m_pad_data{};
   Proto::Touch m_prev_touch{};
   bool m_prev_touch_valid = false;
-  int m_touch_x = 0;
-  int m_touch_y = 0;
   const std::string m_server_address;
   const u16 m_server_port;
 
@@ -587,6 +612,16 @@ Device::Device(std::string name, int index, std::string server_address, u16 serv
   m_touch_y_max = 941;
 
   ResetPadData();
+  m_received_state = {m_pad_data, m_touch_x, m_touch_y};
+
+  m_receive_thread_running.Set();
+  m_receive_thread = std::thread(&Device::ReceiveThreadFunc, this);
+}
+
+Device::~Device()
+{
+  m_receive_thread_running.Clear();
+  m_receive_thread.join();
 }
 
 void Device::ResetPadData()
@@ -616,48 +651,94 @@ std::string Device::GetSource() const
 
 void Device::UpdateInput()
 {
-  // Regularly tell the UDP server to feed us controller data
-  const auto now = SteadyClock::now();
-  if (now >= m_next_reregister)
+  // The receive thread only holds the lock to copy a state, so don't wait for it
+  std::unique_lock lock(m_received_state_mutex, std::try_to_lock);
+  if (!lock.owns_lock() || !m_received_new_state)
+    return;
+
+  m_pad_data = m_received_state.pad_data;
+  m_touch_x = m_received_state.touch_x;
+  m_touch_y = m_received_state.touch_y;
+  m_received_new_state = false;
+}
+
+void Device::ReceiveThreadFunc()
+{
+  Common::SetCurrentThreadName("DualShockUDPClient Device Thread");
+
+  PadState state;
   {
-    m_next_reregister = now + SERVER_REREGISTER_INTERVAL;
-
-    Proto::Message<Proto::MessageType::PadDataRequest> msg(m_client_uid);
-    auto& data_req = msg.m_message;
-    data_req.register_flags = Proto::RegisterFlags::PadID;
-    data_req.pad_id_to_register = m_index;
-    msg.Finish();
-    if (m_socket.send(&data_req, sizeof(data_req), m_server_address, m_server_port) !=
-        sf::Socket::Status::Done)
-    {
-      ERROR_LOG_FMT(CONTROLLERINTERFACE, "DualShockUDPClient UpdateInput send failed");
-    }
+    std::lock_guard lock(m_received_state_mutex);
+    state = m_received_state;
   }
 
-  // Receive and handle controller data
-  Proto::Message<Proto::MessageType::FromServer> msg;
-  std::size_t received_bytes;
-  sf::IpAddress sender;
-  u16 port;
-  while (m_socket.receive(&msg, sizeof msg, received_bytes, sender, port) ==
-         sf::Socket::Status::Done)
+  sf::SocketSelector selector;
+  selector.add(m_socket);
+
+  while (m_receive_thread_running.IsSet())
   {
-    if (auto pad_data = msg.CheckAndCastTo<Proto::MessageType::PadDataResponse>())
+    using namespace std::chrono;
+    using namespace std::chrono_literals;
+
+    // Regularly tell the UDP server to feed us controller data
+    const auto now = SteadyClock::now();
+    if (now >= m_next_reregister)
     {
-      m_pad_data = *pad_data;
+      m_next_reregister = now + SERVER_REREGISTER_INTERVAL;
+
+      Proto::Message<Proto::MessageType::PadDataRequest> msg(m_client_uid);
+      auto& data_req = msg.m_message;
+      data_req.register_flags = Proto::RegisterFlags::PadID;
+      data_req.pad_id_to_register = m_index;
+      msg.Finish();
+      if (m_socket.send(&data_req, sizeof(data_req), m_server_address, m_server_port) !=
+          sf::Socket::Status::Done)
+      {
+        ERROR_LOG_FMT(CONTROLLERINTERFACE, "DualShockUDPClient ReceiveThreadFunc send failed");
+      }
+    }
 
-      // Update touch pad relative coordinates
-      if (m_pad_data.touch1.id != m_prev_touch.id)
-        m_prev_touch_valid = false;
-      if (m_prev_touch_valid)
+    // Wake up in time to re-register and to notice being stopped. A timeout of zero would wait
+    // forever.
+    const auto timeout = std::clamp(duration_cast<milliseconds>(m_next_reregister - now), 1ms,
+                                    THREAD_MAX_WAIT_INTERVAL);
+    if (!selector.wait(sf::milliseconds(timeout.count())))
+      continue;
+
+    // Receive and handle controller data
+    bool received = false;
+    Proto::Message<Proto::MessageType::FromServer> msg;
+    std::size_t received_bytes;
+    sf::IpAddress sender;
+    u16 port;
+    while (m_socket.receive(&msg, sizeof msg, received_bytes, sender, port) ==
+           sf::Socket::Status::Done)
+    {
+      if (auto pad_data = msg.CheckAndCastTo<Proto::MessageType::PadDataResponse>())
       {
-        m_touch_x += m_pad_data.touch1.x - m_prev_touch.x;
-        m_touch_y += m_pad_data.touch1.y - m_prev_touch.y;
-        m_touch_x = std::clamp(m_touch_x, -TOUCH_X_AXIS_MAX, TOUCH_X_AXIS_MAX);
-        m_touch_y = std::clamp(m_touch_y, -TOUCH_Y_AXIS_MAX, TOUCH_Y_AXIS_MAX);
+        state.pad_data = *pad_data;
+        received = true;
+
+        // Update touch pad relative coordinates
+        if (state.pad_data.touch1.id != m_prev_touch.id)
+          m_prev_touch_valid = false;
+        if (m_prev_touch_valid)
+        {
+          state.touch_x += state.pad_data.touch1.x - m_prev_touch.x;
+          state.touch_y += state.pad_data.touch1.y - m_prev_touch.y;
+          state.touch_x = std::clamp(state.touch_x, -TOUCH_X_AXIS_MAX, TOUCH_X_AXIS_MAX);
+          state.touch_y = std::clamp(state.touch_y, -TOUCH_Y_AXIS_MAX, TOUCH_Y_AXIS_MAX);
+        }
+        m_prev_touch = state.pad_data.touch1;
+        m_prev_touch_valid = true;
       }
-      m_prev_touch = m_pad_data.touch1;
-      m_prev_touch_valid = true;
+    }
+
+    if (received)
+    {
+      std::lock_guard lock(m_received_state_mutex);
+      m_received_state = state;
+      m_received_new_state = true;
     }
   }
 }
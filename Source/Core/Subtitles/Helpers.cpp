@@ -1,10 +1,9 @@
 // Copyright 2023 Dolphin Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
-#pragma once
-
 #include "Subtitles/Helpers.h"
 
+#include <optional>
 #include <string>
 
 #include <picojson.h>
@@ -18,10 +17,15 @@
 namespace Subtitles
 {
 
+bool IsTranslatorModeEnabled()
+{
+  return Common::Log::LogManager::GetInstance()->IsEnabled(Common::Log::LogType::SUBTITLES,
+                                                           Common::Log::LogLevel::LWARNING);
+}
+
 void OSDInfo(std::string msg)
 {
-  if (Common::Log::LogManager::GetInstance()->IsEnabled(Common::Log::LogType::SUBTITLES,
-                                                        Common::Log::LogLevel::LWARNING))
+  if (IsTranslatorModeEnabled())
   {
     OSD::AddMessage(msg, 5000, OSD::Color::GREEN);
   }
@@ -58,10 +62,10 @@ u32 TryParsecolor(const picojson::value& raw, u32 defaultColor)
         return parsedHex;
       }
     }
-    else if (WebColors.count(str) == 1)
+    else if (const std::optional<u32> color = FindWebColor(str))
     {
       // html color name
-      return WebColors[str];
+      return *color;
     }
   }
   return defaultColor;
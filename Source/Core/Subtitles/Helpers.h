@@ -11,6 +11,8 @@
 
 namespace Subtitles
 {
+// True while the Subtitles log is enabled, used to show debug info and hot reload files
+bool IsTranslatorModeEnabled();
 void OSDInfo(std::string msg);
 void Info(std::string msg);
 void Error(std::string err);
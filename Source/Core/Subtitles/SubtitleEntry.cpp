@@ -1,20 +1,16 @@
 // Copyright 2023 Dolphin Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
-#pragma once
-
 #include "Subtitles/SubtitleEntry.h"
 
 #include <algorithm>
-#include <fmt/format.h>
+#include <limits>
 #include <string>
 
 #include "Common/CommonTypes.h"
-#include "Subtitles/Helpers.h"
 
 namespace Subtitles
 {
-// Ensure lines are sorted in reverse to simplify querying
 void SubtitleEntryGroup::Preprocess()
 {
   for (auto i = 0; i < subtitleLines.size(); i++)
@@ -23,19 +19,38 @@ void SubtitleEntryGroup::Preprocess()
     hasTimestamps |= subtitleLines[i].Timestamp > 0;
   }
 
+  m_starts.clear();
+  m_ends.clear();
+  m_cursor = 0;
+  preparedLines = 0;
+
   if (hasOffsets)
   {
     std::sort(subtitleLines.begin(), subtitleLines.end(),
-              [](const auto& lhs, const auto& rhs) { return lhs.Offset > rhs.Offset; });
+              [](const auto& lhs, const auto& rhs) { return lhs.Offset < rhs.Offset; });
+
+    for (const auto& line : subtitleLines)
+    {
+      m_starts.push_back(line.Offset);
+      // open range
+      m_ends.push_back(line.OffsetEnd == 0 ? std::numeric_limits<u64>::max() : line.OffsetEnd);
+    }
   }
   // Offsets override Timestamps
   else if (hasTimestamps)
   {
     std::sort(subtitleLines.begin(), subtitleLines.end(),
-              [](const auto& lhs, const auto& rhs) { return lhs.Timestamp > rhs.Timestamp; });
+              [](const auto& lhs, const auto& rhs) { return lhs.Timestamp < rhs.Timestamp; });
+
+    for (const auto& line : subtitleLines)
+    {
+      m_starts.push_back(line.Timestamp);
+      // use display time as treshold
+      m_ends.push_back(line.Timestamp + line.Miliseconds);
+    }
   }
 }
-SubtitleEntry* SubtitleEntryGroup::GetSubtitle(u32 offset)
+SubtitleEntry* SubtitleEntryGroup::GetSubtitle(u32 offset, u64 emulatedMs)
 {
   if (subtitleLines.empty())
     return nullptr;
@@ -46,85 +61,119 @@ SubtitleEntry* SubtitleEntryGroup::GetSubtitle(u32 offset)
   }
   if (hasTimestamps)
   {
-    if (offset == 0)
+    // restart timer if file is being read from start, or if a savestate went back in time
+    if (offset == 0 || emulatedMs < startMs)
     {
-      // restart timer if file is being read from start
-      timer.Start();
+      startMs = emulatedMs;
     }
-    // TODO do sync emulated time with real time, or just ingore this issue?
-    auto timestamp = timer.ElapsedMs();
+    auto timestamp = emulatedMs - startMs;
     return GetSubtitleForRelativeTimestamp(timestamp);
   }
 
   return &subtitleLines[0];
 }
-SubtitleEntry* SubtitleEntryGroup::GetSubtitleForRelativeOffset(u32 offset)
+SubtitleEntry* SubtitleEntryGroup::GetSubtitleAtPlayback(u32 offset, u64 playbackMs)
 {
-  // from latest to earliest
-  for (auto i = 0; i < subtitleLines.size(); i++)
+  if (subtitleLines.empty())
+    return nullptr;
+
+  if (hasOffsets)
+    return GetSubtitleForRelativeOffset(offset);
+  if (hasTimestamps)
+    return GetSubtitleForRelativeTimestamp(playbackMs);
+
+  return &subtitleLines[0];
+}
+s64 SubtitleEntryGroup::FindLineStartingBefore(const std::vector<u64>& starts, u64 key)
+{
+  const size_t count = starts.size();
+
+  // try the previous hit and the one after it before falling back to a binary search
+  for (size_t i = m_cursor; i < count && i <= m_cursor + 1; i++)
   {
-    // find first translation that covers current offset
-    if (offset >= subtitleLines[i].Offset)
+    if (starts[i] <= key && (i + 1 == count || key < starts[i + 1]))
     {
-      // if range is open, or offset is in range
-      if (subtitleLines[i].OffsetEnd == 0 || subtitleLines[i].OffsetEnd >= offset)
-      {
-        return &subtitleLines[i];
-      }
-      else
-      {
-        return nullptr;
-      }
+      m_cursor = i;
+      return static_cast<s64>(i);
     }
   }
 
+  const auto it = std::upper_bound(starts.begin(), starts.end(), key);
+  if (it == starts.begin())
+    return -1;
+
+  m_cursor = static_cast<size_t>(it - starts.begin()) - 1;
+  return static_cast<s64>(m_cursor);
+}
+SubtitleEntry* SubtitleEntryGroup::GetSubtitleForRelativeOffset(u32 offset)
+{
+  // find latest translation that starts before current offset
+  const s64 i = FindLineStartingBefore(m_starts, offset);
+  if (i < 0)
+    return nullptr;
+
+  // if range is open, or offset is in range
+  if (m_ends[i] >= offset)
+    return &subtitleLines[i];
+
   return nullptr;
 }
 SubtitleEntry* SubtitleEntryGroup::GetSubtitleForRelativeTimestamp(u64 timestamp)
 {
-  //if Subttile log is enabled, display timestamp for easier subtitle time aligning
-  OSDInfo(fmt::format("Timestamp: {}", timestamp));
+  const s64 i = FindLineStartingBefore(m_starts, timestamp);
+  if (i < 0)
+    return nullptr;
 
-  // from latest to earliest
-  for (auto i = 0; i < subtitleLines.size(); i++)
-  {
-    // find first translation that covers current offset
-    if (timestamp >= subtitleLines[i].Timestamp)
-    {
-      // use display time as treshold
-      auto endstamp = subtitleLines[i].Timestamp + subtitleLines[i].Miliseconds;
-      if (endstamp >= timestamp)
-      {
-        return &subtitleLines[i];
-      }
-      else
-      {
-        return nullptr;
-      }
-    }
-  }
+  if (m_ends[i] >= timestamp)
+    return &subtitleLines[i];
 
   return nullptr;
 }
-void SubtitleEntryGroup::Add(SubtitleEntry& tl)
+std::string& SubtitleEntryGroup::GetWritableTextPool()
+{
+  if (!m_textPool)
+    m_textPool = std::make_shared<std::string>();
+  else if (m_textPool.use_count() > 1)
+    m_textPool = std::make_shared<std::string>(*m_textPool);
+
+  return *m_textPool;
+}
+void SubtitleEntryGroup::Add(SubtitleEntry tl, std::string_view text)
 {
+  std::string& pool = GetWritableTextPool();
+  tl.TextOffset = static_cast<u32>(pool.size());
+  tl.TextSize = static_cast<u32>(text.size());
+  pool.append(text);
   subtitleLines.push_back(tl);
 }
+void SubtitleEntryGroup::Append(const SubtitleEntryGroup& other)
+{
+  if (other.subtitleLines.empty())
+    return;
 
-SubtitleEntry::SubtitleEntry()
-    : Filename(""), Text(""), Miliseconds(0), Color(0), Enabled(false), AllowDuplicate(false),
-      Scale(1), Offset(0), OffsetEnd(0), DisplayOnTop(false), Timestamp(0)
+  std::string& pool = GetWritableTextPool();
+  const u32 base = static_cast<u32>(pool.size());
+  pool.append(*other.m_textPool);
+
+  subtitleLines.reserve(subtitleLines.size() + other.subtitleLines.size());
+  for (SubtitleEntry tl : other.subtitleLines)
+  {
+    tl.TextOffset += base;
+    subtitleLines.push_back(tl);
+  }
+}
+void SubtitleEntryGroup::Reserve(size_t lines, size_t textSize)
 {
+  subtitleLines.reserve(subtitleLines.size() + lines);
+  std::string& pool = GetWritableTextPool();
+  pool.reserve(pool.size() + textSize);
 }
-SubtitleEntry::SubtitleEntry(std::string& filename, std::string& text, u32 miliseconds, u32 color,
-                             bool enabled, bool allowDuplicates, float scale, u32 offset,
-                             u32 offsetEnd, bool displayOnTop, u64 timestamp)
-    : Filename(filename), Text(text), Miliseconds(miliseconds), Color(color), Enabled(enabled),
-      AllowDuplicate(allowDuplicates), Scale(scale), Offset(offset), OffsetEnd(offsetEnd),
-      DisplayOnTop(displayOnTop), Timestamp(timestamp)
+std::string_view SubtitleEntryGroup::GetText(const SubtitleEntry& tl) const
 {
+  return std::string_view(*m_textPool).substr(tl.TextOffset, tl.TextSize);
 }
-bool SubtitleEntry::IsOffset()
+
+bool SubtitleEntry::IsOffset() const
 {
   return Offset > 0;
 }
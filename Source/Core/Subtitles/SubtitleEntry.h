@@ -3,34 +3,32 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include "Common/CommonTypes.h"
-#include "Common/Timer.h"
 
 namespace Subtitles
 {
-
+// A subtitle line. Its file is the key of its group and its text is stored in the group's text
+// pool, so that a line has no allocations of its own.
 struct SubtitleEntry
 {
-  std::string Filename;
-  std::string Text;
-  u32 Miliseconds;
-  u32 Color;
-  bool Enabled;
-  bool AllowDuplicate;
-  float Scale;
-  u32 Offset;
-  u32 OffsetEnd;
-  bool DisplayOnTop;
-  u64 Timestamp;
-
-public:
-  SubtitleEntry();
-  SubtitleEntry(std::string& filename, std::string& text, u32 miliseconds, u32 color, bool enabled,
-                bool allowDuplicates, float scale, u32 offset, u32 offsetEnd, bool displayOnTop,
-                u64 timestamp);
-  bool IsOffset();
+  u64 Timestamp = 0;
+  // Location of the text in the group's text pool, set by SubtitleEntryGroup::Add
+  u32 TextOffset = 0;
+  u32 TextSize = 0;
+  u32 Miliseconds = 0;
+  u32 Color = 0;
+  float Scale = 1;
+  u32 Offset = 0;
+  u32 OffsetEnd = 0;
+  bool AllowDuplicate = false;
+  bool DisplayOnTop = false;
+
+  bool IsOffset() const;
 };
 
 /// <summary>
@@ -38,19 +36,50 @@ public:
 /// </summary>
 struct SubtitleEntryGroup
 {
-  Common::Timer timer;
+  // Emulated time at which the file was last read from its start
+  u64 startMs = 0;
 
   std::vector<SubtitleEntry> subtitleLines;
   bool hasOffsets = false;
   bool hasTimestamps = false;
+  // Lines before this index were handed to OSD::PrepareMessage or skipped by playback
+  size_t preparedLines = 0;
+  // Set once playback of streamed audio reached the file, its reads are ignored from then on
+  bool followsPlayback = false;
 
-  // Ensure lines are sorted in reverse to simplify querying
+  // Sort lines by their start and build the lookup arrays
   void Preprocess();
-  void Add(SubtitleEntry& tl);
-  SubtitleEntry* GetSubtitle(u32 offset);
+  // Stores text in the pool and appends the line pointing at it
+  void Add(SubtitleEntry tl, std::string_view text);
+  // Appends the lines of other, with their texts
+  void Append(const SubtitleEntryGroup& other);
+  // Makes room for more lines with the given total text size
+  void Reserve(size_t lines, size_t textSize);
+  std::string_view GetText(const SubtitleEntry& tl) const;
+  // Shared with the OSD messages showing the lines, which view it instead of copying their text
+  std::shared_ptr<const std::string> GetTextPool() const { return m_textPool; }
+  // emulatedMs is the emulated time of the read, which keeps timestamps in sync
+  // with the game when running uncapped or in slow motion
+  SubtitleEntry* GetSubtitle(u32 offset, u64 emulatedMs);
+  // Same for the position being played, playbackMs is how long the file has played up to offset
+  SubtitleEntry* GetSubtitleAtPlayback(u32 offset, u64 playbackMs);
 
 private:
+  // Copies the pool first if an OSD message still views it
+  std::string& GetWritableTextPool();
+
   SubtitleEntry* GetSubtitleForRelativeOffset(u32 offset);
   SubtitleEntry* GetSubtitleForRelativeTimestamp(u64 timestamp);
+  // Index of the last line starting at or before key, or -1
+  s64 FindLineStartingBefore(const std::vector<u64>& starts, u64 key);
+
+  // Structure of arrays mirroring subtitleLines, in ascending order of start.
+  // For timestamps, the end is the start plus the display time.
+  std::vector<u64> m_starts;
+  std::vector<u64> m_ends;
+  // Line found by the previous lookup, sequential reads usually hit it or the next one
+  size_t m_cursor = 0;
+
+  std::shared_ptr<std::string> m_textPool;
 };
 }  // namespace Subtitles
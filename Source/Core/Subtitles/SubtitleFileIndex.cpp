@@ -0,0 +1,93 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Subtitles/SubtitleFileIndex.h"
+
+#include <algorithm>
+#include <memory>
+
+#include "Common/Logging/Log.h"
+#include "DiscIO/Filesystem.h"
+#include "Subtitles/SubtitleEntry.h"
+
+namespace Subtitles
+{
+void SubtitleFileIndex::Build(const DiscIO::FileSystem& file_system,
+                              std::map<std::string, SubtitleEntryGroup>& translations)
+{
+  m_extents.clear();
+
+  if (!file_system.IsValid())
+    return;
+
+  m_extents.reserve(translations.size());
+  for (auto& [path, group] : translations)
+  {
+    const std::unique_ptr<DiscIO::FileInfo> file_info = file_system.FindFileInfo(path);
+    if (!file_info || file_info->IsDirectory() || file_info->GetSize() == 0)
+    {
+      WARN_LOG_FMT(SUBTITLES, "Subtitled file {} was not found on disc", path);
+      continue;
+    }
+
+    const u64 start = file_info->GetOffset();
+    m_extents.push_back(Extent{start, start + file_info->GetSize(), &group});
+  }
+
+  std::sort(m_extents.begin(), m_extents.end(),
+            [](const Extent& lhs, const Extent& rhs) { return lhs.start < rhs.start; });
+}
+
+static void AddFilesBelow(const DiscIO::FileInfo& directory, size_t shard,
+                          std::vector<SubtitleFileIndex::Extent>& extents)
+{
+  for (const DiscIO::FileInfo& child : directory)
+  {
+    if (child.IsDirectory())
+      AddFilesBelow(child, shard, extents);
+    else if (child.GetSize() != 0)
+      extents.push_back({child.GetOffset(), child.GetOffset() + child.GetSize(), nullptr, shard});
+  }
+}
+
+void SubtitleFileIndex::AddDirectory(const DiscIO::FileSystem& file_system,
+                                     std::string_view directory, size_t shard)
+{
+  if (!file_system.IsValid())
+    return;
+
+  const std::unique_ptr<DiscIO::FileInfo> directory_info =
+      directory.empty() ? file_system.GetRoot().clone() : file_system.FindFileInfo(directory);
+  if (!directory_info || !directory_info->IsDirectory())
+  {
+    WARN_LOG_FMT(SUBTITLES, "Subtitled directory {} was not found on disc", directory);
+    return;
+  }
+
+  AddFilesBelow(*directory_info, shard, m_extents);
+  std::sort(m_extents.begin(), m_extents.end(),
+            [](const Extent& lhs, const Extent& rhs) { return lhs.start < rhs.start; });
+}
+
+void SubtitleFileIndex::Clear()
+{
+  m_extents.clear();
+}
+
+bool SubtitleFileIndex::IsEmpty() const
+{
+  return m_extents.empty();
+}
+
+const SubtitleFileIndex::Extent* SubtitleFileIndex::Find(u64 disc_offset) const
+{
+  // Find the last extent starting at or before the offset
+  auto it = std::upper_bound(m_extents.begin(), m_extents.end(), disc_offset,
+                             [](u64 offset, const Extent& extent) { return offset < extent.start; });
+  if (it == m_extents.begin())
+    return nullptr;
+
+  --it;
+  return disc_offset < it->end ? &*it : nullptr;
+}
+}  // namespace Subtitles
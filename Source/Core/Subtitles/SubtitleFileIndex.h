@@ -0,0 +1,56 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <limits>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+namespace DiscIO
+{
+class FileSystem;
+}
+
+namespace Subtitles
+{
+struct SubtitleEntryGroup;
+
+/// <summary>
+/// Sorted disc extents of every file in one partition that has subtitles,
+/// so that a read can be matched to its subtitles without resolving the FST
+/// </summary>
+class SubtitleFileIndex
+{
+public:
+  static constexpr size_t NO_SHARD = std::numeric_limits<size_t>::max();
+
+  struct Extent
+  {
+    // Absolute disc offsets, end is exclusive
+    u64 start;
+    u64 end;
+    SubtitleEntryGroup* group;
+    // For extents added by AddDirectory, the shard to load when the file is read
+    size_t shard = NO_SHARD;
+  };
+
+  void Build(const DiscIO::FileSystem& file_system,
+             std::map<std::string, SubtitleEntryGroup>& translations);
+  // Adds every file below directory without a group, only marked with shard
+  void AddDirectory(const DiscIO::FileSystem& file_system, std::string_view directory,
+                    size_t shard);
+  void Clear();
+  bool IsEmpty() const;
+
+  // Returns nullptr if no subtitled file contains the offset
+  const Extent* Find(u64 disc_offset) const;
+
+private:
+  std::vector<Extent> m_extents;
+};
+}  // namespace Subtitles
@@ -0,0 +1,207 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Subtitles/SubtitleLoader.h"
+
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+#include <picojson.h>
+
+#include "Common/FileUtil.h"
+#include "Common/StringUtil.h"
+#include "Subtitles/Helpers.h"
+#include "Subtitles/SubtitlePack.h"
+#include "Subtitles/Subtitles.h"
+#include "VideoCommon/OnScreenDisplay.h"
+
+namespace Subtitles
+{
+static void DeserializeSubtitlesJson(const std::string& filepath, TranslationMap& translations)
+{
+  OSDInfo(fmt::format("Reading translations from: {}", filepath));
+
+  std::string json;
+  File::ReadFileToString(filepath, json);
+
+  if (json == "")
+    return;
+
+  picojson::value v;
+  std::string err = picojson::parse(v, json);
+  if (!err.empty())
+  {
+    Error(fmt::format("Subtitle JSON Error: {} in {}", err, filepath));
+    return;
+  }
+
+  if (!v.is<picojson::array>())
+  {
+    Error(fmt::format("Subtitle JSON Error: Not an array in {}", filepath));
+    return;
+  }
+
+  const auto& arr = v.get<picojson::array>();
+  for (const auto& item : arr)
+  {
+    const auto FileName = item.get("FileName");
+    const auto Translation = item.get("Translation");
+    const auto Miliseconds = item.get("Miliseconds");
+    const auto Color = item.get("Color");
+    const auto Enabled = item.get("Enabled");
+    const auto AllowDuplicate = item.get("AllowDuplicate");
+    const auto Scale = item.get("Scale");
+    const auto Offset = item.get("Offset");
+    const auto OffsetEnd = item.get("OffsetEnd");
+    const auto DisplayOnTop = item.get("DisplayOnTop");
+    const auto Timestamp = item.get("Timestamp");
+
+    // fitler out disabled entries, to lighten lookup load
+    bool enabled = Enabled.is<bool>() ? Enabled.get<bool>() : true;
+    if (!enabled)
+      continue;
+
+    // FileName and Translation are required fields
+    if (!FileName.is<std::string>() || !Translation.is<std::string>())
+      continue;
+
+    const u32 color = TryParsecolor(Color, OSD::Color::CYAN);
+
+    SubtitleEntry tl;
+    tl.Miliseconds =
+        Miliseconds.is<double>() ? Miliseconds.get<double>() : OSD::Duration::SHORT;
+    tl.Color = color;
+    tl.AllowDuplicate = AllowDuplicate.is<bool>() ? AllowDuplicate.get<bool>() : false;
+    tl.Scale = Scale.is<double>() ? Scale.get<double>() : 1;
+    tl.Offset = Offset.is<double>() ? Offset.get<double>() : 0;
+    tl.OffsetEnd = OffsetEnd.is<double>() ? OffsetEnd.get<double>() : 0;
+    tl.DisplayOnTop = DisplayOnTop.is<bool>() ? DisplayOnTop.get<bool>() : false;
+    tl.Timestamp = Timestamp.is<double>() ? Timestamp.get<double>() : 0;
+
+    translations[FileName.get<std::string>()].Add(tl, Translation.get<std::string>());
+  }
+}
+
+static void RecursivelyFindTranslationJsons(const File::FSTEntry& folder,
+                                            const std::string& filter,
+                                            std::vector<std::string>& paths)
+{
+  for (const auto& child : folder.children)
+  {
+    if (child.isDirectory)
+    {
+      RecursivelyFindTranslationJsons(child, filter, paths);
+    }
+    else
+    {
+      auto filepath = child.physicalName;
+      std::string extension;
+      SplitPath(filepath, nullptr, nullptr, &extension);
+      Common::ToLower(&extension);
+
+      if (extension == filter)
+      {
+        paths.push_back(std::move(filepath));
+      }
+    }
+  }
+}
+
+std::vector<std::string> FindSubtitleJsons(const std::string& directory)
+{
+  std::vector<std::string> paths;
+  auto fileEnumerator = File::ScanDirectoryTree(directory, true);
+  RecursivelyFindTranslationJsons(fileEnumerator, SubtitleFileExtension, paths);
+  return paths;
+}
+
+void ReadSubtitleJson(const std::string& path, TranslationMap& translations)
+{
+  DeserializeSubtitlesJson(path, translations);
+}
+
+std::vector<TranslationMap> ReadSubtitleJsons(const std::vector<std::string>& paths)
+{
+  std::vector<TranslationMap> results(paths.size());
+  if (paths.empty())
+    return results;
+
+  // One file per task, files are independent until they are merged
+  const size_t threads =
+      std::min(paths.size(), std::max<size_t>(1, std::thread::hardware_concurrency()));
+  std::atomic<size_t> next_path = 0;
+
+  std::vector<std::future<void>> futures(threads);
+  for (auto& future : futures)
+  {
+    future = std::async(std::launch::async, [&] {
+      for (size_t i = next_path++; i < paths.size(); i = next_path++)
+        DeserializeSubtitlesJson(paths[i], results[i]);
+    });
+  }
+
+  for (auto& future : futures)
+    future.get();
+
+  return results;
+}
+
+void MergeTranslations(TranslationMap& translations, TranslationMap&& from)
+{
+  for (auto& [filename, group] : from)
+  {
+    auto [it, inserted] = translations.try_emplace(filename, std::move(group));
+    if (!inserted)
+      it->second.Append(group);
+  }
+}
+
+void ReadSubtitleJsons(const std::string& directory, TranslationMap& translations)
+{
+  for (TranslationMap& result : ReadSubtitleJsons(FindSubtitleJsons(directory)))
+    MergeTranslations(translations, std::move(result));
+}
+
+bool ReadSubtitlePack(const std::string& path, TranslationMap& translations)
+{
+  SubtitlePack pack;
+  if (!pack.Open(path))
+    return false;
+
+  OSDInfo(fmt::format("Reading translations from: {}", path));
+
+  for (u32 i = 0; i < pack.GetFileCount(); i++)
+  {
+    SubtitleEntryGroup& group = translations[std::string(pack.GetFilePath(i))];
+
+    const auto cues = pack.GetCues(i);
+    size_t textSize = 0;
+    for (const SubtitlePackCue& cue : cues)
+      textSize += cue.text_size;
+    group.Reserve(cues.size(), textSize);
+
+    for (const SubtitlePackCue& cue : cues)
+    {
+      SubtitleEntry tl;
+      tl.Timestamp = cue.timestamp;
+      tl.Miliseconds = cue.miliseconds;
+      tl.Color = cue.color;
+      tl.Scale = cue.scale;
+      tl.Offset = cue.offset;
+      tl.OffsetEnd = cue.offset_end;
+      tl.AllowDuplicate = (cue.flags & CUE_FLAG_ALLOW_DUPLICATE) != 0;
+      tl.DisplayOnTop = (cue.flags & CUE_FLAG_DISPLAY_ON_TOP) != 0;
+      group.Add(tl, pack.GetCueText(cue));
+    }
+  }
+
+  return true;
+}
+}  // namespace Subtitles
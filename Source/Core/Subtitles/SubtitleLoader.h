@@ -0,0 +1,28 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "Subtitles/SubtitleEntry.h"
+
+namespace Subtitles
+{
+using TranslationMap = std::map<std::string, SubtitleEntryGroup>;
+
+// Lists the subtitle JSON files below directory
+std::vector<std::string> FindSubtitleJsons(const std::string& directory);
+void ReadSubtitleJson(const std::string& path, TranslationMap& translations);
+// Parses the files in parallel, returning one map per path in the same order
+std::vector<TranslationMap> ReadSubtitleJsons(const std::vector<std::string>& paths);
+// Appends the lines of from to the groups of the same file in translations
+void MergeTranslations(TranslationMap& translations, TranslationMap&& from);
+
+// Reads every subtitle JSON file below directory. Lines are not preprocessed.
+void ReadSubtitleJsons(const std::string& directory, TranslationMap& translations);
+// Reads a compiled .dsub pack. Lines are not preprocessed.
+bool ReadSubtitlePack(const std::string& path, TranslationMap& translations);
+}  // namespace Subtitles
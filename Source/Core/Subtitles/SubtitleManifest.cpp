@@ -0,0 +1,150 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Subtitles/SubtitleManifest.h"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+
+#include <fmt/format.h>
+#include <picojson.h>
+
+#include "Common/CommonPaths.h"
+#include "Common/FileUtil.h"
+#include "Common/StringUtil.h"
+#include "Subtitles/Helpers.h"
+#include "Subtitles/SubtitlePack.h"
+
+namespace Subtitles
+{
+static std::string NormalizeDiscDirectory(std::string directory)
+{
+  std::replace(directory.begin(), directory.end(), '\\', '/');
+  const size_t start = directory.find_first_not_of('/');
+  const size_t end = directory.find_last_not_of('/');
+  return start == std::string::npos ? std::string() : directory.substr(start, end - start + 1);
+}
+
+std::optional<SubtitleManifest> SubtitleManifest::Read(const std::string& subtitle_directory)
+{
+  const std::string path = subtitle_directory + DIR_SEP + SubtitleManifestFileName;
+
+  std::string json;
+  if (!File::ReadFileToString(path, json))
+    return std::nullopt;
+
+  picojson::value v;
+  const std::string err = picojson::parse(v, json);
+  if (!err.empty())
+  {
+    Error(fmt::format("Subtitle manifest error: {} in {}", err, path));
+    return std::nullopt;
+  }
+
+  const picojson::value& shards = v.get("Shards");
+  if (!shards.is<picojson::array>())
+  {
+    Error(fmt::format("Subtitle manifest error: Shards is not an array in {}", path));
+    return std::nullopt;
+  }
+
+  SubtitleManifest manifest;
+  const picojson::value& default_language = v.get("DefaultLanguage");
+  if (default_language.is<std::string>())
+    manifest.default_language = default_language.get<std::string>();
+
+  for (const picojson::value& item : shards.get<picojson::array>())
+  {
+    const picojson::value& shard_path = item.get("Path");
+    if (!shard_path.is<std::string>())
+      continue;
+
+    SubtitleShard& shard = manifest.shards.emplace_back();
+    shard.path = shard_path.get<std::string>();
+
+    const picojson::value& language = item.get("Language");
+    if (language.is<std::string>())
+      shard.language = language.get<std::string>();
+
+    const picojson::value& directories = item.get("Directories");
+    if (directories.is<picojson::array>())
+    {
+      for (const picojson::value& directory : directories.get<picojson::array>())
+      {
+        if (directory.is<std::string>())
+          shard.directories.push_back(NormalizeDiscDirectory(directory.get<std::string>()));
+      }
+    }
+  }
+
+  return manifest;
+}
+
+std::vector<SubtitleShard> SubtitleManifest::GetShards(std::string_view language) const
+{
+  const bool has_language =
+      !language.empty() && std::any_of(shards.begin(), shards.end(), [&](const SubtitleShard& s) {
+        return Common::CaseInsensitiveEquals(s.language, language);
+      });
+  const std::string_view selected = has_language ? language : default_language;
+
+  std::vector<SubtitleShard> result;
+  for (const SubtitleShard& shard : shards)
+  {
+    if (shard.language.empty() || Common::CaseInsensitiveEquals(shard.language, selected))
+      result.push_back(shard);
+  }
+  return result;
+}
+
+TranslationMap ReadSubtitleShard(const std::string& subtitle_directory,
+                                 const SubtitleShard& shard)
+{
+  const std::string path = subtitle_directory + DIR_SEP + shard.path;
+
+  TranslationMap translations;
+  if (File::IsDirectory(path))
+    ReadSubtitleJsons(path, translations);
+  else if (path.ends_with(SubtitlePackExtension))
+    ReadSubtitlePack(path, translations);
+  else
+    ReadSubtitleJson(path, translations);
+  return translations;
+}
+
+void PendingShards::Reset(std::string subtitle_directory, std::vector<SubtitleShard> shards)
+{
+  m_subtitle_directory = std::move(subtitle_directory);
+  m_shards.clear();
+  for (SubtitleShard& shard : shards)
+    m_shards.push_back(Shard{std::move(shard)});
+  ++m_generation;
+}
+
+std::optional<PendingShards::Load> PendingShards::Begin(size_t index)
+{
+  Shard& shard = m_shards[index];
+  if (shard.loaded)
+    return std::nullopt;
+
+  shard.loaded = true;
+  return Load{m_subtitle_directory, shard.shard, m_generation};
+}
+
+bool PendingShards::Finish(const Load& load, TranslationMap&& lines,
+                           TranslationMap& translations) const
+{
+  if (load.generation != m_generation)
+    return false;
+
+  std::vector<std::string> filenames;
+  for (const auto& [filename, group] : lines)
+    filenames.push_back(filename);
+
+  MergeTranslations(translations, std::move(lines));
+  for (const std::string& filename : filenames)
+    translations[filename].Preprocess();
+  return true;
+}
+}  // namespace Subtitles
@@ -0,0 +1,92 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Subtitles/SubtitleLoader.h"
+
+namespace Subtitles
+{
+// Optional file in a game's subtitle directory that splits its subtitles into shards, e.g.
+// {
+//   "DefaultLanguage": "en",
+//   "Shards": [
+//     { "Path": "en/menus.json", "Language": "en" },
+//     { "Path": "en/voice", "Language": "en", "Directories": ["sound/voice"] },
+//     { "Path": "de/voice.dsub", "Language": "de", "Directories": ["sound/voice"] }
+//   ]
+// }
+// Path is a JSON file, a directory of JSON files or a compiled pack, relative to the subtitle
+// directory. Only the shards of one language (and those without a language) are used. Shards
+// without Directories are loaded at boot, the others the first time a file below one of their
+// disc directories is read.
+const std::string SubtitleManifestFileName = "subtitles.manifest";
+
+struct SubtitleShard
+{
+  std::string path;
+  std::string language;
+  // Disc directories, without leading or trailing slashes. Empty if loaded at boot.
+  std::vector<std::string> directories;
+};
+
+struct SubtitleManifest
+{
+  std::string default_language;
+  std::vector<SubtitleShard> shards;
+
+  static std::optional<SubtitleManifest> Read(const std::string& subtitle_directory);
+
+  // The shards of language, or of the default language if no shard has the given one
+  std::vector<SubtitleShard> GetShards(std::string_view language) const;
+};
+
+// Reads the shard's subtitles. Lines are not preprocessed.
+TranslationMap ReadSubtitleShard(const std::string& subtitle_directory,
+                                 const SubtitleShard& shard);
+
+// The shards of a title that are loaded the first time a file below their directories is read.
+// A shard is read between Begin and Finish, so that the lock guarding this and the translations
+// can be released while it is read.
+class PendingShards
+{
+public:
+  struct Load
+  {
+    std::string subtitle_directory;
+    SubtitleShard shard;
+    u64 generation;
+  };
+
+  // Replaces the shards of the previous title, loads of those that are still running are dropped
+  void Reset(std::string subtitle_directory, std::vector<SubtitleShard> shards);
+
+  bool IsEmpty() const { return m_shards.empty(); }
+  size_t GetCount() const { return m_shards.size(); }
+  const SubtitleShard& Get(size_t index) const { return m_shards[index].shard; }
+  bool IsLoaded(size_t index) const { return m_shards[index].loaded; }
+
+  // Marks the shard as loaded and returns what to read, nothing if it was loaded already
+  std::optional<Load> Begin(size_t index);
+  // Merges the lines read for load into translations and preprocesses the groups that got lines.
+  // Returns false without touching translations if Reset was called since Begin.
+  bool Finish(const Load& load, TranslationMap&& lines, TranslationMap& translations) const;
+
+private:
+  struct Shard
+  {
+    SubtitleShard shard;
+    bool loaded = false;
+  };
+
+  std::string m_subtitle_directory;
+  std::vector<Shard> m_shards;
+  u64 m_generation = 0;
+};
+}  // namespace Subtitles
@@ -0,0 +1,210 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Subtitles/SubtitlePack.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <string_view>
+#include <vector>
+
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+#include "Subtitles/SubtitleEntry.h"
+
+namespace Subtitles
+{
+bool WriteSubtitlePack(const std::string& path,
+                       const std::map<std::string, SubtitleEntryGroup>& translations)
+{
+  std::vector<SubtitlePackFile> files;
+  std::vector<SubtitlePackCue> cues;
+  std::string strings;
+
+  const auto add_string = [&strings](std::string_view str) {
+    const u32 offset = static_cast<u32>(strings.size());
+    strings += str;
+    return offset;
+  };
+
+  // std::map iterates in path order, which is what FindFile relies on
+  files.reserve(translations.size());
+  for (const auto& [file_path, group] : translations)
+  {
+    SubtitlePackFile& file = files.emplace_back();
+    file.path_offset = add_string(file_path);
+    file.path_size = static_cast<u32>(file_path.size());
+    file.first_cue = static_cast<u32>(cues.size());
+    file.cue_count = static_cast<u32>(group.subtitleLines.size());
+
+    for (const SubtitleEntry& line : group.subtitleLines)
+    {
+      SubtitlePackCue& cue = cues.emplace_back();
+      cue.timestamp = line.Timestamp;
+      const std::string_view text = group.GetText(line);
+      cue.text_offset = add_string(text);
+      cue.text_size = static_cast<u32>(text.size());
+      cue.miliseconds = line.Miliseconds;
+      cue.color = line.Color;
+      cue.offset = line.Offset;
+      cue.offset_end = line.OffsetEnd;
+      cue.scale = line.Scale;
+      cue.flags = (line.AllowDuplicate ? CUE_FLAG_ALLOW_DUPLICATE : 0) |
+                  (line.DisplayOnTop ? CUE_FLAG_DISPLAY_ON_TOP : 0);
+    }
+  }
+
+  const u64 total_size = sizeof(SubtitlePackHeader) + files.size() * sizeof(SubtitlePackFile) +
+                         cues.size() * sizeof(SubtitlePackCue) + strings.size();
+  if (total_size > std::numeric_limits<u32>::max())
+  {
+    ERROR_LOG_FMT(SUBTITLES, "Subtitle pack {} would be too large", path);
+    return false;
+  }
+
+  SubtitlePackHeader header{};
+  header.magic = SUBTITLE_PACK_MAGIC;
+  header.version = SUBTITLE_PACK_VERSION;
+  header.file_count = static_cast<u32>(files.size());
+  header.cue_count = static_cast<u32>(cues.size());
+  header.file_table_offset = sizeof(SubtitlePackHeader);
+  header.cue_table_offset =
+      header.file_table_offset + static_cast<u32>(files.size() * sizeof(SubtitlePackFile));
+  header.string_pool_offset =
+      header.cue_table_offset + static_cast<u32>(cues.size() * sizeof(SubtitlePackCue));
+  header.string_pool_size = static_cast<u32>(strings.size());
+
+  File::IOFile file(path, "wb");
+  if (!file.IsOpen() || !file.WriteArray(&header, 1) ||
+      !file.WriteArray(files.data(), files.size()) || !file.WriteArray(cues.data(), cues.size()) ||
+      !file.WriteBytes(strings.data(), strings.size()))
+  {
+    ERROR_LOG_FMT(SUBTITLES, "Failed to write subtitle pack {}", path);
+    return false;
+  }
+
+  return true;
+}
+
+bool SubtitlePack::Open(const std::string& path)
+{
+  Close();
+
+  if (!m_file.Open(path))
+    return false;
+
+  const u8* data = m_file.GetData();
+  const u64 size = m_file.GetSize();
+
+  if (size < sizeof(SubtitlePackHeader))
+  {
+    ERROR_LOG_FMT(SUBTITLES, "Subtitle pack {} is truncated", path);
+    Close();
+    return false;
+  }
+
+  std::memcpy(&m_header, data, sizeof(SubtitlePackHeader));
+  if (m_header.magic != SUBTITLE_PACK_MAGIC || m_header.version != SUBTITLE_PACK_VERSION)
+  {
+    ERROR_LOG_FMT(SUBTITLES, "Subtitle pack {} has an unsupported format", path);
+    Close();
+    return false;
+  }
+
+  const u64 files_end =
+      u64(m_header.file_table_offset) + u64(m_header.file_count) * sizeof(SubtitlePackFile);
+  const u64 cues_end =
+      u64(m_header.cue_table_offset) + u64(m_header.cue_count) * sizeof(SubtitlePackCue);
+  const u64 strings_end = u64(m_header.string_pool_offset) + m_header.string_pool_size;
+  if (files_end > size || cues_end > size || strings_end > size)
+  {
+    ERROR_LOG_FMT(SUBTITLES, "Subtitle pack {} is truncated", path);
+    Close();
+    return false;
+  }
+
+  m_files = reinterpret_cast<const SubtitlePackFile*>(data + m_header.file_table_offset);
+  m_cues = reinterpret_cast<const SubtitlePackCue*>(data + m_header.cue_table_offset);
+  m_strings = reinterpret_cast<const char*>(data + m_header.string_pool_offset);
+
+  // Validate references once so that accessors don't have to
+  for (u32 i = 0; i < m_header.file_count; i++)
+  {
+    const SubtitlePackFile& file = m_files[i];
+    if (u64(file.path_offset) + file.path_size > m_header.string_pool_size ||
+        u64(file.first_cue) + file.cue_count > m_header.cue_count)
+    {
+      ERROR_LOG_FMT(SUBTITLES, "Subtitle pack {} is corrupted", path);
+      Close();
+      return false;
+    }
+  }
+  for (u32 i = 0; i < m_header.cue_count; i++)
+  {
+    if (u64(m_cues[i].text_offset) + m_cues[i].text_size > m_header.string_pool_size)
+    {
+      ERROR_LOG_FMT(SUBTITLES, "Subtitle pack {} is corrupted", path);
+      Close();
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void SubtitlePack::Close()
+{
+  m_file.Close();
+  m_header = {};
+  m_files = nullptr;
+  m_cues = nullptr;
+  m_strings = nullptr;
+}
+
+std::string_view SubtitlePack::GetString(u32 offset, u32 size) const
+{
+  return std::string_view(m_strings + offset, size);
+}
+
+std::string_view SubtitlePack::GetFilePath(u32 file_index) const
+{
+  const SubtitlePackFile& file = m_files[file_index];
+  return GetString(file.path_offset, file.path_size);
+}
+
+std::span<const SubtitlePackCue> SubtitlePack::GetCues(u32 file_index) const
+{
+  const SubtitlePackFile& file = m_files[file_index];
+  return std::span<const SubtitlePackCue>(m_cues + file.first_cue, file.cue_count);
+}
+
+std::string_view SubtitlePack::GetCueText(const SubtitlePackCue& cue) const
+{
+  return GetString(cue.text_offset, cue.text_size);
+}
+
+std::optional<u32> SubtitlePack::FindFile(std::string_view path) const
+{
+  u32 first = 0;
+  u32 count = m_header.file_count;
+  while (count > 0)
+  {
+    const u32 step = count / 2;
+    const u32 middle = first + step;
+    if (GetFilePath(middle) < path)
+    {
+      first = middle + 1;
+      count -= step + 1;
+    }
+    else
+    {
+      count = step;
+    }
+  }
+
+  if (first < m_header.file_count && GetFilePath(first) == path)
+    return first;
+  return std::nullopt;
+}
+}  // namespace Subtitles
@@ -0,0 +1,103 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <map>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+
+#include "Common/CommonTypes.h"
+#include "Common/MappedFile.h"
+
+namespace Subtitles
+{
+struct SubtitleEntryGroup;
+
+// Compiled subtitle pack (.dsub), generated from the JSON files with
+// "dolphin-tool subtitles compile" and memory-mapped at boot.
+//
+// Layout: header, file table sorted by path, cue table grouped by file and sorted
+// by start, then a string pool holding paths and cue texts (not null-terminated).
+// All values are stored in host byte order, a pack with the wrong byte order is
+// rejected by its magic.
+const std::string SubtitlePackExtension = ".dsub";
+
+constexpr u32 SUBTITLE_PACK_MAGIC = 0x42555344;  // "DSUB"
+constexpr u32 SUBTITLE_PACK_VERSION = 1;
+
+#pragma pack(push, 1)
+struct SubtitlePackHeader
+{
+  u32 magic;
+  u32 version;
+  u32 file_count;
+  u32 cue_count;
+  u32 file_table_offset;
+  u32 cue_table_offset;
+  u32 string_pool_offset;
+  u32 string_pool_size;
+};
+static_assert(sizeof(SubtitlePackHeader) == 0x20, "Wrong size for subtitle pack header");
+
+struct SubtitlePackFile
+{
+  u32 path_offset;
+  u32 path_size;
+  u32 first_cue;
+  u32 cue_count;
+};
+static_assert(sizeof(SubtitlePackFile) == 0x10, "Wrong size for subtitle pack file entry");
+
+enum SubtitlePackCueFlags : u32
+{
+  CUE_FLAG_ALLOW_DUPLICATE = 1 << 0,
+  CUE_FLAG_DISPLAY_ON_TOP = 1 << 1,
+};
+
+struct SubtitlePackCue
+{
+  u64 timestamp;
+  u32 text_offset;
+  u32 text_size;
+  u32 miliseconds;
+  u32 color;
+  u32 offset;
+  u32 offset_end;
+  float scale;
+  u32 flags;
+};
+static_assert(sizeof(SubtitlePackCue) == 0x28, "Wrong size for subtitle pack cue");
+#pragma pack(pop)
+
+// Lines must already be preprocessed, so that cues are stored in lookup order
+bool WriteSubtitlePack(const std::string& path,
+                       const std::map<std::string, SubtitleEntryGroup>& translations);
+
+class SubtitlePack
+{
+public:
+  bool Open(const std::string& path);
+  void Close();
+  bool IsOpen() const { return m_file.IsOpen(); }
+
+  u32 GetFileCount() const { return m_header.file_count; }
+  std::string_view GetFilePath(u32 file_index) const;
+  std::span<const SubtitlePackCue> GetCues(u32 file_index) const;
+  std::string_view GetCueText(const SubtitlePackCue& cue) const;
+
+  // Binary search in the sorted file table
+  std::optional<u32> FindFile(std::string_view path) const;
+
+private:
+  std::string_view GetString(u32 offset, u32 size) const;
+
+  File::MappedFile m_file;
+  SubtitlePackHeader m_header{};
+  const SubtitlePackFile* m_files = nullptr;
+  const SubtitlePackCue* m_cues = nullptr;
+  const char* m_strings = nullptr;
+};
+}  // namespace Subtitles
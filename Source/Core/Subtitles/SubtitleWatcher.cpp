@@ -0,0 +1,129 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Subtitles/SubtitleWatcher.h"
+
+#include <system_error>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include "Common/StringUtil.h"
+#include "Subtitles/Helpers.h"
+
+namespace Subtitles
+{
+static std::filesystem::file_time_type GetWriteTime(const std::string& path)
+{
+  std::error_code ec;
+  const auto time = std::filesystem::last_write_time(StringToPath(path), ec);
+  return ec ? std::filesystem::file_time_type{} : time;
+}
+
+TranslationMap SubtitleSourceSet::Load(const std::string& directory)
+{
+  m_directory = directory;
+  m_sources.clear();
+
+  const std::vector<std::string> paths = FindSubtitleJsons(directory);
+  std::vector<TranslationMap> results = ReadSubtitleJsons(paths);
+
+  for (size_t i = 0; i < paths.size(); i++)
+    m_sources[paths[i]] = Source{GetWriteTime(paths[i]), std::move(results[i])};
+
+  // Merging copies, the per-source maps are kept for incremental updates
+  TranslationMap translations;
+  for (const auto& [path, source] : m_sources)
+  {
+    TranslationMap copy = source.translations;
+    MergeTranslations(translations, std::move(copy));
+  }
+  return translations;
+}
+
+void SubtitleSourceSet::Clear()
+{
+  m_directory.clear();
+  m_sources.clear();
+}
+
+std::optional<SubtitleSourceSet::Update> SubtitleSourceSet::Refresh()
+{
+  if (m_directory.empty())
+    return std::nullopt;
+
+  std::set<std::string> affected;
+
+  const std::vector<std::string> paths = FindSubtitleJsons(m_directory);
+  const std::set<std::string> present(paths.begin(), paths.end());
+
+  for (auto it = m_sources.begin(); it != m_sources.end();)
+  {
+    if (present.contains(it->first))
+    {
+      ++it;
+      continue;
+    }
+
+    for (const auto& [filename, group] : it->second.translations)
+      affected.insert(filename);
+    it = m_sources.erase(it);
+  }
+
+  std::vector<std::string> changed_paths;
+  for (const std::string& path : paths)
+  {
+    const auto it = m_sources.find(path);
+    if (it == m_sources.end() || it->second.write_time != GetWriteTime(path))
+      changed_paths.push_back(path);
+  }
+
+  std::vector<TranslationMap> results = ReadSubtitleJsons(changed_paths);
+  for (size_t i = 0; i < changed_paths.size(); i++)
+  {
+    OSDInfo(fmt::format("Reloaded translations from: {}", changed_paths[i]));
+
+    Source& source = m_sources[changed_paths[i]];
+    for (const auto& [filename, group] : source.translations)
+      affected.insert(filename);
+    for (const auto& [filename, group] : results[i])
+      affected.insert(filename);
+
+    source.write_time = GetWriteTime(changed_paths[i]);
+    source.translations = std::move(results[i]);
+  }
+
+  if (affected.empty())
+    return std::nullopt;
+
+  Update update;
+  for (const std::string& filename : affected)
+  {
+    SubtitleEntryGroup group = MergeGroup(filename);
+    if (group.subtitleLines.empty())
+    {
+      update.removed.push_back(filename);
+    }
+    else
+    {
+      group.Preprocess();
+      update.changed.emplace(filename, std::move(group));
+    }
+  }
+  return update;
+}
+
+SubtitleEntryGroup SubtitleSourceSet::MergeGroup(const std::string& filename) const
+{
+  SubtitleEntryGroup merged;
+  for (const auto& [path, source] : m_sources)
+  {
+    const auto it = source.translations.find(filename);
+    if (it == source.translations.end())
+      continue;
+
+    merged.Append(it->second);
+  }
+  return merged;
+}
+}  // namespace Subtitles
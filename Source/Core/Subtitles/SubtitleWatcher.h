@@ -0,0 +1,52 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "Subtitles/SubtitleLoader.h"
+
+namespace Subtitles
+{
+/// <summary>
+/// Keeps what each JSON file of a subtitle directory contributed,
+/// so that editing one file only re-parses that file
+/// </summary>
+class SubtitleSourceSet
+{
+public:
+  struct Update
+  {
+    // Preprocessed replacements for every file whose lines changed
+    TranslationMap changed;
+    // Files that no longer have any lines
+    std::vector<std::string> removed;
+  };
+
+  // Parses every JSON file below directory and returns the merged, not yet preprocessed, result
+  TranslationMap Load(const std::string& directory);
+  void Clear();
+
+  // Re-parses JSON files that were added, modified or deleted since the last call
+  std::optional<Update> Refresh();
+
+private:
+  struct Source
+  {
+    std::filesystem::file_time_type write_time;
+    TranslationMap translations;
+  };
+
+  SubtitleEntryGroup MergeGroup(const std::string& filename) const;
+
+  std::string m_directory;
+  // Sorted by JSON path, which is also the order lines are merged in
+  std::map<std::string, Source> m_sources;
+};
+}  // namespace Subtitles
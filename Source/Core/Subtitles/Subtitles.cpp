@@ -1,192 +1,521 @@
 // Copyright 2023 Dolphin Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
-#pragma once
-
 #include "Subtitles/Subtitles.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <fstream>
 #include <iostream>
 #include <map>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <thread>
 #include <vector>
 
-#include <picojson.h>
-
+#include "Common/Assert.h"
+#include "Common/Counters.h"
+#include "Common/Event.h"
 #include "Common/FileUtil.h"
+#include "Common/Flag.h"
 #include "Common/Logging/LogManager.h"
+#include "Common/SPSCQueue.h"
+#include "Common/Thread.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
+#include "Core/HW/SystemTimers.h"
 #include "DiscIO/Filesystem.h"
 #include "Subtitles/Helpers.h"
 #include "Subtitles/SubtitleEntry.h"
+#include "Subtitles/SubtitleFileIndex.h"
+#include "Subtitles/SubtitleLoader.h"
+#include "Subtitles/SubtitleManifest.h"
+#include "Subtitles/SubtitlePack.h"
+#include "Subtitles/SubtitleWatcher.h"
 #include "VideoCommon/OnScreenDisplay.h"
 
 namespace Subtitles
 {
+struct FileAccessEvent
+{
+  const DiscIO::Volume* volume = nullptr;
+  DiscIO::Partition partition{};
+  u64 offset = 0;
+  u64 ticks = 0;
+  // Set for the playback positions of streamed audio, bytesPerSecond is 0 if unknown
+  bool playback = false;
+  u32 bytesPerSecond = 0;
+};
+
 bool g_messageStacksInitialized = false;
-bool g_subtitlesInitialized = false;
+OSD::MessageStackHandle g_bottomOSDStack = OSD::DEFAULT_MESSAGE_STACK;
+OSD::MessageStackHandle g_topOSDStack = OSD::DEFAULT_MESSAGE_STACK;
+std::atomic<bool> g_subtitlesInitialized = false;
+std::atomic<bool> g_syncToStream = false;
+// Guards Translations against a reload while the worker is resolving an access
+std::mutex g_translationsMutex;
 std::map<std::string, SubtitleEntryGroup> Translations;
+// Extents of subtitled files, built on first access to each partition of the indexed volume
+const DiscIO::Volume* g_indexedVolume = nullptr;
+std::map<DiscIO::Partition, SubtitleFileIndex> g_fileIndices;
+
+PendingShards g_pendingShards;
+// Files below the directories of the shards that aren't loaded yet, per partition
+std::map<DiscIO::Partition, SubtitleFileIndex> g_shardIndices;
+
+std::thread g_workerThread;
+Common::Event g_accessQueueExpanded;                 // Is set by DVD and CPU thread
+Common::Event g_accessQueueDrained;                  // Is set by subtitle worker
+Common::Flag g_workerExiting = Common::Flag(false);  // Is set by CPU thread
+// Single producer (DVD thread), single consumer (subtitle worker)
+Common::SPSCQueue<FileAccessEvent, false> g_accessQueue;
+// Single producer (CPU thread), single consumer (subtitle worker)
+Common::SPSCQueue<FileAccessEvent, false> g_playbackQueue;
+
+// Hot reload of JSON subtitles, only polls while the Subtitles log is enabled
+std::thread g_watcherThread;
+Common::Event g_watcherWakeup;
+Common::Flag g_watcherExiting = Common::Flag(false);
+SubtitleSourceSet g_sources;
+// Set by the loader once g_sources holds the JSON sources of the title, until then the watcher
+// leaves g_sources alone
+std::atomic<bool> g_watchSources = false;
+constexpr auto WATCHER_POLL_INTERVAL = std::chrono::seconds(1);
+
+// Lines laid out ahead of the one being shown, so that showing them costs the video thread nothing
+constexpr size_t PREPARED_LINES_AHEAD = 4;
+
+// Loads the subtitles of a new title, so that the CPU thread doesn't wait for the parsing
+std::thread g_loaderThread;
+
+Common::Counter g_subtitleLookups("dolphin_subtitle_lookups_total",
+                                  "Disc accesses looked up in the subtitle index");
+Common::Counter g_subtitlesShown("dolphin_subtitles_shown_total", "Subtitles that were shown");
 
-void DeserializeSubtitlesJson(std::string& filepath)
+void IniitalizeOSDMessageStacks()
 {
-  OSDInfo(fmt::format("Reading translations from: {}", filepath));
+  if (g_messageStacksInitialized)
+    return;
 
-  std::string json;
-  File::ReadFileToString(filepath, json);
+  // Both are burnt into frame dumps
+  g_bottomOSDStack = OSD::AddMessageStack(0, 0, OSD::MessageStackDirection::Upward, true, true,
+                                         BottomOSDStackName, true, true);
 
-  if (json == "")
-    return;
+  g_topOSDStack = OSD::AddMessageStack(0, 0, OSD::MessageStackDirection::Downward, true, false,
+                                      TopOSDStackName, true, true);
+
+  g_messageStacksInitialized = true;
+}
 
-  picojson::value v;
-  std::string err = picojson::parse(v, json);
-  if (!err.empty())
+void ApplySourceUpdate(SubtitleSourceSet::Update update)
+{
+  bool empty;
   {
-    Error(fmt::format("Subtitle JSON Error: {} in {}", err, filepath));
-    return;
+    std::lock_guard lock(g_translationsMutex);
+
+    for (auto& [filename, group] : update.changed)
+      Translations[filename] = std::move(group);
+    for (const std::string& filename : update.removed)
+      Translations.erase(filename);
+
+    // Group pointers of removed files are gone and new files are missing, rebuild lazily
+    g_fileIndices.clear();
+    empty = Translations.empty();
   }
 
-  if (!v.is<picojson::array>())
+  if (!empty)
+    IniitalizeOSDMessageStacks();
+  g_subtitlesInitialized = !empty;
+}
+
+void WatcherMain()
+{
+  Common::SetCurrentThreadName("Subtitle watcher");
+
+  while (true)
   {
-    Error(fmt::format("Subtitle JSON Error: Not an array in {}", filepath));
+    g_watcherWakeup.WaitFor(WATCHER_POLL_INTERVAL);
+
+    if (g_watcherExiting.IsSet())
+      return;
+
+    if (!g_watchSources.load(std::memory_order_acquire) || !IsTranslatorModeEnabled())
+      continue;
+
+    // Parsing happens here, only swapping in the result takes the lock
+    if (auto update = g_sources.Refresh())
+      ApplySourceUpdate(std::move(*update));
+  }
+}
+
+void StartWatcher()
+{
+  ASSERT(!g_watcherThread.joinable());
+
+  g_watcherWakeup.Reset();
+  g_watcherExiting.Clear();
+  g_watcherThread = std::thread(WatcherMain);
+}
+
+void StopWatcher()
+{
+  if (!g_watcherThread.joinable())
     return;
+
+  g_watcherExiting.Set();
+  g_watcherWakeup.Set();
+
+  g_watcherThread.join();
+}
+
+void LoadSubtitlesForGame(const std::string& gameId, const std::string& language)
+{
+  Common::SetCurrentThreadName("Subtitle loader");
+
+  auto subtitleDir = File::GetUserPath(D_SUBTITLES_IDX) + gameId;
+
+  OSDInfo(fmt::format("Loading subtitles for {} from {}", gameId, subtitleDir));
+
+  // A manifest takes precedence over a compiled pack, which takes precedence over the JSON
+  // sources it was built from
+  TranslationMap translations;
+  std::vector<SubtitleShard> pendingShards;
+  const std::optional<SubtitleManifest> manifest = SubtitleManifest::Read(subtitleDir);
+  const bool fromPack =
+      !manifest && ReadSubtitlePack(subtitleDir + SubtitlePackExtension, translations);
+  if (manifest)
+  {
+    g_sources.Clear();
+    for (SubtitleShard& shard : manifest->GetShards(language))
+    {
+      if (shard.directories.empty())
+        MergeTranslations(translations, ReadSubtitleShard(subtitleDir, shard));
+      else
+        pendingShards.push_back(std::move(shard));
+    }
+  }
+  else if (fromPack)
+  {
+    g_sources.Clear();
+  }
+  else
+  {
+    translations = g_sources.Load(subtitleDir);
   }
 
-  auto arr = v.get<picojson::array>();
-  for (auto item : arr)
+  // ensure stuff is sorted, you never know what mess people will make in text files :)
+  std::for_each(translations.begin(), translations.end(),
+                [](std::pair<const std::string, SubtitleEntryGroup>& t) { t.second.Preprocess(); });
+
+  const bool empty = translations.empty() && pendingShards.empty();
   {
-    const auto FileName = item.get("FileName");
-    const auto Translation = item.get("Translation");
-    const auto Miliseconds = item.get("Miliseconds");
-    const auto Color = item.get("Color");
-    const auto Enabled = item.get("Enabled");
-    const auto AllowDuplicate = item.get("AllowDuplicate");
-    const auto Scale = item.get("Scale");
-    const auto Offset = item.get("Offset");
-    const auto OffsetEnd = item.get("OffsetEnd");
-    const auto DisplayOnTop = item.get("DisplayOnTop");
-    const auto Timestamp = item.get("Timestamp");
-
-    // fitler out disabled entries, to lighten lookup load
-    bool enabled = Enabled.is<bool>() ? Enabled.get<bool>() : true;
-    if (!enabled)
-      continue;
+    std::lock_guard lock(g_translationsMutex);
+    Translations = std::move(translations);
+    g_fileIndices.clear();
+    g_pendingShards.Reset(subtitleDir, std::move(pendingShards));
+    g_shardIndices.clear();
+  }
 
-    // FileName and Translation are required fields
-    if (!FileName.is<std::string>() || !Translation.is<std::string>())
-      continue;
+  // Translators may start from an empty directory, so watch it even if nothing was loaded.
+  // Hot reload only covers plain JSON sources.
+  if (!manifest && !fromPack)
+    g_watchSources.store(true, std::memory_order_release);
 
-    const u32 color = TryParsecolor(Color, OSD::Color::CYAN);
+  if (empty)
+    return;
 
-    std::string filename = FileName.to_str();
-    std::string translation = Translation.to_str();
+  IniitalizeOSDMessageStacks();
 
-    auto tl = SubtitleEntry(
-        filename, translation,
-        Miliseconds.is<double>() ? Miliseconds.get<double>() : OSD::Duration::SHORT, color, enabled,
-        AllowDuplicate.is<bool>() ? AllowDuplicate.get<bool>() : false,
-        Scale.is<double>() ? Scale.get<double>() : 1,
-        Offset.is<double>() ? Offset.get<double>() : 0,
-        OffsetEnd.is<double>() ? OffsetEnd.get<double>() : 0,
-        DisplayOnTop.is<bool>() ? DisplayOnTop.get<bool>() : false,
-        Timestamp.is<double>() ? Timestamp.get<double>() : 0);
+  g_subtitlesInitialized = true;
+  Info(fmt::format("Subtitles loaded for {}", gameId));
+}
 
-    Translations[tl.Filename].Add(tl);
+void StopLoader()
+{
+  if (g_loaderThread.joinable())
+    g_loaderThread.join();
+}
+
+void Reload()
+{
+  // A previous title's load is normally long done by the time the next title starts
+  StopLoader();
+  StopWatcher();
+
+  // Accesses are dropped until the new subtitles are swapped in
+  g_subtitlesInitialized = false;
+  g_watchSources = false;
+  g_syncToStream = Config::Get(Config::MAIN_SUBTITLES_SYNC_TO_STREAM);
+  g_loaderThread = std::thread(LoadSubtitlesForGame, SConfig::GetInstance().GetGameID(),
+                               Config::Get(Config::MAIN_SUBTITLES_LANGUAGE));
+  StartWatcher();
+}
+
+void ClearFileIndices()
+{
+  std::lock_guard lock(g_translationsMutex);
+  g_indexedVolume = nullptr;
+  g_fileIndices.clear();
+  g_shardIndices.clear();
+}
+
+void SetIndexedVolume(const DiscIO::Volume& volume)
+{
+  if (g_indexedVolume == &volume)
+    return;
+
+  g_fileIndices.clear();
+  g_shardIndices.clear();
+  g_indexedVolume = &volume;
+}
+
+const SubtitleFileIndex& GetFileIndex(const DiscIO::Volume& volume,
+                                      const DiscIO::Partition& partition)
+{
+  SetIndexedVolume(volume);
+
+  auto [it, inserted] = g_fileIndices.try_emplace(partition);
+  if (inserted)
+  {
+    if (const DiscIO::FileSystem* file_system = volume.GetFileSystem(partition))
+      it->second.Build(*file_system, Translations);
   }
+  return it->second;
 }
 
-void RecursivelyReadTranslationJsons(const File::FSTEntry& folder, const std::string& filter)
+const SubtitleFileIndex& GetShardIndex(const DiscIO::Volume& volume,
+                                       const DiscIO::Partition& partition)
 {
-  for (const auto& child : folder.children)
+  SetIndexedVolume(volume);
+
+  auto [it, inserted] = g_shardIndices.try_emplace(partition);
+  if (inserted)
   {
-    if (child.isDirectory)
-    {
-      RecursivelyReadTranslationJsons(child, filter);
-    }
-    else
+    if (const DiscIO::FileSystem* file_system = volume.GetFileSystem(partition))
     {
-      auto filepath = child.physicalName;
-      std::string extension;
-      SplitPath(filepath, nullptr, nullptr, &extension);
-      Common::ToLower(&extension);
-
-      if (extension == filter)
+      for (size_t i = 0; i < g_pendingShards.GetCount(); ++i)
       {
-        DeserializeSubtitlesJson(filepath);
+        if (g_pendingShards.IsLoaded(i))
+          continue;
+        for (const std::string& directory : g_pendingShards.Get(i).directories)
+          it->second.AddDirectory(*file_system, directory, i);
       }
     }
   }
+  return it->second;
 }
 
-void IniitalizeOSDMessageStacks()
+// Loads the pending shard covering the accessed file, if any. The shard is read without holding
+// the lock, so that the CPU thread's reloads don't wait for it.
+void LoadShardForAccess(std::unique_lock<std::mutex>& lock, const FileAccessEvent& access)
 {
-  if (g_messageStacksInitialized)
+  if (g_pendingShards.IsEmpty())
     return;
 
-  OSD::AddMessageStack(0, 0, OSD::MessageStackDirection::Upward, true, true, BottomOSDStackName);
+  const SubtitleFileIndex::Extent* extent =
+      GetShardIndex(*access.volume, access.partition).Find(access.offset);
+  if (!extent)
+    return;
 
-  OSD::AddMessageStack(0, 0, OSD::MessageStackDirection::Downward, true, false, TopOSDStackName);
+  const std::optional<PendingShards::Load> load = g_pendingShards.Begin(extent->shard);
+  if (!load)
+    return;
 
-  g_messageStacksInitialized = true;
+  lock.unlock();
+  TranslationMap lines = ReadSubtitleShard(load->subtitle_directory, load->shard);
+  lock.lock();
+
+  // A reload while the shard was read replaced the title's subtitles
+  if (!g_pendingShards.Finish(*load, std::move(lines), Translations))
+    return;
+
+  // The file indices lack the shard's new groups and its files are no longer pending
+  g_fileIndices.clear();
+  g_shardIndices.clear();
 }
 
-void LoadSubtitlesForGame(const std::string& gameId)
+// Hands the lines from first on to the OSD to lay out, groups are sorted so these come next
+void PrepareLines(SubtitleEntryGroup& group, size_t first)
 {
-  g_subtitlesInitialized = false;
-  Translations.clear();
+  const size_t end = std::min(first + PREPARED_LINES_AHEAD, group.subtitleLines.size());
+  for (size_t i = std::max(first, group.preparedLines); i < end; ++i)
+    OSD::PrepareMessage(group.GetTextPool(), group.GetText(group.subtitleLines[i]));
+  group.preparedLines = std::max(group.preparedLines, end);
+}
 
-  auto subtitleDir = File::GetUserPath(D_SUBTITLES_IDX) + gameId;
+void ResolveFileAccess(const FileAccessEvent& access)
+{
+  std::unique_lock lock(g_translationsMutex);
 
-  OSDInfo(fmt::format("Loading subtitles for {} from {}", gameId, subtitleDir));
+  if (!g_subtitlesInitialized)
+    return;
 
-  auto fileEnumerator = File::ScanDirectoryTree(subtitleDir, true);
-  RecursivelyReadTranslationJsons(fileEnumerator, SubtitleFileExtension);
+  LoadShardForAccess(lock, access);
+  if (!g_subtitlesInitialized)
+    return;
 
-  if (Translations.empty())
+  g_subtitleLookups.Add();
+  const SubtitleFileIndex::Extent* extent =
+      GetFileIndex(*access.volume, access.partition).Find(access.offset);
+  if (!extent)
     return;
 
-  // ensure stuff is sorted, you never know what mess people will make in text files :)
-  std::for_each(Translations.begin(), Translations.end(),
-                [](std::pair<const std::string, SubtitleEntryGroup>& t) { t.second.Preprocess(); });
+  SubtitleEntryGroup& group = *extent->group;
+  if (access.playback)
+  {
+    // Without the stream's rate, timestamps can only be timed by the reads
+    if (!group.hasOffsets && access.bytesPerSecond == 0)
+      return;
+    group.followsPlayback = true;
+  }
+  else if (group.followsPlayback)
+  {
+    // Reads of a streamed file run ahead of what is being played
+    return;
+  }
 
-  IniitalizeOSDMessageStacks();
+  auto relativeOffset = access.offset - extent->start;
 
-  g_subtitlesInitialized = true;
-  Info(fmt::format("Subtitles loaded for {}", gameId));
+  // The file starts streaming, its first lines are about to be shown
+  if (relativeOffset == 0)
+    PrepareLines(group, 0);
+
+  SubtitleEntry* tl;
+  if (access.playback)
+  {
+    const u64 playbackMs =
+        access.bytesPerSecond != 0 ? relativeOffset * 1000 / access.bytesPerSecond : 0;
+    tl = group.GetSubtitleAtPlayback((u32)relativeOffset, playbackMs);
+  }
+  else
+  {
+    const u64 emulatedMs = access.ticks * 1000 / SystemTimers::GetTicksPerSecond();
+    tl = group.GetSubtitle((u32)relativeOffset, emulatedMs);
+  }
+
+  if (!tl)
+    return;
+
+  PrepareLines(group, tl - group.subtitleLines.data() + 1);
+
+  g_subtitlesShown.Add();
+  // The message shares the group's text pool, so showing a line doesn't copy its text
+  OSD::AddMessage(group.GetTextPool(), group.GetText(*tl), tl->Miliseconds, tl->Color,
+                  tl->DisplayOnTop ? g_topOSDStack : g_bottomOSDStack, !tl->AllowDuplicate,
+                  tl->Scale);
 }
 
-void Reload()
+void WorkerMain()
+{
+  Common::SetCurrentThreadName("Subtitle worker");
+
+  while (true)
+  {
+    g_accessQueueExpanded.Wait();
+
+    if (g_workerExiting.IsSet())
+      return;
+
+    // Only pop once the access has been handled, so that WaitUntilIdle can rely on Empty()
+    while (!g_accessQueue.Empty() || !g_playbackQueue.Empty())
+    {
+      if (!g_accessQueue.Empty())
+      {
+        ResolveFileAccess(g_accessQueue.Front());
+        g_accessQueue.Pop();
+      }
+      if (!g_playbackQueue.Empty())
+      {
+        ResolveFileAccess(g_playbackQueue.Front());
+        g_playbackQueue.Pop();
+      }
+    }
+
+    g_accessQueueDrained.Set();
+  }
+}
+
+void StartWorker()
 {
-  LoadSubtitlesForGame(SConfig::GetInstance().GetGameID());
+  ASSERT(!g_workerThread.joinable());
+
+  g_accessQueue.Clear();
+  g_playbackQueue.Clear();
+  g_accessQueueExpanded.Reset();
+  g_accessQueueDrained.Reset();
+  g_workerExiting.Clear();
+  g_workerThread = std::thread(WorkerMain);
 }
 
-void OnFileAccess(const DiscIO::Volume& volume, const DiscIO::Partition& partition, u64 offset)
+void StopWorker()
 {
-  if (!g_subtitlesInitialized)
+  // The loader and the watcher may have been started by a title load without the worker running
+  StopLoader();
+  StopWatcher();
+
+  if (!g_workerThread.joinable())
     return;
 
-  const DiscIO::FileSystem* file_system = volume.GetFileSystem(partition);
-  if (!file_system)
+  // Pending accesses are dropped, they would only produce messages for a stopped game
+  g_workerExiting.Set();
+  g_accessQueueExpanded.Set();
+
+  g_workerThread.join();
+  g_accessQueue.Clear();
+  g_playbackQueue.Clear();
+  ClearFileIndices();
+}
+
+void WaitUntilIdle()
+{
+  if (!g_workerThread.joinable())
     return;
 
-  const std::unique_ptr<DiscIO::FileInfo> file_info = file_system->FindFileInfo(offset);
+  while (!g_accessQueue.Empty() || !g_playbackQueue.Empty())
+    g_accessQueueDrained.Wait();
 
-  if (!file_info)
+  // The volume the indices were built from may be about to go away
+  ClearFileIndices();
+}
+
+void OnFileAccess(const DiscIO::Volume& volume, const DiscIO::Partition& partition, u64 offset,
+                  u64 ticks)
+{
+  if (!g_subtitlesInitialized || !g_workerThread.joinable())
     return;
 
-  std::string path = file_info->GetPath();
+  g_accessQueue.Push(FileAccessEvent{&volume, partition, offset, ticks});
+  g_accessQueueExpanded.Set();
+}
 
-  auto relativeOffset = offset - file_info->GetOffset();
+bool IsSyncedToStream()
+{
+  return g_syncToStream && g_subtitlesInitialized && g_workerThread.joinable();
+}
 
-  if (Translations.count(path) == 0)
+void OnStreamPlayback(const DiscIO::Volume& volume, const DiscIO::Partition& partition,
+                      u64 offset, u32 bytes_per_second, u64 ticks)
+{
+  if (!IsSyncedToStream())
     return;
 
-  auto tl = Translations[path].GetSubtitle((u32)relativeOffset);
+  g_playbackQueue.Push(FileAccessEvent{&volume, partition, offset, ticks, true, bytes_per_second});
+  g_accessQueueExpanded.Set();
+}
 
-  if (!tl)
+bool SubtitleObserver::IsEnabled() const
+{
+  return g_subtitlesInitialized && g_workerThread.joinable();
+}
+
+void SubtitleObserver::OnDiscAccess(const DVD::DiscAccess& access)
+{
+  // The position of DTK audio is reported once it is played
+  if (access.audio_stream && g_syncToStream)
     return;
 
-  OSD::AddMessage(tl->Text, tl->Miliseconds, tl->Color, nullptr,
-                  tl->DisplayOnTop ? TopOSDStackName : BottomOSDStackName, !tl->AllowDuplicate,
-                  tl->Scale);
+  OnFileAccess(access.volume, access.partition, access.dvd_offset, access.ticks);
 }
 }  // namespace Subtitles
@@ -5,6 +5,7 @@
 
 #include <string>
 
+#include "Core/HW/DVD/DiscAccessObserver.h"
 #include "DiscIO/Filesystem.h"
 
 namespace Subtitles
@@ -12,6 +13,41 @@ namespace Subtitles
 const std::string SubtitleFileExtension = ".json";
 const std::string BottomOSDStackName = "subtitles-bottom";
 const std::string TopOSDStackName = "subtitles-top";
+// Starts loading the subtitles of the current title in the background. Until they are loaded,
+// disc accesses are ignored.
 void Reload();
-void OnFileAccess(const DiscIO::Volume& volume, const DiscIO::Partition& partition, u64 offset);
+
+// The worker thread does file resolution and OSD posting on behalf of the DVD thread.
+// The volume passed to OnFileAccess must stay alive until WaitUntilIdle or StopWorker returns.
+// StopWorker also joins the loader and watcher threads started by Reload, it runs when the core
+// shuts down.
+void StartWorker();
+void StopWorker();
+void WaitUntilIdle();
+
+// Called by the DVD thread before each read. This only enqueues the access; the lookup happens
+// asynchronously on the subtitle worker thread. ticks is the CoreTiming time of the read,
+// timestamped subtitles are timed in emulated time.
+void OnFileAccess(const DiscIO::Volume& volume, const DiscIO::Partition& partition, u64 offset,
+                  u64 ticks);
+
+// True while the loaded subtitles follow the playback of streamed audio, see
+// MAIN_SUBTITLES_SYNC_TO_STREAM. Read when a title's subtitles are reloaded.
+bool IsSyncedToStream();
+
+// Called by the CPU thread with the disc position that streamed audio is playing from. Once a
+// file's cues have been triggered by playback, reads of it no longer trigger them. Timestamped
+// cues need bytes_per_second to convert the position into a time, positions without it only
+// trigger offset cues.
+void OnStreamPlayback(const DiscIO::Volume& volume, const DiscIO::Partition& partition,
+                      u64 offset, u32 bytes_per_second, u64 ticks);
+
+// Feeds DVD thread reads into OnFileAccess. Subtitles keep their own file index,
+// so no FST resolution is requested.
+class SubtitleObserver final : public DVD::DiscAccessObserver
+{
+public:
+  bool IsEnabled() const override;
+  void OnDiscAccess(const DVD::DiscAccess& access) override;
+};
 }  // namespace Subtitles
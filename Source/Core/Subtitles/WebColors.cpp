@@ -0,0 +1,175 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Subtitles/WebColors.h"
+
+#include <algorithm>
+#include <array>
+
+namespace Subtitles
+{
+namespace
+{
+struct WebColor
+{
+  std::string_view name;
+  u32 argb;
+};
+
+// Sorted by name for binary searching, so that nothing has to be built at startup
+constexpr std::array WEB_COLORS{
+    WebColor{"aliceblue", 0xFFF0F8FF},
+    WebColor{"antiquewhite", 0xFFFAEBD7},
+    WebColor{"aqua", 0xFF00FFFF},
+    WebColor{"aquamarine", 0xFF7FFFD4},
+    WebColor{"azure", 0xFFF0FFFF},
+    WebColor{"beige", 0xFFF5F5DC},
+    WebColor{"bisque", 0xFFFFE4C4},
+    WebColor{"black", 0xFF000000},
+    WebColor{"blanchedalmond", 0xFFFFEBCD},
+    WebColor{"blue", 0xFF0000FF},
+    WebColor{"blueviolet", 0xFF8A2BE2},
+    WebColor{"brown", 0xFFA52A2A},
+    WebColor{"burlywood", 0xFFDEB887},
+    WebColor{"cadetblue", 0xFF5F9EA0},
+    WebColor{"chartreuse", 0xFF7FFF00},
+    WebColor{"chocolate", 0xFFD2691E},
+    WebColor{"coral", 0xFFFF7F50},
+    WebColor{"cornflowerblue", 0xFF6495ED},
+    WebColor{"cornsilk", 0xFFFFF8DC},
+    WebColor{"crimson", 0xFFDC143C},
+    WebColor{"cyan", 0xFF00FFFF},
+    WebColor{"darkblue", 0xFF00008B},
+    WebColor{"darkcyan", 0xFF008B8B},
+    WebColor{"darkgoldenrod", 0xFFB8860B},
+    WebColor{"darkgray", 0xFFA9A9A9},
+    WebColor{"darkgreen", 0xFF006400},
+    WebColor{"darkkhaki", 0xFFBDB76B},
+    WebColor{"darkmagenta", 0xFF8B008B},
+    WebColor{"darkolivegreen", 0xFF556B2F},
+    WebColor{"darkorange", 0xFFFF8C00},
+    WebColor{"darkorchid", 0xFF9932CC},
+    WebColor{"darkred", 0xFF8B0000},
+    WebColor{"darksalmon", 0xFFE9967A},
+    WebColor{"darkseagreen", 0xFF8FBC8F},
+    WebColor{"darkslateblue", 0xFF483D8B},
+    WebColor{"darkslategray", 0xFF2F4F4F},
+    WebColor{"darkturquoise", 0xFF00CED1},
+    WebColor{"darkviolet", 0xFF9400D3},
+    WebColor{"deeppink", 0xFFFF1493},
+    WebColor{"deepskyblue", 0xFF00BFFF},
+    WebColor{"dimgray", 0xFF696969},
+    WebColor{"dodgerblue", 0xFF1E90FF},
+    WebColor{"firebrick", 0xFFB22222},
+    WebColor{"floralwhite", 0xFFFFFAF0},
+    WebColor{"forestgreen", 0xFF228B22},
+    WebColor{"fuchsia", 0xFFFF00FF},
+    WebColor{"gainsboro", 0xFFDCDCDC},
+    WebColor{"ghostwhite", 0xFFF8F8FF},
+    WebColor{"gold", 0xFFFFD700},
+    WebColor{"goldenrod", 0xFFDAA520},
+    WebColor{"gray", 0xFF808080},
+    WebColor{"green", 0xFF008000},
+    WebColor{"greenyellow", 0xFFADFF2F},
+    WebColor{"honeydew", 0xFFF0FFF0},
+    WebColor{"hotpink", 0xFFFF69B4},
+    WebColor{"indianred", 0xFFCD5C5C},
+    WebColor{"indigo", 0xFF4B0082},
+    WebColor{"ivory", 0xFFFFFFF0},
+    WebColor{"khaki", 0xFFF0E68C},
+    WebColor{"lavender", 0xFFE6E6FA},
+    WebColor{"lavenderblush", 0xFFFFF0F5},
+    WebColor{"lawngreen", 0xFF7CFC00},
+    WebColor{"lemonchiffon", 0xFFFFFACD},
+    WebColor{"lightblue", 0xFFADD8E6},
+    WebColor{"lightcoral", 0xFFF08080},
+    WebColor{"lightcyan", 0xFFE0FFFF},
+    WebColor{"lightgoldenrodyellow", 0xFFFAFAD2},
+    WebColor{"lightgray", 0xFFD3D3D3},
+    WebColor{"lightgreen", 0xFF90EE90},
+    WebColor{"lightpink", 0xFFFFB6C1},
+    WebColor{"lightsalmon", 0xFFFFA07A},
+    WebColor{"lightseagreen", 0xFF20B2AA},
+    WebColor{"lightskyblue", 0xFF87CEFA},
+    WebColor{"lightslategray", 0xFF778899},
+    WebColor{"lightsteelblue", 0xFFB0C4DE},
+    WebColor{"lightyellow", 0xFFFFFFE0},
+    WebColor{"lime", 0xFF00FF00},
+    WebColor{"limegreen", 0xFF32CD32},
+    WebColor{"linen", 0xFFFAF0E6},
+    WebColor{"magenta", 0xFFFF00FF},
+    WebColor{"maroon", 0xFF800000},
+    WebColor{"mediumaquamarine", 0xFF66CDAA},
+    WebColor{"mediumblue", 0xFF0000CD},
+    WebColor{"mediumorchid", 0xFFBA55D3},
+    WebColor{"mediumpurple", 0xFF9370DB},
+    WebColor{"mediumseagreen", 0xFF3CB371},
+    WebColor{"mediumslateblue", 0xFF7B68EE},
+    WebColor{"mediumspringgreen", 0xFF00FA9A},
+    WebColor{"mediumturquoise", 0xFF48D1CC},
+    WebColor{"mediumvioletred", 0xFFC71585},
+    WebColor{"midnightblue", 0xFF191970},
+    WebColor{"mintcream", 0xFFF5FFFA},
+    WebColor{"mistyrose", 0xFFFFE4E1},
+    WebColor{"moccasin", 0xFFFFE4B5},
+    WebColor{"navajowhite", 0xFFFFDEAD},
+    WebColor{"navy", 0xFF000080},
+    WebColor{"oldlace", 0xFFFDF5E6},
+    WebColor{"olive", 0xFF808000},
+    WebColor{"olivedrab", 0xFF6B8E23},
+    WebColor{"orange", 0xFFFFA500},
+    WebColor{"orangered", 0xFFFF4500},
+    WebColor{"orchid", 0xFFDA70D6},
+    WebColor{"palegoldenrod", 0xFFEEE8AA},
+    WebColor{"palegreen", 0xFF98FB98},
+    WebColor{"paleturquoise", 0xFFAFEEEE},
+    WebColor{"palevioletred", 0xFFDB7093},
+    WebColor{"papayawhip", 0xFFFFEFD5},
+    WebColor{"peachpuff", 0xFFFFDAB9},
+    WebColor{"peru", 0xFFCD853F},
+    WebColor{"pink", 0xFFFFC0CB},
+    WebColor{"plum", 0xFFDDA0DD},
+    WebColor{"powderblue", 0xFFB0E0E6},
+    WebColor{"purple", 0xFF800080},
+    WebColor{"red", 0xFFFF0000},
+    WebColor{"rosybrown", 0xFFBC8F8F},
+    WebColor{"royalblue", 0xFF041690},
+    WebColor{"saddlebrown", 0xFF8B4513},
+    WebColor{"salmon", 0xFFFA8072},
+    WebColor{"sandybrown", 0xFFF4A460},
+    WebColor{"seagreen", 0xFF2E8B57},
+    WebColor{"seashell", 0xFFFFF5EE},
+    WebColor{"sienna", 0xFFA0522D},
+    WebColor{"silver", 0xFFC0C0C0},
+    WebColor{"skyblue", 0xFF87CEEB},
+    WebColor{"slateblue", 0xFF6A5ACD},
+    WebColor{"slategray", 0xFF708090},
+    WebColor{"snow", 0xFFFFFAFA},
+    WebColor{"springgreen", 0xFF00FF7F},
+    WebColor{"steelblue", 0xFF4682B4},
+    WebColor{"tan", 0xFFD2B48C},
+    WebColor{"teal", 0xFF008080},
+    WebColor{"thistle", 0xFFD8BFD8},
+    WebColor{"tomato", 0xFFFF6347},
+    WebColor{"turquoise", 0xFF40E0D0},
+    WebColor{"violet", 0xFFEE82EE},
+    WebColor{"wheat", 0xFFF5DEB3},
+    WebColor{"white", 0xFFFFFFFF},
+    WebColor{"whitesmoke", 0xFFF5F5F5},
+    WebColor{"yellow", 0xFFFFFF00},
+    WebColor{"yellowgreen", 0xFF9ACD32},
+};
+
+static_assert(std::ranges::is_sorted(WEB_COLORS, {}, &WebColor::name),
+              "WEB_COLORS must be sorted by name");
+}  // namespace
+
+std::optional<u32> FindWebColor(std::string_view name)
+{
+  const auto it = std::ranges::lower_bound(WEB_COLORS, name, {}, &WebColor::name);
+  if (it == WEB_COLORS.end() || it->name != name)
+    return std::nullopt;
+
+  return it->argb;
+}
+}  // namespace Subtitles
@@ -3,154 +3,13 @@
 
 #pragma once
 
-#include <map>
-#include <string>
+#include <optional>
+#include <string_view>
 
 #include "Common/CommonTypes.h"
 
 namespace Subtitles
 {
-// web colors in hex form with Alpha = 255
-std::map<std::string, u32> WebColors = {
-    {"mediumvioletred", 0xFFC71585},
-    {"deeppink", 0xFFFF1493},
-    {"palevioletred", 0xFFDB7093},
-    {"hotpink", 0xFFFF69B4},
-    {"lightpink", 0xFFFFB6C1},
-    {"pink", 0xFFFFC0CB},
-    {"darkred", 0xFF8B0000},
-    {"red", 0xFFFF0000},
-    {"firebrick", 0xFFB22222},
-    {"crimson", 0xFFDC143C},
-    {"indianred", 0xFFCD5C5C},
-    {"lightcoral", 0xFFF08080},
-    {"salmon", 0xFFFA8072},
-    {"darksalmon", 0xFFE9967A},
-    {"lightsalmon", 0xFFFFA07A},
-    {"orangered", 0xFFFF4500},
-    {"tomato", 0xFFFF6347},
-    {"darkorange", 0xFFFF8C00},
-    {"coral", 0xFFFF7F50},
-    {"orange", 0xFFFFA500},
-    {"darkkhaki", 0xFFBDB76B},
-    {"gold", 0xFFFFD700},
-    {"khaki", 0xFFF0E68C},
-    {"peachpuff", 0xFFFFDAB9},
-    {"yellow", 0xFFFFFF00},
-    {"palegoldenrod", 0xFFEEE8AA},
-    {"moccasin", 0xFFFFE4B5},
-    {"papayawhip", 0xFFFFEFD5},
-    {"lightgoldenrodyellow", 0xFFFAFAD2},
-    {"lemonchiffon", 0xFFFFFACD},
-    {"lightyellow", 0xFFFFFFE0},
-    {"maroon", 0xFF800000},
-    {"brown", 0xFFA52A2A},
-    {"saddlebrown", 0xFF8B4513},
-    {"sienna", 0xFFA0522D},
-    {"chocolate", 0xFFD2691E},
-    {"darkgoldenrod", 0xFFB8860B},
-    {"peru", 0xFFCD853F},
-    {"rosybrown", 0xFFBC8F8F},
-    {"goldenrod", 0xFFDAA520},
-    {"sandybrown", 0xFFF4A460},
-    {"tan", 0xFFD2B48C},
-    {"burlywood", 0xFFDEB887},
-    {"wheat", 0xFFF5DEB3},
-    {"navajowhite", 0xFFFFDEAD},
-    {"bisque", 0xFFFFE4C4},
-    {"blanchedalmond", 0xFFFFEBCD},
-    {"cornsilk", 0xFFFFF8DC},
-    {"indigo", 0xFF4B0082},
-    {"purple", 0xFF800080},
-    {"darkmagenta", 0xFF8B008B},
-    {"darkviolet", 0xFF9400D3},
-    {"darkslateblue", 0xFF483D8B},
-    {"blueviolet", 0xFF8A2BE2},
-    {"darkorchid", 0xFF9932CC},
-    {"fuchsia", 0xFFFF00FF},
-    {"magenta", 0xFFFF00FF},
-    {"slateblue", 0xFF6A5ACD},
-    {"mediumslateblue", 0xFF7B68EE},
-    {"mediumorchid", 0xFFBA55D3},
-    {"mediumpurple", 0xFF9370DB},
-    {"orchid", 0xFFDA70D6},
-    {"violet", 0xFFEE82EE},
-    {"plum", 0xFFDDA0DD},
-    {"thistle", 0xFFD8BFD8},
-    {"lavender", 0xFFE6E6FA},
-    {"midnightblue", 0xFF191970},
-    {"navy", 0xFF000080},
-    {"darkblue", 0xFF00008B},
-    {"mediumblue", 0xFF0000CD},
-    {"blue", 0xFF0000FF},
-    {"royalblue", 0xFF041690},
-    {"steelblue", 0xFF4682B4},
-    {"dodgerblue", 0xFF1E90FF},
-    {"deepskyblue", 0xFF00BFFF},
-    {"cornflowerblue", 0xFF6495ED},
-    {"skyblue", 0xFF87CEEB},
-    {"lightskyblue", 0xFF87CEFA},
-    {"lightsteelblue", 0xFFB0C4DE},
-    {"lightblue", 0xFFADD8E6},
-    {"powderblue", 0xFFB0E0E6},
-    {"teal", 0xFF008080},
-    {"darkcyan", 0xFF008B8B},
-    {"lightseagreen", 0xFF20B2AA},
-    {"cadetblue", 0xFF5F9EA0},
-    {"darkturquoise", 0xFF00CED1},
-    {"mediumturquoise", 0xFF48D1CC},
-    {"turquoise", 0xFF40E0D0},
-    {"aqua", 0xFF00FFFF},
-    {"cyan", 0xFF00FFFF},
-    {"aquamarine", 0xFF7FFFD4},
-    {"paleturquoise", 0xFFAFEEEE},
-    {"lightcyan", 0xFFE0FFFF},
-    {"darkgreen", 0xFF006400},
-    {"green", 0xFF008000},
-    {"darkolivegreen", 0xFF556B2F},
-    {"forestgreen", 0xFF228B22},
-    {"seagreen", 0xFF2E8B57},
-    {"olive", 0xFF808000},
-    {"olivedrab", 0xFF6B8E23},
-    {"mediumseagreen", 0xFF3CB371},
-    {"limegreen", 0xFF32CD32},
-    {"lime", 0xFF00FF00},
-    {"springgreen", 0xFF00FF7F},
-    {"mediumspringgreen", 0xFF00FA9A},
-    {"darkseagreen", 0xFF8FBC8F},
-    {"mediumaquamarine", 0xFF66CDAA},
-    {"yellowgreen", 0xFF9ACD32},
-    {"lawngreen", 0xFF7CFC00},
-    {"chartreuse", 0xFF7FFF00},
-    {"lightgreen", 0xFF90EE90},
-    {"greenyellow", 0xFFADFF2F},
-    {"palegreen", 0xFF98FB98},
-    {"mistyrose", 0xFFFFE4E1},
-    {"antiquewhite", 0xFFFAEBD7},
-    {"linen", 0xFFFAF0E6},
-    {"beige", 0xFFF5F5DC},
-    {"whitesmoke", 0xFFF5F5F5},
-    {"lavenderblush", 0xFFFFF0F5},
-    {"oldlace", 0xFFFDF5E6},
-    {"aliceblue", 0xFFF0F8FF},
-    {"seashell", 0xFFFFF5EE},
-    {"ghostwhite", 0xFFF8F8FF},
-    {"honeydew", 0xFFF0FFF0},
-    {"floralwhite", 0xFFFFFAF0},
-    {"azure", 0xFFF0FFFF},
-    {"mintcream", 0xFFF5FFFA},
-    {"snow", 0xFFFFFAFA},
-    {"ivory", 0xFFFFFFF0},
-    {"white", 0xFFFFFFFF},
-    {"black", 0xFF000000},
-    {"darkslategray", 0xFF2F4F4F},
-    {"dimgray", 0xFF696969},
-    {"slategray", 0xFF708090},
-    {"gray", 0xFF808080},
-    {"lightslategray", 0xFF778899},
-    {"darkgray", 0xFFA9A9A9},
-    {"silver", 0xFFC0C0C0},
-    {"lightgray", 0xFFD3D3D3},
-    {"gainsboro", 0xFFDCDCDC},
-};
+// Returns the color of a lowercase HTML color name in ARGB form, with an alpha of 255
+std::optional<u32> FindWebColor(std::string_view name);
 }  // namespace Subtitles
@@ -35,6 +35,10 @@
 #include "Common/StringUtil.h"
 #include "Common/Swap.h"
 
+#ifdef USE_RETRO_ACHIEVEMENTS
+#include "Core/AchievementManager.h"
+#include "Core/Config/AchievementSettings.h"
+#endif  // USE_RETRO_ACHIEVEMENTS
 #include "Core/Config/UISettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/IOS/ES/Formats.h"
@@ -125,7 +129,7 @@ GameFile::GameFile(std::string path) : m_file_path(std::move(path))
       m_long_names = volume->GetLongNames();
       m_short_makers = volume->GetShortMakers();
       m_long_makers = volume->GetLongMakers();
-      m_descriptions = volume->GetDescriptions();
+      m_display_data.Modify().descriptions = volume->GetDescriptions();
 
       m_region = volume->GetRegion();
       m_country = volume->GetCountry();
@@ -147,7 +151,9 @@ GameFile::GameFile(std::string path) : m_file_path(std::move(path))
       m_disc_number = volume->GetDiscNumber().value_or(0);
       m_apploader_date = volume->GetApploaderDate();
 
-      m_volume_banner.buffer = volume->GetBanner(&m_volume_banner.width, &m_volume_banner.height);
+      GameBanner& banner = m_display_data.Modify().volume_banner;
+      banner.buffer = volume->GetBanner(&banner.width, &banner.height);
+      m_has_volume_banner = !banner.empty();
 
       m_valid = true;
     }
@@ -209,7 +215,7 @@ bool GameFile::IsValid() const
 
 bool GameFile::CustomCoverChanged()
 {
-  if (!m_custom_cover.buffer.empty() || !UseGameCovers())
+  if (m_has_custom_cover || !UseGameCovers())
     return false;
 
   std::string path, name;
@@ -236,7 +242,7 @@ bool GameFile::CustomCoverChanged()
 
 void GameFile::DownloadDefaultCover()
 {
-  if (!m_default_cover.buffer.empty() || !UseGameCovers() || m_gametdb_id.empty())
+  if (m_has_default_cover || !UseGameCovers() || m_gametdb_id.empty())
     return;
 
   const auto cover_path = File::GetUserPath(D_COVERCACHE_IDX) + DIR_SEP;
@@ -261,7 +267,7 @@ void GameFile::DownloadDefaultCover()
 
 bool GameFile::DefaultCoverChanged()
 {
-  if (!m_default_cover.buffer.empty() || !UseGameCovers())
+  if (m_has_default_cover || !UseGameCovers())
     return false;
 
   const auto cover_path = File::GetUserPath(D_COVERCACHE_IDX) + DIR_SEP;
@@ -280,12 +286,35 @@ bool GameFile::DefaultCoverChanged()
 
 void GameFile::CustomCoverCommit()
 {
-  m_custom_cover = std::move(m_pending.custom_cover);
+  m_has_custom_cover = !m_pending.custom_cover.empty();
+  m_display_data.Modify().custom_cover = std::move(m_pending.custom_cover);
 }
 
 void GameFile::DefaultCoverCommit()
 {
-  m_default_cover = std::move(m_pending.default_cover);
+  m_has_default_cover = !m_pending.default_cover.empty();
+  m_display_data.Modify().default_cover = std::move(m_pending.default_cover);
+}
+
+bool GameFile::AchievementHashChanged()
+{
+#ifdef USE_RETRO_ACHIEVEMENTS
+  if (!m_achievement_hash.empty() || !Config::Get(Config::RA_ENABLED))
+    return false;
+
+  if (m_platform != DiscIO::Platform::GameCubeDisc && m_platform != DiscIO::Platform::WiiDisc)
+    return false;
+
+  m_pending.achievement_hash = AchievementManager::HashGame(m_file_path);
+  return !m_pending.achievement_hash.empty();
+#else
+  return false;
+#endif  // USE_RETRO_ACHIEVEMENTS
+}
+
+void GameFile::AchievementHashCommit()
+{
+  m_achievement_hash = std::move(m_pending.achievement_hash);
 }
 
 void GameBanner::DoState(PointerWrap& p)
@@ -300,7 +329,22 @@ void GameCover::DoState(PointerWrap& p)
   p.Do(buffer);
 }
 
+void GameFile::DisplayData::DoState(PointerWrap& p)
+{
+  p.Do(descriptions);
+  volume_banner.DoState(p);
+  custom_banner.DoState(p);
+  default_cover.DoState(p);
+  custom_cover.DoState(p);
+}
+
 void GameFile::DoState(PointerWrap& p)
+{
+  DoMetadataState(p);
+  DoDisplayDataState(p);
+}
+
+void GameFile::DoMetadataState(PointerWrap& p)
 {
   p.Do(m_valid);
   p.Do(m_file_path);
@@ -316,7 +360,6 @@ void GameFile::DoState(PointerWrap& p)
   p.Do(m_long_names);
   p.Do(m_short_makers);
   p.Do(m_long_makers);
-  p.Do(m_descriptions);
   p.Do(m_internal_name);
   p.Do(m_game_id);
   p.Do(m_gametdb_id);
@@ -336,10 +379,33 @@ void GameFile::DoState(PointerWrap& p)
   p.Do(m_custom_name);
   p.Do(m_custom_description);
   p.Do(m_custom_maker);
-  m_volume_banner.DoState(p);
-  m_custom_banner.DoState(p);
-  m_default_cover.DoState(p);
-  m_custom_cover.DoState(p);
+  p.Do(m_has_volume_banner);
+  p.Do(m_has_custom_banner);
+  p.Do(m_has_default_cover);
+  p.Do(m_has_custom_cover);
+  p.Do(m_achievement_hash);
+}
+
+void GameFile::DoDisplayDataState(PointerWrap& p)
+{
+  if (p.IsReadMode())
+    m_display_data.Modify().DoState(p);
+  else
+    const_cast<DisplayData&>(*m_display_data).DoState(p);
+}
+
+void GameFile::SetLazyDisplayData(std::shared_ptr<const void> owner, const u8* data, size_t size)
+{
+  m_display_data = Common::SharedLazy<DisplayData>([owner = std::move(owner), data, size] {
+    // PointerWrap takes a non-const pointer, but doesn't write through it in read mode
+    u8* ptr = const_cast<u8*>(data);
+    PointerWrap p(&ptr, size, PointerWrap::Mode::Read);
+    DisplayData display_data;
+    display_data.DoState(p);
+    if (!p.IsReadMode())
+      return DisplayData{};
+    return display_data;
+  });
 }
 
 std::string GameFile::GetExtension() const
@@ -414,7 +480,7 @@ bool GameFile::WiiBannerChanged()
   // In case the cache was created without a save file existing,
   // let's try reading the save file again, because it might exist now.
 
-  if (!m_volume_banner.empty())
+  if (m_has_volume_banner)
     return false;
   if (!DiscIO::IsWii(m_platform))
     return false;
@@ -430,7 +496,8 @@ bool GameFile::WiiBannerChanged()
 
 void GameFile::WiiBannerCommit()
 {
-  m_volume_banner = std::move(m_pending.volume_banner);
+  m_has_volume_banner = !m_pending.volume_banner.empty();
+  m_display_data.Modify().volume_banner = std::move(m_pending.volume_banner);
 }
 
 bool GameFile::ReadPNGBanner(const std::string& path)
@@ -492,12 +559,17 @@ bool GameFile::CustomBannerChanged()
     }
   }
 
-  return m_pending.custom_banner != m_custom_banner;
+  // Only decode the current banner if there are two banners to compare
+  if (m_pending.custom_banner.empty() || !m_has_custom_banner)
+    return m_pending.custom_banner.empty() == m_has_custom_banner;
+
+  return m_pending.custom_banner != m_display_data->custom_banner;
 }
 
 void GameFile::CustomBannerCommit()
 {
-  m_custom_banner = std::move(m_pending.custom_banner);
+  m_has_custom_banner = !m_pending.custom_banner.empty();
+  m_display_data.Modify().custom_banner = std::move(m_pending.custom_banner);
 }
 
 const std::string& GameFile::GetName(const Core::TitleDatabase& title_database) const
@@ -545,7 +617,7 @@ const std::string& GameFile::GetDescription(Variant variant) const
   if (variant == Variant::LongAndPossiblyCustom && !m_custom_description.empty())
     return m_custom_description;
 
-  return LookupUsingConfigLanguage(m_descriptions);
+  return LookupUsingConfigLanguage(m_display_data->descriptions);
 }
 
 std::vector<DiscIO::Language> GameFile::GetLanguages() const
@@ -796,12 +868,16 @@ bool GameFile::IsModDescriptor() const
 
 const GameBanner& GameFile::GetBannerImage() const
 {
-  return m_custom_banner.empty() ? m_volume_banner : m_custom_banner;
+  const DisplayData& display_data = *m_display_data;
+  return display_data.custom_banner.empty() ? display_data.volume_banner :
+                                              display_data.custom_banner;
 }
 
 const GameCover& GameFile::GetCoverImage() const
 {
-  return m_custom_cover.empty() ? m_default_cover : m_custom_cover;
+  const DisplayData& display_data = *m_display_data;
+  return display_data.custom_cover.empty() ? display_data.default_cover :
+                                             display_data.custom_cover;
 }
 
 }  // namespace UICommon
@@ -4,11 +4,14 @@
 #pragma once
 
 #include <array>
+#include <cstddef>
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/Lazy.h"
 #include "Core/SyncIdentifier.h"
 #include "DiscIO/Blob.h"
 #include "DiscIO/Enums.h"
@@ -70,7 +73,10 @@ public:
   const std::string& GetShortMaker() const { return LookupUsingConfigLanguage(m_short_makers); }
   const std::string& GetLongMaker(DiscIO::Language l) const { return Lookup(l, m_long_makers); }
   const std::string& GetLongMaker() const { return LookupUsingConfigLanguage(m_long_makers); }
-  const std::string& GetDescription(DiscIO::Language l) const { return Lookup(l, m_descriptions); }
+  const std::string& GetDescription(DiscIO::Language l) const
+  {
+    return Lookup(l, m_display_data->descriptions);
+  }
   const std::string& GetDescription(Variant variant) const;
   std::vector<DiscIO::Language> GetLanguages() const;
   const std::string& GetInternalName() const { return m_internal_name; }
@@ -108,9 +114,17 @@ public:
   bool IsDatelDisc() const { return m_is_datel_disc; }
   bool IsNKit() const { return m_is_nkit; }
   bool IsModDescriptor() const;
+  // The hash that RetroAchievements identifies the game by, if it has been computed
+  const std::string& GetAchievementHash() const { return m_achievement_hash; }
   const GameBanner& GetBannerImage() const;
   const GameCover& GetCoverImage() const;
   void DoState(PointerWrap& p);
+  // DoState split in two. The display data is only needed once a game is shown, so GameFileCache
+  // stores it separately and decodes it through SetLazyDisplayData when it's first accessed.
+  void DoMetadataState(PointerWrap& p);
+  void DoDisplayDataState(PointerWrap& p);
+  // data must hold the output of DoDisplayDataState and stay valid for as long as owner is alive
+  void SetLazyDisplayData(std::shared_ptr<const void> owner, const u8* data, size_t size);
   bool XMLMetadataChanged();
   void XMLMetadataCommit();
   bool WiiBannerChanged();
@@ -122,8 +136,21 @@ public:
   void DefaultCoverCommit();
   bool CustomCoverChanged();
   void CustomCoverCommit();
+  bool AchievementHashChanged();
+  void AchievementHashCommit();
 
 private:
+  // The fields that are large and not needed for sorting or filtering the game list
+  struct DisplayData
+  {
+    std::map<DiscIO::Language, std::string> descriptions;
+    GameBanner volume_banner{};
+    GameBanner custom_banner{};
+    GameCover default_cover{};
+    GameCover custom_cover{};
+    void DoState(PointerWrap& p);
+  };
+
   DiscIO::Language GetConfigLanguage() const;
   static const std::string& Lookup(DiscIO::Language language,
                                    const std::map<DiscIO::Language, std::string>& strings);
@@ -153,7 +180,6 @@ private:
   std::map<DiscIO::Language, std::string> m_long_names;
   std::map<DiscIO::Language, std::string> m_short_makers;
   std::map<DiscIO::Language, std::string> m_long_makers;
-  std::map<DiscIO::Language, std::string> m_descriptions;
   std::string m_internal_name;
   std::string m_game_id;
   std::string m_gametdb_id;
@@ -173,10 +199,14 @@ private:
   std::string m_custom_name;
   std::string m_custom_description;
   std::string m_custom_maker;
-  GameBanner m_volume_banner{};
-  GameBanner m_custom_banner{};
-  GameCover m_default_cover{};
-  GameCover m_custom_cover{};
+  // Whether each image in m_display_data is present, so that checking for updated images
+  // doesn't decode m_display_data
+  bool m_has_volume_banner{};
+  bool m_has_custom_banner{};
+  bool m_has_default_cover{};
+  bool m_has_custom_cover{};
+  std::string m_achievement_hash;
+  Common::SharedLazy<DisplayData> m_display_data;
 
   // The following data members allow GameFileCache to construct updated versions
   // of GameFiles in a threadsafe way. They should not be handled in DoState.
@@ -189,6 +219,7 @@ private:
     GameBanner custom_banner;
     GameCover default_cover;
     GameCover custom_cover;
+    std::string achievement_hash;
   } m_pending{};
 };
 
@@ -4,12 +4,16 @@
 #include "UICommon/GameFileCache.h"
 
 #include <algorithm>
+#include <condition_variable>
 #include <cstddef>
+#include <cstring>
 #include <functional>
 #include <list>
 #include <memory>
 #include <mutex>
+#include <span>
 #include <string>
+#include <thread>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -19,14 +23,79 @@
 #include "Common/FileSearch.h"
 #include "Common/FileUtil.h"
 #include "Common/IOFile.h"
+#include "Common/MappedFile.h"
 
 #include "DiscIO/DirectoryBlob.h"
 
 #include "UICommon/GameFile.h"
 
+#ifdef USE_RETRO_ACHIEVEMENTS
+#include "Core/AchievementManager.h"
+#endif  // USE_RETRO_ACHIEVEMENTS
+
 namespace UICommon
 {
-static constexpr u32 CACHE_REVISION = 24;  // Last changed in PR 11557
+static constexpr u32 CACHE_REVISION = 27;  // Last changed when achievement hashes were added
+
+// Opening a game mostly waits for storage, so more games than there are cores are opened at once,
+// but only a few, so that a network share isn't flooded with requests
+static constexpr size_t MAX_CONCURRENT_OPENS = 8;
+
+// Calls function(i) for every i below count on up to MAX_CONCURRENT_OPENS threads, which take the
+// next index as soon as they are done with one. on_done(i) is called on the calling thread in the
+// order the calls finish. No new calls are started once processing_halted is set.
+template <typename Function, typename OnDone>
+static void ProcessInParallel(size_t count, const Function& function, const OnDone& on_done,
+                              const std::atomic_bool& processing_halted)
+{
+  std::atomic<size_t> next_index = 0;
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::vector<size_t> finished;
+  size_t running_threads = std::min(count, MAX_CONCURRENT_OPENS);
+
+  const auto worker = [&] {
+    while (!processing_halted)
+    {
+      const size_t i = next_index++;
+      if (i >= count)
+        break;
+
+      function(i);
+
+      std::lock_guard lk(mutex);
+      finished.push_back(i);
+      cv.notify_one();
+    }
+
+    std::lock_guard lk(mutex);
+    --running_threads;
+    cv.notify_one();
+  };
+
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < running_threads; ++i)
+    threads.emplace_back(worker);
+
+  std::vector<size_t> batch;
+  bool done = false;
+  while (!done)
+  {
+    {
+      std::unique_lock lk(mutex);
+      cv.wait(lk, [&] { return !finished.empty() || running_threads == 0; });
+      batch.swap(finished);
+      done = running_threads == 0;
+    }
+
+    for (const size_t i : batch)
+      on_done(i);
+    batch.clear();
+  }
+
+  for (std::thread& thread : threads)
+    thread.join();
+}
 
 std::vector<std::string> FindAllGamePaths(const std::vector<std::string>& directories_to_scan,
                                           bool recursive_scan)
@@ -60,6 +129,8 @@ void GameFileCache::Clear(DeleteOnDisk delete_on_disk)
     File::Delete(m_path);
 
   m_cached_files.clear();
+  m_saved_files = 0;
+  m_needs_full_save = true;
 }
 
 std::shared_ptr<const GameFile> GameFileCache::AddOrGet(const std::string& path,
@@ -77,7 +148,13 @@ std::shared_ptr<const GameFile> GameFileCache::AddOrGet(const std::string& path,
     m_cached_files.emplace_back(std::move(game));
   }
   std::shared_ptr<GameFile>& result = found ? *it : m_cached_files.back();
-  if (UpdateAdditionalMetadata(&result) || !found)
+  if (UpdateAdditionalMetadata(&result))
+  {
+    *cache_changed = true;
+    if (found && static_cast<size_t>(it - m_cached_files.begin()) < m_saved_files)
+      m_needs_full_save = true;
+  }
+  if (!found)
     *cache_changed = true;
 
   return result;
@@ -123,6 +200,7 @@ bool GameFileCache::Update(
           game_removed_from_cache((*it)->GetFilePath());
 
         cache_changed = true;
+        m_needs_full_save = true;
         --end;
         *it = std::move(*end);
       }
@@ -132,21 +210,22 @@ bool GameFileCache::Update(
 
   // Now that the previous loop has run, game_paths only contains paths that
   // aren't in m_cached_files, so we simply add all of them to m_cached_files.
-  for (const std::string& path : game_paths)
-  {
-    if (processing_halted)
-      break;
-
-    auto file = std::make_shared<GameFile>(path);
-    if (file->IsValid())
-    {
-      if (game_added_to_cache)
-        game_added_to_cache(file);
+  const std::vector<std::string> new_paths(game_paths.begin(), game_paths.end());
+  std::vector<std::shared_ptr<GameFile>> new_files(new_paths.size());
+  ProcessInParallel(
+      new_paths.size(), [&](size_t i) { new_files[i] = std::make_shared<GameFile>(new_paths[i]); },
+      [&](size_t i) {
+        std::shared_ptr<GameFile>& file = new_files[i];
+        if (!file->IsValid())
+          return;
+
+        if (game_added_to_cache)
+          game_added_to_cache(file);
 
-      cache_changed = true;
-      m_cached_files.push_back(std::move(file));
-    }
-  }
+        cache_changed = true;
+        m_cached_files.push_back(std::move(file));
+      },
+      processing_halted);
 
   return cache_changed;
 }
@@ -157,20 +236,38 @@ bool GameFileCache::UpdateAdditionalMetadata(
 {
   bool cache_changed = false;
 
-  for (std::shared_ptr<GameFile>& file : m_cached_files)
-  {
-    if (processing_halted)
-      break;
+  // Every call only touches its own element, and m_cached_files isn't resized until all are done
+  std::vector<u8> updated(m_cached_files.size());
+  ProcessInParallel(
+      m_cached_files.size(),
+      [&](size_t i) { updated[i] = UpdateAdditionalMetadata(&m_cached_files[i]); },
+      [&](size_t i) {
+        if (!updated[i])
+          return;
 
-    const bool updated = UpdateAdditionalMetadata(&file);
-    cache_changed |= updated;
-    if (game_updated && updated)
-      game_updated(file);
-  }
+        cache_changed = true;
+        if (i < m_saved_files)
+          m_needs_full_save = true;
+        if (game_updated)
+          game_updated(m_cached_files[i]);
+      },
+      processing_halted);
 
   return cache_changed;
 }
 
+// Booting a game from the list then doesn't have to hash it for RetroAchievements
+static void AddKnownAchievementHash(const GameFile& game_file)
+{
+#ifdef USE_RETRO_ACHIEVEMENTS
+  if (!game_file.GetAchievementHash().empty())
+  {
+    AchievementManager::GetInstance()->AddKnownGameHash(game_file.GetFilePath(),
+                                                       game_file.GetAchievementHash());
+  }
+#endif  // USE_RETRO_ACHIEVEMENTS
+}
+
 bool GameFileCache::UpdateAdditionalMetadata(std::shared_ptr<GameFile>* game_file)
 {
   const bool xml_metadata_changed = (*game_file)->XMLMetadataChanged();
@@ -181,10 +278,12 @@ bool GameFileCache::UpdateAdditionalMetadata(std::shared_ptr<GameFile>* game_fil
 
   const bool default_cover_changed = (*game_file)->DefaultCoverChanged();
   const bool custom_cover_changed = (*game_file)->CustomCoverChanged();
+  const bool achievement_hash_changed = (*game_file)->AchievementHashChanged();
 
   if (!xml_metadata_changed && !wii_banner_changed && !custom_banner_changed &&
-      !default_cover_changed && !custom_cover_changed)
+      !default_cover_changed && !custom_cover_changed && !achievement_hash_changed)
   {
+    AddKnownAchievementHash(**game_file);
     return false;
   }
 
@@ -202,87 +301,148 @@ bool GameFileCache::UpdateAdditionalMetadata(std::shared_ptr<GameFile>* game_fil
     copy->DefaultCoverCommit();
   if (custom_cover_changed)
     copy->CustomCoverCommit();
+  if (achievement_hash_changed)
+    copy->AchievementHashCommit();
 
+  AddKnownAchievementHash(*copy);
   *game_file = std::move(copy);
 
   return true;
 }
 
+// The cache file is the revision followed by one record per game, each being the size of the
+// game's state and the state itself. New games are appended as further records.
 bool GameFileCache::Load()
 {
-  return SyncCacheFile(false);
-}
-
-bool GameFileCache::Save()
-{
-  return SyncCacheFile(true);
-}
+  m_needs_full_save = true;
 
-bool GameFileCache::SyncCacheFile(bool save)
-{
-  const char* open_mode = save ? "wb" : "rb";
-  File::IOFile f(m_path, open_mode);
-  if (!f)
+  // The display data of each game is decoded straight from the mapping once the game is shown,
+  // so the mapping stays alive for as long as any of those games does
+  auto mapping = std::make_shared<File::MappedFile>();
+  if (!mapping->Open(m_path))
     return false;
-  bool success = false;
-  if (save)
+
+  const std::span<const u8> data = mapping->GetSpan();
+  std::vector<std::shared_ptr<GameFile>> files;
+  u32 revision = 0;
+  bool success = data.size() >= sizeof(revision);
+  if (success)
   {
-    // Measure the size of the buffer.
-    u8* ptr = nullptr;
-    PointerWrap p_measure(&ptr, 0, PointerWrap::Mode::Measure);
-    DoState(&p_measure);
-    const size_t buffer_size = reinterpret_cast<size_t>(ptr);
-
-    // Then actually do the write.
-    std::vector<u8> buffer(buffer_size);
-    ptr = buffer.data();
-    PointerWrap p(&ptr, buffer_size, PointerWrap::Mode::Write);
-    DoState(&p, buffer_size);
-    if (f.WriteBytes(buffer.data(), buffer.size()))
-      success = true;
+    std::memcpy(&revision, data.data(), sizeof(revision));
+    success = revision == CACHE_REVISION;
   }
-  else
+
+  size_t position = sizeof(revision);
+  while (success && data.size() - position >= sizeof(u32) * 2)
   {
-    std::vector<u8> buffer(f.GetSize());
-    if (!buffer.empty() && f.ReadBytes(buffer.data(), buffer.size()))
-    {
-      u8* ptr = buffer.data();
-      PointerWrap p(&ptr, buffer.size(), PointerWrap::Mode::Read);
-      DoState(&p, buffer.size());
-      if (p.IsReadMode())
-        success = true;
-    }
+    u32 size, metadata_size;
+    std::memcpy(&size, data.data() + position, sizeof(size));
+    std::memcpy(&metadata_size, data.data() + position + sizeof(size), sizeof(metadata_size));
+    position += sizeof(size);
+
+    // A record that was cut short by an interrupted save. It's dropped by the next save.
+    if (size > data.size() - position)
+      break;
+
+    success = size >= sizeof(metadata_size) && metadata_size <= size - sizeof(metadata_size);
+    if (!success)
+      break;
+
+    const u8* const metadata = data.data() + position + sizeof(metadata_size);
+    // PointerWrap takes a non-const pointer, but doesn't write through it in read mode
+    u8* ptr = const_cast<u8*>(metadata);
+    PointerWrap p(&ptr, metadata_size, PointerWrap::Mode::Read);
+    auto file = std::make_shared<GameFile>();
+    file->DoMetadataState(p);
+    success = p.IsReadMode() && ptr == metadata + metadata_size;
+
+    file->SetLazyDisplayData(mapping, metadata + metadata_size,
+                             size - sizeof(metadata_size) - metadata_size);
+    files.push_back(std::move(file));
+    position += size;
   }
+
   if (!success)
   {
     // If some file operation failed, try to delete the probably-corrupted cache
-    f.Close();
+    files.clear();
+    mapping.reset();
     File::Delete(m_path);
+    return false;
   }
-  return success;
+
+  m_cached_files = std::move(files);
+  m_saved_files = m_cached_files.size();
+  m_needs_full_save = position != data.size();
+  return true;
+}
+
+bool GameFileCache::Save()
+{
+  if (m_needs_full_save || !File::Exists(m_path))
+    return WriteCacheFile(0);
+
+  if (m_saved_files == m_cached_files.size())
+    return true;
+
+  return WriteCacheFile(m_saved_files);
 }
 
-void GameFileCache::DoState(PointerWrap* p, u64 size)
+// Appends the record of a game to buffer
+static void WriteCacheRecord(GameFile& file, std::vector<u8>* buffer)
 {
-  struct
+  // Measure the sizes of the record's parts.
+  u8* ptr = nullptr;
+  PointerWrap p_measure(&ptr, 0, PointerWrap::Mode::Measure);
+  file.DoMetadataState(p_measure);
+  const u32 metadata_size = static_cast<u32>(reinterpret_cast<size_t>(ptr));
+  file.DoDisplayDataState(p_measure);
+  const u32 size = static_cast<u32>(reinterpret_cast<size_t>(ptr)) + sizeof(metadata_size);
+
+  // Then actually do the write.
+  const size_t position = buffer->size();
+  buffer->resize(position + sizeof(size) + size);
+  std::memcpy(buffer->data() + position, &size, sizeof(size));
+  std::memcpy(buffer->data() + position + sizeof(size), &metadata_size, sizeof(metadata_size));
+  ptr = buffer->data() + position + sizeof(size) + sizeof(metadata_size);
+  PointerWrap p(&ptr, size - sizeof(metadata_size), PointerWrap::Mode::Write);
+  file.DoMetadataState(p);
+  file.DoDisplayDataState(p);
+}
+
+bool GameFileCache::WriteCacheFile(size_t first_file)
+{
+  std::vector<u8> buffer;
+  if (first_file == 0)
   {
-    u32 revision;
-    u64 expected_size;
-  } header = {CACHE_REVISION, size};
-  p->Do(header);
-  if (p->IsReadMode())
+    buffer.resize(sizeof(CACHE_REVISION));
+    std::memcpy(buffer.data(), &CACHE_REVISION, sizeof(CACHE_REVISION));
+  }
+
+  for (size_t i = first_file; i < m_cached_files.size(); ++i)
+    WriteCacheRecord(*m_cached_files[i], &buffer);
+
+  // Appending leaves the data that is already mapped untouched. A full save can't truncate the
+  // file while games that haven't been shown yet still read from it, so it writes a new file
+  // and replaces the old one with it instead.
+  const std::string path = first_file == 0 ? m_path + ".tmp" : m_path;
+  File::IOFile f(path, first_file == 0 ? "wb" : "ab");
+  bool success = f && f.WriteBytes(buffer.data(), buffer.size());
+  f.Close();
+  if (success && first_file == 0)
+    success = File::Rename(path, m_path);
+
+  if (!success)
   {
-    if (header.revision != CACHE_REVISION || header.expected_size != size)
-    {
-      p->SetMeasureMode();
-      return;
-    }
+    // If some file operation failed, try to delete the probably-corrupted cache
+    File::Delete(path);
+    m_needs_full_save = true;
+    return false;
   }
-  p->DoEachElement(m_cached_files, [](PointerWrap& state, std::shared_ptr<GameFile>& elem) {
-    if (state.IsReadMode())
-      elem = std::make_shared<GameFile>();
-    elem->DoState(state);
-  });
+
+  m_saved_files = m_cached_files.size();
+  m_needs_full_save = false;
+  return true;
 }
 
 }  // namespace UICommon
@@ -12,8 +12,6 @@
 
 #include "Common/CommonTypes.h"
 
-class PointerWrap;
-
 namespace UICommon
 {
 class GameFile;
@@ -50,16 +48,21 @@ public:
       const std::atomic_bool& processing_halted = false);
 
   bool Load();
+  // Only appends the games added since the last Load or Save, unless games were removed or
+  // updated, in which case the whole file is rewritten.
   bool Save();
 
 private:
   bool UpdateAdditionalMetadata(std::shared_ptr<GameFile>* game_file);
 
-  bool SyncCacheFile(bool save);
-  void DoState(PointerWrap* p, u64 size = 0);
+  bool WriteCacheFile(size_t first_file);
 
   std::string m_path;
   std::vector<std::shared_ptr<GameFile>> m_cached_files;
+  // The first m_saved_files entries of m_cached_files are in the cache file as they are now,
+  // unless m_needs_full_save is set
+  size_t m_saved_files = 0;
+  bool m_needs_full_save = true;
 };
 
 }  // namespace UICommon
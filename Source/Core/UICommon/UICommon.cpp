@@ -4,6 +4,7 @@
 #include "UICommon/UICommon.h"
 
 #include <algorithm>
+#include <chrono>
 #include <clocale>
 #include <cmath>
 #include <iomanip>
@@ -21,6 +22,7 @@
 #include "Common/Common.h"
 #include "Common/CommonPaths.h"
 #include "Common/Config/Config.h"
+#include "Common/Counters.h"
 #include "Common/FileUtil.h"
 #include "Common/IniFile.h"
 #include "Common/Logging/LogManager.h"
@@ -44,6 +46,9 @@
 #include "Core/System.h"
 #include "Core/WiiRoot.h"
 
+#include "DiscIO/FileBlob.h"
+#include "DiscIO/SharedDiscCache.h"
+
 #include "InputCommon/ControllerInterface/ControllerInterface.h"
 #include "InputCommon/GCAdapter.h"
 
@@ -63,6 +68,7 @@
 namespace UICommon
 {
 static Config::ConfigChangedCallbackID s_config_changed_callback_id;
+static Common::CounterWriter s_counter_writer;
 
 static void CreateDumpPath(std::string path)
 {
@@ -121,6 +127,10 @@ static void RefreshConfig()
 {
   Common::SetEnableAlert(Config::Get(Config::MAIN_USE_PANIC_HANDLERS));
   Common::SetAbortOnPanicAlert(Config::Get(Config::MAIN_ABORT_ON_PANIC_ALERT));
+  DiscIO::SetMapPlainDiscImages(Config::Get(Config::MAIN_MAP_PLAIN_DISC_IMAGES));
+  DiscIO::SetSharedDiscCacheDirectory(Config::Get(Config::MAIN_SHARED_DISC_CACHE_PATH));
+  s_counter_writer.Start(Config::Get(Config::MAIN_METRICS_PATH),
+                         std::chrono::seconds(Config::Get(Config::MAIN_METRICS_INTERVAL)));
 }
 
 void Init()
@@ -142,6 +152,8 @@ void Init()
 void Shutdown()
 {
   Config::RemoveConfigChangedCallback(s_config_changed_callback_id);
+  s_counter_writer.Stop();
+  DiscIO::StopSharedDiscCacheWriter();
 
   GCAdapter::Shutdown();
   WiimoteReal::Shutdown();
@@ -3,9 +3,17 @@
 
 #include "UpdaterCommon/UpdaterCommon.h"
 
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <thread>
+#include <vector>
 
 #include <OptionParser.h>
 #include <ed25519.h>
@@ -15,6 +23,7 @@
 
 #include "Common/CommonFuncs.h"
 #include "Common/CommonPaths.h"
+#include "Common/Event.h"
 #include "Common/FileUtil.h"
 #include "Common/HttpRequest.h"
 #include "Common/IOFile.h"
@@ -44,26 +53,30 @@ const std::array<u8, 32> UPDATE_PUB_KEY_TEST = {
     0x0c, 0x5f, 0xdc, 0xd1, 0x15, 0x71, 0xfb, 0x86, 0x4f, 0x9e, 0x6d, 0xe6, 0x65, 0x39, 0x43, 0xe1,
     0x9e, 0xe0, 0x9b, 0x28, 0xc9, 0x1a, 0x60, 0xb7, 0x67, 0x1c, 0xf3, 0xf6, 0xca, 0x1b, 0xdd, 0x1a};
 
+// How many content files are downloaded at once. Each connection inflates and verifies its file
+// before fetching the next one, so that verifying overlaps with the other downloads.
+constexpr size_t DOWNLOAD_CONNECTIONS = 4;
+
 // Where to log updater output.
 static File::IOFile log_file;
+// Content is downloaded on several threads that all log
+static std::mutex log_mutex;
 
 void LogToFile(const char* fmt, ...)
 {
   va_list args;
   va_start(args, fmt);
 
-  log_file.WriteString(StringFromFormatV(fmt, args));
-  log_file.Flush();
+  std::string message = StringFromFormatV(fmt, args);
+  {
+    std::lock_guard lock(log_mutex);
+    log_file.WriteString(message);
+    log_file.Flush();
+  }
 
   va_end(args);
 }
 
-bool ProgressCallback(s64 total, s64 now, s64, s64)
-{
-  UI::SetCurrentProgress(static_cast<int>(now), static_cast<int>(total));
-  return true;
-}
-
 std::string HexEncode(const u8* buffer, size_t size)
 {
   std::string out(size * 2, '\0');
@@ -203,66 +216,150 @@ void TodoList::Log() const
   }
 }
 
-bool DownloadContent(const std::vector<TodoList::DownloadOp>& to_download,
-                     const std::string& content_base_url, const std::string& temp_path)
+// Places the verified contents of download in the temporary directory. Called on the download
+// threads, so this must not touch the UI.
+bool FetchContent(const TodoList::DownloadOp& download, Common::HttpRequest& req,
+                  const std::string& content_base_url, const std::string& install_base_path,
+                  const std::string& temp_path)
 {
-  Common::HttpRequest req(std::chrono::seconds(30), ProgressCallback);
+  std::string hash_filename = HexEncode(download.hash.data(), download.hash.size());
+  const std::string out = temp_path + DIR_SEP + hash_filename;
 
-  UI::SetTotalMarquee(false);
+  // File already exists, skipping
+  if (File::Exists(out))
+    return true;
 
-  for (size_t i = 0; i < to_download.size(); i++)
+  // A file that moved or that has the contents of another one doesn't need to be downloaded
+  if (download.local_source)
   {
-    UI::SetTotalProgress(static_cast<int>(i + 1), static_cast<int>(to_download.size()));
+    const std::string source = install_base_path + DIR_SEP + *download.local_source;
+    std::string contents;
+    if (File::ReadFileToString(source, contents) && ComputeHash(contents) == download.hash)
+    {
+      LogToFile("Reusing installed %s for %s.\n", download.local_source->c_str(),
+                download.filename.c_str());
+      if (!File::WriteStringToFile(out, contents))
+      {
+        LogToFile("Could not write cache file %s.\n", out.c_str());
+        return false;
+      }
+      return true;
+    }
+    LogToFile("Installed %s was modified, downloading %s.\n", download.local_source->c_str(),
+              download.filename.c_str());
+  }
 
-    auto& download = to_download[i];
+  // Add slashes where needed.
+  std::string content_store_path = hash_filename;
+  content_store_path.insert(4, "/");
+  content_store_path.insert(2, "/");
 
-    std::string hash_filename = HexEncode(download.hash.data(), download.hash.size());
+  std::string url = content_base_url + content_store_path;
+  LogToFile("Downloading %s ...\n", url.c_str());
 
-    // File already exists, skipping
-    if (File::Exists(temp_path + DIR_SEP + hash_filename))
-      continue;
+  auto resp = req.Get(url);
+  if (!resp)
+    return false;
 
-    UI::SetDescription("Downloading " + download.filename + "... (File " + std::to_string(i + 1) +
-                       " of " + std::to_string(to_download.size()) + ")");
-    UI::SetCurrentMarquee(false);
+  std::string contents(reinterpret_cast<char*>(resp->data()), resp->size());
+  std::optional<std::string> maybe_decompressed = GzipInflate(contents);
+  if (!maybe_decompressed)
+    return false;
+  const std::string decompressed = std::move(*maybe_decompressed);
 
-    // Add slashes where needed.
-    std::string content_store_path = hash_filename;
-    content_store_path.insert(4, "/");
-    content_store_path.insert(2, "/");
+  // Check that the downloaded contents have the right hash.
+  Manifest::Hash contents_hash = ComputeHash(decompressed);
+  if (contents_hash != download.hash)
+  {
+    LogToFile("Wrong hash on downloaded content %s.\n", url.c_str());
+    return false;
+  }
 
-    std::string url = content_base_url + content_store_path;
-    LogToFile("Downloading %s ...\n", url.c_str());
+  if (!File::WriteStringToFile(out, decompressed))
+  {
+    LogToFile("Could not write cache file %s.\n", out.c_str());
+    return false;
+  }
+  return true;
+}
 
-    auto resp = req.Get(url);
-    if (!resp)
-      return false;
+bool DownloadContent(const std::vector<TodoList::DownloadOp>& to_download,
+                     const std::string& content_base_url, const std::string& install_base_path,
+                     const std::string& temp_path)
+{
+  if (to_download.empty())
+    return true;
 
-    UI::SetCurrentMarquee(true);
-    UI::SetDescription("Verifying " + download.filename + "...");
+  UI::SetTotalMarquee(false);
+  UI::SetCurrentMarquee(false);
 
-    std::string contents(reinterpret_cast<char*>(resp->data()), resp->size());
-    std::optional<std::string> maybe_decompressed = GzipInflate(contents);
-    if (!maybe_decompressed)
-      return false;
-    const std::string decompressed = std::move(*maybe_decompressed);
+  std::atomic<size_t> next_download = 0;
+  std::atomic<size_t> completed = 0;
+  std::atomic<bool> failed = false;
+  Common::Event progress_changed;
+  // Bytes of the download each connection is working on, shown by this thread
+  std::array<std::atomic<s64>, DOWNLOAD_CONNECTIONS> bytes_now{};
+  std::array<std::atomic<s64>, DOWNLOAD_CONNECTIONS> bytes_total{};
+
+  const auto download_thread = [&](size_t connection) {
+    // Returning false aborts the downloads that are in flight once one of them failed
+    const auto progress = [&, connection](s64 total, s64 now, s64, s64) {
+      bytes_total[connection] = total;
+      bytes_now[connection] = now;
+      return !failed;
+    };
+    Common::HttpRequest req(std::chrono::seconds(30), progress);
+
+    while (!failed)
+    {
+      const size_t i = next_download++;
+      if (i >= to_download.size())
+        break;
+
+      if (!FetchContent(to_download[i], req, content_base_url, install_base_path, temp_path))
+        failed = true;
+
+      bytes_total[connection] = 0;
+      bytes_now[connection] = 0;
+      ++completed;
+      progress_changed.Set();
+    }
+  };
 
-    // Check that the downloaded contents have the right hash.
-    Manifest::Hash contents_hash = ComputeHash(decompressed);
-    if (contents_hash != download.hash)
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < std::min(DOWNLOAD_CONNECTIONS, to_download.size()); ++i)
+    threads.emplace_back(download_thread, i);
+
+  size_t shown = std::numeric_limits<size_t>::max();
+  while (completed < to_download.size() && !failed)
+  {
+    if (shown != completed)
     {
-      LogToFile("Wrong hash on downloaded content %s.\n", url.c_str());
-      return false;
+      shown = completed;
+      UI::SetTotalProgress(static_cast<int>(shown), static_cast<int>(to_download.size()));
+      UI::SetDescription("Downloading " + std::to_string(to_download.size()) + " files... (" +
+                         std::to_string(shown) + " of " + std::to_string(to_download.size()) +
+                         " done)");
     }
 
-    const std::string out = temp_path + DIR_SEP + hash_filename;
-    if (!File::WriteStringToFile(out, decompressed))
+    s64 now = 0;
+    s64 total = 0;
+    for (size_t i = 0; i < DOWNLOAD_CONNECTIONS; ++i)
     {
-      LogToFile("Could not write cache file %s.\n", out.c_str());
-      return false;
+      now += bytes_now[i];
+      total += bytes_total[i];
     }
+    // In KiB, so that the progress bar's int doesn't overflow
+    UI::SetCurrentProgress(static_cast<int>(now / 1024), static_cast<int>(total / 1024));
+
+    progress_changed.WaitFor(std::chrono::milliseconds(100));
   }
-  return true;
+
+  for (std::thread& thread : threads)
+    thread.join();
+
+  UI::SetTotalProgress(static_cast<int>(completed), static_cast<int>(to_download.size()));
+  return !failed;
 }
 
 bool PlatformVersionCheck(const std::vector<TodoList::UpdateOp>& to_update,
@@ -288,6 +385,11 @@ TodoList ComputeActionsToDo(Manifest this_manifest, Manifest next_manifest)
     }
   }
 
+  // Installed files by their contents, so that content that is already present isn't downloaded
+  std::map<Manifest::Hash, Manifest::Filename> installed_contents;
+  for (const auto& entry : this_manifest.entries)
+    installed_contents.emplace(entry.second, entry.first);
+
   // Download and update if present in next manifest with different hash from this manifest.
   for (const auto& entry : next_manifest.entries)
   {
@@ -303,6 +405,10 @@ TodoList ComputeActionsToDo(Manifest this_manifest, Manifest next_manifest)
       download.filename = entry.first;
       download.hash = entry.second;
 
+      const auto installed = installed_contents.find(entry.second);
+      if (installed != installed_contents.end())
+        download.local_source = installed->second;
+
       todo.to_download.push_back(std::move(download));
 
       TodoList::UpdateOp update;
@@ -482,7 +588,7 @@ bool PerformUpdate(const TodoList& todo, const std::string& install_base_path,
                    const std::string& content_base_url, const std::string& temp_path)
 {
   LogToFile("Starting download step...\n");
-  if (!DownloadContent(todo.to_download, content_base_url, temp_path))
+  if (!DownloadContent(todo.to_download, content_base_url, install_base_path, temp_path))
     return false;
   LogToFile("Download step completed.\n");
 
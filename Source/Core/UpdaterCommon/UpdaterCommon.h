@@ -28,6 +28,9 @@ struct TodoList
   {
     Manifest::Filename filename;
     Manifest::Hash hash{};
+    // Installed file that the current manifest lists with these contents, which is copied
+    // instead of downloading them if it is unmodified
+    std::optional<Manifest::Filename> local_source;
   };
   std::vector<DownloadOp> to_download;
 
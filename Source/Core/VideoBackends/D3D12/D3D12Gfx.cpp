@@ -658,18 +658,12 @@ void Gfx::UpdateDescriptorTables()
 
 bool Gfx::UpdateSRVDescriptorTable()
 {
-  static constexpr std::array<UINT, VideoCommon::MAX_PIXEL_SHADER_SAMPLERS> src_sizes = {
-      1, 1, 1, 1, 1, 1, 1, 1};
-  DescriptorHandle dst_base_handle;
-  const UINT dst_handle_sizes = VideoCommon::MAX_PIXEL_SHADER_SAMPLERS;
-  if (!g_dx_context->GetDescriptorAllocator()->Allocate(VideoCommon::MAX_PIXEL_SHADER_SAMPLERS,
-                                                        &dst_base_handle))
+  if (!g_dx_context->GetDescriptorAllocator()->GetGroupHandle(m_state.textures,
+                                                              &m_state.srv_descriptor_base))
+  {
     return false;
+  }
 
-  g_dx_context->GetDevice()->CopyDescriptors(
-      1, &dst_base_handle.cpu_handle, &dst_handle_sizes, VideoCommon::MAX_PIXEL_SHADER_SAMPLERS,
-      m_state.textures.data(), src_sizes.data(), D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-  m_state.srv_descriptor_base = dst_base_handle.gpu_handle;
   m_dirty_bits = (m_dirty_bits & ~DirtyState_Textures) | DirtyState_SRV_Descriptor;
   return true;
 }
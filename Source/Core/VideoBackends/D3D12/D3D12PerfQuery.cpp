@@ -139,6 +139,12 @@ void PerfQuery::FlushResults()
     PartialFlush(true, true);
 }
 
+void PerfQuery::PollResults()
+{
+  if (!IsFlushed())
+    PartialFlush(true, false);
+}
+
 bool PerfQuery::IsFlushed() const
 {
   return m_query_count.load(std::memory_order_relaxed) == 0;
@@ -3,53 +3,44 @@
 
 #pragma once
 
-#include <deque>
-#include <utility>
-
 #include "Common/CommonTypes.h"
 #include "VideoBackends/D3D12/Common.h"
+#include "VideoCommon/StreamRing.h"
 
 namespace DX12
 {
-class StreamBuffer
+class StreamBuffer final : public VideoCommon::StreamRing
 {
 public:
   StreamBuffer();
-  ~StreamBuffer();
+  ~StreamBuffer() override;
 
-  bool AllocateBuffer(u32 size);
+  // The buffer may grow up to max_size when it is too small for what is in flight. It is replaced
+  // when it grows, so it shouldn't be kept across allocations then.
+  bool AllocateBuffer(u32 size, u32 max_size = 0);
 
   ID3D12Resource* GetBuffer() const { return m_buffer; }
   D3D12_GPU_VIRTUAL_ADDRESS GetGPUPointer() const { return m_gpu_pointer; }
   u8* GetHostPointer() const { return m_host_pointer; }
-  u8* GetCurrentHostPointer() const { return m_host_pointer + m_current_offset; }
+  u8* GetCurrentHostPointer() const { return m_host_pointer + GetCurrentOffset(); }
   D3D12_GPU_VIRTUAL_ADDRESS GetCurrentGPUPointer() const
   {
-    return m_gpu_pointer + m_current_offset;
+    return m_gpu_pointer + GetCurrentOffset();
   }
-  u32 GetSize() const { return m_size; }
-  u32 GetCurrentOffset() const { return m_current_offset; }
-  bool ReserveMemory(u32 num_bytes, u32 alignment);
-  void CommitMemory(u32 final_num_bytes);
-
-private:
-  void UpdateCurrentFencePosition();
-  void UpdateGPUPosition();
 
-  // Waits for as many fences as needed to allocate num_bytes bytes from the buffer.
-  bool WaitForClearSpace(u32 num_bytes);
+protected:
+  u64 GetCurrentFence() const override;
+  u64 GetCompletedFence() const override;
+  void WaitForFence(u64 fence) override;
+  bool Resize(u32 new_size) override;
 
-  u32 m_size = 0;
-  u32 m_current_offset = 0;
-  u32 m_current_gpu_position = 0;
-  u32 m_last_allocation_size = 0;
+private:
+  bool CreateBuffer(u32 size);
+  void DestroyBuffer(bool defer);
 
   ID3D12Resource* m_buffer = nullptr;
   D3D12_GPU_VIRTUAL_ADDRESS m_gpu_pointer = {};
   u8* m_host_pointer = nullptr;
-
-  // List of fences and the corresponding positions in the buffer
-  std::deque<std::pair<u64, u32>> m_tracked_fences;
 };
 
 }  // namespace DX12
@@ -34,7 +34,8 @@ bool VertexManager::Initialize()
     return false;
 
   if (!m_vertex_stream_buffer.AllocateBuffer(VERTEX_STREAM_BUFFER_SIZE) ||
-      !m_index_stream_buffer.AllocateBuffer(INDEX_STREAM_BUFFER_SIZE) ||
+      !m_index_stream_buffer.AllocateBuffer(INDEX_STREAM_BUFFER_SIZE,
+                                            INDEX_STREAM_BUFFER_SIZE * StreamBuffer::MAX_GROWTH) ||
       !m_uniform_stream_buffer.AllocateBuffer(UNIFORM_STREAM_BUFFER_SIZE) ||
       !m_texel_stream_buffer.AllocateBuffer(TEXEL_STREAM_BUFFER_SIZE))
   {
@@ -428,7 +428,8 @@ bool DXContext::CreateComputeRootSignature()
 
 bool DXContext::CreateTextureUploadBuffer()
 {
-  if (!m_texture_upload_buffer.AllocateBuffer(TEXTURE_UPLOAD_BUFFER_SIZE))
+  constexpr u32 max_size = TEXTURE_UPLOAD_BUFFER_SIZE * StreamBuffer::MAX_GROWTH;
+  if (!m_texture_upload_buffer.AllocateBuffer(TEXTURE_UPLOAD_BUFFER_SIZE, max_size))
   {
     PanicAlertFmt("Failed to create texture upload buffer");
     return false;
@@ -49,6 +49,44 @@ void DescriptorAllocator::Reset()
   m_current_offset = 0;
 }
 
+TextureDescriptorAllocator::TextureDescriptorAllocator() = default;
+TextureDescriptorAllocator::~TextureDescriptorAllocator() = default;
+
+bool TextureDescriptorAllocator::GetGroupHandle(const TextureSet& textures,
+                                                D3D12_GPU_DESCRIPTOR_HANDLE* handle)
+{
+  std::array<SIZE_T, VideoCommon::MAX_PIXEL_SHADER_SAMPLERS> key;
+  for (u32 i = 0; i < VideoCommon::MAX_PIXEL_SHADER_SAMPLERS; i++)
+    key[i] = textures[i].ptr;
+
+  auto it = m_texture_map.find(key);
+  if (it != m_texture_map.end())
+  {
+    *handle = it->second;
+    return true;
+  }
+
+  DescriptorHandle allocation;
+  if (!Allocate(VideoCommon::MAX_PIXEL_SHADER_SAMPLERS, &allocation))
+    return false;
+
+  static constexpr std::array<UINT, VideoCommon::MAX_PIXEL_SHADER_SAMPLERS> source_sizes = {
+      {1, 1, 1, 1, 1, 1, 1, 1}};
+  g_dx_context->GetDevice()->CopyDescriptors(
+      1, &allocation.cpu_handle, &VideoCommon::MAX_PIXEL_SHADER_SAMPLERS,
+      VideoCommon::MAX_PIXEL_SHADER_SAMPLERS, textures.data(), source_sizes.data(),
+      D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+  *handle = allocation.gpu_handle;
+  m_texture_map.emplace(key, allocation.gpu_handle);
+  return true;
+}
+
+void TextureDescriptorAllocator::Reset()
+{
+  DescriptorAllocator::Reset();
+  m_texture_map.clear();
+}
+
 bool operator==(const SamplerStateSet& lhs, const SamplerStateSet& rhs)
 {
   // There shouldn't be any padding here, so this will be safe.
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <array>
 #include <map>
 #include "VideoBackends/D3D12/DescriptorHeapManager.h"
 #include "VideoCommon/Constants.h"
@@ -33,6 +34,26 @@ protected:
   D3D12_GPU_DESCRIPTOR_HANDLE m_heap_base_gpu = {};
 };
 
+// Also keeps the tables of pixel shader textures that were written, as the same textures tend to
+// be bound together many times in a command list. The tables are only valid until Reset(), which
+// is fine since the source descriptors are only freed once the command list has completed.
+class TextureDescriptorAllocator final : public DescriptorAllocator
+{
+public:
+  using TextureSet =
+      std::array<D3D12_CPU_DESCRIPTOR_HANDLE, VideoCommon::MAX_PIXEL_SHADER_SAMPLERS>;
+
+  TextureDescriptorAllocator();
+  ~TextureDescriptorAllocator();
+
+  bool GetGroupHandle(const TextureSet& textures, D3D12_GPU_DESCRIPTOR_HANDLE* handle);
+  void Reset();
+
+private:
+  std::map<std::array<SIZE_T, VideoCommon::MAX_PIXEL_SHADER_SAMPLERS>, D3D12_GPU_DESCRIPTOR_HANDLE>
+      m_texture_map;
+};
+
 struct SamplerStateSet final
 {
   SamplerState states[VideoCommon::MAX_PIXEL_SHADER_SAMPLERS];
@@ -6,8 +6,11 @@
 #include <map>
 #include <mutex>
 #include <optional>
+#include <string>
 
 #include "Common/Assert.h"
+#include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 
 #include "VideoBackends/Metal/MTLPipeline.h"
@@ -16,6 +19,7 @@
 
 #include "VideoCommon/AbstractPipeline.h"
 #include "VideoCommon/NativeVertexFormat.h"
+#include "VideoCommon/ShaderGenCommon.h"
 #include "VideoCommon/VertexShaderGen.h"
 #include "VideoCommon/VideoConfig.h"
 
@@ -379,6 +383,88 @@ public:
   std::map<const Shader*, std::vector<PipelineID>> m_shaders;
   std::array<u32, 3> m_pipeline_counter;
 
+  // Pipelines are looked up in the archive before they are compiled, and the ones that weren't in
+  // it are added, so they don't have to be compiled again on the next launch. With the UID cache,
+  // that covers the pipelines that are created while loading too.
+  MRCOwned<id<MTLBinaryArchive>> m_archive API_AVAILABLE(macos(11.0), ios(14.0));
+  std::string m_archive_filename;
+  std::mutex m_archive_mtx;
+  bool m_archive_changed = false;
+
+  Internal() { LoadBinaryArchive(); }
+  ~Internal() { SaveBinaryArchive(); }
+
+  void LoadBinaryArchive()
+  {
+    if (!g_ActiveConfig.bShaderCache)
+      return;
+
+    if (@available(macOS 11, iOS 14, *))
+    {
+      @autoreleasepool
+      {
+        m_archive_filename = GetDiskShaderCacheFileName(APIType::Metal, "Pipeline", false, true);
+        auto desc = MRCTransfer([MTLBinaryArchiveDescriptor new]);
+        if (File::Exists(m_archive_filename))
+        {
+          [desc setUrl:[NSURL fileURLWithPath:[NSString
+                                                  stringWithUTF8String:m_archive_filename.c_str()]]];
+        }
+        NSError* err = nullptr;
+        m_archive = MRCTransfer([g_device newBinaryArchiveWithDescriptor:desc error:&err]);
+        if (err)
+        {
+          // Archives from another OS or GPU can't be loaded, so start over with an empty one.
+          WARN_LOG_FMT(VIDEO, "Failed to load pipeline archive {}: {}", m_archive_filename,
+                       [[err localizedDescription] UTF8String]);
+          [desc setUrl:nil];
+          m_archive = MRCTransfer([g_device newBinaryArchiveWithDescriptor:desc error:nil]);
+        }
+      }
+    }
+  }
+
+  void SaveBinaryArchive()
+  {
+    if (@available(macOS 11, iOS 14, *))
+    {
+      if (!m_archive || !m_archive_changed)
+        return;
+
+      @autoreleasepool
+      {
+        // The archive may still be reading from the file, so write it next to it first.
+        const std::string temp_filename = m_archive_filename + ".tmp";
+        NSURL* url =
+            [NSURL fileURLWithPath:[NSString stringWithUTF8String:temp_filename.c_str()]];
+        NSError* err = nullptr;
+        if (![m_archive serializeToURL:url error:&err])
+        {
+          WARN_LOG_FMT(VIDEO, "Failed to save pipeline archive {}: {}", m_archive_filename,
+                       [[err localizedDescription] UTF8String]);
+          File::Delete(temp_filename);
+          return;
+        }
+        m_archive = nullptr;
+        File::Rename(temp_filename, m_archive_filename);
+      }
+    }
+  }
+
+  void AddToBinaryArchive(MTLRenderPipelineDescriptor* desc)
+  {
+    if (@available(macOS 11, iOS 14, *))
+    {
+      std::lock_guard<std::mutex> lock(m_archive_mtx);
+      NSError* err = nullptr;
+      if ([m_archive addRenderPipelineFunctionsWithDescriptor:desc error:&err])
+        m_archive_changed = true;
+      else
+        WARN_LOG_FMT(VIDEO, "Failed to add pipeline to archive: {}",
+                     [[err localizedDescription] UTF8String]);
+    }
+  }
+
   StoredPipeline CreatePipeline(const AbstractPipelineConfig& config)
   {
     @autoreleasepool
@@ -438,11 +524,29 @@ public:
         [desc setStencilAttachmentPixelFormat:Util::FromAbstract(fs.depth_texture_format)];
       NSError* err = nullptr;
       MTLRenderPipelineReflection* reflection = nullptr;
-      id<MTLRenderPipelineState> pipe =
-          [g_device newRenderPipelineStateWithDescriptor:desc
-                                                 options:MTLPipelineOptionArgumentInfo
-                                              reflection:&reflection
-                                                   error:&err];
+      id<MTLRenderPipelineState> pipe = nil;
+      bool archive_miss = false;
+      if (@available(macOS 11, iOS 14, *))
+      {
+        if (m_archive)
+        {
+          [desc setBinaryArchives:@[ m_archive.Get() ]];
+          pipe = [g_device
+              newRenderPipelineStateWithDescriptor:desc
+                                           options:MTLPipelineOptionArgumentInfo |
+                                                   MTLPipelineOptionFailOnBinaryArchiveMiss
+                                        reflection:&reflection
+                                             error:nil];
+          archive_miss = !pipe;
+        }
+      }
+      if (!pipe)
+      {
+        pipe = [g_device newRenderPipelineStateWithDescriptor:desc
+                                                      options:MTLPipelineOptionArgumentInfo
+                                                   reflection:&reflection
+                                                        error:&err];
+      }
       if (err)
       {
         PanicAlertFmt("Failed to compile pipeline for {} and {}: {}",
@@ -451,6 +555,8 @@ public:
                       [[err localizedDescription] UTF8String]);
         return std::make_pair(nullptr, PipelineReflection());
       }
+      if (archive_miss)
+        AddToBinaryArchive(desc);
 
       return std::make_pair(MRCTransfer(pipe), PipelineReflection(reflection));
     }
@@ -51,6 +51,11 @@ void PerfQuery::FlushResults()
   m_query->FlushResults();
 }
 
+void PerfQuery::PollResults()
+{
+  m_query->PollResults();
+}
+
 void PerfQuery::ResetQuery()
 {
   m_query_count.store(0, std::memory_order_relaxed);
@@ -184,6 +189,11 @@ void PerfQueryGL::FlushResults()
     FlushOne();
 }
 
+void PerfQueryGL::PollResults()
+{
+  WeakFlush();
+}
+
 PerfQueryGLESNV::PerfQueryGLESNV()
 {
   for (ActiveQuery& query : m_query_buffer)
@@ -281,4 +291,9 @@ void PerfQueryGLESNV::FlushResults()
     FlushOne();
 }
 
+void PerfQueryGLESNV::PollResults()
+{
+  WeakFlush();
+}
+
 }  // namespace OGL
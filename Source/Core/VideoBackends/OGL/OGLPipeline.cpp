@@ -77,6 +77,11 @@ AbstractPipeline::CacheData OGLPipeline::GetCacheData() const
   return data;
 }
 
+bool OGLPipeline::FinishCreation()
+{
+  return ProgramShaderCache::FinishPipelineProgram(m_program);
+}
+
 std::unique_ptr<OGLPipeline> OGLPipeline::Create(const AbstractPipelineConfig& config,
                                                  const void* cache_data, size_t cache_data_size)
 {
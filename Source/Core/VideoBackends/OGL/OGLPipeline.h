@@ -29,6 +29,7 @@ public:
   bool HasVertexInput() const { return m_vertex_format != nullptr; }
   GLenum GetGLPrimitive() const { return m_gl_primitive; }
   CacheData GetCacheData() const override;
+  bool FinishCreation() override;
   static std::unique_ptr<OGLPipeline> Create(const AbstractPipelineConfig& config,
                                              const void* cache_data, size_t cache_data_size);
 
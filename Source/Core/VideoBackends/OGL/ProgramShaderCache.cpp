@@ -13,6 +13,7 @@
 #include "Common/Align.h"
 #include "Common/Assert.h"
 #include "Common/CommonTypes.h"
+#include "Common/Counters.h"
 #include "Common/FileUtil.h"
 #include "Common/GL/GLContext.h"
 #include "Common/Logging/Log.h"
@@ -54,6 +55,38 @@ std::mutex ProgramShaderCache::s_pipeline_program_lock;
 static std::string s_glsl_header;
 static std::atomic<u64> s_shader_counter{0};
 static thread_local bool s_is_shared_context = false;
+static bool s_parallel_shader_compile = false;
+
+// How long the driver takes to link programs, from when they are handed to it until the link
+// status is known. Linking from a program binary is counted too.
+static Common::Counter s_links("dolphin_gl_program_links_total", "Programs linked");
+static Common::Counter s_link_time("dolphin_gl_program_link_microseconds_total",
+                                   "Time spent waiting for programs to link");
+static Common::Counter s_links_under_1ms("dolphin_gl_program_links_under_1ms_total",
+                                         "Programs linked in less than 1 ms");
+static Common::Counter s_links_under_10ms("dolphin_gl_program_links_under_10ms_total",
+                                          "Programs linked in 1 to 10 ms");
+static Common::Counter s_links_under_100ms("dolphin_gl_program_links_under_100ms_total",
+                                           "Programs linked in 10 to 100 ms");
+static Common::Counter s_links_over_100ms("dolphin_gl_program_links_over_100ms_total",
+                                          "Programs linked in 100 ms or more");
+
+static void RecordLinkTime(std::chrono::steady_clock::time_point start)
+{
+  const auto microseconds = std::chrono::duration_cast<std::chrono::microseconds>(
+                                std::chrono::steady_clock::now() - start)
+                                .count();
+  s_links.Add();
+  s_link_time.Add(static_cast<u64>(microseconds));
+  if (microseconds < 1000)
+    s_links_under_1ms.Add();
+  else if (microseconds < 10000)
+    s_links_under_10ms.Add();
+  else if (microseconds < 100000)
+    s_links_under_100ms.Add();
+  else
+    s_links_over_100ms.Add();
+}
 
 static std::string GetGLSLVersionString()
 {
@@ -480,6 +513,13 @@ void ProgramShaderCache::Init()
   CreateHeader();
   CreateAttributelessVAO();
 
+  // Let the driver link on as many threads as it wants to. Program binaries are then linked in the
+  // background, and their link status is only checked when they are first needed.
+  s_parallel_shader_compile = GLExtensions::Supports("GL_KHR_parallel_shader_compile") ||
+                              GLExtensions::Supports("GL_ARB_parallel_shader_compile");
+  if (s_parallel_shader_compile)
+    glMaxShaderCompilerThreads(0xFFFFFFFF);
+
   CurrentProgram = 0;
 }
 
@@ -577,6 +617,7 @@ PipelineProgram* ProgramShaderCache::GetPipelineProgram(const GLVertexFormat* ve
   std::unique_ptr<PipelineProgram> prog = std::make_unique<PipelineProgram>();
   prog->key = key;
   prog->shader.glprogid = glCreateProgram();
+  prog->link_start = std::chrono::steady_clock::now();
 
   // Use the cache data, if present. If this fails, we want to return an error, so the shader cache
   // doesn't attempt to use the same binary data in the future.
@@ -588,14 +629,24 @@ PipelineProgram* ProgramShaderCache::GetPipelineProgram(const GLVertexFormat* ve
                     static_cast<const u8*>(cache_data) + sizeof(u32),
                     static_cast<GLsizei>(cache_data_size - sizeof(u32)));
 
-    // Check the link status. If this fails, it means the binary was invalid.
-    GLint link_status;
-    glGetProgramiv(prog->shader.glprogid, GL_LINK_STATUS, &link_status);
-    if (link_status != GL_TRUE)
+    // Check the link status. If this fails, it means the binary was invalid. When the driver links
+    // in parallel, it's checked by FinishPipelineProgram() instead, so that the other programs of
+    // the cache can be handed to the driver in the meantime.
+    if (s_parallel_shader_compile && !s_is_shared_context)
     {
-      WARN_LOG_FMT(VIDEO, "Failed to create GL program from program binary.");
-      prog->shader.Destroy();
-      return nullptr;
+      prog->link_pending = true;
+    }
+    else
+    {
+      GLint link_status;
+      glGetProgramiv(prog->shader.glprogid, GL_LINK_STATUS, &link_status);
+      RecordLinkTime(prog->link_start);
+      if (link_status != GL_TRUE)
+      {
+        WARN_LOG_FMT(VIDEO, "Failed to create GL program from program binary.");
+        prog->shader.Destroy();
+        return nullptr;
+      }
     }
 
     // We don't want to retrieve this binary and duplicate entries in the cache again.
@@ -632,10 +683,13 @@ PipelineProgram* ProgramShaderCache::GetPipelineProgram(const GLVertexFormat* ve
     if (!s_is_shared_context && vao != s_last_VAO)
       glBindVertexArray(s_last_VAO);
 
-    if (!CheckProgramLinkResult(prog->shader.glprogid,
-                                vertex_shader ? vertex_shader->GetSource() : std::string_view{},
-                                geometry_shader ? geometry_shader->GetSource() : std::string_view{},
-                                pixel_shader ? pixel_shader->GetSource() : std::string_view{}))
+    const bool linked =
+        CheckProgramLinkResult(prog->shader.glprogid,
+                               vertex_shader ? vertex_shader->GetSource() : std::string_view{},
+                               geometry_shader ? geometry_shader->GetSource() : std::string_view{},
+                               pixel_shader ? pixel_shader->GetSource() : std::string_view{});
+    RecordLinkTime(prog->link_start);
+    if (!linked)
     {
       prog->shader.Destroy();
       return nullptr;
@@ -655,7 +709,8 @@ PipelineProgram* ProgramShaderCache::GetPipelineProgram(const GLVertexFormat* ve
 
   // Set program variables on the shader which will be returned.
   // This is only needed for drivers which don't support binding layout.
-  prog->shader.SetProgramVariables();
+  if (!prog->link_pending)
+    prog->shader.SetProgramVariables();
 
   // If this is a shared context, ensure we sync before we return the program to
   // the main thread. If we don't do this, some driver can lock up (e.g. AMD).
@@ -666,6 +721,26 @@ PipelineProgram* ProgramShaderCache::GetPipelineProgram(const GLVertexFormat* ve
   return ip.first->second.get();
 }
 
+bool ProgramShaderCache::FinishPipelineProgram(PipelineProgram* prog)
+{
+  if (!prog->link_pending)
+    return !prog->link_failed;
+
+  prog->link_pending = false;
+  GLint link_status;
+  glGetProgramiv(prog->shader.glprogid, GL_LINK_STATUS, &link_status);
+  RecordLinkTime(prog->link_start);
+  if (link_status != GL_TRUE)
+  {
+    WARN_LOG_FMT(VIDEO, "Failed to create GL program from program binary.");
+    prog->link_failed = true;
+    return false;
+  }
+
+  prog->shader.SetProgramVariables();
+  return true;
+}
+
 void ProgramShaderCache::ReleasePipelineProgram(PipelineProgram* prog)
 {
   if (--prog->reference_count > 0)
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
 #include <memory>
 #include <mutex>
 #include <string_view>
@@ -63,6 +64,12 @@ struct PipelineProgram
   SHADER shader;
   std::atomic_size_t reference_count{1};
   bool binary_retrieved = false;
+
+  // Set while the driver links a program binary in the background, until the link status has been
+  // checked by ProgramShaderCache::FinishPipelineProgram().
+  bool link_pending = false;
+  bool link_failed = false;
+  std::chrono::steady_clock::time_point link_start;
 };
 
 class ProgramShaderCache
@@ -104,6 +111,10 @@ public:
                                              size_t cache_data_size);
   static void ReleasePipelineProgram(PipelineProgram* prog);
 
+  // Waits for the program to be linked, if the driver is still linking it. Returns false if it
+  // failed to link.
+  static bool FinishPipelineProgram(PipelineProgram* prog);
+
 private:
   using PipelineProgramMap =
       std::unordered_map<PipelineProgramKey, std::unique_ptr<PipelineProgram>,
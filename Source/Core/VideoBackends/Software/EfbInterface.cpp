@@ -36,6 +36,20 @@ static inline u32 GetDepthOffset(u16 x, u16 y)
   return (x + y * EFB_WIDTH) * 3 + depth_buffer_start;
 }
 
+// Pixels are three bytes, and only those are accessed, so that the rasterizer threads can write
+// neighbouring pixels.
+static inline u32 ReadPixel(u32 offset)
+{
+  u32 value = 0;
+  std::memcpy(&value, &efb[offset], 3);
+  return value;
+}
+
+static inline void WritePixel(u32 offset, u32 value)
+{
+  std::memcpy(&efb[offset], &value, 3);
+}
+
 static void SetPixelAlphaOnly(u32 offset, u8 a)
 {
   switch (bpmem.zcontrol.pixel_format)
@@ -48,10 +62,9 @@ static void SetPixelAlphaOnly(u32 offset, u8 a)
   case PixelFormat::RGBA6_Z24:
   {
     u32 a32 = a;
-    u32* dst = (u32*)&efb[offset];
-    u32 val = *dst & 0xffffffc0;
+    u32 val = ReadPixel(offset) & 0x00ffffc0;
     val |= (a32 >> 2) & 0x0000003f;
-    *dst = val;
+    WritePixel(offset, val);
   }
   break;
   default:
@@ -68,31 +81,24 @@ static void SetPixelColorOnly(u32 offset, u8* rgb)
   case PixelFormat::Z24:
   {
     u32 src = *(u32*)rgb;
-    u32* dst = (u32*)&efb[offset];
-    u32 val = *dst & 0xff000000;
-    val |= src >> 8;
-    *dst = val;
+    WritePixel(offset, src >> 8);
   }
   break;
   case PixelFormat::RGBA6_Z24:
   {
     u32 src = *(u32*)rgb;
-    u32* dst = (u32*)&efb[offset];
-    u32 val = *dst & 0xff00003f;
+    u32 val = ReadPixel(offset) & 0x0000003f;
     val |= (src >> 4) & 0x00000fc0;  // blue
     val |= (src >> 6) & 0x0003f000;  // green
     val |= (src >> 8) & 0x00fc0000;  // red
-    *dst = val;
+    WritePixel(offset, val);
   }
   break;
   case PixelFormat::RGB565_Z16:
   {
     // TODO: RGB565_Z16 is not supported correctly yet
     u32 src = *(u32*)rgb;
-    u32* dst = (u32*)&efb[offset];
-    u32 val = *dst & 0xff000000;
-    val |= src >> 8;
-    *dst = val;
+    WritePixel(offset, src >> 8);
   }
   break;
   default:
@@ -109,32 +115,24 @@ static void SetPixelAlphaColor(u32 offset, u8* color)
   case PixelFormat::Z24:
   {
     u32 src = *(u32*)color;
-    u32* dst = (u32*)&efb[offset];
-    u32 val = *dst & 0xff000000;
-    val |= src >> 8;
-    *dst = val;
+    WritePixel(offset, src >> 8);
   }
   break;
   case PixelFormat::RGBA6_Z24:
   {
     u32 src = *(u32*)color;
-    u32* dst = (u32*)&efb[offset];
-    u32 val = *dst & 0xff000000;
-    val |= (src >> 2) & 0x0000003f;  // alpha
+    u32 val = (src >> 2) & 0x0000003f;  // alpha
     val |= (src >> 4) & 0x00000fc0;  // blue
     val |= (src >> 6) & 0x0003f000;  // green
     val |= (src >> 8) & 0x00fc0000;  // red
-    *dst = val;
+    WritePixel(offset, val);
   }
   break;
   case PixelFormat::RGB565_Z16:
   {
     // TODO: RGB565_Z16 is not supported correctly yet
     u32 src = *(u32*)color;
-    u32* dst = (u32*)&efb[offset];
-    u32 val = *dst & 0xff000000;
-    val |= src >> 8;
-    *dst = val;
+    WritePixel(offset, src >> 8);
   }
   break;
   default:
@@ -145,8 +143,7 @@ static void SetPixelAlphaColor(u32 offset, u8* color)
 
 static u32 GetPixelColor(u32 offset)
 {
-  u32 src;
-  std::memcpy(&src, &efb[offset], sizeof(u32));
+  const u32 src = ReadPixel(offset);
 
   switch (bpmem.zcontrol.pixel_format)
   {
@@ -178,19 +175,13 @@ static void SetPixelDepth(u32 offset, u32 depth)
   case PixelFormat::RGBA6_Z24:
   case PixelFormat::Z24:
   {
-    u32* dst = (u32*)&efb[offset];
-    u32 val = *dst & 0xff000000;
-    val |= depth & 0x00ffffff;
-    *dst = val;
+    WritePixel(offset, depth & 0x00ffffff);
   }
   break;
   case PixelFormat::RGB565_Z16:
   {
     // TODO: RGB565_Z16 is not supported correctly yet
-    u32* dst = (u32*)&efb[offset];
-    u32 val = *dst & 0xff000000;
-    val |= depth & 0x00ffffff;
-    *dst = val;
+    WritePixel(offset, depth & 0x00ffffff);
   }
   break;
   default:
@@ -209,13 +200,13 @@ static u32 GetPixelDepth(u32 offset)
   case PixelFormat::RGBA6_Z24:
   case PixelFormat::Z24:
   {
-    depth = (*(u32*)&efb[offset]) & 0x00ffffff;
+    depth = ReadPixel(offset);
   }
   break;
   case PixelFormat::RGB565_Z16:
   {
     // TODO: RGB565_Z16 is not supported correctly yet
-    depth = (*(u32*)&efb[offset]) & 0x00ffffff;
+    depth = ReadPixel(offset);
   }
   break;
   default:
@@ -704,16 +695,16 @@ void ResetPerfQuery()
   perf_values = {};
 }
 
-void IncPerfCounterQuadCount(PerfQueryType type)
+void IncPerfCounterQuadCount(PerfQueryType type, u32 pixel_count)
 {
   // NOTE: hardware doesn't process individual pixels but quads instead.
   // Current software renderer architecture works on pixels though, so
   // we have this "quad" hack here to only increment the registers on
   // every fourth rendered pixel
+  // The pixels are counted in bulk, which gives the same result as counting them one by one.
   static u32 quad[PQ_NUM_MEMBERS];
-  if (++quad[type] != 3)
-    return;
-  quad[type] = 0;
-  ++perf_values[type];
+  quad[type] += pixel_count;
+  perf_values[type] += quad[type] / 3;
+  quad[type] %= 3;
 }
 }  // namespace EfbInterface
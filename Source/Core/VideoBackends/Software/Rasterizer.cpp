@@ -4,11 +4,15 @@
 #include "VideoBackends/Software/Rasterizer.h"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cstring>
+#include <memory>
 #include <vector>
 
 #include "Common/Assert.h"
 #include "Common/CommonTypes.h"
+#include "Common/WorkerPool.h"
 
 #include "VideoBackends/Software/EfbInterface.h"
 #include "VideoBackends/Software/NativeVertexFormat.h"
@@ -96,21 +100,70 @@ struct Slope
   }
 };
 
-static Slope ZSlope;
-static Slope WSlope;
-static Slope ColorSlopes[2][4];
-static Slope TexSlopes[8][3];
+// The EFB is split into tiles that are drawn in parallel. Each tile draws the triangles that touch
+// it in the order they were submitted, and every pixel is in exactly one tile, so the result is
+// the same as drawing the triangles one after another.
+static constexpr s32 TILE_SIZE = 32;
+static_assert(TILE_SIZE % BLOCK_SIZE == 0, "Tiles must not split blocks");
+static constexpr s32 TILES_X = (static_cast<s32>(EFB_WIDTH) + TILE_SIZE - 1) / TILE_SIZE;
+static constexpr s32 TILES_Y = (static_cast<s32>(EFB_HEIGHT) + TILE_SIZE - 1) / TILE_SIZE;
+static constexpr size_t MAX_WORKERS = 7;
+
+// Everything needed to draw a triangle once it has been set up
+struct Triangle
+{
+  Slope ZSlope;
+  Slope WSlope;
+  Slope ColorSlopes[2][4];
+  Slope TexSlopes[8][3];
+
+  // Half-edge constants and deltas, in 28.4 fixed point
+  s32 C1, C2, C3;
+  s32 DX12, DX23, DX31;
+  s32 DY12, DY23, DY31;
+
+  // Bounding rectangle, limited to the scissor rectangle
+  s32 minx, maxx, miny, maxy;
+};
 
-static Tev tev;
-static RasterBlock rasterBlock;
+// The state of a thread that draws tiles
+struct Context
+{
+  Tev tev;
+  RasterBlock rasterBlock;
+};
+
+// Kept between draws for zfreeze
+static Slope ZSlope;
 
 static std::vector<BPFunctions::ScissorRect> scissors;
 
+// The triangles of the current draw, and the indices of the ones touching each tile
+static std::vector<Triangle> s_triangles;
+static std::array<std::vector<u32>, TILES_X * TILES_Y> s_tile_triangles;
+static std::vector<u32> s_used_tiles;
+static std::atomic<size_t> s_next_used_tile;
+
+// The first context belongs to the GPU thread, the others to the workers
+static std::vector<std::unique_ptr<Context>> s_contexts;
+static Common::WorkerPool s_workers{"Software rasterizer worker", MAX_WORKERS};
+
 void Init()
 {
   // The other slopes are set each for each primitive drawn, but zfreeze means that the z slope
   // needs to be set to an (untested) default value.
   ZSlope = Slope();
+
+  s_contexts.clear();
+  const size_t job_count = s_workers.GetJobCount();
+  for (size_t i = 0; i < job_count; i++)
+    s_contexts.push_back(std::make_unique<Context>());
+}
+
+void Shutdown()
+{
+  s_workers.Shutdown();
+  s_contexts.clear();
 }
 
 void ScissorChanged()
@@ -142,29 +195,32 @@ static inline int iround(float x)
 
 void SetTevKonstColors()
 {
-  tev.SetKonstColors();
+  for (const auto& context : s_contexts)
+    context->tev.SetKonstColors();
 }
 
-static void Draw(s32 x, s32 y, s32 xi, s32 yi)
+static void Draw(Context& context, const Triangle& triangle, s32 x, s32 y, s32 xi, s32 yi)
 {
-  INCSTAT(g_stats.this_frame.rasterized_pixels);
+  Tev& tev = context.tev;
+  tev.IncRasterizedPixels();
 
-  s32 z = (s32)std::clamp<float>(ZSlope.GetValue(x, y), 0.0f, 16777215.0f);
+  s32 z = (s32)std::clamp<float>(triangle.ZSlope.GetValue(x, y), 0.0f, 16777215.0f);
 
   if (bpmem.GetEmulatedZ() == EmulatedZ::Early)
   {
     // TODO: Test if perf regs are incremented even if test is disabled
-    EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_INPUT_ZCOMPLOC);
+    tev.IncPerfCounterQuadCount(PQ_ZCOMP_INPUT_ZCOMPLOC);
     if (bpmem.zmode.testenable)
     {
       // early z
       if (!EfbInterface::ZCompare(x, y, z))
         return;
     }
-    EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_OUTPUT_ZCOMPLOC);
+    tev.IncPerfCounterQuadCount(PQ_ZCOMP_OUTPUT_ZCOMPLOC);
   }
 
-  RasterBlockPixel& pixel = rasterBlock.Pixel[xi][yi];
+  const RasterBlock& rasterBlock = context.rasterBlock;
+  const RasterBlockPixel& pixel = rasterBlock.Pixel[xi][yi];
 
   tev.Position[0] = x;
   tev.Position[1] = y;
@@ -175,7 +231,7 @@ static void Draw(s32 x, s32 y, s32 xi, s32 yi)
   {
     for (int comp = 0; comp < 4; comp++)
     {
-      u16 color = (u16)ColorSlopes[i][comp].GetValue(x, y);
+      u16 color = (u16)triangle.ColorSlopes[i][comp].GetValue(x, y);
 
       // clamp color value to 0
       u16 mask = ~(color >> 8);
@@ -207,7 +263,8 @@ static void Draw(s32 x, s32 y, s32 xi, s32 yi)
   tev.Draw();
 }
 
-static inline void CalculateLOD(s32* lodp, bool* linear, u32 texmap, u32 texcoord)
+static inline void CalculateLOD(const RasterBlock& rasterBlock, s32* lodp, bool* linear,
+                                u32 texmap, u32 texcoord)
 {
   auto texUnit = bpmem.tex.GetUnit(texmap);
 
@@ -218,10 +275,9 @@ static inline void CalculateLOD(s32* lodp, bool* linear, u32 texmap, u32 texcoor
 
   float sDelta, tDelta;
 
-  float* uv00 = rasterBlock.Pixel[0][0].Uv[texcoord];
-  float* uv10 = rasterBlock.Pixel[1][0].Uv[texcoord];
-  float* uv01 = rasterBlock.Pixel[0][1].Uv[texcoord];
-
+  const float* uv00 = rasterBlock.Pixel[0][0].Uv[texcoord];
+  const float* uv10 = rasterBlock.Pixel[1][0].Uv[texcoord];
+  const float* uv01 = rasterBlock.Pixel[0][1].Uv[texcoord];
   float dudx = fabsf(uv00[0] - uv10[0]);
   float dvdx = fabsf(uv00[1] - uv10[1]);
   float dudy = fabsf(uv00[0] - uv01[0]);
@@ -258,8 +314,9 @@ static inline void CalculateLOD(s32* lodp, bool* linear, u32 texmap, u32 texcoor
   *lodp = lod;
 }
 
-static void BuildBlock(s32 blockX, s32 blockY)
+static void BuildBlock(Context& context, const Triangle& triangle, s32 blockX, s32 blockY)
 {
+  RasterBlock& rasterBlock = context.rasterBlock;
   for (s32 yi = 0; yi < BLOCK_SIZE; yi++)
   {
     for (s32 xi = 0; xi < BLOCK_SIZE; xi++)
@@ -269,19 +326,19 @@ static void BuildBlock(s32 blockX, s32 blockY)
       s32 x = xi + blockX;
       s32 y = yi + blockY;
 
-      float invW = 1.0f / WSlope.GetValue(x, y);
+      float invW = 1.0f / triangle.WSlope.GetValue(x, y);
       pixel.InvW = invW;
 
       // tex coords
       for (unsigned int i = 0; i < bpmem.genMode.numtexgens; i++)
       {
         float projection = invW;
-        float q = TexSlopes[i][2].GetValue(x, y) * invW;
+        float q = triangle.TexSlopes[i][2].GetValue(x, y) * invW;
         if (q != 0.0f)
           projection = invW / q;
 
-        pixel.Uv[i][0] = TexSlopes[i][0].GetValue(x, y) * projection;
-        pixel.Uv[i][1] = TexSlopes[i][1].GetValue(x, y) * projection;
+        pixel.Uv[i][0] = triangle.TexSlopes[i][0].GetValue(x, y) * projection;
+        pixel.Uv[i][1] = triangle.TexSlopes[i][1].GetValue(x, y) * projection;
       }
     }
   }
@@ -291,7 +348,8 @@ static void BuildBlock(s32 blockX, s32 blockY)
     u32 texmap = bpmem.tevindref.getTexMap(i);
     u32 texcoord = bpmem.tevindref.getTexCoord(i);
 
-    CalculateLOD(&rasterBlock.IndirectLod[i], &rasterBlock.IndirectLinear[i], texmap, texcoord);
+    CalculateLOD(rasterBlock, &rasterBlock.IndirectLod[i], &rasterBlock.IndirectLinear[i], texmap,
+                 texcoord);
   }
 
   for (unsigned int i = 0; i <= bpmem.genMode.numtevstages; i++)
@@ -303,7 +361,8 @@ static void BuildBlock(s32 blockX, s32 blockY)
       u32 texmap = order.getTexMap(stageOdd);
       u32 texcoord = order.getTexCoord(stageOdd);
 
-      CalculateLOD(&rasterBlock.TextureLod[i], &rasterBlock.TextureLinear[i], texmap, texcoord);
+      CalculateLOD(rasterBlock, &rasterBlock.TextureLod[i], &rasterBlock.TextureLinear[i], texmap,
+                   texcoord);
     }
   }
 }
@@ -340,24 +399,6 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
   const s32 X2 = iround(16.0f * (v1->screenPosition.x - scissor.x_off)) - 9;
   const s32 X3 = iround(16.0f * (v2->screenPosition.x - scissor.x_off)) - 9;
 
-  // Deltas
-  const s32 DX12 = X1 - X2;
-  const s32 DX23 = X2 - X3;
-  const s32 DX31 = X3 - X1;
-
-  const s32 DY12 = Y1 - Y2;
-  const s32 DY23 = Y2 - Y3;
-  const s32 DY31 = Y3 - Y1;
-
-  // Fixed-pos32 deltas
-  const s32 FDX12 = DX12 * 16;
-  const s32 FDX23 = DX23 * 16;
-  const s32 FDX31 = DX31 * 16;
-
-  const s32 FDY12 = DY12 * 16;
-  const s32 FDY23 = DY23 * 16;
-  const s32 FDY31 = DY31 * 16;
-
   // Bounding rectangle
   s32 minx = (std::min(std::min(X1, X2), X3) + 0xF) >> 4;
   s32 maxx = (std::max(std::max(X1, X2), X3) + 0xF) >> 4;
@@ -378,41 +419,106 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
   if (minx >= maxx || miny >= maxy)
     return;
 
+  Triangle& triangle = s_triangles.emplace_back();
+  triangle.ZSlope = ZSlope;
+  triangle.minx = minx;
+  triangle.maxx = maxx;
+  triangle.miny = miny;
+  triangle.maxy = maxy;
+
+  // Deltas
+  triangle.DX12 = X1 - X2;
+  triangle.DX23 = X2 - X3;
+  triangle.DX31 = X3 - X1;
+
+  triangle.DY12 = Y1 - Y2;
+  triangle.DY23 = Y2 - Y3;
+  triangle.DY31 = Y3 - Y1;
+
   // Set up the remaining slopes
   const SlopeContext ctx(v0, v1, v2, (X1 + 0xF) >> 4, (Y1 + 0xF) >> 4, scissor.x_off,
                          scissor.y_off);
 
   float w[3] = {1.0f / v0->projectedPosition.w, 1.0f / v1->projectedPosition.w,
                 1.0f / v2->projectedPosition.w};
-  WSlope = Slope(w[0], w[1], w[2], ctx);
+  triangle.WSlope = Slope(w[0], w[1], w[2], ctx);
 
   for (unsigned int i = 0; i < bpmem.genMode.numcolchans; i++)
   {
     for (int comp = 0; comp < 4; comp++)
-      ColorSlopes[i][comp] = Slope(v0->color[i][comp], v1->color[i][comp], v2->color[i][comp], ctx);
+    {
+      triangle.ColorSlopes[i][comp] =
+          Slope(v0->color[i][comp], v1->color[i][comp], v2->color[i][comp], ctx);
+    }
   }
 
   for (unsigned int i = 0; i < bpmem.genMode.numtexgens; i++)
   {
     for (int comp = 0; comp < 3; comp++)
     {
-      TexSlopes[i][comp] = Slope(v0->texCoords[i][comp] * w[0], v1->texCoords[i][comp] * w[1],
-                                 v2->texCoords[i][comp] * w[2], ctx);
+      triangle.TexSlopes[i][comp] =
+          Slope(v0->texCoords[i][comp] * w[0], v1->texCoords[i][comp] * w[1],
+                v2->texCoords[i][comp] * w[2], ctx);
     }
   }
 
   // Half-edge constants
-  s32 C1 = DY12 * X1 - DX12 * Y1;
-  s32 C2 = DY23 * X2 - DX23 * Y2;
-  s32 C3 = DY31 * X3 - DX31 * Y3;
+  triangle.C1 = triangle.DY12 * X1 - triangle.DX12 * Y1;
+  triangle.C2 = triangle.DY23 * X2 - triangle.DX23 * Y2;
+  triangle.C3 = triangle.DY31 * X3 - triangle.DX31 * Y3;
 
   // Correct for fill convention
-  if (DY12 < 0 || (DY12 == 0 && DX12 > 0))
-    C1++;
-  if (DY23 < 0 || (DY23 == 0 && DX23 > 0))
-    C2++;
-  if (DY31 < 0 || (DY31 == 0 && DX31 > 0))
-    C3++;
+  if (triangle.DY12 < 0 || (triangle.DY12 == 0 && triangle.DX12 > 0))
+    triangle.C1++;
+  if (triangle.DY23 < 0 || (triangle.DY23 == 0 && triangle.DX23 > 0))
+    triangle.C2++;
+  if (triangle.DY31 < 0 || (triangle.DY31 == 0 && triangle.DX31 > 0))
+    triangle.C3++;
+
+  // Bin the triangle into the tiles its bounding rectangle touches
+  const u32 index = static_cast<u32>(s_triangles.size() - 1);
+  for (s32 tile_y = miny / TILE_SIZE; tile_y <= (maxy - 1) / TILE_SIZE; tile_y++)
+  {
+    for (s32 tile_x = minx / TILE_SIZE; tile_x <= (maxx - 1) / TILE_SIZE; tile_x++)
+    {
+      const u32 tile = static_cast<u32>(tile_y * TILES_X + tile_x);
+      if (s_tile_triangles[tile].empty())
+        s_used_tiles.push_back(tile);
+      s_tile_triangles[tile].push_back(index);
+    }
+  }
+}
+
+// Draws the part of a triangle inside the given tile
+static void DrawTriangle(Context& context, const Triangle& triangle, s32 tile_x, s32 tile_y)
+{
+  const s32 minx = std::max(triangle.minx, tile_x * TILE_SIZE);
+  const s32 maxx = std::min(triangle.maxx, (tile_x + 1) * TILE_SIZE);
+  const s32 miny = std::max(triangle.miny, tile_y * TILE_SIZE);
+  const s32 maxy = std::min(triangle.maxy, (tile_y + 1) * TILE_SIZE);
+  if (minx >= maxx || miny >= maxy)
+    return;
+
+  const s32 C1 = triangle.C1;
+  const s32 C2 = triangle.C2;
+  const s32 C3 = triangle.C3;
+
+  const s32 DX12 = triangle.DX12;
+  const s32 DX23 = triangle.DX23;
+  const s32 DX31 = triangle.DX31;
+
+  const s32 DY12 = triangle.DY12;
+  const s32 DY23 = triangle.DY23;
+  const s32 DY31 = triangle.DY31;
+
+  // Fixed-pos32 deltas
+  const s32 FDX12 = DX12 * 16;
+  const s32 FDX23 = DX23 * 16;
+  const s32 FDX31 = DX31 * 16;
+
+  const s32 FDY12 = DY12 * 16;
+  const s32 FDY23 = DY23 * 16;
+  const s32 FDY31 = DY31 * 16;
 
   // Start in corner of 2x2 block
   s32 block_minx = minx & ~(BLOCK_SIZE - 1);
@@ -455,7 +561,7 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
       if (a == 0x0 || b == 0x0 || c == 0x0)
         continue;
 
-      BuildBlock(x, y);
+      BuildBlock(context, triangle, x, y);
 
       // Accept whole block when totally covered
       // We still need to check min/max x/y because of the scissor
@@ -465,7 +571,7 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
         {
           for (s32 ix = 0; ix < BLOCK_SIZE; ix++)
           {
-            Draw(x + ix, y + iy, ix, iy);
+            Draw(context, triangle, x + ix, y + iy, ix, iy);
           }
         }
       }
@@ -488,7 +594,7 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
               // This check enforces the scissor rectangle, since it might not be aligned with the
               // blocks
               if (x + ix >= minx && x + ix < maxx && y + iy >= miny && y + iy < maxy)
-                Draw(x + ix, y + iy, ix, iy);
+                Draw(context, triangle, x + ix, y + iy, ix, iy);
             }
 
             CX1 -= FDY12;
@@ -505,6 +611,20 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
   }
 }
 
+static void DrawTile(Context& context, u32 tile)
+{
+  const s32 tile_x = static_cast<s32>(tile) % TILES_X;
+  const s32 tile_y = static_cast<s32>(tile) / TILES_X;
+  for (const u32 index : s_tile_triangles[tile])
+    DrawTriangle(context, s_triangles[index], tile_x, tile_y);
+}
+
+static void DrawTiles(Context& context)
+{
+  for (size_t i = s_next_used_tile++; i < s_used_tiles.size(); i = s_next_used_tile++)
+    DrawTile(context, s_used_tiles[i]);
+}
+
 void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v1,
                            const OutputVertexData* v2)
 {
@@ -513,4 +633,24 @@ void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v
   for (const auto& scissor : scissors)
     DrawTriangleFrontFace(v0, v1, v2, scissor);
 }
+
+void Flush()
+{
+  if (s_triangles.empty())
+    return;
+
+  s_next_used_tile = 0;
+  if (s_used_tiles.size() < 2)
+    DrawTiles(*s_contexts[0]);
+  else
+    s_workers.Run([](size_t i) { DrawTiles(*s_contexts[i]); });
+
+  for (const auto& context : s_contexts)
+    context->tev.FlushCounters();
+
+  for (const u32 tile : s_used_tiles)
+    s_tile_triangles[tile].clear();
+  s_used_tiles.clear();
+  s_triangles.clear();
+}
 }  // namespace Rasterizer
@@ -10,12 +10,15 @@ struct OutputVertexData;
 namespace Rasterizer
 {
 void Init();
+void Shutdown();
 void ScissorChanged();
 
 void UpdateZSlope(const OutputVertexData* v0, const OutputVertexData* v1,
                   const OutputVertexData* v2, s32 x_off, s32 y_off);
 void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v1,
                            const OutputVertexData* v2);
+// Draws the triangles queued by DrawTriangleFrontFace
+void Flush();
 
 void SetTevKonstColors();
 
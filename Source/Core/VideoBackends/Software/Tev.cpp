@@ -9,6 +9,7 @@
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
+#include "Common/Intrinsics.h"
 
 #include "Core/System.h"
 
@@ -198,6 +199,103 @@ void Tev::DrawAlphaCompare(const TevStageCombiner::AlphaCombiner& ac, const Inpu
     Reg[ac.dest].a = inputs[ALP_C].d + ((a == b) ? inputs[ALP_C].c : 0);
 }
 
+#ifdef _M_X86_64
+template <typename T>
+static __m128i LoadColor(const T& color)
+{
+  return _mm_loadl_epi64(reinterpret_cast<const __m128i*>(&color));
+}
+
+// Does the same as DrawColorRegular and DrawAlphaRegular followed by the clamping, with the four
+// components in the 16-bit lanes in the order of TevColor. Lane 0 (alpha) follows the alpha
+// combiner, the others follow the color combiner.
+void Tev::DrawRegular(const TevStageCombiner::ColorCombiner& cc,
+                      const TevStageCombiner::AlphaCombiner& ac)
+{
+  const auto input = [this](TevColorArg color_arg, TevAlphaArg alpha_arg) {
+    __m128i value;
+    switch (color_arg)
+    {
+    case TevColorArg::One:
+      value = _mm_set1_epi16(V1);
+      break;
+    case TevColorArg::Half:
+      value = _mm_set1_epi16(V1_2);
+      break;
+    case TevColorArg::Konst:
+      value = LoadColor(StageKonst);
+      break;
+    case TevColorArg::Zero:
+      value = _mm_setzero_si128();
+      break;
+    default:
+    {
+      // The other arguments alternate between the color and the alpha of a register
+      const TevColor* const colors[] = {&Reg[TevOutput::Prev],   &Reg[TevOutput::Color0],
+                                        &Reg[TevOutput::Color1], &Reg[TevOutput::Color2],
+                                        &TexColor,               &RasColor};
+      value = LoadColor(*colors[u32(color_arg) >> 1]);
+      if (u32(color_arg) & 1)
+        value = _mm_shufflelo_epi16(value, 0);
+      break;
+    }
+    }
+    return _mm_insert_epi16(value, m_AlphaInputLUT[alpha_arg].a, ALP_C);
+  };
+  const auto lanes = [](int alpha, int color) {
+    return _mm_setr_epi16(alpha, color, color, color, 0, 0, 0, 0);
+  };
+  const auto lanes32 = [](s32 alpha, s32 color) {
+    return _mm_setr_epi32(alpha, color, color, color);
+  };
+  const auto rounding = [](TevScale scale, TevOp op) {
+    return (scale == TevScale::Divide2) ? 0 : (op == TevOp::Sub) ? 127 : 128;
+  };
+
+  // Like InputRegType, a to c are unsigned 8-bit values and d is a signed 11-bit value
+  const __m128i byte_mask = _mm_set1_epi16(0xff);
+  const __m128i a = _mm_and_si128(input(cc.a, ac.a), byte_mask);
+  const __m128i b = _mm_and_si128(input(cc.b, ac.b), byte_mask);
+  __m128i c = _mm_and_si128(input(cc.c, ac.c), byte_mask);
+  const __m128i d = _mm_srai_epi16(_mm_slli_epi16(input(cc.d, ac.d), 5), 5);
+
+  c = _mm_add_epi16(c, _mm_srli_epi16(c, 7));
+
+  // The left shift of the scale is applied as a multiplication
+  const __m128i scale = lanes(1 << s_ScaleLShiftLUT[ac.scale], 1 << s_ScaleLShiftLUT[cc.scale]);
+  const __m128i inverse_c = _mm_sub_epi16(_mm_set1_epi16(256), c);
+  const __m128i weights =
+      _mm_mullo_epi16(_mm_unpacklo_epi16(inverse_c, c), _mm_unpacklo_epi16(scale, scale));
+  __m128i temp = _mm_madd_epi16(_mm_unpacklo_epi16(a, b), weights);
+  temp = _mm_add_epi32(temp, lanes32(rounding(ac.scale, ac.op), rounding(cc.scale, cc.op)));
+
+  // Alpha is negated before the shift and color after it
+  const __m128i negate_alpha = lanes32(ac.op == TevOp::Sub ? -1 : 0, 0);
+  const __m128i negate_color = lanes32(0, cc.op == TevOp::Sub ? -1 : 0);
+  temp = _mm_sub_epi32(_mm_xor_si128(temp, negate_alpha), negate_alpha);
+  temp = _mm_srai_epi32(temp, 8);
+  temp = _mm_sub_epi32(_mm_xor_si128(temp, negate_color), negate_color);
+
+  const __m128i bias = lanes(s_BiasLUT[ac.bias], s_BiasLUT[cc.bias]);
+  __m128i result = _mm_add_epi16(_mm_mullo_epi16(_mm_add_epi16(d, bias), scale),
+                                 _mm_packs_epi32(temp, temp));
+
+  const __m128i halve =
+      lanes(ac.scale == TevScale::Divide2 ? -1 : 0, cc.scale == TevScale::Divide2 ? -1 : 0);
+  result = _mm_or_si128(_mm_andnot_si128(halve, result),
+                        _mm_and_si128(halve, _mm_srai_epi16(result, 1)));
+
+  const __m128i min = lanes(ac.clamp ? 0 : -1024, cc.clamp ? 0 : -1024);
+  const __m128i max = lanes(ac.clamp ? 255 : 1023, cc.clamp ? 255 : 1023);
+  result = _mm_max_epi16(_mm_min_epi16(result, max), min);
+
+  Reg[cc.dest].b = static_cast<s16>(_mm_extract_epi16(result, BLU_C));
+  Reg[cc.dest].g = static_cast<s16>(_mm_extract_epi16(result, GRN_C));
+  Reg[cc.dest].r = static_cast<s16>(_mm_extract_epi16(result, RED_C));
+  Reg[ac.dest].a = static_cast<s16>(_mm_extract_epi16(result, ALP_C));
+}
+#endif
+
 static bool AlphaCompare(int alpha, int ref, CompareMode comp)
 {
   switch (comp)
@@ -397,7 +495,7 @@ void Tev::Draw()
   ASSERT(Position[0] >= 0 && Position[0] < s32(EFB_WIDTH));
   ASSERT(Position[1] >= 0 && Position[1] < s32(EFB_HEIGHT));
 
-  INCSTAT(g_stats.this_frame.tev_pixels_in);
+  m_pixels_in++;
 
   auto& system = Core::System::GetInstance();
   auto& pixel_shader_manager = system.GetPixelShaderManager();
@@ -491,6 +589,14 @@ void Tev::Draw()
     // set color
     SetRasColor(order.getColorChan(stageOdd), ac.rswap);
 
+#ifdef _M_X86_64
+    if (cc.bias != TevBias::Compare && ac.bias != TevBias::Compare)
+    {
+      DrawRegular(cc, ac);
+      continue;
+    }
+#endif
+
     // combine inputs
     InputRegType inputs[4];
     inputs[BLU_C].a = m_ColorInputLUT[cc.a].b;
@@ -666,25 +772,63 @@ void Tev::Draw()
   if (bpmem.GetEmulatedZ() == EmulatedZ::Late)
   {
     // TODO: Check against hw if these values get incremented even if depth testing is disabled
-    EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_INPUT);
+    IncPerfCounterQuadCount(PQ_ZCOMP_INPUT);
 
     if (!EfbInterface::ZCompare(Position[0], Position[1], Position[2]))
       return;
 
-    EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_OUTPUT);
+    IncPerfCounterQuadCount(PQ_ZCOMP_OUTPUT);
   }
 
   // The GC/Wii GPU rasterizes in 2x2 pixel groups, so bounding box values will be rounded to the
   // extents of these groups, rather than the exact pixel.
-  BBoxManager::Update(static_cast<u16>(Position[0] & ~1), static_cast<u16>(Position[0] | 1),
-                      static_cast<u16>(Position[1] & ~1), static_cast<u16>(Position[1] | 1));
+  const u16 left = static_cast<u16>(Position[0] & ~1);
+  const u16 right = static_cast<u16>(Position[0] | 1);
+  const u16 top = static_cast<u16>(Position[1] & ~1);
+  const u16 bottom = static_cast<u16>(Position[1] | 1);
+  if (!m_bbox_updated)
+  {
+    m_bbox_updated = true;
+    m_bbox_left = left;
+    m_bbox_right = right;
+    m_bbox_top = top;
+    m_bbox_bottom = bottom;
+  }
+  else
+  {
+    m_bbox_left = std::min(m_bbox_left, left);
+    m_bbox_right = std::max(m_bbox_right, right);
+    m_bbox_top = std::min(m_bbox_top, top);
+    m_bbox_bottom = std::max(m_bbox_bottom, bottom);
+  }
 
-  INCSTAT(g_stats.this_frame.tev_pixels_out);
-  EfbInterface::IncPerfCounterQuadCount(PQ_BLEND_INPUT);
+  m_pixels_out++;
+  IncPerfCounterQuadCount(PQ_BLEND_INPUT);
 
   EfbInterface::BlendTev(Position[0], Position[1], output);
 }
 
+void Tev::FlushCounters()
+{
+  for (int i = 0; i < PQ_NUM_MEMBERS; i++)
+  {
+    if (m_perf_pixel_counts[i] != 0)
+      EfbInterface::IncPerfCounterQuadCount(static_cast<PerfQueryType>(i), m_perf_pixel_counts[i]);
+  }
+  m_perf_pixel_counts = {};
+
+  ADDSTAT(g_stats.this_frame.rasterized_pixels, m_rasterized_pixels);
+  ADDSTAT(g_stats.this_frame.tev_pixels_in, m_pixels_in);
+  ADDSTAT(g_stats.this_frame.tev_pixels_out, m_pixels_out);
+  m_rasterized_pixels = 0;
+  m_pixels_in = 0;
+  m_pixels_out = 0;
+
+  if (m_bbox_updated)
+    BBoxManager::Update(m_bbox_left, m_bbox_right, m_bbox_top, m_bbox_bottom);
+  m_bbox_updated = false;
+}
+
 void Tev::SetKonstColors()
 {
   auto& system = Core::System::GetInstance();
@@ -7,6 +7,7 @@
 
 #include "Common/EnumMap.h"
 #include "VideoCommon/BPMemory.h"
+#include "VideoCommon/PerfQueryBase.h"
 
 class Tev
 {
@@ -209,9 +210,23 @@ class Tev
   void DrawColorCompare(const TevStageCombiner::ColorCombiner& cc, const InputRegType inputs[4]);
   void DrawAlphaRegular(const TevStageCombiner::AlphaCombiner& ac, const InputRegType inputs[4]);
   void DrawAlphaCompare(const TevStageCombiner::AlphaCombiner& ac, const InputRegType inputs[4]);
+#ifdef _M_X86_64
+  void DrawRegular(const TevStageCombiner::ColorCombiner& cc,
+                   const TevStageCombiner::AlphaCombiner& ac);
+#endif
 
   void Indirect(unsigned int stageNum, s32 s, s32 t);
 
+  std::array<u32, PQ_NUM_MEMBERS> m_perf_pixel_counts{};
+  u32 m_rasterized_pixels = 0;
+  u32 m_pixels_in = 0;
+  u32 m_pixels_out = 0;
+  bool m_bbox_updated = false;
+  u16 m_bbox_left = 0;
+  u16 m_bbox_right = 0;
+  u16 m_bbox_top = 0;
+  u16 m_bbox_bottom = 0;
+
 public:
   s32 Position[3]{};
   u8 Color[2][4]{};  // must be RGBA for correct swap table ordering
@@ -231,4 +246,10 @@ public:
 
   void SetKonstColors();
   void Draw();
+
+  // Every rasterizer thread has its own Tev, so the counters that pixels update are kept per Tev
+  // until FlushCounters adds them to the perf queries, statistics and bounding box.
+  void IncPerfCounterQuadCount(PerfQueryType type) { m_perf_pixel_counts[type]++; }
+  void IncRasterizedPixels() { m_rasterized_pixels++; }
+  void FlushCounters();
 };
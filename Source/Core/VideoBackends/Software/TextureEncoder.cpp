@@ -3,10 +3,14 @@
 
 #include "VideoBackends/Software/TextureEncoder.h"
 
+#include <cstring>
+
 #include "Common/Align.h"
 #include "Common/Assert.h"
+#include "Common/CPUDetect.h"
 #include "Common/CommonFuncs.h"
 #include "Common/CommonTypes.h"
+#include "Common/Intrinsics.h"
 #include "Common/MsgHandler.h"
 #include "Common/Swap.h"
 
@@ -1418,14 +1422,247 @@ static void EncodeZ24halfscale(u8* dst, const u8* src, EFBCopyFormat format)
   }
 }
 
-namespace
+#ifdef _M_X86_64
+// Full scale copies of the common formats are encoded a row of a block at a time with SSSE3. Each
+// row is a run of pixels that are next to each other in the EFB, and is converted the same way as
+// the per-texel loops above convert it, so the output is identical.
+
+// Pixels are 3 bytes, these read exactly the bytes of 4 and 8 pixels
+FUNCTION_TARGET_SSSE3
+static __m128i Load4Pixels(const u8* src)
+{
+  u32 last;
+  std::memcpy(&last, src + 8, sizeof(last));
+  return _mm_unpacklo_epi64(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src)),
+                            _mm_cvtsi32_si128(static_cast<int>(last)));
+}
+
+// Zero extends each of 4 pixels to a 32-bit lane, as *(u32*)src & 0xffffff would
+FUNCTION_TARGET_SSSE3
+static __m128i Load4PixelsAsLanes(const u8* src)
+{
+  const __m128i mask = _mm_setr_epi8(0, 1, 2, -128, 3, 4, 5, -128, 6, 7, 8, -128, 9, 10, 11, -128);
+  return _mm_shuffle_epi8(Load4Pixels(src), mask);
+}
+
+// The bytes at the given offset in each of 8 pixels
+template <int OFFSET>
+FUNCTION_TARGET_SSSE3 static __m128i Gather8PixelBytes(const u8* src)
+{
+  alignas(16) s8 low_mask[16];
+  alignas(16) s8 high_mask[16];
+  for (int i = 0; i < 16; ++i)
+  {
+    const int index = i * 3 + OFFSET;
+    low_mask[i] = i < 8 && index < 16 ? static_cast<s8>(index) : -128;
+    high_mask[i] = i < 8 && index >= 16 ? static_cast<s8>(index - 16) : -128;
+  }
+
+  const __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+  const __m128i high = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + 16));
+  return _mm_or_si128(
+      _mm_shuffle_epi8(low, _mm_load_si128(reinterpret_cast<const __m128i*>(low_mask))),
+      _mm_shuffle_epi8(high, _mm_load_si128(reinterpret_cast<const __m128i*>(high_mask))));
+}
+
+// Convert6To8((lanes >> SHIFT) & 0x3f) for each 32-bit lane
+template <int SHIFT>
+FUNCTION_TARGET_SSSE3 static __m128i Extract6To8(__m128i lanes)
+{
+  const __m128i value = _mm_and_si128(_mm_srli_epi32(lanes, SHIFT), _mm_set1_epi32(0x3f));
+  return _mm_or_si128(_mm_slli_epi32(value, 2), _mm_srli_epi32(value, 4));
+}
+
+// Stores the low 16 bits of each 32-bit lane byteswapped
+FUNCTION_TARGET_SSSE3
+static void Store4BigEndian16(u8* dst, __m128i lanes)
 {
-void EncodeEfbCopy(u8* dst, const EFBCopyParams& params, u32 native_width, u32 bytes_per_row,
-                   u32 num_blocks_y, u32 memory_stride, const MathUtil::Rectangle<int>& src_rect,
-                   bool scale_by_half)
+  const __m128i mask =
+      _mm_setr_epi8(1, 0, 5, 4, 9, 8, 13, 12, -128, -128, -128, -128, -128, -128, -128, -128);
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), _mm_shuffle_epi8(lanes, mask));
+}
+
+// Rows of RGB8 and Z24 pixels, where src[0], src[1] and src[2] are the low, middle and high byte
+template <int OFFSET>
+FUNCTION_TARGET_SSSE3 static void EncodeRowByte(u8* dst, const u8* src)
+{
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), Gather8PixelBytes<OFFSET>(src));
+}
+
+template <int FIRST, int SECOND>
+FUNCTION_TARGET_SSSE3 static void EncodeRowBytePair(u8* dst, const u8* src)
+{
+  const __m128i mask = _mm_setr_epi8(FIRST, SECOND, FIRST + 3, SECOND + 3, FIRST + 6, SECOND + 6,
+                                     FIRST + 9, SECOND + 9, -128, -128, -128, -128, -128, -128,
+                                     -128, -128);
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), _mm_shuffle_epi8(Load4Pixels(src), mask));
+}
+
+FUNCTION_TARGET_SSSE3
+static void EncodeRowRGB8ToRGBA8(u8* dst, const u8* src)
+{
+  // 0xff and src[2] in the AR half of the block, src[1] and src[0] in the GB half
+  const __m128i mask = _mm_setr_epi8(-128, 2, -128, 5, -128, 8, -128, 11, 1, 0, 4, 3, 7, 6, 10, 9);
+  const __m128i alpha = _mm_setr_epi8(-1, 0, -1, 0, -1, 0, -1, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+  const __m128i texels = _mm_or_si128(_mm_shuffle_epi8(Load4Pixels(src), mask), alpha);
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), texels);
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + 32), _mm_srli_si128(texels, 8));
+}
+
+FUNCTION_TARGET_SSSE3
+static void EncodeRowRGB8ToRGB565(u8* dst, const u8* src)
+{
+  const __m128i color = Load4PixelsAsLanes(src);
+  const __m128i r = _mm_and_si128(_mm_srli_epi32(color, 8), _mm_set1_epi32(0xf800));
+  const __m128i g = _mm_and_si128(_mm_srli_epi32(color, 5), _mm_set1_epi32(0x07e0));
+  const __m128i b = _mm_and_si128(_mm_srli_epi32(color, 3), _mm_set1_epi32(0x001f));
+  Store4BigEndian16(dst, _mm_or_si128(_mm_or_si128(r, g), b));
+}
+
+// Rows of RGBA6 pixels, which hold A, B, G and R in 6 bits each from the bottom up
+FUNCTION_TARGET_SSSE3
+static void EncodeRowRGBA6ToRGBA8(u8* dst, const u8* src)
+{
+  const __m128i color = Load4PixelsAsLanes(src);
+  const __m128i lanes =
+      _mm_or_si128(_mm_or_si128(Extract6To8<0>(color), _mm_slli_epi32(Extract6To8<18>(color), 8)),
+                   _mm_or_si128(_mm_slli_epi32(Extract6To8<12>(color), 16),
+                                _mm_slli_epi32(Extract6To8<6>(color), 24)));
+  const __m128i mask = _mm_setr_epi8(0, 1, 4, 5, 8, 9, 12, 13, 2, 3, 6, 7, 10, 11, 14, 15);
+  const __m128i texels = _mm_shuffle_epi8(lanes, mask);
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), texels);
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + 32), _mm_srli_si128(texels, 8));
+}
+
+FUNCTION_TARGET_SSSE3
+static void EncodeRowRGBA6ToRGB565(u8* dst, const u8* src)
+{
+  const __m128i color = Load4PixelsAsLanes(src);
+  const __m128i r = _mm_and_si128(_mm_srli_epi32(color, 8), _mm_set1_epi32(0xf800));
+  const __m128i g = _mm_and_si128(_mm_srli_epi32(color, 7), _mm_set1_epi32(0x07e0));
+  const __m128i b = _mm_and_si128(_mm_srli_epi32(color, 7), _mm_set1_epi32(0x001f));
+  Store4BigEndian16(dst, _mm_or_si128(_mm_or_si128(r, g), b));
+}
+
+FUNCTION_TARGET_SSSE3
+static void EncodeRowRGBA6ToR8(u8* dst, const u8* src)
+{
+  const __m128i low_mask =
+      _mm_setr_epi8(0, 4, 8, 12, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128,
+                    -128);
+  const __m128i high_mask =
+      _mm_setr_epi8(-128, -128, -128, -128, 0, 4, 8, 12, -128, -128, -128, -128, -128, -128, -128,
+                    -128);
+  const __m128i low = _mm_shuffle_epi8(Extract6To8<18>(Load4PixelsAsLanes(src)), low_mask);
+  const __m128i high = _mm_shuffle_epi8(Extract6To8<18>(Load4PixelsAsLanes(src + 12)), high_mask);
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), _mm_or_si128(low, high));
+}
+
+using EncodeRowFunction = void (*)(u8* dst, const u8* src);
+
+// Walks the blocks the same way ENCODE_LOOP_BLOCKS does. ROW_BYTES is how far apart the rows of a
+// block are in dst, and BLOCK_BYTES how far apart the blocks are.
+template <int BLOCK_WIDTH_LOG2, int BLOCK_HEIGHT_LOG2, u32 ROW_BYTES, u32 BLOCK_BYTES,
+          EncodeRowFunction encode_row>
+FUNCTION_TARGET_SSSE3 static void EncodeBlocksSSSE3(u8* dst, const u8* src)
+{
+  u16 sBlkCount, tBlkCount, sBlkSize, tBlkSize;
+  SetBlockDimensions(BLOCK_WIDTH_LOG2, BLOCK_HEIGHT_LOG2, &sBlkCount, &tBlkCount, &sBlkSize,
+                     &tBlkSize);
+  const u32 write_stride = bpmem.copyMipMapStrideChannels * 32;
+
+  for (u32 tBlk = 0; tBlk < tBlkCount; tBlk++)
+  {
+    u8* block_dst = dst + tBlk * write_stride;
+    for (u32 sBlk = 0; sBlk < sBlkCount; sBlk++)
+    {
+      for (u32 t = 0; t < tBlkSize; t++)
+      {
+        const u32 y = tBlk * tBlkSize + t;
+        encode_row(block_dst + t * ROW_BYTES, src + (y * 640 + sBlk * sBlkSize) * 3);
+      }
+      block_dst += BLOCK_BYTES;
+    }
+  }
+}
+
+// Returns false if there is no SIMD encoder for the copy
+static bool EncodeFullScaleSSSE3(u8* dst, const u8* src, PixelFormat efb_format,
+                                 EFBCopyFormat format, bool yuv)
+{
+  if (!cpu_info.bSSSE3)
+    return false;
+
+  if (efb_format == PixelFormat::RGBA6_Z24 && !yuv)
+  {
+    switch (format)
+    {
+    case EFBCopyFormat::R8_0x1:
+    case EFBCopyFormat::R8:
+      EncodeBlocksSSSE3<3, 2, 8, 32, EncodeRowRGBA6ToR8>(dst, src);
+      return true;
+    case EFBCopyFormat::RGB565:
+      EncodeBlocksSSSE3<2, 2, 8, 32, EncodeRowRGBA6ToRGB565>(dst, src);
+      return true;
+    case EFBCopyFormat::RGBA8:
+      EncodeBlocksSSSE3<2, 2, 8, 64, EncodeRowRGBA6ToRGBA8>(dst, src);
+      return true;
+    default:
+      return false;
+    }
+  }
+
+  // Z24 encodes these the same way as RGB8, it never converts to YUV
+  const bool is_rgb8 =
+      (efb_format == PixelFormat::RGB8_Z24 || efb_format == PixelFormat::RGB565_Z16) && !yuv;
+  if (!is_rgb8 && efb_format != PixelFormat::Z24)
+    return false;
+
+  switch (format)
+  {
+  case EFBCopyFormat::R8_0x1:
+  case EFBCopyFormat::R8:
+    EncodeBlocksSSSE3<3, 2, 8, 32, EncodeRowByte<2>>(dst, src);
+    return true;
+  case EFBCopyFormat::G8:
+    EncodeBlocksSSSE3<3, 2, 8, 32, EncodeRowByte<1>>(dst, src);
+    return true;
+  case EFBCopyFormat::B8:
+    EncodeBlocksSSSE3<3, 2, 8, 32, EncodeRowByte<0>>(dst, src);
+    return true;
+  case EFBCopyFormat::RG8:
+    EncodeBlocksSSSE3<2, 2, 8, 32, EncodeRowBytePair<1, 2>>(dst, src);
+    return true;
+  case EFBCopyFormat::GB8:
+    EncodeBlocksSSSE3<2, 2, 8, 32, EncodeRowBytePair<0, 1>>(dst, src);
+    return true;
+  case EFBCopyFormat::RGBA8:
+    EncodeBlocksSSSE3<2, 2, 8, 64, EncodeRowRGB8ToRGBA8>(dst, src);
+    return true;
+  case EFBCopyFormat::RGB565:
+    if (!is_rgb8)
+      return false;
+    EncodeBlocksSSSE3<2, 2, 8, 32, EncodeRowRGB8ToRGB565>(dst, src);
+    return true;
+  default:
+    return false;
+  }
+}
+#endif
+
+void EncodeEfbCopy(u8* dst, const EFBCopyParams& params, const MathUtil::Rectangle<int>& src_rect,
+                   bool scale_by_half, bool use_simd)
 {
   const u8* src = EfbInterface::GetPixelPointer(src_rect.left, src_rect.top, params.depth);
 
+#ifdef _M_X86_64
+  if (use_simd && !scale_by_half &&
+      EncodeFullScaleSSSE3(dst, src, params.efb_format, params.copy_format, params.yuv))
+  {
+    return;
+  }
+#endif
+
   if (scale_by_half)
   {
     switch (params.efb_format)
@@ -1467,7 +1704,6 @@ void EncodeEfbCopy(u8* dst, const EFBCopyParams& params, u32 native_width, u32 b
     }
   }
 }
-}  // namespace
 
 void Encode(AbstractStagingTexture* dst, const EFBCopyParams& params, u32 native_width,
             u32 bytes_per_row, u32 num_blocks_y, u32 memory_stride,
@@ -1488,8 +1724,8 @@ void Encode(AbstractStagingTexture* dst, const EFBCopyParams& params, u32 native
   }
   else
   {
-    EncodeEfbCopy(reinterpret_cast<u8*>(dst->GetMappedPointer()), params, native_width,
-                  bytes_per_row, num_blocks_y, memory_stride, src_rect, scale_by_half);
+    EncodeEfbCopy(reinterpret_cast<u8*>(dst->GetMappedPointer()), params, src_rect,
+                  scale_by_half);
   }
 }
 }  // namespace TextureEncoder
@@ -13,4 +13,9 @@ void Encode(AbstractStagingTexture* dst, const EFBCopyParams& params, u32 native
             u32 bytes_per_row, u32 num_blocks_y, u32 memory_stride,
             const MathUtil::Rectangle<int>& src_rect, bool scale_by_half, float y_scale,
             float gamma);
+
+// Encodes a copy of the EFB to dst, laid out the way the copy is in emulated memory. The SIMD
+// encoders can be turned off, so tests can compare them against the per-texel loops.
+void EncodeEfbCopy(u8* dst, const EFBCopyParams& params, const MathUtil::Rectangle<int>& src_rect,
+                   bool scale_by_half, bool use_simd = true);
 }
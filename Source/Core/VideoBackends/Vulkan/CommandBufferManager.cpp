@@ -12,11 +12,14 @@
 
 #include "VideoBackends/Vulkan/VulkanContext.h"
 #include "VideoCommon/Constants.h"
+#include "VideoCommon/Statistics.h"
 
 namespace Vulkan
 {
-CommandBufferManager::CommandBufferManager(bool use_threaded_submission)
-    : m_use_threaded_submission(use_threaded_submission)
+CommandBufferManager::CommandBufferManager(bool use_threaded_submission,
+                                           u32 num_recording_threads)
+    : m_use_threaded_submission(use_threaded_submission),
+      m_num_recording_threads(num_recording_threads)
 {
 }
 
@@ -93,6 +96,17 @@ bool CommandBufferManager::CreateCommandBuffers()
       LOG_VULKAN_ERROR(res, "vkCreateSemaphore failed: ");
       return false;
     }
+
+    resources.secondary_pools.resize(m_num_recording_threads);
+    for (auto& secondary_pool : resources.secondary_pools)
+    {
+      res = vkCreateCommandPool(device, &pool_info, nullptr, &secondary_pool.command_pool);
+      if (res != VK_SUCCESS)
+      {
+        LOG_VULKAN_ERROR(res, "vkCreateCommandPool failed: ");
+        return false;
+      }
+    }
   }
 
   res = vkCreateSemaphore(device, &semaphore_create_info, nullptr, &m_present_semaphore);
@@ -120,6 +134,11 @@ void CommandBufferManager::DestroyCommandBuffers()
     // objects which are pending destruction being in-use.
     if (resources.command_pool != VK_NULL_HANDLE)
       vkDestroyCommandPool(device, resources.command_pool, nullptr);
+    for (const auto& secondary_pool : resources.secondary_pools)
+    {
+      if (secondary_pool.command_pool != VK_NULL_HANDLE)
+        vkDestroyCommandPool(device, secondary_pool.command_pool, nullptr);
+    }
 
     // Destroy any pending objects.
     for (auto& it : resources.cleanup_resources)
@@ -194,8 +213,11 @@ VkDescriptorSet CommandBufferManager::AllocateDescriptorSet(VkDescriptorSetLayou
 
     VkResult res =
         vkAllocateDescriptorSets(g_vulkan_context->GetDevice(), &allocate_info, &descriptor_set);
-    if (res != VK_SUCCESS &&
-        resources.descriptor_pools.size() > resources.current_descriptor_pool_index + 1)
+    if (res == VK_SUCCESS) [[likely]]
+    {
+      INCSTAT(g_stats.this_frame.num_descriptor_sets_allocated);
+    }
+    else if (resources.descriptor_pools.size() > resources.current_descriptor_pool_index + 1)
     {
       // Mark the next descriptor set as active and try again.
       resources.current_descriptor_pool_index++;
@@ -219,6 +241,29 @@ VkDescriptorSet CommandBufferManager::AllocateDescriptorSet(VkDescriptorSetLayou
   return descriptor_set;
 }
 
+VkCommandBuffer CommandBufferManager::AllocateSecondaryCommandBuffer(u32 recording_thread)
+{
+  // This is called on the recording threads, which only ever touch their own pool
+  auto& secondary_pool = GetCurrentCmdBufferResources().secondary_pools[recording_thread];
+  if (secondary_pool.num_used == secondary_pool.command_buffers.size())
+  {
+    const VkCommandBufferAllocateInfo buffer_info = {
+        VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO, nullptr, secondary_pool.command_pool,
+        VK_COMMAND_BUFFER_LEVEL_SECONDARY, 1};
+    VkCommandBuffer command_buffer;
+    VkResult res =
+        vkAllocateCommandBuffers(g_vulkan_context->GetDevice(), &buffer_info, &command_buffer);
+    if (res != VK_SUCCESS)
+    {
+      LOG_VULKAN_ERROR(res, "vkAllocateCommandBuffers failed: ");
+      return VK_NULL_HANDLE;
+    }
+    secondary_pool.command_buffers.push_back(command_buffer);
+  }
+
+  return secondary_pool.command_buffers[secondary_pool.num_used++];
+}
+
 bool CommandBufferManager::CreateSubmitThread()
 {
   m_submit_thread.Reset("VK submission thread", [this](PendingCommandBufferSubmit submit) {
@@ -482,6 +527,16 @@ void CommandBufferManager::BeginCommandBuffer()
   res = vkResetCommandPool(g_vulkan_context->GetDevice(), resources.command_pool, 0);
   if (res != VK_SUCCESS)
     LOG_VULKAN_ERROR(res, "vkResetCommandPool failed: ");
+  for (auto& secondary_pool : resources.secondary_pools)
+  {
+    if (secondary_pool.num_used == 0)
+      continue;
+
+    res = vkResetCommandPool(g_vulkan_context->GetDevice(), secondary_pool.command_pool, 0);
+    if (res != VK_SUCCESS)
+      LOG_VULKAN_ERROR(res, "vkResetCommandPool failed: ");
+    secondary_pool.num_used = 0;
+  }
 
   // Enable commands to be recorded to the two buffers again.
   VkCommandBufferBeginInfo begin_info = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO, nullptr,
@@ -516,6 +571,13 @@ void CommandBufferManager::DeferBufferDestruction(VkBuffer buffer, VmaAllocation
   });
 }
 
+void CommandBufferManager::DeferDescriptorPoolDestruction(VkDescriptorPool object)
+{
+  CmdBufferResources& cmd_buffer_resources = GetCurrentCmdBufferResources();
+  cmd_buffer_resources.cleanup_resources.push_back(
+      [object]() { vkDestroyDescriptorPool(g_vulkan_context->GetDevice(), object, nullptr); });
+}
+
 void CommandBufferManager::DeferFramebufferDestruction(VkFramebuffer object)
 {
   CmdBufferResources& cmd_buffer_resources = GetCurrentCmdBufferResources();
@@ -26,7 +26,7 @@ namespace Vulkan
 class CommandBufferManager
 {
 public:
-  explicit CommandBufferManager(bool use_threaded_submission);
+  CommandBufferManager(bool use_threaded_submission, u32 num_recording_threads);
   ~CommandBufferManager();
 
   bool Initialize();
@@ -47,6 +47,13 @@ public:
   // Allocates a descriptors set from the pool reserved for the current frame.
   VkDescriptorSet AllocateDescriptorSet(VkDescriptorSetLayout set_layout);
 
+  // The number of threads that record render passes into secondary command buffers, 0 if they
+  // are recorded into the current command buffer directly.
+  u32 GetNumRecordingThreads() const { return m_num_recording_threads; }
+  // Allocates a secondary command buffer that is valid until the current command buffer is
+  // submitted. Every recording thread has a pool of its own, and may only use its own index.
+  VkCommandBuffer AllocateSecondaryCommandBuffer(u32 recording_thread);
+
   // Fence "counters" are used to track which commands have been completed by the GPU.
   // If the last completed fence counter is greater or equal to N, it means that the work
   // associated counter N has been completed by the GPU. The value of N to associate with
@@ -90,6 +97,7 @@ public:
   // is next re-used, and the GPU has finished working with the specified resource.
   void DeferBufferViewDestruction(VkBufferView object);
   void DeferBufferDestruction(VkBuffer buffer, VmaAllocation alloc);
+  void DeferDescriptorPoolDestruction(VkDescriptorPool object);
   void DeferFramebufferDestruction(VkFramebuffer object);
   void DeferImageDestruction(VkImage object, VmaAllocation alloc);
   void DeferImageViewDestruction(VkImageView object);
@@ -123,6 +131,15 @@ private:
     u32 frame_index = 0;
 
     std::vector<std::function<void()>> cleanup_resources;
+
+    // One per recording thread
+    struct SecondaryCommandPool
+    {
+      VkCommandPool command_pool = VK_NULL_HANDLE;
+      std::vector<VkCommandBuffer> command_buffers;
+      size_t num_used = 0;
+    };
+    std::vector<SecondaryCommandPool> secondary_pools;
   };
 
   struct FrameResources
@@ -159,6 +176,7 @@ private:
   Common::Flag m_last_present_done;
   VkResult m_last_present_result = VK_SUCCESS;
   bool m_use_threaded_submission = false;
+  u32 m_num_recording_threads = 0;
   u32 m_descriptor_set_count = DESCRIPTOR_SETS_PER_POOL;
 };
 
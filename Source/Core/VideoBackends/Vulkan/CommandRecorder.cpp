@@ -0,0 +1,296 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoBackends/Vulkan/CommandRecorder.h"
+
+#include <cstring>
+
+#include <fmt/format.h>
+
+#include "Common/Assert.h"
+
+#include "VideoBackends/Vulkan/CommandBufferManager.h"
+#include "VideoBackends/Vulkan/VulkanContext.h"
+
+namespace Vulkan
+{
+bool CommandRecorder::DrawState::operator==(const DrawState& other) const
+{
+  return pipeline == other.pipeline && pipeline_layout == other.pipeline_layout &&
+         descriptor_sets == other.descriptor_sets &&
+         num_descriptor_sets == other.num_descriptor_sets &&
+         dynamic_offsets == other.dynamic_offsets &&
+         num_dynamic_offsets == other.num_dynamic_offsets && vertex_buffer == other.vertex_buffer &&
+         vertex_buffer_offset == other.vertex_buffer_offset &&
+         index_buffer == other.index_buffer && index_buffer_offset == other.index_buffer_offset &&
+         index_type == other.index_type &&
+         std::memcmp(&viewport, &other.viewport, sizeof(viewport)) == 0 &&
+         std::memcmp(&scissor, &other.scissor, sizeof(scissor)) == 0;
+}
+
+CommandRecorder::CommandRecorder(u32 num_workers)
+{
+  for (u32 i = 0; i < num_workers; ++i)
+  {
+    m_workers.push_back(std::make_unique<Common::WorkQueueThread<Range*>>(
+        fmt::format("VK recording thread {}", i),
+        [i](Range* range) { RecordRange(i, range); }));
+  }
+}
+
+CommandRecorder::~CommandRecorder() = default;
+
+void CommandRecorder::BeginRenderPass(VkRenderPass render_pass, VkFramebuffer framebuffer)
+{
+  ASSERT(m_num_ranges == 0);
+  m_render_pass = render_pass;
+  m_framebuffer = framebuffer;
+  m_has_state = false;
+  m_open_queries = 0;
+}
+
+void CommandRecorder::EndRenderPass(VkCommandBuffer command_buffer)
+{
+  if (!m_current_range_dispatched)
+  {
+    // A render pass that fits in one range is recorded right here, rather than waiting for a
+    // worker. As nothing else was dispatched, the first worker is idle and its pool can be used.
+    if (m_num_ranges == 1)
+      RecordRange(0, m_ranges[0].get());
+    else
+      DispatchRange();
+    m_current_range_dispatched = true;
+  }
+
+  for (auto& worker : m_workers)
+    worker->WaitForCompletion();
+
+  std::vector<VkCommandBuffer> command_buffers;
+  command_buffers.reserve(m_num_ranges);
+  for (size_t i = 0; i < m_num_ranges; ++i)
+  {
+    if (m_ranges[i]->command_buffer != VK_NULL_HANDLE)
+      command_buffers.push_back(m_ranges[i]->command_buffer);
+  }
+  if (!command_buffers.empty())
+  {
+    vkCmdExecuteCommands(command_buffer, static_cast<u32>(command_buffers.size()),
+                         command_buffers.data());
+  }
+
+  m_num_ranges = 0;
+  m_render_pass = VK_NULL_HANDLE;
+  m_framebuffer = VK_NULL_HANDLE;
+}
+
+void CommandRecorder::SetState(const DrawState& state)
+{
+  if (m_has_state && state == m_state)
+    return;
+
+  m_state = state;
+  m_has_state = true;
+
+  // Otherwise the next range starts with the state
+  if (!m_current_range_dispatched)
+    AddState(GetCurrentRange());
+}
+
+void CommandRecorder::Draw(u32 num_vertices, u32 base_vertex)
+{
+  AddCommand(Command::Type::Draw, num_vertices, base_vertex);
+}
+
+void CommandRecorder::DrawIndexed(u32 num_indices, u32 base_index, u32 base_vertex)
+{
+  AddCommand(Command::Type::DrawIndexed, num_indices, base_index, base_vertex);
+}
+
+void CommandRecorder::ClearAttachments(std::span<const VkClearAttachment> attachments,
+                                       const VkClearRect& rect)
+{
+  Range& range = GetCurrentRange();
+  const u32 first = static_cast<u32>(range.clear_attachments.size());
+  range.clear_attachments.insert(range.clear_attachments.end(), attachments.begin(),
+                                 attachments.end());
+  range.clear_rects.push_back(rect);
+  AddCommand(Command::Type::ClearAttachments, first, static_cast<u32>(attachments.size()),
+             static_cast<u32>(range.clear_rects.size() - 1));
+}
+
+void CommandRecorder::BeginQuery(VkQueryPool query_pool, u32 query, VkQueryControlFlags flags)
+{
+  ++m_open_queries;
+  AddCommand(Command::Type::BeginQuery, query, flags, 0, query_pool);
+}
+
+void CommandRecorder::EndQuery(VkQueryPool query_pool, u32 query)
+{
+  ASSERT(m_open_queries > 0);
+  --m_open_queries;
+  AddCommand(Command::Type::EndQuery, query, 0, 0, query_pool);
+}
+
+CommandRecorder::Range& CommandRecorder::GetCurrentRange()
+{
+  if (!m_current_range_dispatched)
+    return *m_ranges[m_num_ranges - 1];
+
+  if (m_num_ranges == m_ranges.size())
+    m_ranges.push_back(std::make_unique<Range>());
+
+  Range& range = *m_ranges[m_num_ranges++];
+  range.commands.clear();
+  range.states.clear();
+  range.clear_attachments.clear();
+  range.clear_rects.clear();
+  range.render_pass = m_render_pass;
+  range.framebuffer = m_framebuffer;
+  range.command_buffer = VK_NULL_HANDLE;
+  m_current_range_dispatched = false;
+
+  // Nothing is bound at the start of a secondary command buffer
+  if (m_has_state)
+    AddState(range);
+
+  return range;
+}
+
+void CommandRecorder::AddState(Range& range)
+{
+  range.states.push_back(m_state);
+  range.commands.push_back({Command::Type::SetState,
+                            {static_cast<u32>(range.states.size() - 1), 0, 0},
+                            VK_NULL_HANDLE});
+}
+
+void CommandRecorder::AddCommand(Command::Type type, u32 arg0, u32 arg1, u32 arg2,
+                                 VkQueryPool query_pool)
+{
+  Range& range = GetCurrentRange();
+  range.commands.push_back({type, {arg0, arg1, arg2}, query_pool});
+  if (range.commands.size() >= COMMANDS_PER_RANGE && m_open_queries == 0)
+    DispatchRange();
+}
+
+void CommandRecorder::DispatchRange()
+{
+  m_workers[m_next_worker]->Push(m_ranges[m_num_ranges - 1].get());
+  m_next_worker = (m_next_worker + 1) % static_cast<u32>(m_workers.size());
+  m_current_range_dispatched = true;
+}
+
+void CommandRecorder::RecordRange(u32 worker, Range* range)
+{
+  const VkCommandBuffer command_buffer =
+      g_command_buffer_mgr->AllocateSecondaryCommandBuffer(worker);
+  if (command_buffer == VK_NULL_HANDLE)
+    return;
+
+  const VkCommandBufferInheritanceInfo inheritance_info = {
+      VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO,
+      nullptr,
+      range->render_pass,
+      0,
+      range->framebuffer,
+      VK_FALSE,
+      0,
+      0};
+  const VkCommandBufferBeginInfo begin_info = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO, nullptr,
+                                               VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT |
+                                                   VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT,
+                                               &inheritance_info};
+  VkResult res = vkBeginCommandBuffer(command_buffer, &begin_info);
+  if (res != VK_SUCCESS)
+  {
+    LOG_VULKAN_ERROR(res, "vkBeginCommandBuffer failed: ");
+    return;
+  }
+
+  // What is bound in this command buffer
+  const DrawState* bound = nullptr;
+  VkBuffer bound_vertex_buffer = VK_NULL_HANDLE;
+  VkDeviceSize bound_vertex_buffer_offset = 0;
+
+  for (const Command& command : range->commands)
+  {
+    switch (command.type)
+    {
+    case Command::Type::SetState:
+    {
+      const DrawState& state = range->states[command.args[0]];
+      if (!bound || bound->pipeline != state.pipeline)
+      {
+        vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, state.pipeline);
+      }
+      if (!bound || bound->pipeline_layout != state.pipeline_layout ||
+          bound->descriptor_sets != state.descriptor_sets ||
+          bound->num_descriptor_sets != state.num_descriptor_sets ||
+          bound->dynamic_offsets != state.dynamic_offsets ||
+          bound->num_dynamic_offsets != state.num_dynamic_offsets)
+      {
+        vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+                                state.pipeline_layout, 0, state.num_descriptor_sets,
+                                state.descriptor_sets.data(), state.num_dynamic_offsets,
+                                state.dynamic_offsets.data());
+      }
+      if (state.vertex_buffer != VK_NULL_HANDLE &&
+          (state.vertex_buffer != bound_vertex_buffer ||
+           state.vertex_buffer_offset != bound_vertex_buffer_offset))
+      {
+        vkCmdBindVertexBuffers(command_buffer, 0, 1, &state.vertex_buffer,
+                               &state.vertex_buffer_offset);
+        bound_vertex_buffer = state.vertex_buffer;
+        bound_vertex_buffer_offset = state.vertex_buffer_offset;
+      }
+      if (state.index_buffer != VK_NULL_HANDLE &&
+          (!bound || bound->index_buffer != state.index_buffer ||
+           bound->index_buffer_offset != state.index_buffer_offset ||
+           bound->index_type != state.index_type))
+      {
+        vkCmdBindIndexBuffer(command_buffer, state.index_buffer, state.index_buffer_offset,
+                             state.index_type);
+      }
+      if (!bound || std::memcmp(&bound->viewport, &state.viewport, sizeof(state.viewport)) != 0)
+        vkCmdSetViewport(command_buffer, 0, 1, &state.viewport);
+      if (!bound || std::memcmp(&bound->scissor, &state.scissor, sizeof(state.scissor)) != 0)
+        vkCmdSetScissor(command_buffer, 0, 1, &state.scissor);
+      bound = &state;
+      break;
+    }
+
+    case Command::Type::Draw:
+      vkCmdDraw(command_buffer, command.args[0], 1, command.args[1], 0);
+      break;
+
+    case Command::Type::DrawIndexed:
+      vkCmdDrawIndexed(command_buffer, command.args[0], 1, command.args[1],
+                       static_cast<s32>(command.args[2]), 0);
+      break;
+
+    case Command::Type::ClearAttachments:
+      vkCmdClearAttachments(command_buffer, command.args[1],
+                            &range->clear_attachments[command.args[0]], 1,
+                            &range->clear_rects[command.args[2]]);
+      break;
+
+    case Command::Type::BeginQuery:
+      vkCmdBeginQuery(command_buffer, command.query_pool, command.args[0], command.args[1]);
+      break;
+
+    case Command::Type::EndQuery:
+      vkCmdEndQuery(command_buffer, command.query_pool, command.args[0]);
+      break;
+    }
+  }
+
+  res = vkEndCommandBuffer(command_buffer);
+  if (res != VK_SUCCESS)
+  {
+    LOG_VULKAN_ERROR(res, "vkEndCommandBuffer failed: ");
+    return;
+  }
+
+  range->command_buffer = command_buffer;
+}
+}  // namespace Vulkan
@@ -0,0 +1,133 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/WorkQueueThread.h"
+
+#include "VideoBackends/Vulkan/Constants.h"
+
+namespace Vulkan
+{
+// Records the contents of render passes into secondary command buffers on worker threads. The
+// commands of a render pass are collected on the video thread and handed to the workers in ranges
+// as soon as a range is full, so the workers make the driver calls while the video thread keeps
+// going. When the render pass ends, the secondary command buffers are executed in the order of the
+// ranges.
+//
+// Descriptor sets are still allocated and written on the video thread, as the descriptor pools are
+// shared. Every draw only carries the state it needs bound, and each worker tracks what is bound
+// in its own command buffer.
+class CommandRecorder
+{
+public:
+  // Everything that is bound for a draw
+  struct DrawState
+  {
+    VkPipeline pipeline = VK_NULL_HANDLE;
+    VkPipelineLayout pipeline_layout = VK_NULL_HANDLE;
+    std::array<VkDescriptorSet, 3> descriptor_sets{};
+    u32 num_descriptor_sets = 0;
+    std::array<u32, NUM_UBO_DESCRIPTOR_SET_BINDINGS> dynamic_offsets{};
+    u32 num_dynamic_offsets = 0;
+    // Not bound if null
+    VkBuffer vertex_buffer = VK_NULL_HANDLE;
+    VkDeviceSize vertex_buffer_offset = 0;
+    VkBuffer index_buffer = VK_NULL_HANDLE;
+    VkDeviceSize index_buffer_offset = 0;
+    VkIndexType index_type = VK_INDEX_TYPE_UINT16;
+    VkViewport viewport{};
+    VkRect2D scissor{};
+
+    bool operator==(const DrawState& other) const;
+  };
+
+  explicit CommandRecorder(u32 num_workers);
+  ~CommandRecorder();
+
+  CommandRecorder(const CommandRecorder&) = delete;
+  CommandRecorder& operator=(const CommandRecorder&) = delete;
+
+  // The render pass has to be begun with VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS
+  void BeginRenderPass(VkRenderPass render_pass, VkFramebuffer framebuffer);
+  // Waits for the workers, and executes what they recorded in the primary command buffer. The
+  // render pass is still to be ended after this.
+  void EndRenderPass(VkCommandBuffer command_buffer);
+
+  void SetState(const DrawState& state);
+  void Draw(u32 num_vertices, u32 base_vertex);
+  void DrawIndexed(u32 num_indices, u32 base_index, u32 base_vertex);
+  void ClearAttachments(std::span<const VkClearAttachment> attachments, const VkClearRect& rect);
+  void BeginQuery(VkQueryPool query_pool, u32 query, VkQueryControlFlags flags);
+  void EndQuery(VkQueryPool query_pool, u32 query);
+
+private:
+  // Fewer commands aren't worth waking a worker for
+  static constexpr size_t COMMANDS_PER_RANGE = 128;
+
+  struct Command
+  {
+    enum class Type : u8
+    {
+      SetState,
+      Draw,
+      DrawIndexed,
+      ClearAttachments,
+      BeginQuery,
+      EndQuery,
+    };
+
+    Type type;
+    // Draws: count, first vertex or index, base vertex.
+    // SetState: index into Range::states.
+    // ClearAttachments: first attachment in Range::clear_attachments, count, index into
+    // Range::clear_rects.
+    // Queries: query, flags.
+    std::array<u32, 3> args;
+    VkQueryPool query_pool;
+  };
+
+  // A part of a render pass that is recorded by a worker
+  struct Range
+  {
+    std::vector<Command> commands;
+    std::vector<DrawState> states;
+    std::vector<VkClearAttachment> clear_attachments;
+    std::vector<VkClearRect> clear_rects;
+
+    VkRenderPass render_pass = VK_NULL_HANDLE;
+    VkFramebuffer framebuffer = VK_NULL_HANDLE;
+    // Set by the worker
+    VkCommandBuffer command_buffer = VK_NULL_HANDLE;
+  };
+
+  static void RecordRange(u32 worker, Range* range);
+
+  Range& GetCurrentRange();
+  void AddState(Range& range);
+  void AddCommand(Command::Type type, u32 arg0, u32 arg1 = 0, u32 arg2 = 0,
+                  VkQueryPool query_pool = VK_NULL_HANDLE);
+  void DispatchRange();
+
+  std::vector<std::unique_ptr<Common::WorkQueueThread<Range*>>> m_workers;
+  u32 m_next_worker = 0;
+
+  // The ranges of the current render pass, which are reused for the following ones
+  std::vector<std::unique_ptr<Range>> m_ranges;
+  size_t m_num_ranges = 0;
+  bool m_current_range_dispatched = true;
+
+  VkRenderPass m_render_pass = VK_NULL_HANDLE;
+  VkFramebuffer m_framebuffer = VK_NULL_HANDLE;
+  DrawState m_state;
+  bool m_has_state = false;
+  // A query has to end in the same command buffer that it began in
+  u32 m_open_queries = 0;
+};
+}  // namespace Vulkan
@@ -52,7 +52,8 @@ bool ObjectCache::Initialize()
     return false;
 
   m_texture_upload_buffer =
-      StreamBuffer::Create(VK_BUFFER_USAGE_TRANSFER_SRC_BIT, TEXTURE_UPLOAD_BUFFER_SIZE);
+      StreamBuffer::Create(VK_BUFFER_USAGE_TRANSFER_SRC_BIT, TEXTURE_UPLOAD_BUFFER_SIZE,
+                           TEXTURE_UPLOAD_BUFFER_SIZE * StreamBuffer::MAX_GROWTH);
   if (!m_texture_upload_buffer)
   {
     PanicAlertFmt("Failed to create texture upload buffer");
@@ -206,6 +207,17 @@ bool ObjectCache::CreateDescriptorSetLayouts()
   if (!g_ActiveConfig.backend_info.bSupportsDynamicVertexLoader)
     create_infos[DESCRIPTOR_SET_LAYOUT_STANDARD_SHADER_STORAGE_BUFFERS].bindingCount--;
 
+  // The samplers change more often than anything else, so push them where we can. Render passes
+  // that are recorded on other threads only carry bound descriptor sets.
+  m_use_push_descriptors =
+      g_vulkan_context->SupportsDeviceExtension(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME) &&
+      g_command_buffer_mgr->GetNumRecordingThreads() == 0;
+  if (m_use_push_descriptors)
+  {
+    create_infos[DESCRIPTOR_SET_LAYOUT_STANDARD_SAMPLERS].flags |=
+        VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR;
+  }
+
   for (size_t i = 0; i < create_infos.size(); i++)
   {
     VkResult res = vkCreateDescriptorSetLayout(g_vulkan_context->GetDevice(), &create_infos[i],
@@ -44,6 +44,10 @@ public:
     return m_descriptor_set_layouts[layout];
   }
 
+  // Whether the GX samplers are pushed with VK_KHR_push_descriptor rather than bound in a set.
+  // DESCRIPTOR_SET_LAYOUT_STANDARD_SAMPLERS can't be used to allocate descriptor sets if so.
+  bool UsesPushDescriptors() const { return m_use_push_descriptors; }
+
   // Pipeline layout accessor. Used to fill in required field in PipelineInfo.
   VkPipelineLayout GetPipelineLayout(PIPELINE_LAYOUT layout) const
   {
@@ -90,6 +94,7 @@ private:
 
   std::array<VkDescriptorSetLayout, NUM_DESCRIPTOR_SET_LAYOUTS> m_descriptor_set_layouts = {};
   std::array<VkPipelineLayout, NUM_PIPELINE_LAYOUTS> m_pipeline_layouts = {};
+  bool m_use_push_descriptors = false;
 
   std::unique_ptr<StreamBuffer> m_texture_upload_buffer;
 
@@ -3,9 +3,13 @@
 
 #include "VideoBackends/Vulkan/StateTracker.h"
 
+#include <algorithm>
+
 #include "Common/Assert.h"
+#include "Common/Hash.h"
 
 #include "VideoBackends/Vulkan/CommandBufferManager.h"
+#include "VideoBackends/Vulkan/CommandRecorder.h"
 #include "VideoBackends/Vulkan/ObjectCache.h"
 #include "VideoBackends/Vulkan/VKGfx.h"
 #include "VideoBackends/Vulkan/VKPipeline.h"
@@ -14,6 +18,7 @@
 #include "VideoBackends/Vulkan/VKVertexFormat.h"
 #include "VideoBackends/Vulkan/VulkanContext.h"
 #include "VideoCommon/Constants.h"
+#include "VideoCommon/Statistics.h"
 
 namespace Vulkan
 {
@@ -21,7 +26,11 @@ static std::unique_ptr<StateTracker> s_state_tracker;
 
 StateTracker::StateTracker() = default;
 
-StateTracker::~StateTracker() = default;
+StateTracker::~StateTracker()
+{
+  if (m_sampler_set_pool != VK_NULL_HANDLE)
+    vkDestroyDescriptorPool(g_vulkan_context->GetDevice(), m_sampler_set_pool, nullptr);
+}
 
 StateTracker* StateTracker::GetInstance()
 {
@@ -90,6 +99,12 @@ bool StateTracker::Initialize()
     m_bindings.image_textures[i].sampler = g_object_cache->GetPointSampler();
   }
 
+  if (!g_object_cache->UsesPushDescriptors() && !CreateSamplerSetPool())
+    return false;
+
+  if (const u32 num_recording_threads = g_command_buffer_mgr->GetNumRecordingThreads())
+    m_recorder = std::make_unique<CommandRecorder>(num_recording_threads);
+
   // Default dirty flags include all descriptors
   InvalidateCachedState();
   return true;
@@ -263,6 +278,55 @@ void StateTracker::UnbindTexture(VkImageView view)
       it.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
     }
   }
+
+  // The view may be reused for another texture
+  const auto sets = m_sampler_set_views.find(view);
+  if (sets != m_sampler_set_views.end())
+  {
+    for (const SamplerSetKey& key : sets->second)
+      m_sampler_sets.erase(key);
+    m_sampler_set_views.erase(sets);
+  }
+}
+
+void StateTracker::ClearSamplerSetCache()
+{
+  if (m_sampler_set_pool == VK_NULL_HANDLE)
+    return;
+
+  // The sets may still be in use by the GPU
+  g_command_buffer_mgr->DeferDescriptorPoolDestruction(m_sampler_set_pool);
+  m_sampler_set_pool = VK_NULL_HANDLE;
+  m_sampler_set_pool_used = 0;
+  m_sampler_sets.clear();
+  m_sampler_set_views.clear();
+  m_gx_descriptor_sets[1] = VK_NULL_HANDLE;
+  CreateSamplerSetPool();
+}
+
+bool StateTracker::CreateSamplerSetPool()
+{
+  const VkDescriptorPoolSize pool_size = {
+      VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+      MAX_CACHED_SAMPLER_SETS * static_cast<u32>(VideoCommon::MAX_PIXEL_SHADER_SAMPLERS)};
+  const VkDescriptorPoolCreateInfo pool_create_info = {
+      VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO, nullptr, 0, MAX_CACHED_SAMPLER_SETS, 1,
+      &pool_size};
+
+  VkResult res = vkCreateDescriptorPool(g_vulkan_context->GetDevice(), &pool_create_info, nullptr,
+                                        &m_sampler_set_pool);
+  if (res != VK_SUCCESS)
+  {
+    LOG_VULKAN_ERROR(res, "vkCreateDescriptorPool failed: ");
+    m_sampler_set_pool = VK_NULL_HANDLE;
+    return false;
+  }
+  return true;
+}
+
+size_t StateTracker::SamplerSetKeyHash::operator()(const SamplerSetKey& key) const
+{
+  return static_cast<size_t>(Common::HashData(&key, sizeof(key)));
 }
 
 void StateTracker::InvalidateCachedState()
@@ -284,19 +348,7 @@ void StateTracker::BeginRenderPass()
   if (InRenderPass())
     return;
 
-  m_current_render_pass = m_framebuffer->GetLoadRenderPass();
-  m_framebuffer_render_area = m_framebuffer->GetRect();
-
-  VkRenderPassBeginInfo begin_info = {VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO,
-                                      nullptr,
-                                      m_current_render_pass,
-                                      m_framebuffer->GetFB(),
-                                      m_framebuffer_render_area,
-                                      0,
-                                      nullptr};
-
-  vkCmdBeginRenderPass(g_command_buffer_mgr->GetCurrentCommandBuffer(), &begin_info,
-                       VK_SUBPASS_CONTENTS_INLINE);
+  BeginRenderPass(m_framebuffer->GetLoadRenderPass(), m_framebuffer->GetRect(), nullptr, 0);
 }
 
 void StateTracker::BeginDiscardRenderPass()
@@ -304,19 +356,7 @@ void StateTracker::BeginDiscardRenderPass()
   if (InRenderPass())
     return;
 
-  m_current_render_pass = m_framebuffer->GetDiscardRenderPass();
-  m_framebuffer_render_area = m_framebuffer->GetRect();
-
-  VkRenderPassBeginInfo begin_info = {VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO,
-                                      nullptr,
-                                      m_current_render_pass,
-                                      m_framebuffer->GetFB(),
-                                      m_framebuffer_render_area,
-                                      0,
-                                      nullptr};
-
-  vkCmdBeginRenderPass(g_command_buffer_mgr->GetCurrentCommandBuffer(), &begin_info,
-                       VK_SUBPASS_CONTENTS_INLINE);
+  BeginRenderPass(m_framebuffer->GetDiscardRenderPass(), m_framebuffer->GetRect(), nullptr, 0);
 }
 
 void StateTracker::EndRenderPass()
@@ -324,7 +364,10 @@ void StateTracker::EndRenderPass()
   if (!InRenderPass())
     return;
 
-  vkCmdEndRenderPass(g_command_buffer_mgr->GetCurrentCommandBuffer());
+  const VkCommandBuffer command_buffer = g_command_buffer_mgr->GetCurrentCommandBuffer();
+  if (m_recorder)
+    m_recorder->EndRenderPass(command_buffer);
+  vkCmdEndRenderPass(command_buffer);
   m_current_render_pass = VK_NULL_HANDLE;
 }
 
@@ -333,7 +376,13 @@ void StateTracker::BeginClearRenderPass(const VkRect2D& area, const VkClearValue
 {
   ASSERT(!InRenderPass());
 
-  m_current_render_pass = m_framebuffer->GetClearRenderPass();
+  BeginRenderPass(m_framebuffer->GetClearRenderPass(), area, clear_values, num_clear_values);
+}
+
+void StateTracker::BeginRenderPass(VkRenderPass render_pass, const VkRect2D& area,
+                                   const VkClearValue* clear_values, u32 num_clear_values)
+{
+  m_current_render_pass = render_pass;
   m_framebuffer_render_area = area;
 
   VkRenderPassBeginInfo begin_info = {VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO,
@@ -344,8 +393,12 @@ void StateTracker::BeginClearRenderPass(const VkRect2D& area, const VkClearValue
                                       num_clear_values,
                                       clear_values};
 
+  // With a recorder, everything within the render pass goes into secondary command buffers
   vkCmdBeginRenderPass(g_command_buffer_mgr->GetCurrentCommandBuffer(), &begin_info,
-                       VK_SUBPASS_CONTENTS_INLINE);
+                       m_recorder ? VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS :
+                                    VK_SUBPASS_CONTENTS_INLINE);
+  if (m_recorder)
+    m_recorder->BeginRenderPass(m_current_render_pass, m_framebuffer->GetFB());
 }
 
 void StateTracker::SetViewport(const VkViewport& viewport)
@@ -383,6 +436,14 @@ bool StateTracker::Bind()
   if (!InRenderPass())
     BeginRenderPass();
 
+  if (m_recorder)
+  {
+    RecordDrawState();
+    m_dirty_flags &= ~(DIRTY_FLAG_VERTEX_BUFFER | DIRTY_FLAG_INDEX_BUFFER | DIRTY_FLAG_PIPELINE |
+                       DIRTY_FLAG_VIEWPORT | DIRTY_FLAG_SCISSOR);
+    return true;
+  }
+
   // Re-bind parts of the pipeline
   const VkCommandBuffer command_buffer = g_command_buffer_mgr->GetCurrentCommandBuffer();
   const bool needs_vertex_buffer = !g_ActiveConfig.backend_info.bSupportsDynamicVertexLoader ||
@@ -410,6 +471,94 @@ bool StateTracker::Bind()
   return true;
 }
 
+void StateTracker::RecordDrawState()
+{
+  CommandRecorder::DrawState state;
+  state.pipeline = m_pipeline->GetVkPipeline();
+  state.pipeline_layout = m_pipeline->GetVkPipelineLayout();
+  if (m_pipeline->GetUsage() != AbstractPipelineUsage::Utility)
+  {
+    state.num_descriptor_sets = NeedsGXSSBO() ? NUM_GX_DESCRIPTOR_SETS : NUM_GX_DESCRIPTOR_SETS - 1;
+    std::copy(m_gx_descriptor_sets.begin(), m_gx_descriptor_sets.end(),
+              state.descriptor_sets.begin());
+    state.num_dynamic_offsets = NeedsGeometryShaderUBO() ? NUM_UBO_DESCRIPTOR_SET_BINDINGS :
+                                                           NUM_UBO_DESCRIPTOR_SET_BINDINGS - 1;
+    state.dynamic_offsets = m_bindings.gx_ubo_offsets;
+  }
+  else
+  {
+    state.num_descriptor_sets = NUM_UTILITY_DESCRIPTOR_SETS;
+    std::copy(m_utility_descriptor_sets.begin(), m_utility_descriptor_sets.end(),
+              state.descriptor_sets.begin());
+    state.num_dynamic_offsets = 1;
+    state.dynamic_offsets[0] = m_bindings.utility_ubo_offset;
+  }
+
+  if (!g_ActiveConfig.backend_info.bSupportsDynamicVertexLoader ||
+      m_pipeline->GetUsage() != AbstractPipelineUsage::GXUber)
+  {
+    state.vertex_buffer = m_vertex_buffer;
+    state.vertex_buffer_offset = m_vertex_buffer_offset;
+  }
+  state.index_buffer = m_index_buffer;
+  state.index_buffer_offset = m_index_buffer_offset;
+  state.index_type = m_index_type;
+  state.viewport = m_viewport;
+  state.scissor = m_scissor;
+  m_recorder->SetState(state);
+}
+
+void StateTracker::Draw(u32 num_vertices, u32 base_vertex)
+{
+  if (m_recorder)
+    m_recorder->Draw(num_vertices, base_vertex);
+  else
+    vkCmdDraw(g_command_buffer_mgr->GetCurrentCommandBuffer(), num_vertices, 1, base_vertex, 0);
+}
+
+void StateTracker::DrawIndexed(u32 num_indices, u32 base_index, u32 base_vertex)
+{
+  if (m_recorder)
+  {
+    m_recorder->DrawIndexed(num_indices, base_index, base_vertex);
+  }
+  else
+  {
+    vkCmdDrawIndexed(g_command_buffer_mgr->GetCurrentCommandBuffer(), num_indices, 1, base_index,
+                     base_vertex, 0);
+  }
+}
+
+void StateTracker::ClearAttachments(std::span<const VkClearAttachment> attachments,
+                                    const VkClearRect& rect)
+{
+  if (m_recorder)
+  {
+    m_recorder->ClearAttachments(attachments, rect);
+  }
+  else
+  {
+    vkCmdClearAttachments(g_command_buffer_mgr->GetCurrentCommandBuffer(),
+                          static_cast<u32>(attachments.size()), attachments.data(), 1, &rect);
+  }
+}
+
+void StateTracker::BeginQuery(VkQueryPool query_pool, u32 query, VkQueryControlFlags flags)
+{
+  if (m_recorder && InRenderPass())
+    m_recorder->BeginQuery(query_pool, query, flags);
+  else
+    vkCmdBeginQuery(g_command_buffer_mgr->GetCurrentCommandBuffer(), query_pool, query, flags);
+}
+
+void StateTracker::EndQuery(VkQueryPool query_pool, u32 query)
+{
+  if (m_recorder && InRenderPass())
+    m_recorder->EndQuery(query_pool, query);
+  else
+    vkCmdEndQuery(g_command_buffer_mgr->GetCurrentCommandBuffer(), query_pool, query);
+}
+
 bool StateTracker::BindCompute()
 {
   if (!m_compute_shader)
@@ -463,6 +612,21 @@ void StateTracker::EndClearRenderPass()
   EndRenderPass();
 }
 
+bool StateTracker::NeedsGeometryShaderUBO() const
+{
+  return g_ActiveConfig.backend_info.bSupportsGeometryShaders ||
+         g_ActiveConfig.UseVSForLinePointExpand();
+}
+
+bool StateTracker::NeedsGXSSBO() const
+{
+  const bool needs_bbox_ssbo = g_ActiveConfig.backend_info.bSupportsBBox;
+  const bool needs_vertex_ssbo = (g_ActiveConfig.backend_info.bSupportsDynamicVertexLoader &&
+                                  m_pipeline->GetUsage() == AbstractPipelineUsage::GXUber) ||
+                                 g_ActiveConfig.UseVSForLinePointExpand();
+  return needs_bbox_ssbo || needs_vertex_ssbo;
+}
+
 void StateTracker::UpdateDescriptorSet()
 {
   if (m_pipeline->GetUsage() != AbstractPipelineUsage::Utility)
@@ -479,8 +643,7 @@ void StateTracker::UpdateGXDescriptorSet()
   std::array<VkWriteDescriptorSet, MAX_DESCRIPTOR_WRITES> writes;
   u32 num_writes = 0;
 
-  const bool needs_gs_ubo = g_ActiveConfig.backend_info.bSupportsGeometryShaders ||
-                            g_ActiveConfig.UseVSForLinePointExpand();
+  const bool needs_gs_ubo = NeedsGeometryShaderUBO();
 
   if (m_dirty_flags & DIRTY_FLAG_GX_UBOS || m_gx_descriptor_sets[0] == VK_NULL_HANDLE)
   {
@@ -515,29 +678,19 @@ void StateTracker::UpdateGXDescriptorSet()
     m_dirty_flags = (m_dirty_flags & ~DIRTY_FLAG_GX_UBOS) | DIRTY_FLAG_DESCRIPTOR_SETS;
   }
 
-  if (m_dirty_flags & DIRTY_FLAG_GX_SAMPLERS || m_gx_descriptor_sets[1] == VK_NULL_HANDLE)
+  // Pushed samplers have to be pushed again whenever the other sets are bound with a new layout
+  const bool use_push_descriptors = g_object_cache->UsesPushDescriptors();
+  const bool push_samplers =
+      use_push_descriptors &&
+      (m_dirty_flags & (DIRTY_FLAG_GX_SAMPLERS | DIRTY_FLAG_DESCRIPTOR_SETS)) != 0;
+  if (!use_push_descriptors &&
+      (m_dirty_flags & DIRTY_FLAG_GX_SAMPLERS || m_gx_descriptor_sets[1] == VK_NULL_HANDLE))
   {
-    m_gx_descriptor_sets[1] = g_command_buffer_mgr->AllocateDescriptorSet(
-        g_object_cache->GetDescriptorSetLayout(DESCRIPTOR_SET_LAYOUT_STANDARD_SAMPLERS));
-
-    writes[num_writes++] = {VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-                            nullptr,
-                            m_gx_descriptor_sets[1],
-                            0,
-                            0,
-                            static_cast<u32>(VideoCommon::MAX_PIXEL_SHADER_SAMPLERS),
-                            VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-                            m_bindings.samplers.data(),
-                            nullptr,
-                            nullptr};
+    m_gx_descriptor_sets[1] = GetGXSamplerSet();
     m_dirty_flags = (m_dirty_flags & ~DIRTY_FLAG_GX_SAMPLERS) | DIRTY_FLAG_DESCRIPTOR_SETS;
   }
 
-  const bool needs_bbox_ssbo = g_ActiveConfig.backend_info.bSupportsBBox;
-  const bool needs_vertex_ssbo = (g_ActiveConfig.backend_info.bSupportsDynamicVertexLoader &&
-                                  m_pipeline->GetUsage() == AbstractPipelineUsage::GXUber) ||
-                                 g_ActiveConfig.UseVSForLinePointExpand();
-  const bool needs_ssbo = needs_bbox_ssbo || needs_vertex_ssbo;
+  const bool needs_ssbo = NeedsGXSSBO();
 
   if (needs_ssbo &&
       (m_dirty_flags & DIRTY_FLAG_GX_SSBO || m_gx_descriptor_sets[2] == VK_NULL_HANDLE))
@@ -571,7 +724,28 @@ void StateTracker::UpdateGXDescriptorSet()
   if (num_writes > 0)
     vkUpdateDescriptorSets(g_vulkan_context->GetDevice(), num_writes, writes.data(), 0, nullptr);
 
-  if (m_dirty_flags & DIRTY_FLAG_DESCRIPTOR_SETS)
+  // The recorder binds the descriptor sets along with the rest of the draw state
+  if (m_recorder)
+  {
+    m_dirty_flags &= ~(DIRTY_FLAG_DESCRIPTOR_SETS | DIRTY_FLAG_GX_UBO_OFFSETS);
+  }
+  else if (m_dirty_flags & DIRTY_FLAG_DESCRIPTOR_SETS && use_push_descriptors)
+  {
+    // There's no set to bind in between the uniform buffers and the SSBOs
+    vkCmdBindDescriptorSets(
+        g_command_buffer_mgr->GetCurrentCommandBuffer(), VK_PIPELINE_BIND_POINT_GRAPHICS,
+        m_pipeline->GetVkPipelineLayout(), 0, 1, m_gx_descriptor_sets.data(),
+        needs_gs_ubo ? NUM_UBO_DESCRIPTOR_SET_BINDINGS : (NUM_UBO_DESCRIPTOR_SET_BINDINGS - 1),
+        m_bindings.gx_ubo_offsets.data());
+    if (needs_ssbo)
+    {
+      vkCmdBindDescriptorSets(g_command_buffer_mgr->GetCurrentCommandBuffer(),
+                              VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipeline->GetVkPipelineLayout(),
+                              2, 1, &m_gx_descriptor_sets[2], 0, nullptr);
+    }
+    m_dirty_flags &= ~(DIRTY_FLAG_DESCRIPTOR_SETS | DIRTY_FLAG_GX_UBO_OFFSETS);
+  }
+  else if (m_dirty_flags & DIRTY_FLAG_DESCRIPTOR_SETS)
   {
     vkCmdBindDescriptorSets(g_command_buffer_mgr->GetCurrentCommandBuffer(),
                             VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipeline->GetVkPipelineLayout(), 0,
@@ -591,6 +765,104 @@ void StateTracker::UpdateGXDescriptorSet()
         m_bindings.gx_ubo_offsets.data());
     m_dirty_flags &= ~DIRTY_FLAG_GX_UBO_OFFSETS;
   }
+
+  if (push_samplers)
+  {
+    PushGXSamplers();
+    m_dirty_flags &= ~DIRTY_FLAG_GX_SAMPLERS;
+  }
+}
+
+VkDescriptorSet StateTracker::GetGXSamplerSet()
+{
+  SamplerSetKey key;
+  for (size_t i = 0; i < VideoCommon::MAX_PIXEL_SHADER_SAMPLERS; i++)
+  {
+    key.views[i] = m_bindings.samplers[i].imageView;
+    key.samplers[i] = m_bindings.samplers[i].sampler;
+  }
+
+  const auto cached = m_sampler_sets.find(key);
+  if (cached != m_sampler_sets.end())
+  {
+    INCSTAT(g_stats.this_frame.num_descriptor_set_cache_hits);
+    return cached->second;
+  }
+
+  if (m_sampler_set_pool_used == MAX_CACHED_SAMPLER_SETS)
+    ClearSamplerSetCache();
+
+  const VkDescriptorSetLayout set_layout =
+      g_object_cache->GetDescriptorSetLayout(DESCRIPTOR_SET_LAYOUT_STANDARD_SAMPLERS);
+  VkDescriptorSet descriptor_set = VK_NULL_HANDLE;
+  if (m_sampler_set_pool != VK_NULL_HANDLE)
+  {
+    const VkDescriptorSetAllocateInfo allocate_info = {
+        VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO, nullptr, m_sampler_set_pool, 1,
+        &set_layout};
+    VkResult res =
+        vkAllocateDescriptorSets(g_vulkan_context->GetDevice(), &allocate_info, &descriptor_set);
+    if (res != VK_SUCCESS)
+    {
+      LOG_VULKAN_ERROR(res, "vkAllocateDescriptorSets failed: ");
+      descriptor_set = VK_NULL_HANDLE;
+    }
+  }
+
+  // Without a cache, the set only lives for the frame
+  const bool is_cached = descriptor_set != VK_NULL_HANDLE;
+  if (is_cached)
+    INCSTAT(g_stats.this_frame.num_descriptor_sets_allocated);
+  else
+    descriptor_set = g_command_buffer_mgr->AllocateDescriptorSet(set_layout);
+  if (descriptor_set == VK_NULL_HANDLE)
+    return VK_NULL_HANDLE;
+
+  const VkWriteDescriptorSet write = {VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+                                      nullptr,
+                                      descriptor_set,
+                                      0,
+                                      0,
+                                      static_cast<u32>(VideoCommon::MAX_PIXEL_SHADER_SAMPLERS),
+                                      VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+                                      m_bindings.samplers.data(),
+                                      nullptr,
+                                      nullptr};
+  vkUpdateDescriptorSets(g_vulkan_context->GetDevice(), 1, &write, 0, nullptr);
+
+  if (is_cached)
+  {
+    m_sampler_set_pool_used++;
+    m_sampler_sets.emplace(key, descriptor_set);
+    for (size_t i = 0; i < key.views.size(); i++)
+    {
+      if (std::find(key.views.begin(), key.views.begin() + i, key.views[i]) ==
+          key.views.begin() + i)
+      {
+        m_sampler_set_views[key.views[i]].push_back(key);
+      }
+    }
+  }
+
+  return descriptor_set;
+}
+
+void StateTracker::PushGXSamplers()
+{
+  const VkWriteDescriptorSet write = {VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+                                      nullptr,
+                                      VK_NULL_HANDLE,
+                                      0,
+                                      0,
+                                      static_cast<u32>(VideoCommon::MAX_PIXEL_SHADER_SAMPLERS),
+                                      VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+                                      m_bindings.samplers.data(),
+                                      nullptr,
+                                      nullptr};
+  vkCmdPushDescriptorSetKHR(g_command_buffer_mgr->GetCurrentCommandBuffer(),
+                            VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipeline->GetVkPipelineLayout(), 1,
+                            1, &write);
+  INCSTAT(g_stats.this_frame.num_descriptor_pushes);
 }
 
 void StateTracker::UpdateUtilityDescriptorSet()
@@ -651,7 +923,11 @@ void StateTracker::UpdateUtilityDescriptorSet()
   if (writes > 0)
     vkUpdateDescriptorSets(g_vulkan_context->GetDevice(), writes, dswrites.data(), 0, nullptr);
 
-  if (m_dirty_flags & DIRTY_FLAG_DESCRIPTOR_SETS)
+  if (m_recorder)
+  {
+    m_dirty_flags &= ~(DIRTY_FLAG_DESCRIPTOR_SETS | DIRTY_FLAG_UTILITY_UBO_OFFSET);
+  }
+  else if (m_dirty_flags & DIRTY_FLAG_DESCRIPTOR_SETS)
   {
     vkCmdBindDescriptorSets(g_command_buffer_mgr->GetCurrentCommandBuffer(),
                             VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipeline->GetVkPipelineLayout(), 0,
@@ -6,6 +6,9 @@
 #include <array>
 #include <cstddef>
 #include <memory>
+#include <span>
+#include <unordered_map>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "VideoBackends/Vulkan/Constants.h"
@@ -13,6 +16,7 @@
 
 namespace Vulkan
 {
+class CommandRecorder;
 class VKFramebuffer;
 class VKShader;
 class VKPipeline;
@@ -47,6 +51,9 @@ public:
 
   void UnbindTexture(VkImageView view);
 
+  // Drops all cached sampler descriptor sets, for when samplers are destroyed.
+  void ClearSamplerSetCache();
+
   // Set dirty flags on everything to force re-bind at next draw time.
   void InvalidateCachedState();
 
@@ -70,6 +77,14 @@ public:
   // If this returns false, you should not issue the draw.
   bool Bind();
 
+  // The commands that are recorded within a render pass. They have to go through here, as render
+  // passes may be recorded on other threads.
+  void Draw(u32 num_vertices, u32 base_vertex);
+  void DrawIndexed(u32 num_indices, u32 base_index, u32 base_vertex);
+  void ClearAttachments(std::span<const VkClearAttachment> attachments, const VkClearRect& rect);
+  void BeginQuery(VkQueryPool query_pool, u32 query, VkQueryControlFlags flags);
+  void EndQuery(VkQueryPool query_pool, u32 query);
+
   // Binds all dirty compute state to the command buffer.
   // If this returns false, you should not dispatch the shader.
   bool BindCompute();
@@ -110,8 +125,32 @@ private:
                                  DIRTY_FLAG_UTILITY_BINDINGS | DIRTY_FLAG_COMPUTE_BINDINGS
   };
 
+  // Sets for this many combinations of GX textures and samplers are kept, after which the pool is
+  // replaced with an empty one.
+  static constexpr u32 MAX_CACHED_SAMPLER_SETS = 1024;
+
+  struct SamplerSetKey
+  {
+    std::array<VkImageView, VideoCommon::MAX_PIXEL_SHADER_SAMPLERS> views;
+    std::array<VkSampler, VideoCommon::MAX_PIXEL_SHADER_SAMPLERS> samplers;
+
+    bool operator==(const SamplerSetKey& other) const = default;
+  };
+  struct SamplerSetKeyHash
+  {
+    size_t operator()(const SamplerSetKey& key) const;
+  };
+
   bool Initialize();
 
+  void BeginRenderPass(VkRenderPass render_pass, const VkRect2D& area,
+                       const VkClearValue* clear_values, u32 num_clear_values);
+  // Passes the state that Bind() would have bound on to the recorder
+  void RecordDrawState();
+
+  bool NeedsGeometryShaderUBO() const;
+  bool NeedsGXSSBO() const;
+
   // Check that the specified viewport is within the render area.
   // If not, ends the render pass if it is a clear render pass.
   bool IsViewportWithinRenderArea() const;
@@ -121,6 +160,11 @@ private:
   void UpdateUtilityDescriptorSet();
   void UpdateComputeDescriptorSet();
 
+  // Returns the set for the currently bound GX samplers, writing a new one if needed
+  VkDescriptorSet GetGXSamplerSet();
+  void PushGXSamplers();
+  bool CreateSamplerSetPool();
+
   // Which bindings/state has to be updated before the next draw.
   u32 m_dirty_flags = 0;
 
@@ -152,6 +196,14 @@ private:
   std::array<VkDescriptorSet, NUM_UTILITY_DESCRIPTOR_SETS> m_utility_descriptor_sets = {};
   VkDescriptorSet m_compute_descriptor_set = VK_NULL_HANDLE;
 
+  // GX sampler sets don't change within a frame, so they are kept for as long as their textures
+  // and samplers are around.
+  VkDescriptorPool m_sampler_set_pool = VK_NULL_HANDLE;
+  u32 m_sampler_set_pool_used = 0;
+  std::unordered_map<SamplerSetKey, VkDescriptorSet, SamplerSetKeyHash> m_sampler_sets;
+  // The keys of the sets that each texture is in. Keys may already be gone from m_sampler_sets.
+  std::unordered_map<VkImageView, std::vector<SamplerSetKey>> m_sampler_set_views;
+
   // rasterization
   VkViewport m_viewport = {0.0f, 0.0f, 1.0f, 1.0f, 0.0f, 1.0f};
   VkRect2D m_scissor = {{0, 0}, {1, 1}};
@@ -163,5 +215,8 @@ private:
   VKFramebuffer* m_framebuffer = nullptr;
   VkRenderPass m_current_render_pass = VK_NULL_HANDLE;
   VkRect2D m_framebuffer_render_area = {};
+
+  // Null if render passes are recorded into the current command buffer directly
+  std::unique_ptr<CommandRecorder> m_recorder;
 };
 }  // namespace Vulkan
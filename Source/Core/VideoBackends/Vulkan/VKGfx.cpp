@@ -198,9 +198,7 @@ void VKGfx::ClearRegion(const MathUtil::Rectangle<int>& target_rc, bool color_en
       }
       StateTracker::GetInstance()->BeginRenderPass();
 
-      vkCmdClearAttachments(g_command_buffer_mgr->GetCurrentCommandBuffer(),
-                            static_cast<uint32_t>(clear_attachments.size()),
-                            clear_attachments.data(), 1, &vk_rect);
+      StateTracker::GetInstance()->ClearAttachments(clear_attachments, vk_rect);
     }
   }
 
@@ -544,7 +542,8 @@ void VKGfx::ResetSamplerStates()
     StateTracker::GetInstance()->SetSampler(i, g_object_cache->GetPointSampler());
   }
 
-  // Invalidate all sampler objects (some will be unused now).
+  // Invalidate all sampler objects (some will be unused now), and the sets that use them.
+  StateTracker::GetInstance()->ClearSamplerSetCache();
   g_object_cache->ClearSamplerCache();
 }
 
@@ -580,7 +579,7 @@ void VKGfx::Draw(u32 base_vertex, u32 num_vertices)
   if (!StateTracker::GetInstance()->Bind())
     return;
 
-  vkCmdDraw(g_command_buffer_mgr->GetCurrentCommandBuffer(), num_vertices, 1, base_vertex, 0);
+  StateTracker::GetInstance()->Draw(num_vertices, base_vertex);
 }
 
 void VKGfx::DrawIndexed(u32 base_index, u32 num_indices, u32 base_vertex)
@@ -588,8 +587,7 @@ void VKGfx::DrawIndexed(u32 base_index, u32 num_indices, u32 base_vertex)
   if (!StateTracker::GetInstance()->Bind())
     return;
 
-  vkCmdDrawIndexed(g_command_buffer_mgr->GetCurrentCommandBuffer(), num_indices, 1, base_index,
-                   base_vertex, 0);
+  StateTracker::GetInstance()->DrawIndexed(num_indices, base_index, base_vertex);
 }
 
 void VKGfx::DispatchComputeShader(const AbstractShader* shader, u32 groupsize_x, u32 groupsize_y,
@@ -3,6 +3,7 @@
 
 #include "VideoBackends/Vulkan/VideoBackend.h"
 
+#include <algorithm>
 #include <vector>
 
 #include "Common/Logging/LogManager.h"
@@ -197,7 +198,9 @@ bool VideoBackend::Initialize(const WindowSystemInfo& wsi)
   UpdateActiveConfig();
 
   // Create command buffers. We do this separately because the other classes depend on it.
-  g_command_buffer_mgr = std::make_unique<CommandBufferManager>(g_Config.bBackendMultithreading);
+  g_command_buffer_mgr = std::make_unique<CommandBufferManager>(
+      g_Config.bBackendMultithreading,
+      static_cast<u32>(std::max(g_Config.iCommandRecordingThreads, 0)));
   if (!g_command_buffer_mgr->Initialize())
   {
     PanicAlertFmt("Failed to create Vulkan command buffers");
@@ -4,51 +4,45 @@
 #pragma once
 
 #include <cstddef>
-#include <deque>
 #include <memory>
-#include <utility>
 
 #include "Common/CommonTypes.h"
 #include "VideoBackends/Vulkan/Constants.h"
+#include "VideoCommon/StreamRing.h"
 
 namespace Vulkan
 {
-class StreamBuffer
+class StreamBuffer final : public VideoCommon::StreamRing
 {
 public:
-  StreamBuffer(VkBufferUsageFlags usage, u32 size);
-  ~StreamBuffer();
+  explicit StreamBuffer(VkBufferUsageFlags usage);
+  ~StreamBuffer() override;
 
+  // The buffer is replaced when it grows, so it shouldn't be kept across allocations then.
   VkBuffer GetBuffer() const { return m_buffer; }
   u8* GetHostPointer() const { return m_host_pointer; }
-  u8* GetCurrentHostPointer() const { return m_host_pointer + m_current_offset; }
-  u32 GetCurrentSize() const { return m_size; }
-  u32 GetCurrentOffset() const { return m_current_offset; }
-  bool ReserveMemory(u32 num_bytes, u32 alignment);
-  void CommitMemory(u32 final_num_bytes);
+  u8* GetCurrentHostPointer() const { return m_host_pointer + GetCurrentOffset(); }
+  u32 GetCurrentSize() const { return GetSize(); }
 
-  static std::unique_ptr<StreamBuffer> Create(VkBufferUsageFlags usage, u32 size);
+  // The buffer may grow up to max_size when it is too small for what is in flight.
+  static std::unique_ptr<StreamBuffer> Create(VkBufferUsageFlags usage, u32 size,
+                                              u32 max_size = 0);
 
-private:
-  bool AllocateBuffer();
-  void UpdateCurrentFencePosition();
-  void UpdateGPUPosition();
+protected:
+  u64 GetCurrentFence() const override;
+  u64 GetCompletedFence() const override;
+  void WaitForFence(u64 fence) override;
+  void FlushRange(u32 offset, u32 size) override;
+  bool Resize(u32 new_size) override;
 
-  // Waits for as many fences as needed to allocate num_bytes bytes from the buffer.
-  bool WaitForClearSpace(u32 num_bytes);
+private:
+  bool AllocateBuffer(u32 size);
 
   VkBufferUsageFlags m_usage;
-  u32 m_size;
-  u32 m_current_offset = 0;
-  u32 m_current_gpu_position = 0;
-  u32 m_last_allocation_size = 0;
 
   VkBuffer m_buffer = VK_NULL_HANDLE;
   VmaAllocation m_alloc = VK_NULL_HANDLE;
   u8* m_host_pointer = nullptr;
-
-  // List of fences and the corresponding positions in the buffer
-  std::deque<std::pair<u64, u32>> m_tracked_fences;
 };
 
 }  // namespace Vulkan
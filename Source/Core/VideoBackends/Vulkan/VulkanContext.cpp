@@ -595,6 +595,7 @@ bool VulkanContext::SelectDeviceExtensions(bool enable_surface)
 
   AddExtension(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME, false);
   AddExtension(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME, false);
+  AddExtension(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME, false);
 
   return true;
 }
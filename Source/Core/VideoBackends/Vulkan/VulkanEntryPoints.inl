@@ -204,6 +204,7 @@ VULKAN_DEVICE_ENTRY_POINT(vkGetBufferMemoryRequirements2, false)
 VULKAN_DEVICE_ENTRY_POINT(vkGetImageMemoryRequirements2, false)
 VULKAN_DEVICE_ENTRY_POINT(vkBindBufferMemory2, false)
 VULKAN_DEVICE_ENTRY_POINT(vkBindImageMemory2, false)
+VULKAN_DEVICE_ENTRY_POINT(vkCmdPushDescriptorSetKHR, false)
 
 #ifdef SUPPORTS_VULKAN_EXCLUSIVE_FULLSCREEN
 VULKAN_DEVICE_ENTRY_POINT(vkAcquireFullScreenExclusiveModeEXT, false)
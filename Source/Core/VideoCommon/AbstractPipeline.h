@@ -86,4 +86,8 @@ public:
   // pipeline objects, the cache is optionally used by the driver to speed up compilation.
   using CacheData = std::vector<u8>;
   virtual CacheData GetCacheData() const { return {}; }
+
+  // The driver may still be creating a pipeline from cache data in the background. This waits for
+  // it, and returns false if the cache data turned out to be unusable.
+  virtual bool FinishCreation() { return true; }
 };
@@ -4,6 +4,7 @@
 #include "VideoCommon/AbstractTexture.h"
 
 #include <algorithm>
+#include <atomic>
 
 #include "Common/Assert.h"
 #include "Common/Image.h"
@@ -11,8 +12,22 @@
 #include "VideoCommon/AbstractGfx.h"
 #include "VideoCommon/AbstractStagingTexture.h"
 
+// Textures may be created and destroyed on worker threads
+static std::atomic<u64> s_total_memory_usage = 0;
+
 AbstractTexture::AbstractTexture(const TextureConfig& c) : m_config(c)
 {
+  s_total_memory_usage.fetch_add(m_config.GetMemorySize(), std::memory_order_relaxed);
+}
+
+AbstractTexture::~AbstractTexture()
+{
+  s_total_memory_usage.fetch_sub(m_config.GetMemorySize(), std::memory_order_relaxed);
+}
+
+u64 AbstractTexture::GetTotalMemoryUsage()
+{
+  return s_total_memory_usage.load(std::memory_order_relaxed);
 }
 
 void AbstractTexture::FinishedRendering()
@@ -14,7 +14,7 @@ class AbstractTexture
 {
 public:
   explicit AbstractTexture(const TextureConfig& c);
-  virtual ~AbstractTexture() = default;
+  virtual ~AbstractTexture();
 
   virtual void CopyRectangleFromTexture(const AbstractTexture* src,
                                         const MathUtil::Rectangle<int>& src_rect, u32 src_layer,
@@ -49,6 +49,9 @@ public:
   static u32 GetTexelSizeForFormat(AbstractTextureFormat format);
   static u32 GetBlockSizeForFormat(AbstractTextureFormat format);
 
+  // The memory of all textures that currently exist, including render targets
+  static u64 GetTotalMemoryUsage();
+
   const TextureConfig& GetConfig() const;
 
 protected:
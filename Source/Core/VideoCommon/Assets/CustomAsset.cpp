@@ -3,6 +3,8 @@
 
 #include "VideoCommon/Assets/CustomAsset.h"
 
+#include <chrono>
+
 namespace VideoCommon
 {
 CustomAsset::CustomAsset(std::shared_ptr<CustomAssetLibrary> library,
@@ -23,6 +25,30 @@ bool CustomAsset::Load()
   return load_information.m_bytes_loaded != 0;
 }
 
+void CustomAsset::Unload()
+{
+  UnloadImpl();
+
+  std::lock_guard lk(m_info_lock);
+  m_bytes_loaded = 0;
+  // Lets users that cached the load time while the asset was unloaded notice that it was loaded
+  // again, even though the data itself didn't change
+  m_last_loaded_time = {};
+  m_unloaded = true;
+}
+
+bool CustomAsset::MarkUsed()
+{
+  m_last_used_time.store(std::chrono::steady_clock::now().time_since_epoch().count(),
+                         std::memory_order_relaxed);
+  return m_unloaded.load(std::memory_order_relaxed) && m_unloaded.exchange(false);
+}
+
+s64 CustomAsset::GetLastUsedTime() const
+{
+  return m_last_used_time.load(std::memory_order_relaxed);
+}
+
 CustomAssetLibrary::TimeType CustomAsset::GetLastWriteTime() const
 {
   return m_owning_library->GetLastAssetWriteTime(m_asset_id);
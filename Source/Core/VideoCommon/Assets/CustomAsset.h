@@ -6,6 +6,7 @@
 #include "Common/CommonTypes.h"
 #include "VideoCommon/Assets/CustomAssetLibrary.h"
 
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <optional>
@@ -28,6 +29,16 @@ public:
   // Loads the asset from the library returning a pass/fail result
   bool Load();
 
+  // Frees the loaded data, after which the asset behaves as if it was never loaded
+  void Unload();
+
+  // Records that the asset is in use right now, see 'GetLastUsedTime'
+  // Returns true if the asset was unloaded since it was last used
+  bool MarkUsed();
+
+  // The steady clock time, in ticks, of the last 'MarkUsed' call or 0 if the asset was never used
+  s64 GetLastUsedTime() const;
+
   // Queries the last time the asset was modified or standard epoch time
   // if the asset hasn't been modified yet
   // Note: not thread safe, expected to be called by the loader
@@ -48,11 +59,15 @@ protected:
 
 private:
   virtual CustomAssetLibrary::LoadInfo LoadImpl(const CustomAssetLibrary::AssetID& asset_id) = 0;
+  virtual void UnloadImpl() = 0;
   CustomAssetLibrary::AssetID m_asset_id;
 
   mutable std::mutex m_info_lock;
   std::size_t m_bytes_loaded = 0;
   CustomAssetLibrary::TimeType m_last_loaded_time = {};
+
+  std::atomic<s64> m_last_used_time = 0;
+  std::atomic_bool m_unloaded = false;
 };
 
 // An abstract class that is expected to
@@ -83,6 +98,14 @@ protected:
   bool m_loaded = false;
   mutable std::mutex m_data_lock;
   std::shared_ptr<UnderlyingType> m_data;
+
+private:
+  void UnloadImpl() override
+  {
+    std::lock_guard lk(m_data_lock);
+    m_loaded = false;
+    m_data.reset();
+  }
 };
 
 // A helper struct that contains
@@ -5,6 +5,8 @@
 
 #include "Common/Logging/Log.h"
 #include "Common/MemoryUtil.h"
+#include "Common/Thread.h"
+#include "Core/Config/GraphicsSettings.h"
 #include "VideoCommon/Assets/CustomAssetLibrary.h"
 
 namespace VideoCommon
@@ -19,6 +21,10 @@ void CustomAssetLoader::Init()
   m_max_memory_available =
       (sys_mem / 2 < recommended_min_mem) ? (sys_mem / 2) : (sys_mem - recommended_min_mem);
 
+  const int memory_budget_mib = Config::Get(Config::GFX_HIRES_TEXTURE_MEMORY_BUDGET);
+  if (memory_budget_mib > 0)
+    m_max_memory_available = size_t(memory_budget_mib) << 20;
+
   m_asset_monitor_thread = std::thread([this]() {
     Common::SetCurrentThreadName("Asset monitor");
     while (true)
@@ -45,43 +51,140 @@ void CustomAssetLoader::Init()
     }
   });
 
-  m_asset_load_thread.Reset("Custom Asset Loader", [this](std::weak_ptr<CustomAsset> asset) {
-    if (auto ptr = asset.lock())
-    {
-      if (ptr->Load())
-      {
-        std::lock_guard lk(m_asset_load_lock);
-        const std::size_t asset_memory_size = ptr->GetByteSizeInMemory();
-        if (m_max_memory_available >= m_total_bytes_loaded + asset_memory_size)
-        {
-          m_total_bytes_loaded += asset_memory_size;
-          m_assets_to_monitor.try_emplace(ptr->GetAssetId(), ptr);
-        }
-        else
-        {
-          ERROR_LOG_FMT(VIDEO, "Failed to load asset {} because there was not enough memory.",
-                        ptr->GetAssetId());
-        }
-      }
-    }
-  });
+  {
+    std::lock_guard lk(m_pending_assets_lock);
+    m_asset_load_thread_shutdown = false;
+  }
+  m_asset_load_thread = std::thread(&CustomAssetLoader::LoadThread, this);
 }
 
 void CustomAssetLoader ::Shutdown()
 {
-  m_asset_load_thread.Shutdown(true);
+  {
+    std::lock_guard lk(m_pending_assets_lock);
+    m_asset_load_thread_shutdown = true;
+  }
+  m_pending_assets_cv.notify_one();
+  m_asset_load_thread.join();
+
+  {
+    std::lock_guard lk(m_pending_assets_lock);
+    m_pending_assets.clear();
+  }
 
   m_asset_monitor_thread_shutdown.Set();
   m_asset_monitor_thread.join();
   m_assets_to_monitor.clear();
+  m_evictable_assets.clear();
   m_total_bytes_loaded = 0;
 }
 
+void CustomAssetLoader::QueueAsset(std::weak_ptr<CustomAsset> asset, bool evictable)
+{
+  {
+    std::lock_guard lk(m_pending_assets_lock);
+    m_pending_assets.push_back(PendingAsset{std::move(asset), evictable});
+  }
+  m_pending_assets_cv.notify_one();
+}
+
+void CustomAssetLoader::LoadThread()
+{
+  Common::SetCurrentThreadName("Custom Asset Loader");
+
+  std::unique_lock lk(m_pending_assets_lock);
+  while (true)
+  {
+    m_pending_assets_cv.wait(
+        lk, [this] { return m_asset_load_thread_shutdown || !m_pending_assets.empty(); });
+    if (m_asset_load_thread_shutdown)
+      break;
+
+    // Load the most recently used asset first. Assets that were never used are loaded in the
+    // order they were requested in.
+    auto next = m_pending_assets.begin();
+    s64 next_last_used = -1;
+    for (auto it = m_pending_assets.begin(); it != m_pending_assets.end(); ++it)
+    {
+      const std::shared_ptr<CustomAsset> asset = it->asset.lock();
+      const s64 last_used = asset ? asset->GetLastUsedTime() : 0;
+      if (last_used > next_last_used)
+      {
+        next = it;
+        next_last_used = last_used;
+      }
+    }
+    const PendingAsset pending = std::move(*next);
+    m_pending_assets.erase(next);
+
+    lk.unlock();
+    if (auto ptr = pending.asset.lock())
+      LoadAsset(ptr, pending.evictable);
+    lk.lock();
+  }
+}
+
+void CustomAssetLoader::LoadAsset(const std::shared_ptr<CustomAsset>& asset, bool evictable)
+{
+  if (!asset->Load())
+    return;
+
+  std::lock_guard lk(m_asset_load_lock);
+  const std::size_t asset_memory_size = asset->GetByteSizeInMemory();
+
+  // Evict the least recently used assets to make room, but only assets that were used less
+  // recently than the new one. Otherwise prefetching would keep replacing assets that are in use.
+  while (m_max_memory_available < m_total_bytes_loaded + asset_memory_size)
+  {
+    std::shared_ptr<CustomAsset> victim;
+    for (const auto& [asset_id, evictable_asset] : m_evictable_assets)
+    {
+      auto ptr = evictable_asset.lock();
+      if (ptr && ptr->GetLastUsedTime() < asset->GetLastUsedTime() &&
+          (!victim || ptr->GetLastUsedTime() < victim->GetLastUsedTime()))
+      {
+        victim = std::move(ptr);
+      }
+    }
+    if (!victim)
+      break;
+
+    m_total_bytes_loaded -= victim->GetByteSizeInMemory();
+    m_assets_to_monitor.erase(victim->GetAssetId());
+    m_evictable_assets.erase(victim->GetAssetId());
+    victim->Unload();
+  }
+
+  if (m_max_memory_available >= m_total_bytes_loaded + asset_memory_size)
+  {
+    m_total_bytes_loaded += asset_memory_size;
+    m_assets_to_monitor.try_emplace(asset->GetAssetId(), asset);
+    if (evictable)
+      m_evictable_assets.try_emplace(asset->GetAssetId(), asset);
+  }
+  else if (evictable)
+  {
+    // Loaded again once it gets used
+    asset->Unload();
+  }
+  else
+  {
+    ERROR_LOG_FMT(VIDEO, "Failed to load asset {} because there was not enough memory.",
+                  asset->GetAssetId());
+  }
+}
+
 std::shared_ptr<GameTextureAsset>
 CustomAssetLoader::LoadGameTexture(const CustomAssetLibrary::AssetID& asset_id,
                                    std::shared_ptr<CustomAssetLibrary> library)
 {
-  return LoadOrCreateAsset<GameTextureAsset>(asset_id, m_game_textures, std::move(library));
+  return LoadOrCreateAsset<GameTextureAsset>(asset_id, m_game_textures, std::move(library), true);
+}
+
+void CustomAssetLoader::MarkGameTextureUsed(const std::shared_ptr<GameTextureAsset>& asset)
+{
+  if (asset->MarkUsed())
+    QueueAsset(asset, true);
 }
 
 std::shared_ptr<PixelShaderAsset>
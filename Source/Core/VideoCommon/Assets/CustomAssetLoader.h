@@ -4,13 +4,14 @@
 #pragma once
 
 #include <chrono>
+#include <condition_variable>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <thread>
+#include <vector>
 
 #include "Common/Flag.h"
-#include "Common/WorkQueueThread.h"
 #include "VideoCommon/Assets/CustomAsset.h"
 #include "VideoCommon/Assets/MaterialAsset.h"
 #include "VideoCommon/Assets/ShaderAsset.h"
@@ -20,6 +21,10 @@ namespace VideoCommon
 {
 // This class is responsible for loading data asynchronously when requested
 // and watches that data asynchronously reloading it if it changes
+//
+// Pending assets are loaded in order of their last use, most recent first. Game textures are
+// streamed: once the loaded assets exceed the memory budget, the game textures that were used the
+// longest time ago are unloaded again, and are loaded again the next time they are used
 class CustomAssetLoader
 {
 public:
@@ -47,13 +52,27 @@ public:
   std::shared_ptr<MaterialAsset> LoadMaterial(const CustomAssetLibrary::AssetID& asset_id,
                                               std::shared_ptr<CustomAssetLibrary> library);
 
+  // Marks a game texture as used, which raises its load priority and protects it from eviction
+  // Queues it to be loaded again if it was evicted
+  void MarkGameTextureUsed(const std::shared_ptr<GameTextureAsset>& asset);
+
 private:
+  struct PendingAsset
+  {
+    std::weak_ptr<CustomAsset> asset;
+    bool evictable;
+  };
+
+  void QueueAsset(std::weak_ptr<CustomAsset> asset, bool evictable);
+  void LoadThread();
+  void LoadAsset(const std::shared_ptr<CustomAsset>& asset, bool evictable);
+
   // TODO C++20: use a 'derived_from' concept against 'CustomAsset' when available
   template <typename AssetType>
   std::shared_ptr<AssetType>
   LoadOrCreateAsset(const CustomAssetLibrary::AssetID& asset_id,
                     std::map<CustomAssetLibrary::AssetID, std::weak_ptr<AssetType>>& asset_map,
-                    std::shared_ptr<CustomAssetLibrary> library)
+                    std::shared_ptr<CustomAssetLibrary> library, bool evictable = false)
   {
     auto [it, inserted] = asset_map.try_emplace(asset_id);
     if (!inserted)
@@ -67,11 +86,12 @@ private:
         std::lock_guard lk(m_asset_load_lock);
         m_total_bytes_loaded -= a->GetByteSizeInMemory();
         m_assets_to_monitor.erase(a->GetAssetId());
+        m_evictable_assets.erase(a->GetAssetId());
       }
       delete a;
     });
     it->second = ptr;
-    m_asset_load_thread.Push(it->second);
+    QueueAsset(it->second, evictable);
     return ptr;
   }
 
@@ -87,10 +107,17 @@ private:
   std::size_t m_max_memory_available = 0;
 
   std::map<CustomAssetLibrary::AssetID, std::weak_ptr<CustomAsset>> m_assets_to_monitor;
+  // The loaded assets that may be unloaded to stay within 'm_max_memory_available'
+  std::map<CustomAssetLibrary::AssetID, std::weak_ptr<CustomAsset>> m_evictable_assets;
 
   // Use a recursive mutex to handle the scenario where an asset goes out of scope while
   // iterating over the assets to monitor which calls the lock above in 'LoadOrCreateAsset'
   std::recursive_mutex m_asset_load_lock;
-  Common::WorkQueueThread<std::weak_ptr<CustomAsset>> m_asset_load_thread;
+
+  std::thread m_asset_load_thread;
+  std::mutex m_pending_assets_lock;
+  std::condition_variable m_pending_assets_cv;
+  std::vector<PendingAsset> m_pending_assets;
+  bool m_asset_load_thread_shutdown = false;
 };
 }  // namespace VideoCommon
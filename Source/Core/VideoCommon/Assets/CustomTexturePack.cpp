@@ -0,0 +1,283 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/Assets/CustomTexturePack.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include "Common/Align.h"
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+#include "VideoCommon/AbstractTexture.h"
+#include "VideoCommon/TextureConfig.h"
+
+namespace VideoCommon
+{
+// Whether the level has a known format, consistent dimensions and at least the data that uploading
+// it reads
+static bool IsValidLevel(const CustomTexturePackLevel& level)
+{
+  if (level.format >= static_cast<u32>(AbstractTextureFormat::Undefined) || level.width == 0 ||
+      level.height == 0 || level.row_length < level.width)
+  {
+    return false;
+  }
+
+  const auto format = static_cast<AbstractTextureFormat>(level.format);
+  const u32 block_size = AbstractTexture::GetBlockSizeForFormat(format);
+  const u64 rows = (u64(level.height) + block_size - 1) / block_size;
+  const u32 stride = AbstractTexture::CalculateStrideForFormat(format, level.row_length);
+  return level.data_size >= rows * stride;
+}
+
+bool WriteCustomTexturePack(const std::string& path, std::vector<CustomTexturePackInput> textures)
+{
+  // FindTexture relies on the texture table being sorted by name
+  std::sort(textures.begin(), textures.end(),
+            [](const auto& a, const auto& b) { return a.name < b.name; });
+  const auto duplicate =
+      std::adjacent_find(textures.begin(), textures.end(),
+                         [](const auto& a, const auto& b) { return a.name == b.name; });
+  if (duplicate != textures.end())
+  {
+    ERROR_LOG_FMT(VIDEO, "Texture pack {} would contain {} more than once", path, duplicate->name);
+    return false;
+  }
+
+  std::vector<CustomTexturePackTexture> texture_table;
+  std::vector<CustomTexturePackLevel> level_table;
+  std::string strings;
+
+  texture_table.reserve(textures.size());
+  for (const CustomTexturePackInput& input : textures)
+  {
+    CustomTexturePackTexture& texture = texture_table.emplace_back();
+    texture.name_offset = static_cast<u32>(strings.size());
+    texture.name_size = static_cast<u32>(input.name.size());
+    texture.first_level = static_cast<u32>(level_table.size());
+    texture.level_count = static_cast<u32>(input.slice.m_levels.size());
+    texture.flags = input.has_arbitrary_mipmaps ? TEXTURE_FLAG_ARBITRARY_MIPMAPS : 0;
+    texture.padding = 0;
+    strings += input.name;
+
+    for (const CustomTextureData::ArraySlice::Level& input_level : input.slice.m_levels)
+    {
+      CustomTexturePackLevel& level = level_table.emplace_back();
+      level.data_size = input_level.data.size();
+      level.format = static_cast<u32>(input_level.format);
+      level.width = input_level.width;
+      level.height = input_level.height;
+      level.row_length = input_level.row_length;
+      if (!IsValidLevel(level))
+      {
+        ERROR_LOG_FMT(VIDEO, "Texture pack {} would contain an invalid level of {}", path,
+                      input.name);
+        return false;
+      }
+    }
+  }
+
+  const u64 tables_size = sizeof(CustomTexturePackHeader) +
+                          texture_table.size() * sizeof(CustomTexturePackTexture) +
+                          level_table.size() * sizeof(CustomTexturePackLevel) + strings.size();
+  if (tables_size > std::numeric_limits<u32>::max())
+  {
+    ERROR_LOG_FMT(VIDEO, "Texture pack {} would have too many textures", path);
+    return false;
+  }
+
+  CustomTexturePackHeader header{};
+  header.magic = CUSTOM_TEXTURE_PACK_MAGIC;
+  header.version = CUSTOM_TEXTURE_PACK_VERSION;
+  header.texture_count = static_cast<u32>(texture_table.size());
+  header.level_count = static_cast<u32>(level_table.size());
+  header.texture_table_offset = sizeof(CustomTexturePackHeader);
+  header.level_table_offset =
+      header.texture_table_offset +
+      static_cast<u32>(texture_table.size() * sizeof(CustomTexturePackTexture));
+  header.string_pool_offset =
+      header.level_table_offset +
+      static_cast<u32>(level_table.size() * sizeof(CustomTexturePackLevel));
+  header.string_pool_size = static_cast<u32>(strings.size());
+
+  u64 data_offset = Common::AlignUp(tables_size, CUSTOM_TEXTURE_PACK_DATA_ALIGNMENT);
+  for (CustomTexturePackLevel& level : level_table)
+  {
+    level.data_offset = data_offset;
+    data_offset =
+        Common::AlignUp(data_offset + level.data_size, CUSTOM_TEXTURE_PACK_DATA_ALIGNMENT);
+  }
+
+  File::IOFile file(path, "wb");
+  if (!file.IsOpen() || !file.WriteArray(&header, 1) ||
+      !file.WriteArray(texture_table.data(), texture_table.size()) ||
+      !file.WriteArray(level_table.data(), level_table.size()) ||
+      !file.WriteBytes(strings.data(), strings.size()))
+  {
+    ERROR_LOG_FMT(VIDEO, "Failed to write texture pack {}", path);
+    return false;
+  }
+
+  size_t level_index = 0;
+  for (const CustomTexturePackInput& input : textures)
+  {
+    for (const CustomTextureData::ArraySlice::Level& input_level : input.slice.m_levels)
+    {
+      if (!file.Seek(level_table[level_index++].data_offset, File::SeekOrigin::Begin) ||
+          !file.WriteBytes(input_level.data.data(), input_level.data.size()))
+      {
+        ERROR_LOG_FMT(VIDEO, "Failed to write texture pack {}", path);
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+bool CustomTexturePack::Open(const std::string& path)
+{
+  Close();
+
+  if (!m_file.Open(path))
+    return false;
+
+  const u8* data = m_file.GetData();
+  const u64 size = m_file.GetSize();
+
+  if (size < sizeof(CustomTexturePackHeader))
+  {
+    ERROR_LOG_FMT(VIDEO, "Texture pack {} is truncated", path);
+    Close();
+    return false;
+  }
+
+  std::memcpy(&m_header, data, sizeof(CustomTexturePackHeader));
+  if (m_header.magic != CUSTOM_TEXTURE_PACK_MAGIC ||
+      m_header.version != CUSTOM_TEXTURE_PACK_VERSION)
+  {
+    ERROR_LOG_FMT(VIDEO, "Texture pack {} has an unsupported format", path);
+    Close();
+    return false;
+  }
+
+  const u64 textures_end = u64(m_header.texture_table_offset) +
+                           u64(m_header.texture_count) * sizeof(CustomTexturePackTexture);
+  const u64 levels_end = u64(m_header.level_table_offset) +
+                         u64(m_header.level_count) * sizeof(CustomTexturePackLevel);
+  const u64 strings_end = u64(m_header.string_pool_offset) + m_header.string_pool_size;
+  if (textures_end > size || levels_end > size || strings_end > size)
+  {
+    ERROR_LOG_FMT(VIDEO, "Texture pack {} is truncated", path);
+    Close();
+    return false;
+  }
+
+  m_textures =
+      reinterpret_cast<const CustomTexturePackTexture*>(data + m_header.texture_table_offset);
+  m_levels = reinterpret_cast<const CustomTexturePackLevel*>(data + m_header.level_table_offset);
+  m_strings = reinterpret_cast<const char*>(data + m_header.string_pool_offset);
+
+  // Validate references once so that accessors don't have to
+  for (u32 i = 0; i < m_header.texture_count; i++)
+  {
+    const CustomTexturePackTexture& texture = m_textures[i];
+    if (u64(texture.name_offset) + texture.name_size > m_header.string_pool_size ||
+        u64(texture.first_level) + texture.level_count > m_header.level_count)
+    {
+      ERROR_LOG_FMT(VIDEO, "Texture pack {} is corrupted", path);
+      Close();
+      return false;
+    }
+  }
+  for (u32 i = 0; i < m_header.level_count; i++)
+  {
+    const CustomTexturePackLevel& level = m_levels[i];
+    if (level.data_offset > size || level.data_size > size - level.data_offset ||
+        !IsValidLevel(level))
+    {
+      ERROR_LOG_FMT(VIDEO, "Texture pack {} is corrupted", path);
+      Close();
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void CustomTexturePack::Close()
+{
+  m_file.Close();
+  m_header = {};
+  m_textures = nullptr;
+  m_levels = nullptr;
+  m_strings = nullptr;
+}
+
+std::string_view CustomTexturePack::GetTextureName(u32 texture_index) const
+{
+  const CustomTexturePackTexture& texture = m_textures[texture_index];
+  return std::string_view(m_strings + texture.name_offset, texture.name_size);
+}
+
+bool CustomTexturePack::HasArbitraryMipmaps(u32 texture_index) const
+{
+  return (m_textures[texture_index].flags & TEXTURE_FLAG_ARBITRARY_MIPMAPS) != 0;
+}
+
+std::span<const CustomTexturePackLevel> CustomTexturePack::GetLevels(u32 texture_index) const
+{
+  const CustomTexturePackTexture& texture = m_textures[texture_index];
+  return std::span<const CustomTexturePackLevel>(m_levels + texture.first_level,
+                                                 texture.level_count);
+}
+
+std::span<const u8> CustomTexturePack::GetLevelData(const CustomTexturePackLevel& level) const
+{
+  return m_file.GetSpan().subspan(level.data_offset, level.data_size);
+}
+
+size_t CustomTexturePack::LoadTexture(u32 texture_index,
+                                      CustomTextureData::ArraySlice* slice) const
+{
+  const std::span<const CustomTexturePackLevel> levels = GetLevels(texture_index);
+
+  // Start reading the whole texture before copying the first level
+  if (!levels.empty())
+  {
+    const u64 start = levels.front().data_offset;
+    m_file.Prefetch(start, levels.back().data_offset + levels.back().data_size - start);
+  }
+
+  size_t bytes_loaded = 0;
+  slice->m_levels.clear();
+  slice->m_levels.reserve(levels.size());
+  for (const CustomTexturePackLevel& level : levels)
+  {
+    const std::span<const u8> data = GetLevelData(level);
+    CustomTextureData::ArraySlice::Level& out_level = slice->m_levels.emplace_back();
+    out_level.data.assign(data.begin(), data.end());
+    out_level.format = static_cast<AbstractTextureFormat>(level.format);
+    out_level.width = level.width;
+    out_level.height = level.height;
+    out_level.row_length = level.row_length;
+    bytes_loaded += data.size();
+  }
+
+  return bytes_loaded;
+}
+
+std::optional<u32> CustomTexturePack::FindTexture(std::string_view name) const
+{
+  const auto begin = m_textures;
+  const auto end = m_textures + m_header.texture_count;
+  const auto it = std::lower_bound(begin, end, name, [this](const auto& texture, auto value) {
+    return std::string_view(m_strings + texture.name_offset, texture.name_size) < value;
+  });
+  if (it == end || GetTextureName(static_cast<u32>(it - begin)) != name)
+    return std::nullopt;
+  return static_cast<u32>(it - begin);
+}
+}  // namespace VideoCommon
@@ -0,0 +1,112 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/MappedFile.h"
+#include "VideoCommon/Assets/CustomTextureData.h"
+
+namespace VideoCommon
+{
+// Packed custom textures (.dtp), generated from a directory of custom textures with
+// "dolphin-tool textures pack" and memory-mapped when custom textures are loaded.
+//
+// Every mip level is stored in the format it is uploaded in, so loading a texture from a pack
+// is a copy instead of decoding a PNG or parsing a DDS file.
+//
+// Layout: header, texture table sorted by name, level table grouped by texture, a string pool
+// holding the names (not null-terminated), then the level data, each level aligned to
+// CUSTOM_TEXTURE_PACK_DATA_ALIGNMENT. All values are stored in host byte order, a pack with the
+// wrong byte order is rejected by its magic.
+const std::string CustomTexturePackExtension = ".dtp";
+
+constexpr u32 CUSTOM_TEXTURE_PACK_MAGIC = 0x4B505444;  // "DTPK"
+constexpr u32 CUSTOM_TEXTURE_PACK_VERSION = 1;
+constexpr u32 CUSTOM_TEXTURE_PACK_DATA_ALIGNMENT = 64;
+
+#pragma pack(push, 1)
+struct CustomTexturePackHeader
+{
+  u32 magic;
+  u32 version;
+  u32 texture_count;
+  u32 level_count;
+  u32 texture_table_offset;
+  u32 level_table_offset;
+  u32 string_pool_offset;
+  u32 string_pool_size;
+};
+static_assert(sizeof(CustomTexturePackHeader) == 0x20, "Wrong size for texture pack header");
+
+enum CustomTexturePackTextureFlags : u32
+{
+  TEXTURE_FLAG_ARBITRARY_MIPMAPS = 1 << 0,
+};
+
+struct CustomTexturePackTexture
+{
+  u32 name_offset;
+  u32 name_size;
+  u32 first_level;
+  u32 level_count;
+  u32 flags;
+  u32 padding;
+};
+static_assert(sizeof(CustomTexturePackTexture) == 0x18, "Wrong size for texture pack texture");
+
+struct CustomTexturePackLevel
+{
+  u64 data_offset;
+  u64 data_size;
+  u32 format;  // AbstractTextureFormat
+  u32 width;
+  u32 height;
+  u32 row_length;
+};
+static_assert(sizeof(CustomTexturePackLevel) == 0x20, "Wrong size for texture pack level");
+#pragma pack(pop)
+
+struct CustomTexturePackInput
+{
+  std::string name;
+  bool has_arbitrary_mipmaps = false;
+  CustomTextureData::ArraySlice slice;
+};
+
+// The inputs don't have to be sorted
+bool WriteCustomTexturePack(const std::string& path, std::vector<CustomTexturePackInput> textures);
+
+class CustomTexturePack
+{
+public:
+  bool Open(const std::string& path);
+  void Close();
+  bool IsOpen() const { return m_file.IsOpen(); }
+
+  u32 GetTextureCount() const { return m_header.texture_count; }
+  std::string_view GetTextureName(u32 texture_index) const;
+  bool HasArbitraryMipmaps(u32 texture_index) const;
+  std::span<const CustomTexturePackLevel> GetLevels(u32 texture_index) const;
+  std::span<const u8> GetLevelData(const CustomTexturePackLevel& level) const;
+
+  // Copies the levels of a texture into a slice, returns the number of bytes copied
+  size_t LoadTexture(u32 texture_index, CustomTextureData::ArraySlice* slice) const;
+
+  // Binary search in the sorted texture table
+  std::optional<u32> FindTexture(std::string_view name) const;
+
+private:
+  File::MappedFile m_file;
+  CustomTexturePackHeader m_header{};
+  const CustomTexturePackTexture* m_textures = nullptr;
+  const CustomTexturePackLevel* m_levels = nullptr;
+  const char* m_strings = nullptr;
+};
+}  // namespace VideoCommon
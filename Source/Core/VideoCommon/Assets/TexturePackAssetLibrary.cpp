@@ -0,0 +1,81 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/Assets/TexturePackAssetLibrary.h"
+
+#include <chrono>
+
+#include "Common/Logging/Log.h"
+#include "VideoCommon/Assets/TextureAsset.h"
+
+namespace VideoCommon
+{
+CustomAssetLibrary::LoadInfo TexturePackAssetLibrary::LoadTexture(const AssetID& asset_id,
+                                                                  TextureData* data)
+{
+  std::shared_ptr<const CustomTexturePack> pack;
+  u32 texture_index = 0;
+  TimeType add_time;
+  {
+    std::lock_guard lk(m_lock);
+    const auto iter = m_asset_locations.find(asset_id);
+    if (iter == m_asset_locations.end())
+    {
+      ERROR_LOG_FMT(VIDEO, "Asset '{}' error - not found in any texture pack!", asset_id);
+      return {};
+    }
+    pack = iter->second.pack;
+    texture_index = iter->second.texture_index;
+    add_time = iter->second.add_time;
+  }
+
+  data->m_type = TextureData::Type::Type_Texture2D;
+  data->m_texture.m_slices.resize(1);
+  const std::size_t bytes_loaded = pack->LoadTexture(texture_index, &data->m_texture.m_slices[0]);
+  if (bytes_loaded == 0)
+  {
+    ERROR_LOG_FMT(VIDEO, "Asset '{}' error - texture pack entry has no data!", asset_id);
+    return {};
+  }
+
+  return LoadInfo{bytes_loaded, add_time};
+}
+
+CustomAssetLibrary::LoadInfo TexturePackAssetLibrary::LoadPixelShader(const AssetID& asset_id,
+                                                                      PixelShaderData*)
+{
+  ERROR_LOG_FMT(VIDEO, "Asset '{}' error - texture packs can't hold pixel shaders!", asset_id);
+  return {};
+}
+
+CustomAssetLibrary::LoadInfo TexturePackAssetLibrary::LoadMaterial(const AssetID& asset_id,
+                                                                   MaterialData*)
+{
+  ERROR_LOG_FMT(VIDEO, "Asset '{}' error - texture packs can't hold materials!", asset_id);
+  return {};
+}
+
+CustomAssetLibrary::TimeType
+TexturePackAssetLibrary::GetLastAssetWriteTime(const AssetID& asset_id) const
+{
+  std::lock_guard lk(m_lock);
+  if (const auto iter = m_asset_locations.find(asset_id); iter != m_asset_locations.end())
+    return iter->second.add_time;
+  return {};
+}
+
+void TexturePackAssetLibrary::SetAssetLocation(const AssetID& asset_id,
+                                               std::shared_ptr<const CustomTexturePack> pack,
+                                               u32 texture_index)
+{
+  std::lock_guard lk(m_lock);
+  m_asset_locations[asset_id] =
+      AssetLocation{std::move(pack), texture_index, std::chrono::system_clock::now()};
+}
+
+bool TexturePackAssetLibrary::HasAsset(const AssetID& asset_id) const
+{
+  std::lock_guard lk(m_lock);
+  return m_asset_locations.contains(asset_id);
+}
+}  // namespace VideoCommon
@@ -0,0 +1,44 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/Assets/CustomAssetLibrary.h"
+#include "VideoCommon/Assets/CustomTexturePack.h"
+
+namespace VideoCommon
+{
+// This class implements 'CustomAssetLibrary' and loads textures from memory-mapped
+// texture packs. Packs only hold textures, loading any other asset fails
+class TexturePackAssetLibrary final : public CustomAssetLibrary
+{
+public:
+  LoadInfo LoadTexture(const AssetID& asset_id, TextureData* data) override;
+  LoadInfo LoadPixelShader(const AssetID& asset_id, PixelShaderData* data) override;
+  LoadInfo LoadMaterial(const AssetID& asset_id, MaterialData* data) override;
+
+  // Packs can't change while they are mapped, so this is the time the asset was added
+  TimeType GetLastAssetWriteTime(const AssetID& asset_id) const override;
+
+  // Assigns the asset id to a texture of an open pack
+  void SetAssetLocation(const AssetID& asset_id, std::shared_ptr<const CustomTexturePack> pack,
+                        u32 texture_index);
+  bool HasAsset(const AssetID& asset_id) const;
+
+private:
+  struct AssetLocation
+  {
+    std::shared_ptr<const CustomTexturePack> pack;
+    u32 texture_index;
+    TimeType add_time;
+  };
+
+  mutable std::mutex m_lock;
+  std::map<AssetID, AssetLocation> m_asset_locations;
+};
+}  // namespace VideoCommon
@@ -172,6 +172,10 @@ void AsyncRequests::HandleEvent(const AsyncRequests::Event& e)
     g_perf_query->FlushResults();
     break;
 
+  case Event::PERF_QUERY_POLL:
+    g_perf_query->PollResults();
+    break;
+
   case Event::DO_SAVE_STATE:
     VideoCommon_DoState(*e.do_save_state.p);
     break;
@@ -29,6 +29,7 @@ public:
       BBOX_READ,
       FIFO_RESET,
       PERF_QUERY,
+      PERF_QUERY_POLL,
       DO_SAVE_STATE,
     } type;
     u64 time;
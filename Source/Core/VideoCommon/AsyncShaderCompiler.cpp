@@ -3,16 +3,23 @@
 
 #include "VideoCommon/AsyncShaderCompiler.h"
 
+#include <algorithm>
 #include <thread>
 
 #include "Common/Assert.h"
+#include "Common/Counters.h"
 #include "Common/Logging/Log.h"
 #include "Common/Thread.h"
+#include "Common/TraceEvents.h"
 
 #include "Core/Core.h"
 
 namespace VideoCommon
 {
+static Common::Counter s_pending_compiles("dolphin_shader_compile_queue_depth",
+                                          "Shaders waiting for a compiler worker",
+                                          Common::Counter::Type::Gauge);
+
 AsyncShaderCompiler::AsyncShaderCompiler()
 {
 }
@@ -24,20 +31,84 @@ AsyncShaderCompiler::~AsyncShaderCompiler()
   ASSERT(!HasWorkerThreads());
 }
 
-void AsyncShaderCompiler::QueueWorkItem(WorkItemPtr item, u32 priority)
+AsyncShaderCompiler::WorkItemID AsyncShaderCompiler::QueueWorkItem(WorkItemPtr item, u32 priority)
 {
   // If no worker threads are available, compile synchronously.
   if (!HasWorkerThreads())
   {
     item->Compile();
     m_completed_work.push_back(std::move(item));
+    return 0;
   }
-  else
-  {
-    std::lock_guard<std::mutex> guard(m_pending_work_lock);
-    m_pending_work.emplace(priority, std::move(item));
-    m_worker_thread_wake.notify_one();
-  }
+
+  std::lock_guard<std::mutex> guard(m_pending_work_lock);
+  const WorkItemID id = m_next_work_item_id++;
+  const auto iter = m_pending_work.emplace(
+      priority, PendingWorkItem{std::move(item), id, std::chrono::steady_clock::now()});
+  m_pending_work_by_id.emplace(id, iter);
+  s_pending_compiles.Set(m_pending_work.size());
+  if (priority < m_speculative_priority)
+    m_queued_deadline_work = true;
+  m_worker_thread_wake.notify_one();
+  return id;
+}
+
+void AsyncShaderCompiler::RaiseWorkItemPriority(WorkItemID id, u32 priority)
+{
+  std::lock_guard<std::mutex> guard(m_pending_work_lock);
+  const auto id_iter = m_pending_work_by_id.find(id);
+  if (id_iter == m_pending_work_by_id.end() || id_iter->second->first <= priority)
+    return;
+
+  // Keeps the queue time, so the latency includes the time spent waiting as speculative work
+  PendingWorkItem pending = std::move(id_iter->second->second);
+  m_pending_work.erase(id_iter->second);
+  id_iter->second = m_pending_work.emplace(priority, std::move(pending));
+  if (priority < m_speculative_priority)
+    m_queued_deadline_work = true;
+
+  // A worker may be waiting because the speculative workers are busy
+  m_worker_thread_wake.notify_one();
+}
+
+void AsyncShaderCompiler::SetSpeculativePriority(u32 priority)
+{
+  std::lock_guard<std::mutex> guard(m_pending_work_lock);
+  m_speculative_priority = priority;
+}
+
+void AsyncShaderCompiler::SetMaxSpeculativeWorkers(u32 num_workers)
+{
+  std::lock_guard<std::mutex> guard(m_pending_work_lock);
+  if (num_workers > m_max_speculative_workers)
+    m_worker_thread_wake.notify_all();
+  m_max_speculative_workers = num_workers;
+}
+
+bool AsyncShaderCompiler::TakeQueuedDeadlineWork()
+{
+  std::lock_guard<std::mutex> guard(m_pending_work_lock);
+  return std::exchange(m_queued_deadline_work, false);
+}
+
+AsyncShaderCompiler::Stats AsyncShaderCompiler::GetStats()
+{
+  std::lock_guard<std::mutex> guard(m_pending_work_lock);
+  Stats stats;
+  stats.pending_items = m_pending_work.size();
+  stats.pending_speculative_items = static_cast<size_t>(
+      std::distance(m_pending_work.lower_bound(m_speculative_priority), m_pending_work.end()));
+  stats.busy_workers = m_busy_workers.load();
+  stats.max_speculative_workers = std::min(m_max_speculative_workers, m_worker_threads.size());
+  stats.average_latency_ms = m_average_latency_ms;
+  stats.average_codegen_ms = m_average_codegen_ms;
+  return stats;
+}
+
+void AsyncShaderCompiler::AddCodegenTime(double ms)
+{
+  std::lock_guard<std::mutex> guard(m_pending_work_lock);
+  m_average_codegen_ms += (ms - m_average_codegen_ms) / 16.0;
 }
 
 void AsyncShaderCompiler::RetrieveWorkItems()
@@ -142,6 +213,12 @@ bool AsyncShaderCompiler::StartWorkerThreads(u32 num_worker_threads)
     m_worker_threads.push_back(std::move(thr));
   }
 
+  {
+    std::lock_guard<std::mutex> guard(m_pending_work_lock);
+    m_max_speculative_workers = m_worker_threads.size();
+    m_worker_thread_wake.notify_all();
+  }
+
   return HasWorkerThreads();
 }
 
@@ -159,6 +236,11 @@ bool AsyncShaderCompiler::HasWorkerThreads() const
   return !m_worker_threads.empty();
 }
 
+u32 AsyncShaderCompiler::GetWorkerThreadCount() const
+{
+  return static_cast<u32>(m_worker_threads.size());
+}
+
 void AsyncShaderCompiler::StopWorkerThreads()
 {
   if (!HasWorkerThreads())
@@ -222,20 +304,44 @@ void AsyncShaderCompiler::WorkerThreadRun()
 
     while (!m_pending_work.empty() && !m_exit_flag.IsSet())
     {
-      m_busy_workers++;
+      // Items are sorted by priority, so if the first item is speculative, all of them are.
+      // Leave them for the speculative workers, this worker is woken again by new work.
       auto iter = m_pending_work.begin();
-      WorkItemPtr item(std::move(iter->second));
+      const bool speculative = iter->first >= m_speculative_priority;
+      if (speculative && m_busy_speculative_workers >= m_max_speculative_workers)
+        break;
+
+      m_busy_workers++;
+      if (speculative)
+        m_busy_speculative_workers++;
+      WorkItemPtr item(std::move(iter->second.item));
+      const auto queue_time = iter->second.queue_time;
+      m_pending_work_by_id.erase(iter->second.id);
       m_pending_work.erase(iter);
+      s_pending_compiles.Set(m_pending_work.size());
       pending_lock.unlock();
 
-      if (item->Compile())
+      bool compiled;
+      {
+        TRACE_SCOPE("Compile shader");
+        compiled = item->Compile();
+      }
+      if (compiled)
       {
         std::lock_guard<std::mutex> completed_guard(m_completed_work_lock);
         m_completed_work.push_back(std::move(item));
       }
 
+      const double latency_ms = std::chrono::duration<double, std::milli>(
+                                    std::chrono::steady_clock::now() - queue_time)
+                                    .count();
+
       pending_lock.lock();
       m_busy_workers--;
+      if (speculative)
+        m_busy_speculative_workers--;
+      else
+        m_average_latency_ms += (latency_ms - m_average_latency_ms) / 16.0;
     }
   }
 }
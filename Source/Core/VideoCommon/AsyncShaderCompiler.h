@@ -4,13 +4,16 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <deque>
 #include <functional>
+#include <limits>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <thread>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -33,6 +36,21 @@ public:
 
   using WorkItemPtr = std::unique_ptr<WorkItem>;
 
+  // Identifies a queued work item while it is pending. Zero is never a valid ID.
+  using WorkItemID = u64;
+
+  struct Stats
+  {
+    size_t pending_items = 0;
+    size_t pending_speculative_items = 0;
+    size_t busy_workers = 0;
+    size_t max_speculative_workers = 0;
+    // Smoothed time from queueing to finishing the compile, for work that isn't speculative
+    double average_latency_ms = 0.0;
+    // Smoothed time that generating the source of a shader takes, before it's compiled
+    double average_codegen_ms = 0.0;
+  };
+
   AsyncShaderCompiler();
   virtual ~AsyncShaderCompiler();
 
@@ -43,8 +61,28 @@ public:
   }
 
   // Queues a new work item to the compiler threads. The lower the priority, the sooner
-  // this work item will be compiled, relative to the other work items.
-  void QueueWorkItem(WorkItemPtr item, u32 priority);
+  // this work item will be compiled, relative to the other work items. Returns 0 if the item was
+  // compiled immediately, because there are no worker threads.
+  WorkItemID QueueWorkItem(WorkItemPtr item, u32 priority);
+
+  // Moves a pending work item forward to the given priority. Does nothing if the item was already
+  // started, or is queued with a lower priority value already.
+  void RaiseWorkItemPriority(WorkItemID id, u32 priority);
+
+  // Work items queued with this priority or a higher value are speculative: nothing is waiting for
+  // them, so they are limited to the speculative workers and yield to all other work.
+  void SetSpeculativePriority(u32 priority);
+
+  // Limits the number of workers that may compile speculative work items at the same time. Other
+  // work items can use every worker. Reset to the number of workers when threads are started.
+  void SetMaxSpeculativeWorkers(u32 num_workers);
+
+  // Reports whether work items that aren't speculative were queued since the last call.
+  bool TakeQueuedDeadlineWork();
+
+  Stats GetStats();
+  void AddCodegenTime(double ms);
+
   void RetrieveWorkItems();
   bool HasPendingWork();
   bool HasCompletedWork();
@@ -57,6 +95,7 @@ public:
   bool StartWorkerThreads(u32 num_worker_threads);
   bool ResizeWorkerThreads(u32 num_worker_threads);
   bool HasWorkerThreads() const;
+  u32 GetWorkerThreadCount() const;
   void StopWorkerThreads();
 
 protected:
@@ -74,13 +113,31 @@ private:
   std::vector<std::thread> m_worker_threads;
   std::atomic_bool m_worker_thread_start_result{false};
 
+  struct PendingWorkItem
+  {
+    WorkItemPtr item;
+    WorkItemID id;
+    std::chrono::steady_clock::time_point queue_time;
+  };
+  using PendingWorkMap = std::multimap<u32, PendingWorkItem>;
+
   // A multimap is used to store the work items. We can't use a priority_queue here, because
   // there's no way to obtain a non-const reference, which we need for the unique_ptr.
-  std::multimap<u32, WorkItemPtr> m_pending_work;
+  PendingWorkMap m_pending_work;
+  std::unordered_map<WorkItemID, PendingWorkMap::iterator> m_pending_work_by_id;
+  WorkItemID m_next_work_item_id = 1;
   std::mutex m_pending_work_lock;
   std::condition_variable m_worker_thread_wake;
   std::atomic_size_t m_busy_workers{0};
 
+  // Guarded by m_pending_work_lock
+  u32 m_speculative_priority = std::numeric_limits<u32>::max();
+  size_t m_max_speculative_workers = 0;
+  size_t m_busy_speculative_workers = 0;
+  bool m_queued_deadline_work = false;
+  double m_average_latency_ms = 0.0;
+  double m_average_codegen_ms = 0.0;
+
   std::deque<WorkItemPtr> m_completed_work;
   std::mutex m_completed_work_lock;
 };
@@ -38,6 +38,7 @@
 #include "VideoCommon/TMEM.h"
 #include "VideoCommon/TextureCacheBase.h"
 #include "VideoCommon/TextureDecoder.h"
+#include "VideoCommon/VertexManagerBase.h"
 #include "VideoCommon/VertexShaderManager.h"
 #include "VideoCommon/VideoBackendBase.h"
 #include "VideoCommon/VideoCommon.h"
@@ -55,6 +56,36 @@ void BPInit()
   bpmem.bpMask = 0xFFFFFF;
 }
 
+// Registers that none of the shader UIDs are generated from, so writing them doesn't need the UIDs
+// to be generated again. Anything not listed here is assumed to change them.
+static bool IsShaderUidRegister(u32 address)
+{
+  if ((address >= BPMEM_IND_MTXA && address < BPMEM_IND_IMASK) ||
+      (address >= BPMEM_SU_SSIZE && address < BPMEM_ZMODE) ||
+      (address >= BPMEM_SETDRAWDONE && address <= BPMEM_COPYFILTER1) ||
+      (address >= BPMEM_PRELOAD_ADDR && address <= BPMEM_TEXINVALIDATE) ||
+      (address >= BPMEM_TX_SETMODE0 && address < BPMEM_TEV_COLOR_ENV) ||
+      (address >= BPMEM_TEV_COLOR_RA && address < BPMEM_FOGRANGE) ||
+      (address > BPMEM_FOGRANGE && address <= BPMEM_FOGBEXPONENT))
+  {
+    return false;
+  }
+
+  switch (address)
+  {
+  case BPMEM_SCISSORTL:
+  case BPMEM_SCISSORBR:
+  case BPMEM_PERF0_TRI:
+  case BPMEM_PERF0_QUAD:
+  case BPMEM_SCISSOROFFSET:
+  case BPMEM_FOGCOLOR:
+  case BPMEM_BIAS:
+    return false;
+  default:
+    return true;
+  }
+}
+
 static void BPWritten(PixelShaderManager& pixel_shader_manager,
                       VertexShaderManager& vertex_shader_manager,
                       GeometryShaderManager& geometry_shader_manager, const BPCmd& bp,
@@ -98,6 +129,9 @@ static void BPWritten(PixelShaderManager& pixel_shader_manager,
 
   ((u32*)&bpmem)[bp.address] = bp.newvalue;
 
+  if (IsShaderUidRegister(bp.address))
+    g_vertex_manager->SetShaderUidsChanged();
+
   switch (bp.address)
   {
   case BPMEM_GENMODE:  // Set the Generation Mode
@@ -9,6 +9,7 @@
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 #include "VideoCommon/PixelShaderManager.h"
+#include "VideoCommon/VertexManagerBase.h"
 #include "VideoCommon/VideoConfig.h"
 
 #include <algorithm>
@@ -19,12 +20,14 @@ void BoundingBox::Enable(PixelShaderManager& pixel_shader_manager)
 {
   m_is_active = true;
   pixel_shader_manager.SetBoundingBoxActive(m_is_active);
+  g_vertex_manager->SetShaderUidsChanged();
 }
 
 void BoundingBox::Disable(PixelShaderManager& pixel_shader_manager)
 {
   m_is_active = false;
   pixel_shader_manager.SetBoundingBoxActive(m_is_active);
+  g_vertex_manager->SetShaderUidsChanged();
 }
 
 void BoundingBox::Flush()
@@ -32,7 +35,7 @@ void BoundingBox::Flush()
   if (!g_ActiveConfig.bBBoxEnable || !g_ActiveConfig.backend_info.bSupportsBBox)
     return;
 
-  m_is_valid = false;
+  InvalidateDrawnValues();
 
   if (std::none_of(m_dirty.begin(), m_dirty.end(), [](bool dirty) { return dirty; }))
     return;
@@ -55,6 +58,64 @@ void BoundingBox::Flush()
   }
 }
 
+void BoundingBox::AddEstimatedBounds(const MathUtil::Rectangle<int>& bounds)
+{
+  if (bounds.left >= bounds.right || bounds.top >= bounds.bottom)
+  {
+    m_has_estimate = true;
+    return;
+  }
+
+  if (!m_has_estimate || m_estimate.left >= m_estimate.right)
+  {
+    m_estimate = bounds;
+  }
+  else
+  {
+    m_estimate.left = std::min(m_estimate.left, bounds.left);
+    m_estimate.top = std::min(m_estimate.top, bounds.top);
+    m_estimate.right = std::max(m_estimate.right, bounds.right);
+    m_estimate.bottom = std::max(m_estimate.bottom, bounds.bottom);
+  }
+  m_has_estimate = true;
+}
+
+void BoundingBox::AddUnboundedDraw()
+{
+  m_has_estimate = true;
+  m_estimate_unbounded = true;
+}
+
+void BoundingBox::InvalidateDrawnValues()
+{
+  if (!m_has_estimate || m_estimate_unbounded)
+  {
+    m_is_valid.fill(false);
+  }
+  else if (m_estimate.left < m_estimate.right)
+  {
+    // The GPU only ever moves the values outwards, to the 2x2 pixel group of a drawn pixel. A value
+    // is unchanged if no pixel of the draw can be beyond it. Dirty values are compared as well, as
+    // they are written before the draw.
+    const int left = m_estimate.left & ~1;
+    const int right = (m_estimate.right - 1) | 1;
+    const int top = m_estimate.top & ~1;
+    const int bottom = (m_estimate.bottom - 1) | 1;
+    if (left < m_values[0])
+      m_is_valid[0] = false;
+    if (right > m_values[1])
+      m_is_valid[1] = false;
+    if (top < m_values[2])
+      m_is_valid[2] = false;
+    if (bottom > m_values[3])
+      m_is_valid[3] = false;
+  }
+
+  m_has_estimate = false;
+  m_estimate_unbounded = false;
+  m_estimate = {};
+}
+
 void BoundingBox::Readback()
 {
   if (!g_ActiveConfig.backend_info.bSupportsBBox)
@@ -69,7 +130,7 @@ void BoundingBox::Readback()
       m_values[i] = read_values[i];
   }
 
-  m_is_valid = true;
+  m_is_valid.fill(true);
 }
 
 u16 BoundingBox::Get(u32 index)
@@ -79,7 +140,7 @@ u16 BoundingBox::Get(u32 index)
   if (!g_ActiveConfig.bBBoxEnable || !g_ActiveConfig.backend_info.bSupportsBBox)
     return m_bounding_box_fallback[index];
 
-  if (!m_is_valid)
+  if (!m_is_valid[index])
     Readback();
 
   return static_cast<u16>(m_values[index]);
@@ -95,7 +156,7 @@ void BoundingBox::Set(u32 index, u16 value)
     return;
   }
 
-  if (m_is_valid && m_values[index] == value)
+  if (m_is_valid[index] && m_values[index] == value)
     return;
 
   m_values[index] = value;
@@ -111,7 +172,12 @@ void BoundingBox::DoState(PointerWrap& p)
   p.Do(m_is_active);
   p.DoArray(m_values);
   p.DoArray(m_dirty);
-  p.Do(m_is_valid);
+  // Saved as a single flag to keep the state format
+  bool is_valid =
+      std::all_of(m_is_valid.begin(), m_is_valid.end(), [](bool valid) { return valid; });
+  p.Do(is_valid);
+  if (p.IsReadMode())
+    m_is_valid.fill(is_valid);
 
   // We handle saving the backend values specially rather than using Readback() and Flush() so that
   // we don't mess up the current cache state
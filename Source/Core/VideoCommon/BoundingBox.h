@@ -8,6 +8,7 @@
 #include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/MathUtil.h"
 
 class PixelShaderManager;
 class PointerWrap;
@@ -27,6 +28,12 @@ public:
 
   void Flush();
 
+  // Conservative bounds of the vertices drawn before the next Flush(), in EFB pixels. Values the
+  // draw can't have moved stay valid, so reading them doesn't need a GPU readback. Draws that
+  // weren't estimated invalidate every value.
+  void AddEstimatedBounds(const MathUtil::Rectangle<int>& bounds);
+  void AddUnboundedDraw();
+
   u16 Get(u32 index);
   void Set(u32 index, u16 value);
 
@@ -43,12 +50,18 @@ protected:
 
 private:
   void Readback();
+  void InvalidateDrawnValues();
 
   bool m_is_active = false;
 
   std::array<BBoxType, NUM_BBOX_VALUES> m_values = {};
   std::array<bool, NUM_BBOX_VALUES> m_dirty = {};
-  bool m_is_valid = true;
+  std::array<bool, NUM_BBOX_VALUES> m_is_valid = {true, true, true, true};
+
+  // Estimate for the draw before the next Flush()
+  bool m_has_estimate = false;
+  bool m_estimate_unbounded = false;
+  MathUtil::Rectangle<int> m_estimate;
 
   // Nintendo's SDK seems to write "default" bounding box values before every draw (1023 0 1023 0
   // are the only values encountered so far, which happen to be the extents allowed by the BP
@@ -3,13 +3,20 @@
 
 #include "VideoCommon/CPUCull.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 #include "Common/Assert.h"
 #include "Common/CPUDetect.h"
 #include "Common/MathUtil.h"
 #include "Common/MemoryUtil.h"
 #include "Core/System.h"
 
+#include "VideoCommon/BPFunctions.h"
 #include "VideoCommon/CPMemory.h"
+#include "VideoCommon/FramebufferManager.h"
+#include "VideoCommon/FreeLookCamera.h"
 #include "VideoCommon/VertexManagerBase.h"
 #include "VideoCommon/VertexShaderManager.h"
 #include "VideoCommon/VideoConfig.h"
@@ -53,10 +60,14 @@
 #include "VideoCommon/CPUCullImpl.h"
 #define USE_FMA
 #include "VideoCommon/CPUCullImpl.h"
+#define USE_AVX512
+#include "VideoCommon/CPUCullImpl.h"
 #endif
 
 #if defined(USE_SSE)
-#if defined(__AVX__) && defined(__FMA__)
+#if defined(__AVX512F__) && defined(__FMA__)
+static constexpr int MIN_SSE = 52;
+#elif defined(__AVX__) && defined(__FMA__)
 static constexpr int MIN_SSE = 51;
 #elif defined(__AVX__)
 static constexpr int MIN_SSE = 50;
@@ -69,25 +80,65 @@ static constexpr int MIN_SSE = 0;
 #endif
 #endif
 
+static CPUCull::InstructionSet GetBestInstructionSet()
+{
+  using IS = CPUCull::InstructionSet;
+#if defined(USE_SSE)
+  if (MIN_SSE >= 52 || (cpu_info.bAVX512F && cpu_info.bFMA))
+    return IS::AVX512;
+  else if (MIN_SSE >= 51 || (cpu_info.bAVX && cpu_info.bFMA))
+    return IS::FMA;
+  else if (MIN_SSE >= 50 || cpu_info.bAVX)
+    return IS::AVX;
+  else if (MIN_SSE >= 41 || cpu_info.bSSE4_1)
+    return IS::SSE41;
+  else if (MIN_SSE >= 30 || cpu_info.bSSE3)
+    return IS::SSE3;
+  else
+    return IS::SSE;
+#elif defined(USE_NEON)
+  return IS::NEON;
+#else
+  return IS::Scalar;
+#endif
+}
+
 template <bool PositionHas3Elems, bool PerVertexPosMtx>
-static CPUCull::TransformFunction GetTransformFunction()
+static CPUCull::TransformFunction GetTransformFunction0(CPUCull::InstructionSet instruction_set)
 {
+  using IS = CPUCull::InstructionSet;
+  switch (instruction_set)
+  {
 #if defined(USE_SSE)
-  if (MIN_SSE >= 51 || (cpu_info.bAVX && cpu_info.bFMA))
+  case IS::AVX512:
+    return CPUCull_AVX512::TransformVertices<PositionHas3Elems, PerVertexPosMtx>;
+  case IS::FMA:
     return CPUCull_FMA::TransformVertices<PositionHas3Elems, PerVertexPosMtx>;
-  else if (MIN_SSE >= 50 || cpu_info.bAVX)
+  case IS::AVX:
     return CPUCull_AVX::TransformVertices<PositionHas3Elems, PerVertexPosMtx>;
-  else if (PositionHas3Elems && PerVertexPosMtx && (MIN_SSE >= 41 || cpu_info.bSSE4_1))
-    return CPUCull_SSE41::TransformVertices<PositionHas3Elems, PerVertexPosMtx>;
-  else if (PositionHas3Elems && (MIN_SSE >= 30 || cpu_info.bSSE3))
-    return CPUCull_SSE3::TransformVertices<PositionHas3Elems, PerVertexPosMtx>;
-  else
+  // The SSE4.1 and SSE3 versions only differ from the plain SSE one for these positions
+  case IS::SSE41:
+    if (PositionHas3Elems && PerVertexPosMtx)
+      return CPUCull_SSE41::TransformVertices<PositionHas3Elems, PerVertexPosMtx>;
+    [[fallthrough]];
+  case IS::SSE3:
+    if (PositionHas3Elems)
+      return CPUCull_SSE3::TransformVertices<PositionHas3Elems, PerVertexPosMtx>;
+    [[fallthrough]];
+  case IS::SSE:
     return CPUCull_SSE::TransformVertices<PositionHas3Elems, PerVertexPosMtx>;
 #elif defined(USE_NEON)
-  return CPUCull_NEON::TransformVertices<PositionHas3Elems, PerVertexPosMtx>;
+  case IS::NEON:
+    return CPUCull_NEON::TransformVertices<PositionHas3Elems, PerVertexPosMtx>;
 #else
-  return CPUCull_Scalar::TransformVertices<PositionHas3Elems, PerVertexPosMtx>;
+  case IS::Scalar:
+    return CPUCull_Scalar::TransformVertices<PositionHas3Elems, PerVertexPosMtx>;
 #endif
+  default:
+    ASSERT_MSG(VIDEO, false, "CPUCull isn't built for instruction set {}",
+               CPUCull::GetInstructionSetName(instruction_set));
+    return nullptr;
+  }
 }
 
 template <OpcodeDecoder::Primitive Primitive, CullMode Mode>
@@ -124,10 +175,11 @@ CPUCull::~CPUCull() = default;
 
 void CPUCull::Init()
 {
-  m_transform_table[false][false] = GetTransformFunction<false, false>();
-  m_transform_table[false][true] = GetTransformFunction<false, true>();
-  m_transform_table[true][false] = GetTransformFunction<true, false>();
-  m_transform_table[true][true] = GetTransformFunction<true, true>();
+  const InstructionSet instruction_set = GetBestInstructionSet();
+  m_transform_table[false][false] = GetTransformFunction0<false, false>(instruction_set);
+  m_transform_table[false][true] = GetTransformFunction0<false, true>(instruction_set);
+  m_transform_table[true][false] = GetTransformFunction0<true, false>(instruction_set);
+  m_transform_table[true][true] = GetTransformFunction0<true, true>(instruction_set);
   using Prim = OpcodeDecoder::Primitive;
   m_cull_table[Prim::GX_DRAW_QUADS] = GetCullFunction1<Prim::GX_DRAW_QUADS>();
   m_cull_table[Prim::GX_DRAW_QUADS_2] = GetCullFunction1<Prim::GX_DRAW_QUADS>();
@@ -141,6 +193,90 @@ bool CPUCull::AreAllVerticesCulled(VertexLoaderBase* loader, OpcodeDecoder::Prim
 {
   ASSERT_MSG(VIDEO, primitive < OpcodeDecoder::Primitive::GX_DRAW_LINES,
              "CPUCull should not be called on lines or points");
+  static constexpr Common::EnumMap<CullMode, CullMode::All> cullmode_invert = {
+      CullMode::None, CullMode::Front, CullMode::Back, CullMode::All};
+
+  CullMode cullmode = bpmem.genMode.cullmode;
+  if (xfmem.viewport.ht > 0)  // See videosoftware Clipper.cpp:IsBackface
+    cullmode = cullmode_invert[cullmode];
+  TransformVertices(loader, src, count);
+
+  // Multisampling, wireframe and stereo rendering cover more than the pixel centers, and vertex
+  // rounding moves the vertices
+  PixelGrid grid;
+  const PixelGrid* grid_ptr = nullptr;
+  if (!g_ActiveConfig.MultisamplingEnabled() && !g_ActiveConfig.bWireFrame &&
+      g_ActiveConfig.stereo_mode == StereoMode::Off && !g_ActiveConfig.UseVertexRounding())
+  {
+    // See BPFunctions::SetScissorAndViewport
+    const BPFunctions::ScissorRect scissor = BPFunctions::ComputeScissorRects().Best();
+    grid.scale_x = g_framebuffer_manager->EFBToScaledXf(xfmem.viewport.wd);
+    grid.scale_y = g_framebuffer_manager->EFBToScaledYf(xfmem.viewport.ht);
+    grid.offset_x = g_framebuffer_manager->EFBToScaledXf(xfmem.viewport.xOrig - scissor.x_off);
+    grid.offset_y = g_framebuffer_manager->EFBToScaledYf(xfmem.viewport.yOrig - scissor.y_off);
+    grid_ptr = &grid;
+  }
+
+  const CullFunction cull = m_cull_table[primitive][cullmode];
+  return cull(m_transform_buffer.get(), count, grid_ptr);
+}
+
+bool CPUCull::GetEFBBounds(VertexLoaderBase* loader, const u8* src, u32 count,
+                           MathUtil::Rectangle<int>* bounds)
+{
+  // Free look and the aspect ratio hack change the projection, so the transformed vertices no
+  // longer match what the game drew.
+  if (g_freelook_camera.IsActive() || g_ActiveConfig.fAspectRatioHackW != 1.0f ||
+      g_ActiveConfig.fAspectRatioHackH != 1.0f)
+  {
+    return false;
+  }
+
+  TransformVertices(loader, src, count);
+
+  float min_x = std::numeric_limits<float>::infinity();
+  float min_y = std::numeric_limits<float>::infinity();
+  float max_x = -std::numeric_limits<float>::infinity();
+  float max_y = -std::numeric_limits<float>::infinity();
+  for (u32 i = 0; i < count; i++)
+  {
+    // Vertices behind the camera get clipped, which can move the edges of the primitive anywhere.
+    const TransformedVertex& vertex = m_transform_buffer[i];
+    if (!(vertex.w > 0.0f))
+      return false;
+
+    // See videosoftware Clipper.cpp:PerspectiveDivide
+    const float x = vertex.x / vertex.w * xfmem.viewport.wd + xfmem.viewport.xOrig;
+    const float y = vertex.y / vertex.w * xfmem.viewport.ht + xfmem.viewport.yOrig;
+    if (!std::isfinite(x) || !std::isfinite(y))
+      return false;
+
+    min_x = std::min(min_x, x);
+    min_y = std::min(min_y, y);
+    max_x = std::max(max_x, x);
+    max_y = std::max(max_y, y);
+  }
+
+  // One pixel of margin covers pixel center offsets and vertex rounding, then the result is
+  // limited to the pixels the scissor test lets through.
+  const BPFunctions::ScissorRect scissor = BPFunctions::ComputeScissorRects().Best();
+  const auto to_pixel = [](float value, int offset) {
+    return static_cast<int>(std::clamp(value, -4096.0f, 4096.0f)) - offset;
+  };
+  MathUtil::Rectangle<int> rect(to_pixel(std::floor(min_x), scissor.x_off) - 1,
+                                to_pixel(std::floor(min_y), scissor.y_off) - 1,
+                                to_pixel(std::ceil(max_x), scissor.x_off) + 2,
+                                to_pixel(std::ceil(max_y), scissor.y_off) + 2);
+  rect.ClampUL(scissor.rect.left, scissor.rect.top, scissor.rect.right, scissor.rect.bottom);
+  if (rect.left >= rect.right || rect.top >= rect.bottom)
+    rect = MathUtil::Rectangle<int>();
+
+  *bounds = rect;
+  return true;
+}
+
+void CPUCull::TransformVertices(VertexLoaderBase* loader, const u8* src, u32 count)
+{
   const u32 stride = loader->m_native_vtx_decl.stride;
   const bool posHas3Elems = loader->m_native_vtx_decl.position.components >= 3;
   const bool perVertexPosMtx = loader->m_native_vtx_decl.posmtx.enable;
@@ -155,16 +291,68 @@ bool CPUCull::AreAllVerticesCulled(VertexLoaderBase* loader, OpcodeDecoder::Prim
   // transform functions need the projection matrix to tranform to clip space
   Core::System::GetInstance().GetVertexShaderManager().SetProjectionMatrix();
 
-  static constexpr Common::EnumMap<CullMode, CullMode::All> cullmode_invert = {
-      CullMode::None, CullMode::Front, CullMode::Back, CullMode::All};
-
-  CullMode cullmode = bpmem.genMode.cullmode;
-  if (xfmem.viewport.ht > 0)  // See videosoftware Clipper.cpp:IsBackface
-    cullmode = cullmode_invert[cullmode];
   const TransformFunction transform = m_transform_table[posHas3Elems][perVertexPosMtx];
   transform(m_transform_buffer.get(), src, stride, count);
-  const CullFunction cull = m_cull_table[primitive][cullmode];
-  return cull(m_transform_buffer.get(), count);
+}
+
+std::vector<CPUCull::InstructionSet> CPUCull::GetSupportedInstructionSets()
+{
+  std::vector<InstructionSet> instruction_sets;
+#if defined(USE_SSE)
+  instruction_sets.push_back(InstructionSet::SSE);
+  if (MIN_SSE >= 30 || cpu_info.bSSE3)
+    instruction_sets.push_back(InstructionSet::SSE3);
+  if (MIN_SSE >= 41 || cpu_info.bSSE4_1)
+    instruction_sets.push_back(InstructionSet::SSE41);
+  if (MIN_SSE >= 50 || cpu_info.bAVX)
+    instruction_sets.push_back(InstructionSet::AVX);
+  if (MIN_SSE >= 51 || (cpu_info.bAVX && cpu_info.bFMA))
+    instruction_sets.push_back(InstructionSet::FMA);
+  if (MIN_SSE >= 52 || (cpu_info.bAVX512F && cpu_info.bFMA))
+    instruction_sets.push_back(InstructionSet::AVX512);
+#elif defined(USE_NEON)
+  instruction_sets.push_back(InstructionSet::NEON);
+#else
+  instruction_sets.push_back(InstructionSet::Scalar);
+#endif
+  return instruction_sets;
+}
+
+const char* CPUCull::GetInstructionSetName(InstructionSet instruction_set)
+{
+  switch (instruction_set)
+  {
+  case InstructionSet::Scalar:
+    return "Scalar";
+  case InstructionSet::SSE:
+    return "SSE";
+  case InstructionSet::SSE3:
+    return "SSE3";
+  case InstructionSet::SSE41:
+    return "SSE4.1";
+  case InstructionSet::AVX:
+    return "AVX";
+  case InstructionSet::FMA:
+    return "FMA";
+  case InstructionSet::AVX512:
+    return "AVX-512";
+  case InstructionSet::NEON:
+    return "NEON";
+  }
+  return "Unknown";
+}
+
+CPUCull::TransformFunction CPUCull::GetTransformFunction(InstructionSet instruction_set,
+                                                         bool position_has_3_elems,
+                                                         bool per_vertex_posmtx)
+{
+  if (position_has_3_elems)
+  {
+    return per_vertex_posmtx ? GetTransformFunction0<true, true>(instruction_set) :
+                               GetTransformFunction0<true, false>(instruction_set);
+  }
+  return per_vertex_posmtx ? GetTransformFunction0<false, true>(instruction_set) :
+                             GetTransformFunction0<false, false>(instruction_set);
 }
 
 template <typename T>
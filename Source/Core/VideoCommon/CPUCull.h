@@ -3,6 +3,9 @@
 
 #pragma once
 
+#include <vector>
+
+#include "Common/MathUtil.h"
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/DataReader.h"
 #include "VideoCommon/OpcodeDecoding.h"
@@ -15,15 +18,48 @@ public:
   bool AreAllVerticesCulled(VertexLoaderBase* loader, OpcodeDecoder::Primitive primitive,
                             const u8* src, u32 count);
 
+  // Conservative bounds in EFB pixels of the vertices, using the same transform as culling.
+  // Fails if the vertices can't be bounded, e.g. if one of them is behind the camera.
+  bool GetEFBBounds(VertexLoaderBase* loader, const u8* src, u32 count,
+                    MathUtil::Rectangle<int>* bounds);
+
   struct alignas(16) TransformedVertex
   {
     float x, y, z, w;
   };
 
+  // Maps transformed vertices to host framebuffer pixels, for culling triangles that are too
+  // small to cover any pixel center
+  struct PixelGrid
+  {
+    float scale_x, scale_y;
+    float offset_x, offset_y;
+  };
+
   using TransformFunction = void (*)(void*, const void*, u32, int);
-  using CullFunction = bool (*)(const CPUCull::TransformedVertex*, int);
+  using CullFunction = bool (*)(const CPUCull::TransformedVertex*, int, const PixelGrid*);
+
+  // The instruction sets the transform functions are built for. Init() uses the best one the host
+  // supports, the others are only used for benchmarking.
+  enum class InstructionSet
+  {
+    Scalar,
+    SSE,
+    SSE3,
+    SSE41,
+    AVX,
+    FMA,
+    AVX512,
+    NEON,
+  };
+  static std::vector<InstructionSet> GetSupportedInstructionSets();
+  static const char* GetInstructionSetName(InstructionSet instruction_set);
+  static TransformFunction GetTransformFunction(InstructionSet instruction_set,
+                                                bool position_has_3_elems, bool per_vertex_posmtx);
 
 private:
+  void TransformVertices(VertexLoaderBase* loader, const u8* src, u32 count);
+
   template <typename T>
   struct BufferDeleter
   {
@@ -1,7 +1,9 @@
 // Copyright 2022 Dolphin Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
-#if defined(USE_FMA)
+#if defined(USE_AVX512)
+#define VECTOR_NAMESPACE CPUCull_AVX512
+#elif defined(USE_FMA)
 #define VECTOR_NAMESPACE CPUCull_FMA
 #elif defined(USE_AVX)
 #define VECTOR_NAMESPACE CPUCull_AVX
@@ -19,7 +21,9 @@
 #error This file is meant to be used by CPUCull.cpp only!
 #endif
 
-#if defined(__GNUC__) && defined(USE_FMA) && !(defined(__AVX__) && defined(__FMA__))
+#if defined(__GNUC__) && defined(USE_AVX512) && !(defined(__AVX512F__) && defined(__FMA__))
+#define ATTR_TARGET __attribute__((target("avx512f,avx,fma")))
+#elif defined(__GNUC__) && defined(USE_FMA) && !(defined(__AVX__) && defined(__FMA__))
 #define ATTR_TARGET __attribute__((target("avx,fma")))
 #elif defined(__GNUC__) && defined(USE_AVX) && !defined(__AVX__)
 #define ATTR_TARGET __attribute__((target("avx")))
@@ -72,6 +76,13 @@ ATTR_TARGET DOLPHIN_FORCE_INLINE static __m256 vector_broadcast(__m256 v)
   return _mm256_shuffle_ps(v, v, _MM_SHUFFLE(i, i, i, i));
 }
 #endif
+#ifdef USE_AVX512
+template <int i>
+ATTR_TARGET DOLPHIN_FORCE_INLINE static __m512 vector_broadcast(__m512 v)
+{
+  return _mm512_permute_ps(v, _MM_SHUFFLE(i, i, i, i));
+}
+#endif
 
 #ifdef USE_AVX
 ATTR_TARGET DOLPHIN_FORCE_INLINE static void TransposeYMM(__m256& o0, __m256& o1,  //
@@ -236,6 +247,152 @@ LoadTransform2Vertices(const u8* v0data, const u8* v1data,                  //
 
 #endif
 
+#ifdef USE_AVX512
+// Like the YMM functions, but with four vertices per register, one in each 128-bit lane
+
+ATTR_TARGET DOLPHIN_FORCE_INLINE static void TransposeZMM(__m512& o0, __m512& o1,  //
+                                                          __m512& o2, __m512& o3)
+{
+  __m512d tmp0 = _mm512_castps_pd(_mm512_unpacklo_ps(o0, o1));
+  __m512d tmp1 = _mm512_castps_pd(_mm512_unpacklo_ps(o2, o3));
+  __m512d tmp2 = _mm512_castps_pd(_mm512_unpackhi_ps(o0, o1));
+  __m512d tmp3 = _mm512_castps_pd(_mm512_unpackhi_ps(o2, o3));
+  o0 = _mm512_castpd_ps(_mm512_unpacklo_pd(tmp0, tmp1));
+  o1 = _mm512_castpd_ps(_mm512_unpackhi_pd(tmp0, tmp1));
+  o2 = _mm512_castpd_ps(_mm512_unpacklo_pd(tmp2, tmp3));
+  o3 = _mm512_castpd_ps(_mm512_unpackhi_pd(tmp2, tmp3));
+}
+
+ATTR_TARGET DOLPHIN_FORCE_INLINE static void LoadTransposedZMM(const void* source, __m512& o0,
+                                                               __m512& o1, __m512& o2, __m512& o3)
+{
+  const Vector* vsource = static_cast<const Vector*>(source);
+  o0 = _mm512_broadcast_f32x4(vsource[0]);
+  o1 = _mm512_broadcast_f32x4(vsource[1]);
+  o2 = _mm512_broadcast_f32x4(vsource[2]);
+  o3 = _mm512_broadcast_f32x4(vsource[3]);
+  TransposeZMM(o0, o1, o2, o3);
+}
+
+ATTR_TARGET DOLPHIN_FORCE_INLINE static void
+LoadTransposedPosZMM(const void* source, __m512& o0, __m512& o1, __m512& o2, __m512& o3)
+{
+  const Vector* vsource = static_cast<const Vector*>(source);
+  o0 = _mm512_broadcast_f32x4(vsource[0]);
+  o1 = _mm512_broadcast_f32x4(vsource[1]);
+  o2 = _mm512_broadcast_f32x4(vsource[2]);
+  o3 = _mm512_broadcast_f32x4(_mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f));
+  TransposeZMM(o0, o1, o2, o3);
+}
+
+ATTR_TARGET DOLPHIN_FORCE_INLINE static __m512 Combine4(__m128 v0, __m128 v1, __m128 v2,
+                                                        __m128 v3)
+{
+  __m512 output = _mm512_castps128_ps512(v0);
+  output = _mm512_insertf32x4(output, v1, 1);
+  output = _mm512_insertf32x4(output, v2, 2);
+  return _mm512_insertf32x4(output, v3, 3);
+}
+
+ATTR_TARGET DOLPHIN_FORCE_INLINE static __m512 ApplyMatrixZMM(__m512 v, __m512 m0, __m512 m1,
+                                                              __m512 m2, __m512 m3)
+{
+  __m512 output = _mm512_mul_ps(vector_broadcast<0>(v), m0);
+  output = _mm512_fmadd_ps(vector_broadcast<1>(v), m1, output);
+  output = _mm512_fmadd_ps(vector_broadcast<2>(v), m2, output);
+  output = _mm512_fmadd_ps(vector_broadcast<3>(v), m3, output);
+  return output;
+}
+
+ATTR_TARGET DOLPHIN_FORCE_INLINE static __m512
+TransformVertexNoTransposeZMM(__m512 vertex, __m512 pos0, __m512 pos1, __m512 pos2,  //
+                              __m512 proj0, __m512 proj1, __m512 proj2, __m512 proj3)
+{
+  // There is no 512-bit hadd, so transpose the products and add them up instead
+  __m512 mul0 = _mm512_mul_ps(vertex, pos0);
+  __m512 mul1 = _mm512_mul_ps(vertex, pos1);
+  __m512 mul2 = _mm512_mul_ps(vertex, pos2);
+  __m512 mul3 = _mm512_broadcast_f32x4(_mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f));
+  TransposeZMM(mul0, mul1, mul2, mul3);
+  __m512 output = _mm512_add_ps(_mm512_add_ps(mul0, mul1), _mm512_add_ps(mul2, mul3));
+  return ApplyMatrixZMM(output, proj0, proj1, proj2, proj3);
+}
+
+template <bool PositionHas3Elems>
+ATTR_TARGET DOLPHIN_FORCE_INLINE static __m512
+TransformVertexZMM(__m512 vertex, __m512 pos0, __m512 pos1, __m512 pos2, __m512 pos3,  //
+                   __m512 proj0, __m512 proj1, __m512 proj2, __m512 proj3)
+{
+  __m512 output = pos3;  // vertex.w is always 1.0
+  output = _mm512_fmadd_ps(vector_broadcast<0>(vertex), pos0, output);
+  output = _mm512_fmadd_ps(vector_broadcast<1>(vertex), pos1, output);
+  if constexpr (PositionHas3Elems)
+    output = _mm512_fmadd_ps(vector_broadcast<2>(vertex), pos2, output);
+  return ApplyMatrixZMM(output, proj0, proj1, proj2, proj3);
+}
+
+template <bool PositionHas3Elems>
+ATTR_TARGET DOLPHIN_FORCE_INLINE static __m128 LoadPosition(const u8* data)
+{
+  const float* fdata = reinterpret_cast<const float*>(data);
+  if constexpr (PositionHas3Elems)
+    return _mm_loadu_ps(fdata);
+  else
+    return _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(fdata));
+}
+
+template <bool PositionHas3Elems, bool PerVertexPosMtx>
+ATTR_TARGET DOLPHIN_FORCE_INLINE static __m512
+LoadTransform4Vertices(const u8* data, u32 stride,                          //
+                       __m512 pos0, __m512 pos1, __m512 pos2, __m512 pos3,  //
+                       __m512 proj0, __m512 proj1, __m512 proj2, __m512 proj3)
+{
+  const u8* v0data = data;
+  const u8* v1data = data + stride;
+  const u8* v2data = data + stride * 2;
+  const u8* v3data = data + stride * 3;
+  __m512 vertices;
+  if constexpr (PerVertexPosMtx)
+  {
+    // Vertex data layout always starts with posmtx data if available, then position data
+    // Convenient for us, that means offsets are always fixed
+    const Vector* m0 = reinterpret_cast<const Vector*>(&xfmem.posMatrices[(v0data[0] & 0x3f) * 4]);
+    const Vector* m1 = reinterpret_cast<const Vector*>(&xfmem.posMatrices[(v1data[0] & 0x3f) * 4]);
+    const Vector* m2 = reinterpret_cast<const Vector*>(&xfmem.posMatrices[(v2data[0] & 0x3f) * 4]);
+    const Vector* m3 = reinterpret_cast<const Vector*>(&xfmem.posMatrices[(v3data[0] & 0x3f) * 4]);
+    pos0 = Combine4(m0[0], m1[0], m2[0], m3[0]);
+    pos1 = Combine4(m0[1], m1[1], m2[1], m3[1]);
+    pos2 = Combine4(m0[2], m1[2], m2[2], m3[2]);
+
+    vertices = Combine4(LoadPosition<PositionHas3Elems>(v0data + sizeof(u32)),
+                        LoadPosition<PositionHas3Elems>(v1data + sizeof(u32)),
+                        LoadPosition<PositionHas3Elems>(v2data + sizeof(u32)),
+                        LoadPosition<PositionHas3Elems>(v3data + sizeof(u32)));
+    vertices = _mm512_mask_mov_ps(vertices, 0x8888, _mm512_set1_ps(1.0f));
+
+    vertices = TransformVertexNoTransposeZMM(vertices, pos0, pos1, pos2,  //
+                                             proj0, proj1, proj2, proj3);
+  }
+  else
+  {
+    vertices = Combine4(LoadPosition<PositionHas3Elems>(v0data),
+                        LoadPosition<PositionHas3Elems>(v1data),
+                        LoadPosition<PositionHas3Elems>(v2data),
+                        LoadPosition<PositionHas3Elems>(v3data));
+
+#ifdef __clang__
+    // See LoadTransform2Vertices
+    asm("" : "+v"(vertices)::);
+#endif
+
+    vertices = TransformVertexZMM<PositionHas3Elems>(vertices, pos0, pos1, pos2, pos3,  //
+                                                     proj0, proj1, proj2, proj3);
+  }
+
+  return vertices;
+}
+#endif
+
 #ifndef USE_AVX
 // Note: Assumes 16-byte aligned source
 ATTR_TARGET DOLPHIN_FORCE_INLINE static void LoadTransposed(const void* source, Vector& o0,
@@ -512,10 +669,47 @@ ATTR_TARGET static void TransformVertices(void* output, const void* vertices, u3
   const u8* cvertices = static_cast<const u8*>(vertices);
   Vector* voutput = static_cast<Vector*>(output);
   u32 idx = g_main_cp_state.matrix_index_a.PosNormalMtxIdx & 0x3f;
-#ifdef USE_AVX
+#if defined(USE_AVX512)
+  __m512 proj0, proj1, proj2, proj3;
+  __m512 pos0, pos1, pos2, pos3;
+  LoadTransposedZMM(vsmanager.GetClipTransform(), proj0, proj1, proj2, proj3);
+  LoadTransposedPosZMM(&xfmem.posMatrices[idx * 4], pos0, pos1, pos2, pos3);
+  // 16 vertices per iteration, so that the four independent transforms can overlap
+  int i = 0;
+  for (; i + 16 <= count; i += 16)
+  {
+    for (int j = 0; j < 4; j++)
+    {
+      __m512 v0123 = LoadTransform4Vertices<PositionHas3Elems, PerVertexPosMtx>(
+          cvertices, stride, pos0, pos1, pos2, pos3, proj0, proj1, proj2, proj3);
+      _mm512_storeu_ps(reinterpret_cast<float*>(voutput), v0123);
+      cvertices += stride * 4;
+      voutput += 4;
+    }
+  }
+  for (; i + 4 <= count; i += 4)
+  {
+    __m512 v0123 = LoadTransform4Vertices<PositionHas3Elems, PerVertexPosMtx>(
+        cvertices, stride, pos0, pos1, pos2, pos3, proj0, proj1, proj2, proj3);
+    _mm512_storeu_ps(reinterpret_cast<float*>(voutput), v0123);
+    cvertices += stride * 4;
+    voutput += 4;
+  }
+  for (; i < count; i++)
+  {
+    *voutput = LoadTransformVertex<PositionHas3Elems, PerVertexPosMtx>(
+        cvertices,                                                     //
+        _mm512_castps512_ps128(pos0), _mm512_castps512_ps128(pos1),    //
+        _mm512_castps512_ps128(pos2), _mm512_castps512_ps128(pos3),    //
+        _mm512_castps512_ps128(proj0), _mm512_castps512_ps128(proj1),  //
+        _mm512_castps512_ps128(proj2), _mm512_castps512_ps128(proj3));
+    cvertices += stride;
+    voutput += 1;
+  }
+#elif defined(USE_AVX)
   __m256 proj0, proj1, proj2, proj3;
   __m256 pos0, pos1, pos2, pos3;
-  LoadTransposedYMM(vsmanager.constants.projection.data(), proj0, proj1, proj2, proj3);
+  LoadTransposedYMM(vsmanager.GetClipTransform(), proj0, proj1, proj2, proj3);
   LoadTransposedPosYMM(&xfmem.posMatrices[idx * 4], pos0, pos1, pos2, pos3);
   for (int i = 1; i < count; i += 2)
   {
@@ -539,7 +733,7 @@ ATTR_TARGET static void TransformVertices(void* output, const void* vertices, u3
 #else
   Vector proj0, proj1, proj2, proj3;
   Vector pos0, pos1, pos2, pos3;
-  LoadTransposed(vsmanager.constants.projection.data(), proj0, proj1, proj2, proj3);
+  LoadTransposed(vsmanager.GetClipTransform(), proj0, proj1, proj2, proj3);
   LoadTransposedPos(&xfmem.posMatrices[idx * 4], pos0, pos1, pos2, pos3);
   for (int i = 0; i < count; i++)
   {
@@ -551,10 +745,43 @@ ATTR_TARGET static void TransformVertices(void* output, const void* vertices, u3
 #endif
 }
 
+// Triangles whose bounds don't contain any pixel center don't produce any fragments.
+// Only checked after the other tests, so it doesn't need to be fast.
+ATTR_TARGET static bool CoversNoPixelCenters(const CPUCull::TransformedVertex& a,
+                                             const CPUCull::TransformedVertex& b,
+                                             const CPUCull::TransformedVertex& c,
+                                             const CPUCull::PixelGrid& grid)
+{
+  // Clipping can move the vertices of triangles that cross the near plane anywhere
+  if (!(a.w > 0.0f && b.w > 0.0f && c.w > 0.0f))
+    return false;
+
+  const auto to_pixel = [](float v, float w, float scale, float offset) {
+    return v / w * scale + offset;
+  };
+  const float ax = to_pixel(a.x, a.w, grid.scale_x, grid.offset_x);
+  const float bx = to_pixel(b.x, b.w, grid.scale_x, grid.offset_x);
+  const float cx = to_pixel(c.x, c.w, grid.scale_x, grid.offset_x);
+  const float ay = to_pixel(a.y, a.w, grid.scale_y, grid.offset_y);
+  const float by = to_pixel(b.y, b.w, grid.scale_y, grid.offset_y);
+  const float cy = to_pixel(c.y, c.w, grid.scale_y, grid.offset_y);
+
+  // Pixel centers are at n + 0.5. The margin covers the pixel center correction of the vertex
+  // shader and differences in rounding. NaNs compare false, so they are never culled.
+  constexpr float MARGIN = 0.25f;
+  const auto misses_centers = [](float v0, float v1, float v2) {
+    const float first = std::ceil(std::min({v0, v1, v2}) - 0.5f - MARGIN);
+    const float last = std::floor(std::max({v0, v1, v2}) - 0.5f + MARGIN);
+    return last < first;
+  };
+  return misses_centers(ax, bx, cx) || misses_centers(ay, by, cy);
+}
+
 template <CullMode Mode>
 ATTR_TARGET DOLPHIN_FORCE_INLINE static bool CullTriangle(const CPUCull::TransformedVertex& a,
                                                           const CPUCull::TransformedVertex& b,
-                                                          const CPUCull::TransformedVertex& c)
+                                                          const CPUCull::TransformedVertex& c,
+                                                          const CPUCull::PixelGrid* grid)
 {
   if (Mode == CullMode::All)
     return true;
@@ -650,12 +877,15 @@ ATTR_TARGET DOLPHIN_FORCE_INLINE static bool CullTriangle(const CPUCull::Transfo
   cull |= a.y > a.w && b.y > b.w && c.y > c.w;
 #endif
 
+  if (!cull && grid)
+    cull = CoversNoPixelCenters(a, b, c, *grid);
+
   return cull;
 }
 
 template <OpcodeDecoder::Primitive Primitive, CullMode Mode>
 ATTR_TARGET static bool AreAllVerticesCulled(const CPUCull::TransformedVertex* transformed,
-                                             int count)
+                                             int count, const CPUCull::PixelGrid* grid)
 {
   switch (Primitive)
   {
@@ -665,15 +895,15 @@ ATTR_TARGET static bool AreAllVerticesCulled(const CPUCull::TransformedVertex* t
     int i = 3;
     for (; i < count; i += 4)
     {
-      if (!CullTriangle<Mode>(transformed[i - 3], transformed[i - 2], transformed[i - 1]))
+      if (!CullTriangle<Mode>(transformed[i - 3], transformed[i - 2], transformed[i - 1], grid))
         return false;
-      if (!CullTriangle<Mode>(transformed[i - 3], transformed[i - 1], transformed[i - 0]))
+      if (!CullTriangle<Mode>(transformed[i - 3], transformed[i - 1], transformed[i - 0], grid))
         return false;
     }
     // three vertices remaining, so render a triangle
     if (i == count)
     {
-      if (!CullTriangle<Mode>(transformed[i - 3], transformed[i - 2], transformed[i - 1]))
+      if (!CullTriangle<Mode>(transformed[i - 3], transformed[i - 2], transformed[i - 1], grid))
         return false;
     }
     break;
@@ -681,7 +911,7 @@ ATTR_TARGET static bool AreAllVerticesCulled(const CPUCull::TransformedVertex* t
   case OpcodeDecoder::Primitive::GX_DRAW_TRIANGLES:
     for (int i = 2; i < count; i += 3)
     {
-      if (!CullTriangle<Mode>(transformed[i - 2], transformed[i - 1], transformed[i - 0]))
+      if (!CullTriangle<Mode>(transformed[i - 2], transformed[i - 1], transformed[i - 0], grid))
         return false;
     }
     break;
@@ -690,8 +920,11 @@ ATTR_TARGET static bool AreAllVerticesCulled(const CPUCull::TransformedVertex* t
     bool wind = false;
     for (int i = 2; i < count; ++i)
     {
-      if (!CullTriangle<Mode>(transformed[i - 2], transformed[i - !wind], transformed[i - wind]))
+      if (!CullTriangle<Mode>(transformed[i - 2], transformed[i - !wind], transformed[i - wind],
+                              grid))
+      {
         return false;
+      }
       wind = !wind;
     }
     break;
@@ -699,7 +932,7 @@ ATTR_TARGET static bool AreAllVerticesCulled(const CPUCull::TransformedVertex* t
   case OpcodeDecoder::Primitive::GX_DRAW_TRIANGLE_FAN:
     for (int i = 2; i < count; ++i)
     {
-      if (!CullTriangle<Mode>(transformed[0], transformed[i - 1], transformed[i]))
+      if (!CullTriangle<Mode>(transformed[0], transformed[i - 1], transformed[i], grid))
         return false;
     }
     break;
@@ -360,7 +360,7 @@ void CommandProcessorManager::RegisterMMIO(Core::System& system, MMIO::Mapping*
   mmio->Register(base | FIFO_READ_POINTER_HI, fifo_read_hi_r, fifo_read_hi_w);
 }
 
-void CommandProcessorManager::GatherPipeBursted(Core::System& system)
+void CommandProcessorManager::GatherPipeBursted(Core::System& system, u32 bursts)
 {
   auto& fifo = m_fifo;
 
@@ -387,15 +387,12 @@ void CommandProcessorManager::GatherPipeBursted(Core::System& system)
   }
 
   // update the fifo pointer
-  if (fifo.CPWritePointer.load(std::memory_order_relaxed) ==
-      fifo.CPEnd.load(std::memory_order_relaxed))
-  {
-    fifo.CPWritePointer.store(fifo.CPBase, std::memory_order_relaxed);
-  }
-  else
-  {
-    fifo.CPWritePointer.fetch_add(GPFifo::GATHER_PIPE_SIZE, std::memory_order_relaxed);
-  }
+  const u32 base = fifo.CPBase.load(std::memory_order_relaxed);
+  const u32 end = fifo.CPEnd.load(std::memory_order_relaxed);
+  u32 write_pointer = fifo.CPWritePointer.load(std::memory_order_relaxed);
+  for (u32 i = 0; i < bursts; ++i)
+    write_pointer = write_pointer == end ? base : write_pointer + GPFifo::GATHER_PIPE_SIZE;
+  fifo.CPWritePointer.store(write_pointer, std::memory_order_relaxed);
 
   if (m_cp_ctrl_reg.GPReadEnable && m_cp_ctrl_reg.GPLinkEnable)
   {
@@ -409,7 +406,7 @@ void CommandProcessorManager::GatherPipeBursted(Core::System& system)
   if (fifo.bFF_HiWatermark.load(std::memory_order_relaxed) != 0)
     system.GetCoreTiming().ForceExceptionCheck(0);
 
-  fifo.CPReadWriteDistance.fetch_add(GPFifo::GATHER_PIPE_SIZE, std::memory_order_seq_cst);
+  fifo.CPReadWriteDistance.fetch_add(bursts * GPFifo::GATHER_PIPE_SIZE, std::memory_order_seq_cst);
 
   system.GetFifo().RunGpu(system);
 
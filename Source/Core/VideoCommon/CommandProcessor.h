@@ -167,7 +167,8 @@ public:
 
   void SetCPStatusFromGPU(Core::System& system);
   void SetCPStatusFromCPU(Core::System& system);
-  void GatherPipeBursted(Core::System& system);
+  // bursts is the number of GATHER_PIPE_SIZE bursts that were written to the FIFO
+  void GatherPipeBursted(Core::System& system, u32 bursts);
   void UpdateInterrupts(Core::System& system, u64 userdata);
   void UpdateInterruptsFromVideoBackend(Core::System& system, u64 userdata);
 
@@ -72,6 +72,7 @@ struct alignas(16) VertexShaderConstants
 
   std::array<float4, 6> posnormalmatrix;
   std::array<float4, 4> projection;
+  std::array<float4, 4> freelook_view;
   std::array<int4, 4> materials;
   struct Light
   {
@@ -3,6 +3,7 @@
 
 #include "VideoCommon/Fifo.h"
 
+#include <algorithm>
 #include <atomic>
 #include <cstring>
 
@@ -13,6 +14,7 @@
 #include "Common/FPURoundMode.h"
 #include "Common/MemoryUtil.h"
 #include "Common/MsgHandler.h"
+#include "Common/TraceEvents.h"
 
 #include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
@@ -35,6 +37,8 @@
 namespace Fifo
 {
 static constexpr int GPU_TIME_SLOT_SIZE = 1000;
+// Longest time the CPU runs in dual core mode with SyncGPU before checking the GPU distance again
+static constexpr int MAX_GPU_TIME_SLOT_SIZE = 50000;
 
 FifoManager::FifoManager() = default;
 FifoManager::~FifoManager() = default;
@@ -147,7 +151,10 @@ void FifoManager::SyncGPU(SyncGPUReason reason, bool may_move_read_ptr)
 {
   if (m_use_deterministic_gpu_thread)
   {
-    m_gpu_mainloop.Wait();
+    {
+      TRACE_SCOPE("Sync GPU");
+      m_gpu_mainloop.Wait();
+    }
     if (!m_gpu_mainloop.IsRunning())
       return;
 
@@ -296,6 +303,8 @@ void FifoManager::RunGpuLoop(Core::System& system)
         if (!m_emu_running_state.IsSet())
           return;
 
+        TRACE_SCOPE("Run GPU");
+
         if (m_use_deterministic_gpu_thread)
         {
           // All the fifo/CP stuff is on the CPU.  We just need to run the opcode decoder.
@@ -397,6 +406,7 @@ void FifoManager::FlushGpu(Core::System& system)
   if (!system.IsDualCoreMode() || m_use_deterministic_gpu_thread)
     return;
 
+  TRACE_SCOPE("Flush GPU");
   m_gpu_mainloop.Wait();
 }
 
@@ -555,9 +565,23 @@ int FifoManager::WaitForGpuThread(Core::System& system, int ticks)
 
   // Wait for GPU
   if (now >= m_config_sync_gpu_max_distance)
+  {
+    TRACE_SCOPE("Wait for GPU");
     m_sync_wakeup_event.Wait();
+  }
+
+  return GetSyncGpuInterval(m_sync_ticks.load());
+}
 
-  return GPU_TIME_SLOT_SIZE;
+// The further the distance between the CPU and the GPU is from both limits, the longer the CPU can
+// run before the GPU either has to be waited for or runs out of ticks. Checking only once half of
+// that time has passed keeps the distance within the limits, without scheduling an event every
+// GPU_TIME_SLOT_SIZE cycles while the GPU is keeping up.
+int FifoManager::GetSyncGpuInterval(int distance) const
+{
+  const int headroom = std::min(m_config_sync_gpu_max_distance - distance,
+                                distance - m_config_sync_gpu_min_distance);
+  return std::clamp(headroom / 2, GPU_TIME_SLOT_SIZE, MAX_GPU_TIME_SLOT_SIZE);
 }
 
 void FifoManager::SyncGPUCallback(Core::System& system, u64 ticks, s64 cyclesLate)
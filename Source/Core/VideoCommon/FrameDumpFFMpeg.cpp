@@ -18,6 +18,7 @@ extern "C" {
 #include <libavcodec/avcodec.h>
 #include <libavformat/avformat.h>
 #include <libavutil/error.h>
+#include <libavutil/hwcontext.h>
 #include <libavutil/log.h>
 #include <libavutil/mathematics.h>
 #include <libavutil/opt.h>
@@ -51,6 +52,12 @@ struct FrameDumpContext
   AVFrame* scaled_frame = nullptr;
   SwsContext* sws = nullptr;
 
+  // The format that frames are converted to for the encoder. With hardware frames, this is the
+  // format that is uploaded.
+  AVPixelFormat input_format = AV_PIX_FMT_NONE;
+  AVBufferRef* hw_device = nullptr;
+  AVBufferRef* hw_frames = nullptr;
+
   s64 last_pts = AV_NOPTS_VALUE;
 
   int width = 0;
@@ -151,6 +158,65 @@ std::string GetDumpPath(const std::string& extension, std::time_t time, u32 inde
   return path;
 }
 
+bool SupportsPixelFormat(const AVCodec* codec, AVPixelFormat pix_fmt)
+{
+  // Encoders which don't list their formats take any of them.
+  if (!codec->pix_fmts)
+    return true;
+
+  for (const AVPixelFormat* format = codec->pix_fmts; *format != AV_PIX_FMT_NONE; ++format)
+  {
+    if (*format == pix_fmt)
+      return true;
+  }
+  return false;
+}
+
+// Sets up the encoder to take frames in GPU memory, for hardware encoders that don't accept frames
+// in system memory, such as VAAPI. Frames are uploaded as NV12.
+bool InitHardwareFrames(FrameDumpContext& context, const AVCodec* codec)
+{
+  for (int i = 0;; ++i)
+  {
+    const AVCodecHWConfig* const config = avcodec_get_hw_config(codec, i);
+    if (!config)
+      return false;
+
+    if (!(config->methods & AV_CODEC_HW_CONFIG_METHOD_HW_FRAMES_CTX))
+      continue;
+
+    const char* const device_name = av_hwdevice_get_type_name(config->device_type);
+    if (av_hwdevice_ctx_create(&context.hw_device, config->device_type, nullptr, nullptr, 0) < 0)
+    {
+      WARN_LOG_FMT(FRAMEDUMP, "Could not create {} device", device_name);
+      continue;
+    }
+
+    context.hw_frames = av_hwframe_ctx_alloc(context.hw_device);
+    if (context.hw_frames)
+    {
+      auto* const frames = reinterpret_cast<AVHWFramesContext*>(context.hw_frames->data);
+      frames->format = config->pix_fmt;
+      frames->sw_format = AV_PIX_FMT_NV12;
+      frames->width = context.width;
+      frames->height = context.height;
+      frames->initial_pool_size = 8;
+      if (av_hwframe_ctx_init(context.hw_frames) >= 0)
+      {
+        context.codec->pix_fmt = config->pix_fmt;
+        context.codec->hw_frames_ctx = av_buffer_ref(context.hw_frames);
+        context.input_format = AV_PIX_FMT_NV12;
+        INFO_LOG_FMT(FRAMEDUMP, "Encoding {} frames", device_name);
+        return true;
+      }
+    }
+
+    WARN_LOG_FMT(FRAMEDUMP, "Could not create {} frames", device_name);
+    av_buffer_unref(&context.hw_frames);
+    av_buffer_unref(&context.hw_device);
+  }
+}
+
 std::string AVErrorString(int error)
 {
   std::array<char, AV_ERROR_MAX_STRING_SIZE> msg;
@@ -281,11 +347,22 @@ bool FFMpegFrameDump::CreateVideoFile()
       pix_fmt = AV_PIX_FMT_BGR0;
     else if (m_context->codec->codec_id == AV_CODEC_ID_UTVIDEO)
       pix_fmt = AV_PIX_FMT_GBRP;
+    else if (!SupportsPixelFormat(codec, AV_PIX_FMT_YUV420P) &&
+             SupportsPixelFormat(codec, AV_PIX_FMT_NV12))
+      pix_fmt = AV_PIX_FMT_NV12;
     else
       pix_fmt = AV_PIX_FMT_YUV420P;
   }
 
   m_context->codec->pix_fmt = pix_fmt;
+  m_context->input_format = pix_fmt;
+
+  // Hardware encoders that can't take the frames as they are get them uploaded instead.
+  if (!SupportsPixelFormat(codec, pix_fmt) && !InitHardwareFrames(*m_context, codec))
+  {
+    WARN_LOG_FMT(FRAMEDUMP, "Encoder {} doesn't support {}", codec->name,
+                 av_get_pix_fmt_name(pix_fmt));
+  }
 
   if (m_context->codec->codec_id == AV_CODEC_ID_UTVIDEO)
     av_opt_set_int(m_context->codec->priv_data, "pred", 3, 0);  // median
@@ -302,7 +379,7 @@ bool FFMpegFrameDump::CreateVideoFile()
   m_context->src_frame = av_frame_alloc();
   m_context->scaled_frame = av_frame_alloc();
 
-  m_context->scaled_frame->format = m_context->codec->pix_fmt;
+  m_context->scaled_frame->format = m_context->input_format;
   m_context->scaled_frame->width = m_context->width;
   m_context->scaled_frame->height = m_context->height;
 
@@ -333,6 +410,11 @@ bool FFMpegFrameDump::CreateVideoFile()
                  m_context->stream->time_base.num);
   }
 
+  // The GPU converts frames to NV12, which only needs splitting into planes for YUV420P.
+  m_accepts_nv12.store(m_context->input_format == AV_PIX_FMT_NV12 ||
+                           m_context->input_format == AV_PIX_FMT_YUV420P,
+                       std::memory_order_relaxed);
+
   OSD::AddMessage(fmt::format("Dumping Frames to \"{}\" ({}x{})", dump_path, m_context->width,
                               m_context->height));
   return true;
@@ -375,28 +457,57 @@ void FFMpegFrameDump::AddFrame(const FrameData& frame)
     }
   }
 
-  constexpr AVPixelFormat pix_fmt = AV_PIX_FMT_RGBA;
+  const bool is_nv12 = frame.format == FrameData::Format::NV12;
+  const AVPixelFormat pix_fmt = is_nv12 ? AV_PIX_FMT_NV12 : AV_PIX_FMT_RGBA;
 
   m_context->src_frame->data[0] = const_cast<u8*>(frame.data);
   m_context->src_frame->linesize[0] = frame.stride;
+  m_context->src_frame->data[1] =
+      is_nv12 ? const_cast<u8*>(frame.data) + frame.height * frame.stride : nullptr;
+  m_context->src_frame->linesize[1] = is_nv12 ? frame.stride : 0;
   m_context->src_frame->format = pix_fmt;
   m_context->src_frame->width = m_context->width;
   m_context->src_frame->height = m_context->height;
 
-  // Convert image from RGBA to desired pixel format.
-  m_context->sws = sws_getCachedContext(
-      m_context->sws, frame.width, frame.height, pix_fmt, m_context->width, m_context->height,
-      m_context->codec->pix_fmt, SWS_BICUBIC, nullptr, nullptr, nullptr);
-  if (m_context->sws)
+  AVFrame* input_frame = m_context->scaled_frame;
+  if (pix_fmt == m_context->input_format && frame.width == m_context->width &&
+      frame.height == m_context->height)
   {
-    sws_scale(m_context->sws, m_context->src_frame->data, m_context->src_frame->linesize, 0,
-              frame.height, m_context->scaled_frame->data, m_context->scaled_frame->linesize);
+    // Already converted on the GPU.
+    input_frame = m_context->src_frame;
+  }
+  else
+  {
+    // Convert image to the pixel format of the encoder.
+    m_context->sws = sws_getCachedContext(
+        m_context->sws, frame.width, frame.height, pix_fmt, m_context->width, m_context->height,
+        m_context->input_format, SWS_BICUBIC, nullptr, nullptr, nullptr);
+    if (m_context->sws)
+    {
+      sws_scale(m_context->sws, m_context->src_frame->data, m_context->src_frame->linesize, 0,
+                frame.height, m_context->scaled_frame->data, m_context->scaled_frame->linesize);
+    }
   }
 
   m_context->last_pts = pts;
-  m_context->scaled_frame->pts = pts;
+  input_frame->pts = pts;
 
-  if (const int error = avcodec_send_frame(m_context->codec, m_context->scaled_frame))
+  auto hw_frame = std::unique_ptr<AVFrame, std::function<void(AVFrame*)>>(
+      nullptr, [](AVFrame* hw_frame_ptr) { av_frame_free(&hw_frame_ptr); });
+  if (m_context->hw_frames)
+  {
+    hw_frame.reset(av_frame_alloc());
+    if (!hw_frame || av_hwframe_get_buffer(m_context->hw_frames, hw_frame.get(), 0) < 0 ||
+        av_hwframe_transfer_data(hw_frame.get(), input_frame, 0) < 0)
+    {
+      ERROR_LOG_FMT(FRAMEDUMP, "Could not upload frame to the encoder");
+      return;
+    }
+    hw_frame->pts = pts;
+    input_frame = hw_frame.get();
+  }
+
+  if (const int error = avcodec_send_frame(m_context->codec, input_frame))
   {
     ERROR_LOG_FMT(FRAMEDUMP, "Error while encoding video: {}", AVErrorString(error));
     return;
@@ -467,10 +578,14 @@ bool FFMpegFrameDump::IsStarted() const
 
 void FFMpegFrameDump::CloseVideoFile()
 {
+  m_accepts_nv12.store(false, std::memory_order_relaxed);
+
   av_frame_free(&m_context->src_frame);
   av_frame_free(&m_context->scaled_frame);
 
   avcodec_free_context(&m_context->codec);
+  av_buffer_unref(&m_context->hw_frames);
+  av_buffer_unref(&m_context->hw_device);
 
   if (m_context->format)
     avio_closep(&m_context->format->pb);
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <ctime>
 #include <memory>
 
@@ -24,11 +25,20 @@ struct FrameState
 
 struct FrameData
 {
+  enum class Format
+  {
+    RGBA8,
+    // The luma plane, followed by the interleaved chroma plane at half the height, both with the
+    // same stride. This is what the frame dumper converts to on the GPU.
+    NV12,
+  };
+
   const u8* data = nullptr;
   int width = 0;
   int height = 0;
   int stride = 0;
   FrameState state;
+  Format format = Format::RGBA8;
 };
 
 class FFMpegFrameDump
@@ -44,6 +54,10 @@ public:
   bool IsStarted() const;
   FrameState FetchState(u64 ticks, int frame_number) const;
 
+  // Whether the encoder takes 4:2:0 YUV, so frames can be given as NV12 rather than RGBA8. This is
+  // read on the video thread.
+  bool AcceptsNV12() const { return m_accepts_nv12.load(std::memory_order_relaxed); }
+
 private:
   bool IsFirstFrameInCurrentFile() const;
   bool PrepareEncoding(int w, int h, u64 start_ticks, u32 savestate_index);
@@ -59,6 +73,8 @@ private:
   // Used for FetchState:
   u32 m_savestate_index = 0;
 
+  std::atomic<bool> m_accepts_nv12{false};
+
   // Used for filename generation.
   std::time_t m_start_time = {};
   u32 m_file_index = 0;
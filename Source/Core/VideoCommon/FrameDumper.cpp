@@ -12,10 +12,16 @@
 
 #include "VideoCommon/AbstractFramebuffer.h"
 #include "VideoCommon/AbstractGfx.h"
+#include "VideoCommon/AbstractPipeline.h"
+#include "VideoCommon/AbstractShader.h"
 #include "VideoCommon/AbstractStagingTexture.h"
 #include "VideoCommon/AbstractTexture.h"
+#include "VideoCommon/FramebufferShaderGen.h"
 #include "VideoCommon/OnScreenDisplay.h"
 #include "VideoCommon/Present.h"
+#include "VideoCommon/RenderState.h"
+#include "VideoCommon/ShaderCache.h"
+#include "VideoCommon/VertexManagerBase.h"
 #include "VideoCommon/VideoConfig.h"
 
 static bool DumpFrameToPNG(const FrameData& frame, const std::string& file_name)
@@ -38,27 +44,44 @@ FrameDumper::~FrameDumper()
 void FrameDumper::DumpCurrentFrame(const AbstractTexture* src_texture,
                                    const MathUtil::Rectangle<int>& src_rect,
                                    const MathUtil::Rectangle<int>& target_rect, u64 ticks,
-                                   int frame_number)
+                                   int frame_number, const FrameOverlay& overlay)
 {
   int source_width = src_rect.GetWidth();
   int source_height = src_rect.GetHeight();
   int target_width = target_rect.GetWidth();
   int target_height = target_rect.GetHeight();
 
-  // We only need to render a copy if we need to stretch/scale the XFB copy.
+  // We only need to render a copy if we need to stretch/scale the XFB copy or draw over it.
   MathUtil::Rectangle<int> copy_rect = src_rect;
-  if (source_width != target_width || source_height != target_height)
+  if (source_width != target_width || source_height != target_height || overlay)
   {
     if (!CheckFrameDumpRenderTexture(target_width, target_height))
       return;
 
     g_gfx->ScaleTexture(m_frame_dump_render_framebuffer.get(),
                         m_frame_dump_render_framebuffer->GetRect(), src_texture, src_rect);
+    if (overlay)
+      overlay(m_frame_dump_render_framebuffer.get());
     src_texture = m_frame_dump_render_texture.get();
     copy_rect = src_texture->GetRect();
   }
 
-  if (!CheckFrameDumpReadbackTexture(target_width, target_height))
+  // Screenshots need the frame as RGBA, as does anything other than a 4:2:0 encoder. Four luma
+  // samples are packed in each texel, and chroma is subsampled vertically.
+  if (m_ffmpeg_dump.AcceptsNV12() && !m_screenshot_request.IsSet() && target_width % 4 == 0 &&
+      target_height % 2 == 0 && CheckFrameDumpNV12Texture(target_width, target_height))
+  {
+    ConvertFrameToNV12(src_texture, copy_rect);
+    src_texture = m_frame_dump_nv12_texture.get();
+    copy_rect = src_texture->GetRect();
+    m_frame_dump_readback_format = FrameData::Format::NV12;
+  }
+  else
+  {
+    m_frame_dump_readback_format = FrameData::Format::RGBA8;
+  }
+
+  if (!CheckFrameDumpReadbackTexture(copy_rect.GetWidth(), copy_rect.GetHeight()))
     return;
 
   m_frame_dump_readback_texture->CopyFromTexture(src_texture, copy_rect, 0, 0,
@@ -111,6 +134,88 @@ bool FrameDumper::CheckFrameDumpReadbackTexture(u32 target_width, u32 target_hei
   return true;
 }
 
+bool FrameDumper::CheckFrameDumpNV12Texture(u32 target_width, u32 target_height)
+{
+  const u32 width = target_width / 4;
+  const u32 height = target_height + target_height / 2;
+  if (m_frame_dump_nv12_texture && m_frame_dump_nv12_texture->GetWidth() == width &&
+      m_frame_dump_nv12_texture->GetHeight() == height)
+  {
+    return true;
+  }
+
+  if (!m_frame_dump_nv12_pipeline)
+  {
+    m_frame_dump_nv12_shader =
+        g_gfx->CreateShaderFromSource(ShaderStage::Pixel,
+                                      FramebufferShaderGen::GenerateRGBAToNV12PixelShader(),
+                                      "Frame dump NV12 conversion pixel shader");
+    if (!m_frame_dump_nv12_shader)
+      return false;
+
+    AbstractPipelineConfig config;
+    config.vertex_format = nullptr;
+    config.vertex_shader = g_shader_cache->GetScreenQuadVertexShader();
+    config.geometry_shader = nullptr;
+    config.pixel_shader = m_frame_dump_nv12_shader.get();
+    config.rasterization_state =
+        RenderState::GetNoCullRasterizationState(PrimitiveType::Triangles);
+    config.depth_state = RenderState::GetNoDepthTestingDepthState();
+    config.blending_state = RenderState::GetNoBlendingBlendState();
+    config.framebuffer_state = RenderState::GetRGBA8FramebufferState();
+    config.usage = AbstractPipelineUsage::Utility;
+    m_frame_dump_nv12_pipeline = g_gfx->CreatePipeline(config);
+    if (!m_frame_dump_nv12_pipeline)
+    {
+      m_frame_dump_nv12_shader.reset();
+      return false;
+    }
+  }
+
+  m_frame_dump_nv12_framebuffer.reset();
+  m_frame_dump_nv12_texture.reset();
+  m_frame_dump_nv12_texture =
+      g_gfx->CreateTexture(TextureConfig(width, height, 1, 1, 1, AbstractTextureFormat::RGBA8,
+                                         AbstractTextureFlag_RenderTarget),
+                           "Frame dump NV12 texture");
+  if (!m_frame_dump_nv12_texture)
+    return false;
+
+  m_frame_dump_nv12_framebuffer =
+      g_gfx->CreateFramebuffer(m_frame_dump_nv12_texture.get(), nullptr);
+  if (!m_frame_dump_nv12_framebuffer)
+  {
+    m_frame_dump_nv12_texture.reset();
+    return false;
+  }
+
+  return true;
+}
+
+void FrameDumper::ConvertFrameToNV12(const AbstractTexture* src_texture,
+                                     const MathUtil::Rectangle<int>& src_rect)
+{
+  g_gfx->BeginUtilityDrawing();
+
+  struct Uniforms
+  {
+    s32 src_offset[2];
+    s32 luma_height;
+    s32 padding;
+  };
+  const Uniforms uniforms = {{src_rect.left, src_rect.top}, src_rect.GetHeight(), 0};
+  g_vertex_manager->UploadUtilityUniforms(&uniforms, sizeof(uniforms));
+
+  g_gfx->SetAndDiscardFramebuffer(m_frame_dump_nv12_framebuffer.get());
+  g_gfx->SetViewportAndScissor(m_frame_dump_nv12_texture->GetRect());
+  g_gfx->SetPipeline(m_frame_dump_nv12_pipeline.get());
+  g_gfx->SetTexture(0, src_texture);
+  g_gfx->SetSamplerState(0, RenderState::GetPointSamplerState());
+  g_gfx->Draw(0, 3);
+  g_gfx->EndUtilityDrawing();
+  m_frame_dump_nv12_texture->FinishedRendering();
+}
+
 void FrameDumper::FlushFrameDump()
 {
   if (!m_frame_dump_needs_flush)
@@ -120,14 +225,22 @@ void FrameDumper::FlushFrameDump()
   FinishFrameData();
 
   std::swap(m_frame_dump_output_texture, m_frame_dump_readback_texture);
+  std::swap(m_frame_dump_output_format, m_frame_dump_readback_format);
 
   // Queue encoding of the last frame dumped.
   auto& output = m_frame_dump_output_texture;
   output->Flush();
   if (output->Map())
   {
-    DumpFrameData(reinterpret_cast<u8*>(output->GetMappedPointer()), output->GetConfig().width,
-                  output->GetConfig().height, static_cast<int>(output->GetMappedStride()));
+    int width = output->GetConfig().width;
+    int height = output->GetConfig().height;
+    if (m_frame_dump_output_format == FrameData::Format::NV12)
+    {
+      width *= 4;
+      height = height * 2 / 3;
+    }
+    DumpFrameData(reinterpret_cast<u8*>(output->GetMappedPointer()), width, height,
+                  static_cast<int>(output->GetMappedStride()), m_frame_dump_output_format);
   }
   else
   {
@@ -159,14 +272,17 @@ void FrameDumper::ShutdownFrameDumping()
     m_frame_dump_thread.join();
   m_frame_dump_render_framebuffer.reset();
   m_frame_dump_render_texture.reset();
+  m_frame_dump_nv12_framebuffer.reset();
+  m_frame_dump_nv12_texture.reset();
 
   m_frame_dump_readback_texture.reset();
   m_frame_dump_output_texture.reset();
 }
 
-void FrameDumper::DumpFrameData(const u8* data, int w, int h, int stride)
+void FrameDumper::DumpFrameData(const u8* data, int w, int h, int stride,
+                                FrameData::Format format)
 {
-  m_frame_dump_data = FrameData{data, w, h, stride, m_last_frame_state};
+  m_frame_dump_data = FrameData{data, w, h, stride, m_last_frame_state, format};
 
   if (!m_frame_dump_thread_running.IsSet())
   {
@@ -217,8 +333,8 @@ void FrameDumper::FrameDumpThreadFunc()
 
     auto frame = m_frame_dump_data;
 
-    // Save screenshot
-    if (m_screenshot_request.TestAndClear())
+    // Save screenshot. A frame that was converted before the request is left for the next one.
+    if (frame.format == FrameData::Format::RGBA8 && m_screenshot_request.TestAndClear())
     {
       std::lock_guard<std::mutex> lk(m_screenshot_lock);
 
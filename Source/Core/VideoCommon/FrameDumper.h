@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <functional>
+
 #include "Common/CommonTypes.h"
 #include "Common/Event.h"
 #include "Common/Flag.h"
@@ -12,6 +14,8 @@
 #include "VideoCommon/FrameDumpFFMpeg.h"
 #include "VideoCommon/VideoEvents.h"
 
+class AbstractPipeline;
+class AbstractShader;
 class AbstractStagingTexture;
 class AbstractTexture;
 class AbstractFramebuffer;
@@ -25,10 +29,14 @@ public:
   // Ensures all rendered frames are queued for encoding.
   void FlushFrameDump();
 
+  // Draws over a frame in the dump's render target before it is read back
+  using FrameOverlay = std::function<void(AbstractFramebuffer* framebuffer)>;
+
   // Fills the frame dump staging texture with the current XFB texture.
   void DumpCurrentFrame(const AbstractTexture* src_texture,
                         const MathUtil::Rectangle<int>& src_rect,
-                        const MathUtil::Rectangle<int>& target_rect, u64 ticks, int frame_number);
+                        const MathUtil::Rectangle<int>& target_rect, u64 ticks, int frame_number,
+                        const FrameOverlay& overlay = {});
 
   void SaveScreenshot(std::string filename);
 
@@ -54,8 +62,17 @@ private:
   // Checks that the frame dump readback texture exists and is the correct size.
   bool CheckFrameDumpReadbackTexture(u32 target_width, u32 target_height);
 
+  // Checks that the texture and pipeline for converting frames to NV12 exist, for a frame of the
+  // given size.
+  bool CheckFrameDumpNV12Texture(u32 target_width, u32 target_height);
+
+  // Converts the frame to NV12 in m_frame_dump_nv12_texture, so that the encoder has less to read
+  // back and nothing left to convert.
+  void ConvertFrameToNV12(const AbstractTexture* src_texture,
+                          const MathUtil::Rectangle<int>& src_rect);
+
   // Asynchronously encodes the specified pointer of frame data to the frame dump.
-  void DumpFrameData(const u8* data, int w, int h, int stride);
+  void DumpFrameData(const u8* data, int w, int h, int stride, FrameData::Format format);
 
   // Ensures all encoded frames have been written to the output file.
   void FinishFrameData();
@@ -79,9 +96,17 @@ private:
   std::unique_ptr<AbstractTexture> m_frame_dump_render_texture;
   std::unique_ptr<AbstractFramebuffer> m_frame_dump_render_framebuffer;
 
+  // Frames converted to NV12, as RGBA8 holding four bytes per texel
+  std::unique_ptr<AbstractTexture> m_frame_dump_nv12_texture;
+  std::unique_ptr<AbstractFramebuffer> m_frame_dump_nv12_framebuffer;
+  std::unique_ptr<AbstractShader> m_frame_dump_nv12_shader;
+  std::unique_ptr<AbstractPipeline> m_frame_dump_nv12_pipeline;
+
   // Double buffer:
   std::unique_ptr<AbstractStagingTexture> m_frame_dump_readback_texture;
   std::unique_ptr<AbstractStagingTexture> m_frame_dump_output_texture;
+  FrameData::Format m_frame_dump_readback_format = FrameData::Format::RGBA8;
+  FrameData::Format m_frame_dump_output_format = FrameData::Format::RGBA8;
   // Set when readback texture holds a frame that needs to be dumped.
   bool m_frame_dump_needs_flush = false;
   // Set when thread is processing output texture.
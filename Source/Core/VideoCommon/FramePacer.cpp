@@ -0,0 +1,46 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/FramePacer.h"
+
+#include <algorithm>
+
+FramePacer g_frame_pacer;
+
+void FramePacer::Reset()
+{
+  std::lock_guard lock(m_mutex);
+  m_next_sample = 0;
+  m_num_samples = 0;
+  m_delay.store(0, std::memory_order_relaxed);
+}
+
+void FramePacer::AddPresent(DT latency, DT wait, bool enabled)
+{
+  DT delay = DT::zero();
+  if (enabled)
+  {
+    // A frame that didn't wait long enough moves the CPU back at once, as the next one could miss
+    // its refresh. One that waited too long moves it later a bit at a time, so that a single frame
+    // which happened to be quick doesn't make the following ones late.
+    const DT error = wait - TARGET_WAIT;
+    delay = GetDelay() + (error > DT::zero() ? error / 8 : error);
+    delay = std::clamp(delay, DT::zero(), MAX_DELAY);
+  }
+  m_delay.store(delay.count(), std::memory_order_relaxed);
+
+  std::lock_guard lock(m_mutex);
+  m_samples[m_next_sample] = {latency, wait, delay};
+  m_next_sample = (m_next_sample + 1) % NUM_SAMPLES;
+  m_num_samples = std::min(m_num_samples + 1, NUM_SAMPLES);
+}
+
+std::vector<FramePacer::Sample> FramePacer::GetSamples() const
+{
+  std::lock_guard lock(m_mutex);
+  std::vector<Sample> samples;
+  samples.reserve(m_num_samples);
+  for (std::size_t i = 0; i < m_num_samples; ++i)
+    samples.push_back(m_samples[(m_next_sample + NUM_SAMPLES - m_num_samples + i) % NUM_SAMPLES]);
+  return samples;
+}
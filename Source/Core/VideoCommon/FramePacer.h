@@ -0,0 +1,61 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+// Delays the emulated CPU so that frames are finished just before the display is ready for them.
+// With V-Sync, a frame that is finished early waits in the backend until the display refreshes,
+// and the input it was emulated with is that much older by the time it's shown.
+//
+// How long presenting blocks is measured for every frame, and the CPU is moved later until frames
+// only wait for TARGET_WAIT. The CPU then runs at the same speed as before, only later.
+class FramePacer
+{
+public:
+  // How long frames are aimed to wait for the display, to absorb frames that take longer
+  static constexpr DT TARGET_WAIT = std::chrono::milliseconds(2);
+  // The most that the CPU is delayed by, as a frame taking longer would miss its refresh
+  static constexpr DT MAX_DELAY = std::chrono::milliseconds(8);
+
+  static constexpr std::size_t NUM_SAMPLES = 256;
+
+  struct Sample
+  {
+    // From when the frame was handed to the presenter until it was presented
+    DT latency;
+    // How much of the latency was spent waiting for the display
+    DT wait;
+    // The delay of the CPU after this frame
+    DT delay;
+  };
+
+  void Reset();
+
+  // Called on the video thread after presenting. The delay only changes while enabled.
+  void AddPresent(DT latency, DT wait, bool enabled);
+
+  // How much later the CPU should run than the throttle would have it
+  DT GetDelay() const { return DT(m_delay.load(std::memory_order_relaxed)); }
+
+  // The samples of the most recent frames, oldest first
+  std::vector<Sample> GetSamples() const;
+
+private:
+  mutable std::mutex m_mutex;
+  std::array<Sample, NUM_SAMPLES> m_samples{};
+  std::size_t m_next_sample = 0;
+  std::size_t m_num_samples = 0;
+
+  std::atomic<DT::rep> m_delay{0};
+};
+
+extern FramePacer g_frame_pacer;
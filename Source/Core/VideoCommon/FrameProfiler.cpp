@@ -0,0 +1,92 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/FrameProfiler.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "Common/Timer.h"
+#include "VideoCommon/VideoEvents.h"
+
+FrameProfiler g_frame_profiler;
+
+// The innermost scope of each thread, which stops counting while stages are entered from it
+static thread_local FrameProfiler::Scope* s_current_scope = nullptr;
+
+FrameProfiler::Scope::Scope(Stage stage, bool active)
+    : m_stage(stage), m_active(active && g_frame_profiler.IsEnabled())
+{
+  if (!m_active)
+    return;
+
+  m_start_us = Common::Timer::NowUs();
+  m_parent = s_current_scope;
+  s_current_scope = this;
+}
+
+FrameProfiler::Scope::~Scope()
+{
+  if (!m_active)
+    return;
+
+  const u64 time_us = Common::Timer::NowUs() - m_start_us;
+  g_frame_profiler.AddStageTime(m_stage, time_us - std::min(m_nested_us, time_us));
+  if (m_parent)
+    m_parent->m_nested_us += time_us;
+  s_current_scope = m_parent;
+}
+
+void FrameProfiler::SetEnabled(bool enabled)
+{
+  if (enabled == IsEnabled())
+    return;
+
+  if (enabled)
+  {
+    for (auto& time : m_stage_time_us)
+      time.store(0, std::memory_order_relaxed);
+    m_last_present_us = Common::Timer::NowUs();
+    m_after_present_event = AfterPresentEvent::Register(
+        [this](const PresentInfo&) { EndFrame(); }, "FrameProfiler");
+  }
+  else
+  {
+    m_after_present_event.reset();
+  }
+
+  m_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+std::vector<FrameProfiler::Frame> FrameProfiler::TakeFrames()
+{
+  std::lock_guard lk(m_frames_mutex);
+  return std::exchange(m_frames, {});
+}
+
+const char* FrameProfiler::GetStageName(Stage stage)
+{
+  static constexpr std::array<const char*, NUM_STAGES> names = {
+      "opcode_decode", "vertex_load", "shader_lookup", "texture_cache", "present",
+  };
+  return names[static_cast<size_t>(stage)];
+}
+
+void FrameProfiler::AddStageTime(Stage stage, u64 time_us)
+{
+  m_stage_time_us[static_cast<size_t>(stage)].fetch_add(time_us, std::memory_order_relaxed);
+}
+
+void FrameProfiler::EndFrame()
+{
+  const u64 now_us = Common::Timer::NowUs();
+
+  Frame frame;
+  frame.frame_time_us = now_us - m_last_present_us;
+  for (size_t i = 0; i < NUM_STAGES; i++)
+    frame.stage_time_us[i] = m_stage_time_us[i].exchange(0, std::memory_order_relaxed);
+  m_last_present_us = now_us;
+
+  std::lock_guard lk(m_frames_mutex);
+  m_frames.push_back(frame);
+}
@@ -0,0 +1,80 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/HookableEvent.h"
+
+// Sums up the time spent in the main stages of the video pipeline for every presented frame, so
+// that replays of the same FIFO log can be compared between builds and backends. Disabled by
+// default, in which case entering a stage only checks a flag.
+class FrameProfiler
+{
+public:
+  enum class Stage
+  {
+    // Everything done while running the FIFO that is not part of another stage, which includes
+    // the draw calls of the backend
+    OpcodeDecode,
+    VertexLoad,
+    ShaderLookup,
+    TextureCache,
+    Present,
+    Count,
+  };
+  static constexpr size_t NUM_STAGES = static_cast<size_t>(Stage::Count);
+
+  struct Frame
+  {
+    // Time since the previous present
+    u64 frame_time_us;
+    // Time spent in each stage, without the time spent in other stages entered from it
+    std::array<u64, NUM_STAGES> stage_time_us;
+  };
+
+  // Adds the time until it is destroyed to a stage, unless it is created inactive
+  class Scope
+  {
+  public:
+    explicit Scope(Stage stage, bool active = true);
+    ~Scope();
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+  private:
+    Stage m_stage;
+    bool m_active;
+    u64 m_start_us = 0;
+    u64 m_nested_us = 0;
+    Scope* m_parent = nullptr;
+  };
+
+  void SetEnabled(bool enabled);
+  bool IsEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+  // Returns the frames recorded since the last call
+  std::vector<Frame> TakeFrames();
+
+  static const char* GetStageName(Stage stage);
+
+private:
+  void AddStageTime(Stage stage, u64 time_us);
+  void EndFrame();
+
+  std::atomic<bool> m_enabled = false;
+  std::array<std::atomic<u64>, NUM_STAGES> m_stage_time_us{};
+  u64 m_last_present_us = 0;
+  Common::EventHook m_after_present_event;
+
+  std::mutex m_frames_mutex;
+  std::vector<Frame> m_frames;
+};
+
+extern FrameProfiler g_frame_profiler;
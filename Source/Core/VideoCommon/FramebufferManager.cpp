@@ -22,6 +22,7 @@
 #include "VideoCommon/FramebufferShaderGen.h"
 #include "VideoCommon/PixelShaderManager.h"
 #include "VideoCommon/Present.h"
+#include "VideoCommon/Statistics.h"
 #include "VideoCommon/VertexManagerBase.h"
 #include "VideoCommon/VideoCommon.h"
 #include "VideoCommon/VideoConfig.h"
@@ -319,6 +320,14 @@ AbstractTexture* FramebufferManager::ResolveEFBColorTexture(const MathUtil::Rect
   MathUtil::Rectangle<int> clamped_region = region;
   clamped_region.ClampUL(0, 0, GetEFBWidth(), GetEFBHeight());
 
+  // Copies of the same part of the EFB, such as the VRAM and RAM halves of an EFB copy, share the
+  // resolve as long as nothing has been drawn in between.
+  if (IsRegionResolved(m_efb_color_resolved_region, clamped_region))
+  {
+    INCSTAT(g_stats.this_frame.num_efb_resolves_reused);
+    return m_efb_resolve_color_texture.get();
+  }
+
   // Resolve to our already-created texture.
   if (g_ActiveConfig.backend_info.bSupportsPartialMultisampleResolve)
   {
@@ -342,6 +351,7 @@ AbstractTexture* FramebufferManager::ResolveEFBColorTexture(const MathUtil::Rect
     g_gfx->EndUtilityDrawing();
   }
   m_efb_resolve_color_texture->FinishedRendering();
+  m_efb_color_resolved_region = clamped_region;
   return m_efb_resolve_color_texture.get();
 }
 
@@ -357,6 +367,11 @@ AbstractTexture* FramebufferManager::ResolveEFBDepthTexture(const MathUtil::Rect
   // It's not valid to resolve an out-of-range rectangle.
   MathUtil::Rectangle<int> clamped_region = region;
   clamped_region.ClampUL(0, 0, GetEFBWidth(), GetEFBHeight());
+  if (IsRegionResolved(m_efb_depth_resolved_region, clamped_region))
+  {
+    INCSTAT(g_stats.this_frame.num_efb_resolves_reused);
+    return m_efb_depth_resolve_texture.get();
+  }
 
   m_efb_depth_texture->FinishedRendering();
   g_gfx->BeginUtilityDrawing();
@@ -370,9 +385,24 @@ AbstractTexture* FramebufferManager::ResolveEFBDepthTexture(const MathUtil::Rect
   m_efb_depth_resolve_texture->FinishedRendering();
   g_gfx->EndUtilityDrawing();
 
+  m_efb_depth_resolved_region = clamped_region;
   return m_efb_depth_resolve_texture.get();
 }
 
+bool FramebufferManager::IsRegionResolved(const MathUtil::Rectangle<int>& resolved_region,
+                                          const MathUtil::Rectangle<int>& region)
+{
+  return resolved_region.GetWidth() > 0 && resolved_region.GetHeight() > 0 &&
+         region.left >= resolved_region.left && region.top >= resolved_region.top &&
+         region.right <= resolved_region.right && region.bottom <= resolved_region.bottom;
+}
+
+void FramebufferManager::InvalidateEFBResolves()
+{
+  m_efb_color_resolved_region = {};
+  m_efb_depth_resolved_region = {};
+}
+
 bool FramebufferManager::ReinterpretPixelData(EFBReinterpretType convtype)
 {
   if (!m_format_conversion_pipelines[static_cast<u32>(convtype)])
@@ -478,7 +508,7 @@ u32 FramebufferManager::PeekEFBColor(u32 x, u32 y)
   if (!IsEFBCacheTilePresent(false, x, y, &tile_index))
     PopulateEFBCache(false, tile_index);
 
-  m_efb_color_cache.tiles[tile_index].frame_access_mask |= 1;
+  OnPeekCacheTileRead(m_efb_color_cache.tiles[tile_index]);
 
   if (m_efb_color_cache.needs_flush)
   {
@@ -501,7 +531,7 @@ float FramebufferManager::PeekEFBDepth(u32 x, u32 y)
   if (!IsEFBCacheTilePresent(true, x, y, &tile_index))
     PopulateEFBCache(true, tile_index);
 
-  m_efb_depth_cache.tiles[tile_index].frame_access_mask |= 1;
+  OnPeekCacheTileRead(m_efb_depth_cache.tiles[tile_index]);
 
   if (m_efb_depth_cache.needs_flush)
   {
@@ -560,6 +590,9 @@ void FramebufferManager::RefreshPeekCache()
 
 void FramebufferManager::InvalidatePeekCache(bool forced)
 {
+  if (forced)
+    InvalidateEFBResolves();
+
   if (forced || m_efb_color_cache.out_of_date)
   {
     if (m_efb_color_cache.has_active_tiles)
@@ -594,6 +627,8 @@ void FramebufferManager::InvalidatePeekCache(bool forced)
 
 void FramebufferManager::FlagPeekCacheAsOutOfDate()
 {
+  InvalidateEFBResolves();
+
   if (m_efb_color_cache.has_active_tiles)
     m_efb_color_cache.out_of_date = true;
   if (m_efb_depth_cache.has_active_tiles)
@@ -603,12 +638,108 @@ void FramebufferManager::FlagPeekCacheAsOutOfDate()
     InvalidatePeekCache();
 }
 
+void FramebufferManager::FlagPeekCacheAsOutOfDate(const MathUtil::Rectangle<int>& rc)
+{
+  InvalidateEFBResolves();
+
+  if (!IsTrackingPeekCacheTiles())
+  {
+    FlagPeekCacheAsOutOfDate();
+    return;
+  }
+
+  // Like peeks, tiles use the origin of the readback texture.
+  MathUtil::Rectangle<int> rect = rc;
+  rect.ClampUL(0, 0, EFB_WIDTH, EFB_HEIGHT);
+  if (rect.GetWidth() <= 0 || rect.GetHeight() <= 0)
+    return;
+  if (g_ActiveConfig.backend_info.bUsesLowerLeftOrigin)
+  {
+    rect = MathUtil::Rectangle<int>(rect.left, EFB_HEIGHT - rect.bottom, rect.right,
+                                    EFB_HEIGHT - rect.top);
+  }
+
+  m_efb_cache_draw_count++;
+
+  u32 first_tile_x = 0, last_tile_x = 0, first_tile_y = 0, last_tile_y = 0;
+  if (IsUsingTiledEFBCache())
+  {
+    first_tile_x = rect.left / m_efb_cache_tile_size;
+    last_tile_x = (rect.right - 1) / m_efb_cache_tile_size;
+    first_tile_y = rect.top / m_efb_cache_tile_size;
+    last_tile_y = (rect.bottom - 1) / m_efb_cache_tile_size;
+  }
+
+  bool flush_command_buffer = false;
+  for (u32 tile_y = first_tile_y; tile_y <= last_tile_y; tile_y++)
+  {
+    for (u32 tile_x = first_tile_x; tile_x <= last_tile_x; tile_x++)
+    {
+      const u32 tile_index = (tile_y * m_efb_cache_tile_row_stride) + tile_x;
+      flush_command_buffer |= InvalidatePeekCacheTile(false, tile_index);
+      flush_command_buffer |= InvalidatePeekCacheTile(true, tile_index);
+    }
+  }
+
+  // Submit the readbacks now, so that they have completed by the time the tiles are read.
+  if (flush_command_buffer)
+    g_gfx->Flush();
+}
+
+bool FramebufferManager::IsTrackingPeekCacheTiles() const
+{
+  return g_ActiveConfig.bEFBAccessPredictiveReadback &&
+         !g_ActiveConfig.bEFBAccessDeferInvalidation && m_efb_cache_accessed;
+}
+
+bool FramebufferManager::InvalidatePeekCacheTile(bool depth, u32 tile_index)
+{
+  EFBCacheData& data = depth ? m_efb_depth_cache : m_efb_color_cache;
+  EFBCacheTile& tile = data.tiles[tile_index];
+  tile.present = false;
+  tile.last_draw = m_efb_cache_draw_count;
+
+  // Last frame, the tile was read after this draw and nothing drew to it in between. Assume the
+  // same this frame and start copying it back. If a later draw changes the tile before it is read,
+  // it is invalidated again and the read falls back to a blocking readback.
+  if (tile.predicted_last_draw == 0 || m_efb_cache_draw_count < tile.predicted_last_draw ||
+      m_efb_cache_draw_count > tile.predicted_read_draw)
+  {
+    return false;
+  }
+
+  PopulateEFBCache(depth, tile_index, true);
+  return true;
+}
+
+void FramebufferManager::OnPeekCacheTileRead(EFBCacheTile& tile)
+{
+  if ((tile.frame_access_mask & 1) == 0)
+  {
+    tile.read_last_draw = tile.last_draw;
+    tile.read_draw = m_efb_cache_draw_count;
+  }
+
+  tile.frame_access_mask |= 1;
+  m_efb_cache_accessed = true;
+}
+
 void FramebufferManager::EndOfFrame()
 {
-  for (u32 i = 0; i < m_efb_color_cache.tiles.size(); i++)
+  m_efb_cache_accessed = false;
+  m_efb_cache_draw_count = 0;
+  for (EFBCacheData* data : {&m_efb_color_cache, &m_efb_depth_cache})
   {
-    m_efb_color_cache.tiles[i].frame_access_mask <<= 1;
-    m_efb_depth_cache.tiles[i].frame_access_mask <<= 1;
+    for (EFBCacheTile& tile : data->tiles)
+    {
+      const bool read_this_frame = (tile.frame_access_mask & 1) != 0;
+      tile.predicted_last_draw = read_this_frame ? tile.read_last_draw : 0;
+      tile.predicted_read_draw = read_this_frame ? tile.read_draw : 0;
+      tile.last_draw = 0;
+
+      tile.frame_access_mask <<= 1;
+      m_efb_cache_accessed |= tile.frame_access_mask != 0;
+    }
   }
 }
 
@@ -849,7 +980,6 @@ void FramebufferManager::ClearEFB(const MathUtil::Rectangle<int>& rc, bool color
                                   bool alpha_enable, bool z_enable, u32 color, u32 z)
 {
   FlushEFBPokes();
-  FlagPeekCacheAsOutOfDate();
 
   // Native -> EFB coordinates
   MathUtil::Rectangle<int> target_rc = ConvertEFBRectangle(rc);
@@ -871,6 +1001,9 @@ void FramebufferManager::ClearEFB(const MathUtil::Rectangle<int>& rc, bool color
 
   g_gfx->ClearRegion(target_rc, color_enable, alpha_enable, z_enable, color, z);
 
+  // After the clear, so that tiles which are read back predictively include it.
+  FlagPeekCacheAsOutOfDate(rc);
+
   // Scissor rect must be restored.
   BPFunctions::SetScissorAndViewport();
 }
@@ -1019,6 +1152,8 @@ void FramebufferManager::FlushEFBPokes()
 void FramebufferManager::DrawPokeVertices(const EFBPokeVertex* vertices, u32 vertex_count,
                                           const AbstractPipeline* pipeline)
 {
+  InvalidateEFBResolves();
+
   // Copy to vertex buffer.
   g_gfx->BeginUtilityDrawing();
   u32 base_vertex, base_index;
@@ -121,6 +121,11 @@ public:
   void InvalidatePeekCache(bool forced = true);
   void RefreshPeekCache();
   void FlagPeekCacheAsOutOfDate();
+  // Invalidates the tiles in a native EFB rectangle that was just drawn to, and starts reading
+  // back the tiles that were read after this point in the last frame. Only used when
+  // IsTrackingPeekCacheTiles(), otherwise the whole cache is flagged as out of date.
+  void FlagPeekCacheAsOutOfDate(const MathUtil::Rectangle<int>& rc);
+  bool IsTrackingPeekCacheTiles() const;
   void EndOfFrame();
 
   // Writes a value to the framebuffer. This will never block, and writes will be batched.
@@ -143,6 +148,15 @@ protected:
   {
     bool present;
     u8 frame_access_mask;
+
+    // Predictive readback, in draws since the start of the frame (0 for none): the last draw to
+    // the tile, the last draw to the tile and the current draw at its first read this frame, and
+    // the same two values from the last frame.
+    u32 last_draw;
+    u32 read_last_draw;
+    u32 read_draw;
+    u32 predicted_last_draw;
+    u32 predicted_read_draw;
   };
 
   // EFB cache - for CPU EFB access
@@ -182,6 +196,8 @@ protected:
   bool IsEFBCacheTilePresent(bool depth, u32 x, u32 y, u32* tile_index) const;
   MathUtil::Rectangle<int> GetEFBCacheTileRect(u32 tile_index) const;
   void PopulateEFBCache(bool depth, u32 tile_index, bool async = false);
+  bool InvalidatePeekCacheTile(bool depth, u32 tile_index);
+  void OnPeekCacheTileRead(EFBCacheTile& tile);
 
   void CreatePokeVertices(std::vector<EFBPokeVertex>* destination_list, u32 x, u32 y, float z,
                           u32 color);
@@ -189,6 +205,11 @@ protected:
   void DrawPokeVertices(const EFBPokeVertex* vertices, u32 vertex_count,
                         const AbstractPipeline* pipeline);
 
+  static bool IsRegionResolved(const MathUtil::Rectangle<int>& resolved_region,
+                               const MathUtil::Rectangle<int>& region);
+  // Called whenever the EFB is drawn to.
+  void InvalidateEFBResolves();
+
   std::tuple<u32, u32> CalculateTargetSize();
 
   void DoLoadState(PointerWrap& p);
@@ -203,6 +224,10 @@ protected:
   std::unique_ptr<AbstractTexture> m_efb_resolve_color_texture;
   std::unique_ptr<AbstractTexture> m_efb_depth_resolve_texture;
 
+  // What of the EFB the resolve textures still hold, empty if it has changed since
+  MathUtil::Rectangle<int> m_efb_color_resolved_region;
+  MathUtil::Rectangle<int> m_efb_depth_resolved_region;
+
   std::unique_ptr<AbstractFramebuffer> m_efb_framebuffer;
   std::unique_ptr<AbstractFramebuffer> m_efb_convert_framebuffer;
   std::unique_ptr<AbstractFramebuffer> m_efb_color_resolve_framebuffer;
@@ -226,6 +251,10 @@ protected:
   u32 m_efb_cache_tile_row_stride = 1;
   EFBCacheData m_efb_color_cache = {};
   EFBCacheData m_efb_depth_cache = {};
+  // Whether the EFB was read recently, and the number of draws this frame, for predictive
+  // readback.
+  bool m_efb_cache_accessed = false;
+  u32 m_efb_cache_draw_count = 0;
 
   // EFB clear pipelines
   // Indexed by [color_write_enabled][alpha_write_enabled][depth_write_enabled]
@@ -647,6 +647,58 @@ std::string GenerateEFBRestorePixelShader()
   return code.GetBuffer();
 }
 
+std::string GenerateRGBAToNV12PixelShader()
+{
+  // The output is RGBA8, with four bytes of NV12 in each texel. Above luma_height, it holds the
+  // luma plane, and below it the interleaved chroma, each sample of which is the average of a 2x2
+  // block. The same coefficients as swscale are used, for BT.601 with limited range.
+  ShaderCode code;
+  EmitUniformBufferDeclaration(code);
+  code.Write("{{\n"
+             "  int2 src_offset;\n"
+             "  int luma_height;\n"
+             "  int padding;\n"
+             "}};\n\n");
+  EmitSamplerDeclarations(code, 0, 1, false);
+  code.Write("float3 LoadRGB(int2 coords)\n"
+             "{{\n"
+             "  return ");
+  EmitTextureLoad(code, 0, "int4(src_offset + coords, 0, 0)");
+  code.Write(".rgb;\n"
+             "}}\n\n"
+             "float3 LoadBlock(int2 coords)\n"
+             "{{\n"
+             "  return (LoadRGB(coords) + LoadRGB(coords + int2(1, 0)) +\n"
+             "          LoadRGB(coords + int2(0, 1)) + LoadRGB(coords + int2(1, 1))) * 0.25;\n"
+             "}}\n\n");
+  EmitPixelMainDeclaration(code, 1, 0, "float4", "", true);
+  code.Write("{{\n"
+             "  const float3 y_coeffs = float3(0.256788, 0.504129, 0.097906);\n"
+             "  const float3 u_coeffs = float3(-0.148223, -0.290993, 0.439216);\n"
+             "  const float3 v_coeffs = float3(0.439216, -0.367788, -0.071427);\n"
+             "  int2 pos = int2(frag_coord.xy);\n"
+             "  if (pos.y < luma_height)\n"
+             "  {{\n"
+             "    int x = pos.x * 4;\n"
+             "    ocol0 = float4(dot(LoadRGB(int2(x, pos.y)), y_coeffs),\n"
+             "                   dot(LoadRGB(int2(x + 1, pos.y)), y_coeffs),\n"
+             "                   dot(LoadRGB(int2(x + 2, pos.y)), y_coeffs),\n"
+             "                   dot(LoadRGB(int2(x + 3, pos.y)), y_coeffs)) +\n"
+             "            16.0 / 255.0;\n"
+             "  }}\n"
+             "  else\n"
+             "  {{\n"
+             "    int2 coords = int2(pos.x * 4, (pos.y - luma_height) * 2);\n"
+             "    float3 left = LoadBlock(coords);\n"
+             "    float3 right = LoadBlock(coords + int2(2, 0));\n"
+             "    ocol0 = float4(dot(left, u_coeffs), dot(left, v_coeffs), dot(right, u_coeffs),\n"
+             "                   dot(right, v_coeffs)) +\n"
+             "            128.0 / 255.0;\n"
+             "  }}\n"
+             "}}\n");
+  return code.GetBuffer();
+}
+
 std::string GenerateImGuiVertexShader()
 {
   ShaderCode code;
@@ -222,12 +222,14 @@ void CameraControllerInput::IncreaseFovX(float fov)
 {
   m_fov_x_multiplier += fov;
   m_fov_x_multiplier = std::max(m_fov_x_multiplier, MIN_FOV_MULTIPLIER);
+  m_dirty = true;
 }
 
 void CameraControllerInput::IncreaseFovY(float fov)
 {
   m_fov_y_multiplier += fov;
   m_fov_y_multiplier = std::max(m_fov_y_multiplier, MIN_FOV_MULTIPLIER);
+  m_dirty = true;
 }
 
 float CameraControllerInput::GetFovStepSize() const
@@ -2,9 +2,100 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include "VideoCommon/GraphicsModSystem/Runtime/CustomShaderCache.h"
+
+#include <cstring>
+
+#include "Common/Hash.h"
+#include "Common/Logging/Log.h"
+
 #include "VideoCommon/AbstractGfx.h"
+#include "VideoCommon/NativeVertexFormat.h"
+#include "VideoCommon/ShaderCache.h"
+#include "VideoCommon/VertexLoaderManager.h"
 #include "VideoCommon/VideoConfig.h"
 
+namespace
+{
+void AppendU32(std::vector<u8>* data, u32 value)
+{
+  const auto* bytes = reinterpret_cast<const u8*>(&value);
+  data->insert(data->end(), bytes, bytes + sizeof(value));
+}
+
+bool ReadU32(const u8** data, const u8* end, u32* value)
+{
+  if (static_cast<size_t>(end - *data) < sizeof(u32))
+    return false;
+  std::memcpy(value, *data, sizeof(u32));
+  *data += sizeof(u32);
+  return true;
+}
+
+// The custom shaders are stored in front of the cache data of the pipeline, as a count followed
+// by the length and source of each shader.
+std::vector<u8> SerializeCustomShaders(const CustomShaderInstance& custom_shaders)
+{
+  std::vector<u8> data;
+  AppendU32(&data, static_cast<u32>(custom_shaders.pixel_contents.shaders.size()));
+  for (const CustomPixelShader& shader : custom_shaders.pixel_contents.shaders)
+  {
+    AppendU32(&data, static_cast<u32>(shader.custom_shader.size()));
+    data.insert(data.end(), shader.custom_shader.begin(), shader.custom_shader.end());
+  }
+  return data;
+}
+
+// Returns the size of the custom shaders, or zero if the data is truncated
+size_t UnserializeCustomShaders(const u8* data, u32 data_size, CustomShaderInstance* custom_shaders)
+{
+  const u8* const end = data + data_size;
+  const u8* ptr = data;
+  u32 num_shaders;
+  if (!ReadU32(&ptr, end, &num_shaders))
+    return 0;
+
+  for (u32 i = 0; i < num_shaders; i++)
+  {
+    u32 length;
+    if (!ReadU32(&ptr, end, &length) || static_cast<size_t>(end - ptr) < length)
+      return 0;
+
+    CustomPixelShader& shader = custom_shaders->pixel_contents.shaders.emplace_back();
+    shader.custom_shader.assign(reinterpret_cast<const char*>(ptr), length);
+    ptr += length;
+  }
+  return ptr - data;
+}
+
+void SerializePipelineUid(const VideoCommon::GXPipelineUid& uid,
+                          VideoCommon::SerializedGXPipelineUid* serialized_uid)
+{
+  // Ensure all padding bytes are zero, as the key is compared as a whole.
+  std::memset(static_cast<void*>(serialized_uid), 0, sizeof(*serialized_uid));
+  serialized_uid->vertex_decl = uid.vertex_format->GetVertexDeclaration();
+  serialized_uid->vs_uid = uid.vs_uid;
+  serialized_uid->gs_uid = uid.gs_uid;
+  serialized_uid->ps_uid = uid.ps_uid;
+  serialized_uid->rasterization_state_bits = uid.rasterization_state.hex;
+  serialized_uid->depth_state_bits = uid.depth_state.hex;
+  serialized_uid->blending_state_bits = uid.blending_state.hex;
+}
+
+VideoCommon::GXPipelineUid
+UnserializePipelineUid(const VideoCommon::SerializedGXPipelineUid& serialized_uid)
+{
+  VideoCommon::GXPipelineUid uid;
+  uid.vertex_format = VertexLoaderManager::GetOrCreateMatchingFormat(serialized_uid.vertex_decl);
+  uid.vs_uid = serialized_uid.vs_uid;
+  uid.gs_uid = serialized_uid.gs_uid;
+  uid.ps_uid = serialized_uid.ps_uid;
+  uid.rasterization_state.hex = serialized_uid.rasterization_state_bits;
+  uid.depth_state.hex = serialized_uid.depth_state_bits;
+  uid.blending_state.hex = serialized_uid.blending_state_bits;
+  return uid;
+}
+}  // namespace
+
 CustomShaderCache::CustomShaderCache()
 {
   m_api_type = g_ActiveConfig.backend_info.api_type;
@@ -18,10 +109,15 @@ CustomShaderCache::CustomShaderCache()
 
   m_frame_end_handler =
       AfterFrameEvent::Register([this] { RetrieveAsyncShaders(); }, "RetreiveAsyncShaders");
+
+  LoadPipelineCache();
 }
 
 CustomShaderCache::~CustomShaderCache()
 {
+  m_pipeline_disk_cache.Sync();
+  m_pipeline_disk_cache.Close();
+
   if (m_async_shader_compiler)
     m_async_shader_compiler->StopWorkerThreads();
 
@@ -33,6 +129,7 @@ void CustomShaderCache::RetrieveAsyncShaders()
 {
   m_async_shader_compiler->RetrieveWorkItems();
   m_async_uber_shader_compiler->RetrieveWorkItems();
+  QueueCachedPipelines();
 }
 
 void CustomShaderCache::Reload()
@@ -52,6 +149,90 @@ void CustomShaderCache::Reload()
   m_uber_ps_cache = {};
   m_pipeline_cache = {};
   m_uber_pipeline_cache = {};
+
+  // The host config is part of the file name
+  m_pipeline_disk_cache.Sync();
+  m_pipeline_disk_cache.Close();
+  LoadPipelineCache();
+}
+
+void CustomShaderCache::LoadPipelineCache()
+{
+  m_cached_pipelines.clear();
+  if (!g_ActiveConfig.bShaderCache || !g_ActiveConfig.bGraphicMods ||
+      m_api_type == APIType::Nothing)
+  {
+    return;
+  }
+
+  class CacheReader : public Common::LinearDiskCacheReader<SerializedCustomPipelineUid, u8>
+  {
+  public:
+    explicit CacheReader(std::vector<CachedPipeline>* pipelines) : m_pipelines(pipelines) {}
+    void Read(const SerializedCustomPipelineUid& key, const u8* value, u32 value_size) override
+    {
+      CachedPipeline pipeline;
+      pipeline.uid = key.uid;
+      const size_t shaders_size =
+          UnserializeCustomShaders(value, value_size, &pipeline.custom_shaders);
+      if (shaders_size == 0 || Common::HashData(value, shaders_size) != key.custom_shaders_hash)
+        return;
+
+      pipeline.cache_data.assign(value + shaders_size, value + value_size);
+      m_pipelines->push_back(std::move(pipeline));
+    }
+
+  private:
+    std::vector<CachedPipeline>* m_pipelines;
+  };
+
+  // Nothing is created here, as the pipelines they're based on may not be loaded yet
+  const std::string filename =
+      GetDiskShaderCacheFileName(m_api_type, "custom-pipeline", true, true);
+  CacheReader reader(&m_cached_pipelines);
+  const u32 count = m_pipeline_disk_cache.OpenAndRead(filename, reader);
+  INFO_LOG_FMT(VIDEO, "Loaded {} cached custom pipelines from {}", count, filename);
+}
+
+void CustomShaderCache::QueueCachedPipelines()
+{
+  for (auto it = m_cached_pipelines.begin(); it != m_cached_pipelines.end();)
+  {
+    const VideoCommon::GXPipelineUid uid = UnserializePipelineUid(it->uid);
+    const std::optional<const AbstractPipeline*> base_pipeline =
+        g_shader_cache->GetPipelineForUidAsync(uid);
+    if (!base_pipeline)
+    {
+      // The custom pipeline reuses the vertex and geometry shaders of this one
+      ++it;
+      continue;
+    }
+
+    if (*base_pipeline && !m_pipeline_cache.GetHolder(uid, it->custom_shaders))
+    {
+      AsyncCreatePipeline(uid, it->custom_shaders, (*base_pipeline)->m_config,
+                          std::move(it->cache_data), true);
+    }
+    it = m_cached_pipelines.erase(it);
+  }
+}
+
+void CustomShaderCache::AppendPipelineToCache(const VideoCommon::GXPipelineUid& uid,
+                                              const CustomShaderInstance& custom_shaders,
+                                              const AbstractPipeline& pipeline)
+{
+  std::vector<u8> value = SerializeCustomShaders(custom_shaders);
+
+  SerializedCustomPipelineUid key;
+  SerializePipelineUid(uid, &key.uid);
+  key.custom_shaders_hash = Common::HashData(value.data(), value.size());
+
+  if (g_ActiveConfig.backend_info.bSupportsPipelineCacheData)
+  {
+    const AbstractPipeline::CacheData cache_data = pipeline.GetCacheData();
+    value.insert(value.end(), cache_data.begin(), cache_data.end());
+  }
+  m_pipeline_disk_cache.Append(key, value.data(), static_cast<u32>(value.size()));
 }
 
 std::optional<const AbstractPipeline*>
@@ -85,18 +266,21 @@ CustomShaderCache::GetPipelineAsync(const VideoCommon::GXUberPipelineUid& uid,
 }
 
 void CustomShaderCache::AsyncCreatePipeline(const VideoCommon::GXPipelineUid& uid,
-
                                             const CustomShaderInstance& custom_shaders,
-                                            const AbstractPipelineConfig& pipeline_config)
+                                            const AbstractPipelineConfig& pipeline_config,
+                                            AbstractPipeline::CacheData cache_data,
+                                            bool from_disk_cache)
 {
   class PipelineWorkItem final : public VideoCommon::AsyncShaderCompiler::WorkItem
   {
   public:
     PipelineWorkItem(CustomShaderCache* shader_cache, const VideoCommon::GXPipelineUid& uid,
                      const CustomShaderInstance& custom_shaders, PipelineIterator iterator,
-                     const AbstractPipelineConfig& pipeline_config)
+                     const AbstractPipelineConfig& pipeline_config,
+                     AbstractPipeline::CacheData cache_data, bool from_disk_cache)
         : m_shader_cache(shader_cache), m_uid(uid), m_iterator(iterator),
-          m_custom_shaders(custom_shaders), m_config(pipeline_config)
+          m_config(pipeline_config), m_custom_shaders(custom_shaders),
+          m_cache_data(std::move(cache_data)), m_from_disk_cache(from_disk_cache)
     {
       SetStagesReady();
     }
@@ -132,7 +316,19 @@ void CustomShaderCache::AsyncCreatePipeline(const VideoCommon::GXPipelineUid& ui
     {
       if (m_stages_ready)
       {
-        m_pipeline = g_gfx->CreatePipeline(m_config);
+        if (!m_cache_data.empty())
+        {
+          m_pipeline = g_gfx->CreatePipeline(m_config, m_cache_data.data(), m_cache_data.size());
+          if (m_pipeline && !m_pipeline->FinishCreation())
+            m_pipeline.reset();
+        }
+
+        // The driver may have changed since the cache data was written
+        if (!m_pipeline)
+        {
+          m_pipeline = g_gfx->CreatePipeline(m_config);
+          m_from_disk_cache = false;
+        }
       }
       return true;
     }
@@ -141,13 +337,15 @@ void CustomShaderCache::AsyncCreatePipeline(const VideoCommon::GXPipelineUid& ui
     {
       if (m_stages_ready)
       {
-        m_shader_cache->NotifyPipelineFinished(m_iterator, std::move(m_pipeline));
+        m_shader_cache->NotifyPipelineFinished(m_uid, m_iterator, std::move(m_pipeline),
+                                               m_from_disk_cache);
       }
       else
       {
         // Re-queue for next frame.
         auto wi = m_shader_cache->m_async_shader_compiler->CreateWorkItem<PipelineWorkItem>(
-            m_shader_cache, m_uid, m_custom_shaders, m_iterator, m_config);
+            m_shader_cache, m_uid, m_custom_shaders, m_iterator, m_config,
+            std::move(m_cache_data), m_from_disk_cache);
         m_shader_cache->m_async_shader_compiler->QueueWorkItem(std::move(wi), 0);
       }
     }
@@ -159,12 +357,15 @@ void CustomShaderCache::AsyncCreatePipeline(const VideoCommon::GXPipelineUid& ui
     PipelineIterator m_iterator;
     AbstractPipelineConfig m_config;
     CustomShaderInstance m_custom_shaders;
+    AbstractPipeline::CacheData m_cache_data;
+    bool m_from_disk_cache;
     bool m_stages_ready;
   };
 
   auto list_iter = m_pipeline_cache.InsertElement(uid, custom_shaders);
   auto work_item = m_async_shader_compiler->CreateWorkItem<PipelineWorkItem>(
-      this, uid, custom_shaders, list_iter, pipeline_config);
+      this, uid, custom_shaders, list_iter, pipeline_config, std::move(cache_data),
+      from_disk_cache);
   m_async_shader_compiler->QueueWorkItem(std::move(work_item), 0);
 }
 
@@ -251,9 +452,15 @@ void CustomShaderCache::AsyncCreatePipeline(const VideoCommon::GXUberPipelineUid
   m_async_uber_shader_compiler->QueueWorkItem(std::move(work_item), 0);
 }
 
-void CustomShaderCache::NotifyPipelineFinished(PipelineIterator iterator,
-                                               std::unique_ptr<AbstractPipeline> pipeline)
+void CustomShaderCache::NotifyPipelineFinished(const VideoCommon::GXPipelineUid& uid,
+                                               PipelineIterator iterator,
+                                               std::unique_ptr<AbstractPipeline> pipeline,
+                                               bool from_disk_cache)
 {
+  // Pipelines that were loaded as they were are already in the cache
+  if (pipeline && !from_disk_cache && g_ActiveConfig.bShaderCache)
+    AppendPipelineToCache(uid, iterator->first, *pipeline);
+
   iterator->second.pending = false;
   iterator->second.value = std::move(pipeline);
 }
@@ -10,6 +10,10 @@
 #include <optional>
 #include <string>
 #include <string_view>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/LinearDiskCache.h"
 
 #include "VideoCommon/AbstractPipeline.h"
 #include "VideoCommon/AbstractShader.h"
@@ -57,6 +61,25 @@ public:
                    const AbstractPipelineConfig& pipeline_config);
 
 private:
+#pragma pack(push, 1)
+  // Key of the disk cache. The values are the serialized custom shaders, followed by the cache
+  // data of the pipeline if the backend has any.
+  struct SerializedCustomPipelineUid
+  {
+    VideoCommon::SerializedGXPipelineUid uid;
+    u64 custom_shaders_hash;
+  };
+#pragma pack(pop)
+
+  // A pipeline that was used in an earlier session, which is compiled again as soon as the
+  // pipeline it's based on is available
+  struct CachedPipeline
+  {
+    VideoCommon::SerializedGXPipelineUid uid;
+    CustomShaderInstance custom_shaders;
+    AbstractPipeline::CacheData cache_data;
+  };
+
   // Configuration bits.
   APIType m_api_type = APIType::Nothing;
   ShaderHostConfig m_host_config = {};
@@ -65,7 +88,9 @@ private:
 
   void AsyncCreatePipeline(const VideoCommon::GXPipelineUid& uid,
                            const CustomShaderInstance& custom_shaders,
-                           const AbstractPipelineConfig& pipeline_config);
+                           const AbstractPipelineConfig& pipeline_config,
+                           AbstractPipeline::CacheData cache_data = {},
+                           bool from_disk_cache = false);
   void AsyncCreatePipeline(const VideoCommon::GXUberPipelineUid& uid,
                            const CustomShaderInstance& custom_shaders,
                            const AbstractPipelineConfig& pipeline_config);
@@ -120,8 +145,8 @@ private:
   using UberPixelShaderIterator =
       Cache<UberShader::PixelShaderUid, AbstractShader>::CacheList::iterator;
 
-  void NotifyPipelineFinished(PipelineIterator iterator,
-                              std::unique_ptr<AbstractPipeline> pipeline);
+  void NotifyPipelineFinished(const VideoCommon::GXPipelineUid& uid, PipelineIterator iterator,
+                              std::unique_ptr<AbstractPipeline> pipeline, bool from_disk_cache);
   void NotifyPipelineFinished(UberPipelineIterator iterator,
                               std::unique_ptr<AbstractPipeline> pipeline);
 
@@ -140,5 +165,15 @@ private:
   void QueuePixelShaderCompile(const UberShader::PixelShaderUid& uid,
                                const CustomShaderInstance& custom_shaders);
 
+  // The specialized pipelines are kept on disk, per game, and compiled again in the next session
+  void LoadPipelineCache();
+  void QueueCachedPipelines();
+  void AppendPipelineToCache(const VideoCommon::GXPipelineUid& uid,
+                             const CustomShaderInstance& custom_shaders,
+                             const AbstractPipeline& pipeline);
+
+  Common::LinearDiskCache<SerializedCustomPipelineUid, u8> m_pipeline_disk_cache;
+  std::vector<CachedPipeline> m_cached_pipelines;
+
   Common::EventHook m_frame_end_handler;
 };
@@ -7,7 +7,7 @@
 
 u32 FBInfo::CalculateHash() const
 {
-  return Common::HashAdler32(reinterpret_cast<const u8*>(this), sizeof(FBInfo));
+  return static_cast<u32>(Common::HashData(this, sizeof(FBInfo)));
 }
 
 bool FBInfo::operator==(const FBInfo& other) const
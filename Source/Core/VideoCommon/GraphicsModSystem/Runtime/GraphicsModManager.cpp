@@ -3,6 +3,7 @@
 
 #include "VideoCommon/GraphicsModSystem/Runtime/GraphicsModManager.h"
 
+#include <functional>
 #include <string>
 #include <string_view>
 #include <variant>
@@ -113,58 +114,87 @@ GraphicsModManager::GetProjectionActions(ProjectionType projection_type) const
   return m_default;
 }
 
-const std::vector<GraphicsModAction*>&
-GraphicsModManager::GetProjectionTextureActions(ProjectionType projection_type,
-                                                const std::string& texture_name) const
+u64 GraphicsModManager::HashTextureName(std::string_view texture_name)
+{
+  return std::hash<std::string_view>{}(texture_name);
+}
+
+const GraphicsModManager::TextureActions*
+GraphicsModManager::FindTextureActions(std::string_view texture_name, u64 texture_hash) const
 {
-  const auto lookup = fmt::format("{}_{}", texture_name, static_cast<int>(projection_type));
-  if (const auto it = m_projection_texture_target_to_actions.find(lookup);
-      it != m_projection_texture_target_to_actions.end())
+  if (const auto it = m_texture_target_to_actions.find(texture_hash);
+      it != m_texture_target_to_actions.end() && it->second.texture_name == texture_name)
   {
-    return it->second;
+    return &it->second;
   }
 
-  return m_default;
+  return nullptr;
 }
 
-const std::vector<GraphicsModAction*>&
-GraphicsModManager::GetDrawStartedActions(const std::string& texture_name) const
+GraphicsModManager::TextureActions*
+GraphicsModManager::GetOrCreateTextureActions(const std::string& texture_name)
 {
-  if (const auto it = m_draw_started_target_to_actions.find(texture_name);
-      it != m_draw_started_target_to_actions.end())
+  auto [it, inserted] = m_texture_target_to_actions.try_emplace(HashTextureName(texture_name));
+  if (inserted)
   {
-    return it->second;
+    it->second.texture_name = texture_name;
+  }
+  else if (it->second.texture_name != texture_name)
+  {
+    WARN_LOG_FMT(VIDEO, "Graphics mod texture '{}' can't be targeted, as its hash is that of '{}'",
+                 texture_name, it->second.texture_name);
+    return nullptr;
   }
 
+  return &it->second;
+}
+
+const std::vector<GraphicsModAction*>&
+GraphicsModManager::GetProjectionTextureActions(ProjectionType projection_type,
+                                                std::string_view texture_name,
+                                                u64 texture_hash) const
+{
+  const auto index = static_cast<size_t>(projection_type);
+  const TextureActions* actions = FindTextureActions(texture_name, texture_hash);
+  if (actions && index < actions->projection.size())
+    return actions->projection[index];
+
   return m_default;
 }
 
 const std::vector<GraphicsModAction*>&
-GraphicsModManager::GetTextureLoadActions(const std::string& texture_name) const
+GraphicsModManager::GetDrawStartedActions(std::string_view texture_name, u64 texture_hash) const
 {
-  if (const auto it = m_load_texture_target_to_actions.find(texture_name);
-      it != m_load_texture_target_to_actions.end())
-  {
-    return it->second;
-  }
+  if (const TextureActions* actions = FindTextureActions(texture_name, texture_hash))
+    return actions->draw_started;
 
   return m_default;
 }
 
 const std::vector<GraphicsModAction*>&
-GraphicsModManager::GetTextureCreateActions(const std::string& texture_name) const
+GraphicsModManager::GetTextureLoadActions(std::string_view texture_name, u64 texture_hash) const
 {
-  if (const auto it = m_create_texture_target_to_actions.find(texture_name);
-      it != m_create_texture_target_to_actions.end())
-  {
-    return it->second;
-  }
+  if (const TextureActions* actions = FindTextureActions(texture_name, texture_hash))
+    return actions->load;
+
+  return m_default;
+}
+
+const std::vector<GraphicsModAction*>&
+GraphicsModManager::GetTextureCreateActions(std::string_view texture_name, u64 texture_hash) const
+{
+  if (const TextureActions* actions = FindTextureActions(texture_name, texture_hash))
+    return actions->create;
 
   return m_default;
 }
 
 const std::vector<GraphicsModAction*>& GraphicsModManager::GetEFBActions(const FBInfo& efb) const
 {
+  // Don't hash the info when nothing targets any copies
+  if (m_efb_target_to_actions.empty())
+    return m_default;
+
   if (const auto it = m_efb_target_to_actions.find(efb); it != m_efb_target_to_actions.end())
   {
     return it->second;
@@ -175,7 +205,10 @@ const std::vector<GraphicsModAction*>& GraphicsModManager::GetEFBActions(const F
 
 const std::vector<GraphicsModAction*>& GraphicsModManager::GetXFBActions(const FBInfo& xfb) const
 {
-  if (const auto it = m_efb_target_to_actions.find(xfb); it != m_efb_target_to_actions.end())
+  if (m_xfb_target_to_actions.empty())
+    return m_default;
+
+  if (const auto it = m_xfb_target_to_actions.find(xfb); it != m_xfb_target_to_actions.end())
   {
     return it->second;
   }
@@ -260,16 +293,16 @@ void GraphicsModManager::Load(const GraphicsModGroupConfig& config)
         std::visit(
             overloaded{
                 [&](const DrawStartedTextureTarget& the_target) {
-                  m_draw_started_target_to_actions[the_target.m_texture_info_string].push_back(
-                      m_actions.back().get());
+                  if (auto* actions = GetOrCreateTextureActions(the_target.m_texture_info_string))
+                    actions->draw_started.push_back(m_actions.back().get());
                 },
                 [&](const LoadTextureTarget& the_target) {
-                  m_load_texture_target_to_actions[the_target.m_texture_info_string].push_back(
-                      m_actions.back().get());
+                  if (auto* actions = GetOrCreateTextureActions(the_target.m_texture_info_string))
+                    actions->load.push_back(m_actions.back().get());
                 },
                 [&](const CreateTextureTarget& the_target) {
-                  m_create_texture_target_to_actions[the_target.m_texture_info_string].push_back(
-                      m_actions.back().get());
+                  if (auto* actions = GetOrCreateTextureActions(the_target.m_texture_info_string))
+                    actions->create.push_back(m_actions.back().get());
                 },
                 [&](const EFBTarget& the_target) {
                   FBInfo info;
@@ -288,10 +321,10 @@ void GraphicsModManager::Load(const GraphicsModGroupConfig& config)
                 [&](const ProjectionTarget& the_target) {
                   if (the_target.m_texture_info_string)
                   {
-                    const auto lookup = fmt::format("{}_{}", *the_target.m_texture_info_string,
-                                                    static_cast<int>(the_target.m_projection_type));
-                    m_projection_texture_target_to_actions[lookup].push_back(
-                        m_actions.back().get());
+                    const auto index = static_cast<size_t>(the_target.m_projection_type);
+                    auto* actions = GetOrCreateTextureActions(*the_target.m_texture_info_string);
+                    if (actions && index < actions->projection.size())
+                      actions->projection[index].push_back(m_actions.back().get());
                   }
                   else
                   {
@@ -360,10 +393,7 @@ void GraphicsModManager::Reset()
   m_actions.clear();
   m_groups.clear();
   m_projection_target_to_actions.clear();
-  m_projection_texture_target_to_actions.clear();
-  m_draw_started_target_to_actions.clear();
-  m_load_texture_target_to_actions.clear();
-  m_create_texture_target_to_actions.clear();
+  m_texture_target_to_actions.clear();
   m_efb_target_to_actions.clear();
   m_xfb_target_to_actions.clear();
 }
@@ -3,13 +3,16 @@
 
 #pragma once
 
+#include <array>
 #include <list>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
+#include "Common/CommonTypes.h"
 #include "VideoCommon/GraphicsModSystem/Runtime/FBInfo.h"
 #include "VideoCommon/GraphicsModSystem/Runtime/GraphicsModAction.h"
 #include "VideoCommon/TextureInfo.h"
@@ -22,16 +25,21 @@ class GraphicsModManager
 public:
   bool Initialize();
 
+  // Textures are looked up by the hash of their name, which the texture cache computes once for
+  // each of its entries, so that the textures without actions are skipped without handling
+  // strings on every draw. The name is only compared to tell apart names of the same hash.
+  static u64 HashTextureName(std::string_view texture_name);
+
   const std::vector<GraphicsModAction*>& GetProjectionActions(ProjectionType projection_type) const;
   const std::vector<GraphicsModAction*>&
-  GetProjectionTextureActions(ProjectionType projection_type,
-                              const std::string& texture_name) const;
-  const std::vector<GraphicsModAction*>&
-  GetDrawStartedActions(const std::string& texture_name) const;
-  const std::vector<GraphicsModAction*>&
-  GetTextureLoadActions(const std::string& texture_name) const;
-  const std::vector<GraphicsModAction*>&
-  GetTextureCreateActions(const std::string& texture_name) const;
+  GetProjectionTextureActions(ProjectionType projection_type, std::string_view texture_name,
+                              u64 texture_hash) const;
+  const std::vector<GraphicsModAction*>& GetDrawStartedActions(std::string_view texture_name,
+                                                               u64 texture_hash) const;
+  const std::vector<GraphicsModAction*>& GetTextureLoadActions(std::string_view texture_name,
+                                                               u64 texture_hash) const;
+  const std::vector<GraphicsModAction*>& GetTextureCreateActions(std::string_view texture_name,
+                                                                 u64 texture_hash) const;
   const std::vector<GraphicsModAction*>& GetEFBActions(const FBInfo& efb) const;
   const std::vector<GraphicsModAction*>& GetXFBActions(const FBInfo& xfb) const;
 
@@ -43,16 +51,25 @@ private:
 
   class DecoratedAction;
 
+  // Everything that targets a texture, so a single lookup finds the actions of any event
+  struct TextureActions
+  {
+    std::string texture_name;
+    std::vector<GraphicsModAction*> draw_started;
+    std::vector<GraphicsModAction*> load;
+    std::vector<GraphicsModAction*> create;
+    // By projection type
+    std::array<std::vector<GraphicsModAction*>, 2> projection;
+  };
+
+  const TextureActions* FindTextureActions(std::string_view texture_name, u64 texture_hash) const;
+  TextureActions* GetOrCreateTextureActions(const std::string& texture_name);
+
   static inline const std::vector<GraphicsModAction*> m_default = {};
   std::list<std::unique_ptr<GraphicsModAction>> m_actions;
   std::unordered_map<ProjectionType, std::vector<GraphicsModAction*>>
       m_projection_target_to_actions;
-  std::unordered_map<std::string, std::vector<GraphicsModAction*>>
-      m_projection_texture_target_to_actions;
-  std::unordered_map<std::string, std::vector<GraphicsModAction*>> m_draw_started_target_to_actions;
-  std::unordered_map<std::string, std::vector<GraphicsModAction*>> m_load_texture_target_to_actions;
-  std::unordered_map<std::string, std::vector<GraphicsModAction*>>
-      m_create_texture_target_to_actions;
+  std::unordered_map<u64, TextureActions> m_texture_target_to_actions;
   std::unordered_map<FBInfo, std::vector<GraphicsModAction*>, FBInfoHasher> m_efb_target_to_actions;
   std::unordered_map<FBInfo, std::vector<GraphicsModAction*>, FBInfoHasher> m_xfb_target_to_actions;
 
@@ -12,7 +12,6 @@
 #include <unordered_map>
 #include <utility>
 #include <vector>
-#include <xxhash.h>
 
 #include <fmt/format.h>
 
@@ -26,7 +25,9 @@
 #include "Core/System.h"
 #include "VideoCommon/Assets/CustomAsset.h"
 #include "VideoCommon/Assets/CustomAssetLoader.h"
+#include "VideoCommon/Assets/CustomTexturePack.h"
 #include "VideoCommon/Assets/DirectFilesystemAssetLibrary.h"
+#include "VideoCommon/Assets/TexturePackAssetLibrary.h"
 #include "VideoCommon/OnScreenDisplay.h"
 #include "VideoCommon/VideoConfig.h"
 
@@ -36,6 +37,7 @@ static std::unordered_map<std::string, std::shared_ptr<HiresTexture>> s_hires_te
 static std::unordered_map<std::string, bool> s_hires_texture_id_to_arbmipmap;
 
 static auto s_file_library = std::make_shared<VideoCommon::DirectFilesystemAssetLibrary>();
+static auto s_pack_library = std::make_shared<VideoCommon::TexturePackAssetLibrary>();
 
 namespace
 {
@@ -75,6 +77,12 @@ std::pair<std::string, bool> GetNameArbPair(const TextureInfo& texture_info)
 
   return {"", false};
 }
+std::shared_ptr<VideoCommon::CustomAssetLibrary> GetLibrary(const std::string& texture_name)
+{
+  if (s_pack_library->HasAsset(texture_name))
+    return s_pack_library;
+  return s_file_library;
+}
 }  // namespace
 
 void HiresTexture::Init()
@@ -98,7 +106,8 @@ void HiresTexture::Update()
   const std::string& game_id = SConfig::GetInstance().GetGameID();
   const std::set<std::string> texture_directories =
       GetTextureDirectoriesWithGameId(File::GetUserPath(D_HIRESTEXTURES_IDX), game_id);
-  const std::vector<std::string> extensions{".png", ".dds"};
+  const std::vector<std::string> extensions{".png", ".dds",
+                                            VideoCommon::CustomTexturePackExtension};
 
   auto& system = Core::System::GetInstance();
 
@@ -108,10 +117,19 @@ void HiresTexture::Update()
         Common::DoFileSearch({texture_directory}, extensions, /*recursive*/ true);
 
     bool failed_insert = false;
+    std::vector<std::string> pack_paths;
     for (auto& path : texture_paths)
     {
       std::string filename;
-      SplitPath(path, nullptr, &filename, nullptr);
+      std::string extension;
+      SplitPath(path, nullptr, &filename, &extension);
+      Common::ToLower(&extension);
+
+      if (extension == VideoCommon::CustomTexturePackExtension)
+      {
+        pack_paths.push_back(path);
+        continue;
+      }
 
       if (filename.substr(0, s_format_prefix.length()) == s_format_prefix)
       {
@@ -144,6 +162,32 @@ void HiresTexture::Update()
       }
     }
 
+    // Loose files take precedence over packed textures of the same name, so that individual
+    // textures of a pack can be replaced without repacking
+    for (const std::string& pack_path : pack_paths)
+    {
+      auto pack = std::make_shared<VideoCommon::CustomTexturePack>();
+      if (!pack->Open(pack_path))
+        continue;
+
+      for (u32 i = 0; i < pack->GetTextureCount(); ++i)
+      {
+        const std::string name(pack->GetTextureName(i));
+        const bool has_arbitrary_mipmaps = pack->HasArbitraryMipmaps(i);
+        if (!s_hires_texture_id_to_arbmipmap.try_emplace(name, has_arbitrary_mipmaps).second)
+          continue;
+
+        s_pack_library->SetAssetLocation(name, pack, i);
+        if (g_ActiveConfig.bCacheHiresTextures)
+        {
+          auto hires_texture = std::make_shared<HiresTexture>(
+              has_arbitrary_mipmaps,
+              system.GetCustomAssetLoader().LoadGameTexture(name, s_pack_library));
+          s_hires_texture_cache.try_emplace(name, std::move(hires_texture));
+        }
+      }
+    }
+
     if (failed_insert)
     {
       ERROR_LOG_FMT(VIDEO, "One or more textures at path '{}' were already inserted",
@@ -168,6 +212,7 @@ void HiresTexture::Clear()
   s_hires_texture_cache.clear();
   s_hires_texture_id_to_arbmipmap.clear();
   s_file_library = std::make_shared<VideoCommon::DirectFilesystemAssetLibrary>();
+  s_pack_library = std::make_shared<VideoCommon::TexturePackAssetLibrary>();
 }
 
 std::shared_ptr<HiresTexture> HiresTexture::Search(const TextureInfo& texture_info)
@@ -185,7 +230,7 @@ std::shared_ptr<HiresTexture> HiresTexture::Search(const TextureInfo& texture_in
     auto& system = Core::System::GetInstance();
     auto hires_texture = std::make_shared<HiresTexture>(
         has_arb_mipmaps,
-        system.GetCustomAssetLoader().LoadGameTexture(base_filename, s_file_library));
+        system.GetCustomAssetLoader().LoadGameTexture(base_filename, GetLibrary(base_filename)));
     if (g_ActiveConfig.bCacheHiresTextures)
     {
       s_hires_texture_cache.try_emplace(base_filename, hires_texture);
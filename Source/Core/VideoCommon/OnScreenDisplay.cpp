@@ -5,18 +5,25 @@
 
 #include <algorithm>
 #include <atomic>
+#include <cfloat>
+#include <functional>
 #include <map>
 #include <mutex>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
 #include <fmt/format.h>
 #include <imgui.h>
 
 #include "Common/CommonTypes.h"
 #include "Common/Config/Config.h"
+#include "Common/MPSCQueue.h"
 #include "Common/Timer.h"
 
 #include "Core/Config/MainSettings.h"
+#include "Core/HW/SystemTimers.h"
 
 #include "VideoCommon/AbstractGfx.h"
 #include "VideoCommon/AbstractTexture.h"
@@ -29,6 +36,7 @@ constexpr float TOP_MARGIN = 10.0f;          // Pixels above the first OSD messa
 constexpr float WINDOW_PADDING = 4.0f;       // Pixels between subsequent OSD messages.
 constexpr float MESSAGE_FADE_TIME = 1000.f;  // Ms to fade OSD messages at the end of their life.
 constexpr float MESSAGE_DROP_TIME = 5000.f;  // Ms to drop OSD messages that has yet to ever render.
+constexpr size_t MAX_TEXT_LAYOUTS = 1024;    // Text sizes kept for text_only stacks.
 
 static std::atomic<int> s_obscured_pixels_left = 0;
 static std::atomic<int> s_obscured_pixels_top = 0;
@@ -36,15 +44,17 @@ static std::atomic<int> s_obscured_pixels_top = 0;
 struct Message
 {
   Message() = default;
-  Message(std::string text_, u32 duration_, u32 color_, std::unique_ptr<Icon> icon_ = nullptr,
-          float scale_ = 1)
-      : text(std::move(text_)), duration(duration_), color(color_), icon(std::move(icon_)),
-        scale(scale_)
+  Message(std::shared_ptr<const std::string> text_storage_, std::string_view text_, u32 duration_,
+          u32 color_, std::unique_ptr<Icon> icon_ = nullptr, float scale_ = 1)
+      : text_storage(std::move(text_storage_)), text(text_), duration(duration_), color(color_),
+        icon(std::move(icon_)), scale(scale_)
   {
     timer.Start();
   }
   s64 TimeRemaining() const { return duration - timer.ElapsedMs(); }
-  std::string text;
+  // text points into text_storage, which may be shared with other messages or the caller
+  std::shared_ptr<const std::string> text_storage;
+  std::string_view text;
   Common::Timer timer;
   u32 duration = 0;
   bool ever_drawn = false;
@@ -53,48 +63,152 @@ struct Message
   std::unique_ptr<Icon> icon;
   std::unique_ptr<AbstractTexture> texture;
   float scale = 1;
+  // Text layout of text_only stacks, computed on first draw and whenever the font size changes
+  float cached_font_size = 0;
+  ImVec2 cached_text_size;
+  // Emulated time of the frame the message was first presented in, for burn_in stacks
+  u64 start_ticks = 0;
+  bool has_start_ticks = false;
 };
 
+// Emulated time of the frame being presented, see SetFrameTicks
+static u64 s_frame_ticks = 0;
+static bool s_burn_in_active = false;
+
+static bool IsBurnInActive(const Message& msg, u64 ticks)
+{
+  if (!msg.has_start_ticks || ticks < msg.start_ticks)
+    return false;
+  const u64 duration_ticks = u64{msg.duration} * SystemTimers::GetTicksPerSecond() / 1000;
+  return ticks - msg.start_ticks < duration_ticks;
+}
+
+// Where text_only messages are drawn: the screen, or a dumped frame for burn_in stacks
+struct TextCanvas
+{
+  ImDrawList* draw_list;
+  ImVec2 size;
+  // Of the layout, relative to the screen's
+  float scale;
+};
+
+static u64 GetMessageKey(MessageType type, std::string_view text)
+{
+  return std::hash<std::string_view>{}(text) ^ (static_cast<u64>(type) * 0x9E3779B97F4A7C15ULL);
+}
+
 struct OSDMessageStack
 {
   ImVec2 initialPosOffset;
   MessageStackDirection dir;
   bool centered;
   bool reversed;
+  bool text_only;
+  bool burn_in;
   std::string name;
   std::multimap<OSD::MessageType, OSD::Message> messages;
+  // Number of messages per (type, text) key, so duplicate checks don't scan all messages
+  std::unordered_map<u64, u32> message_keys;
 
-  OSDMessageStack() : OSDMessageStack(0, 0, MessageStackDirection::Downward, false, false, "") {}
+  OSDMessageStack()
+      : OSDMessageStack(0, 0, MessageStackDirection::Downward, false, false, false, false, "")
+  {
+  }
   OSDMessageStack(float x_offset, float y_offset, MessageStackDirection dir, bool centered,
-                  bool reversed, std::string name)
-      : dir(dir), centered(centered), reversed(reversed), name(name)
+                  bool reversed, bool text_only, bool burn_in, std::string name)
+      : dir(dir), centered(centered), reversed(reversed), text_only(text_only), burn_in(burn_in),
+        name(name)
   {
     initialPosOffset = ImVec2(x_offset, y_offset);
   }
 
-  bool IsVertical()
+  bool IsVertical() const
   {
     return dir == MessageStackDirection::Downward || dir == MessageStackDirection::Upward;
   }
 
-  bool HasMessage(std::string message, MessageType type = OSD::MessageType::Typeless)
+  bool HasMessage(std::string_view message, MessageType type = OSD::MessageType::Typeless)
   {
-    for (auto it = messages.begin(); it != messages.end(); ++it)
-    {
-      if (type == it->first && message == it->second.text)
-      {
-        return true;
-      }
-    }
-    return false;
+    return message_keys.contains(GetMessageKey(type, message));
+  }
+
+  void AddMessage(MessageType type, Message message)
+  {
+    message_keys[GetMessageKey(type, message.text)]++;
+    messages.emplace(type, std::move(message));
   }
+
+  std::multimap<OSD::MessageType, OSD::Message>::iterator
+  EraseMessage(std::multimap<OSD::MessageType, OSD::Message>::iterator it)
+  {
+    const auto key_it = message_keys.find(GetMessageKey(it->first, it->second.text));
+    if (key_it != message_keys.end() && --key_it->second == 0)
+      message_keys.erase(key_it);
+    return messages.erase(it);
+  }
+
+  void ClearMessages()
+  {
+    messages.clear();
+    message_keys.clear();
+  }
+};
+
+struct PendingMessage
+{
+  MessageType type;
+  MessageStackHandle stack;
+  bool prevent_duplicate;
+  Message message;
 };
 
-// default message stack
-static OSDMessageStack s_defaultMessageStack = OSDMessageStack();
-static std::map<std::string, OSDMessageStack> messageStacks;
+// Indexed by MessageStackHandle, the default message stack is always first.
+// Only the video thread touches the stacks, apart from creating and clearing them.
+static std::vector<std::unique_ptr<OSDMessageStack>> s_message_stacks = [] {
+  std::vector<std::unique_ptr<OSDMessageStack>> stacks;
+  stacks.push_back(std::make_unique<OSDMessageStack>());
+  return stacks;
+}();
+static std::mutex s_message_stacks_mutex;
 
-static std::mutex s_messages_mutex;
+// Messages from any thread, moved into their stacks once per frame by DrawMessages
+static Common::MPSCQueue<PendingMessage> s_pending_messages;
+
+struct PendingLayout
+{
+  std::shared_ptr<const std::string> text_storage;
+  std::string_view text;
+};
+
+// Texts from PrepareMessage, laid out by the next DrawMessages
+static Common::MPSCQueue<PendingLayout> s_pending_layouts;
+// Sizes of texts at the font's own size, keyed by text hash. Text sizes scale linearly with the
+// font size, so one entry covers every message scale. Only the video thread touches these.
+static std::unordered_map<u64, ImVec2> s_text_layouts;
+static const ImFont* s_text_layouts_font = nullptr;
+static float s_text_layouts_font_size = 0;
+
+static ImVec2 GetTextLayout(const ImFont* font, std::string_view text)
+{
+  if (s_text_layouts_font != font || s_text_layouts_font_size != font->FontSize)
+  {
+    s_text_layouts.clear();
+    s_text_layouts_font = font;
+    s_text_layouts_font_size = font->FontSize;
+  }
+
+  const u64 key = std::hash<std::string_view>{}(text);
+  if (const auto it = s_text_layouts.find(key); it != s_text_layouts.end())
+    return it->second;
+
+  if (s_text_layouts.size() >= MAX_TEXT_LAYOUTS)
+    s_text_layouts.clear();
+
+  const ImVec2 size =
+      font->CalcTextSizeA(font->FontSize, FLT_MAX, 0.0f, text.data(), text.data() + text.size());
+  s_text_layouts.emplace(key, size);
+  return size;
+}
 
 static ImVec4 ARGBToImVec4(const u32 argb)
 {
@@ -156,8 +270,10 @@ static ImVec2 DrawMessage(int index, Message& msg, const ImVec2& position, int t
 
     //TODO fractional scaling based on viewport size instead of screen pixels?
     ImGui::SetWindowFontScale(msg.scale);
-    // Use %s in case message contains %.
-    ImGui::TextColored(ARGBToImVec4(msg.color), "%s", msg.text.c_str());
+    // Unformatted in case message contains %, text isn't null-terminated either
+    ImGui::PushStyleColor(ImGuiCol_Text, ARGBToImVec4(msg.color));
+    ImGui::TextUnformatted(msg.text.data(), msg.text.data() + msg.text.size());
+    ImGui::PopStyleColor();
     window_width =
         ImGui::GetWindowSize().x + (WINDOW_PADDING * ImGui::GetIO().DisplayFramebufferScale.x);
     window_height =
@@ -201,64 +317,197 @@ static ImVec2 DrawMessage(int index, Message& msg, const ImVec2& position, int t
   return ImVec2(window_width, window_height);
 }
 
-void AddTypedMessage(MessageType type, std::string message, u32 ms, u32 argb, std::unique_ptr<Icon> icon,
-                     std::string message_stack, bool prevent_duplicate, float scale)
+static ImVec2 DrawTextOnlyMessage(Message& msg, const ImVec2& position, int time_left,
+                                  OSDMessageStack& message_Stack, const TextCanvas& canvas)
 {
-  std::lock_guard lock{s_messages_mutex};
+  ImFont* const font = ImGui::GetFont();
+  const float screen_font_size = ImGui::GetFontSize() * msg.scale;
+  if (msg.cached_font_size != screen_font_size)
+  {
+    // Usually already laid out by PrepareMessage
+    const ImVec2 layout = GetTextLayout(font, msg.text);
+    const float layout_scale = screen_font_size / font->FontSize;
+    msg.cached_text_size = ImVec2(layout.x * layout_scale, layout.y * layout_scale);
+    msg.cached_font_size = screen_font_size;
+  }
 
-  OSDMessageStack* stack = &s_defaultMessageStack;
-  if (messageStacks.contains(message_stack))
+  // Text sizes scale linearly, so other canvases don't need a layout of their own
+  const float font_size = screen_font_size * canvas.scale;
+  const ImVec2 text_size(msg.cached_text_size.x * canvas.scale,
+                         msg.cached_text_size.y * canvas.scale);
+  const ImGuiStyle& style = ImGui::GetStyle();
+  const ImVec2 padding(style.WindowPadding.x * canvas.scale, style.WindowPadding.y * canvas.scale);
+  const ImVec2 box_size(text_size.x + padding.x * 2, text_size.y + padding.y * 2);
+  const float window_width =
+      box_size.x + (WINDOW_PADDING * ImGui::GetIO().DisplayFramebufferScale.x * canvas.scale);
+  const float window_height =
+      box_size.y + (WINDOW_PADDING * ImGui::GetIO().DisplayFramebufferScale.y * canvas.scale);
+
+  float x_pos = position.x;
+  float y_pos = position.y;
+
+  if (message_Stack.centered)
   {
-    stack = &messageStacks[message_stack];
+    if (message_Stack.IsVertical())
+    {
+      const float x_center = canvas.size.x / 2.0;
+      x_pos = x_center - window_width / 2;
+    }
+    else
+    {
+      const float y_center = canvas.size.y / 2.0;
+      y_pos = y_center - window_height / 2;
+    }
   }
-    
-  if (prevent_duplicate && stack->HasMessage(message, type))
+
+  if (message_Stack.dir == MessageStackDirection::Leftward)
   {
-    return;
+    x_pos -= window_width;
   }
-  if (type != MessageType::Typeless)
+  if (message_Stack.dir == MessageStackDirection::Upward)
   {
-    // A message may hold a reference to a texture that can only be destroyed on the video thread, so
-    // only mark the old typed message (if any) for removal. It will be discarded on the next call to
-    // DrawMessages().
-    auto range = stack->messages.equal_range(type);
-    for (auto it = range.first; it != range.second; ++it)
-        it->second.should_discard = true;
+    y_pos -= window_height;
   }
-  stack->messages.emplace(type, Message(std::move(message), ms, argb, std::move(icon), scale));
+
+  // Gradually fade old messages away (except in their first frame)
+  const float fade_time = std::max(std::min(MESSAGE_FADE_TIME, (float)msg.duration), 1.f);
+  const float alpha = msg.ever_drawn ? std::clamp(time_left / fade_time, 0.f, 1.f) : 1.0f;
+
+  ImVec4 background = style.Colors[ImGuiCol_WindowBg];
+  background.w *= alpha * style.Alpha;
+  ImVec4 foreground = ARGBToImVec4(msg.color);
+  foreground.w *= alpha * style.Alpha;
+
+  // The font atlas already holds the glyphs, so this is one quad for the box and one per glyph
+  ImDrawList* const draw_list = canvas.draw_list;
+  const ImVec2 box_min(x_pos, y_pos);
+  const ImVec2 box_max(x_pos + box_size.x, y_pos + box_size.y);
+  draw_list->AddRectFilled(box_min, box_max, ImGui::ColorConvertFloat4ToU32(background),
+                           style.WindowRounding * canvas.scale);
+  draw_list->AddText(font, font_size, ImVec2(x_pos + padding.x, y_pos + padding.y),
+                     ImGui::ColorConvertFloat4ToU32(foreground), msg.text.data(),
+                     msg.text.data() + msg.text.size());
+
+  return ImVec2(window_width, window_height);
+}
+
+void AddTypedMessage(MessageType type, std::string message, u32 ms, u32 argb,
+                     std::unique_ptr<Icon> icon, MessageStackHandle message_stack,
+                     bool prevent_duplicate, float scale)
+{
+  auto text_storage = std::make_shared<const std::string>(std::move(message));
+  const std::string_view text = *text_storage;
+
+  // Never blocks on drawing, duplicates are filtered when the message reaches its stack
+  s_pending_messages.Push(
+      PendingMessage{type, message_stack, prevent_duplicate,
+                     Message(std::move(text_storage), text, ms, argb, std::move(icon), scale)});
 }
 
-void AddMessage(std::string message, u32 ms, u32 argb, std::unique_ptr<Icon> icon, std::string message_stack, bool prevent_duplicate, float scale)
+void AddMessage(std::string message, u32 ms, u32 argb, std::unique_ptr<Icon> icon,
+                MessageStackHandle message_stack, bool prevent_duplicate, float scale)
 {
-  AddTypedMessage(MessageType::Typeless, message, ms, argb, std::move(icon), message_stack,
-                  prevent_duplicate,
-                  scale);
+  AddTypedMessage(MessageType::Typeless, std::move(message), ms, argb, std::move(icon),
+                  message_stack, prevent_duplicate, scale);
 }
 
-void AddMessageStack(float x_offset, float y_offset, MessageStackDirection dir, bool centered,
-                     bool reversed, std::string name)
+void AddMessage(std::shared_ptr<const std::string> text_storage, std::string_view text, u32 ms,
+                u32 argb, MessageStackHandle message_stack, bool prevent_duplicate, float scale)
 {
-  messageStacks.emplace(name, OSDMessageStack(x_offset, y_offset, dir, centered, reversed, name));
+  s_pending_messages.Push(
+      PendingMessage{MessageType::Typeless, message_stack, prevent_duplicate,
+                     Message(std::move(text_storage), text, ms, argb, nullptr, scale)});
 }
-void DrawMessages(OSDMessageStack& messageStack)
+
+void PrepareMessage(std::shared_ptr<const std::string> text_storage, std::string_view text)
 {
-  const bool draw_messages = Config::Get(Config::MAIN_OSD_MESSAGES);
-  float current_x = LEFT_MARGIN * ImGui::GetIO().DisplayFramebufferScale.x +
-                    s_obscured_pixels_left + messageStack.initialPosOffset.x;
-  float current_y = TOP_MARGIN * ImGui::GetIO().DisplayFramebufferScale.y + s_obscured_pixels_top +
-                    messageStack.initialPosOffset.y;
-  int index = 0;
+  s_pending_layouts.Push(PendingLayout{std::move(text_storage), text});
+}
+
+MessageStackHandle AddMessageStack(float x_offset, float y_offset, MessageStackDirection dir,
+                                   bool centered, bool reversed, std::string name, bool text_only,
+                                   bool burn_in)
+{
+  std::lock_guard lock{s_message_stacks_mutex};
+  s_message_stacks.push_back(std::make_unique<OSDMessageStack>(
+      x_offset, y_offset, dir, centered, reversed, text_only, burn_in, name));
+  return static_cast<MessageStackHandle>(s_message_stacks.size() - 1);
+}
+
+static void AddPendingMessage(PendingMessage pending)
+{
+  OSDMessageStack* stack = s_message_stacks[DEFAULT_MESSAGE_STACK].get();
+  if (pending.stack < s_message_stacks.size())
+    stack = s_message_stacks[pending.stack].get();
+
+  const MessageType type = pending.type;
+  if (pending.prevent_duplicate && stack->HasMessage(pending.message.text, type))
+  {
+    return;
+  }
+  if (stack->burn_in)
+  {
+    pending.message.start_ticks = s_frame_ticks;
+    pending.message.has_start_ticks = true;
+  }
+  if (type != MessageType::Typeless)
+  {
+    // A message may hold a reference to a texture that can only be destroyed on the video thread,
+    // so only mark the old typed message (if any) for removal. It will be discarded when its stack
+    // is drawn.
+    auto range = stack->messages.equal_range(type);
+    for (auto it = range.first; it != range.second; ++it)
+      it->second.should_discard = true;
+  }
+  stack->AddMessage(type, std::move(pending.message));
+}
+
+// Position of the first message of a stack, obscured is the space taken at the top left
+static ImVec2 GetStackOrigin(const OSDMessageStack& messageStack, const TextCanvas& canvas,
+                             const ImVec2& obscured)
+{
+  float current_x = (LEFT_MARGIN * ImGui::GetIO().DisplayFramebufferScale.x + obscured.x +
+                     messageStack.initialPosOffset.x) *
+                    canvas.scale;
+  float current_y = (TOP_MARGIN * ImGui::GetIO().DisplayFramebufferScale.y + obscured.y +
+                     messageStack.initialPosOffset.y) *
+                    canvas.scale;
 
   if (messageStack.dir == MessageStackDirection::Leftward)
   {
-    current_x = ImGui::GetIO().DisplaySize.x - current_x;
+    current_x = canvas.size.x - current_x;
   }
   if (messageStack.dir == MessageStackDirection::Upward)
   {
-    current_y = ImGui::GetIO().DisplaySize.y - current_y;
+    current_y = canvas.size.y - current_y;
   }
+  return ImVec2(current_x, current_y);
+}
+
+static void AdvanceStackPosition(const OSDMessageStack& messageStack, ImVec2& position,
+                                 const ImVec2& messageSize)
+{
+  if (messageStack.IsVertical())
+  {
+    position.y +=
+        messageStack.dir == OSD::MessageStackDirection::Upward ? -messageSize.y : messageSize.y;
+  }
+  else
+  {
+    position.x +=
+        messageStack.dir == OSD::MessageStackDirection::Leftward ? -messageSize.x : messageSize.x;
+  }
+}
+
+void DrawMessages(OSDMessageStack& messageStack)
+{
+  const bool draw_messages = Config::Get(Config::MAIN_OSD_MESSAGES);
+  const TextCanvas canvas{ImGui::GetBackgroundDrawList(), ImGui::GetIO().DisplaySize, 1.0f};
+  const ImVec2 obscured(static_cast<float>(s_obscured_pixels_left),
+                        static_cast<float>(s_obscured_pixels_top));
+  ImVec2 position = GetStackOrigin(messageStack, canvas, obscured);
+  int index = 0;
 
-  std::lock_guard lock{s_messages_mutex};
   for (auto it = (messageStack.reversed ? messageStack.messages.end() :
                                           messageStack.messages.begin());
        it !=
@@ -272,17 +521,22 @@ void DrawMessages(OSDMessageStack& messageStack)
     Message& msg = it->second;
     if (msg.should_discard)
     {
-      it = messageStack.messages.erase(it);
+      it = messageStack.EraseMessage(it);
       continue;
     }
 
     const s64 time_left = msg.TimeRemaining();
+    const bool expired = time_left <= 0 && (msg.ever_drawn || -time_left >= MESSAGE_DROP_TIME);
 
     // Make sure we draw them at least once if they were printed with 0ms,
-    // unless enough time has expired, in that case, we drop them
-    if (time_left <= 0 && (msg.ever_drawn || -time_left >= MESSAGE_DROP_TIME))
+    // unless enough time has expired, in that case, we drop them.
+    // Frame dumps keep burnt in messages for as long in emulated time, which runs slower than
+    // real time while dumping.
+    const bool burnt_in =
+        messageStack.burn_in && s_burn_in_active && IsBurnInActive(msg, s_frame_ticks);
+    if (expired && !burnt_in)
     {
-      it = messageStack.messages.erase(it);
+      it = messageStack.EraseMessage(it);
       continue;
     }
     else if (!messageStack.reversed)
@@ -290,40 +544,100 @@ void DrawMessages(OSDMessageStack& messageStack)
       ++it;
     }
 
-    if (draw_messages)
+    if (draw_messages && !expired)
     {
-      const auto messageSize =
-          DrawMessage(index++, msg, ImVec2(current_x, current_y), time_left, messageStack);
-
-      if (messageStack.IsVertical())
+      ImVec2 messageSize;
+      if (messageStack.text_only && !msg.icon)
       {
-        current_y +=
-            messageStack.dir == OSD::MessageStackDirection::Upward ? -messageSize.y : messageSize.y;
+        messageSize = DrawTextOnlyMessage(msg, position, time_left, messageStack, canvas);
+        msg.ever_drawn = true;
       }
       else
       {
-        current_x += messageStack.dir == OSD::MessageStackDirection::Leftward ? -messageSize.x :
-                                                                                messageSize.x;
+        messageSize = DrawMessage(index++, msg, position, time_left, messageStack);
       }
+
+      AdvanceStackPosition(messageStack, position, messageSize);
     }
   }
 }
+
+static void DrawBurnInMessages(OSDMessageStack& messageStack, const TextCanvas& canvas)
+{
+  ImVec2 position = GetStackOrigin(messageStack, canvas, ImVec2(0, 0));
+
+  // Same order as on screen, without erasing anything
+  const auto draw = [&](Message& msg) {
+    if (msg.should_discard || msg.icon || !IsBurnInActive(msg, s_frame_ticks))
+      return;
+
+    // Fading is by real time, so dumped messages are drawn opaque
+    const ImVec2 messageSize = DrawTextOnlyMessage(msg, position, static_cast<int>(msg.duration),
+                                                   messageStack, canvas);
+    AdvanceStackPosition(messageStack, position, messageSize);
+  };
+  if (messageStack.reversed)
+    std::for_each(messageStack.messages.rbegin(), messageStack.messages.rend(),
+                  [&](auto& entry) { draw(entry.second); });
+  else
+    std::for_each(messageStack.messages.begin(), messageStack.messages.end(),
+                  [&](auto& entry) { draw(entry.second); });
+}
+
+bool DrawBurnInMessages(ImDrawList& draw_list, const ImVec2& size, float scale)
+{
+  std::lock_guard lock{s_message_stacks_mutex};
+
+  const size_t vertex_count = draw_list.VtxBuffer.size();
+  const TextCanvas canvas{&draw_list, size, scale};
+  for (auto& stack : s_message_stacks)
+  {
+    if (stack->burn_in)
+      DrawBurnInMessages(*stack, canvas);
+  }
+  return draw_list.VtxBuffer.size() != vertex_count;
+}
+
+bool HasBurnInMessages()
+{
+  std::lock_guard lock{s_message_stacks_mutex};
+
+  return std::any_of(s_message_stacks.begin(), s_message_stacks.end(), [](const auto& stack) {
+    return stack->burn_in &&
+           std::any_of(stack->messages.begin(), stack->messages.end(), [](const auto& entry) {
+             return !entry.second.icon && IsBurnInActive(entry.second, s_frame_ticks);
+           });
+  });
+}
+
+void SetFrameTicks(u64 ticks, bool burn_in)
+{
+  s_frame_ticks = ticks;
+  s_burn_in_active = burn_in;
+}
 void DrawMessages()
 {
-  DrawMessages(s_defaultMessageStack);
-  for (auto& [name, stack] : messageStacks)
+  std::lock_guard lock{s_message_stacks_mutex};
+
+  s_pending_messages.PopAll([](PendingMessage&& pending) { AddPendingMessage(std::move(pending)); });
+  s_pending_layouts.PopAll(
+      [](PendingLayout&& pending) { GetTextLayout(ImGui::GetFont(), pending.text); });
+
+  for (auto& stack : s_message_stacks)
   {
-    DrawMessages(stack);
+    DrawMessages(*stack);
   }
 }
 
 void ClearMessages()
 {
-  std::lock_guard lock{s_messages_mutex};
-  s_defaultMessageStack.messages.clear();
-  for (auto& [name, stack] : messageStacks)
+  std::lock_guard lock{s_message_stacks_mutex};
+  // The lock makes this the only consumer of the pending queue
+  s_pending_messages.Clear();
+  s_pending_layouts.Clear();
+  for (auto& stack : s_message_stacks)
   {
-    stack.messages.clear();
+    stack->ClearMessages();
   }
 }
 
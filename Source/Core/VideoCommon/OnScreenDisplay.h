@@ -7,6 +7,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include <imgui.h>
@@ -58,20 +59,46 @@ struct Icon
   u32 height = 0;
 };  // struct Icon
 
-void AddMessageStack(float x_offset, float y_offset, MessageStackDirection dir, bool centered,
-                     bool reversed, std::string name);
+using MessageStackHandle = u32;
+constexpr MessageStackHandle DEFAULT_MESSAGE_STACK = 0;
 
-// On-screen message display (colored yellow by default)
+// Messages of a text_only stack never have icons. They are drawn straight into the background
+// draw list with their layout computed once per message, instead of as one ImGui window each.
+// Messages of a text_only, burn_in stack are also drawn into frame dumps, for as long in
+// emulated time as their duration.
+MessageStackHandle AddMessageStack(float x_offset, float y_offset, MessageStackDirection dir,
+                                   bool centered, bool reversed, std::string name,
+                                   bool text_only = false, bool burn_in = false);
+
+// On-screen message display (colored yellow by default).
+// Safe to call from any thread, messages are queued and picked up by the next DrawMessages.
 void AddMessage(std::string message, u32 ms = Duration::SHORT, u32 argb = Color::YELLOW,
-                std::unique_ptr<Icon> icon = nullptr, std::string message_stack = "",
+                std::unique_ptr<Icon> icon = nullptr,
+                MessageStackHandle message_stack = DEFAULT_MESSAGE_STACK,
+                bool prevent_duplicate = false, float scale = 1);
+// Shows text without copying it. text must point into text_storage, which is kept alive for as
+// long as the message is shown.
+void AddMessage(std::shared_ptr<const std::string> text_storage, std::string_view text,
+                u32 ms = Duration::SHORT, u32 argb = Color::YELLOW,
+                MessageStackHandle message_stack = DEFAULT_MESSAGE_STACK,
                 bool prevent_duplicate = false, float scale = 1);
+// Lays out text ahead of a text_only message showing it, so that its first draw doesn't have to.
+// Like AddMessage, text must point into text_storage.
+void PrepareMessage(std::shared_ptr<const std::string> text_storage, std::string_view text);
 void AddTypedMessage(MessageType type, std::string message, u32 ms = Duration::SHORT,
                      u32 argb = Color::YELLOW, std::unique_ptr<Icon> icon = nullptr,
-                     std::string message_stack = "", bool prevent_duplicate = false,
-                     float scale = 1);
+                     MessageStackHandle message_stack = DEFAULT_MESSAGE_STACK,
+                     bool prevent_duplicate = false, float scale = 1);
 
 // Draw the current messages on the screen. Only call once per frame.
 void DrawMessages();
+// Draws the burn_in messages shown in the frame at the last SetFrameTicks into draw_list, laid out
+// for a frame of the given size, with scale relative to the screen. Returns whether it drew any.
+bool DrawBurnInMessages(ImDrawList& draw_list, const ImVec2& size, float scale);
+bool HasBurnInMessages();
+// Emulated time of the frame about to be presented. While burn_in is set, messages of burn_in
+// stacks are kept until their duration has also passed in emulated time.
+void SetFrameTicks(u64 ticks, bool burn_in);
 void ClearMessages();
 
 void SetObscuredPixelsLeft(int width);
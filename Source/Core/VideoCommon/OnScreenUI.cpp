@@ -11,9 +11,11 @@
 #include "Core/Config/NetplaySettings.h"
 #include "Core/Movie.h"
 
+#include "VideoCommon/AbstractFramebuffer.h"
 #include "VideoCommon/AbstractGfx.h"
 #include "VideoCommon/AbstractPipeline.h"
 #include "VideoCommon/AbstractShader.h"
+#include "VideoCommon/AbstractTexture.h"
 #include "VideoCommon/FramebufferShaderGen.h"
 #include "VideoCommon/NetPlayChatUI.h"
 #include "VideoCommon/NetPlayGolfUI.h"
@@ -113,6 +115,9 @@ OnScreenUI::~OnScreenUI()
 
 bool OnScreenUI::RecompileImGuiPipeline()
 {
+  // Frame dumps are always RGBA8 and don't depend on the stereo mode, but recreate it anyway
+  m_burn_in_pipeline.reset();
+
   if (g_presenter->GetBackbufferFormat() == AbstractTextureFormat::Undefined)
   {
     // No backbuffer (nogui) means no imgui rendering will happen
@@ -120,8 +125,15 @@ bool OnScreenUI::RecompileImGuiPipeline()
     return true;
   }
 
-  const bool linear_space_output =
-      g_presenter->GetBackbufferFormat() == AbstractTextureFormat::RGBA16F;
+  m_imgui_pipeline =
+      CreateImGuiPipeline(g_presenter->GetBackbufferFormat(), g_gfx->UseGeometryShaderForUI());
+  return m_imgui_pipeline != nullptr;
+}
+
+std::unique_ptr<AbstractPipeline>
+OnScreenUI::CreateImGuiPipeline(AbstractTextureFormat format, bool use_geometry_shader) const
+{
+  const bool linear_space_output = format == AbstractTextureFormat::RGBA16F;
 
   std::unique_ptr<AbstractShader> vertex_shader = g_gfx->CreateShaderFromSource(
       ShaderStage::Vertex, FramebufferShaderGen::GenerateImGuiVertexShader(),
@@ -132,12 +144,12 @@ bool OnScreenUI::RecompileImGuiPipeline()
   if (!vertex_shader || !pixel_shader)
   {
     PanicAlertFmt("Failed to compile ImGui shaders");
-    return false;
+    return nullptr;
   }
 
   // GS is used to render the UI to both eyes in stereo modes.
   std::unique_ptr<AbstractShader> geometry_shader;
-  if (g_gfx->UseGeometryShaderForUI())
+  if (use_geometry_shader)
   {
     geometry_shader = g_gfx->CreateShaderFromSource(
         ShaderStage::Geometry, FramebufferShaderGen::GeneratePassthroughGeometryShader(1, 1),
@@ -145,7 +157,7 @@ bool OnScreenUI::RecompileImGuiPipeline()
     if (!geometry_shader)
     {
       PanicAlertFmt("Failed to compile ImGui geometry shader");
-      return false;
+      return nullptr;
     }
   }
 
@@ -162,19 +174,16 @@ bool OnScreenUI::RecompileImGuiPipeline()
   pconfig.blending_state.dstfactor = DstBlendFactor::InvSrcAlpha;
   pconfig.blending_state.srcfactoralpha = SrcBlendFactor::Zero;
   pconfig.blending_state.dstfactoralpha = DstBlendFactor::One;
-  pconfig.framebuffer_state.color_texture_format = g_presenter->GetBackbufferFormat();
+  pconfig.framebuffer_state.color_texture_format = format;
   pconfig.framebuffer_state.depth_texture_format = AbstractTextureFormat::Undefined;
   pconfig.framebuffer_state.samples = 1;
   pconfig.framebuffer_state.per_sample_shading = false;
   pconfig.usage = AbstractPipelineUsage::Utility;
-  m_imgui_pipeline = g_gfx->CreatePipeline(pconfig);
-  if (!m_imgui_pipeline)
-  {
+  std::unique_ptr<AbstractPipeline> pipeline = g_gfx->CreatePipeline(pconfig);
+  if (!pipeline)
     PanicAlertFmt("Failed to create imgui pipeline");
-    return false;
-  }
 
-  return true;
+  return pipeline;
 }
 
 void OnScreenUI::BeginImGuiFrame(u32 width, u32 height)
@@ -208,8 +217,31 @@ void OnScreenUI::DrawImGui()
   if (!draw_data)
     return;
 
-  g_gfx->SetViewport(0.0f, 0.0f, static_cast<float>(m_backbuffer_width),
-                     static_cast<float>(m_backbuffer_height), 0.0f, 1.0f);
+  SetUpImGuiDrawing(m_imgui_pipeline.get(), m_backbuffer_width, m_backbuffer_height);
+
+  for (int i = 0; i < draw_data->CmdListsCount; i++)
+  {
+    const ImDrawList* cmdlist = draw_data->CmdLists[i];
+    if (cmdlist->VtxBuffer.empty() || cmdlist->IdxBuffer.empty())
+      return;
+
+    DrawImGuiDrawList(*cmdlist);
+  }
+
+  // Some capture software (such as OBS) hooks SwapBuffers and uses glBlitFramebuffer to copy our
+  // back buffer just before swap. Because glBlitFramebuffer honors the scissor test, the capture
+  // itself will be clipped to whatever bounds were last set by ImGui, resulting in a rather useless
+  // capture whenever any ImGui windows are open. We'll reset the scissor rectangle to the entire
+  // viewport here to avoid this problem.
+  g_gfx->SetScissorRect(g_gfx->ConvertFramebufferRectangle(
+      MathUtil::Rectangle<int>(0, 0, m_backbuffer_width, m_backbuffer_height),
+      g_gfx->GetCurrentFramebuffer()));
+}
+
+void OnScreenUI::SetUpImGuiDrawing(const AbstractPipeline* pipeline, u32 width, u32 height)
+{
+  g_gfx->SetViewport(0.0f, 0.0f, static_cast<float>(width), static_cast<float>(height), 0.0f,
+                     1.0f);
 
   // Uniform buffer for draws.
   struct ImGuiUbo
@@ -217,51 +249,74 @@ void OnScreenUI::DrawImGui()
     float u_rcp_viewport_size_mul2[2];
     float padding[2];
   };
-  ImGuiUbo ubo = {{1.0f / m_backbuffer_width * 2.0f, 1.0f / m_backbuffer_height * 2.0f}};
+  ImGuiUbo ubo = {{1.0f / width * 2.0f, 1.0f / height * 2.0f}};
 
   // Set up common state for drawing.
-  g_gfx->SetPipeline(m_imgui_pipeline.get());
+  g_gfx->SetPipeline(pipeline);
   g_gfx->SetSamplerState(0, RenderState::GetPointSamplerState());
   g_vertex_manager->UploadUtilityUniforms(&ubo, sizeof(ubo));
+}
 
-  for (int i = 0; i < draw_data->CmdListsCount; i++)
+void OnScreenUI::DrawImGuiDrawList(const ImDrawList& cmdlist)
+{
+  u32 base_vertex, base_index;
+  g_vertex_manager->UploadUtilityVertices(cmdlist.VtxBuffer.Data, sizeof(ImDrawVert),
+                                          cmdlist.VtxBuffer.Size, cmdlist.IdxBuffer.Data,
+                                          cmdlist.IdxBuffer.Size, &base_vertex, &base_index);
+
+  for (const ImDrawCmd& cmd : cmdlist.CmdBuffer)
   {
-    const ImDrawList* cmdlist = draw_data->CmdLists[i];
-    if (cmdlist->VtxBuffer.empty() || cmdlist->IdxBuffer.empty())
-      return;
+    if (cmd.UserCallback)
+    {
+      cmd.UserCallback(&cmdlist, &cmd);
+      continue;
+    }
 
-    u32 base_vertex, base_index;
-    g_vertex_manager->UploadUtilityVertices(cmdlist->VtxBuffer.Data, sizeof(ImDrawVert),
-                                            cmdlist->VtxBuffer.Size, cmdlist->IdxBuffer.Data,
-                                            cmdlist->IdxBuffer.Size, &base_vertex, &base_index);
+    g_gfx->SetScissorRect(g_gfx->ConvertFramebufferRectangle(
+        MathUtil::Rectangle<int>(
+            static_cast<int>(cmd.ClipRect.x), static_cast<int>(cmd.ClipRect.y),
+            static_cast<int>(cmd.ClipRect.z), static_cast<int>(cmd.ClipRect.w)),
+        g_gfx->GetCurrentFramebuffer()));
+    g_gfx->SetTexture(0, reinterpret_cast<const AbstractTexture*>(cmd.TextureId));
+    g_gfx->DrawIndexed(base_index, cmd.ElemCount, base_vertex);
+    base_index += cmd.ElemCount;
+  }
+}
 
-    for (const ImDrawCmd& cmd : cmdlist->CmdBuffer)
-    {
-      if (cmd.UserCallback)
-      {
-        cmd.UserCallback(cmdlist, &cmd);
-        continue;
-      }
+void OnScreenUI::DrawBurnInMessages(AbstractFramebuffer* framebuffer, float scale)
+{
+  std::lock_guard lock(m_imgui_mutex);
 
-      g_gfx->SetScissorRect(g_gfx->ConvertFramebufferRectangle(
-          MathUtil::Rectangle<int>(
-              static_cast<int>(cmd.ClipRect.x), static_cast<int>(cmd.ClipRect.y),
-              static_cast<int>(cmd.ClipRect.z), static_cast<int>(cmd.ClipRect.w)),
-          g_gfx->GetCurrentFramebuffer()));
-      g_gfx->SetTexture(0, reinterpret_cast<const AbstractTexture*>(cmd.TextureId));
-      g_gfx->DrawIndexed(base_index, cmd.ElemCount, base_vertex);
-      base_index += cmd.ElemCount;
-    }
+  if (!m_burn_in_draw_list)
+    m_burn_in_draw_list = std::make_unique<ImDrawList>(ImGui::GetDrawListSharedData());
+
+  const u32 width = framebuffer->GetWidth();
+  const u32 height = framebuffer->GetHeight();
+  const ImVec2 size(static_cast<float>(width), static_cast<float>(height));
+
+  ImDrawList& draw_list = *m_burn_in_draw_list;
+  draw_list._ResetForNewFrame();
+  draw_list.PushTextureID(ImGui::GetIO().Fonts->TexID);
+  draw_list.PushClipRect(ImVec2(0, 0), size);
+  if (!OSD::DrawBurnInMessages(draw_list, size, scale))
+    return;
+  draw_list._PopUnusedDrawCmd();
+
+  if (!m_burn_in_pipeline)
+  {
+    m_burn_in_pipeline = CreateImGuiPipeline(framebuffer->GetColorFormat(), false);
+    if (!m_burn_in_pipeline)
+      return;
   }
 
-  // Some capture software (such as OBS) hooks SwapBuffers and uses glBlitFramebuffer to copy our
-  // back buffer just before swap. Because glBlitFramebuffer honors the scissor test, the capture
-  // itself will be clipped to whatever bounds were last set by ImGui, resulting in a rather useless
-  // capture whenever any ImGui windows are open. We'll reset the scissor rectangle to the entire
-  // viewport here to avoid this problem.
-  g_gfx->SetScissorRect(g_gfx->ConvertFramebufferRectangle(
-      MathUtil::Rectangle<int>(0, 0, m_backbuffer_width, m_backbuffer_height),
-      g_gfx->GetCurrentFramebuffer()));
+  // Drawn straight into the frame before it's read back, so it costs no readback of its own
+  g_gfx->BeginUtilityDrawing();
+  g_gfx->SetFramebuffer(framebuffer);
+  SetUpImGuiDrawing(m_burn_in_pipeline.get(), width, height);
+  DrawImGuiDrawList(draw_list);
+  g_gfx->EndUtilityDrawing();
+  if (framebuffer->GetColorAttachment())
+    framebuffer->GetColorAttachment()->FinishedRendering();
 }
 
 // Create On-Screen-Messages
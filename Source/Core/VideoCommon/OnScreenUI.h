@@ -13,8 +13,11 @@
 #include "VideoCommon/OnScreenUIKeyMap.h"
 
 class NativeVertexFormat;
+class AbstractFramebuffer;
 class AbstractTexture;
 class AbstractPipeline;
+enum class AbstractTextureFormat : u32;
+struct ImDrawList;
 
 namespace VideoCommon
 {
@@ -49,6 +52,10 @@ public:
   // Recompiles ImGui pipeline - call when stereo mode changes.
   bool RecompileImGuiPipeline();
 
+  // Burns the OSD's burn_in messages into a frame about to be dumped, at scale relative to the
+  // screen. Acquires the ImGui lock.
+  void DrawBurnInMessages(AbstractFramebuffer* framebuffer, float scale);
+
   void SetScale(float backbuffer_scale);
 
   void Finalize();
@@ -62,10 +69,18 @@ public:
 private:
   void DrawDebugText();
 
+  std::unique_ptr<AbstractPipeline> CreateImGuiPipeline(AbstractTextureFormat format,
+                                                        bool use_geometry_shader) const;
+  void SetUpImGuiDrawing(const AbstractPipeline* pipeline, u32 width, u32 height);
+  void DrawImGuiDrawList(const ImDrawList& cmdlist);
+
   // ImGui resources.
   std::unique_ptr<NativeVertexFormat> m_imgui_vertex_format;
   std::vector<std::unique_ptr<AbstractTexture>> m_imgui_textures;
   std::unique_ptr<AbstractPipeline> m_imgui_pipeline;
+  // For burning messages into frame dumps, created on first use
+  std::unique_ptr<AbstractPipeline> m_burn_in_pipeline;
+  std::unique_ptr<ImDrawList> m_burn_in_draw_list;
   std::map<u32, int> m_dolphin_to_imgui_map;
   std::mutex m_imgui_mutex;
   u64 m_imgui_last_frame_time = 0;
@@ -14,7 +14,11 @@
 
 #include "VideoCommon/OpcodeDecoding.h"
 
+#include <unordered_map>
+#include <vector>
+
 #include "Common/Assert.h"
+#include "Common/Hash.h"
 #include "Common/Logging/Log.h"
 #include "Core/FifoPlayer/FifoRecorder.h"
 #include "Core/HW/Memmap.h"
@@ -24,6 +28,7 @@
 #include "VideoCommon/CommandProcessor.h"
 #include "VideoCommon/DataReader.h"
 #include "VideoCommon/Fifo.h"
+#include "VideoCommon/FrameProfiler.h"
 #include "VideoCommon/Statistics.h"
 #include "VideoCommon/VertexLoaderBase.h"
 #include "VideoCommon/VertexLoaderManager.h"
@@ -34,6 +39,203 @@
 namespace OpcodeDecoder
 {
 bool g_record_fifo_data = false;
+u64 g_fifo_batch = 0;
+
+namespace
+{
+// A command of a display list as the callbacks saw it when the list was decoded
+struct DecodedCommand
+{
+  enum class Type : u8
+  {
+    XF,
+    CP,
+    BP,
+    IndexedLoad,
+    Primitive,
+    DisplayList,
+    Nop,
+    Unknown,
+  };
+
+  Type type;
+  // CP and BP register, XF count, indexed load size, VAT of a primitive, unknown opcode
+  u8 command;
+  // Primitive type, indexed load array
+  u8 extra;
+  // XF and indexed load address, vertex count of a primitive
+  u16 address;
+  // CP and BP value, indexed load index, vertex size of a primitive, display list address,
+  // NOP count
+  u32 value;
+  // Display list size
+  u32 value2;
+  // Offset and size of the command in the display list
+  u32 offset;
+  u32 size;
+};
+
+// Display lists that were decoded before, so that calling them again only needs a hash of their
+// contents instead of parsing them. The vertex size of a primitive depends on the VAT at the time
+// of the call, so replaying falls back to parsing from the first primitive whose size changed.
+// Lists are only recorded on their second call with the same contents, and only if they are
+// mostly made of small commands; for lists of large primitives, parsing isn't slower than
+// hashing.
+class DisplayListCache
+{
+public:
+  static constexpr size_t MAX_ENTRIES = 4096;
+  static constexpr u32 MAX_AVERAGE_COMMAND_SIZE = 32;
+
+  struct Entry
+  {
+    u64 hash = 0;
+    bool seen_before = false;
+    // Cleared for lists of large commands
+    bool cacheable = true;
+    std::vector<DecodedCommand> commands;
+  };
+
+  // Returns nullptr without hashing the list if the list at this address and of this size was
+  // found not to be worth caching. That sticks until the cache is cleared, even if the contents
+  // change, since lists of large commands usually stay that way.
+  Entry* Lookup(u32 address, u32 size, const u8* data)
+  {
+    if (m_entries.size() >= MAX_ENTRIES)
+      m_entries.clear();
+
+    Entry& entry = m_entries[(u64(size) << 32) | address];
+    if (!entry.cacheable)
+      return nullptr;
+
+    const u64 hash = Common::HashData(data, size);
+    if (entry.hash != hash)
+    {
+      entry.hash = hash;
+      entry.seen_before = false;
+      entry.commands.clear();
+    }
+    return &entry;
+  }
+
+private:
+  std::unordered_map<u64, Entry> m_entries;
+};
+
+// Passes the commands on to another callback, and records them
+template <typename T>
+class RecordingCallback final : public Callback
+{
+public:
+  RecordingCallback(T& callback, const u8* start, std::vector<DecodedCommand>& commands)
+      : m_callback(callback), m_start(start), m_commands(commands)
+  {
+  }
+
+  OPCODE_CALLBACK(void OnXF(u16 address, u8 count, const u8* data))
+  {
+    m_commands.push_back({DecodedCommand::Type::XF, count, 0, address});
+    m_callback.OnXF(address, count, data);
+  }
+  OPCODE_CALLBACK(void OnCP(u8 command, u32 value))
+  {
+    m_commands.push_back({DecodedCommand::Type::CP, command, 0, 0, value});
+    m_callback.OnCP(command, value);
+  }
+  OPCODE_CALLBACK(void OnBP(u8 command, u32 value))
+  {
+    m_commands.push_back({DecodedCommand::Type::BP, command, 0, 0, value});
+    m_callback.OnBP(command, value);
+  }
+  OPCODE_CALLBACK(void OnIndexedLoad(CPArray array, u32 index, u16 address, u8 size))
+  {
+    m_commands.push_back(
+        {DecodedCommand::Type::IndexedLoad, size, static_cast<u8>(array), address, index});
+    m_callback.OnIndexedLoad(array, index, address, size);
+  }
+  OPCODE_CALLBACK(void OnPrimitiveCommand(OpcodeDecoder::Primitive primitive, u8 vat,
+                                          u32 vertex_size, u16 num_vertices, const u8* vertex_data))
+  {
+    m_commands.push_back({DecodedCommand::Type::Primitive, vat, static_cast<u8>(primitive),
+                          num_vertices, vertex_size});
+    m_callback.OnPrimitiveCommand(primitive, vat, vertex_size, num_vertices, vertex_data);
+  }
+  OPCODE_CALLBACK(void OnDisplayList(u32 address, u32 size))
+  {
+    m_commands.push_back({DecodedCommand::Type::DisplayList, 0, 0, 0, address, size});
+    m_callback.OnDisplayList(address, size);
+  }
+  OPCODE_CALLBACK(void OnNop(u32 count))
+  {
+    m_commands.push_back({DecodedCommand::Type::Nop, 0, 0, 0, count});
+    m_callback.OnNop(count);
+  }
+  OPCODE_CALLBACK(void OnUnknown(u8 opcode, const u8* data))
+  {
+    m_commands.push_back({DecodedCommand::Type::Unknown, opcode});
+    m_callback.OnUnknown(opcode, data);
+  }
+  OPCODE_CALLBACK(void OnCommand(const u8* data, u32 size))
+  {
+    DecodedCommand& command = m_commands.back();
+    command.offset = static_cast<u32>(data - m_start);
+    command.size = size;
+    m_callback.OnCommand(data, size);
+  }
+  OPCODE_CALLBACK(CPState& GetCPState()) { return m_callback.GetCPState(); }
+  OPCODE_CALLBACK(u32 GetVertexSize(u8 vat)) { return m_callback.GetVertexSize(vat); }
+
+private:
+  T& m_callback;
+  const u8* m_start;
+  std::vector<DecodedCommand>& m_commands;
+};
+
+// Calls the callback for the recorded commands of a display list starting at start
+template <typename T>
+void Replay(const std::vector<DecodedCommand>& commands, const u8* start, u32 size, T& callback)
+{
+  for (const DecodedCommand& command : commands)
+  {
+    const u8* data = start + command.offset;
+    switch (command.type)
+    {
+    case DecodedCommand::Type::XF:
+      callback.OnXF(command.address, command.command, data + 5);
+      break;
+    case DecodedCommand::Type::CP:
+      callback.OnCP(command.command, command.value);
+      break;
+    case DecodedCommand::Type::BP:
+      callback.OnBP(command.command, command.value);
+      break;
+    case DecodedCommand::Type::IndexedLoad:
+      callback.OnIndexedLoad(static_cast<CPArray>(command.extra), command.value, command.address,
+                             command.command);
+      break;
+    case DecodedCommand::Type::Primitive:
+      if (callback.GetVertexSize(command.command) != command.value)
+      {
+        Run(data, size - command.offset, callback);
+        return;
+      }
+      callback.OnPrimitiveCommand(static_cast<Primitive>(command.extra), command.command,
+                                  command.value, command.address, data + 3);
+      break;
+    case DecodedCommand::Type::DisplayList:
+      callback.OnDisplayList(command.value, command.value2);
+      break;
+    case DecodedCommand::Type::Nop:
+      callback.OnNop(command.value);
+      break;
+    case DecodedCommand::Type::Unknown:
+      callback.OnUnknown(command.command, data);
+      break;
+    }
+    callback.OnCommand(data, command.size);
+  }
+}
+}  // namespace
 
 template <bool is_preprocess>
 class RunCallback final : public Callback
@@ -131,7 +333,8 @@ public:
     const u32 size = vertex_size * num_vertices;
 
     const u32 bytes =
-        VertexLoaderManager::RunVertices<is_preprocess>(vat, primitive, num_vertices, vertex_data);
+        VertexLoaderManager::RunVertices<is_preprocess>(vat, primitive, num_vertices, vertex_data,
+                                                        m_in_display_list);
 
     ASSERT(bytes == size);
 
@@ -164,7 +367,7 @@ public:
 
         if (start_address != nullptr)
         {
-          Run(start_address, size, *this);
+          RunDisplayList(address, start_address, size);
         }
       }
       else
@@ -188,7 +391,7 @@ public:
           // temporarily swap dl and non-dl (small "hack" for the stats)
           g_stats.SwapDL();
 
-          Run(start_address, size, *this);
+          RunDisplayList(address, start_address, size);
           INCSTAT(g_stats.this_frame.num_dlists_called);
 
           // un-swap
@@ -255,11 +458,50 @@ public:
 
   u32 m_cycles = 0;
   bool m_in_display_list = false;
+
+private:
+  void RunDisplayList(u32 address, const u8* start_address, u32 size)
+  {
+    DisplayListCache::Entry* const entry =
+        s_display_list_cache.Lookup(address, size, start_address);
+    if (!entry)
+    {
+      Run(start_address, size, *this);
+    }
+    else if (!entry->commands.empty())
+    {
+      Replay(entry->commands, start_address, size, *this);
+    }
+    else if (entry->seen_before)
+    {
+      RecordingCallback recorder(*this, start_address, entry->commands);
+      Run(start_address, size, recorder);
+
+      if (entry->commands.size() * DisplayListCache::MAX_AVERAGE_COMMAND_SIZE < size)
+      {
+        entry->cacheable = false;
+        entry->commands = {};
+      }
+    }
+    else
+    {
+      entry->seen_before = true;
+      Run(start_address, size, *this);
+    }
+  }
+
+  // The CPU and GPU threads both decode display lists when the GPU thread is deterministic
+  static inline DisplayListCache s_display_list_cache;
 };
 
 template <bool is_preprocess>
 u8* RunFifo(DataReader src, u32* cycles)
 {
+  if constexpr (!is_preprocess)
+    ++g_fifo_batch;
+
+  FrameProfiler::Scope profile_scope(FrameProfiler::Stage::OpcodeDecode, !is_preprocess);
+
   using CallbackT = RunCallback<is_preprocess>;
   auto callback = CallbackT{};
   u32 size = Run(src.GetPointer(), static_cast<u32>(src.size()), callback);
@@ -21,6 +21,11 @@ namespace OpcodeDecoder
 // Global flag to signal if FifoRecorder is active.
 extern bool g_record_fifo_data;
 
+// Incremented every time the GPU starts running a batch of FIFO data. Writes to emulated memory
+// that are ordered before any command of a batch have already happened when the batch starts, so
+// memory read during a batch only changes through the GPU's own writes until the next batch.
+extern u64 g_fifo_batch;
+
 enum class Opcode
 {
   GX_NOP = 0x00,
@@ -60,6 +60,10 @@ public:
   // carefully!
   virtual void FlushResults() {}
 
+  // Collect the results of queries that the host GPU has already finished, submitting the pending
+  // ones so that they finish soon, without waiting for any of them
+  virtual void PollResults() {}
+
   // True if there are no further pending query results
   // NOTE: Called from CPU thread
   virtual bool IsFlushed() const { return true; }
@@ -4,6 +4,7 @@
 #include "VideoCommon/PerformanceMetrics.h"
 
 #include <mutex>
+#include <vector>
 
 #include <imgui.h>
 #include <implot.h>
@@ -11,6 +12,10 @@
 #include "Core/CoreTiming.h"
 #include "Core/HW/VideoInterface.h"
 #include "Core/System.h"
+#include "DiscIO/FileReadQueue.h"
+#include "DiscIO/WIABlob.h"
+#include "VideoCommon/FramePacer.h"
+#include "VideoCommon/ShaderCache.h"
 #include "VideoCommon/VideoConfig.h"
 
 PerformanceMetrics g_perf_metrics;
@@ -22,6 +27,7 @@ void PerformanceMetrics::Reset()
   m_speed_counter.Reset();
 
   m_time_sleeping = DT::zero();
+  m_audio_underruns = 0;
   m_real_times.fill(Clock::now());
   m_cpu_times.fill(Core::System::GetInstance().GetCoreTiming().GetCPUTimePoint(0));
 }
@@ -52,6 +58,17 @@ void PerformanceMetrics::CountPerformanceMarker(Core::System& system, s64 cycles
   m_time_index += 1;
 }
 
+void PerformanceMetrics::CountAudioUnderrun()
+{
+  m_audio_underruns.fetch_add(1, std::memory_order_relaxed);
+}
+
+void PerformanceMetrics::SetAudioBufferLevels(double fill_ms, double target_ms)
+{
+  m_audio_fill_ms.store(fill_ms, std::memory_order_relaxed);
+  m_audio_target_ms.store(target_ms, std::memory_order_relaxed);
+}
+
 double PerformanceMetrics::GetFPS() const
 {
   return m_fps_counter.GetHzAvg();
@@ -80,6 +97,21 @@ double PerformanceMetrics::GetLastSpeedDenominator() const
          Core::System::GetInstance().GetVideoInterface().GetTargetRefreshRate();
 }
 
+u64 PerformanceMetrics::GetAudioUnderrunCount() const
+{
+  return m_audio_underruns.load(std::memory_order_relaxed);
+}
+
+double PerformanceMetrics::GetAudioFillLevel() const
+{
+  return m_audio_fill_ms.load(std::memory_order_relaxed);
+}
+
+double PerformanceMetrics::GetAudioTargetLevel() const
+{
+  return m_audio_target_ms.load(std::memory_order_relaxed);
+}
+
 void PerformanceMetrics::DrawImGuiStats(const float backbuffer_scale)
 {
   const float bg_alpha = 0.7f;
@@ -187,6 +219,61 @@ void PerformanceMetrics::DrawImGuiStats(const float backbuffer_scale)
     }
   }
 
+  if (g_ActiveConfig.bShowGraphs && g_ActiveConfig.bFramePacing)
+  {
+    const float latency_height = graph_height / 2;
+
+    ImGui::PushStyleVar(ImGuiStyleVar_WindowPadding, ImVec2(0, 4.f * backbuffer_scale));
+    ImGui::SetNextWindowPos(ImVec2(window_x, window_y), ImGuiCond_Always, ImVec2(1.0f, 0.0f));
+    ImGui::SetNextWindowSize(ImVec2(graph_width, latency_height));
+    ImGui::SetNextWindowBgAlpha(bg_alpha);
+    window_y += latency_height + window_padding;
+
+    if (ImGui::Begin("PresentLatency", nullptr, imgui_flags))
+    {
+      const std::vector<FramePacer::Sample> samples = g_frame_pacer.GetSamples();
+      std::vector<double> latency, wait, delay;
+      latency.reserve(samples.size());
+      wait.reserve(samples.size());
+      delay.reserve(samples.size());
+      double max_time = 1.0;
+      for (const FramePacer::Sample& sample : samples)
+      {
+        latency.push_back(DT_ms(sample.latency).count());
+        wait.push_back(DT_ms(sample.wait).count());
+        delay.push_back(DT_ms(sample.delay).count());
+        max_time = std::max(max_time, latency.back());
+      }
+
+      if (ImPlot::BeginPlot("PresentLatency", ImVec2(-1.0, -1.0),
+                            ImPlotFlags_NoFrame | ImPlotFlags_NoTitle | ImPlotFlags_NoMenus))
+      {
+        ImPlot::PushStyleColor(ImPlotCol_PlotBg, {0, 0, 0, 0});
+        ImPlot::PushStyleColor(ImPlotCol_LegendBg, {0, 0, 0, 0.2f});
+        ImPlot::PushStyleVar(ImPlotStyleVar_FitPadding, ImVec2(0.f, 0.f));
+        ImPlot::PushStyleVar(ImPlotStyleVar_LineWeight, 1.5f * backbuffer_scale);
+        ImPlot::SetupAxes(nullptr, nullptr,
+                          ImPlotAxisFlags_Lock | ImPlotAxisFlags_NoDecorations |
+                              ImPlotAxisFlags_NoHighlight,
+                          ImPlotAxisFlags_Lock | ImPlotAxisFlags_NoLabel |
+                              ImPlotAxisFlags_NoHighlight);
+        ImPlot::SetupAxisFormat(ImAxis_Y1, "%.1f");
+        ImPlot::SetupAxesLimits(0, static_cast<double>(FramePacer::NUM_SAMPLES - 1), 0,
+                                max_time * 1.1, ImGuiCond_Always);
+        ImPlot::SetupLegend(ImPlotLocation_NorthWest, ImPlotLegendFlags_None);
+        const int count = static_cast<int>(samples.size());
+        ImPlot::PlotLine("Present Latency (ms)", latency.data(), count);
+        ImPlot::PlotLine("Display Wait (ms)", wait.data(), count);
+        ImPlot::PlotLine("CPU Delay (ms)", delay.data(), count);
+        ImPlot::EndPlot();
+        ImPlot::PopStyleVar(2);
+        ImPlot::PopStyleColor(2);
+      }
+      ImGui::End();
+    }
+    ImGui::PopStyleVar();
+  }
+
   if (g_ActiveConfig.bShowSpeed)
   {
     // Position in the top-right corner of the screen.
@@ -269,5 +356,79 @@ void PerformanceMetrics::DrawImGuiStats(const float backbuffer_scale)
     }
   }
 
+  if (g_ActiveConfig.bShowDiscCacheStats)
+  {
+    const DiscIO::WIARVZGroupCacheStats stats = DiscIO::GetWIARVZGroupCacheStats();
+    const u64 reads = stats.hits + stats.misses;
+    const DiscIO::FileReadStats file_stats = DiscIO::GetFileReadStats();
+    float window_height = (12.f + 17.f * 3) * backbuffer_scale;
+
+    // Position in the top-right corner of the screen.
+    ImGui::SetNextWindowPos(ImVec2(window_x, window_y), ImGuiCond_Always, ImVec2(1.0f, 0.0f));
+    ImGui::SetNextWindowSize(ImVec2(window_width, window_height));
+    ImGui::SetNextWindowBgAlpha(bg_alpha);
+
+    if (stack_vertically)
+      window_y += window_height + window_padding;
+    else
+      window_x -= window_width + window_padding;
+
+    if (ImGui::Begin("DiscCacheStats", nullptr, imgui_flags))
+    {
+      ImGui::Text("Hit:%6.1lf%%", reads != 0 ? 100.0 * stats.hits / reads : 0.0);
+      ImGui::Text("Miss:%6llu", static_cast<unsigned long long>(stats.misses));
+      ImGui::Text("I/O:%3u/%-3u", file_stats.outstanding, file_stats.peak_outstanding);
+      ImGui::End();
+    }
+  }
+
+  if (g_ActiveConfig.bShowShaderCompilerStats && g_shader_cache)
+  {
+    const VideoCommon::AsyncShaderCompiler::Stats stats = g_shader_cache->GetAsyncCompilerStats();
+    float window_height = (12.f + 17.f * 4) * backbuffer_scale;
+
+    // Position in the top-right corner of the screen.
+    ImGui::SetNextWindowPos(ImVec2(window_x, window_y), ImGuiCond_Always, ImVec2(1.0f, 0.0f));
+    ImGui::SetNextWindowSize(ImVec2(window_width, window_height));
+    ImGui::SetNextWindowBgAlpha(bg_alpha);
+
+    if (stack_vertically)
+      window_y += window_height + window_padding;
+    else
+      window_x -= window_width + window_padding;
+
+    if (ImGui::Begin("ShaderCompilerStats", nullptr, imgui_flags))
+    {
+      ImGui::Text("Queue:%5zu", stats.pending_items - stats.pending_speculative_items);
+      ImGui::Text("Bg:%4zu/%-2zu", stats.pending_speculative_items, stats.max_speculative_workers);
+      ImGui::Text("Lat:%5.1lfms", stats.average_latency_ms);
+      ImGui::Text("Gen:%5.2lfms", stats.average_codegen_ms);
+      ImGui::End();
+    }
+  }
+
+  if (g_ActiveConfig.bShowAudioStats)
+  {
+    float window_height = (12.f + 17.f * 3) * backbuffer_scale;
+
+    // Position in the top-right corner of the screen.
+    ImGui::SetNextWindowPos(ImVec2(window_x, window_y), ImGuiCond_Always, ImVec2(1.0f, 0.0f));
+    ImGui::SetNextWindowSize(ImVec2(window_width, window_height));
+    ImGui::SetNextWindowBgAlpha(bg_alpha);
+
+    if (stack_vertically)
+      window_y += window_height + window_padding;
+    else
+      window_x -= window_width + window_padding;
+
+    if (ImGui::Begin("AudioStats", nullptr, imgui_flags))
+    {
+      ImGui::Text("Buf:%5.1lfms", GetAudioFillLevel());
+      ImGui::Text("Tgt:%5.1lfms", GetAudioTargetLevel());
+      ImGui::Text("Und:%6llu", static_cast<unsigned long long>(GetAudioUnderrunCount()));
+      ImGui::End();
+    }
+  }
+
   ImGui::PopStyleVar(2);
 }
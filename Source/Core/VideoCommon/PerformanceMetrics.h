@@ -4,6 +4,7 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <shared_mutex>
 
 #include "Common/CommonTypes.h"
@@ -33,6 +34,10 @@ public:
   void CountThrottleSleep(DT sleep);
   void CountPerformanceMarker(Core::System& system, s64 cyclesLate);
 
+  // Called from the audio thread
+  void CountAudioUnderrun();
+  void SetAudioBufferLevels(double fill_ms, double target_ms);
+
   // Getter Functions
   double GetFPS() const;
   double GetVPS() const;
@@ -41,6 +46,10 @@ public:
 
   double GetLastSpeedDenominator() const;
 
+  u64 GetAudioUnderrunCount() const;
+  double GetAudioFillLevel() const;
+  double GetAudioTargetLevel() const;
+
   // ImGui Functions
   void DrawImGuiStats(const float backbuffer_scale);
 
@@ -57,6 +66,10 @@ private:
   std::array<TimePoint, 256> m_real_times{};
   std::array<TimePoint, 256> m_cpu_times{};
   DT m_time_sleeping{};
+
+  std::atomic<u64> m_audio_underruns{0};
+  std::atomic<double> m_audio_fill_ms{0.0};
+  std::atomic<double> m_audio_target_ms{0.0};
 };
 
 extern PerformanceMetrics g_perf_metrics;
@@ -3,6 +3,10 @@
 
 #include "VideoCommon/PostProcessing.h"
 
+#include <algorithm>
+#include <cmath>
+#include <optional>
+#include <span>
 #include <sstream>
 #include <string>
 #include <string_view>
@@ -60,6 +64,92 @@ bool LoadShaderFromFile(const std::string& shader, const std::string& sub_dir,
   return true;
 }
 
+std::optional<std::vector<float>>
+SchedulePostProcessingPasses(std::vector<PostProcessingPass>* passes)
+{
+  // The passes that wrote what each pass reads, and the last pass that reads each output
+  std::vector<std::vector<std::optional<size_t>>> writers(passes->size());
+  std::vector<size_t> last_reads(passes->size());
+  for (size_t i = 0; i < passes->size(); ++i)
+  {
+    const PostProcessingPass& pass = (*passes)[i];
+    if (pass.inputs.empty() || pass.inputs.size() > PostProcessingPass::MAX_INPUTS)
+    {
+      ERROR_LOG_FMT(VIDEO, "Post-processing pass {} has {} inputs, but 1 to {} are supported", i,
+                    pass.inputs.size(), PostProcessingPass::MAX_INPUTS);
+      return std::nullopt;
+    }
+
+    last_reads[i] = i;
+    for (const std::string& input : pass.inputs)
+    {
+      if (input == PostProcessingPass::COLOR_BUFFER_INPUT)
+      {
+        writers[i].push_back(std::nullopt);
+        continue;
+      }
+
+      // The latest output of that name
+      const auto earlier_passes = std::span(*passes).first(i);
+      const auto writer = std::find_if(
+          earlier_passes.rbegin(), earlier_passes.rend(),
+          [&input](const PostProcessingPass& other) { return other.output == input; });
+      if (input.empty() || writer == earlier_passes.rend())
+      {
+        ERROR_LOG_FMT(VIDEO, "Post-processing pass {} reads \"{}\", which no pass before outputs",
+                      i, input);
+        return std::nullopt;
+      }
+
+      const size_t writer_index = std::distance(writer, earlier_passes.rend()) - 1;
+      writers[i].push_back(writer_index);
+      last_reads[writer_index] = i;
+    }
+  }
+
+  std::vector<float> target_scales;
+  std::vector<bool> free_targets;
+  for (size_t i = 0; i < passes->size(); ++i)
+  {
+    PostProcessingPass& pass = (*passes)[i];
+    pass.input_targets.clear();
+    for (const std::optional<size_t>& writer : writers[i])
+      pass.input_targets.push_back(writer ? (*passes)[*writer].target : std::nullopt);
+
+    // The last pass renders the final image
+    pass.target.reset();
+    if (i + 1 < passes->size())
+    {
+      // What the inputs are read from isn't free until after the pass, so a pass never renders to
+      // one of its inputs.
+      u32 target = 0;
+      while (target < target_scales.size() &&
+             !(free_targets[target] && target_scales[target] == pass.output_scale))
+      {
+        ++target;
+      }
+      if (target == target_scales.size())
+      {
+        target_scales.push_back(pass.output_scale);
+        free_targets.push_back(false);
+      }
+      free_targets[target] = false;
+      pass.target = target;
+    }
+
+    // Nothing reads these after this pass
+    for (const std::optional<size_t>& writer : writers[i])
+    {
+      if (writer && last_reads[*writer] == i)
+        free_targets[*(*passes)[*writer].target] = true;
+    }
+    if (pass.target && last_reads[i] == i)
+      free_targets[*pass.target] = true;
+  }
+
+  return target_scales;
+}
+
 PostProcessingConfiguration::PostProcessingConfiguration() = default;
 
 PostProcessingConfiguration::~PostProcessingConfiguration() = default;
@@ -102,6 +192,8 @@ void PostProcessingConfiguration::LoadShader(const std::string& shader)
 void PostProcessingConfiguration::LoadDefaultShader()
 {
   m_options.clear();
+  m_passes.assign(1, {});
+  m_target_scales.clear();
   m_any_options_dirty = false;
   m_current_shader = "";
   m_current_shader_code = s_empty_pixel_shader;
@@ -115,6 +207,8 @@ void PostProcessingConfiguration::LoadOptions(const std::string& code)
   size_t configuration_end = code.find(config_end_delimiter);
 
   m_options.clear();
+  m_passes.assign(1, {});
+  m_target_scales.clear();
   m_any_options_dirty = true;
 
   if (configuration_start == std::string::npos || configuration_end == std::string::npos)
@@ -179,8 +273,37 @@ void PostProcessingConfiguration::LoadOptions(const std::string& code)
     }
   }
 
+  std::vector<PostProcessingPass> passes;
   for (const auto& it : option_strings)
   {
+    if (it.m_type == "Pass")
+    {
+      PostProcessingPass& pass = passes.emplace_back();
+      for (const auto& [key, value] : it.m_options)
+      {
+        if (key == "EntryPoint")
+        {
+          pass.entry_point = value;
+        }
+        else if (key == "Inputs")
+        {
+          pass.inputs.clear();
+          for (const std::string& input : SplitString(value, ','))
+            pass.inputs.emplace_back(StripWhitespace(input));
+        }
+        else if (key == "Output")
+        {
+          pass.output = value;
+        }
+        else if (key == "OutputScale")
+        {
+          if (!TryParse(value, &pass.output_scale) || !(pass.output_scale > 0.0f))
+            pass.output_scale = 1.0f;
+        }
+      }
+      continue;
+    }
+
     ConfigurationOption option;
     option.m_dirty = true;
 
@@ -252,6 +375,17 @@ void PostProcessingConfiguration::LoadOptions(const std::string& code)
     }
     m_options[option.m_option_name] = option;
   }
+
+  if (passes.empty())
+    return;
+
+  // A shader with broken passes fails to compile without a main(), same as a broken shader
+  std::optional<std::vector<float>> target_scales = SchedulePostProcessingPasses(&passes);
+  if (!target_scales)
+    return;
+
+  m_passes = std::move(passes);
+  m_target_scales = std::move(*target_scales);
 }
 
 void PostProcessingConfiguration::LoadOptionsConfiguration()
@@ -434,9 +568,10 @@ void PostProcessing::RecompileShader()
   // and pipelines even if there might not be need to.
 
   m_default_pipeline.reset();
-  m_pipeline.reset();
+  m_pipelines.clear();
+  m_pass_targets.clear();
   m_default_pixel_shader.reset();
-  m_pixel_shader.reset();
+  m_pixel_shaders.clear();
   m_default_vertex_shader.reset();
   m_vertex_shader.reset();
   if (!CompilePixelShader())
@@ -450,7 +585,7 @@ void PostProcessing::RecompileShader()
 void PostProcessing::RecompilePipeline()
 {
   m_default_pipeline.reset();
-  m_pipeline.reset();
+  m_pipelines.clear();
   CompilePipeline();
 }
 
@@ -484,6 +619,12 @@ void PostProcessing::BlitFromTexture(const MathUtil::Rectangle<int>& dst,
   const bool copy_all_layers = src_layer < 0;
   src_layer = std::max(src_layer, 0);
 
+  // We keep the min number of layers as the render target,
+  // as in case of OpenGL, the source FBX will have two layers,
+  // but we will render onto two separate frame buffers (one by one),
+  // so it would be a waste to allocate two layers (see "bUsesExplictQuadBuffering").
+  const u32 target_layers = copy_all_layers ? src_tex->GetLayers() : 1;
+
   MathUtil::Rectangle<int> src_rect = src;
   g_gfx->SetSamplerState(0, RenderState::GetLinearSamplerState());
   g_gfx->SetSamplerState(1, RenderState::GetPointSamplerState());
@@ -497,9 +638,7 @@ void PostProcessing::BlitFromTexture(const MathUtil::Rectangle<int>& dst,
       g_ActiveConfig.output_resampling_mode > OutputResamplingMode::Default;
   const bool needs_intermediary_buffer = NeedsIntermediaryBuffer();
   const bool needs_default_pipeline = needs_color_correction || needs_resampling;
-  const AbstractPipeline* final_pipeline = m_pipeline.get();
-  std::vector<u8>* uniform_staging_buffer = &m_default_uniform_staging_buffer;
-  bool default_uniform_staging_buffer = true;
+  bool default_pipeline_is_final = false;
   const MathUtil::Rectangle<int> present_rect = g_presenter->GetTargetRectangle();
 
   // Intermediary pass.
@@ -512,12 +651,6 @@ void PostProcessing::BlitFromTexture(const MathUtil::Rectangle<int>& dst,
   {
     AbstractFramebuffer* const previous_framebuffer = g_gfx->GetCurrentFramebuffer();
 
-    // We keep the min number of layers as the render target,
-    // as in case of OpenGL, the source FBX will have two layers,
-    // but we will render onto two separate frame buffers (one by one),
-    // so it would be a waste to allocate two layers (see "bUsesExplictQuadBuffering").
-    const u32 target_layers = copy_all_layers ? src_tex->GetLayers() : 1;
-
     const u32 target_width =
         needs_resampling ? present_rect.GetWidth() : static_cast<u32>(src_rect.GetWidth());
     const u32 target_height =
@@ -540,11 +673,12 @@ void PostProcessing::BlitFromTexture(const MathUtil::Rectangle<int>& dst,
 
     g_gfx->SetFramebuffer(m_intermediary_frame_buffer.get());
 
-    FillUniformBuffer(src_rect, src_tex, src_layer, g_gfx->GetCurrentFramebuffer()->GetRect(),
-                      present_rect, uniform_staging_buffer->data(), !default_uniform_staging_buffer,
-                      true);
-    g_vertex_manager->UploadUtilityUniforms(uniform_staging_buffer->data(),
-                                            static_cast<u32>(uniform_staging_buffer->size()));
+    const PassInput source = {src_tex, src_rect, src_layer};
+    FillUniformBuffer(source, source, g_gfx->GetCurrentFramebuffer()->GetRect(), present_rect,
+                      m_default_uniform_staging_buffer.data(), false, true);
+    g_vertex_manager->UploadUtilityUniforms(
+        m_default_uniform_staging_buffer.data(),
+        static_cast<u32>(m_default_uniform_staging_buffer.size()));
 
     g_gfx->SetViewportAndScissor(g_gfx->ConvertFramebufferRectangle(
         m_intermediary_color_texture->GetRect(), m_intermediary_frame_buffer.get()));
@@ -554,30 +688,18 @@ void PostProcessing::BlitFromTexture(const MathUtil::Rectangle<int>& dst,
     g_gfx->SetFramebuffer(previous_framebuffer);
     src_rect = m_intermediary_color_texture->GetRect();
     src_tex = m_intermediary_color_texture.get();
-    g_gfx->SetTexture(0, src_tex);
-    g_gfx->SetTexture(1, src_tex);
     // The "m_intermediary_color_texture" has already copied
     // from the specified source layer onto its first one.
     // If we query for a layer that the source texture doesn't have,
     // it will fall back on the first one anyway.
     src_layer = 0;
-    uniform_staging_buffer = &m_uniform_staging_buffer;
-    default_uniform_staging_buffer = false;
   }
   else
   {
     // If we have no custom user shader selected, and color correction
     // is active, directly run the fixed pipeline shader instead of
     // doing two passes, with the second one doing nothing useful.
-    if (m_default_pipeline && needs_default_pipeline)
-    {
-      final_pipeline = m_default_pipeline.get();
-    }
-    else
-    {
-      uniform_staging_buffer = &m_uniform_staging_buffer;
-      default_uniform_staging_buffer = false;
-    }
+    default_pipeline_is_final = m_default_pipeline && needs_default_pipeline;
 
     m_intermediary_frame_buffer.release();
     m_intermediary_color_texture.release();
@@ -588,18 +710,113 @@ void PostProcessing::BlitFromTexture(const MathUtil::Rectangle<int>& dst,
   // space), though that would break the look of some of current post processes we have, and thus is
   // better avoided for now.
 
-  // Final pass, either a user selected shader or the default (fixed) shader.
-  if (final_pipeline)
+  // Final pass, either the default (fixed) shader or the passes of a user selected shader.
+  if (default_pipeline_is_final)
   {
-    FillUniformBuffer(src_rect, src_tex, src_layer, g_gfx->GetCurrentFramebuffer()->GetRect(),
-                      present_rect, uniform_staging_buffer->data(), !default_uniform_staging_buffer,
-                      false);
-    g_vertex_manager->UploadUtilityUniforms(uniform_staging_buffer->data(),
-                                            static_cast<u32>(uniform_staging_buffer->size()));
+    const PassInput source = {src_tex, src_rect, src_layer};
+    FillUniformBuffer(source, source, g_gfx->GetCurrentFramebuffer()->GetRect(), present_rect,
+                      m_default_uniform_staging_buffer.data(), false, false);
+    g_vertex_manager->UploadUtilityUniforms(
+        m_default_uniform_staging_buffer.data(),
+        static_cast<u32>(m_default_uniform_staging_buffer.size()));
 
     g_gfx->SetViewportAndScissor(
         g_gfx->ConvertFramebufferRectangle(dst, g_gfx->GetCurrentFramebuffer()));
-    g_gfx->SetPipeline(final_pipeline);
+    g_gfx->SetPipeline(m_default_pipeline.get());
+    g_gfx->Draw(0, 3);
+  }
+  else
+  {
+    DrawPasses(dst, {src_tex, src_rect, src_layer}, present_rect, target_layers);
+  }
+}
+
+void PostProcessing::UpdatePassTargets(const MathUtil::Rectangle<int>& dst, u32 layers)
+{
+  const std::vector<float>& target_scales = m_config.GetTargetScales();
+  m_pass_targets.resize(target_scales.size());
+  for (size_t i = 0; i < target_scales.size(); ++i)
+  {
+    const u32 width =
+        static_cast<u32>(std::max(std::lround(dst.GetWidth() * target_scales[i]), 1L));
+    const u32 height =
+        static_cast<u32>(std::max(std::lround(dst.GetHeight() * target_scales[i]), 1L));
+
+    PassTarget& target = m_pass_targets[i];
+    if (target.framebuffer && target.texture->GetWidth() == width &&
+        target.texture->GetHeight() == height && target.texture->GetLayers() == layers)
+    {
+      continue;
+    }
+
+    target.framebuffer.reset();
+    target.texture = g_gfx->CreateTexture(
+        TextureConfig(width, height, 1, layers, 1, s_intermediary_buffer_format,
+                      AbstractTextureFlag_RenderTarget),
+        fmt::format("Post-processing pass target {}", i));
+    if (target.texture)
+      target.framebuffer = g_gfx->CreateFramebuffer(target.texture.get(), nullptr);
+  }
+}
+
+void PostProcessing::DrawPasses(const MathUtil::Rectangle<int>& dst, const PassInput& color_buffer,
+                                const MathUtil::Rectangle<int>& wnd, u32 target_layers)
+{
+  const std::vector<PostProcessingPass>& passes = m_config.GetPasses();
+  if (m_pipelines.size() != passes.size())
+    return;
+
+  // The intermediate targets are sized after the part of the final framebuffer that is drawn to
+  UpdatePassTargets(dst, target_layers);
+  if (std::any_of(m_pass_targets.begin(), m_pass_targets.end(),
+                  [](const PassTarget& target) { return !target.framebuffer; }))
+  {
+    return;
+  }
+
+  AbstractFramebuffer* const final_framebuffer = g_gfx->GetCurrentFramebuffer();
+  for (size_t i = 0; i < passes.size(); ++i)
+  {
+    const PostProcessingPass& pass = passes[i];
+    AbstractFramebuffer* const framebuffer =
+        pass.target ? m_pass_targets[*pass.target].framebuffer.get() : final_framebuffer;
+    if (pass.target)
+      g_gfx->UnbindTexture(m_pass_targets[*pass.target].texture.get());
+    g_gfx->SetFramebuffer(framebuffer);
+
+    // The first input is bound to both samp0 and samp1, like a single pass shader's source
+    PassInput first_input = color_buffer;
+    for (size_t j = 0; j < pass.input_targets.size(); ++j)
+    {
+      const std::optional<u32>& input_target = pass.input_targets[j];
+      const PassInput input =
+          input_target ? PassInput{m_pass_targets[*input_target].texture.get(),
+                                   m_pass_targets[*input_target].texture->GetRect(), 0} :
+                         color_buffer;
+      if (j == 0)
+      {
+        first_input = input;
+        g_gfx->SetTexture(0, input.texture);
+        g_gfx->SetTexture(1, input.texture);
+        g_gfx->SetSamplerState(0, RenderState::GetLinearSamplerState());
+        g_gfx->SetSamplerState(1, RenderState::GetPointSamplerState());
+      }
+      else
+      {
+        g_gfx->SetTexture(static_cast<u32>(j + 1), input.texture);
+        g_gfx->SetSamplerState(static_cast<u32>(j + 1), RenderState::GetLinearSamplerState());
+      }
+    }
+
+    const MathUtil::Rectangle<int> target_rect = framebuffer->GetRect();
+    FillUniformBuffer(first_input, color_buffer, target_rect, wnd, m_uniform_staging_buffer.data(),
+                      true, pass.target.has_value());
+    g_vertex_manager->UploadUtilityUniforms(m_uniform_staging_buffer.data(),
+                                            static_cast<u32>(m_uniform_staging_buffer.size()));
+
+    g_gfx->SetViewportAndScissor(
+        g_gfx->ConvertFramebufferRectangle(pass.target ? target_rect : dst, framebuffer));
+    g_gfx->SetPipeline(m_pipelines[i].get());
     g_gfx->Draw(0, 3);
   }
 }
@@ -618,8 +835,11 @@ std::string PostProcessing::GetUniformBufferHeader(bool user_post_process) const
   // How many horizontal and vertical stereo views do we have? (set to 1 when we use layers instead)
   ss << "  int2 stereo_views;\n";
   ss << "  float4 src_rect;\n";
+  // The image that is post-processed, which passes might read besides their first input
+  ss << "  float4 color_buffer_rect;\n";
   // The first (but not necessarily only) source layer we target
   ss << "  int src_layer;\n";
+  ss << "  int color_buffer_layer;\n";
   ss << "  uint time;\n";
   ss << "  int graphics_api;\n";
   // If true, it's an intermediary buffer (including the first), if false, it's the final one
@@ -764,6 +984,35 @@ void SetOutput(float4 color)
   return ss.str();
 }
 
+std::string PostProcessing::GetPassHeader(const PostProcessingPass& pass) const
+{
+  std::ostringstream ss;
+  for (size_t i = 1; i < pass.input_targets.size(); ++i)
+    ss << fmt::format("SAMPLER_BINDING({}) uniform sampler2DArray samp{};\n", i + 1, i + 1);
+
+  // The other inputs are sampled at the same part of the image as the first one. Only the color
+  // buffer might not be covered by the image completely.
+  ss << R"(
+float3 GetInputLocation(float2 location, float4 rect, int layer)
+{
+  float2 image_location = (location - src_rect.xy) / src_rect.zw;
+  return float3(rect.xy + image_location * rect.zw, v_tex0.z - float(src_layer) + float(layer));
+}
+
+float4 SampleInput0(float2 location) { return SampleLocation(location); }
+)";
+  for (size_t i = 1; i < pass.input_targets.size(); ++i)
+  {
+    ss << fmt::format("float4 SampleInput{}(float2 location) {{ return texture(samp{}, {}); }}\n",
+                      i, i + 1,
+                      pass.input_targets[i] ?
+                          "GetInputLocation(location, float4(0.0, 0.0, 1.0, 1.0), 0)" :
+                          "GetInputLocation(location, color_buffer_rect, color_buffer_layer)");
+  }
+  ss << "\n";
+  return ss.str();
+}
+
 std::string PostProcessing::GetFooter() const
 {
   return {};
@@ -840,7 +1089,9 @@ struct BuiltinUniforms
   std::array<float, 4> window_resolution;
   std::array<float, 4> stereo_views;
   std::array<float, 4> src_rect;
+  std::array<float, 4> color_buffer_rect;
   s32 src_layer;
+  s32 color_buffer_layer;
   u32 time;
   s32 graphics_api;
   s32 intermediary_buffer;
@@ -864,12 +1115,22 @@ size_t PostProcessing::CalculateUniformsSize(bool user_post_process) const
          (user_post_process ? m_config.GetOptions().size() : 0) * sizeof(float) * 4;
 }
 
-void PostProcessing::FillUniformBuffer(const MathUtil::Rectangle<int>& src,
-                                       const AbstractTexture* src_tex, int src_layer,
+static std::array<float, 4> GetNormalizedRect(const MathUtil::Rectangle<int>& rect,
+                                              const AbstractTexture* texture)
+{
+  const float rcp_width = 1.0f / texture->GetWidth();
+  const float rcp_height = 1.0f / texture->GetHeight();
+  return {static_cast<float>(rect.left) * rcp_width, static_cast<float>(rect.top) * rcp_height,
+          static_cast<float>(rect.GetWidth()) * rcp_width,
+          static_cast<float>(rect.GetHeight()) * rcp_height};
+}
+
+void PostProcessing::FillUniformBuffer(const PassInput& src, const PassInput& color_buffer,
                                        const MathUtil::Rectangle<int>& dst,
                                        const MathUtil::Rectangle<int>& wnd, u8* buffer,
                                        bool user_post_process, bool intermediary_buffer)
 {
+  const AbstractTexture* const src_tex = src.texture;
   const float rcp_src_width = 1.0f / src_tex->GetWidth();
   const float rcp_src_height = 1.0f / src_tex->GetHeight();
 
@@ -883,11 +1144,10 @@ void PostProcessing::FillUniformBuffer(const MathUtil::Rectangle<int>& src,
   builtin_uniforms.window_resolution = {
       static_cast<float>(wnd.GetWidth()), static_cast<float>(wnd.GetHeight()),
       1.0f / static_cast<float>(wnd.GetWidth()), 1.0f / static_cast<float>(wnd.GetHeight())};
-  builtin_uniforms.src_rect = {static_cast<float>(src.left) * rcp_src_width,
-                               static_cast<float>(src.top) * rcp_src_height,
-                               static_cast<float>(src.GetWidth()) * rcp_src_width,
-                               static_cast<float>(src.GetHeight()) * rcp_src_height};
-  builtin_uniforms.src_layer = static_cast<s32>(src_layer);
+  builtin_uniforms.src_rect = GetNormalizedRect(src.rect, src_tex);
+  builtin_uniforms.color_buffer_rect = GetNormalizedRect(color_buffer.rect, color_buffer.texture);
+  builtin_uniforms.src_layer = static_cast<s32>(src.layer);
+  builtin_uniforms.color_buffer_layer = static_cast<s32>(color_buffer.layer);
   builtin_uniforms.time = static_cast<u32>(m_timer.ElapsedMs());
   builtin_uniforms.graphics_api = static_cast<s32>(g_ActiveConfig.backend_info.api_type);
   builtin_uniforms.intermediary_buffer = static_cast<s32>(intermediary_buffer);
@@ -960,7 +1220,7 @@ void PostProcessing::FillUniformBuffer(const MathUtil::Rectangle<int>& src,
 bool PostProcessing::CompilePixelShader()
 {
   m_default_pixel_shader.reset();
-  m_pixel_shader.reset();
+  m_pixel_shaders.clear();
 
   // Generate GLSL and compile the new shaders:
 
@@ -978,20 +1238,36 @@ bool PostProcessing::CompilePixelShader()
     m_default_uniform_staging_buffer.resize(0);
   }
 
+  // Every pass has a shader of its own, with its entry point as the main()
+  const auto compile_passes = [this] {
+    const std::vector<PostProcessingPass>& passes = m_config.GetPasses();
+    for (size_t i = 0; i < passes.size(); ++i)
+    {
+      std::string code = GetHeader(true) + GetPassHeader(passes[i]) + m_config.GetShaderCode();
+      if (passes[i].entry_point != "main")
+        code += fmt::format("\nvoid main() {{ {}(); }}\n", passes[i].entry_point);
+
+      std::unique_ptr<AbstractShader> shader = g_gfx->CreateShaderFromSource(
+          ShaderStage::Pixel, code + GetFooter(),
+          fmt::format("User post-processing pixel shader: {} pass {}", m_config.GetShader(), i));
+      if (!shader)
+      {
+        m_pixel_shaders.clear();
+        return false;
+      }
+      m_pixel_shaders.push_back(std::move(shader));
+    }
+    return true;
+  };
+
   m_config.LoadShader(g_ActiveConfig.sPostProcessingShader);
-  m_pixel_shader = g_gfx->CreateShaderFromSource(
-      ShaderStage::Pixel, GetHeader(true) + m_config.GetShaderCode() + GetFooter(),
-      fmt::format("User post-processing pixel shader: {}", m_config.GetShader()));
-  if (!m_pixel_shader)
+  if (!compile_passes())
   {
     PanicAlertFmt("Failed to compile user post-processing shader {}", m_config.GetShader());
 
     // Use default shader.
     m_config.LoadDefaultShader();
-    m_pixel_shader = g_gfx->CreateShaderFromSource(
-        ShaderStage::Pixel, GetHeader(true) + m_config.GetShaderCode() + GetFooter(),
-        "Default user post-processing pixel shader");
-    if (!m_pixel_shader)
+    if (!compile_passes())
     {
       m_uniform_staging_buffer.resize(0);
       return false;
@@ -1051,16 +1327,30 @@ bool PostProcessing::CompilePipeline()
   if (config.pixel_shader)
     m_default_pipeline = g_gfx->CreatePipeline(config);
 
-  config.vertex_shader = m_vertex_shader.get();
-  config.geometry_shader = UseGeometryShaderForPostProcess(false) ?
-                               g_shader_cache->GetTexcoordGeometryShader() :
-                               nullptr;
-  config.pixel_shader = m_pixel_shader.get();
-  config.framebuffer_state = RenderState::GetColorFramebufferState(m_framebuffer_format);
-  m_pipeline = g_gfx->CreatePipeline(config);
-  if (!m_pipeline)
+  // The passes that render to intermediate targets handle the layers like the intermediary buffer
+  const std::vector<PostProcessingPass>& passes = m_config.GetPasses();
+  if (m_pixel_shaders.size() != passes.size())
     return false;
 
+  config.vertex_shader = m_vertex_shader.get();
+  for (size_t i = 0; i < passes.size(); ++i)
+  {
+    const bool is_intermediary_buffer = passes[i].target.has_value();
+    config.geometry_shader = UseGeometryShaderForPostProcess(is_intermediary_buffer) ?
+                                 g_shader_cache->GetTexcoordGeometryShader() :
+                                 nullptr;
+    config.pixel_shader = m_pixel_shaders[i].get();
+    config.framebuffer_state = RenderState::GetColorFramebufferState(
+        is_intermediary_buffer ? s_intermediary_buffer_format : m_framebuffer_format);
+    std::unique_ptr<AbstractPipeline> pipeline = g_gfx->CreatePipeline(config);
+    if (!pipeline)
+    {
+      m_pipelines.clear();
+      return false;
+    }
+    m_pipelines.push_back(std::move(pipeline));
+  }
+
   return true;
 }
 }  // namespace VideoCommon
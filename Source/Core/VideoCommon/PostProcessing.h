@@ -5,7 +5,9 @@
 
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "Common/CommonTypes.h"
@@ -20,6 +22,36 @@ class AbstractFramebuffer;
 
 namespace VideoCommon
 {
+// A pass of a user shader. Shaders that don't declare any passes, with [Pass] sections in their
+// configuration, have a single one that runs their main().
+struct PostProcessingPass
+{
+  // What passes read to sample the image that is post-processed
+  static constexpr std::string_view COLOR_BUFFER_INPUT = "ColorBuffer";
+  // Sampled by samp0 (and samp1), and the following ones by samp2 onwards
+  static constexpr size_t MAX_INPUTS = 4;
+
+  // Function that is the main() of the pass
+  std::string entry_point = "main";
+  // Either COLOR_BUFFER_INPUT or the output of an earlier pass
+  std::vector<std::string> inputs = {std::string(COLOR_BUFFER_INPUT)};
+  // Name that later passes read the output by. The last pass outputs the final image instead.
+  std::string output;
+  // Size of the output relative to the final image
+  float output_scale = 1.0f;
+
+  // Set by SchedulePostProcessingPasses(). The intermediate targets that the inputs are read from
+  // (none for the color buffer), and the one that the pass renders to (none for the final image).
+  std::vector<std::optional<u32>> input_targets = {std::nullopt};
+  std::optional<u32> target;
+};
+
+// Assigns the outputs of the passes to intermediate targets, and resolves the inputs to them. A
+// target is reused by later outputs of the same scale once nothing reads what it holds anymore.
+// Returns the scale of each target, or nothing if an input isn't the output of an earlier pass.
+std::optional<std::vector<float>> SchedulePostProcessingPasses(
+    std::vector<PostProcessingPass>* passes);
+
 class PostProcessingConfiguration
 {
 public:
@@ -74,6 +106,8 @@ public:
   const ConfigMap& GetOptions() const { return m_options; }
   ConfigMap& GetOptions() { return m_options; }
   const ConfigurationOption& GetOption(const std::string& option) { return m_options[option]; }
+  const std::vector<PostProcessingPass>& GetPasses() const { return m_passes; }
+  const std::vector<float>& GetTargetScales() const { return m_target_scales; }
   // For updating option's values
   void SetOptionf(const std::string& option, int index, float value);
   void SetOptioni(const std::string& option, int index, s32 value);
@@ -84,6 +118,8 @@ private:
   std::string m_current_shader;
   std::string m_current_shader_code;
   ConfigMap m_options;
+  std::vector<PostProcessingPass> m_passes = std::vector<PostProcessingPass>(1);
+  std::vector<float> m_target_scales;
 
   void LoadOptions(const std::string& code);
   void LoadOptionsConfiguration();
@@ -113,8 +149,24 @@ public:
   bool NeedsIntermediaryBuffer() const;
 
 protected:
+  // A texture that a pass samples
+  struct PassInput
+  {
+    const AbstractTexture* texture;
+    MathUtil::Rectangle<int> rect;
+    int layer;
+  };
+
+  // An intermediate target of the user shader's passes
+  struct PassTarget
+  {
+    std::unique_ptr<AbstractTexture> texture;
+    std::unique_ptr<AbstractFramebuffer> framebuffer;
+  };
+
   std::string GetUniformBufferHeader(bool user_post_process) const;
   std::string GetHeader(bool user_post_process) const;
+  std::string GetPassHeader(const PostProcessingPass& pass) const;
   std::string GetFooter() const;
 
   bool CompileVertexShader();
@@ -122,10 +174,13 @@ protected:
   bool CompilePipeline();
 
   size_t CalculateUniformsSize(bool user_post_process) const;
-  void FillUniformBuffer(const MathUtil::Rectangle<int>& src, const AbstractTexture* src_tex,
-                         int src_layer, const MathUtil::Rectangle<int>& dst,
-                         const MathUtil::Rectangle<int>& wnd, u8* buffer, bool user_post_process,
-                         bool intermediary_buffer);
+  void FillUniformBuffer(const PassInput& src, const PassInput& color_buffer,
+                         const MathUtil::Rectangle<int>& dst, const MathUtil::Rectangle<int>& wnd,
+                         u8* buffer, bool user_post_process, bool intermediary_buffer);
+
+  void UpdatePassTargets(const MathUtil::Rectangle<int>& dst, u32 layers);
+  void DrawPasses(const MathUtil::Rectangle<int>& dst, const PassInput& color_buffer,
+                  const MathUtil::Rectangle<int>& wnd, u32 target_layers);
 
   // Timer for determining our time value
   Common::Timer m_timer;
@@ -141,8 +196,10 @@ protected:
   // User post process:
   PostProcessingConfiguration m_config;
   std::unique_ptr<AbstractShader> m_vertex_shader;
-  std::unique_ptr<AbstractShader> m_pixel_shader;
-  std::unique_ptr<AbstractPipeline> m_pipeline;
+  // One of each for every pass
+  std::vector<std::unique_ptr<AbstractShader>> m_pixel_shaders;
+  std::vector<std::unique_ptr<AbstractPipeline>> m_pipelines;
+  std::vector<PassTarget> m_pass_targets;
   std::vector<u8> m_uniform_staging_buffer;
 
   AbstractTextureFormat m_framebuffer_format = AbstractTextureFormat::Undefined;
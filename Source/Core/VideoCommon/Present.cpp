@@ -4,6 +4,8 @@
 #include "VideoCommon/Present.h"
 
 #include "Common/ChunkFile.h"
+#include "Common/Counters.h"
+#include "Common/TraceEvents.h"
 #include "Core/HW/VideoInterface.h"
 #include "Core/Host.h"
 #include "Core/System.h"
@@ -13,6 +15,9 @@
 #include "Present.h"
 #include "VideoCommon/AbstractGfx.h"
 #include "VideoCommon/FrameDumper.h"
+#include "VideoCommon/FramePacer.h"
+#include "VideoCommon/FrameProfiler.h"
+#include "VideoCommon/OnScreenDisplay.h"
 #include "VideoCommon/OnScreenUI.h"
 #include "VideoCommon/PostProcessing.h"
 #include "VideoCommon/Statistics.h"
@@ -26,6 +31,11 @@ std::unique_ptr<VideoCommon::Presenter> g_presenter;
 // The video encoder needs the image to be a multiple of x samples.
 static constexpr int VIDEO_ENCODER_LCM = 4;
 
+static Common::Counter s_duplicate_xfbs("dolphin_duplicate_xfbs_total",
+                                        "Fields that scanned out the previous XFB again");
+static Common::Counter s_skipped_duplicate_xfbs("dolphin_duplicate_xfbs_skipped_total",
+                                                "Duplicate fields that weren't presented");
+
 namespace VideoCommon
 {
 static float AspectToWidescreen(float aspect)
@@ -141,6 +151,8 @@ void Presenter::ViSwap(u32 xfb_addr, u32 fb_width, u32 fb_stride, u32 fb_height,
   {
     present_info.frame_count = m_frame_count - 1;  // Previous frame
     present_info.reason = PresentInfo::PresentReason::VideoInterfaceDuplicate;
+    INCSTAT(g_stats.num_duplicate_xfbs);
+    s_duplicate_xfbs.Add();
   }
   else
   {
@@ -149,14 +161,21 @@ void Presenter::ViSwap(u32 xfb_addr, u32 fb_width, u32 fb_stride, u32 fb_height,
   }
 
   BeforePresentEvent::Trigger(present_info);
+  OSD::SetFrameTicks(ticks, g_frame_dumper->IsFrameDumping());
 
-  if (!is_duplicate || !g_ActiveConfig.bSkipPresentingDuplicateXFBs)
+  if ((!is_duplicate || !g_ActiveConfig.bSkipPresentingDuplicateXFBs) &&
+      !m_skip_presenting.IsSet())
   {
     Present();
     ProcessFrameDumping(ticks);
 
     AfterPresentEvent::Trigger(present_info);
   }
+  else if (is_duplicate)
+  {
+    INCSTAT(g_stats.num_duplicate_xfbs_skipped);
+    s_skipped_duplicate_xfbs.Add();
+  }
 }
 
 void Presenter::ImmediateSwap(u32 xfb_addr, u32 fb_width, u32 fb_stride, u32 fb_height, u64 ticks)
@@ -170,6 +189,7 @@ void Presenter::ImmediateSwap(u32 xfb_addr, u32 fb_width, u32 fb_stride, u32 fb_
   present_info.present_count = m_present_count++;
 
   BeforePresentEvent::Trigger(present_info);
+  OSD::SetFrameTicks(ticks, g_frame_dumper->IsFrameDumping());
 
   Present();
   ProcessFrameDumping(ticks);
@@ -194,8 +214,21 @@ void Presenter::ProcessFrameDumping(u64 ticks) const
       target_rect = MathUtil::Rectangle<int>(0, 0, width, height);
     }
 
+    // Subtitles are burnt into the dumped frame, at the size they have relative to the game
+    FrameDumper::FrameOverlay overlay;
+    if (m_onscreen_ui && g_gfx->SupportsUtilityDrawing() && OSD::HasBurnInMessages())
+    {
+      const int screen_height = GetTargetRectangle().GetHeight();
+      const float scale = screen_height > 0 && !g_gfx->IsHeadless() ?
+                              static_cast<float>(target_rect.GetHeight()) / screen_height :
+                              1.0f;
+      overlay = [this, scale](AbstractFramebuffer* framebuffer) {
+        m_onscreen_ui->DrawBurnInMessages(framebuffer, scale);
+      };
+    }
+
     g_frame_dumper->DumpCurrentFrame(m_xfb_entry->texture.get(), m_xfb_rect, target_rect, ticks,
-                                     m_frame_count);
+                                     m_frame_count, overlay);
   }
 }
 
@@ -638,6 +671,11 @@ void Presenter::RenderXFBToScreen(const MathUtil::Rectangle<int>& target_rc,
 
 void Presenter::Present()
 {
+  FrameProfiler::Scope profile_scope(FrameProfiler::Stage::Present);
+  TRACE_SCOPE("Present");
+
+  const TimePoint present_start = Clock::now();
+
   m_present_count++;
 
   if (g_gfx->IsHeadless() || (!m_onscreen_ui && !m_xfb_entry))
@@ -666,7 +704,11 @@ void Presenter::Present()
   UpdateDrawRectangle();
 
   g_gfx->BeginUtilityDrawing();
+
+  // Acquiring the backbuffer and presenting it are where the backends wait for the display.
+  TimePoint wait_start = Clock::now();
   g_gfx->BindBackbuffer({{0.0f, 0.0f, 0.0f, 1.0f}});
+  DT wait = Clock::now() - wait_start;
 
   // Render the XFB to the screen.
   if (m_xfb_entry)
@@ -688,9 +730,15 @@ void Presenter::Present()
   // Present to the window system.
   {
     std::lock_guard<std::mutex> guard(m_swap_mutex);
+    wait_start = Clock::now();
     g_gfx->PresentBackbuffer();
   }
 
+  const TimePoint present_end = Clock::now();
+  wait += present_end - wait_start;
+  g_frame_pacer.AddPresent(present_end - present_start, wait,
+                           g_ActiveConfig.bFramePacing && g_ActiveConfig.bVSyncActive);
+
   if (m_xfb_entry)
   {
     // Update the window size based on the frame that was just rendered.
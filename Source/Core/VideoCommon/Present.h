@@ -42,6 +42,10 @@ public:
   void Present();
   void ClearLastXfbId() { m_last_xfb_id = std::numeric_limits<u64>::max(); }
 
+  // Skips presenting the fields of the video interface, used while the emulation catches up after
+  // a NetPlay rollback
+  void SetSkipPresenting(bool skip) { m_skip_presenting.Set(skip); }
+
   bool Initialize();
 
   void ConfigChanged(u32 changed_bits);
@@ -125,6 +129,7 @@ private:
   void* m_new_surface_handle = nullptr;
   Common::Flag m_surface_changed;
   Common::Flag m_surface_resized;
+  Common::Flag m_skip_presenting;
 
   MathUtil::Rectangle<int> m_target_rectangle = {};
 
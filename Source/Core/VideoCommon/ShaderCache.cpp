@@ -3,6 +3,11 @@
 
 #include "VideoCommon/ShaderCache.h"
 
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+
 #include <fmt/format.h>
 
 #include "Common/Assert.h"
@@ -15,7 +20,9 @@
 #include "VideoCommon/DriverDetails.h"
 #include "VideoCommon/FramebufferManager.h"
 #include "VideoCommon/FramebufferShaderGen.h"
+#include "VideoCommon/PerformanceMetrics.h"
 #include "VideoCommon/Present.h"
+#include "VideoCommon/SharedPipelineUIDCache.h"
 #include "VideoCommon/Statistics.h"
 #include "VideoCommon/VertexLoaderManager.h"
 #include "VideoCommon/VertexManagerBase.h"
@@ -46,6 +53,7 @@ bool ShaderCache::Initialize()
     return false;
 
   m_async_shader_compiler = g_gfx->CreateAsyncShaderCompiler();
+  m_async_shader_compiler->SetSpeculativePriority(COMPILE_PRIORITY_SHADERCACHE_PIPELINE);
   m_frame_end_handler =
       AfterFrameEvent::Register([this] { RetrieveAsyncShaders(); }, "RetreiveAsyncShaders");
   return true;
@@ -102,6 +110,31 @@ void ShaderCache::Reload()
 void ShaderCache::RetrieveAsyncShaders()
 {
   m_async_shader_compiler->RetrieveWorkItems();
+  UpdateSpeculativeCompileWorkers();
+}
+
+AsyncShaderCompiler::Stats ShaderCache::GetAsyncCompilerStats() const
+{
+  return m_async_shader_compiler->GetStats();
+}
+
+void ShaderCache::UpdateSpeculativeCompileWorkers()
+{
+  const u32 num_workers = m_async_shader_compiler->GetWorkerThreadCount();
+  if (num_workers == 0)
+    return;
+
+  // Max speed is how fast emulation could run without throttling. Without headroom above full
+  // speed the host CPU is saturated, and speculative compiles are left to a single worker.
+  const double max_speed = g_perf_metrics.GetMaxSpeed();
+  const double headroom = std::isfinite(max_speed) ? std::clamp(max_speed - 1.0, 0.0, 1.0) : 1.0;
+  u32 max_workers = std::max(1u, static_cast<u32>(std::lround(num_workers * headroom)));
+
+  // Keep a worker free for the pipelines that were missed while drawing this frame
+  if (m_async_shader_compiler->TakeQueuedDeadlineWork() && num_workers > 1)
+    max_workers = std::min(max_workers, num_workers - 1);
+
+  m_async_shader_compiler->SetMaxSpeculativeWorkers(max_workers);
 }
 
 void ShaderCache::Shutdown()
@@ -116,6 +149,9 @@ void ShaderCache::Shutdown()
 
 const AbstractPipeline* ShaderCache::GetPipelineForUid(const GXPipelineUid& uid)
 {
+  if (!m_shared_only_pipeline_uids.empty()) [[unlikely]]
+    RecordSharedPipelineUse(uid);
+
   auto it = m_gx_pipeline_cache.find(uid);
   if (it != m_gx_pipeline_cache.end() && !it->second.second)
     return it->second.first.get();
@@ -132,14 +168,19 @@ const AbstractPipeline* ShaderCache::GetPipelineForUid(const GXPipelineUid& uid)
 
 std::optional<const AbstractPipeline*> ShaderCache::GetPipelineForUidAsync(const GXPipelineUid& uid)
 {
+  if (!m_shared_only_pipeline_uids.empty()) [[unlikely]]
+    RecordSharedPipelineUse(uid);
+
   auto it = m_gx_pipeline_cache.find(uid);
   if (it != m_gx_pipeline_cache.end())
   {
     // .second is the pending flag, i.e. compiling in the background.
     if (!it->second.second)
       return it->second.first.get();
-    else
-      return {};
+
+    if (!m_speculative_pipeline_work.empty())
+      PromotePipelineCompile(uid);
+    return {};
   }
 
   AppendGXPipelineUID(uid);
@@ -160,6 +201,74 @@ const AbstractPipeline* ShaderCache::GetUberPipelineForUid(const GXUberPipelineU
   return InsertGXUberPipeline(uid, std::move(pipeline));
 }
 
+// The cost of drawing with a partially specialized ubershader, lower is faster
+static u32 GetUberPipelineVariantCost(const UberShader::PixelShaderUid& ps_uid)
+{
+  const UberShader::pixel_ubershader_uid_data* const uid_data = ps_uid.GetUidData();
+  const u32 max_stages = uid_data->max_tev_stages != 0 ? uid_data->max_tev_stages : 16;
+  return max_stages * 4 + (uid_data->no_indirect ? 0 : 2) + (uid_data->no_fog ? 0 : 1);
+}
+
+const AbstractPipeline* ShaderCache::GetPartialUberPipelineForUid(const GXUberPipelineUid& uid)
+{
+  GXUberPipelineUid generic_uid = uid;
+  generic_uid.ps_uid = UberShader::ClearPartialSpecializationBits(uid.ps_uid);
+
+  const AbstractPipeline* best_pipeline = nullptr;
+  u32 best_cost = 0;
+  std::vector<GXUberPipelineUid>& variants = m_uber_pipeline_variants[generic_uid];
+  for (const GXUberPipelineUid& variant : variants)
+  {
+    if (!UberShader::PixelShaderCovers(variant.ps_uid, uid.ps_uid))
+      continue;
+
+    const auto it = m_gx_uber_pipeline_cache.find(variant);
+    if (it == m_gx_uber_pipeline_cache.end() || it->second.second || !it->second.first)
+      continue;
+
+    const u32 cost = GetUberPipelineVariantCost(variant.ps_uid);
+    if (!best_pipeline || cost < best_cost)
+    {
+      best_pipeline = it->second.first.get();
+      best_cost = cost;
+    }
+  }
+
+  // Group draws into a handful of variants by rounding the stage count up to a power of two
+  GXUberPipelineUid variant_uid = uid;
+  UberShader::pixel_ubershader_uid_data* const variant_data = variant_uid.ps_uid.GetUidData();
+  if (variant_data->max_tev_stages != 0)
+    variant_data->max_tev_stages = std::bit_ceil(variant_data->max_tev_stages) & 0xF;
+
+  if (UberShader::IsPartiallySpecialized(variant_uid.ps_uid) &&
+      variants.size() < MAX_UBER_PIPELINE_VARIANTS &&
+      (!best_pipeline || GetUberPipelineVariantCost(variant_uid.ps_uid) < best_cost) &&
+      std::find(variants.begin(), variants.end(), variant_uid) == variants.end() &&
+      ++m_uber_pipeline_variant_uses[variant_uid] >= UBER_PIPELINE_VARIANT_MIN_USES)
+  {
+    m_uber_pipeline_variant_uses.erase(variant_uid);
+    variants.push_back(variant_uid);
+    QueueUberPipelineCompile(variant_uid, COMPILE_PRIORITY_UBERSHADER_PIPELINE);
+  }
+
+  return best_pipeline ? best_pipeline : GetUberPipelineForUid(generic_uid);
+}
+
+void ShaderCache::RegisterUberPipelineVariants()
+{
+  for (const auto& [uid, pipeline] : m_gx_uber_pipeline_cache)
+  {
+    if (!UberShader::IsPartiallySpecialized(uid.ps_uid))
+      continue;
+
+    GXUberPipelineUid generic_uid = uid;
+    generic_uid.ps_uid = UberShader::ClearPartialSpecializationBits(uid.ps_uid);
+    std::vector<GXUberPipelineUid>& variants = m_uber_pipeline_variants[generic_uid];
+    if (std::find(variants.begin(), variants.end(), uid) == variants.end())
+      variants.push_back(uid);
+  }
+}
+
 void ShaderCache::WaitForAsyncCompiler()
 {
   bool running = true;
@@ -284,6 +393,8 @@ void ShaderCache::LoadPipelineCache(T& cache, Common::LinearDiskCache<DiskKeyTyp
   public:
     CacheReader(ShaderCache* this_ptr_, T& cache_) : this_ptr(this_ptr_), cache(cache_) {}
     bool AnyFailed() const { return failed; }
+    void SetFailed() { failed = true; }
+    const std::vector<KeyType>& GetLoadedUids() const { return loaded_uids; }
     void Read(const DiskKeyType& key, const u8* value, u32 value_size) override
     {
       KeyType real_uid;
@@ -308,11 +419,13 @@ void ShaderCache::LoadPipelineCache(T& cache, Common::LinearDiskCache<DiskKeyTyp
       auto& entry = cache[real_uid];
       entry.first = std::move(pipeline);
       entry.second = false;
+      loaded_uids.push_back(real_uid);
     }
 
   private:
     ShaderCache* this_ptr;
     T& cache;
+    std::vector<KeyType> loaded_uids;
     bool failed = false;
   };
 
@@ -321,6 +434,18 @@ void ShaderCache::LoadPipelineCache(T& cache, Common::LinearDiskCache<DiskKeyTyp
   const u32 count = disk_cache.OpenAndRead(filename, reader);
   INFO_LOG_FMT(VIDEO, "Loaded {} cached pipelines from {}", count, filename);
 
+  // Only wait for the driver once all of the pipelines have been handed to it, so that it can
+  // create them in parallel. The ones which failed are compiled again when they are used.
+  for (const KeyType& uid : reader.GetLoadedUids())
+  {
+    auto iter = cache.find(uid);
+    if (iter == cache.end() || iter->second.first->FinishCreation())
+      continue;
+
+    cache.erase(iter);
+    reader.SetFailed();
+  }
+
   // If any of the pipelines in the cache failed to create, it's likely because of a change of
   // driver version, or system configuration. In this case, when the UID cache picks up the pipeline
   // later on, we'll write a duplicate entry to the pipeline cache. There's also no point in keeping
@@ -378,17 +503,21 @@ void ShaderCache::LoadCaches()
     LoadPipelineCache<GXUberPipelineUid, SerializedGXUberPipelineUid>(
         m_gx_uber_pipeline_cache, m_gx_uber_pipeline_disk_cache, m_api_type, "uber-pipeline",
         false);
+    RegisterUberPipelineVariants();
   }
 }
 
 void ShaderCache::ClearCaches()
 {
   ClearPipelineCache(m_gx_pipeline_cache, m_gx_pipeline_disk_cache);
+  m_speculative_pipeline_work.clear();
   ClearShaderCache(m_vs_cache);
   ClearShaderCache(m_gs_cache);
   ClearShaderCache(m_ps_cache);
 
   ClearPipelineCache(m_gx_uber_pipeline_cache, m_gx_uber_pipeline_disk_cache);
+  m_uber_pipeline_variants.clear();
+  m_uber_pipeline_variant_uses.clear();
   ClearShaderCache(m_uber_vs_cache);
   ClearShaderCache(m_uber_ps_cache);
 
@@ -417,10 +546,19 @@ void ShaderCache::ClearCaches()
 
 void ShaderCache::CompileMissingPipelines()
 {
-  // Queue all uids with a null pipeline for compilation.
+  // Queue the uids of the UID caches in the order they are likely to be needed in first. Items of
+  // the same priority are compiled in the order they were queued in.
+  for (const GXPipelineUid& uid : m_gx_pipeline_compile_order)
+  {
+    auto it = m_gx_pipeline_cache.find(uid);
+    if (it != m_gx_pipeline_cache.end() && !it->second.first && !it->second.second)
+      QueuePipelineCompile(it->first, COMPILE_PRIORITY_SHADERCACHE_PIPELINE);
+  }
+
+  // Queue all other uids with a null pipeline for compilation.
   for (auto& it : m_gx_pipeline_cache)
   {
-    if (!it.second.first)
+    if (!it.second.first && !it.second.second)
       QueuePipelineCompile(it.first, COMPILE_PRIORITY_SHADERCACHE_PIPELINE);
   }
   for (auto& it : m_gx_uber_pipeline_cache)
@@ -430,34 +568,44 @@ void ShaderCache::CompileMissingPipelines()
   }
 }
 
+template <typename F>
+ShaderCode ShaderCache::GenerateTimed(const F& generate) const
+{
+  const auto start = std::chrono::steady_clock::now();
+  ShaderCode code = generate();
+  m_async_shader_compiler->AddCodegenTime(
+      std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+  return code;
+}
+
 std::unique_ptr<AbstractShader> ShaderCache::CompileVertexShader(const VertexShaderUid& uid) const
 {
-  const ShaderCode source_code =
-      GenerateVertexShaderCode(m_api_type, m_host_config, uid.GetUidData());
+  const ShaderCode source_code = GenerateTimed(
+      [&] { return GenerateVertexShaderCode(m_api_type, m_host_config, uid.GetUidData()); });
   return g_gfx->CreateShaderFromSource(ShaderStage::Vertex, source_code.GetBuffer());
 }
 
 std::unique_ptr<AbstractShader>
 ShaderCache::CompileVertexUberShader(const UberShader::VertexShaderUid& uid) const
 {
-  const ShaderCode source_code =
-      UberShader::GenVertexShader(m_api_type, m_host_config, uid.GetUidData());
+  const ShaderCode source_code = GenerateTimed(
+      [&] { return UberShader::GenVertexShader(m_api_type, m_host_config, uid.GetUidData()); });
   return g_gfx->CreateShaderFromSource(ShaderStage::Vertex, source_code.GetBuffer(),
                                        fmt::to_string(*uid.GetUidData()));
 }
 
 std::unique_ptr<AbstractShader> ShaderCache::CompilePixelShader(const PixelShaderUid& uid) const
 {
-  const ShaderCode source_code =
-      GeneratePixelShaderCode(m_api_type, m_host_config, uid.GetUidData(), {});
+  const ShaderCode source_code = GenerateTimed(
+      [&] { return GeneratePixelShaderCode(m_api_type, m_host_config, uid.GetUidData(), {}); });
   return g_gfx->CreateShaderFromSource(ShaderStage::Pixel, source_code.GetBuffer());
 }
 
 std::unique_ptr<AbstractShader>
 ShaderCache::CompilePixelUberShader(const UberShader::PixelShaderUid& uid) const
 {
-  const ShaderCode source_code =
-      UberShader::GenPixelShader(m_api_type, m_host_config, uid.GetUidData(), {});
+  const ShaderCode source_code = GenerateTimed(
+      [&] { return UberShader::GenPixelShader(m_api_type, m_host_config, uid.GetUidData(), {}); });
   return g_gfx->CreateShaderFromSource(ShaderStage::Pixel, source_code.GetBuffer(),
                                        fmt::to_string(*uid.GetUidData()));
 }
@@ -922,10 +1070,13 @@ ShaderCache::InsertGXUberPipeline(const GXUberPipelineUid& config,
 
 void ShaderCache::LoadPipelineUIDCache()
 {
-  constexpr u32 CACHE_FILE_MAGIC = 0x44495550;  // PUID
+  constexpr u32 CACHE_FILE_MAGIC = PIPELINE_UID_CACHE_MAGIC;
   constexpr size_t CACHE_HEADER_SIZE = sizeof(u32) + sizeof(u32);
-  std::string filename =
-      File::GetUserPath(D_CACHE_IDX) + SConfig::GetInstance().GetGameID() + ".uidcache";
+  const std::string base_filename =
+      File::GetUserPath(D_CACHE_IDX) + SConfig::GetInstance().GetGameID();
+  std::string filename = base_filename + ".uidcache";
+  m_gx_pipeline_compile_order.clear();
+  m_shared_only_pipeline_uids.clear();
   if (m_gx_pipeline_uid_cache_file.Open(filename, "rb+"))
   {
     // If an existing case exists, validate the version before reading entries.
@@ -952,7 +1103,7 @@ void ShaderCache::LoadPipelineUIDCache()
           if (m_gx_pipeline_uid_cache_file.ReadBytes(&serialized_uid, sizeof(serialized_uid)))
           {
             // This just adds the pipeline to the map, it is compiled later.
-            AddSerializedGXPipelineUID(serialized_uid);
+            m_gx_pipeline_compile_order.push_back(AddSerializedGXPipelineUID(serialized_uid));
           }
           else
           {
@@ -991,6 +1142,29 @@ void ShaderCache::LoadPipelineUIDCache()
   }
 
   INFO_LOG_FMT(VIDEO, "Read {} pipeline UIDs from {}", m_gx_pipeline_cache.size(), filename);
+
+  // Loaded after the local UIDs were rewritten above, so that they don't end up in the local
+  // cache. Otherwise merging the local caches of several machines would count them again.
+  const std::string shared_filename = base_filename + SharedPipelineUIDCacheExtension;
+  SharedPipelineUIDCache shared_cache;
+  if (File::Exists(shared_filename) && shared_cache.AddFile(shared_filename))
+  {
+    std::vector<GXPipelineUid> local_order = std::move(m_gx_pipeline_compile_order);
+    m_gx_pipeline_compile_order.clear();
+    for (const SerializedGXPipelineUid& uid : shared_cache.GetUIDsInCompileOrder())
+    {
+      GXPipelineUid real_uid;
+      UnserializePipelineUid(uid, real_uid);
+      if (!m_gx_pipeline_cache.contains(real_uid))
+        m_shared_only_pipeline_uids.insert(real_uid);
+      m_gx_pipeline_compile_order.push_back(AddSerializedGXPipelineUID(uid));
+    }
+    m_gx_pipeline_compile_order.insert(m_gx_pipeline_compile_order.end(), local_order.begin(),
+                                       local_order.end());
+
+    INFO_LOG_FMT(VIDEO, "Read {} pipeline UIDs of {} machines from {}",
+                 shared_cache.GetUIDCount(), shared_cache.GetSourceCount(), shared_filename);
+  }
 }
 
 void ShaderCache::ClosePipelineUIDCache()
@@ -999,18 +1173,27 @@ void ShaderCache::ClosePipelineUIDCache()
   m_gx_pipeline_uid_cache_file.Close();
 }
 
-void ShaderCache::AddSerializedGXPipelineUID(const SerializedGXPipelineUid& uid)
+GXPipelineUid ShaderCache::AddSerializedGXPipelineUID(const SerializedGXPipelineUid& uid)
 {
   GXPipelineUid real_uid;
   UnserializePipelineUid(uid, real_uid);
 
   auto iter = m_gx_pipeline_cache.find(real_uid);
   if (iter != m_gx_pipeline_cache.end())
-    return;
+    return real_uid;
 
   // Flag it as empty with a null pipeline object, for later compilation.
   auto& entry = m_gx_pipeline_cache[real_uid];
   entry.second = false;
+  return real_uid;
+}
+
+void ShaderCache::RecordSharedPipelineUse(const GXPipelineUid& uid)
+{
+  // The local UID cache is what gets merged into shared caches, so it has to contain every UID
+  // this machine used, including the ones that were already known from the shared cache
+  if (m_shared_only_pipeline_uids.erase(uid) != 0)
+    AppendGXPipelineUID(uid);
 }
 
 void ShaderCache::AppendGXPipelineUID(const GXPipelineUid& config)
@@ -1051,9 +1234,10 @@ void ShaderCache::QueueVertexShaderCompile(const VertexShaderUid& uid, u32 prior
     VertexShaderUid uid;
   };
 
-  m_vs_cache.shader_map[uid].pending = true;
+  auto& entry = m_vs_cache.shader_map[uid];
+  entry.pending = true;
   auto wi = m_async_shader_compiler->CreateWorkItem<VertexShaderWorkItem>(this, uid);
-  m_async_shader_compiler->QueueWorkItem(std::move(wi), priority);
+  entry.work_item = m_async_shader_compiler->QueueWorkItem(std::move(wi), priority);
 }
 
 void ShaderCache::QueueVertexUberShaderCompile(const UberShader::VertexShaderUid& uid, u32 priority)
@@ -1109,9 +1293,10 @@ void ShaderCache::QueuePixelShaderCompile(const PixelShaderUid& uid, u32 priorit
     PixelShaderUid uid;
   };
 
-  m_ps_cache.shader_map[uid].pending = true;
+  auto& entry = m_ps_cache.shader_map[uid];
+  entry.pending = true;
   auto wi = m_async_shader_compiler->CreateWorkItem<PixelShaderWorkItem>(this, uid);
-  m_async_shader_compiler->QueueWorkItem(std::move(wi), priority);
+  entry.work_item = m_async_shader_compiler->QueueWorkItem(std::move(wi), priority);
 }
 
 void ShaderCache::QueuePixelUberShaderCompile(const UberShader::PixelShaderUid& uid, u32 priority)
@@ -1188,16 +1373,27 @@ void ShaderCache::QueuePipelineCompile(const GXPipelineUid& uid, u32 priority)
 
     void Retrieve() override
     {
+      auto& speculative_work = shader_cache->m_speculative_pipeline_work;
+      const auto speculative_it = speculative_work.find(uid);
       if (stages_ready)
       {
+        if (speculative_it != speculative_work.end())
+          speculative_work.erase(speculative_it);
         shader_cache->InsertGXPipeline(uid, std::move(pipeline));
       }
       else
       {
+        // The pipeline may have been promoted while its stages were compiling.
+        if (speculative_it == speculative_work.end())
+          priority = std::min<u32>(priority, COMPILE_PRIORITY_ONDEMAND_PIPELINE);
+
         // Re-queue for next frame.
         auto wi = shader_cache->m_async_shader_compiler->CreateWorkItem<PipelineWorkItem>(
             shader_cache, uid, priority);
-        shader_cache->m_async_shader_compiler->QueueWorkItem(std::move(wi), priority);
+        const AsyncShaderCompiler::WorkItemID id =
+            shader_cache->m_async_shader_compiler->QueueWorkItem(std::move(wi), priority);
+        if (speculative_it != speculative_work.end())
+          speculative_it->second = id;
       }
     }
 
@@ -1211,8 +1407,39 @@ void ShaderCache::QueuePipelineCompile(const GXPipelineUid& uid, u32 priority)
   };
 
   auto wi = m_async_shader_compiler->CreateWorkItem<PipelineWorkItem>(this, uid, priority);
-  m_async_shader_compiler->QueueWorkItem(std::move(wi), priority);
+  const AsyncShaderCompiler::WorkItemID id =
+      m_async_shader_compiler->QueueWorkItem(std::move(wi), priority);
   m_gx_pipeline_cache[uid].second = true;
+  if (id != 0 && priority >= COMPILE_PRIORITY_SHADERCACHE_PIPELINE)
+    m_speculative_pipeline_work[uid] = id;
+}
+
+void ShaderCache::PromotePipelineCompile(const GXPipelineUid& uid)
+{
+  const auto it = m_speculative_pipeline_work.find(uid);
+  if (it == m_speculative_pipeline_work.end())
+    return;
+
+  // The stages were queued with the pipeline, at the same priority
+  const GXPipelineUid actual_uid = ApplyDriverBugs(uid);
+  const auto vs_it = m_vs_cache.shader_map.find(actual_uid.vs_uid);
+  if (vs_it != m_vs_cache.shader_map.end() && vs_it->second.pending)
+  {
+    m_async_shader_compiler->RaiseWorkItemPriority(vs_it->second.work_item,
+                                                   COMPILE_PRIORITY_ONDEMAND_PIPELINE);
+  }
+
+  PixelShaderUid ps_uid = actual_uid.ps_uid;
+  ClearUnusedPixelShaderUidBits(m_api_type, m_host_config, &ps_uid);
+  const auto ps_it = m_ps_cache.shader_map.find(ps_uid);
+  if (ps_it != m_ps_cache.shader_map.end() && ps_it->second.pending)
+  {
+    m_async_shader_compiler->RaiseWorkItemPriority(ps_it->second.work_item,
+                                                   COMPILE_PRIORITY_ONDEMAND_PIPELINE);
+  }
+
+  m_async_shader_compiler->RaiseWorkItemPriority(it->second, COMPILE_PRIORITY_ONDEMAND_PIPELINE);
+  m_speculative_pipeline_work.erase(it);
 }
 
 void ShaderCache::QueueUberPipelineCompile(const GXUberPipelineUid& uid, u32 priority)
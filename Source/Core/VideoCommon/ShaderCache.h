@@ -9,9 +9,11 @@
 #include <map>
 #include <memory>
 #include <optional>
+#include <set>
 #include <string>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/IOFile.h"
@@ -62,10 +64,18 @@ public:
   // Retrieves all pending shaders/pipelines from the async compiler.
   void RetrieveAsyncShaders();
 
+  AsyncShaderCompiler::Stats GetAsyncCompilerStats() const;
+
   // Accesses ShaderGen shader caches
   const AbstractPipeline* GetPipelineForUid(const GXPipelineUid& uid);
   const AbstractPipeline* GetUberPipelineForUid(const GXUberPipelineUid& uid);
 
+  // Like GetUberPipelineForUid, but the pixel shader of the UID carries the partial specialization
+  // the draw needs (see UberShader::GetPartiallySpecializedPixelShaderUid). Returns the smallest
+  // compiled ubershader covering it, falling back to the generic ubershader. Records the draw, so
+  // partially specialized ubershaders are compiled for the variants that are used the most.
+  const AbstractPipeline* GetPartialUberPipelineForUid(const GXUberPipelineUid& uid);
+
   // Accesses ShaderGen shader caches asynchronously.
   // The optional will be empty if this pipeline is now background compiling.
   std::optional<const AbstractPipeline*> GetPipelineForUidAsync(const GXPipelineUid& uid);
@@ -127,6 +137,9 @@ private:
   bool CompileSharedPipelines();
 
   // GX shader compiler methods
+  // Counts how long generate takes to make the source of a shader in the compiler statistics
+  template <typename F>
+  ShaderCode GenerateTimed(const F& generate) const;
   std::unique_ptr<AbstractShader> CompileVertexShader(const VertexShaderUid& uid) const;
   std::unique_ptr<AbstractShader>
   CompileVertexUberShader(const UberShader::VertexShaderUid& uid) const;
@@ -159,10 +172,14 @@ private:
                                            std::unique_ptr<AbstractPipeline> pipeline);
   const AbstractPipeline* InsertGXUberPipeline(const GXUberPipelineUid& config,
                                                std::unique_ptr<AbstractPipeline> pipeline);
-  void AddSerializedGXPipelineUID(const SerializedGXPipelineUid& uid);
+  GXPipelineUid AddSerializedGXPipelineUID(const SerializedGXPipelineUid& uid);
+  void RecordSharedPipelineUse(const GXPipelineUid& uid);
   void AppendGXPipelineUID(const GXPipelineUid& config);
+  void RegisterUberPipelineVariants();
 
   // ASync Compiler Methods
+  void PromotePipelineCompile(const GXPipelineUid& uid);
+  void UpdateSpeculativeCompileWorkers();
   void QueueVertexShaderCompile(const VertexShaderUid& uid, u32 priority);
   void QueueVertexUberShaderCompile(const UberShader::VertexShaderUid& uid, u32 priority);
   void QueuePixelShaderCompile(const PixelShaderUid& uid, u32 priority);
@@ -184,7 +201,8 @@ private:
   // Priorities for compiling. The lower the value, the sooner the pipeline is compiled.
   // The shader cache is compiled last, as it is the least likely to be required. On demand
   // shaders are always compiled before pending ubershaders, as we want to use the ubershader
-  // for as few frames as possible, otherwise we risk framerate drops.
+  // for as few frames as possible, otherwise we risk framerate drops. Shader cache pipelines are
+  // speculative, and are promoted to on demand when a frame needs them before they are done.
   enum : u32
   {
     COMPILE_PRIORITY_ONDEMAND_PIPELINE = 100,
@@ -192,6 +210,11 @@ private:
     COMPILE_PRIORITY_SHADERCACHE_PIPELINE = 300
   };
 
+  // At most this many partially specialized variants are compiled per generic ubershader, each
+  // one after draws that it covers fell back to ubershaders this many times.
+  static constexpr size_t MAX_UBER_PIPELINE_VARIANTS = 4;
+  static constexpr u32 UBER_PIPELINE_VARIANT_MIN_USES = 8;
+
   // Configuration bits.
   APIType m_api_type;
   ShaderHostConfig m_host_config = {};
@@ -214,6 +237,7 @@ private:
     {
       std::unique_ptr<AbstractShader> shader;
       bool pending = false;
+      AsyncShaderCompiler::WorkItemID work_item = 0;
     };
     std::map<Uid, Shader> shader_map;
     Common::LinearDiskCache<Uid, u8> disk_cache;
@@ -226,8 +250,18 @@ private:
 
   // GX Pipeline Caches - .first - pipeline, .second - pending
   std::map<GXPipelineUid, std::pair<std::unique_ptr<AbstractPipeline>, bool>> m_gx_pipeline_cache;
+  // UIDs from the UID caches, in the order CompileMissingPipelines queues them in
+  std::vector<GXPipelineUid> m_gx_pipeline_compile_order;
+  // UIDs from the shared UID cache that haven't been used on this machine yet
+  std::set<GXPipelineUid> m_shared_only_pipeline_uids;
+  // Pending pipelines queued by CompileMissingPipelines, promoted when they are needed to draw
+  std::map<GXPipelineUid, AsyncShaderCompiler::WorkItemID> m_speculative_pipeline_work;
   std::map<GXUberPipelineUid, std::pair<std::unique_ptr<AbstractPipeline>, bool>>
       m_gx_uber_pipeline_cache;
+  // Partially specialized ubershader pipelines for each generic one, compiled or pending
+  std::map<GXUberPipelineUid, std::vector<GXUberPipelineUid>> m_uber_pipeline_variants;
+  // How often draws fell back to an ubershader that this variant would have covered
+  std::map<GXUberPipelineUid, u32> m_uber_pipeline_variant_uses;
   File::IOFile m_gx_pipeline_uid_cache_file;
   Common::LinearDiskCache<SerializedGXPipelineUid, u8> m_gx_pipeline_disk_cache;
   Common::LinearDiskCache<SerializedGXUberPipelineUid, u8> m_gx_uber_pipeline_disk_cache;
@@ -12,6 +12,27 @@
 #include "VideoCommon/VideoConfig.h"
 #include "VideoCommon/XFMemory.h"
 
+// The buffer of the last ShaderCode that was destroyed on this thread, which the next one reuses
+static std::string& GetSpareShaderCodeBuffer()
+{
+  static thread_local std::string buffer;
+  return buffer;
+}
+
+ShaderCode::ShaderCode()
+{
+  m_buffer.swap(GetSpareShaderCodeBuffer());
+  m_buffer.clear();
+  m_buffer.reserve(16384);
+}
+
+ShaderCode::~ShaderCode()
+{
+  std::string& spare = GetSpareShaderCodeBuffer();
+  if (m_buffer.capacity() > spare.capacity())
+    spare.swap(m_buffer);
+}
+
 ShaderHostConfig ShaderHostConfig::GetCurrent()
 {
   ShaderHostConfig bits = {};
@@ -295,7 +316,10 @@ void GenerateLineOffset(ShaderCode& object, std::string_view indent0, std::strin
 void GenerateVSLineExpansion(ShaderCode& object, std::string_view indent, u32 texgens)
 {
   std::string indent1 = std::string(indent) + "  ";
-  object.Write("{0}other_pos = float4(dot(" I_PROJECTION "[0], other_pos), dot(" I_PROJECTION
+  object.Write("{0}other_pos = float4(dot(" I_FREELOOKVIEW "[0], other_pos), dot(" I_FREELOOKVIEW
+               "[1], other_pos), dot(" I_FREELOOKVIEW "[2], other_pos), dot(" I_FREELOOKVIEW
+               "[3], other_pos));\n"
+               "{0}other_pos = float4(dot(" I_PROJECTION "[0], other_pos), dot(" I_PROJECTION
                "[1], other_pos), dot(" I_PROJECTION "[2], other_pos), dot(" I_PROJECTION
                "[3], other_pos));\n"
                "\n"
@@ -104,17 +104,60 @@ private:
   uid_data data{};
 };
 
+// A format string for ShaderCode::Write. Most of what the generators write is text without
+// replacement fields, which is found when the string is checked at compile time, so that it can be
+// appended without going through fmt.
+template <typename... Args>
+class ShaderFormatString
+{
+public:
+  template <typename S>
+    requires std::is_convertible_v<const S&, std::string_view>
+  FMT_CONSTEVAL ShaderFormatString(const S& s)
+      : m_format(s), m_is_literal(IsPlainText(std::string_view(s)))
+  {
+  }
+  // For fmt::runtime()
+  template <typename S>
+    requires(!std::is_convertible_v<const S&, std::string_view>)
+  ShaderFormatString(S s) : m_format(s)
+  {
+  }
+
+  const fmt::format_string<Args...>& GetFormat() const { return m_format; }
+  bool IsLiteral() const { return m_is_literal; }
+
+private:
+  static constexpr bool IsPlainText(std::string_view s)
+  {
+    return sizeof...(Args) == 0 && s.find_first_of("{}") == std::string_view::npos;
+  }
+
+  fmt::format_string<Args...> m_format;
+  bool m_is_literal = false;
+};
+
 class ShaderCode : public ShaderGeneratorInterface
 {
 public:
-  ShaderCode() { m_buffer.reserve(16384); }
+  ShaderCode();
+  ~ShaderCode();
+  ShaderCode(ShaderCode&&) = default;
+  ShaderCode& operator=(ShaderCode&&) = default;
+
   const std::string& GetBuffer() const { return m_buffer; }
 
   // Writes format strings using fmtlib format strings.
   template <typename... Args>
-  void Write(fmt::format_string<Args...> format, Args&&... args)
+  void Write(ShaderFormatString<std::type_identity_t<Args>...> format, Args&&... args)
   {
-    fmt::format_to(std::back_inserter(m_buffer), format, std::forward<Args>(args)...);
+    if (format.IsLiteral())
+    {
+      const fmt::string_view text = format.GetFormat();
+      m_buffer.append(text.data(), text.size());
+      return;
+    }
+    fmt::format_to(std::back_inserter(m_buffer), format.GetFormat(), std::forward<Args>(args)...);
   }
 
 protected:
@@ -277,6 +320,7 @@ void WriteSwitch(ShaderCode& out, APIType ApiType, std::string_view variable,
 
 #define I_POSNORMALMATRIX "cpnmtx"
 #define I_PROJECTION "cproj"
+#define I_FREELOOKVIEW "cfreelookview"
 #define I_MATERIALS "cmtrl"
 #define I_LIGHTS "clights"
 #define I_TEXMATRICES "ctexmtx"
@@ -299,6 +343,7 @@ static const char s_shader_uniforms[] = "\tuint    components;\n"
                                         "\tfloat4  missing_color_value;\n"
                                         "\tfloat4 " I_POSNORMALMATRIX "[6];\n"
                                         "\tfloat4 " I_PROJECTION "[4];\n"
+                                        "\tfloat4 " I_FREELOOKVIEW "[4];\n"
                                         "\tint4 " I_MATERIALS "[4];\n"
                                         "\tLight " I_LIGHTS "[8];\n"
                                         "\tfloat4 " I_TEXMATRICES "[24];\n"
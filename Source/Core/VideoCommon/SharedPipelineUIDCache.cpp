@@ -0,0 +1,140 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/SharedPipelineUIDCache.h"
+
+#include <algorithm>
+#include <set>
+
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+
+namespace VideoCommon
+{
+void SharedPipelineUIDCache::AddSource(std::span<const SerializedGXPipelineUid> uids)
+{
+  if (uids.empty())
+    return;
+
+  // Only the first use of a UID counts, a cache may contain a UID more than once
+  std::set<SerializedGXPipelineUid, UIDLess> seen;
+  for (size_t i = 0; i < uids.size(); ++i)
+  {
+    if (!seen.insert(uids[i]).second)
+      continue;
+
+    Usage& usage = m_entries[uids[i]];
+    usage.source_count++;
+    usage.first_use_sum += (u64(i) << 16) / uids.size();
+  }
+
+  m_source_count++;
+}
+
+bool SharedPipelineUIDCache::AddFile(const std::string& path)
+{
+  File::IOFile file(path, "rb");
+  u32 magic;
+  if (!file.ReadArray(&magic, 1) || !file.Seek(0, File::SeekOrigin::Begin))
+  {
+    ERROR_LOG_FMT(VIDEO, "Failed to read pipeline UID cache {}", path);
+    return false;
+  }
+
+  if (magic == PIPELINE_UID_CACHE_MAGIC)
+  {
+    u32 header[2];
+    if (file.GetSize() < sizeof(header))
+    {
+      ERROR_LOG_FMT(VIDEO, "Pipeline UID cache {} is truncated", path);
+      return false;
+    }
+
+    // Like ShaderCache, this ignores a partially written UID at the end
+    const u64 uid_count = (file.GetSize() - sizeof(header)) / sizeof(SerializedGXPipelineUid);
+    std::vector<SerializedGXPipelineUid> uids(uid_count);
+    if (!file.ReadArray(header, 2) || header[1] != GX_PIPELINE_UID_VERSION ||
+        !file.ReadArray(uids.data(), uids.size()))
+    {
+      ERROR_LOG_FMT(VIDEO, "Pipeline UID cache {} is invalid or of a different version", path);
+      return false;
+    }
+
+    AddSource(uids);
+    return true;
+  }
+
+  SharedPipelineUIDCacheHeader header;
+  if (!file.ReadArray(&header, 1) || header.magic != SHARED_PIPELINE_UID_CACHE_MAGIC ||
+      header.version != SHARED_PIPELINE_UID_CACHE_VERSION ||
+      header.uid_version != GX_PIPELINE_UID_VERSION)
+  {
+    ERROR_LOG_FMT(VIDEO, "Pipeline UID cache {} is invalid or of a different version", path);
+    return false;
+  }
+
+  std::vector<SharedPipelineUIDCacheEntry> entries(header.entry_count);
+  if (file.GetSize() != sizeof(header) + u64(header.entry_count) * sizeof(entries[0]) ||
+      !file.ReadArray(entries.data(), entries.size()))
+  {
+    ERROR_LOG_FMT(VIDEO, "Shared pipeline UID cache {} is truncated", path);
+    return false;
+  }
+
+  for (const SharedPipelineUIDCacheEntry& entry : entries)
+  {
+    Usage& usage = m_entries[entry.uid];
+    usage.source_count += entry.source_count;
+    usage.first_use_sum += entry.first_use_sum;
+  }
+  m_source_count += header.source_count;
+  return true;
+}
+
+bool SharedPipelineUIDCache::Save(const std::string& path) const
+{
+  const std::vector<SharedPipelineUIDCacheEntry> entries = GetSortedEntries();
+
+  SharedPipelineUIDCacheHeader header{};
+  header.magic = SHARED_PIPELINE_UID_CACHE_MAGIC;
+  header.version = SHARED_PIPELINE_UID_CACHE_VERSION;
+  header.uid_version = GX_PIPELINE_UID_VERSION;
+  header.entry_count = static_cast<u32>(entries.size());
+  header.source_count = m_source_count;
+
+  File::IOFile file(path, "wb");
+  if (!file.IsOpen() || !file.WriteArray(&header, 1) ||
+      !file.WriteArray(entries.data(), entries.size()))
+  {
+    ERROR_LOG_FMT(VIDEO, "Failed to write shared pipeline UID cache {}", path);
+    return false;
+  }
+
+  return true;
+}
+
+std::vector<SharedPipelineUIDCacheEntry> SharedPipelineUIDCache::GetSortedEntries() const
+{
+  std::vector<SharedPipelineUIDCacheEntry> entries;
+  entries.reserve(m_entries.size());
+  for (const auto& [uid, usage] : m_entries)
+    entries.push_back({uid, usage.source_count, usage.first_use_sum});
+
+  // With equal source counts, the sums order the entries by their average first use
+  std::stable_sort(entries.begin(), entries.end(), [](const auto& a, const auto& b) {
+    if (a.source_count != b.source_count)
+      return a.source_count > b.source_count;
+    return a.first_use_sum < b.first_use_sum;
+  });
+  return entries;
+}
+
+std::vector<SerializedGXPipelineUid> SharedPipelineUIDCache::GetUIDsInCompileOrder() const
+{
+  std::vector<SerializedGXPipelineUid> uids;
+  uids.reserve(m_entries.size());
+  for (const SharedPipelineUIDCacheEntry& entry : GetSortedEntries())
+    uids.push_back(entry.uid);
+  return uids;
+}
+}  // namespace VideoCommon
@@ -0,0 +1,93 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstring>
+#include <map>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/GXPipelineTypes.h"
+
+namespace VideoCommon
+{
+// The per-game pipeline UID cache (<game ID>.uidcache) written by ShaderCache: a header followed
+// by SerializedGXPipelineUids in the order they were first used.
+constexpr u32 PIPELINE_UID_CACHE_MAGIC = 0x44495550;  // "PUID"
+
+// Pipeline UIDs of a game merged from the UID caches of many machines, so that a machine can
+// compile the pipelines other machines needed before it needs them itself. Merged caches are
+// built with "dolphin-tool shadercache merge" and loaded from <game ID>.shareduidcache next to
+// the regular UID cache.
+//
+// For every UID, the merged cache counts the caches it was found in and sums up how far into
+// each cache it was first used, so more caches can be merged in later. Values are stored in host
+// byte order, a cache with the wrong byte order is rejected by its magic.
+constexpr u32 SHARED_PIPELINE_UID_CACHE_MAGIC = 0x44495553;  // "SUID"
+constexpr u32 SHARED_PIPELINE_UID_CACHE_VERSION = 1;
+const std::string SharedPipelineUIDCacheExtension = ".shareduidcache";
+
+#pragma pack(push, 1)
+struct SharedPipelineUIDCacheHeader
+{
+  u32 magic;
+  u32 version;
+  u32 uid_version;  // GX_PIPELINE_UID_VERSION
+  u32 entry_count;
+  u32 source_count;
+  u32 padding;
+};
+static_assert(sizeof(SharedPipelineUIDCacheHeader) == 0x18, "Wrong size for shared UID cache");
+
+struct SharedPipelineUIDCacheEntry
+{
+  SerializedGXPipelineUid uid;
+  u32 source_count;
+  // Sum over the sources of the position of the first use, in 1/65536ths of the source
+  u64 first_use_sum;
+};
+#pragma pack(pop)
+
+class SharedPipelineUIDCache
+{
+public:
+  // Adds one source, the UIDs of a machine in the order they were first used
+  void AddSource(std::span<const SerializedGXPipelineUid> uids);
+
+  // Merges in either a regular or a merged UID cache. Fails if the file is of a different UID
+  // version.
+  bool AddFile(const std::string& path);
+
+  bool Save(const std::string& path) const;
+
+  // The UIDs that were used by the most sources first, UIDs that were used by the same number of
+  // sources in the average order of their first use
+  std::vector<SerializedGXPipelineUid> GetUIDsInCompileOrder() const;
+
+  size_t GetUIDCount() const { return m_entries.size(); }
+  u32 GetSourceCount() const { return m_source_count; }
+
+private:
+  struct UIDLess
+  {
+    bool operator()(const SerializedGXPipelineUid& a, const SerializedGXPipelineUid& b) const
+    {
+      return std::memcmp(&a, &b, sizeof(a)) < 0;
+    }
+  };
+
+  struct Usage
+  {
+    u32 source_count = 0;
+    u64 first_use_sum = 0;
+  };
+
+  std::vector<SharedPipelineUIDCacheEntry> GetSortedEntries() const;
+
+  std::map<SerializedGXPipelineUid, Usage, UIDLess> m_entries;
+  u32 m_source_count = 0;
+};
+}  // namespace VideoCommon
@@ -89,12 +89,22 @@ void Statistics::Display() const
   draw_statistic("Textures created", "%d", num_textures_created);
   draw_statistic("Textures uploaded", "%d", num_textures_uploaded);
   draw_statistic("Textures alive", "%d", num_textures_alive);
+  if (texture_memory_budget != 0)
+  {
+    draw_statistic("Texture memory", "%.1f / %.1f MiB", texture_memory_usage / 1048576.0,
+                   texture_memory_budget / 1048576.0);
+  }
+  else
+  {
+    draw_statistic("Texture memory", "%.1f MiB", texture_memory_usage / 1048576.0);
+  }
   draw_statistic("pshaders created", "%d", num_pixel_shaders_created);
   draw_statistic("pshaders alive", "%d", num_pixel_shaders_alive);
   draw_statistic("vshaders created", "%d", num_vertex_shaders_created);
   draw_statistic("vshaders alive", "%d", num_vertex_shaders_alive);
   draw_statistic("shaders changes", "%d", this_frame.num_shader_changes);
   draw_statistic("dlists called", "%d", this_frame.num_dlists_called);
+  draw_statistic("Cached vertex draws", "%d", this_frame.num_cached_vertex_draws);
   draw_statistic("Primitive joins", "%d", this_frame.num_primitive_joins);
   draw_statistic("Draw calls", "%d", this_frame.num_draw_calls);
   draw_statistic("Primitives", "%d", this_frame.num_prims);
@@ -108,9 +118,16 @@ void Statistics::Display() const
   draw_statistic("Vertex streamed", "%i kB", this_frame.bytes_vertex_streamed / 1024);
   draw_statistic("Index streamed", "%i kB", this_frame.bytes_index_streamed / 1024);
   draw_statistic("Uniform streamed", "%i kB", this_frame.bytes_uniform_streamed / 1024);
+  draw_statistic("Descriptor sets allocated", "%d", this_frame.num_descriptor_sets_allocated);
+  draw_statistic("Descriptor sets cached", "%d", this_frame.num_descriptor_set_cache_hits);
+  draw_statistic("Descriptor pushes", "%d", this_frame.num_descriptor_pushes);
+  draw_statistic("Stream buffer stalls", "%d", this_frame.num_stream_buffer_stalls);
   draw_statistic("Vertex Loaders", "%d", num_vertex_loaders);
+  draw_statistic("Duplicate XFBs", "%d (%d skipped)", num_duplicate_xfbs,
+                 num_duplicate_xfbs_skipped);
   draw_statistic("EFB peeks:", "%d", this_frame.num_efb_peeks);
   draw_statistic("EFB pokes:", "%d", this_frame.num_efb_pokes);
+  draw_statistic("EFB resolves reused:", "%d", this_frame.num_efb_resolves_reused);
   draw_statistic("Draw dones:", "%d", this_frame.num_draw_done);
   draw_statistic("Tokens:", "%d/%d", this_frame.num_token, this_frame.num_token_int);
 
@@ -18,9 +18,16 @@ struct Statistics
   int num_textures_created = 0;
   int num_textures_uploaded = 0;
   int num_textures_alive = 0;
+  // In bytes, including render targets
+  u64 texture_memory_usage = 0;
+  u64 texture_memory_budget = 0;
 
   int num_vertex_loaders = 0;
 
+  // Fields the VI scanned out without a new XFB, and how many of those weren't presented again
+  int num_duplicate_xfbs = 0;
+  int num_duplicate_xfbs_skipped = 0;
+
   std::array<float, 6> proj{};
   std::array<float, 16> gproj{};
   std::array<float, 16> g2proj{};
@@ -53,11 +60,18 @@ struct Statistics
     int num_draw_calls = 0;
 
     int num_dlists_called = 0;
+    int num_cached_vertex_draws = 0;
 
     int bytes_vertex_streamed = 0;
     int bytes_index_streamed = 0;
     int bytes_uniform_streamed = 0;
 
+    int num_descriptor_sets_allocated = 0;
+    int num_descriptor_set_cache_hits = 0;
+    int num_descriptor_pushes = 0;
+
+    int num_stream_buffer_stalls = 0;
+
     int num_triangles_clipped = 0;
     int num_triangles_in = 0;
     int num_triangles_rejected = 0;
@@ -71,6 +85,7 @@ struct Statistics
 
     int num_efb_peeks = 0;
     int num_efb_pokes = 0;
+    int num_efb_resolves_reused = 0;
 
     int num_draw_done = 0;
     int num_token = 0;
@@ -0,0 +1,70 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <deque>
+#include <utility>
+
+#include "Common/CommonTypes.h"
+
+namespace VideoCommon
+{
+// Suballocates a persistently mapped buffer which the GPU reads in the order it was written, such
+// as the streamed vertices and uniforms. The backend owns the buffer and its fences. How far the
+// GPU has got is known from the fences of the command buffers that were executed after the memory
+// was written.
+//
+// If allocating would have to wait for the GPU, the ring is grown instead when it is allowed to,
+// as the data that is in flight doesn't fit in it.
+class StreamRing
+{
+public:
+  // How much the buffers that may grow get larger than they were created, at most
+  static constexpr u32 MAX_GROWTH = 2;
+
+  StreamRing();
+  virtual ~StreamRing();
+
+  u32 GetSize() const { return m_size; }
+  u32 GetCurrentOffset() const { return m_current_offset; }
+
+  // Reserves num_bytes at GetCurrentOffset(). If this returns false, the command buffer that is
+  // being recorded uses too much of the buffer, and has to be executed before trying again.
+  bool ReserveMemory(u32 num_bytes, u32 alignment);
+  void CommitMemory(u32 final_num_bytes);
+
+protected:
+  // Starts over with a new buffer that the GPU doesn't use yet. It grows up to max_size, if that
+  // is larger than size.
+  void Reset(u32 size, u32 max_size);
+
+  virtual u64 GetCurrentFence() const = 0;
+  virtual u64 GetCompletedFence() const = 0;
+  virtual void WaitForFence(u64 fence) = 0;
+
+  // Makes the written range visible to the GPU, if the memory isn't coherent
+  virtual void FlushRange(u32 offset, u32 size) {}
+
+  // Replaces the buffer with a new one of new_size. The old one has to be kept until the GPU is
+  // done with it.
+  virtual bool Resize(u32 new_size) { return false; }
+
+private:
+  void UpdateCurrentFencePosition();
+  void UpdateGPUPosition();
+
+  // Waits for as many fences as needed to allocate num_bytes bytes from the buffer.
+  bool WaitForClearSpace(u32 num_bytes);
+  bool Grow(u32 num_bytes);
+
+  u32 m_size = 0;
+  u32 m_max_size = 0;
+  u32 m_current_offset = 0;
+  u32 m_current_gpu_position = 0;
+  u32 m_last_allocation_size = 0;
+
+  // List of fences and the corresponding positions in the buffer
+  std::deque<std::pair<u64, u32>> m_tracked_fences;
+};
+}  // namespace VideoCommon
@@ -4,6 +4,7 @@
 #include "VideoCommon/TextureCacheBase.h"
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <cstring>
 #include <memory>
@@ -20,6 +21,7 @@
 #include "Common/Assert.h"
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
+#include "Common/Counters.h"
 #include "Common/FileUtil.h"
 #include "Common/Hash.h"
 #include "Common/Logging/Log.h"
@@ -36,8 +38,10 @@
 #include "VideoCommon/AbstractFramebuffer.h"
 #include "VideoCommon/AbstractGfx.h"
 #include "VideoCommon/AbstractStagingTexture.h"
+#include "VideoCommon/Assets/CustomAssetLoader.h"
 #include "VideoCommon/Assets/CustomTextureData.h"
 #include "VideoCommon/BPMemory.h"
+#include "VideoCommon/FrameProfiler.h"
 #include "VideoCommon/FramebufferManager.h"
 #include "VideoCommon/GraphicsModSystem/Runtime/FBInfo.h"
 #include "VideoCommon/GraphicsModSystem/Runtime/GraphicsModActionData.h"
@@ -55,6 +59,7 @@
 #include "VideoCommon/VertexManagerBase.h"
 #include "VideoCommon/VideoCommon.h"
 #include "VideoCommon/VideoConfig.h"
+#include "VideoCommon/XFMemory.h"
 
 static const u64 TEXHASH_INVALID = 0;
 // Sonic the Fighters (inside Sonic Gems Collection) loops a 64 frames animation
@@ -63,6 +68,15 @@ static const int TEXTURE_POOL_KILL_THRESHOLD = 3;
 
 static int xfb_count = 0;
 
+static Common::Counter s_texture_lookups("dolphin_texture_cache_lookups_total",
+                                         "Textures looked up in the texture cache");
+static Common::Counter s_texture_misses("dolphin_texture_cache_misses_total",
+                                        "Texture lookups that had to load the texture");
+static Common::Counter s_reduced_efb_copies("dolphin_efb_copies_reduced_scale_total",
+                                           "EFB copies made below the internal resolution");
+static Common::Counter s_budget_evictions("dolphin_texture_cache_budget_evictions_total",
+                                          "Textures freed to stay within the memory budget");
+
 std::unique_ptr<TextureCacheBase> g_texture_cache;
 
 TCacheEntry::TCacheEntry(std::unique_ptr<AbstractTexture> tex,
@@ -111,6 +125,9 @@ void TextureCacheBase::Shutdown()
 
   HiresTexture::Shutdown();
 
+  // The dumped textures that weren't read back yet still need the backend.
+  m_texture_dumper.Shutdown();
+
   // For correctness, we need to invalidate textures before the gpu context starts shutting down.
   Invalidate();
 }
@@ -129,6 +146,9 @@ bool TextureCacheBase::Initialize()
     return false;
   }
 
+  if (g_ActiveConfig.UseGPUTextureDecoding())
+    BenchmarkTextureDecoding();
+
   return true;
 }
 
@@ -171,6 +191,9 @@ void TextureCacheBase::OnConfigChanged(const VideoConfig& config)
     TexDecoder_SetTexFmtOverlayOptions(config.bTexFmtOverlayEnable, config.bTexFmtOverlayCenter);
   }
 
+  if (config.UseGPUTextureDecoding() && !m_backup_config.gpu_texture_decoding)
+    BenchmarkTextureDecoding();
+
   SetBackupConfig(config);
 }
 
@@ -231,6 +254,78 @@ void TextureCacheBase::Cleanup(int _frameCount)
       ++iter2;
     }
   }
+
+  EnforceMemoryBudget(_frameCount);
+}
+
+void TextureCacheBase::EnforceMemoryBudget(int frame_count)
+{
+  const u64 budget = static_cast<u64>(std::max(g_ActiveConfig.iTextureCacheMemoryBudget, 0)) << 20;
+  g_stats.texture_memory_budget = budget;
+  g_stats.texture_memory_usage = AbstractTexture::GetTotalMemoryUsage();
+  if (budget == 0 || AbstractTexture::GetTotalMemoryUsage() <= budget)
+    return;
+
+  // The pool textures go first, as nothing uses them. The ones that have been idle the longest,
+  // and then the largest, are freed first.
+  std::vector<TexPool::iterator> pool_textures;
+  pool_textures.reserve(m_texture_pool.size());
+  for (auto iter = m_texture_pool.begin(); iter != m_texture_pool.end(); ++iter)
+    pool_textures.push_back(iter);
+  std::sort(pool_textures.begin(), pool_textures.end(), [](const auto& a, const auto& b) {
+    return std::make_pair(a->second.frameCount, b->first.GetMemorySize()) <
+           std::make_pair(b->second.frameCount, a->first.GetMemorySize());
+  });
+  for (const TexPool::iterator& iter : pool_textures)
+  {
+    if (AbstractTexture::GetTotalMemoryUsage() <= budget)
+      break;
+    m_texture_pool.erase(iter);
+  }
+
+  // Then the textures that weren't used this frame, least recently used first. EFB copies are
+  // kept, as their contents only exist on the GPU.
+  std::vector<TexAddrCache::iterator> entries;
+  for (auto iter = m_textures_by_address.begin(); iter != m_textures_by_address.end(); ++iter)
+  {
+    const TCacheEntry& entry = *iter->second;
+    if (entry.frameCount != FRAMECOUNT_INVALID && entry.frameCount < frame_count &&
+        !entry.IsCopy() && entry.texture)
+    {
+      entries.push_back(iter);
+    }
+  }
+  std::sort(entries.begin(), entries.end(), [](const auto& a, const auto& b) {
+    return std::make_pair(a->second->frameCount, b->second->texture->GetConfig().GetMemorySize()) <
+           std::make_pair(b->second->frameCount, a->second->texture->GetConfig().GetMemorySize());
+  });
+
+  u32 num_evicted = 0;
+  for (const TexAddrCache::iterator& iter : entries)
+  {
+    if (AbstractTexture::GetTotalMemoryUsage() <= budget)
+      break;
+
+    RcTcacheEntry entry = iter->second;
+    InvalidateTexture(iter);
+    num_evicted++;
+
+    // Free the texture rather than returning it to the pool, unless something still uses it
+    if (entry.use_count() == 1)
+    {
+      entry->texture.reset();
+      entry->framebuffer.reset();
+    }
+  }
+
+  SETSTAT(g_stats.num_textures_alive, static_cast<int>(m_textures_by_address.size()));
+  g_stats.texture_memory_usage = AbstractTexture::GetTotalMemoryUsage();
+  s_budget_evictions.Add(num_evicted);
+  if (AbstractTexture::GetTotalMemoryUsage() > budget)
+  {
+    DEBUG_LOG_FMT(VIDEO, "Texture memory is {} MiB over the budget after evicting {} textures",
+                  (AbstractTexture::GetTotalMemoryUsage() - budget) >> 20, num_evicted);
+  }
 }
 
 bool TCacheEntry::OverlapsMemoryRange(u32 range_address, u32 range_size) const
@@ -353,6 +448,16 @@ RcTcacheEntry TextureCacheBase::ApplyPaletteToEntry(RcTcacheEntry& entry, const
   return decoded_entry;
 }
 
+static void SetPaletteConversionKey(const RcTcacheEntry& decoded_entry, u64 base_hash,
+                                    u64 full_hash, TextureAndTLUTFormat full_format)
+{
+  // The conversion is a normal texture from here on, which the search by address in GetTexture
+  // finds again by the hash of the copy's memory and the palette. Overwriting the copy changes
+  // that hash or invalidates the conversion along with the copy, so it's never used stale.
+  decoded_entry->SetHashes(base_hash, full_hash);
+  decoded_entry->format = full_format;
+}
+
 RcTcacheEntry TextureCacheBase::ReinterpretEntry(const RcTcacheEntry& existing_entry,
                                                  TextureFormat new_format)
 {
@@ -561,6 +666,8 @@ void TextureCacheBase::DoState(PointerWrap& p)
 {
   // Flush all pending XFB copies before either loading or saving.
   FlushEFBCopies();
+  // Loading a state replaces emulated memory
+  m_texture_data_hashes.clear();
 
   p.Do(m_last_entry_id);
 
@@ -789,6 +896,9 @@ void TextureCacheBase::OnFrameEnd()
   // copies.
   FlushEFBCopies();
 
+  // The copies of the textures dumped during the frame should be done by now.
+  m_texture_dumper.Flush();
+
   Cleanup(g_presenter->FrameCount());
 }
 
@@ -1024,11 +1134,8 @@ void TextureCacheBase::DumpTexture(RcTcacheEntry& entry, std::string basename, u
       return;
   }
 
-  const std::string filename = fmt::format("{}/{}.png", szDir, basename);
-  if (File::Exists(filename))
-    return;
-
-  entry->texture->Save(filename, level, Config::Get(Config::GFX_TEXTURE_PNG_COMPRESSION_LEVEL));
+  m_texture_dumper.Dump(entry->texture.get(), level, fmt::format("{}/{}.png", szDir, basename),
+                        Config::Get(Config::GFX_TEXTURE_PNG_COMPRESSION_LEVEL));
 }
 
 // Helper for checking if a BPMemory TexMode0 register is set to Point
@@ -1112,6 +1219,8 @@ static void SetSamplerState(u32 index, float custom_tex_scale, bool custom_tex,
 
 void TextureCacheBase::BindTextures(BitSet32 used_textures)
 {
+  FrameProfiler::Scope profile_scope(FrameProfiler::Stage::TextureCache);
+
   auto& system = Core::System::GetInstance();
   auto& pixel_shader_manager = system.GetPixelShaderManager();
   for (u32 i = 0; i < m_bound_textures.size(); i++)
@@ -1277,8 +1386,25 @@ private:
 
 TCacheEntry* TextureCacheBase::Load(const TextureInfo& texture_info)
 {
+  FrameProfiler::Scope profile_scope(FrameProfiler::Stage::TextureCache);
+  s_texture_lookups.Add();
+
   if (auto entry = LoadImpl(texture_info, false))
   {
+    // Keeps the custom textures in use from being evicted, and loads them again if they were
+    if (!entry->linked_game_texture_assets.empty())
+    {
+      auto& loader = Core::System::GetInstance().GetCustomAssetLoader();
+      for (const auto& cached_asset : entry->linked_game_texture_assets)
+      {
+        if (cached_asset.m_asset)
+          loader.MarkGameTextureUsed(cached_asset.m_asset);
+      }
+    }
+
+    if (entry->is_efb_copy && g_ActiveConfig.bEFBCopyScaleByUse)
+      UpdateSampledFootprint(entry);
+
     if (!DidLinkedAssetsChange(*entry))
     {
       return entry;
@@ -1291,6 +1417,42 @@ TCacheEntry* TextureCacheBase::Load(const TextureInfo& texture_info)
   return nullptr;
 }
 
+void TextureCacheBase::UpdateSampledFootprint(TCacheEntry* entry) const
+{
+  // What the draw covers isn't known without transforming its vertices, but it can't reach
+  // outside of the viewport. This overestimates the footprint, which only costs memory.
+  const float width =
+      std::min(std::abs(xfmem.viewport.wd) * 2.0f, static_cast<float>(EFB_WIDTH));
+  const float height =
+      std::min(std::abs(xfmem.viewport.ht) * 2.0f, static_cast<float>(EFB_HEIGHT));
+  const float footprint = std::max(width / std::max(entry->native_width, 1u),
+                                   height / std::max(entry->native_height, 1u));
+  entry->sampled_footprint = std::max(entry->sampled_footprint, footprint);
+}
+
+u32 TextureCacheBase::GetEFBCopyScaleByUse(u32 address, u32 width, u32 height,
+                                           TextureFormat format, float* sampled_footprint) const
+{
+  const u32 efb_scale = g_framebuffer_manager->GetEFBScale();
+  const auto range = m_textures_by_address.equal_range(address);
+  for (auto iter = range.first; iter != range.second; ++iter)
+  {
+    const TCacheEntry& entry = *iter->second;
+    if (!entry.is_efb_copy || entry.native_width != width || entry.native_height != height ||
+        entry.format.texfmt != format || entry.sampled_footprint == 0.0f)
+    {
+      continue;
+    }
+
+    // The footprint is kept, so that a copy that isn't sampled doesn't go back to the full scale
+    *sampled_footprint = entry.sampled_footprint;
+    const u32 scale = static_cast<u32>(std::ceil(entry.sampled_footprint * efb_scale));
+    return std::clamp(scale, 1u, efb_scale);
+  }
+
+  return efb_scale;
+}
+
 TCacheEntry* TextureCacheBase::LoadImpl(const TextureInfo& texture_info, bool force_reload)
 {
   // if this stage was not invalidated by changes to texture registers, keep the current texture
@@ -1328,11 +1490,11 @@ TCacheEntry* TextureCacheBase::LoadImpl(const TextureInfo& texture_info, bool fo
   entry->frameCount = FRAMECOUNT_INVALID;
   if (entry->texture_info_name.empty() && g_ActiveConfig.bGraphicMods)
   {
-    entry->texture_info_name = texture_info.CalculateTextureName().GetFullName();
+    entry->SetTextureInfoName(texture_info.CalculateTextureName().GetFullName());
 
     GraphicsModActionData::TextureLoad texture_load{entry->texture_info_name};
-    for (const auto& action :
-         g_graphics_mod_manager->GetTextureLoadActions(entry->texture_info_name))
+    for (const auto& action : g_graphics_mod_manager->GetTextureLoadActions(
+             entry->texture_info_name, entry->texture_info_hash))
     {
       action->OnTextureLoad(&texture_load);
     }
@@ -1386,8 +1548,16 @@ RcTcacheEntry TextureCacheBase::GetTexture(const int textureCacheSafetyColorSamp
 
   // TODO: This doesn't hash GB tiles for preloaded RGBA8 textures (instead, it's hashing more data
   // from the low tmem bank than it should)
-  base_hash = Common::GetHash64(texture_info.GetData(), texture_info.GetTextureSize(),
+  if (texture_info.IsFromTmem())
+  {
+    base_hash = Common::GetHash64(texture_info.GetData(), texture_info.GetTextureSize(),
+                                  textureCacheSafetyColorSampleSize);
+  }
+  else
+  {
+    base_hash = HashTextureData(texture_info.GetData(), texture_info.GetTextureSize(),
                                 textureCacheSafetyColorSampleSize);
+  }
   u32 palette_size = 0;
   if (texture_info.GetPaletteSize())
   {
@@ -1548,8 +1718,12 @@ RcTcacheEntry TextureCacheBase::GetTexture(const int textureCacheSafetyColorSamp
 
     // It's possible to combine reinterpreted textures + palettes.
     if (unreinterpreted_copy == unconverted_copy && decoded_entry)
+    {
       decoded_entry = ApplyPaletteToEntry(decoded_entry, texture_info.GetTlutAddress(),
                                           texture_info.GetTlutFormat());
+      if (decoded_entry)
+        SetPaletteConversionKey(decoded_entry, base_hash, full_hash, full_format);
+    }
 
     if (decoded_entry)
       return decoded_entry;
@@ -1562,6 +1736,7 @@ RcTcacheEntry TextureCacheBase::GetTexture(const int textureCacheSafetyColorSamp
 
     if (decoded_entry)
     {
+      SetPaletteConversionKey(decoded_entry, base_hash, full_hash, full_format);
       return decoded_entry;
     }
   }
@@ -1654,7 +1829,8 @@ RcTcacheEntry TextureCacheBase::GetTexture(const int textureCacheSafetyColorSamp
     texture_name = texture_info.CalculateTextureName().GetFullName();
     GraphicsModActionData::TextureCreate texture_create{
         texture_name, width, height, &cached_game_assets, &additional_dependencies};
-    for (const auto& action : g_graphics_mod_manager->GetTextureCreateActions(texture_name))
+    for (const auto& action : g_graphics_mod_manager->GetTextureCreateActions(
+             texture_name, GraphicsModManager::HashTextureName(texture_name)))
     {
       action->OnTextureCreate(&texture_create);
     }
@@ -1672,13 +1848,14 @@ RcTcacheEntry TextureCacheBase::GetTexture(const int textureCacheSafetyColorSamp
     }
   }
 
+  s_texture_misses.Add();
   auto entry =
       CreateTextureEntry(TextureCreationInfo{base_hash, full_hash, bytes_per_block, palette_size},
                          texture_info, textureCacheSafetyColorSampleSize,
                          std::move(data_for_assets), has_arbitrary_mipmaps, skip_texture_dump);
   entry->linked_game_texture_assets = std::move(cached_game_assets);
   entry->linked_asset_dependencies = std::move(additional_dependencies);
-  entry->texture_info_name = std::move(texture_name);
+  entry->SetTextureInfoName(std::move(texture_name));
   return entry;
 }
 
@@ -1751,6 +1928,7 @@ RcTcacheEntry TextureCacheBase::CreateTextureEntry(
     // shader, however.
     const bool decode_on_gpu =
         g_ActiveConfig.UseGPUTextureDecoding() &&
+        m_decode_on_gpu[static_cast<size_t>(texture_info.GetTextureFormat())] &&
         !(texture_info.IsFromTmem() && texture_info.GetTextureFormat() == TextureFormat::RGBA8);
 
     ArbitraryMipmapDetector arbitrary_mip_detector;
@@ -1760,7 +1938,7 @@ RcTcacheEntry TextureCacheBase::CreateTextureEntry(
 
     if (!decode_on_gpu ||
         !DecodeTextureOnGPU(
-            entry, 0, texture_info.GetData(), texture_info.GetTextureSize(),
+            entry->texture.get(), 0, texture_info.GetData(), texture_info.GetTextureSize(),
             texture_info.GetTextureFormat(), width, height, expanded_width, expanded_height,
             creation_info.bytes_per_block * (expanded_width / texture_info.GetBlockWidth()),
             texture_info.GetTlutAddress(), texture_info.GetTlutFormat()))
@@ -1812,10 +1990,10 @@ RcTcacheEntry TextureCacheBase::CreateTextureEntry(
         continue;
 
       if (!decode_on_gpu ||
-          !DecodeTextureOnGPU(entry, level, mip_level->GetData(), mip_level->GetTextureSize(),
-                              texture_info.GetTextureFormat(), mip_level->GetRawWidth(),
-                              mip_level->GetRawHeight(), mip_level->GetExpandedWidth(),
-                              mip_level->GetExpandedHeight(),
+          !DecodeTextureOnGPU(entry->texture.get(), level, mip_level->GetData(),
+                              mip_level->GetTextureSize(), texture_info.GetTextureFormat(),
+                              mip_level->GetRawWidth(), mip_level->GetRawHeight(),
+                              mip_level->GetExpandedWidth(), mip_level->GetExpandedHeight(),
                               creation_info.bytes_per_block *
                                   (mip_level->GetExpandedWidth() / texture_info.GetBlockWidth()),
                               texture_info.GetTlutAddress(), texture_info.GetTlutFormat()))
@@ -1932,8 +2110,8 @@ RcTcacheEntry TextureCacheBase::GetXFBTexture(u32 address, u32 width, u32 height
   entry->may_have_overlapping_textures = false;
   entry->frameCount = FRAMECOUNT_INVALID;
   if (!g_ActiveConfig.UseGPUTextureDecoding() ||
-      !DecodeTextureOnGPU(entry, 0, src_data, total_size, entry->format.texfmt, width, height,
-                          width, height, stride, texMem, entry->format.tlutfmt))
+      !DecodeTextureOnGPU(entry->texture.get(), 0, src_data, total_size, entry->format.texfmt,
+                          width, height, width, height, stride, texMem, entry->format.tlutfmt))
   {
     const u32 decoded_size = width * height * sizeof(u32);
     CheckTempSize(decoded_size);
@@ -1955,14 +2133,15 @@ RcTcacheEntry TextureCacheBase::GetXFBTexture(u32 address, u32 width, u32 height
     const std::string id = fmt::format("{}x{}", width, height);
     if (g_ActiveConfig.bGraphicMods)
     {
-      entry->texture_info_name = fmt::format("{}_{}", XFB_DUMP_PREFIX, id);
+      entry->SetTextureInfoName(fmt::format("{}_{}", XFB_DUMP_PREFIX, id));
     }
 
     if (g_ActiveConfig.bDumpXFBTarget)
     {
-      entry->texture->Save(fmt::format("{}{}_n{:06}_{}.png", File::GetUserPath(D_DUMPTEXTURES_IDX),
-                                       XFB_DUMP_PREFIX, xfb_count++, id),
-                           0);
+      m_texture_dumper.Dump(entry->texture.get(), 0,
+                            fmt::format("{}{}_n{:06}_{}.png", File::GetUserPath(D_DUMPTEXTURES_IDX),
+                                        XFB_DUMP_PREFIX, xfb_count++, id),
+                            0, true);
     }
   }
 
@@ -2304,6 +2483,19 @@ void TextureCacheBase::CopyRenderTargetToTexture(
   // Get the base (in memory) format of this efb copy.
   TextureFormat baseFormat = TexDecoder_GetEFBCopyBaseFormat(dstFormat);
 
+  // Copies that are only ever sampled small don't need the full internal resolution
+  float sampled_footprint = 0.0f;
+  if (!is_xfb_copy && g_ActiveConfig.bCopyEFBScaled && g_ActiveConfig.bEFBCopyScaleByUse)
+  {
+    const u32 scale = GetEFBCopyScaleByUse(dstAddr, tex_w, tex_h, baseFormat, &sampled_footprint);
+    if (scale != g_framebuffer_manager->GetEFBScale())
+    {
+      scaled_tex_w = tex_w * scale;
+      scaled_tex_h = tex_h * scale;
+      s_reduced_efb_copies.Add();
+    }
+  }
+
   u32 blockH = TexDecoder_GetBlockHeightInTexels(baseFormat);
   const u32 blockW = TexDecoder_GetBlockWidthInTexels(baseFormat);
 
@@ -2395,6 +2587,7 @@ void TextureCacheBase::CopyRenderTargetToTexture(
       }
       entry->may_have_overlapping_textures = false;
       entry->is_custom_tex = false;
+      entry->sampled_footprint = sampled_footprint;
 
       CopyEFBToCacheEntry(entry, is_depth_copy, srcRect, scaleByHalf, linear_filter, dstFormat,
                           isIntensity, gamma, clamp_top, clamp_bottom,
@@ -2405,15 +2598,16 @@ void TextureCacheBase::CopyRenderTargetToTexture(
         const std::string id = fmt::format("{}x{}", tex_w, tex_h);
         if (g_ActiveConfig.bGraphicMods)
         {
-          entry->texture_info_name = fmt::format("{}_{}", XFB_DUMP_PREFIX, id);
+          entry->SetTextureInfoName(fmt::format("{}_{}", XFB_DUMP_PREFIX, id));
         }
 
         if (g_ActiveConfig.bDumpXFBTarget)
         {
-          entry->texture->Save(fmt::format("{}{}_n{:06}_{}.png",
-                                           File::GetUserPath(D_DUMPTEXTURES_IDX), XFB_DUMP_PREFIX,
-                                           xfb_count++, id),
-                               0);
+          m_texture_dumper.Dump(entry->texture.get(), 0,
+                                fmt::format("{}{}_n{:06}_{}.png",
+                                            File::GetUserPath(D_DUMPTEXTURES_IDX), XFB_DUMP_PREFIX,
+                                            xfb_count++, id),
+                                0, true);
         }
       }
       else if (g_ActiveConfig.bDumpEFBTarget || g_ActiveConfig.bGraphicMods)
@@ -2421,16 +2615,17 @@ void TextureCacheBase::CopyRenderTargetToTexture(
         const std::string id = fmt::format("{}x{}_{}", tex_w, tex_h, static_cast<int>(baseFormat));
         if (g_ActiveConfig.bGraphicMods)
         {
-          entry->texture_info_name = fmt::format("{}_{}", EFB_DUMP_PREFIX, id);
+          entry->SetTextureInfoName(fmt::format("{}_{}", EFB_DUMP_PREFIX, id));
         }
 
         if (g_ActiveConfig.bDumpEFBTarget)
         {
           static int efb_count = 0;
-          entry->texture->Save(fmt::format("{}{}_n{:06}_{}.png",
-                                           File::GetUserPath(D_DUMPTEXTURES_IDX), EFB_DUMP_PREFIX,
-                                           efb_count++, id),
-                               0);
+          m_texture_dumper.Dump(entry->texture.get(), 0,
+                                fmt::format("{}{}_n{:06}_{}.png",
+                                            File::GetUserPath(D_DUMPTEXTURES_IDX), EFB_DUMP_PREFIX,
+                                            efb_count++, id),
+                                0, true);
         }
       }
     }
@@ -2569,6 +2764,12 @@ void TextureCacheBase::FlushEFBCopies()
   if (m_pending_efb_copies.empty())
     return;
 
+  // The GPU completes the copies in the order they were issued, so waiting for the most recent
+  // one first makes the whole batch cost a single GPU sync. The copies before it are then written
+  // to RAM without waiting again.
+  if (const auto& last_copy = m_pending_efb_copies.back(); last_copy->pending_efb_copy)
+    last_copy->pending_efb_copy->Flush();
+
   for (auto& entry : m_pending_efb_copies)
     FlushEFBCopy(entry.get());
   m_pending_efb_copies.clear();
@@ -2586,6 +2787,7 @@ void TextureCacheBase::FlushStaleBinds()
 void TextureCacheBase::WriteEFBCopyToRAM(u8* dst_ptr, u32 width, u32 height, u32 stride,
                                          std::unique_ptr<AbstractStagingTexture> staging_texture)
 {
+  m_texture_data_hashes.clear();
   MathUtil::Rectangle<int> copy_rect(0, 0, static_cast<int>(width), static_cast<int>(height));
   staging_texture->ReadTexels(copy_rect, dst_ptr, stride);
   ReleaseEFBCopyStagingTexture(std::move(staging_texture));
@@ -2655,6 +2857,8 @@ void TextureCacheBase::ReleaseEFBCopyStagingTexture(std::unique_ptr<AbstractStag
 void TextureCacheBase::UninitializeEFBMemory(u8* dst, u32 stride, u32 bytes_per_row,
                                              u32 num_blocks_y)
 {
+  m_texture_data_hashes.clear();
+
   // Hack: Most games don't actually need the correct texture data in RAM
   //       and we can just keep a copy in VRAM. We zero the memory so we
   //       can check it hasn't changed before using our copy in VRAM.
@@ -2669,6 +2873,8 @@ void TextureCacheBase::UninitializeEFBMemory(u8* dst, u32 stride, u32 bytes_per_
 void TextureCacheBase::UninitializeXFBMemory(u8* dst, u32 stride, u32 bytes_per_row,
                                              u32 num_blocks_y)
 {
+  m_texture_data_hashes.clear();
+
   // Originally, we planned on using a 'key color'
   // for alpha to address partial xfbs (Mario Strikers / Chicken Little).
   // This work was removed since it was unfinished but there
@@ -3040,10 +3246,10 @@ void TextureCacheBase::CopyEFB(AbstractStagingTexture* dst, const EFBCopyParams&
   g_vertex_manager->OnEFBCopyToRAM();
 }
 
-bool TextureCacheBase::DecodeTextureOnGPU(RcTcacheEntry& entry, u32 dst_level, const u8* data,
-                                          u32 data_size, TextureFormat format, u32 width,
-                                          u32 height, u32 aligned_width, u32 aligned_height,
-                                          u32 row_stride, const u8* palette,
+bool TextureCacheBase::DecodeTextureOnGPU(AbstractTexture* dst_texture, u32 dst_level,
+                                          const u8* data, u32 data_size, TextureFormat format,
+                                          u32 width, u32 height, u32 aligned_width,
+                                          u32 aligned_height, u32 row_stride, const u8* palette,
                                           TLUTFormat palette_format)
 {
   const auto* info = TextureConversionShaderTiled::GetDecodingShaderInfo(format);
@@ -3096,13 +3302,83 @@ bool TextureCacheBase::DecodeTextureOnGPU(RcTcacheEntry& entry, u32 dst_level, c
 
   // Copy from decoding texture -> final texture
   // This is because we don't want to have to create compute view for every layer
-  const auto copy_rect = entry->texture->GetConfig().GetMipRect(dst_level);
-  entry->texture->CopyRectangleFromTexture(m_decoding_texture.get(), copy_rect, 0, 0, copy_rect, 0,
-                                           dst_level);
-  entry->texture->FinishedRendering();
+  const auto copy_rect = dst_texture->GetConfig().GetMipRect(dst_level);
+  dst_texture->CopyRectangleFromTexture(m_decoding_texture.get(), copy_rect, 0, 0, copy_rect, 0,
+                                        dst_level);
+  dst_texture->FinishedRendering();
   return true;
 }
 
+void TextureCacheBase::BenchmarkTextureDecoding()
+{
+  // Large enough that the fixed cost of a dispatch doesn't dominate, small enough to not delay
+  // starting the game noticeably
+  constexpr u32 SIZE = 256;
+  constexpr int ITERATIONS = 8;
+
+  m_decode_on_gpu.fill(false);
+
+  constexpr TextureConfig config(SIZE, SIZE, 1, 1, 1, AbstractTextureFormat::RGBA8, 0);
+  std::unique_ptr<AbstractTexture> texture =
+      g_gfx->CreateTexture(config, "GPU texture decoding benchmark texture");
+  if (!texture)
+    return;
+
+  // The contents don't matter for either decoder, but they should not be all zero
+  std::vector<u8> src(TexDecoder_GetTextureSizeInBytes(SIZE, SIZE, TextureFormat::RGBA8));
+  for (size_t i = 0; i < src.size(); ++i)
+    src[i] = static_cast<u8>(i * 0x9E3779B1u >> 24);
+  std::vector<u8> palette(src.begin(), src.begin() + 0x8000);
+  CheckTempSize(SIZE * SIZE * sizeof(u32));
+
+  const auto measure = [](const auto& decode) {
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ITERATIONS; ++i)
+    {
+      if (!decode())
+        return std::chrono::steady_clock::duration::max();
+    }
+    g_gfx->Flush();
+    g_gfx->WaitForGPUIdle();
+    return std::chrono::steady_clock::now() - start;
+  };
+
+  for (size_t i = 0; i < m_decode_on_gpu.size(); ++i)
+  {
+    const TextureFormat format = static_cast<TextureFormat>(i);
+    if (format == TextureFormat::XFB ||
+        !TextureConversionShaderTiled::GetDecodingShaderInfo(format))
+    {
+      continue;
+    }
+
+    const u32 data_size = TexDecoder_GetTextureSizeInBytes(SIZE, SIZE, format);
+    const u32 row_stride = data_size / (SIZE / TexDecoder_GetBlockHeightInTexels(format));
+
+    // Also compiles the decoding shader, so that the compile time isn't measured below
+    if (!DecodeTextureOnGPU(texture.get(), 0, src.data(), data_size, format, SIZE, SIZE, SIZE,
+                            SIZE, row_stride, palette.data(), TLUTFormat::RGB5A3))
+    {
+      continue;
+    }
+
+    const auto cpu_time = measure([&] {
+      TexDecoder_Decode(m_temp, src.data(), SIZE, SIZE, format, palette.data(), TLUTFormat::RGB5A3);
+      texture->Load(0, SIZE, SIZE, SIZE, m_temp, SIZE * SIZE * sizeof(u32));
+      return true;
+    });
+    const auto gpu_time = measure([&] {
+      return DecodeTextureOnGPU(texture.get(), 0, src.data(), data_size, format, SIZE, SIZE, SIZE,
+                                SIZE, row_stride, palette.data(), TLUTFormat::RGB5A3);
+    });
+
+    m_decode_on_gpu[i] = gpu_time < cpu_time;
+    INFO_LOG_FMT(VIDEO, "Texture decoding benchmark: {} takes {} us on the CPU, {} us on the GPU",
+                 format, std::chrono::duration_cast<std::chrono::microseconds>(cpu_time).count(),
+                 std::chrono::duration_cast<std::chrono::microseconds>(gpu_time).count());
+  }
+}
+
 u32 TCacheEntry::BytesPerRow() const
 {
   // RGBA takes two cache lines per block; all others take one
@@ -3154,6 +3430,12 @@ void TCacheEntry::SetEfbCopy(u32 stride)
   size_in_bytes = memory_stride * NumBlocksY();
 }
 
+void TCacheEntry::SetTextureInfoName(std::string name)
+{
+  texture_info_hash = GraphicsModManager::HashTextureName(name);
+  texture_info_name = std::move(name);
+}
+
 void TCacheEntry::SetNotCopy()
 {
   is_efb_copy = false;
@@ -3171,6 +3453,20 @@ int TCacheEntry::HashSampleSize() const
   return g_ActiveConfig.iSafeTextureCache_ColorSamples;
 }
 
+u64 TextureCacheBase::HashTextureData(const u8* data, u32 size, u32 samples)
+{
+  if (m_texture_data_hash_batch != OpcodeDecoder::g_fifo_batch)
+  {
+    m_texture_data_hashes.clear();
+    m_texture_data_hash_batch = OpcodeDecoder::g_fifo_batch;
+  }
+
+  const auto [it, inserted] = m_texture_data_hashes.try_emplace({data, size, samples});
+  if (inserted)
+    it->second = Common::GetHash64(data, size, samples);
+  return it->second;
+}
+
 u64 TCacheEntry::CalculateHash() const
 {
   const u32 bytes_per_row = BytesPerRow();
@@ -3182,7 +3478,7 @@ u64 TCacheEntry::CalculateHash() const
   u8* ptr = memory.GetPointer(addr);
   if (memory_stride == bytes_per_row)
   {
-    return Common::GetHash64(ptr, size_in_bytes, hash_sample_size);
+    return g_texture_cache->HashTextureData(ptr, size_in_bytes, hash_sample_size);
   }
   else
   {
@@ -26,6 +26,7 @@
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/TextureConfig.h"
 #include "VideoCommon/TextureDecoder.h"
+#include "VideoCommon/TextureDumper.h"
 #include "VideoCommon/TextureInfo.h"
 #include "VideoCommon/VideoEvents.h"
 
@@ -150,6 +151,11 @@ struct TCacheEntry
   // used to delete textures which haven't been used for TEXTURE_KILL_THRESHOLD frames
   int frameCount = FRAMECOUNT_INVALID;
 
+  // For EFB copies, how many times larger than the copy the largest viewport was that it was
+  // sampled in, or 0 if it wasn't sampled yet. Later copies to the same address are scaled by
+  // this rather than the full internal resolution, unless it's unknown.
+  float sampled_footprint = 0.0f;
+
   // Keep an iterator to the entry in m_textures_by_hash, so it does not need to be searched when
   // removing the cache entry
   std::multimap<u64, std::shared_ptr<TCacheEntry>>::iterator textures_by_hash_iter;
@@ -164,7 +170,9 @@ struct TCacheEntry
   u32 pending_efb_copy_width = 0;
   u32 pending_efb_copy_height = 0;
 
+  // What graphics mods target the texture by, see SetTextureInfoName()
   std::string texture_info_name = "";
+  u64 texture_info_hash = 0;
 
   std::vector<VideoCommon::CachedAsset<VideoCommon::GameTextureAsset>> linked_game_texture_assets;
   std::vector<VideoCommon::CachedAsset<VideoCommon::CustomAsset>> linked_asset_dependencies;
@@ -198,6 +206,9 @@ struct TCacheEntry
     hash = _hash;
   }
 
+  // Also hashes the name, which the actions of graphics mods are looked up by
+  void SetTextureInfoName(std::string name);
+
   // This texture entry is used by the other entry as a sub-texture
   void CreateReference(TCacheEntry* other_entry)
   {
@@ -271,6 +282,9 @@ public:
   // Removes textures which aren't used for more than TEXTURE_KILL_THRESHOLD frames,
   // frameCount is the current frame number.
   void Cleanup(int _frameCount);
+  // Frees idle pool textures, then the least recently used textures, while all textures together
+  // use more memory than the budget.
+  void EnforceMemoryBudget(int frame_count);
 
   void Invalidate();
   void ReleaseToPool(TCacheEntry* entry);
@@ -304,18 +318,22 @@ public:
   // Save States
   void DoState(PointerWrap& p);
 
+  // Common::GetHash64 of texture data in emulated RAM. The result is reused for the same data for
+  // the rest of the FIFO batch, unless the texture cache writes to RAM in the meantime.
+  u64 HashTextureData(const u8* data, u32 size, u32 samples);
+
   static bool AllCopyFilterCoefsNeeded(const std::array<u32, 3>& coefficients);
   static bool CopyFilterCanOverflow(const std::array<u32, 3>& coefficients);
 
 protected:
-  // Decodes the specified data to the GPU texture specified by entry.
+  // Decodes the specified data to the given level of dst_texture.
   // Returns false if the configuration is not supported.
   // width, height are the size of the image in pixels.
   // aligned_width, aligned_height are the size of the image in pixels, aligned to the block size.
   // row_stride is the number of bytes for a row of blocks, not pixels.
-  bool DecodeTextureOnGPU(RcTcacheEntry& entry, u32 dst_level, const u8* data, u32 data_size,
-                          TextureFormat format, u32 width, u32 height, u32 aligned_width,
-                          u32 aligned_height, u32 row_stride, const u8* palette,
+  bool DecodeTextureOnGPU(AbstractTexture* dst_texture, u32 dst_level, const u8* data,
+                          u32 data_size, TextureFormat format, u32 width, u32 height,
+                          u32 aligned_width, u32 aligned_height, u32 row_stride, const u8* palette,
                           TLUTFormat palette_format);
 
   virtual void CopyEFB(AbstractStagingTexture* dst, const EFBCopyParams& params, u32 native_width,
@@ -340,6 +358,10 @@ private:
 
   static bool DidLinkedAssetsChange(const TCacheEntry& entry);
 
+  // Times decoding a texture of each format on the CPU and on the GPU, and remembers for which
+  // formats GPU texture decoding comes out ahead on this hardware.
+  void BenchmarkTextureDecoding();
+
   TCacheEntry* LoadImpl(const TextureInfo& texture_info, bool force_reload);
 
   bool CreateUtilityTextures();
@@ -365,6 +387,11 @@ private:
                    bool is_arbitrary);
   void CheckTempSize(size_t required_size);
 
+  // Scale of a new EFB copy from how the previous copy to the address was sampled
+  u32 GetEFBCopyScaleByUse(u32 address, u32 width, u32 height, TextureFormat format,
+                           float* sampled_footprint) const;
+  void UpdateSampledFootprint(TCacheEntry* entry) const;
+
   RcTcacheEntry AllocateCacheEntry(const TextureConfig& config);
   std::optional<TexPoolEntry> AllocateTexture(const TextureConfig& config);
   TexPool::iterator FindMatchingTextureFromPool(const TextureConfig& config);
@@ -418,6 +445,25 @@ private:
   TexPool m_texture_pool;
   u64 m_last_entry_id = 0;
 
+  struct TextureDataKey
+  {
+    const u8* data;
+    u32 size;
+    u32 samples;
+
+    bool operator==(const TextureDataKey&) const = default;
+  };
+  struct TextureDataKeyHash
+  {
+    size_t operator()(const TextureDataKey& key) const
+    {
+      return std::hash<const u8*>{}(key.data) ^ (size_t(key.size) << 8) ^ key.samples;
+    }
+  };
+  // Hashes from HashTextureData for the FIFO batch m_texture_data_hash_batch
+  std::unordered_map<TextureDataKey, u64, TextureDataKeyHash> m_texture_data_hashes;
+  u64 m_texture_data_hash_batch = 0;
+
   // Backup configuration values
   struct BackupConfig
   {
@@ -444,6 +490,10 @@ private:
   // Decoding texture used for GPU texture decoding.
   std::unique_ptr<AbstractTexture> m_decoding_texture;
 
+  // Formats, indexed by TextureFormat, which BenchmarkTextureDecoding found to decode faster on
+  // the GPU. Only used while GPU texture decoding is enabled.
+  std::array<bool, 16> m_decode_on_gpu{};
+
   // Pool of readback textures used for deferred EFB copies.
   std::vector<std::unique_ptr<AbstractStagingTexture>> m_efb_copy_staging_texture_pool;
 
@@ -457,6 +507,8 @@ private:
   // readbacks, saving the overhead of allocating a new buffer every time.
   std::unique_ptr<AbstractStagingTexture> m_readback_texture;
 
+  VideoCommon::TextureDumper m_texture_dumper;
+
   void OnFrameEnd();
 
   Common::EventHook m_frame_event =
@@ -38,3 +38,19 @@ size_t TextureConfig::GetMipStride(u32 level) const
 {
   return AbstractTexture::CalculateStrideForFormat(format, std::max(width >> level, 1u));
 }
+
+u64 TextureConfig::GetMemorySize() const
+{
+  if (format == AbstractTextureFormat::Undefined)
+    return 0;
+
+  // The stride of compressed formats is that of a row of blocks
+  const u32 block_size = AbstractTexture::GetBlockSizeForFormat(format);
+  u64 size = 0;
+  for (u32 level = 0; level < levels; level++)
+  {
+    const u32 rows = std::max((height >> level) / block_size, 1u);
+    size += static_cast<u64>(GetMipStride(level)) * rows;
+  }
+  return size * layers * samples;
+}
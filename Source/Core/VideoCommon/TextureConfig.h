@@ -58,6 +58,8 @@ struct TextureConfig
   MathUtil::Rectangle<int> GetMipRect(u32 level) const;
   size_t GetStride() const;
   size_t GetMipStride(u32 level) const;
+  // The size of all levels, layers and samples, ignoring whatever padding the driver adds
+  u64 GetMemorySize() const;
 
   bool IsMultisampled() const { return samples > 1; }
   bool IsRenderTarget() const { return (flags & AbstractTextureFlag_RenderTarget) != 0; }
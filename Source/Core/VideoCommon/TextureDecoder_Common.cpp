@@ -4,6 +4,9 @@
 #include <algorithm>
 #include <cmath>
 #include <cstddef>
+#include <future>
+#include <thread>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/MsgHandler.h"
@@ -295,10 +298,47 @@ static void TexDecoder_DrawOverlay(u8* dst, int width, int height, TextureFormat
   }
 }
 
+// Large textures are split into bands of whole block rows, which are decoded on several threads.
+// Every decoder reads the blocks of a row one after the other, so a band is decoded exactly like
+// a texture of the same width with the band's height.
+static constexpr int PARALLEL_DECODE_MIN_TEXELS = 256 * 256;
+static constexpr int PARALLEL_DECODE_MAX_THREADS = 4;
+
+static void DecodeInParallel(u32* dst, const u8* src, int width, int height,
+                             TextureFormat texformat, const u8* tlut, TLUTFormat tlutfmt)
+{
+  const int block_height = TexDecoder_GetBlockHeightInTexels(texformat);
+  const int thread_count = std::min<int>(std::thread::hardware_concurrency(),
+                                         PARALLEL_DECODE_MAX_THREADS);
+  if (width * height < PARALLEL_DECODE_MIN_TEXELS || thread_count < 2 ||
+      width % TexDecoder_GetBlockWidthInTexels(texformat) != 0 || height % block_height != 0)
+  {
+    _TexDecoder_DecodeImpl(dst, src, width, height, texformat, tlut, tlutfmt);
+    return;
+  }
+
+  const int block_rows = height / block_height;
+  const int rows_per_band = (block_rows + thread_count - 1) / thread_count * block_height;
+  const auto decode_band = [=](int first_row) {
+    const int rows = std::min(rows_per_band, height - first_row);
+    _TexDecoder_DecodeImpl(dst + first_row * width,
+                           src + TexDecoder_GetTextureSizeInBytes(width, first_row, texformat),
+                           width, rows, texformat, tlut, tlutfmt);
+  };
+
+  std::vector<std::future<void>> bands;
+  for (int first_row = rows_per_band; first_row < height; first_row += rows_per_band)
+    bands.push_back(std::async(std::launch::async, decode_band, first_row));
+
+  decode_band(0);
+  for (std::future<void>& band : bands)
+    band.wait();
+}
+
 void TexDecoder_Decode(u8* dst, const u8* src, int width, int height, TextureFormat texformat,
                        const u8* tlut, TLUTFormat tlutfmt)
 {
-  _TexDecoder_DecodeImpl((u32*)dst, src, width, height, texformat, tlut, tlutfmt);
+  DecodeInParallel((u32*)dst, src, width, height, texformat, tlut, tlutfmt);
 
   if (TexFmt_Overlay_Enable)
     TexDecoder_DrawOverlay(dst, width, height, texformat);
@@ -0,0 +1,134 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/TextureDumper.h"
+
+#include <algorithm>
+#include <cstring>
+#include <thread>
+
+#include <fmt/format.h>
+
+#include "Common/Assert.h"
+#include "Common/Counters.h"
+#include "Common/FileUtil.h"
+#include "Common/Image.h"
+#include "Common/Logging/Log.h"
+
+#include "VideoCommon/AbstractGfx.h"
+#include "VideoCommon/AbstractStagingTexture.h"
+#include "VideoCommon/AbstractTexture.h"
+
+namespace VideoCommon
+{
+static Common::Counter s_dumps("dolphin_texture_dumps_total", "Textures that were dumped");
+static Common::Counter s_dump_stalls("dolphin_texture_dump_stalls_total",
+                                     "Times that dumping textures had to wait for the file writes");
+
+TextureDumper::TextureDumper() = default;
+
+TextureDumper::~TextureDumper()
+{
+  Shutdown();
+}
+
+void TextureDumper::Dump(const AbstractTexture* texture, u32 level, std::string filename,
+                         int compression, bool overwrite)
+{
+  // We can't dump compressed or float textures, as they can't be copied to RGBA8. The texture
+  // cache doesn't dump custom textures, so this is fine for now.
+  const TextureConfig& config = texture->GetConfig();
+  ASSERT(!AbstractTexture::IsCompressedFormat(config.format));
+  ASSERT(config.format != AbstractTextureFormat::RGBA16F);
+  ASSERT(level < config.levels);
+
+  if (!overwrite && (!m_dumped.insert(filename).second || File::Exists(filename)))
+    return;
+
+  const u32 level_width = std::max(1u, config.width >> level);
+  const u32 level_height = std::max(1u, config.height >> level);
+  auto staging_texture = g_gfx->CreateStagingTexture(
+      StagingTextureType::Readback,
+      TextureConfig(level_width, level_height, 1, 1, 1, AbstractTextureFormat::RGBA8, 0));
+  if (!staging_texture)
+    return;
+
+  staging_texture->CopyFromTexture(texture, 0, level);
+  m_pending.push_back({std::move(staging_texture), std::move(filename), compression});
+
+  if (m_pending.size() >= MAX_PENDING_DUMPS)
+    Flush();
+}
+
+void TextureDumper::Flush()
+{
+  if (m_pending.empty())
+    return;
+
+  if (m_workers.empty())
+  {
+    const size_t num_workers = std::clamp<size_t>(std::thread::hardware_concurrency() / 2, 1, 4);
+    for (size_t i = 0; i < num_workers; ++i)
+    {
+      m_workers.push_back(std::make_unique<Common::WorkQueueThread<Job>>(
+          fmt::format("Texture dumping thread {}", i), [this](Job job) { WriteFile(job); }));
+    }
+  }
+
+  for (PendingDump& pending : m_pending)
+  {
+    AbstractStagingTexture* texture = pending.texture.get();
+    texture->Flush();
+    if (!texture->Map())
+    {
+      ERROR_LOG_FMT(VIDEO, "Failed to map texture for dumping to {}", pending.filename);
+      continue;
+    }
+
+    Job job{{},
+            texture->GetConfig().width,
+            texture->GetConfig().height,
+            std::move(pending.filename),
+            pending.compression};
+    const size_t row_size = job.width * 4;
+    job.data.resize(row_size * job.height);
+    const char* src = texture->GetMappedPointer();
+    for (u32 y = 0; y < job.height; ++y)
+      std::memcpy(job.data.data() + y * row_size, src + y * texture->GetMappedStride(), row_size);
+    texture->Unmap();
+
+    const size_t size = job.data.size();
+    if (m_queued_bytes.load() + size > MAX_QUEUED_BYTES && m_queued_bytes.load() != 0)
+    {
+      s_dump_stalls.Add();
+      WaitForWorkers();
+    }
+
+    m_queued_bytes += size;
+    s_dumps.Add();
+    m_workers[m_next_worker]->Push(std::move(job));
+    m_next_worker = (m_next_worker + 1) % m_workers.size();
+  }
+
+  m_pending.clear();
+}
+
+void TextureDumper::Shutdown()
+{
+  Flush();
+  WaitForWorkers();
+}
+
+void TextureDumper::WriteFile(const Job& job)
+{
+  Common::SavePNG(job.filename, job.data.data(), Common::ImageByteFormat::RGBA, job.width,
+                  job.height, job.width * 4, job.compression);
+  m_queued_bytes -= job.data.size();
+}
+
+void TextureDumper::WaitForWorkers()
+{
+  for (auto& worker : m_workers)
+    worker->WaitForCompletion();
+}
+}  // namespace VideoCommon
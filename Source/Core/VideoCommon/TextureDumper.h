@@ -0,0 +1,73 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/WorkQueueThread.h"
+
+class AbstractStagingTexture;
+class AbstractTexture;
+
+namespace VideoCommon
+{
+// Saves textures as PNG files without stalling the video thread. Dumped textures are copied to
+// staging textures, which are only read at the end of the frame, once the GPU had time for the
+// copies. Compressing and writing the files is done by a few worker threads.
+class TextureDumper
+{
+public:
+  TextureDumper();
+  ~TextureDumper();
+
+  // Unless overwrite is set, nothing is saved if a file of the same name was dumped before, or
+  // already exists. The names of dumped files are kept, so that is only checked once.
+  void Dump(const AbstractTexture* texture, u32 level, std::string filename, int compression,
+            bool overwrite = false);
+
+  // Hands the textures that were dumped since the last flush to the workers.
+  void Flush();
+
+  // Writes out everything that was dumped. This has to be called before the backend shuts down.
+  void Shutdown();
+
+private:
+  // Textures dumped between frames are flushed early beyond this, to bound the staging memory
+  static constexpr size_t MAX_PENDING_DUMPS = 64;
+  // Flushing waits for the workers while they have more than this left to write
+  static constexpr size_t MAX_QUEUED_BYTES = 256 * 1024 * 1024;
+
+  struct PendingDump
+  {
+    std::unique_ptr<AbstractStagingTexture> texture;
+    std::string filename;
+    int compression;
+  };
+
+  struct Job
+  {
+    std::vector<u8> data;
+    u32 width;
+    u32 height;
+    std::string filename;
+    int compression;
+  };
+
+  void WriteFile(const Job& job);
+  void WaitForWorkers();
+
+  std::vector<PendingDump> m_pending;
+  std::unordered_set<std::string> m_dumped;
+
+  std::vector<std::unique_ptr<Common::WorkQueueThread<Job>>> m_workers;
+  size_t m_next_worker = 0;
+  std::atomic<size_t> m_queued_bytes{0};
+};
+}  // namespace VideoCommon
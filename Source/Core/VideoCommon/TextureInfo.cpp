@@ -4,9 +4,9 @@
 #include "VideoCommon/TextureInfo.h"
 
 #include <fmt/format.h>
-#include <xxhash.h>
 
 #include "Common/Align.h"
+#include "Common/Hash.h"
 #include "Core/HW/Memmap.h"
 #include "Core/System.h"
 #include "VideoCommon/BPMemory.h"
@@ -155,8 +155,8 @@ TextureInfo::NameDetails TextureInfo::CalculateTextureName() const
     tlut += 2 * min;
   }
 
-  const u64 tex_hash = XXH64(m_ptr, m_texture_size, 0);
-  const u64 tlut_hash = tlut_size ? XXH64(tlut, tlut_size, 0) : 0;
+  const u64 tex_hash = Common::HashData(m_ptr, m_texture_size);
+  const u64 tlut_hash = tlut_size ? Common::HashData(tlut, tlut_size) : 0;
 
   NameDetails result;
   result.base_name = fmt::format("{}{}x{}{}", format_prefix, m_raw_width, m_raw_height,
@@ -6,9 +6,9 @@
 #include <optional>
 #include <string>
 #include <string_view>
-#include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/SmallVector.h"
 
 enum class TextureFormat;
 enum class TLUTFormat;
@@ -61,6 +61,7 @@ public:
   class MipLevel
   {
   public:
+    MipLevel() = default;
     MipLevel(u32 level, const TextureInfo& parent, bool from_tmem, const u8*& src_data,
              const u8*& ptr_even, const u8*& ptr_odd);
 
@@ -75,15 +76,15 @@ public:
     u32 GetRawHeight() const;
 
   private:
-    const u8* m_ptr;
+    const u8* m_ptr = nullptr;
 
     u32 m_texture_size = 0;
 
-    u32 m_expanded_width;
-    u32 m_raw_width;
+    u32 m_expanded_width = 0;
+    u32 m_raw_width = 0;
 
-    u32 m_expanded_height;
-    u32 m_raw_height;
+    u32 m_expanded_height = 0;
+    u32 m_raw_height = 0;
   };
 
   bool HasMipMaps() const;
@@ -105,8 +106,12 @@ private:
   TextureFormat m_texture_format;
   TLUTFormat m_tlut_format;
 
+  // Textures are at most 1024x1024, which has 10 levels after the base one. Keeping them inline
+  // means that looking up the textures of a draw doesn't allocate.
+  static constexpr size_t MAX_MIP_LEVELS = 10;
+
   bool m_mipmaps_enabled = false;
-  std::vector<MipLevel> m_mip_levels;
+  Common::SmallVector<MipLevel, MAX_MIP_LEVELS> m_mip_levels;
 
   u32 m_texture_size = 0;
   std::optional<u32> m_palette_size;
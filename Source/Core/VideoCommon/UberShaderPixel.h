@@ -20,6 +20,13 @@ struct pixel_ubershader_uid_data
   u32 uint_output : 1;
   u32 no_dual_src : 1;
 
+  // Partial specialization, all zero for the ubershader that covers every draw. A partially
+  // specialized ubershader only covers draws with at most max_tev_stages TEV stages (0 for all 16),
+  // and leaves out indirect texturing and fog when they are set.
+  u32 max_tev_stages : 4;
+  u32 no_indirect : 1;
+  u32 no_fog : 1;
+
   u32 NumValues() const { return sizeof(pixel_ubershader_uid_data); }
 };
 #pragma pack()
@@ -28,6 +35,16 @@ using PixelShaderUid = ShaderUid<pixel_ubershader_uid_data>;
 
 PixelShaderUid GetPixelShaderUid();
 
+// Returns the most specialized ubershader that can draw with the current state, i.e. the
+// ubershader from GetPixelShaderUid() with the partial specialization bits set as tightly as
+// possible.
+PixelShaderUid GetPartiallySpecializedPixelShaderUid(const PixelShaderUid& uid);
+PixelShaderUid ClearPartialSpecializationBits(const PixelShaderUid& uid);
+bool IsPartiallySpecialized(const PixelShaderUid& uid);
+
+// Whether a (partially specialized) ubershader can draw everything the required one can
+bool PixelShaderCovers(const PixelShaderUid& uid, const PixelShaderUid& required_uid);
+
 ShaderCode GenPixelShader(APIType api_type, const ShaderHostConfig& host_config,
                           const pixel_ubershader_uid_data* uid_data,
                           const CustomPixelShaderContents& custom_details);
@@ -45,8 +62,10 @@ struct fmt::formatter<UberShader::pixel_ubershader_uid_data>
   auto format(const UberShader::pixel_ubershader_uid_data& uid, FormatContext& ctx) const
   {
     return fmt::format_to(
-        ctx.out(), "Pixel UberShader for {} texgens{}{}{}{}", uid.num_texgens,
+        ctx.out(), "Pixel UberShader for {} texgens{}{}{}{}{}{}{}", uid.num_texgens,
         uid.early_depth ? ", early-depth" : "", uid.per_pixel_depth ? ", per-pixel depth" : "",
-        uid.uint_output ? ", uint output" : "", uid.no_dual_src ? ", no dual-source blending" : "");
+        uid.uint_output ? ", uint output" : "", uid.no_dual_src ? ", no dual-source blending" : "",
+        uid.max_tev_stages != 0 ? fmt::format(", {} TEV stages", uid.max_tev_stages) : "",
+        uid.no_indirect ? ", no indirect textures" : "", uid.no_fog ? ", no fog" : "");
   }
 };
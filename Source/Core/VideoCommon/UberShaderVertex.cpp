@@ -248,8 +248,11 @@ float3 load_input_float3_rawtex(uint vtx_offset, uint attr_offset) {{
             "\n"
             "// Multiply the position vector by the position matrix\n"
             "float4 pos = float4(dot(P0, rawpos), dot(P1, rawpos), dot(P2, rawpos), 1.0);\n"
-            "o.pos = float4(dot(" I_PROJECTION "[0], pos), dot(" I_PROJECTION
-            "[1], pos), dot(" I_PROJECTION "[2], pos), dot(" I_PROJECTION "[3], pos));\n"
+            "float4 view_pos = float4(dot(" I_FREELOOKVIEW "[0], pos), dot(" I_FREELOOKVIEW
+            "[1], pos), dot(" I_FREELOOKVIEW "[2], pos), dot(" I_FREELOOKVIEW "[3], pos));\n"
+            "o.pos = float4(dot(" I_PROJECTION "[0], view_pos), dot(" I_PROJECTION
+            "[1], view_pos), dot(" I_PROJECTION "[2], view_pos), dot(" I_PROJECTION
+            "[3], view_pos));\n"
             "\n"
             "// The scale of the transform matrix is used to control the size of the emboss map\n"
             "// effect by changing the scale of the transformed binormals (which only get used by\n"
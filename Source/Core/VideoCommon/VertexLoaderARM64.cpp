@@ -3,7 +3,9 @@
 
 #include "VideoCommon/VertexLoaderARM64.h"
 
+#include <algorithm>
 #include <array>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "VideoCommon/CPMemory.h"
@@ -24,6 +26,13 @@ constexpr ARM64Reg stride_reg = ARM64Reg::X11;
 constexpr ARM64Reg arraybase_reg = ARM64Reg::X10;
 constexpr ARM64Reg scale_reg = ARM64Reg::X9;
 
+// Base and stride of each of VertexLoaderARM64::m_cached_arrays
+constexpr std::array<std::pair<ARM64Reg, ARM64Reg>, 3> cached_array_regs = {{
+    {ARM64Reg::X3, ARM64Reg::W6},
+    {ARM64Reg::X4, ARM64Reg::W7},
+    {ARM64Reg::X5, ARM64Reg::W8},
+}};
+
 static constexpr int GetLoadSize(int load_bytes)
 {
   if (load_bytes == 1)
@@ -87,6 +96,16 @@ std::pair<Arm64Gen::ARM64Reg, u32> VertexLoaderARM64::GetVertexAddr(CPArray arra
       m_skip_vertex = CBZ(scratch2_reg);
     }
 
+    const auto cached_end = m_cached_arrays.begin() + m_num_cached_arrays;
+    const auto cached = std::find(m_cached_arrays.begin(), cached_end, array);
+    if (cached != cached_end)
+    {
+      const auto [array_base, array_stride] = cached_array_regs[cached - m_cached_arrays.begin()];
+      MUL(scratch1_reg, scratch1_reg, array_stride);
+      ADD(EncodeRegTo64(scratch1_reg), EncodeRegTo64(scratch1_reg), array_base);
+      return {EncodeRegTo64(scratch1_reg), 0};
+    }
+
     LDR(IndexType::Unsigned, scratch2_reg, stride_reg, static_cast<u8>(array) * 4);
     MUL(scratch1_reg, scratch1_reg, scratch2_reg);
 
@@ -323,6 +342,7 @@ void VertexLoaderARM64::GenerateVertexLoader()
   // Registers we don't have to worry about saving
   // R9-R17 are caller saved temporaries
   // R18 is a temporary or platform specific register(iOS)
+  // R3-R8 hold the bases and strides of the cached arrays
   //
   // VFP registers
   // We can touch all except v8-v15
@@ -348,6 +368,17 @@ void VertexLoaderARM64::GenerateVertexLoader()
   MOVP2R(stride_reg, g_main_cp_state.array_strides.data());
   MOVP2R(arraybase_reg, VertexLoaderManager::cached_arraybases.data());
 
+  const std::vector<CPArray> indexed_arrays = GetIndexedArrays();
+  m_num_cached_arrays = std::min(indexed_arrays.size(), m_cached_arrays.size());
+  for (size_t i = 0; i < m_num_cached_arrays; i++)
+  {
+    m_cached_arrays[i] = indexed_arrays[i];
+    const auto [array_base, array_stride] = cached_array_regs[i];
+    const u8 array = static_cast<u8>(m_cached_arrays[i]);
+    LDR(IndexType::Unsigned, array_stride, stride_reg, array * 4);
+    LDR(IndexType::Unsigned, array_base, arraybase_reg, array * 8);
+  }
+
   if (need_scale)
     MOVP2R(scale_reg, scale_factors);
 
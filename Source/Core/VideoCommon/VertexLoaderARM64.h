@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <array>
 #include <utility>
 
 #include "Common/Arm64Emitter.h"
@@ -21,11 +22,15 @@ public:
 
 protected:
   int RunVertices(const u8* src, u8* dst, int count) override;
+  bool IsReentrant() const override { return true; }
 
 private:
   u32 m_src_ofs = 0;
   u32 m_dst_ofs = 0;
   Arm64Gen::FixupBranch m_skip_vertex;
+  // The first indexed arrays, whose bases and strides are kept in registers during the loop
+  std::array<CPArray, 3> m_cached_arrays{};
+  size_t m_num_cached_arrays = 0;
   Arm64Gen::ARM64FloatEmitter m_float_emit;
   std::pair<Arm64Gen::ARM64Reg, u32> GetVertexAddr(CPArray array, VertexComponentFormat attribute);
   void ReadVertex(VertexComponentFormat attribute, ComponentFormat format, int count_in,
@@ -224,6 +224,43 @@ u32 VertexLoaderBase::GetVertexComponents(const TVtxDesc& vtx_desc, const VAT& v
   return components;
 }
 
+bool VertexLoaderBase::HasIndexedAttributes() const
+{
+  if (IsIndexed(m_VtxDesc.low.Position) || IsIndexed(m_VtxDesc.low.Normal))
+    return true;
+  for (u8 i = 0; i < m_VtxDesc.low.Color.Size(); i++)
+  {
+    if (IsIndexed(m_VtxDesc.low.Color[i]))
+      return true;
+  }
+  for (u8 i = 0; i < m_VtxDesc.high.TexCoord.Size(); i++)
+  {
+    if (IsIndexed(m_VtxDesc.high.TexCoord[i]))
+      return true;
+  }
+  return false;
+}
+
+std::vector<CPArray> VertexLoaderBase::GetIndexedArrays() const
+{
+  std::vector<CPArray> arrays;
+  if (IsIndexed(m_VtxDesc.low.Position))
+    arrays.push_back(CPArray::Position);
+  if (IsIndexed(m_VtxDesc.low.Normal))
+    arrays.push_back(CPArray::Normal);
+  for (u8 i = 0; i < m_VtxDesc.low.Color.Size(); i++)
+  {
+    if (IsIndexed(m_VtxDesc.low.Color[i]))
+      arrays.push_back(CPArray::Color0 + i);
+  }
+  for (u8 i = 0; i < m_VtxDesc.high.TexCoord.Size(); i++)
+  {
+    if (IsIndexed(m_VtxDesc.high.TexCoord[i]))
+      arrays.push_back(CPArray::TexCoord0 + i);
+  }
+  return arrays;
+}
+
 std::unique_ptr<VertexLoaderBase> VertexLoaderBase::CreateVertexLoader(const TVtxDesc& vtx_desc,
                                                                        const VAT& vtx_attr)
 {
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <memory>
 #include <string>
 #include <vector>
@@ -28,10 +29,29 @@ public:
     vid[4] = vat.g2.Hex;
     hash = CalculateHash();
   }
+  explicit VertexLoaderUID(const std::array<u32, 5>& data) : vid{data} { hash = CalculateHash(); }
 
   bool operator==(const VertexLoaderUID& rh) const { return vid == rh.vid; }
   size_t GetHash() const { return hash; }
 
+  // As stored in the loader UID cache
+  const std::array<u32, 5>& GetData() const { return vid; }
+  TVtxDesc GetVertexDesc() const
+  {
+    TVtxDesc vtx_desc;
+    vtx_desc.low.Hex = vid[0];
+    vtx_desc.high.Hex = vid[1];
+    return vtx_desc;
+  }
+  VAT GetVertexAttributes() const
+  {
+    VAT vtx_attr;
+    vtx_attr.g0.Hex = vid[2];
+    vtx_attr.g1.Hex = vid[3];
+    vtx_attr.g2.Hex = vid[4];
+    return vtx_attr;
+  }
+
 private:
   size_t CalculateHash() const
   {
@@ -65,6 +85,15 @@ public:
   virtual ~VertexLoaderBase() {}
   virtual int RunVertices(const u8* src, u8* dst, int count) = 0;
 
+  // Whether RunVertices may be called for different parts of a draw from several threads at once.
+  // The last vertices of a draw still have to be converted last, since they are stored in the
+  // zfreeze and emboss caches.
+  virtual bool IsReentrant() const { return false; }
+
+  // Whether any attribute is read from an array. Otherwise, the output only depends on the raw
+  // vertex data.
+  bool HasIndexedAttributes() const;
+
   // per loader public state
   PortableVertexDeclaration m_native_vtx_decl{};
   const u32 m_vertex_size;  // number of bytes of a raw GC vertex
@@ -72,7 +101,7 @@ public:
 
   // used by VertexLoaderManager
   NativeVertexFormat* m_native_vertex_format = nullptr;
-  int m_numLoadedVertices = 0;
+  std::atomic<int> m_numLoadedVertices = 0;
 
 protected:
   VertexLoaderBase(const TVtxDesc& vtx_desc, const VAT& vtx_attr)
@@ -82,6 +111,9 @@ protected:
   {
   }
 
+  // The arrays of the indexed attributes, in the order in which the loaders read them
+  std::vector<CPArray> GetIndexedArrays() const;
+
   // GC vertex format
   const VAT m_VtxAttr;
   const TVtxDesc m_VtxDesc;
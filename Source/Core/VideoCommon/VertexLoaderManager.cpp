@@ -4,27 +4,39 @@
 #include "VideoCommon/VertexLoaderManager.h"
 
 #include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <iterator>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <type_traits>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/EnumMap.h"
+#include "Common/FileUtil.h"
+#include "Common/Hash.h"
+#include "Common/IOFile.h"
 #include "Common/Logging/Log.h"
+#include "Common/Thread.h"
+#include "Common/WorkerPool.h"
 
+#include "Core/ConfigManager.h"
 #include "Core/DolphinAnalytics.h"
 #include "Core/HW/Memmap.h"
 #include "Core/System.h"
 
 #include "VideoCommon/AbstractGfx.h"
 #include "VideoCommon/BPMemory.h"
+#include "VideoCommon/BoundingBox.h"
 #include "VideoCommon/CPMemory.h"
 #include "VideoCommon/DataReader.h"
+#include "VideoCommon/FrameProfiler.h"
 #include "VideoCommon/IndexGenerator.h"
 #include "VideoCommon/NativeVertexFormat.h"
 #include "VideoCommon/Statistics.h"
@@ -52,6 +64,13 @@ static std::mutex s_vertex_loader_map_lock;
 static VertexLoaderMap s_vertex_loader_map;
 // TODO - change into array of pointers. Keep a map of all seen so far.
 
+// UIDs of the loaders that were used by the game in earlier sessions, guarded by
+// s_vertex_loader_map_lock. Their loaders are created on s_precompile_thread at boot.
+static File::IOFile s_loader_uid_cache_file;
+static std::unordered_set<VertexLoaderUID> s_cached_loader_uids;
+static std::thread s_precompile_thread;
+static std::atomic<bool> s_precompile_cancelled;
+
 Common::EnumMap<u8*, CPArray::TexCoord7> cached_arraybases;
 
 BitSet8 g_main_vat_dirty;
@@ -61,6 +80,203 @@ std::array<VertexLoaderBase*, CP_NUM_VAT_REG> g_main_vertex_loaders;
 std::array<VertexLoaderBase*, CP_NUM_VAT_REG> g_preprocess_vertex_loaders;
 bool g_needs_cp_xf_consistency_check;
 
+namespace
+{
+// Converts the vertices of large draws on several threads. Every thread converts a contiguous
+// range of the draw, and the ranges are put back together in order, so the result is the same as
+// converting the whole draw on the GPU thread.
+class ParallelVertexLoader
+{
+public:
+  // Smaller draws take less time to convert than waking up the workers
+  static constexpr int MIN_VERTICES = 4096;
+  static constexpr size_t MAX_WORKERS = 3;
+  // Converted on the calling thread once the workers are done, so that the zfreeze cache ends up
+  // holding the last three vertices of the draw
+  static constexpr int TAIL_VERTICES = 3;
+
+  bool CanRun(const VertexLoaderBase* loader, int count)
+  {
+    return count >= MIN_VERTICES && loader->IsReentrant() && m_workers.GetJobCount() > 1;
+  }
+
+  int Run(VertexLoaderBase* loader, const u8* src, u8* dst, int count);
+  void Shutdown() { m_workers.Shutdown(); }
+
+private:
+  struct Job
+  {
+    const u8* src;
+    u8* dst;
+    int count;
+    int loaded_count;
+  };
+
+  Common::WorkerPool m_workers{"Vertex loader worker", MAX_WORKERS};
+  std::vector<Job> m_jobs;
+};
+
+int ParallelVertexLoader::Run(VertexLoaderBase* loader, const u8* src, u8* dst, int count)
+{
+  const u32 src_stride = loader->m_vertex_size;
+  const u32 dst_stride = loader->m_native_vtx_decl.stride;
+  const int job_count = static_cast<int>(m_workers.GetJobCount());
+  const int parallel_count = count - TAIL_VERTICES;
+  const int vertices_per_job = parallel_count / job_count;
+
+  m_jobs.resize(job_count);
+  int first = 0;
+  for (int i = 0; i < job_count; ++i)
+  {
+    const int job_vertices = i == job_count - 1 ? parallel_count - first : vertices_per_job;
+    m_jobs[i] = {src + first * src_stride, dst + first * dst_stride, job_vertices, 0};
+    first += job_vertices;
+  }
+
+  m_workers.Run([&](size_t i) {
+    Job& job = m_jobs[i];
+    job.loaded_count = loader->RunVertices(job.src, job.dst, job.count);
+  });
+
+  // Skipped vertices leave gaps at the end of the output of a job
+  u8* out = dst;
+  for (const Job& job : m_jobs)
+  {
+    const size_t size = size_t(job.loaded_count) * dst_stride;
+    if (out != job.dst)
+      std::memmove(out, job.dst, size);
+    out += size;
+  }
+
+  const int loaded_count = static_cast<int>((out - dst) / dst_stride);
+  return loaded_count + loader->RunVertices(src + parallel_count * src_stride, out, TAIL_VERTICES);
+}
+
+ParallelVertexLoader s_parallel_vertex_loader;
+
+// Remembers the converted vertices of draws in display lists. Games tend to call the same display
+// lists every frame, so when the raw vertices of a draw match an earlier draw with the same
+// loader, its converted vertices are copied instead of running the loader again. Only loaders
+// without indexed attributes are used, since their output depends on nothing but the raw data.
+// The cache also remembers whether CPU culling found the draw visible. Unlike the converted
+// vertices, that depends on the matrices, so it is only used as a hint for skipping the test.
+class ConvertedVertexCache
+{
+public:
+  // Smaller draws don't take long enough to convert to make up for the hashing
+  static constexpr int MIN_VERTICES = 32;
+  static constexpr size_t MAX_SIZE = 32 * 1024 * 1024;
+  static constexpr size_t MAX_ENTRIES = 64 * 1024;
+  // Converted again after a hit, so that the zfreeze and emboss caches get updated
+  static constexpr int TAIL_VERTICES = 3;
+  // Draws that were visible this many times in a row are only tested every CULL_TEST_INTERVAL
+  // draws, in case they went off screen
+  static constexpr u8 VISIBLE_STREAK = 4;
+  static constexpr u8 CULL_TEST_INTERVAL = 8;
+
+  static bool CanCache(const VertexLoaderBase* loader, int count)
+  {
+    return count >= MIN_VERTICES && !loader->HasIndexedAttributes();
+  }
+
+  // Writes the converted vertices of a draw to dst, either from the cache or by calling convert
+  // with the buffer to write them to. Returns the number of vertices written.
+  // Draws are only stored when they are seen a second time, so that draws in display lists that
+  // are only called once don't use up the cache. dst isn't read from, as it is often GPU memory.
+  template <typename ConvertFunction>
+  int Run(VertexLoaderBase* loader, const u8* src, u8* dst, int count,
+          const ConvertFunction& convert)
+  {
+    if (m_entries.size() >= MAX_ENTRIES)
+      Clear();
+
+    const Key key{loader, count, Common::HashData(src, size_t(count) * loader->m_vertex_size)};
+    const auto [it, inserted] = m_entries.try_emplace(key);
+    m_last_entry = &it->second;
+    if (inserted)
+      return convert(dst);
+
+    const u32 dst_stride = loader->m_native_vtx_decl.stride;
+    const size_t size = size_t(count) * dst_stride;
+    std::vector<u8>& data = it->second.data;
+    if (!data.empty())
+    {
+      const int head = count - TAIL_VERTICES;
+      std::memcpy(dst, data.data(), size_t(head) * dst_stride);
+      loader->RunVertices(src + head * loader->m_vertex_size, dst + head * dst_stride,
+                          TAIL_VERTICES);
+      INCSTAT(g_stats.this_frame.num_cached_vertex_draws);
+      return count;
+    }
+
+    if (m_size + size > MAX_SIZE)
+    {
+      Clear();
+      return convert(dst);
+    }
+
+    // Without indexed positions, no vertices are skipped
+    data.resize(size);
+    const int loaded_count = convert(data.data());
+    std::memcpy(dst, data.data(), size);
+    m_size += size;
+    return loaded_count;
+  }
+
+  // Whether CPU culling can be skipped for the draw of the last call to Run
+  bool IsLastDrawLikelyVisible()
+  {
+    return m_last_entry && m_last_entry->visible_streak >= VISIBLE_STREAK &&
+           ++m_last_entry->skipped_cull_tests % CULL_TEST_INTERVAL != 0;
+  }
+
+  void SetLastDrawCulled(bool culled)
+  {
+    if (!m_last_entry)
+      return;
+    if (culled)
+      m_last_entry->visible_streak = 0;
+    else if (m_last_entry->visible_streak < VISIBLE_STREAK)
+      m_last_entry->visible_streak++;
+  }
+
+  void Clear()
+  {
+    m_entries.clear();
+    m_size = 0;
+    m_last_entry = nullptr;
+  }
+
+private:
+  struct Key
+  {
+    const VertexLoaderBase* loader;
+    int count;
+    u64 hash;
+
+    bool operator==(const Key&) const = default;
+  };
+  struct KeyHash
+  {
+    size_t operator()(const Key& key) const { return key.hash; }
+  };
+
+  struct Entry
+  {
+    std::vector<u8> data;
+    u8 visible_streak = 0;
+    u8 skipped_cull_tests = 0;
+  };
+
+  // Elements of unordered_maps don't move, so this stays valid until the cache is cleared
+  Entry* m_last_entry = nullptr;
+  std::unordered_map<Key, Entry, KeyHash> m_entries;
+  size_t m_size = 0;
+};
+
+ConvertedVertexCache s_converted_vertex_cache;
+}  // namespace
+
 void Init()
 {
   MarkAllDirty();
@@ -71,11 +287,122 @@ void Init()
   SETSTAT(g_stats.num_vertex_loaders, 0);
 }
 
+static void PrecompileLoaders(std::vector<VertexLoaderUID> uids)
+{
+  Common::SetCurrentThreadName("Vertex loader precompiler");
+
+  for (const VertexLoaderUID& uid : uids)
+  {
+    if (s_precompile_cancelled.load(std::memory_order_relaxed))
+      return;
+
+    {
+      std::lock_guard<std::mutex> lk(s_vertex_loader_map_lock);
+      if (s_vertex_loader_map.contains(uid))
+        continue;
+    }
+
+    // Generated outside of the lock so that the GPU thread can keep creating loaders meanwhile
+    std::unique_ptr<VertexLoaderBase> loader =
+        VertexLoaderBase::CreateVertexLoader(uid.GetVertexDesc(), uid.GetVertexAttributes());
+
+    std::lock_guard<std::mutex> lk(s_vertex_loader_map_lock);
+    if (s_vertex_loader_map.try_emplace(uid, std::move(loader)).second)
+      INCSTAT(g_stats.num_vertex_loaders);
+  }
+}
+
+static void AppendLoaderUID(const VertexLoaderUID& uid)
+{
+  if (!s_loader_uid_cache_file.IsOpen() || !s_cached_loader_uids.insert(uid).second)
+    return;
+
+  if (!s_loader_uid_cache_file.WriteArray(uid.GetData()))
+  {
+    WARN_LOG_FMT(VIDEO, "Writing vertex loader UID to cache failed, closing file.");
+    s_loader_uid_cache_file.Close();
+  }
+}
+
+void LoadLoaderUIDCache()
+{
+  constexpr u32 CACHE_FILE_MAGIC = 0x44495556;  // VUID
+  constexpr u32 CACHE_FILE_VERSION = 1;
+  using SerializedUID = std::array<u32, 5>;
+
+  if (!g_ActiveConfig.bShaderCache)
+    return;
+
+  const std::string filename =
+      File::GetUserPath(D_CACHE_IDX) + SConfig::GetInstance().GetGameID() + ".vtxuidcache";
+
+  std::vector<VertexLoaderUID> uids;
+  std::lock_guard<std::mutex> lk(s_vertex_loader_map_lock);
+  if (s_loader_uid_cache_file.Open(filename, "rb+"))
+  {
+    u32 magic;
+    u32 version;
+    bool valid = false;
+    if (s_loader_uid_cache_file.ReadArray(&magic, 1) &&
+        s_loader_uid_cache_file.ReadArray(&version, 1) && magic == CACHE_FILE_MAGIC &&
+        version == CACHE_FILE_VERSION)
+    {
+      const u64 data_size = s_loader_uid_cache_file.GetSize() - 2 * sizeof(u32);
+      std::vector<SerializedUID> data(data_size / sizeof(SerializedUID));
+      valid = data_size % sizeof(SerializedUID) == 0 &&
+              s_loader_uid_cache_file.ReadArray(data.data(), data.size());
+      if (valid)
+      {
+        for (const SerializedUID& serialized_uid : data)
+        {
+          const VertexLoaderUID uid(serialized_uid);
+          if (s_cached_loader_uids.insert(uid).second)
+            uids.push_back(uid);
+        }
+      }
+    }
+
+    // The file is open for reading and writing, so new UIDs are appended at the end
+    if (!valid)
+    {
+      s_loader_uid_cache_file.Close();
+      s_cached_loader_uids.clear();
+      uids.clear();
+    }
+  }
+
+  if (!s_loader_uid_cache_file.IsOpen() && s_loader_uid_cache_file.Open(filename, "wb"))
+  {
+    s_loader_uid_cache_file.WriteArray(&CACHE_FILE_MAGIC, 1);
+    s_loader_uid_cache_file.WriteArray(&CACHE_FILE_VERSION, 1);
+    for (const auto& it : s_vertex_loader_map)
+      AppendLoaderUID(it.first);
+  }
+
+  INFO_LOG_FMT(VIDEO, "Read {} vertex loader UIDs from {}", uids.size(), filename);
+
+  if (!uids.empty())
+  {
+    s_precompile_cancelled.store(false, std::memory_order_relaxed);
+    s_precompile_thread = std::thread(PrecompileLoaders, std::move(uids));
+  }
+}
+
 void Clear()
 {
+  if (s_precompile_thread.joinable())
+  {
+    s_precompile_cancelled.store(true, std::memory_order_relaxed);
+    s_precompile_thread.join();
+  }
+
   std::lock_guard<std::mutex> lk(s_vertex_loader_map_lock);
+  s_loader_uid_cache_file.Close();
+  s_cached_loader_uids.clear();
   s_vertex_loader_map.clear();
   s_native_vertex_map.clear();
+  s_parallel_vertex_loader.Shutdown();
+  s_converted_vertex_cache.Clear();
 }
 
 void UpdateVertexArrayPointers()
@@ -238,6 +565,7 @@ VertexLoaderBase* GetOrCreateLoader(int vtx_attr_group)
         VertexLoaderBase::CreateVertexLoader(state->vtx_desc, state->vtx_attr[vtx_attr_group]));
     loader = it->second.get();
     INCSTAT(g_stats.num_vertex_loaders);
+    AppendLoaderUID(uid);
   }
   if (check_for_native_format)
   {
@@ -334,12 +662,15 @@ static void CheckCPConfiguration(int vtx_attr_group)
 }
 
 template <bool IsPreprocess>
-int RunVertices(int vtx_attr_group, OpcodeDecoder::Primitive primitive, int count, const u8* src)
+int RunVertices(int vtx_attr_group, OpcodeDecoder::Primitive primitive, int count, const u8* src,
+                bool in_display_list)
 {
   if (count == 0) [[unlikely]]
     return 0;
   ASSERT(count > 0);
 
+  FrameProfiler::Scope profile_scope(FrameProfiler::Stage::VertexLoad, !IsPreprocess);
+
   VertexLoaderBase* loader = RefreshLoader<IsPreprocess>(vtx_attr_group);
 
   int size = count * loader->m_vertex_size;
@@ -363,6 +694,7 @@ int RunVertices(int vtx_attr_group, OpcodeDecoder::Primitive primitive, int coun
 
       s_current_vtx_fmt = loader->m_native_vertex_format;
       g_current_components = loader->m_native_components;
+      g_vertex_manager->SetShaderUidsChanged();
       auto& system = Core::System::GetInstance();
       auto& vertex_shader_manager = system.GetVertexShaderManager();
       vertex_shader_manager.SetVertexFormat(loader->m_native_components,
@@ -385,11 +717,33 @@ int RunVertices(int vtx_attr_group, OpcodeDecoder::Primitive primitive, int coun
     DataReader dst = g_vertex_manager->PrepareForAdditionalData(primitive, count, stride,
                                                                 cullall || can_cpu_cull);
 
-    count = loader->RunVertices(src, dst.GetPointer(), count);
+    const auto convert = [&](u8* out) {
+      if (s_parallel_vertex_loader.CanRun(loader, count))
+        return s_parallel_vertex_loader.Run(loader, src, out, count);
+      return loader->RunVertices(src, out, count);
+    };
+
+    const bool use_cache = in_display_list && ConvertedVertexCache::CanCache(loader, count);
+    if (use_cache)
+      count = s_converted_vertex_cache.Run(loader, src, dst.GetPointer(), count, convert);
+    else
+      count = convert(dst.GetPointer());
+
+    // Must happen before culling moves the vertices.
+    if (!cullall && g_ActiveConfig.bBBoxCPUEstimate && g_bounding_box->IsEnabled() &&
+        g_ActiveConfig.bBBoxEnable && g_ActiveConfig.backend_info.bSupportsBBox)
+    {
+      g_vertex_manager->EstimateBoundingBox(loader, primitive, dst.GetPointer(), count);
+    }
 
     if (can_cpu_cull && !cullall)
     {
-      if (!g_vertex_manager->AreAllVerticesCulled(loader, primitive, dst.GetPointer(), count))
+      const bool test = !use_cache || !s_converted_vertex_cache.IsLastDrawLikelyVisible();
+      const bool culled = test && g_vertex_manager->AreAllVerticesCulled(loader, primitive,
+                                                                         dst.GetPointer(), count);
+      if (use_cache && test)
+        s_converted_vertex_cache.SetLastDrawCulled(culled);
+      if (!culled)
       {
         DataReader new_dst = g_vertex_manager->DisableCullAll(stride);
         memmove(new_dst.GetPointer(), dst.GetPointer(), count * stride);
@@ -406,9 +760,9 @@ int RunVertices(int vtx_attr_group, OpcodeDecoder::Primitive primitive, int coun
 }
 
 template int RunVertices<false>(int vtx_attr_group, OpcodeDecoder::Primitive primitive, int count,
-                                const u8* src);
+                                const u8* src, bool in_display_list);
 template int RunVertices<true>(int vtx_attr_group, OpcodeDecoder::Primitive primitive, int count,
-                               const u8* src);
+                               const u8* src, bool in_display_list);
 
 NativeVertexFormat* GetCurrentVertexFormat()
 {
@@ -30,6 +30,11 @@ void Clear();
 
 void MarkAllDirty();
 
+// Opens the list of the loaders the current game used in earlier sessions, and starts creating
+// them on a background thread, so that the first draws of a scene don't wait for them.
+// New loaders are appended to the list until Clear() is called.
+void LoadLoaderUIDCache();
+
 // Creates or obtains a pointer to a VertexFormat representing decl.
 // If this results in a VertexFormat being created, if the game later uses a matching vertex
 // declaration, the one that was previously created will be used.
@@ -40,9 +45,11 @@ NativeVertexFormat* GetOrCreateMatchingFormat(const PortableVertexDeclaration& d
 // offsets set to the unused attributes.
 NativeVertexFormat* GetUberVertexFormat(const PortableVertexDeclaration& decl);
 
-// Returns -1 if buf_size is insufficient, else the amount of bytes consumed
+// Returns -1 if buf_size is insufficient, else the amount of bytes consumed.
+// The converted vertices of draws in display lists may be cached.
 template <bool IsPreprocess = false>
-int RunVertices(int vtx_attr_group, OpcodeDecoder::Primitive primitive, int count, const u8* src);
+int RunVertices(int vtx_attr_group, OpcodeDecoder::Primitive primitive, int count, const u8* src,
+                bool in_display_list = false);
 
 namespace detail
 {
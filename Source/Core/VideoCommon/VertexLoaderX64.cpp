@@ -3,6 +3,7 @@
 
 #include "VideoCommon/VertexLoaderX64.h"
 
+#include <algorithm>
 #include <array>
 #include <cstring>
 #include <string>
@@ -30,6 +31,11 @@ static const X64Reg scratch3 = ABI_PARAM4;
 static const X64Reg remaining_reg = R10;
 static const X64Reg skipped_reg = R11;
 static const X64Reg base_reg = RBX;
+// Base and stride of each of VertexLoaderX64::m_cached_arrays
+static constexpr std::array<std::pair<X64Reg, X64Reg>, 2> cached_array_regs = {{
+    {R12, R13},
+    {R14, R15},
+}};
 
 static const u8* memory_base_ptr = (u8*)&g_main_cp_state.array_strides;
 
@@ -68,6 +74,16 @@ OpArg VertexLoaderX64::GetVertexAddr(CPArray array, VertexComponentFormat attrib
       CMP(bits, R(scratch1), Imm8(-1));
       m_skip_vertex = J_CC(CC_E, Jump::Near);
     }
+
+    const auto cached_end = m_cached_arrays.begin() + m_num_cached_arrays;
+    const auto cached = std::find(m_cached_arrays.begin(), cached_end, array);
+    if (cached != cached_end)
+    {
+      const auto [array_base, array_stride] = cached_array_regs[cached - m_cached_arrays.begin()];
+      IMUL(32, scratch1, R(array_stride));
+      return MRegSum(scratch1, array_base);
+    }
+
     IMUL(32, scratch1, MPIC(&g_main_cp_state.array_strides[array]));
     MOV(64, R(scratch2), MPIC(&VertexLoaderManager::cached_arraybases[array]));
     return MRegSum(scratch1, scratch2);
@@ -401,6 +417,16 @@ void VertexLoaderX64::GenerateVertexLoader()
 {
   BitSet32 regs = {src_reg,  dst_reg,       scratch1,    scratch2,
                    scratch3, remaining_reg, skipped_reg, base_reg};
+
+  const std::vector<CPArray> indexed_arrays = GetIndexedArrays();
+  m_num_cached_arrays = std::min(indexed_arrays.size(), m_cached_arrays.size());
+  for (size_t i = 0; i < m_num_cached_arrays; i++)
+  {
+    m_cached_arrays[i] = indexed_arrays[i];
+    regs[cached_array_regs[i].first] = true;
+    regs[cached_array_regs[i].second] = true;
+  }
+
   regs &= ABI_ALL_CALLEE_SAVED;
   regs[RBP] = true;  // Give us a stack frame
   ABI_PushRegistersAndAdjustStack(regs, 0);
@@ -418,7 +444,12 @@ void VertexLoaderX64::GenerateVertexLoader()
   if (IsIndexed(m_VtxDesc.low.Position))
     XOR(32, R(skipped_reg), R(skipped_reg));
 
-  // TODO: load constants into registers outside the main loop
+  for (size_t i = 0; i < m_num_cached_arrays; i++)
+  {
+    const auto [array_base, array_stride] = cached_array_regs[i];
+    MOV(64, R(array_base), MPIC(&VertexLoaderManager::cached_arraybases[m_cached_arrays[i]]));
+    MOV(32, R(array_stride), MPIC(&g_main_cp_state.array_strides[m_cached_arrays[i]]));
+  }
 
   const u8* loop_start = GetCodePtr();
 
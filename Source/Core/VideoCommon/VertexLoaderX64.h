@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <array>
+
 #include "Common/CommonTypes.h"
 #include "Common/x64Emitter.h"
 #include "VideoCommon/VertexLoaderBase.h"
@@ -19,11 +21,15 @@ public:
 
 protected:
   int RunVertices(const u8* src, u8* dst, int count) override;
+  bool IsReentrant() const override { return true; }
 
 private:
   u32 m_src_ofs = 0;
   u32 m_dst_ofs = 0;
   Gen::FixupBranch m_skip_vertex;
+  // The first indexed arrays, whose bases and strides are kept in registers during the loop
+  std::array<CPArray, 2> m_cached_arrays{};
+  size_t m_num_cached_arrays = 0;
   Gen::OpArg GetVertexAddr(CPArray array, VertexComponentFormat attribute);
   void ReadVertex(Gen::OpArg data, VertexComponentFormat attribute, ComponentFormat format,
                   int count_in, int count_out, bool dequantize, u8 scaling_exponent,
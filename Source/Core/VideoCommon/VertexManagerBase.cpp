@@ -6,12 +6,14 @@
 #include <array>
 #include <cmath>
 #include <memory>
+#include <string_view>
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 #include "Common/EnumMap.h"
 #include "Common/Logging/Log.h"
 #include "Common/MathUtil.h"
+#include "Common/SmallVector.h"
 
 #include "Core/ConfigManager.h"
 #include "Core/DolphinAnalytics.h"
@@ -19,9 +21,11 @@
 #include "Core/System.h"
 
 #include "VideoCommon/AbstractGfx.h"
+#include "VideoCommon/BPFunctions.h"
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/BoundingBox.h"
 #include "VideoCommon/DataReader.h"
+#include "VideoCommon/FrameProfiler.h"
 #include "VideoCommon/FramebufferManager.h"
 #include "VideoCommon/GeometryShaderManager.h"
 #include "VideoCommon/GraphicsModSystem/Runtime/CustomShaderCache.h"
@@ -141,6 +145,23 @@ bool VertexManagerBase::AreAllVerticesCulled(VertexLoaderBase* loader,
   return m_cpu_cull.AreAllVerticesCulled(loader, primitive, src, count);
 }
 
+void VertexManagerBase::EstimateBoundingBox(VertexLoaderBase* loader,
+                                            OpcodeDecoder::Primitive primitive, const u8* src,
+                                            u32 count)
+{
+  // Lines and points are widened around their vertices, so they aren't estimated.
+  MathUtil::Rectangle<int> bounds;
+  if (primitive < OpcodeDecoder::Primitive::GX_DRAW_LINES &&
+      m_cpu_cull.GetEFBBounds(loader, src, count, &bounds))
+  {
+    g_bounding_box->AddEstimatedBounds(bounds);
+  }
+  else
+  {
+    g_bounding_box->AddUnboundedDraw();
+  }
+}
+
 DataReader VertexManagerBase::PrepareForAdditionalData(OpcodeDecoder::Primitive primitive,
                                                        u32 count, u32 stride, bool cullall)
 {
@@ -161,6 +182,7 @@ DataReader VertexManagerBase::PrepareForAdditionalData(OpcodeDecoder::Primitive
     // Have to update the rasterization state for point/line cull modes.
     m_current_primitive_type = new_primitive_type;
     SetRasterizationStateChanged();
+    SetShaderUidsChanged();
   }
 
   u32 remaining_indices = GetRemainingIndices(primitive);
@@ -550,8 +572,11 @@ void VertexManagerBase::Flush()
   CalculateBinormals(VertexLoaderManager::GetCurrentVertexFormat());
   // Calculate ZSlope for zfreeze
   const auto used_textures = UsedTextures();
-  std::vector<std::string> texture_names;
-  std::vector<u32> texture_units;
+  // This runs for every draw, so none of these allocate. The texture cache keeps the entries of
+  // the bound textures, and so their names, alive until the next draw.
+  Common::SmallVector<std::string_view, 8> texture_names;
+  Common::SmallVector<u64, 8> texture_hashes;
+  Common::SmallVector<u32, 8> texture_units;
   if (!m_cull_all)
   {
     if (!g_ActiveConfig.bGraphicMods)
@@ -572,13 +597,15 @@ void VertexManagerBase::Flush()
                         cache_entry->texture_info_name) == texture_names.end())
           {
             texture_names.push_back(cache_entry->texture_info_name);
+            texture_hashes.push_back(cache_entry->texture_info_hash);
             texture_units.push_back(i);
           }
         }
       }
     }
   }
-  vertex_shader_manager.SetConstants(texture_names);
+  vertex_shader_manager.SetConstants({texture_names.data(), texture_names.size()},
+                                     {texture_hashes.data(), texture_hashes.size()});
   if (!bpmem.genMode.zfreeze)
   {
     // Must be done after VertexShaderManager::SetConstants()
@@ -594,15 +621,16 @@ void VertexManagerBase::Flush()
   {
     CustomPixelShaderContents custom_pixel_shader_contents;
     std::optional<CustomPixelShader> custom_pixel_shader;
-    std::vector<std::string> custom_pixel_texture_names;
+    std::vector<std::string_view> custom_pixel_texture_names;
     std::span<u8> custom_pixel_shader_uniforms;
     for (int i = 0; i < texture_names.size(); i++)
     {
-      const std::string& texture_name = texture_names[i];
+      const std::string_view texture_name = texture_names[i];
       const u32 texture_unit = texture_units[i];
       bool skip = false;
       GraphicsModActionData::DrawStarted draw_started{texture_unit, &skip, &custom_pixel_shader};
-      for (const auto& action : g_graphics_mod_manager->GetDrawStartedActions(texture_name))
+      for (const auto& action :
+           g_graphics_mod_manager->GetDrawStartedActions(texture_name, texture_hashes[i]))
       {
         action->OnDrawStarted(&draw_started);
         if (custom_pixel_shader)
@@ -729,7 +757,15 @@ void VertexManagerBase::Flush()
       OnDraw();
 
       // The EFB cache is now potentially stale.
-      g_framebuffer_manager->FlagPeekCacheAsOutOfDate();
+      if (g_framebuffer_manager->IsTrackingPeekCacheTiles())
+      {
+        g_framebuffer_manager->FlagPeekCacheAsOutOfDate(
+            BPFunctions::ComputeScissorRects().Best().rect);
+      }
+      else
+      {
+        g_framebuffer_manager->FlagPeekCacheAsOutOfDate();
+      }
     }
   }
 
@@ -747,6 +783,7 @@ void VertexManagerBase::DoState(PointerWrap& p)
   {
     // Flush old vertex data before loading state.
     Flush();
+    SetShaderUidsChanged();
   }
 
   p.Do(m_zslope);
@@ -858,28 +895,35 @@ void VertexManagerBase::UpdatePipelineConfig()
     m_pipeline_config_changed = true;
   }
 
-  VertexShaderUid vs_uid = GetVertexShaderUid();
-  if (vs_uid != m_current_pipeline_config.vs_uid)
+  if (m_shader_uids_changed)
   {
-    m_current_pipeline_config.vs_uid = vs_uid;
-    m_current_uber_pipeline_config.vs_uid = UberShader::GetVertexShaderUid();
-    m_pipeline_config_changed = true;
-  }
+    m_shader_uids_changed = false;
 
-  PixelShaderUid ps_uid = GetPixelShaderUid();
-  if (ps_uid != m_current_pipeline_config.ps_uid)
-  {
-    m_current_pipeline_config.ps_uid = ps_uid;
-    m_current_uber_pipeline_config.ps_uid = UberShader::GetPixelShaderUid();
-    m_pipeline_config_changed = true;
-  }
+    VertexShaderUid vs_uid = GetVertexShaderUid();
+    if (vs_uid != m_current_pipeline_config.vs_uid)
+    {
+      m_current_pipeline_config.vs_uid = vs_uid;
+      m_current_uber_pipeline_config.vs_uid = UberShader::GetVertexShaderUid();
+      m_pipeline_config_changed = true;
+    }
 
-  GeometryShaderUid gs_uid = GetGeometryShaderUid(GetCurrentPrimitiveType());
-  if (gs_uid != m_current_pipeline_config.gs_uid)
-  {
-    m_current_pipeline_config.gs_uid = gs_uid;
-    m_current_uber_pipeline_config.gs_uid = gs_uid;
-    m_pipeline_config_changed = true;
+    PixelShaderUid ps_uid = GetPixelShaderUid();
+    if (ps_uid != m_current_pipeline_config.ps_uid)
+    {
+      m_current_pipeline_config.ps_uid = ps_uid;
+      m_current_uber_pipeline_config.ps_uid = UberShader::GetPixelShaderUid();
+      m_current_partial_uber_ps_uid =
+          UberShader::GetPartiallySpecializedPixelShaderUid(m_current_uber_pipeline_config.ps_uid);
+      m_pipeline_config_changed = true;
+    }
+
+    GeometryShaderUid gs_uid = GetGeometryShaderUid(GetCurrentPrimitiveType());
+    if (gs_uid != m_current_pipeline_config.gs_uid)
+    {
+      m_current_pipeline_config.gs_uid = gs_uid;
+      m_current_uber_pipeline_config.gs_uid = gs_uid;
+      m_pipeline_config_changed = true;
+    }
   }
 
   if (m_rasterization_state_changed)
@@ -930,6 +974,8 @@ void VertexManagerBase::UpdatePipelineObject()
   if (!m_pipeline_config_changed)
     return;
 
+  FrameProfiler::Scope profile_scope(FrameProfiler::Stage::ShaderLookup);
+
   m_current_pipeline_object = nullptr;
   m_pipeline_config_changed = false;
 
@@ -964,9 +1010,10 @@ void VertexManagerBase::UpdatePipelineObject()
 
     if (g_ActiveConfig.iShaderCompilationMode == ShaderCompilationMode::AsynchronousUberShaders)
     {
-      // Specialized shaders not ready, use the ubershaders.
-      m_current_pipeline_object =
-          g_shader_cache->GetUberPipelineForUid(m_current_uber_pipeline_config);
+      // Specialized shaders not ready, use the smallest ubershader that can draw this.
+      VideoCommon::GXUberPipelineUid partial_uid = m_current_uber_pipeline_config;
+      partial_uid.ps_uid = m_current_partial_uber_ps_uid;
+      m_current_pipeline_object = g_shader_cache->GetPartialUberPipelineForUid(partial_uid);
     }
     else
     {
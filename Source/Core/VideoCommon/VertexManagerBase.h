@@ -105,6 +105,9 @@ public:
   void AddIndices(OpcodeDecoder::Primitive primitive, u32 num_vertices);
   bool AreAllVerticesCulled(VertexLoaderBase* loader, OpcodeDecoder::Primitive primitive,
                             const u8* src, u32 count);
+  // Passes the bounds of the vertices to the bounding box, see BoundingBox::AddEstimatedBounds
+  void EstimateBoundingBox(VertexLoaderBase* loader, OpcodeDecoder::Primitive primitive,
+                           const u8* src, u32 count);
   virtual DataReader PrepareForAdditionalData(OpcodeDecoder::Primitive primitive, u32 count,
                                               u32 stride, bool cullall);
   /// Switch cullall off after a call to PrepareForAdditionalData with cullall true
@@ -121,6 +124,7 @@ public:
   FlushStatistics ResetFlushAspectRatioCount();
 
   // State setters, called from register update functions.
+  void SetShaderUidsChanged() { m_shader_uids_changed = true; }
   void SetRasterizationStateChanged() { m_rasterization_state_changed = true; }
   void SetDepthStateChanged() { m_depth_state_changed = true; }
   void SetBlendingStateChanged() { m_blending_state_changed = true; }
@@ -128,6 +132,7 @@ public:
   {
     m_current_pipeline_object = nullptr;
     m_pipeline_config_changed = true;
+    m_shader_uids_changed = true;
   }
   void NotifyCustomShaderCacheOfHostChange(const ShaderHostConfig& host_config);
 
@@ -203,9 +208,12 @@ protected:
 
   VideoCommon::GXPipelineUid m_current_pipeline_config;
   VideoCommon::GXUberPipelineUid m_current_uber_pipeline_config;
+  UberShader::PixelShaderUid m_current_partial_uber_ps_uid;
   const AbstractPipeline* m_current_pipeline_object = nullptr;
   PrimitiveType m_current_primitive_type = PrimitiveType::Points;
   bool m_pipeline_config_changed = true;
+  // The shader UIDs are only generated again after a write to a register they're generated from
+  bool m_shader_uids_changed = true;
   bool m_rasterization_state_changed = true;
   bool m_depth_state_changed = true;
   bool m_blending_state_changed = true;
@@ -363,8 +363,11 @@ ShaderCode GenerateVertexShaderCode(APIType api_type, const ShaderHostConfig& ho
     out.Write("float3 _tangent = float3(0.0, 0.0, 0.0);\n");
   }
 
-  out.Write("o.pos = float4(dot(" I_PROJECTION "[0], pos), dot(" I_PROJECTION
-            "[1], pos), dot(" I_PROJECTION "[2], pos), dot(" I_PROJECTION "[3], pos));\n");
+  out.Write("float4 view_pos = float4(dot(" I_FREELOOKVIEW "[0], pos), dot(" I_FREELOOKVIEW
+            "[1], pos), dot(" I_FREELOOKVIEW "[2], pos), dot(" I_FREELOOKVIEW "[3], pos));\n");
+  out.Write("o.pos = float4(dot(" I_PROJECTION "[0], view_pos), dot(" I_PROJECTION
+            "[1], view_pos), dot(" I_PROJECTION "[2], view_pos), dot(" I_PROJECTION
+            "[3], view_pos));\n");
 
   out.Write("int4 lacc;\n"
             "float3 ldir, h, cosAttn, distAttn;\n"
@@ -31,6 +31,13 @@
 #include "VideoCommon/VideoConfig.h"
 #include "VideoCommon/XFMemory.h"
 
+static Common::Matrix44 MatrixFromRows(const std::array<float4, 4>& rows)
+{
+  Common::Matrix44 matrix;
+  std::memcpy(matrix.data.data(), rows.data(), sizeof(matrix.data));
+  return matrix;
+}
+
 void VertexShaderManager::Init()
 {
   // Initialize state tracking variables
@@ -53,6 +60,10 @@ void VertexShaderManager::Init()
   // TODO: should these go inside ResetView()?
   m_viewport_correction = Common::Matrix44::Identity();
   m_projection_matrix = Common::Matrix44::Identity().data;
+  m_freelook_view = Common::Matrix44::Identity();
+  m_clip_transform = Common::Matrix44::Identity();
+  std::memcpy(constants.freelook_view.data(), m_freelook_view.data.data(),
+              sizeof(constants.freelook_view));
 
   dirty = true;
 }
@@ -137,24 +148,46 @@ Common::Matrix44 VertexShaderManager::LoadProjectionMatrix()
   PRIM_LOG("Projection: {} {} {} {} {} {}", rawProjection[0], rawProjection[1], rawProjection[2],
            rawProjection[3], rawProjection[4], rawProjection[5]);
 
-  auto corrected_matrix = m_viewport_correction * Common::Matrix44::FromArray(m_projection_matrix);
+  // The free look view is applied separately, see UpdateFreeLookView(). Only its field of view
+  // is part of the projection.
+  g_freelook_camera.GetController()->SetClean();
 
-  if (g_freelook_camera.IsActive() && xfmem.projection.type == ProjectionType::Perspective)
-    corrected_matrix *= g_freelook_camera.GetView();
+  return m_viewport_correction * Common::Matrix44::FromArray(m_projection_matrix);
+}
 
-  g_freelook_camera.GetController()->SetClean();
+void VertexShaderManager::UpdateFreeLookView(bool projection_changed)
+{
+  const bool use_view =
+      g_freelook_camera.IsActive() && xfmem.projection.type == ProjectionType::Perspective;
+  const Common::Matrix44 view =
+      use_view ? g_freelook_camera.GetView() : Common::Matrix44::Identity();
 
-  return corrected_matrix;
+  if (view.data != m_freelook_view.data)
+  {
+    m_freelook_view = view;
+    std::memcpy(constants.freelook_view.data(), view.data.data(), sizeof(constants.freelook_view));
+    dirty = true;
+  }
+  else if (!projection_changed)
+  {
+    return;
+  }
+
+  m_clip_transform = MatrixFromRows(constants.projection) * m_freelook_view;
 }
 
 void VertexShaderManager::SetProjectionMatrix()
 {
+  bool projection_changed = false;
   if (m_projection_changed || g_freelook_camera.GetController()->IsDirty())
   {
     m_projection_changed = false;
     auto corrected_matrix = LoadProjectionMatrix();
     memcpy(constants.projection.data(), corrected_matrix.data.data(), 4 * sizeof(float4));
+    projection_changed = true;
+    dirty = true;
   }
+  UpdateFreeLookView(projection_changed);
 }
 
 bool VertexShaderManager::UseVertexDepthRange()
@@ -178,7 +211,8 @@ bool VertexShaderManager::UseVertexDepthRange()
 
 // Syncs the shader constant buffers with xfmem
 // TODO: A cleaner way to control the matrices without making a mess in the parameters field
-void VertexShaderManager::SetConstants(const std::vector<std::string>& textures)
+void VertexShaderManager::SetConstants(std::span<const std::string_view> textures,
+                                       std::span<const u64> texture_hashes)
 {
   if (constants.missing_color_hex != g_ActiveConfig.iMissingColorValue)
   {
@@ -403,7 +437,9 @@ void VertexShaderManager::SetConstants(const std::vector<std::string>& textures)
     g_stats.AddScissorRect();
   }
 
-  std::vector<GraphicsModAction*> projection_actions;
+  // Reused, so that this doesn't allocate for every draw
+  std::vector<GraphicsModAction*>& projection_actions = m_projection_actions;
+  projection_actions.clear();
   if (g_ActiveConfig.bGraphicMods)
   {
     for (const auto& action : g_graphics_mod_manager->GetProjectionActions(xfmem.projection.type))
@@ -411,16 +447,17 @@ void VertexShaderManager::SetConstants(const std::vector<std::string>& textures)
       projection_actions.push_back(action);
     }
 
-    for (const auto& texture : textures)
+    for (size_t i = 0; i < textures.size(); ++i)
     {
-      for (const auto& action :
-           g_graphics_mod_manager->GetProjectionTextureActions(xfmem.projection.type, texture))
+      for (const auto& action : g_graphics_mod_manager->GetProjectionTextureActions(
+               xfmem.projection.type, textures[i], texture_hashes[i]))
       {
         projection_actions.push_back(action);
       }
     }
   }
 
+  bool projection_changed = false;
   if (m_projection_changed || g_freelook_camera.GetController()->IsDirty() ||
       !projection_actions.empty() || m_projection_graphics_mod_change)
   {
@@ -437,8 +474,10 @@ void VertexShaderManager::SetConstants(const std::vector<std::string>& textures)
 
     memcpy(constants.projection.data(), corrected_matrix.data.data(), 4 * sizeof(float4));
 
+    projection_changed = true;
     dirty = true;
   }
+  UpdateFreeLookView(projection_changed);
 
   if (m_tex_mtx_info_changed)
   {
@@ -660,6 +699,8 @@ void VertexShaderManager::DoState(PointerWrap& p)
 {
   p.DoArray(m_projection_matrix);
   p.Do(m_viewport_correction);
+  p.Do(m_freelook_view);
+  p.Do(m_clip_transform);
   g_freelook_camera.DoState(p);
 
   p.DoArray(m_minmax_transform_matrices_changed);
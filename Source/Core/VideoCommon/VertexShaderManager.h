@@ -4,7 +4,8 @@
 #pragma once
 
 #include <array>
-#include <string>
+#include <span>
+#include <string_view>
 #include <vector>
 
 #include "Common/BitSet.h"
@@ -13,6 +14,7 @@
 #include "VideoCommon/ConstantManager.h"
 #include "VideoCommon/NativeVertexFormat.h"
 
+class GraphicsModAction;
 class PointerWrap;
 struct PortableVertexDeclaration;
 
@@ -26,7 +28,9 @@ public:
 
   // constant management
   void SetProjectionMatrix();
-  void SetConstants(const std::vector<std::string>& textures);
+  // The textures of the draw, with the hashes of their names that graphics mods look them up by
+  void SetConstants(std::span<const std::string_view> textures,
+                    std::span<const u64> texture_hashes);
 
   void InvalidateXFRange(int start, int end);
   void SetTexMatrixChangedA(u32 value);
@@ -46,6 +50,9 @@ public:
 
   static bool UseVertexDepthRange();
 
+  // The projection followed by the free look view, as the vertex shader applies them
+  const float* GetClipTransform() const { return m_clip_transform.data.data(); }
+
   VertexShaderConstants constants{};
   bool dirty = false;
 
@@ -107,5 +114,12 @@ private:
 
   Common::Matrix44 m_viewport_correction{};
 
+  std::vector<GraphicsModAction*> m_projection_actions;
+
+  // The free look view is its own constant, so moving the camera doesn't recompute the projection
+  Common::Matrix44 m_freelook_view{};
+  alignas(16) Common::Matrix44 m_clip_transform{};
+
   Common::Matrix44 LoadProjectionMatrix();
+  void UpdateFreeLookView(bool projection_changed);
 };
@@ -157,11 +157,21 @@ u32 VideoBackendBase::Video_GetQueryResult(PerfQueryType type)
     return 0;
   }
 
+  AsyncRequests::Event e;
+  e.time = 0;
+
+  if (g_ActiveConfig.bPerfQueriesAsync)
+  {
+    // Return what the GPU thread has collected so far, which lags behind by the queries that are
+    // still in flight, and have it collect the finished ones for the next read.
+    e.type = AsyncRequests::Event::PERF_QUERY_POLL;
+    AsyncRequests::GetInstance()->PushEvent(e, false);
+    return g_perf_query->GetQueryResult(type);
+  }
+
   auto& system = Core::System::GetInstance();
   system.GetFifo().SyncGPU(Fifo::SyncGPUReason::PerfQuery);
 
-  AsyncRequests::Event e;
-  e.time = 0;
   e.type = AsyncRequests::Event::PERF_QUERY;
 
   if (!g_perf_query->IsFlushed())
@@ -391,6 +401,7 @@ bool VideoBackendBase::InitializeShared(std::unique_ptr<AbstractGfx> gfx,
   UpdateActiveConfig();
 
   g_shader_cache->InitializeShaderCache();
+  VertexLoaderManager::LoadLoaderUIDCache();
 
   return true;
 }
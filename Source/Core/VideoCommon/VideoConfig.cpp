@@ -79,6 +79,7 @@ void VideoConfig::Refresh()
   }
 
   bVSync = Config::Get(Config::GFX_VSYNC);
+  bFramePacing = Config::Get(Config::GFX_FRAME_PACING);
   iAdapter = Config::Get(Config::GFX_ADAPTER);
   iManuallyUploadBuffers = Config::Get(Config::GFX_MTL_MANUALLY_UPLOAD_BUFFERS);
   iUsePresentDrawable = Config::Get(Config::GFX_MTL_USE_PRESENT_DRAWABLE);
@@ -96,6 +97,7 @@ void VideoConfig::Refresh()
       Config::Get(Config::GFX_WIDESCREEN_HEURISTIC_WIDESCREEN_RATIO);
   bCrop = Config::Get(Config::GFX_CROP);
   iSafeTextureCache_ColorSamples = Config::Get(Config::GFX_SAFE_TEXTURE_CACHE_COLOR_SAMPLES);
+  iTextureCacheMemoryBudget = Config::Get(Config::GFX_TEXTURE_CACHE_MEMORY_BUDGET);
   bShowFPS = Config::Get(Config::GFX_SHOW_FPS);
   bShowFTimes = Config::Get(Config::GFX_SHOW_FTIMES);
   bShowVPS = Config::Get(Config::GFX_SHOW_VPS);
@@ -103,6 +105,9 @@ void VideoConfig::Refresh()
   bShowGraphs = Config::Get(Config::GFX_SHOW_GRAPHS);
   bShowSpeed = Config::Get(Config::GFX_SHOW_SPEED);
   bShowSpeedColors = Config::Get(Config::GFX_SHOW_SPEED_COLORS);
+  bShowDiscCacheStats = Config::Get(Config::GFX_SHOW_DISC_CACHE_STATS);
+  bShowShaderCompilerStats = Config::Get(Config::GFX_SHOW_SHADER_COMPILER_STATS);
+  bShowAudioStats = Config::Get(Config::GFX_SHOW_AUDIO_STATS);
   iPerfSampleUSec = Config::Get(Config::GFX_PERF_SAMP_WINDOW) * 1000;
   bShowNetPlayPing = Config::Get(Config::GFX_SHOW_NETPLAY_PING);
   bShowNetPlayMessages = Config::Get(Config::GFX_SHOW_NETPLAY_MESSAGES);
@@ -141,6 +146,7 @@ void VideoConfig::Refresh()
   bEnableValidationLayer = Config::Get(Config::GFX_ENABLE_VALIDATION_LAYER);
   bBackendMultithreading = Config::Get(Config::GFX_BACKEND_MULTITHREADING);
   iCommandBufferExecuteInterval = Config::Get(Config::GFX_COMMAND_BUFFER_EXECUTE_INTERVAL);
+  iCommandRecordingThreads = Config::Get(Config::GFX_COMMAND_RECORDING_THREADS);
   bShaderCache = Config::Get(Config::GFX_SHADER_CACHE);
   bWaitForShadersBeforeStarting = Config::Get(Config::GFX_WAIT_FOR_SHADERS_BEFORE_STARTING);
   iShaderCompilationMode = Config::Get(Config::GFX_SHADER_COMPILATION_MODE);
@@ -177,7 +183,9 @@ void VideoConfig::Refresh()
 
   bEFBAccessEnable = Config::Get(Config::GFX_HACK_EFB_ACCESS_ENABLE);
   bEFBAccessDeferInvalidation = Config::Get(Config::GFX_HACK_EFB_DEFER_INVALIDATION);
+  bEFBAccessPredictiveReadback = Config::Get(Config::GFX_HACK_EFB_PREDICTIVE_READBACK);
   bBBoxEnable = Config::Get(Config::GFX_HACK_BBOX_ENABLE);
+  bBBoxCPUEstimate = Config::Get(Config::GFX_HACK_BBOX_CPU_ESTIMATE);
   bForceProgressive = Config::Get(Config::GFX_HACK_FORCE_PROGRESSIVE);
   bSkipEFBCopyToRam = Config::Get(Config::GFX_HACK_SKIP_EFB_COPY_TO_RAM);
   bSkipXFBCopyToRam = Config::Get(Config::GFX_HACK_SKIP_XFB_COPY_TO_RAM);
@@ -187,6 +195,7 @@ void VideoConfig::Refresh()
   bVISkip = Config::Get(Config::GFX_HACK_VI_SKIP);
   bSkipPresentingDuplicateXFBs = bVISkip || Config::Get(Config::GFX_HACK_SKIP_DUPLICATE_XFBS);
   bCopyEFBScaled = Config::Get(Config::GFX_HACK_COPY_EFB_SCALED);
+  bEFBCopyScaleByUse = Config::Get(Config::GFX_HACK_EFB_COPY_SCALE_BY_USE);
   bEFBEmulateFormatChanges = Config::Get(Config::GFX_HACK_EFB_EMULATE_FORMAT_CHANGES);
   bVertexRounding = Config::Get(Config::GFX_HACK_VERTEX_ROUNDING);
   iEFBAccessTileSize = Config::Get(Config::GFX_HACK_EFB_ACCESS_TILE_SIZE);
@@ -197,6 +206,7 @@ void VideoConfig::Refresh()
 #endif
 
   bPerfQueriesEnable = Config::Get(Config::GFX_PERF_QUERIES_ENABLE);
+  bPerfQueriesAsync = Config::Get(Config::GFX_PERF_QUERIES_ASYNC);
 
   bGraphicMods = Config::Get(Config::GFX_MODS_ENABLE);
 
@@ -103,6 +103,7 @@ struct VideoConfig final
   // General
   bool bVSync = false;
   bool bVSyncActive = false;
+  bool bFramePacing = false;
   bool bWidescreenHack = false;
   AspectMode aspect_mode{};
   AspectMode suggested_aspect_mode{};
@@ -154,6 +155,9 @@ struct VideoConfig final
   bool bShowGraphs = false;
   bool bShowSpeed = false;
   bool bShowSpeedColors = false;
+  bool bShowDiscCacheStats = false;
+  bool bShowShaderCompilerStats = false;
+  bool bShowAudioStats = false;
   int iPerfSampleUSec = 0;
   bool bShowNetPlayPing = false;
   bool bShowNetPlayMessages = false;
@@ -194,8 +198,11 @@ struct VideoConfig final
   // Hacks
   bool bEFBAccessEnable = false;
   bool bEFBAccessDeferInvalidation = false;
+  bool bEFBAccessPredictiveReadback = false;
   bool bPerfQueriesEnable = false;
+  bool bPerfQueriesAsync = false;
   bool bBBoxEnable = false;
+  bool bBBoxCPUEstimate = false;
   bool bForceProgressive = false;
   bool bCPUCull = false;
 
@@ -207,7 +214,11 @@ struct VideoConfig final
   bool bImmediateXFB = false;
   bool bSkipPresentingDuplicateXFBs = false;
   bool bCopyEFBScaled = false;
+  // Scales EFB copies by how large the previous copy to the address was sampled
+  bool bEFBCopyScaleByUse = false;
   int iSafeTextureCache_ColorSamples = 0;
+  // In MiB, 0 for no budget. Textures that weren't used recently are freed to stay below it.
+  int iTextureCacheMemoryBudget = 0;
   float fAspectRatioHackW = 1;  // Initial value needed for the first frame
   float fAspectRatioHackH = 1;
   bool bEnablePixelLighting = false;
@@ -248,6 +259,10 @@ struct VideoConfig final
   // Currently only supported with Vulkan.
   int iCommandBufferExecuteInterval = 0;
 
+  // Number of threads that render passes are recorded on, 0 to record them on the video thread.
+  // Currently only supported with Vulkan.
+  int iCommandRecordingThreads = 0;
+
   // Shader compilation settings.
   bool bWaitForShadersBeforeStarting = false;
   ShaderCompilationMode iShaderCompilationMode{};
@@ -63,6 +63,7 @@ static void XFRegWritten(Core::System& system, VertexShaderManager& vertex_shade
     case XFMEM_SETNUMCHAN:
       if (xfmem.numChan.numColorChans != (value & 3))
         g_vertex_manager->Flush();
+      g_vertex_manager->SetShaderUidsChanged();
       vertex_shader_manager.SetLightingConfigChanged();
       break;
 
@@ -96,12 +97,14 @@ static void XFRegWritten(Core::System& system, VertexShaderManager& vertex_shade
     case XFMEM_SETCHAN1_ALPHA:
       if (((u32*)&xfmem)[address] != (value & 0x7fff))
         g_vertex_manager->Flush();
+      g_vertex_manager->SetShaderUidsChanged();
       vertex_shader_manager.SetLightingConfigChanged();
       break;
 
     case XFMEM_DUALTEX:
       if (xfmem.dualTexTrans.enabled != bool(value & 1))
         g_vertex_manager->Flush();
+      g_vertex_manager->SetShaderUidsChanged();
       vertex_shader_manager.SetTexMatrixInfoChanged(-1);
       break;
 
@@ -141,6 +144,7 @@ static void XFRegWritten(Core::System& system, VertexShaderManager& vertex_shade
     case XFMEM_SETNUMTEXGENS:  // GXSetNumTexGens
       if (xfmem.numTexGen.numTexGens != (value & 15))
         g_vertex_manager->Flush();
+      g_vertex_manager->SetShaderUidsChanged();
       break;
 
     case XFMEM_SETTEXMTXINFO:
@@ -152,6 +156,7 @@ static void XFRegWritten(Core::System& system, VertexShaderManager& vertex_shade
     case XFMEM_SETTEXMTXINFO + 6:
     case XFMEM_SETTEXMTXINFO + 7:
       g_vertex_manager->Flush();
+      g_vertex_manager->SetShaderUidsChanged();
       vertex_shader_manager.SetTexMatrixInfoChanged(address - XFMEM_SETTEXMTXINFO);
       break;
 
@@ -164,6 +169,7 @@ static void XFRegWritten(Core::System& system, VertexShaderManager& vertex_shade
     case XFMEM_SETPOSTMTXINFO + 6:
     case XFMEM_SETPOSTMTXINFO + 7:
       g_vertex_manager->Flush();
+      g_vertex_manager->SetShaderUidsChanged();
       vertex_shader_manager.SetTexMatrixInfoChanged(address - XFMEM_SETPOSTMTXINFO);
       break;
 
@@ -0,0 +1,74 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <numbers>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "AudioCommon/AudioStretcher.h"
+
+namespace
+{
+constexpr unsigned int SAMPLE_RATE = 48000;
+constexpr unsigned int OUTPUT_SAMPLES = 480;
+constexpr double FREQUENCY = 440.0;
+constexpr double AMPLITUDE = 10000.0;
+// Long enough for the stretch ratio to settle
+constexpr int SETTLE_CALLS = 300;
+constexpr int CHECKED_CALLS = 100;
+// A sine changes by at most this much from one sample to the next, anything much larger means
+// that sequences were joined out of phase or that the output ran out
+const int SINE_MAX_STEP =
+    static_cast<int>(AMPLITUDE * 2 * std::numbers::pi * FREQUENCY / SAMPLE_RATE) + 1;
+
+// Stretches a sine that arrives speed times faster than it is played back, and returns the
+// largest difference between two successive output samples after the ratio has settled
+int GetLargestStep(unsigned int speed)
+{
+  AudioCommon::AudioStretcher stretcher(SAMPLE_RATE);
+  const unsigned int input_samples = OUTPUT_SAMPLES * speed;
+  std::vector<short> input(input_samples * 2);
+  std::vector<short> output(OUTPUT_SAMPLES * 2);
+
+  double phase = 0.0;
+  int previous = 0;
+  int largest_step = 0;
+  for (int call = 0; call < SETTLE_CALLS + CHECKED_CALLS; call++)
+  {
+    for (unsigned int i = 0; i < input_samples; i++)
+    {
+      input[i * 2] = input[i * 2 + 1] = static_cast<short>(AMPLITUDE * std::sin(phase));
+      phase += 2 * std::numbers::pi * FREQUENCY / SAMPLE_RATE;
+    }
+
+    stretcher.ProcessSamples(input.data(), input_samples, OUTPUT_SAMPLES);
+    stretcher.GetStretchedSamples(output.data(), OUTPUT_SAMPLES);
+
+    for (unsigned int i = 0; i < OUTPUT_SAMPLES; i++)
+    {
+      EXPECT_EQ(output[i * 2], output[i * 2 + 1]);
+      if (call >= SETTLE_CALLS)
+        largest_step = std::max(largest_step, std::abs(output[i * 2] - previous));
+      previous = output[i * 2];
+    }
+  }
+
+  return largest_step;
+}
+}  // namespace
+
+TEST(AudioStretcher, KeepsSineContinuous)
+{
+  EXPECT_LE(GetLargestStep(1), SINE_MAX_STEP * 11 / 10);
+  EXPECT_LE(GetLargestStep(2), SINE_MAX_STEP * 11 / 10);
+}
+
+TEST(AudioStretcher, FastForwardKeepsPlaying)
+{
+  static_assert(AudioCommon::AudioStretcher::FAST_FORWARD_TEMPO < 4);
+  EXPECT_LE(GetLargestStep(4), SINE_MAX_STEP * 11 / 10);
+}
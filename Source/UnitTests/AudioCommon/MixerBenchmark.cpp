@@ -0,0 +1,101 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Measures how many output samples per second the mixer produces for each kind of source.
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>  // NOLINT
+
+#include "AudioCommon/Mixer.h"
+#include "Common/CommonTypes.h"
+
+#include "../BenchmarkReport.h"
+
+namespace
+{
+constexpr unsigned int OUTPUT_SAMPLE_RATE = 48000;
+// 10 ms of output at a time, which is how much a typical backend asks for
+constexpr unsigned int OUTPUT_SAMPLES = OUTPUT_SAMPLE_RATE / 100;
+constexpr int RUNS = 2000;
+
+struct Source
+{
+  std::string name;
+  unsigned int sample_rate;
+  // Pushes the given number of stereo samples
+  std::function<void(Mixer&, const short*, unsigned int)> push;
+  // The most samples that can be pushed at once
+  unsigned int max_push = 0xffffffff;
+};
+
+void MeasureSource(const Source& source)
+{
+  Mixer mixer(OUTPUT_SAMPLE_RATE);
+
+  std::mt19937 rng(0);
+  std::uniform_int_distribution<int> distribution(-20000, 20000);
+  const unsigned int input_samples = OUTPUT_SAMPLES * source.sample_rate / OUTPUT_SAMPLE_RATE;
+  std::vector<short> input(input_samples * 2);
+  for (short& sample : input)
+    sample = static_cast<short>(distribution(rng));
+
+  std::vector<short> output(OUTPUT_SAMPLES * 2);
+  bool any_output = false;
+
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < RUNS; i++)
+  {
+    for (unsigned int pushed = 0; pushed < input_samples;)
+    {
+      const unsigned int count = std::min(source.max_push, input_samples - pushed);
+      source.push(mixer, input.data() + pushed * 2, count);
+      pushed += count;
+    }
+
+    ASSERT_EQ(mixer.Mix(output.data(), OUTPUT_SAMPLES), OUTPUT_SAMPLES);
+    any_output |= std::any_of(output.begin(), output.end(), [](short s) { return s != 0; });
+  }
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+  EXPECT_TRUE(any_output) << source.name;
+  ReportBenchmark(source.name, RUNS * OUTPUT_SAMPLES / elapsed.count() / 1e6, "Msamples/s");
+}
+}  // namespace
+
+TEST(MixerBenchmark, MixSources)
+{
+  constexpr u64 DIVIDEND = Mixer::FIXED_SAMPLE_RATE_DIVIDEND;
+
+  const std::vector<Source> sources = {
+      {"DMA", 32000,
+       [](Mixer& mixer, const short* samples, unsigned int count) {
+         mixer.PushSamples(samples, count);
+       }},
+      {"Streaming", 48000,
+       [](Mixer& mixer, const short* samples, unsigned int count) {
+         mixer.PushStreamingSamples(samples, count);
+       }},
+      {"Wii Remote", 3000,
+       [](Mixer& mixer, const short* samples, unsigned int count) {
+         // The speaker is mono, use the left channel
+         std::vector<short> mono(count);
+         for (unsigned int i = 0; i < count; i++)
+           mono[i] = samples[i * 2];
+         mixer.PushWiimoteSpeakerSamples(mono.data(), count, DIVIDEND / 3000);
+       },
+       40},
+      {"GBA", 48000,
+       [](Mixer& mixer, const short* samples, unsigned int count) {
+         mixer.PushGBASamples(0, samples, count);
+       }},
+  };
+
+  for (const Source& source : sources)
+    MeasureSource(source);
+}
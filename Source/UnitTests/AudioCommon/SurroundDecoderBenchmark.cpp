@@ -0,0 +1,108 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Checks the passive matrix decoder and measures both surround modes at every quality.
+
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>  // NOLINT
+
+#include "AudioCommon/Enums.h"
+#include "AudioCommon/SurroundDecoder.h"
+#include "Common/CommonTypes.h"
+
+#include "../BenchmarkReport.h"
+
+namespace
+{
+constexpr u32 SAMPLE_RATE = 48000;
+constexpr size_t SURROUND_CHANNELS = 6;
+// 10 ms of output at a time, which is how much a typical backend asks for
+constexpr size_t OUTPUT_FRAMES = SAMPLE_RATE / 100;
+constexpr int RUNS = 1000;
+
+std::vector<short> GetInput(size_t frames)
+{
+  std::mt19937 rng(0);
+  std::uniform_int_distribution<int> distribution(-20000, 20000);
+  std::vector<short> input(frames * 2);
+  for (short& sample : input)
+    sample = static_cast<short>(distribution(rng));
+  return input;
+}
+}  // namespace
+
+TEST(SurroundDecoderBenchmark, Matrix)
+{
+  constexpr u32 BLOCK_SIZE = 512;
+  constexpr size_t FRAMES = BLOCK_SIZE * 3;
+
+  AudioCommon::SurroundDecoder decoder(SAMPLE_RATE, BLOCK_SIZE);
+  decoder.SetMode(AudioCommon::DPL2Mode::Matrix);
+
+  const std::vector<short> input = GetInput(FRAMES);
+  std::vector<float> output(FRAMES * SURROUND_CHANNELS);
+  ASSERT_EQ(decoder.QueryFramesNeededForSurroundOutput(FRAMES - 1), FRAMES);
+  decoder.PutFrames(input.data(), FRAMES);
+  ASSERT_EQ(decoder.QueryFramesNeededForSurroundOutput(FRAMES), 0u);
+  decoder.ReceiveFrames(output.data(), FRAMES);
+
+  float previous_lfe = 0.0f;
+  for (size_t i = 0; i < FRAMES; ++i)
+  {
+    const float left = input[i * 2] / 32767.0f;
+    const float right = input[i * 2 + 1] / 32767.0f;
+    const float* frame = &output[i * SURROUND_CHANNELS];
+
+    constexpr float TOLERANCE = 1e-5f;
+    EXPECT_NEAR(frame[0], left, TOLERANCE) << "frame " << i;
+    EXPECT_NEAR(frame[1], right, TOLERANCE) << "frame " << i;
+    EXPECT_NEAR(frame[2], (left + right) * 0.7071f, TOLERANCE) << "frame " << i;
+    EXPECT_NEAR(frame[4], left * -0.8718f + right * 0.4899f, TOLERANCE) << "frame " << i;
+    EXPECT_NEAR(frame[5], left * -0.4899f + right * 0.8718f, TOLERANCE) << "frame " << i;
+
+    // The LFE channel is low-passed, so it only moves a little towards the input every frame
+    const float mono = (left + right) / 2;
+    EXPECT_LE(std::abs(frame[3] - previous_lfe), std::abs(mono - previous_lfe) * 0.05f + TOLERANCE)
+        << "frame " << i;
+    previous_lfe = frame[3];
+  }
+}
+
+TEST(SurroundDecoderBenchmark, Decode)
+{
+  for (const AudioCommon::DPL2Mode mode :
+       {AudioCommon::DPL2Mode::FreeSurround, AudioCommon::DPL2Mode::Matrix})
+  {
+    // The block sizes of the decoding qualities
+    for (const u32 block_size : {512, 1024, 2048, 4096})
+    {
+      AudioCommon::SurroundDecoder decoder(SAMPLE_RATE, block_size);
+      decoder.SetMode(mode);
+
+      const std::vector<short> input = GetInput(OUTPUT_FRAMES + block_size);
+      std::vector<float> output(OUTPUT_FRAMES * SURROUND_CHANNELS);
+      size_t decoded_frames = 0;
+
+      const auto start = std::chrono::steady_clock::now();
+      for (int i = 0; i < RUNS; i++)
+      {
+        const size_t needed_frames = decoder.QueryFramesNeededForSurroundOutput(OUTPUT_FRAMES);
+        decoder.PutFrames(input.data(), needed_frames);
+        decoder.ReceiveFrames(output.data(), OUTPUT_FRAMES);
+        decoded_frames += needed_frames;
+      }
+      const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+      EXPECT_GE(decoded_frames, RUNS * OUTPUT_FRAMES);
+      ReportBenchmark(fmt::format("{}, block size: {}",
+                                  mode == AudioCommon::DPL2Mode::Matrix ? "Matrix" : "FreeSurround",
+                                  block_size),
+                      elapsed.count() * 1e6 / (decoded_frames / 1000.0), "us/1000 samples");
+    }
+  }
+}
@@ -0,0 +1,19 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <string_view>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+// Prints a benchmark result and records it as a property of the running test. Running a test with
+// --gtest_output=json:<file> writes the properties to a report that Tools/perf-regression.py
+// collects and compares between commits. Units that end in "/s" are rates, where higher is better,
+// anything else is a cost, where lower is better.
+inline void ReportBenchmark(std::string_view name, double value, std::string_view unit)
+{
+  fmt::print("{:<44} {:>12.2f} {}\n", name, value, unit);
+  testing::Test::RecordProperty(fmt::format("{} [{}]", name, unit), fmt::format("{:.6g}", value));
+}
@@ -0,0 +1,84 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "Common/Counters.h"
+#include "Common/FileUtil.h"
+
+TEST(Counters, FormatsAsPrometheus)
+{
+  Common::Counter counter("test_prometheus_total", "Things that happened");
+  Common::Counter gauge("test_prometheus_depth", "Things waiting", Common::Counter::Type::Gauge);
+  counter.Add();
+  counter.Add(2);
+  gauge.Set(5);
+  gauge.Set(4);
+
+  const std::string text = Common::FormatCountersAsPrometheus();
+  EXPECT_NE(text.find("# HELP test_prometheus_total Things that happened\n"
+                      "# TYPE test_prometheus_total counter\n"
+                      "test_prometheus_total 3\n"),
+            std::string::npos);
+  EXPECT_NE(text.find("# TYPE test_prometheus_depth gauge\ntest_prometheus_depth 4\n"),
+            std::string::npos);
+  // Sorted by name
+  EXPECT_LT(text.find("test_prometheus_depth"), text.find("test_prometheus_total"));
+}
+
+TEST(Counters, FormatsAsJSON)
+{
+  Common::Counter counter("test_json_total", "");
+  counter.Add(7);
+
+  const std::string json = Common::FormatCountersAsJSON();
+  EXPECT_EQ(json.front(), '{');
+  EXPECT_NE(json.find("\"test_json_total\":7"), std::string::npos);
+}
+
+TEST(Counters, UnregistersOnDestruction)
+{
+  {
+    Common::Counter counter("test_destroyed_total", "");
+  }
+  EXPECT_EQ(Common::FormatCountersAsPrometheus().find("test_destroyed_total"), std::string::npos);
+}
+
+TEST(Counters, WritesFormatByExtension)
+{
+  Common::Counter counter("test_written_total", "");
+  counter.Add();
+
+  const std::string directory = File::CreateTempDir();
+  std::string text;
+  ASSERT_TRUE(Common::WriteCounters(directory + "/metrics.prom"));
+  ASSERT_TRUE(File::ReadFileToString(directory + "/metrics.prom", text));
+  EXPECT_NE(text.find("test_written_total 1\n"), std::string::npos);
+
+  ASSERT_TRUE(Common::WriteCounters(directory + "/metrics.json"));
+  ASSERT_TRUE(File::ReadFileToString(directory + "/metrics.json", text));
+  EXPECT_NE(text.find("\"test_written_total\":1"), std::string::npos);
+  EXPECT_FALSE(File::Exists(directory + "/metrics.json.tmp"));
+
+  File::DeleteDirRecursively(directory);
+}
+
+TEST(Counters, WriterWritesOnStop)
+{
+  Common::Counter counter("test_writer_total", "");
+  const std::string directory = File::CreateTempDir();
+  const std::string path = directory + "/metrics.prom";
+
+  Common::CounterWriter writer;
+  writer.Start(path, std::chrono::hours(1));
+  counter.Add(3);
+  writer.Stop();
+
+  std::string text;
+  ASSERT_TRUE(File::ReadFileToString(path, text));
+  EXPECT_NE(text.find("test_writer_total 3\n"), std::string::npos);
+
+  File::DeleteDirRecursively(directory);
+}
@@ -0,0 +1,72 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Measures the throughput of each hash that the caches use.
+
+#include <chrono>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>  // NOLINT
+
+#include "Common/CommonTypes.h"
+#include "Common/Hash.h"
+
+#include "../BenchmarkReport.h"
+
+namespace
+{
+// A 1024x1024 RGBA8 texture
+constexpr u32 DATA_SIZE = 4 * 1024 * 1024;
+constexpr int RUNS = 64;
+
+std::vector<u8> MakeData()
+{
+  std::mt19937 rng(0);
+  std::vector<u8> data(DATA_SIZE);
+  for (u8& byte : data)
+    byte = static_cast<u8>(rng());
+  return data;
+}
+
+void MeasureHash(const std::string& name, const std::function<u64()>& hash)
+{
+  u64 result = 0;
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < RUNS; i++)
+    result ^= hash();
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+  // So that the hashing can't be left out
+  EXPECT_NE(result, 1u) << name;
+  ReportBenchmark(name, RUNS * (DATA_SIZE / 1e9) / elapsed.count(), "GB/s");
+}
+}  // namespace
+
+TEST(HashBenchmark, HashDataIsStable)
+{
+  // Disk caches are keyed by it, so it can't change
+  EXPECT_EQ(Common::HashData(nullptr, 0), 0xef46db3751d8e999u);
+}
+
+TEST(HashBenchmark, Throughput)
+{
+  const std::vector<u8> data = MakeData();
+  const u8* ptr = data.data();
+
+  MeasureHash("GetHash64", [&] { return Common::GetHash64(ptr, DATA_SIZE, 0); });
+  MeasureHash("GetHash64, 128 samples", [&] { return Common::GetHash64(ptr, DATA_SIZE, 128); });
+  MeasureHash("HashData", [&] { return Common::HashData(ptr, DATA_SIZE); });
+  // Like an EFB copy with a stride, which is hashed a row at a time
+  MeasureHash("GetHash64, 256 B rows", [&] {
+    u64 hash = DATA_SIZE;
+    for (u32 offset = 0; offset < DATA_SIZE; offset += 256)
+      hash = (hash * 397) ^ Common::GetHash64(ptr + offset, 256, 0);
+    return hash;
+  });
+  MeasureHash("ComputeCRC32", [&] { return Common::ComputeCRC32(ptr, DATA_SIZE); });
+  MeasureHash("HashAdler32", [&] { return Common::HashAdler32(ptr, DATA_SIZE); });
+}
@@ -0,0 +1,75 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/MPSCQueue.h"
+
+TEST(MPSCQueue, Simple)
+{
+  Common::MPSCQueue<u32> q;
+
+  EXPECT_TRUE(q.Empty());
+
+  q.Push(1);
+  EXPECT_FALSE(q.Empty());
+
+  std::vector<u32> popped;
+  q.PopAll([&](u32 v) { popped.push_back(v); });
+  EXPECT_EQ(std::vector<u32>{1}, popped);
+  EXPECT_TRUE(q.Empty());
+
+  // Test the FIFO order.
+  for (u32 i = 0; i < 1000; ++i)
+    q.Push(i);
+  popped.clear();
+  q.PopAll([&](u32 v) { popped.push_back(v); });
+  ASSERT_EQ(1000u, popped.size());
+  for (u32 i = 0; i < 1000; ++i)
+    EXPECT_EQ(i, popped[i]);
+  EXPECT_TRUE(q.Empty());
+
+  for (u32 i = 0; i < 1000; ++i)
+    q.Push(i);
+  EXPECT_FALSE(q.Empty());
+  q.Clear();
+  EXPECT_TRUE(q.Empty());
+}
+
+TEST(MPSCQueue, MultiThreaded)
+{
+  constexpr u32 PRODUCERS = 4;
+  constexpr u32 COUNT = 100000;
+
+  Common::MPSCQueue<u32> q;
+
+  auto inserter = [&q](u32 producer) {
+    for (u32 i = 0; i < COUNT; ++i)
+      q.Push(producer * COUNT + i);
+  };
+
+  std::vector<std::thread> inserter_threads;
+  for (u32 i = 0; i < PRODUCERS; ++i)
+    inserter_threads.emplace_back(inserter, i);
+
+  // Elements of each producer must come out in the order that producer pushed them
+  std::vector<u32> next(PRODUCERS, 0);
+  u32 total = 0;
+  while (total < PRODUCERS * COUNT)
+  {
+    q.PopAll([&](u32 v) {
+      const u32 producer = v / COUNT;
+      EXPECT_EQ(next[producer], v % COUNT);
+      next[producer] = v % COUNT + 1;
+      ++total;
+    });
+  }
+
+  for (std::thread& thread : inserter_threads)
+    thread.join();
+
+  EXPECT_TRUE(q.Empty());
+}
@@ -0,0 +1,91 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+#include <picojson.h>
+
+#include "Common/FileUtil.h"
+#include "Common/Thread.h"
+#include "Common/TraceEvents.h"
+
+namespace
+{
+picojson::array ReadEvents(const std::string& path)
+{
+  std::string json;
+  File::ReadFileToString(path, json);
+  picojson::value root;
+  if (!picojson::parse(root, json).empty() || !root.get("traceEvents").is<picojson::array>())
+    return {};
+  return root.get("traceEvents").get<picojson::array>();
+}
+
+size_t CountEvents(const picojson::array& events, const std::string& phase,
+                   const std::string& name)
+{
+  size_t count = 0;
+  for (const picojson::value& event : events)
+  {
+    if (event.get("ph").to_str() == phase && event.get("name").to_str() == name)
+      ++count;
+  }
+  return count;
+}
+}  // namespace
+
+TEST(TraceEvents, OnlyRecordsWhileRecording)
+{
+  const std::string directory = File::CreateTempDir();
+  const std::string path = directory + "/trace.json";
+
+  {
+    TRACE_SCOPE("Before");
+  }
+
+  Common::Trace::StartRecording();
+  EXPECT_TRUE(Common::Trace::IsRecording());
+  {
+    TRACE_SCOPE("During");
+  }
+  std::thread thread([] {
+    Common::SetCurrentThreadName("Trace \"test\"");
+    for (int i = 0; i < 3; ++i)
+    {
+      TRACE_SCOPE("Worker");
+    }
+  });
+  thread.join();
+  Common::Trace::StopRecording();
+  {
+    TRACE_SCOPE("After");
+  }
+
+  ASSERT_TRUE(Common::Trace::WriteRecording(path));
+  const picojson::array events = ReadEvents(path);
+  EXPECT_EQ(CountEvents(events, "X", "Before"), 0u);
+  EXPECT_EQ(CountEvents(events, "X", "During"), 1u);
+  EXPECT_EQ(CountEvents(events, "X", "Worker"), 3u);
+  EXPECT_EQ(CountEvents(events, "X", "After"), 0u);
+
+  bool found_thread_name = false;
+  for (const picojson::value& event : events)
+  {
+    if (event.get("ph").to_str() == "M" &&
+        event.get("args").get("name").to_str() == "Trace \"test\"")
+    {
+      found_thread_name = true;
+    }
+  }
+  EXPECT_TRUE(found_thread_name);
+
+  // The next recording starts out empty
+  Common::Trace::StartRecording();
+  Common::Trace::StopRecording();
+  ASSERT_TRUE(Common::Trace::WriteRecording(path));
+  EXPECT_TRUE(ReadEvents(path).empty());
+
+  File::DeleteDirRecursively(directory);
+}
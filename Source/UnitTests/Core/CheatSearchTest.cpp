@@ -0,0 +1,81 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Core/CheatSearch.h"
+
+using Cheats::SearchResults;
+using Cheats::SearchResultValueState;
+
+namespace
+{
+using Page = SearchResults<u32>::Page;
+
+Page MakePage(u32 address, SearchResultValueState state, const std::vector<u32>& slots)
+{
+  Page page;
+  page.address = address;
+  page.value_state = state;
+
+  std::array<u64, Page::WORD_COUNT> bitmap{};
+  for (const u32 slot : slots)
+  {
+    bitmap[slot / 64] |= u64{1} << (slot % 64);
+    if (state != SearchResultValueState::AddressNotAccessible)
+      page.values.push_back(address + slot);
+  }
+  page.SetBitmap(bitmap);
+  return page;
+}
+
+SearchResults<u32> MakeResults()
+{
+  SearchResults<u32> results(4);
+  std::vector<Page> pages;
+  constexpr auto valid = SearchResultValueState::ValueFromVirtualMemory;
+  pages.push_back(MakePage(0x80000000, valid, {0, 63, 64}));
+  pages.push_back(MakePage(0x80001000, valid, {}));
+  pages.push_back(MakePage(0x80002000, SearchResultValueState::AddressNotAccessible, {5}));
+  pages.push_back(MakePage(0x80003000, valid, {1023}));
+  results.AddPages(std::move(pages));
+  return results;
+}
+}  // namespace
+
+TEST(CheatSearchResults, StoresResultsByPage)
+{
+  const SearchResults<u32> results = MakeResults();
+
+  // Pages without results aren't kept
+  EXPECT_EQ(results.GetPages().size(), 3u);
+  ASSERT_EQ(results.GetCount(), 5u);
+  EXPECT_EQ(results.GetValidValueCount(), 4u);
+
+  const std::array<u32, 5> addresses = {0x80000000, 0x800000fc, 0x80000100, 0x80002014,
+                                        0x80003ffc};
+  for (size_t i = 0; i < addresses.size(); ++i)
+    EXPECT_EQ(results.Get(i).m_address, addresses[i]);
+
+  EXPECT_EQ(results.Get(1).m_value, 0x80000000u + 63);
+  EXPECT_TRUE(results.Get(2).IsValueValid());
+  EXPECT_FALSE(results.Get(3).IsValueValid());
+  EXPECT_EQ(results.Get(4).m_value, 0x80003000u + 1023);
+}
+
+TEST(CheatSearchResults, GetsSubsetInAddressOrder)
+{
+  const SearchResults<u32> subset = MakeResults().GetSubset({4, 1, 3, 1});
+
+  ASSERT_EQ(subset.GetCount(), 3u);
+  EXPECT_EQ(subset.GetStep(), 4u);
+  EXPECT_EQ(subset.Get(0).m_address, 0x800000fcu);
+  EXPECT_EQ(subset.Get(0).m_value, 0x80000000u + 63);
+  EXPECT_EQ(subset.Get(1).m_value_state, SearchResultValueState::AddressNotAccessible);
+  EXPECT_EQ(subset.Get(2).m_address, 0x80003ffcu);
+  EXPECT_EQ(subset.Get(2).m_value, 0x80003000u + 1023);
+}
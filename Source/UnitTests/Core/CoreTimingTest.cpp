@@ -5,7 +5,12 @@
 
 #include <array>
 #include <bitset>
+#include <chrono>
 #include <string>
+#include <thread>
+#include <vector>
+
+#include <fmt/format.h>
 
 #include "Common/Config/Config.h"
 #include "Common/FileUtil.h"
@@ -17,6 +22,8 @@
 #include "Core/System.h"
 #include "UICommon/UICommon.h"
 
+#include "../BenchmarkReport.h"
+
 // Numbers are chosen randomly to make sure the correct one is given.
 static constexpr std::array<u64, 5> CB_IDS{{42, 144, 93, 1026, UINT64_C(0xFFFF7FFFF7FFFF)}};
 static constexpr int MAX_SLICE_LENGTH = 20000;  // Copied from CoreTiming internals
@@ -401,3 +408,85 @@ TEST(CoreTiming, Overclocking)
   Config::SetCurrent(Config::MAIN_OVERCLOCK, 1.0f);
   AdvanceAndCheck(system, 4, MAX_SLICE_LENGTH);
 }
+
+struct BenchmarkEvent
+{
+  CoreTiming::EventType* type;
+  s64 period;
+};
+
+static std::vector<BenchmarkEvent> s_benchmark_events;
+static u64 s_benchmark_periodic_count = 0;
+static u64 s_benchmark_thread_safe_count = 0;
+
+static void PeriodicBenchmarkCallback(Core::System& system, u64 userdata, s64 lateness)
+{
+  ++s_benchmark_periodic_count;
+  const BenchmarkEvent& event = s_benchmark_events[userdata];
+  system.GetCoreTiming().ScheduleEvent(event.period - lateness, event.type, userdata);
+}
+
+static void ThreadSafeBenchmarkCallback(Core::System& system, u64 userdata, s64 lateness)
+{
+  ++s_benchmark_thread_safe_count;
+}
+
+// Measures scheduler throughput with periodic events and events scheduled from another thread.
+TEST(CoreTiming, SchedulingBenchmark)
+{
+  auto& system = Core::System::GetInstance();
+
+  ScopeInit guard(system);
+  ASSERT_TRUE(guard.UserDirectoryExists());
+
+  auto& core_timing = system.GetCoreTiming();
+  auto& ppc_state = system.GetPPCState();
+
+  // Don't throttle to the speed of the emulated CPU
+  Config::SetCurrent(Config::MAIN_EMULATION_SPEED, 0.0f);
+
+  // Enter slice 0
+  core_timing.Advance();
+
+  constexpr std::array<s64, 8> periods{{100, 250, 600, 1000, 2700, 5000, 12000, 40000}};
+  s_benchmark_events.clear();
+  s_benchmark_periodic_count = 0;
+  s_benchmark_thread_safe_count = 0;
+  for (u64 i = 0; i < periods.size(); ++i)
+  {
+    CoreTiming::EventType* type =
+        core_timing.RegisterEvent(fmt::format("periodic{}", i), PeriodicBenchmarkCallback);
+    s_benchmark_events.push_back({type, periods[i]});
+    core_timing.ScheduleEvent(periods[i], type, i);
+  }
+  CoreTiming::EventType* cb_thread_safe =
+      core_timing.RegisterEvent("threadSafe", ThreadSafeBenchmarkCallback);
+
+  constexpr u64 THREAD_SAFE_EVENTS = 100000;
+  constexpr int SLICES = 1000000;
+
+  const auto start = std::chrono::steady_clock::now();
+
+  std::thread producer([&] {
+    for (u64 i = 0; i < THREAD_SAFE_EVENTS; ++i)
+      core_timing.ScheduleEvent(0, cb_thread_safe, i, CoreTiming::FromThread::NON_CPU);
+  });
+
+  for (int i = 0; i < SLICES; ++i)
+  {
+    ppc_state.downcount = 0;  // Pretend we executed the whole slice.
+    core_timing.Advance();
+  }
+
+  producer.join();
+  ppc_state.downcount = 0;
+  core_timing.Advance();
+
+  const auto end = std::chrono::steady_clock::now();
+
+  EXPECT_EQ(THREAD_SAFE_EVENTS, s_benchmark_thread_safe_count);
+
+  const u64 events = s_benchmark_periodic_count + s_benchmark_thread_safe_count;
+  const double seconds = std::chrono::duration<double>(end - start).count();
+  ReportBenchmark("scheduled events", events / seconds / 1e6, "Mevents/s");
+}
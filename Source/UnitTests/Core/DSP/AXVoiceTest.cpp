@@ -0,0 +1,158 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <optional>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+
+#define AX_GC
+#include "Core/HW/DSPHLE/UCodes/AXVoice.h"
+
+using namespace DSP::HLE;
+
+namespace
+{
+struct ResampleParameters
+{
+  u32 count;
+  u32 curr_pos;
+  u32 ratio;
+  int srctype;
+  std::array<s16, 4> last_samples;
+};
+
+class AXResampleTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    // Loud enough for the polyphase sums to saturate, with a few -32768 to hit the edge cases
+    std::uniform_int_distribution<int> coeff_distribution(-32768, 32767);
+    for (s16& coeff : m_coeffs)
+      coeff = static_cast<s16>(coeff_distribution(m_rng));
+    for (int i = 0; i < 16; i++)
+      m_coeffs[m_rng() % m_coeffs.size()] = -32768;
+  }
+
+  // Runs ResampleAudio and ResampleBlock on the same random input, or on <fill> if given, and
+  // checks that both output the same samples and end up in the same state
+  void Compare(const ResampleParameters& params, bool use_coeffs,
+               std::optional<s16> fill = std::nullopt)
+  {
+    const u64 input_count =
+        GetResampleInputCount(params.count, params.curr_pos, params.ratio, params.srctype);
+    ASSERT_LE(input_count, MAX_BLOCK_INPUT_SAMPLES);
+
+    std::uniform_int_distribution<int> sample_distribution(-32768, 32767);
+    std::vector<s16> input(4 + input_count);
+    std::copy(params.last_samples.begin(), params.last_samples.end(), input.begin());
+    for (u64 i = 0; i < input_count; i++)
+    {
+      // Mostly full scale, sometimes the extremes
+      const u32 kind = m_rng() % 8;
+      input[4 + i] = kind == 0 ? -32768 : kind == 1 ? 32767 : sample_distribution(m_rng);
+      if (fill)
+        input[4 + i] = *fill;
+    }
+
+    const s16* coeffs = use_coeffs ? m_coeffs.data() + (m_rng() % 4) * 0x200 : nullptr;
+
+    std::array<s16, MAX_SAMPLES_PER_FRAME> expected{};
+    std::array<s16, 4> expected_last_samples = params.last_samples;
+    u32 read_count = 0;
+    const u32 expected_pos = ResampleAudio(
+        [&](u32 i) {
+          EXPECT_EQ(i, read_count);
+          return input[4 + read_count++];
+        },
+        expected.data(), params.count, expected_last_samples.data(), params.curr_pos, params.ratio,
+        params.srctype, coeffs);
+    EXPECT_EQ(read_count, input_count);
+
+    std::array<s16, MAX_SAMPLES_PER_FRAME> output{};
+    std::array<s16, 4> last_samples = params.last_samples;
+    const u32 pos = ResampleBlock(input.data(), output.data(), params.count, last_samples.data(),
+                                  params.curr_pos, params.ratio, params.srctype, coeffs);
+
+    EXPECT_EQ(pos, expected_pos);
+    EXPECT_EQ(last_samples, expected_last_samples);
+    for (u32 i = 0; i < params.count; i++)
+      ASSERT_EQ(output[i], expected[i]) << "sample " << i << " ratio " << params.ratio;
+  }
+
+  ResampleParameters RandomParameters(int srctype)
+  {
+    ResampleParameters params;
+    // Voices always output whole milliseconds, smaller counts check the tails
+    params.count = srctype == SRCTYPE_NEAREST ? 32 : 4 + m_rng() % (MAX_SAMPLES_PER_FRAME - 3);
+    params.curr_pos = m_rng() % 0x10000;
+    // Up to the fastest voice that the block path handles
+    params.ratio = m_rng() % ((MAX_BLOCK_INPUT_SAMPLES - 1) * 0x10000 / params.count);
+    params.srctype = srctype;
+    for (s16& sample : params.last_samples)
+      sample = static_cast<s16>(m_rng());
+    return params;
+  }
+
+  std::mt19937 m_rng{0};
+  std::array<s16, 0x800> m_coeffs;
+};
+}  // namespace
+
+TEST_F(AXResampleTest, Polyphase)
+{
+  for (int i = 0; i < 2000; i++)
+    Compare(RandomParameters(SRCTYPE_POLYPHASE), true);
+}
+
+TEST_F(AXResampleTest, PolyphaseWithoutCoefficients)
+{
+  for (int i = 0; i < 500; i++)
+    Compare(RandomParameters(SRCTYPE_POLYPHASE), false);
+}
+
+TEST_F(AXResampleTest, Linear)
+{
+  for (int i = 0; i < 2000; i++)
+    Compare(RandomParameters(SRCTYPE_LINEAR), false);
+}
+
+TEST_F(AXResampleTest, Nearest)
+{
+  for (int i = 0; i < 100; i++)
+    Compare(RandomParameters(SRCTYPE_NEAREST), false);
+}
+
+TEST_F(AXResampleTest, CommonRatios)
+{
+  // 32 kHz, 48 kHz, 44.1 kHz and 22.05 kHz voices
+  for (const u32 ratio : {0x10000u, 0x18000u, 0x161A0u, 0xB0D0u})
+  {
+    for (const int srctype : {SRCTYPE_POLYPHASE, SRCTYPE_LINEAR})
+    {
+      for (u32 curr_pos : {0u, 0x8000u, 0xFFFFu})
+        Compare({32, curr_pos, ratio, srctype, {1, -2, 3, -4}}, srctype == SRCTYPE_POLYPHASE);
+    }
+  }
+
+  // The Wiimote speaker resamples 96 samples to 18
+  for (u32 curr_pos : {0u, 0x8000u, 0xFFFFu})
+    Compare({18, curr_pos, 0x55555, SRCTYPE_POLYPHASE, {5, -6, 7, -8}}, true);
+}
+
+TEST_F(AXResampleTest, MinimumCoefficients)
+{
+  // Pairs of -32768 samples and coefficients sum to 2^31, which doesn't fit in 32 bits
+  m_coeffs.fill(-32768);
+  for (int i = 0; i < 100; i++)
+  {
+    ResampleParameters params = RandomParameters(SRCTYPE_POLYPHASE);
+    params.last_samples.fill(-32768);
+    Compare(params, true, -32768);
+  }
+}
@@ -0,0 +1,116 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <initializer_list>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Core/DSP/DSPAnalyzer.h"
+#include "Core/DSP/DSPCore.h"
+#include "Core/DSP/DSPTables.h"
+
+class DSPAnalyzerTest : public testing::Test
+{
+protected:
+  static void SetUpTestSuite() { DSP::InitInstructionTable(); }
+
+  void SetUp() override
+  {
+    // Fill the instruction memories with HALT
+    m_iram.fill(0x0021);
+    m_irom.fill(0x0021);
+    m_core.DSPState().iram = m_iram.data();
+    m_core.DSPState().irom = m_irom.data();
+  }
+
+  void TearDown() override
+  {
+    m_core.DSPState().iram = nullptr;
+    m_core.DSPState().irom = nullptr;
+  }
+
+  bool IsIdleLoop(u16 addr, std::initializer_list<u16> code)
+  {
+    std::copy(code.begin(), code.end(), m_iram.begin() + addr);
+    m_analyzer.Analyze(m_core.DSPState());
+    return m_analyzer.IsIdleSkip(addr);
+  }
+
+  DSP::DSPCore m_core;
+  DSP::Analyzer m_analyzer;
+  std::array<u16, DSP::DSP_IRAM_SIZE> m_iram;
+  std::array<u16, DSP::DSP_IROM_SIZE> m_irom;
+};
+
+TEST_F(DSPAnalyzerTest, DMAWaitLoop)
+{
+  // clang-format off
+  EXPECT_TRUE(IsIdleLoop(0x0010, {
+      0x00de, 0xffc9,  // LR $AC0.M, @DSCR
+      0x02a0, 0x0004,  // ANDF $AC0.M, #0x0004
+      0x029c, 0x0010,  // JLNZ 0x0010
+  }));
+  // clang-format on
+}
+
+TEST_F(DSPAnalyzerTest, LoopWithExit)
+{
+  // clang-format off
+  EXPECT_TRUE(IsIdleLoop(0x0020, {
+      0x26fe,          // LRS $AC0.M, @CMBH
+      0x02c0, 0x8000,  // ANDCF $AC0.M, #0x8000
+      0x029d, 0x0040,  // JLZ 0x0040
+      0x0000,          // NOP
+      0x029f, 0x0020,  // JMP 0x0020
+  }));
+  // clang-format on
+}
+
+TEST_F(DSPAnalyzerTest, ReadingMailboxLowIsNotIdle)
+{
+  // clang-format off
+  EXPECT_FALSE(IsIdleLoop(0x0010, {
+      0x00de, 0xfffd,  // LR $AC0.M, @DMBL
+      0xb100,          // TST $AC0
+      0x0295, 0x0010,  // JZ 0x0010
+  }));
+  // clang-format on
+}
+
+TEST_F(DSPAnalyzerTest, StoringIsNotIdle)
+{
+  // clang-format off
+  EXPECT_FALSE(IsIdleLoop(0x0010, {
+      0x00de, 0x0100,  // LR $AC0.M, @0x0100
+      0x00fe, 0x0101,  // SR @0x0101, $AC0.M
+      0xb100,          // TST $AC0
+      0x0295, 0x0010,  // JZ 0x0010
+  }));
+  // clang-format on
+}
+
+TEST_F(DSPAnalyzerTest, ExtendedOpcodeIsNotIdle)
+{
+  // clang-format off
+  EXPECT_FALSE(IsIdleLoop(0x0010, {
+      0x00de, 0x0100,  // LR $AC0.M, @0x0100
+      0xb104,          // TST'DR $AC0 : $AR0
+      0x0295, 0x0010,  // JZ 0x0010
+  }));
+  // clang-format on
+}
+
+TEST_F(DSPAnalyzerTest, LongLoopIsNotIdle)
+{
+  // clang-format off
+  EXPECT_FALSE(IsIdleLoop(0x0010, {
+      0x00de, 0x0100,  // LR $AC0.M, @0x0100
+      0x0000, 0x0000, 0x0000, 0x0000,
+      0x0000, 0x0000, 0x0000,  // NOP * 7
+      0x0295, 0x0010,          // JZ 0x0010
+  }));
+  // clang-format on
+}
@@ -0,0 +1,525 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Measures per-read latency and allocations of the DVD read observer and its subtitle lookup.
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "Common/Align.h"
+#include "Common/CommonPaths.h"
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
+#include "Common/Logging/LogManager.h"
+#include "Common/StringUtil.h"
+#include "Common/Swap.h"
+#include "Core/HW/DVD/DiscAccessObserver.h"
+#include "Core/HW/DVD/FileMonitor.h"
+#include "DiscIO/Blob.h"
+#include "DiscIO/DiscUtils.h"
+#include "DiscIO/Filesystem.h"
+#include "DiscIO/Volume.h"
+#include "Subtitles/SubtitleEntry.h"
+#include "Subtitles/SubtitleFileIndex.h"
+#include "Subtitles/SubtitleLoader.h"
+#include "Subtitles/SubtitlePack.h"
+
+#include "../../BenchmarkReport.h"
+
+namespace
+{
+std::atomic<u64> s_allocation_count{0};
+}  // namespace
+
+// Count every heap allocation in the process so that the allocations of a measured stage can be
+// reported. Only the counter is touched, the allocation itself is left to malloc.
+void* operator new(std::size_t size)
+{
+  s_allocation_count.fetch_add(1, std::memory_order_relaxed);
+  void* ptr = std::malloc(size ? size : 1);
+  if (!ptr)
+    std::abort();
+  return ptr;
+}
+
+void* operator new[](std::size_t size)
+{
+  return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+  std::free(ptr);
+}
+
+namespace
+{
+constexpr u32 DIRECTORY_COUNT = 100;
+constexpr u32 FILES_PER_DIRECTORY = 100;
+constexpr u32 FILE_COUNT = DIRECTORY_COUNT * FILES_PER_DIRECTORY;
+
+constexpr u32 FST_OFFSET = 0x10000;
+constexpr u64 FIRST_FILE_OFFSET = 0x100000;
+constexpr u64 FILE_ALIGNMENT = 0x8000;
+constexpr u64 DISC_SIZE = 0x57058000;
+
+constexpr u32 TRACE_LENGTH = 20000;
+constexpr u32 STREAM_READ_SIZE = 0x8000;
+constexpr u32 LINES_PER_SUBTITLED_FILE = 4;
+
+struct SyntheticFile
+{
+  std::string path;
+  u64 offset;
+  u64 size;
+};
+
+struct SyntheticDisc
+{
+  std::vector<u8> header_and_fst;
+  std::vector<SyntheticFile> files;
+};
+
+void WriteSwapped32(std::vector<u8>* buffer, size_t offset, u32 value)
+{
+  const u32 swapped = Common::swap32(value);
+  std::memcpy(buffer->data() + offset, &swapped, sizeof(swapped));
+}
+
+// A GameCube disc whose only real data is its header and FST. Everything else reads as zero.
+SyntheticDisc BuildSyntheticDisc()
+{
+  SyntheticDisc disc;
+
+  constexpr u32 entry_count = 1 + DIRECTORY_COUNT + FILE_COUNT;
+  std::vector<u8> entries(entry_count * 0xC);
+  std::string names(1, '\0');
+
+  const auto add_entry = [&](u32 index, bool is_directory, const std::string& name, u32 offset,
+                             u32 size) {
+    WriteSwapped32(&entries, index * 0xC, (is_directory ? 0x01000000 : 0) | u32(names.size()));
+    WriteSwapped32(&entries, index * 0xC + 4, offset);
+    WriteSwapped32(&entries, index * 0xC + 8, size);
+    names += name;
+    names += '\0';
+  };
+
+  // The root directory entry has no name, its size is the total entry count
+  WriteSwapped32(&entries, 0, 0x01000000);
+  WriteSwapped32(&entries, 8, entry_count);
+
+  std::mt19937 rng(0);
+  std::uniform_int_distribution<u32> size_distribution(0x8000, 0x38000);
+
+  u64 file_offset = FIRST_FILE_OFFSET;
+  u32 index = 1;
+  for (u32 directory = 0; directory < DIRECTORY_COUNT; ++directory)
+  {
+    const std::string directory_name = fmt::format("dir{:02}", directory);
+    add_entry(index, true, directory_name, 0, index + 1 + FILES_PER_DIRECTORY);
+    ++index;
+
+    for (u32 file = 0; file < FILES_PER_DIRECTORY; ++file)
+    {
+      const std::string file_name = fmt::format("file{:04}.bin", directory * 100 + file);
+      const u32 size = size_distribution(rng);
+      add_entry(index, false, file_name, u32(file_offset), size);
+      disc.files.push_back({directory_name + "/" + file_name, file_offset, size});
+      file_offset = Common::AlignUp(file_offset + size, FILE_ALIGNMENT);
+      ++index;
+    }
+  }
+
+  const u32 fst_size = u32(entries.size() + names.size());
+  disc.header_and_fst.resize(FST_OFFSET + fst_size);
+  WriteSwapped32(&disc.header_and_fst, 0x1C, DiscIO::GAMECUBE_DISC_MAGIC);
+  WriteSwapped32(&disc.header_and_fst, 0x424, FST_OFFSET);
+  WriteSwapped32(&disc.header_and_fst, 0x428, fst_size);
+  std::copy(entries.begin(), entries.end(), disc.header_and_fst.begin() + FST_OFFSET);
+  std::copy(names.begin(), names.end(), disc.header_and_fst.begin() + FST_OFFSET + entries.size());
+
+  return disc;
+}
+
+class SyntheticBlobReader final : public DiscIO::BlobReader
+{
+public:
+  explicit SyntheticBlobReader(std::vector<u8> data) : m_data(std::move(data)) {}
+
+  DiscIO::BlobType GetBlobType() const override { return DiscIO::BlobType::PLAIN; }
+  std::unique_ptr<BlobReader> CopyReader() const override
+  {
+    return std::make_unique<SyntheticBlobReader>(m_data);
+  }
+
+  u64 GetRawSize() const override { return DISC_SIZE; }
+  u64 GetDataSize() const override { return DISC_SIZE; }
+  DiscIO::DataSizeType GetDataSizeType() const override
+  {
+    return DiscIO::DataSizeType::Accurate;
+  }
+
+  u64 GetBlockSize() const override { return 0; }
+  bool HasFastRandomAccessInBlock() const override { return true; }
+  std::string GetCompressionMethod() const override { return {}; }
+  std::optional<int> GetCompressionLevel() const override { return std::nullopt; }
+
+  bool Read(u64 offset, u64 size, u8* out_ptr) override
+  {
+    if (offset + size > DISC_SIZE)
+      return false;
+
+    std::memset(out_ptr, 0, size);
+    if (offset < m_data.size())
+    {
+      const u64 copy_size = std::min<u64>(size, m_data.size() - offset);
+      std::memcpy(out_ptr, m_data.data() + offset, copy_size);
+    }
+    return true;
+  }
+
+private:
+  std::vector<u8> m_data;
+};
+
+struct TraceRead
+{
+  u64 offset;
+  u32 length;
+};
+
+// Roughly what a game does while a level loads with background music: half of the reads
+// continue one of two streams, a few reads hit the header and FST, the rest are scattered loads
+// of whole small files.
+std::vector<TraceRead> BuildTrace(const std::vector<SyntheticFile>& files)
+{
+  std::mt19937 rng(1);
+  std::uniform_int_distribution<size_t> file_distribution(0, files.size() - 1);
+  std::uniform_int_distribution<u32> kind_distribution(0, 99);
+
+  std::array<size_t, 2> stream_files{file_distribution(rng), file_distribution(rng)};
+  std::array<u64, 2> stream_positions{};
+
+  std::vector<TraceRead> trace;
+  trace.reserve(TRACE_LENGTH);
+  while (trace.size() < TRACE_LENGTH)
+  {
+    const u32 kind = kind_distribution(rng);
+    if (kind < 50)
+    {
+      const size_t stream = kind % stream_files.size();
+      const SyntheticFile& file = files[stream_files[stream]];
+      trace.push_back({file.offset + stream_positions[stream], STREAM_READ_SIZE});
+
+      stream_positions[stream] += STREAM_READ_SIZE;
+      if (stream_positions[stream] >= file.size)
+      {
+        stream_files[stream] = file_distribution(rng);
+        stream_positions[stream] = 0;
+      }
+    }
+    else if (kind < 52)
+    {
+      trace.push_back({FST_OFFSET, 0x20});
+    }
+    else
+    {
+      const SyntheticFile& file = files[file_distribution(rng)];
+      for (u64 position = 0; position < file.size && trace.size() < TRACE_LENGTH;
+           position += STREAM_READ_SIZE)
+      {
+        trace.push_back(
+            {file.offset + position, u32(std::min<u64>(STREAM_READ_SIZE, file.size - position))});
+      }
+    }
+  }
+
+  return trace;
+}
+
+class LatencyRecorder
+{
+public:
+  explicit LatencyRecorder(std::string name) : m_name(std::move(name))
+  {
+    m_samples.reserve(TRACE_LENGTH);
+  }
+
+  template <typename Func>
+  void Measure(Func&& func)
+  {
+    const u64 allocations_before = s_allocation_count.load(std::memory_order_relaxed);
+    const auto start = std::chrono::steady_clock::now();
+    func();
+    const auto end = std::chrono::steady_clock::now();
+    m_allocations += s_allocation_count.load(std::memory_order_relaxed) - allocations_before;
+    m_samples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+  }
+
+  u64 GetAllocations() const { return m_allocations; }
+
+  void Report()
+  {
+    ASSERT_FALSE(m_samples.empty());
+    std::sort(m_samples.begin(), m_samples.end());
+    const auto percentile = [this](size_t p) {
+      return m_samples[(m_samples.size() - 1) * p / 100];
+    };
+    ReportBenchmark(fmt::format("{}, p50", m_name), double(percentile(50)), "ns/read");
+    ReportBenchmark(fmt::format("{}, p99", m_name), double(percentile(99)), "ns/read");
+    ReportBenchmark(fmt::format("{}, allocations", m_name),
+                    double(m_allocations) / m_samples.size(), "allocations/read");
+  }
+
+private:
+  std::string m_name;
+  std::vector<s64> m_samples;
+  u64 m_allocations = 0;
+};
+
+class DiscAccessBenchmark : public testing::Test
+{
+protected:
+  static void SetUpTestSuite()
+  {
+    s_disc = std::make_unique<SyntheticDisc>(BuildSyntheticDisc());
+    s_volume =
+        DiscIO::CreateVolume(std::make_unique<SyntheticBlobReader>(s_disc->header_and_fst));
+    s_trace = std::make_unique<std::vector<TraceRead>>(BuildTrace(s_disc->files));
+  }
+
+  static void TearDownTestSuite()
+  {
+    s_trace.reset();
+    s_volume.reset();
+    s_disc.reset();
+  }
+
+  void SetUp() override
+  {
+    ASSERT_TRUE(s_volume);
+    ASSERT_NE(nullptr, s_volume->GetFileSystem(DiscIO::PARTITION_NONE));
+  }
+
+  static std::unique_ptr<SyntheticDisc> s_disc;
+  static std::unique_ptr<DiscIO::Volume> s_volume;
+  static std::unique_ptr<std::vector<TraceRead>> s_trace;
+};
+
+std::unique_ptr<SyntheticDisc> DiscAccessBenchmark::s_disc;
+std::unique_ptr<DiscIO::Volume> DiscAccessBenchmark::s_volume;
+std::unique_ptr<std::vector<TraceRead>> DiscAccessBenchmark::s_trace;
+
+// Stands in for an observer that requests the shared FST lookup but does no work of its own
+class FileInfoObserver final : public DVD::DiscAccessObserver
+{
+public:
+  bool IsEnabled() const override { return true; }
+  bool NeedsFileInfo() const override { return true; }
+  void OnDiscAccess(const DVD::DiscAccess& access) override
+  {
+    if (access.file)
+      ++m_found;
+  }
+
+  u32 m_found = 0;
+};
+
+class DisabledObserver final : public DVD::DiscAccessObserver
+{
+public:
+  bool IsEnabled() const override { return false; }
+  void OnDiscAccess(const DVD::DiscAccess&) override {}
+};
+
+void ReplayThroughObservers(const DiscIO::Volume& volume, const std::vector<TraceRead>& trace,
+                            std::span<DVD::DiscAccessObserver* const> observers,
+                            LatencyRecorder* recorder)
+{
+  u64 ticks = 0;
+  for (const TraceRead& read : trace)
+  {
+    recorder->Measure([&] {
+      DVD::NotifyDiscAccessObservers(observers, volume, DiscIO::PARTITION_NONE, read.offset,
+                                     read.length, ticks);
+    });
+    ticks += 100000;
+  }
+}
+}  // namespace
+
+TEST_F(DiscAccessBenchmark, DisabledObservers)
+{
+  DisabledObserver observer;
+  const std::array<DVD::DiscAccessObserver*, 2> observers{&observer, &observer};
+
+  LatencyRecorder recorder("disabled observers");
+  ReplayThroughObservers(*s_volume, *s_trace, observers, &recorder);
+  recorder.Report();
+
+  // Nothing is enabled, so the DVD thread must not pay for anything but the IsEnabled calls
+  EXPECT_EQ(0u, recorder.GetAllocations());
+}
+
+TEST_F(DiscAccessBenchmark, FileInfoLookup)
+{
+  FileInfoObserver observer;
+  const std::array<DVD::DiscAccessObserver*, 1> observers{&observer};
+
+  // Wait for the file system's offset index, which is not part of a read's cost
+  s_volume->GetFileSystem(DiscIO::PARTITION_NONE)->FindFileLocation(FIRST_FILE_OFFSET);
+
+  LatencyRecorder recorder("shared FST lookup");
+  ReplayThroughObservers(*s_volume, *s_trace, observers, &recorder);
+  recorder.Report();
+
+  EXPECT_GT(observer.m_found, 0u);
+  EXPECT_EQ(0u, recorder.GetAllocations());
+}
+
+TEST_F(DiscAccessBenchmark, PathLookup)
+{
+  const DiscIO::FileSystem* file_system = s_volume->GetFileSystem(DiscIO::PARTITION_NONE);
+
+  LatencyRecorder recorder("path lookup");
+  for (const SyntheticFile& file : s_disc->files)
+  {
+    // Lookups are case insensitive and ignore leading slashes
+    std::string query = "/" + file.path;
+    Common::ToUpper(&query);
+
+    std::unique_ptr<DiscIO::FileInfo> file_info;
+    recorder.Measure([&] { file_info = file_system->FindFileInfo(query); });
+
+    ASSERT_NE(nullptr, file_info);
+    EXPECT_EQ(file.offset, file_info->GetOffset());
+    EXPECT_EQ(file.path, file_info->GetPath());
+    EXPECT_EQ(file.path, file_system->GetPath(file_info->GetIndex()));
+  }
+  recorder.Report();
+
+  EXPECT_EQ(nullptr, file_system->FindFileInfo("dir00/missing.bin"));
+  EXPECT_EQ("dir00/", file_system->GetPath(file_system->FindFileInfo("DIR00//")->GetIndex()));
+}
+
+TEST_F(DiscAccessBenchmark, FileLogger)
+{
+  using Common::Log::LogManager;
+
+  const bool owns_log_manager = !LogManager::GetInstance();
+  if (owns_log_manager)
+    LogManager::Init();
+
+  // Format the log lines like a real FILEMON session, but don't spend the time writing them out
+  LogManager* log_manager = LogManager::GetInstance();
+  for (int i = 0; i < Common::Log::LogListener::NUMBER_OF_LISTENERS; ++i)
+    log_manager->EnableListener(static_cast<Common::Log::LogListener::LISTENER>(i), false);
+  log_manager->SetLogLevel(Common::Log::LogLevel::LWARNING);
+  log_manager->SetEnable(Common::Log::LogType::FILEMON, true);
+
+  FileMonitor::FileLogger file_logger;
+  ASSERT_TRUE(file_logger.IsEnabled());
+  const std::array<DVD::DiscAccessObserver*, 1> observers{&file_logger};
+
+  LatencyRecorder recorder("FileMonitor::FileLogger");
+  ReplayThroughObservers(*s_volume, *s_trace, observers, &recorder);
+  recorder.Report();
+
+  log_manager->SetEnable(Common::Log::LogType::FILEMON, false);
+  if (owns_log_manager)
+    LogManager::Shutdown();
+}
+
+TEST_F(DiscAccessBenchmark, SubtitleLookup)
+{
+  const std::string temp_dir = File::CreateTempDir();
+  ASSERT_FALSE(temp_dir.empty());
+
+  const DiscIO::FileSystem* file_system = s_volume->GetFileSystem(DiscIO::PARTITION_NONE);
+
+  for (const u32 subtitled_files : {10u, 1000u, FILE_COUNT})
+  {
+    // Subtitle every n-th file, each with a few lines spread over its length
+    Subtitles::TranslationMap translations;
+    const u32 stride = FILE_COUNT / subtitled_files;
+    for (u32 i = 0; i < FILE_COUNT; i += stride)
+    {
+      std::string path = s_disc->files[i].path;
+      Subtitles::SubtitleEntryGroup& group = translations[path];
+      const u32 line_size = u32(s_disc->files[i].size / LINES_PER_SUBTITLED_FILE);
+      for (u32 line = 0; line < LINES_PER_SUBTITLED_FILE; ++line)
+      {
+        Subtitles::SubtitleEntry entry;
+        entry.Miliseconds = 3000;
+        entry.Color = 0xFFFFFFFF;
+        entry.Offset = line * line_size;
+        entry.OffsetEnd = (line + 1) * line_size;
+        group.Add(entry, fmt::format("Line {} of {}", line, path));
+      }
+      group.Preprocess();
+    }
+
+    // Round trip through a pack so that the lookup runs on what the game would actually load
+    const std::string pack_path =
+        temp_dir + DIR_SEP "subtitles" + Subtitles::SubtitlePackExtension;
+    ASSERT_TRUE(Subtitles::WriteSubtitlePack(pack_path, translations));
+    Subtitles::TranslationMap loaded;
+    ASSERT_TRUE(Subtitles::ReadSubtitlePack(pack_path, loaded));
+    ASSERT_EQ(translations.size(), loaded.size());
+    for (auto& [path, group] : loaded)
+      group.Preprocess();
+
+    Subtitles::SubtitleFileIndex index;
+    index.Build(*file_system, loaded);
+    ASSERT_FALSE(index.IsEmpty());
+
+    LatencyRecorder recorder(fmt::format("subtitle lookup, {} files", loaded.size()));
+    u32 hits = 0;
+    u64 emulated_ms = 0;
+    for (const TraceRead& read : *s_trace)
+    {
+      recorder.Measure([&] {
+        const Subtitles::SubtitleFileIndex::Extent* extent = index.Find(read.offset);
+        if (extent && extent->group->GetSubtitle(u32(read.offset - extent->start), emulated_ms))
+          ++hits;
+      });
+      ++emulated_ms;
+    }
+    recorder.Report();
+
+    EXPECT_EQ(0u, recorder.GetAllocations());
+    if (subtitled_files == FILE_COUNT)
+      EXPECT_GT(hits, 0u);
+  }
+
+  File::DeleteDirRecursively(temp_dir);
+}
@@ -0,0 +1,159 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Measures RVZ compression and the decompression behind disc reads. A synthetic image that mixes
+// empty, repetitive, low entropy and random blocks is converted to RVZ, then read back the way
+// streamed files and scattered loads read a disc.
+
+#include <chrono>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "Common/CommonPaths.h"
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Common/Logging/LogManager.h"
+#include "DiscIO/Blob.h"
+#include "DiscIO/WIABlob.h"
+
+#include "../../BenchmarkReport.h"
+
+namespace
+{
+constexpr u32 IMAGE_SIZE = 64 * 1024 * 1024;
+constexpr u32 BLOCK_SIZE = 0x8000;
+constexpr int CHUNK_SIZE = 128 * 1024;
+constexpr int COMPRESSION_LEVEL = 5;
+constexpr u32 RANDOM_READS = 20000;
+constexpr u32 RANDOM_READ_SIZE = 0x800;
+
+std::vector<u8> MakeImage()
+{
+  std::mt19937 rng(0);
+  std::vector<u8> image(IMAGE_SIZE);
+  for (u32 block = 0; block < IMAGE_SIZE / BLOCK_SIZE; ++block)
+  {
+    u8* const data = image.data() + block * BLOCK_SIZE;
+    switch (block % 4)
+    {
+    case 0:
+      // Padding
+      break;
+    case 1:
+      for (u32 i = 0; i < BLOCK_SIZE; ++i)
+        data[i] = "Dolphin synthetic disc image "[i % 29];
+      break;
+    case 2:
+      for (u32 i = 0; i < BLOCK_SIZE; ++i)
+        data[i] = static_cast<u8>(rng() & 0x0F);
+      break;
+    default:
+      for (u32 i = 0; i < BLOCK_SIZE; ++i)
+        data[i] = static_cast<u8>(rng());
+      break;
+    }
+  }
+  return image;
+}
+
+class RVZBenchmark : public testing::Test
+{
+protected:
+  static void SetUpTestSuite()
+  {
+    s_owns_log_manager = !Common::Log::LogManager::GetInstance();
+    if (s_owns_log_manager)
+      Common::Log::LogManager::Init();
+
+    s_temp_dir = File::CreateTempDir();
+    ASSERT_FALSE(s_temp_dir.empty());
+
+    s_image = MakeImage();
+    const std::string iso_path = s_temp_dir + DIR_SEP "image.iso";
+    {
+      File::IOFile file(iso_path, "wb");
+      ASSERT_TRUE(file.WriteBytes(s_image.data(), s_image.size()));
+    }
+
+    const std::unique_ptr<DiscIO::BlobReader> iso = DiscIO::CreateBlobReader(iso_path);
+    ASSERT_NE(nullptr, iso);
+
+    s_rvz_path = s_temp_dir + DIR_SEP "image.rvz";
+    const auto start = std::chrono::steady_clock::now();
+    const auto callback = [](const std::string&, float) { return true; };
+    ASSERT_TRUE(DiscIO::ConvertToWIAOrRVZ(iso.get(), iso_path, s_rvz_path, true,
+                                          DiscIO::WIARVZCompressionType::Zstd, COMPRESSION_LEVEL,
+                                          CHUNK_SIZE, callback));
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    ReportBenchmark("RVZ conversion, Zstandard", IMAGE_SIZE / 1e6 / elapsed.count(), "MB/s");
+  }
+
+  static void TearDownTestSuite()
+  {
+    s_image = {};
+    File::DeleteDirRecursively(s_temp_dir);
+    if (s_owns_log_manager)
+      Common::Log::LogManager::Shutdown();
+  }
+
+  static std::vector<u8> s_image;
+  static std::string s_temp_dir;
+  static std::string s_rvz_path;
+  static bool s_owns_log_manager;
+};
+
+std::vector<u8> RVZBenchmark::s_image;
+std::string RVZBenchmark::s_temp_dir;
+std::string RVZBenchmark::s_rvz_path;
+bool RVZBenchmark::s_owns_log_manager = false;
+}  // namespace
+
+TEST_F(RVZBenchmark, SequentialReads)
+{
+  const std::unique_ptr<DiscIO::BlobReader> rvz = DiscIO::CreateBlobReader(s_rvz_path);
+  ASSERT_NE(nullptr, rvz);
+  ASSERT_EQ(IMAGE_SIZE, rvz->GetDataSize());
+
+  std::vector<u8> data(IMAGE_SIZE);
+  const auto start = std::chrono::steady_clock::now();
+  for (u32 offset = 0; offset < IMAGE_SIZE; offset += BLOCK_SIZE)
+    ASSERT_TRUE(rvz->Read(offset, BLOCK_SIZE, data.data() + offset));
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  ReportBenchmark("RVZ sequential 32 KiB reads", IMAGE_SIZE / 1e6 / elapsed.count(), "MB/s");
+
+  EXPECT_EQ(s_image, data);
+}
+
+TEST_F(RVZBenchmark, RandomReads)
+{
+  const std::unique_ptr<DiscIO::BlobReader> rvz = DiscIO::CreateBlobReader(s_rvz_path);
+  ASSERT_NE(nullptr, rvz);
+
+  std::mt19937 rng(1);
+  std::vector<u64> offsets(RANDOM_READS);
+  for (u64& offset : offsets)
+  {
+    offset = std::uniform_int_distribution<u64>(0, IMAGE_SIZE / RANDOM_READ_SIZE - 1)(rng) *
+             RANDOM_READ_SIZE;
+  }
+
+  std::vector<u8> data(RANDOM_READ_SIZE);
+  u32 mismatches = 0;
+  const auto start = std::chrono::steady_clock::now();
+  for (const u64 offset : offsets)
+  {
+    ASSERT_TRUE(rvz->Read(offset, RANDOM_READ_SIZE, data.data()));
+    mismatches += data[0] != s_image[offset];
+  }
+  const std::chrono::duration<double, std::micro> elapsed =
+      std::chrono::steady_clock::now() - start;
+  ReportBenchmark("RVZ random 2 KiB reads", elapsed.count() / RANDOM_READS, "us/read");
+
+  EXPECT_EQ(0u, mismatches);
+}
@@ -249,6 +249,35 @@ TEST_F(FileSystemTest, RenameWithExistingTargetFile)
   EXPECT_EQ(metadata->size, TEST_DATA.size());
 }
 
+TEST_F(FileSystemTest, MetadataSurvivesWithoutShutdown)
+{
+  constexpr Modes other_modes{Mode::ReadWrite, Mode::Read, Mode::None};
+
+  ASSERT_EQ(m_fs->CreateDirectory(Uid{0}, Gid{0}, "/sys/d", 0, modes), ResultCode::Success);
+  ASSERT_EQ(m_fs->CreateFile(Uid{0}, Gid{0}, "/sys/d/f", 0x12, modes), ResultCode::Success);
+  ASSERT_EQ(m_fs->CreateFile(Uid{0}, Gid{0}, "/sys/deleted", 0, modes), ResultCode::Success);
+  ASSERT_EQ(m_fs->SetMetadata(Uid{0}, "/sys/d/f", 1, 2, 0x34, other_modes), ResultCode::Success);
+  ASSERT_EQ(m_fs->Rename(Uid{0}, Gid{0}, "/sys/d", "/sys/e"), ResultCode::Success);
+  ASSERT_EQ(m_fs->Delete(Uid{0}, Gid{0}, "/sys/deleted"), ResultCode::Success);
+
+  // The changes are visible to a new file system while the first one still hasn't shut down,
+  // as if Dolphin had crashed
+  const std::shared_ptr<FileSystem> fs = IOS::HLE::Kernel{}.GetFS();
+  const Result<Metadata> metadata = fs->GetMetadata(Uid{0}, Gid{0}, "/sys/e/f");
+  ASSERT_TRUE(metadata.Succeeded());
+  EXPECT_TRUE(metadata->is_file);
+  EXPECT_EQ(metadata->uid, 1u);
+  EXPECT_EQ(metadata->gid, 2);
+  EXPECT_EQ(metadata->attribute, 0x34);
+  EXPECT_EQ(metadata->modes, other_modes);
+
+  const Result<std::vector<std::string>> children = fs->ReadDirectory(Uid{0}, Gid{0}, "/sys");
+  ASSERT_TRUE(children.Succeeded());
+  EXPECT_EQ(std::count(children->begin(), children->end(), "e"), 1);
+  EXPECT_EQ(std::count(children->begin(), children->end(), "d"), 0);
+  EXPECT_EQ(std::count(children->begin(), children->end(), "deleted"), 0);
+}
+
 TEST_F(FileSystemTest, GetDirectoryStats)
 {
   auto check_stats = [this](u32 clusters, u32 inodes) {
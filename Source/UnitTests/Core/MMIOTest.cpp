@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <gtest/gtest.h>
+#include <chrono>
 #include <string>
 #include <unordered_set>
 
@@ -12,6 +13,8 @@
 #include "Core/HW/MMIO.h"
 #include "UICommon/UICommon.h"
 
+#include "../BenchmarkReport.h"
+
 // Tests that the UniqueID function returns a "unique enough" identifier
 // number: that is, it is unique in the address ranges we care about.
 TEST(UniqueID, UniqueEnough)
@@ -139,3 +142,67 @@ TEST_F(MappingTest, ReadWriteComplex)
   EXPECT_TRUE(read_called);
   EXPECT_TRUE(write_called);
 }
+
+// Measures the cost of an access through each kind of MMIO handler.
+TEST_F(MappingTest, ThroughputBenchmark)
+{
+  constexpr u32 ACCESSES = 1000000;
+  constexpr u32 CONSTANT_ADDR = 0x0C001000;
+  constexpr u32 DIRECT_ADDR = 0x0C001004;
+  constexpr u32 COMPLEX_ADDR = 0x0C001008;
+  constexpr u32 SPLIT_ADDR = 0x0C00100C;
+
+  u32 direct = 0;
+  u32 complex = 0;
+  u16 split_high = 0;
+  u16 split_low = 0;
+
+  m_mapping->Register(CONSTANT_ADDR, MMIO::Constant<u32>(0x12345678), MMIO::Nop<u32>());
+  m_mapping->Register(DIRECT_ADDR, MMIO::DirectRead<u32>(&direct),
+                      MMIO::DirectWrite<u32>(&direct));
+  m_mapping->Register(COMPLEX_ADDR,
+                      MMIO::ComplexRead<u32>([&complex](Core::System&, u32) { return complex; }),
+                      MMIO::ComplexWrite<u32>(
+                          [&complex](Core::System&, u32, u32 val) { complex = val; }));
+  // How most 32-bit registers are mapped: as two 16-bit halves
+  m_mapping->Register(SPLIT_ADDR, MMIO::DirectRead<u16>(&split_high),
+                      MMIO::DirectWrite<u16>(&split_high));
+  m_mapping->Register(SPLIT_ADDR + 2, MMIO::DirectRead<u16>(&split_low),
+                      MMIO::DirectWrite<u16>(&split_low));
+  m_mapping->Register(SPLIT_ADDR,
+                      MMIO::ReadToSmaller<u32>(m_mapping, SPLIT_ADDR, SPLIT_ADDR + 2),
+                      MMIO::WriteToSmaller<u32>(m_mapping, SPLIT_ADDR, SPLIT_ADDR + 2));
+
+  const auto measure = [](const char* name, const auto& function) {
+    const auto start = std::chrono::steady_clock::now();
+    for (u32 i = 0; i < ACCESSES; ++i)
+      function(i);
+    const auto end = std::chrono::steady_clock::now();
+
+    const double ns = std::chrono::duration<double, std::nano>(end - start).count();
+    ReportBenchmark(name, ns / ACCESSES, "ns/access");
+  };
+
+  u32 sum = 0;
+  measure("ReadConstant", [&](u32) { sum += m_mapping->Read<u32>(CONSTANT_ADDR); });
+  EXPECT_EQ(0x12345678u * ACCESSES, sum);
+
+  measure("WriteDirect", [&](u32 i) { m_mapping->Write<u32>(DIRECT_ADDR, i); });
+  EXPECT_EQ(ACCESSES - 1, direct);
+  sum = 0;
+  measure("ReadDirect", [&](u32) { sum += m_mapping->Read<u32>(DIRECT_ADDR); });
+  EXPECT_EQ((ACCESSES - 1) * ACCESSES, sum);
+
+  measure("WriteComplex", [&](u32 i) { m_mapping->Write<u32>(COMPLEX_ADDR, i); });
+  EXPECT_EQ(ACCESSES - 1, complex);
+  sum = 0;
+  measure("ReadComplex", [&](u32) { sum += m_mapping->Read<u32>(COMPLEX_ADDR); });
+  EXPECT_EQ((ACCESSES - 1) * ACCESSES, sum);
+
+  measure("WriteToSmaller", [&](u32 i) { m_mapping->Write<u32>(SPLIT_ADDR, i * 0x10001); });
+  EXPECT_EQ(static_cast<u16>(ACCESSES - 1), split_high);
+  EXPECT_EQ(static_cast<u16>(ACCESSES - 1), split_low);
+  sum = 0;
+  measure("ReadToSmaller", [&](u32) { sum += m_mapping->Read<u32>(SPLIT_ADDR); });
+  EXPECT_EQ((ACCESSES - 1) * 0x10001u * ACCESSES, sum);
+}
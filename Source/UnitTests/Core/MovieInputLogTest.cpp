@@ -0,0 +1,166 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Core/MovieInputLog.h"
+
+using Movie::InputLog;
+
+namespace
+{
+// Stands in for the DTMHeader in front of the blocks
+constexpr size_t HEADER_SIZE = 256;
+
+std::vector<u8> GetInput(size_t size, u8 seed)
+{
+  std::vector<u8> input(size);
+  for (size_t i = 0; i < size; ++i)
+    input[i] = static_cast<u8>((i / 8) * 7 + seed + (i % 8 == 0 ? i / 64 : 0));
+  return input;
+}
+
+bool SaveLog(InputLog& log, const std::string& path, const std::vector<u64>& hashes)
+{
+  File::IOFile file(path, log.CanSaveIncrementally(path) ? "r+b" : "wb");
+  const std::vector<u8> header(HEADER_SIZE, 0xdd);
+  return file.WriteBytes(header.data(), header.size()) && log.Save(file, path, hashes);
+}
+
+bool LoadLog(InputLog& log, const std::string& path, u32 hash_count, std::vector<u64>* hashes)
+{
+  File::IOFile file(path, "rb");
+  return file.Seek(HEADER_SIZE, File::SeekOrigin::Begin) &&
+         log.LoadBlocks(file, hash_count, hashes);
+}
+}  // namespace
+
+TEST(MovieInputLog, ReadsAcrossBlocks)
+{
+  const std::vector<u8> input = GetInput(InputLog::BLOCK_SIZE * 2 + 100, 1);
+
+  InputLog log;
+  for (size_t i = 0; i < input.size(); i += 8)
+    log.Append(&input[i], std::min<size_t>(8, input.size() - i));
+  ASSERT_EQ(log.GetSize(), input.size());
+
+  std::vector<u8> read(200);
+  ASSERT_TRUE(log.Read(InputLog::BLOCK_SIZE - 100, read.data(), read.size()));
+  EXPECT_TRUE(std::equal(read.begin(), read.end(), input.begin() + InputLog::BLOCK_SIZE - 100));
+  EXPECT_FALSE(log.Read(input.size() - 10, read.data(), 11));
+  EXPECT_EQ(log.ReadAll(), input);
+}
+
+TEST(MovieInputLog, TruncatesIntoCompressedBlock)
+{
+  std::vector<u8> input = GetInput(InputLog::BLOCK_SIZE * 3, 2);
+
+  InputLog log;
+  log.Append(input.data(), input.size());
+  log.Truncate(InputLog::BLOCK_SIZE + 12);
+  input.resize(InputLog::BLOCK_SIZE + 12);
+  EXPECT_EQ(log.ReadAll(), input);
+
+  const std::vector<u8> more = GetInput(InputLog::BLOCK_SIZE, 3);
+  log.Append(more.data(), more.size());
+  input.insert(input.end(), more.begin(), more.end());
+  EXPECT_EQ(log.ReadAll(), input);
+}
+
+TEST(MovieInputLog, SavesAndLoads)
+{
+  const std::string directory = File::CreateTempDir();
+  const std::string path = directory + "/movie.dtm";
+  const std::vector<u8> input = GetInput(InputLog::BLOCK_SIZE * 2 + 1000, 4);
+  const std::vector<u64> hashes = {1, 2, 3};
+
+  InputLog log;
+  log.Append(input.data(), input.size());
+  ASSERT_TRUE(SaveLog(log, path, hashes));
+
+  InputLog loaded;
+  std::vector<u64> loaded_hashes;
+  ASSERT_TRUE(LoadLog(loaded, path, static_cast<u32>(hashes.size()), &loaded_hashes));
+  EXPECT_EQ(loaded.ReadAll(), input);
+  EXPECT_EQ(loaded_hashes, hashes);
+
+  // The header says how many hashes there are, so a mismatch means the file is corrupted
+  EXPECT_FALSE(LoadLog(loaded, path, 100, &loaded_hashes));
+
+  File::DeleteDirRecursively(directory);
+}
+
+TEST(MovieInputLog, SavesIncrementally)
+{
+  const std::string directory = File::CreateTempDir();
+  const std::string incremental_path = directory + "/incremental.dtm";
+  const std::string full_path = directory + "/full.dtm";
+
+  InputLog log;
+  std::vector<u8> input = GetInput(InputLog::BLOCK_SIZE + 500, 5);
+  log.Append(input.data(), input.size());
+  ASSERT_TRUE(SaveLog(log, incremental_path, {}));
+  EXPECT_TRUE(log.CanSaveIncrementally(incremental_path));
+
+  // A rerecord undoes part of the saved input, and more is recorded after it. The first block
+  // stays as it was saved.
+  log.Truncate(InputLog::BLOCK_SIZE + 200);
+  input.resize(InputLog::BLOCK_SIZE + 200);
+  const std::vector<u8> more = GetInput(InputLog::BLOCK_SIZE * 2, 6);
+  log.Append(more.data(), more.size());
+  input.insert(input.end(), more.begin(), more.end());
+  ASSERT_TRUE(SaveLog(log, incremental_path, {7}));
+
+  InputLog full_log;
+  full_log.Append(input.data(), input.size());
+  ASSERT_TRUE(SaveLog(full_log, full_path, {7}));
+
+  InputLog loaded;
+  std::vector<u64> hashes;
+  ASSERT_TRUE(LoadLog(loaded, incremental_path, 1, &hashes));
+  EXPECT_EQ(loaded.ReadAll(), input);
+  ASSERT_EQ(hashes.size(), 1u);
+  EXPECT_EQ(hashes[0], 7u);
+  EXPECT_EQ(File::GetSize(incremental_path), File::GetSize(full_path));
+
+  File::DeleteDirRecursively(directory);
+}
+
+TEST(MovieInputLog, RewritesReplacedFile)
+{
+  const std::string directory = File::CreateTempDir();
+  const std::string path = directory + "/movie.dtm";
+
+  InputLog log;
+  std::vector<u8> input = GetInput(InputLog::BLOCK_SIZE * 2, 8);
+  log.Append(input.data(), input.size());
+  ASSERT_TRUE(SaveLog(log, path, {}));
+  EXPECT_TRUE(log.CanSaveIncrementally(path));
+
+  // Another movie that is at least as large takes the place of the saved one
+  InputLog other_log;
+  const std::vector<u8> other_input = GetInput(InputLog::BLOCK_SIZE * 3, 9);
+  other_log.Append(other_input.data(), other_input.size());
+  ASSERT_TRUE(SaveLog(other_log, path, {}));
+  EXPECT_FALSE(log.CanSaveIncrementally(path));
+
+  // So the whole movie is written again
+  const std::vector<u8> more = GetInput(100, 10);
+  log.Append(more.data(), more.size());
+  input.insert(input.end(), more.begin(), more.end());
+  ASSERT_TRUE(SaveLog(log, path, {}));
+
+  InputLog loaded;
+  std::vector<u64> hashes;
+  ASSERT_TRUE(LoadLog(loaded, path, 0, &hashes));
+  EXPECT_EQ(loaded.ReadAll(), input);
+
+  File::DeleteDirRecursively(directory);
+}
@@ -0,0 +1,211 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Common/FileUtil.h"
+#include "Common/Logging/LogManager.h"
+#include "Common/ScopeGuard.h"
+#include "Core/ConfigManager.h"
+#include "Core/NetPlayClient.h"
+#include "Core/NetPlayRollback.h"
+#include "Core/State.h"
+#include "Core/SyncIdentifier.h"
+#include "InputCommon/GCPadStatus.h"
+#include "UICommon/UICommon.h"
+
+using NetPlay::RollbackDeterminismChecker;
+using NetPlay::RollbackInputHistory;
+
+namespace
+{
+GCPadStatus Buttons(u16 button)
+{
+  GCPadStatus status;
+  status.button = button;
+  return status;
+}
+
+class LogRecorder final : public Common::Log::LogListener
+{
+public:
+  void Log(Common::Log::LogLevel level, const char* msg) override
+  {
+    std::lock_guard lk(m_mutex);
+    m_messages.emplace_back(msg);
+  }
+
+  bool Contains(std::string_view text)
+  {
+    std::lock_guard lk(m_mutex);
+    return std::any_of(m_messages.begin(), m_messages.end(),
+                       [&](const std::string& message) { return message.contains(text); });
+  }
+
+private:
+  std::mutex m_mutex;
+  std::vector<std::string> m_messages;
+};
+}  // namespace
+
+TEST(RollbackInputHistory, ReceivedInputsArePolledInOrder)
+{
+  RollbackInputHistory history;
+  EXPECT_TRUE(history.Receive(0, Buttons(1)));
+  EXPECT_TRUE(history.Receive(0, Buttons(2)));
+
+  EXPECT_FALSE(history.IsPolledUpToReceived(0));
+  EXPECT_EQ(history.Poll(0)->button, 1);
+  EXPECT_EQ(history.Poll(0)->button, 2);
+  EXPECT_TRUE(history.IsPolledUpToReceived(0));
+  EXPECT_FALSE(history.IsMispredicted());
+}
+
+TEST(RollbackInputHistory, PredictsTheLastReceivedInput)
+{
+  RollbackInputHistory history;
+  history.Receive(1, Buttons(5));
+  history.Poll(1);
+
+  for (size_t i = 0; i < RollbackInputHistory::MAX_PREDICTED_INPUTS; ++i)
+    EXPECT_EQ(history.Poll(1)->button, 5);
+  EXPECT_FALSE(history.Poll(1).has_value());
+
+  // A correctly predicted input makes room for another prediction
+  EXPECT_TRUE(history.Receive(1, Buttons(5)));
+  EXPECT_TRUE(history.Poll(1).has_value());
+  EXPECT_FALSE(history.IsMispredicted());
+}
+
+TEST(RollbackInputHistory, RollsBackToBeforeMisprediction)
+{
+  RollbackInputHistory history;
+  history.Receive(0, Buttons(1));
+  history.Poll(0);
+  const RollbackInputHistory::Positions before = history.GetPositions();
+  history.Poll(0);
+  history.Poll(0);
+  const RollbackInputHistory::Positions after = history.GetPositions();
+
+  EXPECT_FALSE(history.IsReceived(after));
+  EXPECT_TRUE(history.Receive(0, Buttons(1)));
+  EXPECT_FALSE(history.Receive(0, Buttons(2)));
+  EXPECT_TRUE(history.IsReceived(after));
+  EXPECT_TRUE(history.IsMispredicted());
+
+  EXPECT_TRUE(history.CanRollBackTo(before));
+  EXPECT_FALSE(history.CanRollBackTo(after));
+
+  history.RollBack(before);
+  EXPECT_FALSE(history.IsMispredicted());
+  EXPECT_EQ(history.Poll(0)->button, 1);
+  EXPECT_EQ(history.Poll(0)->button, 2);
+  // Past the received inputs, the new last one is predicted
+  EXPECT_EQ(history.Poll(0)->button, 2);
+}
+
+TEST(RollbackInputHistory, CantRollBackToForgottenInputs)
+{
+  RollbackInputHistory history;
+  history.Receive(0, Buttons(1));
+  const RollbackInputHistory::Positions start = history.GetPositions();
+  history.Poll(0);
+  const RollbackInputHistory::Positions polled = history.GetPositions();
+
+  history.Forget(polled);
+  EXPECT_FALSE(history.CanRollBackTo(start));
+  EXPECT_TRUE(history.CanRollBackTo(polled));
+}
+
+TEST(RollbackDeterminismChecker, SeedDependsOnGame)
+{
+  NetPlay::SyncIdentifier game;
+  game.game_id = "GALE01";
+  NetPlay::SyncIdentifier other_game = game;
+  other_game.revision = 2;
+
+  EXPECT_EQ(RollbackDeterminismChecker::GetSeed(game), RollbackDeterminismChecker::GetSeed(game));
+  EXPECT_NE(RollbackDeterminismChecker::GetSeed(game),
+            RollbackDeterminismChecker::GetSeed(other_game));
+}
+
+TEST(RollbackDeterminismChecker, ConfirmsOnceInputsAreReceived)
+{
+  RollbackInputHistory history;
+  RollbackDeterminismChecker checker(NetPlay::SyncIdentifier{});
+
+  history.Receive(0, Buttons(1));
+  history.Poll(0);
+  history.Poll(0);
+  checker.Record(60, 1000, 0, history.GetPositions());
+  EXPECT_TRUE(checker.TakeConfirmed(history).empty());
+
+  // The checksum is recorded again when the frame is emulated another time after a rollback, but
+  // only handed out once
+  history.Receive(0, Buttons(1));
+  checker.RollBack(60);
+  checker.Record(60, 1000, 0, history.GetPositions());
+  const auto confirmed = checker.TakeConfirmed(history);
+  ASSERT_EQ(confirmed.size(), 1u);
+  EXPECT_EQ(confirmed[0].first, 60u);
+
+  checker.Record(60, 1000, 0, history.GetPositions());
+  EXPECT_TRUE(checker.TakeConfirmed(history).empty());
+}
+
+// Loading savestates is disabled while NetPlay is running, but a rollback has to load the states
+// it captured
+TEST(RollbackStates, LoadWhileNetPlayIsRunning)
+{
+  const std::string profile_path = File::CreateTempDir();
+  ASSERT_FALSE(profile_path.empty());
+  UICommon::SetUserDirectory(profile_path);
+  Config::Init();
+  SConfig::Init();
+  Common::Log::LogManager::Init();
+  Common::ScopeGuard guard([&] {
+    Common::Log::LogManager::Shutdown();
+    SConfig::Shutdown();
+    Config::Shutdown();
+    File::DeleteDirRecursively(profile_path);
+  });
+
+  LogRecorder recorder;
+  auto* const log_manager = Common::Log::LogManager::GetInstance();
+  log_manager->SetLogLevel(Common::Log::LogLevel::LWARNING);
+  log_manager->SetEnable(Common::Log::LogType::CORE, true);
+  log_manager->RegisterListener(Common::Log::LogListener::LOG_WINDOW_LISTENER, &recorder);
+  log_manager->EnableListener(Common::Log::LogListener::LOG_WINDOW_LISTENER, true);
+
+  // The client is only compared against null here
+  alignas(void*) u8 placeholder_client = 0;
+  NetPlay::NetPlay_Enable(reinterpret_cast<NetPlay::NetPlayClient*>(&placeholder_client));
+  Common::ScopeGuard netplay_guard([] { NetPlay::NetPlay_Disable(); });
+
+  // A state from the other console, which is rejected as soon as it's read, so that no emulated
+  // hardware is needed
+  std::vector<u8> buffer{static_cast<u8>(!SConfig::GetInstance().bWii)};
+
+  EXPECT_FALSE(State::LoadFromBuffer(buffer));
+  log_manager->Flush();
+  EXPECT_TRUE(recorder.Contains("NetPlay is running"));
+
+  log_manager->RegisterListener(Common::Log::LogListener::LOG_WINDOW_LISTENER, nullptr);
+  LogRecorder rollback_recorder;
+  log_manager->RegisterListener(Common::Log::LogListener::LOG_WINDOW_LISTENER, &rollback_recorder);
+
+  EXPECT_FALSE(State::LoadFromRollbackBuffer(buffer, State::StateType::Keyframe));
+  EXPECT_FALSE(State::LoadFromRollbackBuffer(buffer, State::StateType::Delta));
+  log_manager->Flush();
+  EXPECT_FALSE(rollback_recorder.Contains("NetPlay is running"));
+
+  log_manager->RegisterListener(Common::Log::LogListener::LOG_WINDOW_LISTENER, nullptr);
+}
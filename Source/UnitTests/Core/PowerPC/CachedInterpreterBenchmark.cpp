@@ -0,0 +1,153 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Checks the CachedInterpreter against the Interpreter on an integer loop and measures both.
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <iterator>
+#include <string>
+
+#include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Common/FileUtil.h"
+#include "Core/ConfigManager.h"
+#include "Core/Core.h"
+#include "Core/CoreTiming.h"
+#include "Core/HW/Memmap.h"
+#include "Core/PowerPC/CachedInterpreter/CachedInterpreter.h"
+#include "Core/PowerPC/Interpreter/Interpreter.h"
+#include "Core/PowerPC/PowerPC.h"
+#include "Core/System.h"
+#include "UICommon/UICommon.h"
+
+// The emitter defines a TEST function, so gtest has to be included after the JIT
+#include <gtest/gtest.h>  // NOLINT
+
+#include "../../BenchmarkReport.h"
+
+namespace
+{
+// With address translation off, this is a physical address in MEM1
+constexpr u32 LOOP_ADDRESS = 0x00003000;
+constexpr u32 ITERATIONS = 200000;
+
+// The operands are in the order of the instruction fields, which for logical and rotate
+// instructions is the source before the destination
+constexpr u32 DForm(u32 opcode, u32 field1, u32 field2, u32 imm)
+{
+  return (opcode << 26) | (field1 << 21) | (field2 << 16) | (imm & 0xFFFF);
+}
+constexpr u32 XForm(u32 field1, u32 field2, u32 field3, u32 subop)
+{
+  return (31 << 26) | (field1 << 21) | (field2 << 16) | (field3 << 11) | (subop << 1);
+}
+constexpr u32 Rlwinm(u32 s, u32 a, u32 sh, u32 mb, u32 me)
+{
+  return (21 << 26) | (s << 21) | (a << 16) | (sh << 11) | (mb << 6) | (me << 1);
+}
+
+// for (ctr = ITERATIONS; ctr != 0; --ctr) with a body of constant loads, additions and masks
+constexpr std::array LOOP_CODE{
+    DForm(15, 3, 0, 0x8000),    // lis r3, 0x8000
+    DForm(24, 3, 3, 0x1234),    // ori r3, r3, 0x1234
+    DForm(14, 4, 4, 1),         // addi r4, r4, 1
+    Rlwinm(4, 5, 2, 0, 29),     // rlwinm r5, r4, 2, 0, 29
+    XForm(6, 5, 3, 266),        // add r6, r5, r3
+    DForm(15, 7, 0, 0x1234),    // lis r7, 0x1234
+    DForm(14, 7, 7, -0x5678),   // addi r7, r7, -0x5678
+    XForm(6, 8, 7, 316),        // xor r8, r6, r7
+    DForm(14, 9, 8, 0x10),      // addi r9, r8, 0x10
+    DForm(25, 9, 10, 0xFF),     // oris r10, r9, 0xFF
+    Rlwinm(10, 11, 31, 1, 31),  // rlwinm r11, r10, 31, 1, 31
+    XForm(12, 11, 12, 266),     // add r12, r11, r12
+    // bdnz back to the start of the loop
+    (16u << 26) | (16 << 21) | ((0u - 12 * 4) & 0xFFFC),
+};
+
+class CachedInterpreterBenchmark : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    m_profile_path = File::CreateTempDir();
+    ASSERT_FALSE(m_profile_path.empty());
+
+    Core::DeclareAsCPUThread();
+    UICommon::SetUserDirectory(m_profile_path);
+    Config::Init();
+    SConfig::Init();
+    m_system.GetMemory().Init();
+    m_system.GetPowerPC().Init(PowerPC::CPUCore::Interpreter);
+    m_system.GetCoreTiming().Init();
+
+    auto& memory = m_system.GetMemory();
+    for (u32 i = 0; i < LOOP_CODE.size(); ++i)
+      memory.Write_U32(LOOP_CODE[i], LOOP_ADDRESS + i * 4);
+  }
+
+  void TearDown() override
+  {
+    m_system.GetCoreTiming().Shutdown();
+    m_system.GetPowerPC().Shutdown();
+    m_system.GetMemory().Shutdown();
+    SConfig::Shutdown();
+    Config::Shutdown();
+    Core::UndeclareAsCPUThread();
+    File::DeleteDirRecursively(m_profile_path);
+  }
+
+  // Runs the loop from the start, with step running at least one block, and returns the
+  // registers it ends with
+  template <typename Function>
+  std::array<u32, 32> RunLoop(const char* name, const Function& step)
+  {
+    auto& ppc_state = m_system.GetPPCState();
+    ppc_state.msr.Hex = 0;
+    std::fill(std::begin(ppc_state.gpr), std::end(ppc_state.gpr), 0);
+    CTR(ppc_state) = ITERATIONS;
+    ppc_state.pc = LOOP_ADDRESS;
+    ppc_state.npc = LOOP_ADDRESS + 4;
+
+    const auto start = std::chrono::steady_clock::now();
+    while (ppc_state.pc == LOOP_ADDRESS)
+      step();
+    const auto end = std::chrono::steady_clock::now();
+
+    const double ns = std::chrono::duration<double, std::nano>(end - start).count();
+    ReportBenchmark(name, ns / ITERATIONS, "ns/iteration");
+
+    EXPECT_EQ(LOOP_ADDRESS + static_cast<u32>(LOOP_CODE.size()) * 4, ppc_state.pc);
+    EXPECT_EQ(0u, CTR(ppc_state));
+
+    std::array<u32, 32> gpr;
+    std::copy(std::begin(ppc_state.gpr), std::end(ppc_state.gpr), gpr.begin());
+    return gpr;
+  }
+
+  Core::System& m_system = Core::System::GetInstance();
+  std::string m_profile_path;
+};
+}  // namespace
+
+TEST_F(CachedInterpreterBenchmark, Loop)
+{
+  auto& core_timing = m_system.GetCoreTiming();
+
+  // Both cores start a timing slice for every block, so that only their execution differs
+  auto& interpreter = m_system.GetInterpreter();
+  const std::array<u32, 32> interpreter_gpr = RunLoop("Interpreter", [&] {
+    core_timing.Advance();
+    interpreter.SingleStepBlock();
+  });
+
+  CachedInterpreter cached_interpreter(m_system);
+  cached_interpreter.Init();
+  const std::array<u32, 32> cached_interpreter_gpr =
+      RunLoop("CachedInterpreter", [&] { cached_interpreter.SingleStep(); });
+  cached_interpreter.Shutdown();
+
+  EXPECT_EQ(ITERATIONS, interpreter_gpr[4]);
+  EXPECT_EQ(interpreter_gpr, cached_interpreter_gpr);
+}
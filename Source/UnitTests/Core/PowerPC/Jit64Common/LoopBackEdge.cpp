@@ -0,0 +1,160 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <cstddef>
+#include <string>
+
+#include "Common/BitSet.h"
+#include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Common/FileUtil.h"
+#include "Common/Swap.h"
+#include "Common/x64ABI.h"
+#include "Core/ConfigManager.h"
+#include "Core/Core.h"
+#include "Core/HW/GPFifo.h"
+#include "Core/HW/Memmap.h"
+#include "Core/HW/ProcessorInterface.h"
+#include "Core/PowerPC/Jit64/Jit.h"
+#include "Core/PowerPC/Jit64Common/Jit64Constants.h"
+#include "Core/PowerPC/Jit64Common/Jit64PowerPCState.h"
+#include "Core/PowerPC/PowerPC.h"
+#include "Core/System.h"
+#include "UICommon/UICommon.h"
+
+// The emitter defines a TEST function, so gtest has to be included after the JIT
+#include <gtest/gtest.h>  // NOLINT
+
+namespace
+{
+constexpr u32 ITERATIONS = 4;
+constexpr u32 FIFO_END = 0x1000 - GPFifo::GATHER_PIPE_SIZE;
+
+// The caller saved registers that the register caches hand out, which a loop with its registers
+// kept across the back edge can have guest registers in during the cleanup calls
+constexpr std::array LOOP_GPRS{Gen::RCX, Gen::RSI, Gen::RDI, Gen::R8, Gen::R9, Gen::R10, Gen::R11};
+constexpr std::array LOOP_FPRS{Gen::XMM2, Gen::XMM3, Gen::XMM4, Gen::XMM5};
+
+struct LoopRegisters
+{
+  std::array<u64, LOOP_GPRS.size()> gprs;
+  std::array<u64, LOOP_FPRS.size()> fprs;
+};
+
+constexpr u64 GPRValue(size_t i)
+{
+  return 0x0123456789ABCDEF ^ (0x0101010101010101 * (i + 1));
+}
+
+constexpr u64 FPRValue(size_t i)
+{
+  return 0xFEDCBA9876543210 ^ (0x1010101010101010 * (i + 1));
+}
+
+class Jit64LoopBackEdge : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    m_profile_path = File::CreateTempDir();
+    ASSERT_FALSE(m_profile_path.empty());
+
+    Core::DeclareAsCPUThread();
+    UICommon::SetUserDirectory(m_profile_path);
+    Config::Init();
+    SConfig::Init();
+    m_system.GetMemory().Init();
+    m_system.GetGPFifo().Init();
+
+    auto& processor_interface = m_system.GetProcessorInterface();
+    processor_interface.m_fifo_cpu_base = 0;
+    processor_interface.m_fifo_cpu_end = FIFO_END;
+    processor_interface.m_fifo_cpu_write_pointer = 0;
+  }
+
+  void TearDown() override
+  {
+    m_system.GetGPFifo().ResetGatherPipe();
+    m_system.GetMemory().Shutdown();
+    SConfig::Shutdown();
+    Config::Shutdown();
+    Core::UndeclareAsCPUThread();
+    File::DeleteDirRecursively(m_profile_path);
+  }
+
+  Core::System& m_system = Core::System::GetInstance();
+  std::string m_profile_path;
+};
+}  // namespace
+
+// A loop keeps its guest registers in host registers across the back edge, where the gather pipe
+// is handed to the FIFO. The call that does that must not clobber them.
+TEST_F(Jit64LoopBackEdge, CleanupKeepsLoopRegisters)
+{
+  using namespace Gen;
+
+  Jit64 jit(m_system);
+  jit.AllocCodeSpace(4096);
+  jit.jo.optimizeGatherPipe = true;
+
+  BitSet32 loop_registers;
+  for (const X64Reg reg : LOOP_GPRS)
+    loop_registers[reg] = true;
+  for (const X64Reg reg : LOOP_FPRS)
+    loop_registers[16 + reg] = true;
+
+  const auto run = reinterpret_cast<void (*)(LoopRegisters*)>(jit.AlignCode4());
+  jit.ABI_PushRegistersAndAdjustStack(ABI_ALL_CALLEE_SAVED, 8, 16);
+  jit.MOV(64, R(RPPCSTATE), ImmPtr(reinterpret_cast<u8*>(&m_system.GetPPCState()) + 0x80));
+  jit.MOV(64, R(R12), R(ABI_PARAM1));
+
+  for (size_t i = 0; i < LOOP_GPRS.size(); ++i)
+    jit.MOV(64, R(LOOP_GPRS[i]), Imm64(GPRValue(i)));
+  for (size_t i = 0; i < LOOP_FPRS.size(); ++i)
+  {
+    jit.MOV(64, R(RSCRATCH), Imm64(FPRValue(i)));
+    jit.MOVQ_xmm(LOOP_FPRS[i], R(RSCRATCH));
+  }
+  jit.MOV(32, R(R13), Imm32(ITERATIONS));
+
+  // Every iteration writes a burst to the gather pipe, so the cleanup calls into the FIFO
+  const u8* const loop = jit.GetCodePtr();
+  jit.MOV(64, R(RSCRATCH2), PPCSTATE(gather_pipe_ptr));
+  for (u32 offset = 0; offset < GPFifo::GATHER_PIPE_SIZE; offset += sizeof(u64))
+    jit.MOV(64, MDisp(RSCRATCH2, offset), R(LOOP_GPRS[0]));
+  jit.ADD(64, R(RSCRATCH2), Imm8(GPFifo::GATHER_PIPE_SIZE));
+  jit.MOV(64, PPCSTATE(gather_pipe_ptr), R(RSCRATCH2));
+  jit.js.fifoBytesSinceCheck = GPFifo::GATHER_PIPE_SIZE;
+  ASSERT_TRUE(jit.Cleanup(loop_registers));
+  jit.SUB(32, R(R13), Imm8(1));
+  jit.J_CC(CC_NZ, loop);
+
+  for (size_t i = 0; i < LOOP_GPRS.size(); ++i)
+  {
+    jit.MOV(64, MDisp(R12, static_cast<int>(offsetof(LoopRegisters, gprs) + i * sizeof(u64))),
+            R(LOOP_GPRS[i]));
+  }
+  for (size_t i = 0; i < LOOP_FPRS.size(); ++i)
+  {
+    jit.MOVQ_xmm(MDisp(R12, static_cast<int>(offsetof(LoopRegisters, fprs) + i * sizeof(u64))),
+                 LOOP_FPRS[i]);
+  }
+  jit.ABI_PopRegistersAndAdjustStack(ABI_ALL_CALLEE_SAVED, 8, 16);
+  jit.RET();
+
+  LoopRegisters registers{};
+  run(&registers);
+
+  // All the bursts went to the FIFO
+  EXPECT_EQ(ITERATIONS * GPFifo::GATHER_PIPE_SIZE,
+            m_system.GetProcessorInterface().m_fifo_cpu_write_pointer);
+  EXPECT_EQ(m_system.GetPPCState().gather_pipe_base_ptr, m_system.GetPPCState().gather_pipe_ptr);
+  EXPECT_EQ(Common::swap64(GPRValue(0)),
+            m_system.GetMemory().Read_U64((ITERATIONS - 1) * GPFifo::GATHER_PIPE_SIZE));
+
+  for (size_t i = 0; i < LOOP_GPRS.size(); ++i)
+    EXPECT_EQ(GPRValue(i), registers.gprs[i]) << "GPR " << i;
+  for (size_t i = 0; i < LOOP_FPRS.size(); ++i)
+    EXPECT_EQ(FPRValue(i), registers.fprs[i]) << "XMM" << static_cast<int>(LOOP_FPRS[i]);
+}
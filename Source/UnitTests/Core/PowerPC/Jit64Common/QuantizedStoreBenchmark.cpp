@@ -0,0 +1,149 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Measures paired stores quantized to s16 with a GQR that is known at compile time, inline as
+// psq_st emits them now and through the asm routine for the type as it emitted them before.
+
+#include <bit>
+#include <chrono>
+#include <string>
+
+#include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Common/FileUtil.h"
+#include "Common/x64ABI.h"
+#include "Core/ConfigManager.h"
+#include "Core/Core.h"
+#include "Core/HW/Memmap.h"
+#include "Core/PowerPC/Gekko.h"
+#include "Core/PowerPC/Jit64/Jit.h"
+#include "Core/PowerPC/Jit64Common/Jit64AsmCommon.h"
+#include "Core/PowerPC/Jit64Common/Jit64Constants.h"
+#include "Core/PowerPC/Jit64Common/Jit64PowerPCState.h"
+#include "Core/PowerPC/PowerPC.h"
+#include "Core/System.h"
+#include "UICommon/UICommon.h"
+
+// The emitter defines a TEST function, so gtest has to be included after the JIT
+#include <gtest/gtest.h>  // NOLINT
+
+#include "../../../BenchmarkReport.h"
+
+namespace
+{
+constexpr u32 STORES = 1 << 22;
+constexpr u32 STORE_ADDRESS = 0x1000;
+constexpr int SCALE = 8;
+constexpr u32 GQR_VALUE = (SCALE << 8) | QUANTIZE_S16;
+
+// ps0 = 1.5 and ps1 = -2.25, which are 0x0180 and 0xFDC0 scaled by 2^8
+constexpr u64 PAIR =
+    std::bit_cast<u32>(1.5f) | static_cast<u64>(std::bit_cast<u32>(-2.25f)) << 32;
+constexpr u32 QUANTIZED_PAIR = 0x0180FDC0;
+
+class QuantizedStoreRoutines : public CommonAsmRoutines
+{
+public:
+  explicit QuantizedStoreRoutines(Core::System& system)
+      : CommonAsmRoutines(jit), jit(system), m_system(system)
+  {
+    using namespace Gen;
+
+    AllocCodeSpace(16384);
+    m_const_pool.Init(AllocChildCodeSpace(1024), 1024);
+    GenQuantizedStores();
+
+    store_inline = EmitStoreLoop([&] { GenQuantizedStore(false, QUANTIZE_S16, SCALE); });
+    store_routine = EmitStoreLoop([&] {
+      MOV(32, PPCSTATE(pc), Imm32(0));
+      MOV(32, R(RSCRATCH2), Imm32(GQR_VALUE & 0x3F00));
+      CALL(paired_store_quantized[QUANTIZE_S16]);
+    });
+  }
+
+  void (*store_inline)();
+  void (*store_routine)();
+  Jit64 jit;
+
+private:
+  // Emits a function that stores PAIR to STORE_ADDRESS STORES times
+  template <typename EmitStore>
+  void (*EmitStoreLoop(const EmitStore& emit_store))()
+  {
+    using namespace Gen;
+
+    const auto function = reinterpret_cast<void (*)()>(AlignCode16());
+    ABI_PushRegistersAndAdjustStack(ABI_ALL_CALLEE_SAVED, 8, 16);
+    MOV(64, R(RPPCSTATE), ImmPtr(reinterpret_cast<u8*>(&m_system.GetPPCState()) + 0x80));
+    MOV(64, R(R12), Imm64(PAIR));
+    MOV(32, R(R13), Imm32(STORES));
+
+    // The store clobbers XMM0 and the address
+    const u8* const loop = GetCodePtr();
+    MOVQ_xmm(XMM0, R(R12));
+    MOV(32, R(RSCRATCH_EXTRA), Imm32(STORE_ADDRESS));
+    emit_store();
+    SUB(32, R(R13), Imm8(1));
+    J_CC(CC_NZ, loop);
+
+    ABI_PopRegistersAndAdjustStack(ABI_ALL_CALLEE_SAVED, 8, 16);
+    RET();
+    return function;
+  }
+
+  Core::System& m_system;
+};
+
+class Jit64QuantizedStoreBenchmark : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    m_profile_path = File::CreateTempDir();
+    ASSERT_FALSE(m_profile_path.empty());
+
+    Core::DeclareAsCPUThread();
+    UICommon::SetUserDirectory(m_profile_path);
+    Config::Init();
+    SConfig::Init();
+    m_system.GetMemory().Init();
+
+    // With address translation off, STORE_ADDRESS is in MEM1
+    m_system.GetPPCState().msr.Hex = 0;
+  }
+
+  void TearDown() override
+  {
+    m_system.GetMemory().Shutdown();
+    SConfig::Shutdown();
+    Config::Shutdown();
+    Core::UndeclareAsCPUThread();
+    File::DeleteDirRecursively(m_profile_path);
+  }
+
+  void Measure(const char* name, void (*store_loop)())
+  {
+    m_system.GetMemory().Write_U32(0, STORE_ADDRESS);
+
+    const auto start = std::chrono::steady_clock::now();
+    store_loop();
+    const auto end = std::chrono::steady_clock::now();
+
+    EXPECT_EQ(QUANTIZED_PAIR, m_system.GetMemory().Read_U32(STORE_ADDRESS)) << name;
+
+    const double seconds = std::chrono::duration<double>(end - start).count();
+    ReportBenchmark(name, STORES / seconds / 1e6, "Mstores/s");
+  }
+
+  Core::System& m_system = Core::System::GetInstance();
+  std::string m_profile_path;
+};
+}  // namespace
+
+TEST_F(Jit64QuantizedStoreBenchmark, ConstantGQR)
+{
+  QuantizedStoreRoutines routines(m_system);
+
+  Measure("psq_st s16 pair, inline", routines.store_inline);
+  Measure("psq_st s16 pair, asm routine", routines.store_routine);
+}
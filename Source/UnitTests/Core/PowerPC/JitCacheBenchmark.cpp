@@ -0,0 +1,199 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Measures block cache lookups, fast block map misses and invalidation for 1k to 50k blocks.
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <set>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Common/CommonTypes.h"
+#include "Core/Core.h"
+#include "Core/PowerPC/JitCommon/JitCache.h"
+#include "Core/PowerPC/PowerPC.h"
+#include "Core/System.h"
+
+#if defined(_M_X86_64)
+#include "Core/PowerPC/Jit64/Jit.h"
+using HostJit = Jit64;
+#elif defined(_M_ARM_64)
+#include "Core/PowerPC/JitArm64/Jit.h"
+using HostJit = JitArm64;
+#endif
+
+// The emitter defines a TEST function, so gtest has to be included after the JIT
+#include <gtest/gtest.h>  // NOLINT
+
+#include "../../BenchmarkReport.h"
+
+namespace
+{
+constexpr u32 BLOCK_BASE_ADDRESS = 0x80000000;
+constexpr u32 INSTRUCTIONS_PER_BLOCK = 16;
+constexpr u32 BLOCK_SIZE = INSTRUCTIONS_PER_BLOCK * 4;
+// Blocks 2n and 2n + 1 are this far apart, so that they share an entry in the fallback fast block
+// map. The offset is a multiple of the address range that map covers.
+constexpr u32 COLLIDING_OFFSET = 0x1000000;
+static_assert(COLLIDING_OFFSET % (JitBaseBlockCache::FAST_BLOCK_MAP_FALLBACK_ELEMENTS * 4) == 0);
+// Lines without any code in them
+constexpr u32 EMPTY_ADDRESS = BLOCK_BASE_ADDRESS + COLLIDING_OFFSET / 2;
+constexpr size_t OPERATIONS = 200000;
+
+// Doesn't emit any code, the blocks only point at a dummy entry point
+class BenchmarkBlockCache final : public JitBaseBlockCache
+{
+public:
+  using JitBaseBlockCache::JitBaseBlockCache;
+
+private:
+  void WriteLinkBlock(const JitBlock::LinkData& source, const JitBlock* dest) override {}
+};
+
+class JitCacheBenchmark : public testing::TestWithParam<u32>
+{
+protected:
+  void SetUp() override
+  {
+    Core::DeclareAsCPUThread();
+
+    // With address translation off, the physical address of a block is its effective address
+    m_system.GetPPCState().msr.Hex = 0;
+    m_jit = std::make_unique<HostJit>(m_system);
+    m_cache = std::make_unique<BenchmarkBlockCache>(*m_jit);
+
+    for (u32 i = 0; i < GetParam(); ++i)
+      AddBlock(GetBlockAddress(i));
+  }
+
+  void TearDown() override
+  {
+    m_cache.reset();
+    m_jit.reset();
+    Core::UndeclareAsCPUThread();
+  }
+
+  static u32 GetBlockAddress(u32 i)
+  {
+    return BLOCK_BASE_ADDRESS + (i & 1) * COLLIDING_OFFSET + (i >> 1) * BLOCK_SIZE;
+  }
+
+  void AddBlock(u32 address)
+  {
+    JitBlock* block = m_cache->AllocateBlock(address);
+    block->normalEntry = m_entry_point.data();
+    block->codeSize = static_cast<u32>(m_entry_point.size());
+    block->originalSize = INSTRUCTIONS_PER_BLOCK;
+
+    std::set<u32> physical_addresses;
+    for (u32 i = 0; i < INSTRUCTIONS_PER_BLOCK; ++i)
+      physical_addresses.insert(address + i * 4);
+    m_cache->FinalizeBlock(*block, false, physical_addresses);
+  }
+
+  // Block indices in random order, the same for every run
+  std::vector<u32> GetRandomBlockIndices(size_t count)
+  {
+    std::mt19937 rng(GetParam());
+    std::uniform_int_distribution<u32> distribution(0, GetParam() - 1);
+    std::vector<u32> indices(count);
+    std::generate(indices.begin(), indices.end(), [&] { return distribution(rng); });
+    return indices;
+  }
+
+  template <typename Function>
+  void Measure(const char* name, size_t count, const Function& function)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < count; ++i)
+      function(i);
+    const auto end = std::chrono::steady_clock::now();
+
+    const double ns = std::chrono::duration<double, std::nano>(end - start).count();
+    ReportBenchmark(fmt::format("{}, {} blocks", name, GetParam()), ns / count, "ns/op");
+  }
+
+  Core::System& m_system = Core::System::GetInstance();
+  std::unique_ptr<HostJit> m_jit;
+  std::unique_ptr<BenchmarkBlockCache> m_cache;
+  std::array<u8, 16> m_entry_point{};
+};
+}  // namespace
+
+// Dispatching to pairs of blocks whose entries in the fast block map replace each other, so that
+// nearly every dispatch goes through the slow lookup. The cache isn't initialized, so it uses the
+// fallback fast block map, but a miss in the full fast block map takes the same path.
+TEST_P(JitCacheBenchmark, DispatchMiss)
+{
+  auto& ppc_state = m_system.GetPPCState();
+  const std::vector<u32> indices = GetRandomBlockIndices(OPERATIONS);
+  Measure("DispatchMiss", OPERATIONS, [&](size_t i) {
+    ppc_state.pc = GetBlockAddress((indices[i / 2] & ~1u) | (i & 1));
+    const u8* entry_point = m_cache->Dispatch();
+    ASSERT_EQ(entry_point, m_entry_point.data());
+  });
+}
+
+TEST_P(JitCacheBenchmark, LookupHit)
+{
+  const std::vector<u32> indices = GetRandomBlockIndices(OPERATIONS);
+  Measure("LookupHit", OPERATIONS, [&](size_t i) {
+    const u32 address = GetBlockAddress(indices[i]);
+    const JitBlock* block = m_cache->GetBlockFromStartAddress(address, 0);
+    ASSERT_NE(block, nullptr);
+    ASSERT_EQ(block->effectiveAddress, address);
+  });
+}
+
+TEST_P(JitCacheBenchmark, LookupMiss)
+{
+  // The second instruction of a block never starts a block
+  const std::vector<u32> indices = GetRandomBlockIndices(OPERATIONS);
+  Measure("LookupMiss", OPERATIONS, [&](size_t i) {
+    ASSERT_EQ(m_cache->GetBlockFromStartAddress(GetBlockAddress(indices[i]) + 4, 0), nullptr);
+  });
+}
+
+// Self-modifying code: a cache line of a block is invalidated, then the block is compiled again
+TEST_P(JitCacheBenchmark, InvalidateAndRecompile)
+{
+  const std::vector<u32> indices = GetRandomBlockIndices(OPERATIONS);
+  Measure("InvalidateAndRecompile", OPERATIONS, [&](size_t i) {
+    const u32 address = GetBlockAddress(indices[i]);
+    m_cache->InvalidateICacheLine(address + 32);
+    ASSERT_EQ(m_cache->GetBlockFromStartAddress(address, 0), nullptr);
+    AddBlock(address);
+  });
+
+  // The neighbours of the invalidated blocks must have survived
+  for (u32 i = 0; i < GetParam(); ++i)
+    ASSERT_NE(m_cache->GetBlockFromStartAddress(GetBlockAddress(i), 0), nullptr);
+}
+
+// Invalidating lines without any code, which dcbi and friends do all the time
+TEST_P(JitCacheBenchmark, InvalidateEmpty)
+{
+  Measure("InvalidateEmpty", OPERATIONS, [&](size_t i) {
+    m_cache->InvalidateICache(EMPTY_ADDRESS + static_cast<u32>(i % 0x1000) * 32, 32, false);
+  });
+}
+
+// Invalidating a whole range, as a game loading a new code overlay does
+TEST_P(JitCacheBenchmark, InvalidateRange)
+{
+  Measure("InvalidateRange", 1, [&](size_t) {
+    m_cache->InvalidateICache(BLOCK_BASE_ADDRESS, COLLIDING_OFFSET + GetParam() / 2 * BLOCK_SIZE,
+                              false);
+  });
+
+  size_t remaining_blocks = 0;
+  m_cache->RunOnBlocks([&](const JitBlock&) { ++remaining_blocks; });
+  EXPECT_EQ(remaining_blocks, 0u);
+}
+
+INSTANTIATE_TEST_SUITE_P(BlockCounts, JitCacheBenchmark, testing::Values(1000, 10000, 50000));
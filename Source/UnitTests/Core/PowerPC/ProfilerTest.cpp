@@ -0,0 +1,78 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <picojson.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/SymbolDB.h"
+#include "Core/PowerPC/PPCSymbolDB.h"
+#include "Core/PowerPC/Profiler.h"
+
+namespace
+{
+Profiler::ProfileStats GetStats()
+{
+  Profiler::ProfileStats stats;
+  stats.block_stats.emplace_back(0x80003000, 100, 2000, 10, 64);
+  stats.block_stats.emplace_back(0x80003020, 50, 1000, 5, 32);
+  stats.block_stats.emplace_back(0x80004000, 20, 500, 1, 16);
+  stats.countsPerSec = 1000000000;
+  return stats;
+}
+
+void AddFunction(PPCSymbolDB* db, u32 address, u32 size, const std::string& name)
+{
+  Common::Symbol symbol(name);
+  symbol.address = address;
+  symbol.size = size;
+  db->AddCompleteSymbol(symbol);
+}
+}  // namespace
+
+TEST(Profiler, AddsUpBlocksOfFunctions)
+{
+  PPCSymbolDB db;
+  AddFunction(&db, 0x80003000, 0x100, "Update");
+  AddFunction(&db, 0x80005000, 0x100, "Unused");
+
+  const std::vector<Profiler::FunctionStat> functions =
+      Profiler::GetFunctionStats(GetStats(), db);
+  ASSERT_EQ(functions.size(), 1u);
+  EXPECT_EQ(functions[0].addr, 0x80003000u);
+  EXPECT_EQ(functions[0].name, "Update");
+  EXPECT_EQ(functions[0].cost, 150u);
+  EXPECT_EQ(functions[0].tick_counter, 3000u);
+  EXPECT_EQ(functions[0].run_count, 15u);
+  EXPECT_EQ(functions[0].block_count, 2u);
+}
+
+TEST(Profiler, WritesSpeedscopeProfile)
+{
+  PPCSymbolDB db;
+  AddFunction(&db, 0x80003000, 0x100, "Update");
+
+  picojson::value root;
+  ASSERT_TRUE(picojson::parse(root, Profiler::GetSpeedscopeJSON(GetStats(), db)).empty());
+
+  // The function and three blocks
+  const picojson::array& frames = root.get("shared").get("frames").get<picojson::array>();
+  ASSERT_EQ(frames.size(), 4u);
+  EXPECT_EQ(frames[0].get("name").get<std::string>(), "Update");
+
+  const picojson::array& profiles = root.get("profiles").get<picojson::array>();
+  ASSERT_EQ(profiles.size(), 2u);
+  const picojson::array& samples = profiles[0].get("samples").get<picojson::array>();
+  ASSERT_EQ(samples.size(), 3u);
+  EXPECT_EQ(samples[0].get<picojson::array>().size(), 2u);
+  EXPECT_EQ(samples[1].get<picojson::array>()[0].get<double>(), 0.0);
+  // The last block isn't in a function
+  EXPECT_EQ(samples[2].get<picojson::array>().size(), 1u);
+
+  EXPECT_EQ(profiles[0].get("endValue").get<double>(), 170.0);
+  EXPECT_EQ(profiles[1].get("unit").get<std::string>(), "nanoseconds");
+  EXPECT_EQ(profiles[1].get("endValue").get<double>(), 3500.0);
+}
@@ -0,0 +1,115 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Measures saving and loading the emulated memory, which is most of what a savestate holds, as
+// full, keyframe and delta states.
+
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "Common/ChunkFile.h"
+#include "Common/CommonTypes.h"
+#include "Core/StateDelta.h"
+
+#include "../BenchmarkReport.h"
+
+namespace
+{
+constexpr u32 MEM1_SIZE = 24 * 1024 * 1024;
+constexpr u32 MEM2_SIZE = 64 * 1024 * 1024;
+// Roughly what a game touches in a second
+constexpr u32 CHANGED_PAGES_PERCENT = 3;
+constexpr int RUNS = 8;
+
+struct Memory
+{
+  State::DeltaArray array;
+  std::vector<u8> data;
+};
+
+class StateDeltaBenchmark : public testing::TestWithParam<u32>
+{
+protected:
+  void TearDown() override { State::SetStateType(State::StateType::Full); }
+
+  template <typename Function>
+  double MeasureMs(const Function& function)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < RUNS; ++i)
+      function();
+    const std::chrono::duration<double, std::milli> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count() / RUNS;
+  }
+};
+
+std::vector<u8> Save(Memory& memory, State::StateType type)
+{
+  State::SetStateType(type);
+  u8* ptr = nullptr;
+  PointerWrap p_measure(&ptr, 0, PointerWrap::Mode::Measure);
+  memory.array.DoState(p_measure, memory.data.data(), static_cast<u32>(memory.data.size()));
+  std::vector<u8> buffer(reinterpret_cast<size_t>(ptr));
+
+  ptr = buffer.data();
+  PointerWrap p(&ptr, buffer.size(), PointerWrap::Mode::Write);
+  memory.array.DoState(p, memory.data.data(), static_cast<u32>(memory.data.size()));
+  State::SetStateType(State::StateType::Full);
+  EXPECT_TRUE(p.IsWriteMode());
+  return buffer;
+}
+
+void Load(Memory& memory, std::vector<u8>& buffer, State::StateType type)
+{
+  State::SetStateType(type);
+  u8* ptr = buffer.data();
+  PointerWrap p(&ptr, buffer.size(), PointerWrap::Mode::Read);
+  memory.array.DoState(p, memory.data.data(), static_cast<u32>(memory.data.size()));
+  State::SetStateType(State::StateType::Full);
+  EXPECT_TRUE(p.IsReadMode());
+}
+}  // namespace
+
+TEST_P(StateDeltaBenchmark, SaveAndLoad)
+{
+  const u32 size = GetParam();
+  const char* const console = size == MEM1_SIZE ? "GameCube" : "Wii";
+
+  std::mt19937 rng(0);
+  Memory memory;
+  memory.data.resize(size);
+  for (u8& byte : memory.data)
+    byte = static_cast<u8>(rng());
+
+  std::vector<u8> full;
+  ReportBenchmark(fmt::format("{} memory, full save", console),
+                  MeasureMs([&] { full = Save(memory, State::StateType::Full); }), "ms");
+  ReportBenchmark(fmt::format("{} memory, full load", console),
+                  MeasureMs([&] { Load(memory, full, State::StateType::Full); }), "ms");
+
+  std::vector<u8> keyframe;
+  ReportBenchmark(fmt::format("{} memory, keyframe save", console),
+                  MeasureMs([&] { keyframe = Save(memory, State::StateType::Keyframe); }), "ms");
+
+  const u32 pages = size / State::DeltaArray::PAGE_SIZE;
+  for (u32 i = 0; i < pages * CHANGED_PAGES_PERCENT / 100; ++i)
+  {
+    const u32 page = std::uniform_int_distribution<u32>(0, pages - 1)(rng);
+    memory.data[page * State::DeltaArray::PAGE_SIZE + rng() % State::DeltaArray::PAGE_SIZE] ^= 1;
+  }
+
+  std::vector<u8> delta;
+  ReportBenchmark(fmt::format("{} memory, delta save", console),
+                  MeasureMs([&] { delta = Save(memory, State::StateType::Delta); }), "ms");
+  EXPECT_LT(delta.size(), size / 10);
+  ReportBenchmark(fmt::format("{} memory, delta load", console),
+                  MeasureMs([&] { Load(memory, delta, State::StateType::Delta); }), "ms");
+}
+
+INSTANTIATE_TEST_SUITE_P(Consoles, StateDeltaBenchmark,
+                         testing::Values(MEM1_SIZE, MEM1_SIZE + MEM2_SIZE));
@@ -0,0 +1,154 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/ChunkFile.h"
+#include "Common/CommonTypes.h"
+#include "Core/StateDelta.h"
+
+namespace
+{
+constexpr u32 SIZE = State::DeltaArray::PAGE_SIZE * 8 + 100;
+
+std::vector<u8> Save(State::DeltaArray& array, std::vector<u8>& data, State::StateType type)
+{
+  State::SetStateType(type);
+
+  u8* ptr = nullptr;
+  PointerWrap p_measure(&ptr, 0, PointerWrap::Mode::Measure);
+  array.DoState(p_measure, data.data(), SIZE);
+  std::vector<u8> buffer(reinterpret_cast<size_t>(ptr));
+
+  ptr = buffer.data();
+  PointerWrap p(&ptr, buffer.size(), PointerWrap::Mode::Write);
+  array.DoState(p, data.data(), SIZE);
+
+  State::SetStateType(State::StateType::Full);
+  if (!p.IsWriteMode())
+    buffer.clear();
+  return buffer;
+}
+
+bool Load(State::DeltaArray& array, std::vector<u8>& data, std::vector<u8>& buffer,
+          State::StateType type)
+{
+  State::SetStateType(type);
+  u8* ptr = buffer.data();
+  PointerWrap p(&ptr, buffer.size(), PointerWrap::Mode::Read);
+  array.DoState(p, data.data(), SIZE);
+  State::SetStateType(State::StateType::Full);
+  return p.IsReadMode();
+}
+}  // namespace
+
+TEST(StateDelta, DeltaWithoutKeyframeFails)
+{
+  State::DeltaArray array;
+  std::vector<u8> data(SIZE);
+  EXPECT_TRUE(Save(array, data, State::StateType::Delta).empty());
+}
+
+TEST(StateDelta, DeltaStoresChangedPages)
+{
+  State::DeltaArray array;
+  std::vector<u8> data(SIZE);
+  for (u32 i = 0; i < SIZE; i++)
+    data[i] = static_cast<u8>(i * 7);
+
+  const std::vector<u8> keyframe = data;
+  EXPECT_EQ(Save(array, data, State::StateType::Keyframe).size(), SIZE);
+
+  // One byte in the second page, and the last partial page
+  data[State::DeltaArray::PAGE_SIZE + 5] ^= 0xff;
+  data[SIZE - 1] ^= 0xff;
+  const std::vector<u8> changed = data;
+
+  std::vector<u8> delta = Save(array, data, State::StateType::Delta);
+  ASSERT_FALSE(delta.empty());
+  EXPECT_LT(delta.size(), State::DeltaArray::PAGE_SIZE + 200);
+
+  // Loading the delta restores the unchanged pages from the keyframe
+  std::vector<u8> loaded(SIZE, 0x55);
+  ASSERT_TRUE(Load(array, loaded, delta, State::StateType::Delta));
+  EXPECT_EQ(loaded, changed);
+
+  // A full state doesn't change the base
+  std::vector<u8> full = Save(array, data, State::StateType::Full);
+  EXPECT_EQ(full.size(), SIZE);
+  EXPECT_EQ(Save(array, data, State::StateType::Delta), delta);
+
+  std::vector<u8> keyframe_buffer = keyframe;
+  ASSERT_TRUE(Load(array, loaded, keyframe_buffer, State::StateType::Keyframe));
+  EXPECT_EQ(loaded, keyframe);
+}
+
+TEST(StateDelta, FullStateReferencesArrayInPlace)
+{
+  State::DeltaArray array;
+  std::vector<u8> data(SIZE, 0x12);
+  std::vector<PointerWrap::ExternalRegion> regions;
+
+  u32 before = 1;
+  u32 after = 2;
+  const auto do_state = [&](PointerWrap& p) {
+    p.Do(before);
+    array.DoState(p, data.data(), SIZE);
+    p.Do(after);
+  };
+
+  u8* ptr = nullptr;
+  PointerWrap p_measure(&ptr, 0, PointerWrap::Mode::Measure, &regions);
+  do_state(p_measure);
+  std::vector<u8> buffer(reinterpret_cast<size_t>(ptr));
+  EXPECT_EQ(buffer.size(), 2 * sizeof(u32));
+
+  ptr = buffer.data();
+  PointerWrap p(&ptr, buffer.size(), PointerWrap::Mode::Write, &regions);
+  do_state(p);
+  ASSERT_TRUE(p.IsWriteMode());
+  ASSERT_EQ(regions.size(), 1u);
+  EXPECT_EQ(regions[0].offset, sizeof(u32));
+  EXPECT_EQ(regions[0].data, data.data());
+  EXPECT_EQ(regions[0].size, SIZE);
+
+  // Splicing the region back in gives a state that loads like a copied one
+  std::vector<u8> state(buffer.begin(), buffer.begin() + sizeof(u32));
+  state.insert(state.end(), data.begin(), data.end());
+  state.insert(state.end(), buffer.begin() + sizeof(u32), buffer.end());
+
+  before = 0;
+  after = 0;
+  std::vector<u8> expected = data;
+  data.assign(SIZE, 0);
+  ptr = state.data();
+  PointerWrap p_read(&ptr, state.size(), PointerWrap::Mode::Read);
+  do_state(p_read);
+  ASSERT_TRUE(p_read.IsReadMode());
+  EXPECT_EQ(before, 1u);
+  EXPECT_EQ(after, 2u);
+  EXPECT_EQ(data, expected);
+}
+
+TEST(StateDelta, CaptureLoadsKeyframeUnlessItIsTheBase)
+{
+  // A delta of the current base only needs itself
+  State::CaptureLoad load = State::GetCaptureLoad(3, 1, 1);
+  EXPECT_FALSE(load.load_keyframe);
+  EXPECT_TRUE(load.load_delta);
+
+  // A delta of another keyframe needs that one first
+  load = State::GetCaptureLoad(5, 4, 1);
+  EXPECT_TRUE(load.load_keyframe);
+  EXPECT_TRUE(load.load_delta);
+
+  // A keyframe is loaded even when it's the current base
+  for (const u64 base : {u64(0), u64(1), u64(4)})
+  {
+    load = State::GetCaptureLoad(4, 4, base);
+    EXPECT_TRUE(load.load_keyframe);
+    EXPECT_FALSE(load.load_delta);
+  }
+}
@@ -0,0 +1,174 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Measures subtitle color and line lookups and subtitle JSON and pack parsing.
+
+#include <chrono>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "Common/CommonPaths.h"
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/Logging/LogManager.h"
+#include "Subtitles/SubtitleEntry.h"
+#include "Subtitles/SubtitleLoader.h"
+#include "Subtitles/SubtitlePack.h"
+#include "Subtitles/WebColors.h"
+
+#include "../../BenchmarkReport.h"
+
+namespace
+{
+constexpr size_t LOOKUPS = 1000000;
+constexpr u32 LINE_SPACING = 0x800;
+constexpr u32 JSON_LINES = 20000;
+
+template <typename Function>
+double MeasureNs(size_t iterations, const Function& function)
+{
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < iterations; ++i)
+    function(i);
+  const auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+}
+
+Subtitles::SubtitleEntryGroup MakeGroup(u32 lines, bool timestamps)
+{
+  Subtitles::SubtitleEntryGroup group;
+  group.Reserve(lines, lines * 16);
+  for (u32 i = 0; i < lines; ++i)
+  {
+    Subtitles::SubtitleEntry entry;
+    entry.Miliseconds = 1000;
+    if (timestamps)
+    {
+      entry.Timestamp = (i + 1) * 2000;
+    }
+    else
+    {
+      entry.Offset = (i + 1) * LINE_SPACING;
+      entry.OffsetEnd = entry.Offset + LINE_SPACING / 2;
+    }
+    group.Add(entry, fmt::format("Line {}", i));
+  }
+  group.Preprocess();
+  return group;
+}
+
+class SubtitlesBenchmark : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    m_owns_log_manager = !Common::Log::LogManager::GetInstance();
+    if (m_owns_log_manager)
+      Common::Log::LogManager::Init();
+
+    m_temp_dir = File::CreateTempDir();
+    ASSERT_FALSE(m_temp_dir.empty());
+  }
+
+  void TearDown() override
+  {
+    File::DeleteDirRecursively(m_temp_dir);
+    if (m_owns_log_manager)
+      Common::Log::LogManager::Shutdown();
+  }
+
+  std::string m_temp_dir;
+  bool m_owns_log_manager = false;
+};
+}  // namespace
+
+TEST_F(SubtitlesBenchmark, ColorLookup)
+{
+  const std::vector<std::string_view> names{"aliceblue", "red",     "yellowgreen", "gold",
+                                            "notacolor", "crimson", "zzz",         "white"};
+
+  u32 found = 0;
+  const double ns = MeasureNs(LOOKUPS, [&](size_t i) {
+    if (Subtitles::FindWebColor(names[i % names.size()]))
+      ++found;
+  });
+  ReportBenchmark("web color", ns, "ns/lookup");
+
+  EXPECT_EQ(LOOKUPS / names.size() * 6, found);
+}
+
+TEST_F(SubtitlesBenchmark, LineLookup)
+{
+  std::mt19937 random(1234);
+
+  for (const u32 line_count : {10u, 1000u, 100000u})
+  {
+    Subtitles::SubtitleEntryGroup offsets = MakeGroup(line_count, false);
+    const u32 file_size = (line_count + 1) * LINE_SPACING;
+
+    // Streaming reads move forward by a sector at a time
+    u32 hits = 0;
+    double ns = MeasureNs(LOOKUPS, [&](size_t i) {
+      if (offsets.GetSubtitle(u32(i * 0x800 % file_size), 0))
+        ++hits;
+    });
+    ReportBenchmark(fmt::format("offset, sequential, {} lines", line_count), ns, "ns/lookup");
+    EXPECT_GT(hits, 0u);
+
+    std::vector<u32> random_offsets(4096);
+    for (u32& offset : random_offsets)
+      offset = std::uniform_int_distribution<u32>(0, file_size - 1)(random);
+    ns = MeasureNs(LOOKUPS, [&](size_t i) {
+      offsets.GetSubtitle(random_offsets[i % random_offsets.size()], 0);
+    });
+    ReportBenchmark(fmt::format("offset, random, {} lines", line_count), ns, "ns/lookup");
+
+    Subtitles::SubtitleEntryGroup timestamps = MakeGroup(line_count, true);
+    const u64 duration_ms = u64(line_count + 1) * 2000;
+    timestamps.GetSubtitle(0, 0);
+    ns = MeasureNs(LOOKUPS, [&](size_t i) { timestamps.GetSubtitle(1, i % duration_ms); });
+    ReportBenchmark(fmt::format("timestamp, {} lines", line_count), ns, "ns/lookup");
+  }
+}
+
+TEST_F(SubtitlesBenchmark, Parsing)
+{
+  std::string json = "[\n";
+  for (u32 i = 0; i < JSON_LINES; ++i)
+  {
+    json += fmt::format(R"(  {{"FileName": "audio/track{}.adp", "Translation": "Line {} of the )"
+                        R"(track", "Offset": {}, "OffsetEnd": {}, "Color": "gold"}}{})",
+                        i / 100, i, (i % 100 + 1) * LINE_SPACING, (i % 100 + 2) * LINE_SPACING,
+                        i + 1 == JSON_LINES ? "\n" : ",\n");
+  }
+  json += "]\n";
+
+  const std::string json_path = m_temp_dir + DIR_SEP "subtitles.json";
+  ASSERT_TRUE(File::WriteStringToFile(json_path, json));
+
+  Subtitles::TranslationMap translations;
+  auto start = std::chrono::steady_clock::now();
+  Subtitles::ReadSubtitleJson(json_path, translations);
+  auto end = std::chrono::steady_clock::now();
+  double ms = std::chrono::duration<double, std::milli>(end - start).count();
+  ReportBenchmark(fmt::format("JSON, {} lines", JSON_LINES), ms, "ms");
+  ReportBenchmark(fmt::format("JSON, {} lines", JSON_LINES), json.size() / 1000.0 / ms, "MB/s");
+  ASSERT_EQ(JSON_LINES / 100, translations.size());
+
+  const std::string pack_path =
+      m_temp_dir + DIR_SEP "subtitles" + Subtitles::SubtitlePackExtension;
+  ASSERT_TRUE(Subtitles::WriteSubtitlePack(pack_path, translations));
+
+  Subtitles::TranslationMap loaded;
+  start = std::chrono::steady_clock::now();
+  ASSERT_TRUE(Subtitles::ReadSubtitlePack(pack_path, loaded));
+  end = std::chrono::steady_clock::now();
+  ms = std::chrono::duration<double, std::milli>(end - start).count();
+  ReportBenchmark(fmt::format("pack, {} lines", JSON_LINES), ms, "ms");
+  EXPECT_EQ(translations.size(), loaded.size());
+}
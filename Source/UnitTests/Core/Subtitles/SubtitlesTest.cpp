@@ -0,0 +1,328 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <picojson.h>
+
+#include "Common/CommonPaths.h"
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/Logging/LogManager.h"
+#include "Subtitles/Helpers.h"
+#include "Subtitles/SubtitleEntry.h"
+#include "Subtitles/SubtitleLoader.h"
+#include "Subtitles/SubtitleManifest.h"
+#include "Subtitles/SubtitlePack.h"
+#include "Subtitles/WebColors.h"
+
+namespace
+{
+Subtitles::SubtitleEntry OffsetLine(u32 offset, u32 offset_end)
+{
+  Subtitles::SubtitleEntry entry;
+  entry.Miliseconds = 1000;
+  entry.Offset = offset;
+  entry.OffsetEnd = offset_end;
+  return entry;
+}
+
+Subtitles::SubtitleEntry TimestampLine(u64 timestamp, u32 ms)
+{
+  Subtitles::SubtitleEntry entry;
+  entry.Miliseconds = ms;
+  entry.Timestamp = timestamp;
+  return entry;
+}
+
+// The loader logs through the LogManager, which the test runner doesn't set up
+class SubtitleLoaderTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    m_owns_log_manager = !Common::Log::LogManager::GetInstance();
+    if (m_owns_log_manager)
+      Common::Log::LogManager::Init();
+
+    m_temp_dir = File::CreateTempDir();
+    ASSERT_FALSE(m_temp_dir.empty());
+  }
+
+  void TearDown() override
+  {
+    File::DeleteDirRecursively(m_temp_dir);
+    if (m_owns_log_manager)
+      Common::Log::LogManager::Shutdown();
+  }
+
+  void WriteManifest(const std::string& json)
+  {
+    ASSERT_TRUE(File::WriteStringToFile(
+        m_temp_dir + DIR_SEP + Subtitles::SubtitleManifestFileName, json));
+  }
+
+  std::string m_temp_dir;
+  bool m_owns_log_manager = false;
+};
+}  // namespace
+
+TEST(WebColors, FindsNames)
+{
+  EXPECT_EQ(0xFFF0F8FFu, Subtitles::FindWebColor("aliceblue"));
+  EXPECT_EQ(0xFFFF0000u, Subtitles::FindWebColor("red"));
+  EXPECT_EQ(0xFF9ACD32u, Subtitles::FindWebColor("yellowgreen"));
+}
+
+TEST(WebColors, RejectsUnknownNames)
+{
+  EXPECT_FALSE(Subtitles::FindWebColor(""));
+  EXPECT_FALSE(Subtitles::FindWebColor("re"));
+  EXPECT_FALSE(Subtitles::FindWebColor("redd"));
+  EXPECT_FALSE(Subtitles::FindWebColor("zzz"));
+  // Names are expected to be lowercased already
+  EXPECT_FALSE(Subtitles::FindWebColor("Red"));
+}
+
+TEST(WebColors, ParsesColorValues)
+{
+  constexpr u32 DEFAULT_COLOR = 0x12345678;
+  EXPECT_EQ(0xFF00FF00u, Subtitles::TryParsecolor(picojson::value(double(0xFF00FF00)), 0));
+  EXPECT_EQ(0xFF00FF00u, Subtitles::TryParsecolor(picojson::value("0xFF00FF00"), 0));
+  EXPECT_EQ(0xFFFF0000u, Subtitles::TryParsecolor(picojson::value("Red"), 0));
+  EXPECT_EQ(DEFAULT_COLOR, Subtitles::TryParsecolor(picojson::value("notacolor"), DEFAULT_COLOR));
+  EXPECT_EQ(DEFAULT_COLOR, Subtitles::TryParsecolor(picojson::value(), DEFAULT_COLOR));
+}
+
+TEST(SubtitleEntryGroup, FindsLinesByOffset)
+{
+  Subtitles::SubtitleEntryGroup group;
+  // Added out of order, Preprocess sorts them
+  group.Add(OffsetLine(0x2000, 0x3000), "second");
+  group.Add(OffsetLine(0x1000, 0x1800), "first");
+  group.Add(OffsetLine(0x4000, 0), "open");
+  group.Preprocess();
+
+  EXPECT_EQ(nullptr, group.GetSubtitle(0x800, 0));
+  ASSERT_NE(nullptr, group.GetSubtitle(0x1000, 0));
+  EXPECT_EQ("first", group.GetText(*group.GetSubtitle(0x1400, 0)));
+  EXPECT_EQ(nullptr, group.GetSubtitle(0x1C00, 0));
+  EXPECT_EQ("second", group.GetText(*group.GetSubtitle(0x2800, 0)));
+  // A line without an end covers the rest of the file
+  EXPECT_EQ("open", group.GetText(*group.GetSubtitle(0x100000, 0)));
+  // Going back after the cursor moved forward
+  EXPECT_EQ("first", group.GetText(*group.GetSubtitle(0x1000, 0)));
+}
+
+TEST(SubtitleEntryGroup, FindsLinesByTimestamp)
+{
+  Subtitles::SubtitleEntryGroup group;
+  group.Add(TimestampLine(1000, 500), "first");
+  group.Add(TimestampLine(3000, 500), "second");
+  group.Preprocess();
+
+  // Reading the start of the file starts the timer
+  EXPECT_EQ(nullptr, group.GetSubtitle(0, 10000));
+  EXPECT_EQ("first", group.GetText(*group.GetSubtitle(0x800, 11200)));
+  EXPECT_EQ(nullptr, group.GetSubtitle(0x800, 12000));
+  EXPECT_EQ("second", group.GetText(*group.GetSubtitle(0x800, 13000)));
+
+  // Playback positions are timed by the stream instead
+  EXPECT_EQ("first", group.GetText(*group.GetSubtitleAtPlayback(0x800, 1200)));
+  EXPECT_EQ(nullptr, group.GetSubtitleAtPlayback(0x800, 2000));
+}
+
+TEST_F(SubtitleLoaderTest, ParsesJson)
+{
+  const std::string path = m_temp_dir + DIR_SEP "subtitles.json";
+  ASSERT_TRUE(File::WriteStringToFile(path, R"([
+    {"FileName": "audio/intro.adp", "Translation": "Hello", "Offset": 4096,
+     "OffsetEnd": 8192, "Color": "gold", "Scale": 1.5, "DisplayOnTop": true},
+    {"FileName": "audio/intro.adp", "Translation": "Disabled", "Enabled": false},
+    {"FileName": "audio/intro.adp"},
+    {"FileName": "movie.thp", "Translation": "World", "Timestamp": 2500,
+     "Miliseconds": 4000, "Color": "0xFF112233", "AllowDuplicate": true}
+  ])"));
+
+  Subtitles::TranslationMap translations;
+  Subtitles::ReadSubtitleJson(path, translations);
+  ASSERT_EQ(2u, translations.size());
+
+  const Subtitles::SubtitleEntryGroup& intro = translations["audio/intro.adp"];
+  ASSERT_EQ(1u, intro.subtitleLines.size());
+  const Subtitles::SubtitleEntry& hello = intro.subtitleLines[0];
+  EXPECT_EQ("Hello", intro.GetText(hello));
+  EXPECT_EQ(4096u, hello.Offset);
+  EXPECT_EQ(8192u, hello.OffsetEnd);
+  EXPECT_EQ(0xFFFFD700u, hello.Color);
+  EXPECT_FLOAT_EQ(1.5f, hello.Scale);
+  EXPECT_TRUE(hello.DisplayOnTop);
+  EXPECT_FALSE(hello.AllowDuplicate);
+
+  const Subtitles::SubtitleEntryGroup& movie = translations["movie.thp"];
+  ASSERT_EQ(1u, movie.subtitleLines.size());
+  const Subtitles::SubtitleEntry& world = movie.subtitleLines[0];
+  EXPECT_EQ("World", movie.GetText(world));
+  EXPECT_EQ(2500u, world.Timestamp);
+  EXPECT_EQ(4000u, world.Miliseconds);
+  EXPECT_EQ(0xFF112233u, world.Color);
+  EXPECT_TRUE(world.AllowDuplicate);
+}
+
+TEST_F(SubtitleLoaderTest, PackRoundTrip)
+{
+  Subtitles::TranslationMap translations;
+  translations["a.adp"].Add(OffsetLine(0x100, 0x200), "first");
+  translations["a.adp"].Add(OffsetLine(0x300, 0), "second");
+  translations["b.thp"].Add(TimestampLine(1000, 2000), "third");
+
+  const std::string path = m_temp_dir + DIR_SEP "subtitles" + Subtitles::SubtitlePackExtension;
+  ASSERT_TRUE(Subtitles::WriteSubtitlePack(path, translations));
+
+  Subtitles::TranslationMap loaded;
+  ASSERT_TRUE(Subtitles::ReadSubtitlePack(path, loaded));
+  ASSERT_EQ(translations.size(), loaded.size());
+  for (const auto& [filename, group] : translations)
+  {
+    const Subtitles::SubtitleEntryGroup& loaded_group = loaded[filename];
+    ASSERT_EQ(group.subtitleLines.size(), loaded_group.subtitleLines.size());
+    for (size_t i = 0; i < group.subtitleLines.size(); ++i)
+    {
+      const Subtitles::SubtitleEntry& line = group.subtitleLines[i];
+      const Subtitles::SubtitleEntry& loaded_line = loaded_group.subtitleLines[i];
+      EXPECT_EQ(group.GetText(line), loaded_group.GetText(loaded_line));
+      EXPECT_EQ(line.Offset, loaded_line.Offset);
+      EXPECT_EQ(line.OffsetEnd, loaded_line.OffsetEnd);
+      EXPECT_EQ(line.Timestamp, loaded_line.Timestamp);
+      EXPECT_EQ(line.Miliseconds, loaded_line.Miliseconds);
+    }
+  }
+}
+
+TEST_F(SubtitleLoaderTest, ReadsManifest)
+{
+  WriteManifest(R"({
+    "DefaultLanguage": "en",
+    "Shards": [
+      {"Path": "en/menus.json", "Language": "en"},
+      {"Language": "en"},
+      {"Path": 5},
+      {"Path": "voice", "Directories": ["/sound\\voice/", 7, "//"]}
+    ]
+  })");
+
+  const std::optional<Subtitles::SubtitleManifest> manifest =
+      Subtitles::SubtitleManifest::Read(m_temp_dir);
+  ASSERT_TRUE(manifest);
+  EXPECT_EQ("en", manifest->default_language);
+
+  // Shards without a path are skipped, as are directories that aren't strings
+  ASSERT_EQ(2u, manifest->shards.size());
+  EXPECT_EQ("en/menus.json", manifest->shards[0].path);
+  EXPECT_EQ("en", manifest->shards[0].language);
+  EXPECT_TRUE(manifest->shards[0].directories.empty());
+  EXPECT_EQ("voice", manifest->shards[1].path);
+  EXPECT_EQ("", manifest->shards[1].language);
+  EXPECT_EQ((std::vector<std::string>{"sound/voice", ""}), manifest->shards[1].directories);
+}
+
+TEST_F(SubtitleLoaderTest, RejectsBadManifests)
+{
+  EXPECT_FALSE(Subtitles::SubtitleManifest::Read(m_temp_dir));
+
+  WriteManifest(R"({"Shards": [)");
+  EXPECT_FALSE(Subtitles::SubtitleManifest::Read(m_temp_dir));
+
+  WriteManifest(R"({"DefaultLanguage": "en"})");
+  EXPECT_FALSE(Subtitles::SubtitleManifest::Read(m_temp_dir));
+
+  WriteManifest(R"({"Shards": {"Path": "en.json"}})");
+  EXPECT_FALSE(Subtitles::SubtitleManifest::Read(m_temp_dir));
+
+  // Everything else is optional
+  WriteManifest(R"({"DefaultLanguage": 1, "Shards": []})");
+  const std::optional<Subtitles::SubtitleManifest> manifest =
+      Subtitles::SubtitleManifest::Read(m_temp_dir);
+  ASSERT_TRUE(manifest);
+  EXPECT_EQ("", manifest->default_language);
+  EXPECT_TRUE(manifest->shards.empty());
+}
+
+TEST(SubtitleManifest, FallsBackToDefaultLanguage)
+{
+  Subtitles::SubtitleManifest manifest;
+  manifest.default_language = "en";
+  manifest.shards = {{"common.json", "", {}}, {"en.json", "en", {}}, {"de.json", "DE", {}}};
+
+  const auto paths = [&](std::string_view language) {
+    std::vector<std::string> result;
+    for (const Subtitles::SubtitleShard& shard : manifest.GetShards(language))
+      result.push_back(shard.path);
+    return result;
+  };
+
+  // Shards without a language are always used, languages are compared case-insensitively
+  EXPECT_EQ((std::vector<std::string>{"common.json", "de.json"}), paths("de"));
+  EXPECT_EQ((std::vector<std::string>{"common.json", "en.json"}), paths("en"));
+  EXPECT_EQ((std::vector<std::string>{"common.json", "en.json"}), paths("fr"));
+  EXPECT_EQ((std::vector<std::string>{"common.json", "en.json"}), paths(""));
+}
+
+TEST_F(SubtitleLoaderTest, LoadsPendingShardOnce)
+{
+  ASSERT_TRUE(File::CreateDir(m_temp_dir + DIR_SEP "voice"));
+  ASSERT_TRUE(File::WriteStringToFile(m_temp_dir + DIR_SEP "voice" DIR_SEP "lines.json", R"([
+    {"FileName": "a.adp", "Translation": "shard", "Offset": 4096, "OffsetEnd": 8192},
+    {"FileName": "b.adp", "Translation": "new file", "Offset": 0}
+  ])"));
+
+  // Lines loaded at boot, the shard's lines of the same file are merged into them
+  Subtitles::TranslationMap translations;
+  translations["a.adp"].Add(OffsetLine(0x4000, 0x5000), "boot");
+  translations["a.adp"].Preprocess();
+
+  Subtitles::PendingShards shards;
+  shards.Reset(m_temp_dir, {{"voice", "", {"sound/voice"}}});
+  ASSERT_EQ(1u, shards.GetCount());
+  EXPECT_FALSE(shards.IsLoaded(0));
+
+  const std::optional<Subtitles::PendingShards::Load> load = shards.Begin(0);
+  ASSERT_TRUE(load);
+  EXPECT_TRUE(shards.IsLoaded(0));
+  // Later accesses to the shard's files don't read it again
+  EXPECT_FALSE(shards.Begin(0));
+
+  ASSERT_TRUE(shards.Finish(
+      *load, Subtitles::ReadSubtitleShard(load->subtitle_directory, load->shard), translations));
+  ASSERT_EQ(2u, translations.size());
+
+  Subtitles::SubtitleEntryGroup& a = translations["a.adp"];
+  ASSERT_EQ(2u, a.subtitleLines.size());
+  EXPECT_EQ("shard", a.GetText(*a.GetSubtitle(0x1000, 0)));
+  EXPECT_EQ("boot", a.GetText(*a.GetSubtitle(0x4000, 0)));
+  const Subtitles::SubtitleEntryGroup& b = translations["b.adp"];
+  ASSERT_EQ(1u, b.subtitleLines.size());
+  EXPECT_EQ("new file", b.GetText(b.subtitleLines[0]));
+}
+
+TEST(PendingShards, DropsLoadsOfThePreviousTitle)
+{
+  Subtitles::PendingShards shards;
+  shards.Reset("old", {{"voice", "", {"sound/voice"}}});
+  const std::optional<Subtitles::PendingShards::Load> load = shards.Begin(0);
+  ASSERT_TRUE(load);
+
+  // The title changes while the shard is read
+  shards.Reset("new", {{"voice", "", {"sound/voice"}}});
+  EXPECT_FALSE(shards.IsLoaded(0));
+
+  Subtitles::TranslationMap lines;
+  lines["a.adp"].Add(OffsetLine(0x1000, 0x2000), "old title");
+  Subtitles::TranslationMap translations;
+  EXPECT_FALSE(shards.Finish(*load, std::move(lines), translations));
+  EXPECT_TRUE(translations.empty());
+}
@@ -0,0 +1,127 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "VideoCommon/BoundingBox.h"
+#include "VideoCommon/VideoConfig.h"
+
+namespace
+{
+// Pretends to be the GPU, drawing touches the values directly
+class FakeBoundingBox final : public BoundingBox
+{
+public:
+  bool Initialize() override { return true; }
+
+  std::array<BBoxType, NUM_BBOX_VALUES> gpu_values = {};
+  u32 read_count = 0;
+
+protected:
+  std::vector<BBoxType> Read(u32 index, u32 length) override
+  {
+    read_count++;
+    return std::vector<BBoxType>(gpu_values.begin() + index, gpu_values.begin() + index + length);
+  }
+
+  void Write(u32 index, const std::vector<BBoxType>& values) override
+  {
+    for (size_t i = 0; i < values.size(); i++)
+      gpu_values[index + i] = values[i];
+  }
+};
+
+class BoundingBoxTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    g_ActiveConfig.bBBoxEnable = true;
+    g_ActiveConfig.backend_info.bSupportsBBox = true;
+
+    // A box from (100, 100) to (199, 199), as read back from the GPU
+    bbox.gpu_values = {100, 199, 100, 199};
+    bbox.Flush();
+    bbox.Get(0);
+    bbox.read_count = 0;
+  }
+
+  FakeBoundingBox bbox;
+};
+}  // namespace
+
+TEST_F(BoundingBoxTest, DrawInsideKeepsValues)
+{
+  bbox.AddEstimatedBounds(MathUtil::Rectangle<int>(120, 120, 180, 180));
+  bbox.Flush();
+
+  EXPECT_EQ(bbox.Get(0), 100);
+  EXPECT_EQ(bbox.Get(1), 199);
+  EXPECT_EQ(bbox.Get(2), 100);
+  EXPECT_EQ(bbox.Get(3), 199);
+  EXPECT_EQ(bbox.read_count, 0u);
+}
+
+TEST_F(BoundingBoxTest, DrawBeyondEdgeReadsBackThatEdge)
+{
+  bbox.AddEstimatedBounds(MathUtil::Rectangle<int>(150, 120, 250, 180));
+  bbox.Flush();
+  bbox.gpu_values[1] = 249;
+
+  EXPECT_EQ(bbox.Get(0), 100);
+  EXPECT_EQ(bbox.read_count, 0u);
+  EXPECT_EQ(bbox.Get(1), 249);
+  EXPECT_EQ(bbox.read_count, 1u);
+}
+
+TEST_F(BoundingBoxTest, DrawOnPixelGroupOfEdgeReadsBack)
+{
+  // Pixel 199 is in the same 2x2 group as pixel 198, the right value can't change
+  bbox.AddEstimatedBounds(MathUtil::Rectangle<int>(150, 120, 200, 180));
+  bbox.Flush();
+  EXPECT_EQ(bbox.Get(1), 199);
+  EXPECT_EQ(bbox.read_count, 0u);
+
+  // Pixel 200 starts a new group
+  bbox.AddEstimatedBounds(MathUtil::Rectangle<int>(150, 120, 201, 180));
+  bbox.Flush();
+  bbox.Get(1);
+  EXPECT_EQ(bbox.read_count, 1u);
+}
+
+TEST_F(BoundingBoxTest, UnestimatedDrawReadsBack)
+{
+  bbox.Flush();
+  bbox.Get(0);
+  EXPECT_EQ(bbox.read_count, 1u);
+
+  bbox.AddEstimatedBounds(MathUtil::Rectangle<int>(120, 120, 180, 180));
+  bbox.AddUnboundedDraw();
+  bbox.Flush();
+  bbox.Get(0);
+  EXPECT_EQ(bbox.read_count, 2u);
+}
+
+TEST_F(BoundingBoxTest, ResetValuesAreExtendedByAnyDraw)
+{
+  // What games write before drawing, 1023 0 1023 0
+  bbox.Set(0, 1023);
+  bbox.Set(1, 0);
+  bbox.Set(2, 1023);
+  bbox.Set(3, 0);
+
+  bbox.AddEstimatedBounds(MathUtil::Rectangle<int>(0, 0, 0, 0));
+  bbox.Flush();
+  EXPECT_EQ(bbox.Get(0), 1023);
+  EXPECT_EQ(bbox.read_count, 0u);
+
+  bbox.AddEstimatedBounds(MathUtil::Rectangle<int>(10, 10, 20, 20));
+  bbox.Flush();
+  bbox.gpu_values = {10, 19, 10, 19};
+  EXPECT_EQ(bbox.Get(0), 10);
+  EXPECT_EQ(bbox.Get(3), 19);
+  EXPECT_EQ(bbox.read_count, 1u);
+}
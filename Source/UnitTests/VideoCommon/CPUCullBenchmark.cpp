@@ -0,0 +1,144 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Checks each CPU cull vertex transform the host supports against plain C++ and measures it.
+
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>  // NOLINT
+
+#include "Common/CommonTypes.h"
+#include "Core/System.h"
+#include "VideoCommon/CPMemory.h"
+#include "VideoCommon/CPUCull.h"
+#include "VideoCommon/VertexShaderManager.h"
+#include "VideoCommon/XFMemory.h"
+
+#include "../BenchmarkReport.h"
+
+namespace
+{
+// Not a multiple of 16, so that the tails of the wider transforms get checked as well
+constexpr int VERTEX_COUNT = 4099;
+constexpr u32 STRIDE = 32;
+constexpr int RUNS = 500;
+// Each position matrix takes up three rows, keep the last one inside posMatrices
+constexpr u32 MATRIX_COUNT = 16;
+
+class CPUCullBenchmark : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<float> distribution(-2.0f, 2.0f);
+
+    auto& vertex_shader_manager = Core::System::GetInstance().GetVertexShaderManager();
+    vertex_shader_manager.Init();
+
+    for (float& value : xfmem.posMatrices)
+      value = distribution(rng);
+    g_main_cp_state.matrix_index_a.PosNormalMtxIdx = 3;
+
+    // The transforms use the clip transform of the manager, which includes the free look view
+    xfmem.projection.type = ProjectionType::Orthographic;
+    for (float& value : xfmem.projection.rawProjection)
+      value = distribution(rng);
+    vertex_shader_manager.SetProjectionChanged();
+    vertex_shader_manager.SetProjectionMatrix();
+
+    // The posmtx index, then the position, then space for other attributes
+    m_vertices.resize(VERTEX_COUNT * STRIDE);
+    for (int i = 0; i < VERTEX_COUNT; i++)
+    {
+      u8* vertex = &m_vertices[i * STRIDE];
+      const u32 index = (i % MATRIX_COUNT) * 3;
+      std::memcpy(vertex, &index, sizeof(index));
+      for (u32 j = 1; j < STRIDE / sizeof(float); j++)
+      {
+        const float value = distribution(rng);
+        std::memcpy(vertex + j * sizeof(float), &value, sizeof(value));
+      }
+    }
+  }
+
+  static CPUCull::TransformedVertex Transform(const u8* vertex, bool position_has_3_elems,
+                                              bool per_vertex_posmtx)
+  {
+    u32 index = g_main_cp_state.matrix_index_a.PosNormalMtxIdx;
+    if (per_vertex_posmtx)
+    {
+      index = vertex[0] & 0x3f;
+      vertex += sizeof(u32);
+    }
+
+    float position[4] = {0.0f, 0.0f, 0.0f, 1.0f};
+    std::memcpy(position, vertex, (position_has_3_elems ? 3 : 2) * sizeof(float));
+
+    float view[4] = {0.0f, 0.0f, 0.0f, 1.0f};
+    for (int row = 0; row < 3; row++)
+    {
+      for (int column = 0; column < 4; column++)
+        view[row] += xfmem.posMatrices[index * 4 + row * 4 + column] * position[column];
+    }
+
+    const float* clip_transform =
+        Core::System::GetInstance().GetVertexShaderManager().GetClipTransform();
+    float clip[4] = {};
+    for (int row = 0; row < 4; row++)
+    {
+      for (int column = 0; column < 4; column++)
+        clip[row] += clip_transform[row * 4 + column] * view[column];
+    }
+    return {clip[0], clip[1], clip[2], clip[3]};
+  }
+
+  std::vector<u8> m_vertices;
+  // The transforms store whole vector registers
+  alignas(64) std::array<CPUCull::TransformedVertex, VERTEX_COUNT> m_output;
+};
+}  // namespace
+
+TEST_F(CPUCullBenchmark, TransformVertices)
+{
+  for (const CPUCull::InstructionSet instruction_set : CPUCull::GetSupportedInstructionSets())
+  {
+    for (const bool position_has_3_elems : {false, true})
+    {
+      for (const bool per_vertex_posmtx : {false, true})
+      {
+        const CPUCull::TransformFunction transform = CPUCull::GetTransformFunction(
+            instruction_set, position_has_3_elems, per_vertex_posmtx);
+        ASSERT_NE(transform, nullptr);
+
+        const u8* vertices = m_vertices.data() + (per_vertex_posmtx ? 0 : sizeof(u32));
+        transform(m_output.data(), vertices, STRIDE, VERTEX_COUNT);
+        for (int i = 0; i < VERTEX_COUNT; i++)
+        {
+          const CPUCull::TransformedVertex expected =
+              Transform(vertices + i * STRIDE, position_has_3_elems, per_vertex_posmtx);
+          // The results only differ in rounding, and whether FMA is used
+          constexpr float TOLERANCE = 1e-3f;
+          ASSERT_NEAR(m_output[i].x, expected.x, TOLERANCE) << "vertex " << i;
+          ASSERT_NEAR(m_output[i].y, expected.y, TOLERANCE) << "vertex " << i;
+          ASSERT_NEAR(m_output[i].z, expected.z, TOLERANCE) << "vertex " << i;
+          ASSERT_NEAR(m_output[i].w, expected.w, TOLERANCE) << "vertex " << i;
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < RUNS; i++)
+          transform(m_output.data(), vertices, STRIDE, VERTEX_COUNT);
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        ReportBenchmark(fmt::format("{}, position: {}, posmtx: {}",
+                                    CPUCull::GetInstructionSetName(instruction_set),
+                                    position_has_3_elems ? 3 : 2, per_vertex_posmtx),
+                        RUNS * VERTEX_COUNT / elapsed.count() / 1e6, "Mvertices/s");
+      }
+    }
+  }
+}
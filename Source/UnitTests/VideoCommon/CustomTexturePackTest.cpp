@@ -0,0 +1,176 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "VideoCommon/Assets/CustomTexturePack.h"
+#include "VideoCommon/TextureConfig.h"
+
+using VideoCommon::CustomTextureData;
+using VideoCommon::CustomTexturePack;
+using VideoCommon::CustomTexturePackInput;
+
+namespace
+{
+CustomTextureData::ArraySlice::Level MakeLevel(AbstractTextureFormat format, u32 width, u32 height,
+                                               u32 size, u8 seed)
+{
+  CustomTextureData::ArraySlice::Level level;
+  level.format = format;
+  level.width = width;
+  level.height = height;
+  level.row_length = width;
+  level.data.resize(size);
+  for (u32 i = 0; i < size; ++i)
+    level.data[i] = static_cast<u8>(seed + i * 7);
+  return level;
+}
+
+class CustomTexturePackTest : public testing::Test
+{
+protected:
+  CustomTexturePackTest()
+      : m_directory(File::CreateTempDir()),
+        m_path(m_directory + "/textures" + VideoCommon::CustomTexturePackExtension)
+  {
+  }
+
+  ~CustomTexturePackTest() override
+  {
+    if (!m_directory.empty())
+      File::DeleteDirRecursively(m_directory);
+  }
+
+  std::string m_directory;
+  std::string m_path;
+};
+}  // namespace
+
+TEST_F(CustomTexturePackTest, RoundTrip)
+{
+  ASSERT_FALSE(m_directory.empty());
+
+  std::vector<CustomTexturePackInput> inputs(2);
+  inputs[0].name = "tex1_8x8_b";
+  inputs[0].slice.m_levels.push_back(MakeLevel(AbstractTextureFormat::DXT1, 8, 8, 32, 1));
+  inputs[0].slice.m_levels.push_back(MakeLevel(AbstractTextureFormat::DXT1, 4, 4, 8, 2));
+  inputs[0].slice.m_levels.push_back(MakeLevel(AbstractTextureFormat::DXT1, 2, 2, 8, 3));
+  inputs[1].name = "tex1_4x2_a";
+  inputs[1].has_arbitrary_mipmaps = true;
+  inputs[1].slice.m_levels.push_back(MakeLevel(AbstractTextureFormat::RGBA8, 4, 2, 32, 4));
+  const std::vector<CustomTexturePackInput> expected = inputs;
+
+  ASSERT_TRUE(VideoCommon::WriteCustomTexturePack(m_path, inputs));
+
+  CustomTexturePack pack;
+  ASSERT_TRUE(pack.Open(m_path));
+  ASSERT_EQ(pack.GetTextureCount(), 2u);
+  EXPECT_FALSE(pack.FindTexture("tex1_4x2_c"));
+  EXPECT_FALSE(pack.FindTexture("tex1_4x2"));
+
+  for (const CustomTexturePackInput& input : expected)
+  {
+    const std::optional<u32> index = pack.FindTexture(input.name);
+    ASSERT_TRUE(index);
+    EXPECT_EQ(pack.GetTextureName(*index), input.name);
+    EXPECT_EQ(pack.HasArbitraryMipmaps(*index), input.has_arbitrary_mipmaps);
+
+    for (const auto& level : pack.GetLevels(*index))
+      EXPECT_EQ(level.data_offset % VideoCommon::CUSTOM_TEXTURE_PACK_DATA_ALIGNMENT, 0u);
+
+    CustomTextureData::ArraySlice slice;
+    size_t expected_size = 0;
+    for (const auto& level : input.slice.m_levels)
+      expected_size += level.data.size();
+    EXPECT_EQ(pack.LoadTexture(*index, &slice), expected_size);
+
+    ASSERT_EQ(slice.m_levels.size(), input.slice.m_levels.size());
+    for (size_t i = 0; i < slice.m_levels.size(); ++i)
+    {
+      EXPECT_EQ(slice.m_levels[i].format, input.slice.m_levels[i].format);
+      EXPECT_EQ(slice.m_levels[i].width, input.slice.m_levels[i].width);
+      EXPECT_EQ(slice.m_levels[i].height, input.slice.m_levels[i].height);
+      EXPECT_EQ(slice.m_levels[i].row_length, input.slice.m_levels[i].row_length);
+      EXPECT_EQ(slice.m_levels[i].data, input.slice.m_levels[i].data);
+    }
+  }
+}
+
+TEST_F(CustomTexturePackTest, RejectsDuplicateNames)
+{
+  std::vector<CustomTexturePackInput> inputs(2);
+  for (auto& input : inputs)
+  {
+    input.name = "tex1_4x4_a";
+    input.slice.m_levels.push_back(MakeLevel(AbstractTextureFormat::RGBA8, 4, 4, 64, 0));
+  }
+  EXPECT_FALSE(VideoCommon::WriteCustomTexturePack(m_path, inputs));
+}
+
+TEST_F(CustomTexturePackTest, RejectsTruncatedPack)
+{
+  std::vector<CustomTexturePackInput> inputs(1);
+  inputs[0].name = "tex1_4x4_a";
+  inputs[0].slice.m_levels.push_back(MakeLevel(AbstractTextureFormat::RGBA8, 4, 4, 64, 0));
+  ASSERT_TRUE(VideoCommon::WriteCustomTexturePack(m_path, inputs));
+
+  {
+    File::IOFile file(m_path, "r+b");
+    ASSERT_TRUE(file.Resize(file.GetSize() - 1));
+  }
+
+  CustomTexturePack pack;
+  EXPECT_FALSE(pack.Open(m_path));
+}
+
+TEST_F(CustomTexturePackTest, RejectsInvalidLevels)
+{
+  const auto write_level = [this](const CustomTextureData::ArraySlice::Level& level) {
+    std::vector<CustomTexturePackInput> inputs(1);
+    inputs[0].name = "tex1_4x4_a";
+    inputs[0].slice.m_levels.push_back(level);
+    return VideoCommon::WriteCustomTexturePack(m_path, inputs);
+  };
+
+  EXPECT_TRUE(write_level(MakeLevel(AbstractTextureFormat::RGBA8, 4, 4, 64, 0)));
+  EXPECT_FALSE(write_level(MakeLevel(AbstractTextureFormat::RGBA8, 0, 4, 64, 0)));
+  EXPECT_FALSE(write_level(MakeLevel(AbstractTextureFormat::RGBA8, 4, 0, 64, 0)));
+  EXPECT_FALSE(write_level(MakeLevel(AbstractTextureFormat::RGBA8, 4, 4, 63, 0)));
+  // Compressed levels are stored in whole blocks
+  EXPECT_TRUE(write_level(MakeLevel(AbstractTextureFormat::DXT5, 2, 6, 32, 0)));
+  EXPECT_FALSE(write_level(MakeLevel(AbstractTextureFormat::DXT5, 2, 6, 16, 0)));
+
+  auto short_rows = MakeLevel(AbstractTextureFormat::RGBA8, 4, 4, 64, 0);
+  short_rows.row_length = 3;
+  EXPECT_FALSE(write_level(short_rows));
+}
+
+TEST_F(CustomTexturePackTest, RejectsLevelLargerThanItsData)
+{
+  std::vector<CustomTexturePackInput> inputs(1);
+  inputs[0].name = "tex1_4x4_a";
+  inputs[0].slice.m_levels.push_back(MakeLevel(AbstractTextureFormat::RGBA8, 4, 4, 64, 0));
+  ASSERT_TRUE(VideoCommon::WriteCustomTexturePack(m_path, inputs));
+
+  // Claim a larger texture than the data that was written for it
+  {
+    File::IOFile file(m_path, "r+b");
+    VideoCommon::CustomTexturePackHeader header;
+    ASSERT_TRUE(file.ReadArray(&header, 1));
+    VideoCommon::CustomTexturePackLevel level;
+    ASSERT_TRUE(file.Seek(header.level_table_offset, File::SeekOrigin::Begin));
+    ASSERT_TRUE(file.ReadArray(&level, 1));
+    level.width = 64;
+    level.row_length = 64;
+    ASSERT_TRUE(file.Seek(header.level_table_offset, File::SeekOrigin::Begin));
+    ASSERT_TRUE(file.WriteArray(&level, 1));
+  }
+
+  CustomTexturePack pack;
+  EXPECT_FALSE(pack.Open(m_path));
+}
@@ -0,0 +1,83 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <chrono>
+
+#include <gtest/gtest.h>
+
+#include "VideoCommon/FramePacer.h"
+
+using namespace std::chrono_literals;
+
+namespace
+{
+// Presents a frame that waits for the display for whatever is left of the refresh after the CPU
+// was delayed
+void PresentWithSlack(FramePacer& pacer, DT slack)
+{
+  const DT wait = std::max(DT::zero(), slack - pacer.GetDelay());
+  pacer.AddPresent(wait + 1ms, wait, true);
+}
+}  // namespace
+
+TEST(FramePacer, ConvergesToTargetWait)
+{
+  FramePacer pacer;
+  for (int i = 0; i < 200; ++i)
+    PresentWithSlack(pacer, 7ms);
+
+  const DT expected = 7ms - FramePacer::TARGET_WAIT;
+  EXPECT_NEAR(DT_ms(pacer.GetDelay()).count(), DT_ms(expected).count(), 0.1);
+}
+
+TEST(FramePacer, ClampsToMaxDelay)
+{
+  FramePacer pacer;
+  for (int i = 0; i < 500; ++i)
+    PresentWithSlack(pacer, 30ms);
+
+  EXPECT_EQ(pacer.GetDelay(), FramePacer::MAX_DELAY);
+}
+
+TEST(FramePacer, BacksOffAtOnce)
+{
+  FramePacer pacer;
+  for (int i = 0; i < 200; ++i)
+    PresentWithSlack(pacer, 7ms);
+  ASSERT_GT(pacer.GetDelay(), DT::zero());
+
+  // A frame that didn't wait at all moves the CPU back by the whole target
+  const DT before = pacer.GetDelay();
+  pacer.AddPresent(5ms, DT::zero(), true);
+  EXPECT_EQ(pacer.GetDelay(), before - FramePacer::TARGET_WAIT);
+
+  for (int i = 0; i < 10; ++i)
+    pacer.AddPresent(5ms, DT::zero(), true);
+  EXPECT_EQ(pacer.GetDelay(), DT::zero());
+}
+
+TEST(FramePacer, NoDelayWhenDisabled)
+{
+  FramePacer pacer;
+  for (int i = 0; i < 200; ++i)
+    PresentWithSlack(pacer, 7ms);
+  pacer.AddPresent(8ms, 7ms, false);
+  EXPECT_EQ(pacer.GetDelay(), DT::zero());
+}
+
+TEST(FramePacer, KeepsRecentSamples)
+{
+  FramePacer pacer;
+  const std::size_t count = FramePacer::NUM_SAMPLES + 10;
+  for (std::size_t i = 0; i < count; ++i)
+    pacer.AddPresent(std::chrono::milliseconds(i), DT::zero(), false);
+
+  const auto samples = pacer.GetSamples();
+  ASSERT_EQ(samples.size(), FramePacer::NUM_SAMPLES);
+  EXPECT_EQ(samples.front().latency, 10ms);
+  EXPECT_EQ(samples.back().latency, std::chrono::milliseconds(count - 1));
+
+  pacer.Reset();
+  EXPECT_TRUE(pacer.GetSamples().empty());
+}
@@ -0,0 +1,92 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "VideoCommon/PostProcessing.h"
+
+using VideoCommon::PostProcessingPass;
+
+static PostProcessingPass MakePass(std::vector<std::string> inputs, std::string output,
+                                   float output_scale = 1.0f)
+{
+  PostProcessingPass pass;
+  pass.inputs = std::move(inputs);
+  pass.output = std::move(output);
+  pass.output_scale = output_scale;
+  return pass;
+}
+
+TEST(PostProcessingPasses, SinglePassRendersFinalImage)
+{
+  std::vector<PostProcessingPass> passes(1);
+  const auto target_scales = VideoCommon::SchedulePostProcessingPasses(&passes);
+  ASSERT_TRUE(target_scales.has_value());
+  EXPECT_TRUE(target_scales->empty());
+  EXPECT_FALSE(passes[0].target.has_value());
+  EXPECT_EQ(passes[0].input_targets, std::vector<std::optional<u32>>{std::nullopt});
+}
+
+TEST(PostProcessingPasses, ReusesTargetsOnceNothingReadsThem)
+{
+  std::vector<PostProcessingPass> passes = {
+      MakePass({"ColorBuffer"}, "a"), MakePass({"a"}, "b"), MakePass({"b"}, "c"),
+      MakePass({"c"}, "")};
+  const auto target_scales = VideoCommon::SchedulePostProcessingPasses(&passes);
+  ASSERT_TRUE(target_scales.has_value());
+  EXPECT_EQ(*target_scales, (std::vector<float>{1.0f, 1.0f}));
+  EXPECT_EQ(passes[0].target, 0u);
+  EXPECT_EQ(passes[1].target, 1u);
+  EXPECT_EQ(passes[2].target, 0u);
+  EXPECT_FALSE(passes[3].target.has_value());
+  EXPECT_EQ(passes[3].input_targets, std::vector<std::optional<u32>>{0u});
+}
+
+TEST(PostProcessingPasses, KeepsTargetsThatAreReadLater)
+{
+  // A bloom: the bright parts are blurred at half resolution, and added to the color buffer
+  std::vector<PostProcessingPass> passes = {
+      MakePass({"ColorBuffer"}, "bright", 0.5f), MakePass({"bright"}, "blur_h", 0.5f),
+      MakePass({"blur_h"}, "blur_v", 0.5f), MakePass({"ColorBuffer", "blur_v", "bright"}, "")};
+  const auto target_scales = VideoCommon::SchedulePostProcessingPasses(&passes);
+  ASSERT_TRUE(target_scales.has_value());
+  EXPECT_EQ(*target_scales, (std::vector<float>{0.5f, 0.5f, 0.5f}));
+  EXPECT_EQ(passes[3].input_targets, (std::vector<std::optional<u32>>{std::nullopt, 2u, 0u}));
+}
+
+TEST(PostProcessingPasses, OnlySharesTargetsOfTheSameScale)
+{
+  std::vector<PostProcessingPass> passes = {
+      MakePass({"ColorBuffer"}, "a", 0.5f), MakePass({"a"}, "b", 0.25f),
+      MakePass({"b"}, "c", 0.5f), MakePass({"c"}, "d", 0.25f), MakePass({"d"}, "")};
+  const auto target_scales = VideoCommon::SchedulePostProcessingPasses(&passes);
+  ASSERT_TRUE(target_scales.has_value());
+  EXPECT_EQ(*target_scales, (std::vector<float>{0.5f, 0.25f}));
+  EXPECT_EQ(passes[2].target, 0u);
+  EXPECT_EQ(passes[3].target, 1u);
+}
+
+TEST(PostProcessingPasses, ReadsTheLatestOutputOfAName)
+{
+  std::vector<PostProcessingPass> passes = {MakePass({"ColorBuffer"}, "a"), MakePass({"a"}, "a"),
+                                            MakePass({"a"}, "")};
+  const auto target_scales = VideoCommon::SchedulePostProcessingPasses(&passes);
+  ASSERT_TRUE(target_scales.has_value());
+  EXPECT_EQ(passes[2].input_targets, std::vector<std::optional<u32>>{passes[1].target});
+  EXPECT_NE(passes[0].target, passes[1].target);
+}
+
+TEST(PostProcessingPasses, RejectsUnknownInputs)
+{
+  std::vector<PostProcessingPass> passes = {MakePass({"later"}, "a"),
+                                            MakePass({"ColorBuffer"}, "later"),
+                                            MakePass({"a"}, "")};
+  EXPECT_FALSE(VideoCommon::SchedulePostProcessingPasses(&passes).has_value());
+
+  passes = {MakePass({}, "")};
+  EXPECT_FALSE(VideoCommon::SchedulePostProcessingPasses(&passes).has_value());
+}
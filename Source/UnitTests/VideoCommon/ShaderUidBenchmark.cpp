@@ -0,0 +1,99 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Measures what building the shader UIDs costs, which happens on draws after the registers they
+// are generated from have changed.
+
+#include <chrono>
+#include <cstring>
+#include <random>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/BPMemory.h"
+#include "VideoCommon/GeometryShaderGen.h"
+#include "VideoCommon/NativeVertexFormat.h"
+#include "VideoCommon/PixelShaderGen.h"
+#include "VideoCommon/RenderState.h"
+#include "VideoCommon/VertexLoaderManager.h"
+#include "VideoCommon/VertexShaderGen.h"
+#include "VideoCommon/XFMemory.h"
+
+#include "../BenchmarkReport.h"
+
+namespace
+{
+constexpr int ITERATIONS = 200000;
+
+class ShaderUidBenchmark : public testing::TestWithParam<u32>
+{
+protected:
+  void SetUp() override
+  {
+    std::memset(static_cast<void*>(&bpmem), 0, sizeof(bpmem));
+    std::memset(static_cast<void*>(&xfmem), 0, sizeof(xfmem));
+
+    // A lit, textured draw with the number of TEV stages given by the parameter
+    const u32 tev_stages = GetParam();
+    bpmem.genMode.numtevstages = tev_stages - 1;
+    bpmem.genMode.numtexgens = 2;
+    bpmem.genMode.numcolchans = 1;
+    xfmem.numTexGen.numTexGens = 2;
+    xfmem.numChan.numColorChans = 1;
+    VertexLoaderManager::g_current_components = VB_HAS_NORMAL | VB_HAS_COL0 | VB_HAS_UV0;
+
+    // The TEV stages, orders and konstant selections are filled in with arbitrary values
+    std::mt19937 rng(tev_stages);
+    u32* const registers = reinterpret_cast<u32*>(&bpmem);
+    for (u32 address = BPMEM_TREF; address < BPMEM_TREF + 8; ++address)
+      registers[address] = rng() & 0xFFFFFF;
+    for (u32 address = BPMEM_TEV_COLOR_ENV; address < BPMEM_TEV_COLOR_ENV + 32; ++address)
+      registers[address] = rng() & 0xFFFFFF;
+    for (u32 address = BPMEM_TEV_KSEL; address < BPMEM_TEV_KSEL + 8; ++address)
+      registers[address] = rng() & 0xFFFFFF;
+  }
+
+  void TearDown() override
+  {
+    std::memset(static_cast<void*>(&bpmem), 0, sizeof(bpmem));
+    std::memset(static_cast<void*>(&xfmem), 0, sizeof(xfmem));
+    VertexLoaderManager::g_current_components = 0;
+  }
+
+  template <typename Function>
+  void Measure(const char* name, const Function& function)
+  {
+    const auto reference = function();
+    int matches = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ITERATIONS; ++i)
+      matches += function() == reference;
+    const std::chrono::duration<double, std::nano> elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    // Also keeps the UIDs from being left out
+    EXPECT_EQ(ITERATIONS, matches) << name;
+    ReportBenchmark(fmt::format("{}, {} TEV stages", name, GetParam()),
+                    elapsed.count() / ITERATIONS, "ns/uid");
+  }
+};
+}  // namespace
+
+TEST_P(ShaderUidBenchmark, Vertex)
+{
+  Measure("vertex shader UID", [] { return GetVertexShaderUid(); });
+}
+
+TEST_P(ShaderUidBenchmark, Pixel)
+{
+  Measure("pixel shader UID", [] { return GetPixelShaderUid(); });
+}
+
+TEST_P(ShaderUidBenchmark, Geometry)
+{
+  Measure("geometry shader UID", [] { return GetGeometryShaderUid(PrimitiveType::Triangles); });
+}
+
+INSTANTIATE_TEST_SUITE_P(TevStages, ShaderUidBenchmark, testing::Values(1u, 4u, 16u));
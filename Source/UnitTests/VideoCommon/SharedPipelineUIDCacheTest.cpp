@@ -0,0 +1,63 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "VideoCommon/GXPipelineTypes.h"
+#include "VideoCommon/SharedPipelineUIDCache.h"
+
+using VideoCommon::SerializedGXPipelineUid;
+
+namespace
+{
+SerializedGXPipelineUid MakeUID(u32 id)
+{
+  // The cache compares UIDs bytewise, padding included
+  SerializedGXPipelineUid uid;
+  std::memset(static_cast<void*>(&uid), 0, sizeof(uid));
+  uid.rasterization_state_bits = id;
+  return uid;
+}
+
+std::vector<u32> GetIDsInCompileOrder(const VideoCommon::SharedPipelineUIDCache& cache)
+{
+  std::vector<u32> ids;
+  for (const SerializedGXPipelineUid& uid : cache.GetUIDsInCompileOrder())
+    ids.push_back(uid.rasterization_state_bits);
+  return ids;
+}
+}  // namespace
+
+TEST(SharedPipelineUIDCache, OrdersByUseCount)
+{
+  VideoCommon::SharedPipelineUIDCache cache;
+  cache.AddSource(std::vector{MakeUID(1), MakeUID(2), MakeUID(3)});
+  cache.AddSource(std::vector{MakeUID(3), MakeUID(2)});
+  cache.AddSource(std::vector{MakeUID(3)});
+
+  EXPECT_EQ(cache.GetSourceCount(), 3u);
+  EXPECT_EQ(cache.GetUIDCount(), 3u);
+  EXPECT_EQ(GetIDsInCompileOrder(cache), (std::vector<u32>{3, 2, 1}));
+}
+
+TEST(SharedPipelineUIDCache, OrdersEqualUseCountsByFirstUse)
+{
+  VideoCommon::SharedPipelineUIDCache cache;
+  cache.AddSource(std::vector{MakeUID(1), MakeUID(2), MakeUID(3), MakeUID(4)});
+  cache.AddSource(std::vector{MakeUID(2), MakeUID(4), MakeUID(1), MakeUID(3)});
+
+  // Average positions: 2 at 0.125, 1 at 0.25, 4 at 0.5, 3 at 0.625
+  EXPECT_EQ(GetIDsInCompileOrder(cache), (std::vector<u32>{2, 1, 4, 3}));
+}
+
+TEST(SharedPipelineUIDCache, CountsRepeatedUIDsOnce)
+{
+  VideoCommon::SharedPipelineUIDCache cache;
+  cache.AddSource(std::vector{MakeUID(1), MakeUID(1), MakeUID(2)});
+  cache.AddSource(std::vector{MakeUID(2)});
+
+  EXPECT_EQ(GetIDsInCompileOrder(cache), (std::vector<u32>{2, 1}));
+}
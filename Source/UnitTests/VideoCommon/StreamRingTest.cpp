@@ -0,0 +1,105 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/StreamRing.h"
+
+namespace
+{
+// Each executed command buffer signals the next fence
+class TestRing final : public VideoCommon::StreamRing
+{
+public:
+  TestRing(u32 size, u32 max_size) { Reset(size, max_size); }
+
+  void Execute() { ++m_current_fence; }
+  void Complete(u64 fence) { m_completed_fence = std::max(m_completed_fence, fence); }
+
+  std::vector<u64> waits;
+  std::vector<u32> resizes;
+
+protected:
+  u64 GetCurrentFence() const override { return m_current_fence; }
+  u64 GetCompletedFence() const override { return m_completed_fence; }
+  void WaitForFence(u64 fence) override
+  {
+    waits.push_back(fence);
+    Complete(fence);
+  }
+  bool Resize(u32 new_size) override
+  {
+    resizes.push_back(new_size);
+    return true;
+  }
+
+private:
+  u64 m_current_fence = 1;
+  u64 m_completed_fence = 0;
+};
+}  // namespace
+
+TEST(StreamRing, AllocatesAligned)
+{
+  TestRing ring(1024, 1024);
+  ASSERT_TRUE(ring.ReserveMemory(100, 16));
+  EXPECT_EQ(ring.GetCurrentOffset(), 0u);
+  ring.CommitMemory(99);
+
+  ASSERT_TRUE(ring.ReserveMemory(100, 16));
+  EXPECT_EQ(ring.GetCurrentOffset(), 112u);
+  EXPECT_TRUE(ring.waits.empty());
+}
+
+TEST(StreamRing, WrapsAroundBehindGPU)
+{
+  TestRing ring(1024, 1024);
+  ASSERT_TRUE(ring.ReserveMemory(600, 4));
+  ring.CommitMemory(600);
+  ASSERT_TRUE(ring.ReserveMemory(100, 4));
+  ring.CommitMemory(100);
+
+  ring.Execute();
+  ring.Complete(1);
+  ASSERT_TRUE(ring.ReserveMemory(500, 4));
+  EXPECT_EQ(ring.GetCurrentOffset(), 0u);
+  EXPECT_TRUE(ring.waits.empty());
+}
+
+TEST(StreamRing, WaitsForExecutedCommandBuffers)
+{
+  TestRing ring(1024, 1024);
+  ASSERT_TRUE(ring.ReserveMemory(600, 4));
+  ring.CommitMemory(600);
+
+  // The command buffer that is being recorded has to be executed first
+  EXPECT_FALSE(ring.ReserveMemory(600, 4));
+  EXPECT_TRUE(ring.waits.empty());
+
+  ring.Execute();
+  ASSERT_TRUE(ring.ReserveMemory(600, 4));
+  EXPECT_EQ(ring.GetCurrentOffset(), 0u);
+  EXPECT_EQ(ring.waits, std::vector<u64>{1});
+}
+
+TEST(StreamRing, GrowsInsteadOfWaiting)
+{
+  TestRing ring(1024, 4096);
+  ASSERT_TRUE(ring.ReserveMemory(600, 4));
+  ring.CommitMemory(600);
+
+  ASSERT_TRUE(ring.ReserveMemory(600, 4));
+  EXPECT_EQ(ring.GetSize(), 2048u);
+  EXPECT_EQ(ring.GetCurrentOffset(), 0u);
+  EXPECT_TRUE(ring.waits.empty());
+
+  // Too large for the current size, but not for the largest one
+  ring.CommitMemory(600);
+  ASSERT_TRUE(ring.ReserveMemory(3000, 4));
+  EXPECT_EQ(ring.GetSize(), 4096u);
+  EXPECT_EQ(ring.resizes, (std::vector<u32>{2048, 4096}));
+}
@@ -0,0 +1,63 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Measures how fast each texture format is decoded, including the threaded decoding of large
+// textures.
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/TextureDecoder.h"
+
+#include "../BenchmarkReport.h"
+
+namespace
+{
+constexpr int RUNS = 16;
+
+class TextureDecoderBenchmark : public testing::TestWithParam<TextureFormat>
+{
+};
+
+void MeasureDecode(TextureFormat format, int width, int height)
+{
+  std::mt19937 rng(static_cast<u32>(format));
+  std::uniform_int_distribution<int> distribution(0, 255);
+  std::vector<u8> src(TexDecoder_GetTextureSizeInBytes(width, height, format));
+  std::generate(src.begin(), src.end(), [&] { return static_cast<u8>(distribution(rng)); });
+  std::vector<u8> tlut(2 * 16384);
+  std::generate(tlut.begin(), tlut.end(), [&] { return static_cast<u8>(distribution(rng)); });
+  std::vector<u8> dst(width * height * 4);
+
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < RUNS; ++i)
+  {
+    TexDecoder_Decode(dst.data(), src.data(), width, height, format, tlut.data(),
+                      TLUTFormat::RGB5A3);
+  }
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+  ReportBenchmark(fmt::format("{}, {}x{}", format, width, height),
+                  RUNS * double(width) * height / elapsed.count() / 1e6, "Mpixels/s");
+}
+}  // namespace
+
+TEST_P(TextureDecoderBenchmark, Decode)
+{
+  // Small enough to be decoded on one thread, and large enough to be split between threads
+  MeasureDecode(GetParam(), 128, 128);
+  MeasureDecode(GetParam(), 1024, 1024);
+}
+
+INSTANTIATE_TEST_SUITE_P(Formats, TextureDecoderBenchmark,
+                         testing::Values(TextureFormat::I4, TextureFormat::I8, TextureFormat::IA4,
+                                         TextureFormat::IA8, TextureFormat::RGB565,
+                                         TextureFormat::RGB5A3, TextureFormat::RGBA8,
+                                         TextureFormat::C4, TextureFormat::C8,
+                                         TextureFormat::C14X2, TextureFormat::CMPR));
@@ -1,6 +1,7 @@
 // Copyright 2014 Dolphin Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <chrono>
 #include <limits>
 #include <memory>
 #include <tuple>
@@ -18,6 +19,8 @@
 #include "VideoCommon/VertexLoaderBase.h"
 #include "VideoCommon/VertexLoaderManager.h"
 
+#include "../BenchmarkReport.h"
+
 TEST(VertexLoaderUID, UniqueEnough)
 {
   std::unordered_set<VertexLoaderUID> uids;
@@ -367,6 +370,124 @@ TEST_F(VertexLoaderTest, LargeFloatVertexSpeed)
     RunVertices(100000);
 }
 
+// Uses more indexed arrays than the JIT loaders keep in registers
+TEST_F(VertexLoaderTest, IndexedPositionNormalTexCoords)
+{
+  m_vtx_desc.low.Position = VertexComponentFormat::Index16;
+  m_vtx_desc.low.Normal = VertexComponentFormat::Index8;
+  m_vtx_desc.high.Tex0Coord = VertexComponentFormat::Index16;
+  m_vtx_desc.high.Tex1Coord = VertexComponentFormat::Index8;
+  m_vtx_attr.g0.PosElements = CoordComponentCount::XY;
+  m_vtx_attr.g0.PosFormat = ComponentFormat::Float;
+  m_vtx_attr.g0.NormalElements = NormalComponentCount::N;
+  m_vtx_attr.g0.NormalFormat = ComponentFormat::Float;
+  m_vtx_attr.g0.Tex0CoordElements = TexComponentCount::S;
+  m_vtx_attr.g0.Tex0CoordFormat = ComponentFormat::Float;
+  m_vtx_attr.g1.Tex1CoordElements = TexComponentCount::ST;
+  m_vtx_attr.g1.Tex1CoordFormat = ComponentFormat::Float;
+  CreateAndCheckSizes(2 + 1 + 2 + 1, (2 + 3 + 1 + 2) * sizeof(float));
+
+  // Each array element starts with its index, followed by consecutive values
+  const auto fill_array = [&](CPArray array, u32 elements) {
+    VertexLoaderManager::cached_arraybases[array] = m_src.GetPointer();
+    g_main_cp_state.array_strides[array] = elements * sizeof(float);
+    for (u32 i = 0; i < 4; ++i)
+    {
+      for (u32 j = 0; j < elements; ++j)
+        Input(static_cast<float>(static_cast<u32>(array) * 100 + i * 10 + j));
+    }
+  };
+  fill_array(CPArray::Position, 2);
+  fill_array(CPArray::Normal, 3);
+  fill_array(CPArray::TexCoord0, 1);
+  fill_array(CPArray::TexCoord1, 2);
+
+  const u8* vertices = m_src.GetPointer();
+  for (u16 i = 0; i < 4; ++i)
+  {
+    Input<u16>(3 - i);
+    Input<u8>(i);
+    Input<u16>(i ^ 1);
+    Input<u8>(i ^ 2);
+  }
+
+  m_src = DataReader(const_cast<u8*>(vertices), input_memory + sizeof(input_memory));
+  int actual_count = m_loader->RunVertices(m_src.GetPointer(), m_dst.GetPointer(), 4);
+  EXPECT_EQ(actual_count, 4);
+
+  const auto expect_element = [&](CPArray array, u32 index, u32 elements) {
+    for (u32 j = 0; j < elements; ++j)
+      ExpectOut(static_cast<float>(static_cast<u32>(array) * 100 + index * 10 + j));
+  };
+  for (u32 i = 0; i < 4; ++i)
+  {
+    expect_element(CPArray::Position, 3 - i, 2);
+    expect_element(CPArray::Normal, i, 3);
+    expect_element(CPArray::TexCoord0, i ^ 1, 1);
+    expect_element(CPArray::TexCoord1, i ^ 2, 2);
+  }
+}
+
+class VertexLoaderIndexedSpeedTest
+    : public VertexLoaderTest,
+      public ::testing::WithParamInterface<std::tuple<ComponentFormat, VertexComponentFormat>>
+{
+};
+INSTANTIATE_TEST_SUITE_P(
+    FormatsAndIndices, VertexLoaderIndexedSpeedTest,
+    ::testing::Combine(::testing::Values(ComponentFormat::Byte, ComponentFormat::Short,
+                                         ComponentFormat::Float),
+                       ::testing::Values(VertexComponentFormat::Index8,
+                                         VertexComponentFormat::Index16)));
+
+// Reports the speed of the most common indexed layout: a position, a normal and a texture
+// coordinate, each read through its own index
+TEST_P(VertexLoaderIndexedSpeedTest, PositionNormalTexCoord)
+{
+  const auto [format, index] = GetParam();
+  m_vtx_desc.low.Position = index;
+  m_vtx_desc.low.Normal = index;
+  m_vtx_desc.high.Tex0Coord = index;
+  m_vtx_attr.g0.PosElements = CoordComponentCount::XYZ;
+  m_vtx_attr.g0.PosFormat = format;
+  m_vtx_attr.g0.NormalElements = NormalComponentCount::N;
+  m_vtx_attr.g0.NormalFormat = format;
+  m_vtx_attr.g0.Tex0CoordElements = TexComponentCount::ST;
+  m_vtx_attr.g0.Tex0CoordFormat = format;
+  const u32 index_size = index == VertexComponentFormat::Index8 ? 1 : 2;
+  CreateAndCheckSizes(3 * index_size, 8 * sizeof(float));
+
+  // 200 elements fit in both index sizes without hitting the skipped vertex index
+  constexpr u32 ELEMENT_COUNT = 200;
+  constexpr int VERTEX_COUNT = 100000;
+  const u32 stride = 3 * GetElementSize(format);
+  for (CPArray array : {CPArray::Position, CPArray::Normal, CPArray::TexCoord0})
+  {
+    VertexLoaderManager::cached_arraybases[array] = input_memory + sizeof(input_memory) / 2;
+    g_main_cp_state.array_strides[array] = stride;
+  }
+
+  for (int i = 0; i < VERTEX_COUNT; ++i)
+  {
+    for (u32 j = 0; j < 3; ++j)
+    {
+      const u32 element = (i * 7 + j * 31) % ELEMENT_COUNT;
+      if (index_size == 1)
+        Input<u8>(element);
+      else
+        Input<u16>(element);
+    }
+  }
+
+  constexpr int RUNS = 100;
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < RUNS; ++i)
+    RunVertices(VERTEX_COUNT);
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  ReportBenchmark(fmt::format("format: {}, index: {}", format, index),
+                  RUNS * VERTEX_COUNT / elapsed.count() / 1e6, "Mvertices/s");
+}
+
 TEST_F(VertexLoaderTest, DirectAllComponents)
 {
   m_vtx_desc.low.PosMatIdx = 1;
@@ -0,0 +1,254 @@
+#!/usr/bin/env python3
+
+"""
+perf-regression.py run --binaries-dir <dir> [--fifo-log <dff>] [--movie <dtm> <game>] -o <json>
+perf-regression.py compare <base json> <new json> [--threshold <percent>]
+
+Runs the performance benchmarks and collects their results in one JSON file, or compares two
+such files, for example from the parent commit and from a change, and lists the regressions.
+
+The microbenchmarks are the unit tests whose suite or name contains "Benchmark" or "Speed". The
+results they report with ReportBenchmark (Source/UnitTests/BenchmarkReport.h) are collected from
+the gtest JSON output, and for tests that report nothing, the time the test took.
+
+The macro workloads are run with dolphin-emu-nogui: FIFO logs with --fifo-bench, which replays
+the log on the configured video backend, and movies with --cpu-bench on the Null backend, which
+also measures saving and loading a savestate. Both need a user directory with the games and
+settings they were recorded with, given with --user.
+"""
+
+import argparse
+import datetime
+import json
+import os
+import platform
+import statistics
+import subprocess
+import sys
+import tempfile
+
+BENCHMARK_FILTER = '*Benchmark*:*Speed*'
+
+def metric(value, unit, higher_is_better=None):
+    if higher_is_better is None:
+        higher_is_better = unit.endswith('/s')
+    return {'value': value, 'unit': unit, 'higher_is_better': higher_is_better}
+
+def find_executables(directory):
+    '''Lists the unit test executables in the build output.'''
+    if not os.path.isdir(directory):
+        return []
+    names = sorted(os.listdir(directory))
+    if os.name == 'nt':
+        names = [name for name in names if name.endswith('.exe')]
+    paths = [os.path.join(directory, name) for name in names]
+    return [path for path in paths if os.path.isfile(path) and os.access(path, os.X_OK)]
+
+def parse_property(key):
+    '''Splits a "name [unit]" property key as written by ReportBenchmark.'''
+    if not key.endswith(']') or ' [' not in key:
+        return None
+    name, unit = key[:-1].rsplit(' [', 1)
+    return name, unit
+
+def collect_properties(prefix, entry, metrics):
+    found = False
+    for key, value in entry.items():
+        parsed = parse_property(key)
+        if parsed is None:
+            continue
+        name, unit = parsed
+        metrics[f'{prefix}/{name}'] = metric(float(value), unit)
+        found = True
+    return found
+
+def run_microbenchmarks(tests_dir, test_filter, metrics):
+    for executable in find_executables(tests_dir):
+        binary = os.path.basename(executable)
+        with tempfile.TemporaryDirectory() as temp_dir:
+            report_path = os.path.join(temp_dir, 'report.json')
+            result = subprocess.run([executable, f'--gtest_filter={test_filter}',
+                                     f'--gtest_output=json:{report_path}'])
+            if result.returncode != 0:
+                print(f'{binary} failed with exit code {result.returncode}', file=sys.stderr)
+            if not os.path.exists(report_path):
+                continue
+            with open(report_path) as f:
+                report = json.load(f)
+
+        for suite in report.get('testsuites', []):
+            suite_prefix = f'micro/{binary}/{suite["name"]}'
+            collect_properties(suite_prefix, suite, metrics)
+            for test in suite.get('testsuite', []):
+                if test.get('result', 'COMPLETED') != 'COMPLETED':
+                    continue
+                prefix = f'{suite_prefix}.{test["name"]}'
+                if not collect_properties(prefix, test, metrics):
+                    seconds = float(test.get('time', '0s').rstrip('s'))
+                    metrics[f'{prefix}/time'] = metric(seconds * 1000, 'ms')
+
+def run_nogui(nogui, arguments, user_dir):
+    with tempfile.TemporaryDirectory() as temp_dir:
+        report_path = os.path.join(temp_dir, 'report.json')
+        command = [nogui] + arguments
+        if user_dir:
+            command += ['--user', user_dir]
+        if '--fifo-bench' in arguments:
+            output_option = '--fifo-bench-output'
+        else:
+            output_option = '--cpu-bench-output'
+        result = subprocess.run(command + [output_option, report_path])
+        if result.returncode != 0 or not os.path.exists(report_path):
+            print(f'{" ".join(command)} failed with exit code {result.returncode}',
+                  file=sys.stderr)
+            return None
+        with open(report_path) as f:
+            return json.load(f)
+
+def run_fifo_log(nogui, path, loops, user_dir, metrics):
+    report = run_nogui(nogui, ['--fifo-bench', str(loops), path], user_dir)
+    if report is None:
+        return
+    prefix = f'fifo/{os.path.basename(path)}'
+    for key, value in report['average'].items():
+        metrics[f'{prefix}/{key}'] = metric(value, 'us', False)
+
+def run_movie(nogui, path, game, frames, user_dir, metrics):
+    report = run_nogui(nogui, ['--cpu-bench', str(frames), '--movie', path, '--exec', game],
+                       user_dir)
+    if report is None:
+        return
+    prefix = f'movie/{os.path.basename(path)}'
+    metrics[f'{prefix}/speed'] = metric(report['speed'], 'x', True)
+    metrics[f'{prefix}/emulated_mhz'] = metric(report['emulated_mhz'], 'MHz', True)
+    metrics[f'{prefix}/average_frame_time_us'] = metric(report['average_frame_time_us'], 'us')
+    metrics[f'{prefix}/peak_rss_bytes'] = metric(report['peak_rss_bytes'], 'bytes')
+    savestate = report.get('savestate')
+    if savestate:
+        metrics[f'{prefix}/savestate_save_ms'] = metric(savestate['save_ms'], 'ms')
+        metrics[f'{prefix}/savestate_load_ms'] = metric(savestate['load_ms'], 'ms')
+        metrics[f'{prefix}/savestate_size_bytes'] = metric(savestate['size_bytes'], 'bytes')
+
+def get_commit():
+    try:
+        return subprocess.check_output(['git', 'rev-parse', 'HEAD'],
+                                       cwd=os.path.dirname(os.path.abspath(__file__)),
+                                       text=True).strip()
+    except (OSError, subprocess.CalledProcessError):
+        return None
+
+def run(args):
+    binaries = args.binaries_dir
+    nogui = os.path.join(binaries, 'dolphin-emu-nogui' + ('.exe' if os.name == 'nt' else ''))
+    if (args.fifo_log or args.movie) and not os.path.exists(nogui):
+        print(f'{nogui} was not found', file=sys.stderr)
+        return 1
+
+    # Every repetition runs everything once, the median of the repetitions is reported
+    metrics = {}
+    for _ in range(args.repetitions):
+        repetition = {}
+        if not args.skip_microbenchmarks:
+            run_microbenchmarks(os.path.join(binaries, 'Tests'), args.filter, repetition)
+        for path in args.fifo_log:
+            run_fifo_log(nogui, path, args.fifo_loops, args.user, repetition)
+        for path, game in args.movie:
+            run_movie(nogui, path, game, args.frames, args.user, repetition)
+        for name, result in repetition.items():
+            metrics.setdefault(name, dict(result, values=[]))['values'].append(result['value'])
+
+    for result in metrics.values():
+        result['value'] = statistics.median(result.pop('values'))
+
+    results = {
+        'commit': get_commit(),
+        'date': datetime.datetime.now(datetime.timezone.utc).isoformat(),
+        'host': {'machine': platform.machine(), 'node': platform.node(),
+                 'processor': platform.processor(), 'system': platform.system()},
+        'repetitions': args.repetitions,
+        'metrics': metrics,
+    }
+    with open(args.output, 'w') as f:
+        json.dump(results, f, indent=2, sort_keys=True)
+    print(f'Wrote {len(metrics)} results to {args.output}')
+    return 0
+
+def compare(args):
+    with open(args.base) as f:
+        base = json.load(f)
+    with open(args.new) as f:
+        new = json.load(f)
+
+    if base.get('host') != new.get('host'):
+        print('Warning: the results are from different hosts', file=sys.stderr)
+
+    regressions = 0
+    rows = []
+    for name in sorted(set(base['metrics']) & set(new['metrics'])):
+        old_metric = base['metrics'][name]
+        new_metric = new['metrics'][name]
+        old_value = old_metric['value']
+        new_value = new_metric['value']
+        if old_value == 0:
+            continue
+        change = (new_value - old_value) / abs(old_value) * 100
+        worse = -change if new_metric['higher_is_better'] else change
+        status = ''
+        if worse > args.threshold:
+            status = 'REGRESSION'
+            regressions += 1
+        elif worse < -args.threshold:
+            status = 'improvement'
+        if status or args.all:
+            rows.append((name, old_value, new_value, new_metric['unit'], change, status))
+
+    for name, old_value, new_value, unit, change, status in rows:
+        print(f'{name:<80} {old_value:>12.4g} -> {new_value:>12.4g} {unit:<10} '
+              f'{change:>+7.1f}% {status}')
+
+    missing = sorted(set(base['metrics']) - set(new['metrics']))
+    for name in missing:
+        print(f'{name:<80} missing from the new results')
+
+    print(f'{regressions} regressions beyond {args.threshold}%, {len(missing)} missing results')
+    return 1 if regressions or missing else 0
+
+def main():
+    parser = argparse.ArgumentParser(description='Runs and compares performance benchmarks.')
+    subparsers = parser.add_subparsers(dest='command', required=True)
+
+    run_parser = subparsers.add_parser('run', help='run the benchmarks')
+    run_parser.add_argument('--binaries-dir', required=True,
+                            help='the directory with dolphin-emu-nogui and the Tests directory, '
+                                 'Binaries in a CMake build directory')
+    run_parser.add_argument('-o', '--output', required=True, help='the JSON file to write')
+    run_parser.add_argument('--filter', default=BENCHMARK_FILTER,
+                            help='the gtest filter that selects the microbenchmarks')
+    run_parser.add_argument('--skip-microbenchmarks', action='store_true')
+    run_parser.add_argument('--fifo-log', action='append', default=[],
+                            help='a FIFO log to replay, can be given more than once')
+    run_parser.add_argument('--fifo-loops', type=int, default=3)
+    run_parser.add_argument('--movie', action='append', default=[], nargs=2,
+                            metavar=('MOVIE', 'GAME'),
+                            help='a movie and its game to play on the Null backend, can be given '
+                                 'more than once')
+    run_parser.add_argument('--frames', type=int, default=3600,
+                            help='how many frames of each movie to play')
+    run_parser.add_argument('--user', help='the user directory for dolphin-emu-nogui')
+    run_parser.add_argument('--repetitions', type=int, default=1)
+    run_parser.set_defaults(function=run)
+
+    compare_parser = subparsers.add_parser('compare', help='compare two result files')
+    compare_parser.add_argument('base')
+    compare_parser.add_argument('new')
+    compare_parser.add_argument('--threshold', type=float, default=5.0,
+                                help='the change in percent that counts as a regression')
+    compare_parser.add_argument('--all', action='store_true',
+                                help='list all results, not only the ones that changed')
+    compare_parser.set_defaults(function=compare)
+
+    args = parser.parse_args()
+    return args.function(args)
+
+if __name__ == '__main__':
+    sys.exit(main())